@@ -416,6 +416,52 @@ if (NOT SERAC_THIRD_PARTY_LIBRARIES_FOUND)
     
     message(STATUS "Tribol support is " ${TRIBOL_FOUND})
 
+    #------------------------------------------------------------------------------
+    # Ascent
+    #------------------------------------------------------------------------------
+    if(ASCENT_DIR)
+        serac_assert_is_directory(VARIABLE_NAME ASCENT_DIR)
+
+        find_package(Ascent REQUIRED
+                            NO_DEFAULT_PATH
+                            PATHS ${ASCENT_DIR}/lib/cmake/ascent)
+
+        if(TARGET ascent::ascent_mpi)
+            message(STATUS "Ascent CMake exported library loaded: ascent::ascent_mpi")
+        else()
+            message(FATAL_ERROR "Could not load Ascent CMake exported library: ascent::ascent_mpi")
+        endif()
+
+        set(ASCENT_FOUND TRUE)
+    else()
+        set(ASCENT_FOUND FALSE)
+    endif()
+
+    message(STATUS "Ascent support is " ${ASCENT_FOUND})
+
+    #------------------------------------------------------------------------------
+    # SCR (Scalable Checkpoint/Restart)
+    #------------------------------------------------------------------------------
+    if(SCR_DIR)
+        serac_assert_is_directory(VARIABLE_NAME SCR_DIR)
+
+        find_package(scr REQUIRED
+                         NO_DEFAULT_PATH
+                         PATHS ${SCR_DIR}/share/scr/cmake ${SCR_DIR}/lib/cmake/scr)
+
+        if(TARGET scr::scr)
+            message(STATUS "SCR CMake exported library loaded: scr::scr")
+        else()
+            message(FATAL_ERROR "Could not load SCR CMake exported library: scr::scr")
+        endif()
+
+        set(SCR_FOUND TRUE)
+    else()
+        set(SCR_FOUND FALSE)
+    endif()
+
+    message(STATUS "SCR support is " ${SCR_FOUND})
+
     #------------------------------------------------------------------------------
     # PETSC
     #------------------------------------------------------------------------------
@@ -0,0 +1,184 @@
+#!/bin/sh
+"exec" "python3" "-u" "-B" "$0" "$@"
+##############################################################################
+# Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+# other Serac Project Developers. See the top-level COPYRIGHT file for details.
+#
+# SPDX-License-Identifier: (BSD-3-Clause)
+##############################################################################
+
+import argparse
+import json
+import os
+import socket
+import sys
+
+
+# This script checks the performance regression runs of tests/performance/performance.ats.
+# Each deck runs in its own directory, where the driver writes the hot-path counters
+# of the run (counters.json, see profiling::writeCounters()) and the summary with
+# the telemetry of each time step (summary.json). For each deck, this writes the
+# timing breakdown of each phase to breakdown.json in that directory: the time
+# (of the slowest rank) and count of each counter, and the totals of the summary
+# telemetry over the time steps. It then compares the breakdown against the
+# baseline of the deck, <baseline-dir>/<deck>.json, and fails if any phase (or
+# iteration count) grew by more than the tolerance. Decks without a baseline are
+# reported but do not fail, and --update-baselines records the current breakdowns
+# as the baselines, which should be done on the reference machine of each baseline
+# directory.
+
+# the telemetry curves that are totaled over the time steps, and whether they are times
+telemetry_totals = [("solves", False), ("nonlinear_iterations", False), ("linear_iterations", False),
+                    ("residual_time", True), ("assembly_time", True), ("preconditioner_setup_time", True),
+                    ("linear_solve_time", True), ("output_time", True)]
+
+
+# The machine, named after SYS_TYPE on LC machines and after the host elsewhere (as in the ATS files)
+def machine_name():
+    return os.environ.get("SYS_TYPE", socket.gethostname().rstrip("0123456789"))
+
+
+def parse_args():
+    repo_dir = os.path.dirname(os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
+    default_baseline_dir = os.path.join(repo_dir, "tests", "performance", "baselines", machine_name())
+
+    parser = argparse.ArgumentParser(description="Check Serac performance runs against their baselines.")
+    parser.add_argument("--input-dir", type=str, required=True,
+                        help="Directory of the performance runs, one subdirectory per deck")
+    parser.add_argument("--baseline-dir", type=str, default=default_baseline_dir,
+                        help="Directory of the baseline breakdowns of this machine (default: {0})"
+                        .format(default_baseline_dir))
+    parser.add_argument("--tolerance", type=float, default=0.15,
+                        help="Allowed relative growth of each phase time and iteration count")
+    parser.add_argument("--min-seconds", type=float, default=0.05,
+                        help="Phases whose baseline time is shorter than this are not checked, being mostly noise")
+    parser.add_argument("--update-baselines", action="store_true",
+                        help="Record the breakdowns of these runs as the baselines instead of checking them")
+    return parser.parse_args()
+
+
+# converts to list in the case it's single value
+def as_list(v):
+    if type(v) is list:
+        return v
+    else:
+        return [v]
+
+
+# returns the breakdown of a run: {"num_ranks": n, "times": {phase: seconds}, "counts": {phase: count}}
+def read_run(run_dir):
+    with open(os.path.join(run_dir, "counters.json")) as counter_file:
+        counters = json.load(counter_file)
+
+    breakdown = {"num_ranks": counters["num_ranks"], "times": {}, "counts": {}}
+    for name, counter in counters["counters"].items():
+        breakdown["times"][name] = counter["max_seconds"]
+        breakdown["counts"][name] = counter["count"]
+
+    summary_path = os.path.join(run_dir, "summary.json")
+    if os.path.isfile(summary_path):
+        with open(summary_path) as summary_file:
+            telemetry = json.load(summary_file)["curves"].get("telemetry", {})
+        for name, is_time in telemetry_totals:
+            if name not in telemetry:
+                continue
+            total = sum(float(v) for v in as_list(telemetry[name]))
+            if is_time:
+                breakdown["times"]["telemetry " + name] = total
+            else:
+                breakdown["counts"]["telemetry " + name] = int(round(total))
+
+    return breakdown
+
+
+def print_breakdown(deck, breakdown, baseline):
+    print("")
+    print("{0} ({1} ranks)".format(deck, breakdown["num_ranks"]))
+    header = "{0:<48} {1:>12} {2:>12} {3:>8}".format("phase", "time (s)", "baseline (s)", "change")
+    print(header)
+    print("-" * len(header))
+    for name, seconds in sorted(breakdown["times"].items()):
+        base = None if baseline is None else baseline["times"].get(name)
+        change = "-" if not base else "{0:+.1%}".format(seconds / base - 1.0)
+        print("{0:<48} {1:>12.4f} {2:>12} {3:>8}".format(name, seconds, "-" if base is None else
+                                                          "{0:.4f}".format(base), change))
+
+
+# returns the regressions of a breakdown, compared to its baseline
+def regressions(breakdown, baseline, tolerance, min_seconds):
+    found = []
+    if breakdown["num_ranks"] != baseline["num_ranks"]:
+        found.append("ran on {0} ranks, the baseline on {1}".format(breakdown["num_ranks"], baseline["num_ranks"]))
+        return found
+
+    for name, base in baseline["times"].items():
+        if base < min_seconds:
+            continue
+        if name not in breakdown["times"]:
+            found.append("phase '{0}' is missing".format(name))
+        elif breakdown["times"][name] > (1.0 + tolerance) * base:
+            found.append("phase '{0}' took {1:.4f} s, the baseline {2:.4f} s"
+                         .format(name, breakdown["times"][name], base))
+
+    # more iterations (of the solvers) or evaluations (of the counters) are a regression on any machine
+    for name, base in baseline["counts"].items():
+        count = breakdown["counts"].get(name)
+        if count is not None and count > (1.0 + tolerance) * base:
+            found.append("'{0}' counted {1}, the baseline {2}".format(name, count, base))
+
+    return found
+
+
+def main():
+    args = parse_args()
+
+    if not os.path.isdir(args.input_dir):
+        print("ERROR: Given input directory does not exist: {0}".format(args.input_dir))
+        sys.exit(1)
+
+    decks = sorted(d for d in os.listdir(args.input_dir)
+                   if os.path.isfile(os.path.join(args.input_dir, d, "counters.json")))
+    if not decks:
+        print("ERROR: No performance runs found in: {0}".format(args.input_dir))
+        sys.exit(1)
+
+    failed = False
+    for deck in decks:
+        run_dir = os.path.join(args.input_dir, deck)
+        breakdown = read_run(run_dir)
+        with open(os.path.join(run_dir, "breakdown.json"), "w") as breakdown_file:
+            json.dump(breakdown, breakdown_file, indent=2, sort_keys=True)
+
+        baseline_path = os.path.join(args.baseline_dir, deck + ".json")
+        if args.update_baselines:
+            if not os.path.isdir(args.baseline_dir):
+                os.makedirs(args.baseline_dir)
+            with open(baseline_path, "w") as baseline_file:
+                json.dump(breakdown, baseline_file, indent=2, sort_keys=True)
+            print_breakdown(deck, breakdown, None)
+            print("Recorded the baseline: {0}".format(baseline_path))
+            continue
+
+        baseline = None
+        if os.path.isfile(baseline_path):
+            with open(baseline_path) as baseline_file:
+                baseline = json.load(baseline_file)
+
+        print_breakdown(deck, breakdown, baseline)
+        if baseline is None:
+            print("No baseline to check against: {0}".format(baseline_path))
+            continue
+
+        found = regressions(breakdown, baseline, args.tolerance, args.min_seconds)
+        for regression in found:
+            print("ERROR: {0}: {1}".format(deck, regression))
+        failed = failed or bool(found)
+
+    if failed:
+        print("")
+        print("ERROR: Performance regressions beyond the tolerance of {0:.0%}".format(args.tolerance))
+        sys.exit(1)
+
+if __name__ == "__main__":
+    main()
+    sys.exit(0)
@@ -0,0 +1,152 @@
+#!/bin/sh
+"exec" "python3" "-u" "-B" "$0" "$@"
+##############################################################################
+# Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+# other Serac Project Developers. See the top-level COPYRIGHT file for details.
+#
+# SPDX-License-Identifier: (BSD-3-Clause)
+##############################################################################
+
+import argparse
+import glob
+import os
+import re
+import sys
+
+
+# This script tabulates the parallel efficiency of each phase of the physics
+# benchmarks, from the Caliper SPOT files written by tests/scaling/scaling.ats.
+# The files are named <benchmark>_<weak|strong>_<nodes>_nodes.cali, and carry
+# the Adiak metadata of the run (see benchmark_options.hpp), of which the
+# element and rank counts are used to normalize the timings of weak scaling
+# studies whose work per rank is only approximately constant.
+
+# the phases, by the name of the Caliper region that times them
+phases = [("Setup", "Setup"), ("Assembly", "Functional::assembly"), ("Solve", "Solve"), ("I/O", "I/O")]
+
+file_pattern = re.compile(r"(?P<benchmark>.+)_(?P<study>weak|strong)_(?P<nodes>\d+)_nodes\.cali$")
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(description="Tabulate the parallel efficiency of Serac scaling runs.")
+    parser.add_argument("--input-dir", type=str, required=True,
+                        help="Directory of the Caliper files of the scaling runs")
+    parser.add_argument("--threshold", type=float, default=0.0,
+                        help="Fail if the efficiency of any phase drops below this value")
+    return parser.parse_args()
+
+
+# the time of the slowest rank, if the file has cross-rank statistics
+def time_metric(record):
+    keys = [k for k in record.keys() if "inclusive" in k and "time.duration" in k]
+    for key in keys:
+        if key.startswith("max#"):
+            return key
+    return keys[0] if keys else None
+
+
+# converts to list in the case it's single value
+def as_list(v):
+    if type(v) is list:
+        return v
+    else:
+        return [v]
+
+
+# returns {problem: {phase: seconds}} and the run metadata of a Caliper file
+def read_run(path):
+    import caliperreader
+
+    reader = caliperreader.CaliperReader()
+    reader.read(path)
+
+    times = {}
+    for record in reader.records:
+        if "path" not in record:
+            continue
+        metric = time_metric(record)
+        if metric is None:
+            continue
+        region_path = as_list(record["path"])
+        problem = region_path[0]
+        for phase, region in phases:
+            if region_path[-1] == region:
+                problem_times = times.setdefault(problem, {})
+                problem_times[phase] = problem_times.get(phase, 0.0) + float(record[metric])
+
+    return times, reader.globals
+
+
+def efficiency(study, base, run, phase):
+    if phase not in base["times"] or phase not in run["times"] or run["times"][phase] <= 0.0:
+        return None
+    speedup = base["times"][phase] / run["times"][phase]
+    if study == "strong":
+        return speedup * base["ranks"] / run["ranks"]
+    # weak scaling: the time per element and rank, so that runs need not have exactly the same work per rank
+    return speedup * (run["elements"] / run["ranks"]) / (base["elements"] / base["ranks"])
+
+
+def print_table(benchmark, study, problem, runs):
+    print("")
+    print("{0}, {1} scaling: {2}".format(benchmark, study, problem))
+    header = "{0:>6} {1:>8} {2:>10}".format("nodes", "ranks", "elements")
+    for phase, _ in phases:
+        header += " {0:>10} {1:>6}".format(phase + " (s)", "eff.")
+    print(header)
+    print("-" * len(header))
+
+    lowest = 1.0
+    base = runs[0]
+    for run in runs:
+        line = "{0:>6} {1:>8} {2:>10}".format(run["nodes"], run["ranks"], run["elements"])
+        for phase, _ in phases:
+            e = efficiency(study, base, run, phase)
+            t = run["times"].get(phase)
+            line += " {0:>10} {1:>6}".format("-" if t is None else "{0:.3f}".format(t),
+                                             "-" if e is None else "{0:.2f}".format(e))
+            if e is not None:
+                lowest = min(lowest, e)
+        print(line)
+    return lowest
+
+
+def main():
+    args = parse_args()
+
+    if not os.path.isdir(args.input_dir):
+        print("ERROR: Given input directory does not exist: {0}".format(args.input_dir))
+        sys.exit(1)
+
+    # {(benchmark, study, problem): [run]}
+    studies = {}
+    for path in sorted(glob.glob(os.path.join(args.input_dir, "*.cali"))):
+        match = file_pattern.match(os.path.basename(path))
+        if match is None:
+            continue
+        times, metadata = read_run(path)
+        for problem, problem_times in times.items():
+            run = {"nodes": int(match.group("nodes")),
+                   "ranks": int(metadata.get("num_ranks", metadata.get("jobsize", 1))),
+                   "elements": int(metadata.get("elements", 1)),
+                   "times": problem_times}
+            key = (match.group("benchmark"), match.group("study"), problem)
+            studies.setdefault(key, []).append(run)
+
+    if not studies:
+        print("ERROR: No scaling runs found in: {0}".format(args.input_dir))
+        sys.exit(1)
+
+    lowest = 1.0
+    for (benchmark, study, problem), runs in sorted(studies.items()):
+        runs.sort(key=lambda run: run["nodes"])
+        lowest = min(lowest, print_table(benchmark, study, problem, runs))
+
+    if lowest < args.threshold:
+        print("")
+        print("ERROR: Parallel efficiency {0:.2f} is below the threshold {1:.2f}".format(lowest, args.threshold))
+        sys.exit(1)
+
+if __name__ == "__main__":
+    main()
+    sys.exit(0)
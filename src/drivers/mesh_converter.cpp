@@ -0,0 +1,84 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file mesh_converter.cpp
+ *
+ * @brief Converts a mesh file that mfem reads (e.g. an MFEM `.mesh` or an Exodus file) to serac's binary mesh format,
+ * optionally refining it and precomputing its partition for a number of ranks, see serac::mesh::writeBinaryMesh
+ *
+ * The conversion parses the mesh once, on a single rank, so that the runs that use the binary file only map it into
+ * memory (and, with a precomputed partition, each rank only reads its own part).
+ */
+
+#include <string>
+
+#include "axom/core.hpp"
+#include "mfem.hpp"
+
+#include "serac/infrastructure/initialize.hpp"
+#include "serac/infrastructure/logger.hpp"
+#include "serac/infrastructure/terminator.hpp"
+#include "serac/mesh/mesh_utils.hpp"
+
+int main(int argc, char* argv[])
+{
+  auto rank = serac::initialize(argc, argv).second;
+
+  axom::CLI::App app{"Converts a mesh file to serac's binary mesh format"};
+  std::string    input_file;
+  app.add_option("-i, --input-file", input_file, "Mesh file to convert")->required()->check(axom::CLI::ExistingFile);
+  std::string output_file;
+  app.add_option("-o, --output-file", output_file, "Binary mesh file to write")->required();
+  int serial_refinements = 0;
+  app.add_option("-r, --serial-refinements", serial_refinements, "Number of uniform refinements before writing");
+  int num_parts = 0;
+  app.add_option("-n, --parts", num_parts, "Number of ranks to precompute the partition for (none by default)");
+  std::string partitioner = "metis";
+  app.add_option("-p, --partitioner", partitioner, "Partitioning method (metis|metis-recursive|metis-volume|hilbert)");
+  bool reorder{false};
+  app.add_flag("--reorder", reorder, "Order the elements along a Hilbert curve before partitioning");
+
+  try {
+    app.parse(argc, argv);
+  } catch (const axom::CLI::ParseError& e) {
+    serac::logger::flush();
+    if (e.get_name() == "CallForHelp") {
+      SLIC_INFO_ROOT(app.help());
+      serac::exitGracefully();
+    } else {
+      SLIC_ERROR_ROOT(axom::CLI::FailureMessage::simple(&app, e));
+    }
+  }
+
+  serac::mesh::PartitionOptions partition;
+  partition.reorder = reorder;
+  if (partitioner == "metis") {
+    partition.method = serac::mesh::Partitioner::METISKway;
+  } else if (partitioner == "metis-recursive") {
+    partition.method = serac::mesh::Partitioner::METISRecursive;
+  } else if (partitioner == "metis-volume") {
+    partition.method = serac::mesh::Partitioner::METISVolume;
+  } else if (partitioner == "hilbert") {
+    partition.method = serac::mesh::Partitioner::HilbertCurve;
+  } else {
+    SLIC_ERROR_ROOT(axom::fmt::format("Unknown partitioner '{}'", partitioner));
+  }
+
+  // the whole mesh is converted by the first rank
+  if (rank == 0) {
+    mfem::Mesh mesh = serac::buildMeshFromFile(input_file);
+    for (int lev = 0; lev < serial_refinements; lev++) {
+      mesh.UniformRefinement();
+    }
+
+    serac::mesh::writeBinaryMesh(mesh, output_file, num_parts, partition);
+    SLIC_INFO(axom::fmt::format("Wrote {} elements to '{}'{}", mesh.GetNE(), output_file,
+                                (num_parts > 0) ? axom::fmt::format(" in {} parts", num_parts) : ""));
+  }
+
+  serac::exitGracefully();
+}
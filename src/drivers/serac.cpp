@@ -14,18 +14,24 @@
 
 #include <fstream>
 #include <iostream>
+#include <map>
 #include <memory>
+#include <optional>
+#include <sstream>
 #include <string>
+#include <utility>
 
 #include "axom/core.hpp"
 #include "mfem.hpp"
 
 #include "serac/infrastructure/about.hpp"
+#include "serac/infrastructure/accelerator.hpp"
 #include "serac/infrastructure/cli.hpp"
 #include "serac/infrastructure/initialize.hpp"
 #include "serac/infrastructure/input.hpp"
 #include "serac/infrastructure/logger.hpp"
 #include "serac/infrastructure/output.hpp"
+#include "serac/infrastructure/profiling.hpp"
 #include "serac/infrastructure/terminator.hpp"
 #include "serac/mesh/mesh_utils.hpp"
 #include "serac/physics/solid_mechanics.hpp"
@@ -65,114 +71,264 @@ void defineInputFileSchema(axom::inlet::Inlet& inlet)
   auto& thermal_solid_solver_table = inlet.addStruct("thermal_solid", "Thermal solid module");
   ThermomechanicsInputOptions::defineInputFileSchema(thermal_solid_solver_table);
 
-  // Verify the input file
-  if (!inlet.verify()) {
+  // The output file options
+  auto& output_table = inlet.addStruct("output", "Restart and visualization file options");
+  output_table.addInt("compression_level", "gzip level (0-9) of the restart and ParaView files.").defaultValue(0);
+  output_table
+      .addDouble("visualization_error_bound",
+                 "Pointwise error bound of the lossy compression of the ParaView fields, 0 for lossless output.")
+      .defaultValue(0.0);
+  output_table
+      .addInt("restart_writers_per_node",
+              "Number of restart files written per node, 0 for one file per rank (the ranks of a node share them).")
+      .defaultValue(0);
+  output_table.addInt("restart_cycle_interval", "Write a restart file every this many cycles, 0 to disable.")
+      .defaultValue(1);
+  output_table
+      .addBool("node_local_checkpoints",
+               "Write the restart files to node-local storage with SCR, and only some of them to the output directory.")
+      .defaultValue(false);
+  output_table.addString("checkpoint_cache", "Node-local directory of the SCR checkpoints, SCR's default if not set.");
+  output_table
+      .addString("checkpoint_redundancy", "Protection of the SCR checkpoints from node loss: SINGLE, PARTNER or XOR.")
+      .defaultValue("PARTNER");
+  output_table.addInt("checkpoint_flush_interval", "Copy every this many SCR checkpoints to the output directory.")
+      .defaultValue(10);
+  output_table
+      .addDouble("restart_wall_interval", "Also write a restart file every this many wall-clock seconds, 0 to disable.")
+      .defaultValue(0.0);
+  output_table.addInt("visualization_cycle_interval", "Write the ParaView files every this many cycles, 0 to disable.")
+      .defaultValue(1);
+  output_table
+      .addInt("visualization_levels_of_detail",
+              "Subdivisions of each element in the ParaView files, 0 for the highest order of the fields.")
+      .defaultValue(0);
+  output_table
+      .addBool("visualization_high_order", "Write high-order ParaView cells instead of subdivided linear ones.")
+      .defaultValue(true);
+  output_table.addStringArray("visualization_fields", "Names of the fields in the ParaView files, all if not given.");
+  output_table
+      .addBool("stream_summary", "Append the summary of each cycle to summary.csv instead of writing it at the end.")
+      .defaultValue(false);
+  output_table.addInt("summary_flush_interval", "Flush summary.csv every this many cycles.").defaultValue(1);
+  output_table.addString("in_situ_actions", "Ascent actions file of the in-situ visualization, none if not given.");
+  output_table.addInt("in_situ_cycle_interval", "Run the in-situ visualization every this many cycles, 0 to disable.")
+      .defaultValue(1);
+  output_table
+      .addInt("counter_report_interval", "Log the hot-path counters every this many cycles, 0 for the last one only.")
+      .defaultValue(0);
+  output_table.addString("counter_file",
+                         "JSON file in the output directory that the hot-path counters of the run are written to at "
+                         "its end, none if not given.");
+
+  // The load balance monitoring options
+  auto& load_balance_table =
+      inlet.addStruct("load_balance", "Monitoring of the balance of the time step cost across the ranks");
+  load_balance_table
+      .addDouble("imbalance_threshold",
+                 "Checkpoint and report per-material element weights once the largest time step cost of a rank "
+                 "exceeds the mean cost by this factor, 0 to disable.")
+      .defaultValue(0.0);
+  load_balance_table.addInt("check_interval", "Measure the imbalance every this many cycles.").defaultValue(10);
+
+  // The ensemble options
+  auto& ensemble_table =
+      inlet.addStruct("ensemble", "Independent runs of the problem over sets of material parameters");
+  ensemble_table.addInt("num_groups", "Number of MPI sub-communicators the runs are distributed over.").defaultValue(1);
+  auto& parameter_sets_table =
+      ensemble_table.addStructArray("parameter_sets", "Solid material parameters of each run of the ensemble");
+  parameter_sets_table.addDouble("mu", "Shear modulus in the Neo-Hookean hyperelastic model.");
+  parameter_sets_table.addDouble("K", "Bulk modulus in the Neo-Hookean hyperelastic model.");
+  parameter_sets_table.addDouble("density", "Initial mass density");
+
+  // Verify the input file, which is the same on every rank, so only rank 0 checks it
+  if (!serac::input::verify(inlet, MPI_COMM_WORLD)) {
     SLIC_ERROR_ROOT("Input file failed to verify.");
   }
 }
 
-}  // namespace serac
+/**
+ * @brief Records the equation solver settings of a physics module of the input file as Adiak metadata, as
+ * "<block>.<setting>", so that the profiles of runs with different solvers can be told apart
+ *
+ * @param[in] inlet The inlet instance
+ * @param[in] block The path of the physics module block, e.g. "solid" or "thermal_solid/thermal_conduction"
+ */
+void setSolverMetadata([[maybe_unused]] axom::inlet::Inlet& inlet, [[maybe_unused]] const std::string& block)
+{
+  const std::string solver = block + "/equation_solver";
+  if (inlet[solver + "/linear/type"].get<std::string>() == "iterative") {
+    const std::string iterative = solver + "/linear/iterative_options";
+    SERAC_SET_METADATA(block + ".linear_solver", inlet[iterative + "/solver_type"].get<std::string>());
+    SERAC_SET_METADATA(block + ".preconditioner", inlet[iterative + "/prec_type"].get<std::string>());
+    SERAC_SET_METADATA(block + ".linear_relative_tol", inlet[iterative + "/rel_tol"].get<double>());
+    SERAC_SET_METADATA(block + ".linear_max_iterations", inlet[iterative + "/max_iter"].get<int>());
+  } else {
+    SERAC_SET_METADATA(block + ".linear_solver", std::string("direct"));
+  }
+
+  if (inlet.contains(solver + "/nonlinear")) {
+    SERAC_SET_METADATA(block + ".nonlinear_solver", inlet[solver + "/nonlinear/solver_type"].get<std::string>());
+    SERAC_SET_METADATA(block + ".nonlinear_relative_tol", inlet[solver + "/nonlinear/rel_tol"].get<double>());
+    SERAC_SET_METADATA(block + ".nonlinear_absolute_tol", inlet[solver + "/nonlinear/abs_tol"].get<double>());
+    SERAC_SET_METADATA(block + ".nonlinear_max_iterations", inlet[solver + "/nonlinear/max_iter"].get<int>());
+  }
+}
 
 /**
- * @brief Constructs the appropriate physics object using the input file options
+ * @brief Records the configuration of the run as Adiak metadata: the input file, the number of ranks and threads,
+ * the order, and the solver settings of each physics module, so that the profiles of many runs can be compared
  *
+ * @param[in] inlet The inlet instance
+ * @param[in] input_file_path The path of the input file
  * @param[in] order The order of the discretization
- * @param[in] dim The spatial dimension of the mesh
+ */
+void setRunMetadata([[maybe_unused]] axom::inlet::Inlet& inlet, [[maybe_unused]] const std::string& input_file_path,
+                    [[maybe_unused]] int order)
+{
+  [[maybe_unused]] auto [num_ranks, rank] = getMPIInfo();
+  [[maybe_unused]] int  num_threads       = 1;
+#if defined(SERAC_USE_OPENMP) && defined(_OPENMP)
+  num_threads = omp_get_max_threads();
+#endif
+
+  SERAC_SET_METADATA("input_file", input_file_path);
+  SERAC_SET_METADATA("num_ranks", num_ranks);
+  SERAC_SET_METADATA("num_threads", num_threads);
+  SERAC_SET_METADATA("order", order);
+
+  for (const char* block : {"solid", "thermal_conduction", "thermal_solid/solid", "thermal_solid/thermal_conduction"}) {
+    if (inlet.isUserProvided(block)) {
+      setSolverMetadata(inlet, block);
+    }
+  }
+}
+
+/// When the balance of the time step cost across the ranks is measured, and what is done once it is off
+struct LoadBalanceOptions {
+  /// The largest time step cost of a rank over the mean cost past which the run is checkpointed, 0 to disable
+  double imbalance_threshold = 0.0;
+
+  /// The number of cycles over which the time step costs are accumulated between measurements
+  int check_interval = 10;
+};
+
+/// The solid material parameters of one run of an ensemble, which override those of the input file when given
+struct EnsembleParameters {
+  /// The shear modulus
+  std::optional<double> mu;
+
+  /// The bulk modulus
+  std::optional<double> K;
+
+  /// The initial mass density
+  std::optional<double> density;
+
+  /**
+   * @brief Override the material parameters of the solid options with the given ones
+   *
+   * @param[inout] solid_options The solid mechanics input options of the run
+   */
+  void apply(SolidMechanicsInputOptions& solid_options) const
+  {
+    solid_options.mu                   = mu.value_or(solid_options.mu);
+    solid_options.K                    = K.value_or(solid_options.K);
+    solid_options.initial_mass_density = density.value_or(solid_options.initial_mass_density);
+  }
+};
+
+}  // namespace serac
+
+/**
+ * @brief Prototype the specialization for Inlet parsing
+ *
+ * @tparam The object to be created by Inlet
+ */
+template <>
+struct FromInlet<serac::EnsembleParameters> {
+  /// @brief Returns created object from Inlet container
+  serac::EnsembleParameters operator()(const axom::inlet::Container& base)
+  {
+    serac::EnsembleParameters result;
+    if (base.contains("mu")) {
+      result.mu = base["mu"];
+    }
+    if (base.contains("K")) {
+      result.K = base["K"];
+    }
+    if (base.contains("density")) {
+      result.density = base["density"];
+    }
+    return result;
+  }
+};
+
+/// The polynomial orders of the discretizations the driver is compiled for
+using DriverOrders = std::integer_sequence<int, 1, 2, 3, 4, 5, 6, 7, 8>;
+
+/// The highest polynomial order of the discretizations the driver is compiled for
+constexpr int max_order = static_cast<int>(DriverOrders::size());
+
+/**
+ * @brief Constructs the appropriate physics object of a given order and dimension using the input file options
+ *
+ * @tparam order The order of the discretization
+ * @tparam dim The spatial dimension of the mesh
  * @param[in] solid_mechanics_options Optional container of input options for SolidMechanics physics module
  * @param[in] heat_transfer_options   Optional container of input options for HeatTransfer physics module
  * @param[in] thermomechanics_options Optional container of input options for Thermomechanics physics module
  *
  * @return Base class instance of the created physics class
  */
+template <int order, int dim>
 std::unique_ptr<serac::BasePhysics> createPhysics(
-    int dim, int order, std::optional<serac::SolidMechanicsInputOptions> solid_mechanics_options,
-    std::optional<serac::HeatTransferInputOptions>    heat_transfer_options,
-    std::optional<serac::ThermomechanicsInputOptions> thermomechanics_options)
+    const std::optional<serac::SolidMechanicsInputOptions>&  solid_mechanics_options,
+    const std::optional<serac::HeatTransferInputOptions>&    heat_transfer_options,
+    const std::optional<serac::ThermomechanicsInputOptions>& thermomechanics_options)
 {
-  std::unique_ptr<serac::BasePhysics> main_physics;
   if (thermomechanics_options) {
-    if (order == 1) {
-      if (dim == 2) {
-        main_physics = std::make_unique<serac::Thermomechanics<1, 2>>(*thermomechanics_options);
-      } else if (dim == 3) {
-        main_physics = std::make_unique<serac::Thermomechanics<1, 3>>(*thermomechanics_options);
-      }
-    } else if (order == 2) {
-      if (dim == 2) {
-        main_physics = std::make_unique<serac::Thermomechanics<2, 2>>(*thermomechanics_options);
-      } else if (dim == 3) {
-        main_physics = std::make_unique<serac::Thermomechanics<2, 3>>(*thermomechanics_options);
-      }
-    } else if (order == 3) {
-      if (dim == 2) {
-        main_physics = std::make_unique<serac::Thermomechanics<3, 2>>(*thermomechanics_options);
-      } else if (dim == 3) {
-        main_physics = std::make_unique<serac::Thermomechanics<3, 3>>(*thermomechanics_options);
-      }
-    }
+    return std::make_unique<serac::Thermomechanics<order, dim>>(*thermomechanics_options);
   } else if (solid_mechanics_options && heat_transfer_options) {
-    if (order == 1) {
-      if (dim == 2) {
-        main_physics = std::make_unique<serac::Thermomechanics<1, 2>>(*heat_transfer_options, *solid_mechanics_options);
-      } else if (dim == 3) {
-        main_physics = std::make_unique<serac::Thermomechanics<1, 3>>(*heat_transfer_options, *solid_mechanics_options);
-      }
-    } else if (order == 2) {
-      if (dim == 2) {
-        main_physics = std::make_unique<serac::Thermomechanics<2, 2>>(*heat_transfer_options, *solid_mechanics_options);
-      } else if (dim == 3) {
-        main_physics = std::make_unique<serac::Thermomechanics<2, 3>>(*heat_transfer_options, *solid_mechanics_options);
-      }
-    } else if (order == 3) {
-      if (dim == 2) {
-        main_physics = std::make_unique<serac::Thermomechanics<3, 2>>(*heat_transfer_options, *solid_mechanics_options);
-      } else if (dim == 3) {
-        main_physics = std::make_unique<serac::Thermomechanics<3, 3>>(*heat_transfer_options, *solid_mechanics_options);
-      }
-    }
+    return std::make_unique<serac::Thermomechanics<order, dim>>(*heat_transfer_options, *solid_mechanics_options);
   } else if (solid_mechanics_options) {
-    if (order == 1) {
-      if (dim == 2) {
-        main_physics = std::make_unique<serac::SolidMechanics<1, 2>>(*solid_mechanics_options);
-      } else if (dim == 3) {
-        main_physics = std::make_unique<serac::SolidMechanics<1, 3>>(*solid_mechanics_options);
-      }
-    } else if (order == 2) {
-      if (dim == 2) {
-        main_physics = std::make_unique<serac::SolidMechanics<2, 2>>(*solid_mechanics_options);
-      } else if (dim == 3) {
-        main_physics = std::make_unique<serac::SolidMechanics<2, 3>>(*solid_mechanics_options);
-      }
-    } else if (order == 3) {
-      if (dim == 2) {
-        main_physics = std::make_unique<serac::SolidMechanics<3, 2>>(*solid_mechanics_options);
-      } else if (dim == 3) {
-        main_physics = std::make_unique<serac::SolidMechanics<3, 3>>(*solid_mechanics_options);
-      }
-    }
+    return std::make_unique<serac::SolidMechanics<order, dim>>(*solid_mechanics_options);
   } else if (heat_transfer_options) {
-    if (order == 1) {
-      if (dim == 2) {
-        main_physics = std::make_unique<serac::HeatTransfer<1, 2>>(*heat_transfer_options);
-      } else if (dim == 3) {
-        main_physics = std::make_unique<serac::HeatTransfer<1, 3>>(*heat_transfer_options);
-      }
-    } else if (order == 2) {
-      if (dim == 2) {
-        main_physics = std::make_unique<serac::HeatTransfer<2, 2>>(*heat_transfer_options);
-      } else if (dim == 3) {
-        main_physics = std::make_unique<serac::HeatTransfer<2, 3>>(*heat_transfer_options);
-      }
-    } else if (order == 3) {
-      if (dim == 2) {
-        main_physics = std::make_unique<serac::HeatTransfer<3, 2>>(*heat_transfer_options);
-      } else if (dim == 3) {
-        main_physics = std::make_unique<serac::HeatTransfer<3, 3>>(*heat_transfer_options);
-      }
-    }
-  } else {
-    SLIC_ERROR_ROOT("Neither solid, thermal_conduction, nor thermal_solid blocks specified in the input file.");
+    return std::make_unique<serac::HeatTransfer<order, dim>>(*heat_transfer_options);
   }
+  SLIC_ERROR_ROOT("Neither solid, thermal_conduction, nor thermal_solid blocks specified in the input file.");
+  return nullptr;
+}
+
+/**
+ * @brief Constructs the appropriate physics object using the input file options
+ *
+ * @tparam orders The orders of the discretization the driver is compiled for
+ * @param[in] dim The spatial dimension of the mesh
+ * @param[in] order The order of the discretization
+ * @param[in] solid_mechanics_options Optional container of input options for SolidMechanics physics module
+ * @param[in] heat_transfer_options   Optional container of input options for HeatTransfer physics module
+ * @param[in] thermomechanics_options Optional container of input options for Thermomechanics physics module
+ *
+ * @return Base class instance of the created physics class
+ */
+template <int... orders>
+std::unique_ptr<serac::BasePhysics> createPhysics(
+    std::integer_sequence<int, orders...>, int dim, int order,
+    const std::optional<serac::SolidMechanicsInputOptions>&  solid_mechanics_options,
+    const std::optional<serac::HeatTransferInputOptions>&    heat_transfer_options,
+    const std::optional<serac::ThermomechanicsInputOptions>& thermomechanics_options)
+{
+  std::unique_ptr<serac::BasePhysics> main_physics;
+  (
+      [&]() {
+        if (order == orders) {
+          main_physics = (dim == 2) ? createPhysics<orders, 2>(solid_mechanics_options, heat_transfer_options,
+                                                               thermomechanics_options)
+                                    : createPhysics<orders, 3>(solid_mechanics_options, heat_transfer_options,
+                                                               thermomechanics_options);
+        }
+      }(),
+      ...);
   return main_physics;
 }
 
@@ -209,11 +365,143 @@ int getOrder(std::optional<serac::SolidMechanicsInputOptions>  solid_mechanics_o
   } else {
     SLIC_ERROR_ROOT("Neither solid, thermal_conduction, nor thermal_solid blocks specified in the input file.");
   }
-  SLIC_ERROR_ROOT_IF(order < 1 || order > 3,
-                     axom::fmt::format("Invalid solver order '{0}' given. Valid values are 1, 2, or 3.", order));
+  SLIC_ERROR_ROOT_IF(order < 1 || order > max_order,
+                     axom::fmt::format("Invalid solver order '{0}' given. Valid values are 1 through {1}.", order,
+                                       max_order));
   return order;
 }
 
+/**
+ * @brief Constructs the physics module on the StateManager mesh and runs its time step loop
+ *
+ * @param[in] order The order of the discretization
+ * @param[in] solid_mechanics_options Optional container of input options for SolidMechanics physics module
+ * @param[in] heat_transfer_options   Optional container of input options for HeatTransfer physics module
+ * @param[in] thermomechanics_options Optional container of input options for Thermomechanics physics module
+ * @param[in] t The initial time
+ * @param[in] t_final The final time
+ * @param[in] dt The time step
+ * @param[in] cycle The initial cycle
+ * @param[inout] datastore The datastore holding the summary data of the run
+ * @param[in] paraview_output_dir The optional directory of the visualization files
+ * @param[in] output_policy When the restart and visualization files are written
+ * @param[in] load_balance When the balance of the time step cost across the ranks is measured
+ * @param[in] counter_report_interval Log the hot-path counters every this many cycles, 0 for the last one only
+ */
+void runSimulation(int order, std::optional<serac::SolidMechanicsInputOptions> solid_mechanics_options,
+                   std::optional<serac::HeatTransferInputOptions>    heat_transfer_options,
+                   std::optional<serac::ThermomechanicsInputOptions> thermomechanics_options, double t, double t_final,
+                   double dt, int cycle, axom::sidre::DataStore& datastore,
+                   const std::optional<std::string>& paraview_output_dir, const serac::OutputPolicy& output_policy,
+                   const LoadBalanceOptions& load_balance, int counter_report_interval)
+{
+  // Get dimension of problem
+  int dim = serac::StateManager::mesh().Dimension();
+  SLIC_ERROR_ROOT_IF(dim < 2 || dim > 3,
+                     axom::fmt::format("Invalid mesh dimension '{0}' provided. Valid values are 2 or 3.", dim));
+
+  SERAC_SET_METADATA("dimension", dim);
+  SERAC_SET_METADATA("elements", static_cast<long>(serac::StateManager::mesh().GetGlobalNE()));
+
+  // The phases of the run are timed by hot-path counters, so that they are reported (and written to the counter
+  // file) along with those of the subsystems
+  std::unique_ptr<serac::BasePhysics> main_physics;
+  {
+    SERAC_TIME_SCOPE("Driver setup");
+
+    // Create the physics object
+    main_physics = createPhysics(DriverOrders{}, dim, order, solid_mechanics_options, heat_transfer_options,
+                                 thermomechanics_options);
+
+    // Complete the solver setup
+    main_physics->completeSetup();
+  }
+
+  // Update physics time and cycle
+  main_physics->setTime(t);
+  main_physics->setCycle(cycle);
+  main_physics->setOutputPolicy(output_policy);
+
+  main_physics->initializeSummary(datastore, t_final, dt);
+
+  // The wall time of the time steps on this rank since the last load balance measurement
+  double step_cost          = 0.0;
+  int    measured_steps     = 0;
+  bool   imbalance_reported = false;
+
+  // Enter the time step loop.
+  bool last_step = false;
+  while (!last_step) {
+    // Flush all messages held by the logger
+    serac::logger::flush();
+
+    // Compute the real timestep. This may be less than dt for the last timestep.
+    double dt_real = std::min(dt, t_final - t);
+
+    // Solve the physics module appropriately. With adaptive timestepping, dt_real returns the timestep taken.
+    const double step_start = MPI_Wtime();
+    {
+      SERAC_TIME_SCOPE("Driver time steps");
+      main_physics->advanceTimestep(dt_real);
+    }
+    step_cost += MPI_Wtime() - step_start;
+    measured_steps++;
+
+    // Compute current time
+    t = t + dt_real;
+
+    // Print the timestep information
+    SLIC_INFO_ROOT("step " << cycle << ", t = " << t);
+
+    // Determine if this is the last timestep
+    last_step = (t >= t_final - 1e-8 * dt);
+
+    // Once the cost per rank (e.g. of growing plastic zones) is out of balance, checkpoint so that the run can be
+    // restarted on a mesh partitioned by the measured cost of each material
+    bool checkpoint = false;
+    if (load_balance.imbalance_threshold > 0.0 && measured_steps >= load_balance.check_interval) {
+      const auto&  mesh      = serac::StateManager::mesh();
+      const double imbalance = serac::mesh::loadImbalance(step_cost, mesh.GetComm());
+      SLIC_INFO_ROOT(axom::fmt::format("load imbalance over the last {0} steps: {1:.3f}", measured_steps, imbalance));
+      if (imbalance > load_balance.imbalance_threshold && !imbalance_reported) {
+        const auto  weights = serac::mesh::estimateAttributeWeights(mesh, step_cost);
+        std::string element_weights;
+        for (int a = 0; a < mesh.attributes.Size(); a++) {
+          element_weights += axom::fmt::format("{0}[{1}] = {2:.4g}", a == 0 ? "" : ", ", mesh.attributes[a],
+                                               weights.at(mesh.attributes[a]));
+        }
+        SLIC_WARNING_ROOT(axom::fmt::format(
+            "Load imbalance {0:.3f} exceeds the threshold {1}, writing a checkpoint at cycle {2}. Restart from it "
+            "with main_mesh partitioner = \"hilbert\" and element_weights = {{{3}}} to rebalance the run.",
+            imbalance, load_balance.imbalance_threshold, cycle, element_weights));
+        checkpoint         = true;
+        imbalance_reported = true;
+      }
+      step_cost      = 0.0;
+      measured_steps = 0;
+    }
+
+    {
+      SERAC_TIME_SCOPE("Driver output");
+
+      // Output the restart and visualization files due this cycle, and all of them after the last step
+      main_physics->outputState(paraview_output_dir, last_step || checkpoint);
+
+      // Save curve data to Sidre datastore to be output later
+      main_physics->saveSummary(datastore, t);
+    }
+
+    // The counters accumulate over the whole run
+    if (last_step || (counter_report_interval > 0 && cycle % counter_report_interval == 0)) {
+      serac::profiling::reportCounters(serac::StateManager::mesh().GetComm(),
+                                       axom::fmt::format("Counters (cycle {})", cycle));
+    }
+
+    // Increment cycle
+    cycle++;
+  }
+}
+
 /**
  * @brief The main serac driver code
  *
@@ -226,14 +514,6 @@ int main(int argc, char* argv[])
 {
   serac::initialize(argc, argv);
 
-  // TODO: Remove this after input file functionality is restored.
-  const std::string warning_message = R"PREFIX(******************************
-This Serac driver does not
-currently work due to missing
-input file functionality.
-******************************)PREFIX";
-  SLIC_INFO(warning_message);
-
   // Handle Command line
   std::unordered_map<std::string, std::string> cli_opts =
       serac::cli::defineAndParse(argc, argv, "Serac: a high order nonlinear thermomechanical simulation code");
@@ -250,6 +530,25 @@ input file functionality.
   serac::printRunInfo();
   serac::cli::printGiven(cli_opts);
 
+  // The profiler started by serac::initialize() uses the default configuration
+  if (auto caliper = cli_opts.find("caliper"); caliper != cli_opts.end()) {
+    serac::profiling::configure(serac::profiling::caliperConfig(caliper->second));
+    SERAC_SET_METADATA("caliper", caliper->second);
+  }
+
+  if (auto pools = cli_opts.find("memory-pools"); pools != cli_opts.end()) {
+    serac::accelerator::MemoryPools memory_pools;
+    std::stringstream               kinds(pools->second);
+    for (std::string kind; std::getline(kinds, kind, ',');) {
+      SLIC_ERROR_ROOT_IF(kind != "host" && kind != "device" && kind != "pinned",
+                         axom::fmt::format("Unknown kind of memory pool '{}'", kind));
+      memory_pools.host   = memory_pools.host || (kind == "host");
+      memory_pools.device = memory_pools.device || (kind == "device");
+      memory_pools.pinned = memory_pools.pinned || (kind == "pinned");
+    }
+    serac::accelerator::initializeMemoryPools(memory_pools);
+  }
+
   // Read input file
   std::string input_file_path = "";
   auto        search          = cli_opts.find("input-file");
@@ -289,9 +588,12 @@ input file functionality.
 
   // Intialize MFEMSidreDataCollection
   serac::StateManager::initialize(datastore, output_directory);
+  serac::StateManager::enableAsyncSaves(cli_opts.find("async-save") != cli_opts.end());
+  serac::StateManager::enableIncrementalSaves(cli_opts.find("incremental-save") != cli_opts.end());
 
-  // Initialize Inlet and read input file
-  auto inlet = serac::input::initialize(datastore, input_file_path);
+  // Initialize Inlet and read input file, only on rank 0 so the filesystem is not hit by every rank at startup
+  auto inlet =
+      serac::input::initialize(datastore, input_file_path, serac::input::Language::Lua, "input_file", MPI_COMM_WORLD);
   serac::defineInputFileSchema(inlet);
 
   // Optionally, create input file documentation and quit
@@ -306,28 +608,71 @@ input file functionality.
   std::string input_values_path = axom::utilities::filesystem::joinPath(output_directory, "serac_input_values.json");
   datastore.getRoot()->getGroup("input_file")->save(input_values_path, "json");
 
+  // Set the compression of the output files
+  serac::OutputCompression compression;
+  compression.lossless_level            = inlet["output/compression_level"];
+  compression.visualization_error_bound = inlet["output/visualization_error_bound"];
+  serac::StateManager::setOutputCompression(compression);
+  serac::StateManager::setRestartWritersPerNode(inlet["output/restart_writers_per_node"]);
+
+  // Optionally write the restart files to node-local storage, which the restart below reads from as well
+  const bool node_local_checkpoints = inlet["output/node_local_checkpoints"];
+  if (node_local_checkpoints) {
+    serac::NodeLocalCheckpointOptions checkpoint_options;
+    if (inlet.contains("output/checkpoint_cache")) {
+      checkpoint_options.cache_directory = inlet["output/checkpoint_cache"].get<std::string>();
+    }
+    checkpoint_options.redundancy     = inlet["output/checkpoint_redundancy"].get<std::string>();
+    checkpoint_options.flush_interval = inlet["output/checkpoint_flush_interval"];
+    serac::StateManager::enableNodeLocalCheckpoints(checkpoint_options);
+  }
+
+  // Set when the restart and visualization files are written
+  serac::OutputPolicy output_policy;
+  output_policy.restart_cycle_interval         = inlet["output/restart_cycle_interval"];
+  output_policy.restart_wall_interval          = inlet["output/restart_wall_interval"];
+  output_policy.visualization_cycle_interval   = inlet["output/visualization_cycle_interval"];
+  output_policy.visualization_levels_of_detail = inlet["output/visualization_levels_of_detail"];
+  output_policy.visualization_high_order       = inlet["output/visualization_high_order"];
+  if (inlet.contains("output/visualization_fields")) {
+    for (const auto& [idx, field] : inlet["output/visualization_fields"].get<std::unordered_map<int, std::string>>()) {
+      output_policy.visualization_fields.push_back(field);
+    }
+  }
+  output_policy.in_situ_cycle_interval = inlet["output/in_situ_cycle_interval"];
+  output_policy.summary_flush_interval = inlet["output/summary_flush_interval"];
+  const bool stream_summary            = inlet["output/stream_summary"];
+  if (stream_summary) {
+    output_policy.summary_file = axom::utilities::filesystem::joinPath(output_directory, "summary.csv");
+  }
+
+  // Set when the balance of the time step cost is measured
+  LoadBalanceOptions load_balance;
+  load_balance.imbalance_threshold = inlet["load_balance/imbalance_threshold"];
+  load_balance.check_interval      = inlet["load_balance/check_interval"];
+  SLIC_ERROR_ROOT_IF(load_balance.check_interval < 1, "The load balance check_interval must be positive.");
+
+  // Set when the hot-path counters are logged, and where they are written at the end of the run
+  const int                  counter_report_interval = inlet["output/counter_report_interval"];
+  std::optional<std::string> counter_file;
+  if (inlet.contains("output/counter_file")) {
+    counter_file =
+        axom::utilities::filesystem::joinPath(output_directory, inlet["output/counter_file"].get<std::string>());
+  }
+
+  // Optionally visualize the state in situ, reenabled after each StateManager::reset()
+  std::optional<std::string> in_situ_actions;
+  if (inlet.contains("output/in_situ_actions")) {
+    in_situ_actions = inlet["output/in_situ_actions"].get<std::string>();
+    serac::StateManager::enableInSitu(*in_situ_actions);
+  }
+
   // Initialize/set the time information
   double t       = 0;
   double t_final = inlet["t_final"];
   double dt      = inlet["dt"];
   int    cycle   = 1;
 
-  // Not restarting, so we need to create the mesh and register it with the StateManager
-  if (!restart_cycle) {
-    // Build the mesh
-    auto mesh_options = inlet["main_mesh"].get<serac::mesh::InputOptions>();
-    if (const auto file_opts = std::get_if<serac::mesh::FileInputOptions>(&mesh_options.extra_options)) {
-      file_opts->absolute_mesh_file_name =
-          serac::input::findMeshFilePath(file_opts->relative_mesh_file_name, input_file_path);
-    }
-    auto mesh = serac::mesh::buildParallelMesh(mesh_options);
-    serac::StateManager::setMesh(std::move(mesh));
-  } else {
-    // If restart_cycle is non-empty, then this is a restart run and the data will be loaded here
-    t     = serac::StateManager::load(*restart_cycle);
-    cycle = *restart_cycle;
-  }
-
   // Create nullable containers for the solid and thermal input file options
   std::optional<serac::SolidMechanicsInputOptions>  solid_mechanics_options;
   std::optional<serac::HeatTransferInputOptions>    heat_transfer_options;
@@ -344,58 +689,136 @@ input file functionality.
     thermomechanics_options = inlet["thermal_solid"].get<serac::ThermomechanicsInputOptions>();
   }
 
-  // Get dimension and order of problem
-  int dim = serac::StateManager::mesh().Dimension();
-  SLIC_ERROR_ROOT_IF(dim < 2 || dim > 3,
-                     axom::fmt::format("Invalid mesh dimension '{0}' provided. Valid values are 2 or 3.", dim));
   int order = getOrder(solid_mechanics_options, heat_transfer_options, thermomechanics_options);
 
-  // Create the physics object
-  auto main_physics =
-      createPhysics(dim, order, solid_mechanics_options, heat_transfer_options, thermomechanics_options);
-
-  // Complete the solver setup
-  main_physics->completeSetup();
+  // Record the configuration of the run, so that the profiles of different runs can be compared in bulk
+  serac::setRunMetadata(inlet, input_file_path, order);
 
-  // Update physics time and cycle
-  main_physics->setTime(t);
-  main_physics->setCycle(cycle);
+  // Read the mesh options, resolving the mesh file path relative to the input file, and the mesh cache directory
+  // relative to the output directory
+  auto get_mesh_options = [&inlet, &input_file_path, &output_directory]() {
+    auto mesh_options = inlet["main_mesh"].get<serac::mesh::InputOptions>();
+    if (!mesh_options.cache_directory.empty() && mesh_options.cache_directory.front() != '/') {
+      mesh_options.cache_directory =
+          axom::utilities::filesystem::joinPath(output_directory, mesh_options.cache_directory);
+    }
+    if (const auto file_opts = std::get_if<serac::mesh::FileInputOptions>(&mesh_options.extra_options)) {
+      if (file_opts->partitioned) {
+        // resolve the prefix of the files from the one of rank 0
+        const std::string suffix = ".000000";
+        std::string       first  = serac::input::findMeshFilePath(file_opts->relative_mesh_file_name + suffix,
+                                                           input_file_path);
+        file_opts->absolute_mesh_file_name = first.substr(0, first.size() - suffix.size());
+      } else {
+        file_opts->absolute_mesh_file_name =
+            serac::input::findMeshFilePath(file_opts->relative_mesh_file_name, input_file_path);
+      }
+    }
+    return mesh_options;
+  };
+
+  if (inlet.isUserProvided("ensemble")) {
+    SLIC_ERROR_ROOT_IF(restart_cycle, "Restarting an ensemble run is not supported");
+    SLIC_ERROR_ROOT_IF(node_local_checkpoints, "Node-local checkpoints of an ensemble run are not supported");
+    SLIC_ERROR_ROOT_IF(!solid_mechanics_options && !thermomechanics_options,
+                       "Ensemble runs require a solid or thermal_solid block in the input file");
+
+    auto parameter_sets =
+        inlet["ensemble/parameter_sets"].get<std::unordered_map<int, serac::EnsembleParameters>>();
+
+    // Order the runs by their index in the input file
+    std::map<int, serac::EnsembleParameters> ordered_parameter_sets(parameter_sets.begin(), parameter_sets.end());
+
+    auto [world_size, world_rank] = serac::getMPIInfo();
+    int num_groups                = inlet["ensemble/num_groups"];
+    SLIC_ERROR_ROOT_IF(num_groups < 1 || num_groups > world_size,
+                       axom::fmt::format("Invalid number of ensemble groups '{0}' given for {1} MPI ranks.",
+                                         num_groups, world_size));
+
+    // Contiguous blocks of ranks form each group, so that a group stays on as few nodes as possible
+    int      group = static_cast<int>(static_cast<long long>(world_rank) * num_groups / world_size);
+    MPI_Comm group_comm;
+    MPI_Comm_split(MPI_COMM_WORLD, group, world_rank, &group_comm);
+
+    // The mesh is read, refined and partitioned once per group, and copied for each of its runs
+    auto group_mesh = serac::mesh::buildParallelMesh(get_mesh_options(), group_comm);
+
+    int run = 0;
+    for (const auto& [index, parameters] : ordered_parameter_sets) {
+      if (run++ % num_groups != group) {
+        continue;
+      }
 
-  main_physics->initializeSummary(datastore, t_final, dt);
+      // Each run writes into its own directory, and has its own datastore for the state and summary data
+      std::string run_directory =
+          axom::utilities::filesystem::joinPath(output_directory, axom::fmt::format("ensemble_{0}", index));
+      axom::utilities::filesystem::makeDirsForPath(run_directory);
 
-  // Enter the time step loop.
-  bool last_step = false;
-  while (!last_step) {
-    // Flush all messages held by the logger
-    serac::logger::flush();
+      std::optional<std::string> run_paraview_dir;
+      if (paraview_output_dir) {
+        run_paraview_dir = axom::utilities::filesystem::joinPath(*paraview_output_dir,
+                                                                 axom::fmt::format("ensemble_{0}", index));
+        axom::utilities::filesystem::makeDirsForPath(*run_paraview_dir);
+      }
 
-    // Compute the real timestep. This may be less than dt for the last timestep.
-    double dt_real = std::min(dt, t_final - t);
+      auto run_solid_options           = solid_mechanics_options;
+      auto run_thermomechanics_options = thermomechanics_options;
+      if (run_solid_options) {
+        parameters.apply(*run_solid_options);
+      }
+      if (run_thermomechanics_options) {
+        parameters.apply(run_thermomechanics_options->solid_options);
+      }
 
-    // Compute current time
-    t = t + dt_real;
+      auto run_output_policy = output_policy;
+      if (stream_summary) {
+        run_output_policy.summary_file = axom::utilities::filesystem::joinPath(run_directory, "summary.csv");
+      }
 
-    // Print the timestep information
-    SLIC_INFO_ROOT("step " << cycle << ", t = " << t);
+      axom::sidre::DataStore run_datastore;
+      serac::StateManager::initialize(run_datastore, run_directory);
+      if (in_situ_actions) {
+        serac::StateManager::enableInSitu(*in_situ_actions);
+      }
+      serac::StateManager::setMesh(std::make_unique<mfem::ParMesh>(*group_mesh));
 
-    // Solve the physics module appropriately
-    main_physics->advanceTimestep(dt_real);
+      runSimulation(order, run_solid_options, heat_transfer_options, run_thermomechanics_options, t, t_final, dt,
+                    cycle, run_datastore, run_paraview_dir, run_output_policy, load_balance, counter_report_interval);
 
-    // Output a visualization file
-    main_physics->outputState(paraview_output_dir);
+      serac::output::outputSummary(run_datastore, run_directory, serac::output::FileFormat::JSON, group_comm);
+      serac::StateManager::reset();
+    }
 
-    // Save curve data to Sidre datastore to be output later
-    main_physics->saveSummary(datastore, t);
+    MPI_Comm_free(&group_comm);
+    serac::exitGracefully();
+  }
 
-    // Determine if this is the last timestep
-    last_step = (t >= t_final - 1e-8 * dt);
+  // Not restarting, so we need to create the mesh and register it with the StateManager
+  if (!restart_cycle) {
+    SERAC_TIME_SCOPE("Driver mesh");
 
-    // Increment cycle
-    cycle++;
+    // Build the mesh
+    auto mesh = serac::mesh::buildParallelMesh(get_mesh_options());
+    serac::StateManager::setMesh(std::move(mesh));
+  } else {
+    // If restart_cycle is non-empty, then this is a restart run and the data will be loaded here
+    t     = serac::StateManager::load(*restart_cycle);
+    cycle = *restart_cycle;
   }
 
+  runSimulation(order, solid_mechanics_options, heat_transfer_options, thermomechanics_options, t, t_final, dt, cycle,
+                datastore, paraview_output_dir, output_policy, load_balance, counter_report_interval);
+
+  // The last restart file may still be being written, and the last checkpoint may still be node-local only
+  serac::StateManager::waitForPendingSaves();
+  serac::StateManager::disableNodeLocalCheckpoints();
+
   // Output summary file (basic run info and curve data)
   serac::output::outputSummary(datastore, output_directory);
 
+  if (counter_file) {
+    serac::profiling::writeCounters(MPI_COMM_WORLD, *counter_file);
+  }
+
   serac::exitGracefully();
 }
@@ -6,10 +6,22 @@
 
 #include "serac/infrastructure/accelerator.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
 #include <memory>
+#include <vector>
+
+#include <sys/mman.h>
 
 #include "mfem.hpp"
 
+#include "serac/serac_config.hpp"
+#ifdef SERAC_USE_UMPIRE
+#include "umpire/ResourceManager.hpp"
+#include "umpire/strategy/QuickPool.hpp"
+#endif
+
 #include "serac/infrastructure/logger.hpp"
 
 namespace serac {
@@ -19,23 +31,327 @@ namespace accelerator {
 // Restrict global to this file only
 namespace {
 std::unique_ptr<mfem::Device> device;
+
+/// the (Umpire) allocator IDs of the memory pools for ExecutionSpace::CPU and ::GPU, negative when not pooled
+int host_pool_id   = -1;
+int device_pool_id = -1;
+
+/// how the large host arrays are allocated
+HostAllocation host_allocation;
+
+/// where the calculations in ExecutionSpace::Dynamic run
+DynamicDispatch dynamic_dispatch;
+
+/// the time to launch (and complete) an empty device kernel, in seconds
+double launch_overhead = 0.0;
+
+#if defined(__CUDACC__)
+/// the stream of the kernel graph being captured, or the default stream
+cudaStream_t launch_stream = nullptr;
+
+/// the streams of launchConcurrently(), and the events ordering them after and before the launching stream
+struct ConcurrentStreams {
+  std::vector<cudaStream_t> streams;
+  std::vector<cudaEvent_t>  joins;
+  cudaEvent_t               fork = nullptr;
+
+  void release()
+  {
+    for (auto stream : streams) cudaStreamDestroy(stream);
+    for (auto event : joins) cudaEventDestroy(event);
+    if (fork) cudaEventDestroy(fork);
+    streams.clear();
+    joins.clear();
+    fork = nullptr;
+  }
+};
+
+/// the streams are created the first time they are needed, and reused by every call
+ConcurrentStreams concurrent_streams;
+#endif
 }  // namespace
 
-void initializeDevice()
+#if defined(__CUDACC__)
+cudaStream_t launchStream() { return launch_stream; }
+#endif
+
+void initializeDevice([[maybe_unused]] bool gpu_aware_mpi)
 {
   SLIC_ERROR_ROOT_IF(device, "serac::accelerator::initializeDevice cannot be called more than once");
   device = std::make_unique<mfem::Device>();
 #ifdef MFEM_USE_CUDA
   device->Configure("cuda");
+  device->SetGPUAwareMPI(gpu_aware_mpi);
+#endif
+
+#if defined(__CUDACC__)
+  // the first launch also initializes the CUDA context, so it isn't timed
+  constexpr int launches = 100;
+  forall<ExecutionSpace::GPU>(1, [] SERAC_HOST_DEVICE(uint32_t) {});
+  cudaDeviceSynchronize();
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < launches; i++) {
+    forall<ExecutionSpace::GPU>(1, [] SERAC_HOST_DEVICE(uint32_t) {});
+    cudaDeviceSynchronize();
+  }
+  launch_overhead = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / launches;
 #endif
 }
 
 void terminateDevice()
 {
   // Idempotent, no adverse affects if called multiple times
+#if defined(__CUDACC__)
+  concurrent_streams.release();
+#endif
   device.reset();
+
+#ifdef SERAC_USE_UMPIRE
+  // free the unused blocks of the pools, which Umpire owns until the program exits
+  auto& rm = umpire::ResourceManager::getInstance();
+  for (int id : {host_pool_id, device_pool_id}) {
+    if (id >= 0) {
+      rm.getAllocator(id).release();
+    }
+  }
+#endif
+  host_pool_id   = -1;
+  device_pool_id = -1;
+}
+
+void initializeMemoryPools(const MemoryPools& pools)
+{
+#ifdef SERAC_USE_UMPIRE
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto pool_id = [&rm](const std::string& resource) {
+    const std::string name = "SERAC_" + resource + "_POOL";
+    if (!rm.isAllocator(name)) {
+      rm.makeAllocator<umpire::strategy::QuickPool>(name, rm.getAllocator(resource));
+    }
+    return rm.getAllocator(name).getId();
+  };
+
+#ifdef SERAC_USE_CUDA
+  if (pools.pinned) {
+    host_pool_id = pool_id("PINNED");
+  } else if (pools.host) {
+    host_pool_id = pool_id("HOST");
+  }
+  if (pools.device) {
+    device_pool_id = pool_id("DEVICE");
+  }
+#else
+  SLIC_WARNING_ROOT_IF(pools.device || pools.pinned, "Device and pinned memory pools require a CUDA build");
+  if (pools.host || pools.pinned) {
+    host_pool_id = pool_id("HOST");
+  }
+#endif
+#else
+  SLIC_WARNING_ROOT_IF(pools.host || pools.device || pools.pinned,
+                       "Memory pools require Serac to be built with Umpire");
+#endif
+}
+
+bool usesMemoryPool(ExecutionSpace exec)
+{
+  switch (exec) {
+    case ExecutionSpace::CPU:
+      return host_pool_id >= 0;
+    case ExecutionSpace::GPU:
+      return device_pool_id >= 0;
+    default:
+      return false;
+  }
+}
+
+int memoryPoolAllocatorID(ExecutionSpace exec)
+{
+  SLIC_ERROR_ROOT_IF(!usesMemoryPool(exec), "No memory pool was initialized for this execution space");
+  return (exec == ExecutionSpace::GPU) ? device_pool_id : host_pool_id;
+}
+
+void* allocateFromPool([[maybe_unused]] ExecutionSpace exec, [[maybe_unused]] std::size_t bytes)
+{
+#ifdef SERAC_USE_UMPIRE
+  return umpire::ResourceManager::getInstance().getAllocator(memoryPoolAllocatorID(exec)).allocate(bytes);
+#else
+  SLIC_ERROR_ROOT("Memory pools require Serac to be built with Umpire");
+  return nullptr;
+#endif
 }
 
+void deallocateFromPool([[maybe_unused]] void* ptr)
+{
+#ifdef SERAC_USE_UMPIRE
+  umpire::ResourceManager::getInstance().deallocate(ptr);
+#endif
+}
+
+void configureDynamicDispatch(const DynamicDispatch& options) { dynamic_dispatch = options; }
+
+const DynamicDispatch& dynamicDispatch() { return dynamic_dispatch; }
+
+double deviceLaunchOverhead() { return launch_overhead; }
+
+ExecutionSpace selectExecutionSpace(uint32_t num_elements, double flops_per_element)
+{
+  if (!device || !mfem::Device::Allows(mfem::Backend::DEVICE_MASK)) {
+    return ExecutionSpace::CPU;
+  }
+
+  if (num_elements < dynamic_dispatch.min_device_elements) {
+    return ExecutionSpace::CPU;
+  }
+
+  double host_time = double(num_elements) * flops_per_element / dynamic_dispatch.host_flop_rate;
+  return (host_time > launch_overhead) ? ExecutionSpace::GPU : ExecutionSpace::CPU;
+}
+
+void synchronizeDevice()
+{
+#ifdef SERAC_USE_CUDA
+  cudaDeviceSynchronize();
+#endif
+}
+
+struct KernelGraph::Capture {
+#if defined(__CUDACC__)
+  cudaStream_t    stream = nullptr;  ///< the stream the graph is captured from, and replayed on
+  cudaGraphExec_t graph  = nullptr;  ///< the executable graph, once captured
+  bool            failed = false;    ///< whether the capture failed, so the kernels are launched one at a time
+#endif
+};
+
+KernelGraph::KernelGraph() : capture_(std::make_unique<Capture>()) {}
+
+KernelGraph::~KernelGraph()
+{
+#if defined(__CUDACC__)
+  if (capture_->graph) cudaGraphExecDestroy(capture_->graph);
+  if (capture_->stream) cudaStreamDestroy(capture_->stream);
+#endif
+}
+
+void KernelGraph::run(const std::function<void()>& launches)
+{
+#if defined(__CUDACC__)
+  Capture& capture = *capture_;
+  if (capture.failed) {
+    launches();
+    return;
+  }
+
+  if (capture.graph == nullptr) {
+    // a blocking stream, whose work is ordered with that of the default stream
+    cudaStreamCreate(&capture.stream);
+
+    cudaGraph_t graph = nullptr;
+    launch_stream     = capture.stream;
+    cudaError_t error = cudaStreamBeginCapture(capture.stream, cudaStreamCaptureModeThreadLocal);
+    if (error == cudaSuccess) {
+      launches();
+      error = cudaStreamEndCapture(capture.stream, &graph);
+    }
+    launch_stream = nullptr;
+
+    if (error == cudaSuccess) {
+      error = cudaGraphInstantiateWithFlags(&capture.graph, graph, 0);
+    }
+    if (graph) cudaGraphDestroy(graph);
+
+    if (error != cudaSuccess) {
+      cudaGetLastError();  // clears the error
+      capture.graph  = nullptr;
+      capture.failed = true;
+      SLIC_WARNING_ROOT(axom::fmt::format("Could not capture the kernels into a CUDA graph ({}), launching them one at "
+                                          "a time instead",
+                                          cudaGetErrorString(error)));
+      launches();
+      return;
+    }
+  }
+
+  cudaGraphLaunch(capture.graph, capture.stream);
+#else
+  launches();
+#endif
+}
+
+void launchConcurrently(std::size_t n, const std::function<void(std::size_t)>& launch)
+{
+#if defined(__CUDACC__)
+  if (n <= 1) {
+    if (n == 1) launch(0);
+    return;
+  }
+
+  auto& pool = concurrent_streams;
+  if (pool.fork == nullptr) {
+    cudaEventCreateWithFlags(&pool.fork, cudaEventDisableTiming);
+  }
+  while (pool.streams.size() < n) {
+    cudaStream_t stream;
+    cudaEvent_t  join;
+    cudaStreamCreateWithFlags(&stream, cudaStreamNonBlocking);
+    cudaEventCreateWithFlags(&join, cudaEventDisableTiming);
+    pool.streams.push_back(stream);
+    pool.joins.push_back(join);
+  }
+
+  // fork: every stream waits for the work before this call ...
+  cudaStream_t origin = launch_stream;
+  cudaEventRecord(pool.fork, origin);
+  for (std::size_t i = 0; i < n; i++) {
+    cudaStreamWaitEvent(pool.streams[i], pool.fork, 0);
+    launch_stream = pool.streams[i];
+    launch(i);
+    cudaEventRecord(pool.joins[i], pool.streams[i]);
+  }
+  launch_stream = origin;
+
+  // ... and join: the work after this call waits for every stream
+  for (std::size_t i = 0; i < n; i++) {
+    cudaStreamWaitEvent(origin, pool.joins[i], 0);
+  }
+#else
+  for (std::size_t i = 0; i < n; i++) {
+    launch(i);
+  }
+#endif
+}
+
+void configureHostAllocation(const HostAllocation& options)
+{
+#ifndef MADV_HUGEPAGE
+  SLIC_WARNING_ROOT_IF(options.huge_pages, "Transparent huge pages are not supported on this platform");
+#endif
+  host_allocation = options;
+}
+
+const HostAllocation& hostAllocation() { return host_allocation; }
+
+void* allocateHost(std::size_t bytes, std::size_t alignment)
+{
+  // cache line alignment, or huge page alignment so that the kernel can back the whole array with huge pages
+  constexpr std::size_t cache_line = 64;
+  const bool            huge       = host_allocation.huge_pages && bytes >= huge_page_size;
+  alignment                        = std::max({alignment, sizeof(void*), huge ? huge_page_size : cache_line});
+
+  void* ptr = nullptr;
+  SLIC_ERROR_IF(posix_memalign(&ptr, alignment, std::max(bytes, std::size_t(1))) != 0,
+                axom::fmt::format("Could not allocate {} bytes of host memory", bytes));
+
+#ifdef MADV_HUGEPAGE
+  if (huge) {
+    madvise(ptr, bytes, MADV_HUGEPAGE);
+  }
+#endif
+  return ptr;
+}
+
+void deallocateHost(void* ptr) { std::free(ptr); }
+
 }  // namespace accelerator
 
 }  // namespace serac
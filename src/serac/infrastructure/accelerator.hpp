@@ -50,13 +50,56 @@
 #define SERAC_SUPPRESS_NVCC_HOSTDEVICE_WARNING
 #endif
 
+#include <cstddef>
+#include <functional>
 #include <memory>
+#include <new>
+#include <type_traits>
 
 #include "axom/core.hpp"
 
 #include "serac/infrastructure/logger.hpp"
+#include "serac/infrastructure/memory.hpp"
 #include "serac/infrastructure/profiling.hpp"
 
+#if defined(SERAC_USE_OPENMP) && defined(_OPENMP)
+#include <omp.h>
+/**
+ * @brief Macro that distributes the iterations of the following (element) loop over the available OpenMP threads
+ *
+ * @note each iteration must only write to data owned by that iteration (e.g. the outputs of a single element),
+ * and user-provided q-functions evaluated inside the loop must be thread-safe
+ */
+#define SERAC_OMP_PARALLEL_FOR _Pragma("omp parallel for schedule(static)")
+
+/// @brief helper for SERAC_OMP_PARALLEL_FOR_IF, which turns its argument into a pragma
+#define SERAC_OMP_PRAGMA(x) _Pragma(#x)
+
+/**
+ * @brief Macro like SERAC_OMP_PARALLEL_FOR, but that only starts threads when the given condition holds
+ * (e.g. when the loop has enough iterations to be worth the overhead)
+ */
+#define SERAC_OMP_PARALLEL_FOR_IF(condition) SERAC_OMP_PRAGMA(omp parallel for schedule(static) if (condition))
+
+/**
+ * @brief Macro like SERAC_OMP_PARALLEL_FOR_IF, for loops that accumulate into a variable,
+ * e.g. SERAC_OMP_PARALLEL_FOR_REDUCTION_IF(+ : sum, n > 1000)
+ */
+#define SERAC_OMP_PARALLEL_FOR_REDUCTION_IF(reduction_clause, condition) \
+  SERAC_OMP_PRAGMA(omp parallel for schedule(static) reduction(reduction_clause) if (condition))
+#else
+/**
+ * @brief Macro that evaluates to nothing when OpenMP is disabled, so the following loop runs serially
+ */
+#define SERAC_OMP_PARALLEL_FOR
+
+/// @overload
+#define SERAC_OMP_PARALLEL_FOR_IF(condition)
+
+/// @overload
+#define SERAC_OMP_PARALLEL_FOR_REDUCTION_IF(reduction_clause, condition)
+#endif
+
 /**
  * @brief Accelerator functionality
  */
@@ -104,7 +147,12 @@ struct execution_to_memory<ExecutionSpace::GPU> {
 /// @overload
 template <>
 struct execution_to_memory<ExecutionSpace::Dynamic> {
+#ifdef SERAC_USE_CUDA
   static constexpr axom::MemorySpace value = axom::MemorySpace::Unified;
+#else
+  // without a device, the calculations in ExecutionSpace::Dynamic all run on the host
+  static constexpr axom::MemorySpace value = axom::MemorySpace::Host;
+#endif
 };
 #endif
 
@@ -189,15 +237,253 @@ namespace accelerator {
 /**
  * @brief Initializes the device (GPU)
  *
+ * @param gpu_aware_mpi Whether the MPI library can send and receive device memory, in which case the parallel
+ * operators (e.g. the prolongations of the finite element spaces) pass device buffers to MPI directly, instead of
+ * staging them through host memory
+ *
  * @note This function should only be called once
  */
-void initializeDevice();
+void initializeDevice(bool gpu_aware_mpi = false);
 
 /**
- * @brief Cleans up the device, if applicable
+ * @brief Cleans up the device, if applicable, and the memory pools (see initializeMemoryPools())
  */
 void terminateDevice();
 
+/// @brief Which kinds of memory the temporary arrays of the finite element calculations are pooled in
+struct MemoryPools {
+  /// @brief pool the arrays for ExecutionSpace::CPU
+  bool host = false;
+
+  /// @brief pool the arrays for ExecutionSpace::GPU (CUDA builds only)
+  bool device = false;
+
+  /**
+   * @brief pool the arrays for ExecutionSpace::CPU in pinned (page-locked) host memory instead, which is faster to
+   * transfer to and from the device (CUDA builds only)
+   */
+  bool pinned = false;
+};
+
+/**
+ * @brief Allocates the temporary arrays of the finite element calculations (e.g. the q-function derivatives and the
+ * element matrices, see make_shared_array() and make_array()) from Umpire memory pools
+ *
+ * Calculations that are repeated (e.g. the gradient assembly of each Newton iteration) then reuse the memory of the
+ * previous ones, rather than allocating and freeing it each time, which is very costly for device memory.
+ *
+ * @param pools which pools to use, arrays whose memory isn't pooled are allocated as usual
+ * @note This should be called once, after serac::initialize(), and requires Umpire (otherwise a warning is
+ * issued and no pools are used)
+ */
+void initializeMemoryPools(const MemoryPools& pools);
+
+/**
+ * @brief Whether the arrays of an execution space are allocated from a memory pool, see initializeMemoryPools()
+ * @param exec the execution space
+ */
+bool usesMemoryPool(ExecutionSpace exec);
+
+/**
+ * @brief The Umpire allocator ID of the memory pool of an execution space
+ * @param exec the execution space
+ * @pre usesMemoryPool(exec)
+ */
+int memoryPoolAllocatorID(ExecutionSpace exec);
+
+/**
+ * @brief Allocates memory from the pool of an execution space
+ * @param exec the execution space
+ * @param bytes the size of the allocation
+ * @pre usesMemoryPool(exec)
+ */
+void* allocateFromPool(ExecutionSpace exec, std::size_t bytes);
+
+/**
+ * @brief Returns memory allocated by allocateFromPool() to its pool
+ * @param ptr the allocation
+ */
+void deallocateFromPool(void* ptr);
+
+/// @brief How the calculations in ExecutionSpace::Dynamic choose where to run, see selectExecutionSpace()
+struct DynamicDispatch {
+  /// @brief the (estimated) rate of floating point operations of the host's element calculations, in FLOP/s
+  double host_flop_rate = 1.0e10;
+
+  /// @brief the fewest elements that are worth launching device kernels for, however costly each of them is
+  uint32_t min_device_elements = 4096;
+};
+
+/**
+ * @brief Sets how the calculations in ExecutionSpace::Dynamic choose where to run from now on, which only affects
+ * the integrals added to a Functional afterwards
+ * @param options the dispatch options
+ */
+void configureDynamicDispatch(const DynamicDispatch& options);
+
+/// @brief How the calculations in ExecutionSpace::Dynamic choose where to run, see configureDynamicDispatch()
+const DynamicDispatch& dynamicDispatch();
+
+/**
+ * @brief The time from launching an (empty) kernel on the device to its completion, in seconds, measured by
+ * initializeDevice() (zero when there is no device)
+ */
+double deviceLaunchOverhead();
+
+/**
+ * @brief Chooses where a calculation in ExecutionSpace::Dynamic runs (e.g. the kernels of an integral)
+ *
+ * A calculation runs on the device when it has at least DynamicDispatch::min_device_elements elements and its
+ * estimated time on the host exceeds the launch overhead of a device kernel (see deviceLaunchOverhead()), so that
+ * large domain integrals run on the device, while small (e.g. boundary) integrals stay on the host, where they
+ * aren't dominated by the cost of launching kernels.
+ *
+ * @param num_elements the number of elements of the calculation
+ * @param flops_per_element the (estimated) floating point operations of each element
+ * @return ExecutionSpace::GPU or ExecutionSpace::CPU (always, unless the device was initialized)
+ */
+ExecutionSpace selectExecutionSpace(uint32_t num_elements, double flops_per_element);
+
+/// @brief Waits for the kernels launched on the device to complete (does nothing without a device)
+void synchronizeDevice();
+
+/**
+ * @brief A sequence of device kernels (launched with forall()) that is captured into a CUDA graph the first time it
+ * runs, and replayed as a whole afterwards, which costs about as much as launching a single kernel
+ *
+ * The kernels must read and write the same memory in every run, and the sequence may only launch kernels: it can't
+ * allocate, copy or synchronize. If it does, the capture fails, and the kernels are launched one at a time instead.
+ * Without CUDA, the sequence is simply run.
+ *
+ * @note the graph runs on its own (blocking) stream, so it is ordered with the work on the default stream before
+ * and after it, like the kernels it replaces would be
+ */
+class KernelGraph {
+public:
+  /// @brief An empty graph, which captures the kernels of its first run
+  KernelGraph();
+
+  /// @brief Frees the graph
+  ~KernelGraph();
+
+  /// @brief The graphs are not copyable
+  KernelGraph(const KernelGraph&) = delete;
+
+  /// @brief The graphs are not copyable
+  KernelGraph& operator=(const KernelGraph&) = delete;
+
+  /**
+   * @brief Runs the sequence of kernels
+   * @param launches launches the kernels, which is only called the first time (or every time, if the capture
+   * failed or there is no device)
+   */
+  void run(const std::function<void()>& launches);
+
+private:
+  /// @brief the stream and executable graph of the captured sequence
+  struct Capture;
+
+  /// @brief the stream and executable graph of the captured sequence
+  std::unique_ptr<Capture> capture_;
+};
+
+/**
+ * @brief Calls `launch(i)` for each i in [0, n), with the device kernels (see forall()) of each call on a separate
+ * stream, so that independent sequences of small kernels run concurrently instead of one after another
+ *
+ * The kernels are ordered after the work launched before on the current stream, and the work launched after this
+ * call is ordered after all of them, so this can also be captured by a KernelGraph (as a fork and join of streams).
+ *
+ * @param n the number of independent sequences of kernels
+ * @param launch launches the kernels of a sequence, which must not depend on those of the other sequences
+ * @note without a device, this just calls `launch(i)` for each i in order
+ */
+void launchConcurrently(std::size_t n, const std::function<void(std::size_t)>& launch);
+
+/// @brief How the large host arrays of per-element data (see make_host_array()) are allocated
+struct HostAllocation {
+  /**
+   * @brief initialize the arrays in a loop distributed over the OpenMP threads like the element loops are (see
+   * SERAC_OMP_PARALLEL_FOR), so that each page is first touched by, and so placed in the NUMA domain of, the thread
+   * that later processes its elements, rather than all of them by the thread that allocates the array
+   */
+  bool first_touch = true;
+
+  /// @brief back the arrays of at least huge_page_size bytes with transparent huge pages (Linux only)
+  bool huge_pages = false;
+};
+
+/// @brief The size of the (transparent) huge pages, which is also the alignment of the arrays backed by them
+inline constexpr std::size_t huge_page_size = std::size_t(2) << 20;
+
+/**
+ * @brief Sets how the large host arrays are allocated from now on
+ * @param options the allocation options
+ */
+void configureHostAllocation(const HostAllocation& options);
+
+/// @brief How the large host arrays are allocated, see configureHostAllocation()
+const HostAllocation& hostAllocation();
+
+/**
+ * @brief Allocates uninitialized host memory, backed by huge pages if requested (see HostAllocation)
+ * @param bytes the size of the allocation
+ * @param alignment the (minimum) alignment of the allocation
+ */
+void* allocateHost(std::size_t bytes, std::size_t alignment);
+
+/**
+ * @brief Frees memory allocated by allocateHost()
+ * @param ptr the allocation
+ */
+void deallocateHost(void* ptr);
+
+/**
+ * @brief create a host array of `n` value-initialized entries of type `T`, first touched by the threads that process
+ * them (see HostAllocation), to be freed with destroy_host_array()
+ *
+ * The entries are assumed to be ordered by element, like the element loops visit them. Arrays made of `planes`
+ * consecutive sub-arrays that are each ordered by element (e.g. structure-of-arrays layouts) are initialized one
+ * index of all the planes at a time, so that the entries of each element stay with the same thread.
+ *
+ * @tparam T the type of the entries
+ * @param n the number of entries
+ * @param planes the number of sub-arrays, which must divide `n`
+ */
+template <typename T>
+T* make_host_array(std::size_t n, std::size_t planes = 1)
+{
+  T*                          data       = static_cast<T*>(allocateHost(sizeof(T) * n, alignof(T)));
+  const std::size_t           plane_size = n / planes;
+  [[maybe_unused]] const bool threaded   = hostAllocation().first_touch;
+  SERAC_OMP_PARALLEL_FOR_IF(threaded)
+  for (std::size_t i = 0; i < plane_size; i++) {
+    for (std::size_t k = 0; k < planes; k++) {
+      new (data + k * plane_size + i) T();
+    }
+  }
+  return data;
+}
+
+/**
+ * @brief destroy an array created by make_host_array()
+ * @param data the array (or nullptr)
+ * @param n its number of entries
+ */
+template <typename T>
+void destroy_host_array(T* data, std::size_t n)
+{
+  if (data == nullptr) {
+    return;
+  }
+  if constexpr (!std::is_trivially_destructible_v<T>) {
+    for (std::size_t i = 0; i < n; i++) {
+      data[i].~T();
+    }
+  }
+  deallocateHost(data);
+}
+
 #if defined(__CUDACC__)
 
 /**
@@ -253,19 +539,40 @@ inline std::string getCUDAMemInfoString()
  * @tparam T the type of the value to be stored in the array
  * @tparam exec the memory space where the data lives
  * @param n how many entries to allocate in the array
+ * @param subsystem the part of serac that the array is accounted to, until it is freed (see memory::usage())
  */
 template <ExecutionSpace exec, typename T>
-std::shared_ptr<T[]> make_shared_array(std::size_t n)
+std::shared_ptr<T[]> make_shared_array(std::size_t n, memory::Subsystem subsystem = memory::Subsystem::Other)
 {
+  const std::size_t bytes = sizeof(T) * n;
+  memory::recordAllocation(subsystem, bytes);
+
+  // the pools hand out uninitialized memory, like `new T[n]` does for these types
+  if constexpr (std::is_trivially_default_constructible_v<T> && std::is_trivially_destructible_v<T>) {
+    if (usesMemoryPool(exec)) {
+      auto* data = static_cast<T*>(allocateFromPool(exec, bytes));
+      return std::shared_ptr<T[]>(data, [subsystem, bytes](T* ptr) {
+        deallocateFromPool(ptr);
+        memory::recordDeallocation(subsystem, bytes);
+      });
+    }
+  }
+
   if constexpr (exec == ExecutionSpace::CPU) {
-    return std::shared_ptr<T[]>(new T[n]);
+    return std::shared_ptr<T[]>(make_host_array<T>(n), [subsystem, bytes, n](T* ptr) {
+      destroy_host_array(ptr, n);
+      memory::recordDeallocation(subsystem, bytes);
+    });
   }
 
 #if defined(__CUDACC__)
   if constexpr (exec == ExecutionSpace::GPU) {
     T* data;
-    cudaMalloc(&data, sizeof(T) * n);
-    auto deleter = [](T* ptr) { cudaFree(ptr); };
+    cudaMalloc(&data, bytes);
+    auto deleter = [subsystem, bytes](T* ptr) {
+      cudaFree(ptr);
+      memory::recordDeallocation(subsystem, bytes);
+    };
     return std::shared_ptr<T[]>(data, deleter);
   }
 #endif
@@ -276,11 +583,106 @@ std::shared_ptr<T[]> make_shared_array(std::size_t n)
  * @tparam T the type of the value to be stored in the array
  * @tparam exec the memory space where the data lives
  * @param n how many entries to allocate in the array
+ * @param subsystem the part of serac that the arrays are accounted to
  */
 template <ExecutionSpace exec, typename... T>
-auto make_shared_arrays(std::size_t n)
+auto make_shared_arrays(std::size_t n, memory::Subsystem subsystem = memory::Subsystem::Other)
+{
+  return std::tuple{make_shared_array<exec, T>(n, subsystem)...};
+}
+
+/**
+ * @brief create an ExecArray with the given shape, in the memory pool of its execution space if there is one
+ * (see initializeMemoryPools())
+ * @tparam T the type of the values stored in the array
+ * @tparam dim the dimension of the array
+ * @tparam exec the memory space where the data lives
+ * @param shape the extent of each dimension
+ */
+template <typename T, int dim, ExecutionSpace exec, typename... Extents>
+ExecArray<T, dim, exec> make_array(Extents... shape)
 {
-  return std::tuple{make_shared_array<exec, T>(n)...};
+  static_assert(sizeof...(Extents) == dim, "make_array() requires one extent per dimension");
+#ifdef SERAC_USE_UMPIRE
+  if (usesMemoryPool(exec)) {
+    axom::StackArray<axom::IndexType, dim> extents{{static_cast<axom::IndexType>(shape)...}};
+    return ExecArray<T, dim, exec>(extents, memoryPoolAllocatorID(exec));
+  }
+#endif
+  return ExecArray<T, dim, exec>(shape...);
+}
+
+#if defined(__CUDACC__)
+/**
+ * @brief The stream that forall() launches its device kernels on: the default stream, except while a KernelGraph
+ * captures them, or launchConcurrently() distributes them over several streams
+ */
+cudaStream_t launchStream();
+
+namespace detail {
+
+/// @brief the GPU kernel used by forall(): one thread per index
+template <typename lambda>
+__global__ void forall_kernel(uint32_t n, lambda f)
+{
+  uint32_t i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i < n) {
+    f(i);
+  }
+}
+
+}  // namespace detail
+#endif
+
+/**
+ * @brief evaluate `f(i)` for each `i` in [0, n), in the specified execution space
+ *
+ * @tparam exec where to carry out the calculation: ExecutionSpace::CPU loops over the indices on the host
+ * (distributed over OpenMP threads, when enabled), and ExecutionSpace::GPU launches one device thread per index
+ * @tparam lambda the type of the callable object
+ * @param n the number of indices
+ * @param f the function to evaluate, which must be marked SERAC_HOST_DEVICE and only capture by value
+ * (e.g. pointers to memory in the appropriate space) to be used with ExecutionSpace::GPU
+ *
+ * @note kernels launched on the GPU are asynchronous w.r.t. the host
+ */
+template <ExecutionSpace exec, typename lambda>
+void forall(uint32_t n, lambda f)
+{
+  if constexpr (exec == ExecutionSpace::GPU) {
+#if defined(__CUDACC__)
+    constexpr uint32_t blocksize = 128;
+    if (n > 0) {
+      detail::forall_kernel<<<(n + blocksize - 1) / blocksize, blocksize, 0, launchStream()>>>(n, f);
+    }
+#else
+    SLIC_ERROR_ROOT("ExecutionSpace::GPU requires this translation unit to be compiled with CUDA");
+#endif
+  } else {
+    SERAC_OMP_PARALLEL_FOR
+    for (uint32_t i = 0; i < n; i++) {
+      f(i);
+    }
+  }
+}
+
+/**
+ * @brief atomically add `value` to `*address`, for forall() iterations that accumulate into shared destinations
+ * (e.g. scatter-adds of element contributions)
+ *
+ * @param address the destination, in the memory of the execution space the calling iteration runs in
+ * @param value what to add
+ */
+SERAC_HOST_DEVICE inline void atomic_add(double* address, double value)
+{
+#if defined(__CUDA_ARCH__)
+  atomicAdd(address, value);
+#elif defined(SERAC_USE_OPENMP) && defined(_OPENMP)
+  SERAC_OMP_PRAGMA(omp atomic)
+  *address += value;
+#else
+  *address += value;
+#endif
 }
 
 }  // namespace accelerator
@@ -36,6 +36,17 @@ std::unordered_map<std::string, std::string> defineAndParse(int argc, char* argv
   app.add_option("-o, --output-directory", output_directory, "Directory to put outputted files");
   bool enable_paraview{false};
   app.add_flag("-p, --paraview", enable_paraview, "Enable ParaView output");
+  bool async_save{false};
+  app.add_flag("-a, --async-save", async_save, "Write restart files in the background while the simulation continues");
+  bool incremental_save{false};
+  app.add_flag("-n, --incremental-save", incremental_save,
+               "Only write the fields that changed to the restart files after the first one");
+  std::string memory_pools;
+  app.add_option("-m, --memory-pools", memory_pools,
+                 "Comma-separated kinds of memory (host, device, pinned) to pool the temporary arrays in");
+  std::string caliper;
+  app.add_option("--caliper", caliper,
+                 "Caliper profiling preset (runtime-report|spot|roofline|mpi-report) or config string");
   bool version{false};
   app.add_flag("-v, --version", version, "Print version and provenance information, then exits");
 
@@ -77,6 +88,18 @@ std::unordered_map<std::string, std::string> defineAndParse(int argc, char* argv
       output_directory = serac::input::getInputFileName(input_file_path);
     }
     cli_opts.insert({"output-directory", output_directory});
+    if (async_save) {
+      cli_opts.insert({"async-save", {}});
+    }
+    if (incremental_save) {
+      cli_opts.insert({"incremental-save", {}});
+    }
+    if (!memory_pools.empty()) {
+      cli_opts.insert({"memory-pools", memory_pools});
+    }
+    if (!caliper.empty()) {
+      cli_opts.insert({"caliper", caliper});
+    }
     if (enable_paraview) {
       cli_opts.insert({"paraview", {}});
       cli_opts.insert({"paraview-directory", output_directory + "_paraview"});
@@ -104,8 +127,12 @@ void printGiven(std::unordered_map<std::string, std::string>& cli_opts)
   // Create options map
   // clang-format off
   std::vector<std::pair<std::string, std::string>> opts_output_map{
+    {"async-save", "Asynchronous restart files"},
+    {"caliper", "Caliper profiling"},
     {"create-input-file-docs", "Create Input File Docs"},
+    {"incremental-save", "Incremental restart files"},
     {"input-file", "Input File"},
+    {"memory-pools", "Memory pools"},
     {"output-directory", "Output Directory"},
     {"paraview", "Enable ParaView output"},
     {"restart-cycle", "Restart Cycle"},
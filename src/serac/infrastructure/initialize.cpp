@@ -37,10 +37,12 @@ std::pair<int, int> getMPIInfo(MPI_Comm comm)
   return {num_procs, rank};
 }
 
-std::pair<int, int> initialize(int argc, char* argv[], MPI_Comm comm)
+std::pair<int, int> initialize(int argc, char* argv[], MPI_Comm comm, const logger::LoggerOptions& logger_options)
 {
-  // Initialize MPI.
-  if (MPI_Init(&argc, &argv) != MPI_SUCCESS) {
+  // Initialize MPI. For asynchronous checkpoints, ask for concurrent MPI calls
+  // from multiple threads, although MPI is also usable if they are not provided
+  int provided = MPI_THREAD_SINGLE;
+  if (MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &provided) != MPI_SUCCESS) {
     std::cerr << "Failed to initialize MPI" << std::endl;
     serac::exitGracefully(true);
   }
@@ -49,7 +51,7 @@ std::pair<int, int> initialize(int argc, char* argv[], MPI_Comm comm)
   terminator::registerSignals();
 
   // Initialize SLIC logger
-  if (!logger::initialize(comm)) {
+  if (!logger::initialize(comm, logger_options)) {
     serac::exitGracefully(true);
   }
 
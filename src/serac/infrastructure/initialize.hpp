@@ -16,6 +16,8 @@
 
 #include "mpi.h"
 
+#include "serac/infrastructure/logger.hpp"
+
 namespace serac {
 
 /**
@@ -33,8 +35,10 @@ std::pair<int, int> getMPIInfo(MPI_Comm comm = MPI_COMM_WORLD);
  * @param argc The number of command-line arguments
  * @param argv The command-line arguments, as C-strings
  * @param comm The MPI communicator to initialize with
+ * @param logger_options The modes of the parallel message streams of the logger
  * @return A pair containing the size and rank relative to the provided MPI communicator
  */
-std::pair<int, int> initialize(int argc, char* argv[], MPI_Comm comm = MPI_COMM_WORLD);
+std::pair<int, int> initialize(int argc, char* argv[], MPI_Comm comm = MPI_COMM_WORLD,
+                               const logger::LoggerOptions& logger_options = {});
 
 }  // namespace serac
@@ -8,6 +8,8 @@
 
 #include <stdlib.h>
 #include <algorithm>
+#include <fstream>
+#include <iterator>
 
 #include "axom/core.hpp"
 
@@ -17,8 +19,42 @@
 
 namespace serac::input {
 
+namespace {
+
+/**
+ * @brief Reads a file on rank 0 of @p comm, and broadcasts its contents to the other ranks
+ *
+ * @param[in] path The path to the file
+ * @param[in] comm The communicator
+ * @return The contents of the file, if it exists
+ */
+std::optional<std::string> readOnRoot(const std::string& path, MPI_Comm comm)
+{
+  int rank = 0;
+  MPI_Comm_rank(comm, &rank);
+
+  std::string contents;
+  long        size = -1;
+  if (rank == 0 && axom::utilities::filesystem::pathExists(path)) {
+    std::ifstream file(path, std::ios::binary);
+    contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    size = static_cast<long>(contents.size());
+  }
+
+  MPI_Bcast(&size, 1, MPI_LONG, 0, comm);
+  if (size < 0) {
+    return std::nullopt;
+  }
+
+  contents.resize(static_cast<std::size_t>(size));
+  MPI_Bcast(contents.data(), static_cast<int>(size), MPI_CHAR, 0, comm);
+  return contents;
+}
+
+}  // namespace
+
 axom::inlet::Inlet initialize(axom::sidre::DataStore& datastore, const std::string& input_file_path,
-                              const Language language, const std::string& sidre_path)
+                              const Language language, const std::string& sidre_path, MPI_Comm comm)
 {
   // Initialize Inlet
   std::unique_ptr<axom::inlet::Reader> reader;
@@ -30,7 +66,11 @@ axom::inlet::Inlet initialize(axom::sidre::DataStore& datastore, const std::stri
     reader = std::make_unique<axom::inlet::YAMLReader>();
   }
 
-  if (axom::utilities::filesystem::pathExists(input_file_path)) {
+  if (comm != MPI_COMM_NULL) {
+    if (auto contents = readOnRoot(input_file_path, comm)) {
+      reader->parseString(*contents);
+    }
+  } else if (axom::utilities::filesystem::pathExists(input_file_path)) {
     reader->parseFile(input_file_path);
   }
 
@@ -43,6 +83,16 @@ axom::inlet::Inlet initialize(axom::sidre::DataStore& datastore, const std::stri
   return axom::inlet::Inlet(std::move(reader), inlet_root);
 }
 
+bool verify(axom::inlet::Inlet& inlet, MPI_Comm comm)
+{
+  int rank = 0;
+  MPI_Comm_rank(comm, &rank);
+
+  int verified = (rank == 0) ? inlet.verify() : 0;
+  MPI_Bcast(&verified, 1, MPI_INT, 0, comm);
+  return verified != 0;
+}
+
 std::string findMeshFilePath(const std::string& mesh_path, const std::string& input_file_path)
 {
   using namespace axom::utilities;
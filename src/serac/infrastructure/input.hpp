@@ -43,10 +43,25 @@ enum class Language
  * @param[in] input_file_path Path to user given input file
  * @param[in] language The language of the file at @a input_file_path
  * @param[in] sidre_path The path within the datastore to use as the root of the Inlet hierarchy
+ * @param[in] comm If given, only rank 0 of this communicator reads the input file, and broadcasts its contents to
+ * the other ranks, instead of every rank reading the same file at startup
  * @return initialized Inlet instance
+ *
+ * @note Every rank still interprets the contents, since the functions defined in a Lua input file are evaluated by
+ * the interpreter of each rank. Files read by the input file itself (e.g. with dofile) are still read by every rank.
  */
 axom::inlet::Inlet initialize(axom::sidre::DataStore& datastore, const std::string& input_file_path,
-                              const Language language = Language::Lua, const std::string& sidre_path = "input_file");
+                              const Language language = Language::Lua, const std::string& sidre_path = "input_file",
+                              MPI_Comm comm = MPI_COMM_NULL);
+
+/**
+ * @brief Verifies the input file against its schema on rank 0 of @p comm only, since every rank has the same input
+ *
+ * @param[in] inlet The Inlet instance, with the whole schema defined
+ * @param[in] comm The communicator the result is broadcast over
+ * @return Whether the input file verified, on every rank
+ */
+bool verify(axom::inlet::Inlet& inlet, MPI_Comm comm);
 
 /**
  * @brief Returns the absolute path of the given mesh either relative
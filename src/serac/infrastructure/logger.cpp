@@ -6,12 +6,140 @@
 
 #include "serac/infrastructure/logger.hpp"
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
 #include "serac/infrastructure/initialize.hpp"
 #include "serac/infrastructure/terminator.hpp"
 
 namespace serac::logger {
 
-bool initialize(MPI_Comm comm)
+namespace {
+
+/**
+ * @brief A stream that writes the messages of the root rank from a background thread, and drops the others
+ *
+ * Logging only formats the message and queues it, so it never waits for the output (or other ranks), while flush()
+ * waits for the queued messages of this rank only.
+ */
+class AsyncRootStream : public axom::slic::LogStream {
+public:
+  /**
+   * @brief Start the writer thread (on the root rank)
+   *
+   * @param[in] stream The output stream
+   * @param[in] is_root Whether this is the root rank, whose messages are written
+   * @param[in] format The format of the messages
+   */
+  AsyncRootStream(std::ostream* stream, bool is_root, const std::string& format) : stream_(stream), is_root_(is_root)
+  {
+    setFormatString(format);
+    if (is_root_) {
+      writer_ = std::thread([this]() { write(); });
+    }
+  }
+
+  /// @brief Write the queued messages and stop the writer thread
+  ~AsyncRootStream() override
+  {
+    if (is_root_) {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+      }
+      queued_.notify_one();
+      writer_.join();
+    }
+  }
+
+  /// @brief Queue a formatted message, on the root rank
+  void append(axom::slic::message::Level level, const std::string& message, const std::string& tag,
+              const std::string& file, int line, bool /* filter_duplicates */, bool /* tag_stream_only */) override
+  {
+    if (!is_root_) {
+      return;
+    }
+
+    std::string formatted =
+        getFormatedMessage(axom::slic::message::getLevelAsString(level), message, tag, "0", file, line);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      queue_.push_back(std::move(formatted));
+    }
+    queued_.notify_one();
+  }
+
+  /// @brief Wait until the queued messages are written
+  void flush() override
+  {
+    if (!is_root_) {
+      return;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    written_.wait(lock, [this]() { return queue_.empty() && !writing_; });
+  }
+
+private:
+  /// @brief The writer thread, which writes the queued messages in batches
+  void write()
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      queued_.wait(lock, [this]() { return stop_ || !queue_.empty(); });
+      if (queue_.empty() && stop_) {
+        return;
+      }
+
+      std::deque<std::string> batch;
+      batch.swap(queue_);
+      writing_ = true;
+      lock.unlock();
+
+      for (const auto& message : batch) {
+        (*stream_) << message;
+      }
+      stream_->flush();
+
+      lock.lock();
+      writing_ = false;
+      written_.notify_all();
+    }
+  }
+
+  /// @brief The output stream
+  std::ostream* stream_;
+
+  /// @brief Whether this is the root rank
+  bool is_root_;
+
+  /// @brief Guards the queue and the state of the writer
+  std::mutex mutex_;
+
+  /// @brief Signals queued messages, or the end of the writer
+  std::condition_variable queued_;
+
+  /// @brief Signals written batches of messages
+  std::condition_variable written_;
+
+  /// @brief The messages waiting to be written
+  std::deque<std::string> queue_;
+
+  /// @brief Whether the writer is writing a batch of messages
+  bool writing_ = false;
+
+  /// @brief Whether the writer should stop, once the queue is empty
+  bool stop_ = false;
+
+  /// @brief The writer thread
+  std::thread writer_;
+};
+
+}  // namespace
+
+bool initialize(MPI_Comm comm, const LoggerOptions& options)
 {
   namespace slic = axom::slic;
 
@@ -53,8 +181,15 @@ bool initialize(MPI_Comm comm)
 
     const int RLIMIT = 8;
 
-    i_logstream  = new slic::LumberjackStream(&std::cout, comm, RLIMIT, i_format_string);
-    d_logstream  = new slic::LumberjackStream(&std::cout, comm, RLIMIT, d_format_string);
+    auto stream = [&](std::ostream* output, StreamMode mode, const std::string& format) -> slic::LogStream* {
+      if (mode == StreamMode::RootOnly) {
+        return new AsyncRootStream(output, rank == 0, format);
+      }
+      return new slic::LumberjackStream(output, comm, RLIMIT, format);
+    };
+
+    i_logstream  = stream(&std::cout, options.info, i_format_string);
+    d_logstream  = stream(&std::cout, options.debug, d_format_string);
     we_logstream = new slic::LumberjackStream(&std::cerr, comm, RLIMIT, we_format_string);
   } else {
     i_logstream  = new slic::GenericOutputStream(&std::cout, i_format_string);
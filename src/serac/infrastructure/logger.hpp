@@ -19,6 +19,24 @@
 
 // Logger functionality
 namespace serac::logger {
+
+/// How the messages of a level are written when running in parallel
+enum class StreamMode
+{
+  Aggregated, /**< The messages of all ranks are combined by Lumberjack, and only written by flush(), a collective */
+  RootOnly    /**< Only the messages of rank 0 are written, as soon as they are logged but by a background thread,
+                 with no communication at all. The messages of the other ranks are dropped. */
+};
+
+/// The modes of the info and debug message streams, warnings and errors are always aggregated
+struct LoggerOptions {
+  /// The mode of the info messages, e.g. those of SLIC_INFO_ROOT in the solvers
+  StreamMode info = StreamMode::Aggregated;
+
+  /// The mode of the debug messages
+  StreamMode debug = StreamMode::Aggregated;
+};
+
 /**
  * @brief Initializes and setups the logger.
  *
@@ -27,8 +45,9 @@ namespace serac::logger {
  * logging streams if you are running serial or parallel.
  *
  * @param[in] comm MPI communicator that the logger will use
+ * @param[in] options The modes of the parallel message streams
  */
-bool initialize(MPI_Comm comm);
+bool initialize(MPI_Comm comm, const LoggerOptions& options = {});
 
 /**
  * @brief Finalizes the logger.
@@ -42,7 +61,8 @@ void finalize();
  *
  * If running in parallel, SLIC doesn't output messages immediately.  This flushes
  * all messages currently held by SLIC.  This is a collective operation because
- * messages can be spread across MPI ranks.
+ * messages can be spread across MPI ranks, so with aggregated streams it should only be called at points where the
+ * ranks synchronize anyway (e.g. between timesteps), not in the inner loops of the solvers.
  */
 void flush();
 
@@ -0,0 +1,131 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/infrastructure/memory.hpp"
+
+#include <atomic>
+#include <vector>
+
+#include <sys/resource.h>
+
+#include "axom/fmt.hpp"
+
+#include "serac/infrastructure/logger.hpp"
+#include "serac/infrastructure/profiling.hpp"
+
+namespace serac::memory {
+
+// Restrict global to this file only
+namespace {
+
+/// the accounting of a subsystem (or of all of them)
+struct Counters {
+  std::atomic<std::size_t> current{0};
+  std::atomic<std::size_t> peak{0};
+
+  void add(std::size_t bytes)
+  {
+    std::size_t now  = current.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    std::size_t seen = peak.load(std::memory_order_relaxed);
+    while (now > seen && !peak.compare_exchange_weak(seen, now, std::memory_order_relaxed)) {
+    }
+  }
+
+  void remove(std::size_t bytes) { current.fetch_sub(bytes, std::memory_order_relaxed); }
+};
+
+Counters subsystem_counters[num_subsystems];
+Counters total_counters;
+
+/// formats a number of bytes in the most readable unit
+std::string readable(unsigned long long bytes)
+{
+  const char* units[] = {"B", "KiB", "MiB", "GiB", "TiB"};
+  double      value   = static_cast<double>(bytes);
+  int         unit    = 0;
+  while (value >= 1024.0 && unit < 4) {
+    value /= 1024.0;
+    unit++;
+  }
+  return axom::fmt::format("{:.1f} {}", value, units[unit]);
+}
+
+}  // namespace
+
+void recordAllocation(Subsystem subsystem, std::size_t bytes)
+{
+  subsystem_counters[static_cast<int>(subsystem)].add(bytes);
+  total_counters.add(bytes);
+}
+
+void recordDeallocation(Subsystem subsystem, std::size_t bytes)
+{
+  subsystem_counters[static_cast<int>(subsystem)].remove(bytes);
+  total_counters.remove(bytes);
+}
+
+Usage usage(Subsystem subsystem)
+{
+  const auto& counters = subsystem_counters[static_cast<int>(subsystem)];
+  return {counters.current.load(), counters.peak.load()};
+}
+
+Usage totalUsage() { return {total_counters.current.load(), total_counters.peak.load()}; }
+
+std::size_t peakResidentSetSize()
+{
+  rusage usage_info;
+  if (getrusage(RUSAGE_SELF, &usage_info) != 0) {
+    return 0;
+  }
+#if defined(__APPLE__)
+  return static_cast<std::size_t>(usage_info.ru_maxrss);
+#else
+  // kilobytes on Linux
+  return static_cast<std::size_t>(usage_info.ru_maxrss) * 1024;
+#endif
+}
+
+void report(const std::string& phase, MPI_Comm comm)
+{
+  // the current and peak memory of each subsystem, then the total, then the resident set size
+  std::vector<unsigned long long> values;
+  for (int i = 0; i < num_subsystems; i++) {
+    auto [current, peak] = usage(static_cast<Subsystem>(i));
+    values.push_back(current);
+    values.push_back(peak);
+  }
+  auto [current, peak] = totalUsage();
+  values.push_back(current);
+  values.push_back(peak);
+  values.push_back(peakResidentSetSize());
+
+  MPI_Allreduce(MPI_IN_PLACE, values.data(), static_cast<int>(values.size()), MPI_UNSIGNED_LONG_LONG, MPI_MAX, comm);
+
+  std::string table = axom::fmt::format("Memory after {} (largest over the ranks):\n", phase);
+  table += axom::fmt::format("  {:<16} {:>12} {:>12}\n", "subsystem", "current", "peak");
+  for (int i = 0; i <= num_subsystems; i++) {
+    const char* name = (i < num_subsystems) ? SubsystemNames[i] : "total";
+    table += axom::fmt::format("  {:<16} {:>12} {:>12}\n", name, readable(values[2 * size_t(i)]),
+                               readable(values[2 * size_t(i) + 1]));
+
+    SERAC_SET_METADATA(axom::fmt::format("memory.{}.{}", phase, name), static_cast<long>(values[2 * size_t(i) + 1]));
+  }
+  table += axom::fmt::format("  {:<16} {:>12} {:>12}", "resident set", "", readable(values.back()));
+  SERAC_SET_METADATA(axom::fmt::format("memory.{}.resident_set", phase), static_cast<long>(values.back()));
+
+  SLIC_INFO_ROOT(table);
+}
+
+void reportEstimate(const std::string& description, std::size_t bytes, MPI_Comm comm)
+{
+  unsigned long long largest = bytes;
+  MPI_Allreduce(MPI_IN_PLACE, &largest, 1, MPI_UNSIGNED_LONG_LONG, MPI_MAX, comm);
+  SLIC_INFO_ROOT(axom::fmt::format("Estimated memory for {}: {} (largest over the ranks)", description,
+                                   readable(largest)));
+}
+
+}  // namespace serac::memory
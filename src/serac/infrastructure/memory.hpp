@@ -0,0 +1,150 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file memory.hpp
+ *
+ * @brief Accounting of the memory allocated by each part of serac, to find what is responsible for
+ * the memory footprint of large runs
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "mpi.h"
+
+namespace serac::memory {
+
+/// @brief The parts of serac whose allocations are accounted for separately
+enum class Subsystem
+{
+  QFunctionDerivatives,  ///< the derivatives of the q-functions saved for the action of the gradient
+  QuadratureData,        ///< the material state at the quadrature points
+  EVectors,              ///< the per-element ("E-vector") values of the Functional gathers and scatters
+  LookupTables,          ///< the dof and index maps of the element restrictions
+  Matrices,              ///< the element matrices and assembled sparse matrices
+  States,                ///< the finite element states and duals, and their copies in Sidre
+  Other                  ///< everything else allocated through the accelerator allocators
+};
+
+/// @brief The number of subsystems
+inline constexpr int num_subsystems = static_cast<int>(Subsystem::Other) + 1;
+
+/// @brief The name of each subsystem, at the index of its enumerator
+inline constexpr const char* SubsystemNames[num_subsystems] = {
+    "qf_derivatives", "quadrature_data", "e_vectors", "lookup_tables", "matrices", "states", "other"};
+
+/// @brief The memory of a subsystem on this rank, in bytes
+struct Usage {
+  std::size_t current;  ///< how much is allocated now
+  std::size_t peak;     ///< the most that was allocated at one time
+};
+
+/**
+ * @brief Records an allocation of a subsystem
+ * @param subsystem the subsystem the memory belongs to
+ * @param bytes the size of the allocation
+ */
+void recordAllocation(Subsystem subsystem, std::size_t bytes);
+
+/**
+ * @brief Records that memory recorded by recordAllocation() was freed
+ * @param subsystem the subsystem the memory belongs to
+ * @param bytes the size of the allocation
+ */
+void recordDeallocation(Subsystem subsystem, std::size_t bytes);
+
+/**
+ * @brief The memory of a subsystem on this rank
+ * @param subsystem the subsystem
+ */
+Usage usage(Subsystem subsystem);
+
+/// @brief The memory of all subsystems on this rank (whose peak is that of the sum, not the sum of the peaks)
+Usage totalUsage();
+
+/// @brief The peak resident set size of this process, in bytes (0 where it is not available)
+std::size_t peakResidentSetSize();
+
+/**
+ * @brief Logs the current and peak memory of each subsystem, and the peak resident set size, of the rank that uses
+ * the most, and records them as metadata of the profile (`memory.<phase>.<subsystem>`)
+ *
+ * @param phase the phase of the calculation that just ended, e.g. "setup"
+ * @param comm the ranks to report on
+ * @note this is collective over @a comm
+ */
+void report(const std::string& phase, MPI_Comm comm = MPI_COMM_WORLD);
+
+/**
+ * @brief Logs an estimate of memory that is yet to be allocated, of the rank that needs the most
+ *
+ * @param description what the memory is for
+ * @param bytes the estimate, on this rank
+ * @param comm the ranks to report on
+ * @note this is collective over @a comm
+ */
+void reportEstimate(const std::string& description, std::size_t bytes, MPI_Comm comm = MPI_COMM_WORLD);
+
+/**
+ * @brief The accounting of memory that is owned by an object, and freed with it
+ *
+ * Copies of a Tracker account for the same amount again, as the objects that hold them
+ * (e.g. mfem::Vector members) copy the memory they account for.
+ */
+class Tracker {
+public:
+  /**
+   * @brief Accounts for no memory yet
+   * @param subsystem what the memory belongs to
+   */
+  explicit Tracker(Subsystem subsystem = Subsystem::Other) : subsystem_(subsystem) {}
+
+  /// @brief Accounts for the same memory as @a other, again
+  Tracker(const Tracker& other) : subsystem_(other.subsystem_) { set(other.bytes_); }
+
+  /// @brief Accounts for the same memory as @a other, again
+  Tracker& operator=(const Tracker& other)
+  {
+    if (this != &other) {
+      set(0);
+      subsystem_ = other.subsystem_;
+      set(other.bytes_);
+    }
+    return *this;
+  }
+
+  /// @brief Releases the memory accounted for
+  ~Tracker() { set(0); }
+
+  /**
+   * @brief Changes the amount of memory accounted for
+   * @param bytes the new size of the memory
+   */
+  void set(std::size_t bytes)
+  {
+    if (bytes > bytes_) {
+      recordAllocation(subsystem_, bytes - bytes_);
+    } else if (bytes < bytes_) {
+      recordDeallocation(subsystem_, bytes_ - bytes);
+    }
+    bytes_ = bytes;
+  }
+
+  /// @brief The amount of memory accounted for
+  std::size_t bytes() const { return bytes_; }
+
+private:
+  /// what the memory belongs to
+  Subsystem subsystem_;
+
+  /// the amount of memory accounted for
+  std::size_t bytes_ = 0;
+};
+
+}  // namespace serac::memory
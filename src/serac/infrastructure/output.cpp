@@ -31,9 +31,9 @@ std::string file_format_string(const FileFormat file_format)
 }  // namespace detail
 
 void outputSummary(const axom::sidre::DataStore& datastore, const std::string& output_directory,
-                   const FileFormat file_format)
+                   const FileFormat file_format, MPI_Comm comm)
 {
-  auto [_, rank] = getMPIInfo();
+  auto [_, rank] = getMPIInfo(comm);
   if (rank != 0) {
     return;
   }
@@ -15,6 +15,7 @@
 #include <string>
 
 #include "axom/sidre.hpp"
+#include "mpi.h"
 
 /**
  * @brief The output related helper functions and objects
@@ -38,8 +39,9 @@ enum class FileFormat
  * @param[in] datastore Root of the Sidre datastore
  * @param[in] output_directory Directory to write output file into
  * @param[in] file_format The output file format
+ * @param[in] comm The communicator of the simulation, whose rank 0 writes the file
  */
 void outputSummary(const axom::sidre::DataStore& datastore, const std::string& output_directory,
-                   const FileFormat file_format = FileFormat::JSON);
+                   const FileFormat file_format = FileFormat::JSON, MPI_Comm comm = MPI_COMM_WORLD);
 
 }  // namespace serac::output
@@ -8,6 +8,17 @@
 
 #include "serac/infrastructure/logger.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__x86_64__) && !defined(__CUDACC__)
+#include <x86intrin.h>
+#endif
+
 #ifdef SERAC_USE_CALIPER
 #include <optional>
 #endif
@@ -17,6 +28,27 @@ namespace serac::profiling {
 #ifdef SERAC_USE_CALIPER
 namespace {
 std::optional<cali::ConfigManager> mgr;
+
+/// Starts Caliper with a configuration, and the defaults that it does not configure already
+void startCaliper(const std::string& options)
+{
+  mgr               = cali::ConfigManager();
+  auto check_result = mgr->check(options.c_str());
+
+  if (check_result.empty()) {
+    mgr->add(options.c_str());
+  } else {
+    SLIC_WARNING_ROOT("Caliper options invalid, ignoring: " << check_result);
+  }
+
+  // Defaults, should probably always be enabled
+  for (const char* config : {"runtime-report", "spot"}) {
+    if (!check_result.empty() || options.find(config) == std::string::npos) {
+      mgr->add(config);
+    }
+  }
+  mgr->start();
+}
 }  // namespace
 #endif
 
@@ -38,21 +70,32 @@ void initialize([[maybe_unused]] MPI_Comm comm, [[maybe_unused]] std::string opt
 
 #ifdef SERAC_USE_CALIPER
   // Initialize Caliper
-  mgr               = cali::ConfigManager();
-  auto check_result = mgr->check(options.c_str());
+  startCaliper(options);
+#endif
+}
 
-  if (check_result.empty()) {
-    mgr->add(options.c_str());
-  } else {
-    SLIC_WARNING_ROOT("Caliper options invalid, ignoring: " << check_result);
+void configure([[maybe_unused]] const std::string& options)
+{
+#ifdef SERAC_USE_CALIPER
+  if (mgr) {
+    mgr->stop();
   }
-
-  // Defaults, should probably always be enabled
-  mgr->add("runtime-report,spot");
-  mgr->start();
+  startCaliper(options);
 #endif
 }
 
+std::string caliperConfig(const std::string& preset)
+{
+  static const std::unordered_map<std::string, std::string> presets = {
+      {"runtime-report", "runtime-report(calc.inclusive,region.count,mem.highwatermark)"},
+      {"spot", "spot(mem.highwatermark)"},
+      {"roofline", "spot(topdown-counters.all)"},
+      {"mpi-report", "mpi-report"}};
+
+  auto found = presets.find(preset);
+  return (found != presets.end()) ? found->second : preset;
+}
+
 void finalize()
 {
 #ifdef SERAC_USE_ADIAK
@@ -71,9 +114,240 @@ void finalize()
 #endif
 }
 
+namespace {
+
+/// the names of the hot-path counters, in the order of their indices
+std::vector<std::string> counter_names;
+
+/// the counters of the threads that are running, and of those that have exited
+std::vector<detail::CounterValues*> live_counters;
+detail::CounterValues               retired_counters;
+
+/// guards the names and the lists of counters
+std::mutex counters_mutex;
+
+/// the counters of a thread, which are kept (as retired counters) once it exits
+struct ThreadCounters {
+  detail::CounterValues values;
+
+  ThreadCounters()
+  {
+    std::lock_guard<std::mutex> lock(counters_mutex);
+    live_counters.push_back(&values);
+  }
+
+  ~ThreadCounters()
+  {
+    std::lock_guard<std::mutex> lock(counters_mutex);
+    for (int i = 0; i < detail::max_counters; i++) {
+      detail::add(retired_counters.counts[std::size_t(i)], values.counts[std::size_t(i)].load());
+      detail::add(retired_counters.ticks[std::size_t(i)], values.ticks[std::size_t(i)].load());
+    }
+    live_counters.erase(std::find(live_counters.begin(), live_counters.end(), &values));
+  }
+};
+
+thread_local ThreadCounters thread_counters;
+
+/// the number of ticks() per second, measured against a steady clock since the first call
+double ticksPerSecond()
+{
+  using clock                    = std::chrono::steady_clock;
+  static const auto     start    = clock::now();
+  static const uint64_t start_ts = detail::ticks();
+
+  std::chrono::duration<double> elapsed       = clock::now() - start;
+  uint64_t                      elapsed_ticks = detail::ticks() - start_ts;
+  return (elapsed.count() > 0.0 && elapsed_ticks > 0) ? double(elapsed_ticks) / elapsed.count() : 1.0e9;
+}
+
+// the measurement of the tick rate starts with the program
+[[maybe_unused]] const double initial_ticks_per_second = ticksPerSecond();
+
+}  // namespace
+
+void setCounterMode(CounterMode mode) { detail::counter_mode = mode; }
+
+int counterId(const std::string& name)
+{
+  std::lock_guard<std::mutex> lock(counters_mutex);
+  auto found = std::find(counter_names.begin(), counter_names.end(), name);
+  if (found != counter_names.end()) {
+    return static_cast<int>(found - counter_names.begin());
+  }
+
+  SLIC_ERROR_IF(static_cast<int>(counter_names.size()) == detail::max_counters,
+                axom::fmt::format("Too many hot-path counters, at most {} can be registered", detail::max_counters));
+  counter_names.push_back(name);
+  return static_cast<int>(counter_names.size()) - 1;
+}
+
+namespace {
+
+/// the totals of the hot-path counters over the ranks of a communicator, see reportCounters()
+struct CounterTotals {
+  int                      num_ranks = 0;  ///< the number of ranks
+  std::vector<std::string> names;          ///< the names of the counters registered by any of the ranks
+  std::vector<uint64_t>    counts;         ///< the number of events of each counter, on rank 0
+  std::vector<double>      sum_seconds;    ///< the sum of the times of each counter over the ranks, on rank 0
+  std::vector<double>      max_seconds;    ///< the time of each counter on the slowest rank, on rank 0
+};
+
+/// sums the hot-path counters of every thread and every rank of @p comm, which is collective
+CounterTotals gatherCounters(MPI_Comm comm)
+{
+  int num_ranks = 0;
+  MPI_Comm_size(comm, &num_ranks);
+
+  // the totals of the counters of every thread of this rank
+  std::vector<std::string> local_names;
+  std::vector<uint64_t>    local_counts(detail::max_counters, 0);
+  std::vector<double>      local_seconds(detail::max_counters, 0.0);
+  {
+    std::lock_guard<std::mutex> lock(counters_mutex);
+    local_names = counter_names;
+
+    std::vector<const detail::CounterValues*> all(live_counters.begin(), live_counters.end());
+    all.push_back(&retired_counters);
+    const double tick = 1.0 / ticksPerSecond();
+    for (auto* values : all) {
+      for (std::size_t i = 0; i < std::size_t(detail::max_counters); i++) {
+        local_counts[i] += values->counts[i].load(std::memory_order_relaxed);
+        local_seconds[i] += tick * double(values->ticks[i].load(std::memory_order_relaxed));
+      }
+    }
+  }
+
+  // the ranks may not have registered the same counters (or in the same order), so they are matched by name
+  std::string local_buffer;
+  for (const auto& name : local_names) {
+    local_buffer += name + '\n';
+  }
+  int              local_size = static_cast<int>(local_buffer.size());
+  std::vector<int> sizes(std::size_t(num_ranks)), offsets(std::size_t(num_ranks) + 1, 0);
+  MPI_Allgather(&local_size, 1, MPI_INT, sizes.data(), 1, MPI_INT, comm);
+  for (std::size_t r = 0; r < sizes.size(); r++) {
+    offsets[r + 1] = offsets[r] + sizes[r];
+  }
+  std::string buffer(std::size_t(offsets.back()), '\0');
+  MPI_Allgatherv(local_buffer.data(), local_size, MPI_CHAR, buffer.data(), sizes.data(), offsets.data(), MPI_CHAR,
+                 comm);
+
+  std::vector<std::string> names;
+  std::stringstream        all_names(buffer);
+  for (std::string name; std::getline(all_names, name);) {
+    if (std::find(names.begin(), names.end(), name) == names.end()) {
+      names.push_back(name);
+    }
+  }
+
+  std::vector<uint64_t> counts(names.size(), 0), total_counts(names.size());
+  std::vector<double>   seconds(names.size(), 0.0), max_seconds(names.size()), sum_seconds(names.size());
+  for (std::size_t i = 0; i < local_names.size(); i++) {
+    auto j     = std::size_t(std::find(names.begin(), names.end(), local_names[i]) - names.begin());
+    counts[j]  = local_counts[i];
+    seconds[j] = local_seconds[i];
+  }
+
+  const int n = static_cast<int>(names.size());
+  MPI_Reduce(counts.data(), total_counts.data(), n, MPI_UINT64_T, MPI_SUM, 0, comm);
+  MPI_Reduce(seconds.data(), max_seconds.data(), n, MPI_DOUBLE, MPI_MAX, 0, comm);
+  MPI_Reduce(seconds.data(), sum_seconds.data(), n, MPI_DOUBLE, MPI_SUM, 0, comm);
+
+  return {num_ranks, std::move(names), std::move(total_counts), std::move(sum_seconds), std::move(max_seconds)};
+}
+
+/// escapes the characters of a counter name that can't appear in a JSON string as they are
+std::string jsonString(const std::string& text)
+{
+  std::string result = "\"";
+  for (char c : text) {
+    if (c == '"' || c == '\\') {
+      result += '\\';
+    }
+    result += c;
+  }
+  return result + "\"";
+}
+
+}  // namespace
+
+void reportCounters(MPI_Comm comm, const std::string& title)
+{
+  const auto totals = gatherCounters(comm);
+
+  std::string report = axom::fmt::format("\n{:*^80}\n{:<44}{:>12}{:>12}{:>12}\n", " " + title + " ", "counter",
+                                         "count", "avg (s)", "max (s)");
+  for (std::size_t i = 0; i < totals.names.size(); i++) {
+    report += axom::fmt::format("{:<44}{:>12}{:>12.4e}{:>12.4e}\n", totals.names[i], totals.counts[i],
+                                totals.sum_seconds[i] / totals.num_ranks, totals.max_seconds[i]);
+  }
+  report += axom::fmt::format("{:*^80}\n", "*");
+  SLIC_INFO_ROOT(report);
+}
+
+void writeCounters(MPI_Comm comm, const std::string& filename)
+{
+  const auto totals = gatherCounters(comm);
+
+  int rank = 0;
+  MPI_Comm_rank(comm, &rank);
+  if (rank != 0) {
+    return;
+  }
+
+  std::ofstream file(filename);
+  SLIC_ERROR_IF(!file, axom::fmt::format("Could not open the counter file '{}'", filename));
+
+  file << "{\n  \"num_ranks\": " << totals.num_ranks << ",\n  \"counters\": {";
+  for (std::size_t i = 0; i < totals.names.size(); i++) {
+    file << (i == 0 ? "\n" : ",\n")
+         << axom::fmt::format("    {}: {{\"count\": {}, \"avg_seconds\": {:.6e}, \"max_seconds\": {:.6e}}}",
+                              jsonString(totals.names[i]), totals.counts[i],
+                              totals.sum_seconds[i] / totals.num_ranks, totals.max_seconds[i]);
+  }
+  file << "\n  }\n}\n";
+}
+
+void resetCounters()
+{
+  std::lock_guard<std::mutex> lock(counters_mutex);
+  std::vector<detail::CounterValues*> all(live_counters.begin(), live_counters.end());
+  all.push_back(&retired_counters);
+  for (auto* values : all) {
+    for (std::size_t i = 0; i < std::size_t(detail::max_counters); i++) {
+      values->counts[i].store(0, std::memory_order_relaxed);
+      values->ticks[i].store(0, std::memory_order_relaxed);
+    }
+  }
+}
+
+uint64_t counterCount(int id)
+{
+  std::lock_guard<std::mutex> lock(counters_mutex);
+  uint64_t                    total = retired_counters.counts[std::size_t(id)].load(std::memory_order_relaxed);
+  for (auto* values : live_counters) {
+    total += values->counts[std::size_t(id)].load(std::memory_order_relaxed);
+  }
+  return total;
+}
+
 /// @cond
 namespace detail {
 
+CounterValues& threadCounters() { return thread_counters.values; }
+
+uint64_t ticks()
+{
+#if defined(__x86_64__) && !defined(__CUDACC__)
+  return __rdtsc();
+#else
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+#endif
+}
+
 void startCaliperRegion([[maybe_unused]] const char* name)
 {
 #ifdef SERAC_USE_CALIPER
@@ -12,6 +12,9 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <string>
 #include <sstream>
 
@@ -78,12 +81,32 @@
  * Profiles an expression several times. Returns the last evaluation
  */
 
+/**
+ * @def SERAC_PROFILE_COUNTER(name, value)
+ * Attributes a quantity (e.g. an analytic FLOP or byte count) to the enclosing Caliper region, as an
+ * aggregatable attribute that is summed over the region's invocations
+ */
+
+/**
+ * @def SERAC_COUNT(name)
+ * Counts an event with the hot-path counter @p name (a string literal), see profiling::reportCounters()
+ */
+
+/**
+ * @def SERAC_TIME_SCOPE(name)
+ * Counts an event with the hot-path counter @p name (a string literal), and adds the time until the end of the
+ * enclosing scope to it, see profiling::reportCounters()
+ */
+
 #ifdef SERAC_USE_ADIAK
 #define SERAC_SET_METADATA(name, data) adiak::value(name, data)
 #else
 #define SERAC_SET_METADATA(name, data)
 #endif
 
+#define SERAC_CONCAT_(a, b) a##b
+#define SERAC_CONCAT(a, b) SERAC_CONCAT_(a, b)
+
 #ifdef SERAC_USE_CALIPER
 
 #define SERAC_MARK_FUNCTION CALI_CXX_MARK_FUNCTION
@@ -93,9 +116,6 @@
 #define SERAC_MARK_BEGIN(name) serac::profiling::detail::startCaliperRegion(name)
 #define SERAC_MARK_END(name) serac::profiling::detail::endCaliperRegion(name)
 
-#define SERAC_CONCAT_(a, b) a##b
-#define SERAC_CONCAT(a, b) SERAC_CONCAT_(a, b)
-
 namespace serac::profiling::detail {
 
 /**
@@ -108,6 +128,30 @@ inline const char* make_cstr(const char* str) { return str; }
  */
 inline const char* make_cstr(const std::string& str) { return str.c_str(); }
 
+/**
+ * @brief Sets an aggregatable Caliper attribute for the lifetime of this object, see SERAC_PROFILE_COUNTER
+ */
+class ScopedCounter {
+public:
+  /**
+   * @brief Sets the attribute
+   * @param[in] name The name of the attribute
+   * @param[in] value The value to attribute to the enclosing region
+   */
+  ScopedCounter(const char* name, double value)
+      : annotation_(name, CALI_ATTR_ASVALUE | CALI_ATTR_AGGREGATABLE)
+  {
+    annotation_.begin(value);
+  }
+
+  /// @brief Unsets the attribute
+  ~ScopedCounter() { annotation_.end(); }
+
+private:
+  /// the attribute being set
+  cali::Annotation annotation_;
+};
+
 }  // namespace serac::profiling::detail
 
 #define SERAC_PROFILE_SCOPE(name) \
@@ -124,6 +168,12 @@ inline const char* make_cstr(const std::string& str) { return str.c_str(); }
     return (expr);                                                                                         \
   }()
 
+// the counter must be declared after the region it describes, so that the snapshot taken when it is unset
+// attributes its value to that region
+#define SERAC_PROFILE_COUNTER(name, value)                                 \
+  serac::profiling::detail::ScopedCounter SERAC_CONCAT(counter, __LINE__)( \
+      serac::profiling::detail::make_cstr(name), static_cast<double>(value))
+
 /**
  * @brief Profiles an expression several times; Return the last evaluation
  */
@@ -147,6 +197,7 @@ inline const char* make_cstr(const std::string& str) { return str.c_str(); }
 #define SERAC_PROFILE_SCOPE(name)
 #define SERAC_PROFILE_EXPR(name, expr) expr
 #define SERAC_PROFILE_EXPR_LOOP(name, expr, ntest) expr
+#define SERAC_PROFILE_COUNTER(name, value)
 
 #endif
 
@@ -161,6 +212,28 @@ namespace serac::profiling {
  */
 void initialize([[maybe_unused]] MPI_Comm comm = MPI_COMM_WORLD, [[maybe_unused]] std::string options = "");
 
+/**
+ * @brief Restarts the Caliper profiling with another configuration, e.g. one read from the command line once
+ * initialize() has already run. What was measured so far is discarded.
+ * @param options The Caliper ConfigManager config string, see initialize()
+ * @note The default runtime report and SPOT file are added, unless @p options configures them already
+ */
+void configure([[maybe_unused]] const std::string& options);
+
+/**
+ * @brief The Caliper config string of a profiling preset, for the command line of the drivers
+ *
+ * The presets are:
+ *  - runtime-report: the inclusive time, call count and memory high-water mark of each region, printed at the end
+ *  - spot: a SPOT file, with the memory high-water mark of each region
+ *  - roofline: a SPOT file with the hardware counters of the top-down analysis (requires PAPI), next to the
+ *    analytic flops and bytes of the Functional kernels (see SERAC_PROFILE_COUNTER)
+ *  - mpi-report: the time spent in each MPI function, printed at the end
+ *
+ * @param preset The name of a preset, or a config string, which is returned unchanged
+ */
+std::string caliperConfig(const std::string& preset);
+
 /**
  * @brief Concludes performance monitoring and writes collected data to a file
  */
@@ -185,6 +258,129 @@ void endCaliperRegion(const char* name);
 
 }  // namespace detail
 
+/**
+ * @brief What the hot-path counters record
+ *
+ * Unlike Caliper regions, the counters are cheap enough to stay on in production runs, and inside the loops over
+ * the elements or the Newton iterations: each event increments a thread-local count and, in the Timed mode, reads
+ * the time stamp counter of the processor twice.
+ */
+enum class CounterMode
+{
+  Off,     ///< nothing is recorded
+  Counts,  ///< the number of events of each counter is recorded
+  Timed    ///< the number of events and their time are recorded
+};
+
+/// @brief Sets what the hot-path counters record (Timed by default)
+void setCounterMode(CounterMode mode);
+
+/**
+ * @brief The index of the hot-path counter with a name, which is registered on its first use
+ * @note This takes a lock, so the indices of the counters of hot loops should be looked up once (SERAC_COUNT and
+ * SERAC_TIME_SCOPE do so for their string literals)
+ */
+int counterId(const std::string& name);
+
+/**
+ * @brief Logs the number of events of each hot-path counter, summed over the ranks of @p comm and the threads,
+ * and their time, averaged over the ranks and on the slowest one. This is collective.
+ * @param comm The communicator of the ranks whose counters are reported
+ * @param title The title of the report, e.g. the cycle of a periodic report
+ * @note The counters accumulate from the start of the run (or the last resetCounters())
+ */
+void reportCounters(MPI_Comm comm = MPI_COMM_WORLD, const std::string& title = "Counters");
+
+/**
+ * @brief Writes the same totals as reportCounters() to a JSON file (from rank 0), for scripts that compare runs,
+ * e.g. `{"num_ranks": 2, "counters": {"name": {"count": 10, "avg_seconds": 1.0e-3, "max_seconds": 2.0e-3}}}`.
+ * This is collective.
+ * @param comm The communicator of the ranks whose counters are written
+ * @param filename The path of the file
+ */
+void writeCounters(MPI_Comm comm, const std::string& filename);
+
+/// @brief Sets every hot-path counter back to zero, outside of any parallel region
+void resetCounters();
+
+/// @brief The number of events of the hot-path counter with index @p id on this rank, over all its threads
+uint64_t counterCount(int id);
+
+/// @cond
+namespace detail {
+
+/// the maximum number of hot-path counters
+constexpr int max_counters = 64;
+
+/// the counters of a thread, which are only written by that thread
+struct CounterValues {
+  std::array<std::atomic<uint64_t>, max_counters> counts{};  ///< the number of events of each counter
+  std::array<std::atomic<uint64_t>, max_counters> ticks{};   ///< the time of the events, in ticks()
+};
+
+/// what the hot-path counters record
+inline std::atomic<CounterMode> counter_mode{CounterMode::Timed};
+
+/// the counters of the calling thread
+CounterValues& threadCounters();
+
+/// the time stamp counter of the processor (or a steady clock in nanoseconds on other architectures)
+uint64_t ticks();
+
+/// adds @p amount to a counter that only the calling thread writes
+inline void add(std::atomic<uint64_t>& counter, uint64_t amount)
+{
+  counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+/// counts an event of counter @p id
+inline void count(int id)
+{
+  if (counter_mode.load(std::memory_order_relaxed) != CounterMode::Off) {
+    add(threadCounters().counts[std::size_t(id)], 1);
+  }
+}
+
+}  // namespace detail
+/// @endcond
+
+/// @brief Counts an event of a hot-path counter, and adds the time until it is destroyed to it
+class ScopedTimer {
+public:
+  /// @brief Starts the event of the counter with index @p id, see counterId()
+  explicit ScopedTimer(int id) : id_(id), mode_(detail::counter_mode.load(std::memory_order_relaxed))
+  {
+    if (mode_ == CounterMode::Timed) {
+      start_ = detail::ticks();
+    }
+  }
+
+  /// @brief Ends the event
+  ~ScopedTimer()
+  {
+    if (mode_ != CounterMode::Off) {
+      auto& counters = detail::threadCounters();
+      detail::add(counters.counts[std::size_t(id_)], 1);
+      if (mode_ == CounterMode::Timed) {
+        detail::add(counters.ticks[std::size_t(id_)], detail::ticks() - start_);
+      }
+    }
+  }
+
+  ScopedTimer(const ScopedTimer&) = delete;
+  ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+  /// the index of the counter
+  int id_;
+
+  /// what is recorded, fixed for the duration of the event
+  CounterMode mode_;
+
+  /// the time stamp counter at the start of the event
+  uint64_t start_ = 0;
+};
+
 /// Produces a string by applying << to all arguments
 template <typename... T>
 std::string concat(T... args)
@@ -199,3 +395,14 @@ std::string concat(T... args)
 }
 
 }  // namespace serac::profiling
+
+// each use looks up the index of its counter only once
+#define SERAC_COUNTER_ID(name)                               \
+  [] {                                                       \
+    static const int id = serac::profiling::counterId(name); \
+    return id;                                               \
+  }()
+
+#define SERAC_COUNT(name) serac::profiling::detail::count(SERAC_COUNTER_ID(name))
+
+#define SERAC_TIME_SCOPE(name) serac::profiling::ScopedTimer SERAC_CONCAT(timer, __LINE__)(SERAC_COUNTER_ID(name))
@@ -0,0 +1,64 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/infrastructure/shared_memory.hpp"
+
+#include "serac/infrastructure/logger.hpp"
+
+namespace serac {
+
+std::vector<int> nodeRanks(MPI_Comm comm)
+{
+  int rank = 0;
+  MPI_Comm_rank(comm, &rank);
+
+  MPI_Comm node_comm;
+  MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &node_comm);
+  int node_size = 0;
+  MPI_Comm_size(node_comm, &node_size);
+
+  // the split keeps the order of the ranks
+  std::vector<int> ranks(static_cast<std::size_t>(node_size));
+  MPI_Allgather(&rank, 1, MPI_INT, ranks.data(), 1, MPI_INT, node_comm);
+  MPI_Comm_free(&node_comm);
+  return ranks;
+}
+
+NodeSharedBuffer::NodeSharedBuffer(std::size_t bytes, MPI_Comm comm) : tracker_(memory::Subsystem::Other)
+{
+  int rank = 0;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &node_comm_);
+  MPI_Comm_rank(node_comm_, &node_rank_);
+
+  // only the first rank of the node allocates, the others map its segment
+  const auto local_bytes = static_cast<MPI_Aint>(isNodeLeader() ? bytes : 0);
+  void*      local_data  = nullptr;
+  const int  error       = MPI_Win_allocate_shared(local_bytes, 1, MPI_INFO_NULL, node_comm_, &local_data, &window_);
+  SLIC_ERROR_IF(error != MPI_SUCCESS, "Could not allocate a node-shared MPI window");
+
+  MPI_Aint leader_bytes = 0;
+  int      displacement = 0;
+  MPI_Win_shared_query(window_, 0, &leader_bytes, &displacement, &data_);
+  size_ = static_cast<std::size_t>(leader_bytes);
+
+  if (isNodeLeader()) {
+    tracker_.set(size_);
+  }
+
+  // start the epoch in which the buffer is written
+  MPI_Win_fence(0, window_);
+}
+
+NodeSharedBuffer::~NodeSharedBuffer()
+{
+  MPI_Win_free(&window_);
+  MPI_Comm_free(&node_comm_);
+}
+
+void NodeSharedBuffer::fence() const { MPI_Win_fence(0, window_); }
+
+}  // namespace serac
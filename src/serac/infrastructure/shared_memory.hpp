@@ -0,0 +1,139 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file shared_memory.hpp
+ *
+ * @brief Storage of read-only data once per (shared-memory) node, instead of once per MPI rank
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+#include "mpi.h"
+
+#include "serac/infrastructure/memory.hpp"
+
+namespace serac {
+
+/**
+ * @brief The ranks of a communicator that are on the same (shared-memory) node as this rank
+ *
+ * @param comm The communicator
+ * @return The ranks in @a comm, in increasing order, so the first one is the same on all the ranks of the node
+ */
+std::vector<int> nodeRanks(MPI_Comm comm);
+
+/**
+ * @brief A buffer allocated once on each node, by the first rank of the node (see nodeRanks()), and mapped into the
+ * address space of all the ranks of the node, i.e. an MPI-3 shared-memory window
+ */
+class NodeSharedBuffer {
+public:
+  /**
+   * @brief Allocates the buffer of every node, collectively over a communicator
+   *
+   * @param bytes The size of the buffer of the node, only read on the first rank of each node
+   * @param comm The communicator whose ranks share the buffer of their node
+   */
+  NodeSharedBuffer(std::size_t bytes, MPI_Comm comm);
+
+  /// @brief Frees the buffer, collectively over the communicator
+  ~NodeSharedBuffer();
+
+  /// @brief The buffers are not copyable
+  NodeSharedBuffer(const NodeSharedBuffer&) = delete;
+
+  /// @brief The buffers are not copyable
+  NodeSharedBuffer& operator=(const NodeSharedBuffer&) = delete;
+
+  /// @brief The contents of the buffer
+  void* data() const { return data_; }
+
+  /// @brief The size of the buffer, in bytes
+  std::size_t size() const { return size_; }
+
+  /// @brief Whether this rank is the first rank of its node, which owns (and writes) the buffer
+  bool isNodeLeader() const { return node_rank_ == 0; }
+
+  /**
+   * @brief Completes the writes to the buffer (on any rank of the node) before the following reads, collectively
+   * over the ranks of the node
+   */
+  void fence() const;
+
+private:
+  /// @brief The ranks of the communicator on this node
+  MPI_Comm node_comm_;
+
+  /// @brief The rank of this rank in node_comm_
+  int node_rank_;
+
+  /// @brief The shared-memory window
+  MPI_Win window_;
+
+  /// @brief The contents of the buffer
+  void* data_ = nullptr;
+
+  /// @brief The size of the buffer, in bytes
+  std::size_t size_ = 0;
+
+  /// @brief The accounting of the memory of the buffer, on the first rank of the node only
+  memory::Tracker tracker_;
+};
+
+/**
+ * @brief A read-only array stored once per node (see NodeSharedBuffer), e.g. for the tables that every rank needs
+ * a copy of
+ *
+ * @tparam T The type of the entries, which must be trivially copyable
+ */
+template <typename T>
+class NodeSharedArray {
+  static_assert(std::is_trivially_copyable_v<T>, "node-shared arrays only store trivially copyable types");
+
+public:
+  /**
+   * @brief Allocates and fills the array of every node, collectively over a communicator
+   *
+   * @param size The number of entries of the array of the node, only read on the first rank of each node
+   * @param comm The communicator whose ranks share the array of their node
+   * @param fill The function writing the entries, only called on the first rank of each node
+   */
+  NodeSharedArray(std::size_t size, MPI_Comm comm, const std::function<void(T*)>& fill)
+      : buffer_(sizeof(T) * size, comm)
+  {
+    if (buffer_.isNodeLeader()) {
+      fill(static_cast<T*>(buffer_.data()));
+    }
+    buffer_.fence();
+  }
+
+  /// @brief The entries
+  const T* data() const { return static_cast<const T*>(buffer_.data()); }
+
+  /// @brief The number of entries
+  std::size_t size() const { return buffer_.size() / sizeof(T); }
+
+  /// @brief An entry
+  const T& operator[](std::size_t i) const { return data()[i]; }
+
+  /// @brief The first entry
+  const T* begin() const { return data(); }
+
+  /// @brief The end of the entries
+  const T* end() const { return data() + size(); }
+
+private:
+  /// @brief The storage of the entries
+  NodeSharedBuffer buffer_;
+};
+
+}  // namespace serac
@@ -4,6 +4,9 @@
 //
 // SPDX-License-Identifier: (BSD-3-Clause)
 
+#include <cstdio>
+#include <fstream>
+
 #include "axom/slic/core/SimpleLogger.hpp"
 #include <gtest/gtest.h>
 #include "mfem.hpp"
@@ -246,6 +249,44 @@ TEST_F(InputTest, CoefBuildScalarFromVec)
 
 }  // namespace serac
 
+TEST(Input, ReadOnRoot)
+{
+  int rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  std::string path = "read_on_root.lua";
+  if (rank == 0) {
+    std::ofstream file(path);
+    file << "scale = 2.5\nvec = { x = 1.0, y = 2.0 }\nf = function(x) return scale * x end\n";
+  }
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  axom::sidre::DataStore datastore;
+  auto inlet = input::initialize(datastore, path, input::Language::Lua, "input_file", MPI_COMM_WORLD);
+
+  inlet.addDouble("scale").required();
+  auto& vec_table = inlet.addStruct("vec");
+  input::defineVectorInputFileSchema(vec_table);
+  inlet.addFunction("f", axom::inlet::FunctionTag::Double, {axom::inlet::FunctionTag::Double}, "");
+  EXPECT_TRUE(input::verify(inlet, MPI_COMM_WORLD));
+
+  // the functions are interpreted by every rank
+  double scale = inlet["scale"];
+  auto   vec   = vec_table.get<mfem::Vector>();
+  EXPECT_DOUBLE_EQ(scale, 2.5);
+  EXPECT_DOUBLE_EQ(vec(1), 2.0);
+  EXPECT_DOUBLE_EQ(inlet["f"].call<double>(3.0), 7.5);
+
+  // with a required value that is missing, the input fails to verify on every rank
+  inlet.addInt("missing").required();
+  EXPECT_FALSE(input::verify(inlet, MPI_COMM_WORLD));
+
+  MPI_Barrier(MPI_COMM_WORLD);
+  if (rank == 0) {
+    std::remove(path.c_str());
+  }
+}
+
 int main(int argc, char* argv[])
 {
   int result = 0;
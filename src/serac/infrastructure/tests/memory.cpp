@@ -0,0 +1,108 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/infrastructure/memory.hpp"
+
+#include "axom/slic/core/SimpleLogger.hpp"
+#include <gtest/gtest.h>
+
+#include "serac/infrastructure/accelerator.hpp"
+
+namespace serac {
+
+TEST(Memory, RecordsCurrentAndPeakUsage)
+{
+  auto before = memory::usage(memory::Subsystem::Matrices);
+
+  memory::recordAllocation(memory::Subsystem::Matrices, 1000);
+  memory::recordAllocation(memory::Subsystem::Matrices, 500);
+  memory::recordDeallocation(memory::Subsystem::Matrices, 1000);
+
+  auto after = memory::usage(memory::Subsystem::Matrices);
+  EXPECT_EQ(after.current, before.current + 500);
+  EXPECT_GE(after.peak, before.current + 1500);
+
+  memory::recordDeallocation(memory::Subsystem::Matrices, 500);
+  EXPECT_EQ(memory::usage(memory::Subsystem::Matrices).current, before.current);
+}
+
+TEST(Memory, TrackerReleasesItsMemory)
+{
+  auto before = memory::usage(memory::Subsystem::LookupTables).current;
+  {
+    memory::Tracker tracker(memory::Subsystem::LookupTables);
+    tracker.set(256);
+    EXPECT_EQ(memory::usage(memory::Subsystem::LookupTables).current, before + 256);
+
+    // copies account for the same memory again, as the objects that hold them copy it
+    memory::Tracker copy = tracker;
+    EXPECT_EQ(memory::usage(memory::Subsystem::LookupTables).current, before + 512);
+
+    tracker.set(128);
+    EXPECT_EQ(memory::usage(memory::Subsystem::LookupTables).current, before + 384);
+  }
+  EXPECT_EQ(memory::usage(memory::Subsystem::LookupTables).current, before);
+}
+
+TEST(Memory, SharedArraysAreAccountedUntilFreed)
+{
+  auto before = memory::usage(memory::Subsystem::QFunctionDerivatives).current;
+  {
+    auto array = accelerator::make_shared_array<ExecutionSpace::CPU, double>(100,
+                                                                             memory::Subsystem::QFunctionDerivatives);
+    EXPECT_EQ(memory::usage(memory::Subsystem::QFunctionDerivatives).current, before + 100 * sizeof(double));
+
+    auto copy = array;
+    EXPECT_EQ(memory::usage(memory::Subsystem::QFunctionDerivatives).current, before + 100 * sizeof(double));
+  }
+  EXPECT_EQ(memory::usage(memory::Subsystem::QFunctionDerivatives).current, before);
+}
+
+TEST(Memory, HostArraysAreInitializedAndAligned)
+{
+  // the entries are value-initialized (i.e. zero), whichever threads touch them first
+  auto* values = accelerator::make_host_array<double>(1000);
+  for (int i = 0; i < 1000; i++) {
+    EXPECT_EQ(values[i], 0.0);
+  }
+  accelerator::destroy_host_array(values, 1000);
+
+  // large arrays are aligned to the huge pages that back them
+  auto previous = accelerator::hostAllocation();
+  accelerator::configureHostAllocation({.first_touch = true, .huge_pages = true});
+  const std::size_t n     = 2 * accelerator::huge_page_size / sizeof(double);
+  auto*             large = accelerator::make_host_array<double>(n, 2);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(large) % accelerator::huge_page_size, 0);
+  EXPECT_EQ(large[n - 1], 0.0);
+  accelerator::destroy_host_array(large, n);
+  accelerator::configureHostAllocation(previous);
+}
+
+TEST(Memory, ReportIsCollective)
+{
+  memory::recordAllocation(memory::Subsystem::Other, 1 << 20);
+  memory::report("test");
+  memory::reportEstimate("a test", 1 << 20);
+  memory::recordDeallocation(memory::Subsystem::Other, 1 << 20);
+
+  EXPECT_GE(memory::totalUsage().peak, std::size_t(1 << 20));
+  EXPECT_GT(memory::peakResidentSetSize(), std::size_t(0));
+}
+
+}  // namespace serac
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  MPI_Init(&argc, &argv);
+
+  axom::slic::SimpleLogger logger;  // create & initialize test logger, finalized when exiting main scope
+
+  int result = RUN_ALL_TESTS();
+  MPI_Finalize();
+
+  return result;
+}
@@ -7,6 +7,9 @@
 #include <array>
 #include <cstring>
 #include <exception>
+#include <fstream>
+#include <sstream>
+#include <thread>
 
 #include "axom/slic/core/SimpleLogger.hpp"
 #include <gtest/gtest.h>
@@ -96,6 +99,74 @@ TEST(Profiling, Exception)
   MPI_Barrier(MPI_COMM_WORLD);
 }
 
+TEST(Profiling, CaliperPresets)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+  serac::profiling::initialize();
+
+  // the presets name configurations of their own, and anything else is taken as a config string
+  for (const char* preset : {"runtime-report", "spot", "roofline", "mpi-report"}) {
+    EXPECT_FALSE(serac::profiling::caliperConfig(preset).empty());
+  }
+  EXPECT_NE(serac::profiling::caliperConfig("roofline"), "roofline");
+  EXPECT_EQ(serac::profiling::caliperConfig("runtime-report(output=stdout)"), "runtime-report(output=stdout)");
+
+  serac::profiling::configure(serac::profiling::caliperConfig("mpi-report"));
+  {
+    SERAC_PROFILE_SCOPE("Reconfigured scope");
+  }
+  serac::profiling::finalize();
+
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
+TEST(Profiling, HotPathCounters)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  // the same name is the same counter, wherever it is used
+  const int id = serac::profiling::counterId("test events");
+  EXPECT_EQ(serac::profiling::counterId("test events"), id);
+  serac::profiling::resetCounters();
+
+  for (int i = 0; i < 10; i++) {
+    SERAC_COUNT("test events");
+  }
+  {
+    SERAC_TIME_SCOPE("test events");
+  }
+  EXPECT_EQ(serac::profiling::counterCount(id), 11u);
+
+  // the counts of other threads are included
+  std::thread([]() { SERAC_COUNT("test events"); }).join();
+  EXPECT_EQ(serac::profiling::counterCount(id), 12u);
+
+  serac::profiling::setCounterMode(serac::profiling::CounterMode::Off);
+  SERAC_COUNT("test events");
+  EXPECT_EQ(serac::profiling::counterCount(id), 12u);
+  serac::profiling::setCounterMode(serac::profiling::CounterMode::Timed);
+
+  serac::profiling::reportCounters(MPI_COMM_WORLD, "Test counters");
+
+  // the same totals, summed over the ranks, in a file that scripts can read
+  serac::profiling::writeCounters(MPI_COMM_WORLD, "test_counters.json");
+  int rank = 0, num_ranks = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+  if (rank == 0) {
+    std::ifstream     file("test_counters.json");
+    std::stringstream contents;
+    contents << file.rdbuf();
+    std::string expected = "\"test events\": {\"count\": " + std::to_string(12 * num_ranks) + ",";
+    EXPECT_NE(contents.str().find(expected), std::string::npos);
+  }
+
+  serac::profiling::resetCounters();
+  EXPECT_EQ(serac::profiling::counterCount(id), 0u);
+
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
 struct NonCopyableOrMovable {
   int value                                         = 0;
   NonCopyableOrMovable()                            = default;
@@ -6,12 +6,31 @@
 
 #include "serac/mesh/mesh_utils.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
 #include <fstream>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <sstream>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include "axom/core.hpp"
 #include "axom/fmt.hpp"
 
+#include "serac/infrastructure/initialize.hpp"
 #include "serac/infrastructure/logger.hpp"
+#include "serac/infrastructure/shared_memory.hpp"
 #include "serac/infrastructure/terminator.hpp"
 
 namespace serac {
@@ -29,6 +48,10 @@ mfem::Mesh buildMeshFromFile(const std::string& mesh_file)
     SLIC_ERROR_ROOT(msg);
   }
 
+  if (mesh::isBinaryMeshFile(mesh_file)) {
+    return mesh::buildMeshFromBinaryFile(mesh_file);
+  }
+
   // This inherits from std::ifstream, and will work the same way as a std::ifstream,
   // but is required for Exodus meshes
   mfem::named_ifgzstream imesh(mesh_file);
@@ -403,6 +426,26 @@ void InputOptions::defineInputFileSchema(axom::inlet::Container& container)
   // `file` type mesh options
   container.addString("mesh", "Path to Mesh file");
 
+  // `box` and `file` type options: generate the box in parallel (without the refined serial mesh), or read
+  // a mesh partitioned into one file per rank (`<mesh>.<rank, 6 digits>`)
+  container.addBool("parallel", "Build or read the mesh in parallel, without a serial mesh on each rank.")
+      .defaultValue(false);
+
+  // Partitioning of the serial mesh
+  container.addString("partitioner", "Method partitioning the serial mesh among the ranks.")
+      .defaultValue("metis_kway")
+      .validValues({"metis_kway", "metis_recursive", "metis_volume", "hilbert"});
+  container.addDoubleArray("element_weights",
+                           "Load-balancing weight of the elements of each attribute, 1 if not given (hilbert only).");
+  container.addBool("reorder", "Order the elements along a Hilbert curve (and the DOFs with them) for locality.")
+      .defaultValue(false);
+  container.addBool("node_shared", "Refine and partition the serial mesh once per node, in node-shared memory.")
+      .defaultValue(false);
+
+  // Caching of the refined and distributed mesh
+  container.addString("cache_directory",
+                      "Directory of the cache of refined and distributed meshes, none if not given.");
+
   // `box` type mesh generation options
   auto& elements = container.addStruct("elements");
   // TODO: Can these be specified as required if elements is defined?
@@ -420,15 +463,124 @@ void InputOptions::defineInputFileSchema(axom::inlet::Container& container)
   container.addInt("approx_elements", "Approximate number of elements in an n-ball mesh");
 }
 
+namespace {
+
+/// @brief Extends an FNV-1a hash with some bytes
+std::uint64_t fnv1a(const char* bytes, std::size_t size, std::uint64_t hash = 14695981039346656037ull)
+{
+  for (std::size_t i = 0; i < size; i++) {
+    hash = (hash ^ static_cast<unsigned char>(bytes[i])) * 1099511628211ull;
+  }
+  return hash;
+}
+
+/// @brief A hash of the contents of a file, read by the first rank of a communicator only
+std::uint64_t fileHash(const std::string& file_name, const MPI_Comm comm)
+{
+  auto          rank = getMPIInfo(comm).second;
+  std::uint64_t hash = 0;
+  if (rank == 0) {
+    std::ifstream file(file_name, std::ios::binary);
+    SLIC_ERROR_IF(!file, axom::fmt::format("Can not open mesh file: '{0}'", file_name));
+    hash = fnv1a(nullptr, 0);
+    std::vector<char> buffer(1 << 20);
+    while (file) {
+      file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+      hash = fnv1a(buffer.data(), static_cast<std::size_t>(file.gcount()), hash);
+    }
+  }
+  MPI_Bcast(&hash, 1, MPI_UINT64_T, 0, comm);
+  return hash;
+}
+
+/// @brief The prefix of the cached files of the mesh of a set of input options, on a number of ranks
+std::string cachedMeshPrefix(const InputOptions& options, const MPI_Comm comm)
+{
+  std::string key;
+  if (const auto file_opts = std::get_if<FileInputOptions>(&options.extra_options)) {
+    key = axom::fmt::format("file {:016x}", fileHash(file_opts->absolute_mesh_file_name, comm));
+  } else if (const auto box_opts = std::get_if<BoxInputOptions>(&options.extra_options)) {
+    key = axom::fmt::format("box {} {:.17g} {}", axom::fmt::join(box_opts->elements, ","),
+                            axom::fmt::join(box_opts->overall_size, ","), box_opts->parallel_generation);
+  } else if (const auto ball_opts = std::get_if<NBallInputOptions>(&options.extra_options)) {
+    key = axom::fmt::format("ball {} {}", ball_opts->approx_elements, ball_opts->dimension);
+  }
+
+  // the weights are sorted by attribute, so that the key doesn't depend on the order of the map
+  std::map<int, double> weights(options.partition.attribute_weights.begin(), options.partition.attribute_weights.end());
+  key += axom::fmt::format(" refine {} {} partition {} {} {}", options.ser_ref_levels, options.par_ref_levels,
+                           static_cast<int>(options.partition.method), options.partition.reorder,
+                           options.partition.node_shared);
+  for (const auto& [attribute, weight] : weights) {
+    key += axom::fmt::format(" {}:{:.17g}", attribute, weight);
+  }
+
+  auto num_procs = getMPIInfo(comm).first;
+  return axom::utilities::filesystem::joinPath(
+      options.cache_directory, axom::fmt::format("mesh_{:016x}_np{}", fnv1a(key.data(), key.size()), num_procs));
+}
+
+}  // namespace
+
 std::unique_ptr<mfem::ParMesh> buildParallelMesh(const InputOptions& options, const MPI_Comm comm)
+{
+  if (options.cache_directory.empty()) {
+    return buildUncachedParallelMesh(options, comm);
+  }
+
+  const int         rank   = getMPIInfo(comm).second;
+  const std::string prefix = cachedMeshPrefix(options, comm);
+
+  // the cache is only used if the files of all the ranks are there
+  int cached = axom::utilities::filesystem::pathExists(axom::fmt::format("{}.{:06}", prefix, rank));
+  MPI_Allreduce(MPI_IN_PLACE, &cached, 1, MPI_INT, MPI_LAND, comm);
+  if (cached) {
+    SLIC_INFO_ROOT(axom::fmt::format("Reading the cached mesh '{0}'", prefix));
+    return buildPartitionedMeshFromFiles(prefix, 0, comm);
+  }
+
+  auto mesh = buildUncachedParallelMesh(options, comm);
+
+  if (rank == 0) {
+    axom::utilities::filesystem::makeDirsForPath(options.cache_directory);
+  }
+  MPI_Barrier(comm);
+
+  // each file is written under a temporary name and then renamed, so that runs (e.g. the groups of an ensemble)
+  // building the same mesh at the same time never read a partially written file
+  int world_rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &world_rank);
+  const std::string temporary_prefix = axom::fmt::format("{}.tmp{}", prefix, world_rank);
+  writePartitionedMesh(*mesh, temporary_prefix);
+  std::rename(axom::fmt::format("{}.{:06}", temporary_prefix, rank).c_str(),
+              axom::fmt::format("{}.{:06}", prefix, rank).c_str());
+  SLIC_INFO_ROOT(axom::fmt::format("Wrote the mesh to the cache '{0}'", prefix));
+
+  return mesh;
+}
+
+std::unique_ptr<mfem::ParMesh> buildUncachedParallelMesh(const InputOptions& options, const MPI_Comm comm)
 {
   std::optional<mfem::Mesh> serial_mesh;
 
   if (const auto file_opts = std::get_if<FileInputOptions>(&options.extra_options)) {
     SLIC_ERROR_ROOT_IF(file_opts->absolute_mesh_file_name.empty(),
                        "Absolute path to mesh file was not configured, did you forget to call findMeshFilePath?");
+    if (file_opts->partitioned) {
+      // the serial refinements of an already distributed mesh are parallel ones
+      return buildPartitionedMeshFromFiles(file_opts->absolute_mesh_file_name,
+                                           options.ser_ref_levels + options.par_ref_levels, comm);
+    }
+    // the parts of a binary mesh file partitioned for this number of ranks are read by their ranks only
+    if (binaryMeshParts(file_opts->absolute_mesh_file_name) == getMPIInfo(comm).first) {
+      return buildParallelMeshFromBinaryFile(file_opts->absolute_mesh_file_name,
+                                             options.ser_ref_levels + options.par_ref_levels, comm);
+    }
     serial_mesh.emplace(buildMeshFromFile(file_opts->absolute_mesh_file_name));
   } else if (const auto box_opts = std::get_if<BoxInputOptions>(&options.extra_options)) {
+    if (box_opts->parallel_generation) {
+      return buildParallelBoxMesh(*box_opts, options.ser_ref_levels, options.par_ref_levels, comm, options.partition);
+    }
     const auto& elems = box_opts->elements;
     const auto& sizes = box_opts->overall_size;
     if (elems.size() == 2) {
@@ -446,19 +598,371 @@ std::unique_ptr<mfem::ParMesh> buildParallelMesh(const InputOptions& options, co
   }
 
   SLIC_ERROR_ROOT_IF(!serial_mesh, "Mesh input options were invalid");
-  return refineAndDistribute(std::move(*serial_mesh), options.ser_ref_levels, options.par_ref_levels, comm);
+  return refineAndDistribute(std::move(*serial_mesh), options.ser_ref_levels, options.par_ref_levels, comm,
+                             options.partition);
 }
 
-std::unique_ptr<mfem::ParMesh> refineAndDistribute(mfem::Mesh&& serial_mesh, const int refine_serial,
-                                                   const int refine_parallel, const MPI_Comm comm)
+namespace {
+
+/**
+ * @brief The index of a point along a Hilbert curve through a grid of 2^bits points in each direction
+ *
+ * This is Skilling's algorithm ("Programming the Hilbert curve", 2004): the coordinates are transposed
+ * into the Hilbert index in place, and then interleaved.
+ *
+ * @param[inout] x The (integer) coordinates of the point, overwritten
+ * @param[in] dim The number of coordinates
+ * @param[in] bits The number of bits of each coordinate
+ */
+std::uint64_t hilbertIndex(std::array<std::uint32_t, 3>& x, int dim, int bits)
+{
+  const std::uint32_t top = 1u << (bits - 1);
+
+  // inverse undo
+  for (std::uint32_t q = top; q > 1; q >>= 1) {
+    const std::uint32_t p = q - 1;
+    for (int i = 0; i < dim; i++) {
+      if (x[i] & q) {
+        x[0] ^= p;
+      } else {
+        const std::uint32_t t = (x[0] ^ x[i]) & p;
+        x[0] ^= t;
+        x[i] ^= t;
+      }
+    }
+  }
+
+  // Gray encode
+  for (int i = 1; i < dim; i++) {
+    x[i] ^= x[i - 1];
+  }
+  std::uint32_t t = 0;
+  for (std::uint32_t q = top; q > 1; q >>= 1) {
+    if (x[dim - 1] & q) {
+      t ^= q - 1;
+    }
+  }
+  for (int i = 0; i < dim; i++) {
+    x[i] ^= t;
+  }
+
+  // interleave the transposed index, most significant bits first
+  std::uint64_t index = 0;
+  for (int b = bits - 1; b >= 0; b--) {
+    for (int i = 0; i < dim; i++) {
+      index = (index << 1) | ((x[i] >> b) & 1u);
+    }
+  }
+  return index;
+}
+
+}  // namespace
+
+std::vector<int> hilbertCurvePartitioning(const mfem::Mesh& mesh, int num_parts,
+                                          const std::unordered_map<int, double>& attribute_weights)
+{
+  const int num_elements = mesh.GetNE();
+  const int dim          = mesh.SpaceDimension();
+  SLIC_ERROR_ROOT_IF(num_parts < 1 || num_parts > num_elements,
+                     axom::fmt::format("Cannot partition {} elements into {} parts", num_elements, num_parts));
+  SLIC_ERROR_ROOT_IF(dim < 1 || dim > 3, "Hilbert curve partitioning requires a 1D, 2D or 3D mesh");
+
+  // the center (vertex average) of each element, and their bounding box
+  std::vector<std::array<double, 3>> centers(static_cast<std::size_t>(num_elements), {0.0, 0.0, 0.0});
+  std::array<double, 3>              lower{}, upper{};
+  lower.fill(std::numeric_limits<double>::max());
+  upper.fill(std::numeric_limits<double>::lowest());
+  mfem::Array<int> vertices;
+  for (int e = 0; e < num_elements; e++) {
+    mesh.GetElementVertices(e, vertices);
+    auto& center = centers[static_cast<std::size_t>(e)];
+    for (int v : vertices) {
+      const double* coords = mesh.GetVertex(v);
+      for (int d = 0; d < dim; d++) {
+        center[static_cast<std::size_t>(d)] += coords[d] / vertices.Size();
+      }
+    }
+    for (std::size_t d = 0; d < static_cast<std::size_t>(dim); d++) {
+      lower[d] = std::min(lower[d], center[d]);
+      upper[d] = std::max(upper[d], center[d]);
+    }
+  }
+
+  // order the elements along the curve through a grid of 2^bits points (in each direction) over the box
+  const int                  bits      = (dim == 3) ? 21 : 31;
+  const double               max_index = std::ldexp(1.0, bits) - 1.0;
+  std::vector<std::uint64_t> keys(static_cast<std::size_t>(num_elements));
+  for (std::size_t e = 0; e < keys.size(); e++) {
+    std::array<std::uint32_t, 3> x{0, 0, 0};
+    for (std::size_t d = 0; d < static_cast<std::size_t>(dim); d++) {
+      const double extent = upper[d] - lower[d];
+      const double scaled = (extent > 0.0) ? (centers[e][d] - lower[d]) / extent : 0.0;
+      x[d]                = static_cast<std::uint32_t>(scaled * max_index);
+    }
+    keys[e] = hilbertIndex(x, dim, bits);
+  }
+  std::vector<int> order(static_cast<std::size_t>(num_elements));
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&keys](int a, int b) {
+    return keys[static_cast<std::size_t>(a)] < keys[static_cast<std::size_t>(b)];
+  });
+
+  auto weight = [&mesh, &attribute_weights](int e) {
+    auto found = attribute_weights.find(mesh.GetAttribute(e));
+    return (found == attribute_weights.end()) ? 1.0 : found->second;
+  };
+  double total_weight = 0.0;
+  for (int e = 0; e < num_elements; e++) {
+    SLIC_ERROR_ROOT_IF(weight(e) <= 0.0, "Partitioning weights must be positive");
+    total_weight += weight(e);
+  }
+
+  // Cut the curve where its cumulative weight crosses multiples of total_weight / num_parts (at the middle
+  // of each element), moving on by at most one part per element, and leaving an element for each later part
+  std::vector<int> partitioning(static_cast<std::size_t>(num_elements));
+  double           cumulative_weight = 0.0;
+  int              part              = 0;
+  for (int i = 0; i < num_elements; i++) {
+    const int    e         = order[static_cast<std::size_t>(i)];
+    const double w         = weight(e);
+    const int    candidate = static_cast<int>((cumulative_weight + 0.5 * w) * num_parts / total_weight);
+    part                   = std::clamp(candidate, part, part + (i > 0 ? 1 : 0));
+    part                   = std::clamp(part, num_parts - (num_elements - i), num_parts - 1);
+    partitioning[static_cast<std::size_t>(e)] = part;
+    cumulative_weight += w;
+  }
+  return partitioning;
+}
+
+namespace {
+
+/**
+ * @brief Refines a serial mesh, orders its elements along a Hilbert curve (if requested) and partitions it
+ *
+ * @param[inout] serial_mesh The serial mesh, refined and reordered in place
+ * @param[in] refine_serial The number of serial refinements
+ * @param[in] num_parts The number of parts
+ * @param[in] partition How the refined serial mesh is partitioned
+ *
+ * @return The part of each element of the refined serial mesh
+ */
+std::vector<int> refineAndPartition(mfem::Mesh& serial_mesh, const int refine_serial, const int num_parts,
+                                    const PartitionOptions& partition)
 {
   // Serial refinement first
   for (int lev = 0; lev < refine_serial; lev++) {
     serial_mesh.UniformRefinement();
   }
 
-  // Then create the parallel mesh and apply parallel refinement
-  auto parallel_mesh = std::make_unique<mfem::ParMesh>(comm, serial_mesh);
+  // Order the elements along a space-filling curve, which the parts keep, and the vertices (and so the
+  // DOFs of the spaces built on the mesh) by the first element that uses them
+  if (partition.reorder) {
+    mfem::Array<int> ordering;
+    serial_mesh.GetHilbertOrdering(ordering);
+    serial_mesh.ReorderElements(ordering, true);
+  }
+
+  // Partition the refined serial mesh
+  std::vector<int> partitioning;
+  switch (partition.method) {
+    case Partitioner::HilbertCurve:
+      partitioning = hilbertCurvePartitioning(serial_mesh, num_parts, partition.attribute_weights);
+      break;
+    default: {
+      // the part_method numbering of mfem::Mesh::GeneratePartitioning
+      const int part_method = (partition.method == Partitioner::METISRecursive) ? 0
+                              : (partition.method == Partitioner::METISVolume)  ? 2
+                                                                                : 1;
+      int* metis_partitioning = serial_mesh.GeneratePartitioning(num_parts, part_method);
+      partitioning.assign(metis_partitioning, metis_partitioning + serial_mesh.GetNE());
+      delete[] metis_partitioning;
+    }
+  }
+  return partitioning;
+}
+
+/**
+ * @brief Distributes a serial mesh that is refined and partitioned on the first rank of each node only (see
+ * PartitionOptions::node_shared), which writes the parts of all the ranks of its node into node-shared memory
+ *
+ * @param[in] serial_mesh The serial mesh, only used on the first rank of each node
+ * @param[in] refine_serial The number of serial refinements
+ * @param[in] comm The MPI communicator
+ * @param[in] partition How the refined serial mesh is partitioned among the ranks
+ *
+ * @return The (unrefined) parallel mesh
+ */
+std::unique_ptr<mfem::ParMesh> distributeFromNodeLeaders(mfem::Mesh&& serial_mesh, const int refine_serial,
+                                                         const MPI_Comm comm, const PartitionOptions& partition)
+{
+  auto [num_procs, rank] = getMPIInfo(comm);
+  const auto node_ranks  = nodeRanks(comm);
+  const bool node_leader = (node_ranks.front() == rank);
+
+  // the parts of the ranks of the node (in the format of mfem::ParMesh::ParPrint), one after the other
+  std::string              parts;
+  std::vector<std::size_t> offsets{0};
+  if (node_leader) {
+    auto partitioning = refineAndPartition(serial_mesh, refine_serial, num_procs, partition);
+
+    mfem::MeshPartitioner partitioner(serial_mesh, num_procs, partitioning.data());
+    mfem::MeshPart        mesh_part;
+    for (int node_rank : node_ranks) {
+      partitioner.ExtractPart(node_rank, mesh_part);
+      std::ostringstream part;
+      part.precision(std::numeric_limits<double>::max_digits10);
+      mesh_part.Print(part);
+      parts += part.str();
+      offsets.push_back(parts.size());
+    }
+  }
+  serial_mesh = mfem::Mesh();
+
+  const NodeSharedArray<std::size_t> shared_offsets(offsets.size(), comm, [&offsets](std::size_t* data) {
+    std::copy(offsets.begin(), offsets.end(), data);
+  });
+  const NodeSharedArray<char> shared_parts(parts.size(), comm, [&parts](char* data) {
+    std::copy(parts.begin(), parts.end(), data);
+  });
+  parts = std::string();
+
+  // each rank only parses (and copies) its own part
+  const auto local = static_cast<std::size_t>(std::find(node_ranks.begin(), node_ranks.end(), rank) -
+                                              node_ranks.begin());
+  std::istringstream part(
+      std::string(shared_parts.data() + shared_offsets[local], shared_parts.data() + shared_offsets[local + 1]));
+  return std::make_unique<mfem::ParMesh>(comm, part);
+}
+
+}  // namespace
+
+std::unique_ptr<mfem::ParMesh> refineAndDistribute(mfem::Mesh&& serial_mesh, const int refine_serial,
+                                                   const int refine_parallel, const MPI_Comm comm,
+                                                   const PartitionOptions&                      partition,
+                                                   std::vector<std::unique_ptr<mfem::ParMesh>>* coarse_meshes)
+{
+  SLIC_ERROR_ROOT_IF(partition.reorder && (serial_mesh.NURBSext || serial_mesh.ncmesh),
+                     "Element reordering is not supported for NURBS or nonconforming meshes");
+  SLIC_ERROR_ROOT_IF(partition.method != Partitioner::HilbertCurve && !partition.attribute_weights.empty(),
+                     "Element weights are only supported by the Hilbert curve partitioner");
+  SLIC_ERROR_ROOT_IF(partition.node_shared && (serial_mesh.NURBSext || serial_mesh.ncmesh || serial_mesh.GetNodes()),
+                     "Node-shared distribution is not supported for NURBS, nonconforming or curved meshes");
+
+  std::unique_ptr<mfem::ParMesh> parallel_mesh;
+  if (partition.node_shared) {
+    parallel_mesh = distributeFromNodeLeaders(std::move(serial_mesh), refine_serial, comm, partition);
+  } else {
+    auto partitioning = refineAndPartition(serial_mesh, refine_serial, getMPIInfo(comm).first, partition);
+    parallel_mesh     = std::make_unique<mfem::ParMesh>(comm, serial_mesh, partitioning.data());
+  }
+
+  // Then apply the parallel refinement
+  for (int lev = 0; lev < refine_parallel; lev++) {
+    // each kept level is refined into a copy of itself, whose refinement transformations (used by the
+    // transfer operators between the levels) then describe its elements in terms of those of the kept level
+    if (coarse_meshes) {
+      auto refined = std::make_unique<mfem::ParMesh>(*parallel_mesh);
+      coarse_meshes->push_back(std::move(parallel_mesh));
+      parallel_mesh = std::move(refined);
+    }
+    parallel_mesh->UniformRefinement();
+  }
+
+  parallel_mesh->EnsureNodes();
+  parallel_mesh->ExchangeFaceNbrData();
+
+  return parallel_mesh;
+}
+
+std::unique_ptr<mfem::ParMesh> buildParallelBoxMesh(const BoxInputOptions& options, const int refine_serial,
+                                                    const int refine_parallel, const MPI_Comm comm,
+                                                    const PartitionOptions& partition)
+{
+  const auto& elems = options.elements;
+  const auto& sizes = options.overall_size;
+  SLIC_ERROR_ROOT_IF(elems.size() != 2 && elems.size() != 3, "Box meshes must be 2D or 3D");
+
+  // The box has elems * 2^levels elements in each direction. It is the refinement (in parallel) of the boxes whose
+  // numbers of elements are that divided by a power of two, the largest of which is the one of the original
+  // levels of serial refinement.
+  const int levels              = refine_serial + refine_parallel;
+  int       max_parallel_levels = std::numeric_limits<int>::max();
+  for (int n : elems) {
+    SLIC_ERROR_ROOT_IF(n < 1, "The number of elements of a box must be positive in each direction");
+    int halvings = 0;
+    for (; n % 2 == 0; n /= 2) {
+      halvings++;
+    }
+    max_parallel_levels = std::min(max_parallel_levels, levels + halvings);
+  }
+
+  auto coarse_elements = [&elems, levels](int parallel_levels) {
+    std::vector<long long> coarse;
+    for (int n : elems) {
+      coarse.push_back((static_cast<long long>(n) << levels) >> parallel_levels);
+    }
+    return coarse;
+  };
+  auto num_elements = [](const std::vector<long long>& n) {
+    return std::accumulate(n.begin(), n.end(), 1LL, std::multiplies<long long>());
+  };
+
+  // the coarsest of them with an element per rank
+  auto [num_procs, rank] = getMPIInfo(comm);
+  int parallel_levels    = max_parallel_levels;
+  while (parallel_levels > refine_parallel && num_elements(coarse_elements(parallel_levels)) < num_procs) {
+    parallel_levels--;
+  }
+
+  auto coarse = coarse_elements(parallel_levels);
+  for (long long n : coarse) {
+    SLIC_ERROR_ROOT_IF(n > std::numeric_limits<int>::max(), "Too many elements in the coarse box mesh");
+  }
+  SLIC_INFO_ROOT(axom::fmt::format("Distributing a box mesh of {} elements, refined {} times in parallel",
+                                   num_elements(coarse), parallel_levels));
+
+  mfem::Mesh serial_mesh =
+      (elems.size() == 2)
+          ? buildRectangleMesh(static_cast<int>(coarse[0]), static_cast<int>(coarse[1]), sizes.at(0), sizes.at(1))
+          : buildCuboidMesh(static_cast<int>(coarse[0]), static_cast<int>(coarse[1]), static_cast<int>(coarse[2]),
+                            sizes.at(0), sizes.at(1), sizes.at(2));
+  return refineAndDistribute(std::move(serial_mesh), 0, parallel_levels, comm, partition);
+}
+
+std::unique_ptr<mfem::ParSubMesh> buildSubmesh(const mfem::ParMesh& parent, const std::set<int>& attributes)
+{
+  SLIC_ERROR_ROOT_IF(attributes.empty(), "A submesh needs the attributes of its elements");
+
+  mfem::Array<int> domain_attributes;
+  for (int attribute : attributes) {
+    domain_attributes.Append(attribute);
+  }
+
+  auto submesh = std::make_unique<mfem::ParSubMesh>(mfem::ParSubMesh::CreateFromDomain(parent, domain_attributes));
+  submesh->EnsureNodes();
+  submesh->ExchangeFaceNbrData();
+  return submesh;
+}
+
+std::unique_ptr<mfem::ParMesh> buildPartitionedMeshFromFiles(const std::string& mesh_prefix, const int refine_parallel,
+                                                             const MPI_Comm comm)
+{
+  auto [num_procs, rank] = getMPIInfo(comm);
+  SLIC_INFO_ROOT(axom::fmt::format("Opening partitioned mesh files: '{0}.*'", mesh_prefix));
+  SLIC_ERROR_ROOT_IF(axom::utilities::filesystem::pathExists(axom::fmt::format("{}.{:06}", mesh_prefix, num_procs)),
+                     axom::fmt::format("Partitioned mesh '{}' has more parts than the {} ranks", mesh_prefix,
+                                       num_procs));
+
+  // Each rank only reads its own part
+  const std::string mesh_file = axom::fmt::format("{}.{:06}", mesh_prefix, rank);
+  serac::logger::flush();
+  SLIC_ERROR_IF(!axom::utilities::filesystem::pathExists(mesh_file),
+                axom::fmt::format("Given mesh file does not exist: '{0}'", mesh_file));
+
+  mfem::named_ifgzstream imesh(mesh_file);
+  SLIC_ERROR_IF(!imesh, axom::fmt::format("Can not open mesh file: '{0}'", mesh_file));
+
+  auto parallel_mesh = std::make_unique<mfem::ParMesh>(comm, imesh);
   for (int lev = 0; lev < refine_parallel; lev++) {
     parallel_mesh->UniformRefinement();
   }
@@ -469,14 +973,542 @@ std::unique_ptr<mfem::ParMesh> refineAndDistribute(mfem::Mesh&& serial_mesh, con
   return parallel_mesh;
 }
 
+void writePartitionedMesh(const mfem::ParMesh& mesh, const std::string& mesh_prefix)
+{
+  auto [num_procs, rank] = getMPIInfo(mesh.GetComm());
+  const std::string mesh_file = axom::fmt::format("{}.{:06}", mesh_prefix, rank);
+  std::ofstream     omesh(mesh_file);
+  SLIC_ERROR_IF(!omesh, axom::fmt::format("Can not open mesh file: '{0}'", mesh_file));
+  omesh.precision(std::numeric_limits<double>::max_digits10);
+  mesh.ParPrint(omesh);
+}
+
+namespace {
+
+/// @brief The first bytes of a binary mesh file
+constexpr char binary_mesh_magic[8] = {'S', 'E', 'R', 'A', 'C', 'M', 'S', 'H'};
+
+/// @brief The version of the binary mesh format, which also tells files written in another byte order apart
+constexpr std::uint32_t binary_mesh_version = 1;
+
+/// @brief The location of an array in a binary mesh file
+struct BinaryMeshSection {
+  std::int64_t offset = 0;  ///< the position of its first byte, a multiple of 8
+  std::int64_t size   = 0;  ///< the number of bytes
+};
+
+/// @brief The arrays of the elements (or boundary elements) of a binary mesh file
+struct BinaryMeshElements {
+  BinaryMeshSection geometries;  ///< the mfem::Geometry::Type of each element, as int32
+  BinaryMeshSection attributes;  ///< the attribute of each element, as int32
+  BinaryMeshSection offsets;     ///< where the vertices of each element start in the next array, as int64
+  BinaryMeshSection vertices;    ///< the vertices of all the elements, one element after the other, as int32
+};
+
+/// @brief The header at the beginning of a binary mesh file, which locates its arrays
+struct BinaryMeshHeader {
+  char               magic[8];               ///< binary_mesh_magic
+  std::uint32_t      version;                ///< binary_mesh_version
+  std::int32_t       dimension;              ///< the dimension of the elements
+  std::int32_t       space_dimension;        ///< the dimension of the vertices
+  std::int32_t       num_parts;              ///< the number of parts of the precomputed partition, or zero
+  std::int64_t       num_vertices;           ///< the number of vertices
+  std::int64_t       num_elements;           ///< the number of elements
+  std::int64_t       num_boundary_elements;  ///< the number of boundary elements
+  BinaryMeshSection  vertices;               ///< the coordinates of the vertices, one vertex after the other
+  BinaryMeshElements elements;               ///< the elements
+  BinaryMeshElements boundary_elements;      ///< the boundary elements
+  BinaryMeshSection  nodes_collection;       ///< the name of the collection of the nodes, empty for straight meshes
+  std::int32_t       nodes_vdim;             ///< the number of components of the nodes
+  std::int32_t       nodes_ordering;         ///< the mfem::Ordering::Type of the nodes
+  BinaryMeshSection  nodes;                  ///< the values of the nodes
+  BinaryMeshSection  part_offsets;           ///< where each part starts (and the last one ends) in the next array
+  BinaryMeshSection  parts;                  ///< the mesh of each part, in the format of mfem::ParMesh::ParPrint
+};
+
+static_assert(std::is_trivially_copyable_v<BinaryMeshHeader>, "the header is written and mapped as raw bytes");
+
+/// @brief Appends an array to a binary mesh file, at the next multiple of 8 bytes, and returns its section
+template <typename T>
+BinaryMeshSection appendSection(std::ofstream& file, const T* data, std::size_t count)
+{
+  const std::int64_t position = file.tellp();
+  const std::int64_t padding  = (8 - position % 8) % 8;
+  const char         zeros[8] = {};
+  file.write(zeros, padding);
+
+  BinaryMeshSection section{position + padding, static_cast<std::int64_t>(count * sizeof(T))};
+  file.write(reinterpret_cast<const char*>(data), section.size);
+  return section;
+}
+
+/// @brief Appends the arrays of the elements (or boundary elements) of a mesh to a binary mesh file
+BinaryMeshElements appendElements(std::ofstream& file, const mfem::Mesh& mesh, bool boundary)
+{
+  const int                 n = boundary ? mesh.GetNBE() : mesh.GetNE();
+  std::vector<std::int32_t> geometries(static_cast<std::size_t>(n));
+  std::vector<std::int32_t> attributes(static_cast<std::size_t>(n));
+  std::vector<std::int64_t> offsets{0};
+  std::vector<std::int32_t> vertices;
+
+  mfem::Array<int> element_vertices;
+  for (int i = 0; i < n; i++) {
+    const mfem::Element* element = boundary ? mesh.GetBdrElement(i) : mesh.GetElement(i);
+    element->GetVertices(element_vertices);
+    geometries[static_cast<std::size_t>(i)] = element->GetGeometryType();
+    attributes[static_cast<std::size_t>(i)] = element->GetAttribute();
+    vertices.insert(vertices.end(), element_vertices.begin(), element_vertices.end());
+    offsets.push_back(static_cast<std::int64_t>(vertices.size()));
+  }
+
+  BinaryMeshElements sections;
+  sections.geometries = appendSection(file, geometries.data(), geometries.size());
+  sections.attributes = appendSection(file, attributes.data(), attributes.size());
+  sections.offsets    = appendSection(file, offsets.data(), offsets.size());
+  sections.vertices   = appendSection(file, vertices.data(), vertices.size());
+  return sections;
+}
+
+/// @brief Reads the header of a binary mesh file, and whether it is one
+bool readBinaryMeshHeader(const std::string& mesh_file, BinaryMeshHeader& header)
+{
+  std::ifstream file(mesh_file, std::ios::binary);
+  if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+    return false;
+  }
+  if (!std::equal(std::begin(binary_mesh_magic), std::end(binary_mesh_magic), header.magic)) {
+    return false;
+  }
+  SLIC_ERROR_IF(header.version != binary_mesh_version,
+                axom::fmt::format("Binary mesh file '{}' has version {} instead of {} (or another byte order)",
+                                  mesh_file, header.version, binary_mesh_version));
+  return true;
+}
+
+/**
+ * @brief A binary mesh file, mapped (read only) into memory
+ *
+ * Only the pages of the file that are accessed are read, so the rank of each part of a partitioned file only reads
+ * the header and its own part.
+ */
+class MappedBinaryMesh {
+public:
+  /// @brief Maps a binary mesh file into memory
+  explicit MappedBinaryMesh(const std::string& mesh_file) : name_(mesh_file)
+  {
+    const int descriptor = open(mesh_file.c_str(), O_RDONLY);
+    SLIC_ERROR_IF(descriptor < 0, axom::fmt::format("Can not open mesh file: '{0}'", mesh_file));
+
+    struct stat status;
+    fstat(descriptor, &status);
+    size_ = static_cast<std::size_t>(status.st_size);
+    SLIC_ERROR_IF(size_ < sizeof(BinaryMeshHeader), axom::fmt::format("'{}' is not a binary mesh file", mesh_file));
+
+    data_ = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    close(descriptor);
+    // i.e. MAP_FAILED
+    SLIC_ERROR_IF(data_ == reinterpret_cast<void*>(std::intptr_t{-1}),
+                  axom::fmt::format("Can not map mesh file into memory: '{0}'", mesh_file));
+
+    SLIC_ERROR_IF(!std::equal(std::begin(binary_mesh_magic), std::end(binary_mesh_magic), header().magic),
+                  axom::fmt::format("'{}' is not a binary mesh file", mesh_file));
+    SLIC_ERROR_IF(header().version != binary_mesh_version,
+                  axom::fmt::format("Binary mesh file '{}' has version {} instead of {} (or another byte order)",
+                                    mesh_file, header().version, binary_mesh_version));
+  }
+
+  MappedBinaryMesh(const MappedBinaryMesh&)            = delete;
+  MappedBinaryMesh& operator=(const MappedBinaryMesh&) = delete;
+
+  /// @brief Unmaps the file
+  ~MappedBinaryMesh() { munmap(data_, size_); }
+
+  /// @brief The header of the file
+  const BinaryMeshHeader& header() const { return *static_cast<const BinaryMeshHeader*>(data_); }
+
+  /// @brief An array of the file, of (at least) @a count values of type T
+  template <typename T>
+  const T* array(const BinaryMeshSection& section, std::int64_t count) const
+  {
+    SLIC_ERROR_IF(section.offset < 0 || section.size < count * static_cast<std::int64_t>(sizeof(T)) ||
+                      static_cast<std::size_t>(section.offset + section.size) > size_,
+                  axom::fmt::format("Binary mesh file '{}' is truncated or corrupt", name_));
+    return reinterpret_cast<const T*>(static_cast<const char*>(data_) + section.offset);
+  }
+
+private:
+  /// @brief The name of the file
+  std::string name_;
+
+  /// @brief The mapped file
+  void* data_ = nullptr;
+
+  /// @brief The size of the file
+  std::size_t size_ = 0;
+};
+
+/// @brief Adds the elements (or boundary elements) of a binary mesh file to a mesh
+void addElements(const MappedBinaryMesh& file, const BinaryMeshElements& sections, std::int64_t n, bool boundary,
+                 mfem::Mesh& mesh)
+{
+  const auto* geometries = file.array<std::int32_t>(sections.geometries, n);
+  const auto* attributes = file.array<std::int32_t>(sections.attributes, n);
+  const auto* offsets    = file.array<std::int64_t>(sections.offsets, n + 1);
+  const auto* vertices   = file.array<std::int32_t>(sections.vertices, offsets[n]);
+
+  for (std::int64_t i = 0; i < n; i++) {
+    mfem::Element* element = mesh.NewElement(geometries[i]);
+    SLIC_ERROR_IF(offsets[i + 1] - offsets[i] != element->GetNVertices(),
+                  "Binary mesh file has an element with the wrong number of vertices");
+    element->SetVertices(vertices + offsets[i]);
+    element->SetAttribute(attributes[i]);
+    if (boundary) {
+      mesh.AddBdrElement(element);
+    } else {
+      mesh.AddElement(element);
+    }
+  }
+}
+
+}  // namespace
+
+void writeBinaryMesh(mfem::Mesh& mesh, const std::string& mesh_file, const int num_parts,
+                     const PartitionOptions& partition)
+{
+  SLIC_ERROR_IF(mesh.NURBSext || mesh.ncmesh, "Binary mesh files do not support NURBS or nonconforming meshes");
+  SLIC_ERROR_IF(num_parts > 0 && mesh.GetNodes(), "Binary mesh files of curved meshes can not be partitioned");
+
+  // the elements are reordered (if at all) before they are written, so that the parts are those of the written mesh
+  std::vector<int> partitioning;
+  if (num_parts > 0) {
+    partitioning = refineAndPartition(mesh, 0, num_parts, partition);
+  }
+
+  std::ofstream file(mesh_file, std::ios::binary);
+  SLIC_ERROR_IF(!file, axom::fmt::format("Can not open mesh file: '{0}'", mesh_file));
+
+  BinaryMeshHeader header{};
+  std::copy(std::begin(binary_mesh_magic), std::end(binary_mesh_magic), header.magic);
+  header.version               = binary_mesh_version;
+  header.dimension             = mesh.Dimension();
+  header.space_dimension       = mesh.SpaceDimension();
+  header.num_parts             = num_parts;
+  header.num_vertices          = mesh.GetNV();
+  header.num_elements          = mesh.GetNE();
+  header.num_boundary_elements = mesh.GetNBE();
+
+  // the header is written again at the end, once the arrays are located
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+  std::vector<double> vertices;
+  vertices.reserve(static_cast<std::size_t>(mesh.GetNV() * mesh.SpaceDimension()));
+  for (int v = 0; v < mesh.GetNV(); v++) {
+    vertices.insert(vertices.end(), mesh.GetVertex(v), mesh.GetVertex(v) + mesh.SpaceDimension());
+  }
+  header.vertices          = appendSection(file, vertices.data(), vertices.size());
+  header.elements          = appendElements(file, mesh, false);
+  header.boundary_elements = appendElements(file, mesh, true);
+
+  if (const mfem::GridFunction* nodes = mesh.GetNodes()) {
+    const std::string collection = nodes->FESpace()->FEColl()->Name();
+    header.nodes_collection      = appendSection(file, collection.data(), collection.size());
+    header.nodes_vdim            = nodes->FESpace()->GetVDim();
+    header.nodes_ordering        = nodes->FESpace()->GetOrdering();
+    header.nodes = appendSection(file, nodes->HostRead(), static_cast<std::size_t>(nodes->Size()));
+  }
+
+  // each part is written as it is extracted, so that only one of them is ever held in memory
+  if (num_parts > 0) {
+    const std::int64_t position = file.tellp();
+    const char         zeros[8] = {};
+    file.write(zeros, (8 - position % 8) % 8);
+    header.parts.offset = file.tellp();
+
+    std::vector<std::int64_t> part_offsets{0};
+    mfem::MeshPartitioner     partitioner(mesh, num_parts, partitioning.data());
+    mfem::MeshPart            mesh_part;
+    for (int part = 0; part < num_parts; part++) {
+      partitioner.ExtractPart(part, mesh_part);
+      file.precision(std::numeric_limits<double>::max_digits10);
+      mesh_part.Print(file);
+      part_offsets.push_back(static_cast<std::int64_t>(file.tellp()) - header.parts.offset);
+    }
+    header.parts.size   = part_offsets.back();
+    header.part_offsets = appendSection(file, part_offsets.data(), part_offsets.size());
+  }
+
+  file.seekp(0);
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  SLIC_ERROR_IF(!file, axom::fmt::format("Can not write mesh file: '{0}'", mesh_file));
+}
+
+bool isBinaryMeshFile(const std::string& mesh_file)
+{
+  BinaryMeshHeader header;
+  return readBinaryMeshHeader(mesh_file, header);
+}
+
+int binaryMeshParts(const std::string& mesh_file)
+{
+  BinaryMeshHeader header;
+  return readBinaryMeshHeader(mesh_file, header) ? header.num_parts : 0;
+}
+
+mfem::Mesh buildMeshFromBinaryFile(const std::string& mesh_file)
+{
+  const MappedBinaryMesh  file(mesh_file);
+  const BinaryMeshHeader& header = file.header();
+  SLIC_ERROR_IF(header.num_vertices > std::numeric_limits<int>::max() ||
+                    header.num_elements > std::numeric_limits<int>::max() ||
+                    header.num_boundary_elements > std::numeric_limits<int>::max(),
+                axom::fmt::format("Binary mesh file '{}' has too many entities for a serial mesh", mesh_file));
+
+  mfem::Mesh mesh(header.dimension, static_cast<int>(header.num_vertices), static_cast<int>(header.num_elements),
+                  static_cast<int>(header.num_boundary_elements), header.space_dimension);
+
+  const double* vertices = file.array<double>(header.vertices, header.num_vertices * header.space_dimension);
+  for (std::int64_t v = 0; v < header.num_vertices; v++) {
+    mesh.AddVertex(vertices + v * header.space_dimension);
+  }
+  addElements(file, header.elements, header.num_elements, false, mesh);
+  addElements(file, header.boundary_elements, header.num_boundary_elements, true, mesh);
+
+  // the mesh was finalized (with its orientations fixed) before it was written
+  mesh.FinalizeTopology();
+  mesh.Finalize(true, false);
+
+  if (header.nodes.size > 0) {
+    const char*       name = file.array<char>(header.nodes_collection, header.nodes_collection.size);
+    const std::string collection_name(name, name + header.nodes_collection.size);
+
+    // the nodes own their space and collection, and the mesh owns the nodes
+    auto* collection = mfem::FiniteElementCollection::New(collection_name.c_str());
+    auto* space      = new mfem::FiniteElementSpace(&mesh, collection, header.nodes_vdim, header.nodes_ordering);
+    auto* nodes      = new mfem::GridFunction(space);
+    nodes->MakeOwner(collection);
+
+    const double* values = file.array<double>(header.nodes, nodes->Size());
+    std::copy(values, values + nodes->Size(), nodes->HostWrite());
+    mesh.NewNodes(*nodes, true);
+  }
+
+  return mesh;
+}
+
+std::unique_ptr<mfem::ParMesh> buildParallelMeshFromBinaryFile(const std::string& mesh_file,
+                                                               const int refine_parallel, const MPI_Comm comm)
+{
+  auto [num_procs, rank] = getMPIInfo(comm);
+  SLIC_INFO_ROOT(axom::fmt::format("Opening partitioned binary mesh file: '{0}'", mesh_file));
+  serac::logger::flush();
+  SLIC_ERROR_IF(!axom::utilities::filesystem::pathExists(mesh_file),
+                axom::fmt::format("Given mesh file does not exist: '{0}'", mesh_file));
+
+  const MappedBinaryMesh  file(mesh_file);
+  const BinaryMeshHeader& header = file.header();
+  SLIC_ERROR_ROOT_IF(header.num_parts != num_procs,
+                     axom::fmt::format("Binary mesh file '{}' has {} parts instead of one for each of the {} ranks",
+                                       mesh_file, header.num_parts, num_procs));
+
+  // Each rank only reads its own part
+  const auto*        offsets = file.array<std::int64_t>(header.part_offsets, num_procs + 1);
+  const char*        parts   = file.array<char>(header.parts, offsets[num_procs]);
+  std::istringstream part(std::string(parts + offsets[rank], parts + offsets[rank + 1]));
+
+  auto parallel_mesh = std::make_unique<mfem::ParMesh>(comm, part);
+  for (int lev = 0; lev < refine_parallel; lev++) {
+    parallel_mesh->UniformRefinement();
+  }
+
+  parallel_mesh->EnsureNodes();
+  parallel_mesh->ExchangeFaceNbrData();
+
+  return parallel_mesh;
+}
+
+double loadImbalance(double local_cost, const MPI_Comm comm)
+{
+  int num_procs = 0;
+  MPI_Comm_size(comm, &num_procs);
+
+  double max_cost = 0.0;
+  double sum_cost = 0.0;
+  MPI_Allreduce(&local_cost, &max_cost, 1, MPI_DOUBLE, MPI_MAX, comm);
+  MPI_Allreduce(&local_cost, &sum_cost, 1, MPI_DOUBLE, MPI_SUM, comm);
+
+  if (sum_cost <= 0.0) {
+    return 1.0;
+  }
+  return max_cost * num_procs / sum_cost;
+}
+
+std::unordered_map<int, double> estimateAttributeWeights(const mfem::ParMesh& mesh, double local_cost)
+{
+  // The attributes of a ParMesh are those of all the ranks
+  const int num_attributes = mesh.attributes.Size();
+  SLIC_ERROR_ROOT_IF(num_attributes == 0, "The mesh has no element attributes to estimate the weights of.");
+
+  std::unordered_map<int, int> attribute_index;
+  for (int a = 0; a < num_attributes; a++) {
+    attribute_index[mesh.attributes[a]] = a;
+  }
+
+  std::vector<double> counts(static_cast<std::size_t>(num_attributes), 0.0);
+  for (int e = 0; e < mesh.GetNE(); e++) {
+    counts[static_cast<std::size_t>(attribute_index.at(mesh.GetAttribute(e)))] += 1.0;
+  }
+
+  // Sum the normal equations N w = b of the least squares fit of counts . w = cost over the ranks, in one reduction
+  std::vector<double> normal_equations(static_cast<std::size_t>(num_attributes * (num_attributes + 1)), 0.0);
+  for (int i = 0; i < num_attributes; i++) {
+    for (int j = 0; j < num_attributes; j++) {
+      normal_equations[static_cast<std::size_t>(i * num_attributes + j)] =
+          counts[static_cast<std::size_t>(i)] * counts[static_cast<std::size_t>(j)];
+    }
+    normal_equations[static_cast<std::size_t>(num_attributes * num_attributes + i)] =
+        counts[static_cast<std::size_t>(i)] * local_cost;
+  }
+  MPI_Allreduce(MPI_IN_PLACE, normal_equations.data(), static_cast<int>(normal_equations.size()), MPI_DOUBLE, MPI_SUM,
+                mesh.GetComm());
+
+  mfem::DenseMatrix N(num_attributes);
+  mfem::Vector      b(num_attributes);
+  double            trace = 0.0;
+  for (int i = 0; i < num_attributes; i++) {
+    for (int j = 0; j < num_attributes; j++) {
+      N(i, j) = normal_equations[static_cast<std::size_t>(i * num_attributes + j)];
+    }
+    b(i) = normal_equations[static_cast<std::size_t>(num_attributes * num_attributes + i)];
+    trace += N(i, i);
+  }
+
+  // A ridge keeps the system solvable with fewer ranks than attributes, or attributes that are never apart
+  constexpr double ridge = 1.0e-8;
+  for (int i = 0; i < num_attributes; i++) {
+    N(i, i) += ridge * trace / num_attributes;
+  }
+
+  mfem::Vector weights(num_attributes);
+  if (trace > 0.0) {
+    mfem::DenseMatrixInverse(N).Mult(b, weights);
+  } else {
+    weights = 1.0;
+  }
+
+  // The fit may give (slightly) negative costs to cheap attributes, keep every weight meaningful for a partitioner
+  const double max_weight = std::max(weights.Max(), std::numeric_limits<double>::min());
+  double       min_weight = max_weight;
+  for (int a = 0; a < num_attributes; a++) {
+    weights(a) = std::max(weights(a), 1.0e-3 * max_weight);
+    min_weight = std::min(min_weight, weights(a));
+  }
+
+  std::unordered_map<int, double> attribute_weights;
+  for (int a = 0; a < num_attributes; a++) {
+    attribute_weights[mesh.attributes[a]] = weights(a) / min_weight;
+  }
+  return attribute_weights;
+}
+
+std::vector<size_t> refineMarkedElements(mfem::ParMesh& mesh, const mfem::Array<int>& marked_elements, int nc_limit)
+{
+  SLIC_ERROR_ROOT_IF(mesh.NURBSext, "Local refinement of NURBS meshes is not supported.");
+
+  const long sequence     = mesh.GetSequence();
+  const int  num_elements = mesh.GetNE();
+  mesh.GeneralRefinement(marked_elements, 1, nc_limit);
+
+  std::vector<size_t> source_elements(static_cast<std::size_t>(mesh.GetNE()));
+  if (mesh.GetSequence() == sequence) {
+    std::iota(source_elements.begin(), source_elements.end(), 0);
+    return source_elements;
+  }
+
+  const mfem::CoarseFineTransformations& transforms = mesh.GetRefinementTransforms();
+  SLIC_ERROR_ROOT_IF(transforms.embeddings.Size() != mesh.GetNE(), "Unexpected refinement transformations.");
+  for (int e = 0; e < mesh.GetNE(); e++) {
+    const int parent = transforms.embeddings[e].parent;
+    SLIC_ERROR_IF(parent < 0 || parent >= num_elements, "Refined element without a parent element on this rank.");
+    source_elements[static_cast<std::size_t>(e)] = static_cast<std::size_t>(parent);
+  }
+
+  mesh.ExchangeFaceNbrData();
+  return source_elements;
+}
+
+std::vector<size_t> derefineElements(mfem::ParMesh& mesh, const mfem::Vector& element_error, double threshold,
+                                     int nc_limit)
+{
+  SLIC_ERROR_ROOT_IF(!mesh.Nonconforming(), "Only (locally refined) nonconforming meshes can be derefined.");
+  SLIC_ERROR_IF(element_error.Size() != mesh.GetNE(),
+                axom::fmt::format("Expected an error for each of the {} elements, got {}", mesh.GetNE(),
+                                  element_error.Size()));
+
+  const int num_elements = mesh.GetNE();
+  if (!mesh.DerefineByError(element_error, threshold, nc_limit)) {
+    std::vector<size_t> source_elements(static_cast<std::size_t>(num_elements));
+    std::iota(source_elements.begin(), source_elements.end(), 0);
+    return source_elements;
+  }
+
+  // the transformations map each element before the derefinement to the element that replaces it
+  const mfem::CoarseFineTransformations& transforms = mesh.ncmesh->GetDerefinementTransforms();
+  SLIC_ERROR_ROOT_IF(transforms.embeddings.Size() != num_elements, "Unexpected derefinement transformations.");
+
+  constexpr size_t    unset = std::numeric_limits<size_t>::max();
+  std::vector<size_t> source_elements(static_cast<std::size_t>(mesh.GetNE()), unset);
+  for (int e = 0; e < num_elements; e++) {
+    auto& source = source_elements[static_cast<std::size_t>(transforms.embeddings[e].parent)];
+    if (source == unset) {
+      source = static_cast<std::size_t>(e);
+    }
+  }
+  SLIC_ERROR_IF(std::count(source_elements.begin(), source_elements.end(), unset) > 0,
+                "Derefined element without a previous element on this rank.");
+
+  mesh.ExchangeFaceNbrData();
+  return source_elements;
+}
+
 }  // namespace mesh
 }  // namespace serac
 
+namespace {
+
+/// @brief The partitioning options of an Inlet mesh container
+serac::mesh::PartitionOptions partitionFromInlet(const axom::inlet::Container& base)
+{
+  serac::mesh::PartitionOptions partition;
+
+  const std::unordered_map<std::string, serac::mesh::Partitioner> methods = {
+      {"metis_kway", serac::mesh::Partitioner::METISKway},
+      {"metis_recursive", serac::mesh::Partitioner::METISRecursive},
+      {"metis_volume", serac::mesh::Partitioner::METISVolume},
+      {"hilbert", serac::mesh::Partitioner::HilbertCurve}};
+  partition.method = methods.at(base["partitioner"].get<std::string>());
+
+  partition.reorder     = base["reorder"];
+  partition.node_shared = base["node_shared"];
+
+  if (base.contains("element_weights")) {
+    for (const auto& [attribute, weight] : base["element_weights"].get<std::unordered_map<int, double>>()) {
+      partition.attribute_weights[attribute] = weight;
+    }
+  }
+  return partition;
+}
+
+}  // namespace
+
 serac::mesh::InputOptions FromInlet<serac::mesh::InputOptions>::operator()(const axom::inlet::Container& base)
 {
   int ser_ref = base["ser_ref_levels"];
   int par_ref = base["par_ref_levels"];
 
+  auto partition = partitionFromInlet(base);
+
+  std::string cache_directory = base.contains("cache_directory") ? base["cache_directory"].get<std::string>() : "";
+
   // This is for cuboid/rectangular meshes
   std::string mesh_type = base["type"];
   if (mesh_type == "box") {
@@ -500,17 +1532,20 @@ serac::mesh::InputOptions FromInlet<serac::mesh::InputOptions>::operator()(const
       overall_size = std::vector<double>(overall_size.size(), 1.);
     }
 
-    return {serac::mesh::BoxInputOptions{elements, overall_size}, ser_ref, par_ref};
+    bool parallel_generation = base["parallel"];
+    return {serac::mesh::BoxInputOptions{elements, overall_size, parallel_generation}, ser_ref, par_ref, partition,
+            cache_directory};
   } else if (mesh_type == "disk" || mesh_type == "ball") {
     int approx_elements = base["approx_elements"];
     int dim             = 3;
     if (mesh_type == "disk") {
       dim = 2;
     }
-    return {serac::mesh::NBallInputOptions{approx_elements, dim}, ser_ref, par_ref};
+    return {serac::mesh::NBallInputOptions{approx_elements, dim}, ser_ref, par_ref, partition, cache_directory};
   } else if (mesh_type == "file") {  // This is for file-based meshes
-    std::string mesh_path = base["mesh"];
-    return {serac::mesh::FileInputOptions{mesh_path}, ser_ref, par_ref};
+    std::string mesh_path   = base["mesh"];
+    bool        partitioned = base["parallel"];
+    return {serac::mesh::FileInputOptions{mesh_path, {}, partitioned}, ser_ref, par_ref, partition, cache_directory};
   }
 
   // If it reaches here, we haven't found a supported type
@@ -49,11 +49,27 @@ struct InputOptions {
    *
    */
   int par_ref_levels;
+
+  /**
+   * @brief How the mesh is partitioned among the ranks
+   *
+   */
+  PartitionOptions partition = {};
+
+  /**
+   * @brief The directory of the cache of refined and distributed meshes, none if empty, see buildParallelMesh
+   *
+   */
+  std::string cache_directory = "";
 };
 
 /**
  * @brief Constructs an MFEM parallel mesh from a set of input options
  *
+ * With a cache directory, the refined and distributed mesh is written there (as one file per rank) the first time
+ * it is built, and read back instead of being built again by later runs with the same mesh file contents (or box or
+ * n-ball options), refinement levels, partitioning and number of ranks.
+ *
  * @param[in] options The options used to construct the mesh
  * @param[in] comm The MPI communicator to use with the parallel mesh
  *
@@ -61,6 +77,17 @@ struct InputOptions {
  */
 std::unique_ptr<mfem::ParMesh> buildParallelMesh(const InputOptions& options, const MPI_Comm comm = MPI_COMM_WORLD);
 
+/**
+ * @brief Constructs an MFEM parallel mesh from a set of input options, without the cache of buildParallelMesh
+ *
+ * @param[in] options The options used to construct the mesh
+ * @param[in] comm The MPI communicator to use with the parallel mesh
+ *
+ * @return A unique_ptr containing the constructed mesh
+ */
+std::unique_ptr<mfem::ParMesh> buildUncachedParallelMesh(const InputOptions& options,
+                                                         const MPI_Comm      comm = MPI_COMM_WORLD);
+
 }  // namespace mesh
 }  // namespace serac
 
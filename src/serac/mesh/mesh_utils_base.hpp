@@ -14,7 +14,10 @@
 #pragma once
 
 #include <memory>
+#include <set>
+#include <unordered_map>
 #include <variant>
+#include <vector>
 #include "mfem.hpp"
 
 #include "serac/infrastructure/input.hpp"
@@ -25,7 +28,8 @@ namespace serac {
  * @brief Constructs an MFEM mesh from a file
  *
  * This opens and reads an external mesh file and constructs a serial
- * MFEM Mesh object.
+ * MFEM Mesh object. Files in serac's binary mesh format (see mesh::writeBinaryMesh)
+ * are mapped into memory instead of parsed.
  *
  * @param[in] mesh_file The mesh file to open
  * @return A serial mesh object
@@ -164,6 +168,12 @@ struct FileInputOptions {
    * @brief The absolute path for the mesh file, intended to be populated by the user directly
    */
   mutable std::string absolute_mesh_file_name{};
+
+  /**
+   * @brief Whether the mesh is partitioned, i.e. the mesh file names are prefixes of one file per rank
+   * (see writePartitionedMesh), each read by its rank only
+   */
+  bool partitioned = false;
 };
 
 /**
@@ -189,6 +199,12 @@ struct BoxInputOptions {
    *
    */
   std::vector<double> overall_size;
+
+  /**
+   * @brief Whether to generate the mesh in parallel, see buildParallelBoxMesh
+   *
+   */
+  bool parallel_generation = false;
 };
 
 /**
@@ -207,6 +223,61 @@ struct NBallInputOptions {
   int dimension;
 };
 
+/**
+ * @brief Methods of partitioning a serial mesh among the ranks
+ */
+enum class Partitioner
+{
+  METISKway,      /**< METIS k-way partitioning of the element graph (MFEM's default) */
+  METISRecursive, /**< METIS recursive bisection of the element graph */
+  METISVolume,    /**< METIS k-way partitioning minimizing the communication volume */
+  HilbertCurve    /**< Contiguous pieces of the elements ordered along a Hilbert curve, fast and allows weights */
+};
+
+/**
+ * @brief How a serial mesh is partitioned (and ordered) among the ranks
+ */
+struct PartitionOptions {
+  /**
+   * @brief The partitioning method
+   */
+  Partitioner method = Partitioner::METISKway;
+
+  /**
+   * @brief The load-balancing weight of the elements of each attribute (e.g. an expensive material), one for the
+   * attributes that are not given. Only supported by the Hilbert curve partitioner.
+   */
+  std::unordered_map<int, double> attribute_weights;
+
+  /**
+   * @brief Order the elements of the serial mesh along a Hilbert curve, and its vertices by their first element,
+   * before partitioning it. The element order (and, with it, the DOF numbering of the finite element spaces) of each
+   * rank then follows the curve, which improves the locality of element gathers and of the assembled matrices.
+   */
+  bool reorder = false;
+
+  /**
+   * @brief Refine and partition the serial mesh on the first rank of each node only, which passes the parts of the
+   * other ranks of the node to them through node-shared memory (see NodeSharedArray), instead of on every rank.
+   * The other ranks then never hold the refined serial mesh. Not supported for NURBS, nonconforming or curved meshes.
+   */
+  bool node_shared = false;
+};
+
+/**
+ * @brief Partitions the elements of a serial mesh along a Hilbert curve through their centers
+ *
+ * The curve is cut into pieces of (approximately) equal total weight, each of at least one element.
+ *
+ * @param[in] mesh The serial mesh
+ * @param[in] num_parts The number of parts
+ * @param[in] attribute_weights The weight of the elements of each attribute, one for the others
+ *
+ * @return The part of each element
+ */
+std::vector<int> hilbertCurvePartitioning(const mfem::Mesh& mesh, int num_parts,
+                                          const std::unordered_map<int, double>& attribute_weights = {});
+
 /**
  * @brief Finalizes a serial mesh into a refined parallel mesh
  *
@@ -214,14 +285,187 @@ struct NBallInputOptions {
  * @param[in] refine_serial The number of serial refinements
  * @param[in] refine_parallel The number of parallel refinements
  * @param[in] comm The MPI communicator
+ * @param[in] partition How the refined serial mesh is partitioned among the ranks
+ * @param[out] coarse_meshes If given, the parallel meshes before each parallel refinement are kept in it, from the
+ * coarsest (distributed) mesh to the one that was refined into the returned mesh, e.g. for the coarse levels of a
+ * GeometricMultigridPreconditioner (see also StateManager::setCoarseMeshes)
  *
  * @return A unique_ptr containing the constructed mesh
  *
  * @note It is sometimes required to refine serially first if your number of processors
  * is less than the original number of mesh elements
  */
-std::unique_ptr<mfem::ParMesh> refineAndDistribute(mfem::Mesh&& serial_mesh, const int refine_serial = 0,
-                                                   const int refine_parallel = 0, const MPI_Comm comm = MPI_COMM_WORLD);
+std::unique_ptr<mfem::ParMesh> refineAndDistribute(
+    mfem::Mesh&& serial_mesh, const int refine_serial = 0, const int refine_parallel = 0,
+    const MPI_Comm comm = MPI_COMM_WORLD, const PartitionOptions& partition = {},
+    std::vector<std::unique_ptr<mfem::ParMesh>>* coarse_meshes = nullptr);
+
+/**
+ * @brief Constructs a refined parallel mesh of a rectangle or cuboid without building the refined serial mesh
+ *
+ * The result is the box of refineAndDistribute(mesh of \p options, \p refine_serial, \p refine_parallel). It is
+ * built by distributing the coarsest box that refines into it and still has an element per rank, and refining that
+ * in parallel, so the serial mesh on each rank has about as many elements as there are ranks.
+ *
+ * @param[in] options The elements and size of the box
+ * @param[in] refine_serial The number of serial refinements
+ * @param[in] refine_parallel The number of parallel refinements
+ * @param[in] comm The MPI communicator
+ * @param[in] partition How the coarse box is partitioned among the ranks
+ *
+ * @return A unique_ptr containing the constructed mesh
+ *
+ * @note The elements are ordered (and partitioned) differently from the mesh of refineAndDistribute
+ */
+std::unique_ptr<mfem::ParMesh> buildParallelBoxMesh(const BoxInputOptions& options, const int refine_serial = 0,
+                                                    const int refine_parallel = 0, const MPI_Comm comm = MPI_COMM_WORLD,
+                                                    const PartitionOptions& partition = {});
+
+/**
+ * @brief Constructs the submesh of the elements of some attributes of a parallel mesh, for physics (or Functionals)
+ * that are confined to a region of the mesh
+ *
+ * The elements of the submesh keep their attributes, and it is distributed like the elements of its parent are, so
+ * the fields of physics on the two meshes can be transferred between them without communication (see
+ * SubmeshTransfer). The nodes of a parent with nodes are transferred to the submesh.
+ *
+ * @param[in] parent The parallel mesh
+ * @param[in] attributes The attributes of the elements of the submesh
+ *
+ * @return A unique_ptr containing the constructed submesh, which refers to its parent, so the parent must outlive it
+ */
+std::unique_ptr<mfem::ParSubMesh> buildSubmesh(const mfem::ParMesh& parent, const std::set<int>& attributes);
+
+/**
+ * @brief Reads a parallel mesh from one file per rank, so that no rank reads the whole mesh
+ *
+ * @param[in] mesh_prefix The prefix of the files, the file of each rank is `<mesh_prefix>.<rank, 6 digits>`
+ * @param[in] refine_parallel The number of parallel refinements
+ * @param[in] comm The MPI communicator, whose size must be the number of files
+ *
+ * @return A unique_ptr containing the constructed mesh
+ */
+std::unique_ptr<mfem::ParMesh> buildPartitionedMeshFromFiles(const std::string& mesh_prefix,
+                                                             const int          refine_parallel = 0,
+                                                             const MPI_Comm     comm            = MPI_COMM_WORLD);
+
+/**
+ * @brief Writes a parallel mesh as one file per rank, which buildPartitionedMeshFromFiles reads
+ *
+ * @param[in] mesh The mesh to write
+ * @param[in] mesh_prefix The prefix of the files, the file of each rank is `<mesh_prefix>.<rank, 6 digits>`
+ */
+void writePartitionedMesh(const mfem::ParMesh& mesh, const std::string& mesh_prefix);
+
+/**
+ * @brief Writes a serial mesh in serac's binary mesh format, which buildMeshFromFile maps into memory instead of
+ * parsing it
+ *
+ * The file holds the vertices, the elements and boundary elements (their geometries, attributes and vertices) and
+ * the nodes of curved meshes, as arrays in the native byte order. If \p num_parts is positive, the mesh is also
+ * partitioned with \p partition, and the file holds the (distributed) mesh of each part, which the rank of that part
+ * then reads on its own (see buildParallelMeshFromBinaryFile).
+ *
+ * @param[in] mesh The serial mesh, which is reordered if \p partition reorders the elements
+ * @param[in] mesh_file The name of the file
+ * @param[in] num_parts The number of parts of the precomputed partition, zero for none
+ * @param[in] partition How the mesh is partitioned
+ *
+ * @note NURBS and nonconforming meshes are not supported, nor are curved meshes with a precomputed partition
+ */
+void writeBinaryMesh(mfem::Mesh& mesh, const std::string& mesh_file, const int num_parts = 0,
+                     const PartitionOptions& partition = {});
+
+/**
+ * @brief Whether a file is in serac's binary mesh format, see writeBinaryMesh
+ */
+bool isBinaryMeshFile(const std::string& mesh_file);
+
+/**
+ * @brief The number of parts of the precomputed partition of a binary mesh file, zero if it has none (or the file is
+ * not a binary mesh file)
+ */
+int binaryMeshParts(const std::string& mesh_file);
+
+/**
+ * @brief Reads a serial mesh from a binary mesh file, whose arrays are mapped into memory rather than parsed
+ *
+ * @param[in] mesh_file The binary mesh file, see writeBinaryMesh
+ *
+ * @return A serial mesh object
+ */
+mfem::Mesh buildMeshFromBinaryFile(const std::string& mesh_file);
+
+/**
+ * @brief Reads the parts of the precomputed partition of a binary mesh file, each rank mapping only its own part
+ * into memory, so that no rank reads the whole mesh
+ *
+ * @param[in] mesh_file The binary mesh file, see writeBinaryMesh
+ * @param[in] refine_parallel The number of parallel refinements
+ * @param[in] comm The MPI communicator, whose size must be the number of parts
+ *
+ * @return A unique_ptr containing the constructed mesh
+ */
+std::unique_ptr<mfem::ParMesh> buildParallelMeshFromBinaryFile(const std::string& mesh_file,
+                                                               const int          refine_parallel = 0,
+                                                               const MPI_Comm     comm            = MPI_COMM_WORLD);
+
+/**
+ * @brief Computes the load imbalance of a parallel computation, the largest cost of a rank over the mean cost
+ *
+ * @param[in] local_cost The cost (e.g. the wall time) of the computation on this rank
+ * @param[in] comm The MPI communicator
+ *
+ * @return The imbalance, one for a perfectly balanced computation
+ */
+double loadImbalance(double local_cost, const MPI_Comm comm = MPI_COMM_WORLD);
+
+/**
+ * @brief Estimates the cost of the elements of each attribute from the measured cost of each rank
+ *
+ * The cost of a rank is modelled as the sum over attributes of its number of elements of the attribute times the
+ * cost of one such element, which is fit to the costs of all ranks in the least squares sense.
+ *
+ * @param[in] mesh The parallel mesh
+ * @param[in] local_cost The cost (e.g. the wall time) of the computation on this rank
+ *
+ * @return The element weights of each attribute relative to the cheapest one, as taken by PartitionOptions
+ *
+ * @note The costs of attributes which appear on the ranks in the same proportions can not be told apart, these
+ * are regularized towards each other
+ */
+std::unordered_map<int, double> estimateAttributeWeights(const mfem::ParMesh& mesh, double local_cost);
+
+/**
+ * @brief Locally refines the marked elements of a parallel mesh, e.g. those flagged by an error estimator
+ *
+ * Tensor-product meshes are refined nonconformingly, with hanging nodes. After this, the spaces of the states on
+ * the mesh are updated with FiniteElementVector::updateSpace(), the quadrature data with QuadratureData::remap()
+ * and the Functionals with Functional::Update().
+ *
+ * @param[inout] mesh The mesh to refine
+ * @param[in] marked_elements The (local) indices of the elements to refine
+ * @param[in] nc_limit The largest difference of refinement levels between neighboring elements, 0 for no limit
+ *
+ * @return The element of the mesh before the refinement that each element of the refined mesh is (a part of)
+ */
+std::vector<size_t> refineMarkedElements(mfem::ParMesh& mesh, const mfem::Array<int>& marked_elements,
+                                         int nc_limit = 1);
+
+/**
+ * @brief Undoes the refinement of the groups of elements of a locally refined mesh whose error is small enough
+ *
+ * @param[inout] mesh The (nonconforming) mesh to derefine
+ * @param[in] element_error The error of each (local) element
+ * @param[in] threshold The groups of elements refined from the same element, whose largest error is below this,
+ * are derefined
+ * @param[in] nc_limit The largest difference of refinement levels between neighboring elements, 0 for no limit
+ *
+ * @return The element of the mesh before the derefinement that each element of the derefined mesh takes its
+ * quadrature data from, the first of the elements it replaces
+ */
+std::vector<size_t> derefineElements(mfem::ParMesh& mesh, const mfem::Vector& element_error, double threshold,
+                                     int nc_limit = 1);
 
 }  // namespace mesh
 
@@ -114,6 +114,63 @@ TEST_F(MeshTest, LuaInputMainMeshRect)
   MPI_Barrier(MPI_COMM_WORLD);
 }
 
+TEST_F(MeshTest, LuaInputMainMeshParallelBox)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+  reader_->parseString(std::string("main_mesh_parallel = { type = \"box\", parallel = true,") +
+                       "elements = {x = 4, y = 2}, size = {x = 2, y = 1}, ser_ref_levels = 1, par_ref_levels = 1, }");
+  auto& mesh_table = inlet_->addStruct("main_mesh_parallel");
+  mesh::InputOptions::defineInputFileSchema(mesh_table);
+
+  // The box refined by generating a coarser one in parallel has the elements and size of the serially refined one
+  auto       mesh_options = mesh_table.get<serac::mesh::InputOptions>();
+  const auto box_options  = std::get_if<serac::mesh::BoxInputOptions>(&mesh_options.extra_options);
+  ASSERT_NE(box_options, nullptr);
+  EXPECT_TRUE(box_options->parallel_generation);
+  auto mesh = serac::mesh::buildParallelMesh(mesh_options);
+  EXPECT_EQ(mesh->GetGlobalNE(), 4 * 2 * 16);
+
+  mfem::Vector min, max;
+  mesh->GetBoundingBox(min, max);
+  EXPECT_NEAR(max[0] - min[0], 2.0, 1.0e-12);
+  EXPECT_NEAR(max[1] - min[1], 1.0, 1.0e-12);
+
+  // and so does its partitioned file
+  mesh::writePartitionedMesh(*mesh, "parallel_box.mesh");
+  auto read_mesh = mesh::buildPartitionedMeshFromFiles("parallel_box.mesh");
+  EXPECT_EQ(read_mesh->GetGlobalNE(), mesh->GetGlobalNE());
+  EXPECT_EQ(read_mesh->bdr_attributes.Max(), mesh->bdr_attributes.Max());
+
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
+TEST_F(MeshTest, LuaInputMainMeshCached)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+  std::string cache_directory = "mesh_cache_test";
+  axom::utilities::filesystem::makeDirsForPath(cache_directory);
+  reader_->parseString(std::string("main_mesh_cached = { type = \"box\", cache_directory = \"") + cache_directory +
+                       "\", elements = {x = 3, y = 2}, ser_ref_levels = 1, par_ref_levels = 1, }");
+  auto& mesh_table = inlet_->addStruct("main_mesh_cached");
+  mesh::InputOptions::defineInputFileSchema(mesh_table);
+
+  auto mesh_options = mesh_table.get<serac::mesh::InputOptions>();
+  EXPECT_EQ(mesh_options.cache_directory, cache_directory);
+
+  // the first build writes the cache, which the second one reads
+  auto built_mesh  = serac::mesh::buildParallelMesh(mesh_options);
+  auto cached_mesh = serac::mesh::buildParallelMesh(mesh_options);
+  EXPECT_EQ(cached_mesh->GetGlobalNE(), 3 * 2 * 16);
+  EXPECT_EQ(cached_mesh->GetNE(), built_mesh->GetNE());
+  EXPECT_EQ(cached_mesh->GetNV(), built_mesh->GetNV());
+
+  // other refinement levels are cached separately
+  mesh_options.par_ref_levels = 0;
+  EXPECT_EQ(serac::mesh::buildParallelMesh(mesh_options)->GetGlobalNE(), 3 * 2 * 4);
+
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
 TEST_F(MeshTest, LuaInputMainMeshFail)
 {
   MPI_Barrier(MPI_COMM_WORLD);
@@ -143,6 +200,65 @@ TEST(MeshGen, SuccessfulCreation)
   ASSERT_EQ(buildHollowCylinderMesh(2, 1, 2.0, 3.0, 5.0, 2. * M_PI, 7).GetNE(), 112);
 }
 
+TEST(MeshGen, HilbertCurvePartitioning)
+{
+  auto mesh = buildRectangleMesh(8, 8, 1., 1.);
+
+  // equal weights give equal parts
+  auto partitioning = mesh::hilbertCurvePartitioning(mesh, 4);
+  ASSERT_EQ(partitioning.size(), 64);
+  std::vector<int> counts(4, 0);
+  for (int part : partitioning) {
+    counts[static_cast<std::size_t>(part)]++;
+  }
+  EXPECT_EQ(counts, std::vector<int>(4, 16));
+
+  // the right half of the elements are three times as expensive
+  for (int e = 0; e < mesh.GetNE(); e++) {
+    mfem::Vector center;
+    mesh.GetElementCenter(e, center);
+    mesh.SetAttribute(e, center[0] > 0.5 ? 2 : 1);
+  }
+  partitioning = mesh::hilbertCurvePartitioning(mesh, 4, {{2, 3.0}});
+  std::vector<double> weights(4, 0.0);
+  for (int e = 0; e < mesh.GetNE(); e++) {
+    auto part = static_cast<std::size_t>(partitioning[static_cast<std::size_t>(e)]);
+    weights[part] += (mesh.GetAttribute(e) == 2) ? 3.0 : 1.0;
+  }
+  for (double weight : weights) {
+    EXPECT_NEAR(weight, 128.0 / 4, 3.0);
+  }
+}
+
+TEST(MeshGen, ReorderedDistribution)
+{
+  mesh::PartitionOptions partition;
+  partition.reorder = true;
+  auto mesh         = mesh::refineAndDistribute(buildCuboidMesh(4, 4, 4, 1., 2., 3.), 1, 0, MPI_COMM_WORLD, partition);
+  EXPECT_EQ(mesh->GetGlobalNE(), 512);
+
+  // consecutive elements are neighbors along the curve
+  mfem::Vector previous, center;
+  mesh->GetElementCenter(0, previous);
+  for (int e = 1; e < mesh->GetNE(); e++) {
+    mesh->GetElementCenter(e, center);
+    EXPECT_LT(center.DistanceTo(previous), 1.5 * 3.0 / 8.0 + 1.0e-12);
+    previous = center;
+  }
+}
+
+TEST(MeshGen, CoarseMeshes)
+{
+  std::vector<std::unique_ptr<mfem::ParMesh>> coarse_meshes;
+  auto mesh = mesh::refineAndDistribute(buildRectangleMesh(4, 4, 1., 1.), 0, 2, MPI_COMM_WORLD, {}, &coarse_meshes);
+  EXPECT_EQ(mesh->GetGlobalNE(), 256);
+
+  // the distributed mesh, and its first refinement
+  ASSERT_EQ(coarse_meshes.size(), 2);
+  EXPECT_EQ(coarse_meshes[0]->GetGlobalNE(), 16);
+  EXPECT_EQ(coarse_meshes[1]->GetGlobalNE(), 64);
+}
+
 }  // namespace serac
 
 int main(int argc, char* argv[])
@@ -23,6 +23,99 @@ TEST(Mesh, LoadExodus)
   MPI_Barrier(MPI_COMM_WORLD);
 }
 
+TEST(Mesh, LoadImbalance)
+{
+  int rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  // the costs 1 and 2 have a mean of 1.5
+  EXPECT_NEAR(mesh::loadImbalance(rank + 1.0, MPI_COMM_WORLD), 2.0 / 1.5, 1.0e-12);
+
+  // the elements of each rank are of their own material, the second three times as expensive
+  auto pmesh = mesh::refineAndDistribute(buildRectangleMesh(4, 4), 0, 0);
+  for (int e = 0; e < pmesh->GetNE(); e++) {
+    pmesh->SetAttribute(e, rank + 1);
+  }
+  pmesh->SetAttributes();
+
+  auto weights = mesh::estimateAttributeWeights(*pmesh, pmesh->GetNE() * (rank == 0 ? 1.0 : 3.0));
+  ASSERT_EQ(weights.size(), 2);
+  EXPECT_NEAR(weights.at(1), 1.0, 1.0e-6);
+  EXPECT_NEAR(weights.at(2), 3.0, 1.0e-6);
+}
+
+TEST(Mesh, NodeSharedDistribution)
+{
+  // the same parts as when every rank refines and partitions the serial mesh
+  auto replicated = mesh::refineAndDistribute(buildCuboidMesh(2, 2, 2, 1., 1., 1.), 1, 1);
+
+  mesh::PartitionOptions partition;
+  partition.node_shared = true;
+  auto shared = mesh::refineAndDistribute(buildCuboidMesh(2, 2, 2, 1., 1., 1.), 1, 1, MPI_COMM_WORLD, partition);
+
+  EXPECT_EQ(shared->GetGlobalNE(), 512);
+  ASSERT_EQ(shared->GetNE(), replicated->GetNE());
+  EXPECT_EQ(shared->GetNSharedFaces(), replicated->GetNSharedFaces());
+
+  double volume = 0.0;
+  for (int e = 0; e < shared->GetNE(); e++) {
+    volume += shared->GetElementVolume(e);
+  }
+  MPI_Allreduce(MPI_IN_PLACE, &volume, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+  EXPECT_NEAR(volume, 1.0, 1.0e-12);
+}
+
+TEST(Mesh, BinaryMeshFile)
+{
+  int rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  // a curved mesh, and a straight one with a partition for the two ranks
+  if (rank == 0) {
+    auto curved = buildRectangleMesh(3, 2);
+    curved.SetCurvature(2);
+    mesh::writeBinaryMesh(curved, "curved_rectangle.smesh");
+
+    auto cuboid = buildCuboidMesh(2, 2, 2, 1., 1., 1.);
+    cuboid.UniformRefinement();
+    mesh::writeBinaryMesh(cuboid, "partitioned_cuboid.smesh", 2);
+  }
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  EXPECT_FALSE(mesh::isBinaryMeshFile(std::string(SERAC_REPO_DIR) + "/data/meshes/bortel_echem.e"));
+  ASSERT_TRUE(mesh::isBinaryMeshFile("curved_rectangle.smesh"));
+  EXPECT_EQ(mesh::binaryMeshParts("curved_rectangle.smesh"), 0);
+  EXPECT_EQ(mesh::binaryMeshParts("partitioned_cuboid.smesh"), 2);
+
+  // the serial mesh read from the file is the one that was written
+  auto expected = buildRectangleMesh(3, 2);
+  expected.SetCurvature(2);
+  auto curved = buildMeshFromFile("curved_rectangle.smesh");
+  EXPECT_EQ(curved.GetNE(), expected.GetNE());
+  EXPECT_EQ(curved.GetNV(), expected.GetNV());
+  EXPECT_EQ(curved.GetNBE(), expected.GetNBE());
+  EXPECT_EQ(curved.bdr_attributes.Max(), expected.bdr_attributes.Max());
+  ASSERT_NE(curved.GetNodes(), nullptr);
+  ASSERT_EQ(curved.GetNodes()->Size(), expected.GetNodes()->Size());
+  mfem::Vector difference(*curved.GetNodes());
+  difference -= *expected.GetNodes();
+  EXPECT_NEAR(difference.Normlinf(), 0.0, 1.0e-15);
+
+  // and each rank reads its own part of the partitioned one, which are the parts of refineAndDistribute
+  auto partitioned = mesh::buildParallelMeshFromBinaryFile("partitioned_cuboid.smesh", 1);
+  auto replicated  = mesh::refineAndDistribute(buildCuboidMesh(2, 2, 2, 1., 1., 1.), 1, 1);
+  EXPECT_EQ(partitioned->GetGlobalNE(), 512);
+  ASSERT_EQ(partitioned->GetNE(), replicated->GetNE());
+  EXPECT_EQ(partitioned->GetNSharedFaces(), replicated->GetNSharedFaces());
+
+  double volume = 0.0;
+  for (int e = 0; e < partitioned->GetNE(); e++) {
+    volume += partitioned->GetElementVolume(e);
+  }
+  MPI_Allreduce(MPI_IN_PLACE, &volume, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+  EXPECT_NEAR(volume, 1.0, 1.0e-12);
+}
+
 }  // namespace serac
 
 //------------------------------------------------------------------------------
@@ -0,0 +1,111 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/numerics/checkpoint_schedule.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#include "serac/infrastructure/logger.hpp"
+
+namespace serac {
+
+namespace {
+
+using Action = CheckpointOperation::Action;
+
+/// Builds a schedule, keeping track of the step of the current state so that redundant restores are skipped
+struct ScheduleBuilder {
+  /// Move the current state to @a step, from the checkpoint in @a slot
+  void restore(int slot, int step)
+  {
+    if (position != step) {
+      operations.push_back({Action::Restore, step, slot});
+      position = step;
+    }
+  }
+
+  /// Advance the current state to @a step
+  void advance(int step)
+  {
+    for (; position < step; position++) {
+      operations.push_back({Action::Advance, position});
+    }
+  }
+
+  /**
+   * @brief Reverse the steps [start, end), where the state at @a start is in the checkpoint @a slot and the slots
+   * after it are free, up to a total of @a checkpoints
+   */
+  void reverse(int start, int end, int slot, int checkpoints)
+  {
+    int num_steps = end - start;
+
+    // without a free slot, every state is recomputed from the one at the start
+    if (num_steps == 1 || checkpoints == 1) {
+      for (int step = end - 1; step >= start; step--) {
+        restore(slot, start);
+        advance(step + 1);
+        operations.push_back({Action::Adjoint, step});
+      }
+      return;
+    }
+
+    // the fewest repetitions r that reverse the steps with these checkpoints ...
+    int repetitions = 1;
+    while (binomialCheckpointCapacity(checkpoints, repetitions) < num_steps) {
+      repetitions++;
+    }
+
+    // ... and the binomial partition: the steps after the next checkpoint are reversed with one checkpoint fewer
+    // (and r repetitions), and those before it with the same checkpoints (and r - 1 repetitions)
+    long after = std::min(binomialCheckpointCapacity(checkpoints - 1, repetitions), static_cast<long>(num_steps - 1));
+    int  split = end - static_cast<int>(after);
+
+    restore(slot, start);
+    advance(split);
+    operations.push_back({Action::Store, split, slot + 1});
+
+    reverse(split, end, slot + 1, checkpoints - 1);
+    reverse(start, split, slot, checkpoints);
+  }
+
+  /// The step of the current state
+  int position = 0;
+
+  /// The operations of the schedule
+  std::vector<CheckpointOperation> operations;
+};
+
+}  // namespace
+
+long binomialCheckpointCapacity(int num_checkpoints, int repetitions)
+{
+  // (c + r choose c), built up one factor at a time (each partial product is itself a binomial coefficient)
+  constexpr long max_capacity = std::numeric_limits<int>::max();
+  long           capacity     = 1;
+  for (int i = 1; i <= num_checkpoints; i++) {
+    capacity = capacity * (repetitions + i) / i;
+    if (capacity > max_capacity) {
+      return max_capacity;
+    }
+  }
+  return capacity;
+}
+
+std::vector<CheckpointOperation> binomialCheckpointSchedule(int num_steps, int num_checkpoints)
+{
+  SLIC_ERROR_ROOT_IF(num_checkpoints < 1, "A checkpointing schedule needs at least one checkpoint");
+
+  ScheduleBuilder builder;
+  if (num_steps > 0) {
+    builder.operations.push_back({Action::Store, 0, 0});
+    builder.reverse(0, num_steps, 0, num_checkpoints);
+  }
+  return builder.operations;
+}
+
+}  // namespace serac
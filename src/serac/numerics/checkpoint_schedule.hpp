@@ -0,0 +1,73 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file checkpoint_schedule.hpp
+ *
+ * @brief Binomial (revolve) checkpointing schedules for reversing a time integration with bounded memory
+ */
+
+#pragma once
+
+#include <vector>
+
+namespace serac {
+
+/**
+ * @brief One operation of a checkpointing schedule
+ */
+struct CheckpointOperation {
+  /// @brief The kinds of operations
+  enum class Action
+  {
+    Store,    ///< copy the current state (at @a step) into checkpoint @a slot
+    Restore,  ///< copy checkpoint @a slot (holding the state at @a step) into the current state
+    Advance,  ///< advance the current state from @a step to @a step + 1
+    Adjoint   ///< the current state is at the end of @a step, compute the adjoint of that step
+  };
+
+  /// @brief What to do
+  Action action;
+
+  /// @brief The time step the operation applies to
+  int step;
+
+  /// @brief The checkpoint slot, for Store and Restore
+  int slot = -1;
+
+  /// @brief Whether two operations are the same
+  bool operator==(const CheckpointOperation& other) const
+  {
+    return action == other.action && step == other.step && slot == other.slot;
+  }
+};
+
+/**
+ * @brief The number of time steps a binomial schedule can reverse with @p num_checkpoints checkpoints, when each
+ * step is advanced at most @p repetitions times (beyond the forward run), i.e. the binomial coefficient
+ * (num_checkpoints + repetitions choose num_checkpoints) of Griewank's revolve algorithm
+ */
+long binomialCheckpointCapacity(int num_checkpoints, int repetitions);
+
+/**
+ * @brief Compute a binomial (revolve) checkpointing schedule
+ *
+ * The schedule starts from the initial state (step 0), runs the forward integration of @p num_steps time steps
+ * storing a few checkpoints along the way, and then computes the adjoint of every step in reverse, restoring the
+ * checkpoints and recomputing the states between them as needed. The checkpoints are placed by the recursive
+ * binomial partition of Griewank and Walther, which minimizes the number of recomputed steps for the given number
+ * of checkpoints: if the steps fit in binomialCheckpointCapacity(num_checkpoints, r), no step is advanced more
+ * than r + 1 times.
+ *
+ * Slot 0 holds the initial state for the whole schedule, and the slots are reused as the adjoint sweep passes them.
+ *
+ * @param[in] num_steps The number of time steps
+ * @param[in] num_checkpoints The number of checkpoint slots, at least 1
+ * @return The operations, in order
+ */
+std::vector<CheckpointOperation> binomialCheckpointSchedule(int num_steps, int num_checkpoints);
+
+}  // namespace serac
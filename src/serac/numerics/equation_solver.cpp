@@ -6,107 +6,1750 @@
 
 #include "serac/numerics/equation_solver.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+
 #include "serac/infrastructure/logger.hpp"
+#include "serac/infrastructure/profiling.hpp"
 #include "serac/infrastructure/terminator.hpp"
 
-namespace serac {
+namespace serac {
+
+EquationSolver::EquationSolver(NonlinearSolverOptions nonlinear_opts, LinearSolverOptions lin_opts, MPI_Comm comm)
+{
+  auto [lin_solver, preconditioner] = buildLinearSolverAndPreconditioner(lin_opts, comm);
+
+  lin_solver_     = std::move(lin_solver);
+  preconditioner_ = std::move(preconditioner);
+  nonlin_solver_  = buildNonlinearSolver(nonlinear_opts, comm);
+  matrix_free_    = lin_opts.matrix_free;
+
+  SLIC_ERROR_ROOT_IF(matrix_free_ && lin_opts.linear_solver == LinearSolver::SuperLU,
+                     "Matrix-free linear solves require an iterative linear solver");
+  SLIC_ERROR_ROOT_IF(matrix_free_ && lin_opts.preconditioner != Preconditioner::Jacobi &&
+                         lin_opts.preconditioner != Preconditioner::Chebyshev &&
+                         lin_opts.preconditioner != Preconditioner::LOR &&
+                         lin_opts.preconditioner != Preconditioner::SeparateComponentAMG &&
+                         lin_opts.preconditioner != Preconditioner::None,
+                     "Matrix-free linear solves require a Jacobi, Chebyshev, LOR, SeparateComponentAMG, or no "
+                     "preconditioner");
+  SLIC_ERROR_ROOT_IF(matrix_free_ && (nonlinear_opts.jacobian_reuse != JacobianReuse::Never ||
+                                     nonlinear_opts.nonlin_solver == NonlinearSolver::Anderson ||
+                                     nonlinear_opts.nonlin_solver == NonlinearSolver::JFNK),
+                     "Jacobian reuse requires an assembled Jacobian, it is not supported with matrix-free solves");
+  SLIC_ERROR_ROOT_IF(
+      nonlinear_opts.forcing_term != ForcingTerm::Fixed && lin_opts.linear_solver == LinearSolver::SuperLU,
+      "Eisenstat-Walker forcing terms require an iterative linear solver");
+
+  // the separate-displacement-component preconditioner is set up from the matrix it is given, not the operator
+  transpose_invariant_preconditioner_ =
+      lin_opts.preconditioner == Preconditioner::HypreJacobi || lin_opts.preconditioner == Preconditioner::Jacobi ||
+      lin_opts.preconditioner == Preconditioner::Chebyshev || lin_opts.preconditioner == Preconditioner::LOR ||
+      lin_opts.preconditioner == Preconditioner::SeparateComponentAMG ||
+      lin_opts.preconditioner == Preconditioner::None;
+
+  adjoint_preconditioning_ = lin_opts.adjoint_preconditioning;
+  refinement_relative_tol_ = lin_opts.relative_tol;
+  refinement_absolute_tol_ = lin_opts.absolute_tol;
+
+  // only the preconditioners that are set up from the matrix alone can have a copy for J^T, the others are
+  // configured by the physics modules
+  const bool matrix_only_preconditioner =
+      lin_opts.preconditioner == Preconditioner::HypreAMG || lin_opts.preconditioner == Preconditioner::HypreILU ||
+      lin_opts.preconditioner == Preconditioner::HypreGaussSeidel ||
+      lin_opts.preconditioner == Preconditioner::HypreL1Jacobi || lin_opts.preconditioner == Preconditioner::AMGX;
+  if (adjoint_preconditioning_ == AdjointPreconditioning::CachedTranspose && matrix_only_preconditioner &&
+      !transpose_invariant_preconditioner_ && lin_opts.linear_solver != LinearSolver::SuperLU) {
+    transpose_preconditioner_ = buildPreconditioner(lin_opts.preconditioner, lin_opts.preconditioner_print_level, comm,
+                                                    lin_opts.preconditioner_rebuild_period, lin_opts.amgx_options,
+                                                    lin_opts.single_precision_preconditioner);
+  }
+
+  // the forcing term overwrites the linear solver tolerance, so it is restored after each nonlinear solve
+  if (nonlinear_opts.forcing_term != ForcingTerm::Fixed) {
+    linear_relative_tol_ = lin_opts.relative_tol;
+  }
+
+  initializeTelemetry();
+}
+
+EquationSolver::EquationSolver(std::unique_ptr<mfem::NewtonSolver> nonlinear_solver,
+                               std::unique_ptr<mfem::Solver>       linear_solver,
+                               std::unique_ptr<mfem::Solver>       preconditioner)
+{
+  SLIC_ERROR_ROOT_IF(!nonlinear_solver, "Nonlinear solvers must be given to construct an EquationSolver");
+  SLIC_ERROR_ROOT_IF(!linear_solver, "Linear solvers must be given to construct an EquationSolver");
+
+  nonlin_solver_  = std::move(nonlinear_solver);
+  lin_solver_     = std::move(linear_solver);
+  preconditioner_ = std::move(preconditioner);
+
+  initializeTelemetry();
+}
+
+SolveTelemetry& SolveTelemetry::operator+=(const SolveTelemetry& other)
+{
+  solves += other.solves;
+  nonlinear_iterations += other.nonlinear_iterations;
+  linear_iterations.insert(linear_iterations.end(), other.linear_iterations.begin(), other.linear_iterations.end());
+  initial_residual_norm = std::hypot(initial_residual_norm, other.initial_residual_norm);
+  final_residual_norm   = std::hypot(final_residual_norm, other.final_residual_norm);
+  residual_time += other.residual_time;
+  assembly_time += other.assembly_time;
+  preconditioner_setup_time += other.preconditioner_setup_time;
+  linear_solve_time += other.linear_solve_time;
+  return *this;
+}
+
+namespace {
+
+/// @brief A nonlinear operator that adds the time of its evaluations (and of its Jacobians) to a solve's telemetry
+class TimedOperator : public mfem::Operator {
+public:
+  /// @brief Time the evaluations of @p op in @p telemetry
+  TimedOperator(const mfem::Operator& op, SolveTelemetry& telemetry)
+      : mfem::Operator(op.Height(), op.Width()), op_(op), telemetry_(telemetry)
+  {
+  }
+
+  /// @brief Evaluate the residual
+  void Mult(const mfem::Vector& x, mfem::Vector& y) const override
+  {
+    double start = MPI_Wtime();
+    op_.Mult(x, y);
+    telemetry_.residual_time += MPI_Wtime() - start;
+  }
+
+  /// @brief Evaluate the Jacobian
+  mfem::Operator& GetGradient(const mfem::Vector& x) const override
+  {
+    double          start    = MPI_Wtime();
+    mfem::Operator& jacobian = op_.GetGradient(x);
+    telemetry_.assembly_time += MPI_Wtime() - start;
+    return jacobian;
+  }
+
+private:
+  /// @brief The timed operator
+  const mfem::Operator& op_;
+
+  /// @brief The telemetry the times are added to
+  SolveTelemetry& telemetry_;
+};
+
+/// @brief A preconditioner that adds the time of its setups to a solve's telemetry
+class TimedPreconditioner : public mfem::Solver {
+public:
+  /// @brief Time the setups of @p preconditioner in @p telemetry
+  TimedPreconditioner(mfem::Solver& preconditioner, SolveTelemetry& telemetry)
+      : mfem::Solver(preconditioner.Height(), preconditioner.Width()),
+        preconditioner_(preconditioner),
+        telemetry_(telemetry)
+  {
+  }
+
+  /// @brief Apply the preconditioner
+  void Mult(const mfem::Vector& x, mfem::Vector& y) const override { preconditioner_.Mult(x, y); }
+
+  /// @brief Set up the preconditioner
+  void SetOperator(const mfem::Operator& op) override
+  {
+    double start = MPI_Wtime();
+    preconditioner_.SetOperator(op);
+    telemetry_.preconditioner_setup_time += MPI_Wtime() - start;
+    height = preconditioner_.Height();
+    width  = preconditioner_.Width();
+  }
+
+private:
+  /// @brief The timed preconditioner
+  mfem::Solver& preconditioner_;
+
+  /// @brief The telemetry the times are added to
+  SolveTelemetry& telemetry_;
+};
+
+/// @brief A monitor of the nonlinear solver that records its residual norms and the iterations of its linear solves
+class TelemetryMonitor : public mfem::IterativeSolverMonitor {
+public:
+  /// @brief Record the iterations of a nonlinear solver, and of its @p linear_solver, in @p telemetry
+  TelemetryMonitor(const mfem::Solver& linear_solver, SolveTelemetry& telemetry)
+      : linear_solver_(linear_solver), telemetry_(telemetry)
+  {
+  }
+
+  /// @brief A solve is about to start, whose iterations are counted from 0
+  void beginSolve() { first_linear_iteration_ = telemetry_.linear_iterations.size(); }
+
+  /// @brief The nonlinear iteration @p it has the residual norm @p norm, after the linear solve of the previous one
+  void MonitorResidual(int it, double norm, const mfem::Vector&, bool) override
+  {
+    if (it == 0 && telemetry_.solves == 0) {
+      telemetry_.initial_residual_norm = norm;
+    }
+
+    auto* iterative_solver = dynamic_cast<const mfem::IterativeSolver*>(&linear_solver_);
+    auto  recorded         = telemetry_.linear_iterations.size() - first_linear_iteration_;
+    if (iterative_solver && it > 0 && recorded < static_cast<std::size_t>(it)) {
+      telemetry_.linear_iterations.push_back(iterative_solver->GetNumIterations());
+    }
+
+    telemetry_.final_residual_norm = norm;
+  }
+
+private:
+  /// @brief The linear solver of the Newton updates
+  const mfem::Solver& linear_solver_;
+
+  /// @brief The telemetry the iterations are recorded in
+  SolveTelemetry& telemetry_;
+
+  /// @brief The number of linear solves recorded before this solve
+  std::size_t first_linear_iteration_ = 0;
+};
+
+}  // namespace
+
+void EquationSolver::initializeTelemetry()
+{
+  auto* iterative_solver = dynamic_cast<mfem::IterativeSolver*>(lin_solver_.get());
+  if (iterative_solver && preconditioner_) {
+    timed_preconditioner_ = std::make_unique<TimedPreconditioner>(*preconditioner_, telemetry_);
+    iterative_solver->SetPreconditioner(*timed_preconditioner_);
+  }
+
+  telemetry_monitor_ = std::make_unique<TelemetryMonitor>(*lin_solver_, telemetry_);
+  nonlin_solver_->SetMonitor(*telemetry_monitor_);
+}
+
+void EquationSolver::setOperator(const mfem::Operator& op)
+{
+  timed_operator_ = std::make_unique<TimedOperator>(op, telemetry_);
+  operator_       = timed_operator_.get();
+  nonlin_solver_->SetOperator(*operator_);
+  rebuild_linear_jacobian_ = true;
+
+  // Now that the nonlinear solver knows about the operator, we can set its linear solver
+  if (!nonlin_solver_set_solver_called_) {
+    nonlin_solver_->SetSolver(linearSolver());
+    nonlin_solver_set_solver_called_ = true;
+  }
+}
+
+void EquationSolver::solve(mfem::Vector& x) const
+{
+  // the linear solves take the time of the solve that is not spent in the residual, the Jacobian or the
+  // preconditioner setup
+  auto timed = [this]() {
+    return telemetry_.residual_time + telemetry_.assembly_time + telemetry_.preconditioner_setup_time;
+  };
+  const double start        = MPI_Wtime();
+  const double timed_before = timed();
+
+  // a new forward solution (e.g. of the next design iteration) calls for a new preconditioner of its transpose
+  transpose_preconditioner_current_ = false;
+
+  if (linear_) {
+    solveLinear(x);
+    telemetry_.nonlinear_iterations++;
+  } else {
+    static_cast<TelemetryMonitor&>(*telemetry_monitor_).beginSolve();
+
+    mfem::Vector zero(x);
+    zero = 0.0;
+    // KINSOL does not handle non-zero RHS, so we enforce that the RHS
+    // of the nonlinear system is zero
+    nonlin_solver_->Mult(zero, x);
+    telemetry_.nonlinear_iterations += nonlin_solver_->GetNumIterations();
+
+    if (linear_relative_tol_) {
+      if (auto* iterative_solver = dynamic_cast<mfem::IterativeSolver*>(lin_solver_.get())) {
+        iterative_solver->SetRelTol(*linear_relative_tol_);
+      }
+    }
+  }
+
+  telemetry_.linear_solve_time += (MPI_Wtime() - start) - (timed() - timed_before);
+  telemetry_.solves++;
+}
+
+void EquationSolver::solveLinear(mfem::Vector& x) const
+{
+  SLIC_ERROR_ROOT_IF(!operator_, "The operator must be set prior to a linear solve");
+
+  mfem::Vector r(x.Size());
+  mfem::Vector dx(x.Size());
+
+  // evaluating F first lets the operator discard the Jacobian (with resetJacobian) when its inputs changed
+  operator_->Mult(x, r);
+
+  if (rebuild_linear_jacobian_) {
+    lin_solver_->SetOperator(operator_->GetGradient(x));
+    rebuild_linear_jacobian_ = false;
+  }
+
+  // since F is affine, F(x - dx) = F(x) - J dx = 0 is satisfied after a single linear solve
+  dx = 0.0;
+  lin_solver_->Mult(r, dx);
+  x -= dx;
+
+  auto* iterative_solver = dynamic_cast<const mfem::IterativeSolver*>(lin_solver_.get());
+  linear_converged_      = !iterative_solver || iterative_solver->GetConverged();
+
+  if (telemetry_.solves == 0) {
+    telemetry_.initial_residual_norm = mfem::ParNormlp(r, 2.0, nonlin_solver_->GetComm());
+  }
+  if (iterative_solver) {
+    telemetry_.linear_iterations.push_back(iterative_solver->GetNumIterations());
+    telemetry_.final_residual_norm = iterative_solver->GetFinalNorm();
+  } else {
+    telemetry_.final_residual_norm = 0.0;
+  }
+}
+
+bool EquationSolver::converged() const { return linear_ ? linear_converged_ : nonlin_solver_->GetConverged(); }
+
+namespace {
+
+/**
+ * @brief A preconditioner that ignores SetOperator, so that an iterative solver can be given
+ * an operator (e.g. a transposed action) that its preconditioner was not built from
+ */
+class FixedPreconditioner : public mfem::Solver {
+public:
+  /// @brief Wrap an already configured preconditioner
+  FixedPreconditioner(const mfem::Solver& preconditioner)
+      : mfem::Solver(preconditioner.Height(), preconditioner.Width()), preconditioner_(preconditioner)
+  {
+  }
+
+  /// @brief Apply the wrapped preconditioner
+  void Mult(const mfem::Vector& x, mfem::Vector& y) const override { preconditioner_.Mult(x, y); }
+
+  /// @brief The wrapped preconditioner is left as is
+  void SetOperator(const mfem::Operator&) override {}
+
+private:
+  /// @brief The wrapped preconditioner
+  const mfem::Solver& preconditioner_;
+};
+
+/**
+ * @brief The action of the Jacobian of a nonlinear operator at a point, from a forward finite difference of the
+ * operator along each vector it is applied to
+ */
+class FiniteDifferenceJacobian : public mfem::Operator {
+public:
+  /**
+   * @brief The Jacobian of @p F at @p x
+   *
+   * @param F The nonlinear operator
+   * @param x The point, which must outlive this operator
+   * @param Fx The value of F at x, which must outlive this operator
+   * @param comm The communicator the vectors are distributed over
+   */
+  FiniteDifferenceJacobian(const mfem::Operator& F, const mfem::Vector& x, const mfem::Vector& Fx, MPI_Comm comm)
+      : mfem::Operator(F.Height(), F.Width()),
+        F_(F),
+        x_(x),
+        Fx_(Fx),
+        comm_(comm),
+        x_norm_(std::sqrt(mfem::InnerProduct(comm, x, x))),
+        perturbed_(x.Size())
+  {
+  }
+
+  /// @brief J v ~ (F(x + h v) - F(x)) / h, with the step h scaled to balance truncation and rounding errors
+  void Mult(const mfem::Vector& v, mfem::Vector& Jv) const override
+  {
+    double v_norm = std::sqrt(mfem::InnerProduct(comm_, v, v));
+    if (v_norm == 0.0) {
+      Jv = 0.0;
+      return;
+    }
+
+    double h = std::sqrt(std::numeric_limits<double>::epsilon()) * (1.0 + x_norm_) / v_norm;
+    add(x_, h, v, perturbed_);
+    F_.Mult(perturbed_, Jv);
+    Jv -= Fx_;
+    Jv *= 1.0 / h;
+  }
+
+private:
+  /// @brief The nonlinear operator
+  const mfem::Operator& F_;
+
+  /// @brief The point the Jacobian is evaluated at
+  const mfem::Vector& x_;
+
+  /// @brief The value of the operator at that point
+  const mfem::Vector& Fx_;
+
+  /// @brief The communicator the vectors are distributed over
+  MPI_Comm comm_;
+
+  /// @brief The norm of the point
+  double x_norm_;
+
+  /// @brief The perturbed point of the last application
+  mutable mfem::Vector perturbed_;
+};
+
+/**
+ * @brief Whether a square matrix is symmetric, checked by comparing w^T (J v) with v^T (J w) for random v and w
+ */
+bool isSymmetric(const mfem::HypreParMatrix& J)
+{
+  mfem::HypreParVector v(const_cast<mfem::HypreParMatrix&>(J), 1);
+  mfem::HypreParVector w(const_cast<mfem::HypreParMatrix&>(J), 1);
+  mfem::HypreParVector Jv(const_cast<mfem::HypreParMatrix&>(J), 0);
+  mfem::HypreParVector Jw(const_cast<mfem::HypreParMatrix&>(J), 0);
+
+  v.Randomize(1);
+  w.Randomize(2);
+  J.Mult(v, Jv);
+  J.Mult(w, Jw);
+
+  double wJv = mfem::InnerProduct(w, Jv);
+  double vJw = mfem::InnerProduct(v, Jw);
+
+  constexpr double tolerance = 1.0e-12;
+  return std::abs(wJv - vJw) <= tolerance * std::max(std::abs(wJv), std::abs(vJw));
+}
+
+/**
+ * @brief Solves J^T x = b with a SuperLU factorization of a nearby matrix, by iterative refinement with the
+ * residuals of J^T
+ *
+ * @return Whether the residual met the tolerances within a few refinement steps
+ */
+bool refinedTransposeSolve(const SuperLUSolver& factorization, const mfem::HypreParMatrix& J, const mfem::Vector& b,
+                           mfem::Vector& x, double relative_tol, double absolute_tol)
+{
+  // a factorization of a matrix that is far from J is better redone than refined for many steps
+  constexpr int max_refinements = 5;
+
+  MPI_Comm     comm      = J.GetComm();
+  const double tolerance = std::max(relative_tol * mfem::ParNormlp(b, 2.0, comm), absolute_tol);
+
+  mfem::Vector r(b);
+  mfem::Vector dx(x.Size());
+  x = 0.0;
+  for (int k = 0; k < max_refinements; k++) {
+    factorization.MultTranspose(r, dx);
+    x += dx;
+
+    r = b;
+    J.MultTranspose(-1.0, x, 1.0, r);
+    if (mfem::ParNormlp(r, 2.0, comm) <= tolerance) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+void EquationSolver::solveTranspose(const mfem::HypreParMatrix& J, const mfem::Vector& b, mfem::Vector& x)
+{
+  // the linear solver no longer holds the Jacobian of the nonlinear solve
+  resetJacobian();
+
+  const bool symmetric = isSymmetric(J);
+  const bool reuse     = adjoint_preconditioning_ != AdjointPreconditioning::Rebuild;
+
+  if (auto* superlu = dynamic_cast<SuperLUSolver*>(lin_solver_.get())) {
+    // the factorization of the last forward solve is of a nearby matrix (e.g. the Jacobian of the last Newton
+    // iteration), so it is refined with J, and only refactored if the refinement doesn't converge
+    bool solved = false;
+    if (reuse && superlu->factorizationSize() == J.Height()) {
+      solved = refinedTransposeSolve(*superlu, J, b, x, refinement_relative_tol_, refinement_absolute_tol_);
+    }
+    if (!solved) {
+      superlu->SetOperator(J);
+      superlu->MultTranspose(b, x);
+    }
+    return;
+  }
+
+  auto* iterative_solver = dynamic_cast<mfem::IterativeSolver*>(lin_solver_.get());
+  if (symmetric && !(iterative_solver && preconditioner_)) {
+    lin_solver_->SetOperator(J);
+    lin_solver_->Mult(b, x);
+    return;
+  }
+
+  SLIC_ERROR_ROOT_IF(!iterative_solver, "Transpose solves require a SuperLU or an iterative linear solver");
+
+  // the preconditioner is set up here (if at all), so that the iterative solver does not set it up from the
+  // transposed action
+  std::optional<FixedPreconditioner> fixed_preconditioner;
+  if (preconditioner_) {
+    const bool forward_applies = symmetric || transpose_invariant_preconditioner_;
+    const bool forward_set_up  = preconditioner_->Height() == J.Height();
+
+    if (forward_applies) {
+      if (!(reuse && forward_set_up)) {
+        preconditioner_->SetOperator(J);
+      }
+      fixed_preconditioner.emplace(*preconditioner_);
+    } else if (transpose_preconditioner_) {
+      // set up once after each forward solve, and shared by the adjoint solves until the next one
+      if (!transpose_preconditioner_current_) {
+        transpose_matrix_.reset(J.Transpose());
+        transpose_preconditioner_->SetOperator(*transpose_matrix_);
+        transpose_preconditioner_current_ = true;
+      }
+      fixed_preconditioner.emplace(*transpose_preconditioner_);
+    } else {
+      transpose_matrix_.reset(J.Transpose());
+      preconditioner_->SetOperator(*transpose_matrix_);
+      fixed_preconditioner.emplace(*preconditioner_);
+    }
+    iterative_solver->SetPreconditioner(*fixed_preconditioner);
+  }
+
+  if (symmetric) {
+    iterative_solver->SetOperator(J);
+  } else {
+    transpose_operator_ = std::make_unique<mfem::TransposeOperator>(&J);
+    iterative_solver->SetOperator(*transpose_operator_);
+  }
+  iterative_solver->Mult(b, x);
+
+  if (preconditioner_) {
+    iterative_solver->SetPreconditioner(timed_preconditioner_ ? *timed_preconditioner_ : *preconditioner_);
+  }
+  if (!transpose_preconditioner_) {
+    transpose_matrix_.reset();
+  }
+}
+
+bool EquationSolver::reusingJacobian() const
+{
+  auto* modified_newton = dynamic_cast<const ModifiedNewtonSolver*>(nonlin_solver_.get());
+  return modified_newton && modified_newton->reusingJacobian();
+}
+
+void EquationSolver::resetJacobian()
+{
+  rebuild_linear_jacobian_ = true;
+  if (auto* modified_newton = dynamic_cast<ModifiedNewtonSolver*>(nonlin_solver_.get())) {
+    modified_newton->resetJacobian();
+  }
+}
+
+ModifiedNewtonSolver::ModifiedNewtonSolver(MPI_Comm comm, const NonlinearSolverOptions& nonlinear_opts)
+    : mfem::NewtonSolver(comm),
+      reuse_(nonlinear_opts.jacobian_reuse),
+      rebuild_period_(nonlinear_opts.jacobian_rebuild_period),
+      stagnation_ratio_(nonlinear_opts.jacobian_stagnation_ratio),
+      method_(nonlinear_opts.nonlin_solver),
+      jfnk_relative_tol_(nonlinear_opts.jfnk_relative_tol),
+      jfnk_max_iterations_(nonlinear_opts.jfnk_max_iterations),
+      globalization_(nonlinear_opts.globalization),
+      max_line_search_iterations_(nonlinear_opts.max_line_search_iterations),
+      sufficient_decrease_(nonlinear_opts.sufficient_decrease)
+{
+  SLIC_ERROR_ROOT_IF(rebuild_period_ < 0, "The Jacobian rebuild period must be non-negative");
+  SLIC_ERROR_ROOT_IF(globalization_ != NonlinearGlobalization::None && max_line_search_iterations_ < 0,
+                     "The maximum number of line search iterations must be non-negative");
+
+  if (method_ == NonlinearSolver::Anderson) {
+    // the modified Newton update is already a good step, so it is not relaxed
+    accelerator_.emplace(comm, FixedPointAccelerationOptions{.method     = FixedPointAcceleration::Anderson,
+                                                              .relaxation = 1.0,
+                                                              .depth      = nonlinear_opts.anderson_depth});
+  }
+}
+
+void ModifiedNewtonSolver::SetOperator(const mfem::Operator& op)
+{
+  mfem::NewtonSolver::SetOperator(op);
+  rebuild_jacobian_ = true;
+}
+
+bool ModifiedNewtonSolver::reusingJacobian() const
+{
+  return reuse_ == JacobianReuse::AcrossSolves && !rebuild_jacobian_;
+}
+
+void ModifiedNewtonSolver::Mult(const mfem::Vector& b, mfem::Vector& x) const
+{
+  SLIC_ERROR_ROOT_IF(!oper, "The operator must be set prior to a nonlinear solve");
+  SLIC_ERROR_ROOT_IF(!prec, "The linear solver must be set prior to a nonlinear solve");
+
+  const bool have_b = (b.Size() == Height());
+
+  if (!iterative_mode) {
+    x = 0.0;
+  }
+
+  ProcessNewState(x);
+
+  oper->Mult(x, r);
+  if (have_b) {
+    r -= b;
+  }
+
+  double       norm0     = Norm(r);
+  double       norm      = norm0;
+  const double norm_goal = std::max(rel_tol * norm0, abs_tol);
+  initial_norm           = norm0;
+
+  if (reuse_ != JacobianReuse::AcrossSolves) {
+    rebuild_jacobian_ = true;
+  }
+
+  prec->iterative_mode = false;
+
+  if (accelerator_) {
+    accelerator_->reset();
+  }
+  trust_radius_ = 0.0;
+
+  // the Jacobian-free Krylov solver of JFNK, preconditioned with the linear solver (holding the reused Jacobian)
+  std::optional<mfem::FGMRESSolver>  krylov;
+  std::optional<FixedPreconditioner> fixed_preconditioner;
+  mfem::Vector                       residual_value;
+  mfem::Vector                       next_x(x.Size());
+  if (method_ == NonlinearSolver::JFNK) {
+    krylov.emplace(GetComm());
+    krylov->SetRelTol(jfnk_relative_tol_);
+    krylov->SetAbsTol(0.0);
+    krylov->SetMaxIter(jfnk_max_iterations_);
+    krylov->SetKDim(jfnk_max_iterations_);
+    krylov->SetPrintLevel(0);
+    fixed_preconditioner.emplace(*prec);
+    krylov->SetPreconditioner(*fixed_preconditioner);
+  }
+
+  int it = 0;
+  for (; true; it++) {
+    if (print_options.iterations) {
+      mfem::out << "Newton iteration " << std::setw(2) << it << " : ||r|| = " << norm;
+      if (it > 0) {
+        mfem::out << ", ||r||/||r_0|| = " << norm / norm0;
+      }
+      mfem::out << '\n';
+    }
+    Monitor(it, norm, r, x);
+
+    if (norm <= norm_goal) {
+      converged = true;
+      break;
+    }
+
+    if (it >= max_iter) {
+      converged = false;
+      break;
+    }
+
+    // only linearize (i.e. assemble and set up the preconditioner) when the policy asks for it,
+    // otherwise the linear solver still holds the previous Jacobian
+    if (reuse_ == JacobianReuse::Never || rebuild_jacobian_ ||
+        (rebuild_period_ > 0 && iterations_since_rebuild_ >= rebuild_period_)) {
+      grad = &oper->GetGradient(x);
+      prec->SetOperator(*grad);
+      rebuild_jacobian_         = false;
+      iterations_since_rebuild_ = 0;
+      num_rebuilds_++;
+
+      // the fixed-point map of Anderson acceleration changes with the Jacobian, so its history no longer applies
+      if (accelerator_) {
+        accelerator_->reset();
+      }
+    }
+
+    if (lin_rtol_type) {
+      AdaptLinRtolPreSolve(x, it, norm);
+    }
+
+    if (krylov) {
+      // the finite differences are of F, so the value of F is needed without the right hand side
+      residual_value = r;
+      if (have_b) {
+        residual_value += b;
+      }
+      FiniteDifferenceJacobian jacobian(*oper, x, residual_value, GetComm());
+      krylov->SetOperator(jacobian);
+      c = 0.0;
+      krylov->Mult(r, c);
+    } else {
+      prec->Mult(r, c);
+    }
+
+    if (lin_rtol_type) {
+      AdaptLinRtolPostSolve(c, r, it, norm);
+    }
+
+    const double c_scale = ComputeScalingFactor(x, b);
+    if (c_scale == 0.0) {
+      converged = false;
+      break;
+    }
+
+    if (globalization_ != NonlinearGlobalization::None) {
+      // the residual of the accepted update was the last one evaluated, so it is not evaluated again
+      c *= c_scale;
+      if (!globalizedUpdate(b, x, norm)) {
+        converged = false;
+        break;
+      }
+    } else {
+      if (accelerator_) {
+        add(x, -c_scale, c, next_x);
+        accelerator_->update(x, next_x);
+      } else {
+        add(x, -c_scale, c, x);
+      }
+
+      ProcessNewState(x);
+
+      oper->Mult(x, r);
+      if (have_b) {
+        r -= b;
+      }
+    }
+
+    const double previous_norm = norm;
+    norm                       = Norm(r);
+    iterations_since_rebuild_++;
+
+    // the Jacobian no longer contracts the residual quickly enough, so rebuild it
+    if (norm > stagnation_ratio_ * previous_norm) {
+      rebuild_jacobian_ = true;
+    }
+  }
+
+  // a Jacobian that failed to converge the last solve should not be kept for the next one
+  if (!converged) {
+    rebuild_jacobian_ = true;
+  }
+
+  final_iter = it;
+  final_norm = norm;
+
+  if (print_options.summary || (!converged && print_options.warnings) || print_options.first_and_last) {
+    mfem::out << "Newton: Number of iterations: " << final_iter << '\n'
+              << "   ||r|| = " << final_norm << ", Jacobian rebuilds: " << num_rebuilds_ << '\n';
+  }
+  if (!converged && (print_options.summary || print_options.warnings)) {
+    mfem::out << "Newton: No convergence!\n";
+  }
+}
+
+bool ModifiedNewtonSolver::globalizedUpdate(const mfem::Vector& b, mfem::Vector& x, double norm) const
+{
+  const bool   have_b = (b.Size() == Height());
+  const double c_norm = Norm(c);
+  if (c_norm == 0.0) {
+    return false;
+  }
+
+  // the first update of a solve sets the initial radius of the trust region
+  if (globalization_ == NonlinearGlobalization::TrustRegion && trust_radius_ == 0.0) {
+    trust_radius_ = c_norm;
+  }
+
+  auto full_step = [&]() {
+    return (globalization_ == NonlinearGlobalization::TrustRegion) ? std::min(1.0, trust_radius_ / c_norm) : 1.0;
+  };
+
+  trial_x_.SetSize(x.Size());
+  double step = full_step();
+  for (int attempt = 0; attempt <= max_line_search_iterations_; attempt++) {
+    add(x, -step, c, trial_x_);
+    ProcessNewState(trial_x_);
+
+    oper->Mult(trial_x_, r);
+    if (have_b) {
+      r -= b;
+    }
+
+    // the linear model predicts a decrease of the residual norm by step * norm, and a NaN residual is rejected
+    const double trial_norm = Norm(r);
+    const double ratio      = (norm - trial_norm) / (step * norm);
+    const bool   accepted   = ratio >= sufficient_decrease_;
+
+    if (print_options.iterations && step < 1.0) {
+      mfem::out << "   line search step " << step << " : ||r|| = " << trial_norm << '\n';
+    }
+
+    if (globalization_ == NonlinearGlobalization::TrustRegion) {
+      if (!(ratio >= 0.25)) {
+        trust_radius_ = 0.25 * step * c_norm;
+      } else if (ratio > 0.75 && step * c_norm >= 0.99 * trust_radius_) {
+        trust_radius_ *= 2.0;
+      }
+    }
+
+    if (accepted) {
+      x = trial_x_;
+      return true;
+    }
+
+    step = (globalization_ == NonlinearGlobalization::TrustRegion) ? full_step() : 0.5 * step;
+  }
+
+  return false;
+}
+
+void SuperLUSolver::Mult(const mfem::Vector& x, mfem::Vector& y) const
+{
+  SLIC_ERROR_ROOT_IF(!superlu_mat_, "Operator must be set prior to solving with SuperLU");
+
+  // Use the underlying MFEM-based solver and SuperLU matrix type to solve the system
+  superlu_solver_.Mult(x, y);
+}
+
+void SuperLUSolver::MultTranspose(const mfem::Vector& x, mfem::Vector& y) const
+{
+  SLIC_ERROR_ROOT_IF(!superlu_mat_, "Operator must be set prior to solving with SuperLU");
+
+  superlu_solver_.MultTranspose(x, y);
+}
+
+namespace {
+
+/// @brief The values of a HypreParMatrix, diagonal part followed by off-diagonal part, as (pointer, size) pairs
+std::array<std::pair<double*, int>, 2> hypreValues(mfem::HypreParMatrix& matrix)
+{
+  mfem::SparseMatrix diag;
+  mfem::SparseMatrix offd;
+  HYPRE_BigInt*      col_map_offd;
+
+  matrix.HostReadWrite();
+  matrix.GetDiag(diag);
+  matrix.GetOffd(offd, col_map_offd);
+
+  return {{{diag.GetData(), diag.NumNonZeroElems()}, {offd.GetData(), offd.NumNonZeroElems()}}};
+}
+
+}  // namespace
+
+SuperLUSolver::SparsityPattern::SparsityPattern(const mfem::HypreParMatrix& matrix)
+{
+  mfem::SparseMatrix diag;
+  mfem::SparseMatrix offd;
+  HYPRE_BigInt*      cmap;
+
+  matrix.HostRead();
+  matrix.GetDiag(diag);
+  matrix.GetOffd(offd, cmap);
+
+  diag_I.assign(diag.GetI(), diag.GetI() + diag.Height() + 1);
+  diag_J.assign(diag.GetJ(), diag.GetJ() + diag.NumNonZeroElems());
+  offd_I.assign(offd.GetI(), offd.GetI() + offd.Height() + 1);
+  offd_J.assign(offd.GetJ(), offd.GetJ() + offd.NumNonZeroElems());
+  col_map_offd.assign(cmap, cmap + offd.Width());
+}
+
+bool SuperLUSolver::SparsityPattern::matches(const mfem::HypreParMatrix& matrix) const
+{
+  mfem::SparseMatrix diag;
+  mfem::SparseMatrix offd;
+  HYPRE_BigInt*      cmap;
+
+  matrix.HostRead();
+  matrix.GetDiag(diag);
+  matrix.GetOffd(offd, cmap);
+
+  auto same = [](const auto& stored, const auto* values, int size) {
+    return static_cast<int>(stored.size()) == size && std::equal(stored.begin(), stored.end(), values);
+  };
+
+  return same(diag_I, diag.GetI(), diag.Height() + 1) && same(diag_J, diag.GetJ(), diag.NumNonZeroElems()) &&
+         same(offd_I, offd.GetI(), offd.Height() + 1) && same(offd_J, offd.GetJ(), offd.NumNonZeroElems()) &&
+         same(col_map_offd, cmap, offd.Width());
+}
+
+void SuperLUSolver::buildMonolithicMatrix(const std::vector<const mfem::HypreParMatrix*>& blocks, int row_blocks)
+{
+  // HypreParMatrixFromBlocks only moves entries around, so building it from blocks whose values
+  // are (1 + the index of each entry among all the block entries) tells us where each entry ends up
+  std::vector<std::unique_ptr<mfem::HypreParMatrix>> index_blocks(blocks.size());
+  std::vector<int>                                   block_offsets(blocks.size() + 1, 0);
+  mfem::Array2D<mfem::HypreParMatrix*>               hypre_blocks(row_blocks, row_blocks);
+
+  for (std::size_t b = 0; b < blocks.size(); b++) {
+    index_blocks[b] = std::make_unique<mfem::HypreParMatrix>(*blocks[b]);
+
+    int entry = 0;
+    for (auto [values, size] : hypreValues(*index_blocks[b])) {
+      for (int k = 0; k < size; k++) {
+        values[k] = double(block_offsets[b] + entry + 1);
+        entry++;
+      }
+    }
+    block_offsets[b + 1] = block_offsets[b] + entry;
+
+    hypre_blocks(int(b) / row_blocks, int(b) % row_blocks) = index_blocks[b].get();
+  }
+
+  // Note that MFEM passes ownership of this matrix to the caller
+  monolithic_mat_ = std::unique_ptr<mfem::HypreParMatrix>(mfem::HypreParMatrixFromBlocks(hypre_blocks));
+
+  monolithic_source_block_.clear();
+  monolithic_source_entry_.clear();
+  for (auto [values, size] : hypreValues(*monolithic_mat_)) {
+    for (int k = 0; k < size; k++) {
+      int  index = int(values[k]) - 1;
+      auto block = std::upper_bound(block_offsets.begin(), block_offsets.end(), index) - block_offsets.begin() - 1;
+      monolithic_source_block_.push_back(int(block));
+      monolithic_source_entry_.push_back(index - block_offsets[std::size_t(block)]);
+    }
+  }
+}
+
+void SuperLUSolver::updateMonolithicMatrix(const std::vector<const mfem::HypreParMatrix*>& blocks)
+{
+  // the values of each block, with the diagonal and off-diagonal parts concatenated
+  std::vector<std::vector<double>> block_values(blocks.size());
+  for (std::size_t b = 0; b < blocks.size(); b++) {
+    for (auto [values, size] : hypreValues(const_cast<mfem::HypreParMatrix&>(*blocks[b]))) {
+      block_values[b].insert(block_values[b].end(), values, values + size);
+    }
+  }
+
+  int m = 0;
+  for (auto [values, size] : hypreValues(*monolithic_mat_)) {
+    for (int k = 0; k < size; k++, m++) {
+      values[k] = block_values[std::size_t(monolithic_source_block_[std::size_t(m)])]
+                              [std::size_t(monolithic_source_entry_[std::size_t(m)])];
+    }
+  }
+}
+
+void SuperLUSolver::SetOperator(const mfem::Operator& op)
+{
+  std::vector<const mfem::HypreParMatrix*> blocks;
+  int                                      row_blocks = 1;
+
+  // Check if this is a block operator
+  auto* block_operator = dynamic_cast<const mfem::BlockOperator*>(&op);
+
+  // If it is, gather the underlying blocks to make a monolithic system from
+  if (block_operator) {
+    row_blocks     = block_operator->NumRowBlocks();
+    int col_blocks = block_operator->NumColBlocks();
+
+    SLIC_ERROR_ROOT_IF(row_blocks != col_blocks, "Attempted to use SuperLU on a non-square block system.");
+
+    for (int i = 0; i < row_blocks; ++i) {
+      for (int j = 0; j < col_blocks; ++j) {
+        auto* hypre_block = dynamic_cast<const mfem::HypreParMatrix*>(&block_operator->GetBlock(i, j));
+        SLIC_ERROR_ROOT_IF(!hypre_block,
+                           "Trying to use SuperLU on a block operator that does not contain HypreParMatrix blocks.");
+
+        blocks.push_back(hypre_block);
+      }
+    }
+  } else {
+    // If this is not a block system, check that the input operator is a HypreParMatrix as expected
+    auto* matrix = dynamic_cast<const mfem::HypreParMatrix*>(&op);
+
+    SLIC_ERROR_ROOT_IF(!matrix, "Matrix must be an assembled HypreParMatrix for use with SuperLU");
+
+    blocks.push_back(matrix);
+  }
+
+  // the factorization structure (and the monolithic matrix of a block system) can only be
+  // reused if every block has the same sparsity pattern as before, on every rank
+  int same_pattern = (patterns_.size() == blocks.size());
+  for (std::size_t b = 0; same_pattern && b < blocks.size(); b++) {
+    same_pattern = patterns_[b].matches(*blocks[b]);
+  }
+  MPI_Allreduce(MPI_IN_PLACE, &same_pattern, 1, MPI_INT, MPI_MIN, comm_);
+
+  if (!same_pattern) {
+    patterns_.clear();
+    for (auto* block : blocks) {
+      patterns_.emplace_back(*block);
+    }
+  }
+
+  const mfem::HypreParMatrix* matrix = blocks[0];
+  if (block_operator) {
+    if (!same_pattern) {
+      buildMonolithicMatrix(blocks, row_blocks);
+    }
+    updateMonolithicMatrix(blocks);
+    matrix = monolithic_mat_.get();
+  }
+
+  superlu_mat_ = std::make_unique<mfem::SuperLURowLocMatrix>(*matrix);
+
+  superlu_solver_.SetOperator(*superlu_mat_);
+
+  // keep the column permutation and elimination tree of the previous factorization when the structure is unchanged
+  superlu_solver_.SetFact(same_pattern ? mfem::superlu::SamePattern : mfem::superlu::DOFACT);
+}
+
+SinglePrecisionParMatrix::SinglePrecisionParMatrix(const mfem::HypreParMatrix& A)
+    : mfem::Operator(A.Height(), A.Width()), comm_(A.GetComm())
+{
+  A.HostRead();
+
+  mfem::SparseMatrix diag, offd;
+  HYPRE_BigInt*      offd_columns = nullptr;
+  A.GetDiag(diag);
+  A.GetOffd(offd, offd_columns);
+  diag_ = copyBlock(diag);
+  offd_ = copyBlock(offd);
+
+  // the halo exchange of the input vector follows the communication package of the hypre matrix-vector product
+  hypre_ParCSRMatrix* parcsr = A;
+  if (!hypre_ParCSRMatrixCommPkg(parcsr)) {
+    hypre_MatvecCommPkgCreate(parcsr);
+  }
+  hypre_ParCSRCommPkg* comm_pkg = hypre_ParCSRMatrixCommPkg(parcsr);
+
+  const int  num_sends   = hypre_ParCSRCommPkgNumSends(comm_pkg);
+  const int  num_recvs   = hypre_ParCSRCommPkgNumRecvs(comm_pkg);
+  const auto send_starts = hypre_ParCSRCommPkgSendMapStarts(comm_pkg);
+  const auto recv_starts = hypre_ParCSRCommPkgRecvVecStarts(comm_pkg);
+  const auto send_elmts  = hypre_ParCSRCommPkgSendMapElmts(comm_pkg);
+
+  send_ranks_.assign(hypre_ParCSRCommPkgSendProcs(comm_pkg), hypre_ParCSRCommPkgSendProcs(comm_pkg) + num_sends);
+  recv_ranks_.assign(hypre_ParCSRCommPkgRecvProcs(comm_pkg), hypre_ParCSRCommPkgRecvProcs(comm_pkg) + num_recvs);
+  send_offsets_.assign(send_starts, send_starts + num_sends + 1);
+  recv_offsets_.assign(recv_starts, recv_starts + num_recvs + 1);
+  send_indices_.assign(send_elmts, send_elmts + send_starts[num_sends]);
+
+  send_buffer_.resize(send_indices_.size());
+  halo_.resize(static_cast<size_t>(recv_offsets_.back()));
+
+  SLIC_ERROR_IF(static_cast<int>(halo_.size()) != offd.Width(),
+                "the halo of the single precision matrix doesn't match its off-diagonal block");
+
+  tracker_.set(sizeof(float) * (diag_.values.size() + offd_.values.size() + send_buffer_.size() + halo_.size()));
+}
+
+SinglePrecisionParMatrix::LocalBlock SinglePrecisionParMatrix::copyBlock(const mfem::SparseMatrix& block)
+{
+  const int*    I    = block.GetI();
+  const int*    J    = block.GetJ();
+  const double* data = block.GetData();
+  const int     rows = block.Height();
+
+  LocalBlock copy;
+  copy.row_ptr.assign(I, I + rows + 1);
+  copy.col_ind.assign(J, J + I[rows]);
+  copy.values.resize(static_cast<size_t>(I[rows]));
+  std::transform(data, data + I[rows], copy.values.begin(), [](double value) { return static_cast<float>(value); });
+  return copy;
+}
+
+void SinglePrecisionParMatrix::Mult(const mfem::Vector& x, mfem::Vector& y) const
+{
+  SLIC_ERROR_IF(x.Size() != Width(), "SinglePrecisionParMatrix::Mult(): x has the wrong size");
+
+  constexpr int tag = 0;
+  const double* X   = x.HostRead();
+
+  // start the halo exchange, and overlap it with the product of the diagonal block
+  std::vector<MPI_Request> requests(recv_ranks_.size() + send_ranks_.size());
+  for (size_t r = 0; r < recv_ranks_.size(); r++) {
+    MPI_Irecv(halo_.data() + recv_offsets_[r], recv_offsets_[r + 1] - recv_offsets_[r], MPI_FLOAT, recv_ranks_[r],
+              tag, comm_, &requests[r]);
+  }
+  for (size_t k = 0; k < send_indices_.size(); k++) {
+    send_buffer_[k] = static_cast<float>(X[send_indices_[k]]);
+  }
+  for (size_t s = 0; s < send_ranks_.size(); s++) {
+    MPI_Isend(send_buffer_.data() + send_offsets_[s], send_offsets_[s + 1] - send_offsets_[s], MPI_FLOAT,
+              send_ranks_[s], tag, comm_, &requests[recv_ranks_.size() + s]);
+  }
+
+  y.SetSize(Height());
+  double* Y = y.HostWrite();
+  for (int row = 0; row < Height(); row++) {
+    double sum = 0.0;
+    for (int k = diag_.row_ptr[static_cast<size_t>(row)]; k < diag_.row_ptr[static_cast<size_t>(row) + 1]; k++) {
+      sum += static_cast<double>(diag_.values[static_cast<size_t>(k)]) * X[diag_.col_ind[static_cast<size_t>(k)]];
+    }
+    Y[row] = sum;
+  }
+
+  MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+
+  for (int row = 0; row < Height(); row++) {
+    double sum = 0.0;
+    for (int k = offd_.row_ptr[static_cast<size_t>(row)]; k < offd_.row_ptr[static_cast<size_t>(row) + 1]; k++) {
+      sum += static_cast<double>(offd_.values[static_cast<size_t>(k)]) *
+             static_cast<double>(halo_[static_cast<size_t>(offd_.col_ind[static_cast<size_t>(k)])]);
+    }
+    Y[row] += sum;
+  }
+}
+
+void SinglePrecisionParMatrix::AssembleDiagonal(mfem::Vector& diag) const
+{
+  diag.SetSize(Height());
+  double* D = diag.HostWrite();
+  for (int row = 0; row < Height(); row++) {
+    D[row] = 0.0;
+    for (int k = diag_.row_ptr[static_cast<size_t>(row)]; k < diag_.row_ptr[static_cast<size_t>(row) + 1]; k++) {
+      if (diag_.col_ind[static_cast<size_t>(k)] == row) {
+        D[row] = static_cast<double>(diag_.values[static_cast<size_t>(k)]);
+      }
+    }
+  }
+}
 
-EquationSolver::EquationSolver(NonlinearSolverOptions nonlinear_opts, LinearSolverOptions lin_opts, MPI_Comm comm)
+void ChebyshevSmoother::Mult(const mfem::Vector& x, mfem::Vector& y) const
 {
-  auto [lin_solver, preconditioner] = buildLinearSolverAndPreconditioner(lin_opts, comm);
+  SLIC_ERROR_ROOT_IF(!smoother_, "Operator must be set prior to applying the Chebyshev smoother");
 
-  lin_solver_     = std::move(lin_solver);
-  preconditioner_ = std::move(preconditioner);
-  nonlin_solver_  = buildNonlinearSolver(nonlinear_opts, comm);
+  smoother_->Mult(x, y);
 }
 
-EquationSolver::EquationSolver(std::unique_ptr<mfem::NewtonSolver> nonlinear_solver,
-                               std::unique_ptr<mfem::Solver>       linear_solver,
-                               std::unique_ptr<mfem::Solver>       preconditioner)
+void ChebyshevSmoother::SetOperator(const mfem::Operator& op)
 {
-  SLIC_ERROR_ROOT_IF(!nonlinear_solver, "Nonlinear solvers must be given to construct an EquationSolver");
-  SLIC_ERROR_ROOT_IF(!linear_solver, "Linear solvers must be given to construct an EquationSolver");
+  height = op.Height();
+  width  = op.Width();
 
-  nonlin_solver_  = std::move(nonlinear_solver);
-  lin_solver_     = std::move(linear_solver);
-  preconditioner_ = std::move(preconditioner);
+  diagonal_.SetSize(height);
+  op.AssembleDiagonal(diagonal_);
+
+  smoother_ = std::make_unique<mfem::OperatorChebyshevSmoother>(op, diagonal_, no_essential_dofs_, order_, comm_);
 }
 
-void EquationSolver::setOperator(const mfem::Operator& op)
+void ReusableBoomerAMG::SetOperator(const mfem::Operator& op)
 {
-  nonlin_solver_->SetOperator(op);
+  auto* matrix = dynamic_cast<const mfem::HypreParMatrix*>(&op);
 
-  // Now that the nonlinear solver knows about the operator, we can set its linear solver
-  if (!nonlin_solver_set_solver_called_) {
-    nonlin_solver_->SetSolver(linearSolver());
-    nonlin_solver_set_solver_called_ = true;
+  SLIC_ERROR_ROOT_IF(!matrix, "Matrix must be an assembled HypreParMatrix for use with BoomerAMG");
+
+  const bool size_changed = !setup_matrix_ || setup_matrix_->Height() != matrix->Height() ||
+                            setup_matrix_->GetGlobalNumRows() != matrix->GetGlobalNumRows();
+
+  if (size_changed || updates_since_setup_ >= rebuild_period_) {
+    SERAC_PROFILE_SCOPE("BoomerAMG setup");
+    setup_matrix_ = std::make_unique<mfem::HypreParMatrix>(*matrix);
+    mfem::HypreBoomerAMG::SetOperator(*setup_matrix_);
+    updates_since_setup_ = 0;
+    num_setups_++;
   }
+
+  updates_since_setup_++;
 }
 
-void EquationSolver::solve(mfem::Vector& x) const
+#ifdef MFEM_USE_AMGX
+void ReusableAmgXSolver::SetOperator(const mfem::Operator& op)
 {
-  mfem::Vector zero(x);
-  zero = 0.0;
-  // KINSOL does not handle non-zero RHS, so we enforce that the RHS
-  // of the nonlinear system is zero
-  nonlin_solver_->Mult(zero, x);
+  auto* matrix = dynamic_cast<const mfem::HypreParMatrix*>(&op);
+
+  SLIC_ERROR_ROOT_IF(!matrix, "Matrix must be an assembled HypreParMatrix for use with AMGX");
+
+  // the coefficients can only be replaced (and the hierarchy reused) on the sparsity pattern of the last setup,
+  // and every rank has to make the same choice
+  mfem::SparseMatrix diag, offd;
+  HYPRE_BigInt*      offd_columns;
+  matrix->GetDiag(diag);
+  matrix->GetOffd(offd, offd_columns);
+  std::pair<int, int> structure{matrix->Height(), diag.NumNonZeroElems() + offd.NumNonZeroElems()};
+
+  int structure_changed = (structure != setup_structure_);
+  MPI_Allreduce(MPI_IN_PLACE, &structure_changed, 1, MPI_INT, MPI_LOR, matrix->GetComm());
+
+  bool full_setup = structure_changed || (resetup_ == AMGXResetup::Full) ||
+                    (resetup_ == AMGXResetup::ReuseHierarchy && updates_since_setup_ >= reuse_period_);
+
+  if (full_setup) {
+    SERAC_PROFILE_SCOPE("AmgX setup");
+    mfem::AmgXSolver::SetOperator(op);
+    setup_structure_     = structure;
+    updates_since_setup_ = 0;
+    num_setups_++;
+  } else if (resetup_ == AMGXResetup::CoefficientsOnly) {
+    mfem::AmgXSolver::UpdateOperator(op);
+    num_coefficient_updates_++;
+  }
+
+  updates_since_setup_++;
 }
+#endif
 
-void SuperLUSolver::Mult(const mfem::Vector& x, mfem::Vector& y) const
+void DeflatedCGSolver::SetOperator(const mfem::Operator& op)
 {
-  SLIC_ERROR_ROOT_IF(!superlu_mat_, "Operator must be set prior to solving with SuperLU");
+  mfem::IterativeSolver::SetOperator(op);
 
-  // Use the underlying MFEM-based solver and SuperLU matrix type to solve the system
-  superlu_solver_.Mult(x, y);
+  // solutions of a different size (e.g. after a mesh change) can not be recycled
+  if (!recycled_.empty() && recycled_.front().Size() != height) {
+    recycled_.clear();
+  }
+
+  r_.SetSize(height);
+  z_.SetSize(height);
+  p_.SetSize(height);
+  q_.SetSize(height);
 }
 
-void SuperLUSolver::SetOperator(const mfem::Operator& op)
+void DeflatedCGSolver::buildDeflationBasis() const
 {
-  // Check if this is a block operator
-  auto* block_operator = dynamic_cast<const mfem::BlockOperator*>(&op);
+  W_.clear();
+  AW_.clear();
 
-  // If it is, make a monolithic system from the underlying blocks
-  if (block_operator) {
-    int row_blocks = block_operator->NumRowBlocks();
-    int col_blocks = block_operator->NumColBlocks();
+  // vectors that lose all but this fraction of their A-norm to the previous ones are dropped
+  constexpr double dependence_tolerance = 1.0e-10;
 
-    SLIC_ERROR_ROOT_IF(row_blocks != col_blocks, "Attempted to use SuperLU on a non-square block system.");
+  for (const auto& v : recycled_) {
+    mfem::Vector w(v);
+    mfem::Vector Aw(height);
+    oper->Mult(w, Aw);
+    const double original_norm = std::sqrt(std::abs(Dot(w, Aw)));
 
-    mfem::Array2D<mfem::HypreParMatrix*> hypre_blocks(row_blocks, col_blocks);
+    // modified Gram-Schmidt in the A-inner product
+    for (size_t j = 0; j < W_.size(); j++) {
+      const double projection = Dot(AW_[j], w);
+      w.Add(-projection, W_[j]);
+      Aw.Add(-projection, AW_[j]);
+    }
 
-    for (int i = 0; i < row_blocks; ++i) {
-      for (int j = 0; j < col_blocks; ++j) {
-        auto* hypre_block = const_cast<mfem::HypreParMatrix*>(
-            dynamic_cast<const mfem::HypreParMatrix*>(&block_operator->GetBlock(i, j)));
-        SLIC_ERROR_ROOT_IF(!hypre_block,
-                           "Trying to use SuperLU on a block operator that does not contain HypreParMatrix blocks.");
+    const double norm = std::sqrt(std::abs(Dot(w, Aw)));
+    if (norm <= dependence_tolerance * original_norm || norm == 0.0) {
+      continue;
+    }
+
+    w /= norm;
+    Aw /= norm;
+    W_.push_back(std::move(w));
+    AW_.push_back(std::move(Aw));
+  }
+}
+
+void DeflatedCGSolver::deflate(const mfem::Vector& z, mfem::Vector& v) const
+{
+  for (size_t j = 0; j < W_.size(); j++) {
+    v.Add(-Dot(AW_[j], z), W_[j]);
+  }
+}
+
+void DeflatedCGSolver::Mult(const mfem::Vector& b, mfem::Vector& x) const
+{
+  SLIC_ERROR_ROOT_IF(!oper, "Operator must be set prior to solving with deflated CG");
+
+  if (!iterative_mode) {
+    x = 0.0;
+  }
+
+  buildDeflationBasis();
+
+  oper->Mult(x, q_);
+  r_ = b;
+  r_ -= q_;
+
+  // start from the A-orthogonal projection of the error onto the recycled subspace
+  for (size_t j = 0; j < W_.size(); j++) {
+    const double coefficient = Dot(W_[j], r_);
+    x.Add(coefficient, W_[j]);
+    r_.Add(-coefficient, AW_[j]);
+  }
+
+  if (prec) {
+    prec->Mult(r_, z_);
+  } else {
+    z_ = r_;
+  }
+  p_ = z_;
+  deflate(z_, p_);
+
+  double       rz        = Dot(r_, z_);
+  const double initial_r = std::sqrt(Dot(r_, r_));
+  const double tolerance = std::max(rel_tol * initial_r, abs_tol);
+
+  converged  = initial_r <= tolerance;
+  final_iter = 0;
+  final_norm = initial_r;
+
+  if (print_options.iterations) {
+    mfem::out << "   Iteration : " << std::setw(3) << 0 << "  ||r|| = " << initial_r
+              << "  (deflation dimension " << W_.size() << ")\n";
+  }
+
+  for (int i = 1; !converged && i <= max_iter; i++) {
+    oper->Mult(p_, q_);
+
+    const double pq = Dot(p_, q_);
+    if (pq <= 0.0) {
+      // the operator is not positive definite along this direction
+      break;
+    }
+
+    const double alpha = rz / pq;
+    x.Add(alpha, p_);
+    r_.Add(-alpha, q_);
+
+    final_iter = i;
+    final_norm = std::sqrt(Dot(r_, r_));
+    converged  = final_norm <= tolerance;
+
+    if (print_options.iterations) {
+      mfem::out << "   Iteration : " << std::setw(3) << i << "  ||r|| = " << final_norm << "\n";
+    }
+
+    if (converged) {
+      break;
+    }
+
+    if (prec) {
+      prec->Mult(r_, z_);
+    } else {
+      z_ = r_;
+    }
+
+    const double rz_new = Dot(r_, z_);
+    const double beta   = rz_new / rz;
+    rz                  = rz_new;
+
+    // p = z + beta p - W (AW)^T z
+    p_ *= beta;
+    p_ += z_;
+    deflate(z_, p_);
+  }
+
+  if (print_options.summary || (print_options.warnings && !converged)) {
+    mfem::out << "Deflated CG: Number of iterations: " << final_iter << ", ||r|| = " << final_norm
+              << (converged ? "" : " (not converged)") << "\n";
+  }
+
+  // the newest solution replaces the oldest one in the recycled subspace
+  if (recycled_dimension_ > 0) {
+    if (static_cast<int>(recycled_.size()) >= recycled_dimension_) {
+      recycled_.erase(recycled_.begin());
+    }
+    recycled_.emplace_back(x);
+  }
+}
+
+void PipelinedCGSolver::SetOperator(const mfem::Operator& op)
+{
+  mfem::IterativeSolver::SetOperator(op);
+
+  for (auto* v : {&r_, &u_, &w_, &m_, &n_, &z_, &q_, &s_, &p_}) {
+    v->SetSize(height);
+  }
+}
+
+void PipelinedCGSolver::precondition(const mfem::Vector& x, mfem::Vector& y) const
+{
+  if (prec) {
+    prec->Mult(x, y);
+  } else {
+    y = x;
+  }
+}
+
+void PipelinedCGSolver::Mult(const mfem::Vector& b, mfem::Vector& x) const
+{
+  SLIC_ERROR_ROOT_IF(!oper, "Operator must be set prior to solving with pipelined CG");
+
+  if (!iterative_mode) {
+    x = 0.0;
+  }
+
+  oper->Mult(x, r_);
+  subtract(b, r_, r_);
+  precondition(r_, u_);
+  oper->Mult(u_, w_);
+
+  z_ = 0.0;
+  q_ = 0.0;
+  s_ = 0.0;
+  p_ = 0.0;
+
+  double gamma_old = 0.0;
+  double alpha_old = 0.0;
+  double tolerance = 0.0;
+
+  converged  = false;
+  final_iter = 0;
+
+  for (int i = 0;; i++) {
+    // the three inner products of the iteration are reduced together, while M w and A M w are computed
+    std::array<double, 3> dots = {r_ * u_, w_ * u_, r_ * r_};
+    MPI_Request           request;
+    MPI_Iallreduce(MPI_IN_PLACE, dots.data(), 3, MPI_DOUBLE, MPI_SUM, comm, &request);
+
+    precondition(w_, m_);
+    oper->Mult(m_, n_);
+
+    MPI_Wait(&request, MPI_STATUS_IGNORE);
+    const auto [gamma, delta, r_squared] = dots;
+
+    final_norm = std::sqrt(r_squared);
+    if (i == 0) {
+      tolerance = std::max(rel_tol * final_norm, abs_tol);
+    }
+
+    if (print_options.iterations) {
+      mfem::out << "   Iteration : " << std::setw(3) << i << "  ||r|| = " << final_norm << "\n";
+    }
+
+    converged = final_norm <= tolerance;
+    if (converged || i == max_iter) {
+      break;
+    }
+
+    double beta  = 0.0;
+    double alpha = gamma / delta;
+    if (i > 0) {
+      beta  = gamma / gamma_old;
+      alpha = gamma / (delta - beta * gamma / alpha_old);
+    }
+
+    if (!std::isfinite(alpha) || alpha <= 0.0) {
+      // the operator or preconditioner is not positive definite
+      break;
+    }
+
+    // z = n + beta z, q = m + beta q, s = w + beta s, p = u + beta p
+    add(n_, beta, z_, z_);
+    add(m_, beta, q_, q_);
+    add(w_, beta, s_, s_);
+    add(u_, beta, p_, p_);
+
+    x.Add(alpha, p_);
+    r_.Add(-alpha, s_);
+    u_.Add(-alpha, q_);
+    w_.Add(-alpha, z_);
+
+    gamma_old  = gamma;
+    alpha_old  = alpha;
+    final_iter = i + 1;
+  }
+
+  if (print_options.summary || (print_options.warnings && !converged)) {
+    mfem::out << "Pipelined CG: Number of iterations: " << final_iter << ", ||r|| = " << final_norm
+              << (converged ? "" : " (not converged)") << "\n";
+  }
+}
+
+void GalerkinMultigridPreconditioner::setFineSpace(mfem::ParFiniteElementSpace& fes)
+{
+  fine_space_ = &fes;
+  coarse_spaces_.clear();
+  transfers_.clear();
+  prolongations_.clear();
+
+  fine_matrix_ = nullptr;
+}
+
+void GalerkinMultigridPreconditioner::addCoarseSpace(std::unique_ptr<mfem::ParFiniteElementSpace> space)
+{
+  mfem::ParFiniteElementSpace* finer_space = coarse_spaces_.empty() ? fine_space_ : coarse_spaces_.back().get();
+
+  auto transfer = std::make_unique<mfem::InterpolationGridTransfer>(*space, *finer_space);
+  transfer->SetOperatorType(mfem::Operator::Hypre_ParCSR);
+  prolongations_.push_back(dynamic_cast<const mfem::HypreParMatrix*>(&transfer->TrueForwardOperator()));
+  transfers_.push_back(std::move(transfer));
+
+  coarse_spaces_.push_back(std::move(space));
+}
+
+void PMultigridPreconditioner::setFiniteElementSpace(mfem::ParFiniteElementSpace& fes)
+{
+  auto* h1_collection = dynamic_cast<const mfem::H1_FECollection*>(fes.FEColl());
+  SLIC_ERROR_ROOT_IF(!h1_collection, "p-multigrid requires an H1 finite element space");
+
+  setFineSpace(fes);
+  coarse_collections_.clear();
+
+  const int dim = fes.GetParMesh()->Dimension();
+
+  int finer_order = fes.GetMaxElementOrder();
+  for (int order = finer_order / 2; finer_order > 1; order /= 2) {
+    coarse_collections_.push_back(std::make_unique<mfem::H1_FECollection>(order, dim, h1_collection->GetBasisType()));
+    addCoarseSpace(std::make_unique<mfem::ParFiniteElementSpace>(fes.GetParMesh(), coarse_collections_.back().get(),
+                                                                 fes.GetVDim(), fes.GetOrdering()));
+    finer_order = order;
+  }
+}
+
+void GeometricMultigridPreconditioner::setFiniteElementSpace(mfem::ParFiniteElementSpace&       fes,
+                                                             const std::vector<mfem::ParMesh*>& coarse_meshes)
+{
+  SLIC_ERROR_ROOT_IF(coarse_meshes.empty(),
+                     "geometric multigrid requires the coarse meshes of the refinements of the fine mesh, see the "
+                     "coarse_meshes argument of mesh::refineAndDistribute");
 
-        hypre_blocks(i, j) = hypre_block;
+  setFineSpace(fes);
+
+  // from the finest coarse mesh to the coarsest one, each refined uniformly into the one above it
+  const mfem::ParMesh* finer_mesh = fes.GetParMesh();
+  for (auto mesh = coarse_meshes.rbegin(); mesh != coarse_meshes.rend(); ++mesh) {
+    const int children = 1 << (*mesh)->Dimension();
+    SLIC_ERROR_ROOT_IF(finer_mesh->GetGlobalNE() != children * (*mesh)->GetGlobalNE(),
+                       "each mesh of a geometric multigrid hierarchy must be refined uniformly into the next one");
+
+    addCoarseSpace(
+        std::make_unique<mfem::ParFiniteElementSpace>(*mesh, fes.FEColl(), fes.GetVDim(), fes.GetOrdering()));
+    finer_mesh = *mesh;
+  }
+}
+
+void GalerkinMultigridPreconditioner::SetOperator(const mfem::Operator& op)
+{
+  fine_matrix_ = dynamic_cast<const mfem::HypreParMatrix*>(&op);
+
+  SLIC_ERROR_ROOT_IF(!fine_matrix_, "Matrix must be an assembled HypreParMatrix for use with " + name_);
+  SLIC_ERROR_ROOT_IF(!fine_space_ || fine_space_->GetTrueVSize() != fine_matrix_->Height(),
+                     "The finite element space of the operator must be given to " + name_ + " before its operator");
+
+  height = op.Height();
+  width  = op.Width();
+
+  const int num_levels = numLevels();
+
+  coarse_matrices_.resize(static_cast<size_t>(num_levels - 1));
+  single_precision_matrices_.resize(static_cast<size_t>(single_precision_ ? num_levels - 1 : 0));
+  level_operators_.resize(static_cast<size_t>(num_levels - 1));
+  smoothers_.resize(static_cast<size_t>(num_levels - 1));
+  residuals_.resize(static_cast<size_t>(num_levels - 1));
+  corrections_.resize(static_cast<size_t>(num_levels - 1));
+  coarse_rhs_.resize(static_cast<size_t>(num_levels - 1));
+  coarse_solutions_.resize(static_cast<size_t>(num_levels - 1));
+
+  constexpr int chebyshev_order = 2;
+  for (int level = 0; level < num_levels - 1; level++) {
+    auto i = static_cast<size_t>(level);
+
+    coarse_matrices_[i].reset(mfem::RAP(&levelMatrix(level), prolongations_[i]));
+
+    level_operators_[i] = &levelMatrix(level);
+    if (single_precision_) {
+      single_precision_matrices_[i] = std::make_unique<SinglePrecisionParMatrix>(levelMatrix(level));
+      level_operators_[i]           = single_precision_matrices_[i].get();
+
+      // the Galerkin product of the next level was the last use of the double precision operator of this one
+      if (level > 0) {
+        coarse_matrices_[i - 1].reset();
       }
     }
 
-    // Note that MFEM passes ownership of this matrix to the caller
-    auto monolithic_mat = std::unique_ptr<mfem::HypreParMatrix>(mfem::HypreParMatrixFromBlocks(hypre_blocks));
+    smoothers_[i] = std::make_unique<ChebyshevSmoother>(chebyshev_order, comm_);
+    smoothers_[i]->SetOperator(*level_operators_[i]);
+
+    residuals_[i].SetSize(level_operators_[i]->Height());
+    corrections_[i].SetSize(level_operators_[i]->Height());
+    coarse_rhs_[i].SetSize(coarse_matrices_[i]->Height());
+    coarse_solutions_[i].SetSize(coarse_matrices_[i]->Height());
+  }
+
+  coarse_solver_ = std::make_unique<mfem::HypreBoomerAMG>();
+  coarse_solver_->SetPrintLevel(print_level_);
+  if (fine_space_->GetVDim() > 1) {
+    coarse_solver_->SetSystemsOptions(fine_space_->GetVDim(), fine_space_->GetOrdering() == mfem::Ordering::byNODES);
+  }
+  coarse_solver_->SetOperator(levelMatrix(num_levels - 1));
+}
+
+void GalerkinMultigridPreconditioner::Mult(const mfem::Vector& x, mfem::Vector& y) const
+{
+  SLIC_ERROR_ROOT_IF(!coarse_solver_, "Operator must be set prior to applying " + name_);
+
+  cycle(0, x, y);
+}
+
+void GalerkinMultigridPreconditioner::cycle(int level, const mfem::Vector& b, mfem::Vector& x) const
+{
+  if (level == numLevels() - 1) {
+    coarse_solver_->Mult(b, x);
+    return;
+  }
+
+  auto        i = static_cast<size_t>(level);
+  const auto& A = *level_operators_[i];
+  const auto& P = *prolongations_[i];
+
+  auto& r  = residuals_[i];
+  auto& e  = corrections_[i];
+  auto& bc = coarse_rhs_[i];
+  auto& xc = coarse_solutions_[i];
+
+  // pre-smoothing, from a zero initial guess
+  smoothers_[i]->Mult(b, x);
+
+  // coarse grid correction
+  A.Mult(x, r);
+  subtract(b, r, r);
+  P.MultTranspose(r, bc);
+  cycle(level + 1, bc, xc);
+  P.Mult(1.0, xc, 1.0, x);
+
+  // post-smoothing
+  A.Mult(x, r);
+  subtract(b, r, r);
+  smoothers_[i]->Mult(r, e);
+  x += e;
+}
+
+void LORPreconditioner::setFiniteElementSpace(mfem::ParFiniteElementSpace& fes, const mfem::Array<int>& essential_dofs)
+{
+  SLIC_ERROR_ROOT_IF(!dynamic_cast<const mfem::H1_FECollection*>(fes.FEColl()),
+                     "low-order-refined preconditioning requires an H1 finite element space");
+
+  fes_            = &fes;
+  essential_dofs_ = &essential_dofs;
+  lor_.reset();
+  amg_.reset();
+}
+
+void LORPreconditioner::buildLowOrderMatrix()
+{
+  const int vdim = fes_->GetVDim();
+  const int dim  = fes_->GetParMesh()->Dimension();
 
-    superlu_mat_ = std::make_unique<mfem::SuperLURowLocMatrix>(*monolithic_mat);
+  // the LOR discretization refers to the integrators of the high order form
+  lor_.reset();
+  high_order_form_ = std::make_unique<mfem::ParBilinearForm>(fes_);
+  if (vdim == 1) {
+    high_order_form_->AddDomainIntegrator(new mfem::DiffusionIntegrator(one_));
+  } else if (vdim == dim) {
+    high_order_form_->AddDomainIntegrator(new mfem::ElasticityIntegrator(one_, one_));
   } else {
-    // If this is not a block system, check that the input operator is a HypreParMatrix as expected
-    auto* matrix = dynamic_cast<const mfem::HypreParMatrix*>(&op);
+    high_order_form_->AddDomainIntegrator(new mfem::VectorDiffusionIntegrator(one_, vdim));
+  }
 
-    SLIC_ERROR_ROOT_IF(!matrix, "Matrix must be an assembled HypreParMatrix for use with SuperLU");
+  assembled_essential_dofs_ = *essential_dofs_;
+  lor_ = std::make_unique<mfem::ParLORDiscretization>(*high_order_form_, assembled_essential_dofs_);
 
-    superlu_mat_ = std::make_unique<mfem::SuperLURowLocMatrix>(*matrix);
+  const auto& L = lor_->GetAssembledMatrix();
+  lor_diagonal_.SetSize(L.Height());
+  L.AssembleDiagonal(lor_diagonal_);
+
+  amg_ = std::make_unique<mfem::HypreBoomerAMG>();
+  amg_->SetPrintLevel(print_level_);
+  if (vdim == dim && vdim > 1) {
+    amg_->SetElasticityOptions(&lor_->GetParFESpace());
+  } else if (vdim > 1) {
+    amg_->SetSystemsOptions(vdim, fes_->GetOrdering() == mfem::Ordering::byNODES);
   }
+  amg_->SetOperator(L);
+}
 
-  superlu_solver_.SetOperator(*superlu_mat_);
+void LORPreconditioner::SetOperator(const mfem::Operator& op)
+{
+  SLIC_ERROR_ROOT_IF(!fes_ || fes_->GetTrueVSize() != op.Height(),
+                     "The finite element space of the operator must be given to the LOR preconditioner before its "
+                     "operator");
+
+  height = op.Height();
+  width  = op.Width();
+
+  // the LOR matrix (and its AMG setup) only depends on the mesh and the constrained dofs
+  bool same_essential_dofs = lor_ && assembled_essential_dofs_.Size() == essential_dofs_->Size() &&
+                             std::equal(assembled_essential_dofs_.begin(), assembled_essential_dofs_.end(),
+                                        essential_dofs_->begin());
+  if (!same_essential_dofs) {
+    buildLowOrderMatrix();
+  }
+
+  mfem::Vector diagonal(height);
+  op.AssembleDiagonal(diagonal);
+
+  scaling_.SetSize(height);
+  const double* A = diagonal.HostRead();
+  const double* L = lor_diagonal_.HostRead();
+  double*       S = scaling_.HostWrite();
+  for (int i = 0; i < height; i++) {
+    S[i] = (A[i] > 0.0 && L[i] > 0.0) ? std::sqrt(A[i] / L[i]) : 1.0;
+  }
+
+  z_.SetSize(height);
+  w_.SetSize(height);
+}
+
+void LORPreconditioner::Mult(const mfem::Vector& x, mfem::Vector& y) const
+{
+  SLIC_ERROR_ROOT_IF(!amg_, "Operator must be set prior to applying the LOR preconditioner");
+
+  // y = S^{-1} AMG(L) S^{-1} x
+  z_ = x;
+  z_ /= scaling_;
+  amg_->Mult(z_, w_);
+  y = w_;
+  y /= scaling_;
+}
+
+void SeparateComponentPreconditioner::setFiniteElementSpace(const mfem::ParFiniteElementSpace& fes)
+{
+  components_ = fes.GetVDim();
+  by_nodes_   = fes.GetOrdering() == mfem::Ordering::byNODES;
+  amg_.reset();
+}
+
+void SeparateComponentPreconditioner::SetOperator(const mfem::Operator& op)
+{
+  SLIC_ERROR_ROOT_IF(components_ == 0,
+                     "The finite element space of the operator must be given to the separate-displacement-component "
+                     "preconditioner before its operator");
+  SLIC_ERROR_ROOT_IF(!matrix_ || matrix_->Height() != op.Height(),
+                     "The separate-displacement-component matrix of the operator must be given to the preconditioner "
+                     "before its operator");
+
+  height = op.Height();
+  width  = op.Width();
+
+  // the hierarchy is rebuilt for each matrix, so hypre's setup reuses nothing from the previous one
+  amg_ = std::make_unique<mfem::HypreBoomerAMG>();
+  amg_->SetPrintLevel(print_level_);
+  if (components_ > 1) {
+    amg_->SetSystemsOptions(components_, by_nodes_);
+
+    // the components are decoupled, so they are coarsened separately (the "unknown" approach), rather than with
+    // the nodal coarsening that the systems options enable for coupled components
+    HYPRE_BoomerAMGSetNodal(*amg_, 0);
+  }
+  amg_->SetOperator(*matrix_);
+}
+
+void SeparateComponentPreconditioner::Mult(const mfem::Vector& x, mfem::Vector& y) const
+{
+  SLIC_ERROR_ROOT_IF(!amg_, "Operator must be set prior to applying the separate-displacement-component "
+                            "preconditioner");
+  amg_->Mult(x, y);
 }
 
 std::unique_ptr<mfem::NewtonSolver> buildNonlinearSolver(NonlinearSolverOptions nonlinear_opts, MPI_Comm comm)
 {
   std::unique_ptr<mfem::NewtonSolver> nonlinear_solver;
 
+  const bool reuses_jacobian = nonlinear_opts.nonlin_solver == NonlinearSolver::Anderson ||
+                               nonlinear_opts.nonlin_solver == NonlinearSolver::JFNK;
+
+  SLIC_ERROR_ROOT_IF(nonlinear_opts.jacobian_reuse != JacobianReuse::Never &&
+                         nonlinear_opts.nonlin_solver != NonlinearSolver::Newton && !reuses_jacobian,
+                     "Jacobian reuse is only supported by the Newton, Anderson and JFNK nonlinear solvers");
+  SLIC_ERROR_ROOT_IF(nonlinear_opts.globalization != NonlinearGlobalization::None &&
+                         nonlinear_opts.nonlin_solver != NonlinearSolver::Newton &&
+                         nonlinear_opts.nonlin_solver != NonlinearSolver::JFNK,
+                     "Line search and trust region globalization are only supported by the Newton and JFNK "
+                     "nonlinear solvers");
+  SLIC_ERROR_ROOT_IF(nonlinear_opts.nonlin_solver == NonlinearSolver::Anderson && nonlinear_opts.anderson_depth < 1,
+                     "The Anderson nonlinear solver needs a depth of at least 1");
+  SLIC_ERROR_ROOT_IF(nonlinear_opts.nonlin_solver == NonlinearSolver::JFNK && nonlinear_opts.jfnk_max_iterations < 1,
+                     "The JFNK nonlinear solver needs a positive maximum number of Krylov iterations");
+
   if (nonlinear_opts.nonlin_solver == NonlinearSolver::Newton) {
-    nonlinear_solver = std::make_unique<mfem::NewtonSolver>(comm);
+    if (nonlinear_opts.jacobian_reuse == JacobianReuse::Never &&
+        nonlinear_opts.globalization == NonlinearGlobalization::None) {
+      nonlinear_solver = std::make_unique<mfem::NewtonSolver>(comm);
+    } else {
+      nonlinear_solver = std::make_unique<ModifiedNewtonSolver>(comm, nonlinear_opts);
+    }
+  } else if (reuses_jacobian) {
+    // both always reuse the Jacobian within a solve, which is what "Never" means for them
+    NonlinearSolverOptions reuse_opts = nonlinear_opts;
+    if (reuse_opts.jacobian_reuse == JacobianReuse::Never) {
+      reuse_opts.jacobian_reuse = JacobianReuse::WithinSolve;
+    }
+    nonlinear_solver = std::make_unique<ModifiedNewtonSolver>(comm, reuse_opts);
   } else if (nonlinear_opts.nonlin_solver == NonlinearSolver::LBFGS) {
     nonlinear_solver = std::make_unique<mfem::LBFGSSolver>(comm);
   }
@@ -142,6 +1785,13 @@ std::unique_ptr<mfem::NewtonSolver> buildNonlinearSolver(NonlinearSolverOptions
   nonlinear_solver->SetMaxIter(nonlinear_opts.max_iterations);
   nonlinear_solver->SetPrintLevel(nonlinear_opts.print_level);
 
+  if (nonlinear_opts.forcing_term != ForcingTerm::Fixed) {
+    SLIC_ERROR_ROOT_IF(nonlinear_opts.nonlin_solver != NonlinearSolver::Newton,
+                       "Eisenstat-Walker forcing terms are only supported by the Newton nonlinear solver");
+    const int type = (nonlinear_opts.forcing_term == ForcingTerm::EisenstatWalker1) ? 1 : 2;
+    nonlinear_solver->SetAdaptiveLinRtol(type, nonlinear_opts.forcing_term_initial, nonlinear_opts.forcing_term_max);
+  }
+
   // Iterative mode indicates we do not zero out the initial guess during the
   // nonlinear solver call. This is required as we apply the essential boundary
   // conditions before the nonlinear solver is applied.
@@ -164,6 +1814,14 @@ std::pair<std::unique_ptr<mfem::Solver>, std::unique_ptr<mfem::Solver>> buildLin
     case LinearSolver::CG:
       iter_lin_solver = std::make_unique<mfem::CGSolver>(comm);
       break;
+    case LinearSolver::DeflatedCG:
+      SLIC_ERROR_ROOT_IF(linear_opts.recycled_subspace_dimension < 0,
+                         "The recycled subspace dimension of deflated CG must not be negative");
+      iter_lin_solver = std::make_unique<DeflatedCGSolver>(comm, linear_opts.recycled_subspace_dimension);
+      break;
+    case LinearSolver::PipelinedCG:
+      iter_lin_solver = std::make_unique<PipelinedCGSolver>(comm);
+      break;
     case LinearSolver::GMRES:
       iter_lin_solver = std::make_unique<mfem::GMRESSolver>(comm);
       break;
@@ -177,7 +1835,9 @@ std::pair<std::unique_ptr<mfem::Solver>, std::unique_ptr<mfem::Solver>> buildLin
   iter_lin_solver->SetMaxIter(linear_opts.max_iterations);
   iter_lin_solver->SetPrintLevel(linear_opts.print_level);
 
-  auto preconditioner = buildPreconditioner(linear_opts.preconditioner, linear_opts.preconditioner_print_level, comm);
+  auto preconditioner = buildPreconditioner(linear_opts.preconditioner, linear_opts.preconditioner_print_level, comm,
+                                            linear_opts.preconditioner_rebuild_period, linear_opts.amgx_options,
+                                            linear_opts.single_precision_preconditioner);
 
   if (preconditioner) {
     iter_lin_solver->SetPreconditioner(*preconditioner);
@@ -189,7 +1849,9 @@ std::pair<std::unique_ptr<mfem::Solver>, std::unique_ptr<mfem::Solver>> buildLin
 #ifdef MFEM_USE_AMGX
 std::unique_ptr<mfem::AmgXSolver> buildAMGX(const AMGXOptions& options, const MPI_Comm comm)
 {
-  auto          amgx = std::make_unique<mfem::AmgXSolver>();
+  SLIC_ERROR_ROOT_IF(options.reuse_period < 1, "The AMGX reuse period must be at least 1");
+
+  auto          amgx = std::make_unique<ReusableAmgXSolver>(options.resetup, options.reuse_period);
   conduit::Node options_node;
   options_node["config_version"] = 2;
   auto& solver_options           = options_node["solver"];
@@ -201,6 +1863,12 @@ std::unique_ptr<mfem::AmgXSolver> buildAMGX(const AMGXOptions& options, const MP
   solver_options["convergence"]  = "ABSOLUTE";
   solver_options["cycle"]        = "V";
 
+  // on a coefficient-only update, AMGX recomputes the coarse operators on the aggregates and
+  // interpolation sparsity of every level of the last hierarchy, rather than coarsening again
+  if (options.resetup == AMGXResetup::CoefficientsOnly) {
+    solver_options["structure_reuse_levels"] = -1;
+  }
+
   if (options.verbose) {
     options_node["solver/obtain_timings"]    = 1;
     options_node["solver/monitor_residual"]  = 1;
@@ -242,13 +1910,27 @@ std::unique_ptr<mfem::AmgXSolver> buildAMGX(const AMGXOptions& options, const MP
 #endif
 
 std::unique_ptr<mfem::Solver> buildPreconditioner(Preconditioner preconditioner, int print_level,
-                                                  [[maybe_unused]] MPI_Comm comm)
+                                                  [[maybe_unused]] MPI_Comm comm, int rebuild_period,
+                                                  [[maybe_unused]] const AMGXOptions& amgx_options,
+                                                  bool                                single_precision)
 {
   std::unique_ptr<mfem::Solver> preconditioner_solver;
 
+  SLIC_ERROR_ROOT_IF(rebuild_period < 1, "The preconditioner rebuild period must be at least 1");
+  SLIC_ERROR_ROOT_IF(rebuild_period > 1 && preconditioner != Preconditioner::HypreAMG,
+                     "Reusing the preconditioner setup across operator updates is only supported for HypreAMG");
+  SLIC_ERROR_ROOT_IF(single_precision && preconditioner != Preconditioner::PMultigrid &&
+                         preconditioner != Preconditioner::GeometricMultigrid,
+                     "Single precision preconditioning is only supported for PMultigrid and GeometricMultigrid");
+
   // Handle the preconditioner - currently just BoomerAMG and HypreSmoother are supported
   if (preconditioner == Preconditioner::HypreAMG) {
-    auto amg_preconditioner = std::make_unique<mfem::HypreBoomerAMG>();
+    std::unique_ptr<mfem::HypreBoomerAMG> amg_preconditioner;
+    if (rebuild_period > 1) {
+      amg_preconditioner = std::make_unique<ReusableBoomerAMG>(rebuild_period);
+    } else {
+      amg_preconditioner = std::make_unique<mfem::HypreBoomerAMG>();
+    }
     amg_preconditioner->SetPrintLevel(print_level);
     preconditioner_solver = std::move(amg_preconditioner);
   } else if (preconditioner == Preconditioner::HypreJacobi) {
@@ -268,9 +1950,26 @@ std::unique_ptr<mfem::Solver> buildPreconditioner(Preconditioner preconditioner,
     ilu_preconditioner->SetLevelOfFill(1);
     ilu_preconditioner->SetPrintLevel(print_level);
     preconditioner_solver = std::move(ilu_preconditioner);
+  } else if (preconditioner == Preconditioner::Jacobi) {
+    preconditioner_solver = std::make_unique<mfem::OperatorJacobiSmoother>();
+  } else if (preconditioner == Preconditioner::Chebyshev) {
+    constexpr int chebyshev_order = 2;
+    preconditioner_solver         = std::make_unique<ChebyshevSmoother>(chebyshev_order, comm);
+  } else if (preconditioner == Preconditioner::PMultigrid) {
+    auto pmg = std::make_unique<PMultigridPreconditioner>(print_level, comm);
+    pmg->useSinglePrecision(single_precision);
+    preconditioner_solver = std::move(pmg);
+  } else if (preconditioner == Preconditioner::GeometricMultigrid) {
+    auto gmg = std::make_unique<GeometricMultigridPreconditioner>(print_level, comm);
+    gmg->useSinglePrecision(single_precision);
+    preconditioner_solver = std::move(gmg);
+  } else if (preconditioner == Preconditioner::LOR) {
+    preconditioner_solver = std::make_unique<LORPreconditioner>(print_level);
+  } else if (preconditioner == Preconditioner::SeparateComponentAMG) {
+    preconditioner_solver = std::make_unique<SeparateComponentPreconditioner>(print_level);
   } else if (preconditioner == Preconditioner::AMGX) {
 #ifdef MFEM_USE_AMGX
-    preconditioner_solver = buildAMGX(AMGXOptions{}, comm);
+    preconditioner_solver = buildAMGX(amgx_options, comm);
 #else
     SLIC_ERROR_ROOT("AMGX requested in non-GPU build");
 #endif
@@ -303,9 +2002,36 @@ void EquationSolver::defineInputFileSchema(axom::inlet::Container& container)
   iterative_container.addDouble("abs_tol", "Absolute tolerance for the linear solve.").defaultValue(1.0e-8);
   iterative_container.addInt("max_iter", "Maximum iterations for the linear solve.").defaultValue(5000);
   iterative_container.addInt("print_level", "Linear print level.").defaultValue(0);
-  iterative_container.addString("solver_type", "Solver type (gmres|minres|cg).").defaultValue("gmres");
-  iterative_container.addString("prec_type", "Preconditioner type (JacobiSmoother|L1JacobiSmoother|AMG|ILU).")
+  iterative_container.addString("solver_type", "Solver type (gmres|minres|cg|deflated_cg|pipelined_cg).")
+      .defaultValue("gmres");
+  iterative_container
+      .addString("prec_type",
+                 "Preconditioner type "
+                 "(JacobiSmoother|L1JacobiSmoother|AMG|ILU|Jacobi|Chebyshev|PMultigrid|GeometricMultigrid|LOR|"
+                 "SeparateComponentAMG).")
       .defaultValue("JacobiSmoother");
+  iterative_container.addBool("matrix_free", "Use the action of the Jacobian instead of an assembled matrix.")
+      .defaultValue(false);
+  iterative_container
+      .addInt("prec_rebuild_period", "Number of operator updates that reuse one AMG preconditioner setup.")
+      .defaultValue(1);
+  iterative_container
+      .addString("amgx_resetup", "How AMGX is updated for new operators (Full|CoefficientsOnly|ReuseHierarchy).")
+      .defaultValue("Full")
+      .validValues({"Full", "CoefficientsOnly", "ReuseHierarchy"});
+  iterative_container
+      .addInt("amgx_reuse_period", "Number of operator updates that reuse one AMGX setup, for ReuseHierarchy.")
+      .defaultValue(1);
+  iterative_container
+      .addInt("recycle_dim", "Number of previous solutions recycled as the deflation subspace of deflated CG.")
+      .defaultValue(4);
+  iterative_container
+      .addBool("prec_single_precision", "Use single precision operators in the PMultigrid|GeometricMultigrid levels.")
+      .defaultValue(false);
+  iterative_container
+      .addString("adjoint_prec", "How adjoint solves are preconditioned (Rebuild|ReuseForward|CachedTranspose).")
+      .defaultValue("ReuseForward")
+      .validValues({"Rebuild", "ReuseForward", "CachedTranspose"});
 
   auto& direct_container = linear_container.addStruct("direct_options", "Direct solver parameters");
   direct_container.addInt("print_level", "Linear print level.").defaultValue(0);
@@ -316,7 +2042,39 @@ void EquationSolver::defineInputFileSchema(axom::inlet::Container& container)
   nonlinear_container.addDouble("abs_tol", "Absolute tolerance for the Newton solve.").defaultValue(1.0e-4);
   nonlinear_container.addInt("max_iter", "Maximum iterations for the Newton solve.").defaultValue(500);
   nonlinear_container.addInt("print_level", "Nonlinear print level.").defaultValue(0);
-  nonlinear_container.addString("solver_type", "Solver type (Newton|KINFullStep|KINLineSearch)").defaultValue("Newton");
+  nonlinear_container.addString("solver_type", "Solver type (Newton|KINFullStep|KINLineSearch|KINPicard|Anderson|JFNK)")
+      .defaultValue("Newton");
+  nonlinear_container
+      .addString("jacobian_reuse", "When the Newton Jacobian is rebuilt (Never|WithinSolve|AcrossSolves)")
+      .defaultValue("Never")
+      .validValues({"Never", "WithinSolve", "AcrossSolves"});
+  nonlinear_container.addInt("jacobian_rebuild_period", "Rebuild a reused Jacobian after this many iterations.")
+      .defaultValue(0);
+  nonlinear_container
+      .addDouble("jacobian_stagnation_ratio", "Rebuild a reused Jacobian when ||r_{k+1}|| > ratio * ||r_k||.")
+      .defaultValue(0.5);
+  nonlinear_container
+      .addString("forcing_term", "Linear tolerance choice (Fixed|EisenstatWalker1|EisenstatWalker2).")
+      .defaultValue("Fixed")
+      .validValues({"Fixed", "EisenstatWalker1", "EisenstatWalker2"});
+  nonlinear_container.addDouble("forcing_term_initial", "Linear relative tolerance of the first Newton iteration.")
+      .defaultValue(0.5);
+  nonlinear_container.addDouble("forcing_term_max", "Upper bound for the adaptive linear relative tolerance.")
+      .defaultValue(0.9);
+  nonlinear_container
+      .addString("globalization", "Globalization of the Newton updates (None|Backtracking|TrustRegion).")
+      .defaultValue("None")
+      .validValues({"None", "Backtracking", "TrustRegion"});
+  nonlinear_container.addInt("line_search_max_iter", "Maximum shortened updates tried in each Newton iteration.")
+      .defaultValue(10);
+  nonlinear_container.addDouble("sufficient_decrease", "Fraction of the predicted residual decrease to achieve.")
+      .defaultValue(1.0e-4);
+  nonlinear_container.addInt("anderson_depth", "Number of previous iterates fitted by the Anderson solver.")
+      .defaultValue(5);
+  nonlinear_container.addDouble("jfnk_rel_tol", "Relative tolerance of the Krylov solves of the JFNK solver.")
+      .defaultValue(1.0e-4);
+  nonlinear_container.addInt("jfnk_max_iter", "Maximum iterations of the Krylov solves of the JFNK solver.")
+      .defaultValue(50);
 }
 
 }  // namespace serac
@@ -341,11 +2099,16 @@ serac::LinearSolverOptions FromInlet<serac::LinearSolverOptions>::operator()(con
   options.absolute_tol    = config["abs_tol"];
   options.max_iterations  = config["max_iter"];
   options.print_level     = config["print_level"];
+  options.matrix_free     = config["matrix_free"];
   std::string solver_type = config["solver_type"];
   if (solver_type == "gmres") {
     options.linear_solver = serac::LinearSolver::GMRES;
   } else if (solver_type == "cg") {
     options.linear_solver = serac::LinearSolver::CG;
+  } else if (solver_type == "deflated_cg") {
+    options.linear_solver = serac::LinearSolver::DeflatedCG;
+  } else if (solver_type == "pipelined_cg") {
+    options.linear_solver = serac::LinearSolver::PipelinedCG;
   } else {
     std::string msg = axom::fmt::format("Unknown Linear solver type given: '{0}'", solver_type);
     SLIC_ERROR_ROOT(msg);
@@ -365,11 +2128,46 @@ serac::LinearSolverOptions FromInlet<serac::LinearSolverOptions>::operator()(con
 #endif
   } else if (prec_type == "GaussSeidel") {
     options.preconditioner = serac::Preconditioner::HypreGaussSeidel;
+  } else if (prec_type == "Jacobi") {
+    options.preconditioner = serac::Preconditioner::Jacobi;
+  } else if (prec_type == "Chebyshev") {
+    options.preconditioner = serac::Preconditioner::Chebyshev;
+  } else if (prec_type == "PMultigrid") {
+    options.preconditioner = serac::Preconditioner::PMultigrid;
+  } else if (prec_type == "GeometricMultigrid") {
+    options.preconditioner = serac::Preconditioner::GeometricMultigrid;
+  } else if (prec_type == "LOR") {
+    options.preconditioner = serac::Preconditioner::LOR;
+  } else if (prec_type == "SeparateComponentAMG") {
+    options.preconditioner = serac::Preconditioner::SeparateComponentAMG;
   } else {
     std::string msg = axom::fmt::format("Unknown preconditioner type given: '{0}'", prec_type);
     SLIC_ERROR_ROOT(msg);
   }
 
+  options.preconditioner_rebuild_period   = config["prec_rebuild_period"];
+  options.recycled_subspace_dimension     = config["recycle_dim"];
+  options.single_precision_preconditioner = config["prec_single_precision"];
+
+  const std::string adjoint_prec = config["adjoint_prec"];
+  if (adjoint_prec == "Rebuild") {
+    options.adjoint_preconditioning = serac::AdjointPreconditioning::Rebuild;
+  } else if (adjoint_prec == "CachedTranspose") {
+    options.adjoint_preconditioning = serac::AdjointPreconditioning::CachedTranspose;
+  } else {
+    options.adjoint_preconditioning = serac::AdjointPreconditioning::ReuseForward;
+  }
+
+  const std::string amgx_resetup = config["amgx_resetup"];
+  if (amgx_resetup == "CoefficientsOnly") {
+    options.amgx_options.resetup = serac::AMGXResetup::CoefficientsOnly;
+  } else if (amgx_resetup == "ReuseHierarchy") {
+    options.amgx_options.resetup = serac::AMGXResetup::ReuseHierarchy;
+  } else {
+    options.amgx_options.resetup = serac::AMGXResetup::Full;
+  }
+  options.amgx_options.reuse_period = config["amgx_reuse_period"];
+
   return options;
 }
 
@@ -389,9 +2187,52 @@ serac::NonlinearSolverOptions FromInlet<serac::NonlinearSolverOptions>::operator
     options.nonlin_solver = serac::NonlinearSolver::KINBacktrackingLineSearch;
   } else if (solver_type == "KINPicard") {
     options.nonlin_solver = serac::NonlinearSolver::KINPicard;
+  } else if (solver_type == "Anderson") {
+    options.nonlin_solver = serac::NonlinearSolver::Anderson;
+  } else if (solver_type == "JFNK") {
+    options.nonlin_solver = serac::NonlinearSolver::JFNK;
   } else {
     SLIC_ERROR_ROOT(axom::fmt::format("Unknown nonlinear solver type given: '{0}'", solver_type));
   }
+  options.jacobian_rebuild_period   = base["jacobian_rebuild_period"];
+  options.jacobian_stagnation_ratio = base["jacobian_stagnation_ratio"];
+  const std::string jacobian_reuse  = base["jacobian_reuse"];
+  if (jacobian_reuse == "Never") {
+    options.jacobian_reuse = serac::JacobianReuse::Never;
+  } else if (jacobian_reuse == "WithinSolve") {
+    options.jacobian_reuse = serac::JacobianReuse::WithinSolve;
+  } else if (jacobian_reuse == "AcrossSolves") {
+    options.jacobian_reuse = serac::JacobianReuse::AcrossSolves;
+  } else {
+    SLIC_ERROR_ROOT(axom::fmt::format("Unknown Jacobian reuse policy given: '{0}'", jacobian_reuse));
+  }
+  const std::string globalization = base["globalization"];
+  if (globalization == "None") {
+    options.globalization = serac::NonlinearGlobalization::None;
+  } else if (globalization == "Backtracking") {
+    options.globalization = serac::NonlinearGlobalization::Backtracking;
+  } else if (globalization == "TrustRegion") {
+    options.globalization = serac::NonlinearGlobalization::TrustRegion;
+  } else {
+    SLIC_ERROR_ROOT(axom::fmt::format("Unknown globalization given: '{0}'", globalization));
+  }
+  options.max_line_search_iterations = base["line_search_max_iter"];
+  options.sufficient_decrease        = base["sufficient_decrease"];
+  options.anderson_depth         = base["anderson_depth"];
+  options.jfnk_relative_tol      = base["jfnk_rel_tol"];
+  options.jfnk_max_iterations    = base["jfnk_max_iter"];
+  options.forcing_term_initial   = base["forcing_term_initial"];
+  options.forcing_term_max       = base["forcing_term_max"];
+  const std::string forcing_term = base["forcing_term"];
+  if (forcing_term == "Fixed") {
+    options.forcing_term = serac::ForcingTerm::Fixed;
+  } else if (forcing_term == "EisenstatWalker1") {
+    options.forcing_term = serac::ForcingTerm::EisenstatWalker1;
+  } else if (forcing_term == "EisenstatWalker2") {
+    options.forcing_term = serac::ForcingTerm::EisenstatWalker2;
+  } else {
+    SLIC_ERROR_ROOT(axom::fmt::format("Unknown forcing term given: '{0}'", forcing_term));
+  }
   return options;
 }
 
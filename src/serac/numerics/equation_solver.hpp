@@ -13,16 +13,65 @@
 #pragma once
 
 #include <memory>
+#include <numeric>
 #include <optional>
+#include <string>
 #include <variant>
+#include <vector>
 
 #include "mfem.hpp"
 
 #include "serac/infrastructure/input.hpp"
+#include "serac/infrastructure/memory.hpp"
+#include "serac/numerics/fixed_point_acceleration.hpp"
 #include "serac/numerics/solver_config.hpp"
 
 namespace serac {
 
+/**
+ * @brief Performance telemetry of the solves of an EquationSolver, accumulated since the last
+ * EquationSolver::resetTelemetry(), e.g. for the summary of each timestep of a simulation
+ *
+ * The times are those of the calling rank, in seconds.
+ */
+struct SolveTelemetry {
+  /// The number of calls to EquationSolver::solve()
+  int solves = 0;
+
+  /// The number of nonlinear (e.g. Newton) iterations, one for each linear-mode solve
+  int nonlinear_iterations = 0;
+
+  /// The number of iterations of the (Krylov) linear solver in each nonlinear iteration, empty for direct solvers
+  std::vector<int> linear_iterations;
+
+  /// The norm of the residual before the first iteration of the first solve
+  double initial_residual_norm = 0.0;
+
+  /// The norm of the residual after the last iteration of the last solve
+  double final_residual_norm = 0.0;
+
+  /// The time spent evaluating the residual
+  double residual_time = 0.0;
+
+  /// The time spent evaluating the Jacobian, i.e. assembling it and applying the essential boundary conditions
+  double assembly_time = 0.0;
+
+  /// The time spent setting up the preconditioner of an iterative linear solver from the Jacobian
+  double preconditioner_setup_time = 0.0;
+
+  /// The rest of the time of the solves, mostly in the linear solves (and the factorizations of direct solvers)
+  double linear_solve_time = 0.0;
+
+  /// @brief The total number of linear iterations
+  int totalLinearIterations() const { return std::accumulate(linear_iterations.begin(), linear_iterations.end(), 0); }
+
+  /**
+   * @brief Adds the telemetry of another solver, e.g. of the other field of a coupled problem
+   * @note The residual norms are combined as the norm of the residual of both solvers together
+   */
+  SolveTelemetry& operator+=(const SolveTelemetry& other);
+};
+
 /**
  * @brief This class manages the objects typically required to solve a nonlinear set of equations arising from
  * discretization of a PDE of the form F(x) = 0. Specifically, it has
@@ -80,6 +129,39 @@ public:
    */
   void solve(mfem::Vector& x) const;
 
+  /**
+   * Declare whether F is affine, i.e. whether its Jacobian is constant
+   * @param[in] linear Whether each solve should be a single linear solve, x -= J^{-1} F(x)
+   * @note In linear mode the nonlinear solver is bypassed, and the Jacobian (along with the preconditioner or
+   * factorization built from it) is kept from one solve to the next until resetJacobian() is called
+   */
+  void setLinear(bool linear) { linear_ = linear; }
+
+  /**
+   * Whether each solve is a single linear solve with a constant Jacobian
+   * @see setLinear
+   */
+  bool linear() const { return linear_; }
+
+  /**
+   * Whether the last call to solve() converged
+   * @note In linear mode, this is the convergence of the iterative linear solver (direct solvers always converge)
+   */
+  bool converged() const;
+
+  /**
+   * Solves the transposed linear system J^T x = b with the linear solver, e.g. for an adjoint problem
+   * @param[in] J The (forward) matrix, with any essential boundary conditions already eliminated
+   * @param[in] b The right hand side
+   * @param[out] x The solution
+   * @note This does not form J^T when J is symmetric, or when the linear solver is SuperLU (which solves with the
+   * transpose of its factorization). For iterative solvers, the Krylov method uses the transposed action of J, and
+   * the transpose is only formed for preconditioners that are not built from the diagonal alone (e.g. AMG).
+   * Whether the preconditioner (or factorization) of the last forward solve is reused, rather than set up from J,
+   * is chosen by LinearSolverOptions::adjoint_preconditioning.
+   */
+  void solveTranspose(const mfem::HypreParMatrix& J, const mfem::Vector& b, mfem::Vector& x);
+
   /**
    * Returns the underlying solver object
    * @return A non-owning reference to the underlying nonlinear solver
@@ -114,12 +196,58 @@ public:
    */
   const mfem::Solver* preconditioner() const { return preconditioner_.get(); }
 
+  /**
+   * Whether the physics modules should pass the linear solver the action of the Jacobian
+   * instead of an assembled sparse matrix
+   * @see LinearSolverOptions::matrix_free
+   */
+  bool matrixFree() const { return matrix_free_; }
+
+  /**
+   * Whether the linear solver still holds a Jacobian that the reuse policy will keep for the next solve
+   * @see NonlinearSolverOptions::jacobian_reuse
+   * @note Physics modules can use this to skip assembling a Jacobian of their own (e.g. for a predictor step)
+   */
+  bool reusingJacobian() const;
+
+  /**
+   * The performance telemetry of the solves since the last call to resetTelemetry()
+   * @note The residual norms and the linear iterations of each nonlinear iteration are recorded through the
+   * monitor of the nonlinear solver, so they are no longer recorded if it is given another monitor
+   */
+  const SolveTelemetry& telemetry() const { return telemetry_; }
+
+  /**
+   * Start accumulating the telemetry of the next solves anew, e.g. at the beginning of a timestep
+   */
+  void resetTelemetry() const { telemetry_ = SolveTelemetry{}; }
+
+  /**
+   * Discard any Jacobian kept by the reuse policy (or by linear mode), so that the next Newton iteration
+   * (or linear solve) rebuilds it
+   * @note This must be called after the linear solver is given a different operator outside of the
+   * nonlinear solve, e.g. for an adjoint solve
+   */
+  void resetJacobian();
+
   /**
    * Input file parameters specific to this class
    **/
   static void defineInputFileSchema(axom::inlet::Container& container);
 
 private:
+  /**
+   * @brief Solve F(x) = 0 with a single linear solve, rebuilding the Jacobian only when it was discarded
+   * @param[in,out] x The initial guess on input, the solution on output
+   */
+  void solveLinear(mfem::Vector& x) const;
+
+  /**
+   * @brief Times the preconditioner and records the nonlinear iterations, for the telemetry
+   * @note This is called by the constructors, once the solvers are given
+   */
+  void initializeTelemetry();
+
   /**
    * @brief The optional preconditioner (used for an iterative solver only)
    */
@@ -141,6 +269,180 @@ private:
    * before SetSolver
    */
   bool nonlin_solver_set_solver_called_ = false;
+
+  /**
+   * @brief Whether the linear systems are solved with the action of the Jacobian, rather than an assembled matrix
+   */
+  bool matrix_free_ = false;
+
+  /// @brief The operator F of the system F(x) = 0
+  const mfem::Operator* operator_ = nullptr;
+
+  /// @brief Whether F is affine, so that each solve is a single linear solve with a constant Jacobian
+  bool linear_ = false;
+
+  /// @brief Whether the next linear-mode solve must rebuild the Jacobian
+  mutable bool rebuild_linear_jacobian_ = true;
+
+  /// @brief Whether the last linear-mode solve converged
+  mutable bool linear_converged_ = false;
+
+  /**
+   * @brief The relative tolerance the linear solver was configured with, when a forcing term adapts it during
+   * nonlinear solves (so that adjoint and other direct uses of the linear solver see the configured value)
+   */
+  std::optional<double> linear_relative_tol_;
+
+  /**
+   * @brief Whether the preconditioner of J also works for J^T, since it only depends on the diagonal
+   * (or, for Chebyshev, the spectrum) of the matrix
+   */
+  bool transpose_invariant_preconditioner_ = false;
+
+  /// @brief The transposed action of the matrix of the last transpose solve of an iterative linear solver
+  std::unique_ptr<mfem::TransposeOperator> transpose_operator_;
+
+  /// @brief The transposed matrix used to build the preconditioner of the last transpose solve, if one was required
+  std::unique_ptr<mfem::HypreParMatrix> transpose_matrix_;
+
+  /// @brief How the transpose solves are preconditioned
+  AdjointPreconditioning adjoint_preconditioning_ = AdjointPreconditioning::ReuseForward;
+
+  /**
+   * @brief For AdjointPreconditioning::CachedTranspose, the preconditioner of J^T, which is kept apart from the
+   * forward one so that neither needs to be set up again for the other
+   */
+  std::unique_ptr<mfem::Solver> transpose_preconditioner_;
+
+  /// @brief Whether transpose_preconditioner_ was set up since the last forward solve
+  mutable bool transpose_preconditioner_current_ = false;
+
+  /// @brief The tolerances of the iterative refinement of transpose solves with a reused SuperLU factorization
+  double refinement_relative_tol_ = LinearSolverOptions{}.relative_tol;
+  double refinement_absolute_tol_ = LinearSolverOptions{}.absolute_tol;  ///< @see refinement_relative_tol_
+
+  /// @brief The telemetry of the solves since the last resetTelemetry()
+  mutable SolveTelemetry telemetry_;
+
+  /// @brief The operator F, which the nonlinear solver is given so that its evaluations are timed
+  std::unique_ptr<mfem::Operator> timed_operator_;
+
+  /// @brief The preconditioner, which the iterative linear solver is given so that its setups are timed
+  std::unique_ptr<mfem::Solver> timed_preconditioner_;
+
+  /// @brief The monitor of the nonlinear solver, which records the residual norm and linear iterations
+  std::unique_ptr<mfem::IterativeSolverMonitor> telemetry_monitor_;
+};
+
+/**
+ * @brief A Newton solver that rebuilds the Jacobian (and thereby the preconditioner) only when the reuse policy
+ * requires it, i.e. a modified Newton method
+ *
+ * Iterations that reuse the Jacobian do not call GetGradient on the operator, so no assembly, boundary condition
+ * elimination or preconditioner setup happens in the physics modules for those iterations.
+ *
+ * For problems with expensive Jacobians, the solves with the reused Jacobian can also drive two more robust
+ * iterations (see NonlinearSolver):
+ *  - Anderson: the modified Newton updates are the fixed-point iteration x <- x - J_0^{-1} F(x), which Anderson
+ *    acceleration combines with the previous ones to converge far faster than modified Newton alone.
+ *  - JFNK: each update is a Krylov (flexible GMRES) solve with the current Jacobian, whose action is the
+ *    finite-difference derivative of F (so it is never assembled), preconditioned with the solve with J_0.
+ *
+ * The Newton and JFNK updates can be globalized with a line search or a trust region (see NonlinearGlobalization),
+ * in which case this solver is also used for full Newton, so that a bad update is shortened with a few residual
+ * evaluations instead of failing the solve.
+ */
+class ModifiedNewtonSolver : public mfem::NewtonSolver {
+public:
+  /**
+   * @brief Constructs a modified Newton solver
+   * @param[in] comm The MPI communicator used by the vectors in the solve
+   * @param[in] nonlinear_opts The options containing the Jacobian reuse policy
+   */
+  ModifiedNewtonSolver(MPI_Comm comm, const NonlinearSolverOptions& nonlinear_opts);
+
+  /**
+   * @brief Solve F(x) = b
+   *
+   * @param b The right hand side, or an empty vector for b = 0
+   * @param x The initial guess on input, the solution on output
+   */
+  void Mult(const mfem::Vector& b, mfem::Vector& x) const override;
+
+  /**
+   * @brief Set the nonlinear operator, discarding any Jacobian kept from a previous operator
+   *
+   * @param op The nonlinear operator
+   */
+  void SetOperator(const mfem::Operator& op) override;
+
+  /// @brief Whether the Jacobian currently held by the linear solver will be used by the next solve
+  bool reusingJacobian() const;
+
+  /// @brief Discard the Jacobian held by the linear solver, so that the next iteration rebuilds it
+  void resetJacobian() { rebuild_jacobian_ = true; }
+
+  /// @brief The number of times the Jacobian has been rebuilt
+  int numJacobianRebuilds() const { return num_rebuilds_; }
+
+private:
+  /**
+   * @brief Take the (shortened) update -step * c from x, as chosen by the globalization
+   *
+   * Only the residual is evaluated at the trial points. Each evaluation overwrites that of the previous one (e.g. the
+   * tentative quadrature data of the physics modules), so the last one is that of the accepted point.
+   *
+   * @param b The right hand side, or an empty vector for b = 0
+   * @param x The current iterate, replaced by the accepted one
+   * @param norm The residual norm of the current iterate
+   * @return Whether an update was accepted, in which case r holds the residual of the new iterate
+   */
+  bool globalizedUpdate(const mfem::Vector& b, mfem::Vector& x, double norm) const;
+
+  /// @brief The policy for keeping the Jacobian between iterations and solves
+  JacobianReuse reuse_;
+
+  /// @brief The maximum number of iterations a Jacobian is reused for (0 means no limit)
+  int rebuild_period_;
+
+  /// @brief The residual reduction ratio above which the Jacobian is rebuilt
+  double stagnation_ratio_;
+
+  /// @brief Whether the next iteration must rebuild the Jacobian
+  mutable bool rebuild_jacobian_ = true;
+
+  /// @brief The number of iterations that have used the current Jacobian
+  mutable int iterations_since_rebuild_ = 0;
+
+  /// @brief The number of times the Jacobian has been rebuilt
+  mutable int num_rebuilds_ = 0;
+
+  /// @brief The nonlinear solver, Newton, Anderson or JFNK
+  NonlinearSolver method_;
+
+  /// @brief The Anderson acceleration of the modified Newton updates
+  mutable std::optional<FixedPointAccelerator> accelerator_;
+
+  /// @brief The relative tolerance of the Jacobian-free Krylov solves
+  double jfnk_relative_tol_;
+
+  /// @brief The maximum number of iterations of the Jacobian-free Krylov solves
+  int jfnk_max_iterations_;
+
+  /// @brief The globalization of the updates
+  NonlinearGlobalization globalization_;
+
+  /// @brief The maximum number of shortened updates tried in each iteration
+  int max_line_search_iterations_;
+
+  /// @brief The fraction of the predicted decrease of the residual norm an update must achieve
+  double sufficient_decrease_;
+
+  /// @brief The radius of the trust region, or 0 before the first update of a solve
+  mutable double trust_radius_ = 0.0;
+
+  /// @brief The trial iterate of the globalization
+  mutable mfem::Vector trial_x_;
 };
 
 /**
@@ -153,7 +455,7 @@ public:
    * @param[in] comm The MPI communicator used by the vectors and matrices in the solve
    * @param[in] print_level The verbosity level for the mfem::SuperLUSolver
    */
-  SuperLUSolver(int print_level, MPI_Comm comm) : superlu_solver_(comm)
+  SuperLUSolver(int print_level, MPI_Comm comm) : comm_(comm), superlu_solver_(comm)
   {
     superlu_solver_.SetColumnPermutation(mfem::superlu::PARMETIS);
     if (print_level == 0) {
@@ -169,15 +471,77 @@ public:
    */
   void Mult(const mfem::Vector& x, mfem::Vector& y) const;
 
+  /**
+   * @brief Solve the transposed linear system y = Op^{-T} x, using the same factorization as Mult
+   *
+   * @param x The input RHS vector
+   * @param y The output solution vector
+   */
+  void MultTranspose(const mfem::Vector& x, mfem::Vector& y) const;
+
   /**
    * @brief Set the underlying matrix operator to use in the solution algorithm
    *
    * @param op The matrix operator to factorize with SuperLU
    * @pre This operator must be an assembled HypreParMatrix for compatibility with SuperLU
+   * @note When the sparsity pattern (of every block) matches the previous operator, the column permutation
+   * and elimination tree are reused, so only the numeric factorization is redone
    */
   void SetOperator(const mfem::Operator& op);
 
+  /// @brief The size of the factored matrix, or 0 before the first factorization
+  int factorizationSize() const { return superlu_mat_ ? superlu_mat_->Height() : 0; }
+
 private:
+  /**
+   * @brief The rank-local sparsity pattern of a HypreParMatrix, used to detect
+   * when a new operator has the same structure as the previous one
+   */
+  struct SparsityPattern {
+    /// @brief Record the sparsity pattern of a matrix
+    SparsityPattern(const mfem::HypreParMatrix& matrix);
+
+    /// @brief Whether a matrix has this sparsity pattern on this rank
+    bool matches(const mfem::HypreParMatrix& matrix) const;
+
+    /// @brief The CSR row offsets and column indices of the diagonal and off-diagonal parts
+    std::vector<int> diag_I, diag_J, offd_I, offd_J;
+
+    /// @brief The global column indices of the off-diagonal part
+    std::vector<HYPRE_BigInt> col_map_offd;
+  };
+
+  /**
+   * @brief Build the monolithic matrix of a block system, along with the location in
+   * the blocks that each of its entries is copied from
+   *
+   * @param blocks The blocks of the system, in row-major order
+   * @param row_blocks The number of block rows (and columns)
+   */
+  void buildMonolithicMatrix(const std::vector<const mfem::HypreParMatrix*>& blocks, int row_blocks);
+
+  /**
+   * @brief Copy the values of the blocks into the monolithic matrix
+   *
+   * @param blocks The blocks of the system, in row-major order, with the same sparsity as when it was built
+   */
+  void updateMonolithicMatrix(const std::vector<const mfem::HypreParMatrix*>& blocks);
+
+  /// @brief The MPI communicator used by the vectors and matrices in the solve
+  MPI_Comm comm_;
+
+  /// @brief The sparsity patterns of the blocks (or the matrix) that the current factorization structure is for
+  std::vector<SparsityPattern> patterns_;
+
+  /// @brief For block systems, the monolithic matrix that is factored, reused while the block sparsity is unchanged
+  std::unique_ptr<mfem::HypreParMatrix> monolithic_mat_;
+
+  /**
+   * @brief For each entry of the monolithic matrix (diagonal part, then off-diagonal part), the
+   * block it is copied from and the index of the entry within that block (with the same ordering)
+   */
+  std::vector<int> monolithic_source_block_, monolithic_source_entry_;
+
   /**
    * @brief The owner of the SuperLU matrix for the gradient, stored
    * as a member variable for lifetime purposes
@@ -192,6 +556,668 @@ private:
   mfem::SuperLUSolver superlu_solver_;
 };
 
+/**
+ * @brief A copy of an assembled HypreParMatrix whose values (and halo exchanges) are stored in single precision
+ *
+ * The matrix-vector products read half the bytes per nonzero of the original matrix, and accumulate in double
+ * precision. The rounding of the values makes this unsuitable for the operator of a solve, but not for the
+ * operators of a preconditioner, whose accuracy is only that of the approximate inverse it applies.
+ */
+class SinglePrecisionParMatrix : public mfem::Operator {
+public:
+  /**
+   * @brief Copy (and round) the values of a matrix
+   * @param[in] A The matrix to copy, which is not referenced afterwards
+   */
+  explicit SinglePrecisionParMatrix(const mfem::HypreParMatrix& A);
+
+  /**
+   * @brief y := A x
+   *
+   * @param x The input vector
+   * @param y The output vector
+   */
+  void Mult(const mfem::Vector& x, mfem::Vector& y) const override;
+
+  /**
+   * @brief The diagonal of the matrix
+   *
+   * @param diag The output vector
+   */
+  void AssembleDiagonal(mfem::Vector& diag) const override;
+
+private:
+  /// @brief A rank-local block of the matrix in CSR format, with single precision values
+  struct LocalBlock {
+    /// @brief The offsets of the rows
+    std::vector<int> row_ptr;
+
+    /// @brief The column of each value
+    std::vector<int> col_ind;
+
+    /// @brief The values
+    std::vector<float> values;
+  };
+
+  /// @brief Copy an mfem::SparseMatrix into a LocalBlock
+  static LocalBlock copyBlock(const mfem::SparseMatrix& block);
+
+  /// @brief The communicator of the matrix
+  MPI_Comm comm_;
+
+  /// @brief The columns owned by this rank
+  LocalBlock diag_;
+
+  /// @brief The columns owned by other ranks, numbered in the order of the halo received from them
+  LocalBlock offd_;
+
+  /// @brief The ranks that this rank sends entries of the input vector to, and that it receives the halo from
+  std::vector<int> send_ranks_, recv_ranks_;
+
+  /// @brief The offsets of the entries sent to each rank in send_indices_, and received from each rank in the halo
+  std::vector<int> send_offsets_, recv_offsets_;
+
+  /// @brief The local indices of the entries of the input vector sent to the other ranks
+  std::vector<int> send_indices_;
+
+  /// @brief Buffers for the halo exchange
+  mutable std::vector<float> send_buffer_, halo_;
+
+  /// @brief The accounting of the memory of the values and buffers
+  memory::Tracker tracker_{memory::Subsystem::Matrices};
+};
+
+/**
+ * @brief A wrapper over mfem::OperatorChebyshevSmoother that can be (re)configured through SetOperator,
+ * using only the action and the diagonal of the operator (i.e. no assembled matrix is required)
+ */
+class ChebyshevSmoother : public mfem::Solver {
+public:
+  /**
+   * @brief Constructs a Chebyshev smoother of a given polynomial order
+   * @param[in] order The order of the Chebyshev polynomial
+   * @param[in] comm The MPI communicator used by the vectors in the solve
+   */
+  ChebyshevSmoother(int order, MPI_Comm comm) : order_(order), comm_(comm) {}
+
+  /**
+   * @brief Apply the smoother, y = P(Op) x
+   *
+   * @param x The input vector
+   * @param y The output vector
+   */
+  void Mult(const mfem::Vector& x, mfem::Vector& y) const;
+
+  /**
+   * @brief Set the operator to smooth, and estimate its spectral radius
+   *
+   * @param op The operator, which must implement AssembleDiagonal()
+   * @note essential boundary conditions are expected to be built into @a op (e.g. with an mfem::ConstrainedOperator)
+   */
+  void SetOperator(const mfem::Operator& op);
+
+private:
+  /// @brief The order of the Chebyshev polynomial
+  int order_;
+
+  /// @brief The MPI communicator used for the spectral radius estimate
+  MPI_Comm comm_;
+
+  /// @brief The diagonal of the operator
+  mfem::Vector diagonal_;
+
+  /// @brief An empty list of constrained dofs, since those are handled by the operator itself
+  mfem::Array<int> no_essential_dofs_;
+
+  /// @brief The underlying MFEM Chebyshev smoother, rebuilt every time the operator changes
+  std::unique_ptr<mfem::OperatorChebyshevSmoother> smoother_;
+};
+
+/**
+ * @brief A BoomerAMG preconditioner that keeps its setup (coarsening, interpolation and coarse operators)
+ * across several operator updates, instead of redoing it for every new operator
+ *
+ * Between rebuilds, the preconditioner is the AMG hierarchy of an earlier operator. Since only the action of
+ * the preconditioner is affected, the Krylov solver still converges to the solution of the current system.
+ */
+class ReusableBoomerAMG : public mfem::HypreBoomerAMG {
+public:
+  /**
+   * @brief Constructs an AMG preconditioner that is set up again only every @a rebuild_period operator updates
+   * @param[in] rebuild_period The number of operator updates that reuse one AMG setup
+   */
+  ReusableBoomerAMG(int rebuild_period) : rebuild_period_(rebuild_period) {}
+
+  /**
+   * @brief Update the operator, only setting up the AMG hierarchy again when the rebuild period has elapsed
+   *
+   * @param op The new operator, which must be an assembled HypreParMatrix
+   */
+  void SetOperator(const mfem::Operator& op) override;
+
+  /// @brief The number of times the AMG hierarchy has been set up
+  int numSetups() const { return num_setups_; }
+
+private:
+  /// @brief The number of operator updates that reuse one AMG setup
+  int rebuild_period_;
+
+  /// @brief The number of operator updates since the last AMG setup
+  int updates_since_setup_ = 0;
+
+  /// @brief The number of times the AMG hierarchy has been set up
+  int num_setups_ = 0;
+
+  /**
+   * @brief A copy of the matrix the current AMG hierarchy was built from, since hypre keeps a reference
+   * to it and the caller's matrix may be modified or deleted before the next rebuild
+   */
+  std::unique_ptr<mfem::HypreParMatrix> setup_matrix_;
+};
+
+#ifdef MFEM_USE_AMGX
+/**
+ * @brief An AMGX preconditioner that follows a policy for updating its setup when the operator changes
+ * (see AMGXResetup), e.g. to only replace the coefficients of the uploaded matrix across Newton iterations
+ */
+class ReusableAmgXSolver : public mfem::AmgXSolver {
+public:
+  /**
+   * @brief Constructs an AMGX preconditioner, which still needs its parameters and GPU initialization (see buildAMGX)
+   * @param[in] resetup How the setup is updated for a new operator
+   * @param[in] reuse_period For AMGXResetup::ReuseHierarchy, the number of operator updates that use one setup
+   */
+  ReusableAmgXSolver(AMGXResetup resetup, int reuse_period) : resetup_(resetup), reuse_period_(reuse_period) {}
+
+  /**
+   * @brief Update the operator according to the resetup policy
+   *
+   * @param op The new operator, which must be an assembled HypreParMatrix
+   */
+  void SetOperator(const mfem::Operator& op) override;
+
+  /// @brief The number of times the matrix was uploaded and the AMG hierarchy set up from scratch
+  int numSetups() const { return num_setups_; }
+
+  /// @brief The number of times only the coefficients of the matrix were replaced
+  int numCoefficientUpdates() const { return num_coefficient_updates_; }
+
+private:
+  /// @brief How the setup is updated for a new operator
+  AMGXResetup resetup_;
+
+  /// @brief For AMGXResetup::ReuseHierarchy, the number of operator updates that use one setup
+  int reuse_period_;
+
+  /// @brief The number of operator updates since the last full setup
+  int updates_since_setup_ = 0;
+
+  /// @brief The number of full setups
+  int num_setups_ = 0;
+
+  /// @brief The number of coefficient-only updates
+  int num_coefficient_updates_ = 0;
+
+  /// @brief The local number of rows and nonzeros of the matrix of the last full setup
+  std::pair<int, int> setup_structure_ = {-1, -1};
+};
+#endif
+
+/**
+ * @brief A preconditioned conjugate gradient solver deflated by a subspace recycled across calls to Mult
+ *
+ * The recycled subspace W is spanned by the solutions of the last few solves, which are good approximations of
+ * the following solutions when the operator and right hand side change slowly (e.g. Newton iterations and
+ * timesteps). Each solve starts from the Galerkin projection of the solution onto W, and the CG search directions
+ * are kept A-orthogonal to W, so the iterations only resolve what W does not already capture.
+ */
+class DeflatedCGSolver : public mfem::IterativeSolver {
+public:
+  /**
+   * @brief Constructs a deflated CG solver
+   * @param[in] comm The MPI communicator used by the vectors in the solve
+   * @param[in] recycled_dimension The maximum number of vectors kept in the recycled subspace
+   */
+  DeflatedCGSolver(MPI_Comm comm, int recycled_dimension)
+      : mfem::IterativeSolver(comm), recycled_dimension_(recycled_dimension)
+  {
+  }
+
+  /**
+   * @brief Solve the linear system A x = b, and add the solution to the recycled subspace
+   *
+   * @param b The right hand side
+   * @param x The solution, also the initial guess if iterative_mode is set
+   */
+  void Mult(const mfem::Vector& b, mfem::Vector& x) const override;
+
+  /**
+   * @brief Set the operator, which must be symmetric positive definite
+   *
+   * @note The recycled subspace is kept, since it is meant to be reused across changes of the operator
+   */
+  void SetOperator(const mfem::Operator& op) override;
+
+  /// @brief Clear the recycled subspace, e.g. when the following systems are unrelated to the previous ones
+  void clearRecycledSubspace() { recycled_.clear(); }
+
+  /// @brief The current number of vectors in the recycled subspace
+  int recycledDimension() const { return static_cast<int>(recycled_.size()); }
+
+private:
+  /**
+   * @brief A-orthonormalize the recycled vectors into W, dropping those that are (numerically) in the span of others
+   */
+  void buildDeflationBasis() const;
+
+  /**
+   * @brief Remove the A-projection onto W from a vector, v -= W (AW)^T z
+   *
+   * @param z The vector whose component is removed
+   * @param v The vector to update
+   */
+  void deflate(const mfem::Vector& z, mfem::Vector& v) const;
+
+  /// @brief The maximum number of vectors kept in the recycled subspace
+  int recycled_dimension_;
+
+  /// @brief The solutions of the most recent solves, from the oldest to the newest
+  mutable std::vector<mfem::Vector> recycled_;
+
+  /// @brief The A-orthonormal basis W of the recycled subspace for the current operator
+  mutable std::vector<mfem::Vector> W_;
+
+  /// @brief The action of the operator on the basis, A W
+  mutable std::vector<mfem::Vector> AW_;
+
+  /// @brief Work vectors for the residual, preconditioned residual, search direction and its image
+  mutable mfem::Vector r_, z_, p_, q_;
+};
+
+/**
+ * @brief The pipelined preconditioned conjugate gradient method of Ghysels and Vanroose
+ *
+ * Mathematically equivalent to preconditioned CG, but the inner products of each iteration are combined into a
+ * single nonblocking reduction, which is overlapped with the preconditioner application and the operator action.
+ * This hides the global synchronizations that dominate CG at large rank counts, for a few extra vector updates.
+ */
+class PipelinedCGSolver : public mfem::IterativeSolver {
+public:
+  /**
+   * @brief Constructs a pipelined CG solver
+   * @param[in] comm The MPI communicator used by the vectors in the solve
+   */
+  PipelinedCGSolver(MPI_Comm comm) : mfem::IterativeSolver(comm) {}
+
+  /**
+   * @brief Solve the linear system A x = b
+   *
+   * @param b The right hand side
+   * @param x The solution, also the initial guess if iterative_mode is set
+   */
+  void Mult(const mfem::Vector& b, mfem::Vector& x) const override;
+
+  /**
+   * @brief Set the operator, which must be symmetric positive definite
+   */
+  void SetOperator(const mfem::Operator& op) override;
+
+private:
+  /// @brief Apply the preconditioner (or the identity, without one), y = M x
+  void precondition(const mfem::Vector& x, mfem::Vector& y) const;
+
+  /// @brief Work vectors of the recurrences, named as in Ghysels and Vanroose (2014)
+  mutable mfem::Vector r_, u_, w_, m_, n_, z_, q_, s_, p_;
+};
+
+/**
+ * @brief A multigrid V-cycle over a hierarchy of nested finite element spaces, whose coarse operators are the
+ * Galerkin products P^T A P of the finer ones
+ *
+ * Every level but the coarsest is smoothed with Chebyshev polynomials of its operator, using only its action and
+ * diagonal, and the coarsest level is solved approximately with BoomerAMG. The derived classes build the coarse
+ * spaces of the hierarchy (see addCoarseSpace).
+ */
+class GalerkinMultigridPreconditioner : public mfem::Solver {
+public:
+  /**
+   * @brief Apply one V-cycle, y = M^{-1} x
+   *
+   * @param x The input vector
+   * @param y The output vector
+   */
+  void Mult(const mfem::Vector& x, mfem::Vector& y) const;
+
+  /**
+   * @brief Set the fine operator, and build the coarse operators, smoothers and AMG solver from it
+   *
+   * @param op The fine operator, which must be an assembled HypreParMatrix
+   */
+  void SetOperator(const mfem::Operator& op);
+
+  /// @brief The number of levels in the hierarchy, including the fine level
+  int numLevels() const { return static_cast<int>(coarse_spaces_.size()) + 1; }
+
+  /**
+   * @brief Store and apply the operators of the smoothed levels in single precision (see SinglePrecisionParMatrix),
+   * from the next call to SetOperator on
+   *
+   * Only the operator of the coarsest level is kept in double precision, for BoomerAMG.
+   *
+   * @param single_precision Whether to use single precision operators
+   */
+  void useSinglePrecision(bool single_precision) { single_precision_ = single_precision; }
+
+protected:
+  /**
+   * @brief Constructs an empty hierarchy
+   * @param[in] print_level The print level of the BoomerAMG solver on the coarsest level
+   * @param[in] comm The MPI communicator used by the vectors in the solve
+   * @param[in] name The name of the method, for error messages
+   */
+  GalerkinMultigridPreconditioner(int print_level, MPI_Comm comm, std::string name)
+      : print_level_(print_level), comm_(comm), name_(std::move(name))
+  {
+  }
+
+  /**
+   * @brief Start a new hierarchy from the fine space
+   *
+   * @param fes The (fine) space of the operators given to SetOperator
+   */
+  void setFineSpace(mfem::ParFiniteElementSpace& fes);
+
+  /**
+   * @brief Add a level below the coarsest one, and the interpolation from it to the coarsest one
+   *
+   * @param space The space of the new level, which must be nested in the space of the (current) coarsest one
+   */
+  void addCoarseSpace(std::unique_ptr<mfem::ParFiniteElementSpace> space);
+
+private:
+  /**
+   * @brief Apply the V-cycle from a given level down, starting from a zero initial guess
+   *
+   * @param level The level index, where 0 is the fine level
+   * @param b The right hand side on this level
+   * @param x The approximate solution on this level
+   */
+  void cycle(int level, const mfem::Vector& b, mfem::Vector& x) const;
+
+  /// @brief The operator of a given level
+  const mfem::HypreParMatrix& levelMatrix(int level) const
+  {
+    return level == 0 ? *fine_matrix_ : *coarse_matrices_[static_cast<size_t>(level - 1)];
+  }
+
+  /// @brief The print level of the BoomerAMG solver on the coarsest level
+  int print_level_;
+
+  /// @brief The MPI communicator used by the Chebyshev smoothers
+  MPI_Comm comm_;
+
+  /// @brief The name of the method, for error messages
+  std::string name_;
+
+  /// @brief Whether the operators of the smoothed levels are stored in single precision
+  bool single_precision_ = false;
+
+  /// @brief The fine space, set by setFineSpace
+  mfem::ParFiniteElementSpace* fine_space_ = nullptr;
+
+  /// @brief The spaces of the coarse levels, from the finest coarse level to the coarsest
+  std::vector<std::unique_ptr<mfem::ParFiniteElementSpace>> coarse_spaces_;
+
+  /// @brief The interpolations between consecutive levels, which own the assembled prolongation matrices
+  std::vector<std::unique_ptr<mfem::InterpolationGridTransfer>> transfers_;
+
+  /// @brief The prolongation from level i + 1 to level i, in true dofs
+  std::vector<const mfem::HypreParMatrix*> prolongations_;
+
+  /// @brief The fine operator
+  const mfem::HypreParMatrix* fine_matrix_ = nullptr;
+
+  /// @brief The Galerkin operators P^T A P of the coarse levels
+  std::vector<std::unique_ptr<mfem::HypreParMatrix>> coarse_matrices_;
+
+  /// @brief The single precision copies of the operators of every level but the coarsest, if used
+  std::vector<std::unique_ptr<SinglePrecisionParMatrix>> single_precision_matrices_;
+
+  /// @brief The operators applied by the smoothers and residuals of every level but the coarsest
+  std::vector<const mfem::Operator*> level_operators_;
+
+  /// @brief The Chebyshev smoothers of every level but the coarsest
+  std::vector<std::unique_ptr<ChebyshevSmoother>> smoothers_;
+
+  /// @brief The BoomerAMG solver of the coarsest level
+  std::unique_ptr<mfem::HypreBoomerAMG> coarse_solver_;
+
+  /// @brief Work vectors of each level, for the residual and the correction of the smoother
+  mutable std::vector<mfem::Vector> residuals_, corrections_;
+
+  /// @brief Work vectors of each coarse level, for the restricted residual and the coarse correction
+  mutable std::vector<mfem::Vector> coarse_rhs_, coarse_solutions_;
+};
+
+/**
+ * @brief A p-multigrid V-cycle over a hierarchy of H1 spaces of orders p, p/2, ..., 1 on the same mesh
+ *
+ * The levels above p = 1 are smoothed with Chebyshev polynomials of their (Galerkin) operators, using only their
+ * action and diagonal, and the p = 1 level is solved approximately with BoomerAMG. This avoids the expensive
+ * AMG setup on high order matrices, whose stencils are much denser than those of the p = 1 problem.
+ */
+class PMultigridPreconditioner : public GalerkinMultigridPreconditioner {
+public:
+  /**
+   * @brief Constructs a p-multigrid preconditioner
+   * @param[in] print_level The print level of the BoomerAMG solver on the p = 1 level
+   * @param[in] comm The MPI communicator used by the vectors in the solve
+   */
+  PMultigridPreconditioner(int print_level, MPI_Comm comm)
+      : GalerkinMultigridPreconditioner(print_level, comm, "p-multigrid")
+  {
+  }
+
+  /**
+   * @brief Build the coarse spaces and the transfer operators between them
+   *
+   * @param fes The (fine) H1 space of the operators given to SetOperator
+   * @note This must be called before SetOperator
+   */
+  void setFiniteElementSpace(mfem::ParFiniteElementSpace& fes);
+
+private:
+  /// @brief The H1 collections of the coarse levels, from the finest coarse level to p = 1
+  std::vector<std::unique_ptr<mfem::FiniteElementCollection>> coarse_collections_;
+};
+
+/**
+ * @brief A geometric multigrid V-cycle over the meshes of successive uniform refinements (see the coarse meshes of
+ * mesh::refineAndDistribute), with the same finite element collection on every mesh
+ *
+ * The levels above the coarsest mesh are smoothed with Chebyshev polynomials of their (Galerkin) operators, using
+ * only their action and diagonal, and the coarsest mesh is solved approximately with BoomerAMG. Both the setup and
+ * the memory of the hierarchy are much smaller than those of BoomerAMG on the fine mesh, whose coarsening and
+ * interpolation are replaced by the refinements (and the interpolations between the meshes) themselves.
+ */
+class GeometricMultigridPreconditioner : public GalerkinMultigridPreconditioner {
+public:
+  /**
+   * @brief Constructs a geometric multigrid preconditioner
+   * @param[in] print_level The print level of the BoomerAMG solver on the coarsest mesh
+   * @param[in] comm The MPI communicator used by the vectors in the solve
+   */
+  GeometricMultigridPreconditioner(int print_level, MPI_Comm comm)
+      : GalerkinMultigridPreconditioner(print_level, comm, "geometric multigrid")
+  {
+  }
+
+  /**
+   * @brief Build the coarse spaces and the transfer operators between them
+   *
+   * @param fes The (fine) space of the operators given to SetOperator
+   * @param coarse_meshes The coarse meshes of the refinements that produced the mesh of @a fes, from the coarsest
+   * to the finest, where each mesh (and the mesh of @a fes) is the uniform refinement of the one before it
+   * @note This must be called before SetOperator, and the coarse meshes must outlive the preconditioner
+   */
+  void setFiniteElementSpace(mfem::ParFiniteElementSpace& fes, const std::vector<mfem::ParMesh*>& coarse_meshes);
+};
+
+/**
+ * @brief A preconditioner for high order H1 spaces, built from the spectrally equivalent low-order-refined (LOR)
+ * discretization: the p = 1 space on the mesh whose vertices are the nodes of the high order space
+ *
+ * Only the (much sparser) LOR matrix is assembled and set up with BoomerAMG, so the high order operator can stay
+ * matrix-free. The LOR matrix is that of a unit Laplacian (or, for vector spaces with a component per dimension, a
+ * unit-modulus elasticity operator) on the reference mesh, which is symmetrically scaled to the diagonal of the
+ * operator given to SetOperator, i.e. the preconditioner is M^{-1} = S^{-1} AMG(L) S^{-1} with
+ * S = sqrt(diag(A) / diag(L)). This captures the distribution of the material properties (e.g. the conductivity or
+ * stiffness of each element) and the time step, without reassembling the LOR matrix or redoing the AMG setup for
+ * each operator.
+ */
+class LORPreconditioner : public mfem::Solver {
+public:
+  /**
+   * @brief Constructs a low-order-refined preconditioner
+   * @param[in] print_level The print level of the BoomerAMG solver of the LOR matrix
+   */
+  explicit LORPreconditioner(int print_level) : print_level_(print_level) {}
+
+  /**
+   * @brief Set the high order space of the operators given to SetOperator
+   *
+   * @param fes The (high order) H1 space
+   * @param essential_dofs The constrained true dofs of the operators, which are read again (and the LOR matrix
+   * rebuilt if they changed) by every SetOperator, so they must outlive the preconditioner
+   * @note This must be called before SetOperator
+   */
+  void setFiniteElementSpace(mfem::ParFiniteElementSpace& fes, const mfem::Array<int>& essential_dofs);
+
+  /**
+   * @brief Apply the preconditioner, y = M^{-1} x
+   *
+   * @param x The input vector
+   * @param y The output vector
+   */
+  void Mult(const mfem::Vector& x, mfem::Vector& y) const;
+
+  /**
+   * @brief Set the high order operator, and scale the LOR matrix to its diagonal
+   *
+   * @param op The high order operator, which must implement AssembleDiagonal() (e.g. a matrix-free Functional
+   * gradient, in an mfem::ConstrainedOperator)
+   */
+  void SetOperator(const mfem::Operator& op);
+
+  /// @brief The assembled LOR matrix, with the rows and columns of the essential dofs eliminated
+  const mfem::HypreParMatrix& lowOrderMatrix() const { return lor_->GetAssembledMatrix(); }
+
+private:
+  /// @brief Assemble the LOR matrix for the current essential dofs, and set up BoomerAMG with it
+  void buildLowOrderMatrix();
+
+  /// @brief The print level of the BoomerAMG solver
+  int print_level_;
+
+  /// @brief The high order space, set by setFiniteElementSpace
+  mfem::ParFiniteElementSpace* fes_ = nullptr;
+
+  /// @brief The constrained true dofs of the operators, set by setFiniteElementSpace
+  const mfem::Array<int>* essential_dofs_ = nullptr;
+
+  /// @brief The constrained true dofs the current LOR matrix was assembled with
+  mfem::Array<int> assembled_essential_dofs_;
+
+  /// @brief The (never assembled) high order form whose integrators the LOR discretization assembles
+  std::unique_ptr<mfem::ParBilinearForm> high_order_form_;
+
+  /// @brief The unit coefficient of the integrators
+  mfem::ConstantCoefficient one_{1.0};
+
+  /// @brief The LOR discretization, which owns the LOR space and matrix
+  std::unique_ptr<mfem::ParLORDiscretization> lor_;
+
+  /// @brief The BoomerAMG solver of the LOR matrix
+  std::unique_ptr<mfem::HypreBoomerAMG> amg_;
+
+  /// @brief The diagonal of the LOR matrix
+  mfem::Vector lor_diagonal_;
+
+  /// @brief The symmetric scaling S of the LOR matrix
+  mfem::Vector scaling_;
+
+  /// @brief Work vectors for the scaled input and output of BoomerAMG
+  mutable mfem::Vector z_, w_;
+};
+
+/**
+ * @brief BoomerAMG on the "separate displacement component" (SDC) approximation of a vector-valued operator: the
+ * block diagonal matrix with only the couplings between the same components (see
+ * Functional::Gradient::assemble_component_blocks())
+ *
+ * The SDC matrix is assembled by the physics module and given to setMatrix() before each SetOperator, which sets up
+ * BoomerAMG with it (with the systems options, coarsening each component separately) rather than with the operator
+ * of the linear solver. So the operator can be the full Jacobian, assembled or matrix-free, while the matrix and the
+ * AMG hierarchy of the preconditioner are those of vdim decoupled scalar problems.
+ */
+class SeparateComponentPreconditioner : public mfem::Solver {
+public:
+  /**
+   * @brief Constructs a separate-displacement-component preconditioner
+   * @param[in] print_level The print level of the BoomerAMG solver of the SDC matrix
+   */
+  explicit SeparateComponentPreconditioner(int print_level) : print_level_(print_level) {}
+
+  /**
+   * @brief Set the (vector-valued) space of the operators given to SetOperator
+   *
+   * @param fes The space, whose components are coarsened separately
+   * @note This must be called before SetOperator
+   */
+  void setFiniteElementSpace(const mfem::ParFiniteElementSpace& fes);
+
+  /**
+   * @brief Set the SDC matrix of the next operator given to SetOperator
+   *
+   * @param matrix The matrix, with the essential rows and columns eliminated
+   */
+  void setMatrix(std::unique_ptr<mfem::HypreParMatrix> matrix) { matrix_ = std::move(matrix); }
+
+  /**
+   * @brief Apply the preconditioner, y = AMG(A_SDC) x
+   *
+   * @param x The input vector
+   * @param y The output vector
+   */
+  void Mult(const mfem::Vector& x, mfem::Vector& y) const;
+
+  /**
+   * @brief Set up BoomerAMG with the SDC matrix given to setMatrix()
+   *
+   * @param op The operator of the linear solver, which only provides the sizes
+   */
+  void SetOperator(const mfem::Operator& op);
+
+  /// @brief The SDC matrix the preconditioner was last set up with
+  const mfem::HypreParMatrix& matrix() const { return *matrix_; }
+
+private:
+  /// @brief The print level of the BoomerAMG solver
+  int print_level_;
+
+  /// @brief The number of components of the space, set by setFiniteElementSpace
+  int components_ = 0;
+
+  /// @brief Whether the components of the space are ordered by nodes, set by setFiniteElementSpace
+  bool by_nodes_ = true;
+
+  /// @brief The SDC matrix of the current operator
+  std::unique_ptr<mfem::HypreParMatrix> matrix_;
+
+  /// @brief The BoomerAMG solver of the SDC matrix
+  std::unique_ptr<mfem::HypreBoomerAMG> amg_;
+};
+
 /**
  * @brief Build a nonlinear solver using the nonlinear option struct
  *
@@ -218,10 +1244,16 @@ std::pair<std::unique_ptr<mfem::Solver>, std::unique_ptr<mfem::Solver>> buildLin
  * @param preconditioner The preconditioner type to be built
  * @param print_level The print level for the constructed preconditioner
  * @param comm The communicator for the underlying operator and HypreParVectors
+ * @param rebuild_period For HypreAMG, the number of operator updates that reuse one AMG setup
+ * @param amgx_options For AMGX, its configuration
+ * @param single_precision For PMultigrid and GeometricMultigrid, whether to use single precision level operators
  * @return A constructed preconditioner based on the input option
  */
 std::unique_ptr<mfem::Solver> buildPreconditioner(Preconditioner preconditioner, int print_level = 0,
-                                                  [[maybe_unused]] MPI_Comm comm = MPI_COMM_WORLD);
+                                                  [[maybe_unused]] MPI_Comm comm                   = MPI_COMM_WORLD,
+                                                  int                       rebuild_period         = 1,
+                                                  [[maybe_unused]] const AMGXOptions& amgx_options = {},
+                                                  bool                                single_precision = false);
 
 #ifdef MFEM_USE_AMGX
 /**
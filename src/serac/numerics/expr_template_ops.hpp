@@ -12,6 +12,9 @@
 
 #pragma once
 
+#include <cmath>
+#include <type_traits>
+
 #include "serac/numerics/expr_template_impl.hpp"
 
 /**
@@ -200,3 +203,85 @@ inline auto operator*(const mfem::Operator& A, const mfem::Vector& v)
 {
   return serac::detail::OperatorExpr<mfem::Vector>(A, v);
 }
+
+namespace serac {
+
+namespace detail {
+
+/// @brief the operands of the fused reductions, i.e., vector expressions or (non-expression) mfem vectors
+template <typename T>
+inline constexpr bool is_reduction_operand_v =
+    std::is_base_of_v<mfem::Vector, T> || std::is_base_of_v<VectorExpr<T>, T>;
+
+/**
+ * @brief Sums f(i) over the entries of this rank, then over the ranks of a communicator
+ * @param n The number of entries on this rank
+ * @param f The summand, evaluated once for each entry
+ * @param comm The communicator that the vectors are distributed over
+ */
+template <typename summand>
+double sum_over_entries(int n, summand f, MPI_Comm comm)
+{
+  double local = 0.0;
+  SERAC_OMP_PARALLEL_FOR_REDUCTION_IF(+ : local, n >= parallel_evaluation_threshold)
+  for (int i = 0; i < n; i++) {
+    local += f(i);
+  }
+
+  double global = 0.0;
+  MPI_Allreduce(&local, &global, 1, MPI_DOUBLE, MPI_SUM, comm);
+  return global;
+}
+
+}  // namespace detail
+
+/**
+ * @brief The global dot product of two distributed vectors, which may be unevaluated expressions
+ * @param comm The communicator that the vectors are distributed over
+ * @param a The first vector
+ * @param b The second vector
+ *
+ * @note the operands are evaluated entry by entry inside the reduction, so no temporary vectors are allocated
+ * and only a single MPI_Allreduce is performed
+ */
+template <typename S, typename T,
+          typename = std::enable_if_t<detail::is_reduction_operand_v<S> && detail::is_reduction_operand_v<T>>>
+double dot(MPI_Comm comm, const S& a, const T& b)
+{
+  SLIC_ERROR_IF(a.Size() != b.Size(), "Vector sizes in dot product must be equal");
+  return detail::sum_over_entries(
+      a.Size(), [&](int i) { return detail::index(a, i) * detail::index(b, i); }, comm);
+}
+
+/**
+ * @brief The global l2 norm of a distributed vector, which may be an unevaluated expression
+ * @param comm The communicator that the vector is distributed over
+ * @param v The vector
+ * @see dot
+ */
+template <typename T, typename = std::enable_if_t<detail::is_reduction_operand_v<T>>>
+double norm2(MPI_Comm comm, const T& v)
+{
+  return std::sqrt(detail::sum_over_entries(
+      v.Size(),
+      [&](int i) {
+        double v_i = detail::index(v, i);
+        return v_i * v_i;
+      },
+      comm));
+}
+
+/**
+ * @brief The global l1 norm of a distributed vector, which may be an unevaluated expression
+ * @param comm The communicator that the vector is distributed over
+ * @param v The vector
+ * @see dot
+ */
+template <typename T, typename = std::enable_if_t<detail::is_reduction_operand_v<T>>>
+double l1(MPI_Comm comm, const T& v)
+{
+  return detail::sum_over_entries(
+      v.Size(), [&](int i) { return std::abs(detail::index(v, i)); }, comm);
+}
+
+}  // namespace serac
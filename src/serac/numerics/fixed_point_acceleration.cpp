@@ -0,0 +1,122 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/numerics/fixed_point_acceleration.hpp"
+
+#include <algorithm>
+
+#include "serac/infrastructure/logger.hpp"
+
+namespace serac {
+
+FixedPointAccelerator::FixedPointAccelerator(MPI_Comm comm, const FixedPointAccelerationOptions& options)
+    : comm_(comm), options_(options), aitken_relaxation_(options.relaxation)
+{
+  SLIC_ERROR_ROOT_IF(options.relaxation <= 0.0, "Fixed-point iterations need a positive relaxation factor");
+  SLIC_ERROR_ROOT_IF(options.method == FixedPointAcceleration::Anderson && options.depth < 1,
+                     "Anderson acceleration needs a depth of at least 1");
+}
+
+void FixedPointAccelerator::reset()
+{
+  iterations_        = 0;
+  aitken_relaxation_ = options_.relaxation;
+  dx_.clear();
+  dr_.clear();
+}
+
+void FixedPointAccelerator::update(mfem::Vector& x, const mfem::Vector& g)
+{
+  mfem::Vector residual(g);
+  residual -= x;
+
+  switch (options_.method) {
+    case FixedPointAcceleration::Relaxation:
+      x.Add(options_.relaxation, residual);
+      break;
+
+    case FixedPointAcceleration::Aitken:
+      if (iterations_ > 0) {
+        // w_k = -w_{k-1} r_{k-1} . (r_k - r_{k-1}) / |r_k - r_{k-1}|^2
+        mfem::Vector dr(residual);
+        dr -= previous_residual_;
+        double dots[2] = {mfem::InnerProduct(dr, previous_residual_), mfem::InnerProduct(dr, dr)};
+        MPI_Allreduce(MPI_IN_PLACE, dots, 2, MPI_DOUBLE, MPI_SUM, comm_);
+        if (dots[1] > 0.0) {
+          aitken_relaxation_ = -aitken_relaxation_ * dots[0] / dots[1];
+        }
+      }
+      previous_residual_ = residual;
+      x.Add(aitken_relaxation_, residual);
+      break;
+
+    case FixedPointAcceleration::Anderson: {
+      if (iterations_ > 0) {
+        if (static_cast<int>(dx_.size()) == options_.depth) {
+          dx_.erase(dx_.begin());
+          dr_.erase(dr_.begin());
+        }
+        dx_.emplace_back(x);
+        dx_.back() -= previous_x_;
+        dr_.emplace_back(residual);
+        dr_.back() -= previous_residual_;
+      }
+      previous_x_        = x;
+      previous_residual_ = residual;
+
+      // the coefficients gamma minimizing |r - sum_j gamma_j dr_j|, from the normal equations (with all of the
+      // inner products reduced at once)
+      int                 m = static_cast<int>(dr_.size());
+      std::vector<double> dots(static_cast<size_t>(m * (m + 1)));
+      for (int i = 0; i < m; i++) {
+        dots[static_cast<size_t>(i * (m + 1) + m)] = mfem::InnerProduct(dr_[static_cast<size_t>(i)], residual);
+        for (int j = 0; j < m; j++) {
+          dots[static_cast<size_t>(i * (m + 1) + j)] =
+              mfem::InnerProduct(dr_[static_cast<size_t>(i)], dr_[static_cast<size_t>(j)]);
+        }
+      }
+      MPI_Allreduce(MPI_IN_PLACE, dots.data(), m * (m + 1), MPI_DOUBLE, MPI_SUM, comm_);
+
+      x.Add(options_.relaxation, residual);
+      if (m > 0) {
+        mfem::DenseMatrix A(m);
+        mfem::Vector      b(m);
+        double            max_diagonal = 0.0;
+        for (int i = 0; i < m; i++) {
+          for (int j = 0; j < m; j++) {
+            A(i, j) = dots[static_cast<size_t>(i * (m + 1) + j)];
+          }
+          b(i)         = dots[static_cast<size_t>(i * (m + 1) + m)];
+          max_diagonal = std::max(max_diagonal, A(i, i));
+        }
+
+        // a little regularization, as the differences of the residuals become nearly dependent near convergence
+        for (int i = 0; i < m; i++) {
+          A(i, i) += 1.0e-12 * max_diagonal;
+        }
+
+        mfem::Vector gamma(m);
+        if (max_diagonal > 0.0) {
+          A.Invert();
+          A.Mult(b, gamma);
+        } else {
+          gamma = 0.0;
+        }
+
+        // x <- x + beta r - sum_j gamma_j (dx_j + beta dr_j)
+        for (int j = 0; j < m; j++) {
+          x.Add(-gamma(j), dx_[static_cast<size_t>(j)]);
+          x.Add(-gamma(j) * options_.relaxation, dr_[static_cast<size_t>(j)]);
+        }
+      }
+      break;
+    }
+  }
+
+  iterations_++;
+}
+
+}  // namespace serac
@@ -0,0 +1,98 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file fixed_point_acceleration.hpp
+ *
+ * @brief Relaxation and acceleration of fixed-point iterations, e.g. of partitioned multiphysics couplings
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "mpi.h"
+#include "mfem.hpp"
+
+namespace serac {
+
+/// The methods for choosing the next iterate of a fixed-point iteration x = G(x)
+enum class FixedPointAcceleration
+{
+  Relaxation, /**< Constant under-relaxation, x <- x + w (G(x) - x) */
+  Aitken,     /**< Under-relaxation with a dynamic (Aitken) factor, from the last two residuals */
+  Anderson    /**< Anderson acceleration, from a least squares fit to the last few residuals */
+};
+
+/// The options of a FixedPointAccelerator
+struct FixedPointAccelerationOptions {
+  /// The method
+  FixedPointAcceleration method = FixedPointAcceleration::Aitken;
+
+  /// The relaxation factor, which is only that of the first iteration for Aitken's method
+  double relaxation = 0.5;
+
+  /// The number of previous iterates Anderson acceleration fits the residual with
+  int depth = 5;
+};
+
+/**
+ * @brief Picks the iterates of a fixed-point iteration x = G(x) from the residuals G(x) - x of the previous ones
+ *
+ * Anderson acceleration picks the next iterate from the combination of the previous ones that minimizes the
+ * (linearized) residual, which is equivalent to GMRES for linear G, with far fewer iterations than (relaxed)
+ * Picard iteration for slowly converging ones.
+ */
+class FixedPointAccelerator {
+public:
+  /**
+   * @brief Construct an accelerator
+   *
+   * @param[in] comm The communicator the iterates are distributed over
+   * @param[in] options The method and its parameters
+   */
+  FixedPointAccelerator(MPI_Comm comm, const FixedPointAccelerationOptions& options);
+
+  /**
+   * @brief Forget the previous iterates, to start a new fixed-point iteration
+   */
+  void reset();
+
+  /**
+   * @brief Compute the next iterate
+   *
+   * @param[inout] x The current iterate, replaced by the next one
+   * @param[in] g The image G(x) of the current iterate
+   */
+  void update(mfem::Vector& x, const mfem::Vector& g);
+
+private:
+  /// The communicator the iterates are distributed over
+  MPI_Comm comm_;
+
+  /// The method and its parameters
+  FixedPointAccelerationOptions options_;
+
+  /// The number of updates since the last reset()
+  int iterations_ = 0;
+
+  /// The current Aitken relaxation factor
+  double aitken_relaxation_;
+
+  /// The previous iterate
+  mfem::Vector previous_x_;
+
+  /// The residual of the previous iterate
+  mfem::Vector previous_residual_;
+
+  /// The differences between consecutive iterates kept by Anderson acceleration, oldest first
+  std::vector<mfem::Vector> dx_;
+
+  /// The differences between the residuals of consecutive iterates kept by Anderson acceleration, oldest first
+  std::vector<mfem::Vector> dr_;
+};
+
+}  // namespace serac
@@ -0,0 +1,173 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/numerics/functional/block_sparse_matrix.hpp"
+
+#include "serac/infrastructure/logger.hpp"
+
+namespace serac {
+
+BlockSparseMatrix::BlockSparseMatrix(std::shared_ptr<const BlockSparsityPattern> pattern, int test_components,
+                                     int trial_components, mfem::Ordering::Type test_ordering,
+                                     mfem::Ordering::Type trial_ordering)
+    : mfem::Operator(pattern->num_rows * test_components, pattern->num_columns * trial_components),
+      pattern_(pattern),
+      test_components_(test_components),
+      trial_components_(trial_components),
+      test_ordering_(test_ordering),
+      trial_ordering_(trial_ordering),
+      values_(std::size_t(pattern->NumBlocks() * test_components * trial_components), 0.0)
+{
+  tracker_.set(sizeof(double) * values_.size());
+}
+
+void BlockSparseMatrix::Mult(const mfem::Vector& x, mfem::Vector& y) const
+{
+  SLIC_ERROR_IF(x.Size() != Width(), "BlockSparseMatrix::Mult(): x has the wrong size");
+  y.SetSize(Height());
+
+  const double* X       = x.HostRead();
+  double*       Y       = y.HostWrite();
+  const int     ct      = test_components_;
+  const int     cr      = trial_components_;
+  const auto&   row_ptr = pattern_->row_ptr;
+  const auto&   col_ind = pattern_->col_ind;
+
+  for (int row = 0; row < pattern_->num_rows; row++) {
+    for (int i = 0; i < ct; i++) {
+      Y[test_index(row, i)] = 0.0;
+    }
+
+    for (int k = row_ptr[std::size_t(row)]; k < row_ptr[std::size_t(row) + 1]; k++) {
+      const int     col   = col_ind[std::size_t(k)];
+      const double* block = values_.data() + std::size_t(k) * std::size_t(ct * cr);
+      for (int i = 0; i < ct; i++) {
+        double sum = 0.0;
+        for (int j = 0; j < cr; j++) {
+          sum += block[i * cr + j] * X[trial_index(col, j)];
+        }
+        Y[test_index(row, i)] += sum;
+      }
+    }
+  }
+}
+
+void BlockSparseMatrix::MultTranspose(const mfem::Vector& x, mfem::Vector& y) const
+{
+  SLIC_ERROR_IF(x.Size() != Height(), "BlockSparseMatrix::MultTranspose(): x has the wrong size");
+  y.SetSize(Width());
+
+  const double* X       = x.HostRead();
+  double*       Y       = y.HostWrite();
+  const int     ct      = test_components_;
+  const int     cr      = trial_components_;
+  const auto&   row_ptr = pattern_->row_ptr;
+  const auto&   col_ind = pattern_->col_ind;
+
+  for (int i = 0; i < Width(); i++) {
+    Y[i] = 0.0;
+  }
+
+  for (int row = 0; row < pattern_->num_rows; row++) {
+    for (int k = row_ptr[std::size_t(row)]; k < row_ptr[std::size_t(row) + 1]; k++) {
+      const int     col   = col_ind[std::size_t(k)];
+      const double* block = values_.data() + std::size_t(k) * std::size_t(ct * cr);
+      for (int i = 0; i < ct; i++) {
+        double x_i = X[test_index(row, i)];
+        for (int j = 0; j < cr; j++) {
+          Y[trial_index(col, j)] += block[i * cr + j] * x_i;
+        }
+      }
+    }
+  }
+}
+
+std::unique_ptr<mfem::SparseMatrix> BlockSparseMatrix::ToSparseMatrix() const
+{
+  auto        A       = std::make_unique<mfem::SparseMatrix>(Height(), Width());
+  const int   ct      = test_components_;
+  const int   cr      = trial_components_;
+  const auto& row_ptr = pattern_->row_ptr;
+  const auto& col_ind = pattern_->col_ind;
+  for (int row = 0; row < pattern_->num_rows; row++) {
+    for (int k = row_ptr[std::size_t(row)]; k < row_ptr[std::size_t(row) + 1]; k++) {
+      const int     col   = col_ind[std::size_t(k)];
+      const double* block = values_.data() + std::size_t(k) * std::size_t(ct * cr);
+      for (int i = 0; i < ct; i++) {
+        for (int j = 0; j < cr; j++) {
+          A->Set(test_index(row, i), trial_index(col, j), block[i * cr + j]);
+        }
+      }
+    }
+  }
+  A->Finalize();
+  return A;
+}
+
+ParBlockSparseMatrix::ParBlockSparseMatrix(std::unique_ptr<BlockSparseMatrix> local, const mfem::Operator& P_test,
+                                           const mfem::Operator& P_trial, const mfem::Array<int>& constrained_dofs,
+                                           bool square)
+    : mfem::Operator(P_test.Width(), P_trial.Width()),
+      local_(std::move(local)),
+      P_test_(P_test),
+      P_trial_(P_trial),
+      constrained_dofs_(constrained_dofs),
+      square_(square),
+      x_L_(P_trial.Height()),
+      y_L_(P_test.Height())
+{
+  SLIC_ERROR_IF(local_->Height() != P_test.Height() || local_->Width() != P_trial.Height(),
+                "the block sparse matrix doesn't match the prolongations of its spaces");
+}
+
+void ParBlockSparseMatrix::Mult(const mfem::Vector& x, mfem::Vector& y) const
+{
+  const mfem::Vector* input = &x;
+  if (square_ && constrained_dofs_.Size() > 0) {
+    x_ = x;
+    x_.SetSubVector(constrained_dofs_, 0.0);
+    input = &x_;
+  }
+
+  P_trial_.Mult(*input, x_L_);
+  local_->Mult(x_L_, y_L_);
+  y.SetSize(Height());
+  P_test_.MultTranspose(y_L_, y);
+
+  if (constrained_dofs_.Size() > 0) {
+    if (square_) {
+      const double* X = x.HostRead();
+      double*       Y = y.HostReadWrite();
+      for (int dof : constrained_dofs_) {
+        Y[dof] = X[dof];
+      }
+    } else {
+      y.SetSubVector(constrained_dofs_, 0.0);
+    }
+  }
+}
+
+void ParBlockSparseMatrix::MultTranspose(const mfem::Vector& x, mfem::Vector& y) const
+{
+  // the constrained rows (columns of the transpose) don't contribute
+  x_ = x;
+  x_.SetSubVector(constrained_dofs_, 0.0);
+
+  P_test_.Mult(x_, y_L_);
+  local_->MultTranspose(y_L_, x_L_);
+  y.SetSize(Width());
+  P_trial_.MultTranspose(x_L_, y);
+
+  if (square_ && constrained_dofs_.Size() > 0) {
+    const double* X = x.HostRead();
+    double*       Y = y.HostReadWrite();
+    for (int dof : constrained_dofs_) {
+      Y[dof] = X[dof];
+    }
+  }
+}
+
+}  // namespace serac
@@ -0,0 +1,184 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file block_sparse_matrix.hpp
+ *
+ * @brief Block compressed sparse row (BSR) matrices, for the gradients of vector-valued fields
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "mfem.hpp"
+
+#include "serac/infrastructure/memory.hpp"
+
+namespace serac {
+
+/**
+ * @brief the sparsity pattern of a block sparse matrix: which (block row, block column) pairs have a nonzero block
+ */
+struct BlockSparsityPattern {
+  /// @brief the number of block rows
+  int num_rows = 0;
+
+  /// @brief the number of block columns
+  int num_columns = 0;
+
+  /// @brief the offsets of the blocks of each block row, i.e. block row r has the blocks [row_ptr[r], row_ptr[r+1])
+  std::vector<int> row_ptr;
+
+  /// @brief the (sorted) block column of each nonzero block
+  std::vector<int> col_ind;
+
+  /// @brief the number of nonzero blocks
+  int NumBlocks() const { return row_ptr.empty() ? 0 : row_ptr.back(); }
+};
+
+/**
+ * @brief a rank-local sparse matrix of dense blocks, with a block row for each node of the test space and a block
+ * column for each node of the trial space, each block coupling all of the components of the two nodes
+ *
+ * Compared to a scalar CSR matrix of the same values, this stores one column index per block rather than one per
+ * value (e.g. 9 times fewer for the displacement field of a 3D solid), and applies each block to contiguous
+ * values, which reduces the memory traffic of the matrix-vector product.
+ *
+ * The matrix acts on "L-vectors", whose layout (mfem::Ordering) is given by the finite element spaces.
+ */
+class BlockSparseMatrix : public mfem::Operator {
+public:
+  /**
+   * @brief create a matrix (with zero values) with the given sparsity pattern
+   *
+   * @param pattern the sparsity pattern, which can be shared with other matrices
+   * @param test_components the number of components of the test space, i.e. rows of each block
+   * @param trial_components the number of components of the trial space, i.e. columns of each block
+   * @param test_ordering the layout of the components of the test space's L-vectors
+   * @param trial_ordering the layout of the components of the trial space's L-vectors
+   */
+  BlockSparseMatrix(std::shared_ptr<const BlockSparsityPattern> pattern, int test_components, int trial_components,
+                    mfem::Ordering::Type test_ordering, mfem::Ordering::Type trial_ordering);
+
+  /// @brief y := A x
+  void Mult(const mfem::Vector& x, mfem::Vector& y) const override;
+
+  /// @brief y := A^T x
+  void MultTranspose(const mfem::Vector& x, mfem::Vector& y) const override;
+
+  /**
+   * @brief the values of the blocks, in the order of the sparsity pattern, with each block stored row-major, i.e.
+   * entry (i, j) of block k is `Values()[(k * test_components + i) * trial_components + j]`
+   */
+  double* Values() { return values_.data(); }
+
+  /// @overload
+  const double* Values() const { return values_.data(); }
+
+  /// @brief the sparsity pattern
+  const BlockSparsityPattern& Pattern() const { return *pattern_; }
+
+  /// @brief the number of rows of each block
+  int TestComponents() const { return test_components_; }
+
+  /// @brief the number of columns of each block
+  int TrialComponents() const { return trial_components_; }
+
+  /// @brief the equivalent scalar CSR matrix, e.g. to form an mfem::HypreParMatrix
+  std::unique_ptr<mfem::SparseMatrix> ToSparseMatrix() const;
+
+private:
+  /// @brief the L-vector index of a component of a test space node
+  int test_index(int node, int component) const
+  {
+    return (test_ordering_ == mfem::Ordering::byNODES) ? component * pattern_->num_rows + node
+                                                       : node * test_components_ + component;
+  }
+
+  /// @brief the L-vector index of a component of a trial space node
+  int trial_index(int node, int component) const
+  {
+    return (trial_ordering_ == mfem::Ordering::byNODES) ? component * pattern_->num_columns + node
+                                                        : node * trial_components_ + component;
+  }
+
+  /// @brief the sparsity pattern
+  std::shared_ptr<const BlockSparsityPattern> pattern_;
+
+  /// @brief the number of rows of each block
+  int test_components_;
+
+  /// @brief the number of columns of each block
+  int trial_components_;
+
+  /// @brief the layout of the test space's L-vectors
+  mfem::Ordering::Type test_ordering_;
+
+  /// @brief the layout of the trial space's L-vectors
+  mfem::Ordering::Type trial_ordering_;
+
+  /// @brief the values of the blocks, see Values()
+  std::vector<double> values_;
+
+  /// @brief the accounting of the memory of the values
+  memory::Tracker tracker_{memory::Subsystem::Matrices};
+};
+
+/**
+ * @brief the parallel operator K = P_test^T A P_trial on the true dofs, for a rank-local block sparse matrix A, where
+ * P_test and P_trial are the prolongations of the test and trial spaces
+ *
+ * This is the matrix-free counterpart of the mfem::HypreParMatrix that mfem::RAP() forms from the scalar version of
+ * A: its action is that of the assembled gradient (including its constraints, if any), without forming the parallel
+ * matrix, e.g. for Krylov solvers with preconditioners that don't need the assembled matrix.
+ */
+class ParBlockSparseMatrix : public mfem::Operator {
+public:
+  /**
+   * @brief create the parallel operator
+   *
+   * @param local the rank-local block sparse matrix
+   * @param P_test the prolongation of the test space
+   * @param P_trial the prolongation of the trial space
+   * @param constrained_dofs the constrained true dofs, whose rows (and, for square operators, columns) are
+   * eliminated, with a unit diagonal for square operators (as Functional does, see SetEssentialTrueDofs())
+   * @param square whether the test and trial spaces are the same
+   */
+  ParBlockSparseMatrix(std::unique_ptr<BlockSparseMatrix> local, const mfem::Operator& P_test,
+                       const mfem::Operator& P_trial, const mfem::Array<int>& constrained_dofs, bool square);
+
+  /// @brief y := K x
+  void Mult(const mfem::Vector& x, mfem::Vector& y) const override;
+
+  /// @brief y := K^T x
+  void MultTranspose(const mfem::Vector& x, mfem::Vector& y) const override;
+
+  /// @brief the rank-local block sparse matrix
+  const BlockSparseMatrix& LocalMatrix() const { return *local_; }
+
+private:
+  /// @brief the rank-local block sparse matrix
+  std::unique_ptr<BlockSparseMatrix> local_;
+
+  /// @brief the prolongation of the test space
+  const mfem::Operator& P_test_;
+
+  /// @brief the prolongation of the trial space
+  const mfem::Operator& P_trial_;
+
+  /// @brief the constrained true dofs
+  mfem::Array<int> constrained_dofs_;
+
+  /// @brief whether the test and trial spaces are the same
+  bool square_;
+
+  /// @brief temporaries for the (constrained) input, and the L-vectors of the test and trial spaces
+  mutable mfem::Vector x_, x_L_, y_L_;
+};
+
+}  // namespace serac
@@ -7,9 +7,12 @@
 
 #include <array>
 
+#include "serac/infrastructure/accelerator.hpp"
 #include "serac/numerics/functional/quadrature_data.hpp"
 #include "serac/numerics/functional/integral_utilities.hpp"
 #include "serac/numerics/functional/differentiate_wrt.hpp"
+#include "serac/numerics/functional/derivative_storage.hpp"
+#include "serac/numerics/functional/interpolation_cache.hpp"
 
 namespace serac {
 
@@ -58,9 +61,32 @@ auto get_derivative_type(lambda qf)
                zero{}};
 };
 
+/// @brief the type used to store the derivatives of a q-function with respect to trial space i
+template <int i, int dim, typename lambda, typename... trials>
+using qf_derivative_storage_t =
+    detail::derivative_storage_t<lambda, decltype(get_derivative_type<i, dim, trials...>(std::declval<lambda>()))>;
+
+/**
+ * @brief allocate the memory for the derivatives of a q-function with respect to each trial space, at each quadrature
+ * point of the given number of elements
+ *
+ * @note the derivatives are stored in single precision if the q-function was wrapped with
+ * `with_single_precision_derivatives()`
+ */
+template <int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename test, typename... trials, typename lambda,
+          int... i>
+auto allocate_qf_derivatives(FunctionSignature<test(trials...)>, const lambda&, uint32_t num_elements,
+                             std::integer_sequence<int, i...>)
+{
+  constexpr int         dim              = dimension_of(geom);
+  constexpr std::size_t qpts_per_element = num_quadrature_points(geom, Q);
+  return serac::make_tuple(accelerator::make_shared_array<exec, qf_derivative_storage_t<i, dim, lambda, trials...>>(
+      num_elements * qpts_per_element, memory::Subsystem::QFunctionDerivatives)...);
+}
+
 template <typename lambda, int dim, int n, typename... T>
-auto batch_apply_qf(lambda qf, const tensor<double, dim, n>& positions,
-                    const tensor<double, dim - 1, dim, n>& jacobians, const T&... inputs)
+SERAC_HOST_DEVICE auto batch_apply_qf(lambda qf, const tensor<double, dim, n>& positions,
+                                      const tensor<double, dim - 1, dim, n>& jacobians, const T&... inputs)
 {
   using return_type = decltype(qf(tensor<double, dim>{}, tensor<double, dim>{}, T{}[0]...));
   tensor<tuple<return_type, zero>, n> outputs{};
@@ -82,41 +108,53 @@ auto batch_apply_qf(lambda qf, const tensor<double, dim, n>& positions,
   return outputs;
 }
 
-template <uint32_t differentiation_index, int Q, mfem::Geometry::Type geom, typename test, typename... trials,
-          typename lambda_type, typename derivative_type, int... indices>
+template <uint32_t differentiation_index, int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename test,
+          typename... trials, typename lambda_type, typename derivative_type, int... indices>
 void evaluation_kernel_impl(FunctionSignature<test(trials...)>, const std::vector<const double*>& inputs,
                             double* outputs, const double* positions, const double* jacobians, lambda_type qf,
-                            [[maybe_unused]] derivative_type* qf_derivatives, uint32_t num_elements,
-                            std::integer_sequence<int, indices...>)
+                            [[maybe_unused]] derivative_type* qf_derivatives,
+                            InterpolationCache<Q, geom, trials...>& interpolation_cache, uint32_t first_element,
+                            uint32_t num_elements, std::integer_sequence<int, indices...>)
 {
   using test_element = finite_element<geom, test>;
 
   /// @brief the element type for each trial space
-  static constexpr tuple<finite_element<geom, trials>...> trial_elements{};
+  using trial_elements = tuple<finite_element<geom, trials>...>;
 
   // mfem provides this information as opaque arrays of doubles,
   // so we reinterpret the pointer with
+  //
+  // note: `inputs` and `outputs` only describe the elements [first_element, first_element + num_elements),
+  // so the other per-element quantities are offset to begin at `first_element` as well
   constexpr int dim = dimension_of(geom) + 1;
   constexpr int nqp = num_quadrature_points(geom, Q);
-  auto          J   = reinterpret_cast<const tensor<double, dim - 1, dim, nqp>*>(jacobians);
-  auto          x   = reinterpret_cast<const tensor<double, dim, nqp>*>(positions);
+  auto          J   = reinterpret_cast<const tensor<double, dim - 1, dim, nqp>*>(jacobians) + first_element;
+  auto          x   = reinterpret_cast<const tensor<double, dim, nqp>*>(positions) + first_element;
   auto          r   = reinterpret_cast<typename test_element::dof_type*>(outputs);
-  static constexpr TensorProductQuadratureRule<Q> rule{};
 
-  static constexpr int qpts_per_elem = num_quadrature_points(geom, Q);
+  constexpr int qpts_per_elem = num_quadrature_points(geom, Q);
 
   [[maybe_unused]] tuple u = {
-      reinterpret_cast<const typename decltype(type<indices>(trial_elements))::dof_type*>(inputs[indices])...};
+      reinterpret_cast<const typename decltype(type<indices>(trial_elements{}))::dof_type*>(inputs[indices])...};
+
+  // a trial space whose values at each quadrature point are reused between evaluations (if any),
+  // and those whose values at each quadrature point are supplied instead of interpolated
+  [[maybe_unused]] auto cached   = interpolation_cache.template pointers<exec>(first_element);
+  [[maybe_unused]] auto supplied = interpolation_cache.template supplied_values<exec>(first_element);
+  [[maybe_unused]] bool refresh  = interpolation_cache.state->refresh;
 
   // for each element in the domain
-  for (uint32_t e = 0; e < num_elements; e++) {
+  accelerator::forall<exec>(num_elements, [=] SERAC_HOST_DEVICE(uint32_t e) {
+    TensorProductQuadratureRule<Q> rule{};
+
     // load the jacobians and positions for each quadrature point in this element
     auto J_e = J[e];
     auto x_e = x[e];
 
     // batch-calculate values / derivatives of each trial space, at each quadrature point
     [[maybe_unused]] tuple qf_inputs = {promote_each_to_dual_when<indices == differentiation_index>(
-        get<indices>(trial_elements).interpolate(get<indices>(u)[e], rule))...};
+        interpolate_or_reuse<decltype(type<indices>(trial_elements{}))>(get<indices>(u)[e], rule, get<indices>(cached),
+                                                                        get<indices>(supplied), e, refresh))...};
 
     // (batch) evalute the q-function at each quadrature point
     auto qf_outputs = batch_apply_qf(qf, x_e, J_e, get<indices>(qf_inputs)...);
@@ -126,18 +164,161 @@ void evaluation_kernel_impl(FunctionSignature<test(trials...)>, const std::vecto
     // won't need to be applied in the action_of_gradient and element_gradient kernels
     if constexpr (differentiation_index != serac::NO_DIFFERENTIATION) {
       for (int q = 0; q < leading_dimension(qf_outputs); q++) {
-        qf_derivatives[e * qpts_per_elem + uint32_t(q)] = get_gradient(qf_outputs[q]);
+        detail::precision_copy(get_gradient(qf_outputs[q]),
+                               qf_derivatives[(first_element + e) * qpts_per_elem + uint32_t(q)]);
       }
     }
 
     // (batch) integrate the material response against the test-space basis functions
     test_element::integrate(get_value(qf_outputs), rule, &r[e]);
-  }
+  });
+}
+
+/**
+ * @brief a version of evaluation_kernel_impl() that stores the derivatives of the q-function with respect to several
+ * trial spaces in the same pass over the elements (so the trial space values are only interpolated once per element)
+ *
+ * @param qf_derivatives where to write the derivatives with respect to each trial space
+ * @param which a bitmask of the trial spaces to differentiate with respect to: bit i selects trial space i
+ */
+template <int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename test, typename... trials,
+          typename lambda_type, typename... derivative_type, int... indices>
+void evaluation_kernel_with_multiple_derivatives_impl(FunctionSignature<test(trials...)>,
+                                                      const std::vector<const double*>& inputs, double* outputs,
+                                                      const double* positions, const double* jacobians,
+                                                      lambda_type qf, tuple<derivative_type*...> qf_derivatives,
+                                                      InterpolationCache<Q, geom, trials...>& interpolation_cache,
+                                                      uint32_t which, uint32_t first_element, uint32_t num_elements,
+                                                      std::integer_sequence<int, indices...>)
+{
+  using test_element = finite_element<geom, test>;
+
+  /// @brief the element type for each trial space
+  using trial_elements = tuple<finite_element<geom, trials>...>;
+
+  constexpr int dim = dimension_of(geom) + 1;
+  constexpr int nqp = num_quadrature_points(geom, Q);
+  auto          J   = reinterpret_cast<const tensor<double, dim - 1, dim, nqp>*>(jacobians) + first_element;
+  auto          x   = reinterpret_cast<const tensor<double, dim, nqp>*>(positions) + first_element;
+  auto          r   = reinterpret_cast<typename test_element::dof_type*>(outputs);
+
+  constexpr int qpts_per_elem = num_quadrature_points(geom, Q);
+
+  tuple u = {reinterpret_cast<const typename decltype(type<indices>(trial_elements{}))::dof_type*>(inputs[indices])...};
+
+  // a trial space whose values at each quadrature point are reused between evaluations (if any),
+  // and those whose values at each quadrature point are supplied instead of interpolated
+  [[maybe_unused]] auto cached   = interpolation_cache.template pointers<exec>(first_element);
+  [[maybe_unused]] auto supplied = interpolation_cache.template supplied_values<exec>(first_element);
+  [[maybe_unused]] bool refresh  = interpolation_cache.state->refresh;
+
+  // for each element in the domain
+  accelerator::forall<exec>(num_elements, [=] SERAC_HOST_DEVICE(uint32_t e) {
+    TensorProductQuadratureRule<Q> rule{};
+
+    // load the jacobians and positions for each quadrature point in this element
+    auto J_e = J[e];
+    auto x_e = x[e];
+
+    // batch-calculate values / derivatives of each trial space, at each quadrature point
+    tuple values = {interpolate_or_reuse<decltype(type<indices>(trial_elements{}))>(
+        get<indices>(u)[e], rule, get<indices>(cached), get<indices>(supplied), e, refresh)...};
+
+    for_constexpr<sizeof...(trials)>([&](auto i) {
+      if (((which >> i) & 1) == 0) return;
+
+      [[maybe_unused]] tuple qf_inputs = {promote_each_to_dual_when<indices == i>(get<indices>(values))...};
+
+      auto qf_outputs = batch_apply_qf(qf, x_e, J_e, get<indices>(qf_inputs)...);
+
+      for (int q = 0; q < leading_dimension(qf_outputs); q++) {
+        detail::precision_copy(get_gradient(qf_outputs[q]),
+                               get<i>(qf_derivatives)[(first_element + e) * qpts_per_elem + uint32_t(q)]);
+      }
+
+      // the last selected trial space is responsible for the residual
+      if ((which >> i) == 1) {
+        test_element::integrate(get_value(qf_outputs), rule, &r[e]);
+      }
+    });
+  });
+}
+
+/**
+ * @brief a version of evaluation_kernel_impl() for q-functions wrapped with `with_directional_derivatives<K>()`, that
+ * evaluates the integral along with its directional derivatives in several directions, propagating K of them
+ * through each evaluation of the q-function
+ *
+ * @param directions the values of each direction for the elements [first_element, first_element + num_elements)
+ * @param direction_trial the (integral) index of the trial space that each direction perturbs, where directions
+ * with any other value perturb a trial space that this integral doesn't depend on
+ * @param outputs the values of the integral, followed by its derivative in each direction (each describing
+ * `num_elements` elements)
+ */
+template <int K, int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename test, typename... trials,
+          typename lambda_type, int... indices>
+void directional_derivatives_kernel_impl(FunctionSignature<test(trials...)>, const std::vector<const double*>& inputs,
+                                         const std::vector<const double*>& directions,
+                                         const std::vector<uint32_t>& direction_trial, double* outputs,
+                                         const double* positions, const double* jacobians, lambda_type qf,
+                                         uint32_t first_element, uint32_t num_elements,
+                                         std::integer_sequence<int, indices...>)
+{
+  static_assert(exec == ExecutionSpace::CPU, "directional derivatives are only supported for ExecutionSpace::CPU");
+
+  using test_element = finite_element<geom, test>;
+
+  /// @brief the element type for each trial space
+  using trial_elements = tuple<finite_element<geom, trials>...>;
+
+  constexpr int dim = dimension_of(geom) + 1;
+  constexpr int nqp = num_quadrature_points(geom, Q);
+  auto          J   = reinterpret_cast<const tensor<double, dim - 1, dim, nqp>*>(jacobians) + first_element;
+  auto          x   = reinterpret_cast<const tensor<double, dim, nqp>*>(positions) + first_element;
+  auto          r   = reinterpret_cast<typename test_element::dof_type*>(outputs);
+
+  tuple u = {reinterpret_cast<const typename decltype(type<indices>(trial_elements{}))::dof_type*>(inputs[indices])...};
+
+  const int num_directions = int(directions.size());
+
+  // for each element in the domain
+  accelerator::forall<exec>(num_elements, [=](uint32_t e) {
+    TensorProductQuadratureRule<Q> rule{};
+
+    auto J_e = J[e];
+    auto x_e = x[e];
+
+    tuple values = {decltype(type<indices>(trial_elements{}))::interpolate(get<indices>(u)[e], rule)...};
+
+    // the directions are propagated K at a time, and the first pass is also responsible for the values
+    for (int first = 0; first == 0 || first < num_directions; first += K) {
+      int count = std::min(K, num_directions - first);
+
+      tuple qf_inputs = {make_multidirectional_dual<K>(get<indices>(values))...};
+      for (int d = 0; d < count; d++) {
+        for_constexpr<sizeof...(trials)>([&](auto i) {
+          if (direction_trial[uint32_t(first + d)] != uint32_t(i)) return;
+          using trial_element = decltype(type<i>(trial_elements{}));
+          auto du = reinterpret_cast<const typename trial_element::dof_type*>(directions[uint32_t(first + d)]);
+          seed_direction(get<i>(qf_inputs), trial_element::interpolate(du[e], rule), d);
+        });
+      }
+
+      auto qf_outputs = batch_apply_qf(qf, x_e, J_e, get<indices>(qf_inputs)...);
+
+      if (first == 0) {
+        test_element::integrate(get_value(qf_outputs), rule, &r[e]);
+      }
+      for (int d = 0; d < count; d++) {
+        test_element::integrate(get_direction(qf_outputs, d), rule, &r[uint32_t(first + d + 1) * num_elements + e]);
+      }
+    }
+  });
 }
 
 //clang-format off
 template <typename S, typename T>
-auto chain_rule(const S& dfdx, const T& dx)
+SERAC_HOST_DEVICE auto chain_rule(const S& dfdx, const T& dx)
 {
   return serac::chain_rule(serac::get<0>(serac::get<0>(dfdx)), serac::get<0>(dx)) +
          serac::chain_rule(serac::get<1>(serac::get<0>(dfdx)), serac::get<1>(dx));
@@ -145,16 +326,44 @@ auto chain_rule(const S& dfdx, const T& dx)
 //clang-format on
 
 template <typename derivative_type, int n, typename T>
-auto batch_apply_chain_rule(derivative_type* qf_derivatives, const tensor<T, n>& inputs)
+SERAC_HOST_DEVICE auto batch_apply_chain_rule(derivative_type* qf_derivatives, const tensor<T, n>& inputs)
 {
-  using return_type = decltype(chain_rule(derivative_type{}, T{}));
+  using full_derivative_type = detail::double_precision_t<std::remove_const_t<derivative_type>>;
+  using return_type          = decltype(chain_rule(full_derivative_type{}, T{}));
   tensor<tuple<return_type, zero>, n> outputs{};
   for (int i = 0; i < n; i++) {
-    get<0>(outputs[i]) = chain_rule(qf_derivatives[i], inputs[i]);
+    get<0>(outputs[i]) = chain_rule(detail::to_double_precision(qf_derivatives[i]), inputs[i]);
   }
   return outputs;
 }
 
+/**
+ * @brief the body of action_of_gradient_kernel() for a single element
+ *
+ * @param[in] du_e the DOF values of the perturbation on this element
+ * @param[inout] dr_e the resulting perturbation of this element's residual
+ * @param[in] qf_derivatives_e the derivatives of the q-function at each quadrature point of this element
+ */
+template <int Q, mfem::Geometry::Type geom, typename test, typename trial, typename derivatives_type>
+SERAC_HOST_DEVICE void action_of_gradient_element(const typename finite_element<geom, trial>::dof_type& du_e,
+                                                  typename finite_element<geom, test>::dof_type& dr_e,
+                                                  const derivatives_type* qf_derivatives_e)
+{
+  using test_element  = finite_element<geom, test>;
+  using trial_element = finite_element<geom, trial>;
+
+  TensorProductQuadratureRule<Q> rule{};
+
+  // (batch) interpolate each quadrature point's value
+  auto qf_inputs = trial_element::interpolate(du_e, rule);
+
+  // (batch) evalute the q-function at each quadrature point
+  auto qf_outputs = batch_apply_chain_rule(qf_derivatives_e, qf_inputs);
+
+  // (batch) integrate the material response against the test-space basis functions
+  test_element::integrate(qf_outputs, rule, &dr_e);
+}
+
 /**
  * @brief The base kernel template used to create create custom directional derivative
  * kernels associated with finite element calculations
@@ -179,30 +388,138 @@ auto batch_apply_chain_rule(derivative_type* qf_derivatives, const tensor<T, n>&
  * @param[in] J_ The Jacobians of the element transformations at all quadrature points
  * @see mfem::GeometricFactors
  * @param[in] num_elements The number of elements in the mesh
+ * @param[in] num_directions The number of perturbations to apply the gradient to: dU and dR hold the values for each
+ * perturbation one after another, each describing `num_elements` elements
  */
-template <int Q, mfem::Geometry::Type geom, typename test, typename trial, typename derivatives_type>
-void action_of_gradient_kernel(const double* dU, double* dR, derivatives_type* qf_derivatives, std::size_t num_elements)
+template <int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename test, typename trial,
+          typename derivatives_type>
+void action_of_gradient_kernel(const double* dU, double* dR, derivatives_type* qf_derivatives, std::size_t num_elements,
+                               uint32_t num_directions)
 {
   using test_element  = finite_element<geom, test>;
   using trial_element = finite_element<geom, trial>;
 
   // mfem provides this information in 1D arrays, so we reshape it
   // into strided multidimensional arrays before using
-  constexpr int                                   nqp = num_quadrature_points(geom, Q);
-  auto                                            du  = reinterpret_cast<const typename trial_element::dof_type*>(dU);
-  auto                                            dr  = reinterpret_cast<typename test_element::dof_type*>(dR);
-  static constexpr TensorProductQuadratureRule<Q> rule{};
+  constexpr int nqp = num_quadrature_points(geom, Q);
+  auto          du  = reinterpret_cast<const typename trial_element::dof_type*>(dU);
+  auto          dr  = reinterpret_cast<typename test_element::dof_type*>(dR);
+
+  // for each element in the domain, the q-function derivatives are loaded
+  // once and applied to each of the perturbations
+  accelerator::forall<exec>(uint32_t(num_elements), [=] SERAC_HOST_DEVICE(uint32_t e) {
+    for (uint32_t d = 0; d < num_directions; d++) {
+      std::size_t i = std::size_t(d) * num_elements + e;
+      action_of_gradient_element<Q, geom, test, trial>(du[i], dr[i], qf_derivatives + e * nqp);
+    }
+  });
+}
 
-  // for each element in the domain
-  for (uint32_t e = 0; e < num_elements; e++) {
-    // (batch) interpolate each quadrature point's value
-    auto qf_inputs = trial_element::interpolate(du[e], rule);
+/**
+ * @brief the transpose of chain_rule(), for the derivatives of the (source) output of a q-function with
+ * respect to the (value, derivative) of one of its arguments
+ *
+ * @tparam input_type the type of that argument at a quadrature point
+ * @param dfdx the derivatives of the q-function output w.r.t. that argument
+ * @param df a small change in the source output
+ */
+template <typename input_type, typename S, typename T>
+SERAC_HOST_DEVICE auto chain_rule_transpose(const S& dfdx, const T& df)
+{
+  using value_type      = std::decay_t<decltype(serac::get<0>(input_type{}))>;
+  using derivative_type = std::decay_t<decltype(serac::get<1>(input_type{}))>;
+  return serac::tuple{serac::chain_rule_transpose<value_type>(serac::get<0>(serac::get<0>(dfdx)), df),
+                      serac::chain_rule_transpose<derivative_type>(serac::get<1>(serac::get<0>(dfdx)), df)};
+}
 
-    // (batch) evalute the q-function at each quadrature point
-    auto qf_outputs = batch_apply_chain_rule(qf_derivatives + e * nqp, qf_inputs);
+/**
+ * @brief the body of transpose_action_of_gradient_kernel() for a single element
+ *
+ * @param[in] dr_e the DOF values of the perturbation of this element's residual
+ * @param[inout] du_e the resulting perturbation in the trial space on this element
+ * @param[in] qf_derivatives_e the derivatives of the q-function at each quadrature point of this element
+ */
+template <int Q, mfem::Geometry::Type geom, typename test, typename trial, typename derivatives_type>
+SERAC_HOST_DEVICE void transpose_action_of_gradient_element(const typename finite_element<geom, test>::dof_type& dr_e,
+                                                            typename finite_element<geom, trial>::dof_type& du_e,
+                                                            const derivatives_type* qf_derivatives_e)
+{
+  using test_element    = finite_element<geom, test>;
+  using trial_element   = finite_element<geom, trial>;
+  using derivative_type = detail::double_precision_t<std::remove_const_t<derivatives_type>>;
 
-    // (batch) integrate the material response against the test-space basis functions
-    test_element::integrate(qf_outputs, rule, &dr[e]);
+  constexpr int nqp = num_quadrature_points(geom, Q);
+
+  TensorProductQuadratureRule<Q> rule{};
+
+  // (batch) interpolate the perturbation of the residual at each quadrature point
+  auto test_values = test_element::interpolate(dr_e, rule);
+
+  // apply the transpose of the q-function derivatives at each quadrature point
+  using input_type  = std::decay_t<decltype(trial_element::interpolate(du_e, rule)[0])>;
+  using output_type = decltype(chain_rule_transpose<input_type>(derivative_type{}, serac::get<0>(test_values[0])));
+  tensor<output_type, nqp> qf_outputs{};
+  for (int q = 0; q < nqp; q++) {
+    auto df       = serac::get<0>(test_values[q]);
+    qf_outputs[q] = chain_rule_transpose<input_type>(detail::to_double_precision(qf_derivatives_e[q]), df);
+  }
+
+  // (batch) integrate the result against the trial-space basis functions
+  trial_element::integrate(qf_outputs, rule, &du_e);
+}
+
+/**
+ * @brief the transpose of action_of_gradient_kernel(), i.e. the vector-jacobian product: applies the transpose
+ * of the stored q-function derivatives to a perturbation of the residual, without forming the element matrices
+ *
+ * @param[in] dR the per-element values of the perturbation of the residual (test space)
+ * @param[inout] dU the resulting per-element values in the trial space
+ * @param[in] qf_derivatives the derivatives of the q-function at each quadrature point
+ * @param[in] num_elements the number of elements
+ */
+template <int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename test, typename trial,
+          typename derivatives_type>
+void transpose_action_of_gradient_kernel(const double* dR, double* dU, derivatives_type* qf_derivatives,
+                                         std::size_t num_elements)
+{
+  using test_element  = finite_element<geom, test>;
+  using trial_element = finite_element<geom, trial>;
+
+  constexpr int nqp = num_quadrature_points(geom, Q);
+  auto          dr  = reinterpret_cast<const typename test_element::dof_type*>(dR);
+  auto          du  = reinterpret_cast<typename trial_element::dof_type*>(dU);
+
+  accelerator::forall<exec>(uint32_t(num_elements), [=] SERAC_HOST_DEVICE(uint32_t e) {
+    transpose_action_of_gradient_element<Q, geom, test, trial>(dr[e], du[e], qf_derivatives + e * nqp);
+  });
+}
+
+/**
+ * @brief the body of element_gradient_kernel() for a single element
+ *
+ * @param[inout] K_e the element gradient matrix of this element
+ * @param[in] qf_derivatives_e the derivatives of the q-function at each quadrature point of this element
+ */
+template <int Q, mfem::Geometry::Type g, typename test, typename trial, typename derivatives_type>
+SERAC_HOST_DEVICE void element_gradient_element(double* K_e, const derivatives_type* qf_derivatives_e)
+{
+  using test_element  = finite_element<g, test>;
+  using trial_element = finite_element<g, trial>;
+
+  constexpr int nquad = num_quadrature_points(g, Q);
+
+  TensorProductQuadratureRule<Q> rule{};
+
+  auto* output_ptr = reinterpret_cast<typename test_element::dof_type*>(K_e);
+
+  tensor<detail::dense_t<derivatives_type>, nquad> derivatives{};
+  for (int q = 0; q < nquad; q++) {
+    derivatives(q) = detail::to_dense(qf_derivatives_e[q]);
+  }
+
+  for (int J = 0; J < trial_element::ndof; J++) {
+    auto source_and_flux = trial_element::batch_apply_shape_fn(J, derivatives, rule);
+    test_element::integrate(source_and_flux, rule, output_ptr + J, trial_element::ndof);
   }
 }
 
@@ -227,8 +544,8 @@ void action_of_gradient_kernel(const double* dU, double* dR, derivatives_type* q
  * @see mfem::GeometricFactors
  * @param[in] num_elements The number of elements in the mesh
  */
-template <mfem::Geometry::Type g, typename test, typename trial, int Q, typename derivatives_type>
-void element_gradient_kernel(ExecArrayView<double, 3, ExecutionSpace::CPU> dK, derivatives_type* qf_derivatives,
+template <mfem::Geometry::Type g, typename test, typename trial, int Q, ExecutionSpace exec, typename derivatives_type>
+void element_gradient_kernel(ExecArrayView<double, 3, exec> dK, derivatives_type* qf_derivatives,
                              std::size_t num_elements)
 {
   using test_element  = finite_element<g, test>;
@@ -236,55 +553,278 @@ void element_gradient_kernel(ExecArrayView<double, 3, ExecutionSpace::CPU> dK, d
 
   constexpr int nquad = num_quadrature_points(g, Q);
 
-  static constexpr TensorProductQuadratureRule<Q> rule{};
+  // the number of entries in each element matrix
+  constexpr uint32_t entries_per_elem = uint32_t(test_element::ndof * test_element::components * trial_element::ndof *
+                                                 trial_element::components);
+
+  double* K = dK.data();
 
   // for each element in the domain
-  for (uint32_t e = 0; e < num_elements; e++) {
-    auto* output_ptr = reinterpret_cast<typename test_element::dof_type*>(&dK(e, 0, 0));
+  accelerator::forall<exec>(uint32_t(num_elements), [=] SERAC_HOST_DEVICE(uint32_t e) {
+    element_gradient_element<Q, g, test, trial>(K + e * entries_per_elem, qf_derivatives + e * nquad);
+  });
+}
 
-    tensor<derivatives_type, nquad> derivatives{};
-    for (int q = 0; q < nquad; q++) {
-      derivatives(q) = qf_derivatives[e * nquad + uint32_t(q)];
-    }
+/**
+ * @brief evaluate the derivatives of the q-function with respect to trial space `wrt` at each quadrature point
+ * of a single element, in the same form that evaluation_kernel_impl() stores them, for integrals that recompute
+ * their derivatives rather than storing them
+ *
+ * @param qf the q-function
+ * @param x_e the positions of the quadrature points in this element
+ * @param J_e the jacobians of the element transformation at the quadrature points in this element
+ * @param u pointers to the per-element values of each trial space, at the linearization point
+ * @param e which element
+ */
+template <uint32_t wrt, int Q, mfem::Geometry::Type geom, typename test, typename... trials, typename lambda_type,
+          typename position_type, typename jacobian_type, typename input_type, int... indices>
+SERAC_HOST_DEVICE auto recompute_qf_derivatives(FunctionSignature<test(trials...)>, lambda_type qf,
+                                                const position_type& x_e, const jacobian_type& J_e, const input_type& u,
+                                                uint32_t e, std::integer_sequence<int, indices...>)
+{
+  using trial_elements = tuple<finite_element<geom, trials>...>;
 
-    for (int J = 0; J < trial_element::ndof; J++) {
-      auto source_and_flux = trial_element::batch_apply_shape_fn(J, derivatives, rule);
-      test_element::integrate(source_and_flux, rule, output_ptr + J, trial_element::ndof);
-    }
+  TensorProductQuadratureRule<Q> rule{};
+
+  tuple qf_inputs = {promote_each_to_dual_when<indices == wrt>(
+      decltype(type<indices>(trial_elements{}))::interpolate(get<indices>(u)[e], rule))...};
+
+  auto qf_outputs = batch_apply_qf(qf, x_e, J_e, get<indices>(qf_inputs)...);
+
+  constexpr int nqp = num_quadrature_points(geom, Q);
+  tensor<std::decay_t<decltype(get_gradient(qf_outputs[0]))>, nqp> derivatives{};
+  for (int q = 0; q < nqp; q++) {
+    derivatives[q] = get_gradient(qf_outputs[q]);
   }
+  return derivatives;
 }
 
-template <uint32_t wrt, int Q, mfem::Geometry::Type geom, typename signature, typename lambda_type,
-          typename derivative_type>
-std::function<void(const std::vector<const double*>&, double*, bool)> evaluation_kernel(
+/**
+ * @brief the counterpart of action_of_gradient_kernel() for integrals that recompute the q-function derivatives
+ * (from the values of the trial spaces at the linearization point) instead of storing them
+ *
+ * @param inputs the per-element values of each trial space at the linearization point
+ * @param positions the positions of each quadrature point
+ * @param jacobians the jacobians of the element transformations at each quadrature point
+ * @param qf the q-function
+ * @param dU the per-element values of the perturbation of trial space `wrt`, beginning with `first_element`
+ * @param dR the per-element values of the resulting perturbation of the residual, beginning with `first_element`
+ * @param first_element the index of the first element to process
+ * @param num_elements the number of elements to process
+ * @param num_directions the number of perturbations, see action_of_gradient_kernel()
+ */
+template <uint32_t wrt, int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename test, typename... trials,
+          typename lambda_type, int... indices>
+void action_of_gradient_recompute_kernel(FunctionSignature<test(trials...)> s, const std::vector<const double*>& inputs,
+                                         const double* positions, const double* jacobians, lambda_type qf,
+                                         const double* dU, double* dR, uint32_t first_element, uint32_t num_elements,
+                                         uint32_t num_directions, std::integer_sequence<int, indices...> seq)
+{
+  using test_element   = finite_element<geom, test>;
+  using trial_elements = tuple<finite_element<geom, trials>...>;
+  using trial_element  = decltype(type<wrt>(trial_elements{}));
+
+  constexpr int dim = dimension_of(geom) + 1;
+  constexpr int nqp = num_quadrature_points(geom, Q);
+  auto          J   = reinterpret_cast<const tensor<double, dim - 1, dim, nqp>*>(jacobians);
+  auto          x   = reinterpret_cast<const tensor<double, dim, nqp>*>(positions);
+  auto          du  = reinterpret_cast<const typename trial_element::dof_type*>(dU);
+  auto          dr  = reinterpret_cast<typename test_element::dof_type*>(dR);
+
+  tuple u = {reinterpret_cast<const typename decltype(type<indices>(trial_elements{}))::dof_type*>(inputs[indices])...};
+
+  accelerator::forall<exec>(num_elements, [=] SERAC_HOST_DEVICE(uint32_t i) {
+    uint32_t e = first_element + i;
+
+    auto derivatives = recompute_qf_derivatives<wrt, Q, geom>(s, qf, x[e], J[e], u, e, seq);
+
+    for (uint32_t d = 0; d < num_directions; d++) {
+      std::size_t j = std::size_t(d) * num_elements + i;
+      action_of_gradient_element<Q, geom, test, std::tuple_element_t<wrt, std::tuple<trials...>>>(
+          du[j], dr[j], &derivatives[0]);
+    }
+  });
+}
+
+/**
+ * @brief the counterpart of element_gradient_kernel() for integrals that recompute the q-function derivatives
+ * (from the values of the trial spaces at the linearization point) instead of storing them
+ *
+ * @param inputs the per-element values of each trial space at the linearization point
+ * @param positions the positions of each quadrature point
+ * @param jacobians the jacobians of the element transformations at each quadrature point
+ * @param qf the q-function
+ * @param K the element gradients
+ * @param num_elements the number of elements
+ */
+template <uint32_t wrt, int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename test, typename... trials,
+          typename lambda_type, int... indices>
+void element_gradient_recompute_kernel_impl(FunctionSignature<test(trials...)> s,
+                                            const std::vector<const double*>& inputs, const double* positions,
+                                            const double* jacobians, lambda_type qf, double* K, uint32_t num_elements,
+                                            std::integer_sequence<int, indices...> seq)
+{
+  using test_element   = finite_element<geom, test>;
+  using trial_elements = tuple<finite_element<geom, trials>...>;
+  using trial_element  = decltype(type<wrt>(trial_elements{}));
+
+  // the number of entries in each element matrix
+  constexpr uint32_t entries_per_elem = uint32_t(test_element::ndof * test_element::components * trial_element::ndof *
+                                                 trial_element::components);
+
+  constexpr int dim = dimension_of(geom) + 1;
+  constexpr int nqp = num_quadrature_points(geom, Q);
+  auto          J   = reinterpret_cast<const tensor<double, dim - 1, dim, nqp>*>(jacobians);
+  auto          x   = reinterpret_cast<const tensor<double, dim, nqp>*>(positions);
+
+  tuple u = {reinterpret_cast<const typename decltype(type<indices>(trial_elements{}))::dof_type*>(inputs[indices])...};
+
+  accelerator::forall<exec>(num_elements, [=] SERAC_HOST_DEVICE(uint32_t e) {
+    auto derivatives = recompute_qf_derivatives<wrt, Q, geom>(s, qf, x[e], J[e], u, e, seq);
+
+    element_gradient_element<Q, geom, test, std::tuple_element_t<wrt, std::tuple<trials...>>>(
+        K + e * entries_per_elem, &derivatives[0]);
+  });
+}
+
+template <uint32_t wrt, int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename signature, typename lambda_type,
+          typename derivative_type, typename cache_type>
+std::function<void(const std::vector<const double*>&, double*, bool, uint32_t, uint32_t)> evaluation_kernel(
     signature s, lambda_type qf, const double* positions, const double* jacobians,
-    std::shared_ptr<derivative_type> qf_derivatives, uint32_t num_elements)
+    std::shared_ptr<derivative_type> qf_derivatives, std::shared_ptr<cache_type> interpolation_cache)
+{
+  return [=](const std::vector<const double*>& inputs, double* outputs, bool /* update state */,
+             uint32_t first_element, uint32_t num_elements) {
+    evaluation_kernel_impl<wrt, Q, geom, exec>(s, inputs, outputs, positions, jacobians, qf, qf_derivatives.get(),
+                                               *interpolation_cache, first_element, num_elements, s.index_seq);
+  };
+}
+
+template <int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename signature, typename lambda_type,
+          typename... derivative_type, typename cache_type>
+std::function<void(const std::vector<const double*>&, double*, bool, uint32_t, uint32_t, uint32_t)>
+evaluation_kernel_with_multiple_derivatives(signature s, lambda_type qf, const double* positions,
+                                            const double*                              jacobians,
+                                            tuple<std::shared_ptr<derivative_type>...> qf_derivatives,
+                                            std::shared_ptr<cache_type>                interpolation_cache)
+{
+  return [=](const std::vector<const double*>& inputs, double* outputs, bool /* update state */,
+             uint32_t first_element, uint32_t num_elements, uint32_t which) {
+    auto derivatives = serac::apply([](auto&... each) { return serac::make_tuple(each.get()...); }, qf_derivatives);
+    evaluation_kernel_with_multiple_derivatives_impl<Q, geom, exec>(s, inputs, outputs, positions, jacobians, qf,
+                                                                    derivatives, *interpolation_cache, which,
+                                                                    first_element, num_elements, s.index_seq);
+  };
+}
+
+template <int K, int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename signature, typename lambda_type>
+std::function<void(const std::vector<const double*>&, const std::vector<const double*>&, const std::vector<uint32_t>&,
+                   double*, uint32_t, uint32_t)>
+directional_derivatives_kernel(signature s, lambda_type qf, const double* positions, const double* jacobians)
 {
-  return [=](const std::vector<const double*>& inputs, double* outputs, bool /* update state */) {
-    evaluation_kernel_impl<wrt, Q, geom>(s, inputs, outputs, positions, jacobians, qf, qf_derivatives.get(),
-                                         num_elements, s.index_seq);
+  return [=](const std::vector<const double*>& inputs, const std::vector<const double*>& directions,
+             const std::vector<uint32_t>& direction_trial, double* outputs, uint32_t first_element,
+             uint32_t num_elements) {
+    directional_derivatives_kernel_impl<K, Q, geom, exec>(s, inputs, directions, direction_trial, outputs, positions,
+                                                          jacobians, qf, first_element, num_elements, s.index_seq);
   };
 }
 
-template <int wrt, int Q, mfem::Geometry::Type geom, typename signature, typename derivative_type>
-std::function<void(const double*, double*)> jacobian_vector_product_kernel(
-    signature, std::shared_ptr<derivative_type> qf_derivatives, uint32_t num_elements)
+template <int wrt, int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename signature, typename derivative_type>
+std::function<void(const double*, double*, uint32_t, uint32_t, uint32_t)> jacobian_vector_product_kernel(
+    signature, std::shared_ptr<derivative_type> qf_derivatives)
 {
-  return [=](const double* du, double* dr) {
+  return [=](const double* du, double* dr, uint32_t first_element, uint32_t num_elements, uint32_t num_directions) {
     using test_space  = typename signature::return_type;
     using trial_space = typename std::tuple_element<wrt, typename signature::parameter_types>::type;
-    action_of_gradient_kernel<Q, geom, test_space, trial_space>(du, dr, qf_derivatives.get(), num_elements);
+    constexpr int nqp = num_quadrature_points(geom, Q);
+    action_of_gradient_kernel<Q, geom, exec, test_space, trial_space>(
+        du, dr, qf_derivatives.get() + std::size_t(first_element) * nqp, num_elements, num_directions);
   };
 }
 
-template <int wrt, int Q, mfem::Geometry::Type geom, typename signature, typename derivative_type>
-std::function<void(ExecArrayView<double, 3, ExecutionSpace::CPU>)> element_gradient_kernel(
-    signature, std::shared_ptr<derivative_type> qf_derivatives, uint32_t num_elements)
+template <int wrt, int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename signature, typename derivative_type>
+std::function<void(const double*, double*, uint32_t, uint32_t)> vector_jacobian_product_kernel(
+    signature, std::shared_ptr<derivative_type> qf_derivatives)
 {
-  return [=](ExecArrayView<double, 3, ExecutionSpace::CPU> K_elem) {
+  return [=](const double* dr, double* du, uint32_t first_element, uint32_t num_elements) {
     using test_space  = typename signature::return_type;
     using trial_space = typename std::tuple_element<wrt, typename signature::parameter_types>::type;
-    element_gradient_kernel<geom, test_space, trial_space, Q>(K_elem, qf_derivatives.get(), num_elements);
+    constexpr int nqp = num_quadrature_points(geom, Q);
+    transpose_action_of_gradient_kernel<Q, geom, exec, test_space, trial_space>(
+        dr, du, qf_derivatives.get() + std::size_t(first_element) * nqp, num_elements);
+  };
+}
+
+template <int wrt, int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename signature, typename derivative_type>
+std::function<void(double*)> element_gradient_kernel(signature, std::shared_ptr<derivative_type> qf_derivatives,
+                                                     uint32_t num_elements)
+{
+  return [=](double* K_elem) {
+    using test_space    = typename signature::return_type;
+    using trial_space   = typename std::tuple_element<wrt, typename signature::parameter_types>::type;
+    using test_element  = finite_element<geom, test_space>;
+    using trial_element = finite_element<geom, trial_space>;
+
+    constexpr int test_vdofs  = test_element::ndof * test_element::components;
+    constexpr int trial_vdofs = trial_element::ndof * trial_element::components;
+
+    ExecArrayView<double, 3, exec> K_elem_view(K_elem, num_elements, trial_vdofs, test_vdofs);
+    element_gradient_kernel<geom, test_space, trial_space, Q, exec>(K_elem_view, qf_derivatives.get(), num_elements);
+  };
+}
+
+template <int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename signature, typename lambda_type,
+          typename cache_type>
+std::function<void(const std::vector<const double*>&, double*, bool, uint32_t, uint32_t)>
+evaluation_kernel_with_saved_inputs(signature s, lambda_type qf, const double* positions, const double* jacobians,
+                                    detail::LinearizationPoint  linearization_point,
+                                    std::shared_ptr<cache_type> interpolation_cache)
+{
+  return [=](const std::vector<const double*>& inputs, double* outputs, bool /* update state */,
+             uint32_t first_element, uint32_t num_elements) {
+    linearization_point.save<exec>(inputs, first_element, num_elements);
+    zero* no_derivatives = nullptr;
+    evaluation_kernel_impl<NO_DIFFERENTIATION, Q, geom, exec>(s, inputs, outputs, positions, jacobians, qf,
+                                                              no_derivatives, *interpolation_cache, first_element,
+                                                              num_elements, s.index_seq);
+  };
+}
+
+template <int wrt, int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename signature, typename lambda_type>
+std::function<void(const double*, double*, uint32_t, uint32_t, uint32_t)> jacobian_vector_product_recompute_kernel(
+    signature s, lambda_type qf, const double* positions, const double* jacobians,
+    detail::LinearizationPoint linearization_point)
+{
+  return [=](const double* du, double* dr, uint32_t first_element, uint32_t num_elements, uint32_t num_directions) {
+    action_of_gradient_recompute_kernel<wrt, Q, geom, exec>(s, linearization_point.pointers(), positions, jacobians,
+                                                            qf, du, dr, first_element, num_elements, num_directions,
+                                                            s.index_seq);
+  };
+}
+
+template <int wrt, int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename signature, typename lambda_type>
+std::function<void(double*)> element_gradient_recompute_kernel(signature s, lambda_type qf, const double* positions,
+                                                               const double*              jacobians,
+                                                               detail::LinearizationPoint linearization_point,
+                                                               uint32_t                   num_elements)
+{
+  return [=](double* K_elem) {
+    element_gradient_recompute_kernel_impl<wrt, Q, geom, exec>(s, linearization_point.pointers(), positions,
+                                                               jacobians, qf, K_elem, num_elements, s.index_seq);
+  };
+}
+
+/// @brief the boundary integral counterpart of domain_integral::qoi_gradient_kernel()
+template <int wrt, int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename signature, typename lambda_type>
+std::function<void(const std::vector<const double*>&, double*)> qoi_gradient_kernel(signature s, lambda_type qf,
+                                                                                     const double* positions,
+                                                                                     const double* jacobians,
+                                                                                     uint32_t      num_elements)
+{
+  return [=](const std::vector<const double*>& inputs, double* dQ) {
+    element_gradient_recompute_kernel_impl<wrt, Q, geom, exec>(s, inputs, positions, jacobians, qf, dQ, num_elements,
+                                                               s.index_seq);
   };
 }
 
@@ -0,0 +1,572 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file derivative_storage.hpp
+ *
+ * @brief options for how the q-function derivatives used by the gradient kernels are stored (or recomputed)
+ */
+
+#pragma once
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "serac/infrastructure/accelerator.hpp"
+#include "serac/numerics/functional/tuple.hpp"
+#include "serac/numerics/functional/tensor.hpp"
+
+namespace serac {
+
+/**
+ * @brief a wrapper around a q-function that tells Functional to store its derivatives in single precision
+ *
+ * By default, the derivatives of the q-function at each quadrature point are stored in double precision
+ * for use in the action-of-gradient and element gradient calculations. For some materials (e.g. 3D J2 plasticity,
+ * where the derivative is a rank-4 tensor) this can be the largest allocation of the simulation. Wrapping the
+ * q-function in this type halves that storage, at the cost of gradient calculations that are only accurate to
+ * single precision (which may slow the convergence of the nonlinear solver somewhat).
+ *
+ * @note the residual calculation itself is unaffected, and always carried out in double precision
+ *
+ * @tparam lambda the type of the q-function being wrapped
+ */
+template <typename lambda>
+struct SinglePrecisionDerivatives {
+  lambda qf;  ///< the q-function
+
+  /// @brief evaluate the underlying q-function
+  template <typename... T>
+  SERAC_HOST_DEVICE auto operator()(T&&... args) const
+  {
+    return qf(std::forward<T>(args)...);
+  }
+};
+
+/**
+ * @brief convenience function for opting in to single-precision derivative storage for a given q-function, e.g.
+ *
+ * @code{.cpp}
+ * residual.AddDomainIntegral(Dimension<3>{}, DependsOn<0>{}, with_single_precision_derivatives(qf), mesh);
+ * @endcode
+ *
+ * @param qf the q-function
+ */
+template <typename lambda>
+auto with_single_precision_derivatives(lambda&& qf)
+{
+  return SinglePrecisionDerivatives<std::decay_t<lambda>>{std::forward<lambda>(qf)};
+}
+
+/**
+ * @brief a wrapper around a q-function that tells Functional not to store its derivatives at all
+ *
+ * Instead, the values of the integral's inputs are saved when its gradient is requested, and the action-of-gradient
+ * and element gradient calculations re-evaluate the q-function (with dual numbers) at each quadrature point to
+ * obtain the derivatives as they are needed. This trades the memory of the stored derivatives for the cost of
+ * additional q-function evaluations, which is favorable for inexpensive q-functions with large derivatives.
+ *
+ * @note quadrature point data is read (but not modified) by the recomputation, so gradients requested after an
+ * evaluation that updated the quadrature point data are taken with respect to the updated values
+ *
+ * @tparam lambda the type of the q-function being wrapped
+ */
+template <typename lambda>
+struct RecomputedDerivatives {
+  lambda qf;  ///< the q-function
+
+  /// @brief evaluate the underlying q-function
+  template <typename... T>
+  SERAC_HOST_DEVICE auto operator()(T&&... args) const
+  {
+    return qf(std::forward<T>(args)...);
+  }
+};
+
+/**
+ * @brief convenience function for opting in to recomputing (rather than storing) the derivatives of a given
+ * q-function, e.g.
+ *
+ * @code{.cpp}
+ * residual.AddDomainIntegral(Dimension<3>{}, DependsOn<0>{}, with_recomputed_derivatives(qf), mesh);
+ * @endcode
+ *
+ * @param qf the q-function
+ */
+template <typename lambda>
+auto with_recomputed_derivatives(lambda&& qf)
+{
+  return RecomputedDerivatives<std::decay_t<lambda>>{std::forward<lambda>(qf)};
+}
+
+/**
+ * @brief a wrapper around a q-function that tells Functional its derivatives with respect to rank-2 tensor
+ * arguments (e.g. the stress w.r.t. the displacement gradient) are isotropic rank-4 tensors
+ *
+ * Those derivatives are then stored as `isotropic_tensor`s (3 values, rather than the 81 of a dense
+ * `tensor<double, 3, 3, 3, 3>`), and the action-of-gradient calculation applies them directly in that form. This is
+ * the case for, e.g., linear isotropic elasticity without geometric nonlinearities.
+ *
+ * @note the isotropic part is extracted from a handful of entries of each derivative, so wrapping a q-function whose
+ * derivatives are not actually isotropic gives incorrect gradients. The residual calculation is unaffected.
+ *
+ * @tparam lambda the type of the q-function being wrapped
+ */
+template <typename lambda>
+struct IsotropicDerivatives {
+  lambda qf;  ///< the q-function
+
+  /// @brief evaluate the underlying q-function
+  template <typename... T>
+  SERAC_HOST_DEVICE auto operator()(T&&... args) const
+  {
+    return qf(std::forward<T>(args)...);
+  }
+};
+
+/**
+ * @brief convenience function for opting in to isotropic derivative storage for a given q-function, e.g.
+ *
+ * @code{.cpp}
+ * residual.AddDomainIntegral(Dimension<3>{}, DependsOn<0>{}, with_isotropic_derivatives(qf), mesh);
+ * @endcode
+ *
+ * @param qf the q-function
+ */
+template <typename lambda>
+auto with_isotropic_derivatives(lambda&& qf)
+{
+  return IsotropicDerivatives<std::decay_t<lambda>>{std::forward<lambda>(qf)};
+}
+
+/**
+ * @brief a wrapper around a q-function that tells Functional its derivatives are the same at every quadrature point
+ * and every linearization point (e.g. linear materials with constant coefficients)
+ *
+ * Instead of storing the derivatives at each quadrature point, the derivative with respect to each trial space is
+ * computed once, when the integral is created, and the action-of-gradient and element gradient calculations apply
+ * it (along with the element jacobians) directly.
+ *
+ * @note the derivative is evaluated at the origin, with zero-valued arguments and default-constructed quadrature
+ * point data, so wrapping a q-function whose derivatives depend on any of those gives incorrect gradients.
+ * The residual calculation is unaffected.
+ *
+ * @tparam lambda the type of the q-function being wrapped
+ */
+template <typename lambda>
+struct ConstantDerivatives {
+  lambda qf;  ///< the q-function
+
+  /// @brief evaluate the underlying q-function
+  template <typename... T>
+  SERAC_HOST_DEVICE auto operator()(T&&... args) const
+  {
+    return qf(std::forward<T>(args)...);
+  }
+};
+
+/**
+ * @brief convenience function for declaring that the derivatives of a given q-function are constant, e.g.
+ *
+ * @code{.cpp}
+ * residual.AddDomainIntegral(Dimension<3>{}, DependsOn<0>{}, with_constant_derivatives(qf), mesh);
+ * @endcode
+ *
+ * @param qf the q-function
+ */
+template <typename lambda>
+auto with_constant_derivatives(lambda&& qf)
+{
+  return ConstantDerivatives<std::decay_t<lambda>>{std::forward<lambda>(qf)};
+}
+
+/**
+ * @brief a wrapper around a q-function that lets Functional evaluate it along with its directional derivatives in up
+ * to K directions at once (see Functional::DirectionalDerivatives())
+ *
+ * The q-function is called with dual numbers whose gradients are K-vectors: entry d holds the perturbation of that
+ * input in direction d, where each direction perturbs one of the trial spaces (e.g. one parameter field). A single
+ * evaluation then gives the directional derivatives of the residual in all K directions, instead of one pass per
+ * direction with the usual dual numbers. More than K directions are processed K at a time.
+ *
+ * @note the q-function must accept its arguments as `auto` (or as `dual<tensor<double, K>>`-valued types), and
+ * the usual residual and gradient evaluations of the integral are unaffected
+ *
+ * @tparam K the number of directions per evaluation
+ * @tparam lambda the type of the q-function being wrapped
+ */
+template <int K, typename lambda>
+struct DirectionalDerivatives {
+  static_assert(K > 0, "the number of directions per evaluation must be positive");
+
+  lambda qf;  ///< the q-function
+
+  /// @brief evaluate the underlying q-function
+  template <typename... T>
+  SERAC_HOST_DEVICE auto operator()(T&&... args) const
+  {
+    return qf(std::forward<T>(args)...);
+  }
+};
+
+/**
+ * @brief convenience function for opting in to the directional derivatives of a given q-function in several directions
+ * at once, e.g.
+ *
+ * @code{.cpp}
+ * residual.AddDomainIntegral(Dimension<3>{}, DependsOn<0, 1, 2>{}, with_directional_derivatives<2>(qf), mesh);
+ * @endcode
+ *
+ * @tparam K the number of directions per evaluation
+ * @param qf the q-function
+ */
+template <int K, typename lambda>
+auto with_directional_derivatives(lambda&& qf)
+{
+  return DirectionalDerivatives<K, std::decay_t<lambda>>{std::forward<lambda>(qf)};
+}
+
+namespace detail {
+
+/// @brief a trait for detecting q-functions that requested their derivatives be recomputed rather than stored
+template <typename T>
+struct recomputes_derivatives : std::false_type {
+};
+
+/// @overload
+template <typename lambda>
+struct recomputes_derivatives<RecomputedDerivatives<lambda>> : std::true_type {
+};
+
+/// @brief a trait for detecting q-functions that declared their derivatives to be constant
+template <typename T>
+struct has_constant_derivatives : std::false_type {
+};
+
+/// @overload
+template <typename lambda>
+struct has_constant_derivatives<ConstantDerivatives<lambda>> : std::true_type {
+};
+
+/// @brief a trait for the number of directions a q-function propagates per evaluation, or 0 if it didn't opt in
+template <typename T>
+struct directions_per_evaluation {
+  static constexpr int value = 0;  ///< the number of directions
+};
+
+/// @overload
+template <int K, typename lambda>
+struct directions_per_evaluation<DirectionalDerivatives<K, lambda>> {
+  static constexpr int value = K;  ///< the number of directions
+};
+
+/**
+ * @brief per-element copies of the inputs to an integral at its most recent linearization point,
+ * used by integrals that recompute their q-function derivatives
+ *
+ * @note copies of this type share the same underlying arrays
+ */
+struct LinearizationPoint {
+  /**
+   * @brief allocate space for the per-element values of another trial space
+   * @param num_elements the number of elements
+   * @param values_per_element how many values are associated with each element
+   */
+  template <ExecutionSpace exec>
+  void allocate(std::size_t num_elements, std::size_t values_per_element)
+  {
+    values.push_back(accelerator::make_shared_array<exec, double>(num_elements * values_per_element,
+                                                                  memory::Subsystem::QFunctionDerivatives));
+    sizes.push_back(values_per_element);
+  }
+
+  /**
+   * @brief copy the per-element values of each trial space in to the saved arrays
+   * @param inputs the values of each trial space for the elements [first_element, first_element + num_elements)
+   * @param first_element the index of the first element described by `inputs`
+   * @param num_elements the number of elements described by `inputs`
+   */
+  template <ExecutionSpace exec>
+  void save(const std::vector<const double*>& inputs, uint32_t first_element, uint32_t num_elements) const
+  {
+    for (std::size_t i = 0; i < values.size(); i++) {
+      const double* from = inputs[i];
+      double*       to   = values[i].get() + first_element * sizes[i];
+      accelerator::forall<exec>(uint32_t(num_elements * sizes[i]),
+                                [=] SERAC_HOST_DEVICE(uint32_t j) { to[j] = from[j]; });
+    }
+  }
+
+  /// @brief the addresses of the saved values for each trial space
+  std::vector<const double*> pointers() const
+  {
+    std::vector<const double*> output(values.size());
+    for (std::size_t i = 0; i < values.size(); i++) {
+      output[i] = values[i].get();
+    }
+    return output;
+  }
+
+  std::vector<std::shared_ptr<double[]>> values;  ///< the per-element values of each trial space
+  std::vector<std::size_t>               sizes;   ///< how many values are stored per element, for each trial space
+};
+
+/**
+ * @brief a trait for detecting derivatives that are zero by construction, i.e. `zero` or tuples whose every entry
+ * is, as when none of the q-function's outputs depend on the argument it was differentiated w.r.t.
+ *
+ * The derivatives of outputs that depend on only some parts of an argument (e.g. a flux that depends on the
+ * gradient of the temperature, but not its value) already have `zero` blocks, which chain_rule() and the element
+ * gradients skip at compile time. Derivatives that are entirely zero aren't stored, and their kernels do nothing.
+ */
+template <typename T>
+struct is_structurally_zero : std::false_type {
+};
+
+/// @overload
+template <>
+struct is_structurally_zero<zero> : std::true_type {
+};
+
+/// @overload
+template <typename... T>
+struct is_structurally_zero<tuple<T...>> : std::bool_constant<(is_structurally_zero<T>::value && ...)> {
+};
+
+/// @brief helper variable template for @p is_structurally_zero
+template <typename T>
+inline constexpr bool is_structurally_zero_v = is_structurally_zero<std::remove_const_t<T>>::value;
+
+/// @brief a trait for detecting q-functions that requested single-precision derivative storage
+template <typename T>
+struct stores_single_precision_derivatives : std::false_type {
+};
+
+/// @overload
+template <typename lambda>
+struct stores_single_precision_derivatives<SinglePrecisionDerivatives<lambda>> : std::true_type {
+};
+
+/// @brief the type obtained by replacing each double in T by a float
+template <typename T>
+struct single_precision {
+  using type = T;  ///< the type with single-precision values
+};
+
+/// @overload
+template <>
+struct single_precision<double> {
+  using type = float;  ///< the type with single-precision values
+};
+
+/// @overload
+template <typename T, int... n>
+struct single_precision<tensor<T, n...>> {
+  using type = tensor<typename single_precision<T>::type, n...>;  ///< the type with single-precision values
+};
+
+/// @overload
+template <typename... T>
+struct single_precision<tuple<T...>> {
+  using type = tuple<typename single_precision<T>::type...>;  ///< the type with single-precision values
+};
+
+/// @brief the type obtained by replacing each float in T by a double
+template <typename T>
+struct double_precision {
+  using type = T;  ///< the type with double-precision values
+};
+
+/// @overload
+template <>
+struct double_precision<float> {
+  using type = double;  ///< the type with double-precision values
+};
+
+/// @overload
+template <typename T, int... n>
+struct double_precision<tensor<T, n...>> {
+  using type = tensor<typename double_precision<T>::type, n...>;  ///< the type with double-precision values
+};
+
+/// @overload
+template <typename... T>
+struct double_precision<tuple<T...>> {
+  using type = tuple<typename double_precision<T>::type...>;  ///< the type with double-precision values
+};
+
+/// @brief helper alias for @p double_precision
+template <typename T>
+using double_precision_t = typename double_precision<T>::type;
+
+/// @brief a trait for detecting q-functions that requested isotropic derivative storage
+template <typename T>
+struct stores_isotropic_derivatives : std::false_type {
+};
+
+/// @overload
+template <typename lambda>
+struct stores_isotropic_derivatives<IsotropicDerivatives<lambda>> : std::true_type {
+};
+
+/// @brief the type obtained by replacing each rank-4 tensor in T by an isotropic_tensor
+template <typename T>
+struct isotropic_storage {
+  using type = T;  ///< the type with isotropic rank-4 tensors
+};
+
+/// @overload
+template <int m>
+struct isotropic_storage<tensor<double, m, m, m, m>> {
+  using type = isotropic_tensor<double, m, m, m, m>;  ///< the type with isotropic rank-4 tensors
+};
+
+/// @overload
+template <typename... T>
+struct isotropic_storage<tuple<T...>> {
+  using type = tuple<typename isotropic_storage<T>::type...>;  ///< the type with isotropic rank-4 tensors
+};
+
+/// @brief the dense, double-precision counterpart of a stored derivative type, as used by the element gradients
+template <typename T>
+struct dense {
+  using type = double_precision_t<T>;  ///< the dense type
+};
+
+/// @overload
+template <typename T, int m>
+struct dense<isotropic_tensor<T, m, m, m, m>> {
+  using type = tensor<double, m, m, m, m>;  ///< the dense type
+};
+
+/// @overload
+template <typename... T>
+struct dense<tuple<T...>> {
+  using type = tuple<typename dense<T>::type...>;  ///< the dense type
+};
+
+/// @brief helper alias for @p dense
+template <typename T>
+using dense_t = typename dense<T>::type;
+
+/**
+ * @brief the type used to store the derivatives of q-function `lambda`
+ * @tparam lambda the type of the q-function
+ * @tparam derivative_type the (double precision) type of the derivatives
+ */
+template <typename lambda, typename derivative_type>
+using derivative_storage_t = std::conditional_t<
+    stores_single_precision_derivatives<std::decay_t<lambda>>::value, typename single_precision<derivative_type>::type,
+    std::conditional_t<stores_isotropic_derivatives<std::decay_t<lambda>>::value,
+                       typename isotropic_storage<derivative_type>::type, derivative_type>>;
+
+/**
+ * @brief copy values between types that differ only in the precision of their entries
+ * @param from the values to copy
+ * @param to the destination
+ */
+template <typename S, typename T>
+SERAC_HOST_DEVICE void precision_copy(const S& from, T& to);
+
+/// @brief convert a single value
+SERAC_HOST_DEVICE inline void precision_copy_entries(const double& from, float& to) { to = static_cast<float>(from); }
+
+/// @overload
+SERAC_HOST_DEVICE inline void precision_copy_entries(const float& from, double& to) { to = from; }
+
+/// @overload
+template <typename S, typename T, int m, int... n>
+SERAC_HOST_DEVICE void precision_copy_entries(const tensor<S, m, n...>& from, tensor<T, m, n...>& to)
+{
+  for (int i = 0; i < m; i++) {
+    precision_copy(from[i], to[i]);
+  }
+}
+
+/// @brief extract the isotropic part of a rank-4 tensor
+template <int m>
+SERAC_HOST_DEVICE void precision_copy_entries(const tensor<double, m, m, m, m>& from,
+                                              isotropic_tensor<double, m, m, m, m>& to)
+{
+  if constexpr (m == 1) {
+    to = {0.0, from[0][0][0][0], 0.0};
+  } else {
+    to = {from[0][0][1][1], from[0][1][0][1] + from[0][1][1][0], from[0][1][0][1] - from[0][1][1][0]};
+  }
+}
+
+/// @brief expand an isotropic rank-4 tensor to its dense form
+template <int m>
+SERAC_HOST_DEVICE void precision_copy_entries(const isotropic_tensor<double, m, m, m, m>& from,
+                                              tensor<double, m, m, m, m>& to)
+{
+  for_constexpr<m, m, m, m>([&](auto i, auto j, auto k, auto l) { to(i, j, k, l) = from(i, j, k, l); });
+}
+
+/// @overload
+template <typename... S, typename... T, int... i>
+SERAC_HOST_DEVICE void precision_copy_entries(const tuple<S...>& from, tuple<T...>& to,
+                                              std::integer_sequence<int, i...>)
+{
+  (precision_copy(get<i>(from), get<i>(to)), ...);
+}
+
+/// @overload
+template <typename... S, typename... T>
+SERAC_HOST_DEVICE void precision_copy_entries(const tuple<S...>& from, tuple<T...>& to)
+{
+  static_assert(sizeof...(S) == sizeof...(T));
+  precision_copy_entries(from, to, std::make_integer_sequence<int, int(sizeof...(S))>{});
+}
+
+template <typename S, typename T>
+SERAC_HOST_DEVICE void precision_copy(const S& from, T& to)
+{
+  if constexpr (std::is_same_v<S, T>) {
+    to = from;
+  } else {
+    precision_copy_entries(from, to);
+  }
+}
+
+/**
+ * @brief load a (possibly single-precision) stored derivative as its double-precision counterpart
+ * @param stored the stored derivative
+ */
+template <typename T>
+SERAC_HOST_DEVICE double_precision_t<T> to_double_precision(const T& stored)
+{
+  if constexpr (std::is_same_v<double_precision_t<T>, T>) {
+    return stored;
+  } else {
+    double_precision_t<T> value{};
+    precision_copy(stored, value);
+    return value;
+  }
+}
+
+/**
+ * @brief load a stored derivative (possibly single-precision, possibly isotropic) as its dense, double-precision
+ * counterpart
+ * @param stored the stored derivative
+ */
+template <typename T>
+SERAC_HOST_DEVICE dense_t<T> to_dense(const T& stored)
+{
+  if constexpr (std::is_same_v<dense_t<T>, T>) {
+    return stored;
+  } else {
+    dense_t<T> value{};
+    precision_copy(stored, value);
+    return value;
+  }
+}
+
+}  // namespace detail
+
+}  // namespace serac
@@ -0,0 +1,121 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file element_constant.inl
+ *
+ * @brief Interpolation and integration for the piecewise constant (L2, p = 0) elements
+ */
+
+// An L2 element of order 0 has a single shape function, equal to 1 everywhere on the element, so
+// interpolation is just a broadcast of its one value per component to the quadrature points (with a
+// zero gradient), and integration a quadrature-weighted sum of the sources (the fluxes are multiplied
+// by the zero gradient, and drop out). The L2 elements use these instead of their general
+// sum-factorized or tabulated kernels for p = 0, e.g. for piecewise constant design parameters.
+/// @cond
+namespace detail {
+
+/**
+ * @brief the quadrature weights of each point of a rule, in the order of the quadrature point data
+ *
+ * @tparam geom the element geometry
+ * @tparam q the parameter of the quadrature rule
+ */
+template <mfem::Geometry::Type geom, int q>
+constexpr auto element_constant_weights()
+{
+  if constexpr (geom == mfem::Geometry::SQUARE || geom == mfem::Geometry::CUBE) {
+    constexpr int  dim   = (geom == mfem::Geometry::SQUARE) ? 2 : 3;
+    constexpr int  nqpts = num_quadrature_points(geom, q);
+    constexpr int  nz    = (dim == 3) ? q : 1;
+    constexpr auto w_1D  = GaussLegendreWeights<q, mfem::Geometry::SEGMENT>();
+
+    tensor<double, nqpts> weights{};
+    for (int qz = 0; qz < nz; qz++) {
+      for (int qy = 0; qy < q; qy++) {
+        for (int qx = 0; qx < q; qx++) {
+          weights[(qz * q + qy) * q + qx] = w_1D[qx] * w_1D[qy] * ((dim == 3) ? w_1D[qz] : 1.0);
+        }
+      }
+    }
+    return weights;
+  } else {
+    return GaussLegendreWeights<q, geom>();
+  }
+}
+
+/**
+ * @brief the values and (zero) parent-space gradients of each component of a piecewise constant element at its
+ * quadrature points
+ *
+ * @tparam element_type the finite element
+ * @tparam nqpts the number of quadrature points
+ * @param X the values of the element dofs, one per component
+ */
+template <typename element_type, int nqpts, typename dof_type>
+SERAC_HOST_DEVICE auto element_constant_interpolate(const dof_type& X)
+{
+  constexpr int c   = element_type::components;
+  constexpr int dim = element_type::dim;
+
+  static_assert(element_type::ndof == 1, "element_constant_interpolate() requires an element with a single dof");
+
+  union {
+    tensor<tuple<tensor<double, c>, tensor<double, c, dim> >, nqpts> unflattened;
+    tensor<typename element_type::qf_input_type, nqpts>             flattened;
+  } output{};
+
+  const double* values = reinterpret_cast<const double*>(&X);
+  for (int j = 0; j < nqpts; j++) {
+    for (int i = 0; i < c; i++) {
+      get<0>(output.unflattened[j])[i] = values[i];
+    }
+  }
+
+  return output.flattened;
+}
+
+/**
+ * @brief integrates the sources at the quadrature points of a piecewise constant element against its shape function
+ *
+ * @tparam element_type the finite element
+ * @tparam q the parameter of the quadrature rule
+ * @param qf_output the sources and fluxes at each quadrature point
+ * @param element_residual the residual(s) to add the integrals to
+ * @param step the stride between the residuals of consecutive trial directions
+ */
+template <typename element_type, int q, typename source_type, typename flux_type, int nqpts, typename dof_type>
+SERAC_HOST_DEVICE void element_constant_integrate(const tensor<tuple<source_type, flux_type>, nqpts>& qf_output,
+                                                  dof_type* element_residual, int step)
+{
+  if constexpr (is_zero<source_type>{}) {
+    return;
+  } else {
+    constexpr int SOURCE = 0;
+
+    constexpr int c      = element_type::components;
+    constexpr int dim    = element_type::dim;
+    constexpr int ntrial = std::max(size(source_type{}), size(flux_type{}) / dim) / c;
+
+    static_assert(element_type::ndof == 1, "element_constant_integrate() requires an element with a single dof");
+
+    static constexpr auto weights = element_constant_weights<element_type::geometry, q>();
+
+    for (int j = 0; j < ntrial; j++) {
+      double* residual = reinterpret_cast<double*>(&element_residual[j * step]);
+      for (int i = 0; i < c; i++) {
+        double sum = 0.0;
+        for (int Q = 0; Q < nqpts; Q++) {
+          sum += weights[Q] * reinterpret_cast<const double*>(&get<SOURCE>(qf_output[Q]))[i * ntrial + j];
+        }
+        residual[i] += sum;
+      }
+    }
+  }
+}
+
+}  // namespace detail
+/// @endcond
@@ -255,12 +255,13 @@ struct finite_element<mfem::Geometry::CUBE, Hcurl<p>> {
   }
 
   template <typename in_t, int q>
-  static auto batch_apply_shape_fn(int j, tensor<in_t, q * q * q> input, const TensorProductQuadratureRule<q>&)
+  static SERAC_HOST_DEVICE auto batch_apply_shape_fn(int j, tensor<in_t, q * q * q> input,
+                                                     const TensorProductQuadratureRule<q>&)
   {
-    constexpr bool                     apply_weights = false;
-    constexpr tensor<double, q, p>     B1            = calculate_B1<apply_weights, q>();
-    constexpr tensor<double, q, p + 1> B2            = calculate_B2<apply_weights, q>();
-    constexpr tensor<double, q, p + 1> G2            = calculate_G2<apply_weights, q>();
+    static constexpr bool apply_weights = false;
+    static constexpr auto B1            = calculate_B1<apply_weights, q>();
+    static constexpr auto B2            = calculate_B2<apply_weights, q>();
+    static constexpr auto G2            = calculate_G2<apply_weights, q>();
 
     // figure out which node and which direction
     // correspond to the dof index "j"
@@ -334,12 +335,12 @@ struct finite_element<mfem::Geometry::CUBE, Hcurl<p>> {
   }
 
   template <int q>
-  static auto interpolate(const dof_type& element_values, const TensorProductQuadratureRule<q>&)
+  static SERAC_HOST_DEVICE auto interpolate(const dof_type& element_values, const TensorProductQuadratureRule<q>&)
   {
-    constexpr bool                     apply_weights = false;
-    constexpr tensor<double, q, p>     B1            = calculate_B1<apply_weights, q>();
-    constexpr tensor<double, q, p + 1> B2            = calculate_B2<apply_weights, q>();
-    constexpr tensor<double, q, p + 1> G2            = calculate_G2<apply_weights, q>();
+    static constexpr bool apply_weights = false;
+    static constexpr auto B1            = calculate_B1<apply_weights, q>();
+    static constexpr auto B2            = calculate_B2<apply_weights, q>();
+    static constexpr auto G2            = calculate_G2<apply_weights, q>();
 
     tensor<tensor<double, q, q, q>, 3> value{};
     tensor<tensor<double, q, q, q>, 3> curl{};
@@ -395,66 +396,78 @@ struct finite_element<mfem::Geometry::CUBE, Hcurl<p>> {
   }
 
   template <typename source_type, typename flux_type, int q>
-  static void integrate(const tensor<tuple<source_type, flux_type>, q * q * q>& qf_output,
-                        const TensorProductQuadratureRule<q>&, dof_type* element_residual,
-                        [[maybe_unused]] int step = 1)
+  static SERAC_HOST_DEVICE void integrate(const tensor<tuple<source_type, flux_type>, q * q * q>& qf_output,
+                                          const TensorProductQuadratureRule<q>&, dof_type* element_residual,
+                                          int step = 1)
   {
-    constexpr bool                     apply_weights = true;
-    constexpr tensor<double, q, p>     B1            = calculate_B1<apply_weights, q>();
-    constexpr tensor<double, q, p + 1> B2            = calculate_B2<apply_weights, q>();
-    constexpr tensor<double, q, p + 1> G2            = calculate_G2<apply_weights, q>();
-
-    tensor<double, 3, q, q, q> source{};
-    tensor<double, 3, q, q, q> flux{};
-
-    for (int qz = 0; qz < q; qz++) {
-      for (int qy = 0; qy < q; qy++) {
-        for (int qx = 0; qx < q; qx++) {
-          int               k = (qz * q + qy) * q + qx;
-          tensor<double, 3> s{get<SOURCE>(qf_output[k])};
-          tensor<double, 3> f{get<FLUX>(qf_output[k])};
-          for (int i = 0; i < 3; i++) {
-            source(i, qz, qy, qx) = s[i];
-            flux(i, qz, qy, qx)   = f[i];
+    if constexpr (is_zero<source_type>{} && is_zero<flux_type>{}) {
+      return;
+    } else {
+      // the sources and fluxes may describe several trial directions (e.g. the columns of an element gradient),
+      // whose residuals are `step` apart
+      constexpr int ntrial = std::max(size(source_type{}), size(flux_type{})) / dim;
+
+      static constexpr bool apply_weights = true;
+      static constexpr auto B1            = calculate_B1<apply_weights, q>();
+      static constexpr auto B2            = calculate_B2<apply_weights, q>();
+      static constexpr auto G2            = calculate_G2<apply_weights, q>();
+
+      for (int j = 0; j < ntrial; j++) {
+        tensor<double, 3, q, q, q> source{};
+        tensor<double, 3, q, q, q> flux{};
+
+        for (int qz = 0; qz < q; qz++) {
+          for (int qy = 0; qy < q; qy++) {
+            for (int qx = 0; qx < q; qx++) {
+              int k = (qz * q + qy) * q + qx;
+              for (int i = 0; i < 3; i++) {
+                if constexpr (!is_zero<source_type>{}) {
+                  source(i, qz, qy, qx) = reinterpret_cast<const double*>(&get<SOURCE>(qf_output[k]))[i * ntrial + j];
+                }
+                if constexpr (!is_zero<flux_type>{}) {
+                  flux(i, qz, qy, qx) = reinterpret_cast<const double*>(&get<FLUX>(qf_output[k]))[i * ntrial + j];
+                }
+              }
+            }
           }
         }
-      }
-    }
-
-    // to clarify which contractions correspond to which spatial dimensions
-    constexpr int x = 2, y = 1, z = 0;
 
-    // clang-format off
-    //  r(0, dz, dy, dx) = s(0, qz, qy, qx) * B2(qz, dz) * B2(qy, dy) * B1(qx, dx)
-    //                   + f(1, qz, qy, qx) * G2(qz, dz) * B2(qy, dy) * B1(qx, dx)
-    //                   - f(2, qz, qy, qx) * B2(qz, dz) * G2(qy, dy) * B1(qx, dx);
-    {
-      auto A20 = contract< z, 0 >(source[0], B2) + contract< z, 0 >(flux[1], G2);
-      auto A21 = contract< z, 0 >(flux[2], B2);
-      auto A1 = contract< y, 0 >(A20, B2) - contract< y, 0 >(A21, G2);
-      element_residual[0].x += contract< x, 0 >(A1, B1);
-    }
+        // to clarify which contractions correspond to which spatial dimensions
+        constexpr int x = 2, y = 1, z = 0;
+
+        // clang-format off
+        //  r(0, dz, dy, dx) = s(0, qz, qy, qx) * B2(qz, dz) * B2(qy, dy) * B1(qx, dx)
+        //                   + f(1, qz, qy, qx) * G2(qz, dz) * B2(qy, dy) * B1(qx, dx)
+        //                   - f(2, qz, qy, qx) * B2(qz, dz) * G2(qy, dy) * B1(qx, dx);
+        {
+          auto A20 = contract< z, 0 >(source[0], B2) + contract< z, 0 >(flux[1], G2);
+          auto A21 = contract< z, 0 >(flux[2], B2);
+          auto A1 = contract< y, 0 >(A20, B2) - contract< y, 0 >(A21, G2);
+          element_residual[j * step].x += contract< x, 0 >(A1, B1);
+        }
 
-    //  r(1, dz, dy, dx) = s(1, qz, qy, qx) * B2(qz, dz) * B1(qy, dy) * B2(qx, dx)
-    //                   - f(0, qz, qy, qx) * G2(qz, dz) * B1(qy, dy) * B2(qx, dx)
-    //                   + f(2, qz, qy, qx) * B2(qz, dz) * B1(qy, dy) * G2(qx, dx);
-    {
-      auto A20 = contract< x, 0 >(source[1], B2) + contract< x, 0 >(flux[2], G2);
-      auto A21 = contract< x, 0 >(flux[0], B2);
-      auto A1 = contract< z, 0 >(A20, B2) - contract< z, 0 >(A21, G2);
-      element_residual[0].y += contract< y, 0 >(A1, B1);
-    }
+        //  r(1, dz, dy, dx) = s(1, qz, qy, qx) * B2(qz, dz) * B1(qy, dy) * B2(qx, dx)
+        //                   - f(0, qz, qy, qx) * G2(qz, dz) * B1(qy, dy) * B2(qx, dx)
+        //                   + f(2, qz, qy, qx) * B2(qz, dz) * B1(qy, dy) * G2(qx, dx);
+        {
+          auto A20 = contract< x, 0 >(source[1], B2) + contract< x, 0 >(flux[2], G2);
+          auto A21 = contract< x, 0 >(flux[0], B2);
+          auto A1 = contract< z, 0 >(A20, B2) - contract< z, 0 >(A21, G2);
+          element_residual[j * step].y += contract< y, 0 >(A1, B1);
+        }
 
-    //  r(2, dz, dy, dx) = s(2, qz, qy, qx) * B1(qz, dz) * B2(qy, dy) * B2(qx, dx) 
-    //                   + f(0, qz, qy, qx) * B1(qz, dz) * G2(qy, dy) * B2(qx, dx) 
-    //                   - f(1, qz, qy, qx) * B1(qz, dz) * B2(qy, dy) * G2(qx, dx);
-    {
-      auto A20 = contract< y, 0 >(source[2], B2) + contract< y, 0 >(flux[0], G2);
-      auto A21 = contract< y, 0 >(flux[1], B2);
-      auto A1 = contract< x, 0 >(A20, B2) - contract< x, 0 >(A21, G2);
-      element_residual[0].z += contract< z, 0 >(A1, B1);
+        //  r(2, dz, dy, dx) = s(2, qz, qy, qx) * B1(qz, dz) * B2(qy, dy) * B2(qx, dx)
+        //                   + f(0, qz, qy, qx) * B1(qz, dz) * G2(qy, dy) * B2(qx, dx)
+        //                   - f(1, qz, qy, qx) * B1(qz, dz) * B2(qy, dy) * G2(qx, dx);
+        {
+          auto A20 = contract< y, 0 >(source[2], B2) + contract< y, 0 >(flux[0], G2);
+          auto A21 = contract< y, 0 >(flux[1], B2);
+          auto A1 = contract< x, 0 >(A20, B2) - contract< x, 0 >(A21, G2);
+          element_residual[j * step].z += contract< z, 0 >(A1, B1);
+        }
+        // clang-format on
+      }
     }
-    // clang-format on
   }
 
   //////////////////////////////////////////////////////////////////////////////////////////////////////
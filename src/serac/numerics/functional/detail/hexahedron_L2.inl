@@ -134,7 +134,8 @@ struct finite_element<mfem::Geometry::CUBE, L2<p, c> > {
   }
 
   template <typename in_t, int q>
-  static auto batch_apply_shape_fn(int j, tensor<in_t, q * q * q> input, const TensorProductQuadratureRule<q>&)
+  static SERAC_HOST_DEVICE auto batch_apply_shape_fn(int j, tensor<in_t, q * q * q> input,
+                                                     const TensorProductQuadratureRule<q>&)
   {
     static constexpr bool apply_weights = false;
     static constexpr auto B             = calculate_B<apply_weights, q>();
@@ -171,8 +172,12 @@ struct finite_element<mfem::Geometry::CUBE, L2<p, c> > {
   }
 
   template <int q>
-  static auto interpolate(const dof_type& X, const TensorProductQuadratureRule<q>&)
+  static SERAC_HOST_DEVICE auto interpolate(const dof_type& X, const TensorProductQuadratureRule<q>&)
   {
+    if constexpr (p == 0) {
+      return detail::element_constant_interpolate<finite_element, num_quadrature_points(geometry, q)>(X);
+    }
+
     // we want to compute the following:
     //
     // X_q(u, v, w) := (B(u, i) * B(v, j) * B(w, k)) * X_e(i, j, k)
@@ -232,13 +237,18 @@ struct finite_element<mfem::Geometry::CUBE, L2<p, c> > {
   }
 
   template <typename source_type, typename flux_type, int q>
-  static void integrate(const tensor<tuple<source_type, flux_type>, q * q * q>& qf_output,
-                        const TensorProductQuadratureRule<q>&, dof_type* element_residual, int step = 1)
+  static SERAC_HOST_DEVICE void integrate(const tensor<tuple<source_type, flux_type>, q * q * q>& qf_output,
+                                          const TensorProductQuadratureRule<q>&, dof_type* element_residual,
+                                          int step = 1)
   {
     if constexpr (is_zero<source_type>{} && is_zero<flux_type>{}) {
       return;
     }
 
+    if constexpr (p == 0) {
+      return detail::element_constant_integrate<finite_element, q>(qf_output, element_residual, step);
+    }
+
     constexpr int ntrial = std::max(size(source_type{}), size(flux_type{}) / dim) / c;
 
     using s_buffer_type = std::conditional_t<is_zero<source_type>{}, zero, tensor<double, q, q, q> >;
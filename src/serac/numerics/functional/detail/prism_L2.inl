@@ -0,0 +1,110 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file prism_L2.inl
+ *
+ * @brief Specialization of finite_element for L2 on prism geometry
+ */
+
+// this specialization defines shape functions (and their gradients) that are the products of the
+// L2 triangle shape functions of the same order and the 1D Gauss-Lobatto interpolating polynomials
+// in the extruded direction, numbered with the triangle nodes fastest (see prism_basis.inl)
+//
+// note: mfem assumes the parent element domain is the triangle {{0,0}, {1,0}, {0,1}} extruded over [0,1]
+// for additional information on the finite_element concept requirements, see finite_element.hpp
+/// @cond
+template <int p, int c>
+struct finite_element<mfem::Geometry::PRISM, L2<p, c> > {
+  static constexpr auto geometry   = mfem::Geometry::PRISM;
+  static constexpr auto family     = Family::L2;
+  static constexpr int  components = c;
+  static constexpr int  dim        = 3;
+  static constexpr int  n          = (p + 1);
+  static constexpr int  ndof       = (p + 1) * (p + 1) * (p + 2) / 2;
+  static constexpr int  order      = p;
+  static constexpr int  nqpts(int q) { return num_quadrature_points(mfem::Geometry::PRISM, q); }
+
+  static constexpr int VALUE = 0, GRADIENT = 1;
+  static constexpr int SOURCE = 0, FLUX = 1;
+
+  /// the element on each cross-section of the prism
+  using triangle_element = finite_element<mfem::Geometry::TRIANGLE, L2<p> >;
+
+  using residual_type =
+      typename std::conditional<components == 1, tensor<double, ndof>, tensor<double, ndof, components> >::type;
+
+  using dof_type = tensor<double, c, ndof>;
+
+  using value_type = typename std::conditional<components == 1, double, tensor<double, components> >::type;
+  using derivative_type =
+      typename std::conditional<components == 1, tensor<double, dim>, tensor<double, components, dim> >::type;
+  using qf_input_type = tuple<value_type, derivative_type>;
+
+  SERAC_HOST_DEVICE static constexpr double shape_function(tensor<double, dim> xi, int i)
+  {
+    constexpr int ntri = triangle_element::ndof;
+    return triangle_element::shape_function({xi[0], xi[1]}, i % ntri) * GaussLobattoInterpolation<n>(xi[2])[i / ntri];
+  }
+
+  SERAC_HOST_DEVICE static constexpr tensor<double, dim> shape_function_gradient(tensor<double, dim> xi, int i)
+  {
+    constexpr int ntri = triangle_element::ndof;
+    double        T    = triangle_element::shape_function({xi[0], xi[1]}, i % ntri);
+    auto          dT   = triangle_element::shape_function_gradient({xi[0], xi[1]}, i % ntri);
+    double        N    = GaussLobattoInterpolation<n>(xi[2])[i / ntri];
+    double        dN   = GaussLobattoInterpolationDerivative<n>(xi[2])[i / ntri];
+    return {dT[0] * N, dT[1] * N, T * dN};
+  }
+
+  SERAC_HOST_DEVICE static constexpr tensor<double, ndof> shape_functions(tensor<double, dim> xi)
+  {
+    tensor<double, ndof> output{};
+    for (int i = 0; i < ndof; i++) {
+      output[i] = shape_function(xi, i);
+    }
+    return output;
+  }
+
+  SERAC_HOST_DEVICE static constexpr tensor<double, ndof, dim> shape_function_gradients(tensor<double, dim> xi)
+  {
+    tensor<double, ndof, dim> output{};
+    for (int i = 0; i < ndof; i++) {
+      output[i] = shape_function_gradient(xi, i);
+    }
+    return output;
+  }
+
+  template <typename in_t, int q>
+  static SERAC_HOST_DEVICE auto batch_apply_shape_fn(int j, tensor<in_t, nqpts(q)> input,
+                                                     const TensorProductQuadratureRule<q>&)
+  {
+    return detail::simplex_batch_apply_shape_fn<finite_element, q>(j, input);
+  }
+
+  template <int q>
+  static SERAC_HOST_DEVICE auto interpolate(const tensor<double, c, ndof>& X, const TensorProductQuadratureRule<q>&)
+  {
+    if constexpr (p == 0) {
+      return detail::element_constant_interpolate<finite_element, num_quadrature_points(geometry, q)>(X);
+    }
+
+    return detail::prism_interpolate<finite_element, q>(X);
+  }
+
+  template <typename source_type, typename flux_type, int q>
+  static SERAC_HOST_DEVICE void integrate(const tensor<tuple<source_type, flux_type>, nqpts(q)>& qf_output,
+                                          const TensorProductQuadratureRule<q>&,
+                                          tensor<double, c, ndof>* element_residual, int step = 1)
+  {
+    if constexpr (p == 0) {
+      detail::element_constant_integrate<finite_element, q>(qf_output, element_residual, step);
+    } else {
+      detail::prism_integrate<finite_element, q>(qf_output, element_residual, step);
+    }
+  }
+};
+/// @endcond
@@ -0,0 +1,199 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file prism_basis.inl
+ *
+ * @brief Sum-factorized interpolation and integration for the elements on prisms
+ */
+
+// The shape functions of the H1 and L2 elements on prisms are products of the shape functions of the
+// triangle element of the same order and the 1D Gauss-Lobatto interpolating polynomials in the extruded
+// direction, with the triangle dofs numbered fastest:
+//
+//   phi_{t + ntri * k}(xi) = T_t(xi_0, xi_1) * N_k(xi_2)
+//
+// Their quadrature rules are the products of the triangle and segment rules (with the triangle points
+// numbered fastest, see GaussLegendreNodes), so interpolation and integration can be carried out one
+// direction at a time, like for the tensor product elements: the dofs are first contracted with the 1D
+// polynomials in the extruded direction, and the result with the tabulated triangle basis (see
+// simplex_basis.inl) on each cross-section:
+//
+//   A(i, qz, t)           := sum_k X_e(i, t + ntri * k) * N(qz, k)
+//   X_q(i, qt + nt * qz)  := sum_t A(i, qz, t) * T(qt, t)
+//
+// which takes O(q * ntri * (n + nt)) operations per component, instead of the O(q * nt * n * ntri) of
+// a tabulation of the full prism basis.
+/// @cond
+namespace detail {
+
+/**
+ * @brief the values N(0, i, k) and derivatives N(1, i, k) of the kth 1D Gauss-Lobatto interpolating polynomial,
+ * used in the extruded direction of the prism elements, at the ith point of a 1D Gauss-Legendre rule
+ *
+ * @tparam n the number of interpolating polynomials
+ * @tparam q the number of quadrature points
+ * @tparam apply_weights optionally multiply the entries by the associated quadrature weight
+ */
+template <int n, int q, bool apply_weights>
+constexpr auto calculate_extrusion_basis()
+{
+  constexpr auto                  points1D  = GaussLegendreNodes<q, mfem::Geometry::SEGMENT>();
+  [[maybe_unused]] constexpr auto weights1D = GaussLegendreWeights<q, mfem::Geometry::SEGMENT>();
+
+  tensor<double, 2, q, n> N{};
+  for (int i = 0; i < q; i++) {
+    N[0][i] = GaussLobattoInterpolation<n>(points1D[i]);
+    N[1][i] = GaussLobattoInterpolationDerivative<n>(points1D[i]);
+    if constexpr (apply_weights) {
+      N[0][i] = N[0][i] * weights1D[i];
+      N[1][i] = N[1][i] * weights1D[i];
+    }
+  }
+  return N;
+}
+
+/**
+ * @brief the values and parent-space gradients of each component of a prism element at its quadrature points
+ *
+ * @tparam element_type the finite element
+ * @tparam q the parameter of the quadrature rule
+ * @param X the values of the element dofs
+ */
+template <typename element_type, int q>
+SERAC_HOST_DEVICE auto prism_interpolate(const tensor<double, element_type::components, element_type::ndof>& X)
+{
+  using triangle_element = typename element_type::triangle_element;
+
+  constexpr int c     = element_type::components;
+  constexpr int dim   = element_type::dim;
+  constexpr int n     = element_type::n;
+  constexpr int ntri  = triangle_element::ndof;
+  constexpr int nt    = num_quadrature_points(mfem::Geometry::TRIANGLE, q);
+  constexpr int nqpts = num_quadrature_points(mfem::Geometry::PRISM, q);
+
+  static constexpr auto T = calculate_simplex_basis_table<triangle_element, false, q>();
+  static constexpr auto N = calculate_extrusion_basis<n, q, false>();
+
+  // transpose the quadrature data into a flat tensor of tuples
+  union {
+    tensor<tuple<tensor<double, c>, tensor<double, c, dim> >, nqpts> unflattened;
+    tensor<typename element_type::qf_input_type, nqpts>             flattened;
+  } output{};
+
+  for (int i = 0; i < c; i++) {
+    for (int qz = 0; qz < q; qz++) {
+      // the values (A0) and derivatives in the extruded direction (A1) of each triangle node on this cross-section
+      double A0[ntri]{};
+      double A1[ntri]{};
+      for (int k = 0; k < n; k++) {
+        for (int t = 0; t < ntri; t++) {
+          A0[t] += X(i, k * ntri + t) * N[0][qz][k];
+          A1[t] += X(i, k * ntri + t) * N[1][qz][k];
+        }
+      }
+
+      for (int qt = 0; qt < nt; qt++) {
+        const double* T_value = T.entries[qt * 3];
+        const double* T_dxi   = T.entries[qt * 3 + 1];
+        const double* T_deta  = T.entries[qt * 3 + 2];
+
+        double values[dim + 1]{};
+        for (int t = 0; t < ntri; t++) {
+          values[0] += A0[t] * T_value[t];
+          values[1] += A0[t] * T_dxi[t];
+          values[2] += A0[t] * T_deta[t];
+          values[3] += A1[t] * T_value[t];
+        }
+
+        int Q                            = qz * nt + qt;
+        get<0>(output.unflattened[Q])[i] = values[0];
+        for (int d = 0; d < dim; d++) {
+          get<1>(output.unflattened[Q])[i][d] = values[1 + d];
+        }
+      }
+    }
+  }
+
+  return output.flattened;
+}
+
+/**
+ * @brief integrates the sources and fluxes at the quadrature points of a prism element against its shape functions
+ *
+ * @tparam element_type the finite element
+ * @tparam q the parameter of the quadrature rule
+ * @param qf_output the sources and fluxes at each quadrature point
+ * @param element_residual the residual(s) to add the integrals to
+ * @param step the stride between the residuals of consecutive trial directions
+ */
+template <typename element_type, int q, typename source_type, typename flux_type, int nqpts>
+SERAC_HOST_DEVICE void prism_integrate(const tensor<tuple<source_type, flux_type>, nqpts>& qf_output,
+                                       tensor<double, element_type::components, element_type::ndof>* element_residual,
+                                       int step)
+{
+  if constexpr (is_zero<source_type>{} && is_zero<flux_type>{}) {
+    return;
+  } else {
+    using triangle_element = typename element_type::triangle_element;
+
+    constexpr int SOURCE = 0;
+    constexpr int FLUX   = 1;
+
+    constexpr int c      = element_type::components;
+    constexpr int dim    = element_type::dim;
+    constexpr int n      = element_type::n;
+    constexpr int ntri   = triangle_element::ndof;
+    constexpr int nt     = num_quadrature_points(mfem::Geometry::TRIANGLE, q);
+    constexpr int ntrial = std::max(size(source_type{}), size(flux_type{}) / dim) / c;
+
+    static constexpr auto W = calculate_simplex_basis_table<triangle_element, true, q>();
+    static constexpr auto N = calculate_extrusion_basis<n, q, true>();
+
+    for (int j = 0; j < ntrial; j++) {
+      for (int i = 0; i < c; i++) {
+        auto& residual = element_residual[j * step][i];
+        for (int qz = 0; qz < q; qz++) {
+          // the integrals over this cross-section against the values (S0) and the derivatives
+          // in the extruded direction (S1) of the 1D polynomials
+          double S0[ntri]{};
+          double S1[ntri]{};
+          for (int qt = 0; qt < nt; qt++) {
+            int Q = qz * nt + qt;
+
+            if constexpr (!is_zero<source_type>{}) {
+              double        source = reinterpret_cast<const double*>(&get<SOURCE>(qf_output[Q]))[i * ntrial + j];
+              const double* row    = W.entries[qt * 3];
+              for (int t = 0; t < ntri; t++) {
+                S0[t] += source * row[t];
+              }
+            }
+
+            if constexpr (!is_zero<flux_type>{}) {
+              const double* fluxes = reinterpret_cast<const double*>(&get<FLUX>(qf_output[Q]));
+              double        f0     = fluxes[(i * dim + 0) * ntrial + j];
+              double        f1     = fluxes[(i * dim + 1) * ntrial + j];
+              double        f2     = fluxes[(i * dim + 2) * ntrial + j];
+              for (int t = 0; t < ntri; t++) {
+                S0[t] += f0 * W.entries[qt * 3 + 1][t] + f1 * W.entries[qt * 3 + 2][t];
+                S1[t] += f2 * W.entries[qt * 3][t];
+              }
+            }
+          }
+
+          for (int k = 0; k < n; k++) {
+            for (int t = 0; t < ntri; t++) {
+              residual[k * ntri + t] += S0[t] * N[0][qz][k] + S1[t] * N[1][qz][k];
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+}  // namespace detail
+/// @endcond
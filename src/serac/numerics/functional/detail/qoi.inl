@@ -24,15 +24,15 @@ struct finite_element<g, QOI> {
   SERAC_HOST_DEVICE static constexpr double shape_functions(double /* xi */) { return 1.0; }
 
   template <int Q, int q>
-  static void integrate(const tensor<zero, Q>&, const TensorProductQuadratureRule<q>&, dof_type*,
-                        [[maybe_unused]] int step = 1)
+  static SERAC_HOST_DEVICE void integrate(const tensor<zero, Q>&, const TensorProductQuadratureRule<q>&, dof_type*,
+                                          [[maybe_unused]] int step = 1)
   {
     return;  // integrating zeros is a no-op
   }
 
   template <int Q, int q>
-  static void integrate(const tensor<double, Q>& qf_output, const TensorProductQuadratureRule<q>&,
-                        dof_type* element_total, [[maybe_unused]] int step = 1)
+  static SERAC_HOST_DEVICE void integrate(const tensor<double, Q>& qf_output, const TensorProductQuadratureRule<q>&,
+                                          dof_type* element_total, [[maybe_unused]] int step = 1)
   {
     if constexpr (geometry == mfem::Geometry::SEGMENT) {
       static_assert(Q == q);
@@ -66,7 +66,8 @@ struct finite_element<g, QOI> {
       }
     }
 
-    if constexpr (geometry == mfem::Geometry::TRIANGLE || geometry == mfem::Geometry::TETRAHEDRON) {
+    if constexpr (geometry == mfem::Geometry::TRIANGLE || geometry == mfem::Geometry::TETRAHEDRON ||
+                  geometry == mfem::Geometry::PRISM) {
       static constexpr auto wts = GaussLegendreWeights<q, geometry>();
       for (int k = 0; k < leading_dimension(wts); k++) {
         element_total[0] += qf_output[k] * wts[k];
@@ -77,8 +78,9 @@ struct finite_element<g, QOI> {
   // this overload is used for boundary integrals, since they pad the
   // output to be a tuple with a hardcoded `zero` flux term
   template <typename source_type, int Q, int q>
-  static void integrate(const tensor<serac::tuple<source_type, zero>, Q>& qf_output,
-                        const TensorProductQuadratureRule<q>&, dof_type* element_total, [[maybe_unused]] int step = 1)
+  static SERAC_HOST_DEVICE void integrate(const tensor<serac::tuple<source_type, zero>, Q>& qf_output,
+                                          const TensorProductQuadratureRule<q>&, dof_type* element_total,
+                                          [[maybe_unused]] int step = 1)
   {
     if constexpr (is_zero<source_type>{}) {
       return;
@@ -120,7 +122,8 @@ struct finite_element<g, QOI> {
         }
       }
 
-      if constexpr (geometry == mfem::Geometry::TRIANGLE || geometry == mfem::Geometry::TETRAHEDRON) {
+      if constexpr (geometry == mfem::Geometry::TRIANGLE || geometry == mfem::Geometry::TETRAHEDRON ||
+                    geometry == mfem::Geometry::PRISM) {
         static constexpr auto wts = GaussLegendreWeights<q, geometry>();
         for (int k = 0; k < leading_dimension(wts); k++) {
           element_total[j * step] += reinterpret_cast<const double*>(&get<0>(qf_output[k]))[j] * wts[k];
@@ -243,12 +243,13 @@ struct finite_element<mfem::Geometry::SQUARE, Hcurl<p> > {
   }
 
   template <typename in_t, int q>
-  static auto batch_apply_shape_fn(int j, tensor<in_t, q * q> input, const TensorProductQuadratureRule<q>&)
+  static SERAC_HOST_DEVICE auto batch_apply_shape_fn(int j, tensor<in_t, q * q> input,
+                                                     const TensorProductQuadratureRule<q>&)
   {
-    constexpr bool                     apply_weights = false;
-    constexpr tensor<double, q, p>     B1            = calculate_B1<apply_weights, q>();
-    constexpr tensor<double, q, p + 1> B2            = calculate_B2<apply_weights, q>();
-    constexpr tensor<double, q, p + 1> G2            = calculate_G2<apply_weights, q>();
+    static constexpr bool apply_weights = false;
+    static constexpr auto B1            = calculate_B1<apply_weights, q>();
+    static constexpr auto B2            = calculate_B2<apply_weights, q>();
+    static constexpr auto G2            = calculate_G2<apply_weights, q>();
 
     int jx, jy;
     int dir = j / ((p + 1) * p);
@@ -285,12 +286,12 @@ struct finite_element<mfem::Geometry::SQUARE, Hcurl<p> > {
   }
 
   template <int q>
-  static auto interpolate(const dof_type& element_values, const TensorProductQuadratureRule<q>&)
+  static SERAC_HOST_DEVICE auto interpolate(const dof_type& element_values, const TensorProductQuadratureRule<q>&)
   {
-    constexpr bool                     apply_weights = false;
-    constexpr tensor<double, q, p>     B1            = calculate_B1<apply_weights, q>();
-    constexpr tensor<double, q, p + 1> B2            = calculate_B2<apply_weights, q>();
-    constexpr tensor<double, q, p + 1> G2            = calculate_G2<apply_weights, q>();
+    static constexpr bool apply_weights = false;
+    static constexpr auto B1            = calculate_B1<apply_weights, q>();
+    static constexpr auto B2            = calculate_B2<apply_weights, q>();
+    static constexpr auto G2            = calculate_G2<apply_weights, q>();
 
     tensor<double, 2, q, q> value{};
     tensor<double, q, q>    curl{};
@@ -323,37 +324,50 @@ struct finite_element<mfem::Geometry::SQUARE, Hcurl<p> > {
   }
 
   template <typename source_type, typename flux_type, int q>
-  static void integrate(const tensor<tuple<source_type, flux_type>, q * q>& qf_output,
-                        const TensorProductQuadratureRule<q>&, dof_type* element_residual,
-                        [[maybe_unused]] int step = 1)
+  static SERAC_HOST_DEVICE void integrate(const tensor<tuple<source_type, flux_type>, q * q>& qf_output,
+                                          const TensorProductQuadratureRule<q>&, dof_type* element_residual,
+                                          int step = 1)
   {
-    constexpr bool                     apply_weights = true;
-    constexpr tensor<double, q, p>     B1            = calculate_B1<apply_weights, q>();
-    constexpr tensor<double, q, p + 1> B2            = calculate_B2<apply_weights, q>();
-    constexpr tensor<double, q, p + 1> G2            = calculate_G2<apply_weights, q>();
+    if constexpr (is_zero<source_type>{} && is_zero<flux_type>{}) {
+      return;
+    } else {
+      // the sources and fluxes may describe several trial directions (e.g. the columns of an element gradient),
+      // whose residuals are `step` apart
+      constexpr int ntrial = std::max(size(source_type{}) / dim, size(flux_type{}));
 
-    tensor<double, 2, q, q> source{};
-    tensor<double, q, q>    flux{};
+      static constexpr bool apply_weights = true;
+      static constexpr auto B1            = calculate_B1<apply_weights, q>();
+      static constexpr auto B2            = calculate_B2<apply_weights, q>();
+      static constexpr auto G2            = calculate_G2<apply_weights, q>();
 
-    for (int qy = 0; qy < q; qy++) {
-      for (int qx = 0; qx < q; qx++) {
-        int                 Q = qy * q + qx;
-        tensor<double, dim> s{get<SOURCE>(qf_output[Q])};
-        for (int i = 0; i < dim; i++) {
-          source(i, qy, qx) = s[i];
+      for (int j = 0; j < ntrial; j++) {
+        tensor<double, 2, q, q> source{};
+        tensor<double, q, q>    flux{};
+
+        for (int qy = 0; qy < q; qy++) {
+          for (int qx = 0; qx < q; qx++) {
+            int Q = qy * q + qx;
+            if constexpr (!is_zero<source_type>{}) {
+              for (int i = 0; i < dim; i++) {
+                source(i, qy, qx) = reinterpret_cast<const double*>(&get<SOURCE>(qf_output[Q]))[i * ntrial + j];
+              }
+            }
+            if constexpr (!is_zero<flux_type>{}) {
+              flux(qy, qx) = reinterpret_cast<const double*>(&get<FLUX>(qf_output[Q]))[j];
+            }
+          }
         }
-        flux(qy, qx) = get<FLUX>(qf_output[Q]);
-      }
-    }
 
-    // to clarify which contractions correspond to which spatial dimensions
-    constexpr int x = 1, y = 0;
+        // to clarify which contractions correspond to which spatial dimensions
+        constexpr int x = 1, y = 0;
 
-    auto A = contract<y, 0>(source[0], B2) - contract<y, 0>(flux, G2);
-    element_residual[0].x += contract<x, 0>(A, B1);
+        auto A = contract<y, 0>(source[0], B2) - contract<y, 0>(flux, G2);
+        element_residual[j * step].x += contract<x, 0>(A, B1);
 
-    A = contract<x, 0>(source[1], B2) + contract<x, 0>(flux, G2);
-    element_residual[0].y += contract<y, 0>(A, B1);
+        A = contract<x, 0>(source[1], B2) + contract<x, 0>(flux, G2);
+        element_residual[j * step].y += contract<y, 0>(A, B1);
+      }
+    }
   }
 
 #if 0
@@ -0,0 +1,227 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file simplex_basis.inl
+ *
+ * @brief Tabulated shape functions for the elements on triangles and tetrahedra
+ */
+
+// Simplex elements don't have a tensor product structure to sum-factorize, so instead of evaluating
+// their shape functions at each quadrature point, the H1 and L2 elements on triangles and tetrahedra
+// tabulate them at compile time, for each element and quadrature rule. Interpolation and integration
+// are then small dense matrix products with those tables:
+//
+//   interpolate: X_q(i, r)    = sum_k X_e(i, k) * B(r, k)
+//   integrate:   R_e(i, k)   += sum_r F_q(i, r) * W(r, k)
+//
+// where the rows r of B are the values and the parent-space derivatives of the shape functions at
+// each quadrature point, and W is B with each row scaled by the quadrature weight. The rows are padded
+// out to whole cache lines, so that the loops over the element dofs vectorize.
+/// @cond
+namespace detail {
+
+/// @brief the number of doubles in a 64-byte cache line
+inline constexpr int doubles_per_cache_line = 8;
+
+/// @brief the length of n doubles padded out to a whole number of cache lines
+constexpr int padded_length(int n)
+{
+  return doubles_per_cache_line * ((n + doubles_per_cache_line - 1) / doubles_per_cache_line);
+}
+
+/**
+ * @brief the values and parent-space derivatives of the shape functions of a simplex element at each quadrature point
+ *
+ * Row `q * (dim + 1)` holds the values of the shape functions at quadrature point q, and row
+ * `q * (dim + 1) + 1 + d` their derivatives with respect to the parent coordinate d.
+ *
+ * @tparam nqpts the number of quadrature points
+ * @tparam dim the dimension of the parent element
+ * @tparam ndof the number of shape functions
+ */
+template <int nqpts, int dim, int ndof>
+struct SimplexBasisTable {
+  /// the number of rows of the table
+  static constexpr int rows = nqpts * (dim + 1);
+
+  /// the (padded) length of each row of the table
+  static constexpr int row_length = padded_length(ndof);
+
+  /// the shape function values and derivatives, each row starting on a cache line
+  alignas(64) double entries[rows][row_length] = {};
+};
+
+/**
+ * @brief tabulates the shape functions of a simplex element at the points of its quadrature rule
+ *
+ * @tparam element_type the finite element
+ * @tparam apply_weights optionally multiply the rows by the associated quadrature weight
+ * @tparam q the parameter of the quadrature rule
+ */
+template <typename element_type, bool apply_weights, int q>
+constexpr auto calculate_simplex_basis_table()
+{
+  constexpr auto geom  = element_type::geometry;
+  constexpr int  dim   = element_type::dim;
+  constexpr int  ndof  = element_type::ndof;
+  constexpr int  nqpts = num_quadrature_points(geom, q);
+
+  constexpr auto points  = GaussLegendreNodes<q, geom>();
+  constexpr auto weights = GaussLegendreWeights<q, geom>();
+
+  SimplexBasisTable<nqpts, dim, ndof> table{};
+  for (int j = 0; j < nqpts; j++) {
+    tensor<double, dim> xi = points[j];
+    double              wt = apply_weights ? weights[j] : 1.0;
+    for (int k = 0; k < ndof; k++) {
+      auto dphi_dxi                   = element_type::shape_function_gradient(xi, k);
+      table.entries[j * (dim + 1)][k] = wt * element_type::shape_function(xi, k);
+      for (int d = 0; d < dim; d++) {
+        table.entries[j * (dim + 1) + 1 + d][k] = wt * dphi_dxi[d];
+      }
+    }
+  }
+  return table;
+}
+
+/**
+ * @brief the values and parent-space gradients of each component of a simplex element at its quadrature points
+ *
+ * @tparam element_type the finite element
+ * @tparam q the parameter of the quadrature rule
+ * @param X the values of the element dofs
+ */
+template <typename element_type, int q>
+SERAC_HOST_DEVICE auto simplex_interpolate(const tensor<double, element_type::components, element_type::ndof>& X)
+{
+  constexpr int c     = element_type::components;
+  constexpr int dim   = element_type::dim;
+  constexpr int ndof  = element_type::ndof;
+  constexpr int nqpts = num_quadrature_points(element_type::geometry, q);
+
+  static constexpr auto B = calculate_simplex_basis_table<element_type, false, q>();
+
+  // transpose the quadrature data into a flat tensor of tuples
+  union {
+    tensor<tuple<tensor<double, c>, tensor<double, c, dim> >, nqpts> unflattened;
+    tensor<typename element_type::qf_input_type, nqpts>             flattened;
+  } output{};
+
+  for (int i = 0; i < c; i++) {
+    for (int j = 0; j < nqpts; j++) {
+      double values[dim + 1]{};
+      for (int r = 0; r < dim + 1; r++) {
+        const double* row = B.entries[j * (dim + 1) + r];
+        for (int k = 0; k < ndof; k++) {
+          values[r] += X(i, k) * row[k];
+        }
+      }
+      get<0>(output.unflattened[j])[i] = values[0];
+      for (int d = 0; d < dim; d++) {
+        get<1>(output.unflattened[j])[i][d] = values[1 + d];
+      }
+    }
+  }
+
+  return output.flattened;
+}
+
+/**
+ * @brief integrates the sources and fluxes at the quadrature points of a simplex element against its shape functions
+ *
+ * @tparam element_type the finite element
+ * @tparam q the parameter of the quadrature rule
+ * @param qf_output the sources and fluxes at each quadrature point
+ * @param element_residual the residual(s) to add the integrals to
+ * @param step the stride between the residuals of consecutive trial directions
+ */
+template <typename element_type, int q, typename source_type, typename flux_type, int nqpts>
+SERAC_HOST_DEVICE void simplex_integrate(const tensor<tuple<source_type, flux_type>, nqpts>& qf_output,
+                                         tensor<double, element_type::components, element_type::ndof>* element_residual,
+                                         int step)
+{
+  if constexpr (is_zero<source_type>{} && is_zero<flux_type>{}) {
+    return;
+  } else {
+    constexpr int SOURCE = 0;
+    constexpr int FLUX   = 1;
+
+    constexpr int c      = element_type::components;
+    constexpr int dim    = element_type::dim;
+    constexpr int ndof   = element_type::ndof;
+    constexpr int ntrial = std::max(size(source_type{}), size(flux_type{}) / dim) / c;
+
+    static constexpr auto W = calculate_simplex_basis_table<element_type, true, q>();
+
+    for (int j = 0; j < ntrial; j++) {
+      for (int i = 0; i < c; i++) {
+        auto& residual = element_residual[j * step][i];
+        for (int Q = 0; Q < nqpts; Q++) {
+          if constexpr (!is_zero<source_type>{}) {
+            double        source = reinterpret_cast<const double*>(&get<SOURCE>(qf_output[Q]))[i * ntrial + j];
+            const double* row    = W.entries[Q * (dim + 1)];
+            for (int k = 0; k < ndof; k++) {
+              residual[k] += source * row[k];
+            }
+          }
+
+          if constexpr (!is_zero<flux_type>{}) {
+            for (int d = 0; d < dim; d++) {
+              double flux = reinterpret_cast<const double*>(&get<FLUX>(qf_output[Q]))[(i * dim + d) * ntrial + j];
+              const double* row  = W.entries[Q * (dim + 1) + 1 + d];
+              for (int k = 0; k < ndof; k++) {
+                residual[k] += flux * row[k];
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+/**
+ * @brief applies the jth shape function of a simplex element (and its gradient) to the derivatives of a
+ * q-function at each quadrature point, see finite_element::batch_apply_shape_fn
+ *
+ * @tparam element_type the finite element
+ * @tparam q the parameter of the quadrature rule
+ * @param j which shape function
+ * @param input the q-function derivatives at each quadrature point
+ */
+template <typename element_type, int q, typename in_t, int nqpts>
+SERAC_HOST_DEVICE auto simplex_batch_apply_shape_fn(int j, const tensor<in_t, nqpts>& input)
+{
+  constexpr int dim = element_type::dim;
+
+  using source_t = decltype(get<0>(get<0>(in_t{})) + dot(get<1>(get<0>(in_t{})), tensor<double, dim>{}));
+  using flux_t   = decltype(get<0>(get<1>(in_t{})) + dot(get<1>(get<1>(in_t{})), tensor<double, dim>{}));
+
+  static constexpr auto B = calculate_simplex_basis_table<element_type, false, q>();
+
+  tensor<tuple<source_t, flux_t>, nqpts> output;
+
+  for (int i = 0; i < nqpts; i++) {
+    double              phi_j = B.entries[i * (dim + 1)][j];
+    tensor<double, dim> dphi_j_dxi{};
+    for (int d = 0; d < dim; d++) {
+      dphi_j_dxi[d] = B.entries[i * (dim + 1) + 1 + d][j];
+    }
+
+    auto& d00 = get<0>(get<0>(input(i)));
+    auto& d01 = get<1>(get<0>(input(i)));
+    auto& d10 = get<0>(get<1>(input(i)));
+    auto& d11 = get<1>(get<1>(input(i)));
+
+    output[i] = {d00 * phi_j + dot(d01, dphi_j_dxi), d10 * phi_j + dot(d11, dphi_j_dxi)};
+  }
+
+  return output;
+}
+
+}  // namespace detail
+/// @endcond
@@ -240,96 +240,24 @@ struct finite_element<mfem::Geometry::TRIANGLE, H1<p, c> > {
   }
 
   template <typename in_t, int q>
-  static auto batch_apply_shape_fn(int j, tensor<in_t, q*(q + 1) / 2> input, const TensorProductQuadratureRule<q>&)
+  static SERAC_HOST_DEVICE auto batch_apply_shape_fn(int j, tensor<in_t, q*(q + 1) / 2> input,
+                                                     const TensorProductQuadratureRule<q>&)
   {
-    using source_t = decltype(get<0>(get<0>(in_t{})) + dot(get<1>(get<0>(in_t{})), tensor<double, 2>{}));
-    using flux_t   = decltype(get<0>(get<1>(in_t{})) + dot(get<1>(get<1>(in_t{})), tensor<double, 2>{}));
-
-    constexpr auto xi = GaussLegendreNodes<q, mfem::Geometry::TRIANGLE>();
-
-    static constexpr int               Q = q * (q + 1) / 2;
-    tensor<tuple<source_t, flux_t>, Q> output;
-
-    for (int i = 0; i < Q; i++) {
-      double              phi_j      = shape_function(xi[i], j);
-      tensor<double, dim> dphi_j_dxi = shape_function_gradient(xi[i], j);
-
-      auto& d00 = get<0>(get<0>(input(i)));
-      auto& d01 = get<1>(get<0>(input(i)));
-      auto& d10 = get<0>(get<1>(input(i)));
-      auto& d11 = get<1>(get<1>(input(i)));
-
-      output[i] = {d00 * phi_j + dot(d01, dphi_j_dxi), d10 * phi_j + dot(d11, dphi_j_dxi)};
-    }
-
-    return output;
+    return detail::simplex_batch_apply_shape_fn<finite_element, q>(j, input);
   }
 
   template <int q>
-  static auto interpolate(const tensor<double, c, ndof>& X, const TensorProductQuadratureRule<q>&)
+  static SERAC_HOST_DEVICE auto interpolate(const tensor<double, c, ndof>& X, const TensorProductQuadratureRule<q>&)
   {
-    constexpr auto       xi                    = GaussLegendreNodes<q, mfem::Geometry::TRIANGLE>();
-    static constexpr int num_quadrature_points = q * (q + 1) / 2;
-
-    // transpose the quadrature data into a flat tensor of tuples
-    union {
-      tensor<tuple<tensor<double, c>, tensor<double, c, dim> >, num_quadrature_points> unflattened;
-      tensor<qf_input_type, num_quadrature_points>                                     flattened;
-    } output{};
-
-    for (int i = 0; i < c; i++) {
-      for (int j = 0; j < num_quadrature_points; j++) {
-        for (int k = 0; k < ndof; k++) {
-          get<VALUE>(output.unflattened[j])[i] += X(i, k) * shape_function(xi[j], k);
-          get<GRADIENT>(output.unflattened[j])[i] += X(i, k) * shape_function_gradient(xi[j], k);
-        }
-      }
-    }
-
-    return output.flattened;
+    return detail::simplex_interpolate<finite_element, q>(X);
   }
 
   template <typename source_type, typename flux_type, int q>
-  static void integrate(const tensor<tuple<source_type, flux_type>, q*(q + 1) / 2>& qf_output,
-                        const TensorProductQuadratureRule<q>&, tensor<double, c, ndof>* element_residual, int step = 1)
+  static SERAC_HOST_DEVICE void integrate(const tensor<tuple<source_type, flux_type>, q*(q + 1) / 2>& qf_output,
+                                          const TensorProductQuadratureRule<q>&,
+                                          tensor<double, c, ndof>* element_residual, int step = 1)
   {
-    if constexpr (is_zero<source_type>{} && is_zero<flux_type>{}) {
-      return;
-    }
-
-    using source_component_type = std::conditional_t<is_zero<source_type>{}, zero, double>;
-    using flux_component_type   = std::conditional_t<is_zero<flux_type>{}, zero, tensor<double, dim> >;
-
-    constexpr int  num_quadrature_points = q * (q + 1) / 2;
-    constexpr int  ntrial                = std::max(size(source_type{}), size(flux_type{}) / dim) / c;
-    constexpr auto integration_points    = GaussLegendreNodes<q, mfem::Geometry::TRIANGLE>();
-    constexpr auto integration_weights   = GaussLegendreWeights<q, mfem::Geometry::TRIANGLE>();
-
-    for (int j = 0; j < ntrial; j++) {
-      for (int i = 0; i < c; i++) {
-        for (int Q = 0; Q < num_quadrature_points; Q++) {
-          tensor<double, 2> xi = integration_points[Q];
-          double            wt = integration_weights[Q];
-
-          source_component_type source;
-          if constexpr (!is_zero<source_type>{}) {
-            source = reinterpret_cast<const double*>(&get<SOURCE>(qf_output[Q]))[i * ntrial + j];
-          }
-
-          flux_component_type flux;
-          if constexpr (!is_zero<flux_type>{}) {
-            for (int k = 0; k < dim; k++) {
-              flux[k] = reinterpret_cast<const double*>(&get<FLUX>(qf_output[Q]))[(i * dim + k) * ntrial + j];
-            }
-          }
-
-          for (int k = 0; k < ndof; k++) {
-            element_residual[j * step](i, k) +=
-                (source * shape_function(xi, k) + dot(flux, shape_function_gradient(xi, k))) * wt;
-          }
-        }
-      }
-    }
+    detail::simplex_integrate<finite_element, q>(qf_output, element_residual, step);
   }
 };
 /// @endcond
@@ -11,7 +11,13 @@ namespace serac {
 
 static constexpr uint32_t NO_DIFFERENTIATION = uint32_t(1) << 31;
 
-template <uint32_t i>
+/**
+ * @brief a tag type for specifying which argument(s) `serac::Functional::operator()` should differentiate w.r.t.
+ *
+ * e.g. `DifferentiateWRT<1>{}` or, to store the derivatives w.r.t. several arguments in one evaluation,
+ * `DifferentiateWRT<1, 2>{}` (see serac::Functional::operator())
+ */
+template <uint32_t... i>
 struct DifferentiateWRT {
 };
 
@@ -29,7 +35,7 @@ struct differentiate_wrt_this {
 /**
  * @brief this function is intended to only be used in combination with
  *   `serac::Functional::operator()`, as a way for the user to express that
- *   it should both evaluate and differentiate w.r.t. a specific argument (only 1 argument at a time)
+ *   it should both evaluate and differentiate w.r.t. a specific argument (or several arguments)
  *
  * For example:
  * @code{.cpp}
@@ -37,6 +43,8 @@ struct differentiate_wrt_this {
  *     mfem::Vector arg1 = ...;
  *     mfem::Vector just_the_value = my_functional(arg0, arg1);
  *     auto [value, gradient_wrt_arg1] = my_functional(arg0, differentiate_wrt(arg1));
+ *     auto [value, gradient_wrt_arg0, gradient_wrt_arg1] = my_functional(differentiate_wrt(arg0),
+ *                                                                        differentiate_wrt(arg1));
  * @endcode
  */
 auto differentiate_wrt(const mfem::Vector& v) { return differentiate_wrt_this{v}; }
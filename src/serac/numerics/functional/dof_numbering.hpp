@@ -8,9 +8,11 @@
 #include "mfem.hpp"
 
 #include "serac/infrastructure/accelerator.hpp"
+#include "serac/infrastructure/profiling.hpp"
 
 #include "serac/numerics/functional/integral.hpp"
 #include "serac/numerics/functional/element_restriction.hpp"
+#include "serac/numerics/functional/block_sparse_matrix.hpp"
 
 namespace serac {
 
@@ -243,8 +245,8 @@ struct DofNumbering {
  *   of the given test and trial function spaces, and records which nonzero each element "stiffness"
  *   matrix maps to, to facilitate assembling the element matrices into the global sparse matrix. e.g.
  *
- *   element_nonzero_LUT(e, i, j) says where (in the global sparse matrix)
- *   to put the (i,j) component of the matrix associated with element element matrix `e`
+ *   element_nonzero_LUT[type].at(geom)[(e * trial_vdofs + i) * test_vdofs + j] says where (in the global
+ *   sparse matrix values array) to put the (i,j) component of element matrix `e`, and with what sign
  *
  * Note: due to an internal inconsistency between mfem::FiniteElementSpace and mfem::FaceRestriction,
  *    we choose to use the Restriction operator as the "source of truth", since we are also using its
@@ -278,78 +280,117 @@ struct GradientAssemblyLookupTables {
   };
 
   /**
-   * @param block_test_dofs object containing information about dofs for the test space
-   * @param block_trial_dofs object containing information about dofs for the trial space
+   * @param test_dofs objects containing information about dofs for the test space, for each integral type
+   * @param trial_dofs objects containing information about dofs for the trial space, for each integral type
    *
    * @brief create lookup tables describing which degrees of freedom
-   * correspond to each domain/boundary element
+   * correspond to each domain element, boundary element and interior face
    */
-  GradientAssemblyLookupTables(const serac::BlockElementRestriction& block_test_dofs,
-                               const serac::BlockElementRestriction& block_trial_dofs)
+  GradientAssemblyLookupTables(const std::array<const BlockElementRestriction*, Integral::num_types>& test_dofs,
+                               const std::array<const BlockElementRestriction*, Integral::num_types>& trial_dofs)
   {
-    // we start by having each element and boundary element emit the (i,j) entry that it
-    // touches in the global "stiffness matrix", and also keep track of some metadata about
-    // which element and which dof are associated with that particular nonzero entry
-    for (const auto& [geometry, trial_dofs] : block_trial_dofs.restrictions) {
-      const auto& test_dofs = block_test_dofs.restrictions.at(geometry);
-
-      std::vector<DoF> test_vdofs(test_dofs.nodes_per_elem * test_dofs.components);
-      std::vector<DoF> trial_vdofs(trial_dofs.nodes_per_elem * trial_dofs.components);
-
-      auto num_elements = static_cast<uint32_t>(trial_dofs.num_elements);
-      for (uint32_t e = 0; e < num_elements; e++) {
-        for (uint64_t i = 0; i < uint64_t(test_dofs.dof_info.shape()[1]); i++) {
-          auto test_dof = test_dofs.dof_info(e, i);
-
-          for (uint64_t j = 0; j < uint64_t(trial_dofs.dof_info.shape()[1]); j++) {
-            auto trial_dof = trial_dofs.dof_info(e, j);
-
-            for (uint64_t k = 0; k < test_dofs.components; k++) {
-              uint32_t test_global_id = uint32_t(test_dofs.GetVDof(test_dof, k).index());
-              for (uint64_t l = 0; l < trial_dofs.components; l++) {
-                uint32_t trial_global_id                  = uint32_t(trial_dofs.GetVDof(trial_dof, l).index());
-                nz_LUT[{test_global_id, trial_global_id}] = 0;  // just store the keys initially
-              }
-            }
-          }
-        }
+    SERAC_PROFILE_SCOPE("GradientAssemblyLookupTables");
+
+    // we start by having each element and boundary element emit the (i,j) entries that it
+    // touches in the global "stiffness matrix", bucketed by row (duplicates included)
+    //
+    // note: this is two passes over the element dofs (counting, then filling) into flat arrays,
+    //       which uses far less memory (and is much faster) than inserting each entry into a hash map
+    const auto       num_rows    = static_cast<std::size_t>(test_dofs[Integral::Domain]->LSize());
+    const auto       num_columns = static_cast<std::size_t>(trial_dofs[Integral::Domain]->LSize());
+    std::vector<int> bucket_ptr(num_rows + 1, 0);
+    for (auto type : Integral::Types) {
+      for_each_entry(*test_dofs[type], *trial_dofs[type], [&](uint32_t row, uint32_t col, int /* sign */) {
+        // note: interior faces shared with other ranks also refer to the dofs of the elements on the other side
+        SLIC_ERROR_IF(row >= num_rows || col >= num_columns,
+                      "assembling the gradient of interior face integrals on faces shared between ranks is not "
+                      "supported, use the action of the gradient instead");
+        bucket_ptr[row + 1]++;
+      });
+    }
+
+    for (std::size_t r = 1; r <= num_rows; r++) {
+      bucket_ptr[r] += bucket_ptr[r - 1];
+    }
+
+    std::vector<int> buckets(static_cast<std::size_t>(bucket_ptr[num_rows]));
+    {
+      std::vector<int> next(bucket_ptr.begin(), bucket_ptr.end() - 1);
+      for (auto type : Integral::Types) {
+        for_each_entry(*test_dofs[type], *trial_dofs[type], [&](uint32_t row, uint32_t col, int /* sign */) {
+          buckets[static_cast<std::size_t>(next[row]++)] = int(col);
+        });
       }
     }
-    std::vector<Entry> entries(nz_LUT.size());
 
-    uint32_t count = 0;
-    for (auto [key, value] : nz_LUT) {
-      entries[count++] = key;
+    // each row is then sorted and deduplicated independently of the others
+    row_ptr.assign(num_rows + 1, 0);
+    SERAC_OMP_PARALLEL_FOR
+    for (int r = 0; r < int(num_rows); r++) {
+      auto begin = buckets.begin() + bucket_ptr[static_cast<std::size_t>(r)];
+      auto end   = buckets.begin() + bucket_ptr[static_cast<std::size_t>(r + 1)];
+      std::sort(begin, end);
+      row_ptr[static_cast<std::size_t>(r + 1)] = static_cast<int>(std::unique(begin, end) - begin);
     }
 
-    std::sort(entries.begin(), entries.end());
+    // convert the per-row counts into offsets
+    for (std::size_t r = 1; r < row_ptr.size(); r++) {
+      row_ptr[r] += row_ptr[r - 1];
+    }
 
-    nnz = static_cast<uint32_t>(nz_LUT.size());
-    row_ptr.resize(static_cast<size_t>(block_test_dofs.LSize() + 1));
+    nnz = static_cast<uint32_t>(row_ptr[num_rows]);
     col_ind.resize(nnz);
 
-    row_ptr[0] = 0;
-    col_ind[0] = int(entries[0].column);
+    SERAC_OMP_PARALLEL_FOR
+    for (int r = 0; r < int(num_rows); r++) {
+      auto from = buckets.begin() + bucket_ptr[static_cast<std::size_t>(r)];
+      auto to   = col_ind.begin() + row_ptr[static_cast<std::size_t>(r)];
+      std::copy(from, from + (row_ptr[static_cast<std::size_t>(r + 1)] - row_ptr[static_cast<std::size_t>(r)]), to);
+    }
 
-    for (uint32_t i = 1; i < nnz; i++) {
-      nz_LUT[entries[i]] = i;
-      col_ind[i]         = int(entries[i].column);
+    // then, record where each element matrix entry goes, so that assembly doesn't need to do any lookups
+    for (auto type : Integral::Types) {
+      for (const auto& [geometry, trial_restriction] : trial_dofs[type]->restrictions) {
+        const auto& test_restriction = test_dofs[type]->restrictions.at(geometry);
+
+        auto& element_LUT = element_nonzero_LUT[type][geometry];
+        element_LUT.reserve(trial_restriction.num_elements * trial_restriction.nodes_per_elem *
+                            trial_restriction.components * test_restriction.nodes_per_elem *
+                            test_restriction.components);
+        for_each_entry(test_restriction, trial_restriction, [&](uint32_t row, uint32_t col, int sign) {
+          element_LUT.push_back({find(row, col), sign});
+        });
+      }
+    }
 
-      // if the new entry has a different row, then the row_ptr offsets must be set as well
-      for (uint32_t j = entries[i - 1].row; j < entries[i].row; j++) {
-        row_ptr[j + 1] = int(i);
+    std::size_t bytes = sizeof(int) * (row_ptr.size() + col_ind.size());
+    for (const auto& per_geometry : element_nonzero_LUT) {
+      for (const auto& [geometry, element_LUT] : per_geometry) {
+        bytes += sizeof(SignedIndex) * element_LUT.size();
       }
     }
+    tracker.set(bytes);
 
-    row_ptr.back() = static_cast<int>(nnz);
+    // the buckets are only needed during setup, and they are quite large, so
+    // we let them go out of scope here rather than keeping them around
   }
 
   /**
    * @brief return the index (into the nonzero entries) corresponding to entry (i,j)
    * @param i the row
    * @param j the column
+   *
+   * @note this does a binary search of the sorted column indices of row `i`, the
+   * element matrix assembly should use `element_nonzero_LUT` instead
    */
-  uint32_t operator()(int i, int j) const { return nz_LUT.at({uint32_t(i), uint32_t(j)}); }
+  uint32_t operator()(int i, int j) const
+  {
+    auto end = col_ind.begin() + row_ptr[static_cast<std::size_t>(i + 1)];
+    auto k   = find(static_cast<uint32_t>(i), static_cast<uint32_t>(j));
+    SLIC_ERROR_IF(col_ind.begin() + k == end || col_ind[k] != j,
+                  axom::fmt::format("entry ({}, {}) is not in the sparsity pattern", i, j));
+    return k;
+  }
 
   /// @brief how many nonzero entries appear in the sparse matrix
   uint32_t nnz;
@@ -364,10 +405,211 @@ struct GradientAssemblyLookupTables {
   std::vector<int> col_ind;
 
   /**
-   * @brief `nz_LUT` returns the index of the `col_ind` / `value` CSR arrays
-   * corresponding to the (i,j) entry
+   * @brief `element_nonzero_LUT[type].at(geom)` holds the index of the `col_ind` / `value` CSR arrays (and the sign)
+   * that each entry of the element matrices (of the given integral type and geometry) contributes to,
+   * laid out in the same order as the element matrices, i.e. `(e * trial_vdofs + i) * test_vdofs + j`
+   */
+  std::map<mfem::Geometry::Type, std::vector<SignedIndex>> element_nonzero_LUT[Integral::num_types];
+
+  /// @brief the accounting of the memory of these tables, see memory::usage()
+  memory::Tracker tracker{memory::Subsystem::LookupTables};
+
+private:
+  /**
+   * @brief binary search the sorted column indices of `row` for `col`
+   * @return the index of the first entry of `row` whose column is not less than `col`
+   */
+  uint32_t find(uint32_t row, uint32_t col) const
+  {
+    auto begin = col_ind.begin() + row_ptr[row];
+    auto end   = col_ind.begin() + row_ptr[row + 1];
+    return static_cast<uint32_t>(std::lower_bound(begin, end, int(col)) - col_ind.begin());
+  }
+
+  /**
+   * @brief call `f(row, col, sign)` for every entry of every element matrix, in the order they are
+   *   laid out in memory by the element gradient kernels
+   *
+   * @param test_dofs the dof information for the test space
+   * @param trial_dofs the dof information for the trial space
+   * @param f the function to call for each entry
+   */
+  template <typename callable>
+  static void for_each_entry(const ElementRestriction& test_dofs, const ElementRestriction& trial_dofs, callable f)
+  {
+    std::vector<DoF> test_vdofs(test_dofs.nodes_per_elem * test_dofs.components);
+    std::vector<DoF> trial_vdofs(trial_dofs.nodes_per_elem * trial_dofs.components);
+
+    auto num_elements = static_cast<int>(trial_dofs.num_elements);
+    for (int e = 0; e < num_elements; e++) {
+      test_dofs.GetElementVDofs(e, test_vdofs);
+      trial_dofs.GetElementVDofs(e, trial_vdofs);
+
+      for (const auto& trial_vdof : trial_vdofs) {
+        auto col = static_cast<uint32_t>(trial_vdof.index());
+        for (const auto& test_vdof : test_vdofs) {
+          auto row = static_cast<uint32_t>(test_vdof.index());
+          f(row, col, test_vdof.sign() * trial_vdof.sign());
+        }
+      }
+    }
+  }
+
+  /// @overload
+  template <typename callable>
+  static void for_each_entry(const BlockElementRestriction& block_test_dofs,
+                             const BlockElementRestriction& block_trial_dofs, callable f)
+  {
+    for (const auto& [geometry, trial_dofs] : block_trial_dofs.restrictions) {
+      for_each_entry(block_test_dofs.restrictions.at(geometry), trial_dofs, f);
+    }
+  }
+};
+
+/**
+ * @brief the node-level counterpart of GradientAssemblyLookupTables, for assembling gradients as block sparse matrices
+ *   (see BlockSparseMatrix): each pair of test and trial nodes that share an element couple through a dense block,
+ *   of size (test components) x (trial components), e.g. 3 x 3 for the displacement field of a 3D solid. The sparsity
+ *   pattern and lookup tables then only have one entry per block, rather than one per scalar nonzero.
+ *
+ *   element_block_LUT[type].at(geom)[(e * trial_nodes + J) * test_nodes + I] says which block (of the block CSR
+ *   values array) the couplings between trial node J and test node I of element `e` contribute to
+ *
+ * @note the dofs can't have sign flips (e.g. H1 or L2 spaces, but not Hcurl)
+ */
+struct BlockAssemblyLookupTables {
+  /**
+   * @param test_dofs objects containing information about dofs for the test space, for each integral type
+   * @param trial_dofs objects containing information about dofs for the trial space, for each integral type
+   * @param num_test_nodes the number of (local) nodes of the test space, i.e. block rows
+   * @param num_trial_nodes the number of (local) nodes of the trial space, i.e. block columns
    */
-  std::unordered_map<Entry, uint32_t, Entry::Hasher> nz_LUT;
+  BlockAssemblyLookupTables(const std::array<const BlockElementRestriction*, Integral::num_types>& test_dofs,
+                            const std::array<const BlockElementRestriction*, Integral::num_types>& trial_dofs,
+                            uint32_t num_test_nodes, uint32_t num_trial_nodes)
+  {
+    auto sparsity         = std::make_shared<BlockSparsityPattern>();
+    sparsity->num_rows    = int(num_test_nodes);
+    sparsity->num_columns = int(num_trial_nodes);
+    auto& row_ptr         = sparsity->row_ptr;
+    auto& col_ind         = sparsity->col_ind;
+
+    // the same two passes (counting, then filling) as GradientAssemblyLookupTables, over pairs of nodes
+    std::vector<int> bucket_ptr(num_test_nodes + 1, 0);
+    for (auto type : Integral::Types) {
+      for (const auto& [geometry, trial_restriction] : trial_dofs[type]->restrictions) {
+        for_each_block(test_dofs[type]->restrictions.at(geometry), trial_restriction, [&](uint32_t row, uint32_t col) {
+          SLIC_ERROR_IF(row >= num_test_nodes || col >= num_trial_nodes,
+                        "block assembly of the gradient of interior face integrals on faces shared between ranks is "
+                        "not supported");
+          bucket_ptr[row + 1]++;
+        });
+      }
+    }
+
+    for (std::size_t r = 1; r <= num_test_nodes; r++) {
+      bucket_ptr[r] += bucket_ptr[r - 1];
+    }
+
+    std::vector<int> buckets(static_cast<std::size_t>(bucket_ptr[num_test_nodes]));
+    {
+      std::vector<int> next(bucket_ptr.begin(), bucket_ptr.end() - 1);
+      for (auto type : Integral::Types) {
+        for (const auto& [geometry, trial_restriction] : trial_dofs[type]->restrictions) {
+          for_each_block(test_dofs[type]->restrictions.at(geometry), trial_restriction,
+                         [&](uint32_t row, uint32_t col) { buckets[std::size_t(next[row]++)] = int(col); });
+        }
+      }
+    }
+
+    row_ptr.assign(num_test_nodes + 1, 0);
+    SERAC_OMP_PARALLEL_FOR
+    for (int r = 0; r < int(num_test_nodes); r++) {
+      auto begin = buckets.begin() + bucket_ptr[static_cast<std::size_t>(r)];
+      auto end   = buckets.begin() + bucket_ptr[static_cast<std::size_t>(r + 1)];
+      std::sort(begin, end);
+      row_ptr[static_cast<std::size_t>(r + 1)] = static_cast<int>(std::unique(begin, end) - begin);
+    }
+
+    for (std::size_t r = 1; r < row_ptr.size(); r++) {
+      row_ptr[r] += row_ptr[r - 1];
+    }
+
+    col_ind.resize(std::size_t(row_ptr[num_test_nodes]));
+
+    SERAC_OMP_PARALLEL_FOR
+    for (int r = 0; r < int(num_test_nodes); r++) {
+      auto from = buckets.begin() + bucket_ptr[static_cast<std::size_t>(r)];
+      auto to   = col_ind.begin() + row_ptr[static_cast<std::size_t>(r)];
+      std::copy(from, from + (row_ptr[static_cast<std::size_t>(r + 1)] - row_ptr[static_cast<std::size_t>(r)]), to);
+    }
+
+    pattern = sparsity;
+
+    for (auto type : Integral::Types) {
+      for (const auto& [geometry, trial_restriction] : trial_dofs[type]->restrictions) {
+        const auto& test_restriction = test_dofs[type]->restrictions.at(geometry);
+
+        auto& element_LUT = element_block_LUT[type][geometry];
+        element_LUT.reserve(trial_restriction.num_elements * trial_restriction.nodes_per_elem *
+                            test_restriction.nodes_per_elem);
+        for_each_block(test_restriction, trial_restriction,
+                       [&](uint32_t row, uint32_t col) { element_LUT.push_back(find(row, col)); });
+      }
+    }
+
+    std::size_t bytes = sizeof(int) * (row_ptr.size() + col_ind.size());
+    for (const auto& per_geometry : element_block_LUT) {
+      for (const auto& [geometry, element_LUT] : per_geometry) {
+        bytes += sizeof(uint32_t) * element_LUT.size();
+      }
+    }
+    tracker.set(bytes);
+  }
+
+  /// @brief the sparsity pattern of the blocks, with a block row for each test node and a block column for each
+  /// trial node
+  std::shared_ptr<const BlockSparsityPattern> pattern;
+
+  /// @brief the block that each pair of (trial, test) nodes of each element contributes to, see above
+  std::map<mfem::Geometry::Type, std::vector<uint32_t>> element_block_LUT[Integral::num_types];
+
+  /// @brief the accounting of the memory of these tables, see memory::usage()
+  memory::Tracker tracker{memory::Subsystem::LookupTables};
+
+private:
+  /// @brief binary search the sorted block columns of `row` for `col`
+  uint32_t find(uint32_t row, uint32_t col) const
+  {
+    const auto& col_ind = pattern->col_ind;
+    auto        begin   = col_ind.begin() + pattern->row_ptr[row];
+    auto        end     = col_ind.begin() + pattern->row_ptr[row + 1];
+    return static_cast<uint32_t>(std::lower_bound(begin, end, int(col)) - col_ind.begin());
+  }
+
+  /**
+   * @brief call `f(row, col)` for every pair of (trial node, test node) of every element, in the order of the
+   *   blocks of the element matrices
+   *
+   * @param test_dofs the dof information for the test space
+   * @param trial_dofs the dof information for the trial space
+   * @param f the function to call for each pair of nodes
+   */
+  template <typename callable>
+  static void for_each_block(const ElementRestriction& test_dofs, const ElementRestriction& trial_dofs, callable f)
+  {
+    for (uint64_t e = 0; e < trial_dofs.num_elements; e++) {
+      for (uint64_t J = 0; J < trial_dofs.nodes_per_elem; J++) {
+        DoF col = trial_dofs.dof_info(e, J);
+        for (uint64_t I = 0; I < test_dofs.nodes_per_elem; I++) {
+          DoF row = test_dofs.dof_info(e, I);
+          SLIC_ERROR_IF(row.sign() != 1 || col.sign() != 1,
+                        "block assembly requires spaces without sign flips in their dofs (e.g. H1 or L2)");
+          f(static_cast<uint32_t>(row.index()), static_cast<uint32_t>(col.index()));
+        }
+      }
+    }
+  }
 };
 
 }  // namespace serac
@@ -10,6 +10,10 @@
 #include "serac/numerics/functional/integral_utilities.hpp"
 #include "serac/numerics/functional/function_signature.hpp"
 #include "serac/numerics/functional/differentiate_wrt.hpp"
+#include "serac/numerics/functional/derivative_storage.hpp"
+#include "serac/numerics/functional/simd_element_batching.hpp"
+#include "serac/numerics/functional/tabulated_element_gradient.hpp"
+#include "serac/numerics/functional/interpolation_cache.hpp"
 
 #include <array>
 
@@ -69,8 +73,39 @@ auto get_derivative_type(lambda qf, qpt_data_type&& qpt_data)
   return get_gradient(detail::apply_qf(qf, tensor<double, dim>{}, qpt_data, make_dual_wrt<i>(qf_arguments{})));
 };
 
+/// @brief the type used to store the derivatives of a q-function with respect to trial space i
+template <int i, int dim, typename lambda, typename qpt_data_type, typename... trials>
+using qf_derivative_storage_t = detail::derivative_storage_t<
+    lambda, decltype(get_derivative_type<i, dim, trials...>(std::declval<lambda>(), qdata_value_t<qpt_data_type>{}))>;
+
+/**
+ * @brief allocate the memory for the derivatives of a q-function with respect to each trial space, at each quadrature
+ * point of the given number of elements
+ *
+ * @note the derivatives are stored in single precision if the q-function was wrapped with
+ * `with_single_precision_derivatives()`, and with isotropic rank-4 tensors if it was wrapped with
+ * `with_isotropic_derivatives()`
+ */
+template <int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename test, typename... trials, typename lambda,
+          typename qpt_data_type, int... i>
+auto allocate_qf_derivatives(FunctionSignature<test(trials...)>, const lambda&,
+                             std::shared_ptr<QuadratureData<qpt_data_type> >, uint32_t num_elements,
+                             std::integer_sequence<int, i...>)
+{
+  constexpr int         dim              = dimension_of(geom);
+  constexpr std::size_t qpts_per_element = num_quadrature_points(geom, Q);
+
+  // derivatives that are zero by construction aren't stored at all
+  return serac::make_tuple(
+      accelerator::make_shared_array<exec, qf_derivative_storage_t<i, dim, lambda, qpt_data_type, trials...> >(
+          detail::is_structurally_zero_v<qf_derivative_storage_t<i, dim, lambda, qpt_data_type, trials...> >
+              ? 0
+              : num_elements * qpts_per_element,
+          memory::Subsystem::QFunctionDerivatives)...);
+}
+
 template <typename lambda, int dim, int n, typename... T>
-auto batch_apply_qf_no_qdata(lambda qf, const tensor<double, dim, n> x, const T&... inputs)
+SERAC_HOST_DEVICE auto batch_apply_qf_no_qdata(lambda qf, const tensor<double, dim, n> x, const T&... inputs)
 {
   using return_type = decltype(qf(tensor<double, dim>{}, T{}[0]...));
   tensor<return_type, n> outputs{};
@@ -84,11 +119,19 @@ auto batch_apply_qf_no_qdata(lambda qf, const tensor<double, dim, n> x, const T&
   return outputs;
 }
 
-template <typename lambda, int dim, int n, typename qpt_data_type, typename... T>
-auto batch_apply_qf(lambda qf, const tensor<double, dim, n> x, qpt_data_type* qpt_data, bool update_state,
-                    const T&... inputs)
+/**
+ * @brief evaluate a q-function with quadrature point data at each quadrature point of an element
+ *
+ * @param qpt_data the quadrature point data the q-function starts from (see QuadratureData::at())
+ * @param updated where the updated quadrature point data is written (see QuadratureData::updated()),
+ * or nullptr to leave it unchanged
+ */
+template <typename lambda, int dim, int n, typename qpt_data_type, typename updated_type, typename... T>
+SERAC_HOST_DEVICE auto batch_apply_qf(lambda qf, const tensor<double, dim, n> x, qpt_data_type qpt_data,
+                                      updated_type updated, const T&... inputs)
 {
-  using return_type = decltype(qf(tensor<double, dim>{}, qpt_data[0], T{}[0]...));
+  using value_type  = decltype(detail::load_qdata(qpt_data, 0));
+  using return_type = decltype(qf(tensor<double, dim>{}, std::declval<value_type&>(), T{}[0]...));
   tensor<return_type, n> outputs{};
   for (int i = 0; i < n; i++) {
     tensor<double, dim> x_q;
@@ -96,52 +139,189 @@ auto batch_apply_qf(lambda qf, const tensor<double, dim, n> x, qpt_data_type* qp
       x_q[j] = x(j, i);
     }
 
-    auto qdata = qpt_data[i];
+    auto qdata = detail::load_qdata(qpt_data, size_t(i));
     outputs[i] = qf(x_q, qdata, inputs[i]...);
-    if (update_state) {
-      qpt_data[i] = qdata;
+    if constexpr (!std::is_same_v<updated_type, std::nullptr_t>) {
+      if (updated) {
+        detail::store_qdata(updated, size_t(i), qdata);
+      }
     }
   }
   return outputs;
 }
 
-template <uint32_t differentiation_index, int Q, mfem::Geometry::Type geom, typename test, typename... trials,
-          typename lambda_type, typename state_type, typename derivative_type, int... indices>
-void evaluation_kernel_impl(FunctionSignature<test(trials...)>, const std::vector<const double*>& inputs,
-                            double* outputs, const double* positions, const double* jacobians, lambda_type qf,
+/**
+ * @brief a version of evaluation_kernel_impl() (without derivatives or quadrature point data) that evaluates
+ * the q-function on W elements at a time, with the values for each element in a separate lane of a serac::simd pack
+ *
+ * @note when the number of elements isn't a multiple of W, the final lanes of the last batch repeat its last element,
+ * and their results are discarded
+ */
+template <int W, int Q, mfem::Geometry::Type geom, typename test, typename... trials, typename lambda_type,
+          int... indices>
+void simd_evaluation_kernel_impl(FunctionSignature<test(trials...)>, const std::vector<const double*>& inputs,
+                                 double* outputs, const double* positions, const double* jacobians, lambda_type qf,
+                                 InterpolationCache<Q, geom, trials...>& interpolation_cache, uint32_t first_element,
+                                 uint32_t num_elements, std::integer_sequence<int, indices...>)
+{
+  using test_element = finite_element<geom, test>;
+
+  /// @brief the element type for each trial space
+  using trial_elements = tuple<finite_element<geom, trials>...>;
+
+  auto r = reinterpret_cast<typename test_element::dof_type*>(outputs);
+  auto x = reinterpret_cast<const typename batched_position<geom, Q>::type*>(positions) + first_element;
+  auto J = reinterpret_cast<const typename batched_jacobian<geom, Q>::type*>(jacobians) + first_element;
+
+  constexpr int dim           = dimension_of(geom);
+  constexpr int qpts_per_elem = num_quadrature_points(geom, Q);
+
+  tuple u = {reinterpret_cast<const typename decltype(type<indices>(trial_elements{}))::dof_type*>(inputs[indices])...};
+
+  auto cached   = interpolation_cache.template pointers<ExecutionSpace::CPU>(first_element);
+  auto supplied = interpolation_cache.template supplied_values<ExecutionSpace::CPU>(first_element);
+  bool refresh  = interpolation_cache.state->refresh;
+
+  uint32_t num_batches = (num_elements + W - 1) / W;
+
+  // for each batch of W elements
+  accelerator::forall<ExecutionSpace::CPU>(num_batches, [=](uint32_t b) {
+    TensorProductQuadratureRule<Q> rule{};
+
+    uint32_t elements[W];
+    for (int j = 0; j < W; j++) {
+      elements[j] = std::min(b * W + uint32_t(j), num_elements - 1);
+    }
+
+    // batch-calculate values / derivatives of each trial space for each element, and transform
+    // them from the parent element to the corresponding values / derivatives on the physical element
+    using input_type =
+        decltype(tuple{decltype(type<indices>(trial_elements{}))::interpolate(get<indices>(u)[0], rule)...});
+    input_type qf_inputs[W];
+    for (int j = 0; j < W; j++) {
+      qf_inputs[j] = {interpolate_or_reuse<decltype(type<indices>(trial_elements{}))>(
+          get<indices>(u)[elements[j]], rule, get<indices>(cached), get<indices>(supplied), elements[j], refresh)...};
+      (parent_to_physical<decltype(type<indices>(trial_elements{}))::family>(get<indices>(qf_inputs[j]),
+                                                                              J[elements[j]]),
+       ...);
+    }
+
+    // evaluate the q-function at each quadrature point, for all of the elements in this batch at once
+    using output_type = decltype(qf(tensor<double, dim>{}, get<indices>(qf_inputs[0])[0]...));
+    tensor<output_type, qpts_per_elem> qf_outputs[W];
+    for (int q = 0; q < qpts_per_elem; q++) {
+      tensor<simd<double, W>, dim> x_q{};
+      tuple<detail::simd_type_t<std::decay_t<decltype(get<indices>(qf_inputs[0])[0])>, W>...> args{};
+      for (int j = 0; j < W; j++) {
+        for (int k = 0; k < dim; k++) {
+          x_q[k][j] = x[elements[j]](k, q);
+        }
+        (detail::pack_lane(get<indices>(qf_inputs[j])[q], get<indices>(args), j), ...);
+      }
+
+      auto output = qf(x_q, get<indices>(args)...);
+      for (int j = 0; j < W; j++) {
+        detail::unpack_lane(output, qf_outputs[j][q], j);
+      }
+    }
+
+    // transform the sources / fluxes back to the parent element, and integrate
+    // them against the test-space basis functions, for each (distinct) element
+    for (uint32_t j = 0; j < W && b * W + j < num_elements; j++) {
+      physical_to_parent<test_element::family>(qf_outputs[j], J[elements[j]]);
+      test_element::integrate(qf_outputs[j], rule, &r[elements[j]]);
+    }
+  });
+}
+
+template <uint32_t differentiation_index, int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename test,
+          typename... trials, typename lambda_type, typename state_type, typename derivative_type, int... indices>
+void evaluation_kernel_impl(FunctionSignature<test(trials...)> s, const std::vector<const double*>& inputs,
+                            double* outputs, const double* positions, const double* jacobians,
+                            const double* affine_jacobians, const double* inverse_jacobians, lambda_type qf,
                             QuadratureData<state_type>& qf_state, [[maybe_unused]] derivative_type* qf_derivatives,
-                            uint32_t num_elements, bool update_state, std::integer_sequence<int, indices...>)
+                            InterpolationCache<Q, geom, trials...>& interpolation_cache, uint32_t first_element,
+                            uint32_t num_elements, bool update_state, std::integer_sequence<int, indices...> seq)
 {
   using test_element = finite_element<geom, test>;
 
   /// @brief the element type for each trial space
-  static constexpr tuple<finite_element<geom, trials>...> trial_elements{};
+  using trial_elements = tuple<finite_element<geom, trials>...>;
+
+  static_assert(exec == ExecutionSpace::CPU || std::is_same_v<state_type, Nothing>,
+                "quadrature point data is not yet supported for ExecutionSpace::GPU");
+
+  // q-functions that opted in to element batching evaluate their residuals W elements at a time,
+  // see SimdElementBatching
+  constexpr int W = detail::simd_width<lambda_type>::value;
+  if constexpr (W > 1 && differentiation_index == NO_DIFFERENTIATION && std::is_same_v<state_type, Nothing> &&
+                exec == ExecutionSpace::CPU) {
+    simd_evaluation_kernel_impl<W, Q, geom>(s, inputs, outputs, positions, jacobians, qf, interpolation_cache,
+                                            first_element, num_elements, seq);
+    return;
+  }
 
   // mfem provides this information as opaque arrays of doubles,
   // so we reinterpret the pointer with
+  //
+  // note: `inputs` and `outputs` only describe the elements [first_element, first_element + num_elements),
+  // so the other per-element quantities are offset to begin at `first_element` as well
   auto r = reinterpret_cast<typename test_element::dof_type*>(outputs);
-  auto x = reinterpret_cast<const typename batched_position<geom, Q>::type*>(positions);
-  auto J = reinterpret_cast<const typename batched_jacobian<geom, Q>::type*>(jacobians);
-  static constexpr TensorProductQuadratureRule<Q> rule{};
+  auto x = reinterpret_cast<const typename batched_position<geom, Q>::type*>(positions) + first_element;
+  auto J = reinterpret_cast<const typename batched_jacobian<geom, Q>::type*>(jacobians) + first_element;
+
+  // elements with affine isoparametric maps (if all of them are, see GeometricFactors::affine) transform
+  // their values with a single jacobian (and inverse) each
+  using affine_type = AffineJacobian<dimension_of(geom)>;
+  auto J_affine     = reinterpret_cast<const affine_type*>(affine_jacobians);
+  if (J_affine != nullptr) J_affine += first_element;
+
+  constexpr int qpts_per_elem = num_quadrature_points(geom, Q);
 
-  static constexpr int qpts_per_elem = num_quadrature_points(geom, Q);
+  // the other elements may have precomputed the inverses of their jacobians (see GeometricFactors::inverse_jacobians)
+  using inverse_type = InverseJacobians<dimension_of(geom), qpts_per_elem>;
+  auto J_inverse     = reinterpret_cast<const inverse_type*>(inverse_jacobians);
+  if (J_inverse != nullptr) J_inverse += first_element;
 
   [[maybe_unused]] tuple u = {
-      reinterpret_cast<const typename decltype(type<indices>(trial_elements))::dof_type*>(inputs[indices])...};
+      reinterpret_cast<const typename decltype(type<indices>(trial_elements{}))::dof_type*>(inputs[indices])...};
+
+  [[maybe_unused]] auto* state = &qf_state;
+  if (update_state) {
+    qf_state.markUpdated();
+  }
+
+  // a trial space whose values at each quadrature point are reused between evaluations (if any),
+  // and those whose values at each quadrature point are supplied instead of interpolated
+  [[maybe_unused]] auto cached   = interpolation_cache.template pointers<exec>(first_element);
+  [[maybe_unused]] auto supplied = interpolation_cache.template supplied_values<exec>(first_element);
+  [[maybe_unused]] bool refresh  = interpolation_cache.state->refresh;
 
   // for each element in the domain
-  for (uint32_t e = 0; e < num_elements; e++) {
+  accelerator::forall<exec>(num_elements, [=] SERAC_HOST_DEVICE(uint32_t e) {
+    TensorProductQuadratureRule<Q> rule{};
+
     // load the jacobians and positions for each quadrature point in this element
     auto J_e = J[e];
     auto x_e = x[e];
 
     // batch-calculate values / derivatives of each trial space, at each quadrature point
     [[maybe_unused]] tuple qf_inputs = {promote_each_to_dual_when<indices == differentiation_index>(
-        get<indices>(trial_elements).interpolate(get<indices>(u)[e], rule))...};
+        interpolate_or_reuse<decltype(type<indices>(trial_elements{}))>(get<indices>(u)[e], rule, get<indices>(cached),
+                                                                        get<indices>(supplied), e, refresh))...};
 
     // use J_e to transform values / derivatives on the parent element
     // to the to the corresponding values / derivatives on the physical element
-    (parent_to_physical<get<indices>(trial_elements).family>(get<indices>(qf_inputs), J_e), ...);
+    if (J_affine != nullptr) {
+      (parent_to_physical<decltype(type<indices>(trial_elements{}))::family>(get<indices>(qf_inputs), J_affine[e]),
+       ...);
+    } else if (J_inverse != nullptr) {
+      (parent_to_physical<decltype(type<indices>(trial_elements{}))::family>(get<indices>(qf_inputs), J_e,
+                                                                              J_inverse[e]),
+       ...);
+    } else {
+      (parent_to_physical<decltype(type<indices>(trial_elements{}))::family>(get<indices>(qf_inputs), J_e), ...);
+    }
 
     // (batch) evalute the q-function at each quadrature point
     //
@@ -152,31 +332,220 @@ void evaluation_kernel_impl(FunctionSignature<test(trials...)>, const std::vecto
       if constexpr (std::is_same_v<state_type, Nothing>) {
         return batch_apply_qf_no_qdata(qf, x_e, get<indices>(qf_inputs)...);
       } else {
-        return batch_apply_qf(qf, x_e, &qf_state(e, 0), update_state, get<indices>(qf_inputs)...);
+        return batch_apply_qf(qf, x_e, state->at(first_element + e),
+                              update_state ? state->updated(first_element + e) : nullptr, get<indices>(qf_inputs)...);
       }
     }();
 
     // use J to transform sources / fluxes on the physical element
     // back to the corresponding sources / fluxes on the parent element
-    physical_to_parent<test_element::family>(qf_outputs, J_e);
+    if (J_affine != nullptr) {
+      physical_to_parent<test_element::family>(qf_outputs, J_affine[e]);
+    } else if (J_inverse != nullptr) {
+      physical_to_parent<test_element::family>(qf_outputs, J_e, J_inverse[e]);
+    } else {
+      physical_to_parent<test_element::family>(qf_outputs, J_e);
+    }
 
     // write out the q-function derivatives after applying the
     // physical_to_parent transformation, so that those transformations
     // won't need to be applied in the action_of_gradient and element_gradient kernels
-    if constexpr (differentiation_index != serac::NO_DIFFERENTIATION) {
+    if constexpr (differentiation_index != serac::NO_DIFFERENTIATION &&
+                  !detail::is_structurally_zero_v<derivative_type>) {
       for (int q = 0; q < leading_dimension(qf_outputs); q++) {
-        qf_derivatives[e * qpts_per_elem + uint32_t(q)] = get_gradient(qf_outputs[q]);
+        detail::precision_copy(get_gradient(qf_outputs[q]),
+                               qf_derivatives[(first_element + e) * qpts_per_elem + uint32_t(q)]);
       }
     }
 
     // (batch) integrate the material response against the test-space basis functions
     test_element::integrate(get_value(qf_outputs), rule, &r[e]);
+  });
+}
+
+/**
+ * @brief a version of evaluation_kernel_impl() that stores the derivatives of the q-function with respect to several
+ * trial spaces in the same pass over the elements (so the trial space values are only interpolated once per element)
+ *
+ * @param qf_derivatives where to write the derivatives with respect to each trial space
+ * @param which a bitmask of the trial spaces to differentiate with respect to: bit i selects trial space i
+ *
+ * @note the q-function is evaluated once for each selected trial space, and only its final evaluation updates the
+ * quadrature point data (if requested), so that every evaluation starts from the same state
+ */
+template <int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename test, typename... trials,
+          typename lambda_type, typename state_type, typename... derivative_type, int... indices>
+void evaluation_kernel_with_multiple_derivatives_impl(FunctionSignature<test(trials...)>,
+                                                      const std::vector<const double*>& inputs, double* outputs,
+                                                      const double* positions, const double* jacobians,
+                                                      lambda_type qf, QuadratureData<state_type>& qf_state,
+                                                      tuple<derivative_type*...>              qf_derivatives,
+                                                      InterpolationCache<Q, geom, trials...>& interpolation_cache,
+                                                      uint32_t which, uint32_t first_element, uint32_t num_elements,
+                                                      bool update_state, std::integer_sequence<int, indices...>)
+{
+  using test_element = finite_element<geom, test>;
+
+  /// @brief the element type for each trial space
+  using trial_elements = tuple<finite_element<geom, trials>...>;
+
+  static_assert(exec == ExecutionSpace::CPU || std::is_same_v<state_type, Nothing>,
+                "quadrature point data is not yet supported for ExecutionSpace::GPU");
+
+  auto r = reinterpret_cast<typename test_element::dof_type*>(outputs);
+  auto x = reinterpret_cast<const typename batched_position<geom, Q>::type*>(positions) + first_element;
+  auto J = reinterpret_cast<const typename batched_jacobian<geom, Q>::type*>(jacobians) + first_element;
+
+  constexpr int qpts_per_elem = num_quadrature_points(geom, Q);
+
+  tuple u = {reinterpret_cast<const typename decltype(type<indices>(trial_elements{}))::dof_type*>(inputs[indices])...};
+
+  [[maybe_unused]] auto* state = &qf_state;
+  if (update_state) {
+    qf_state.markUpdated();
   }
+
+  // a trial space whose values at each quadrature point are reused between evaluations (if any),
+  // and those whose values at each quadrature point are supplied instead of interpolated
+  [[maybe_unused]] auto cached   = interpolation_cache.template pointers<exec>(first_element);
+  [[maybe_unused]] auto supplied = interpolation_cache.template supplied_values<exec>(first_element);
+  [[maybe_unused]] bool refresh  = interpolation_cache.state->refresh;
+
+  // for each element in the domain
+  accelerator::forall<exec>(num_elements, [=] SERAC_HOST_DEVICE(uint32_t e) {
+    TensorProductQuadratureRule<Q> rule{};
+
+    // load the jacobians and positions for each quadrature point in this element
+    auto J_e = J[e];
+    auto x_e = x[e];
+
+    // batch-calculate values / derivatives of each trial space, at each quadrature point
+    tuple values = {interpolate_or_reuse<decltype(type<indices>(trial_elements{}))>(
+        get<indices>(u)[e], rule, get<indices>(cached), get<indices>(supplied), e, refresh)...};
+
+    for_constexpr<sizeof...(trials)>([&](auto i) {
+      if (((which >> i) & 1) == 0) return;
+
+      // the last selected trial space is responsible for the residual and the state update
+      bool last = (which >> i) == 1;
+
+      [[maybe_unused]] tuple qf_inputs = {promote_each_to_dual_when<indices == i>(get<indices>(values))...};
+
+      (parent_to_physical<decltype(type<indices>(trial_elements{}))::family>(get<indices>(qf_inputs), J_e), ...);
+
+      auto qf_outputs = [&]() {
+        if constexpr (std::is_same_v<state_type, Nothing>) {
+          return batch_apply_qf_no_qdata(qf, x_e, get<indices>(qf_inputs)...);
+        } else {
+          return batch_apply_qf(qf, x_e, state->at(first_element + e),
+                                (update_state && last) ? state->updated(first_element + e) : nullptr,
+                                get<indices>(qf_inputs)...);
+        }
+      }();
+
+      physical_to_parent<test_element::family>(qf_outputs, J_e);
+
+      using stored_type = std::remove_pointer_t<std::decay_t<decltype(get<i>(qf_derivatives))>>;
+      if constexpr (!detail::is_structurally_zero_v<stored_type>) {
+        for (int q = 0; q < leading_dimension(qf_outputs); q++) {
+          detail::precision_copy(get_gradient(qf_outputs[q]),
+                                 get<i>(qf_derivatives)[(first_element + e) * qpts_per_elem + uint32_t(q)]);
+        }
+      }
+
+      if (last) {
+        test_element::integrate(get_value(qf_outputs), rule, &r[e]);
+      }
+    });
+  });
 }
 
 //clang-format off
+/**
+ * @brief a version of evaluation_kernel_impl() for q-functions wrapped with `with_directional_derivatives<K>()`, that
+ * evaluates the integral along with its directional derivatives in several directions, propagating K of them
+ * through each evaluation of the q-function
+ *
+ * @param directions the values of each direction for the elements [first_element, first_element + num_elements)
+ * @param direction_trial the (integral) index of the trial space that each direction perturbs, where directions
+ * with any other value perturb a trial space that this integral doesn't depend on
+ * @param outputs the values of the integral, followed by its derivative in each direction (each describing
+ * `num_elements` elements)
+ *
+ * @note the quadrature point data is only read, not updated
+ */
+template <int K, int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename test, typename... trials,
+          typename lambda_type, typename state_type, int... indices>
+void directional_derivatives_kernel_impl(FunctionSignature<test(trials...)>, const std::vector<const double*>& inputs,
+                                         const std::vector<const double*>& directions,
+                                         const std::vector<uint32_t>& direction_trial, double* outputs,
+                                         const double* positions, const double* jacobians, lambda_type qf,
+                                         QuadratureData<state_type>& qf_state, uint32_t first_element,
+                                         uint32_t num_elements, std::integer_sequence<int, indices...>)
+{
+  static_assert(exec == ExecutionSpace::CPU, "directional derivatives are only supported for ExecutionSpace::CPU");
+
+  using test_element = finite_element<geom, test>;
+
+  /// @brief the element type for each trial space
+  using trial_elements = tuple<finite_element<geom, trials>...>;
+
+  auto r = reinterpret_cast<typename test_element::dof_type*>(outputs);
+  auto x = reinterpret_cast<const typename batched_position<geom, Q>::type*>(positions) + first_element;
+  auto J = reinterpret_cast<const typename batched_jacobian<geom, Q>::type*>(jacobians) + first_element;
+
+  tuple u = {reinterpret_cast<const typename decltype(type<indices>(trial_elements{}))::dof_type*>(inputs[indices])...};
+
+  [[maybe_unused]] auto* state          = &qf_state;
+  const int              num_directions = int(directions.size());
+
+  // for each element in the domain
+  accelerator::forall<exec>(num_elements, [=](uint32_t e) {
+    TensorProductQuadratureRule<Q> rule{};
+
+    auto J_e = J[e];
+    auto x_e = x[e];
+
+    tuple values = {decltype(type<indices>(trial_elements{}))::interpolate(get<indices>(u)[e], rule)...};
+
+    // the directions are propagated K at a time, and the first pass is also responsible for the values
+    for (int first = 0; first == 0 || first < num_directions; first += K) {
+      int count = std::min(K, num_directions - first);
+
+      tuple qf_inputs = {make_multidirectional_dual<K>(get<indices>(values))...};
+      for (int d = 0; d < count; d++) {
+        for_constexpr<sizeof...(trials)>([&](auto i) {
+          if (direction_trial[uint32_t(first + d)] != uint32_t(i)) return;
+          using trial_element = decltype(type<i>(trial_elements{}));
+          auto du = reinterpret_cast<const typename trial_element::dof_type*>(directions[uint32_t(first + d)]);
+          seed_direction(get<i>(qf_inputs), trial_element::interpolate(du[e], rule), d);
+        });
+      }
+
+      (parent_to_physical<decltype(type<indices>(trial_elements{}))::family>(get<indices>(qf_inputs), J_e), ...);
+
+      auto qf_outputs = [&]() {
+        if constexpr (std::is_same_v<state_type, Nothing>) {
+          return batch_apply_qf_no_qdata(qf, x_e, get<indices>(qf_inputs)...);
+        } else {
+          return batch_apply_qf(qf, x_e, state->at(first_element + e), nullptr, get<indices>(qf_inputs)...);
+        }
+      }();
+
+      physical_to_parent<test_element::family>(qf_outputs, J_e);
+
+      if (first == 0) {
+        test_element::integrate(get_value(qf_outputs), rule, &r[e]);
+      }
+      for (int d = 0; d < count; d++) {
+        test_element::integrate(get_direction(qf_outputs, d), rule, &r[uint32_t(first + d + 1) * num_elements + e]);
+      }
+    }
+  });
+}
+
 template <bool is_QOI, typename S, typename T>
-auto chain_rule(const S& dfdx, const T& dx)
+SERAC_HOST_DEVICE auto chain_rule(const S& dfdx, const T& dx)
 {
   if constexpr (is_QOI) {
     return serac::chain_rule(serac::get<0>(dfdx), serac::get<0>(dx)) +
@@ -193,16 +562,46 @@ auto chain_rule(const S& dfdx, const T& dx)
 //clang-format on
 
 template <bool is_QOI, typename derivative_type, int n, typename T>
-auto batch_apply_chain_rule(derivative_type* qf_derivatives, const tensor<T, n>& inputs)
+SERAC_HOST_DEVICE auto batch_apply_chain_rule(derivative_type* qf_derivatives, const tensor<T, n>& inputs)
 {
-  using return_type = decltype(chain_rule<is_QOI>(derivative_type{}, T{}));
+  using full_derivative_type = detail::double_precision_t<std::remove_const_t<derivative_type>>;
+  using return_type          = decltype(chain_rule<is_QOI>(full_derivative_type{}, T{}));
   tensor<return_type, n> outputs{};
   for (int i = 0; i < n; i++) {
-    outputs[i] = chain_rule<is_QOI>(qf_derivatives[i], inputs[i]);
+    outputs[i] = chain_rule<is_QOI>(detail::to_double_precision(qf_derivatives[i]), inputs[i]);
   }
   return outputs;
 }
 
+/**
+ * @brief the body of action_of_gradient_kernel() for a single element
+ *
+ * @param[in] du_e the DOF values of the perturbation on this element
+ * @param[inout] dr_e the resulting perturbation of this element's residual
+ * @param[in] qf_derivatives_e the derivatives of the q-function at each quadrature point of this element
+ */
+template <int Q, mfem::Geometry::Type g, typename test, typename trial, typename derivatives_type>
+SERAC_HOST_DEVICE void action_of_gradient_element(const typename finite_element<g, trial>::dof_type& du_e,
+                                                  typename finite_element<g, test>::dof_type& dr_e,
+                                                  const derivatives_type* qf_derivatives_e)
+{
+  using test_element  = finite_element<g, test>;
+  using trial_element = finite_element<g, trial>;
+
+  constexpr bool is_QOI = (test::family == Family::QOI);
+
+  TensorProductQuadratureRule<Q> rule{};
+
+  // (batch) interpolate each quadrature point's value
+  auto qf_inputs = trial_element::interpolate(du_e, rule);
+
+  // (batch) evalute the q-function at each quadrature point
+  auto qf_outputs = batch_apply_chain_rule<is_QOI>(qf_derivatives_e, qf_inputs);
+
+  // (batch) integrate the material response against the test-space basis functions
+  test_element::integrate(qf_outputs, rule, &dr_e);
+}
+
 /**
  * @brief The base kernel template used to create create custom directional derivative
  * kernels associated with finite element calculations
@@ -227,33 +626,153 @@ auto batch_apply_chain_rule(derivative_type* qf_derivatives, const tensor<T, n>&
  * @param[in] J_ The Jacobians of the element transformations at all quadrature points
  * @see mfem::GeometricFactors
  * @param[in] num_elements The number of elements in the mesh
+ * @param[in] num_directions The number of perturbations to apply the gradient to: dU and dR hold the values for each
+ * perturbation one after another, each describing `num_elements` elements
  */
 
-template <int Q, mfem::Geometry::Type g, typename test, typename trial, typename derivatives_type>
-void action_of_gradient_kernel(const double* dU, double* dR, derivatives_type* qf_derivatives, std::size_t num_elements)
+template <int Q, mfem::Geometry::Type g, ExecutionSpace exec, typename test, typename trial, typename derivatives_type>
+void action_of_gradient_kernel(const double* dU, double* dR, derivatives_type* qf_derivatives, std::size_t num_elements,
+                               uint32_t num_directions)
 {
   using test_element  = finite_element<g, test>;
   using trial_element = finite_element<g, trial>;
 
-  static constexpr bool is_QOI   = (test::family == Family::QOI);
-  static constexpr int  num_qpts = num_quadrature_points(g, Q);
+  constexpr int num_qpts = num_quadrature_points(g, Q);
 
   // mfem provides this information in 1D arrays, so we reshape it
   // into strided multidimensional arrays before using
-  auto                                            du = reinterpret_cast<const typename trial_element::dof_type*>(dU);
-  auto                                            dr = reinterpret_cast<typename test_element::dof_type*>(dR);
-  static constexpr TensorProductQuadratureRule<Q> rule{};
+  auto du = reinterpret_cast<const typename trial_element::dof_type*>(dU);
+  auto dr = reinterpret_cast<typename test_element::dof_type*>(dR);
 
-  // for each element in the domain
-  for (uint32_t e = 0; e < num_elements; e++) {
-    // (batch) interpolate each quadrature point's value
-    auto qf_inputs = trial_element::interpolate(du[e], rule);
+  // for each element in the domain, the q-function derivatives are loaded
+  // once and applied to each of the perturbations
+  accelerator::forall<exec>(uint32_t(num_elements), [=] SERAC_HOST_DEVICE(uint32_t e) {
+    for (uint32_t d = 0; d < num_directions; d++) {
+      std::size_t i = std::size_t(d) * num_elements + e;
+      action_of_gradient_element<Q, g, test, trial>(du[i], dr[i], qf_derivatives + e * num_qpts);
+    }
+  });
+}
 
-    // (batch) evalute the q-function at each quadrature point
-    auto qf_outputs = batch_apply_chain_rule<is_QOI>(qf_derivatives + e * num_qpts, qf_inputs);
+/**
+ * @brief the transpose of chain_rule(), for the derivatives of the (source, flux) outputs of a q-function with
+ * respect to the (value, derivative) of one of its arguments
+ *
+ * @tparam input_type the type of that argument at a quadrature point
+ * @param dfdx the derivatives of the q-function outputs w.r.t. that argument
+ * @param df a small change in the (source, flux) outputs
+ */
+template <typename input_type, typename S, typename T>
+SERAC_HOST_DEVICE auto chain_rule_transpose(const S& dfdx, const T& df)
+{
+  using value_type      = std::decay_t<decltype(serac::get<0>(input_type{}))>;
+  using derivative_type = std::decay_t<decltype(serac::get<1>(input_type{}))>;
+  return serac::tuple{
+      serac::chain_rule_transpose<value_type>(serac::get<0>(serac::get<0>(dfdx)), serac::get<0>(df)) +
+          serac::chain_rule_transpose<value_type>(serac::get<0>(serac::get<1>(dfdx)), serac::get<1>(df)),
+      serac::chain_rule_transpose<derivative_type>(serac::get<1>(serac::get<0>(dfdx)), serac::get<0>(df)) +
+          serac::chain_rule_transpose<derivative_type>(serac::get<1>(serac::get<1>(dfdx)), serac::get<1>(df))};
+}
 
-    // (batch) integrate the material response against the test-space basis functions
-    test_element::integrate(qf_outputs, rule, &dr[e]);
+/**
+ * @brief the body of transpose_action_of_gradient_kernel() for a single element
+ *
+ * @param[in] dr_e the DOF values of the perturbation of this element's residual
+ * @param[inout] du_e the resulting perturbation in the trial space on this element
+ * @param[in] qf_derivatives_e the derivatives of the q-function at each quadrature point of this element
+ */
+template <int Q, mfem::Geometry::Type g, typename test, typename trial, typename derivatives_type>
+SERAC_HOST_DEVICE void transpose_action_of_gradient_element(const typename finite_element<g, test>::dof_type& dr_e,
+                                                            typename finite_element<g, trial>::dof_type& du_e,
+                                                            const derivatives_type* qf_derivatives_e)
+{
+  using test_element    = finite_element<g, test>;
+  using trial_element   = finite_element<g, trial>;
+  using derivative_type = detail::double_precision_t<std::remove_const_t<derivatives_type>>;
+
+  constexpr int nqp = num_quadrature_points(g, Q);
+
+  TensorProductQuadratureRule<Q> rule{};
+
+  // (batch) interpolate the perturbation of the residual (and its derivatives) at each quadrature point
+  auto test_values = test_element::interpolate(dr_e, rule);
+
+  // apply the transpose of the q-function derivatives at each quadrature point
+  using input_type  = std::decay_t<decltype(trial_element::interpolate(du_e, rule)[0])>;
+  using output_type = decltype(chain_rule_transpose<input_type>(derivative_type{}, test_values[0]));
+  tensor<output_type, nqp> qf_outputs{};
+  for (int q = 0; q < nqp; q++) {
+    qf_outputs[q] = chain_rule_transpose<input_type>(detail::to_double_precision(qf_derivatives_e[q]), test_values[q]);
+  }
+
+  // (batch) integrate the result against the trial-space basis functions
+  trial_element::integrate(qf_outputs, rule, &du_e);
+}
+
+/**
+ * @brief the transpose of action_of_gradient_kernel(), i.e. the vector-jacobian product: applies the transpose
+ * of the stored q-function derivatives to a perturbation of the residual, without forming the element matrices
+ *
+ * @param[in] dR the per-element values of the perturbation of the residual (test space)
+ * @param[inout] dU the resulting per-element values in the trial space
+ * @param[in] qf_derivatives the derivatives of the q-function at each quadrature point
+ * @param[in] num_elements the number of elements
+ */
+template <int Q, mfem::Geometry::Type g, ExecutionSpace exec, typename test, typename trial, typename derivatives_type>
+void transpose_action_of_gradient_kernel(const double* dR, double* dU, derivatives_type* qf_derivatives,
+                                         std::size_t num_elements)
+{
+  using test_element  = finite_element<g, test>;
+  using trial_element = finite_element<g, trial>;
+
+  constexpr int nqp = num_quadrature_points(g, Q);
+  auto          dr  = reinterpret_cast<const typename test_element::dof_type*>(dR);
+  auto          du  = reinterpret_cast<typename trial_element::dof_type*>(dU);
+
+  accelerator::forall<exec>(uint32_t(num_elements), [=] SERAC_HOST_DEVICE(uint32_t e) {
+    transpose_action_of_gradient_element<Q, g, test, trial>(dr[e], du[e], qf_derivatives + e * nqp);
+  });
+}
+
+/**
+ * @brief the body of element_gradient_kernel() for a single element
+ *
+ * @param[inout] K_e the element gradient matrix of this element
+ * @param[in] qf_derivatives_e the derivatives of the q-function at each quadrature point of this element
+ */
+template <int Q, mfem::Geometry::Type g, typename test, typename trial, typename derivatives_type>
+SERAC_HOST_DEVICE void element_gradient_element(double* K_e, const derivatives_type* qf_derivatives_e)
+{
+  // quantities of interest have no flux term, so we pad the derivative
+  // tuple with a "zero" type in the second position to treat it like the standard case
+  constexpr bool is_QOI        = test::family == Family::QOI;
+  using full_derivatives_type  = detail::dense_t<derivatives_type>;
+  using padded_derivative_type = std::conditional_t<is_QOI, tuple<full_derivatives_type, zero>, full_derivatives_type>;
+
+  using test_element  = finite_element<g, test>;
+  using trial_element = finite_element<g, trial>;
+
+  constexpr int nquad = num_quadrature_points(g, Q);
+
+  tensor<padded_derivative_type, nquad> derivatives{};
+  for (int q = 0; q < nquad; q++) {
+    if constexpr (is_QOI) {
+      get<0>(derivatives(q)) = detail::to_dense(qf_derivatives_e[q]);
+    } else {
+      derivatives(q) = detail::to_dense(qf_derivatives_e[q]);
+    }
+  }
+
+  if constexpr (detail::uses_tabulated_element_gradient<g, test, trial>()) {
+    detail::tabulated_element_gradient<Q, g, test, trial>(K_e, derivatives);
+  } else {
+    TensorProductQuadratureRule<Q> rule{};
+
+    auto* output_ptr = reinterpret_cast<typename test_element::dof_type*>(K_e);
+    for (int J = 0; J < trial_element::ndof; J++) {
+      auto source_and_flux = trial_element::batch_apply_shape_fn(J, derivatives, rule);
+      test_element::integrate(source_and_flux, rule, output_ptr + J, trial_element::ndof);
+    }
   }
 }
 
@@ -278,75 +797,560 @@ void action_of_gradient_kernel(const double* dU, double* dR, derivatives_type* q
  * @see mfem::GeometricFactors
  * @param[in] num_elements The number of elements in the mesh
  */
-template <mfem::Geometry::Type g, typename test, typename trial, int Q, typename derivatives_type>
-void element_gradient_kernel(ExecArrayView<double, 3, ExecutionSpace::CPU> dK, derivatives_type* qf_derivatives,
+template <mfem::Geometry::Type g, typename test, typename trial, int Q, ExecutionSpace exec, typename derivatives_type>
+void element_gradient_kernel(ExecArrayView<double, 3, exec> dK, derivatives_type* qf_derivatives,
                              std::size_t num_elements)
 {
-  // quantities of interest have no flux term, so we pad the derivative
-  // tuple with a "zero" type in the second position to treat it like the standard case
-  constexpr bool is_QOI        = test::family == Family::QOI;
-  using padded_derivative_type = std::conditional_t<is_QOI, tuple<derivatives_type, zero>, derivatives_type>;
-
   using test_element  = finite_element<g, test>;
   using trial_element = finite_element<g, trial>;
 
   constexpr int nquad = num_quadrature_points(g, Q);
 
-  static constexpr TensorProductQuadratureRule<Q> rule{};
+  // the number of entries in each element matrix
+  constexpr uint32_t entries_per_elem = uint32_t(test_element::ndof * test_element::components * trial_element::ndof *
+                                                 trial_element::components);
+
+  double* K = dK.data();
 
   // for each element in the domain
-  for (uint32_t e = 0; e < num_elements; e++) {
-    auto* output_ptr = reinterpret_cast<typename test_element::dof_type*>(&dK(e, 0, 0));
+  accelerator::forall<exec>(uint32_t(num_elements), [=] SERAC_HOST_DEVICE(uint32_t e) {
+    element_gradient_element<Q, g, test, trial>(K + e * entries_per_elem, qf_derivatives + e * nquad);
+  });
+}
 
-    tensor<padded_derivative_type, nquad> derivatives{};
-    for (int q = 0; q < nquad; q++) {
-      if constexpr (is_QOI) {
-        get<0>(derivatives(q)) = qf_derivatives[e * nquad + uint32_t(q)];
-      } else {
-        derivatives(q) = qf_derivatives[e * nquad + uint32_t(q)];
+/**
+ * @brief the counterpart of element_gradient_element() for symmetric element matrices (identical test and trial
+ * spaces, and a symmetric q-function tangent), which only stores the upper triangle of the element matrix
+ *
+ * @param[inout] K_e the upper triangle of the element gradient matrix of this element, stored row by row
+ * @param[in] qf_derivatives_e the derivatives of the q-function at each quadrature point of this element
+ */
+template <int Q, mfem::Geometry::Type g, typename space, typename derivatives_type>
+SERAC_HOST_DEVICE void symmetric_element_gradient_element(double* K_e, const derivatives_type* qf_derivatives_e)
+{
+  using element = finite_element<g, space>;
+
+  constexpr int      nquad = num_quadrature_points(g, Q);
+  constexpr uint32_t vdofs = uint32_t(element::ndof * element::components);
+
+  TensorProductQuadratureRule<Q> rule{};
+
+  tensor<detail::dense_t<derivatives_type>, nquad> derivatives{};
+  for (int q = 0; q < nquad; q++) {
+    derivatives(q) = detail::to_dense(qf_derivatives_e[q]);
+  }
+
+  // each row of the element matrix (one shape function, in every component) is integrated into a temporary,
+  // and only its entries on or above the diagonal are kept
+  for (int J = 0; J < element::ndof; J++) {
+    typename element::dof_type rows[element::components]{};
+    auto                       source_and_flux = element::batch_apply_shape_fn(J, derivatives, rule);
+    element::integrate(source_and_flux, rule, rows, 1);
+
+    const double* row_values = reinterpret_cast<const double*>(rows);
+    for (uint32_t c = 0; c < uint32_t(element::components); c++) {
+      uint32_t i = c * uint32_t(element::ndof) + uint32_t(J);
+      for (uint32_t j = i; j < vdofs; j++) {
+        K_e[detail::upper_triangle_index(vdofs, i, j)] = row_values[c * vdofs + j];
       }
     }
+  }
+}
 
-    for (int J = 0; J < trial_element::ndof; J++) {
-      auto source_and_flux = trial_element::batch_apply_shape_fn(J, derivatives, rule);
-      test_element::integrate(source_and_flux, rule, output_ptr + J, trial_element::ndof);
+/**
+ * @brief the counterpart of element_gradient_kernel() for symmetric element matrices, which only computes and stores
+ * the upper triangle of each element matrix, see symmetric_element_gradient_element()
+ *
+ * @param[inout] K the upper triangles of the element gradient matrices
+ * @param[in] qf_derivatives the derivatives of the q-function at each quadrature point
+ * @param[in] num_elements The number of elements in the mesh
+ */
+template <mfem::Geometry::Type g, typename space, int Q, ExecutionSpace exec, typename derivatives_type>
+void symmetric_element_gradient_kernel(double* K, derivatives_type* qf_derivatives, std::size_t num_elements)
+{
+  using element = finite_element<g, space>;
+
+  constexpr int      nquad            = num_quadrature_points(g, Q);
+  constexpr uint32_t entries_per_elem = detail::upper_triangle_size(uint32_t(element::ndof * element::components));
+
+  accelerator::forall<exec>(uint32_t(num_elements), [=] SERAC_HOST_DEVICE(uint32_t e) {
+    symmetric_element_gradient_element<Q, g, space>(K + e * entries_per_elem, qf_derivatives + e * nquad);
+  });
+}
+
+/**
+ * @brief the counterpart of action_of_gradient_element() for q-functions whose derivatives are the same at every
+ * quadrature point (see `with_constant_derivatives()`)
+ *
+ * @param[in] du_e the DOF values of the perturbation on this element
+ * @param[inout] dr_e the resulting perturbation of this element's residual
+ * @param[in] qf_derivative the derivative of the q-function with respect to its physical-space arguments
+ * @param[in] J_e the jacobians of the element transformation at the quadrature points in this element
+ */
+template <int Q, mfem::Geometry::Type g, typename test, typename trial, typename derivative_type>
+SERAC_HOST_DEVICE void constant_action_of_gradient_element(const typename finite_element<g, trial>::dof_type& du_e,
+                                                           typename finite_element<g, test>::dof_type& dr_e,
+                                                           const derivative_type& qf_derivative,
+                                                           const typename batched_jacobian<g, Q>::type& J_e)
+{
+  using test_element  = finite_element<g, test>;
+  using trial_element = finite_element<g, trial>;
+
+  constexpr bool is_QOI = (test::family == Family::QOI);
+  constexpr int  nqp    = num_quadrature_points(g, Q);
+
+  TensorProductQuadratureRule<Q> rule{};
+
+  // the derivative describes the physical element, so the perturbation and its response
+  // are transformed just like the q-function's arguments and outputs in evaluation_kernel_impl()
+  auto qf_inputs = trial_element::interpolate(du_e, rule);
+  parent_to_physical<trial_element::family>(qf_inputs, J_e);
+
+  using output_type = decltype(chain_rule<is_QOI>(qf_derivative, qf_inputs[0]));
+  tensor<output_type, nqp> qf_outputs{};
+  for (int q = 0; q < nqp; q++) {
+    qf_outputs[q] = chain_rule<is_QOI>(qf_derivative, qf_inputs[q]);
+  }
+
+  physical_to_parent<test_element::family>(qf_outputs, J_e);
+
+  test_element::integrate(qf_outputs, rule, &dr_e);
+}
+
+/**
+ * @brief the counterpart of action_of_gradient_kernel() for q-functions whose derivatives are the same at every
+ * quadrature point: only that one derivative (and the element jacobians) are read, rather than a stored derivative
+ * for each quadrature point
+ *
+ * @param[in] dU The full set of per-element DOF values (primary input)
+ * @param[inout] dR The full set of per-element residuals (primary output)
+ * @param[in] qf_derivative the derivative of the q-function with respect to its physical-space arguments
+ * @param[in] jacobians the jacobians of the element transformations at each quadrature point
+ * @param[in] num_elements The number of elements in the mesh
+ * @param[in] num_directions The number of perturbations to apply the gradient to
+ */
+template <int Q, mfem::Geometry::Type g, ExecutionSpace exec, typename test, typename trial, typename derivative_type>
+void constant_action_of_gradient_kernel(const double* dU, double* dR, derivative_type qf_derivative,
+                                        const double* jacobians, std::size_t num_elements, uint32_t num_directions)
+{
+  using test_element  = finite_element<g, test>;
+  using trial_element = finite_element<g, trial>;
+
+  auto du = reinterpret_cast<const typename trial_element::dof_type*>(dU);
+  auto dr = reinterpret_cast<typename test_element::dof_type*>(dR);
+  auto J  = reinterpret_cast<const typename batched_jacobian<g, Q>::type*>(jacobians);
+
+  accelerator::forall<exec>(uint32_t(num_elements), [=] SERAC_HOST_DEVICE(uint32_t e) {
+    auto J_e = J[e];
+    for (uint32_t d = 0; d < num_directions; d++) {
+      std::size_t i = std::size_t(d) * num_elements + e;
+      constant_action_of_gradient_element<Q, g, test, trial>(du[i], dr[i], qf_derivative, J_e);
+    }
+  });
+}
+
+/**
+ * @brief the counterpart of element_gradient_kernel() for q-functions whose derivatives are the same at every
+ * quadrature point
+ *
+ * @note each column of the element gradient is the action of the gradient on the corresponding unit vector
+ *
+ * @param[inout] dK 3-dimensional array storing the element gradient matrices
+ * @param[in] qf_derivative the derivative of the q-function with respect to its physical-space arguments
+ * @param[in] jacobians the jacobians of the element transformations at each quadrature point
+ * @param[in] num_elements The number of elements in the mesh
+ */
+template <mfem::Geometry::Type g, typename test, typename trial, int Q, ExecutionSpace exec, typename derivative_type>
+void constant_element_gradient_kernel(ExecArrayView<double, 3, exec> dK, derivative_type qf_derivative,
+                                      const double* jacobians, std::size_t num_elements)
+{
+  using test_element  = finite_element<g, test>;
+  using trial_element = finite_element<g, trial>;
+
+  constexpr int      trial_vdofs      = trial_element::ndof * trial_element::components;
+  constexpr uint32_t entries_per_elem = uint32_t(test_element::ndof * test_element::components * trial_vdofs);
+
+  double* K = dK.data();
+  auto    J = reinterpret_cast<const typename batched_jacobian<g, Q>::type*>(jacobians);
+
+  accelerator::forall<exec>(uint32_t(num_elements), [=] SERAC_HOST_DEVICE(uint32_t e) {
+    auto  J_e = J[e];
+    auto* K_e = reinterpret_cast<typename test_element::dof_type*>(K + e * entries_per_elem);
+
+    typename trial_element::dof_type du_e{};
+    auto*                            du_entries = reinterpret_cast<double*>(&du_e);
+    for (int j = 0; j < trial_vdofs; j++) {
+      du_entries[j] = 1.0;
+      constant_action_of_gradient_element<Q, g, test, trial>(du_e, K_e[j], qf_derivative, J_e);
+      du_entries[j] = 0.0;
     }
+  });
+}
+
+/**
+ * @brief evaluate the derivatives of the q-function with respect to trial space `wrt` at each quadrature point
+ * of a single element, in the same form that evaluation_kernel_impl() stores them, for integrals that recompute
+ * their derivatives rather than storing them
+ *
+ * @param qf the q-function
+ * @param x_e the positions of the quadrature points in this element
+ * @param J_e the jacobians of the element transformation at the quadrature points in this element
+ * @param qpt_data the quadrature point data for this element (or nullptr, if the q-function has none)
+ * @param u pointers to the per-element values of each trial space, at the linearization point
+ * @param e which element
+ */
+template <uint32_t wrt, int Q, mfem::Geometry::Type geom, typename test, typename... trials, typename lambda_type,
+          typename position_type, typename jacobian_type, typename qpt_data_type, typename input_type,
+          int... indices>
+SERAC_HOST_DEVICE auto recompute_qf_derivatives(FunctionSignature<test(trials...)>, lambda_type qf,
+                                                const position_type& x_e, const jacobian_type& J_e,
+                                                [[maybe_unused]] qpt_data_type qpt_data, const input_type& u,
+                                                uint32_t e, std::integer_sequence<int, indices...>)
+{
+  using test_element   = finite_element<geom, test>;
+  using trial_elements = tuple<finite_element<geom, trials>...>;
+
+  TensorProductQuadratureRule<Q> rule{};
+
+  tuple qf_inputs = {promote_each_to_dual_when<indices == wrt>(
+      decltype(type<indices>(trial_elements{}))::interpolate(get<indices>(u)[e], rule))...};
+
+  (parent_to_physical<decltype(type<indices>(trial_elements{}))::family>(get<indices>(qf_inputs), J_e), ...);
+
+  // note: the quadrature point data is never updated when recomputing derivatives
+  auto qf_outputs = [&]() {
+    if constexpr (std::is_same_v<qpt_data_type, Nothing*>) {
+      return batch_apply_qf_no_qdata(qf, x_e, get<indices>(qf_inputs)...);
+    } else {
+      return batch_apply_qf(qf, x_e, qpt_data, nullptr, get<indices>(qf_inputs)...);
+    }
+  }();
+
+  physical_to_parent<test_element::family>(qf_outputs, J_e);
+
+  constexpr int nqp = num_quadrature_points(geom, Q);
+  tensor<std::decay_t<decltype(get_gradient(qf_outputs[0]))>, nqp> derivatives{};
+  for (int q = 0; q < nqp; q++) {
+    derivatives[q] = get_gradient(qf_outputs[q]);
   }
+  return derivatives;
 }
 
-template <uint32_t wrt, int Q, mfem::Geometry::Type geom, typename signature, typename lambda_type, typename state_type,
-          typename derivative_type>
-std::function<void(const std::vector<const double*>&, double*, bool)> evaluation_kernel(
-    signature s, lambda_type qf, const double* positions, const double* jacobians,
-    std::shared_ptr<QuadratureData<state_type> > qf_state, std::shared_ptr<derivative_type> qf_derivatives,
-    uint32_t num_elements)
+/**
+ * @brief the counterpart of action_of_gradient_kernel() for integrals that recompute the q-function derivatives
+ * (from the values of the trial spaces at the linearization point) instead of storing them
+ *
+ * @param inputs the per-element values of each trial space at the linearization point
+ * @param positions the positions of each quadrature point
+ * @param jacobians the jacobians of the element transformations at each quadrature point
+ * @param qf the q-function
+ * @param qf_state the quadrature point data
+ * @param dU the per-element values of the perturbation of trial space `wrt`, beginning with `first_element`
+ * @param dR the per-element values of the resulting perturbation of the residual, beginning with `first_element`
+ * @param first_element the index of the first element to process
+ * @param num_elements the number of elements to process
+ * @param num_directions the number of perturbations, see action_of_gradient_kernel()
+ */
+template <uint32_t wrt, int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename test, typename... trials,
+          typename lambda_type, typename state_type, int... indices>
+void action_of_gradient_recompute_kernel(FunctionSignature<test(trials...)> s, const std::vector<const double*>& inputs,
+                                         const double* positions, const double* jacobians, lambda_type qf,
+                                         QuadratureData<state_type>& qf_state, const double* dU, double* dR,
+                                         uint32_t first_element, uint32_t num_elements, uint32_t num_directions,
+                                         std::integer_sequence<int, indices...> seq)
+{
+  using test_element   = finite_element<geom, test>;
+  using trial_elements = tuple<finite_element<geom, trials>...>;
+  using trial_element  = decltype(type<wrt>(trial_elements{}));
+
+  static_assert(exec == ExecutionSpace::CPU || std::is_same_v<state_type, Nothing>,
+                "quadrature point data is not yet supported for ExecutionSpace::GPU");
+
+  auto x  = reinterpret_cast<const typename batched_position<geom, Q>::type*>(positions);
+  auto J  = reinterpret_cast<const typename batched_jacobian<geom, Q>::type*>(jacobians);
+  auto du = reinterpret_cast<const typename trial_element::dof_type*>(dU);
+  auto dr = reinterpret_cast<typename test_element::dof_type*>(dR);
+
+  tuple u = {reinterpret_cast<const typename decltype(type<indices>(trial_elements{}))::dof_type*>(inputs[indices])...};
+
+  [[maybe_unused]] auto* state = &qf_state;
+
+  accelerator::forall<exec>(num_elements, [=] SERAC_HOST_DEVICE(uint32_t i) {
+    uint32_t e = first_element + i;
+
+    auto qpt_data = [&]() {
+      if constexpr (std::is_same_v<state_type, Nothing>) {
+        return static_cast<Nothing*>(nullptr);
+      } else {
+        return state->at(e);
+      }
+    }();
+
+    auto derivatives = recompute_qf_derivatives<wrt, Q, geom>(s, qf, x[e], J[e], qpt_data, u, e, seq);
+
+    for (uint32_t d = 0; d < num_directions; d++) {
+      std::size_t j = std::size_t(d) * num_elements + i;
+      action_of_gradient_element<Q, geom, test, std::tuple_element_t<wrt, std::tuple<trials...>>>(
+          du[j], dr[j], &derivatives[0]);
+    }
+  });
+}
+
+/**
+ * @brief the counterpart of element_gradient_kernel() for integrals that recompute the q-function derivatives
+ * (from the values of the trial spaces at the linearization point) instead of storing them
+ *
+ * @param inputs the per-element values of each trial space at the linearization point
+ * @param positions the positions of each quadrature point
+ * @param jacobians the jacobians of the element transformations at each quadrature point
+ * @param qf the q-function
+ * @param qf_state the quadrature point data
+ * @param K the element gradients
+ * @param num_elements the number of elements
+ */
+template <uint32_t wrt, int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename test, typename... trials,
+          typename lambda_type, typename state_type, int... indices>
+void element_gradient_recompute_kernel_impl(FunctionSignature<test(trials...)> s,
+                                            const std::vector<const double*>& inputs, const double* positions,
+                                            const double* jacobians, lambda_type qf,
+                                            QuadratureData<state_type>& qf_state, double* K, uint32_t num_elements,
+                                            std::integer_sequence<int, indices...> seq)
+{
+  using test_element   = finite_element<geom, test>;
+  using trial_elements = tuple<finite_element<geom, trials>...>;
+  using trial_element  = decltype(type<wrt>(trial_elements{}));
+
+  static_assert(exec == ExecutionSpace::CPU || std::is_same_v<state_type, Nothing>,
+                "quadrature point data is not yet supported for ExecutionSpace::GPU");
+
+  // the number of entries in each element matrix
+  constexpr uint32_t entries_per_elem = uint32_t(test_element::ndof * test_element::components * trial_element::ndof *
+                                                 trial_element::components);
+
+  auto x = reinterpret_cast<const typename batched_position<geom, Q>::type*>(positions);
+  auto J = reinterpret_cast<const typename batched_jacobian<geom, Q>::type*>(jacobians);
+
+  tuple u = {reinterpret_cast<const typename decltype(type<indices>(trial_elements{}))::dof_type*>(inputs[indices])...};
+
+  [[maybe_unused]] auto* state = &qf_state;
+
+  accelerator::forall<exec>(num_elements, [=] SERAC_HOST_DEVICE(uint32_t e) {
+    auto qpt_data = [&]() {
+      if constexpr (std::is_same_v<state_type, Nothing>) {
+        return static_cast<Nothing*>(nullptr);
+      } else {
+        return state->at(e);
+      }
+    }();
+
+    auto derivatives = recompute_qf_derivatives<wrt, Q, geom>(s, qf, x[e], J[e], qpt_data, u, e, seq);
+
+    element_gradient_element<Q, geom, test, std::tuple_element_t<wrt, std::tuple<trials...>>>(
+        K + e * entries_per_elem, &derivatives[0]);
+  });
+}
+
+template <uint32_t wrt, int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename signature, typename lambda_type,
+          typename state_type, typename derivative_type, typename cache_type>
+std::function<void(const std::vector<const double*>&, double*, bool, uint32_t, uint32_t)> evaluation_kernel(
+    signature s, lambda_type qf, const double* positions, const double* jacobians, const double* affine_jacobians,
+    const double* inverse_jacobians, std::shared_ptr<QuadratureData<state_type> > qf_state,
+    std::shared_ptr<derivative_type> qf_derivatives, std::shared_ptr<cache_type> interpolation_cache)
 {
-  return [=](const std::vector<const double*>& inputs, double* outputs, bool update_state) {
-    domain_integral::evaluation_kernel_impl<wrt, Q, geom>(s, inputs, outputs, positions, jacobians, qf, *qf_state.get(),
-                                                          qf_derivatives.get(), num_elements, update_state,
-                                                          s.index_seq);
+  return [=](const std::vector<const double*>& inputs, double* outputs, bool update_state, uint32_t first_element,
+             uint32_t num_elements) {
+    domain_integral::evaluation_kernel_impl<wrt, Q, geom, exec>(
+        s, inputs, outputs, positions, jacobians, affine_jacobians, inverse_jacobians, qf, *qf_state.get(),
+        qf_derivatives.get(), *interpolation_cache, first_element, num_elements, update_state, s.index_seq);
   };
 }
 
-template <int wrt, int Q, mfem::Geometry::Type geom, typename signature, typename derivative_type>
-std::function<void(const double*, double*)> jacobian_vector_product_kernel(
-    signature, std::shared_ptr<derivative_type> qf_derivatives, uint32_t num_elements)
+template <int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename signature, typename lambda_type,
+          typename state_type, typename... derivative_type, typename cache_type>
+std::function<void(const std::vector<const double*>&, double*, bool, uint32_t, uint32_t, uint32_t)>
+evaluation_kernel_with_multiple_derivatives(signature s, lambda_type qf, const double* positions,
+                                            const double*                                jacobians,
+                                            std::shared_ptr<QuadratureData<state_type> > qf_state,
+                                            tuple<std::shared_ptr<derivative_type>...>   qf_derivatives,
+                                            std::shared_ptr<cache_type>                  interpolation_cache)
 {
-  return [=](const double* du, double* dr) {
+  return [=](const std::vector<const double*>& inputs, double* outputs, bool update_state, uint32_t first_element,
+             uint32_t num_elements, uint32_t which) {
+    auto derivatives = serac::apply([](auto&... each) { return serac::make_tuple(each.get()...); }, qf_derivatives);
+    domain_integral::evaluation_kernel_with_multiple_derivatives_impl<Q, geom, exec>(
+        s, inputs, outputs, positions, jacobians, qf, *qf_state.get(), derivatives, *interpolation_cache, which,
+        first_element, num_elements, update_state, s.index_seq);
+  };
+}
+
+template <int K, int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename signature, typename lambda_type,
+          typename state_type>
+std::function<void(const std::vector<const double*>&, const std::vector<const double*>&, const std::vector<uint32_t>&,
+                   double*, uint32_t, uint32_t)>
+directional_derivatives_kernel(signature s, lambda_type qf, const double* positions, const double* jacobians,
+                               std::shared_ptr<QuadratureData<state_type> > qf_state)
+{
+  return [=](const std::vector<const double*>& inputs, const std::vector<const double*>& directions,
+             const std::vector<uint32_t>& direction_trial, double* outputs, uint32_t first_element,
+             uint32_t num_elements) {
+    domain_integral::directional_derivatives_kernel_impl<K, Q, geom, exec>(
+        s, inputs, directions, direction_trial, outputs, positions, jacobians, qf, *qf_state.get(), first_element,
+        num_elements, s.index_seq);
+  };
+}
+
+template <int wrt, int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename signature, typename derivative_type>
+std::function<void(const double*, double*, uint32_t, uint32_t, uint32_t)> jacobian_vector_product_kernel(
+    signature, std::shared_ptr<derivative_type> qf_derivatives)
+{
+  return [=](const double* du, double* dr, uint32_t first_element, uint32_t num_elements, uint32_t num_directions) {
     using test_space  = typename signature::return_type;
     using trial_space = typename std::tuple_element<wrt, typename signature::parameter_types>::type;
-    action_of_gradient_kernel<Q, geom, test_space, trial_space>(du, dr, qf_derivatives.get(), num_elements);
+    constexpr int nqp = num_quadrature_points(geom, Q);
+    action_of_gradient_kernel<Q, geom, exec, test_space, trial_space>(
+        du, dr, qf_derivatives.get() + std::size_t(first_element) * nqp, num_elements, num_directions);
   };
 }
 
-template <int wrt, int Q, mfem::Geometry::Type geom, typename signature, typename derivative_type>
-std::function<void(ExecArrayView<double, 3, ExecutionSpace::CPU>)> element_gradient_kernel(
-    signature, std::shared_ptr<derivative_type> qf_derivatives, uint32_t num_elements)
+template <int wrt, int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename signature, typename derivative_type>
+std::function<void(const double*, double*, uint32_t, uint32_t)> vector_jacobian_product_kernel(
+    signature, std::shared_ptr<derivative_type> qf_derivatives)
 {
-  return [=](ExecArrayView<double, 3, ExecutionSpace::CPU> K_elem) {
+  return [=](const double* dr, double* du, uint32_t first_element, uint32_t num_elements) {
     using test_space  = typename signature::return_type;
     using trial_space = typename std::tuple_element<wrt, typename signature::parameter_types>::type;
-    element_gradient_kernel<geom, test_space, trial_space, Q>(K_elem, qf_derivatives.get(), num_elements);
+    constexpr int nqp = num_quadrature_points(geom, Q);
+    transpose_action_of_gradient_kernel<Q, geom, exec, test_space, trial_space>(
+        dr, du, qf_derivatives.get() + std::size_t(first_element) * nqp, num_elements);
+  };
+}
+
+template <int wrt, int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename signature, typename derivative_type>
+std::function<void(double*)> element_gradient_kernel(signature, std::shared_ptr<derivative_type> qf_derivatives,
+                                                     uint32_t num_elements)
+{
+  return [=](double* K_elem) {
+    using test_space    = typename signature::return_type;
+    using trial_space   = typename std::tuple_element<wrt, typename signature::parameter_types>::type;
+    using test_element  = finite_element<geom, test_space>;
+    using trial_element = finite_element<geom, trial_space>;
+
+    constexpr int test_vdofs  = test_element::ndof * test_element::components;
+    constexpr int trial_vdofs = trial_element::ndof * trial_element::components;
+
+    ExecArrayView<double, 3, exec> K_elem_view(K_elem, num_elements, trial_vdofs, test_vdofs);
+    element_gradient_kernel<geom, test_space, trial_space, Q, exec>(K_elem_view, qf_derivatives.get(), num_elements);
+  };
+}
+
+/// @brief the counterpart of element_gradient_kernel() that only computes the upper triangles of the element matrices
+template <int wrt, int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename signature, typename derivative_type>
+std::function<void(double*)> symmetric_element_gradient_kernel(signature,
+                                                               std::shared_ptr<derivative_type> qf_derivatives,
+                                                               uint32_t                         num_elements)
+{
+  return [=](double* K_elem) {
+    using space = typename signature::return_type;
+    symmetric_element_gradient_kernel<geom, space, Q, exec>(K_elem, qf_derivatives.get(), num_elements);
+  };
+}
+
+template <int wrt, int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename signature, typename derivative_type>
+std::function<void(const double*, double*, uint32_t, uint32_t, uint32_t)> constant_jacobian_vector_product_kernel(
+    signature, derivative_type qf_derivative, const double* jacobians)
+{
+  return [=](const double* du, double* dr, uint32_t first_element, uint32_t num_elements, uint32_t num_directions) {
+    using test_space             = typename signature::return_type;
+    using trial_space            = typename std::tuple_element<wrt, typename signature::parameter_types>::type;
+    constexpr std::size_t stride = sizeof(typename batched_jacobian<geom, Q>::type) / sizeof(double);
+    constant_action_of_gradient_kernel<Q, geom, exec, test_space, trial_space>(
+        du, dr, qf_derivative, jacobians + std::size_t(first_element) * stride, num_elements, num_directions);
+  };
+}
+
+template <int wrt, int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename signature, typename derivative_type>
+std::function<void(double*)> constant_element_gradient_kernel(signature, derivative_type qf_derivative,
+                                                              const double* jacobians, uint32_t num_elements)
+{
+  return [=](double* K_elem) {
+    using test_space    = typename signature::return_type;
+    using trial_space   = typename std::tuple_element<wrt, typename signature::parameter_types>::type;
+    using test_element  = finite_element<geom, test_space>;
+    using trial_element = finite_element<geom, trial_space>;
+
+    constexpr int test_vdofs  = test_element::ndof * test_element::components;
+    constexpr int trial_vdofs = trial_element::ndof * trial_element::components;
+
+    ExecArrayView<double, 3, exec> K_elem_view(K_elem, num_elements, trial_vdofs, test_vdofs);
+    constant_element_gradient_kernel<geom, test_space, trial_space, Q, exec>(K_elem_view, qf_derivative, jacobians,
+                                                                            num_elements);
+  };
+}
+
+template <int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename signature, typename lambda_type,
+          typename state_type, typename cache_type>
+std::function<void(const std::vector<const double*>&, double*, bool, uint32_t, uint32_t)>
+evaluation_kernel_with_saved_inputs(signature s, lambda_type qf, const double* positions, const double* jacobians,
+                                    std::shared_ptr<QuadratureData<state_type> > qf_state,
+                                    detail::LinearizationPoint                   linearization_point,
+                                    std::shared_ptr<cache_type>                  interpolation_cache)
+{
+  return [=](const std::vector<const double*>& inputs, double* outputs, bool update_state, uint32_t first_element,
+             uint32_t num_elements) {
+    linearization_point.save<exec>(inputs, first_element, num_elements);
+    zero* no_derivatives = nullptr;
+    domain_integral::evaluation_kernel_impl<NO_DIFFERENTIATION, Q, geom, exec>(
+        s, inputs, outputs, positions, jacobians, nullptr, nullptr, qf, *qf_state.get(), no_derivatives,
+        *interpolation_cache, first_element, num_elements, update_state, s.index_seq);
+  };
+}
+
+template <int wrt, int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename signature, typename lambda_type,
+          typename state_type>
+std::function<void(const double*, double*, uint32_t, uint32_t, uint32_t)> jacobian_vector_product_recompute_kernel(
+    signature s, lambda_type qf, const double* positions, const double* jacobians,
+    std::shared_ptr<QuadratureData<state_type> > qf_state, detail::LinearizationPoint linearization_point)
+{
+  return [=](const double* du, double* dr, uint32_t first_element, uint32_t num_elements, uint32_t num_directions) {
+    action_of_gradient_recompute_kernel<wrt, Q, geom, exec>(s, linearization_point.pointers(), positions, jacobians,
+                                                            qf, *qf_state.get(), du, dr, first_element, num_elements,
+                                                            num_directions, s.index_seq);
+  };
+}
+
+template <int wrt, int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename signature, typename lambda_type,
+          typename state_type>
+std::function<void(double*)> element_gradient_recompute_kernel(
+    signature s, lambda_type qf, const double* positions, const double* jacobians,
+    std::shared_ptr<QuadratureData<state_type> > qf_state, detail::LinearizationPoint linearization_point,
+    uint32_t num_elements)
+{
+  return [=](double* K_elem) {
+    element_gradient_recompute_kernel_impl<wrt, Q, geom, exec>(s, linearization_point.pointers(), positions,
+                                                               jacobians, qf, *qf_state.get(), K_elem, num_elements,
+                                                               s.index_seq);
+  };
+}
+
+/**
+ * @brief the derivative of a quantity of interest with respect to trial space `wrt`, evaluated in a single pass
+ * over the elements at the given inputs
+ *
+ * At each quadrature point, the q-function is evaluated once with its argument `wrt` promoted to a dual number, which
+ * yields the whole gradient of its (scalar) output. Those gradients are integrated against the trial space basis
+ * functions element by element, so that no q-function derivatives are stored between evaluations.
+ *
+ * @note the returned kernel writes the element gradients in the layout of element_gradient_kernel()
+ */
+template <int wrt, int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename signature, typename lambda_type,
+          typename state_type>
+std::function<void(const std::vector<const double*>&, double*)> qoi_gradient_kernel(
+    signature s, lambda_type qf, const double* positions, const double* jacobians,
+    std::shared_ptr<QuadratureData<state_type> > qf_state, uint32_t num_elements)
+{
+  return [=](const std::vector<const double*>& inputs, double* dQ) {
+    element_gradient_recompute_kernel_impl<wrt, Q, geom, exec>(s, inputs, positions, jacobians, qf, *qf_state.get(),
+                                                               dQ, num_elements, s.index_seq);
   };
 }
 
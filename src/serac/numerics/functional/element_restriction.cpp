@@ -1,9 +1,64 @@
 #include "serac/numerics/functional/element_restriction.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <tuple>
+
 #include "mfem.hpp"
 
+#include "serac/infrastructure/accelerator.hpp"
+#include "serac/infrastructure/profiling.hpp"
 #include "serac/numerics/functional/geometry.hpp"
 
+/**
+ * @brief the native-to-lexicographic permutation of the nodes of a prism element of order p > 0, i.e. the native
+ * index of the node that serac numbers t + ntri * k (see prism_basis.inl), where t is the lexicographic index of its
+ * position on the triangle cross-section, and k that of its position in the extruded direction
+ *
+ * mfem doesn't provide a lexicographic ordering for prisms, so the permutation is found by matching the prism's
+ * nodes to the positions of the nodes of the triangle and segment elements of the same order
+ *
+ * @param prism the (H1 or Gauss-Lobatto L2) finite element on a prism
+ * @param p the polynomial order of the element
+ */
+std::vector<int> prism_lexicographic_permutation(const mfem::FiniteElement& prism, int p)
+{
+  mfem::H1_TriangleElement triangle(p);
+  mfem::H1_SegmentElement  segment(p);
+
+  const mfem::Array<int>& triangle_lex = triangle.GetLexicographicOrdering();
+  const mfem::Array<int>& segment_lex  = segment.GetLexicographicOrdering();
+
+  int ntri = triangle.GetDof();
+  int n    = segment.GetDof();
+
+  constexpr double tolerance = 1.0e-10;
+
+  std::vector<int> native_to_lex(uint32_t(ntri * n), -1);
+
+  const mfem::IntegrationRule& nodes = prism.GetNodes();
+  for (int i = 0; i < nodes.GetNPoints(); i++) {
+    const mfem::IntegrationPoint& X = nodes.IntPoint(i);
+    for (int k = 0; k < n; k++) {
+      if (std::abs(segment.GetNodes().IntPoint(segment_lex[k]).x - X.z) > tolerance) continue;
+      for (int t = 0; t < ntri; t++) {
+        const mfem::IntegrationPoint& Y = triangle.GetNodes().IntPoint(triangle_lex[t]);
+        if (std::abs(Y.x - X.x) < tolerance && std::abs(Y.y - X.y) < tolerance) {
+          native_to_lex[uint32_t(t + ntri * k)] = i;
+        }
+      }
+    }
+  }
+
+  SLIC_ERROR_IF(std::count(native_to_lex.begin(), native_to_lex.end(), -1) > 0,
+                "the nodes of the prism element don't match those of the triangle and segment elements");
+
+  return native_to_lex;
+}
+
 std::vector<std::vector<int> > lexicographic_permutations(int p)
 {
   // p == 0 is admissible for L2 spaces, but lexicographic permutations
@@ -59,6 +114,8 @@ std::vector<std::vector<int> > lexicographic_permutations(int p)
     output[mfem::Geometry::Type::CUBE] = native_to_lex;
   }
 
+  output[mfem::Geometry::Type::PRISM] = prism_lexicographic_permutation(mfem::H1_WedgeElement(p), p);
+
   // other geometries are not defined, as they are not currently used
 
   return output;
@@ -223,6 +280,12 @@ axom::Array<DoF, 2, axom::MemorySpace::Host> GetElementRestriction(const mfem::F
   int                            p        = fes->GetElementOrder(0);
   std::vector<std::vector<int> > lex_perm = lexicographic_permutations(p);
 
+  // unlike the other L2 elements, mfem's prisms don't number their dofs lexicographically
+  std::vector<int> dg_perm;
+  if (isDG(*fes) && geom == mfem::Geometry::PRISM && p > 0) {
+    dg_perm = prism_lexicographic_permutation(*fes->FEColl()->FiniteElementForGeometry(geom), p);
+  }
+
   uint64_t n = 0;
 
   for (int elem = 0; elem < fes->GetNE(); elem++) {
@@ -256,10 +319,10 @@ axom::Array<DoF, 2, axom::MemorySpace::Host> GetElementRestriction(const mfem::F
     }
 
     // mfem returns DG dofs in lexicographic order already
-    // so no permutation is required here
+    // so no permutation is required here (except on prisms)
     if (isDG(*fes)) {
       for (int k = 0; k < dofs.Size(); k++) {
-        elem_dofs.push_back({uint64_t(dofs[k])});
+        elem_dofs.push_back({uint64_t(dofs[dg_perm.empty() ? k : dg_perm[uint32_t(k)]])});
       }
     }
 
@@ -289,6 +352,13 @@ axom::Array<DoF, 2, axom::MemorySpace::Host> GetFaceDofs(const mfem::FiniteEleme
   std::vector<Array2D<int> >     local_face_dofs = geom_local_face_dofs(p);
   std::vector<std::vector<int> > lex_perm        = lexicographic_permutations(p);
 
+  // interior faces of DG spaces also need the dofs of elements on other ranks that share a face with this rank
+  auto* pfes = dynamic_cast<const mfem::ParFiniteElementSpace*>(fes);
+  if (type == FaceType::INTERIOR && isDG(*fes) && pfes != nullptr) {
+    // note: this is a no-op if the face neighbor data was already exchanged
+    const_cast<mfem::ParFiniteElementSpace*>(pfes)->ExchangeFaceNbrData();
+  }
+
   uint64_t n = 0;
 
   for (int f = 0; f < fes->GetNF(); f++) {
@@ -299,9 +369,48 @@ axom::Array<DoF, 2, axom::MemorySpace::Host> GetFaceDofs(const mfem::FiniteEleme
     if (faceinfo.IsInterior() && type == FaceType::BOUNDARY) continue;
     if (faceinfo.IsBoundary() && type == FaceType::INTERIOR) continue;
 
-    // mfem doesn't provide this connectivity info for DG spaces directly,
-    // so we have to get at it indirectly in several steps:
-    if (isDG(*fes)) {
+    // interior faces of DG spaces gather the dofs of both elements that share the face. Their order (and mfem's
+    // orientation of each side w.r.t. the face) is taken from mfem's face information, so that the first element
+    // is the one the face normal points out of
+    if (isDG(*fes) && type == FaceType::INTERIOR) {
+      SLIC_ERROR_IF(!faceinfo.IsConforming(), "interior face integrals are not supported on nonconforming meshes");
+
+      for (const auto& side : faceinfo.element) {
+        mfem::Array<int>     elem_dof_ids;
+        mfem::Geometry::Type elem_geom;
+        uint64_t             offset = 0;
+
+        if (side.location == mfem::Mesh::ElementLocation::FaceNbr) {
+          // the element belongs to another rank, so its nodes are numbered after this rank's nodes
+          // (see ElementRestriction::num_face_nbr_nodes), and mfem only provides their vdofs
+          pfes->GetFaceNbrElementVDofs(side.index, elem_dof_ids);
+          elem_geom = pfes->GetFaceNbrFE(side.index)->GetGeomType();
+          offset    = uint64_t(fes->GetNDofs());
+
+          // the first (ndof) vdofs are the first component, which determine the node numbers
+          elem_dof_ids.SetSize(pfes->GetFaceNbrFE(side.index)->GetDof());
+          if (fes->GetOrdering() == mfem::Ordering::byVDIM) {
+            for (auto& id : elem_dof_ids) {
+              id /= fes->GetVDim();
+            }
+          }
+        } else {
+          fes->GetElementDofs(side.index, elem_dof_ids);
+          elem_geom = mesh->GetElementGeometry(side.index);
+        }
+
+        SLIC_ERROR_IF(elem_geom == mfem::Geometry::PRISM,
+                      "face integrals of discontinuous spaces are not supported on prisms");
+
+        for (auto k : face_perm(side.orientation)) {
+          int local_dof = local_face_dofs[uint32_t(elem_geom)](side.local_face_id, k);
+          face_dofs.push_back(offset + uint64_t(elem_dof_ids[local_dof]));
+        }
+      }
+
+      // mfem doesn't provide this connectivity info for DG spaces directly,
+      // so we have to get at it indirectly in several steps:
+    } else if (isDG(*fes)) {
       // 1. find the element(s) that this face belongs to
       mfem::Array<int> elem_ids;
       face_to_elem->GetRow(f, elem_ids);
@@ -336,6 +445,8 @@ axom::Array<DoF, 2, axom::MemorySpace::Host> GetFaceDofs(const mfem::FiniteEleme
         fes->GetElementDofs(elem, elem_dof_ids);
 
         mfem::Geometry::Type elem_geom = mesh->GetElementGeometry(elem);
+        SLIC_ERROR_IF(elem_geom == mfem::Geometry::PRISM,
+                      "face integrals of discontinuous spaces are not supported on prisms");
 
         // mfem uses different conventions for boundary element orientations in 2D and 3D.
         // In 2D, mfem's official edge orientations on the boundary will always be a mix of
@@ -387,35 +498,153 @@ axom::Array<DoF, 2, axom::MemorySpace::Host> GetFaceDofs(const mfem::FiniteEleme
   }
 }
 
+DoFTable::DoFTable(const axom::Array<DoF, 2, axom::MemorySpace::Host>& values)
+    : dim{uint64_t(values.shape()[0]), uint64_t(values.shape()[1])}
+{
+  const DoF* begin = values.data();
+  const DoF* end   = values.data() + size();
+
+  bool trivial = std::all_of(begin, end, [](const DoF& dof) {
+    return (dof.bits & ~DoF::index_mask) == 0 && dof.index() <= std::numeric_limits<uint32_t>::max();
+  });
+
+  if (trivial) {
+    auto compact_indices = std::make_shared<std::vector<uint32_t> >(size());
+    std::transform(begin, end, compact_indices->begin(), [](const DoF& dof) { return uint32_t(dof.index()); });
+    indices = std::move(compact_indices);
+  } else {
+    dofs = std::make_shared<const std::vector<DoF> >(begin, end);
+  }
+}
+
 namespace serac {
 
 ElementRestriction::ElementRestriction(const mfem::FiniteElementSpace* fes, mfem::Geometry::Type elem_geom)
 {
-  dof_info = GetElementRestriction(fes, elem_geom);
+  dof_info = DoFTable(GetElementRestriction(fes, elem_geom));
 
   ordering = fes->GetOrdering();
 
-  lsize          = uint64_t(fes->GetVSize());
-  components     = uint64_t(fes->GetVDim());
-  num_nodes      = lsize / components;
-  num_elements   = uint64_t(dof_info.shape()[0]);
-  nodes_per_elem = uint64_t(dof_info.shape()[1]);
-  esize          = num_elements * nodes_per_elem * components;
+  lsize              = uint64_t(fes->GetVSize());
+  components         = uint64_t(fes->GetVDim());
+  num_nodes          = lsize / components;
+  num_elements       = uint64_t(dof_info.shape()[0]);
+  nodes_per_elem     = uint64_t(dof_info.shape()[1]);
+  esize              = num_elements * nodes_per_elem * components;
+  num_face_nbr_nodes = 0;
+
+  BuildIndexMaps();
+  FindRankBoundaryElements(fes);
 }
 
 ElementRestriction::ElementRestriction(const mfem::FiniteElementSpace* fes, mfem::Geometry::Type face_geom,
                                        FaceType type)
 {
-  dof_info = GetFaceDofs(fes, face_geom, type);
+  dof_info = DoFTable(GetFaceDofs(fes, face_geom, type));
 
   ordering = fes->GetOrdering();
 
-  lsize          = uint64_t(fes->GetVSize());
-  components     = uint64_t(fes->GetVDim());
-  num_nodes      = lsize / components;
-  num_elements   = uint64_t(dof_info.shape()[0]);
-  nodes_per_elem = uint64_t(dof_info.shape()[1]);
-  esize          = num_elements * nodes_per_elem * components;
+  lsize              = uint64_t(fes->GetVSize());
+  components         = uint64_t(fes->GetVDim());
+  num_nodes          = lsize / components;
+  num_elements       = uint64_t(dof_info.shape()[0]);
+  nodes_per_elem     = uint64_t(dof_info.shape()[1]);
+  esize              = num_elements * nodes_per_elem * components;
+  num_face_nbr_nodes = 0;
+
+  auto pfes = dynamic_cast<const mfem::ParFiniteElementSpace*>(fes);
+  if (type == FaceType::INTERIOR && isDG(*fes) && pfes != nullptr) {
+    num_face_nbr_nodes = uint64_t(pfes->GetFaceNbrVSize()) / components;
+  }
+
+  BuildIndexMaps();
+  FindRankBoundaryElements(fes);
+}
+
+void ElementRestriction::FindRankBoundaryElements(const mfem::FiniteElementSpace* fes)
+{
+  auto boundary_elements = std::make_shared<std::vector<uint64_t> >();
+  rank_boundary_elements = boundary_elements;
+
+  auto pfes = dynamic_cast<const mfem::ParFiniteElementSpace*>(fes);
+  if (pfes == nullptr) return;
+
+  for (uint64_t e = 0; e < num_elements; e++) {
+    bool owns_all_dofs = true;
+    for (uint64_t c = 0; c < components && owns_all_dofs; c++) {
+      for (uint64_t j = 0; j < nodes_per_elem && owns_all_dofs; j++) {
+        // note: the values of nodes on other ranks (see `num_face_nbr_nodes`) come after the L-vector's
+        int ldof      = int(GetVDof(dof_info(e, j), c).index());
+        owns_all_dofs = (ldof < int(lsize)) && (pfes->GetLocalTDofNumber(ldof) >= 0);
+      }
+    }
+
+    if (!owns_all_dofs) {
+      boundary_elements->push_back(e);
+    }
+  }
+}
+
+void ElementRestriction::BuildIndexMaps()
+{
+  auto L_ids = std::make_shared<std::vector<int> >(esize);
+  for (uint64_t i = 0; i < num_elements; i++) {
+    for (uint64_t c = 0; c < components; c++) {
+      for (uint64_t j = 0; j < nodes_per_elem; j++) {
+        uint64_t E_id  = (i * components + c) * nodes_per_elem + j;
+        (*L_ids)[E_id] = int(GetVDof(dof_info(i, j), c).index());
+      }
+    }
+  }
+  L_indices = L_ids;
+
+  // note: the values of nodes on other ranks are not part of the L-vector
+  L_offset = L_ids->empty() ? 0 : uint64_t(L_ids->front());
+  identity = (num_face_nbr_nodes == 0);
+  for (uint64_t k = 0; k < esize && identity; k++) {
+    identity = (uint64_t((*L_ids)[k]) == L_offset + k);
+  }
+
+  auto colors = std::make_shared<std::vector<std::vector<uint32_t> > >();
+
+#if defined(SERAC_USE_OPENMP) && defined(_OPENMP)
+  // greedily assign each element the first color not already used by an element it shares a node with
+  std::vector<std::vector<uint32_t> > node_to_elements(num_nodes + num_face_nbr_nodes);
+  for (uint64_t i = 0; i < num_elements; i++) {
+    for (uint64_t j = 0; j < nodes_per_elem; j++) {
+      node_to_elements[dof_info(i, j).index()].push_back(uint32_t(i));
+    }
+  }
+
+  std::vector<uint32_t> color(num_elements, 0);
+  std::vector<uint64_t> used_by;  // used_by[c] == i + 1 marks that color c is taken by a neighbor of element i
+  for (uint64_t i = 0; i < num_elements; i++) {
+    for (uint64_t j = 0; j < nodes_per_elem; j++) {
+      for (auto neighbor : node_to_elements[dof_info(i, j).index()]) {
+        if (neighbor < i) used_by[color[neighbor]] = i + 1;
+      }
+    }
+
+    uint32_t c = 0;
+    while (c < used_by.size() && used_by[c] == i + 1) c++;
+    if (c == used_by.size()) {
+      used_by.push_back(0);
+      colors->emplace_back();
+    }
+
+    color[i] = c;
+    (*colors)[c].push_back(uint32_t(i));
+  }
+#endif
+
+  element_colors = colors;
+
+  std::size_t bytes = dof_info.bytes() + sizeof(int) * L_indices->size();
+  for (const auto& elements : *element_colors) {
+    bytes += sizeof(uint32_t) * elements.size();
+  }
+  tracker = std::make_shared<memory::Tracker>(memory::Subsystem::LookupTables);
+  tracker->set(bytes);
 }
 
 uint64_t ElementRestriction::ESize() const { return esize; }
@@ -424,6 +653,14 @@ uint64_t ElementRestriction::LSize() const { return lsize; }
 
 DoF ElementRestriction::GetVDof(DoF node, uint64_t component) const
 {
+  // nodes on other ranks are numbered after this rank's, and their vdofs after this rank's vdofs
+  if (node.index() >= num_nodes) {
+    uint64_t k    = node.index() - num_nodes;
+    uint64_t vdof = (ordering == mfem::Ordering::Type::byNODES) ? component * num_face_nbr_nodes + k
+                                                                : k * components + component;
+    return DoF{lsize + vdof, (node.sign() == 1) ? 0ull : 1ull, node.orientation()};
+  }
+
   if (ordering == mfem::Ordering::Type::byNODES) {
     return DoF{component * num_nodes + node.index(), (node.sign() == 1) ? 0ull : 1ull, node.orientation()};
   } else {
@@ -435,69 +672,209 @@ void ElementRestriction::GetElementVDofs(int i, std::vector<DoF>& vdofs) const
 {
   for (uint64_t c = 0; c < components; c++) {
     for (uint64_t j = 0; j < nodes_per_elem; j++) {
-      vdofs[c * nodes_per_elem + j] = GetVDof(dof_info(i, j), c);
+      vdofs[c * nodes_per_elem + j] = GetVDof(dof_info(uint64_t(i), j), c);
     }
   }
 }
 
 void ElementRestriction::Gather(const mfem::Vector& L_vector, mfem::Vector& E_vector) const
 {
-  for (uint64_t i = 0; i < num_elements; i++) {
-    for (uint64_t c = 0; c < components; c++) {
-      for (uint64_t j = 0; j < nodes_per_elem; j++) {
-        uint64_t E_id       = (i * components + c) * nodes_per_elem + j;
-        uint64_t L_id       = GetVDof(dof_info(i, j), c).index();
-        E_vector[int(E_id)] = L_vector[int(L_id)];
-      }
-    }
-  }
+  // note: these vectors may be device-resident, so we explicitly request (synchronized) host pointers
+  Gather(L_vector.HostRead(), E_vector.HostReadWrite(), 0, num_elements);
 }
 
 void ElementRestriction::ScatterAdd(const mfem::Vector& E_vector, mfem::Vector& L_vector) const
 {
-  for (uint64_t i = 0; i < num_elements; i++) {
-    for (uint64_t c = 0; c < components; c++) {
-      for (uint64_t j = 0; j < nodes_per_elem; j++) {
-        uint64_t E_id = (i * components + c) * nodes_per_elem + j;
-        uint64_t L_id = GetVDof(dof_info(i, j), c).index();
-        L_vector[int(L_id)] += E_vector[int(E_id)];
+  ScatterAdd(E_vector.HostRead(), L_vector.HostReadWrite(), 0, num_elements);
+}
+
+void ElementRestriction::Gather(const double* L, double* E, uint64_t first_element, uint64_t count) const
+{
+  const int* L_ids = L_indices->data() + first_element * ValuesPerElement();
+  int64_t    n     = int64_t(count * ValuesPerElement());
+
+  // each entry of the E-vector is written exactly once, so there are no races
+  SERAC_OMP_PARALLEL_FOR
+  for (int64_t k = 0; k < n; k++) {
+    E[k] = L[L_ids[k]];
+  }
+}
+
+void ElementRestriction::Gather(const double* L, const double* L_face_nbr, double* E, uint64_t first_element,
+                                uint64_t count) const
+{
+  if (num_face_nbr_nodes == 0) {
+    Gather(L, E, first_element, count);
+    return;
+  }
+
+  const int* L_ids  = L_indices->data() + first_element * ValuesPerElement();
+  int64_t    n      = int64_t(count * ValuesPerElement());
+  int        L_size = int(lsize);
+
+  SERAC_OMP_PARALLEL_FOR
+  for (int64_t k = 0; k < n; k++) {
+    E[k] = (L_ids[k] < L_size) ? L[L_ids[k]] : L_face_nbr[L_ids[k] - L_size];
+  }
+}
+
+void ElementRestriction::ScatterAdd(const double* E, double* L, uint64_t first_element, uint64_t count) const
+{
+  uint64_t values_per_element = ValuesPerElement();
+
+#if defined(SERAC_USE_OPENMP) && defined(_OPENMP)
+  // elements of the same color write to disjoint entries of the L-vector, so they can be processed concurrently
+  for (auto& elements : *element_colors) {
+    auto            begin = std::lower_bound(elements.begin(), elements.end(), first_element);
+    auto            end   = std::lower_bound(begin, elements.end(), first_element + count);
+    const uint32_t* ids   = elements.data() + (begin - elements.begin());
+    int64_t         n     = end - begin;
+
+    SERAC_OMP_PARALLEL_FOR
+    for (int64_t k = 0; k < n; k++) {
+      const int*    L_ids = L_indices->data() + ids[k] * values_per_element;
+      const double* E_e   = E + (ids[k] - first_element) * values_per_element;
+      for (uint64_t j = 0; j < values_per_element; j++) {
+        // values of nodes on other ranks are discarded (see `num_face_nbr_nodes`)
+        if (uint64_t(L_ids[j]) < lsize) L[L_ids[j]] += E_e[j];
       }
     }
   }
+#else
+  const int* L_ids = L_indices->data() + first_element * values_per_element;
+  uint64_t   n     = count * values_per_element;
+  if (num_face_nbr_nodes == 0) {
+    for (uint64_t k = 0; k < n; k++) {
+      L[L_ids[k]] += E[k];
+    }
+  } else {
+    // values of nodes on other ranks are discarded (see `num_face_nbr_nodes`)
+    for (uint64_t k = 0; k < n; k++) {
+      if (uint64_t(L_ids[k]) < lsize) L[L_ids[k]] += E[k];
+    }
+  }
+#endif
 }
 
 ////////////////////////////////////////////////////////////////////////
 
+namespace {
+
+/// the restrictions of each element geometry
+using RestrictionMap = std::map<mfem::Geometry::Type, ElementRestriction>;
+
+/**
+ * @brief what identifies the restrictions of a space: the space and its mesh (and their sequence numbers, which
+ * change whenever they are updated), and the kind of element (-1 for domain elements, or the FaceType)
+ */
+using RestrictionKey = std::tuple<const mfem::FiniteElementSpace*, long, const mfem::Mesh*, long, int>;
+
+/// the restrictions in use, see BlockElementRestriction
+std::map<RestrictionKey, std::weak_ptr<const RestrictionMap> > restriction_cache;
+
+/// guards `restriction_cache`
+std::mutex restriction_cache_mutex;
+
+/**
+ * @brief find the restrictions of a space in the cache, or create them (and add them to the cache)
+ *
+ * @param fes the finite element space
+ * @param kind the kind of element, see RestrictionKey
+ * @param create creates the restrictions
+ */
+std::shared_ptr<const RestrictionMap> findOrCreateRestrictions(const mfem::FiniteElementSpace* fes, int kind,
+                                                               const std::function<RestrictionMap()>& create)
+{
+  const mfem::Mesh* mesh = fes->GetMesh();
+  RestrictionKey    key{fes, fes->GetSequence(), mesh, mesh->GetSequence(), kind};
+
+  std::lock_guard<std::mutex> lock(restriction_cache_mutex);
+
+  // forget the restrictions that are no longer used
+  for (auto it = restriction_cache.begin(); it != restriction_cache.end();) {
+    it = it->second.expired() ? restriction_cache.erase(it) : std::next(it);
+  }
+
+  if (auto found = restriction_cache.find(key); found != restriction_cache.end()) {
+    if (auto restrictions = found->second.lock()) return restrictions;
+  }
+
+  auto restrictions      = std::make_shared<const RestrictionMap>(create());
+  restriction_cache[key] = restrictions;
+  return restrictions;
+}
+
+/// @brief whether the restrictions' blocks of the "E-vector" make up the whole "L-vector", in order
+bool isIdentity(const RestrictionMap& restrictions)
+{
+  if (restrictions.empty()) return false;
+
+  // note: std::map visits the geometries in the same order as the blocks of BlockElementRestriction::bOffsets()
+  uint64_t offset = 0;
+  for (const auto& [geom, restriction] : restrictions) {
+    if (!restriction.identity || (restriction.ESize() > 0 && restriction.L_offset != offset)) return false;
+    offset += restriction.ESize();
+  }
+
+  return offset == restrictions.begin()->second.LSize();
+}
+
+}  // namespace
+
 BlockElementRestriction::BlockElementRestriction(const mfem::FiniteElementSpace* fes)
 {
-  int dim = fes->GetMesh()->Dimension();
+  SERAC_PROFILE_SCOPE("BlockElementRestriction");
+
+  cached = findOrCreateRestrictions(fes, -1, [fes]() {
+    RestrictionMap output;
+
+    int dim = fes->GetMesh()->Dimension();
 
-  if (dim == 2) {
-    for (auto geom : {mfem::Geometry::TRIANGLE, mfem::Geometry::SQUARE}) {
-      restrictions[geom] = ElementRestriction(fes, geom);
+    if (dim == 2) {
+      for (auto geom : {mfem::Geometry::TRIANGLE, mfem::Geometry::SQUARE}) {
+        output[geom] = ElementRestriction(fes, geom);
+      }
     }
-  }
 
-  if (dim == 3) {
-    for (auto geom : {mfem::Geometry::TETRAHEDRON, mfem::Geometry::CUBE}) {
-      restrictions[geom] = ElementRestriction(fes, geom);
+    if (dim == 3) {
+      for (auto geom : {mfem::Geometry::TETRAHEDRON, mfem::Geometry::CUBE, mfem::Geometry::PRISM}) {
+        output[geom] = ElementRestriction(fes, geom);
+      }
     }
-  }
+
+    return output;
+  });
+
+  restrictions = *cached;
+  identity     = isIdentity(restrictions);
 }
 
 BlockElementRestriction::BlockElementRestriction(const mfem::FiniteElementSpace* fes, FaceType type)
 {
-  int dim = fes->GetMesh()->Dimension();
+  // interior faces also exchange the face neighbor data of the mesh
+  SERAC_PROFILE_SCOPE(type == FaceType::INTERIOR ? "BlockElementRestriction (interior faces)"
+                                                 : "BlockElementRestriction");
 
-  if (dim == 2) {
-    restrictions[mfem::Geometry::SEGMENT] = ElementRestriction(fes, mfem::Geometry::SEGMENT, type);
-  }
+  cached = findOrCreateRestrictions(fes, int(type), [fes, type]() {
+    RestrictionMap output;
+
+    int dim = fes->GetMesh()->Dimension();
 
-  if (dim == 3) {
-    for (auto geom : {mfem::Geometry::TRIANGLE, mfem::Geometry::SQUARE}) {
-      restrictions[geom] = ElementRestriction(fes, geom, type);
+    if (dim == 2) {
+      output[mfem::Geometry::SEGMENT] = ElementRestriction(fes, mfem::Geometry::SEGMENT, type);
     }
-  }
+
+    if (dim == 3) {
+      for (auto geom : {mfem::Geometry::TRIANGLE, mfem::Geometry::SQUARE}) {
+        output[geom] = ElementRestriction(fes, geom, type);
+      }
+    }
+
+    return output;
+  });
+
+  restrictions = *cached;
+  identity     = isIdentity(restrictions);
 }
 
 uint64_t BlockElementRestriction::ESize() const { return (*restrictions.begin()).second.ESize(); }
@@ -523,14 +900,18 @@ mfem::Array<int> BlockElementRestriction::bOffsets() const
 
 void BlockElementRestriction::Gather(const mfem::Vector& L_vector, mfem::BlockVector& E_block_vector) const
 {
-  for (auto [geom, restriction] : restrictions) {
+  if (identity && E_block_vector.GetData() == L_vector.GetData()) return;
+
+  for (const auto& [geom, restriction] : restrictions) {
     restriction.Gather(L_vector, E_block_vector.GetBlock(geom));
   }
 }
 
 void BlockElementRestriction::ScatterAdd(const mfem::BlockVector& E_block_vector, mfem::Vector& L_vector) const
 {
-  for (auto [geom, restriction] : restrictions) {
+  if (identity && E_block_vector.GetData() == L_vector.GetData()) return;
+
+  for (const auto& [geom, restriction] : restrictions) {
     restriction.ScatterAdd(E_block_vector.GetBlock(geom), L_vector);
   }
 }
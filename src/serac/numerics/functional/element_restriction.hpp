@@ -1,10 +1,13 @@
 #pragma once
 
+#include <array>
+#include <memory>
 #include <vector>
 
 #include "mfem.hpp"
 #include "axom/core.hpp"
 #include "geometry.hpp"
+#include "serac/infrastructure/memory.hpp"
 
 inline bool isH1(const mfem::FiniteElementSpace& fes)
 {
@@ -79,6 +82,47 @@ struct DoF {
   uint64_t index() const { return (bits & index_mask); }
 };
 
+/**
+ * @brief a num_elements-by-nodes_per_elem table of the DoFs of the nodes of each element
+ *
+ * When every DoF has a positive sign and no orientation (e.g. in H1 and L2 spaces), only their indices are stored,
+ * in 32 bits each, rather than the full 64-bit `DoF`s. Copies of a table share its values, which are immutable.
+ */
+struct DoFTable {
+  /// default ctor creates an empty table
+  DoFTable() : dim{0, 0} {}
+
+  /// create a table of the values in `dofs`, in the compact encoding if possible
+  explicit DoFTable(const axom::Array<DoF, 2, axom::MemorySpace::Host>& values);
+
+  /// the DoF of node `j` of element `i`
+  DoF operator()(uint64_t i, uint64_t j) const
+  {
+    return indices ? DoF{(*indices)[i * dim[1] + j]} : (*dofs)[i * dim[1] + j];
+  }
+
+  /// the number of rows (elements) and columns (nodes per element) of the table
+  std::array<uint64_t, 2> shape() const { return {dim[0], dim[1]}; }
+
+  /// the number of entries in the table
+  uint64_t size() const { return dim[0] * dim[1]; }
+
+  /// whether the table only stores the (32-bit) indices of the DoFs
+  bool compact() const { return indices != nullptr; }
+
+  /// the size (in bytes) of the values of the table
+  std::size_t bytes() const { return compact() ? sizeof(uint32_t) * size() : sizeof(DoF) * size(); }
+
+  /// the indices of the DoFs, when they are stored in the compact encoding (and nullptr otherwise)
+  std::shared_ptr<const std::vector<uint32_t> > indices;
+
+  /// the DoFs, when they are not stored in the compact encoding (and nullptr otherwise)
+  std::shared_ptr<const std::vector<DoF> > dofs;
+
+  /// the number of rows and columns in the table, respectively
+  uint64_t dim[2];
+};
+
 /// a small struct used to enable range-based for loops in `Array2D`
 template <typename T>
 struct Range {
@@ -141,8 +185,13 @@ struct Array2D {
 
 namespace serac {
 
-/// a more complete version of mfem::ElementRestriction that works with {H1, Hcurl, L2} spaces (including on the
-/// boundary)
+/**
+ * @brief a more complete version of mfem::ElementRestriction that works with {H1, Hcurl, L2} spaces (including on the
+ * boundary)
+ *
+ * @note the lookup tables (`dof_info`, `L_indices`, `element_colors` and `rank_boundary_elements`) are immutable once
+ * created, and shared by the copies of a restriction, so copies are cheap (see BlockElementRestriction)
+ */
 struct ElementRestriction {
   /// default ctor leaves this object uninitialized
   ElementRestriction() {}
@@ -150,7 +199,13 @@ struct ElementRestriction {
   /// create an ElementRestriction for all domain-type (geom dim == spatial dim) elements of the specified geometry
   ElementRestriction(const mfem::FiniteElementSpace* fes, mfem::Geometry::Type elem_geom);
 
-  /// create an ElementRestriction for all face-type (geom dim == spatial dim) elements of the specified geometry
+  /**
+   * @brief create an ElementRestriction for all face-type (geom dim + 1 == spatial dim) elements of the specified
+   * geometry
+   *
+   * @note for interior faces of DG spaces, each face gathers the face dofs of both of the elements that share it
+   * (first the element that the face normal points out of, then the other one) into one contiguous buffer
+   */
   ElementRestriction(const mfem::FiniteElementSpace* fes, mfem::Geometry::Type face_geom, FaceType type);
 
   /// the size of the "E-vector" associated with this restriction operator
@@ -173,9 +228,61 @@ struct ElementRestriction {
   /// "L->E" in mfem parlance, each element gathers the values that belong to it, and stores them in the "E-vector"
   void Gather(const mfem::Vector& L_vector, mfem::Vector& E_vector) const;
 
-  /// "E->L" in mfem parlance, each element scatter-adds its local vector into the appropriate place in the "L-vector"
+  /**
+   * @brief "E->L" in mfem parlance, each element scatter-adds its local vector into the appropriate place in the
+   * "L-vector"
+   *
+   * @note values belonging to nodes on other ranks (see `num_face_nbr_nodes`) are discarded, since those are
+   * accounted for by the rank that owns them
+   */
   void ScatterAdd(const mfem::Vector& E_vector, mfem::Vector& L_vector) const;
 
+  /**
+   * @brief "L->E" for only the elements [first_element, first_element + count)
+   *
+   * @param L the values of the "L-vector" (on the host)
+   * @param E the values of the "E-vector" for the requested elements, beginning with `first_element`
+   * @param first_element the index of the first element to gather
+   * @param count how many elements to gather
+   */
+  void Gather(const double* L, double* E, uint64_t first_element, uint64_t count) const;
+
+  /**
+   * @brief a version of Gather() for restrictions with nodes on other ranks (see `num_face_nbr_nodes`)
+   *
+   * @param L the values of the "L-vector" (on the host)
+   * @param L_face_nbr the values of the dofs of the neighboring ranks' elements that share a face with this rank,
+   * e.g. mfem::ParGridFunction::FaceNbrData()
+   * @param E the values of the "E-vector" for the requested elements, beginning with `first_element`
+   * @param first_element the index of the first element to gather
+   * @param count how many elements to gather
+   */
+  void Gather(const double* L, const double* L_face_nbr, double* E, uint64_t first_element, uint64_t count) const;
+
+  /**
+   * @brief "E->L" for only the elements [first_element, first_element + count)
+   *
+   * @param E the values of the "E-vector" for the requested elements, beginning with `first_element`
+   * @param L the values of the "L-vector" (on the host)
+   * @param first_element the index of the first element to scatter-add
+   * @param count how many elements to scatter-add
+   */
+  void ScatterAdd(const double* E, double* L, uint64_t first_element, uint64_t count) const;
+
+  /// the number of values in the "E-vector" associated with each element
+  uint64_t ValuesPerElement() const { return nodes_per_elem * components; }
+
+  /**
+   * @brief record which elements have dofs that are not owned by this rank (i.e. their values are only available
+   * after communicating with the neighboring ranks)
+   *
+   * @param fes the finite element space used to create this restriction
+   */
+  void FindRankBoundaryElements(const mfem::FiniteElementSpace* fes);
+
+  /// precompute `L_indices` (and `element_colors`, in OpenMP builds) from `dof_info`
+  void BuildIndexMaps();
+
   /// the size of the "E-vector"
   uint64_t esize;
 
@@ -191,29 +298,74 @@ struct ElementRestriction {
   /// the number of elements of the given geometry
   uint64_t num_elements;
 
+  /**
+   * @brief the number of nodes of the neighboring ranks' elements that share a face with this rank
+   *
+   * @note this is only nonzero for restrictions to the interior faces of a DG space on a mesh that is distributed
+   * over several ranks. The nodes of those elements are numbered after this rank's nodes, so their vdofs are
+   * offset by `lsize` (and their values are only available from the face neighbor data, see Gather())
+   */
+  uint64_t num_face_nbr_nodes;
+
   /// the number of nodes in each element
   uint64_t nodes_per_elem;
 
   /// a 2D array (num_elements-by-nodes_per_elem) holding the dof info extracted from the finite element space
-  axom::Array<DoF, 2, axom::MemorySpace::Host> dof_info;
+  DoFTable dof_info;
 
   /// whether the underlying dofs are arranged "byNodes" or "byVDim"
   mfem::Ordering::Type ordering;
+
+  /// the (sorted) indices of elements with at least one dof owned by another rank, empty for serial spaces
+  std::shared_ptr<const std::vector<uint64_t> > rank_boundary_elements;
+
+  /**
+   * @brief the "L-vector" index of each entry of the "E-vector", decoded from `dof_info` ahead of time
+   * so that Gather and ScatterAdd are simple indirect loops over contiguous memory
+   */
+  std::shared_ptr<const std::vector<int> > L_indices;
+
+  /**
+   * @brief whether the "E-vector" is the range of the "L-vector" that begins at `L_offset` (`L_indices[k] == L_offset
+   * + k`), e.g. for scalar L2 spaces, whose dofs mfem numbers element by element. Then Gather and ScatterAdd are
+   * plain copies, which the element calculations can skip by reading from (and adding into) the "L-vector" directly
+   */
+  bool identity;
+
+  /// the index of the "L-vector" value of the first entry of the "E-vector", see `identity`
+  uint64_t L_offset;
+
+  /**
+   * @brief a partition of the elements (each color in ascending order) such that elements of the same color
+   * share no nodes, so that ScatterAdd can process the elements of each color concurrently without races
+   *
+   * @note only computed in OpenMP builds
+   */
+  std::shared_ptr<const std::vector<std::vector<uint32_t> > > element_colors;
+
+  /// the accounting of the memory of `dof_info`, `L_indices` and `element_colors` (once for all the copies of this
+  /// restriction), see memory::usage()
+  std::shared_ptr<memory::Tracker> tracker;
 };
 
 /**
  * @brief a generalization of mfem::ElementRestriction that works with multiple kinds of element geometries.
  * Instead of doing the "E->L" (gather) and "L->E" (scatter) operations for only one element geometry, this
  * class does them with block "E-vectors", where each element geometry is a separate block.
+ *
+ * The restrictions of a space are cached: every BlockElementRestriction of the same space (and kind of element)
+ * shares the lookup tables of its restrictions with the others, e.g. those of a residual, its sensitivities and the
+ * quantities of interest of a physics module. The tables are released along with the last restriction that uses
+ * them, and rebuilt after the space is updated (see mfem::FiniteElementSpace::GetSequence()).
  */
 struct BlockElementRestriction {
   /// default ctor leaves this object uninitialized
   BlockElementRestriction() {}
 
-  /// create a BlockElementRestriction for all domain-elements (geom dim == spatial dim)
+  /// create (or find in the cache) a BlockElementRestriction for all domain-elements (geom dim == spatial dim)
   BlockElementRestriction(const mfem::FiniteElementSpace* fes);
 
-  /// create a BlockElementRestriction for all face-elements (geom dim + 1 == spatial dim)
+  /// create (or find in the cache) a BlockElementRestriction for all face-elements (geom dim + 1 == spatial dim)
   BlockElementRestriction(const mfem::FiniteElementSpace* fes, FaceType type);
 
   /// the size of the "E-vector" associated with this restriction operator
@@ -233,6 +385,16 @@ struct BlockElementRestriction {
 
   /// the individual ElementRestriction operators for each element geometry
   std::map<mfem::Geometry::Type, ElementRestriction> restrictions;
+
+  /**
+   * @brief whether the block "E-vector" is the "L-vector", i.e. every restriction is the identity and their blocks
+   * are in the order of the "L-vector" (see ElementRestriction::identity). Then the block "E-vector" can alias the
+   * "L-vector", and Gather and ScatterAdd do nothing for an "E-vector" that does
+   */
+  bool identity = false;
+
+  /// the entry of the cache these restrictions were found in, which keeps it alive as long as they are used
+  std::shared_ptr<const std::map<mfem::Geometry::Type, ElementRestriction> > cached;
 };
 
 }  // namespace serac
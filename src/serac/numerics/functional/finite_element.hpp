@@ -82,6 +82,13 @@ struct batched_jacobian<mfem::Geometry::TETRAHEDRON, q> {
   using type = tensor<double, 3, 3, (q * (q + 1) * (q + 2)) / 6>;
 };
 
+/// @overload
+template <int q>
+struct batched_jacobian<mfem::Geometry::PRISM, q> {
+  /// the data layout for this geometry and quadrature rule
+  using type = tensor<double, 3, 3, (q * (q + 1) / 2) * q>;
+};
+
 /**
  * @brief this struct is used to look up mfem's memory layout of the
  * quadrature point position vectors
@@ -120,6 +127,13 @@ struct batched_position<mfem::Geometry::TETRAHEDRON, q> {
   using type = tensor<double, 3, (q * (q + 1) * (q + 2)) / 6>;
 };
 
+/// @overload
+template <int q>
+struct batched_position<mfem::Geometry::PRISM, q> {
+  /// the data layout for this geometry and quadrature rule
+  using type = tensor<double, 3, (q * (q + 1) / 2) * q>;
+};
+
 /// @overload
 template <int q>
 struct batched_position<mfem::Geometry::SEGMENT, q> {
@@ -127,6 +141,13 @@ struct batched_position<mfem::Geometry::SEGMENT, q> {
   using type = tensor<double, q>;
 };
 
+/**
+ * @brief the highest polynomial order of the H1 and L2 elements on triangles, tetrahedra and prisms
+ *
+ * @note the elements on segments, quadrilaterals and hexahedra are implemented up to order 8
+ */
+inline constexpr int max_simplex_order = 3;
+
 /**
  * @brief this function returns information about how many elements
  * should be processed by a single thread block in CUDA (note: the optimal
@@ -244,7 +265,7 @@ struct QOI {
  * @param jacobians the jacobians of the isoparametric map from parent to physical space of each quadrature point
  */
 template <Family f, typename T, int q, int dim>
-void parent_to_physical(tensor<T, q>& qf_input, const tensor<double, dim, dim, q>& jacobians)
+SERAC_HOST_DEVICE void parent_to_physical(tensor<T, q>& qf_input, const tensor<double, dim, dim, q>& jacobians)
 {
   [[maybe_unused]] constexpr int VALUE      = 0;
   [[maybe_unused]] constexpr int DERIVATIVE = 1;
@@ -285,7 +306,7 @@ void parent_to_physical(tensor<T, q>& qf_input, const tensor<double, dim, dim, q
  * @param jacobians the jacobians of the isoparametric map from parent to physical space of each quadrature point
  */
 template <Family f, typename T, int q, int dim>
-void physical_to_parent(tensor<T, q>& qf_output, const tensor<double, dim, dim, q>& jacobians)
+SERAC_HOST_DEVICE void physical_to_parent(tensor<T, q>& qf_output, const tensor<double, dim, dim, q>& jacobians)
 {
   [[maybe_unused]] constexpr int SOURCE = 0;
   [[maybe_unused]] constexpr int FLUX   = 1;
@@ -321,6 +342,155 @@ void physical_to_parent(tensor<T, q>& qf_output, const tensor<double, dim, dim,
   }
 }
 
+/**
+ * @brief the jacobian of an affine isoparametric map (which is the same at every point of the element), along with
+ * its inverse and determinant, so that they are only computed once per element
+ * @tparam dim the spatial dimension
+ */
+template <int dim>
+struct AffineJacobian {
+  tensor<double, dim, dim> J;      ///< the derivatives of the physical coordinates w.r.t. the parent coordinates
+  tensor<double, dim, dim> inv_J;  ///< the inverse of J
+  double                   det_J;  ///< the determinant of J
+};
+
+/**
+ * @brief the inverses and determinants of the jacobians of an element's isoparametric map at each of its quadrature
+ * points, precomputed once rather than in every evaluation (see Functional::SetPrecomputedInverseJacobians())
+ * @tparam dim the spatial dimension
+ * @tparam q the number of quadrature points
+ */
+template <int dim, int q>
+struct InverseJacobians {
+  tensor<double, q, dim, dim> inv_J;  ///< the inverse of the jacobian at each quadrature point
+  tensor<double, q>           det_J;  ///< the determinant of the jacobian at each quadrature point
+};
+
+namespace detail {
+
+/// @brief parent_to_physical() at a single point, given the jacobian there along with its inverse and determinant
+template <Family f, typename T, int dim>
+SERAC_HOST_DEVICE void parent_to_physical_at_point(T& qf_input, [[maybe_unused]] const tensor<double, dim, dim>& J,
+                                                   const tensor<double, dim, dim>& inv_J, [[maybe_unused]] double det_J)
+{
+  [[maybe_unused]] constexpr int VALUE      = 0;
+  [[maybe_unused]] constexpr int DERIVATIVE = 1;
+
+  if constexpr (f == Family::H1 || f == Family::L2) {
+    get<DERIVATIVE>(qf_input) = dot(get<DERIVATIVE>(qf_input), inv_J);
+  }
+
+  if constexpr (f == Family::HCURL) {
+    get<VALUE>(qf_input)      = dot(get<VALUE>(qf_input), inv_J);
+    get<DERIVATIVE>(qf_input) = get<DERIVATIVE>(qf_input) / det_J;
+    if constexpr (dim == 3) {
+      get<DERIVATIVE>(qf_input) = dot(get<DERIVATIVE>(qf_input), transpose(J));
+    }
+  }
+}
+
+/// @brief physical_to_parent() at a single point, given the jacobian there along with its inverse and determinant
+template <Family f, typename T, int dim>
+SERAC_HOST_DEVICE void physical_to_parent_at_point(T& qf_output, [[maybe_unused]] const tensor<double, dim, dim>& J,
+                                                   [[maybe_unused]] const tensor<double, dim, dim>& inv_J, double det_J)
+{
+  [[maybe_unused]] constexpr int SOURCE = 0;
+  [[maybe_unused]] constexpr int FLUX   = 1;
+
+  if constexpr (f == Family::H1 || f == Family::L2) {
+    get<SOURCE>(qf_output) = get<SOURCE>(qf_output) * det_J;
+    get<FLUX>(qf_output)   = dot(get<FLUX>(qf_output), transpose(inv_J)) * det_J;
+  }
+
+  if constexpr (f == Family::HCURL) {
+    get<SOURCE>(qf_output) = dot(get<SOURCE>(qf_output), transpose(inv_J)) * det_J;
+    if constexpr (dim == 3) {
+      get<FLUX>(qf_output) = dot(get<FLUX>(qf_output), J);
+    }
+  }
+
+  if constexpr (f == Family::QOI) {
+    qf_output = qf_output * det_J;
+  }
+}
+
+/// @brief the jacobian at quadrature point k, in the layout of the jacobians passed to parent_to_physical()
+template <int dim, int q>
+SERAC_HOST_DEVICE tensor<double, dim, dim> jacobian_at(const tensor<double, dim, dim, q>& jacobians, int k)
+{
+  tensor<double, dim, dim> J;
+  for (int row = 0; row < dim; row++) {
+    for (int col = 0; col < dim; col++) {
+      J[row][col] = jacobians(col, row, k);
+    }
+  }
+  return J;
+}
+
+}  // namespace detail
+
+/**
+ * @overload
+ * @brief parent_to_physical() for elements with an affine isoparametric map, which doesn't need to invert the
+ * jacobian at each quadrature point
+ */
+template <Family f, typename T, int q, int dim>
+SERAC_HOST_DEVICE void parent_to_physical(tensor<T, q>& qf_input, const AffineJacobian<dim>& jacobian)
+{
+  for (int k = 0; k < q; k++) {
+    detail::parent_to_physical_at_point<f>(qf_input[k], jacobian.J, jacobian.inv_J, jacobian.det_J);
+  }
+}
+
+/**
+ * @overload
+ * @brief physical_to_parent() for elements with an affine isoparametric map, which doesn't need to invert the
+ * jacobian at each quadrature point
+ */
+template <Family f, typename T, int q, int dim>
+SERAC_HOST_DEVICE void physical_to_parent(tensor<T, q>& qf_output, const AffineJacobian<dim>& jacobian)
+{
+  for (int k = 0; k < q; k++) {
+    detail::physical_to_parent_at_point<f>(qf_output[k], jacobian.J, jacobian.inv_J, jacobian.det_J);
+  }
+}
+
+/**
+ * @overload
+ * @brief parent_to_physical() with precomputed inverses and determinants of the jacobians at each quadrature point
+ */
+template <Family f, typename T, int q, int dim>
+SERAC_HOST_DEVICE void parent_to_physical(tensor<T, q>& qf_input, const tensor<double, dim, dim, q>& jacobians,
+                                          const InverseJacobians<dim, q>& inverses)
+{
+  for (int k = 0; k < q; k++) {
+    // only H(curl) elements use the jacobian itself
+    tensor<double, dim, dim> J{};
+    if constexpr (f == Family::HCURL) {
+      J = detail::jacobian_at(jacobians, k);
+    }
+    detail::parent_to_physical_at_point<f>(qf_input[k], J, inverses.inv_J[k], inverses.det_J[k]);
+  }
+}
+
+/**
+ * @overload
+ * @brief physical_to_parent() with precomputed inverses and determinants of the jacobians at each quadrature point
+ */
+template <Family f, typename T, int q, int dim>
+SERAC_HOST_DEVICE void physical_to_parent(tensor<T, q>& qf_output, const tensor<double, dim, dim, q>& jacobians,
+                                          const InverseJacobians<dim, q>& inverses)
+{
+  for (int k = 0; k < q; k++) {
+    // only H(curl) elements use the jacobian itself
+    tensor<double, dim, dim> J{};
+    if constexpr (f == Family::HCURL) {
+      J = detail::jacobian_at(jacobians, k);
+    }
+    detail::physical_to_parent_at_point<f>(qf_output[k], J, inverses.inv_J[k], inverses.det_J[k]);
+  }
+}
+
 /**
  * @brief Template prototype for finite element implementations
  * @tparam g The geometry of the element
@@ -349,10 +519,14 @@ void physical_to_parent(tensor<T, q>& qf_output, const tensor<double, dim, dim,
 template <mfem::Geometry::Type g, typename family>
 struct finite_element;
 
+#include "detail/element_constant.inl"
+
 #include "detail/segment_H1.inl"
 #include "detail/segment_Hcurl.inl"
 #include "detail/segment_L2.inl"
 
+#include "detail/simplex_basis.inl"
+
 #include "detail/triangle_H1.inl"
 #include "detail/triangle_L2.inl"
 
@@ -367,6 +541,11 @@ struct finite_element;
 #include "detail/hexahedron_Hcurl.inl"
 #include "detail/hexahedron_L2.inl"
 
+#include "detail/prism_basis.inl"
+
+#include "detail/prism_H1.inl"
+#include "detail/prism_L2.inl"
+
 #include "detail/qoi.inl"
 
 }  // namespace serac
@@ -15,16 +15,32 @@
 #include "mfem.hpp"
 
 #include "serac/infrastructure/logger.hpp"
+#include "serac/infrastructure/memory.hpp"
 #include "serac/numerics/functional/tensor.hpp"
 #include "serac/numerics/functional/quadrature.hpp"
 #include "serac/numerics/functional/finite_element.hpp"
 #include "serac/numerics/functional/integral.hpp"
+#include "serac/numerics/functional/qfunction_pack.hpp"
 #include "serac/numerics/functional/dof_numbering.hpp"
+#include "serac/numerics/functional/in_place_assembly.hpp"
+#include "serac/numerics/functional/overlapped_prolongation.hpp"
 #include "serac/numerics/functional/differentiate_wrt.hpp"
 
 #include "serac/numerics/functional/element_restriction.hpp"
+#include "serac/numerics/functional/tuning_cache.hpp"
 
+#include <algorithm>
 #include <array>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <initializer_list>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <utility>
 #include <vector>
 
 namespace serac {
@@ -33,6 +49,29 @@ template <int... i>
 struct DependsOn {
 };
 
+/**
+ * @brief a tag type that sets the number of quadrature points per dimension of an integral, overriding the default
+ * of one more than the highest polynomial order of its test and trial spaces, e.g.
+ *
+ * @code{.cpp}
+ * // a lumped-looking mass term for linear elements, integrated with a single point per dimension
+ * residual.AddDomainIntegral(Dimension<3>{}, DependsOn<0>{}, QuadraturePoints<1>{}, mass_qfunction, mesh);
+ * @endcode
+ *
+ * Lower-order terms (mass matrices, body forces, tractions) often don't need the default rule, and reduced
+ * integration of some terms (e.g. the volumetric part of a nearly incompressible material) is a common way to
+ * alleviate locking. The number of points on triangles and tetrahedra refers to their symmetric rules (see
+ * GaussLegendreNodes()), which have (q (q + 1)) / 2 and (q (q + 1) (q + 2)) / 6 points, respectively.
+ *
+ * @note any quadrature point data of the integral must be allocated for this number of quadrature points
+ *
+ * @tparam q the number of quadrature points per dimension
+ */
+template <int q>
+struct QuadraturePoints {
+  static_assert(1 <= q && q <= 9, "quadrature rules are only implemented with 1 to 9 points per dimension");
+};
+
 /**
  * @brief given a list of types, this function returns the index that corresponds to the type `dual_vector`.
  *
@@ -56,6 +95,30 @@ constexpr uint32_t index_of_differentiation()
   return NO_DIFFERENTIATION;
 }
 
+/**
+ * @brief given a list of types, this function returns the indices of each type `differentiate_wrt_this`, in order
+ *
+ * e.g.
+ * @code{.cpp}
+ * static_assert(indices_of_differentiation < foo, differentiate_wrt_this, bar, differentiate_wrt_this >()[1] == 3);
+ * @endcode
+ */
+template <typename... T>
+constexpr auto indices_of_differentiation()
+{
+  constexpr uint32_t n          = sizeof...(T);
+  bool               matching[] = {std::is_same_v<T, differentiate_wrt_this>...};
+
+  std::array<uint32_t, (std::is_same_v<T, differentiate_wrt_this> + ... + 0)> indices{};
+  uint32_t                                                                     count = 0;
+  for (uint32_t i = 0; i < n; i++) {
+    if (matching[i]) {
+      indices[count++] = i;
+    }
+  }
+  return indices;
+}
+
 /**
  * @brief Compile-time alias for index of differentiation
  */
@@ -91,9 +154,13 @@ void check_for_unsupported_elements(const mfem::Mesh& mesh)
   int num_elements = mesh.GetNE();
   for (int e = 0; e < num_elements; e++) {
     auto type = mesh.GetElementType(e);
-    if (type == mfem::Element::POINT || type == mfem::Element::WEDGE || type == mfem::Element::PYRAMID) {
+    if (type == mfem::Element::POINT) {
       SLIC_ERROR_ROOT("Mesh contains unsupported element type");
     }
+
+    // the pyramid shape functions are rational, and don't have the tensor product structure in any direction
+    // that the kernels of the other elements rely on
+    SLIC_ERROR_ROOT_IF(type == mfem::Element::PYRAMID, "pyramid elements are not supported by serac::Functional");
   }
 }
 
@@ -160,7 +227,9 @@ class Functional;
  *
  * @tparam test The space of test functions to use
  * @tparam trial The space of trial functions to use
- * @tparam exec whether to carry out calculations on CPU or GPU
+ * @tparam exec whether to carry out calculations on CPU or GPU: with ExecutionSpace::Dynamic, each integral is
+ * carried out on whichever of the two suits its size (see accelerator::selectExecutionSpace()), with the data flow of
+ * ExecutionSpace::GPU (i.e. through E-vectors, whose values mfem moves between the host and the device as needed)
  *
  * To use this class, you use the methods @p Functional::Add****Integral(integrand,domain_of_integration)
  * where @p integrand is a q-function lambda or functor and @p domain_of_integration is an @p mfem::mesh
@@ -196,14 +265,18 @@ class Functional<test(trials...), exec> {
 
   class Gradient;
 
+  /// @brief the type of a reference to the gradient w.r.t. argument `i`
+  template <uint32_t i>
+  using gradient_reference = Gradient&;
+
   // clang-format off
-  template <uint32_t i> 
+  template <uint32_t... i> 
   struct operator_paren_return {
     using type = typename std::conditional<
-        i == NO_DIFFERENTIATION,               // if `i` indicates that we want to skip differentiation
-        mfem::Vector&,                         // we just return the value
-        serac::tuple<mfem::Vector&, Gradient&> // otherwise we return the value and the derivative w.r.t arg `i`
-        >::type;
+        ((i == NO_DIFFERENTIATION) && ...),                    // if `i` indicates that we want to skip differentiation
+        mfem::Vector&,                                         // we just return the value
+        serac::tuple<mfem::Vector&, gradient_reference<i>...>  // otherwise we return the value and the derivative
+        >::type;                                               // w.r.t each arg `i`
   };
   // clang-format on
 
@@ -217,47 +290,9 @@ public:
              std::array<const mfem::ParFiniteElementSpace*, num_trial_spaces> trial_fes)
       : update_qdata(false), test_space_(test_fes), trial_space_(trial_fes)
   {
-    auto mem_type = mfem::Device::GetMemoryType();
-
-    for (auto type : {Integral::Type::Domain, Integral::Type::Boundary}) {
-      input_E_[type].resize(num_trial_spaces);
-    }
-
-    for (uint32_t i = 0; i < num_trial_spaces; i++) {
-      P_trial_[i] = trial_space_[i]->GetProlongationMatrix();
-
-      input_L_[i].SetSize(P_trial_[i]->Height(), mfem::Device::GetMemoryType());
-
-      // L->E
-      for (auto type : {Integral::Type::Domain, Integral::Type::Boundary}) {
-        if (type == Integral::Type::Domain) {
-          G_trial_[type][i] = BlockElementRestriction(trial_fes[i]);
-        } else {
-          G_trial_[type][i] = BlockElementRestriction(trial_fes[i], FaceType::BOUNDARY);
-        }
-
-        // note: we have to use "Update" here, as mfem::BlockVector's
-        // copy assignment ctor (operator=) doesn't let you make changes
-        // to the block size
-        input_E_[type][i].Update(G_trial_[type][i].bOffsets(), mem_type);
-      }
-    }
+    SERAC_PROFILE_SCOPE("Functional::Functional");
 
-    for (auto type : {Integral::Type::Domain, Integral::Type::Boundary}) {
-      if (type == Integral::Type::Domain) {
-        G_test_[type] = BlockElementRestriction(test_fes);
-      } else {
-        G_test_[type] = BlockElementRestriction(test_fes, FaceType::BOUNDARY);
-      }
-
-      output_E_[type].Update(G_test_[type].bOffsets(), mem_type);
-    }
-
-    P_test_ = test_space_->GetProlongationMatrix();
-
-    output_L_.SetSize(P_test_->Height(), mem_type);
-
-    output_T_.SetSize(test_fes->GetTrueVSize(), mem_type);
+    initialize_spaces();
 
     // gradient objects depend on some member variables in
     // Functional, so we initialize the gradient objects last
@@ -281,17 +316,81 @@ public:
   template <int dim, int... args, typename lambda, typename qpt_data_type = Nothing>
   void AddDomainIntegral(Dimension<dim>, DependsOn<args...>, lambda&& integrand, mfem::Mesh& domain,
                          std::shared_ptr<QuadratureData<qpt_data_type>> qdata = NoQData)
+  {
+    AddDomainIntegral(Dimension<dim>{}, DependsOn<args...>{}, QuadraturePoints<Q>{}, integrand, domain,
+                      std::set<int>{}, qdata);
+  }
+
+  /**
+   * @brief Adds a domain integral term with a specific quadrature rule to the weak formulation of the PDE
+   * @tparam q the number of quadrature points per dimension, see @p QuadraturePoints
+   * @param[in] integrand The user-provided quadrature function, see @p Integral
+   * @param[in] domain The domain on which to evaluate the integral
+   * @param[inout] qdata The data for each quadrature point (of this integral's quadrature rule)
+   */
+  template <int dim, int... args, int q, typename lambda, typename qpt_data_type = Nothing>
+  void AddDomainIntegral(Dimension<dim>, DependsOn<args...>, QuadraturePoints<q>, lambda&& integrand,
+                         mfem::Mesh& domain, std::shared_ptr<QuadratureData<qpt_data_type>> qdata = NoQData)
+  {
+    AddDomainIntegral(Dimension<dim>{}, DependsOn<args...>{}, QuadraturePoints<q>{}, integrand, domain,
+                      std::set<int>{}, qdata);
+  }
+
+  /**
+   * @brief Adds a domain integral term over the elements with the given attributes to the weak formulation of the PDE
+   *
+   * Only those elements are evaluated, and the quadrature point data only needs to describe those elements,
+   * numbered in the order they appear in the mesh (for each element geometry).
+   *
+   * @param[in] integrand The user-provided quadrature function, see @p Integral
+   * @param[in] domain The domain on which to evaluate the integral
+   * @param[in] attributes The attributes of the elements to integrate over (or every element, if empty)
+   * @param[inout] qdata The data for each quadrature point of those elements
+   *
+   * @note integrals over some of the elements are not yet supported for ExecutionSpace::GPU
+   */
+  template <int dim, int... args, typename lambda, typename qpt_data_type = Nothing>
+  void AddDomainIntegral(Dimension<dim>, DependsOn<args...>, lambda&& integrand, mfem::Mesh& domain,
+                         const std::set<int>& attributes,
+                         std::shared_ptr<QuadratureData<qpt_data_type>> qdata = NoQData)
+  {
+    AddDomainIntegral(Dimension<dim>{}, DependsOn<args...>{}, QuadraturePoints<Q>{}, integrand, domain, attributes,
+                      qdata);
+  }
+
+  /**
+   * @brief Adds a domain integral term with a specific quadrature rule, over the elements with the given attributes,
+   * to the weak formulation of the PDE
+   * @tparam q the number of quadrature points per dimension, see @p QuadraturePoints
+   * @param[in] integrand The user-provided quadrature function, see @p Integral
+   * @param[in] domain The domain on which to evaluate the integral
+   * @param[in] attributes The attributes of the elements to integrate over (or every element, if empty)
+   * @param[inout] qdata The data for each quadrature point (of this integral's quadrature rule) of those elements
+   */
+  template <int dim, int... args, int q, typename lambda, typename qpt_data_type = Nothing>
+  void AddDomainIntegral(Dimension<dim>, DependsOn<args...>, QuadraturePoints<q>, lambda&& integrand,
+                         mfem::Mesh& domain, const std::set<int>& attributes,
+                         std::shared_ptr<QuadratureData<qpt_data_type>> qdata = NoQData)
   {
     if (domain.GetNE() == 0) return;
 
+    SERAC_PROFILE_SCOPE("Functional::AddDomainIntegral");
+
     SLIC_ERROR_ROOT_IF(dim != domain.Dimension(), "invalid mesh dimension for domain integral");
 
     check_for_unsupported_elements(domain);
     check_for_missing_nodal_gridfunc(domain);
 
-    using signature = test(decltype(serac::type<args>(trial_spaces))...);
-    integrals_.push_back(
-        MakeDomainIntegral<signature, Q, dim>(domain, integrand, qdata, std::vector<uint32_t>{args...}));
+    // the integral is built again by Update(), from the (possibly remapped) quadrature data
+    integral_builders_.push_back([this, integrand, &domain, attributes, qdata]() {
+      using signature = test(decltype(serac::type<args>(trial_spaces))...);
+      integrals_.push_back(MakeDomainIntegral<signature, q, dim, exec>(
+          domain, integrand, qdata, std::vector<uint32_t>{args...}, attributes, precompute_inverse_jacobians_));
+    });
+    integral_builders_.back()();
+
+    // the captured kernel sequences don't include the new integral
+    kernel_graphs_.clear();
   }
 
   /**
@@ -305,14 +404,131 @@ public:
    */
   template <int dim, int... args, typename lambda>
   void AddBoundaryIntegral(Dimension<dim>, DependsOn<args...>, lambda&& integrand, mfem::Mesh& domain)
+  {
+    AddBoundaryIntegral(Dimension<dim>{}, DependsOn<args...>{}, QuadraturePoints<Q>{}, integrand, domain);
+  }
+
+  /**
+   * @brief Adds a boundary integral term with a specific quadrature rule to the weak formulation of the PDE
+   * @tparam q the number of quadrature points per dimension, see @p QuadraturePoints
+   * @param[in] integrand The user-provided quadrature function, see @p Integral
+   * @param[in] domain The domain on which to evaluate the integral
+   */
+  template <int dim, int... args, int q, typename lambda>
+  void AddBoundaryIntegral(Dimension<dim>, DependsOn<args...>, QuadraturePoints<q>, lambda&& integrand,
+                           mfem::Mesh& domain)
+  {
+    AddBoundaryIntegral(Dimension<dim>{}, DependsOn<args...>{}, QuadraturePoints<q>{}, integrand, domain,
+                        std::set<int>{});
+  }
+
+  /**
+   * @brief Adds a boundary integral term over the boundary elements with the given attributes to the weak
+   * formulation of the PDE, e.g. for a load that only acts on part of the boundary
+   *
+   * Only those boundary elements are evaluated (and only their geometric factors are stored), rather than
+   * every boundary element with a q-function that vanishes on the others.
+   *
+   * @param[in] integrand The user-provided quadrature function, see @p Integral
+   * @param[in] domain The domain on which to evaluate the integral
+   * @param[in] attributes The attributes of the boundary elements to integrate over (or every one, if empty)
+   *
+   * @note integrals over some of the boundary elements are not yet supported for ExecutionSpace::GPU
+   */
+  template <int dim, int... args, typename lambda>
+  void AddBoundaryIntegral(Dimension<dim>, DependsOn<args...>, lambda&& integrand, mfem::Mesh& domain,
+                           const std::set<int>& attributes)
+  {
+    AddBoundaryIntegral(Dimension<dim>{}, DependsOn<args...>{}, QuadraturePoints<Q>{}, integrand, domain,
+                        attributes);
+  }
+
+  /**
+   * @brief Adds a boundary integral term with a specific quadrature rule, over the boundary elements with the given
+   * attributes, to the weak formulation of the PDE
+   * @tparam q the number of quadrature points per dimension, see @p QuadraturePoints
+   * @param[in] integrand The user-provided quadrature function, see @p Integral
+   * @param[in] domain The domain on which to evaluate the integral
+   * @param[in] attributes The attributes of the boundary elements to integrate over (or every one, if empty)
+   */
+  template <int dim, int... args, int q, typename lambda>
+  void AddBoundaryIntegral(Dimension<dim>, DependsOn<args...>, QuadraturePoints<q>, lambda&& integrand,
+                           mfem::Mesh& domain, const std::set<int>& attributes)
   {
     auto num_bdr_elements = domain.GetNBE();
     if (num_bdr_elements == 0) return;
 
+    SERAC_PROFILE_SCOPE("Functional::AddBoundaryIntegral");
+
+    check_for_missing_nodal_gridfunc(domain);
+
+    integral_builders_.push_back([this, integrand, &domain, attributes]() {
+      using signature = test(decltype(serac::type<args>(trial_spaces))...);
+      integrals_.push_back(MakeBoundaryIntegral<signature, q, dim, exec>(domain, integrand,
+                                                                         std::vector<uint32_t>{args...}, attributes));
+    });
+    integral_builders_.back()();
+
+    // the captured kernel sequences don't include the new integral
+    kernel_graphs_.clear();
+  }
+
+  /**
+   * @brief Adds an integral over the interior faces of the mesh (e.g. the numerical fluxes of a DG method), where
+   * the q-function is given the values of each trial space on both sides of the face, e.g.
+   *
+   * @code{.cpp}
+   * residual.AddInteriorFaceIntegral(Dimension<1>{}, DependsOn<0>{}, [](auto x, auto n, auto u) {
+   *   auto [u1, u2] = u;  // the values on side 1 and side 2
+   *   return serac::tuple{u1 - u2, u2 - u1};
+   * }, mesh);
+   * @endcode
+   *
+   * where `n` is the unit normal pointing from side 1 to side 2, and the q-function returns the sources to
+   * integrate against the test functions of side 1 and side 2, respectively
+   *
+   * @tparam dim The dimension of the faces (1 for line, 2 for quad, etc)
+   * @tparam lambda the type of the integrand functor: must implement operator() with an appropriate function signature
+   * @param[in] integrand The user-provided quadrature function
+   * @param[in] domain The mesh whose interior faces are integrated over
+   *
+   * @note the test space and trial spaces used by the integral must be L2 spaces. On faces shared with another
+   * rank, the values from the other side are exchanged through mfem's face neighbor data.
+   */
+  template <int dim, int... args, typename lambda>
+  void AddInteriorFaceIntegral(Dimension<dim>, DependsOn<args...>, lambda&& integrand, mfem::Mesh& domain)
+  {
+    static_assert(exec == ExecutionSpace::CPU, "interior face integrals are only supported on the CPU");
+    static_assert(test::family == Family::L2 &&
+                      ((decltype(serac::type<args>(trial_spaces))::family == Family::L2) && ...),
+                  "interior face integrals require L2 test and trial spaces");
+
+    SERAC_PROFILE_SCOPE("Functional::AddInteriorFaceIntegral");
+
     check_for_missing_nodal_gridfunc(domain);
 
-    using signature = test(decltype(serac::type<args>(trial_spaces))...);
-    integrals_.push_back(MakeBoundaryIntegral<signature, Q, dim>(domain, integrand, std::vector<uint32_t>{args...}));
+    integral_builders_.push_back([this, integrand, &domain]() {
+      // the restrictions for interior faces are only created for Functionals that need them
+      //
+      // note: this is collective (face neighbor data is exchanged between ranks), so it is done even on ranks
+      // without any interior faces
+      if (!uses_interior_faces_) {
+        G_test_[Integral::InteriorFace] = BlockElementRestriction(test_space_, FaceType::INTERIOR);
+        uses_interior_faces_            = true;
+      }
+      for (uint32_t i : std::vector<uint32_t>{args...}) {
+        if (!uses_face_nbr_values_[i]) {
+          G_trial_[Integral::InteriorFace][i] = BlockElementRestriction(trial_space_[i], FaceType::INTERIOR);
+          uses_face_nbr_values_[i]            = true;
+        }
+      }
+      partition_elements();
+
+      using signature = test(decltype(serac::type<args>(trial_spaces))...);
+      integrals_.push_back(
+          MakeInteriorFaceIntegral<signature, Q, dim, exec>(domain, integrand, std::vector<uint32_t>{args...}));
+    });
+    integral_builders_.back()();
   }
 
   /**
@@ -367,88 +583,297 @@ public:
    */
   void ActionOfGradient(const mfem::Vector& input_T, mfem::Vector& output_T, uint32_t which) const
   {
-    P_trial_[which]->Mult(input_T, input_L_[which]);
+    SERAC_TIME_SCOPE("Functional gradient actions");
 
     output_L_ = 0.0;
 
-    // this is used to mark when gather operations have been performed,
-    // to avoid doing them more than once per trial space
-    bool already_computed[Integral::num_types]{};  // default initializes to `false`
+    if constexpr (exec == ExecutionSpace::CPU) {
+      auto evaluate = [&](ElementStage stage) {
+        for (auto& integral : integrals_) {
+          if (integral.functional_to_integral_index_.count(which) == 0) continue;
 
-    for (auto& integral : integrals_) {
-      auto type = integral.type;
+          batched_element_loop(integral, {which}, element_ranges_[integral.type][stage],
+                               [&](mfem::Geometry::Type geom, const std::vector<const double*>& inputs,
+                                   double* outputs, uint32_t first_element, uint32_t num_elements) {
+                                 integral.GradientMult(geom, inputs[0], outputs, first_element, num_elements, which);
+                               });
+        }
+      };
+
+      // elements whose dofs are all owned by this rank are evaluated while the shared dof values are exchanged
+      trial_prolongation_[which].MultBegin(input_T, input_L_[which]);
+      evaluate(InteriorBeforeExchange);
+      {
+        SERAC_TIME_SCOPE("Functional MPI wait");
+        trial_prolongation_[which].MultEnd(input_L_[which]);
+        exchange_face_nbr_values(which, input_L_[which], face_nbr_L_[which]);
+      }
 
-      if (!already_computed[type]) {
-        G_trial_[type][which].Gather(input_L_[which], input_E_[type][which]);
-        already_computed[type] = true;
+      evaluate(RankBoundary);
+
+      // scatter-add to compute global residuals
+      test_prolongation_.MultTransposeBegin(output_L_);
+      evaluate(InteriorDuringReduction);
+      {
+        SERAC_TIME_SCOPE("Functional MPI wait");
+        test_prolongation_.MultTransposeEnd(output_L_, output_T);
       }
+    } else {
+      P_trial_[which]->Mult(input_T, input_L_[which]);
+
+      if ((use_kernel_graphs_ || concurrent_integrals_) && !batched_device_evaluation_) {
+        device_element_loop({1, which}, {which},
+                            [&](const Integral& integral, mfem::Geometry::Type geom,
+                                const std::vector<const double*>& inputs, double* outputs, uint32_t num_elements) {
+                              auto index = integral.functional_to_integral_index_.find(which);
+                              if (index == integral.functional_to_integral_index_.end()) return;
+                              integral.GradientMult(geom, inputs[index->second], outputs, 0, num_elements, which);
+                            });
+      } else {
+        // this is used to mark when gather operations have been performed,
+        // to avoid doing them more than once per trial space
+        bool already_computed[Integral::num_types]{};  // default initializes to `false`
+
+        for (auto& integral : integrals_) {
+          auto type = integral.type;
+
+          if (batched_device_evaluation_) {
+            device_batched_element_loop(integral, {which},
+                                        [&](mfem::Geometry::Type geom, const std::vector<const double*>& inputs,
+                                            double* outputs, uint32_t first_element, uint32_t num_elements) {
+                                          integral.GradientMult(geom, inputs[0], outputs, first_element, num_elements,
+                                                                which);
+                                        });
+            continue;
+          }
+
+          if (!already_computed[type]) {
+            G_trial_[type][which].Gather(input_L_[which], input_E_[type][which]);
+            already_computed[type] = true;
+          }
 
-      integral.GradientMult(input_E_[type][which], output_E_[type], which);
+          integral.GradientMult(input_E_[type][which], output_E_[type], which);
 
-      // scatter-add to compute residuals on the local processor
-      G_test_[type].ScatterAdd(output_E_[type], output_L_);
-    }
+          // scatter-add to compute residuals on the local processor
+          G_test_[type].ScatterAdd(output_E_[type], output_L_);
+        }
+      }
 
-    // scatter-add to compute global residuals
-    P_test_->MultTranspose(output_L_, output_T);
+      // scatter-add to compute global residuals
+      P_test_->MultTranspose(output_L_, output_T);
+    }
   }
 
   /**
-   * @brief this function lets the user evaluate the serac::Functional with the given trial space values
+   * @brief this function computes the directional derivatives of `serac::Functional::operator()` in several
+   * directions at once
    *
-   * note: it accepts exactly `num_trial_spaces` arguments of type mfem::Vector. Additionally, one of those
-   * arguments may be a dual_vector, to indicate that Functional::operator() should not only evaluate the
-   * element calculations, but also differentiate them w.r.t. the specified dual_vector argument
+   * Compared to calling ActionOfGradient() once per direction, the q-function derivatives are only read from memory
+   * once (per element) and then applied to every direction, which makes better use of memory bandwidth.
    *
-   * @tparam T the types of the arguments passed in
-   * @param args the trial space dofs used to carry out the calculation,
-   *  at most one of which may be of the type `differentiate_wrt_this(mfem::Vector)`
+   * @param input_T the T-vectors to apply the action of gradient to, one per column
+   * @param output_T the T-vectors where the resulting values are stored, one per column (resized to match input_T)
+   * @param which describes which trial space input_T corresponds to
    */
-  template <uint32_t wrt, typename... T>
-  typename operator_paren_return<wrt>::type operator()(DifferentiateWRT<wrt>, const T&... args)
+  void ActionOfGradient(const mfem::DenseMatrix& input_T, mfem::DenseMatrix& output_T, uint32_t which) const
   {
-    const mfem::Vector* input_T[] = {&static_cast<const mfem::Vector&>(args)...};
+    SERAC_TIME_SCOPE("Functional gradient actions");
 
-    // get the values for each local processor
-    for (uint32_t i = 0; i < num_trial_spaces; i++) {
-      P_trial_[i]->Mult(*input_T[i], input_L_[i]);
+    auto num_directions = uint32_t(input_T.Width());
+
+    output_T.SetSize(test_space_->GetTrueVSize(), input_T.Width());
+
+    if constexpr (exec == ExecutionSpace::CPU) {
+      block_input_L_.resize(num_directions);
+      block_face_nbr_L_.resize(num_directions);
+      block_output_L_.resize(num_directions);
+
+      // note: the values are exchanged one direction at a time, since only one exchange per communicator
+      // may be in progress at once
+      for (uint32_t d = 0; d < num_directions; d++) {
+        mfem::Vector input_T_d(const_cast<double*>(input_T.GetColumn(int(d))), input_T.Height());
+        block_input_L_[d].SetSize(input_L_[which].Size());
+        P_trial_[which]->Mult(input_T_d, block_input_L_[d]);
+        exchange_face_nbr_values(which, block_input_L_[d], block_face_nbr_L_[d]);
+
+        block_output_L_[d].SetSize(output_L_.Size());
+        block_output_L_[d] = 0.0;
+      }
+
+      for (auto& integral : integrals_) {
+        if (integral.functional_to_integral_index_.count(which) == 0) continue;
+
+        block_element_loop(integral, which, num_directions);
+      }
+
+      // scatter-add to compute global residuals
+      for (uint32_t d = 0; d < num_directions; d++) {
+        mfem::Vector output_T_d(output_T.GetColumn(int(d)), output_T.Height());
+        P_test_->MultTranspose(block_output_L_[d], output_T_d);
+      }
+    } else {
+      for (uint32_t d = 0; d < num_directions; d++) {
+        mfem::Vector input_T_d(const_cast<double*>(input_T.GetColumn(int(d))), input_T.Height());
+        mfem::Vector output_T_d(output_T.GetColumn(int(d)), output_T.Height());
+        ActionOfGradient(input_T_d, output_T_d, which);
+      }
     }
+  }
 
-    output_L_ = 0.0;
+  /**
+   * @brief this function computes the action of the transpose of the gradient of `serac::Functional::operator()`
+   * (the vector-jacobian product), e.g. for the sensitivities of an adjoint problem
+   *
+   * The test space values of each element are interpolated at the quadrature points, the transpose of the stored
+   * q-function derivatives is applied to them, and the result is integrated against the trial space basis
+   * functions, so no sparse matrix is assembled. Integrals whose q-function derivatives aren't stored (see
+   * Integral::HasGradientTranspose()) apply the transposes of their element matrices instead.
+   *
+   * @param input_T the T-vector (in the test space) to apply the transposed gradient to
+   * @param output_T the T-vector (in trial space `which`) where the resulting values are stored
+   * @param which describes which trial space output_T corresponds to
+   *
+   * @note interior face integrals are not supported
+   */
+  void ActionOfGradientTranspose(const mfem::Vector& input_T, mfem::Vector& output_T, uint32_t which) const
+  {
+    SERAC_MARK_FUNCTION;
+    SERAC_TIME_SCOPE("Functional transposed gradient actions");
 
-    // this is used to mark when operations have been performed,
-    // to avoid doing them more than once
-    bool already_computed[Integral::num_types][num_trial_spaces]{};  // default initializes to `false`
+    P_test_->Mult(input_T, output_L_);
+    input_L_[which] = 0.0;
 
     for (auto& integral : integrals_) {
+      if (integral.functional_to_integral_index_.count(which) == 0) continue;
+
       auto type = integral.type;
+      SLIC_ERROR_ROOT_IF(type == Integral::Type::InteriorFace,
+                         "the transpose of the gradient is not supported for interior face integrals");
 
-      for (auto i : integral.active_trial_spaces_) {
-        if (!already_computed[type][i]) {
-          G_trial_[type][i].Gather(input_L_[i], input_E_[type][i]);
-          already_computed[type][i] = true;
-        }
+      // the element values are only needed for the duration of this call
+      mfem::BlockVector test_E(G_test_[type].bOffsets(), mfem::Device::GetMemoryType());
+      mfem::BlockVector trial_E(G_trial_[type][which].bOffsets(), mfem::Device::GetMemoryType());
+      G_test_[type].Gather(output_L_, test_E);
+
+      if (integral.HasGradientTranspose(which)) {
+        integral.GradientMultTranspose(test_E, trial_E, which);
+      } else {
+        transpose_action_of_element_gradients(integral, which, test_E, trial_E);
       }
 
-      integral.Mult(input_E_[type], output_E_[type], wrt, update_qdata);
+      G_trial_[type][which].ScatterAdd(trial_E, input_L_[which]);
+    }
+
+    output_T.SetSize(trial_space_[which]->GetTrueVSize());
+    P_trial_[which]->MultTranspose(input_L_[which], output_T);
+  }
+
+  /**
+   * @brief evaluate the serac::Functional along with its directional derivatives in several directions, each of which
+   * perturbs one of the arguments (e.g. the sensitivities to several parameter fields), in a single pass over the
+   * elements
+   *
+   * The q-functions of the integrals must be wrapped with `with_directional_derivatives<K>()`, which propagates K of
+   * the directions through each q-function evaluation, instead of differentiating with respect to each argument
+   * and applying the gradient to each direction separately. e.g.
+   *
+   * @code{.cpp}
+   * std::vector<mfem::Vector> dr;
+   * mfem::Vector r = residual.DirectionalDerivatives({1, 2}, {&dp1, &dp2}, dr, u, p1, p2);
+   * // dr[0] is the derivative of r w.r.t. p1 in the direction dp1, and dr[1] w.r.t. p2 in the direction dp2
+   * @endcode
+   *
+   * @param which the index of the argument that each direction perturbs
+   * @param directions the perturbation (T-vector) of that argument, for each direction
+   * @param derivatives the derivatives (T-vectors) of the output in each direction
+   * @param args the input T-vectors
+   * @return the output T-vector
+   *
+   * @note the quadrature point data is not updated, and interior face integrals are not supported
+   */
+  template <typename... T>
+  const mfem::Vector& DirectionalDerivatives(const std::vector<uint32_t>&            which,
+                                             const std::vector<const mfem::Vector*>& directions,
+                                             std::vector<mfem::Vector>& derivatives, const T&... args) const
+  {
+    static_assert(exec == ExecutionSpace::CPU, "directional derivatives are only supported for ExecutionSpace::CPU");
+    static_assert(sizeof...(T) == num_trial_spaces,
+                  "Error: Functional::DirectionalDerivatives() takes one T-vector per trial space");
+    SLIC_ERROR_ROOT_IF(which.size() != directions.size(),
+                       "Functional::DirectionalDerivatives(): need the index of the argument each direction perturbs");
+    SLIC_ERROR_ROOT_IF(uses_interior_faces_,
+                       "Functional::DirectionalDerivatives() does not support interior face integrals");
+
+    const mfem::Vector* input_T[]      = {&static_cast<const mfem::Vector&>(args)...};
+    auto                num_directions = uint32_t(directions.size());
+
+    for (uint32_t i = 0; i < num_trial_spaces; i++) {
+      P_trial_[i]->Mult(*input_T[i], input_L_[i]);
+    }
+
+    block_input_L_.resize(num_directions);
+    block_output_L_.resize(num_directions);
+    for (uint32_t d = 0; d < num_directions; d++) {
+      SLIC_ERROR_ROOT_IF(which[d] >= num_trial_spaces, "Functional::DirectionalDerivatives(): invalid argument index");
+      block_input_L_[d].SetSize(input_L_[which[d]].Size());
+      P_trial_[which[d]]->Mult(*directions[d], block_input_L_[d]);
+      block_output_L_[d].SetSize(output_L_.Size());
+      block_output_L_[d] = 0.0;
+    }
 
-      // scatter-add to compute residuals on the local processor
-      G_test_[type].ScatterAdd(output_E_[type], output_L_);
+    output_L_ = 0.0;
+    for (auto& integral : integrals_) {
+      directional_element_loop(integral, which);
     }
 
-    // scatter-add to compute global residuals
     P_test_->MultTranspose(output_L_, output_T_);
+    derivatives.resize(num_directions);
+    for (uint32_t d = 0; d < num_directions; d++) {
+      derivatives[d].SetSize(output_T_.Size());
+      P_test_->MultTranspose(block_output_L_[d], derivatives[d]);
+    }
+
+    if (constrain_essential_dofs) {
+      output_T_.SetSubVector(essential_true_dofs_, 0.0);
+      for (auto& derivative : derivatives) {
+        derivative.SetSubVector(essential_true_dofs_, 0.0);
+      }
+    }
+
+    return output_T_;
+  }
+
+  /**
+   * @brief this function lets the user evaluate the serac::Functional with the given trial space values
+   *
+   * note: it accepts exactly `num_trial_spaces` arguments of type mfem::Vector. Additionally, one of those
+   * arguments may be a dual_vector, to indicate that Functional::operator() should not only evaluate the
+   * element calculations, but also differentiate them w.r.t. the specified dual_vector argument
+   *
+   * @tparam wrt the indices of the arguments to differentiate w.r.t. (or NO_DIFFERENTIATION). Differentiating w.r.t.
+   * several arguments stores the q-function derivatives w.r.t. each of them in the same pass over the elements, which
+   * is cheaper than a separate evaluation for each argument.
+   * @tparam T the types of the arguments passed in
+   * @param args the trial space dofs used to carry out the calculation,
+   *  any of which may be of the type `differentiate_wrt_this(mfem::Vector)`
+   */
+  template <uint32_t... wrt, typename... T>
+  typename operator_paren_return<wrt...>::type operator()(DifferentiateWRT<wrt...>, const T&... args)
+  {
+    const mfem::Vector* input_T[] = {&static_cast<const mfem::Vector&>(args)...};
 
-    if constexpr (wrt != NO_DIFFERENTIATION) {
+    evaluate({wrt...}, input_T, output_T_);
+
+    if constexpr (!((wrt == NO_DIFFERENTIATION) && ...)) {
       // if the user has indicated they'd like to evaluate and differentiate w.r.t.
-      // a specific argument, then we return both the value and gradient w.r.t. that argument
+      // specific arguments, then we return both the value and gradients w.r.t. those arguments
       //
       // mfem::Vector arg0 = ...;
       // mfem::Vector arg1 = ...;
       // e.g. auto [value, gradient_wrt_arg1] = my_functional(arg0, differentiate_wrt(arg1));
-      return {output_T_, grad_[wrt]};
+      return {output_T_, grad_[wrt]...};
     }
-    if constexpr (wrt == NO_DIFFERENTIATION) {
+    if constexpr (((wrt == NO_DIFFERENTIATION) && ...)) {
       // if the user passes only `mfem::Vector`s then we assume they only want the output value
       //
       // mfem::Vector arg0 = ...;
@@ -462,79 +887,2553 @@ public:
   template <typename... T>
   auto operator()(const T&... args)
   {
-    constexpr int num_differentiated_arguments = (std::is_same_v<T, differentiate_wrt_this> + ...);
-    static_assert(num_differentiated_arguments <= 1,
-                  "Error: Functional::operator() can only differentiate w.r.t. 1 argument a time");
     static_assert(sizeof...(T) == num_trial_spaces,
                   "Error: Functional::operator() must take exactly as many arguments as trial spaces");
 
-    [[maybe_unused]] constexpr uint32_t i = index_of_differentiation<T...>();
+    constexpr auto indices = indices_of_differentiation<T...>();
+    if constexpr (indices.size() == 0) {
+      return (*this)(DifferentiateWRT<NO_DIFFERENTIATION>{}, args...);
+    } else {
+      return differentiate_wrt_each(std::make_index_sequence<indices.size()>{}, args...);
+    }
+  }
+
+  /**
+   * @brief evaluate this Functional directly into a caller-provided vector
+   *
+   * This is operator() without differentiation, except that the residual is prolongated straight into `output_T`,
+   * rather than into this Functional's output vector (which operator() returns a reference to), so callers
+   * filling in their own storage (e.g. the residual of an mfem::Operator) don't need to copy it.
+   *
+   * @param output_T the T-vector where the resulting values are stored (resized to the test space, if needed)
+   * @param args the trial space dofs used to carry out the calculation
+   */
+  template <typename... T>
+  void Mult(mfem::Vector& output_T, const T&... args)
+  {
+    static_assert(sizeof...(T) == num_trial_spaces,
+                  "Error: Functional::Mult() must take exactly as many arguments as trial spaces");
+    static_assert(indices_of_differentiation<T...>().size() == 0,
+                  "Error: Functional::Mult() doesn't differentiate, use operator() instead");
+
+    const mfem::Vector* input_T[] = {&static_cast<const mfem::Vector&>(args)...};
 
-    return (*this)(DifferentiateWRT<i>{}, args...);
+    output_T.SetSize(test_space_->GetTrueVSize());
+    evaluate({NO_DIFFERENTIATION}, input_T, output_T);
   }
 
-  // TODO: expose this feature a better way
-  /// @brief flag for denoting when a residual evaluation should update the material state buffers
-  bool update_qdata;
+  /**
+   * @brief the buffers that one evaluation through Functional::Evaluate() works in
+   *
+   * Each thread evaluating a Functional concurrently needs its own Workspace. They are sized by the first
+   * evaluation that uses them, and reused (without allocating) by the later ones.
+   */
+  struct Workspace {
+    mfem::Vector        input_L[num_trial_spaces];      ///< the local values of each argument
+    mfem::Vector        output_L;                       ///< the local values of the residual
+    std::vector<double> batch_input[num_trial_spaces];  ///< the gathered inputs of a batch of elements
+    std::vector<double> batch_output;                   ///< the outputs of a batch of elements
+  };
 
-private:
   /**
-   * @brief mfem::Operator representing the gradient matrix that
-   * can compute the action of the gradient (with operator()),
-   * or assemble the sparse matrix representation through implicit conversion to mfem::HypreParMatrix *
+   * @brief evaluate this Functional into a caller-provided vector, using caller-provided work buffers
+   *
+   * Unlike operator(), which works in (and returns a reference to) buffers owned by this Functional, this doesn't
+   * modify the Functional, so several threads may evaluate it at the same time, each with its own Workspace: e.g.
+   * the residuals for two sets of parameters. Writing into `output_T` directly also avoids copying the result into
+   * the solver's vector.
+   *
+   * @param workspace the buffers to work in, not used by any other evaluation at the same time
+   * @param output_T the T-vector where the resulting values are stored
+   * @param args the trial space dofs used to carry out the calculation
+   *
+   * @note this evaluates the residual only: it neither differentiates it, nor updates the quadrature data, nor
+   * reuses the values of a cached argument (see SetCachedArgument()), and doesn't support interior face integrals.
+   * The (parallel) prolongations of the arguments and of the residual are done one evaluation at a time, so
+   * evaluating concurrently on several ranks requires MPI to be initialized with (at least) MPI_THREAD_SERIALIZED.
    */
-  class Gradient : public mfem::Operator {
-  public:
-    /**
-     * @brief Constructs a Gradient wrapper that references a parent @p Functional
+  template <typename... T>
+  void Evaluate(Workspace& workspace, mfem::Vector& output_T, const T&... args) const
+  {
+    static_assert(exec == ExecutionSpace::CPU, "Functional::Evaluate() is only supported for ExecutionSpace::CPU");
+    static_assert(sizeof...(T) == num_trial_spaces,
+                  "Error: Functional::Evaluate() must take exactly as many arguments as trial spaces");
+    SLIC_ERROR_ROOT_IF(uses_interior_faces_, "Functional::Evaluate() does not support interior face integrals");
+    SLIC_ERROR_ROOT_IF(cached_argument_ != NO_CACHED_ARGUMENT,
+                       "Functional::Evaluate() does not support cached arguments, see SetCachedArgument()");
+    SLIC_ERROR_ROOT_IF(!quadrature_point_arguments_.empty(),
+                       "Functional::Evaluate() does not support quadrature point arguments, see "
+                       "SetQuadraturePointArgument()");
+
+    const mfem::Vector* input_T[] = {&static_cast<const mfem::Vector&>(args)...};
+
+    {
+      std::lock_guard<std::mutex> lock(prolongation_mutex_);
+      for (uint32_t i = 0; i < num_trial_spaces; i++) {
+        workspace.input_L[i].SetSize(P_trial_[i]->Height());
+        P_trial_[i]->Mult(*input_T[i], workspace.input_L[i]);
+      }
+    }
+
+    workspace.output_L.SetSize(P_test_->Height());
+    workspace.output_L = 0.0;
+    double* output_L   = workspace.output_L.HostReadWrite();
+
+    for (const auto& integral : integrals_) {
+      auto        type         = integral.type;
+      const auto& trial_spaces = integral.active_trial_spaces_;
+
+      std::vector<const double*> inputs(trial_spaces.size());
+      for (auto& [geom, test_restriction] : G_test_[type].restrictions) {
+        uint32_t num_elements = integral.NumMeshElements(geom);
+        if (integral.NumElements(geom) == 0) continue;
+
+        uint32_t batch_size = std::min(element_batch_size_, num_elements);
+        for (std::size_t i = 0; i < trial_spaces.size(); i++) {
+          const auto& trial_restriction = G_trial_[type][trial_spaces[i]].restrictions.at(geom);
+          workspace.batch_input[i].resize(batch_size * trial_restriction.ValuesPerElement());
+          inputs[i] = workspace.batch_input[i].data();
+        }
+        workspace.batch_output.resize(batch_size * test_restriction.ValuesPerElement());
+
+        auto evaluate_run = [&, geom = geom, &test_restriction = test_restriction](uint32_t begin, uint32_t end) {
+          for (uint32_t first_element = begin; first_element < end; first_element += batch_size) {
+            uint32_t count = std::min(batch_size, end - first_element);
+            for (std::size_t i = 0; i < trial_spaces.size(); i++) {
+              const auto& trial_restriction = G_trial_[type][trial_spaces[i]].restrictions.at(geom);
+              trial_restriction.Gather(workspace.input_L[trial_spaces[i]].HostRead(),
+                                       workspace.batch_input[i].data(), first_element, count);
+            }
+
+            std::fill(workspace.batch_output.begin(), workspace.batch_output.end(), 0.0);
+            integral.Mult(geom, inputs, workspace.batch_output.data(), first_element, count, NO_DIFFERENTIATION,
+                          false);
+            test_restriction.ScatterAdd(workspace.batch_output.data(), output_L, first_element, count);
+          }
+        };
+        integral.ForEachElementRun(geom, 0, num_elements, evaluate_run);
+      }
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(prolongation_mutex_);
+      output_T.SetSize(P_test_->Width());
+      P_test_->MultTranspose(workspace.output_L, output_T);
+    }
+
+    if (constrain_essential_dofs) {
+      output_T.SetSubVector(essential_true_dofs_, 0.0);
+    }
+  }
+
+  /**
+   * @brief rebuild the element restrictions, geometric factors and integrals after the mesh (and with it the test
+   * and trial spaces) changed, e.g. through adaptive refinement
+   *
+   * The integrals are built again from the q-functions, domains and quadrature data they were added with, so only
+   * the mesh-dependent parts of this Functional are recomputed.
+   *
+   * @pre the spaces have been updated to the current mesh (e.g. by FiniteElementState::updateSpace()), and the
+   * quadrature data buffers of the domain integrals remapped to its elements (see QuadratureData::remap())
+   * @note the constrained dofs refer to the previous mesh, so they are cleared (see SetEssentialTrueDofs())
+   */
+  void Update()
+  {
+    integrals_.clear();
+    grad_.clear();
+    cached_argument_T_.Destroy();
+    ClearMemoization();
+    incremental_outputs_.clear();
+    essential_true_dofs_.DeleteAll();
+    essential_local_dofs_.clear();
+    essential_dofs_version_++;
+
+    for (auto type : Integral::Types) {
+      G_test_[type] = BlockElementRestriction{};
+      for (uint32_t i = 0; i < num_trial_spaces; i++) {
+        G_trial_[type][i] = BlockElementRestriction{};
+      }
+    }
+    uses_interior_faces_ = false;
+    for (uint32_t i = 0; i < num_trial_spaces; i++) {
+      uses_face_nbr_values_[i] = false;
+    }
+
+    initialize_spaces();
+    for (auto& build_integral : integral_builders_) {
+      build_integral();
+    }
+
+    for (uint32_t i = 0; i < num_trial_spaces; i++) {
+      grad_.emplace_back(*this, i);
+    }
+  }
+
+  /**
+   * @brief store the inverse and determinant of the jacobian at each quadrature point of the domain integrals'
+   * elements, instead of computing them in every evaluation
+   *
+   * Each residual evaluation (and each evaluation that computes derivatives) maps the values of the trial spaces
+   * from the parent element to the physical one, and the q-function outputs back, at every quadrature point, which
+   * inverts the jacobian there. Precomputing these adds (dim * dim + 1) values per quadrature point to the geometric
+   * factors, which pays off in evaluations that are compute-bound, e.g. high order elements with inexpensive
+   * q-functions. Affine elements (see GeometricFactors::affine) already store one inverse per element.
+   *
+   * @param enabled whether to precompute the inverse jacobians (off by default)
+   * @pre this is called before the domain integrals are added
+   */
+  void SetPrecomputedInverseJacobians(bool enabled)
+  {
+    SLIC_ERROR_ROOT_IF(!integrals_.empty(), "SetPrecomputedInverseJacobians() must be called before adding integrals");
+    precompute_inverse_jacobians_ = enabled;
+  }
+
+  /**
+   * @brief set how many elements are processed at a time when evaluating this Functional (or its gradients' action)
+   *
+   * On the CPU, the element calculations are fused with the gather and scatter-add operations: the inputs for a
+   * batch of elements are gathered from the local (L-vector) values, the batch is evaluated, and its outputs are
+   * immediately scatter-added into the local output values. Batches small enough to stay in cache reduce the
+   * memory traffic, and peak memory usage, compared to gathering every element up front.
+   *
+   * On the GPU, the elements are evaluated all at once by default, through E-vectors holding the inputs and outputs
+   * of every element in the mesh. Setting a batch size there instead evaluates the elements in batches of (at most)
+   * `num_elements`, gathered into (and scatter-added from) buffers reused by every batch, and releases the E-vectors:
+   * this bounds the working set of the element calculations, for meshes whose E-vectors don't fit in device memory,
+   * at the cost of launching the kernels once per batch.
+   *
+   * @param num_elements the (positive) maximum number of elements per batch
+   */
+  void SetElementBatchSize(uint32_t num_elements)
+  {
+    SLIC_ERROR_ROOT_IF(num_elements == 0, "element batch size must be positive");
+    element_batch_size_ = num_elements;
+
+    // an explicit batch size replaces the tuned ones (see Autotune())
+    for (auto& integral : integrals_) {
+      integral.batch_sizes_.clear();
+    }
+
+    if constexpr (exec != ExecutionSpace::CPU) {
+      if (!batched_device_evaluation_) {
+        batched_device_evaluation_ = true;
+        allocate_element_vectors();
+      }
+    }
+  }
+
+  /**
+   * @brief launch the element kernels of each evaluation on the GPU (and of each action of its gradients) as a single
+   * CUDA graph, captured the first time each kind of evaluation runs (see accelerator::KernelGraph)
+   *
+   * Every evaluation on the GPU launches the same sequence of kernels, one per integral and element geometry, on
+   * arrays of the same sizes, so on small to medium meshes per GPU the launch latency dominates the time spent in
+   * the kernels. With graphs, the E-vectors of every integral are gathered before the first kernel and scatter-added
+   * after the last one, and the kernels in between are replayed as a whole.
+   *
+   * @param enabled whether to use graphs (off by default)
+   * @note this only affects ExecutionSpace::GPU when the elements aren't evaluated in batches (see
+   * SetElementBatchSize()). Graphs are captured again after integrals are added, or Update() is called.
+   */
+  void SetKernelGraphs(bool enabled)
+  {
+    use_kernel_graphs_ = (exec == ExecutionSpace::GPU) && enabled;
+    kernel_graphs_.clear();
+  }
+
+  /**
+   * @brief choose the number of elements per batch (see SetElementBatchSize()) of the evaluation kernel of each domain
+   * and boundary integral and element geometry on the CPU by timing candidates, or reuse the ones chosen in an
+   * earlier run on the same hardware and build (see autotuning::lookup())
+   *
+   * The fastest batch size depends on how the inputs, outputs and temporaries of a batch (i.e. the order of the
+   * spaces and the quadrature rule) and the work done by the q-function compare to the caches of the hardware. Each
+   * kernel is evaluated on all of the elements (without derivatives, or updating the quadrature data) once per
+   * candidate and repetition (see autotuning::Options), the candidate with the lowest total time over the ranks is
+   * kept, and recorded in the tuning cache so that later runs don't time it again.
+   *
+   * @note this is collective over the ranks of the mesh, and is called by the physics modules in completeSetup()
+   * when enabled (see autotuning::configure()). It does nothing in the other execution spaces, whose kernels
+   * evaluate all of the elements at once.
+   */
+  void Autotune()
+  {
+    if constexpr (exec == ExecutionSpace::CPU) {
+      SERAC_PROFILE_SCOPE("Functional::Autotune");
+
+      constexpr uint32_t candidates[]   = {8, 16, 32, 64, 128, 256, 512, 1024};
+      constexpr int      num_candidates = static_cast<int>(std::size(candidates));
+      const int          repetitions    = autotuning::options().repetitions;
+      MPI_Comm           comm           = test_space_->GetComm();
+
+      // the values of the inputs don't change the cost of most q-functions, and those of the L-vectors are
+      // overwritten by every evaluation
+      for (uint32_t i = 0; i < num_trial_spaces; i++) {
+        input_L_[i] = 0.0;
+      }
+
+      for (auto& integral : integrals_) {
+        for (auto& [geom, name] : integral.kernel_names_) {
+          if (auto tuned = autotuning::lookup(name)) {
+            integral.batch_sizes_[geom] = *tuned;
+            continue;
+          }
+
+          ElementRanges       all_elements{{geom, {{0, integral.NumMeshElements(geom)}}}};
+          std::vector<double> times(static_cast<std::size_t>(num_candidates));
+          for (int c = 0; c < num_candidates; c++) {
+            integral.batch_sizes_[geom] = candidates[c];
+            double fastest              = std::numeric_limits<double>::max();
+            for (int r = 0; r < repetitions; r++) {
+              auto start = std::chrono::steady_clock::now();
+              batched_element_loop(integral, integral.active_trial_spaces_, all_elements,
+                                   [&](mfem::Geometry::Type g, const std::vector<const double*>& inputs,
+                                       double* outputs, uint32_t first_element, uint32_t num_elements) {
+                                     integral.Mult(g, inputs, outputs, first_element, num_elements,
+                                                   NO_DIFFERENTIATION, false);
+                                   });
+              std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+              fastest                               = std::min(fastest, elapsed.count());
+            }
+            times[static_cast<std::size_t>(c)] = fastest;
+          }
+
+          // every rank uses the same batch sizes, which balances the time of the whole evaluation
+          MPI_Allreduce(MPI_IN_PLACE, times.data(), num_candidates, MPI_DOUBLE, MPI_SUM, comm);
+          auto best = std::min_element(times.begin(), times.end()) - times.begin();
+
+          integral.batch_sizes_[geom] = candidates[best];
+          autotuning::store(name, candidates[best], comm);
+        }
+      }
+
+      output_L_ = 0.0;
+    }
+  }
+
+  /**
+   * @brief launch the element kernels of the integrals on the GPU (domain, boundary and interior face integrals, and
+   * each element geometry of a mixed mesh) concurrently, on separate streams, instead of one after another
+   *
+   * The kernels of small geometry blocks, or of boundary integrals, don't occupy the whole GPU, and otherwise
+   * serialize with the larger ones. With concurrent integrals, the E-vectors of every integral are gathered before
+   * the first kernel and scatter-added after the last one, i.e. the outputs are reduced into a single L-vector once.
+   *
+   * @param enabled whether to launch the integrals concurrently (off by default)
+   * @note this only affects ExecutionSpace::GPU when the elements aren't evaluated in batches (see
+   * SetElementBatchSize()), and can be combined with SetKernelGraphs(), whose graphs then fork and join the streams
+   */
+  void SetConcurrentIntegrals(bool enabled)
+  {
+    concurrent_integrals_ = (exec == ExecutionSpace::GPU) && enabled;
+    kernel_graphs_.clear();
+  }
+
+  /**
+   * @brief assemble the gradients w.r.t. one of the arguments as symmetric matrices
+   *
+   * When the argument is on the test space and each q-function's tangent is symmetric (e.g. hyperelasticity, or
+   * linear conduction), so are the element matrices of the gradient. In that case, only the upper triangle of each
+   * domain element matrix is computed and stored, and assembly adds each of its entries to both halves of the sparse
+   * matrix, which roughly halves the memory of the element matrices, and the traffic of assembly. Integrals without
+   * a symmetric kernel (e.g. boundary integrals) still compute their whole element matrices, of which only the upper
+   * triangles are kept. See also Gradient::local_upper_triangle().
+   *
+   * @param argument the index of the argument
+   * @param enabled whether its gradients are symmetric (off by default)
+   * @note this assumes, rather than checks, that the tangents of the q-functions are symmetric, and only affects
+   * assembly in ExecutionSpace::CPU
+   */
+  void SetSymmetricGradient(uint32_t argument, bool enabled = true)
+  {
+    SLIC_ERROR_ROOT_IF(argument >= num_trial_spaces, "invalid argument index for SetSymmetricGradient()");
+    SLIC_ERROR_ROOT_IF(enabled && trial_space_[argument] != test_space_,
+                       "symmetric gradients require the argument to be on the test space");
+    symmetric_gradient_[argument] = enabled;
+  }
+
+  /**
+   * @brief reuse the values (and derivatives) of one of the arguments at each quadrature point, across evaluations
+   * in which that argument doesn't change
+   *
+   * Some arguments change far less often than the others: e.g. in shape optimization, the shape displacement only
+   * changes once per design iteration, while the nonlinear solver evaluates the residual (and its gradient) many times
+   * per iteration. For such an argument, each evaluation compares it to its value in the previous evaluation, and only
+   * interpolates it to the quadrature points again if it has changed (on any rank) in the meantime.
+   *
+   * @param argument the index of the argument to reuse, or NO_CACHED_ARGUMENT to interpolate every argument in each
+   * evaluation (the default)
+   *
+   * @note this stores the values of that argument at every quadrature point of each integral that depends on it,
+   * and only affects evaluations in ExecutionSpace::CPU
+   */
+  void SetCachedArgument(uint32_t argument)
+  {
+    SLIC_ERROR_ROOT_IF(argument >= num_trial_spaces && argument != NO_CACHED_ARGUMENT,
+                       "invalid argument index for SetCachedArgument()");
+    cached_argument_ = argument;
+    cached_argument_T_.Destroy();
+  }
+
+  /**
+   * @brief pass the values of one of the arguments at each quadrature point to the q-functions directly, rather than
+   * interpolating them from its dofs
+   *
+   * Some parameters are only known at quadrature points, e.g. those coming from an upstream process simulation.
+   * Instead of projecting them onto the argument's finite element space (and interpolating that back to the
+   * quadrature points in every evaluation), the domain integrals that depend on the argument read its values from
+   * `values`, with a zero gradient. The dofs of the argument itself are then ignored.
+   *
+   * @param argument the index of the argument
+   * @param values the values at each quadrature point, in the layout of the quadrature point data of each integral
+   * that depends on the argument (see createQuadratureDataBuffer()), of type quadrature_point_value_t of its space,
+   * or nullptr to interpolate the argument again
+   *
+   * @note evaluations read `values` each time, but a change of its contents alone doesn't invalidate a memoized
+   * evaluation (see ClearMemoization()). These arguments can't be differentiated with respect to, or be used by
+   * boundary integrals, q-functions that recompute their derivatives or directional derivatives, or
+   * Functional::Evaluate(), and only affect evaluations in ExecutionSpace::CPU
+   */
+  template <typename T>
+  void SetQuadraturePointArgument(uint32_t argument, std::shared_ptr<QuadratureData<T>> values)
+  {
+    SLIC_ERROR_ROOT_IF(argument >= num_trial_spaces, "invalid argument index for SetQuadraturePointArgument()");
+
+    if (!values) {
+      quadrature_point_arguments_.erase(argument);
+      return;
+    }
+
+    for_constexpr<num_trial_spaces>([&](auto i) {
+      using space = decltype(serac::type<i>(trial_spaces));
+      if (uint32_t(int(i)) != argument) return;
+      SLIC_ERROR_ROOT_IF(space::family != Family::H1 && space::family != Family::L2,
+                         "SetQuadraturePointArgument() only supports H1 and L2 arguments");
+      SLIC_ERROR_ROOT_IF((!std::is_same_v<T, quadrature_point_value_t<space>>),
+                         "the quadrature point values don't match the type of the argument's values");
+    });
+
+    quadrature_point_arguments_[argument] = SuppliedValues{values, values->size / values->stride, values->stride};
+    memoized_.valid                       = false;
+    cached_gradient_.valid                = false;
+  }
+
+  /**
+   * @brief evaluate the derivatives w.r.t. one of the arguments along with every residual, so that a derivative
+   * request at the arguments of the previous evaluation reuses it
+   *
+   * A Newton iteration evaluates the residual at a point, and then its gradient at the same point: two passes over
+   * the elements, the second of which recomputes the values of the first (with dual numbers). With memoization, each
+   * residual evaluation also stores the q-function derivatives w.r.t. `argument` (so costs about as much as the
+   * gradient evaluation), and an evaluation (of the residual, or differentiating w.r.t. `argument` only) at the same
+   * arguments as the previous one returns its value and gradient without another pass. Each evaluation compares its
+   * arguments to those of the previous one, on every rank.
+   *
+   * @param argument the index of the argument to differentiate w.r.t., or NO_DIFFERENTIATION to disable
+   * memoization (the default)
+   *
+   * @note the memoized evaluation is only reused while nothing else it depends on changes: the arguments aren't the
+   * only inputs of the q-functions, which may e.g. capture the time, or read the quadrature data. Call
+   * ClearMemoization() when those change, e.g. before each nonlinear solve. An evaluation that updates the
+   * quadrature data (see `update_qdata`) doesn't reuse one that didn't. Memoization stores a copy of each argument.
+   */
+  void SetMemoization(uint32_t argument)
+  {
+    SLIC_ERROR_ROOT_IF(argument >= num_trial_spaces && argument != NO_DIFFERENTIATION,
+                       "invalid argument index for SetMemoization()");
+    memoized_argument_ = argument;
+    ClearMemoization();
+  }
+
+  /**
+   * @brief keep the derivatives w.r.t. one of the arguments of the last evaluation that computed them, so that an
+   * evaluation differentiating w.r.t. that argument at the same arguments reuses them
+   *
+   * Unlike SetMemoization(), this doesn't make residual evaluations any more expensive: it is meant for derivatives
+   * that are needed far less often than the residual, but repeatedly at the same point, e.g. the shape derivative of
+   * the residual in shape optimization, which is applied to the adjoint of each quantity of interest at the same
+   * state (and at the same shape, when only the other parameters of the design changed). Each evaluation
+   * differentiating w.r.t. `argument` alone compares its arguments to those the stored derivatives were computed at,
+   * on every rank, so setting an argument to the values it already had doesn't invalidate them.
+   *
+   * @param argument the index of the argument, or NO_DIFFERENTIATION to disable this (the default)
+   *
+   * @note the same caveats as for memoization apply (see SetMemoization()), and ClearMemoization() also forgets
+   * these derivatives. An evaluation that updates the quadrature data without computing them does too. This stores
+   * a copy of each argument.
+   */
+  void SetGradientCaching(uint32_t argument)
+  {
+    SLIC_ERROR_ROOT_IF(argument >= num_trial_spaces && argument != NO_DIFFERENTIATION,
+                       "invalid argument index for SetGradientCaching()");
+    cached_gradient_argument_ = argument;
+    cached_gradient_.clear();
+  }
+
+  /**
+   * @brief forget the memoized evaluation (see SetMemoization()) and the cached derivatives (see
+   * SetGradientCaching()), so that the next evaluations compute them again
+   */
+  void ClearMemoization()
+  {
+    memoized_.clear();
+    cached_gradient_.clear();
+  }
+
+  /**
+   * @brief only re-evaluate the elements whose inputs changed since the previous evaluation
+   *
+   * In problems with localized changes, e.g. contact or localized plasticity, most elements' inputs barely change
+   * between Newton iterations. In incremental mode, each element's contribution to the residual is stored, and an
+   * evaluation only recomputes the elements with a local dof (of any argument) that changed by more than `tolerance`
+   * since it was last used: their new contributions replace the stored ones in the local residual, and the other
+   * elements keep theirs. Every element is evaluated in the first incremental evaluation, and whenever the arguments
+   * to differentiate w.r.t. change.
+   *
+   * @param enabled whether to evaluate incrementally
+   * @param tolerance how much a dof's value may change before the elements using it are evaluated again. With a
+   * tolerance of zero, the residual only differs from a full evaluation by roundoff; otherwise each element's
+   * contribution is evaluated with inputs within `2 * tolerance` of the current ones.
+   *
+   * @note evaluations that update the quadrature data (see `update_qdata`) evaluate every element, as do Functionals
+   * with interior face integrals. Incremental mode stores the outputs of every element, and only affects
+   * evaluations in ExecutionSpace::CPU.
+   */
+  void SetIncrementalEvaluation(bool enabled, double tolerance = 0.0)
+  {
+    SLIC_ERROR_ROOT_IF(tolerance < 0.0, "incremental evaluation tolerance must be non-negative");
+    incremental_evaluation_ = (exec == ExecutionSpace::CPU) && enabled;
+    incremental_tolerance_  = tolerance;
+    incremental_outputs_.clear();
+    incremental_memory_.set(0);
+  }
+
+  /**
+   * @brief set the true dofs of the test space that are constrained by essential boundary conditions
+   *
+   * While `constrain_essential_dofs` is set, the constrained entries of the output of operator() are zeroed, and the
+   * gradients are assembled as the constrained system: the constrained rows are zeroed, as are the constrained
+   * columns of gradients w.r.t. an argument on the test space, which get a unit diagonal instead. This is done while
+   * the element matrices are summed into the rank-local sparse matrix, so the assembled matrix doesn't need a
+   * separate elimination (e.g. mfem::HypreParMatrix::EliminateBC()) afterwards.
+   *
+   * @param true_dofs the (rank-local) indices of the constrained true dofs
+   *
+   * @note this is collective, but cheap when the constrained dofs haven't changed since the previous call, so it can
+   * be called before every evaluation. The action of the gradients (e.g. Gradient::Mult()) is not affected, as
+   * with matrix-free solvers the constraints are usually applied by an mfem::ConstrainedOperator instead.
+   */
+  void SetEssentialTrueDofs(const mfem::Array<int>& true_dofs)
+  {
+    int changed = (true_dofs.Size() != essential_true_dofs_.Size()) ||
+                  !std::equal(true_dofs.begin(), true_dofs.end(), essential_true_dofs_.begin());
+    MPI_Allreduce(MPI_IN_PLACE, &changed, 1, MPI_INT, MPI_LOR, test_space_->GetComm());
+    if (!changed) return;
+
+    essential_true_dofs_ = true_dofs;
+    essential_dofs_version_++;
+
+    // a local dof is constrained if it is (a copy of) a constrained true dof, possibly owned by another rank
+    mfem::Vector marker_T(test_space_->GetTrueVSize());
+    mfem::Vector marker_L(P_test_->Height());
+    marker_T = 0.0;
+    for (int dof : essential_true_dofs_) {
+      marker_T(dof) = 1.0;
+    }
+    P_test_->Mult(marker_T, marker_L);
+
+    const double* marker = marker_L.HostRead();
+    essential_local_dofs_.assign(std::size_t(marker_L.Size()), false);
+    for (int i = 0; i < marker_L.Size(); i++) {
+      essential_local_dofs_[std::size_t(i)] = (marker[i] != 0.0);
+    }
+  }
+
+  /**
+   * @brief estimate the memory (on this rank) that assembling the gradient with respect to one of the arguments
+   * allocates, before it is first assembled: the element matrices, the assembly lookup tables and the sparse matrix
+   *
+   * @param which the index of the argument
+   * @note the number of nonzeros of the sparse matrix is bounded by the number of entries of the element matrices,
+   * and the matrix is held three times while it is formed (the rank-local matrix, its parallel version and the
+   * product with the prolongations), so this is an upper bound
+   */
+  std::size_t EstimatedAssemblyMemory(uint32_t which) const
+  {
+    bool types_used[Integral::num_types] = {};
+    for (const auto& integral : integrals_) {
+      if (integral.functional_to_integral_index_.count(which) > 0) {
+        types_used[integral.type] = true;
+      }
+    }
+
+    std::size_t entries = 0;
+    for (auto type : Integral::Types) {
+      if (!types_used[type]) continue;
+      const auto& trial_restrictions = G_trial_[type][which].restrictions;
+      for (const auto& [geom, test_restriction] : G_test_[type].restrictions) {
+        auto trial_restriction = trial_restrictions.find(geom);
+        if (trial_restriction == trial_restrictions.end()) continue;
+        entries += std::size_t(test_restriction.num_elements * test_restriction.ValuesPerElement() *
+                               trial_restriction->second.ValuesPerElement());
+      }
+    }
+
+    return entries * (sizeof(double) + sizeof(SignedIndex) + 3 * (sizeof(double) + sizeof(int)));
+  }
+
+  // TODO: expose this feature a better way
+  /// @brief flag for denoting when a residual evaluation should update the material state buffers
+  bool update_qdata;
+
+  /// @brief flag for denoting when the outputs and gradients should be constrained, see SetEssentialTrueDofs()
+  bool constrain_essential_dofs = false;
+
+private:
+  /// @brief an evaluation, with what it was evaluated at, see SetMemoization() and SetGradientCaching()
+  struct StoredEvaluation {
+    bool         valid = false;                  ///< whether the evaluation can be reused
+    mfem::Vector arguments_T[num_trial_spaces];  ///< the arguments of the evaluation
+    mfem::Vector value_T;                        ///< the value of the evaluation
+    bool         update_qdata   = false;         ///< whether the evaluation updated the quadrature data
+    bool         constrained    = false;         ///< whether the output of the evaluation was constrained
+    std::size_t  essential_dofs = 0;             ///< the essential_dofs_version_ of the evaluation
+
+    /// @brief stores an evaluation at the given arguments, with the given settings
+    void store(const mfem::Vector* const* input_T, const mfem::Vector& output_T, bool updated_qdata,
+               bool constrained_output, std::size_t essential_dofs_version)
+    {
+      for (uint32_t i = 0; i < num_trial_spaces; i++) {
+        arguments_T[i] = *input_T[i];
+      }
+      value_T        = output_T;
+      update_qdata   = updated_qdata;
+      constrained    = constrained_output;
+      essential_dofs = essential_dofs_version;
+      valid          = true;
+    }
+
+    /// @brief forgets the evaluation, and releases the memory of its copies
+    void clear()
+    {
+      valid = false;
+      for (auto& argument : arguments_T) {
+        argument.Destroy();
+      }
+      value_T.Destroy();
+    }
+  };
+
+  /// @brief the index of the hot-path counter of the evaluation kernels of the integrals of a type
+  static int kernel_counter(Integral::Type type)
+  {
+    static const auto ids = [] {
+      std::array<int, Integral::num_types> result{};
+      for (auto t : Integral::Types) {
+        result[t] = profiling::counterId(profiling::concat("Functional kernels (", Integral::TypeNames[t], ")"));
+      }
+      return result;
+    }();
+    return ids[type];
+  }
+
+  /**
+   * @brief create the element restrictions, prolongations and storage of the test and trial spaces, for their
+   * current sizes (see the constructor and Update())
+   */
+  void initialize_spaces()
+  {
+    auto mem_type = mfem::Device::GetMemoryType();
+
+    for (auto type : Integral::Types) {
+      input_E_[type].resize(num_trial_spaces);
+    }
+
+    for (uint32_t i = 0; i < num_trial_spaces; i++) {
+      P_trial_[i] = trial_space_[i]->GetProlongationMatrix();
+
+      input_L_[i].SetSize(P_trial_[i]->Height(), mfem::Device::GetMemoryType());
+
+      // L->E
+      for (auto type : {Integral::Type::Domain, Integral::Type::Boundary}) {
+        if (type == Integral::Type::Domain) {
+          G_trial_[type][i] = BlockElementRestriction(trial_space_[i]);
+        } else {
+          G_trial_[type][i] = BlockElementRestriction(trial_space_[i], FaceType::BOUNDARY);
+        }
+
+      }
+    }
+
+    for (auto type : {Integral::Type::Domain, Integral::Type::Boundary}) {
+      if (type == Integral::Type::Domain) {
+        G_test_[type] = BlockElementRestriction(test_space_);
+      } else {
+        G_test_[type] = BlockElementRestriction(test_space_, FaceType::BOUNDARY);
+      }
+    }
+
+    P_test_ = test_space_->GetProlongationMatrix();
+
+    output_L_.SetSize(P_test_->Height(), mem_type);
+
+    output_T_.SetSize(test_space_->GetTrueVSize(), mem_type);
+
+    allocate_element_vectors();
+
+    if constexpr (exec == ExecutionSpace::CPU) {
+      for (uint32_t i = 0; i < num_trial_spaces; i++) {
+        trial_prolongation_[i] = OverlappedProlongation(trial_space_[i]);
+
+        // only one exchange per communicator can be in progress at a time, so trial spaces that share
+        // a communicator with an earlier trial space are prolonged before the others begin
+        overlap_trial_prolongation_[i] = true;
+        for (uint32_t j = 0; j < i; j++) {
+          if (trial_prolongation_[i].Communicator() == trial_prolongation_[j].Communicator()) {
+            overlap_trial_prolongation_[i] = false;
+          }
+        }
+      }
+
+      test_prolongation_ = OverlappedProlongation(test_space_);
+
+      partition_elements();
+    }
+  }
+
+  /**
+   * @brief (re)allocate the E-vectors of the test and trial spaces, if this Functional's element calculations use
+   * them, and account for the memory of the work vectors
+   *
+   * E-vectors are only needed when the element calculations are not fused with the gather / scatter-add
+   * operations, i.e. on the GPU, unless a batch size was set (see batched_element_loop(), SetElementBatchSize())
+   */
+  void allocate_element_vectors()
+  {
+    auto mem_type = mfem::Device::GetMemoryType();
+
+    // the captured kernel sequences refer to the previous E-vectors
+    kernel_graphs_.clear();
+
+    bool use_E_vectors = (exec != ExecutionSpace::CPU) && !batched_device_evaluation_;
+    for (auto type : {Integral::Type::Domain, Integral::Type::Boundary}) {
+      // note: we have to use "Update" here, as mfem::BlockVector's
+      // copy assignment ctor (operator=) doesn't let you make changes
+      // to the block size
+      for (uint32_t i = 0; i < num_trial_spaces; i++) {
+        if (use_E_vectors && G_trial_[type][i].identity) {
+          // the E-vector of a restriction that is the identity is the L-vector itself, so nothing is gathered
+          input_E_[type][i].Update(input_L_[i], G_trial_[type][i].bOffsets());
+        } else if (use_E_vectors) {
+          input_E_[type][i].Update(G_trial_[type][i].bOffsets(), mem_type);
+        } else {
+          input_E_[type][i].Destroy();
+        }
+      }
+
+      if (use_E_vectors) {
+        output_E_[type].Update(G_test_[type].bOffsets(), mem_type);
+      } else {
+        output_E_[type].Destroy();
+      }
+    }
+
+    std::size_t work_vector_size = std::size_t(output_L_.Size() + output_T_.Size());
+    for (auto type : Integral::Types) {
+      work_vector_size += std::size_t(output_E_[type].Size());
+      for (uint32_t i = 0; i < input_E_[type].size(); i++) {
+        if (input_E_[type][i].GetData() != input_L_[i].GetData()) {
+          work_vector_size += std::size_t(input_E_[type][i].Size());
+        }
+      }
+    }
+    for (uint32_t i = 0; i < num_trial_spaces; i++) {
+      work_vector_size += std::size_t(input_L_[i].Size());
+    }
+    work_vector_memory_.set(sizeof(double) * work_vector_size);
+  }
+
+  /**
+   * @brief apply the transposes of the element matrices of an integral (w.r.t. trial space `which`), for integrals
+   * whose q-function derivatives aren't stored, see ActionOfGradientTranspose()
+   *
+   * @param integral the integral
+   * @param which the (Functional) index of the trial space
+   * @param test_E the test space values of each element
+   * @param trial_E the resulting trial space values of each element
+   */
+  void transpose_action_of_element_gradients(const Integral& integral, uint32_t which, const mfem::BlockVector& test_E,
+                                             mfem::BlockVector& trial_E) const
+  {
+    auto& test_restrictions  = G_test_[integral.type].restrictions;
+    auto& trial_restrictions = G_trial_[integral.type][which].restrictions;
+
+    std::map<mfem::Geometry::Type, ExecArray<double, 3, exec>> K_elem;
+    for (auto& [geom, test_restriction] : test_restrictions) {
+      K_elem[geom] = accelerator::make_array<double, 3, exec>(test_restriction.num_elements,
+                                                              trial_restrictions.at(geom).ValuesPerElement(),
+                                                              test_restriction.ValuesPerElement());
+      detail::zero_out(K_elem[geom]);
+    }
+    integral.ComputeElementGradients(K_elem, which);
+    if constexpr (exec == ExecutionSpace::Dynamic) {
+      // the element matrices of integrals on the device are read on the host
+      accelerator::synchronizeDevice();
+    }
+
+    // note: the element matrices are stored as K_elem(e, trial dof, test dof)
+    trial_E = 0.0;
+    for (auto& [geom, K] : K_elem) {
+      const uint64_t num_elements = test_restrictions.at(geom).num_elements;
+      const uint64_t test_dofs    = test_restrictions.at(geom).ValuesPerElement();
+      const uint64_t trial_dofs   = trial_restrictions.at(geom).ValuesPerElement();
+      const double*  K_e          = K.data();
+      const double*  dr           = test_E.GetBlock(geom).HostRead();
+      double*        du           = trial_E.GetBlock(geom).HostReadWrite();
+      for (uint64_t e = 0; e < num_elements; e++) {
+        for (uint64_t j = 0; j < trial_dofs; j++) {
+          double sum = 0.0;
+          for (uint64_t i = 0; i < test_dofs; i++) {
+            sum += K_e[(e * trial_dofs + j) * test_dofs + i] * dr[e * test_dofs + i];
+          }
+          du[e * trial_dofs + j] = sum;
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief evaluate the residual (see operator()) into the given T-vector, reusing the memoized evaluation if
+   * possible (see SetMemoization())
+   *
+   * @param differentiation_indices the (Functional) indices of the arguments to differentiate w.r.t.
+   * @param input_T the arguments of the evaluation
+   * @param output_T the T-vector where the resulting values are stored
+   */
+  void evaluate(const std::vector<uint32_t>& differentiation_indices, const mfem::Vector* const* input_T,
+                mfem::Vector& output_T)
+  {
+    SERAC_TIME_SCOPE("Functional residual evaluations");
+
+    const bool value_only = (differentiation_indices.size() == 1 && differentiation_indices[0] == NO_DIFFERENTIATION);
+    const bool memoizable = (memoized_argument_ != NO_DIFFERENTIATION) &&
+                            (value_only || (differentiation_indices.size() == 1 &&
+                                            differentiation_indices[0] == memoized_argument_));
+    const bool cached_gradient = (cached_gradient_argument_ != NO_DIFFERENTIATION) &&
+                                 differentiation_indices.size() == 1 &&
+                                 differentiation_indices[0] == cached_gradient_argument_;
+
+    if (cached_gradient && matches(cached_gradient_, input_T)) {
+      output_T = cached_gradient_.value_T;
+      return;
+    }
+
+    std::vector<uint32_t> swept = differentiation_indices;
+    if (!memoizable) {
+      memoized_.valid = false;
+      sweep(differentiation_indices, input_T, output_T);
+    } else {
+      if (matches(memoized_, input_T)) {
+        output_T = memoized_.value_T;
+        return;
+      }
+
+      swept = {memoized_argument_};
+      sweep(swept, input_T, output_T);
+      memoized_.store(input_T, output_T, update_qdata, constrain_essential_dofs, essential_dofs_version_);
+    }
+
+    // the stored derivatives w.r.t. each argument are those of the last evaluation that computed them
+    if (cached_gradient_argument_ != NO_DIFFERENTIATION) {
+      if (std::find(swept.begin(), swept.end(), cached_gradient_argument_) != swept.end()) {
+        cached_gradient_.store(input_T, output_T, update_qdata, constrain_essential_dofs, essential_dofs_version_);
+      } else if (update_qdata) {
+        cached_gradient_.valid = false;
+      }
+    }
+  }
+
+  /**
+   * @brief whether an evaluation at the given arguments (and the current settings) would reproduce a stored one
+   *
+   * @param stored the stored evaluation, see SetMemoization() and SetGradientCaching()
+   * @param input_T the arguments of the evaluation
+   */
+  bool matches(const StoredEvaluation& stored, const mfem::Vector* const* input_T) const
+  {
+    // these are the same on every rank
+    if (!stored.valid || (update_qdata && !stored.update_qdata) || constrain_essential_dofs != stored.constrained ||
+        essential_dofs_version_ != stored.essential_dofs) {
+      return false;
+    }
+
+    int changed = 0;
+    for (uint32_t i = 0; i < num_trial_spaces && !changed; i++) {
+      const mfem::Vector& argument = *input_T[i];
+      const mfem::Vector& previous = stored.arguments_T[i];
+
+      changed = (argument.Size() != previous.Size());
+      if (!changed) {
+        const double* current_values  = argument.HostRead();
+        const double* previous_values = previous.HostRead();
+
+        changed = !std::equal(current_values, current_values + argument.Size(), previous_values);
+      }
+    }
+
+    // note: the elements on this rank also depend on the values owned by other ranks
+    MPI_Allreduce(MPI_IN_PLACE, &changed, 1, MPI_INT, MPI_LOR, test_space_->GetComm());
+    return !changed;
+  }
+
+  /**
+   * @brief evaluate the residual (see operator()) into the given T-vector, with a pass over the elements
+   *
+   * @param differentiation_indices the (Functional) indices of the arguments to differentiate w.r.t.
+   * @param input_T the arguments of the evaluation
+   * @param output_T the T-vector where the resulting values are stored
+   */
+  void sweep(const std::vector<uint32_t>& differentiation_indices, const mfem::Vector* const* input_T,
+             mfem::Vector& output_T)
+  {
+    for (uint32_t index : differentiation_indices) {
+      SLIC_ERROR_ROOT_IF(quadrature_point_arguments_.count(index) > 0,
+                         "can't differentiate w.r.t. a quadrature point argument, see SetQuadraturePointArgument()");
+    }
+
+    update_interpolation_caches(input_T);
+
+    output_L_ = 0.0;
+
+    // evaluations that update the quadrature data (or evaluate interior faces, or read quadrature point arguments)
+    // always evaluate every element, after which the outputs of the previous incremental evaluation are out of date
+    bool incremental =
+        incremental_evaluation_ && !update_qdata && !uses_interior_faces_ && quadrature_point_arguments_.empty();
+    if (!incremental) {
+      incremental_outputs_.clear();
+      incremental_memory_.set(0);
+    }
+
+    if (incremental) {
+      incremental_evaluation(input_T, differentiation_indices, output_T);
+    } else if constexpr (exec == ExecutionSpace::CPU) {
+      auto evaluate = [&](ElementStage stage) {
+        for (auto& integral : integrals_) {
+          profiling::ScopedTimer kernel_timer(kernel_counter(integral.type));
+          batched_element_loop(integral, integral.active_trial_spaces_, element_ranges_[integral.type][stage],
+                               [&](mfem::Geometry::Type geom, const std::vector<const double*>& inputs,
+                                   double* outputs, uint32_t first_element, uint32_t num_elements) {
+                                 integral.Mult(geom, inputs, outputs, first_element, num_elements,
+                                               differentiation_indices, update_qdata);
+                               });
+        }
+      };
+
+      // get the values for each local processor, evaluating the elements whose dofs
+      // are all owned by this rank while the shared dof values are exchanged
+      {
+        SERAC_PROFILE_SCOPE("Functional::prolongation");
+        for (uint32_t i = 0; i < num_trial_spaces; i++) {
+          if (!overlap_trial_prolongation_[i]) P_trial_[i]->Mult(*input_T[i], input_L_[i]);
+        }
+        for (uint32_t i = 0; i < num_trial_spaces; i++) {
+          if (overlap_trial_prolongation_[i]) trial_prolongation_[i].MultBegin(*input_T[i], input_L_[i]);
+        }
+      }
+      evaluate(InteriorBeforeExchange);
+      {
+        // the time spent here is the part of the communication that wasn't hidden behind the evaluation above
+        SERAC_PROFILE_SCOPE("Functional::prolongation (wait)");
+        SERAC_TIME_SCOPE("Functional MPI wait");
+        for (uint32_t i = 0; i < num_trial_spaces; i++) {
+          if (overlap_trial_prolongation_[i]) trial_prolongation_[i].MultEnd(input_L_[i]);
+        }
+        for (uint32_t i = 0; i < num_trial_spaces; i++) {
+          exchange_face_nbr_values(i, input_L_[i], face_nbr_L_[i]);
+        }
+      }
+
+      evaluate(RankBoundary);
+
+      // scatter-add to compute global residuals
+      SERAC_MARK_BEGIN("Functional::prolongation transpose");
+      test_prolongation_.MultTransposeBegin(output_L_);
+      SERAC_MARK_END("Functional::prolongation transpose");
+      evaluate(InteriorDuringReduction);
+      SERAC_MARK_BEGIN("Functional::prolongation transpose (wait)");
+      {
+        SERAC_TIME_SCOPE("Functional MPI wait");
+        test_prolongation_.MultTransposeEnd(output_L_, output_T);
+      }
+      SERAC_MARK_END("Functional::prolongation transpose (wait)");
+    } else {
+      // get the values for each local processor
+      SERAC_MARK_BEGIN("Functional::prolongation");
+      for (uint32_t i = 0; i < num_trial_spaces; i++) {
+        P_trial_[i]->Mult(*input_T[i], input_L_[i]);
+      }
+      SERAC_MARK_END("Functional::prolongation");
+
+      if ((use_kernel_graphs_ || concurrent_integrals_) && !batched_device_evaluation_) {
+        std::vector<uint32_t> key{0, update_qdata};
+        key.insert(key.end(), differentiation_indices.begin(), differentiation_indices.end());
+
+        std::vector<uint32_t> trial_spaces(num_trial_spaces);
+        std::iota(trial_spaces.begin(), trial_spaces.end(), 0);
+
+        device_element_loop(key, trial_spaces,
+                            [&](const Integral& integral, mfem::Geometry::Type geom,
+                                const std::vector<const double*>& inputs, double* outputs, uint32_t num_elements) {
+                              integral.Mult(geom, inputs, outputs, 0, num_elements, differentiation_indices,
+                                            update_qdata);
+                            });
+      } else {
+        // this is used to mark when operations have been performed,
+        // to avoid doing them more than once
+        bool already_computed[Integral::num_types][num_trial_spaces]{};  // default initializes to `false`
+
+        for (auto& integral : integrals_) {
+          auto type = integral.type;
+          SERAC_PROFILE_SCOPE(profiling::concat("Functional::", Integral::TypeNames[type]));
+
+          if (batched_device_evaluation_) {
+            device_batched_element_loop(integral, integral.active_trial_spaces_,
+                                        [&](mfem::Geometry::Type geom, const std::vector<const double*>& inputs,
+                                            double* outputs, uint32_t first_element, uint32_t num_elements) {
+                                          integral.Mult(geom, inputs, outputs, first_element, num_elements,
+                                                        differentiation_indices, update_qdata);
+                                        });
+            continue;
+          }
+
+          SERAC_MARK_BEGIN("gather");
+          for (auto i : integral.active_trial_spaces_) {
+            if (!already_computed[type][i]) {
+              G_trial_[type][i].Gather(input_L_[i], input_E_[type][i]);
+              already_computed[type][i] = true;
+            }
+          }
+          SERAC_MARK_END("gather");
+
+          SERAC_MARK_BEGIN("kernel");
+          {
+            profiling::ScopedTimer kernel_timer(kernel_counter(type));
+            integral.Mult(input_E_[type], output_E_[type], differentiation_indices, update_qdata);
+          }
+          SERAC_MARK_END("kernel");
+
+          // scatter-add to compute residuals on the local processor
+          SERAC_MARK_BEGIN("scatter");
+          G_test_[type].ScatterAdd(output_E_[type], output_L_);
+          SERAC_MARK_END("scatter");
+        }
+      }
+
+      // scatter-add to compute global residuals
+      SERAC_MARK_BEGIN("Functional::prolongation transpose");
+      P_test_->MultTranspose(output_L_, output_T);
+      SERAC_MARK_END("Functional::prolongation transpose");
+    }
+
+    if (constrain_essential_dofs) {
+      output_T.SetSubVector(essential_true_dofs_, 0.0);
+    }
+  }
+
+  /**
+   * @brief evaluate the residual in incremental mode (see SetIncrementalEvaluation()), into `output_T`
+   *
+   * @param input_T the arguments of the evaluation
+   * @param differentiation_indices the (Functional) indices of the arguments to differentiate w.r.t.
+   * @param output_T the T-vector where the resulting values are stored
+   */
+  void incremental_evaluation(const mfem::Vector* const* input_T, const std::vector<uint32_t>& differentiation_indices,
+                              mfem::Vector& output_T)
+  {
+    SERAC_PROFILE_SCOPE("Functional::incremental evaluation");
+
+    for (uint32_t i = 0; i < num_trial_spaces; i++) {
+      P_trial_[i]->Mult(*input_T[i], input_L_[i]);
+    }
+
+    // every element is evaluated when there are no stored outputs (for these integrals and derivatives)
+    bool evaluate_all = (incremental_outputs_.size() != integrals_.size()) ||
+                        (differentiation_indices != incremental_differentiation_indices_);
+    if (evaluate_all) {
+      incremental_outputs_.assign(integrals_.size(), {});
+      incremental_differentiation_indices_ = differentiation_indices;
+      incremental_output_L_.SetSize(output_L_.Size());
+      incremental_output_L_ = 0.0;
+    }
+
+    // mark the local dofs that changed by more than the tolerance, and remember their new values: the other
+    // dofs are compared to the values they had when the last elements using them were evaluated
+    for (uint32_t i = 0; i < num_trial_spaces; i++) {
+      changed_dofs_L_[i].SetSize(input_L_[i].Size());
+      if (evaluate_all) {
+        incremental_input_L_[i] = input_L_[i];
+        changed_dofs_L_[i]      = 1.0;
+        continue;
+      }
+
+      const double* current  = input_L_[i].HostRead();
+      double*       previous = incremental_input_L_[i].HostReadWrite();
+      double*       changed  = changed_dofs_L_[i].HostWrite();
+      for (int j = 0; j < input_L_[i].Size(); j++) {
+        changed[j] = (std::abs(current[j] - previous[j]) > incremental_tolerance_) ? 1.0 : 0.0;
+        if (changed[j] != 0.0) previous[j] = current[j];
+      }
+    }
+
+    double* output_L = incremental_output_L_.HostReadWrite();
+
+    std::size_t           stored_values = 0;
+    std::vector<double>   element_changes;
+    std::vector<uint32_t> elements;
+    for (std::size_t k = 0; k < integrals_.size(); k++) {
+      const auto& integral     = integrals_[k];
+      auto        type         = integral.type;
+      const auto& trial_spaces = integral.active_trial_spaces_;
+
+      std::vector<const double*> inputs(trial_spaces.size());
+      for (auto& [geom, test_restriction] : G_test_[type].restrictions) {
+        uint32_t num_elements = integral.NumMeshElements(geom);
+        if (integral.NumElements(geom) == 0) continue;
+
+        uint32_t values_per_element = test_restriction.ValuesPerElement();
+        auto&    stored             = incremental_outputs_[k][geom];
+        stored.resize(std::size_t(num_elements) * values_per_element, 0.0);
+        stored_values += stored.size();
+
+        // the elements (in this integral's domain) with a changed dof
+        elements.clear();
+        integral.ForEachElementRun(geom, 0, num_elements, [&](uint32_t begin, uint32_t end) {
+          for (uint32_t e = begin; e < end; e++) {
+            bool changed = false;
+            for (std::size_t i = 0; i < trial_spaces.size() && !changed; i++) {
+              const auto& trial_restriction = G_trial_[type][trial_spaces[i]].restrictions.at(geom);
+              element_changes.resize(trial_restriction.ValuesPerElement());
+              trial_restriction.Gather(changed_dofs_L_[trial_spaces[i]].HostRead(), element_changes.data(), e, 1);
+              changed = std::any_of(element_changes.begin(), element_changes.end(), [](double c) { return c != 0.0; });
+            }
+            if (changed) elements.push_back(e);
+          }
+        });
+
+        batch_output_.resize(element_batch_size_ * values_per_element);
+        for (std::size_t i = 0; i < trial_spaces.size(); i++) {
+          const auto& trial_restriction = G_trial_[type][trial_spaces[i]].restrictions.at(geom);
+          batch_input_[i].resize(element_batch_size_ * trial_restriction.ValuesPerElement());
+          inputs[i] = batch_input_[i].data();
+        }
+
+        // evaluate the runs of consecutive changed elements in batches, and add the changes in their outputs
+        for (std::size_t n = 0; n < elements.size();) {
+          uint32_t first_element = elements[n];
+          uint32_t count         = 1;
+          while (n + count < elements.size() && count < element_batch_size_ &&
+                 elements[n + count] == first_element + count) {
+            count++;
+          }
+
+          for (std::size_t i = 0; i < trial_spaces.size(); i++) {
+            const auto& trial_restriction = G_trial_[type][trial_spaces[i]].restrictions.at(geom);
+            trial_restriction.Gather(input_L_[trial_spaces[i]].HostRead(), batch_input_[i].data(), first_element,
+                                     count);
+          }
+
+          std::fill(batch_output_.begin(), batch_output_.end(), 0.0);
+          integral.Mult(geom, inputs, batch_output_.data(), first_element, count, differentiation_indices, false);
+
+          double* previous = stored.data() + std::size_t(first_element) * values_per_element;
+          for (std::size_t v = 0; v < std::size_t(count) * values_per_element; v++) {
+            double change    = batch_output_[v] - previous[v];
+            previous[v]      = batch_output_[v];
+            batch_output_[v] = change;
+          }
+          test_restriction.ScatterAdd(batch_output_.data(), output_L, first_element, count);
+
+          n += count;
+        }
+      }
+    }
+
+    std::size_t dof_values = std::size_t(incremental_output_L_.Size());
+    for (uint32_t i = 0; i < num_trial_spaces; i++) {
+      dof_values += std::size_t(incremental_input_L_[i].Size() + changed_dofs_L_[i].Size());
+    }
+    incremental_memory_.set(sizeof(double) * (stored_values + dof_values));
+
+    P_test_->MultTranspose(incremental_output_L_, output_T);
+  }
+
+  /**
+   * @brief tell each integral which of its trial spaces (if any) reuses its interpolated values, and whether they
+   * need to be recomputed for the arguments of this evaluation (see SetCachedArgument())
+   *
+   * @param input_T the arguments of the evaluation
+   */
+  void update_interpolation_caches(const mfem::Vector* const* input_T)
+  {
+    bool refresh = false;
+    if (cached_argument_ != NO_CACHED_ARGUMENT) {
+      const mfem::Vector& argument = *input_T[cached_argument_];
+
+      int changed = (argument.Size() != cached_argument_T_.Size());
+      if (!changed) {
+        const double* current  = argument.HostRead();
+        const double* previous = cached_argument_T_.HostRead();
+        for (int i = 0; i < argument.Size() && !changed; i++) {
+          changed = (current[i] != previous[i]);
+        }
+      }
+
+      // note: the elements on this rank also depend on the values owned by other ranks
+      MPI_Allreduce(MPI_IN_PLACE, &changed, 1, MPI_INT, MPI_LOR, test_space_->GetComm());
+
+      if (changed) {
+        cached_argument_T_ = argument;
+      }
+      refresh = changed;
+    }
+
+    for (auto& integral : integrals_) {
+      auto index      = integral.functional_to_integral_index_.find(cached_argument_);
+      bool uses_cache = (index != integral.functional_to_integral_index_.end());
+      integral.interpolation_cache_->argument = uses_cache ? index->second : NO_CACHED_ARGUMENT;
+      integral.interpolation_cache_->refresh  = refresh;
+
+      integral.interpolation_cache_->supplied.clear();
+      for (auto& [argument, values] : quadrature_point_arguments_) {
+        auto supplied = integral.functional_to_integral_index_.find(argument);
+        if (supplied == integral.functional_to_integral_index_.end()) continue;
+        SLIC_ERROR_ROOT_IF(integral.type != Integral::Domain,
+                           "quadrature point arguments are only supported by domain integrals");
+        integral.interpolation_cache_->supplied[supplied->second] = values;
+      }
+    }
+  }
+
+  /// @brief evaluate, and differentiate w.r.t. each of the arguments of type `differentiate_wrt_this`
+  template <typename... T, std::size_t... i>
+  auto differentiate_wrt_each(std::index_sequence<i...>, const T&... args)
+  {
+    constexpr auto indices = indices_of_differentiation<T...>();
+    return (*this)(DifferentiateWRT<indices[i]...>{}, args...);
+  }
+
+  /// @brief a contiguous range of element indices, [begin, end)
+  struct ElementRange {
+    uint32_t begin;  ///< the first element in the range
+    uint32_t end;    ///< one past the last element in the range
+  };
+
+  /// @brief the element ranges (for each element geometry) evaluated at a given stage
+  using ElementRanges = std::map<mfem::Geometry::Type, std::vector<ElementRange>>;
+
+  /**
+   * @brief the order in which elements are evaluated on the CPU, so that the communication of shared dof values
+   * can be overlapped with the element calculations that don't depend on it
+   */
+  enum ElementStage
+  {
+    InteriorBeforeExchange,   ///< elements whose dofs are all owned by this rank, while the trial values are exchanged
+    RankBoundary,             ///< elements with dofs owned by other ranks, after the trial values are exchanged
+    InteriorDuringReduction,  ///< the remaining interior elements, while the test values are sent to their owners
+    num_element_stages
+  };
+
+  /**
+   * @brief sort the elements of each geometry into the stages of ElementStage: elements with a dof (of any trial space,
+   * or the test space) owned by another rank go in the RankBoundary stage, and the remaining elements are divided
+   * evenly between the other two stages
+   */
+  void partition_elements()
+  {
+    for (auto type : Integral::Types) {
+      for (auto& ranges : element_ranges_[type]) {
+        ranges.clear();
+      }
+
+      for (auto& [geom, test_restriction] : G_test_[type].restrictions) {
+        auto num_elements = uint32_t(test_restriction.num_elements);
+
+        std::vector<bool> on_rank_boundary(num_elements, false);
+        for (auto e : *test_restriction.rank_boundary_elements) {
+          on_rank_boundary[e] = true;
+        }
+        for (uint32_t i = 0; i < num_trial_spaces; i++) {
+          // note: interior face restrictions are only created for the trial spaces that need them
+          auto trial_restriction = G_trial_[type][i].restrictions.find(geom);
+          if (trial_restriction == G_trial_[type][i].restrictions.end()) continue;
+
+          for (auto e : *trial_restriction->second.rank_boundary_elements) {
+            on_rank_boundary[e] = true;
+          }
+        }
+
+        std::vector<ElementRange> interior;
+        std::vector<ElementRange> boundary;
+        uint32_t                  num_interior = 0;
+        for (uint32_t e = 0; e < num_elements;) {
+          uint32_t first = e;
+          while (e < num_elements && on_rank_boundary[e] == on_rank_boundary[first]) e++;
+          if (on_rank_boundary[first]) {
+            boundary.push_back({first, e});
+          } else {
+            interior.push_back({first, e});
+            num_interior += e - first;
+          }
+        }
+
+        auto& before = element_ranges_[type][InteriorBeforeExchange][geom];
+        auto& during = element_ranges_[type][InteriorDuringReduction][geom];
+        element_ranges_[type][RankBoundary][geom] = boundary;
+
+        uint32_t remaining = num_interior / 2;
+        for (auto range : interior) {
+          uint32_t count = range.end - range.begin;
+          if (remaining >= count) {
+            before.push_back(range);
+            remaining -= count;
+          } else {
+            if (remaining > 0) before.push_back({range.begin, range.begin + remaining});
+            during.push_back({range.begin + remaining, range.end});
+            remaining = 0;
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief evaluate an integral's element calculations in batches, gathering each batch's inputs from the
+   * L-vectors in `input_L_` and scatter-adding its outputs into `output_L_` immediately afterwards
+   *
+   * @param integral the integral being evaluated
+   * @param trial_spaces the (Functional) indices of the trial spaces to gather, in the order `kernel` expects them
+   * @param ranges which elements (of each geometry) to evaluate
+   * @param kernel a callable with the signature
+   * (mfem::Geometry::Type, const std::vector<const double*>& inputs, double* outputs, first_element, num_elements)
+   */
+  template <typename kernel_type>
+  void batched_element_loop(const Integral& integral, const std::vector<uint32_t>& trial_spaces,
+                            const ElementRanges& ranges, kernel_type&& kernel) const
+  {
+    auto type = integral.type;
+
+    std::vector<const double*> L(trial_spaces.size());
+    std::vector<const double*> L_face_nbr(trial_spaces.size(), nullptr);
+    for (std::size_t i = 0; i < trial_spaces.size(); i++) {
+      L[i] = input_L_[trial_spaces[i]].HostRead();
+      if (type == Integral::InteriorFace) {
+        L_face_nbr[i] = face_nbr_L_[trial_spaces[i]].HostRead();
+      }
+    }
+    double* output_L = output_L_.HostReadWrite();
+
+    std::vector<const double*> inputs(trial_spaces.size());
+    for (auto& [geom, test_restriction] : G_test_[type].restrictions) {
+      uint32_t num_elements = integral.NumElements(geom);
+      if (num_elements == 0 || ranges.count(geom) == 0) continue;
+
+      SERAC_PROFILE_SCOPE(
+          profiling::concat("Functional::", Integral::TypeNames[type], " ", mfem::Geometry::Name[geom]));
+
+      // analytic estimates of the work per element of each stage, see Integral::costs_ (each gathered or
+      // scattered value is read from one array and written to another)
+      [[maybe_unused]] Integral::ElementCost cost{0.0, 0.0};
+      [[maybe_unused]] double                gather_bytes  = 0.0;
+      [[maybe_unused]] double                scatter_bytes = 0.0;
+      if (integral.costs_.count(geom)) {
+        cost = integral.costs_.at(geom);
+      }
+
+      // restrictions that are the identity (e.g. of scalar L2 spaces) aren't gathered (or scatter-added): the
+      // element calculations read from (and add into) the L-vectors directly
+      if (!test_restriction.identity) {
+        scatter_bytes = 2.0 * sizeof(double) * double(test_restriction.ValuesPerElement());
+      }
+
+      auto     tuned      = integral.batch_sizes_.find(geom);
+      uint32_t batch_size = std::min((tuned != integral.batch_sizes_.end()) ? tuned->second : element_batch_size_,
+                                     num_elements);
+      for (std::size_t i = 0; i < trial_spaces.size(); i++) {
+        const auto& trial_restriction = G_trial_[type][trial_spaces[i]].restrictions.at(geom);
+        if (!trial_restriction.identity) {
+          batch_input_[i].resize(batch_size * trial_restriction.ValuesPerElement());
+          gather_bytes += 2.0 * sizeof(double) * double(trial_restriction.ValuesPerElement());
+        }
+      }
+      if (!test_restriction.identity) {
+        batch_output_.resize(batch_size * test_restriction.ValuesPerElement());
+      }
+
+      // integrals over some of the elements only gather (and evaluate) the runs of elements in their domain
+      auto evaluate_run = [&, geom = geom, &test_restriction = test_restriction](uint32_t begin, uint32_t end) {
+        for (uint32_t first_element = begin; first_element < end; first_element += batch_size) {
+          uint32_t count = std::min(batch_size, end - first_element);
+
+          {
+            SERAC_PROFILE_SCOPE("gather");
+            SERAC_PROFILE_COUNTER("bytes", gather_bytes * count);
+            for (std::size_t i = 0; i < trial_spaces.size(); i++) {
+              const auto& trial_restriction = G_trial_[type][trial_spaces[i]].restrictions.at(geom);
+              if (trial_restriction.identity) {
+                inputs[i] = L[i] + trial_restriction.L_offset + first_element * trial_restriction.ValuesPerElement();
+              } else {
+                trial_restriction.Gather(L[i], L_face_nbr[i], batch_input_[i].data(), first_element, count);
+                inputs[i] = batch_input_[i].data();
+              }
+            }
+          }
+
+          // note: the element calculations add their outputs to the (zero-initialized) values they are given
+          double* outputs = batch_output_.data();
+          if (test_restriction.identity) {
+            outputs = output_L + test_restriction.L_offset + first_element * test_restriction.ValuesPerElement();
+          } else {
+            std::fill(batch_output_.begin(), batch_output_.end(), 0.0);
+          }
+
+          {
+            SERAC_PROFILE_SCOPE("kernel");
+            SERAC_PROFILE_COUNTER("flops", cost.flops * count);
+            SERAC_PROFILE_COUNTER("bytes", cost.bytes * count);
+            kernel(geom, inputs, outputs, first_element, count);
+          }
+
+          // scatter-add to compute residuals on the local processor
+          if (!test_restriction.identity) {
+            SERAC_PROFILE_SCOPE("scatter");
+            SERAC_PROFILE_COUNTER("bytes", scatter_bytes * count);
+            test_restriction.ScatterAdd(batch_output_.data(), output_L, first_element, count);
+          }
+        }
+      };
+
+      for (auto range : ranges.at(geom)) {
+        integral.ForEachElementRun(geom, range.begin, range.end, evaluate_run);
+      }
+    }
+  }
+
+  /**
+   * @brief the counterpart of batched_element_loop() for the GPU, once a batch size is set (see SetElementBatchSize()):
+   * each batch is gathered on the host into buffers reused by every batch, evaluated in the execution space, and
+   * scatter-added into `output_L_`, so that no E-vectors for the whole mesh are needed
+   *
+   * @param integral the integral being evaluated
+   * @param trial_spaces the (Functional) indices of the trial spaces to gather, in the order `kernel` expects them
+   * @param kernel see batched_element_loop(), called with pointers to memory in the execution space
+   */
+  template <typename kernel_type>
+  void device_batched_element_loop(const Integral& integral, const std::vector<uint32_t>& trial_spaces,
+                                   kernel_type&& kernel) const
+  {
+    auto type     = integral.type;
+    auto mem_type = mfem::Device::GetMemoryType();
+
+    std::vector<const double*> inputs(trial_spaces.size());
+    for (auto& [geom, test_restriction] : G_test_[type].restrictions) {
+      uint32_t num_elements = integral.NumMeshElements(geom);
+      if (num_elements == 0) continue;
+
+      SERAC_PROFILE_SCOPE(
+          profiling::concat("Functional::", Integral::TypeNames[type], " ", mfem::Geometry::Name[geom]));
+
+      // mfem::Vector only reallocates when the new size exceeds its capacity
+      uint32_t batch_size = std::min(element_batch_size_, num_elements);
+      for (std::size_t i = 0; i < trial_spaces.size(); i++) {
+        const auto& trial_restriction = G_trial_[type][trial_spaces[i]].restrictions.at(geom);
+        device_batch_input_[i].SetSize(int(batch_size * trial_restriction.ValuesPerElement()), mem_type);
+      }
+      device_batch_output_.SetSize(int(batch_size * test_restriction.ValuesPerElement()), mem_type);
+
+      for (uint32_t first_element = 0; first_element < num_elements; first_element += batch_size) {
+        uint32_t count = std::min(batch_size, num_elements - first_element);
+
+        SERAC_MARK_BEGIN("gather");
+        for (std::size_t i = 0; i < trial_spaces.size(); i++) {
+          const auto& trial_restriction = G_trial_[type][trial_spaces[i]].restrictions.at(geom);
+          trial_restriction.Gather(input_L_[trial_spaces[i]].HostRead(), device_batch_input_[i].HostWrite(),
+                                   first_element, count);
+          inputs[i] = device_batch_input_[i].Read();
+        }
+        SERAC_MARK_END("gather");
+
+        SERAC_MARK_BEGIN("kernel");
+        device_batch_output_ = 0.0;
+        kernel(geom, inputs, device_batch_output_.ReadWrite(), first_element, count);
+        SERAC_MARK_END("kernel");
+
+        // scatter-add to compute residuals on the local processor
+        SERAC_MARK_BEGIN("scatter");
+        test_restriction.ScatterAdd(device_batch_output_.HostRead(), output_L_.HostReadWrite(), first_element, count);
+        SERAC_MARK_END("scatter");
+      }
+    }
+  }
+
+  /**
+   * @brief evaluate the element kernels of the integrals through E-vectors, with the kernels of each integral and
+   * geometry on separate streams (see SetConcurrentIntegrals()) and/or replayed as one CUDA graph (see
+   * SetKernelGraphs()): the E-vectors of every integral type are gathered, and made current on the device, before
+   * the kernels, which then only read and write device memory, and scatter-added after all of them
+   *
+   * @param key identifies the sequence of kernels, whose graph is captured the first time it is evaluated
+   * @param trial_spaces the (Functional) indices of the trial spaces whose E-vectors the kernels read
+   * @param kernel launches the kernels of an integral over the elements of one geometry, given its inputs (one per
+   * active trial space of the integral, or nullptr for those not in `trial_spaces`) and its outputs
+   */
+  template <typename kernel_type>
+  void device_element_loop(const std::vector<uint32_t>& key, const std::vector<uint32_t>& trial_spaces,
+                           kernel_type&& kernel) const
+  {
+    SERAC_PROFILE_SCOPE("Functional::device element loop");
+
+    bool used[Integral::num_types]{};
+    bool gathered[Integral::num_types][num_trial_spaces]{};
+    for (auto& integral : integrals_) {
+      used[integral.type] = true;
+      for (auto i : trial_spaces) {
+        gathered[integral.type][i] |= (integral.functional_to_integral_index_.count(i) > 0);
+      }
+    }
+
+    SERAC_MARK_BEGIN("gather");
+    for (auto type : Integral::Types) {
+      if (!used[type]) continue;
+      for (uint32_t i = 0; i < num_trial_spaces; i++) {
+        if (gathered[type][i]) {
+          G_trial_[type][i].Gather(input_L_[i], input_E_[type][i]);
+          input_E_[type][i].Read();
+        }
+      }
+      output_E_[type] = 0.0;
+      output_E_[type].ReadWrite();
+    }
+    SERAC_MARK_END("gather");
+
+    // the device memory of every kernel's inputs and outputs, which must be the same in every replay of the graph
+    struct Launch {
+      const Integral*            integral;
+      mfem::Geometry::Type       geom;
+      std::vector<const double*> inputs;
+      double*                    outputs;
+      uint32_t                   num_elements;
+    };
+    std::vector<Launch> launches;
+    for (auto& integral : integrals_) {
+      auto type = integral.type;
+      for (auto& [geom, test_restriction] : G_test_[type].restrictions) {
+        uint32_t num_elements = integral.NumMeshElements(geom);
+        if (num_elements == 0) continue;
+
+        std::vector<const double*> inputs;
+        for (auto i : integral.active_trial_spaces_) {
+          inputs.push_back(gathered[type][i] ? input_E_[type][i].GetBlock(geom).Read() : nullptr);
+        }
+        launches.push_back({&integral, geom, inputs, output_E_[type].GetBlock(geom).ReadWrite(), num_elements});
+      }
+    }
+
+    // the integrals (and geometries) write to separate blocks of the E-vectors, so their kernels are independent
+    auto launch_kernels = [&]() {
+      if (concurrent_integrals_) {
+        accelerator::launchConcurrently(launches.size(), [&](std::size_t l) {
+          kernel(*launches[l].integral, launches[l].geom, launches[l].inputs, launches[l].outputs,
+                 launches[l].num_elements);
+        });
+      } else {
+        for (auto& launch : launches) {
+          kernel(*launch.integral, launch.geom, launch.inputs, launch.outputs, launch.num_elements);
+        }
+      }
+    };
+
+    SERAC_MARK_BEGIN("kernel");
+    if (use_kernel_graphs_) {
+      kernel_graphs_[key].run(launch_kernels);
+    } else {
+      launch_kernels();
+    }
+    SERAC_MARK_END("kernel");
+
+    // scatter-add to compute residuals on the local processor
+    SERAC_MARK_BEGIN("scatter");
+    for (auto type : Integral::Types) {
+      if (used[type]) {
+        G_test_[type].ScatterAdd(output_E_[type], output_L_);
+      }
+    }
+    SERAC_MARK_END("scatter");
+  }
+
+  /**
+   * @brief the counterpart of batched_element_loop() for ActionOfGradient() in several directions: each batch
+   * gathers the values of every direction from `block_input_L_`, applies the integral's jacobian to all of them
+   * together, and scatter-adds the results into `block_output_L_`
+   *
+   * @param integral the integral being evaluated
+   * @param which the (Functional) index of the trial space the directions correspond to
+   * @param num_directions the number of directions
+   */
+  void block_element_loop(const Integral& integral, uint32_t which, uint32_t num_directions) const
+  {
+    auto type = integral.type;
+
+    for (auto& [geom, test_restriction] : G_test_[type].restrictions) {
+      uint32_t num_elements = integral.NumElements(geom);
+      if (num_elements == 0) continue;
+
+      const auto& trial_restriction = G_trial_[type][which].restrictions.at(geom);
+      uint64_t    input_values      = trial_restriction.ValuesPerElement();
+      uint64_t    output_values     = test_restriction.ValuesPerElement();
+
+      uint32_t batch_size = std::min(element_batch_size_, num_elements);
+      batch_input_[0].resize(num_directions * batch_size * input_values);
+      batch_output_.resize(num_directions * batch_size * output_values);
+
+      auto evaluate_run = [&, geom = geom, &test_restriction = test_restriction](uint32_t begin, uint32_t end) {
+        for (uint32_t first_element = begin; first_element < end; first_element += batch_size) {
+          uint32_t count = std::min(batch_size, end - first_element);
+
+          // the values of each direction are stored one after another
+          for (uint32_t d = 0; d < num_directions; d++) {
+            trial_restriction.Gather(block_input_L_[d].HostRead(), block_face_nbr_L_[d].HostRead(),
+                                     batch_input_[0].data() + d * count * input_values, first_element, count);
+          }
+
+          std::fill(batch_output_.begin(), batch_output_.end(), 0.0);
+          integral.GradientMult(geom, batch_input_[0].data(), batch_output_.data(), first_element, count, which,
+                                num_directions);
+
+          // scatter-add to compute residuals on the local processor
+          for (uint32_t d = 0; d < num_directions; d++) {
+            test_restriction.ScatterAdd(batch_output_.data() + d * count * output_values,
+                                        block_output_L_[d].HostReadWrite(), first_element, count);
+          }
+        }
+      };
+
+      integral.ForEachElementRun(geom, 0, integral.NumMeshElements(geom), evaluate_run);
+    }
+  }
+
+  /**
+   * @brief the counterpart of batched_element_loop() for DirectionalDerivatives(): each batch gathers the values of
+   * the trial spaces from `input_L_` and of each direction from `block_input_L_`, evaluates the integral along with
+   * its derivatives in every direction, and scatter-adds the results into `output_L_` and `block_output_L_`
+   *
+   * @param integral the integral being evaluated
+   * @param which the (Functional) index of the trial space that each direction perturbs
+   */
+  void directional_element_loop(const Integral& integral, const std::vector<uint32_t>& which) const
+  {
+    auto        type           = integral.type;
+    const auto& trial_spaces   = integral.active_trial_spaces_;
+    auto        num_directions = uint32_t(which.size());
+
+    std::vector<const double*> inputs(trial_spaces.size());
+    std::vector<const double*> directions(num_directions, nullptr);
+    batch_direction_input_.resize(num_directions);
+
+    for (auto& [geom, test_restriction] : G_test_[type].restrictions) {
+      uint32_t num_elements = integral.NumElements(geom);
+      if (num_elements == 0) continue;
+
+      uint64_t output_values = test_restriction.ValuesPerElement();
+      uint32_t batch_size    = std::min(element_batch_size_, num_elements);
+      for (std::size_t i = 0; i < trial_spaces.size(); i++) {
+        const auto& trial_restriction = G_trial_[type][trial_spaces[i]].restrictions.at(geom);
+        batch_input_[i].resize(batch_size * trial_restriction.ValuesPerElement());
+        inputs[i] = batch_input_[i].data();
+      }
+      for (uint32_t d = 0; d < num_directions; d++) {
+        if (integral.functional_to_integral_index_.count(which[d]) == 0) continue;
+        const auto& trial_restriction = G_trial_[type][which[d]].restrictions.at(geom);
+        batch_direction_input_[d].resize(batch_size * trial_restriction.ValuesPerElement());
+        directions[d] = batch_direction_input_[d].data();
+      }
+      batch_output_.resize((num_directions + 1) * batch_size * output_values);
+
+      auto evaluate_run = [&, geom = geom, &test_restriction = test_restriction](uint32_t begin, uint32_t end) {
+        for (uint32_t first_element = begin; first_element < end; first_element += batch_size) {
+          uint32_t count = std::min(batch_size, end - first_element);
+
+          for (std::size_t i = 0; i < trial_spaces.size(); i++) {
+            const auto& trial_restriction = G_trial_[type][trial_spaces[i]].restrictions.at(geom);
+            trial_restriction.Gather(input_L_[trial_spaces[i]].HostRead(), batch_input_[i].data(), first_element,
+                                     count);
+          }
+          for (uint32_t d = 0; d < num_directions; d++) {
+            if (directions[d] == nullptr) continue;
+            const auto& trial_restriction = G_trial_[type][which[d]].restrictions.at(geom);
+            trial_restriction.Gather(block_input_L_[d].HostRead(), batch_direction_input_[d].data(), first_element,
+                                     count);
+          }
+
+          std::fill(batch_output_.begin(), batch_output_.end(), 0.0);
+          integral.DirectionalMult(geom, inputs, directions, which, batch_output_.data(), first_element, count);
+
+          // the values come first, followed by the derivative in each direction
+          test_restriction.ScatterAdd(batch_output_.data(), output_L_.HostReadWrite(), first_element, count);
+          for (uint32_t d = 0; d < num_directions; d++) {
+            test_restriction.ScatterAdd(batch_output_.data() + (d + 1) * count * output_values,
+                                        block_output_L_[d].HostReadWrite(), first_element, count);
+          }
+        }
+      };
+
+      integral.ForEachElementRun(geom, 0, integral.NumMeshElements(geom), evaluate_run);
+    }
+  }
+
+  /**
+   * @brief get the values of a trial space on the elements of other ranks that share a face with this rank,
+   * for the interior face integrals (this does nothing for trial spaces that no interior face integral uses)
+   *
+   * @param i the index of the trial space
+   * @param L the local values of the trial space
+   * @param L_face_nbr the values of the face neighbor elements' dofs
+   *
+   * @note this is collective, and must be called after `L` is up to date (i.e. after its values are exchanged)
+   */
+  void exchange_face_nbr_values(uint32_t i, const mfem::Vector& L, mfem::Vector& L_face_nbr) const
+  {
+    if (!uses_face_nbr_values_[i]) return;
+
+    mfem::ParGridFunction values(const_cast<mfem::ParFiniteElementSpace*>(trial_space_[i]),
+                                 const_cast<double*>(L.HostRead()));
+    values.ExchangeFaceNbrData();
+    L_face_nbr = values.FaceNbrData();
+  }
+
+  /**
+   * @brief mfem::Operator representing the gradient matrix that
+   * can compute the action of the gradient (with operator()),
+   * or assemble the sparse matrix representation through implicit conversion to mfem::HypreParMatrix *
+   */
+  class Gradient : public mfem::Operator {
+  public:
+    /**
+     * @brief Constructs a Gradient wrapper that references a parent @p Functional
      * @param[in] f The @p Functional to use for gradient calculations
      */
-    Gradient(Functional<test(trials...), exec>& f, uint32_t which = 0)
-        : mfem::Operator(f.test_space_->GetTrueVSize(), f.trial_space_[which]->GetTrueVSize()),
-          form_(f),
-          lookup_tables(f.G_test_[Integral::Domain], f.G_trial_[Integral::Domain][which]),
-          which_argument(which),
-          test_space_(f.test_space_),
-          trial_space_(f.trial_space_[which]),
-          df_(f.test_space_->GetTrueVSize())
+    Gradient(Functional<test(trials...), exec>& f, uint32_t which = 0)
+        : mfem::Operator(f.test_space_->GetTrueVSize(), f.trial_space_[which]->GetTrueVSize()),
+          form_(f),
+          which_argument(which),
+          test_space_(f.test_space_),
+          trial_space_(f.trial_space_[which]),
+          df_(f.test_space_->GetTrueVSize())
+    {
+    }
+
+    /**
+     * @brief implement that action of the gradient: df := df_dx * dx
+     * @param[in] dx a small perturbation in the trial space
+     * @param[in] df the resulting small perturbation in the residuals
+     */
+    virtual void Mult(const mfem::Vector& dx, mfem::Vector& df) const override
+    {
+      form_.ActionOfGradient(dx, df, which_argument);
+    }
+
+    /**
+     * @brief implement the action of the gradient on several perturbations at once: dF := df_dx * dX
+     * @param[in] dX the perturbations in the trial space, one per column
+     * @param[out] dF the resulting perturbations in the residuals, one per column
+     */
+    void Mult(const mfem::DenseMatrix& dX, mfem::DenseMatrix& dF) const
+    {
+      form_.ActionOfGradient(dX, dF, which_argument);
+    }
+
+    /**
+     * @brief implement the action of the transpose of the gradient: dx := df_dx^T * df, without assembling
+     * a sparse matrix (see Functional::ActionOfGradientTranspose())
+     * @param[in] df a perturbation in the residuals
+     * @param[out] dx the resulting perturbation in the trial space
+     * @note like Mult(), this is not affected by Functional::SetEssentialTrueDofs()
+     */
+    virtual void MultTranspose(const mfem::Vector& df, mfem::Vector& dx) const override
+    {
+      form_.ActionOfGradientTranspose(df, dx, which_argument);
+    }
+
+    /// @brief syntactic sugar:  df_dx.Mult(dx, df)  <=>  mfem::Vector df = df_dx(dx);
+    mfem::Vector& operator()(const mfem::Vector& dx)
+    {
+      form_.ActionOfGradient(dx, df_, which_argument);
+      return df_;
+    }
+
+    /**
+     * @brief assemble element matrices and form an mfem::HypreParMatrix
+     *
+     * @note for ExecutionSpace::GPU, the element matrices are assembled on the device (see device_local_values()),
+     * and the matrix is formed wherever hypre keeps its matrices, i.e. on the device for GPU-enabled builds of hypre
+     */
+    std::unique_ptr<mfem::HypreParMatrix> assemble()
+    {
+      SERAC_TIME_SCOPE("Functional assemblies");
+
+      if constexpr (exec == ExecutionSpace::GPU) {
+        auto K = form_matrix(device_local_values({{1.0, this}}));
+        constrain_matrix(*K);
+        return K;
+      } else {
+        double* values = new double[lookup_tables().nnz]{};
+
+        assemble_local_values(values);
+        constrain_local_values(values);
+
+        auto K = form_matrix(values);
+        constrain_matrix(*K);
+        return K;
+      }
+    };
+
+    /**
+     * @brief assemble element matrices into `K`, reusing its sparsity pattern and parallel layout when possible
+     *
+     * If `K` holds the matrix produced by the previous call to this function, then only its numerical values are
+     * refreshed in place: no memory is allocated, and its row/column partitioning and communication package are
+     * kept. Otherwise (or when the function spaces don't support it, e.g. nonconforming meshes or Hcurl spaces),
+     * a new matrix is assembled with `assemble()` and stored in `K`.
+     *
+     * @param K the matrix to assemble into
+     */
+    void assemble(std::unique_ptr<mfem::HypreParMatrix>& K) { assemble_terms({{1.0, this}}, K); }
+
+    /**
+     * @brief compute the diagonal of the gradient, without assembling a sparse matrix
+     *
+     * The diagonals of the element matrices are scattered into the local dofs with the test space's
+     * element restriction, and then summed into the true dofs with the transpose of the prolongation.
+     *
+     * @param diag the diagonal entries of df_dx (one per true dof)
+     * @note this requires the test and trial spaces to be the same. For nonconforming meshes, the result
+     * is only an approximation of the assembled diagonal (as with mfem's partial assembly)
+     */
+    void AssembleDiagonal(mfem::Vector& diag) const override
+    {
+      SLIC_ERROR_ROOT_IF(test_space_ != trial_space_, "AssembleDiagonal() requires identical test and trial spaces");
+
+      element_gradients_t element_gradients[Integral::num_types];
+
+      compute_element_gradients(element_gradients);
+      memory::Tracker element_matrix_memory(memory::Subsystem::Matrices);
+      element_matrix_memory.set(element_matrix_bytes(element_gradients));
+
+      form_.output_L_ = 0.0;
+      double* diag_L  = form_.output_L_.HostReadWrite();
+      for (auto type : Integral::Types) {
+        for (auto& [geom, elem_matrices] : element_gradients[type]) {
+          const auto& restriction = form_.G_test_[type].restrictions.at(geom);
+          const auto  num_elems   = restriction.num_elements;
+          const auto  dofs        = restriction.ValuesPerElement();
+          const auto* K_e         = elem_matrices.data();
+
+          // the E-vector and the element matrices use the same (component-major) ordering of element dofs
+          const uint64_t      entries = uint64_t(elem_matrices.size()) / num_elems;
+          std::vector<double> diag_e(num_elems * dofs);
+          for (uint64_t e = 0; e < num_elems; e++) {
+            for (uint64_t i = 0; i < dofs; i++) {
+              uint64_t ii = symmetric() ? detail::upper_triangle_index(uint32_t(dofs), uint32_t(i), uint32_t(i))
+                                        : i * dofs + i;
+              diag_e[e * dofs + i] = K_e[e * entries + ii];
+            }
+          }
+
+          restriction.ScatterAdd(diag_e.data(), diag_L, 0, num_elems);
+        }
+      }
+
+      diag.SetSize(Height());
+      form_.P_test_->MultTranspose(form_.output_L_, diag);
+    }
+
+    friend auto assemble(Gradient& g) { return g.assemble(); }
+
+    /// @overload
+    friend void assemble(Gradient& g, std::unique_ptr<mfem::HypreParMatrix>& K) { g.assemble(K); }
+
+    /**
+     * @brief assemble the linear combination `alpha * a + beta * b` of two gradients into `K`
+     *
+     * The element matrices of both gradients are summed into the same CSR values array, so only the combined
+     * matrix is ever formed (e.g. `M + dt * K` for a transient problem). Like `assemble(g, K)`, the values of `K`
+     * are refreshed in place when it holds the matrix produced by the previous call.
+     *
+     * @param alpha the coefficient of `a`
+     * @param a the gradient w.r.t. one argument
+     * @param beta the coefficient of `b`
+     * @param b the gradient w.r.t. another argument of the same Functional, on the same trial space as `a`
+     * @param K the matrix to assemble into
+     * @note to evaluate the q-function derivatives of both gradients in a single pass, differentiate w.r.t.
+     * both arguments in the same call, e.g. `f(differentiate_wrt(u), differentiate_wrt(du_dt))`
+     */
+    friend void assemble(double alpha, Gradient& a, double beta, Gradient& b, std::unique_ptr<mfem::HypreParMatrix>& K)
+    {
+      SLIC_ERROR_ROOT_IF(&a.form_ != &b.form_ || a.trial_space_ != b.trial_space_,
+                         "Only gradients of the same Functional w.r.t. arguments on the same space can be combined");
+      a.assemble_terms({{alpha, &a}, {beta, &b}}, K);
+    }
+
+    /// @overload
+    friend std::unique_ptr<mfem::HypreParMatrix> assemble(double alpha, Gradient& a, double beta, Gradient& b)
+    {
+      std::unique_ptr<mfem::HypreParMatrix> K;
+      assemble(alpha, a, beta, b, K);
+      return K;
+    }
+
+    /**
+     * @brief compute the values of the rank-local sparse matrix (before forming the parallel matrix), e.g. to
+     * cache a term of a linear combination that doesn't change between assemblies
+     *
+     * @return the CSR values, in the sparsity pattern shared by every gradient on this trial space
+     */
+    std::vector<double> local_values()
+    {
+      std::vector<double> values(lookup_tables().nnz, 0.0);
+      assemble_local_values(values.data());
+      return values;
+    }
+
+    /**
+     * @brief compute the upper triangle (including the diagonal) of the rank-local sparse matrix, e.g. for solvers
+     * that take symmetric matrices in symmetric storage
+     *
+     * @return the upper triangle of the matrix whose values are given by `local_values()`, in the local (L-dof)
+     * numbering of the test and trial spaces
+     * @note this requires the test and trial spaces to be the same
+     */
+    std::unique_ptr<mfem::SparseMatrix> local_upper_triangle()
+    {
+      SLIC_ERROR_ROOT_IF(test_space_ != trial_space_,
+                         "local_upper_triangle() requires identical test and trial spaces");
+
+      const auto&         tables = lookup_tables();
+      std::vector<double> values(tables.nnz, 0.0);
+      assemble_local_values(values.data());
+
+      const int num_rows = int(tables.row_ptr.size()) - 1;
+      int*      row_ptr  = new int[std::size_t(num_rows) + 1];
+      row_ptr[0]         = 0;
+      for (int row = 0; row < num_rows; row++) {
+        int count = 0;
+        for (int k = tables.row_ptr[std::size_t(row)]; k < tables.row_ptr[std::size_t(row) + 1]; k++) {
+          count += (tables.col_ind[std::size_t(k)] >= row);
+        }
+        row_ptr[row + 1] = row_ptr[row] + count;
+      }
+
+      int*    col_ind       = new int[std::size_t(row_ptr[num_rows])];
+      double* upper_values  = new double[std::size_t(row_ptr[num_rows])];
+      int     upper_nonzero = 0;
+      for (int row = 0; row < num_rows; row++) {
+        for (int k = tables.row_ptr[std::size_t(row)]; k < tables.row_ptr[std::size_t(row) + 1]; k++) {
+          if (tables.col_ind[std::size_t(k)] >= row) {
+            col_ind[upper_nonzero]      = tables.col_ind[std::size_t(k)];
+            upper_values[upper_nonzero] = values[std::size_t(k)];
+            upper_nonzero++;
+          }
+        }
+      }
+
+      // the matrix takes ownership of (and frees) the CSR arrays
+      return std::make_unique<mfem::SparseMatrix>(row_ptr, col_ind, upper_values, num_rows, num_rows);
+    }
+
+    /**
+     * @brief assemble the element matrices into a block sparse matrix, with a dense block for each pair of coupled
+     * nodes (e.g. 3 x 3 blocks for the displacement field of a 3D solid), rather than a scalar sparse matrix
+     *
+     * The lookup tables and column indices then only have one entry per block, and the action of the result is
+     * that of the (constrained) matrix from `assemble()`, without forming a parallel matrix.
+     *
+     * @return the operator on the true dofs, whose rank-local block sparse matrix is available through
+     * ParBlockSparseMatrix::LocalMatrix() (and BlockSparseMatrix::ToSparseMatrix(), for its scalar version)
+     * @note this requires spaces whose dofs have no sign flips (e.g. H1 or L2, but not Hcurl)
+     */
+    std::unique_ptr<ParBlockSparseMatrix> assemble_blocks()
+    {
+      const auto& tables = block_lookup_tables();
+      auto        local  = std::make_unique<BlockSparseMatrix>(tables.pattern, test_space_->GetVDim(),
+                                                               trial_space_->GetVDim(), test_space_->GetOrdering(),
+                                                               trial_space_->GetOrdering());
+
+      element_gradients_t element_gradients[Integral::num_types];
+
+      compute_element_gradients(element_gradients);
+      memory::Tracker element_matrix_memory(memory::Subsystem::Matrices);
+      element_matrix_memory.set(element_matrix_bytes(element_gradients));
+
+      // each (trial node, test node) pair of an element adds its components' couplings to one block
+      SERAC_PROFILE_SCOPE("Functional::block_assembly");
+      double* values = local->Values();
+      for (auto type : Integral::Types) {
+        for (auto& [geom, elem_matrices] : element_gradients[type]) {
+          const auto& blocks            = tables.element_block_LUT[type].at(geom);
+          const auto& test_restriction  = form_.G_test_[type].restrictions.at(geom);
+          const auto& trial_restriction = form_.G_trial_[type][which_argument].restrictions.at(geom);
+          const auto  num_elems         = test_restriction.num_elements;
+          const auto  nt                = test_restriction.nodes_per_elem;
+          const auto  nr                = trial_restriction.nodes_per_elem;
+          const auto  ct                = test_restriction.components;
+          const auto  cr                = trial_restriction.components;
+          const auto  test_dofs         = nt * ct;
+          const auto  entries           = uint64_t(elem_matrices.size()) / num_elems;
+          const auto* K_e               = elem_matrices.data();
+
+          // element matrix entry (R, S), for symmetric gradients from the upper triangle (see SetSymmetricGradient())
+          auto entry = [&](uint64_t e, uint64_t R, uint64_t S) {
+            if (!symmetric()) return K_e[e * entries + R * test_dofs + S];
+            uint32_t i = uint32_t(std::min(R, S));
+            uint32_t j = uint32_t(std::max(R, S));
+            return K_e[e * entries + detail::upper_triangle_index(uint32_t(test_dofs), i, j)];
+          };
+
+          for (uint64_t e = 0; e < num_elems; e++) {
+            for (uint64_t J = 0; J < nr; J++) {
+              for (uint64_t I = 0; I < nt; I++) {
+                double* block = values + uint64_t(blocks[(e * nr + J) * nt + I]) * ct * cr;
+                for (uint64_t ci = 0; ci < ct; ci++) {
+                  for (uint64_t cj = 0; cj < cr; cj++) {
+                    block[ci * cr + cj] += entry(e, cj * nr + J, ci * nt + I);
+                  }
+                }
+              }
+            }
+          }
+        }
+      }
+
+      const mfem::Array<int> no_constraints;
+      return std::make_unique<ParBlockSparseMatrix>(
+          std::move(local), *form_.P_test_, *form_.P_trial_[which_argument],
+          form_.constrain_essential_dofs ? form_.essential_true_dofs_ : no_constraints, test_space_ == trial_space_);
+    }
+
+    /**
+     * @brief assemble only the couplings between the same components of the test and trial spaces, i.e. the
+     * diagonal entries of each node-pair block of `assemble_blocks()`, into a parallel matrix
+     *
+     * For the displacement field of a solid, this is the "separate displacement component" approximation of its
+     * stiffness: a block diagonal matrix with a (scalar) block per component, which has 1 / vdim of the nonzeros
+     * of the full gradient and, set up with the systems options of BoomerAMG, a much cheaper AMG hierarchy. It is
+     * meant as the matrix of a preconditioner, while the linear solver applies the full gradient.
+     *
+     * @return the matrix on the true dofs, with the essential rows and columns eliminated (and a unit diagonal on
+     * them) if the gradient is constrained
+     * @note this requires test and trial spaces with the same number of components, ordered by nodes, and whose
+     * dofs have no sign flips (e.g. H1 or L2, but not Hcurl)
+     */
+    std::unique_ptr<mfem::HypreParMatrix> assemble_component_blocks()
+    {
+      SLIC_ERROR_ROOT_IF(test_space_->GetVDim() != trial_space_->GetVDim() ||
+                             test_space_->GetOrdering() != mfem::Ordering::byNODES ||
+                             trial_space_->GetOrdering() != mfem::Ordering::byNODES,
+                         "assembling the component blocks of a gradient requires test and trial spaces with the same "
+                         "number of components, ordered by nodes");
+
+      const auto& pattern    = *block_lookup_tables().pattern;
+      const auto& blocks_LUT = block_lookup_tables().element_block_LUT;
+      const int   vdim       = trial_space_->GetVDim();
+      const int   num_blocks = pattern.NumBlocks();
+
+      // component c of test node n is row c * num_rows + n (and likewise for the columns), so each component's
+      // values are a copy of the node sparsity pattern, stored one component after the other
+      const int num_rows = vdim * pattern.num_rows;
+      int*      row_ptr  = new int[std::size_t(num_rows) + 1];
+      int*      col_ind  = new int[std::size_t(vdim * num_blocks)];
+      double*   values   = new double[std::size_t(vdim * num_blocks)]();
+      row_ptr[0]         = 0;
+      for (int c = 0; c < vdim; c++) {
+        for (int n = 0; n < pattern.num_rows; n++) {
+          row_ptr[c * pattern.num_rows + n + 1] = c * num_blocks + pattern.row_ptr[std::size_t(n) + 1];
+        }
+        for (int k = 0; k < num_blocks; k++) {
+          col_ind[c * num_blocks + k] = c * pattern.num_columns + pattern.col_ind[std::size_t(k)];
+        }
+      }
+
+      element_gradients_t element_gradients[Integral::num_types];
+
+      compute_element_gradients(element_gradients);
+      memory::Tracker element_matrix_memory(memory::Subsystem::Matrices);
+      element_matrix_memory.set(element_matrix_bytes(element_gradients));
+
+      // the entries of the element matrices between different components are skipped
+      SERAC_PROFILE_SCOPE("Functional::component_block_assembly");
+      for (auto type : Integral::Types) {
+        for (auto& [geom, elem_matrices] : element_gradients[type]) {
+          const auto& blocks            = blocks_LUT[type].at(geom);
+          const auto& test_restriction  = form_.G_test_[type].restrictions.at(geom);
+          const auto& trial_restriction = form_.G_trial_[type][which_argument].restrictions.at(geom);
+          const auto  num_elems         = test_restriction.num_elements;
+          const auto  nt                = test_restriction.nodes_per_elem;
+          const auto  nr                = trial_restriction.nodes_per_elem;
+          const auto  test_dofs         = nt * test_restriction.components;
+          const auto  entries           = uint64_t(elem_matrices.size()) / num_elems;
+          const auto* K_e               = elem_matrices.data();
+
+          // element matrix entry (R, S), for symmetric gradients from the upper triangle (see SetSymmetricGradient())
+          auto entry = [&](uint64_t e, uint64_t R, uint64_t S) {
+            if (!symmetric()) return K_e[e * entries + R * test_dofs + S];
+            uint32_t i = uint32_t(std::min(R, S));
+            uint32_t j = uint32_t(std::max(R, S));
+            return K_e[e * entries + detail::upper_triangle_index(uint32_t(test_dofs), i, j)];
+          };
+
+          for (uint64_t e = 0; e < num_elems; e++) {
+            for (uint64_t J = 0; J < nr; J++) {
+              for (uint64_t I = 0; I < nt; I++) {
+                const uint64_t block = uint64_t(blocks[(e * nr + J) * nt + I]);
+                for (uint64_t c = 0; c < uint64_t(vdim); c++) {
+                  values[c * uint64_t(num_blocks) + block] += entry(e, c * nr + J, c * nt + I);
+                }
+              }
+            }
+          }
+        }
+      }
+
+      // the matrix takes ownership of (and frees) the CSR arrays
+      mfem::SparseMatrix J_local(row_ptr, col_ind, values, num_rows, vdim * pattern.num_columns);
+
+      auto* A =
+          new mfem::HypreParMatrix(test_space_->GetComm(), test_space_->GlobalVSize(), trial_space_->GlobalVSize(),
+                                   test_space_->GetDofOffsets(), trial_space_->GetDofOffsets(), &J_local);
+
+      // the prolongations of spaces ordered by nodes don't couple different components either
+      std::unique_ptr<mfem::HypreParMatrix> K(
+          mfem::RAP(test_space_->Dof_TrueDof_Matrix(), A, trial_space_->Dof_TrueDof_Matrix()));
+      delete A;
+
+      if (form_.constrain_essential_dofs) {
+        if (test_space_ == trial_space_) {
+          K->EliminateBC(form_.essential_true_dofs_, mfem::Operator::DiagonalPolicy::DIAG_ONE);
+        } else {
+          K->EliminateRows(form_.essential_true_dofs_);
+        }
+      }
+
+      return K;
+    }
+
+    /**
+     * @brief assemble the linear combination `alpha * A + beta * b` into `K`, where `A` is a previously computed
+     * (e.g. cached mass) term, given by its rank-local values
+     *
+     * @param alpha the coefficient of `A`
+     * @param A_values the rank-local values of `A`, from `local_values()` of a gradient on the same trial space as `b`
+     * @param beta the coefficient of `b`
+     * @param b the gradient to evaluate
+     * @param K the matrix to assemble into (refreshed in place when it holds the matrix produced by the previous call)
+     */
+    friend void assemble(double alpha, const std::vector<double>& A_values, double beta, Gradient& b,
+                         std::unique_ptr<mfem::HypreParMatrix>& K)
+    {
+      SLIC_ERROR_ROOT_IF(A_values.size() != b.lookup_tables().nnz,
+                         "The cached values don't match the sparsity pattern of the gradient they're combined with");
+      b.assemble_terms({{beta, &b}}, K, {alpha, &A_values});
+    }
+
+  private:
+    /**
+     * @brief assemble a linear combination of gradients (sharing this gradient's sparsity pattern) into `K`,
+     * reusing `K` in place when it holds the matrix produced by the previous call
+     *
+     * @param terms the coefficient and gradient of each term
+     * @param K the matrix to assemble into
+     * @param cached an optional term, given by its coefficient and rank-local values
+     */
+    void assemble_terms(std::initializer_list<std::pair<double, Gradient*>> terms,
+                        std::unique_ptr<mfem::HypreParMatrix>&               K,
+                        std::pair<double, const std::vector<double>*>        cached = {0.0, nullptr})
     {
+      SERAC_TIME_SCOPE("Functional assemblies");
+
+      if constexpr (exec == ExecutionSpace::GPU) {
+        // the values are assembled on the device, so there is no host copy of them to refresh in place
+        K = form_matrix(device_local_values(terms, cached));
+        constrain_matrix(*K);
+        return;
+      }
+
+      auto& in_place = *in_place_;
+
+      auto accumulate = [&](double* values) {
+        for (auto [scale, gradient] : terms) {
+          gradient->assemble_local_values(values, scale);
+        }
+        if (auto [scale, cached_values] = cached; cached_values) {
+          for (std::size_t i = 0; i < cached_values->size(); i++) {
+            values[i] += scale * (*cached_values)[i];
+          }
+        }
+        constrain_local_values(values);
+      };
+
+      bool reuse = K && (K.get() == in_place.matrix) && in_place.assembly && in_place.assembly->matches(*K);
+
+      if (!reuse) {
+        double* values = new double[lookup_tables().nnz]{};
+        accumulate(values);
+
+        K               = form_matrix(values);
+        in_place.matrix = K.get();
+        in_place.assembly.reset();
+        if (InPlaceAssembly::isSupported(*test_space_, *trial_space_)) {
+          in_place.assembly = std::make_unique<InPlaceAssembly>(*test_space_, *trial_space_, lookup_tables().row_ptr,
+                                                                lookup_tables().col_ind, *K);
+          if (!in_place.assembly->valid()) {
+            in_place.assembly.reset();
+          }
+        }
+        constrain_matrix(*K);
+        return;
+      }
+
+      in_place.local_values.assign(lookup_tables().nnz, 0.0);
+      accumulate(in_place.local_values.data());
+      in_place.assembly->update(in_place.local_values.data(), *K);
+      constrain_matrix(*K);
     }
 
     /**
-     * @brief implement that action of the gradient: df := df_dx * dx
-     * @param[in] dx a small perturbation in the trial space
-     * @param[in] df the resulting small perturbation in the residuals
+     * @brief whether the constraints can be applied to the rank-local sparse matrix, which requires each local dof
+     * to be a copy of a single true dof (so, not on nonconforming meshes)
      */
-    virtual void Mult(const mfem::Vector& dx, mfem::Vector& df) const override
+    bool constrains_local_values() const { return !test_space_->Nonconforming() && !trial_space_->Nonconforming(); }
+
+    /**
+     * @brief zero the values of the rank-local sparse matrix in the rows (and, for gradients w.r.t. an argument on
+     * the test space, the columns) of the constrained dofs, see Functional::SetEssentialTrueDofs()
+     *
+     * @param values the CSR values (in the sparsity pattern described by `lookup_tables()`)
+     */
+    void constrain_local_values(double* values)
     {
-      form_.ActionOfGradient(dx, df, which_argument);
+      if (!form_.constrain_essential_dofs || !constrains_local_values()) return;
+
+      update_constrained_values();
+      for (int k : constrained_values_->indices) {
+        values[k] = 0.0;
+      }
     }
 
-    /// @brief syntactic sugar:  df_dx.Mult(dx, df)  <=>  mfem::Vector df = df_dx(dx);
-    mfem::Vector& operator()(const mfem::Vector& dx)
+    /// @brief recompute the indices of the values zeroed by constrain_local_values(), if the constraints changed
+    void update_constrained_values()
     {
-      form_.ActionOfGradient(dx, df_, which_argument);
-      return df_;
+      auto& constrained = *constrained_values_;
+      if (constrained.version != form_.essential_dofs_version_) {
+        const auto& tables          = lookup_tables();
+        const auto& constrained_dof = form_.essential_local_dofs_;
+        const bool  square          = (trial_space_ == test_space_);
+
+        constrained.indices.clear();
+        if (!constrained_dof.empty()) {
+          for (std::size_t row = 0; row + 1 < tables.row_ptr.size(); row++) {
+            for (int k = tables.row_ptr[row]; k < tables.row_ptr[row + 1]; k++) {
+              if (constrained_dof[row] || (square && constrained_dof[std::size_t(tables.col_ind[std::size_t(k)])])) {
+                constrained.indices.push_back(k);
+              }
+            }
+          }
+        }
+        if constexpr (exec == ExecutionSpace::GPU) {
+          constrained.device_indices.SetSize(int(constrained.indices.size()));
+          std::copy(constrained.indices.begin(), constrained.indices.end(), constrained.device_indices.HostWrite());
+        }
+        constrained.version = form_.essential_dofs_version_;
+      }
     }
 
-    /// @brief assemble element matrices and form an mfem::HypreParMatrix
-    std::unique_ptr<mfem::HypreParMatrix> assemble()
+    /**
+     * @brief finish constraining an assembled gradient: puts a unit diagonal in the constrained rows of gradients
+     * w.r.t. an argument on the test space (whose rows and columns were zeroed by constrain_local_values()), or
+     * eliminates the constrained rows and columns directly where the local values couldn't be constrained
+     *
+     * @param K the assembled gradient
+     */
+    void constrain_matrix(mfem::HypreParMatrix& K)
+    {
+      if (!form_.constrain_essential_dofs) return;
+
+      const auto& dofs   = form_.essential_true_dofs_;
+      const bool  square = (trial_space_ == test_space_);
+
+      if (!constrains_local_values()) {
+        if (square) {
+          K.EliminateBC(dofs, mfem::Operator::DiagonalPolicy::DIAG_ONE);
+        } else {
+          K.EliminateRows(dofs);
+        }
+        return;
+      }
+
+      if (!square) return;
+
+      mfem::SparseMatrix diag;
+      K.GetDiag(diag);
+
+      if constexpr (exec == ExecutionSpace::GPU) {
+        // the diagonal entries are set wherever hypre keeps the matrix, rather than on a host copy of it
+        const int* row_ptr = diag.ReadI();
+        const int* col_ind = diag.ReadJ();
+        double*    values  = diag.ReadWriteData();
+        const int* dof     = dofs.Read();
+        accelerator::forall<exec>(uint32_t(dofs.Size()), [=] SERAC_HOST_DEVICE(uint32_t i) {
+          for (int k = row_ptr[dof[i]]; k < row_ptr[dof[i] + 1]; k++) {
+            if (col_ind[k] == dof[i]) values[k] = 1.0;
+          }
+        });
+        return;
+      }
+
+      const int* row_ptr = diag.GetI();
+      const int* col_ind = diag.GetJ();
+      double*    values  = diag.GetData();
+      for (int dof : dofs) {
+        int k = row_ptr[dof];
+        while (k < row_ptr[dof + 1] && col_ind[k] != dof) k++;
+        SLIC_ERROR_IF(k == row_ptr[dof + 1], "constrained dof is missing its diagonal entry in the gradient");
+        values[k] = 1.0;
+      }
+    }
+
+    /**
+     * @brief form the parallel matrix from the values of the rank-local sparse matrix
+     *
+     * @param values the CSR values (in the sparsity pattern described by `lookup_tables()`), whose ownership is
+     * passed to this function
+     */
+    std::unique_ptr<mfem::HypreParMatrix> form_matrix(double* values)
     {
+      constexpr bool memory_owns_values = true;
+      return form_matrix(mfem::Memory<double>(values, int(lookup_tables().nnz), memory_owns_values));
+    }
+
+    /**
+     * @overload
+     * @note the values may live on the device, in which case a GPU-enabled build of hypre forms the matrix there
+     */
+    std::unique_ptr<mfem::HypreParMatrix> form_matrix(mfem::Memory<double> values)
+    {
+      SERAC_MARK_FUNCTION;
       // the CSR graph (sparsity pattern) is reusable, so we cache
       // that and ask mfem to not free that memory in ~SparseMatrix()
       constexpr bool sparse_matrix_frees_graph_ptrs = false;
 
-      // the CSR values are NOT reusable, so we pass ownership of
-      // them to the mfem::SparseMatrix, to be freed in ~SparseMatrix()
-      constexpr bool sparse_matrix_frees_values_ptr = true;
+      // the CSR values are NOT reusable, so ownership of them is passed (through `values`, after the
+      // matrix is created without any) to the mfem::SparseMatrix, to be freed in ~SparseMatrix()
+      constexpr bool sparse_matrix_frees_values_ptr = false;
 
       constexpr bool col_ind_is_sorted = true;
 
-      double* values = new double[lookup_tables.nnz]{};
+      // Copy the column indices to an auxilliary array as MFEM can mutate these during HypreParMatrix construction
+      col_ind_copy_ = lookup_tables().col_ind;
+
+      auto J_local =
+          mfem::SparseMatrix(lookup_tables().row_ptr.data(), col_ind_copy_.data(), nullptr, form_.output_L_.Size(),
+                             form_.input_L_[which_argument].Size(), sparse_matrix_frees_graph_ptrs,
+                             sparse_matrix_frees_values_ptr, col_ind_is_sorted);
+      J_local.GetMemoryData() = values;
+
+      auto* R = form_.test_space_->Dof_TrueDof_Matrix();
+
+      auto* A =
+          new mfem::HypreParMatrix(test_space_->GetComm(), test_space_->GlobalVSize(), trial_space_->GlobalVSize(),
+                                   test_space_->GetDofOffsets(), trial_space_->GetDofOffsets(), &J_local);
+
+      auto* P = trial_space_->Dof_TrueDof_Matrix();
+
+      std::unique_ptr<mfem::HypreParMatrix> K(mfem::RAP(R, A, P));
+
+      delete A;
+
+      // the matrix is owned by the caller, so this accounts for (only) the most recently formed one
+      mfem::SparseMatrix diag, offd;
+      HYPRE_BigInt*      offd_columns;
+      K->GetDiag(diag);
+      K->GetOffd(offd, offd_columns);
+      std::size_t nonzeros = std::size_t(diag.NumNonZeroElems() + offd.NumNonZeroElems());
+      matrix_memory_.set((sizeof(double) + sizeof(int)) * nonzeros + sizeof(int) * std::size_t(2 * diag.Height() + 2));
+
+      return K;
+    }
+
+    /// @brief the element matrices for each kind of element geometry
+    using element_gradients_t = std::map<mfem::Geometry::Type, ExecArray<double, 3, exec>>;
+
+    /**
+     * @brief compute the element matrices and sum them into the values of the
+     * rank-local sparse matrix (in the sparsity pattern described by `lookup_tables()`)
+     *
+     * @param values the CSR values array to accumulate into (of size `lookup_tables().nnz`)
+     * @param scale the factor the element matrices are multiplied by
+     */
+    void assemble_local_values(double* values, double scale = 1.0)
+    {
+      element_gradients_t element_gradients[Integral::num_types];
+
+      compute_element_gradients(element_gradients);
+      memory::Tracker element_matrix_memory(memory::Subsystem::Matrices);
+      element_matrix_memory.set(element_matrix_bytes(element_gradients));
+
+      // each element matrix entry has a precomputed destination (and sign) in the CSR values array,
+      // so assembly is just a streaming scatter-add over the element matrices
+      //
+      // note: the element matrices are stored as K_elem(e, trial dof, test dof), since the element
+      //       gradient kernel output is actually transposed, as a result of being row-major storage.
+      SERAC_PROFILE_SCOPE("Functional::assembly");
+      for (auto type : Integral::Types) {
+        for (auto& [geom, elem_matrices] : element_gradients[type]) {
+          const auto& nonzeros         = lookup_tables().element_nonzero_LUT[type].at(geom);
+          const auto& test_restriction = form_.G_test_[type].restrictions.at(geom);
+          const auto  num_elems        = uint64_t(elem_matrices.shape()[0]);
+          const auto  dofs             = uint64_t(test_restriction.ValuesPerElement());
+          const auto  values_per_elem  = (num_elems > 0) ? nonzeros.size() / num_elems : 0;
+          const auto  stored_per_elem  = symmetric() ? detail::upper_triangle_size(uint32_t(dofs)) : values_per_elem;
+          const bool  upper_triangles  = symmetric();
+
+          auto add_element = [&, K = elem_matrices.data()](uint64_t e) {
+            const SignedIndex* element_nonzeros = nonzeros.data() + e * values_per_elem;
+            const double*      K_e              = K + e * stored_per_elem;
+            if (!upper_triangles) {
+              for (uint64_t k = 0; k < values_per_elem; k++) {
+                values[element_nonzeros[k].index_] += scale * element_nonzeros[k].sign_ * K_e[k];
+              }
+              return;
+            }
+
+            // each entry of the upper triangles is added to both of the nonzeros it stands for
+            for (uint64_t i = 0; i < dofs; i++) {
+              for (uint64_t j = i; j < dofs; j++) {
+                double K_ij = scale * (*K_e++);
+                values[element_nonzeros[i * dofs + j].index_] += element_nonzeros[i * dofs + j].sign_ * K_ij;
+                if (j != i) {
+                  values[element_nonzeros[j * dofs + i].index_] += element_nonzeros[j * dofs + i].sign_ * K_ij;
+                }
+              }
+            }
+          };
+
+#if defined(SERAC_USE_OPENMP) && defined(_OPENMP)
+          // the rows of an element's nonzeros are its test dofs, so elements of the same color (which share no
+          // test nodes, see ElementRestriction::element_colors) add into disjoint nonzeros, without atomics
+          for (const auto& elements : *test_restriction.element_colors) {
+            const uint32_t* ids = elements.data();
+            int64_t         n   = int64_t(elements.size());
+
+            SERAC_OMP_PARALLEL_FOR
+            for (int64_t k = 0; k < n; k++) {
+              add_element(ids[k]);
+            }
+          }
+#else
+          for (uint64_t e = 0; e < num_elems; e++) {
+            add_element(e);
+          }
+#endif
+        }
+      }
+    }
+
+    /**
+     * @brief the counterpart of assemble_local_values() (followed by constrain_local_values()) for
+     * ExecutionSpace::GPU: the element matrices are scatter-added straight from device memory into CSR values that
+     * are allocated on the device, through copies of the lookup tables that are only moved there once (see
+     * device_lookup_tables()), so the values are handed to hypre without a round trip through the host
+     *
+     * @param terms the coefficient and gradient of each term (sharing this gradient's sparsity pattern)
+     * @param cached an optional term, given by its coefficient and rank-local values (on the host)
+     */
+    mfem::Memory<double> device_local_values(std::initializer_list<std::pair<double, Gradient*>> terms,
+                                             std::pair<double, const std::vector<double>*> cached = {0.0, nullptr})
+    {
+      SERAC_PROFILE_SCOPE("Functional::device_assembly");
+      const uint32_t nnz = lookup_tables().nnz;
+
+      mfem::Memory<double> values(int(nnz), mfem::Device::GetDeviceMemoryType());
+      double*              V = values.Write(mfem::Device::GetDeviceMemoryClass(), int(nnz));
+      accelerator::forall<exec>(nnz, [=] SERAC_HOST_DEVICE(uint32_t k) { V[k] = 0.0; });
+
+      for (auto [scale, gradient] : terms) {
+        gradient->scatter_add_element_gradients(V, scale);
+      }
+
+      mfem::Vector cached_values;
+      if (cached.second) {
+        cached_values.SetDataAndSize(const_cast<double*>(cached.second->data()), int(cached.second->size()));
+        const double  scale = cached.first;
+        const double* C     = cached_values.Read();
+        accelerator::forall<exec>(nnz, [=] SERAC_HOST_DEVICE(uint32_t k) { V[k] += scale * C[k]; });
+      }
+
+      if (form_.constrain_essential_dofs && constrains_local_values()) {
+        update_constrained_values();
+        const auto& indices = constrained_values_->device_indices;
+        const int*  I       = indices.Read();
+        accelerator::forall<exec>(uint32_t(indices.Size()), [=] SERAC_HOST_DEVICE(uint32_t i) { V[I[i]] = 0.0; });
+      }
+
+      return values;
+    }
+
+    /**
+     * @brief compute the element matrices in the execution space, and scatter-add them into the CSR values there
+     *
+     * @param V the CSR values (in the memory of the execution space) to accumulate into
+     * @param scale the factor the element matrices are multiplied by
+     */
+    void scatter_add_element_gradients(double* V, double scale)
+    {
+      element_gradients_t element_gradients[Integral::num_types];
+
+      compute_element_gradients(element_gradients);
+      memory::Tracker element_matrix_memory(memory::Subsystem::Matrices);
+      element_matrix_memory.set(element_matrix_bytes(element_gradients));
 
-      std::map<mfem::Geometry::Type, ExecArray<double, 3, exec>> element_gradients[Integral::num_types];
+      const auto& tables = device_lookup_tables();
+      for (auto type : Integral::Types) {
+        for (auto& [geom, elem_matrices] : element_gradients[type]) {
+          // neighboring elements share nonzeros, so their contributions are added atomically
+          const auto&   nonzeros = tables.element_nonzero_LUT[type].at(geom);
+          const int*    LUT      = nonzeros.Read();
+          const double* K_e      = elem_matrices.data();
+          accelerator::forall<exec>(uint32_t(nonzeros.Size()), [=] SERAC_HOST_DEVICE(uint32_t k) {
+            int i = LUT[k];
+            if (i >= 0) {
+              accelerator::atomic_add(V + i, scale * K_e[k]);
+            } else {
+              accelerator::atomic_add(V + (-1 - i), -scale * K_e[k]);
+            }
+          });
+        }
+      }
+    }
 
+    /**
+     * @brief evaluate the element matrices of every integral, summing the contributions
+     * of integrals defined over the same kind of domain
+     *
+     * @param element_gradients the element matrices, K_elem(e, trial dof, test dof), for each integral type (or their
+     * upper triangles, K_elem(e, 0, entry), for symmetric gradients)
+     */
+    void compute_element_gradients(element_gradients_t (&element_gradients)[Integral::num_types]) const
+    {
+      SERAC_MARK_FUNCTION;
       for (auto& integral : form_.integrals_) {
+        // note: this also avoids creating element matrices for (interior face) restrictions that don't exist
+        if (integral.functional_to_integral_index_.count(which_argument) == 0) continue;
+
         auto& K_elem             = element_gradients[integral.type];
         auto& test_restrictions  = form_.G_test_[integral.type].restrictions;
         auto& trial_restrictions = form_.G_trial_[integral.type][which_argument].restrictions;
@@ -543,88 +3442,151 @@ private:
           for (auto& [geom, test_restriction] : test_restrictions) {
             auto& trial_restriction = trial_restrictions[geom];
 
-            K_elem[geom] = ExecArray<double, 3, exec>(test_restriction.num_elements,
-                                                      trial_restriction.nodes_per_elem * trial_restriction.components,
-                                                      test_restriction.nodes_per_elem * test_restriction.components);
+            // the element matrices are reallocated for each assembly, so they come from the memory pool (if any)
+            uint64_t trial_dofs = trial_restriction.ValuesPerElement();
+            uint64_t test_dofs  = test_restriction.ValuesPerElement();
+            if (symmetric()) {
+              K_elem[geom] = accelerator::make_array<double, 3, exec>(
+                  test_restriction.num_elements, 1, detail::upper_triangle_size(uint32_t(test_dofs)));
+            } else {
+              K_elem[geom] =
+                  accelerator::make_array<double, 3, exec>(test_restriction.num_elements, trial_dofs, test_dofs);
+            }
 
             detail::zero_out(K_elem[geom]);
           }
         }
 
-        integral.ComputeElementGradients(K_elem, which_argument);
+        integral.ComputeElementGradients(K_elem, which_argument, symmetric());
+      }
+
+      if constexpr (exec == ExecutionSpace::Dynamic) {
+        // the element matrices of integrals on the device are assembled on the host
+        accelerator::synchronizeDevice();
       }
+    }
 
+    /// @brief whether the element matrices only hold their upper triangles, see Functional::SetSymmetricGradient()
+    bool symmetric() const { return exec == ExecutionSpace::CPU && form_.symmetric_gradient_[which_argument]; }
+
+    /// @brief the memory of the element matrices of every integral type
+    static std::size_t element_matrix_bytes(const element_gradients_t (&element_gradients)[Integral::num_types])
+    {
+      std::size_t bytes = 0;
       for (auto type : Integral::Types) {
-        auto& K_elem             = element_gradients[type];
-        auto& test_restrictions  = form_.G_test_[type].restrictions;
-        auto& trial_restrictions = form_.G_trial_[type][which_argument].restrictions;
-
-        if (!K_elem.empty()) {
-          for (auto [geom, elem_matrices] : K_elem) {
-            std::vector<DoF> test_vdofs(test_restrictions[geom].nodes_per_elem * test_restrictions[geom].components);
-            std::vector<DoF> trial_vdofs(trial_restrictions[geom].nodes_per_elem * trial_restrictions[geom].components);
-
-            for (axom::IndexType e = 0; e < elem_matrices.shape()[0]; e++) {
-              test_restrictions[geom].GetElementVDofs(e, test_vdofs);
-              trial_restrictions[geom].GetElementVDofs(e, trial_vdofs);
-
-              for (uint32_t i = 0; i < uint32_t(elem_matrices.shape()[1]); i++) {
-                int col = int(trial_vdofs[i].index());
-
-                for (uint32_t j = 0; j < uint32_t(elem_matrices.shape()[2]); j++) {
-                  int row = int(test_vdofs[j].index());
-
-                  int sign = test_vdofs[j].sign() * trial_vdofs[i].sign();
-
-                  // note: col / row appear backwards here, because the element matrix kernel
-                  //       is actually transposed, as a result of being row-major storage.
-                  //
-                  //       This is kind of confusing, and will be fixed in a future refactor
-                  //       of the element gradient kernel implementation
-                  [[maybe_unused]] auto nz = lookup_tables(row, col);
-                  values[lookup_tables(row, col)] += sign * elem_matrices(e, i, j);
-                }
-              }
-            }
-          }
+        for (const auto& [geom, elem_matrices] : element_gradients[type]) {
+          bytes += sizeof(double) * std::size_t(elem_matrices.size());
         }
       }
+      return bytes;
+    }
 
-      // Copy the column indices to an auxilliary array as MFEM can mutate these during HypreParMatrix construction
-      col_ind_copy_ = lookup_tables.col_ind;
+    /// @brief The "parent" @p Functional to calculate gradients with
+    Functional<test(trials...), exec>& form_;
 
-      auto J_local =
-          mfem::SparseMatrix(lookup_tables.row_ptr.data(), col_ind_copy_.data(), values, form_.output_L_.Size(),
-                             form_.input_L_[which_argument].Size(), sparse_matrix_frees_graph_ptrs,
-                             sparse_matrix_frees_values_ptr, col_ind_is_sorted);
+    /**
+     * @brief get the lookup tables for where to place each element and boundary element
+     *   gradient contribution in the global sparse matrix
+     *
+     * @note these are only needed for assembly, so they are built the first time they are used (rather than
+     *   when the Functional is created), and they are shared with the Gradients of any other arguments that
+     *   belong to the same finite element space, since those have identical element restrictions
+     */
+    const GradientAssemblyLookupTables& lookup_tables()
+    {
+      if (!lookup_tables_) {
+        for (auto& other : form_.grad_) {
+          if (other.lookup_tables_ && other.trial_space_ == trial_space_) {
+            lookup_tables_ = other.lookup_tables_;
+            return *lookup_tables_;
+          }
+        }
 
-      auto* R = form_.test_space_->Dof_TrueDof_Matrix();
+        std::array<const BlockElementRestriction*, Integral::num_types> test_dofs;
+        std::array<const BlockElementRestriction*, Integral::num_types> trial_dofs;
+        for (auto type : Integral::Types) {
+          test_dofs[type]  = &form_.G_test_[type];
+          trial_dofs[type] = &form_.G_trial_[type][which_argument];
+        }
+        lookup_tables_ = std::make_shared<const GradientAssemblyLookupTables>(test_dofs, trial_dofs);
+      }
+      return *lookup_tables_;
+    }
 
-      auto* A =
-          new mfem::HypreParMatrix(test_space_->GetComm(), test_space_->GlobalVSize(), trial_space_->GlobalVSize(),
-                                   test_space_->GetDofOffsets(), trial_space_->GetDofOffsets(), &J_local);
+    /// @brief the lookup tables for assembly, see lookup_tables()
+    std::shared_ptr<const GradientAssemblyLookupTables> lookup_tables_;
 
-      auto* P = trial_space_->Dof_TrueDof_Matrix();
+    /// @brief copies of the element-to-CSR maps of the assembly lookup tables that can be read on the device
+    struct DeviceLookupTables {
+      /// @brief `GradientAssemblyLookupTables::element_nonzero_LUT`, with each SignedIndex encoded as mfem does
+      std::map<mfem::Geometry::Type, mfem::Array<int>> element_nonzero_LUT[Integral::num_types];
 
-      std::unique_ptr<mfem::HypreParMatrix> K(mfem::RAP(R, A, P));
+      /// @brief the accounting of the memory of the tables
+      memory::Tracker tracker{memory::Subsystem::LookupTables};
+    };
 
-      delete A;
+    /// @brief get the lookup tables for device assembly (see device_local_values()), shared like lookup_tables()
+    const DeviceLookupTables& device_lookup_tables()
+    {
+      if (!device_lookup_tables_) {
+        for (auto& other : form_.grad_) {
+          if (other.device_lookup_tables_ && other.trial_space_ == trial_space_) {
+            device_lookup_tables_ = other.device_lookup_tables_;
+            return *device_lookup_tables_;
+          }
+        }
 
-      return K;
-    };
+        auto        tables = std::make_shared<DeviceLookupTables>();
+        std::size_t bytes  = 0;
+        for (auto type : Integral::Types) {
+          for (const auto& [geom, nonzeros] : lookup_tables().element_nonzero_LUT[type]) {
+            auto& LUT = tables->element_nonzero_LUT[type][geom];
+            LUT.SetSize(int(nonzeros.size()));
+            int* encoded = LUT.HostWrite();
+            for (std::size_t k = 0; k < nonzeros.size(); k++) {
+              int index  = int(nonzeros[k].index_);
+              encoded[k] = (nonzeros[k].sign_ > 0) ? index : -1 - index;
+            }
 
-    friend auto assemble(Gradient& g) { return g.assemble(); }
+            // move the table to the device now, rather than during the first assembly
+            LUT.Read();
+            bytes += sizeof(int) * nonzeros.size();
+          }
+        }
+        tables->tracker.set(bytes);
+        device_lookup_tables_ = tables;
+      }
+      return *device_lookup_tables_;
+    }
 
-  private:
-    /// @brief The "parent" @p Functional to calculate gradients with
-    Functional<test(trials...), exec>& form_;
+    /// @brief the lookup tables for device assembly, see device_lookup_tables()
+    std::shared_ptr<const DeviceLookupTables> device_lookup_tables_;
 
-    /**
-     * @brief this object has lookup tables for where to place each
-     *   element and boundary element gradient contribution in the global
-     *   sparse matrix
-     */
-    GradientAssemblyLookupTables lookup_tables;
+    /// @brief get the (node-level) lookup tables for block assembly, shared like those of lookup_tables()
+    const BlockAssemblyLookupTables& block_lookup_tables()
+    {
+      if (!block_lookup_tables_) {
+        for (auto& other : form_.grad_) {
+          if (other.block_lookup_tables_ && other.trial_space_ == trial_space_) {
+            block_lookup_tables_ = other.block_lookup_tables_;
+            return *block_lookup_tables_;
+          }
+        }
+
+        std::array<const BlockElementRestriction*, Integral::num_types> test_dofs;
+        std::array<const BlockElementRestriction*, Integral::num_types> trial_dofs;
+        for (auto type : Integral::Types) {
+          test_dofs[type]  = &form_.G_test_[type];
+          trial_dofs[type] = &form_.G_trial_[type][which_argument];
+        }
+        block_lookup_tables_ = std::make_shared<const BlockAssemblyLookupTables>(
+            test_dofs, trial_dofs, uint32_t(test_space_->GetNDofs()), uint32_t(trial_space_->GetNDofs()));
+      }
+      return *block_lookup_tables_;
+    }
+
+    /// @brief the lookup tables for block assembly, see block_lookup_tables()
+    std::shared_ptr<const BlockAssemblyLookupTables> block_lookup_tables_;
 
     /**
      * @brief Copy of the column indices for sparse matrix assembly
@@ -652,6 +3614,42 @@ private:
 
     /// @brief storage for computing the action-of-gradient output
     mfem::Vector df_;
+
+    /// @brief what is needed to refresh the values of the most recently assembled matrix in place
+    struct InPlaceState {
+      /// @brief lookup tables for refreshing the values of `matrix` in place
+      std::unique_ptr<InPlaceAssembly> assembly;
+
+      /// @brief the matrix that `assembly` describes (not owned by this object, only used for identification)
+      const mfem::HypreParMatrix* matrix = nullptr;
+
+      /// @brief storage for the rank-local sparse matrix values during in-place assembly
+      std::vector<double> local_values;
+    };
+
+    /**
+     * @brief the in-place assembly state, shared with the copies of this gradient (e.g. `auto K = get<1>(f(...))`),
+     * so that they keep refreshing the same matrix
+     */
+    std::shared_ptr<InPlaceState> in_place_ = std::make_shared<InPlaceState>();
+
+    /// @brief the values of the rank-local sparse matrix that are zeroed by constrain_local_values()
+    struct ConstrainedValues {
+      /// @brief the Functional::essential_dofs_version_ that `indices` were computed for
+      std::size_t version = 0;
+
+      /// @brief the indices of the zeroed entries of the CSR values array
+      std::vector<int> indices;
+
+      /// @brief a copy of `indices` that can be read on the device (only for ExecutionSpace::GPU)
+      mfem::Array<int> device_indices;
+    };
+
+    /// @brief the constrained values, shared with the copies of this gradient (like `in_place_`)
+    std::shared_ptr<ConstrainedValues> constrained_values_ = std::make_shared<ConstrainedValues>();
+
+    /// @brief the accounting of the memory of the most recently formed matrix, see form_matrix()
+    memory::Tracker matrix_memory_{memory::Subsystem::Matrices};
   };
 
   /// @brief Manages DOFs for the test space
@@ -675,8 +3673,129 @@ private:
 
   std::vector<Integral> integrals_;
 
+  /// @brief the functions that (re)build each of integrals_ for the current mesh, see Update()
+  std::vector<std::function<void()>> integral_builders_;
+
+  /// @brief whether the domain integrals store the inverse jacobians, see SetPrecomputedInverseJacobians()
+  bool precompute_inverse_jacobians_ = false;
+
   mutable mfem::BlockVector output_E_[Integral::num_types];
 
+  /// @brief the accounting of the memory of the E-, L- and T-vectors above, see memory::usage()
+  memory::Tracker work_vector_memory_{memory::Subsystem::EVectors};
+
+  /// @brief the maximum number of elements processed at a time by batched_element_loop()
+  uint32_t element_batch_size_ = 64;
+
+  /// @brief whether the GPU evaluates the elements in batches rather than through E-vectors, see SetElementBatchSize()
+  bool batched_device_evaluation_ = false;
+
+  /// @brief storage (in the execution space) for the inputs of a batch of elements, see device_batched_element_loop()
+  mutable mfem::Vector device_batch_input_[num_trial_spaces];
+
+  /// @brief storage (in the execution space) for the outputs of a batch of elements
+  mutable mfem::Vector device_batch_output_;
+
+  /// @brief whether the element kernels on the GPU are replayed from CUDA graphs, see SetKernelGraphs()
+  bool use_kernel_graphs_ = false;
+
+  /// @brief whether the element kernels of the integrals on the GPU run concurrently, see SetConcurrentIntegrals()
+  bool concurrent_integrals_ = false;
+
+  /// @brief the captured kernel sequences of each kind of evaluation, see device_element_loop()
+  mutable std::map<std::vector<uint32_t>, accelerator::KernelGraph> kernel_graphs_;
+
+  /// @brief the argument whose values at each quadrature point are reused between evaluations (see SetCachedArgument())
+  uint32_t cached_argument_ = NO_CACHED_ARGUMENT;
+
+  /// @brief the value of the cached argument when its values at each quadrature point were last computed
+  mfem::Vector cached_argument_T_;
+
+  /// @brief the arguments whose values at each quadrature point are supplied, see SetQuadraturePointArgument()
+  std::map<uint32_t, SuppliedValues> quadrature_point_arguments_;
+
+  /// @brief whether the gradients w.r.t. each argument are assembled as symmetric matrices, see SetSymmetricGradient()
+  bool symmetric_gradient_[num_trial_spaces] = {};
+
+  /// @brief whether operator() only re-evaluates the elements whose inputs changed, see SetIncrementalEvaluation()
+  bool incremental_evaluation_ = false;
+
+  /// @brief the argument that every residual evaluation also differentiates w.r.t., see SetMemoization()
+  uint32_t memoized_argument_ = NO_DIFFERENTIATION;
+
+  /// @brief the memoized evaluation
+  StoredEvaluation memoized_;
+
+  /// @brief the argument whose derivatives are reused between evaluations at the same point, see SetGradientCaching()
+  uint32_t cached_gradient_argument_ = NO_DIFFERENTIATION;
+
+  /// @brief the last evaluation that computed the derivatives w.r.t. cached_gradient_argument_
+  StoredEvaluation cached_gradient_;
+
+  /// @brief how much a dof may change before the elements using it are evaluated again
+  double incremental_tolerance_ = 0.0;
+
+  /// @brief the stored outputs of each element, for each integral and geometry, in incremental mode
+  std::vector<std::map<mfem::Geometry::Type, std::vector<double> > > incremental_outputs_;
+
+  /// @brief the arguments differentiated w.r.t. when the stored outputs were evaluated
+  std::vector<uint32_t> incremental_differentiation_indices_;
+
+  /// @brief the sum of the stored outputs of every element, i.e. the local residual
+  mfem::Vector incremental_output_L_;
+
+  /// @brief the values of each local dof when the last elements using it were evaluated
+  mfem::Vector incremental_input_L_[num_trial_spaces];
+
+  /// @brief 1.0 for the local dofs that changed by more than the tolerance in this evaluation, 0.0 otherwise
+  mfem::Vector changed_dofs_L_[num_trial_spaces];
+
+  /// @brief the accounting of the memory used by incremental mode
+  memory::Tracker incremental_memory_{memory::Subsystem::EVectors};
+
+  /// @brief serializes the prolongations of concurrent calls to Evaluate(), as mfem's parallel operators aren't
+  /// thread-safe
+  mutable std::mutex prolongation_mutex_;
+
+  /// @brief storage for the gathered inputs of a batch of elements, for each trial space used by an integral
+  mutable std::vector<double> batch_input_[num_trial_spaces];
+
+  /// @brief storage for the outputs of a batch of elements
+  mutable std::vector<double> batch_output_;
+
+  /// @brief storage for the gathered values of each direction of a batch of elements, see DirectionalDerivatives()
+  mutable std::vector<std::vector<double> > batch_direction_input_;
+
+  /// @brief the local DOF values of each direction passed to the multi-direction ActionOfGradient() (CPU only)
+  mutable std::vector<mfem::Vector> block_input_L_;
+
+  /// @brief the local output values of each direction of the multi-direction ActionOfGradient() (CPU only)
+  mutable std::vector<mfem::Vector> block_output_L_;
+
+  /// @brief whether any interior face integrals have been added (see AddInteriorFaceIntegral())
+  bool uses_interior_faces_ = false;
+
+  /// @brief whether trial space i is used by an interior face integral, and so needs its face neighbor values
+  bool uses_face_nbr_values_[num_trial_spaces]{};
+
+  /// @brief the values of each trial space on elements of other ranks that share a face with this rank (CPU only)
+  mutable mfem::Vector face_nbr_L_[num_trial_spaces];
+
+  /// @brief the face neighbor values of each direction passed to the multi-direction ActionOfGradient() (CPU only)
+  mutable std::vector<mfem::Vector> block_face_nbr_L_;
+
+  /// @brief the elements evaluated at each stage (see ElementStage), for each integral type
+  ElementRanges element_ranges_[Integral::num_types][num_element_stages];
+
+  /// @brief versions of P_trial_ that can overlap their communication with element calculations (CPU only)
+  OverlappedProlongation trial_prolongation_[num_trial_spaces];
+
+  /// @brief whether trial_prolongation_[i] can exchange values concurrently with the other trial spaces
+  bool overlap_trial_prolongation_[num_trial_spaces];
+
+  /// @brief a version of P_test_ that can overlap its communication with element calculations (CPU only)
+  OverlappedProlongation test_prolongation_;
+
   BlockElementRestriction G_test_[Integral::num_types];
 
   /// @brief The output set of local DOF values (i.e., on the current rank)
@@ -687,6 +3806,15 @@ private:
   /// @brief The set of true DOF values, a reference to this member is returned by @p operator()
   mutable mfem::Vector output_T_;
 
+  /// @brief the constrained true dofs of the test space, see SetEssentialTrueDofs()
+  mfem::Array<int> essential_true_dofs_;
+
+  /// @brief whether each local dof of the test space is a copy of a constrained true dof
+  std::vector<bool> essential_local_dofs_;
+
+  /// @brief incremented whenever the constrained dofs change, so that the gradients find their constrained values again
+  std::size_t essential_dofs_version_ = 0;
+
   /// @brief The objects representing the gradients w.r.t. each input argument of the Functional
   mutable std::vector<Gradient> grad_;
 };
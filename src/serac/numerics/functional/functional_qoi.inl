@@ -53,6 +53,9 @@ struct QoIElementRestriction {
   void ScatterAdd(const mfem::Vector& input, mfem::Vector& output) const { output[0] += input.Sum(); }
 };
 
+template <typename T, ExecutionSpace exec = serac::default_execution_space>
+class QoIGroup;
+
 /**
  * @brief a partial template specialization of Functional with test == double, implying "quantity of interest"
  */
@@ -108,8 +111,13 @@ public:
 
         // note: we have to use "Update" here, as mfem::BlockVector's
         // copy assignment ctor (operator=) doesn't let you make changes
-        // to the block size
-        input_E_[type][i].Update(G_trial_[type][i].bOffsets(), mem_type);
+        // to the block size. The E-vector of a restriction that is the
+        // identity is the L-vector itself, so nothing is gathered
+        if (G_trial_[type][i].identity) {
+          input_E_[type][i].Update(input_L_[i], G_trial_[type][i].bOffsets());
+        } else {
+          input_E_[type][i].Update(G_trial_[type][i].bOffsets(), mem_type);
+        }
       }
     }
 
@@ -168,6 +176,20 @@ public:
   template <int dim, int... args, typename lambda, typename qpt_data_type = Nothing>
   void AddDomainIntegral(Dimension<dim>, DependsOn<args...>, lambda&& integrand, mfem::Mesh& domain,
                          std::shared_ptr<QuadratureData<qpt_data_type>> qdata = NoQData)
+  {
+    AddDomainIntegral(Dimension<dim>{}, DependsOn<args...>{}, QuadraturePoints<Q>{}, integrand, domain, qdata);
+  }
+
+  /**
+   * @brief Adds a domain integral term with a specific quadrature rule to the Functional object
+   * @tparam q the number of quadrature points per dimension, see @p QuadraturePoints
+   * @param[in] integrand The user-provided quadrature function, see @p Integral
+   * @param[in] domain The domain on which to evaluate the integral
+   * @param[in] qdata The data structure containing per-quadrature-point data (of this integral's quadrature rule)
+   */
+  template <int dim, int... args, int q, typename lambda, typename qpt_data_type = Nothing>
+  void AddDomainIntegral(Dimension<dim>, DependsOn<args...>, QuadraturePoints<q>, lambda&& integrand,
+                         mfem::Mesh& domain, std::shared_ptr<QuadratureData<qpt_data_type>> qdata = NoQData)
   {
     if (domain.GetNE() == 0) return;
 
@@ -178,7 +200,7 @@ public:
 
     using signature = test(decltype(serac::type<args>(trial_spaces))...);
     integrals_.push_back(
-        MakeDomainIntegral<signature, Q, dim>(domain, integrand, qdata, std::vector<uint32_t>{args...}));
+        MakeDomainIntegral<signature, q, dim, exec>(domain, integrand, qdata, std::vector<uint32_t>{args...}));
   }
 
   /**
@@ -194,6 +216,19 @@ public:
    */
   template <int dim, int... args, typename lambda, typename qpt_data_type = void>
   void AddBoundaryIntegral(Dimension<dim>, DependsOn<args...>, lambda&& integrand, mfem::Mesh& domain)
+  {
+    AddBoundaryIntegral(Dimension<dim>{}, DependsOn<args...>{}, QuadraturePoints<Q>{}, integrand, domain);
+  }
+
+  /**
+   * @brief Adds a boundary integral term with a specific quadrature rule to the Functional object
+   * @tparam q the number of quadrature points per dimension, see @p QuadraturePoints
+   * @param[in] integrand The user-provided quadrature function, see @p Integral
+   * @param[in] domain The domain on which to evaluate the integral
+   */
+  template <int dim, int... args, int q, typename lambda>
+  void AddBoundaryIntegral(Dimension<dim>, DependsOn<args...>, QuadraturePoints<q>, lambda&& integrand,
+                           mfem::Mesh& domain)
   {
     auto num_bdr_elements = domain.GetNBE();
     if (num_bdr_elements == 0) return;
@@ -201,7 +236,8 @@ public:
     check_for_missing_nodal_gridfunc(domain);
 
     using signature = test(decltype(serac::type<args>(trial_spaces))...);
-    integrals_.push_back(MakeBoundaryIntegral<signature, Q, dim>(domain, integrand, std::vector<uint32_t>{args...}));
+    integrals_.push_back(
+        MakeBoundaryIntegral<signature, q, dim, exec>(domain, integrand, std::vector<uint32_t>{args...}));
   }
 
   /**
@@ -350,6 +386,54 @@ public:
     }
   }
 
+  /**
+   * @brief evaluate the gradient of the quantity of interest with respect to one of its arguments, in a single pass
+   * over the elements
+   *
+   * @param which the index of the argument to differentiate with respect to
+   * @param args the input T-vectors
+   *
+   * Unlike `operator()` with `differentiate_wrt()`, followed by assemble() on the returned Gradient, this
+   * doesn't store the derivatives of the q-functions at each quadrature point: they are evaluated (one
+   * q-function evaluation per quadrature point, for all of the components of argument `which` at once)
+   * and integrated against the trial space basis functions as the elements are visited.
+   *
+   * e.g. auto dQ_darg1 = my_functional.ReverseModeGradient(1, arg0, arg1);
+   */
+  template <typename... T>
+  std::unique_ptr<mfem::HypreParVector> ReverseModeGradient(uint32_t which, const T&... args) const
+  {
+    static_assert(sizeof...(T) == num_trial_spaces,
+                  "Error: Functional::ReverseModeGradient() must take exactly as many arguments as trial spaces");
+    SLIC_ERROR_ROOT_IF(which >= num_trial_spaces, "Functional::ReverseModeGradient(): invalid argument index");
+
+    const mfem::Vector* input_T[] = {&static_cast<const mfem::Vector&>(args)...};
+
+    for (uint32_t i = 0; i < num_trial_spaces; i++) {
+      P_trial_[i]->Mult(*input_T[i], input_L_[i]);
+    }
+
+    auto element_gradients = allocate_element_gradients(which);
+
+    bool already_computed[Integral::num_types][num_trial_spaces]{};  // default initializes to `false`
+
+    for (auto& integral : integrals_) {
+      auto type = integral.type;
+
+      for (auto i : integral.active_trial_spaces_) {
+        if (!already_computed[type][i]) {
+          G_trial_[type][i].Gather(input_L_[i], input_E_[type][i]);
+          already_computed[type][i] = true;
+        }
+      }
+
+      integral.ComputeQoIGradients(input_E_[type], element_gradients[integral.type], which);
+    }
+
+    mfem::Vector gradient_L(trial_space_[which]->GetVSize());
+    return assemble_element_gradients(element_gradients, which, gradient_L);
+  }
+
   /// @overload
   template <typename... T>
   auto operator()(const T&... args)
@@ -366,6 +450,10 @@ public:
   }
 
 private:
+  /// @brief a QoIGroup evaluates the integrals of several Functionals with shared inputs
+  template <typename, ExecutionSpace>
+  friend class QoIGroup;
+
   /**
    * @brief Indicates whether to obtain values or gradients from a calculation
    */
@@ -395,57 +483,13 @@ private:
 
     std::unique_ptr<mfem::HypreParVector> assemble()
     {
-      // The mfem method ParFiniteElementSpace.NewTrueDofVector should really be marked const
-      std::unique_ptr<mfem::HypreParVector> gradient_T(
-          const_cast<mfem::ParFiniteElementSpace*>(form_.trial_space_[which_argument])->NewTrueDofVector());
-
-      gradient_L_ = 0.0;
-
-      std::map<mfem::Geometry::Type, ExecArray<double, 3, exec>> element_gradients[Integral::num_types];
+      auto element_gradients = form_.allocate_element_gradients(which_argument);
 
       for (auto& integral : form_.integrals_) {
-        auto& K_elem             = element_gradients[integral.type];
-        auto& trial_restrictions = form_.G_trial_[integral.type][which_argument].restrictions;
-
-        if (K_elem.empty()) {
-          for (auto& [geom, trial_restriction] : trial_restrictions) {
-            K_elem[geom] = ExecArray<double, 3, exec>(trial_restriction.num_elements, 1,
-                                                      trial_restriction.nodes_per_elem * trial_restriction.components);
-
-            detail::zero_out(K_elem[geom]);
-          }
-        }
-
-        integral.ComputeElementGradients(K_elem, which_argument);
+        integral.ComputeElementGradients(element_gradients[integral.type], which_argument);
       }
 
-      for (auto type : Integral::Types) {
-        auto& K_elem             = element_gradients[type];
-        auto& trial_restrictions = form_.G_trial_[type][which_argument].restrictions;
-
-        if (!K_elem.empty()) {
-          for (auto [geom, elem_matrices] : K_elem) {
-            std::vector<DoF> trial_vdofs(trial_restrictions[geom].nodes_per_elem * trial_restrictions[geom].components);
-
-            for (axom::IndexType e = 0; e < elem_matrices.shape()[0]; e++) {
-              trial_restrictions[geom].GetElementVDofs(e, trial_vdofs);
-
-              // note: elem_matrices.shape()[1] is 1 for a QoI
-              for (axom::IndexType i = 0; i < elem_matrices.shape()[1]; i++) {
-                for (axom::IndexType j = 0; j < elem_matrices.shape()[2]; j++) {
-                  int sign = trial_vdofs[uint32_t(j)].sign();
-                  int col  = int(trial_vdofs[uint32_t(j)].index());
-                  gradient_L_[col] += sign * elem_matrices(e, i, j);
-                }
-              }
-            }
-          }
-        }
-      }
-
-      form_.P_trial_[which_argument]->MultTranspose(gradient_L_, *gradient_T);
-
-      return gradient_T;
+      return form_.assemble_element_gradients(element_gradients, which_argument, gradient_L_);
     }
 
     friend auto assemble(Gradient& g) { return g.assemble(); }
@@ -461,6 +505,81 @@ private:
     mfem::Vector gradient_L_;
   };
 
+  /**
+   * @brief allocate (zero-initialized) storage for the element gradients (num_elements x 1 x trial_dofs_per_elem)
+   * with respect to a trial space, for each kind of integral in this Functional
+   *
+   * @param which the index of the trial space
+   */
+  auto allocate_element_gradients(uint32_t which) const
+  {
+    std::array<std::map<mfem::Geometry::Type, ExecArray<double, 3, exec> >, Integral::num_types> element_gradients;
+
+    for (auto& integral : integrals_) {
+      auto& K_elem = element_gradients[integral.type];
+      if (!K_elem.empty()) continue;
+
+      for (auto& [geom, trial_restriction] : G_trial_[integral.type][which].restrictions) {
+        K_elem[geom] = accelerator::make_array<double, 3, exec>(
+            trial_restriction.num_elements, 1, trial_restriction.nodes_per_elem * trial_restriction.components);
+
+        detail::zero_out(K_elem[geom]);
+      }
+    }
+
+    return element_gradients;
+  }
+
+  /**
+   * @brief sum the element gradients with respect to a trial space into a T-vector
+   *
+   * @param element_gradients the element gradients, see allocate_element_gradients()
+   * @param which the index of the trial space
+   * @param gradient_L storage for the L-vector of the gradient
+   */
+  template <typename element_gradients_type>
+  std::unique_ptr<mfem::HypreParVector> assemble_element_gradients(element_gradients_type& element_gradients,
+                                                                   uint32_t which, mfem::Vector& gradient_L) const
+  {
+    // The mfem method ParFiniteElementSpace.NewTrueDofVector should really be marked const
+    std::unique_ptr<mfem::HypreParVector> gradient_T(
+        const_cast<mfem::ParFiniteElementSpace*>(trial_space_[which])->NewTrueDofVector());
+
+    gradient_L = 0.0;
+
+    if constexpr (exec == ExecutionSpace::Dynamic) {
+      // the element gradients of integrals on the device are summed on the host
+      accelerator::synchronizeDevice();
+    }
+
+    for (auto type : Integral::Types) {
+      auto& K_elem             = element_gradients[type];
+      auto& trial_restrictions = G_trial_[type][which].restrictions;
+
+      for (auto& [geom, elem_matrices] : K_elem) {
+        const auto&      trial_restriction = trial_restrictions.at(geom);
+        std::vector<DoF> trial_vdofs(trial_restriction.nodes_per_elem * trial_restriction.components);
+
+        for (axom::IndexType e = 0; e < elem_matrices.shape()[0]; e++) {
+          trial_restriction.GetElementVDofs(e, trial_vdofs);
+
+          // note: elem_matrices.shape()[1] is 1 for a QoI
+          for (axom::IndexType i = 0; i < elem_matrices.shape()[1]; i++) {
+            for (axom::IndexType j = 0; j < elem_matrices.shape()[2]; j++) {
+              int sign = trial_vdofs[uint32_t(j)].sign();
+              int col  = int(trial_vdofs[uint32_t(j)].index());
+              gradient_L[col] += sign * elem_matrices(e, i, j);
+            }
+          }
+        }
+      }
+    }
+
+    P_trial_[which]->MultTranspose(gradient_L, *gradient_T);
+
+    return gradient_T;
+  }
+
   /// @brief Manages DOFs for the test space
   const mfem::L2_FECollection       test_fec_;
   const mfem::ParFiniteElementSpace test_space_;
@@ -499,4 +618,142 @@ private:
   mutable std::vector<Gradient> grad_;
 };
 
+/**
+ * @brief several quantities of interest of the same trial spaces, evaluated together
+ *
+ * Each quantity of interest is an ordinary Functional (see operator[]()), but evaluating the group prolongs and
+ * gathers the inputs once for all of them, and sums their values over the processors with a single MPI_Allreduce,
+ * rather than one per quantity of interest.
+ *
+ * e.g.
+ *   QoIGroup<double(H1<2, dim>)> qois({&fespace}, 2);
+ *   qois[0].AddDomainIntegral(...);  // mass
+ *   qois[1].AddDomainIntegral(...);  // compliance
+ *   std::vector<double> values = qois(U);
+ */
+template <typename... trials, ExecutionSpace exec>
+class QoIGroup<double(trials...), exec> {
+  static constexpr uint32_t num_trial_spaces = sizeof...(trials);
+
+public:
+  /**
+   * @brief create a group of quantities of interest, initially without any integrals
+   * @param trial_fes the trial spaces, see Functional<double(trials...)>
+   * @param num_qois how many quantities of interest the group holds
+   */
+  QoIGroup(std::array<const mfem::ParFiniteElementSpace*, num_trial_spaces> trial_fes, std::size_t num_qois)
+      : comm_(trial_fes[0]->GetComm())
+  {
+    SLIC_ERROR_ROOT_IF(num_qois == 0, "QoIGroup: the group needs at least one quantity of interest");
+    for (std::size_t i = 0; i < num_qois; i++) {
+      qois_.push_back(std::make_unique<Functional<double(trials...), exec> >(trial_fes));
+    }
+  }
+
+  /// @brief the quantity of interest with the given index, to add integrals to
+  Functional<double(trials...), exec>& operator[](std::size_t i) { return *qois_.at(i); }
+
+  /// @brief the number of quantities of interest in the group
+  std::size_t size() const { return qois_.size(); }
+
+  /**
+   * @brief evaluate each quantity of interest with the given trial space values
+   * @param args the input T-vectors
+   * @return the value of each quantity of interest
+   */
+  template <typename... T>
+  std::vector<double> operator()(const T&... args)
+  {
+    static_assert(sizeof...(T) == num_trial_spaces,
+                  "Error: QoIGroup::operator() must take exactly as many arguments as trial spaces");
+
+    gather_inputs(args...);
+
+    auto& f = *qois_[0];
+
+    std::vector<double> local_values(qois_.size(), 0.0);
+    for (std::size_t q = 0; q < qois_.size(); q++) {
+      for (auto& integral : qois_[q]->integrals_) {
+        auto type = integral.type;
+
+        const bool update_state = false;
+        integral.Mult(f.input_E_[type], f.output_E_[type], NO_DIFFERENTIATION, update_state);
+
+        // sum the element values on the local processor, as in QoIElementRestriction::ScatterAdd()
+        local_values[q] += f.output_E_[type].Sum();
+      }
+    }
+
+    std::vector<double> values(qois_.size());
+    MPI_Allreduce(local_values.data(), values.data(), int(values.size()), MPI_DOUBLE, MPI_SUM, comm_);
+    return values;
+  }
+
+  /**
+   * @brief evaluate the gradient of each quantity of interest with respect to one of the arguments, in a
+   * single pass over the elements of each one (see Functional<double(trials...)>::ReverseModeGradient())
+   *
+   * @param which the index of the argument to differentiate with respect to
+   * @param args the input T-vectors
+   * @return the gradient of each quantity of interest
+   */
+  template <typename... T>
+  std::vector<std::unique_ptr<mfem::HypreParVector> > Gradients(uint32_t which, const T&... args)
+  {
+    static_assert(sizeof...(T) == num_trial_spaces,
+                  "Error: QoIGroup::Gradients() must take exactly as many arguments as trial spaces");
+    SLIC_ERROR_ROOT_IF(which >= num_trial_spaces, "QoIGroup::Gradients(): invalid argument index");
+
+    gather_inputs(args...);
+
+    auto& f = *qois_[0];
+
+    mfem::Vector                                        gradient_L(f.trial_space_[which]->GetVSize());
+    std::vector<std::unique_ptr<mfem::HypreParVector> > gradients;
+    for (auto& qoi : qois_) {
+      auto element_gradients = qoi->allocate_element_gradients(which);
+      for (auto& integral : qoi->integrals_) {
+        integral.ComputeQoIGradients(f.input_E_[integral.type], element_gradients[integral.type], which);
+      }
+      gradients.push_back(qoi->assemble_element_gradients(element_gradients, which, gradient_L));
+    }
+    return gradients;
+  }
+
+private:
+  /**
+   * @brief prolong and gather the given T-vectors into the element values of the first quantity of interest,
+   * which serve all of the quantities of interest in the group
+   */
+  template <typename... T>
+  void gather_inputs(const T&... args)
+  {
+    const mfem::Vector* input_T[] = {&static_cast<const mfem::Vector&>(args)...};
+
+    auto& f = *qois_[0];
+    for (uint32_t i = 0; i < num_trial_spaces; i++) {
+      f.P_trial_[i]->Mult(*input_T[i], f.input_L_[i]);
+    }
+
+    bool already_computed[Integral::num_types][num_trial_spaces]{};  // default initializes to `false`
+    for (auto& qoi : qois_) {
+      for (auto& integral : qoi->integrals_) {
+        auto type = integral.type;
+        for (auto i : integral.active_trial_spaces_) {
+          if (!already_computed[type][i]) {
+            f.G_trial_[type][i].Gather(f.input_L_[i], f.input_E_[type][i]);
+            already_computed[type][i] = true;
+          }
+        }
+      }
+    }
+  }
+
+  /// @brief MPI communicator used to sum the values from different processors
+  MPI_Comm comm_;
+
+  /// @brief the quantities of interest in the group
+  std::vector<std::unique_ptr<Functional<double(trials...), exec> > > qois_;
+};
+
 }  // namespace serac
@@ -1,5 +1,15 @@
 #include "serac/numerics/functional/geometric_factors.hpp"
 #include "serac/numerics/functional/finite_element.hpp"
+#include "serac/infrastructure/logger.hpp"
+#include "serac/infrastructure/profiling.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <tuple>
 
 namespace serac {
 
@@ -57,14 +67,112 @@ void compute_geometric_factors(mfem::Vector& positions_q, mfem::Vector& jacobian
   }
 }
 
+/**
+ * @brief check whether the jacobians of each element are the same at all of its quadrature points (up to roundoff),
+ * and if so, store the jacobian, its inverse and determinant once per element
+ * @tparam dim the spatial (and geometric) dimension of the elements
+ * @param gf the geometric factors of the elements of a domain
+ */
+template <int dim>
+void compute_affine_jacobians(GeometricFactors& gf)
+{
+  int num_elements  = int(gf.num_elements);
+  int qpts_per_elem = (num_elements > 0) ? gf.X.Size() / (num_elements * dim) : 0;
+
+  // the jacobians of each element are stored as J(derivative, component, quadrature point)
+  const double* J = gf.J.HostRead();
+  for (int e = 0; e < num_elements; e++) {
+    const double* J_e   = J + e * dim * dim * qpts_per_elem;
+    double        scale = 0.0;
+    for (int i = 0; i < dim * dim; i++) {
+      scale = std::max(scale, std::abs(J_e[i * qpts_per_elem]));
+    }
+    for (int i = 0; i < dim * dim; i++) {
+      for (int q = 1; q < qpts_per_elem; q++) {
+        if (std::abs(J_e[i * qpts_per_elem + q] - J_e[i * qpts_per_elem]) > 1.0e-12 * scale) return;
+      }
+    }
+  }
+
+  gf.affine           = true;
+  gf.affine_jacobians = mfem::Vector(num_elements * int(sizeof(AffineJacobian<dim>) / sizeof(double)));
+
+  auto affine = reinterpret_cast<AffineJacobian<dim>*>(gf.affine_jacobians.HostWrite());
+  for (int e = 0; e < num_elements; e++) {
+    tensor<double, dim, dim> J_e;
+    for (int i = 0; i < dim; i++) {
+      for (int j = 0; j < dim; j++) {
+        J_e[i][j] = J[((e * dim + j) * dim + i) * qpts_per_elem];
+      }
+    }
+    affine[e] = AffineJacobian<dim>{J_e, inv(J_e), det(J_e)};
+  }
+}
+
+namespace {
+
+/**
+ * @brief gather the "e-vector" of the nodes of a mesh whose nodes are discontinuous (e.g. a periodic mesh), without
+ * building an ElementRestriction of the node space
+ *
+ * The nodes of each element are then a contiguous range of each component of the L-vector, in the order of the
+ * e-vector, so the gather is a copy per element and component.
+ *
+ * @param nodes the nodes of the mesh
+ * @param g the element geometry
+ * @param X_e (output) the "e-vector" of position data
+ * @return whether the nodes could be gathered directly: they must be discontinuous and ordered by nodes, and all the
+ * elements must have geometry g (other than prisms, whose L2 dofs are not numbered lexicographically)
+ */
+bool gather_discontinuous_nodes(const mfem::GridFunction& nodes, mfem::Geometry::Type g, mfem::Vector& X_e)
+{
+  const auto* fes  = nodes.FESpace();
+  const auto* mesh = fes->GetMesh();
+  if (!isDG(*fes) || fes->GetOrdering() != mfem::Ordering::byNODES || g == mfem::Geometry::PRISM ||
+      mesh->GetNE() == 0 || mesh->GetNumGeometries(mesh->Dimension()) != 1 || mesh->GetElementGeometry(0) != g) {
+    return false;
+  }
+
+  const int num_elements   = mesh->GetNE();
+  const int nodes_per_elem = fes->GetFE(0)->GetDof();
+  const int num_nodes      = fes->GetNDofs();
+  const int components     = fes->GetVDim();
+  if (num_nodes != num_elements * nodes_per_elem) return false;
+
+  X_e.SetSize(num_elements * components * nodes_per_elem);
+  const double* X = nodes.HostRead();
+  double*       E = X_e.HostWrite();
+  for (int e = 0; e < num_elements; e++) {
+    for (int c = 0; c < components; c++) {
+      std::memcpy(E + (e * components + c) * nodes_per_elem, X + c * num_nodes + e * nodes_per_elem,
+                  sizeof(double) * std::size_t(nodes_per_elem));
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
 GeometricFactors::GeometricFactors(const mfem::Mesh* mesh, int q, mfem::Geometry::Type g)
 {
+  SERAC_PROFILE_SCOPE("GeometricFactors");
+
   auto* nodes = mesh->GetNodes();
   auto* fes   = nodes->FESpace();
 
-  auto         restriction = serac::ElementRestriction(fes, g);
-  mfem::Vector X_e(int(restriction.ESize()));
-  restriction.Gather(*nodes, X_e);
+  // the discontinuous nodes of periodic meshes don't need the index maps of a restriction to be gathered
+  mfem::Vector X_e;
+  if (gather_discontinuous_nodes(*nodes, g, X_e)) {
+    num_elements = std::size_t(mesh->GetNE());
+  } else {
+    auto restriction = serac::ElementRestriction(fes, g);
+    X_e.SetSize(int(restriction.ESize()));
+    restriction.Gather(*nodes, X_e);
+
+    // NB: we only want the number of elements with the specified
+    // geometry, which is not the same as mesh->GetNE() in general
+    num_elements = std::size_t(restriction.dof_info.shape()[0]);
+  }
 
   // assumes all elements are the same order
   int p = fes->GetElementOrder(0);
@@ -73,10 +181,6 @@ GeometricFactors::GeometricFactors(const mfem::Mesh* mesh, int q, mfem::Geometry
   int geometry_dim  = dimension_of(g);
   int qpts_per_elem = num_quadrature_points(g, q);
 
-  // NB: we only want the number of elements with the specified
-  // geometry, which is not the same as mesh->GetNE() in general
-  num_elements = std::size_t(restriction.dof_info.shape()[0]);
-
   X = mfem::Vector(int(num_elements) * qpts_per_elem * spatial_dim);
   J = mfem::Vector(int(num_elements) * qpts_per_elem * spatial_dim * geometry_dim);
 
@@ -84,6 +188,7 @@ GeometricFactors::GeometricFactors(const mfem::Mesh* mesh, int q, mfem::Geometry
   if (g == mfem::Geometry::GEOM && p == P && q == Q) {                                              \
     compute_geometric_factors<Q, mfem::Geometry::GEOM, H1<P, dimension_of(mfem::Geometry::GEOM)> >( \
         X, J, X_e, uint32_t(num_elements));                                                         \
+    compute_affine_jacobians<dimension_of(mfem::Geometry::GEOM)>(*this);                            \
     return;                                                                                         \
   }
 
@@ -96,47 +201,89 @@ GeometricFactors::GeometricFactors(const mfem::Mesh* mesh, int q, mfem::Geometry
   DISPATCH_KERNEL(SQUARE, 1, 2);
   DISPATCH_KERNEL(SQUARE, 1, 3);
   DISPATCH_KERNEL(SQUARE, 1, 4);
+  DISPATCH_KERNEL(SQUARE, 1, 5);
+  DISPATCH_KERNEL(SQUARE, 1, 6);
+  DISPATCH_KERNEL(SQUARE, 1, 7);
+  DISPATCH_KERNEL(SQUARE, 1, 8);
+  DISPATCH_KERNEL(SQUARE, 1, 9);
 
   DISPATCH_KERNEL(SQUARE, 2, 1);
   DISPATCH_KERNEL(SQUARE, 2, 2);
   DISPATCH_KERNEL(SQUARE, 2, 3);
   DISPATCH_KERNEL(SQUARE, 2, 4);
+  DISPATCH_KERNEL(SQUARE, 2, 5);
+  DISPATCH_KERNEL(SQUARE, 2, 6);
+  DISPATCH_KERNEL(SQUARE, 2, 7);
+  DISPATCH_KERNEL(SQUARE, 2, 8);
+  DISPATCH_KERNEL(SQUARE, 2, 9);
 
   DISPATCH_KERNEL(SQUARE, 3, 1);
   DISPATCH_KERNEL(SQUARE, 3, 2);
   DISPATCH_KERNEL(SQUARE, 3, 3);
   DISPATCH_KERNEL(SQUARE, 3, 4);
+  DISPATCH_KERNEL(SQUARE, 3, 5);
+  DISPATCH_KERNEL(SQUARE, 3, 6);
+  DISPATCH_KERNEL(SQUARE, 3, 7);
+  DISPATCH_KERNEL(SQUARE, 3, 8);
+  DISPATCH_KERNEL(SQUARE, 3, 9);
 
   DISPATCH_KERNEL(TETRAHEDRON, 1, 1);
   DISPATCH_KERNEL(TETRAHEDRON, 1, 2);
   DISPATCH_KERNEL(TETRAHEDRON, 1, 3);
   DISPATCH_KERNEL(TETRAHEDRON, 1, 4);
 
+  DISPATCH_KERNEL(PRISM, 1, 1);
+  DISPATCH_KERNEL(PRISM, 1, 2);
+  DISPATCH_KERNEL(PRISM, 1, 3);
+  DISPATCH_KERNEL(PRISM, 1, 4);
+
   DISPATCH_KERNEL(CUBE, 1, 1);
   DISPATCH_KERNEL(CUBE, 1, 2);
   DISPATCH_KERNEL(CUBE, 1, 3);
   DISPATCH_KERNEL(CUBE, 1, 4);
+  DISPATCH_KERNEL(CUBE, 1, 5);
+  DISPATCH_KERNEL(CUBE, 1, 6);
+  DISPATCH_KERNEL(CUBE, 1, 7);
+  DISPATCH_KERNEL(CUBE, 1, 8);
+  DISPATCH_KERNEL(CUBE, 1, 9);
 
   DISPATCH_KERNEL(CUBE, 2, 1);
   DISPATCH_KERNEL(CUBE, 2, 2);
   DISPATCH_KERNEL(CUBE, 2, 3);
   DISPATCH_KERNEL(CUBE, 2, 4);
+  DISPATCH_KERNEL(CUBE, 2, 5);
+  DISPATCH_KERNEL(CUBE, 2, 6);
+  DISPATCH_KERNEL(CUBE, 2, 7);
+  DISPATCH_KERNEL(CUBE, 2, 8);
+  DISPATCH_KERNEL(CUBE, 2, 9);
 
   DISPATCH_KERNEL(CUBE, 3, 1);
   DISPATCH_KERNEL(CUBE, 3, 2);
   DISPATCH_KERNEL(CUBE, 3, 3);
   DISPATCH_KERNEL(CUBE, 3, 4);
+  DISPATCH_KERNEL(CUBE, 3, 5);
+  DISPATCH_KERNEL(CUBE, 3, 6);
+  DISPATCH_KERNEL(CUBE, 3, 7);
+  DISPATCH_KERNEL(CUBE, 3, 8);
+  DISPATCH_KERNEL(CUBE, 3, 9);
 
 #undef DISPATCH_KERNEL
 
-  std::cout << "should never be reached " << std::endl;
+  SLIC_ERROR_ROOT(axom::fmt::format("geometric factors are not implemented for {} elements of order {} with q = {}",
+                                    mfem::Geometry::Name[g], p, q));
 }
 
 GeometricFactors::GeometricFactors(const mfem::Mesh* mesh, int q, mfem::Geometry::Type g, FaceType type)
 {
+  SERAC_PROFILE_SCOPE("GeometricFactors");
+
   auto* nodes = mesh->GetNodes();
   auto* fes   = nodes->FESpace();
 
+  // note: interior faces of discontinuous spaces would gather the (possibly different) nodes of both sides
+  SLIC_ERROR_ROOT_IF(type == FaceType::INTERIOR && isDG(*fes),
+                     "interior face integrals require a mesh with continuous nodes");
+
   auto         restriction = serac::ElementRestriction(fes, g, type);
   mfem::Vector X_e(int(restriction.ESize()));
   restriction.Gather(*nodes, X_e);
@@ -166,16 +313,31 @@ GeometricFactors::GeometricFactors(const mfem::Mesh* mesh, int q, mfem::Geometry
   DISPATCH_KERNEL(SEGMENT, 1, 2);
   DISPATCH_KERNEL(SEGMENT, 1, 3);
   DISPATCH_KERNEL(SEGMENT, 1, 4);
+  DISPATCH_KERNEL(SEGMENT, 1, 5);
+  DISPATCH_KERNEL(SEGMENT, 1, 6);
+  DISPATCH_KERNEL(SEGMENT, 1, 7);
+  DISPATCH_KERNEL(SEGMENT, 1, 8);
+  DISPATCH_KERNEL(SEGMENT, 1, 9);
 
   DISPATCH_KERNEL(SEGMENT, 2, 1);
   DISPATCH_KERNEL(SEGMENT, 2, 2);
   DISPATCH_KERNEL(SEGMENT, 2, 3);
   DISPATCH_KERNEL(SEGMENT, 2, 4);
+  DISPATCH_KERNEL(SEGMENT, 2, 5);
+  DISPATCH_KERNEL(SEGMENT, 2, 6);
+  DISPATCH_KERNEL(SEGMENT, 2, 7);
+  DISPATCH_KERNEL(SEGMENT, 2, 8);
+  DISPATCH_KERNEL(SEGMENT, 2, 9);
 
   DISPATCH_KERNEL(SEGMENT, 3, 1);
   DISPATCH_KERNEL(SEGMENT, 3, 2);
   DISPATCH_KERNEL(SEGMENT, 3, 3);
   DISPATCH_KERNEL(SEGMENT, 3, 4);
+  DISPATCH_KERNEL(SEGMENT, 3, 5);
+  DISPATCH_KERNEL(SEGMENT, 3, 6);
+  DISPATCH_KERNEL(SEGMENT, 3, 7);
+  DISPATCH_KERNEL(SEGMENT, 3, 8);
+  DISPATCH_KERNEL(SEGMENT, 3, 9);
 
   DISPATCH_KERNEL(TRIANGLE, 1, 1);
   DISPATCH_KERNEL(TRIANGLE, 1, 2);
@@ -196,20 +358,248 @@ GeometricFactors::GeometricFactors(const mfem::Mesh* mesh, int q, mfem::Geometry
   DISPATCH_KERNEL(SQUARE, 1, 2);
   DISPATCH_KERNEL(SQUARE, 1, 3);
   DISPATCH_KERNEL(SQUARE, 1, 4);
+  DISPATCH_KERNEL(SQUARE, 1, 5);
+  DISPATCH_KERNEL(SQUARE, 1, 6);
+  DISPATCH_KERNEL(SQUARE, 1, 7);
+  DISPATCH_KERNEL(SQUARE, 1, 8);
+  DISPATCH_KERNEL(SQUARE, 1, 9);
 
   DISPATCH_KERNEL(SQUARE, 2, 1);
   DISPATCH_KERNEL(SQUARE, 2, 2);
   DISPATCH_KERNEL(SQUARE, 2, 3);
   DISPATCH_KERNEL(SQUARE, 2, 4);
+  DISPATCH_KERNEL(SQUARE, 2, 5);
+  DISPATCH_KERNEL(SQUARE, 2, 6);
+  DISPATCH_KERNEL(SQUARE, 2, 7);
+  DISPATCH_KERNEL(SQUARE, 2, 8);
+  DISPATCH_KERNEL(SQUARE, 2, 9);
 
   DISPATCH_KERNEL(SQUARE, 3, 1);
   DISPATCH_KERNEL(SQUARE, 3, 2);
   DISPATCH_KERNEL(SQUARE, 3, 3);
   DISPATCH_KERNEL(SQUARE, 3, 4);
+  DISPATCH_KERNEL(SQUARE, 3, 5);
+  DISPATCH_KERNEL(SQUARE, 3, 6);
+  DISPATCH_KERNEL(SQUARE, 3, 7);
+  DISPATCH_KERNEL(SQUARE, 3, 8);
+  DISPATCH_KERNEL(SQUARE, 3, 9);
 
 #undef DISPATCH_KERNEL
 
-  std::cout << "should never be reached" << std::endl;
+  SLIC_ERROR_ROOT(axom::fmt::format("geometric factors are not implemented for {} elements of order {} with q = {}",
+                                    mfem::Geometry::Name[g], p, q));
+}
+
+/**
+ * @brief compute the inverse and determinant of the jacobian at each quadrature point, see
+ * precompute_inverse_jacobians()
+ * @tparam dim the spatial (and geometric) dimension of the elements
+ * @param gf the geometric factors of the elements of a domain
+ */
+template <int dim>
+void compute_inverse_jacobians(GeometricFactors& gf)
+{
+  int num_elements  = int(gf.num_elements);
+  int qpts_per_elem = gf.X.Size() / (num_elements * dim);
+  int per_elem      = qpts_per_elem * (dim * dim + 1);
+
+  gf.inverse_jacobians = mfem::Vector(num_elements * per_elem);
+
+  // the jacobians of each element are stored as J(derivative, component, quadrature point), and their inverses as
+  // inv_J(quadrature point, row, column) followed by det_J(quadrature point)
+  const double* J     = gf.J.HostRead();
+  double*       inv_J = gf.inverse_jacobians.HostWrite();
+  for (int e = 0; e < num_elements; e++) {
+    double* inv_J_e = inv_J + e * per_elem;
+    double* det_J_e = inv_J_e + qpts_per_elem * dim * dim;
+    for (int q = 0; q < qpts_per_elem; q++) {
+      tensor<double, dim, dim> J_q;
+      for (int i = 0; i < dim; i++) {
+        for (int j = 0; j < dim; j++) {
+          J_q[i][j] = J[((e * dim + j) * dim + i) * qpts_per_elem + q];
+        }
+      }
+      auto inv_J_q = inv(J_q);
+      for (int i = 0; i < dim; i++) {
+        for (int j = 0; j < dim; j++) {
+          inv_J_e[(q * dim + i) * dim + j] = inv_J_q[i][j];
+        }
+      }
+      det_J_e[q] = det(J_q);
+    }
+  }
+}
+
+void precompute_inverse_jacobians(GeometricFactors& gf)
+{
+  // affine elements already store a single inverse per element
+  if (gf.affine || gf.num_elements == 0) return;
+
+  int dim = gf.J.Size() / gf.X.Size();
+  SLIC_ERROR_ROOT_IF(gf.J.Size() != gf.X.Size() * dim || (dim != 2 && dim != 3),
+                     "inverse jacobians require the jacobians of 2D or 3D domain elements");
+
+  if (dim == 2) compute_inverse_jacobians<2>(gf);
+  if (dim == 3) compute_inverse_jacobians<3>(gf);
+}
+
+namespace {
+
+/**
+ * @brief which mesh, quadrature rule, element geometry and kind of element (-1 for domain elements, -2 for domain
+ * elements with inverse jacobians) a table is for
+ */
+using GeometricFactorsKey = std::tuple<const mfem::Mesh*, int, mfem::Geometry::Type, int>;
+
+/// @brief a table of geometric factors, along with a fingerprint of the mesh nodes it was computed from
+struct CachedGeometricFactors {
+  uint64_t                              fingerprint;  ///< a hash of the mesh node values
+  std::weak_ptr<const GeometricFactors> factors;      ///< the table (if it is still in use)
+};
+
+/**
+ * @brief a cheap (FNV-1a) hash of the nodal positions of a mesh, used to detect meshes that have been moved
+ * (or destroyed and replaced by another mesh at the same address) after their geometric factors were computed
+ */
+uint64_t node_fingerprint(const mfem::Mesh* mesh)
+{
+  const mfem::GridFunction* nodes = mesh->GetNodes();
+
+  uint64_t      hash   = 14695981039346656037ull;
+  const double* values = nodes->HostRead();
+  for (int i = 0; i < nodes->Size(); i++) {
+    uint64_t bits;
+    std::memcpy(&bits, values + i, sizeof(bits));
+    hash = (hash ^ bits) * 1099511628211ull;
+  }
+  return (hash ^ uint64_t(nodes->Size())) * 1099511628211ull;
+}
+
+/**
+ * @brief look up a table of geometric factors in the cache, calling `compute` to create it if there isn't one
+ * that is both still in use and up to date with the mesh nodes
+ */
+template <typename callable>
+std::shared_ptr<const GeometricFactors> find_or_compute(const GeometricFactorsKey& key, const mfem::Mesh* mesh,
+                                                        callable compute)
+{
+  static std::mutex                                            m;
+  static std::map<GeometricFactorsKey, CachedGeometricFactors> cache;
+
+  uint64_t fingerprint = node_fingerprint(mesh);
+
+  std::lock_guard<std::mutex> lock(m);
+
+  // discard the entries that are no longer used by anything, so the cache doesn't grow indefinitely
+  for (auto it = cache.begin(); it != cache.end();) {
+    it = it->second.factors.expired() ? cache.erase(it) : std::next(it);
+  }
+
+  auto it = cache.find(key);
+  if (it != cache.end() && it->second.fingerprint == fingerprint) {
+    if (auto factors = it->second.factors.lock()) return factors;
+  }
+
+  auto factors = std::make_shared<const GeometricFactors>(compute());
+  cache[key]   = CachedGeometricFactors{fingerprint, factors};
+  return factors;
+}
+
+}  // namespace
+
+std::shared_ptr<const GeometricFactors> shared_geometric_factors(const mfem::Mesh* mesh, int q,
+                                                                 mfem::Geometry::Type elem_geom,
+                                                                 bool with_inverse_jacobians)
+{
+  return find_or_compute(GeometricFactorsKey{mesh, q, elem_geom, with_inverse_jacobians ? -2 : -1}, mesh, [&]() {
+    GeometricFactors gf(mesh, q, elem_geom);
+    if (with_inverse_jacobians) precompute_inverse_jacobians(gf);
+    return gf;
+  });
+}
+
+std::shared_ptr<const GeometricFactors> shared_geometric_factors(const mfem::Mesh* mesh, int q,
+                                                                 mfem::Geometry::Type elem_geom, FaceType type)
+{
+  return find_or_compute(GeometricFactorsKey{mesh, q, elem_geom, int(type)}, mesh,
+                         [&]() { return GeometricFactors(mesh, q, elem_geom, type); });
+}
+
+GeometricFactors select_elements(const GeometricFactors& gf, const std::vector<uint32_t>& elements)
+{
+  GeometricFactors selected;
+  selected.num_elements = elements.size();
+
+  // the values of each element are stored contiguously in both tables
+  int X_per_elem = (gf.num_elements > 0) ? gf.X.Size() / int(gf.num_elements) : 0;
+  int J_per_elem = (gf.num_elements > 0) ? gf.J.Size() / int(gf.num_elements) : 0;
+
+  int A_per_elem = (gf.num_elements > 0) ? gf.affine_jacobians.Size() / int(gf.num_elements) : 0;
+  int I_per_elem = (gf.num_elements > 0) ? gf.inverse_jacobians.Size() / int(gf.num_elements) : 0;
+
+  selected.X                 = mfem::Vector(int(elements.size()) * X_per_elem);
+  selected.J                 = mfem::Vector(int(elements.size()) * J_per_elem);
+  selected.affine            = gf.affine;
+  selected.affine_jacobians  = mfem::Vector(int(elements.size()) * A_per_elem);
+  selected.inverse_jacobians = mfem::Vector(int(elements.size()) * I_per_elem);
+
+  const double* X          = gf.X.HostRead();
+  const double* J          = gf.J.HostRead();
+  double*       X_selected = selected.X.HostWrite();
+  double*       J_selected = selected.J.HostWrite();
+  for (std::size_t e = 0; e < elements.size(); e++) {
+    int i = int(elements[e]);
+    std::copy(X + i * X_per_elem, X + (i + 1) * X_per_elem, X_selected + int(e) * X_per_elem);
+    std::copy(J + i * J_per_elem, J + (i + 1) * J_per_elem, J_selected + int(e) * J_per_elem);
+  }
+
+  if (A_per_elem > 0) {
+    const double* A          = gf.affine_jacobians.HostRead();
+    double*       A_selected = selected.affine_jacobians.HostWrite();
+    for (std::size_t e = 0; e < elements.size(); e++) {
+      int i = int(elements[e]);
+      std::copy(A + i * A_per_elem, A + (i + 1) * A_per_elem, A_selected + int(e) * A_per_elem);
+    }
+  }
+
+  if (I_per_elem > 0) {
+    const double* I          = gf.inverse_jacobians.HostRead();
+    double*       I_selected = selected.inverse_jacobians.HostWrite();
+    for (std::size_t e = 0; e < elements.size(); e++) {
+      int i = int(elements[e]);
+      std::copy(I + i * I_per_elem, I + (i + 1) * I_per_elem, I_selected + int(e) * I_per_elem);
+    }
+  }
+
+  return selected;
+}
+
+std::vector<double> min_element_lengths(const GeometricFactors& gf, mfem::Geometry::Type elem_geom)
+{
+  int dim           = dimension_of(elem_geom);
+  int num_elements  = int(gf.num_elements);
+  int qpts_per_elem = (num_elements > 0) ? gf.X.Size() / (num_elements * dim) : 0;
+
+  SLIC_ERROR_ROOT_IF(gf.J.Size() != num_elements * qpts_per_elem * dim * dim,
+                     "element lengths require the jacobians of domain elements");
+
+  std::vector<double> lengths(gf.num_elements, std::numeric_limits<double>::max());
+
+  // the jacobians of each element are stored as J(derivative, component, quadrature point)
+  const double*     J = gf.J.HostRead();
+  mfem::DenseMatrix J_q(dim);
+  for (int e = 0; e < num_elements; e++) {
+    for (int q = 0; q < qpts_per_elem; q++) {
+      for (int i = 0; i < dim; i++) {
+        for (int j = 0; j < dim; j++) {
+          J_q(i, j) = J[((e * dim + j) * dim + i) * qpts_per_elem + q];
+        }
+      }
+      lengths[std::size_t(e)] = std::min(lengths[std::size_t(e)], J_q.CalcSingularvalue(dim - 1));
+    }
+  }
+
+  return lengths;
 }
 
 }  // namespace serac
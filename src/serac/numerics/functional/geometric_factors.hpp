@@ -1,5 +1,8 @@
 #pragma once
 
+#include <memory>
+#include <vector>
+
 #include "serac/numerics/functional/element_restriction.hpp"  // for FaceType
 #include "serac/numerics/functional/finite_element.hpp"       // for Geometry
 
@@ -28,12 +31,12 @@ struct GeometricFactors {
 
   /**
    * @brief calculate positions and jacobians for quadrature points belonging to
-   * boundary elements with the specified geometry, belonging to the provided mesh.
+   * the boundary (or interior) faces with the specified geometry, belonging to the provided mesh.
    *
    * @param mesh the mesh
    * @param q a parameter controlling the number of quadrature points per element
    * @param elem_geom which kind of element geometry to select
-   * @param type whether or not the faces are on the boundary (supported) or interior (unsupported)
+   * @param type whether the faces are on the boundary or in the interior of the mesh
    */
   GeometricFactors(const mfem::Mesh* mesh, int q, mfem::Geometry::Type elem_geom, FaceType type);
 
@@ -56,8 +59,84 @@ struct GeometricFactors {
       - NE = number of elements in the mesh. */
   mfem::Vector J;
 
+  /**
+   * @brief whether the jacobian of every element is the same at all of its quadrature points (e.g. straight-sided
+   * simplices, and parallelogram/parallelepiped quads/hexes), so that kernels can use affine_jacobians instead
+   * @note only domain elements are checked, the factors of faces are never affine
+   */
+  bool affine = false;
+
+  /// For affine tables, the AffineJacobian (jacobian, inverse and determinant) of each element, and empty otherwise.
+  /** This array is laid out as NE consecutive AffineJacobian<DIM>, i.e. (2 x DIM x DIM + 1) values per element */
+  mfem::Vector affine_jacobians;
+
+  /// The InverseJacobians (inverse and determinant at each quadrature point) of each element, if requested.
+  /** This array is laid out as NE consecutive InverseJacobians<DIM, NQ>, i.e. (NQ x DIM x DIM + NQ) values per
+      element, and is empty unless precompute_inverse_jacobians() was called (and the table isn't affine) */
+  mfem::Vector inverse_jacobians;
+
   /// the number of elements in the domain
   std::size_t num_elements;
 };
 
+/**
+ * @brief get the positions and jacobians at each quadrature point of the elements with the specified geometry,
+ * reusing an existing table if one was already computed for the same mesh, quadrature rule and geometry
+ *
+ * Every Integral needs these tables, so Functionals defined on the same mesh (e.g. a residual and its sensitivities,
+ * or the residuals of several physics modules) would otherwise hold identical copies of them. The cache only keeps
+ * a table alive for as long as something else refers to it, and a table is recomputed if the mesh nodes have
+ * changed since it was computed.
+ *
+ * @param mesh the mesh
+ * @param q a parameter controlling the number of quadrature points per element
+ * @param elem_geom which kind of element geometry to select
+ * @param with_inverse_jacobians whether to also precompute the inverse jacobians, see precompute_inverse_jacobians()
+ */
+std::shared_ptr<const GeometricFactors> shared_geometric_factors(const mfem::Mesh* mesh, int q,
+                                                                 mfem::Geometry::Type elem_geom,
+                                                                 bool with_inverse_jacobians = false);
+
+/**
+ * @brief get the positions and jacobians at each quadrature point of the boundary elements with the specified
+ * geometry, reusing an existing table if one was already computed for the same mesh, quadrature rule and geometry
+ *
+ * @param mesh the mesh
+ * @param q a parameter controlling the number of quadrature points per element
+ * @param elem_geom which kind of element geometry to select
+ * @param type whether the faces are on the boundary or in the interior of the mesh
+ *
+ * @see shared_geometric_factors(const mfem::Mesh*, int, mfem::Geometry::Type)
+ */
+std::shared_ptr<const GeometricFactors> shared_geometric_factors(const mfem::Mesh* mesh, int q,
+                                                                 mfem::Geometry::Type elem_geom, FaceType type);
+
+/**
+ * @brief compute and store the inverse and determinant of the jacobian at each quadrature point of a table's
+ * elements, so that evaluations don't need to recompute them (for tables that aren't affine)
+ *
+ * @param gf the positions and jacobians of the elements of a domain
+ */
+void precompute_inverse_jacobians(GeometricFactors& gf);
+
+/**
+ * @brief copy the positions and jacobians at each quadrature point of some of the elements in a table
+ *
+ * @param gf the positions and jacobians of the elements with one kind of geometry
+ * @param elements the indices of the elements to copy (in the numbering of gf)
+ * @return the positions and jacobians of those elements, in the order they are given
+ */
+GeometricFactors select_elements(const GeometricFactors& gf, const std::vector<uint32_t>& elements);
+
+/**
+ * @brief estimate the smallest length scale of each element, as the smallest singular value of the jacobians at its
+ * quadrature points (i.e. the length that the element mapping gives the reference element in its thinnest direction)
+ *
+ * @param gf the positions and jacobians of the elements with one kind of geometry
+ * @param elem_geom the geometry of those elements
+ * @return the length scale of each element, in the same order as the elements in gf
+ * @pre gf describes the elements of a domain (not faces), so that the spatial and geometric dimensions agree
+ */
+std::vector<double> min_element_lengths(const GeometricFactors& gf, mfem::Geometry::Type elem_geom);
+
 }  // namespace serac
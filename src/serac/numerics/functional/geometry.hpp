@@ -39,6 +39,9 @@ constexpr int num_quadrature_points(mfem::Geometry::Type g, int Q)
   if (g == mfem::Geometry::CUBE) {
     return Q * Q * Q;
   }
+  if (g == mfem::Geometry::PRISM) {
+    return ((Q * (Q + 1)) / 2) * Q;
+  }
   return -1;
 }
 
@@ -56,7 +59,7 @@ constexpr int dimension_of(mfem::Geometry::Type g)
     return 2;
   }
 
-  if (g == mfem::Geometry::TETRAHEDRON || g == mfem::Geometry::CUBE) {
+  if (g == mfem::Geometry::TETRAHEDRON || g == mfem::Geometry::CUBE || g == mfem::Geometry::PRISM) {
     return 3;
   }
 
@@ -0,0 +1,296 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/numerics/functional/in_place_assembly.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+#include "serac/infrastructure/logger.hpp"
+
+namespace serac {
+
+namespace {
+
+/**
+ * @brief compute the global true dof number associated with each local dof of a finite element space,
+ * by prolongating a true-dof vector containing the global indices
+ *
+ * @param fes the finite element space
+ * @param[out] consistent whether or not every local dof took the value of exactly one true dof
+ */
+std::vector<HYPRE_BigInt> globalTrueDofNumbers(const mfem::ParFiniteElementSpace& fes, bool& consistent)
+{
+  HYPRE_BigInt offset = fes.GetMyTDofOffset();
+
+  mfem::Vector tdofs(fes.GetTrueVSize());
+  for (int i = 0; i < tdofs.Size(); i++) {
+    tdofs[i] = static_cast<double>(offset + i);
+  }
+
+  mfem::Vector ldofs(fes.GetVSize());
+  fes.GetProlongationMatrix()->Mult(tdofs, ldofs);
+
+  const double*             ldofs_h = ldofs.HostRead();
+  std::vector<HYPRE_BigInt> output(static_cast<std::size_t>(ldofs.Size()));
+  for (int i = 0; i < ldofs.Size(); i++) {
+    double rounded = std::round(ldofs_h[i]);
+    consistent     = consistent && (std::abs(ldofs_h[i] - rounded) == 0.0) && (rounded >= 0.0);
+    output[static_cast<std::size_t>(i)] = static_cast<HYPRE_BigInt>(rounded);
+  }
+  return output;
+}
+
+/**
+ * @brief the locations (in the diagonal and off-diagonal blocks) of every nonzero entry of
+ * the rows of a HypreParMatrix owned by this rank, sorted by global column index
+ */
+struct OwnedRows {
+  /// @brief collect and sort the entries of each row of K
+  OwnedRows(const mfem::SparseMatrix& diag, const mfem::SparseMatrix& offd, const HYPRE_BigInt* cmap,
+            HYPRE_BigInt col_start)
+  {
+    int num_rows = diag.Height();
+    row_ptr.resize(static_cast<std::size_t>(num_rows + 1));
+    row_ptr[0] = 0;
+    for (int r = 0; r < num_rows; r++) {
+      row_ptr[std::size_t(r) + 1] = row_ptr[std::size_t(r)] + (diag.GetI()[r + 1] - diag.GetI()[r]) +
+                                    ((offd.Height() > 0) ? (offd.GetI()[r + 1] - offd.GetI()[r]) : 0);
+    }
+
+    entries.resize(static_cast<std::size_t>(row_ptr.back()));
+    int diag_nnz = diag.NumNonZeroElems();
+    for (int r = 0; r < num_rows; r++) {
+      auto count = static_cast<std::size_t>(row_ptr[std::size_t(r)]);
+      for (int k = diag.GetI()[r]; k < diag.GetI()[r + 1]; k++) {
+        entries[count++] = {col_start + diag.GetJ()[k], k};
+      }
+      if (offd.Height() > 0) {
+        for (int k = offd.GetI()[r]; k < offd.GetI()[r + 1]; k++) {
+          entries[count++] = {cmap[offd.GetJ()[k]], diag_nnz + k};
+        }
+      }
+      std::sort(entries.begin() + row_ptr[std::size_t(r)], entries.begin() + row_ptr[std::size_t(r) + 1]);
+    }
+  }
+
+  /// @brief find where entry (r, col) of K is stored, or -1 if it is not in the sparsity pattern
+  int find(int r, HYPRE_BigInt col) const
+  {
+    auto begin = entries.begin() + row_ptr[std::size_t(r)];
+    auto end   = entries.begin() + row_ptr[std::size_t(r) + 1];
+    auto it    = std::lower_bound(begin, end, std::pair<HYPRE_BigInt, int>{col, -1});
+    return (it != end && it->first == col) ? it->second : -1;
+  }
+
+  std::vector<int>                          row_ptr;  ///< offsets of each row in `entries`
+  std::vector<std::pair<HYPRE_BigInt, int>> entries;  ///< {global column, slot} for each nonzero entry
+};
+
+}  // namespace
+
+bool InPlaceAssembly::isSupported(const mfem::ParFiniteElementSpace& test_space,
+                                  const mfem::ParFiniteElementSpace& trial_space)
+{
+  for (auto fes : {&test_space, &trial_space}) {
+    // nonconforming meshes have prolongation operators that interpolate, and
+    // Hcurl spaces may flip the sign of shared dofs, so neither can use this simplification
+    if (fes->Nonconforming()) return false;
+    if (fes->FEColl()->GetContType() == mfem::FiniteElementCollection::TANGENTIAL) return false;
+  }
+  return true;
+}
+
+InPlaceAssembly::InPlaceAssembly(const mfem::ParFiniteElementSpace& test_space,
+                                 const mfem::ParFiniteElementSpace& trial_space, const std::vector<int>& row_ptr,
+                                 const std::vector<int>& col_ind, mfem::HypreParMatrix& K)
+    : comm_(K.GetComm()), valid_(true)
+{
+  int rank      = 0;
+  int num_ranks = 0;
+  MPI_Comm_rank(comm_, &rank);
+  MPI_Comm_size(comm_, &num_ranks);
+
+  bool consistent  = true;
+  auto global_rows = globalTrueDofNumbers(test_space, consistent);
+  auto global_cols = globalTrueDofNumbers(trial_space, consistent);
+  valid_           = consistent;
+
+  // find out which rank owns each row of K
+  std::vector<HYPRE_BigInt> row_starts(static_cast<std::size_t>(num_ranks) + 1);
+  HYPRE_BigInt              my_row_start = test_space.GetMyTDofOffset();
+  MPI_Allgather(&my_row_start, 1, HYPRE_MPI_BIG_INT, row_starts.data(), 1, HYPRE_MPI_BIG_INT, comm_);
+  row_starts.back() = test_space.GlobalTrueVSize();
+
+  HYPRE_BigInt my_row_end = row_starts[std::size_t(rank) + 1];
+  HYPRE_BigInt col_start  = trial_space.GetMyTDofOffset();
+
+  K.HostRead();
+  mfem::SparseMatrix diag, offd;
+  HYPRE_BigInt*      cmap = nullptr;
+  K.GetDiag(diag);
+  K.GetOffd(offd, cmap);
+
+  diag_nnz_ = diag.NumNonZeroElems();
+  offd_nnz_ = (offd.Height() > 0) ? offd.NumNonZeroElems() : 0;
+
+  OwnedRows owned(diag, offd, cmap, col_start);
+
+  // figure out where the entries that belong to this processor go, and group the rest by owner
+  std::map<int, std::vector<int>>          sends;
+  std::map<int, std::vector<HYPRE_BigInt>> send_patterns;
+
+  auto num_local_rows = static_cast<int>(row_ptr.size()) - 1;
+  local_slots_.assign(col_ind.size(), -1);
+  for (int r = 0; r < num_local_rows && valid_; r++) {
+    HYPRE_BigInt global_row = global_rows[std::size_t(r)];
+    bool         is_owned   = (my_row_start <= global_row && global_row < my_row_end);
+    int          owner      = rank;
+    if (!is_owned) {
+      owner = int(std::upper_bound(row_starts.begin(), row_starts.end(), global_row) - row_starts.begin()) - 1;
+    }
+
+    for (int k = row_ptr[std::size_t(r)]; k < row_ptr[std::size_t(r) + 1]; k++) {
+      if (is_owned) {
+        local_slots_[std::size_t(k)] =
+            owned.find(int(global_row - my_row_start), global_cols[std::size_t(col_ind[std::size_t(k)])]);
+        valid_ = valid_ && (local_slots_[std::size_t(k)] != -1);
+      } else {
+        sends[owner].push_back(k);
+        send_patterns[owner].push_back(global_row);
+        send_patterns[owner].push_back(global_cols[std::size_t(col_ind[std::size_t(k)])]);
+      }
+    }
+  }
+
+  // tell the owners which entries they will be receiving from this rank
+  std::vector<int> send_counts(static_cast<std::size_t>(num_ranks), 0);
+  std::vector<int> recv_counts(static_cast<std::size_t>(num_ranks), 0);
+
+  send_offsets_.push_back(0);
+  for (auto& [owner, ids] : sends) {
+    send_ranks_.push_back(owner);
+    send_ids_.insert(send_ids_.end(), ids.begin(), ids.end());
+    send_offsets_.push_back(static_cast<int>(send_ids_.size()));
+    send_counts[std::size_t(owner)] = 2 * static_cast<int>(ids.size());
+  }
+
+  MPI_Alltoall(send_counts.data(), 1, MPI_INT, recv_counts.data(), 1, MPI_INT, comm_);
+
+  std::vector<int> send_displs(static_cast<std::size_t>(num_ranks) + 1, 0);
+  std::vector<int> recv_displs(static_cast<std::size_t>(num_ranks) + 1, 0);
+  for (std::size_t i = 0; i < std::size_t(num_ranks); i++) {
+    send_displs[i + 1] = send_displs[i] + send_counts[i];
+    recv_displs[i + 1] = recv_displs[i] + recv_counts[i];
+  }
+
+  // note: std::map iterates over the owners in ascending order, which matches the layout of send_displs
+  std::vector<HYPRE_BigInt> send_entries;
+  std::vector<HYPRE_BigInt> recv_entries(static_cast<std::size_t>(recv_displs.back()));
+  for (auto& [owner, pattern] : send_patterns) {
+    send_entries.insert(send_entries.end(), pattern.begin(), pattern.end());
+  }
+
+  MPI_Alltoallv(send_entries.data(), send_counts.data(), send_displs.data(), HYPRE_MPI_BIG_INT, recv_entries.data(),
+                recv_counts.data(), recv_displs.data(), HYPRE_MPI_BIG_INT, comm_);
+
+  recv_offsets_.push_back(0);
+  for (int i = 0; i < num_ranks; i++) {
+    if (recv_counts[std::size_t(i)] == 0) continue;
+
+    recv_ranks_.push_back(i);
+    for (int j = recv_displs[std::size_t(i)]; j < recv_displs[std::size_t(i) + 1]; j += 2) {
+      HYPRE_BigInt global_row = recv_entries[std::size_t(j)];
+      HYPRE_BigInt global_col = recv_entries[std::size_t(j) + 1];
+      int          slot       = owned.find(int(global_row - my_row_start), global_col);
+      valid_                  = valid_ && (slot != -1);
+      recv_slots_.push_back(slot);
+    }
+    recv_offsets_.push_back(static_cast<int>(recv_slots_.size()));
+  }
+
+  send_buffer_.resize(send_ids_.size());
+  recv_buffer_.resize(recv_slots_.size());
+
+  // every rank has to agree on whether or not in-place updates are possible
+  int local_valid  = valid_ ? 1 : 0;
+  int global_valid = 0;
+  MPI_Allreduce(&local_valid, &global_valid, 1, MPI_INT, MPI_MIN, comm_);
+  valid_ = (global_valid == 1);
+
+  SLIC_WARNING_ROOT_IF(!valid_, "sparsity pattern mismatch, in-place matrix assembly is disabled for this operator");
+}
+
+bool InPlaceAssembly::matches(mfem::HypreParMatrix& K) const
+{
+  mfem::SparseMatrix diag, offd;
+  HYPRE_BigInt*      cmap = nullptr;
+  K.GetDiag(diag);
+  K.GetOffd(offd, cmap);
+
+  int offd_nnz = (offd.Height() > 0) ? offd.NumNonZeroElems() : 0;
+  return (diag.NumNonZeroElems() == diag_nnz_) && (offd_nnz == offd_nnz_);
+}
+
+void InPlaceAssembly::update(const double* values, mfem::HypreParMatrix& K) const
+{
+  SLIC_ERROR_ROOT_IF(!valid_, "in-place assembly is not available for this operator");
+
+  std::vector<MPI_Request> requests(recv_ranks_.size() + send_ranks_.size());
+
+  // start receiving the contributions to rows owned by this rank
+  constexpr int tag = 0;
+  for (std::size_t i = 0; i < recv_ranks_.size(); i++) {
+    MPI_Irecv(&recv_buffer_[std::size_t(recv_offsets_[i])], recv_offsets_[i + 1] - recv_offsets_[i], MPI_DOUBLE,
+              recv_ranks_[i], tag, comm_, &requests[i]);
+  }
+
+  // and send the contributions to rows owned by other ranks
+  for (std::size_t i = 0; i < send_ids_.size(); i++) {
+    send_buffer_[i] = values[send_ids_[i]];
+  }
+
+  for (std::size_t i = 0; i < send_ranks_.size(); i++) {
+    MPI_Isend(&send_buffer_[std::size_t(send_offsets_[i])], send_offsets_[i + 1] - send_offsets_[i], MPI_DOUBLE,
+              send_ranks_[i], tag, comm_, &requests[recv_ranks_.size() + i]);
+  }
+
+  K.HostReadWrite();
+  mfem::SparseMatrix diag, offd;
+  HYPRE_BigInt*      cmap = nullptr;
+  K.GetDiag(diag);
+  K.GetOffd(offd, cmap);
+
+  double* diag_values = diag.GetData();
+  double* offd_values = (offd_nnz_ > 0) ? offd.GetData() : nullptr;
+
+  std::fill(diag_values, diag_values + diag_nnz_, 0.0);
+  std::fill(offd_values, offd_values + offd_nnz_, 0.0);
+
+  auto add = [&](int slot, double value) {
+    if (slot < diag_nnz_) {
+      diag_values[slot] += value;
+    } else {
+      offd_values[slot - diag_nnz_] += value;
+    }
+  };
+
+  // while the messages are in flight, add in the local contributions
+  for (std::size_t k = 0; k < local_slots_.size(); k++) {
+    if (local_slots_[k] != -1) {
+      add(local_slots_[k], values[k]);
+    }
+  }
+
+  MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+
+  for (std::size_t i = 0; i < recv_slots_.size(); i++) {
+    add(recv_slots_[i], recv_buffer_[i]);
+  }
+}
+
+}  // namespace serac
@@ -0,0 +1,126 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file in_place_assembly.hpp
+ *
+ * @brief Lookup tables for refreshing the values of an assembled mfem::HypreParMatrix without
+ * redoing the parallel triple product (RAP) that was used to create it
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "mfem.hpp"
+
+namespace serac {
+
+/**
+ * @brief this object records where each nonzero entry of a rank-local sparse matrix A (defined on the local
+ * "L-vector" dofs) ends up in the parallel matrix K = R^T A P created by mfem::RAP(R, A, P), where R and P are the
+ * Dof_TrueDof matrices of the test and trial spaces.
+ *
+ * When R and P only copy values between dofs (i.e. conforming, non-Hcurl spaces), K's entries are just sums of
+ * entries of A, so new values of A can be added directly into K's storage (with a single neighbor-to-neighbor
+ * exchange for the contributions to rows owned by other ranks). This keeps K's sparsity pattern, row/column
+ * partitioning and communication package, and avoids allocating and multiplying matrices every time the values change.
+ */
+class InPlaceAssembly {
+public:
+  /**
+   * @brief whether the prolongation operators of the given spaces are simple enough to support in-place updates
+   *
+   * @param test_space the test space (rows of K)
+   * @param trial_space the trial space (columns of K)
+   */
+  static bool isSupported(const mfem::ParFiniteElementSpace& test_space,
+                          const mfem::ParFiniteElementSpace& trial_space);
+
+  /**
+   * @brief build the lookup tables for a given local sparsity pattern
+   *
+   * @param test_space the test space (rows of K)
+   * @param trial_space the trial space (columns of K)
+   * @param row_ptr CSR row offsets of the local matrix A
+   * @param col_ind CSR column indices of the local matrix A
+   * @param K the result of mfem::RAP(R, A, P) for this sparsity pattern
+   *
+   * @note this constructor is collective over the communicator of K
+   */
+  InPlaceAssembly(const mfem::ParFiniteElementSpace& test_space, const mfem::ParFiniteElementSpace& trial_space,
+                  const std::vector<int>& row_ptr, const std::vector<int>& col_ind, mfem::HypreParMatrix& K);
+
+  /**
+   * @brief whether every local nonzero was found in the sparsity pattern of K (on every rank)
+   *
+   * if this is false, `update` must not be called, and K should be reassembled with mfem::RAP instead
+   */
+  bool valid() const { return valid_; }
+
+  /**
+   * @brief whether this object was built for (a matrix with the same local layout as) K
+   * @param K the matrix in question
+   */
+  bool matches(mfem::HypreParMatrix& K) const;
+
+  /**
+   * @brief overwrite the values of K with R^T A P, for a new set of values of A
+   *
+   * @param values the CSR values of the local matrix A, in the sparsity pattern given at construction
+   * @param K the matrix that was used to construct this object (possibly modified since, e.g. by
+   *          eliminating essential boundary conditions, as long as its sparsity pattern is the same)
+   *
+   * @note this function is collective over the communicator of K
+   */
+  void update(const double* values, mfem::HypreParMatrix& K) const;
+
+private:
+  /// @brief the communicator of K
+  MPI_Comm comm_;
+
+  /// @brief false if some entries of A did not have a corresponding entry in K
+  bool valid_;
+
+  /// @brief the number of nonzero entries in the diagonal block of the rows of K owned by this rank
+  int diag_nnz_;
+
+  /// @brief the number of nonzero entries in the off-diagonal block of the rows of K owned by this rank
+  int offd_nnz_;
+
+  /**
+   * @brief for each nonzero of A: where its value goes in K (indices in [0, diag_nnz_) refer to the diagonal
+   * block's values array, indices in [diag_nnz_, diag_nnz_ + offd_nnz_) refer to the off-diagonal block's values
+   * array), or -1 if it belongs to a row of K owned by another rank
+   */
+  std::vector<int> local_slots_;
+
+  /// @brief the ranks that this rank sends contributions to
+  std::vector<int> send_ranks_;
+
+  /// @brief send_ids_[send_offsets_[i]] ... send_ids_[send_offsets_[i+1] - 1] are the entries sent to send_ranks_[i]
+  std::vector<int> send_offsets_;
+
+  /// @brief which nonzero entries of A are sent to other ranks
+  std::vector<int> send_ids_;
+
+  /// @brief the ranks that this rank receives contributions from
+  std::vector<int> recv_ranks_;
+
+  /// @brief recv_slots_[recv_offsets_[i]] ... recv_slots_[recv_offsets_[i+1] - 1] are the entries from recv_ranks_[i]
+  std::vector<int> recv_offsets_;
+
+  /// @brief where each contribution received from another rank goes in K (same convention as local_slots_)
+  std::vector<int> recv_slots_;
+
+  /// @brief staging buffer for values sent to other ranks
+  mutable std::vector<double> send_buffer_;
+
+  /// @brief staging buffer for values received from other ranks
+  mutable std::vector<double> recv_buffer_;
+};
+
+}  // namespace serac
@@ -6,8 +6,12 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <memory>
+#include <set>
+#include <string>
+#include <typeinfo>
 
 #include "mfem.hpp"
 
@@ -16,6 +20,7 @@
 #include "serac/numerics/functional/function_signature.hpp"
 #include "serac/numerics/functional/domain_integral_kernels.hpp"
 #include "serac/numerics/functional/boundary_integral_kernels.hpp"
+#include "serac/numerics/functional/interior_face_integral_kernels.hpp"
 #include "serac/numerics/functional/differentiate_wrt.hpp"
 
 namespace serac {
@@ -26,17 +31,21 @@ struct Integral {
    * @brief the different kinds of supported integrals
    * @note Domain: spatial dimension == geometry dimension
    * @note Boundary: spatial dimension == geometry dimension + 1
+   * @note InteriorFace: spatial dimension == geometry dimension + 1, with values from the elements on either side
    */
   enum Type
   {
     Domain,
     Boundary,
-    // DG, unimplemented
+    InteriorFace,
     _size
   };
 
   /// @brief a list of all possible integral types, used for range-for loops
-  static constexpr Type Types[2] = {Domain, Boundary};
+  static constexpr Type Types[3] = {Domain, Boundary, InteriorFace};
+
+  /// @brief the name of each kind of integral, e.g. for profiling
+  static constexpr const char* TypeNames[3] = {"Domain", "Boundary", "InteriorFace"};
 
   /// @brief the number of different kinds of integrals
   static constexpr std::size_t num_types = Type::_size;
@@ -50,12 +59,18 @@ struct Integral {
    * @param t the type of integral
    * @param trial_space_indices a list of which trial spaces are used in the integrand
    */
-  Integral(Type t, std::vector<uint32_t> trial_space_indices) : type(t), active_trial_spaces_(trial_space_indices)
+  Integral(Type t, std::vector<uint32_t> trial_space_indices)
+      : type(t),
+        active_trial_spaces_(trial_space_indices),
+        interpolation_cache_(std::make_shared<InterpolationCacheState>())
   {
     std::size_t num_trial_spaces = trial_space_indices.size();
     evaluation_with_AD_.resize(num_trial_spaces);
     jvp_.resize(num_trial_spaces);
+    vjp_.resize(num_trial_spaces);
     element_gradient_.resize(num_trial_spaces);
+    symmetric_element_gradient_.resize(num_trial_spaces);
+    qoi_gradient_.resize(num_trial_spaces);
 
     for (uint32_t i = 0; i < num_trial_spaces; i++) {
       functional_to_integral_index_[active_trial_spaces_[i]] = i;
@@ -88,9 +103,119 @@ struct Integral {
     for (auto& [geometry, func] : kernels) {
       std::vector<const double*> inputs(active_trial_spaces_.size());
       for (std::size_t i = 0; i < active_trial_spaces_.size(); i++) {
-        inputs[i] = input_E[uint32_t(active_trial_spaces_[i])].GetBlock(geometry).Read();
+        inputs[i] = Read(input_E[uint32_t(active_trial_spaces_[i])].GetBlock(geometry));
       }
-      func(inputs, output_E.GetBlock(geometry).ReadWrite(), update_state);
+      EvaluateOnDomain(geometry, inputs, -1, ReadWrite(output_E.GetBlock(geometry)), 0, NumMeshElements(geometry), 1,
+                       [&, &func = func](const std::vector<const double*>& values, double* outputs,
+                                         uint32_t first_element, uint32_t num_elements) {
+                         func(values, outputs, update_state, first_element, num_elements);
+                       });
+    }
+  }
+
+  /**
+   * @brief evaluate the integral, storing q-function derivatives with respect to each of the given trial spaces
+   * (that this integral depends on) in a single pass over the elements
+   *
+   * @param input_E see Integral::Mult()
+   * @param output_E see Integral::Mult()
+   * @param differentiation_indices the (Functional) indices of the trial spaces to differentiate with respect to
+   * @param update_state see Integral::Mult()
+   */
+  void Mult(const std::vector<mfem::BlockVector>& input_E, mfem::BlockVector& output_E,
+            const std::vector<uint32_t>& differentiation_indices, bool update_state) const
+  {
+    output_E = 0.0;
+
+    std::vector<const double*> inputs(active_trial_spaces_.size());
+    for (auto& [geometry, func] : evaluation_) {
+      for (std::size_t i = 0; i < active_trial_spaces_.size(); i++) {
+        inputs[i] = Read(input_E[uint32_t(active_trial_spaces_[i])].GetBlock(geometry));
+      }
+      Mult(geometry, inputs, ReadWrite(output_E.GetBlock(geometry)), 0, NumMeshElements(geometry),
+           differentiation_indices, update_state);
+    }
+  }
+
+  /**
+   * @brief evaluate the integral over a range of elements of one geometry, optionally storing
+   * q-function derivatives with respect to a specific trial space.
+   *
+   * @param geometry the element geometry
+   * @param inputs the input values (one pointer for each of this integral's active trial spaces, in the order of
+   * `active_trial_spaces_`) for the elements [first_element, first_element + num_elements)
+   * @param outputs the (zero-initialized) output values for the elements [first_element, first_element + num_elements)
+   * @param first_element the index of the first element to evaluate
+   * @param num_elements how many elements to evaluate
+   * @param differentiation_index see Integral::Mult()
+   * @param update_state see Integral::Mult()
+   *
+   * @note the elements are numbered like the mesh's elements of this geometry, even for integrals restricted to
+   * some of them (see `subsets_`), whose other elements are skipped
+   * @note all of the pointers must refer to memory in the execution space this Integral was created for
+   */
+  void Mult(mfem::Geometry::Type geometry, const std::vector<const double*>& inputs, double* outputs,
+            uint32_t first_element, uint32_t num_elements, uint32_t differentiation_index, bool update_state) const
+  {
+    bool with_AD =
+        (functional_to_integral_index_.count(differentiation_index) > 0 && differentiation_index != NO_DIFFERENTIATION);
+    auto& kernels =
+        (with_AD) ? evaluation_with_AD_[functional_to_integral_index_.at(differentiation_index)] : evaluation_;
+    auto kernel = kernels.find(geometry);
+    if (kernel != kernels.end()) {
+      EvaluateOnDomain(geometry, inputs, -1, outputs, first_element, num_elements, 1,
+                       [&](const std::vector<const double*>& values, double* outputs_e, uint32_t first, uint32_t n) {
+                         kernel->second(values, outputs_e, update_state, first, n);
+                       });
+    }
+  }
+
+  /**
+   * @brief evaluate the integral over a range of elements of one geometry, storing q-function derivatives with
+   * respect to each of the given trial spaces (that this integral depends on)
+   *
+   * @param geometry see Integral::Mult()
+   * @param inputs see Integral::Mult()
+   * @param outputs see Integral::Mult()
+   * @param first_element see Integral::Mult()
+   * @param num_elements see Integral::Mult()
+   * @param differentiation_indices the (Functional) indices of the trial spaces to differentiate with respect to
+   * @param update_state see Integral::Mult()
+   */
+  void Mult(mfem::Geometry::Type geometry, const std::vector<const double*>& inputs, double* outputs,
+            uint32_t first_element, uint32_t num_elements, const std::vector<uint32_t>& differentiation_indices,
+            bool update_state) const
+  {
+    // bit i is set if the derivatives w.r.t. (integral) trial space i are requested
+    uint32_t which = 0;
+    for (auto index : differentiation_indices) {
+      auto integral_index = functional_to_integral_index_.find(index);
+      if (integral_index != functional_to_integral_index_.end()) {
+        which |= uint32_t(1) << integral_index->second;
+      }
+    }
+
+    // evaluations with at most one derivative use the kernels specialized for that case
+    if ((which & (which - 1)) == 0) {
+      uint32_t i = 0;
+      while ((which >> i) > 1) i++;
+      auto& kernels = (which == 0) ? evaluation_ : evaluation_with_AD_[i];
+      auto  kernel  = kernels.find(geometry);
+      if (kernel != kernels.end()) {
+        EvaluateOnDomain(geometry, inputs, -1, outputs, first_element, num_elements, 1,
+                         [&](const std::vector<const double*>& values, double* outputs_e, uint32_t first, uint32_t n) {
+                           kernel->second(values, outputs_e, update_state, first, n);
+                         });
+      }
+      return;
+    }
+
+    auto kernel = evaluation_with_multiple_AD_.find(geometry);
+    if (kernel != evaluation_with_multiple_AD_.end()) {
+      EvaluateOnDomain(geometry, inputs, -1, outputs, first_element, num_elements, 1,
+                       [&](const std::vector<const double*>& values, double* outputs_e, uint32_t first, uint32_t n) {
+                         kernel->second(values, outputs_e, update_state, first, n, which);
+                       });
     }
   }
 
@@ -111,25 +236,428 @@ struct Integral {
     // if this integral actually depends on the specified variable
     if (functional_to_integral_index_.count(differentiation_index) > 0) {
       for (auto& [geometry, func] : jvp_[functional_to_integral_index_.at(differentiation_index)]) {
-        func(input_E.GetBlock(geometry).Read(), output_E.GetBlock(geometry).ReadWrite());
+        GradientMult(geometry, Read(input_E.GetBlock(geometry)), ReadWrite(output_E.GetBlock(geometry)), 0,
+                     NumMeshElements(geometry), differentiation_index);
       }
     }
   }
 
+  /**
+   * @brief evaluate the jacobian(with respect to some trial space)-vector product of this integral
+   * over a range of elements of one geometry
+   *
+   * @param geometry the element geometry
+   * @param input the values of the specified trial space for the elements [first_element, first_element + num_elements)
+   * @param output the (zero-initialized) output values for the elements [first_element, first_element + num_elements)
+   * @param first_element the index of the first element to evaluate
+   * @param num_elements how many elements to evaluate
+   * @param differentiation_index see Integral::GradientMult()
+   * @param num_directions how many perturbations to apply the jacobian to: `input` and `output` hold the values for
+   * each perturbation one after another (each describing `num_elements` elements), and the q-function derivatives
+   * are only read once for all of them
+   *
+   * @note the elements are numbered like the mesh's elements of this geometry (see Integral::Mult())
+   * @note all of the pointers must refer to memory in the execution space this Integral was created for
+   */
+  void GradientMult(mfem::Geometry::Type geometry, const double* input, double* output, uint32_t first_element,
+                    uint32_t num_elements, uint32_t differentiation_index, uint32_t num_directions = 1) const
+  {
+    // if this integral actually depends on the specified variable
+    if (functional_to_integral_index_.count(differentiation_index) > 0) {
+      uint32_t index   = functional_to_integral_index_.at(differentiation_index);
+      auto&    kernels = jvp_[index];
+      auto     kernel  = kernels.find(geometry);
+      if (kernel != kernels.end()) {
+        EvaluateOnDomain(geometry, {input}, int(index), output, first_element, num_elements, num_directions,
+                         [&](const std::vector<const double*>& values, double* outputs, uint32_t first, uint32_t n) {
+                           kernel->second(values[0], outputs, first, n, num_directions);
+                         });
+      }
+    }
+  }
+
+  /**
+   * @brief whether GradientMultTranspose() can apply the transpose of the gradient (w.r.t. some trial space) of this
+   * integral directly from the stored q-function derivatives, which requires that they are stored (so, not for
+   * q-functions wrapped with `with_constant_derivatives()` or `with_recomputed_derivatives()`), and not on interior
+   * faces
+   *
+   * @param differentiation_index the (Functional) index of the trial space
+   */
+  bool HasGradientTranspose(uint32_t differentiation_index) const
+  {
+    auto index = functional_to_integral_index_.find(differentiation_index);
+    if (index == functional_to_integral_index_.end()) return true;
+
+    for (auto& [geometry, func] : jvp_[index->second]) {
+      if (vjp_[index->second].count(geometry) == 0) return false;
+    }
+    return true;
+  }
+
+  /**
+   * @brief evaluate the vector-jacobian product of this integral: the action of the transpose of its gradient
+   * (with respect to some trial space), without forming the element matrices
+   *
+   * @param input_E a block vector (block index corresponds to the element geometry) of the test space values of
+   * each element
+   * @param output_E a block vector (block index corresponds to the element geometry) of the resulting trial space
+   * values of each element
+   * @param differentiation_index the (Functional) index of the trial space
+   *
+   * @pre HasGradientTranspose(differentiation_index), and a prior call to Mult() that stored the q-function
+   * derivatives w.r.t. that trial space
+   */
+  void GradientMultTranspose(const mfem::BlockVector& input_E, mfem::BlockVector& output_E,
+                             uint32_t differentiation_index) const
+  {
+    output_E = 0.0;
+
+    if (functional_to_integral_index_.count(differentiation_index) == 0) return;
+
+    uint32_t index = functional_to_integral_index_.at(differentiation_index);
+    for (auto& [geometry, func] : vjp_[index]) {
+      const double* input  = Read(input_E.GetBlock(geometry));
+      double*       output = ReadWrite(output_E.GetBlock(geometry));
+
+      auto subset = subsets_.find(geometry);
+      if (subset == subsets_.end()) {
+        func(input, output, 0, NumElements(geometry));
+        continue;
+      }
+
+      // the kernels only see the elements in this integral's domain, so their values are copied to (and from)
+      // contiguous buffers, as in EvaluateOnDomain()
+      const auto&         elements     = subset->second.elements;
+      uint64_t            test_values  = subset->second.test_values_per_element;
+      uint64_t            trial_values = subset->second.trial_values_per_element[index];
+      std::vector<double> input_buffer(elements.size() * test_values);
+      std::vector<double> output_buffer(elements.size() * trial_values, 0.0);
+      for (std::size_t e = 0; e < elements.size(); e++) {
+        const double* source = input + elements[e] * test_values;
+        std::copy(source, source + test_values, input_buffer.data() + e * test_values);
+      }
+      func(input_buffer.data(), output_buffer.data(), 0, uint32_t(elements.size()));
+      for (std::size_t e = 0; e < elements.size(); e++) {
+        const double* source = output_buffer.data() + e * trial_values;
+        std::copy(source, source + trial_values, output + elements[e] * trial_values);
+      }
+    }
+  }
+
+  /**
+   * @brief evaluate the integral over a range of elements of one geometry, along with its directional derivatives
+   * in several directions, each of which perturbs one of the trial spaces
+   *
+   * @param geometry see Integral::Mult()
+   * @param inputs see Integral::Mult()
+   * @param directions the values of each direction for the elements [first_element, first_element + num_elements),
+   * which may be nullptr for directions that perturb a trial space this integral doesn't depend on
+   * @param which the (Functional) index of the trial space that each direction perturbs
+   * @param outputs the (zero-initialized) output values, followed by the derivative in each direction (each
+   * describing the elements [first_element, first_element + num_elements))
+   * @param first_element see Integral::Mult()
+   * @param num_elements see Integral::Mult()
+   *
+   * @note this requires a q-function wrapped with `with_directional_derivatives()`
+   */
+  void DirectionalMult(mfem::Geometry::Type geometry, const std::vector<const double*>& inputs,
+                       const std::vector<const double*>& directions, const std::vector<uint32_t>& which,
+                       double* outputs, uint32_t first_element, uint32_t num_elements) const
+  {
+    auto kernel = directional_derivatives_.find(geometry);
+    if (kernel == directional_derivatives_.end()) {
+      SLIC_ERROR_IF(evaluation_.count(geometry) > 0,
+                    "directional derivatives require a q-function wrapped with with_directional_derivatives()");
+      return;
+    }
+
+    // the directions are passed along with the trial space values, so that integrals restricted to some of the
+    // elements copy both of them with EvaluateOnDomain()
+    std::vector<const double*> values(inputs);
+    std::vector<uint32_t>      trial_indices(inputs.size());
+    std::vector<uint32_t>      direction_trial(which.size(), NO_DIFFERENTIATION);
+    for (uint32_t i = 0; i < inputs.size(); i++) {
+      trial_indices[i] = i;
+    }
+    for (std::size_t d = 0; d < which.size(); d++) {
+      auto index = functional_to_integral_index_.find(which[d]);
+      if (index != functional_to_integral_index_.end()) {
+        direction_trial[d] = index->second;
+        values.push_back(directions[d]);
+        trial_indices.push_back(index->second);
+      }
+    }
+
+    auto num_outputs = uint32_t(which.size() + 1);
+    EvaluateOnDomain(geometry, values, trial_indices, outputs, first_element, num_elements, 1, num_outputs,
+                     [&](const std::vector<const double*>& v, double* outputs_e, uint32_t first, uint32_t n) {
+                       std::vector<const double*> directions_e(which.size(), nullptr);
+                       for (std::size_t d = 0, j = inputs.size(); d < which.size(); d++) {
+                         if (direction_trial[d] != NO_DIFFERENTIATION) directions_e[d] = v[j++];
+                       }
+                       std::vector<const double*> inputs_e(v.begin(), v.begin() + std::ptrdiff_t(inputs.size()));
+                       kernel->second(inputs_e, directions_e, direction_trial, outputs_e, first, n);
+                     });
+  }
+
+  /// @brief the number of elements of the given geometry in this integral's domain
+  uint32_t NumElements(mfem::Geometry::Type geometry) const
+  {
+    auto gf = geometric_factors_.find(geometry);
+    return (gf == geometric_factors_.end()) ? 0 : uint32_t(gf->second->num_elements);
+  }
+
+  /**
+   * @brief the number of elements of the given geometry in the mesh, which is also the number of elements in this
+   * integral's domain, unless the integral is restricted to some of them (see `subsets_`)
+   */
+  uint32_t NumMeshElements(mfem::Geometry::Type geometry) const
+  {
+    auto subset = subsets_.find(geometry);
+    return (subset == subsets_.end()) ? NumElements(geometry) : subset->second.num_mesh_elements;
+  }
+
+  /**
+   * @brief call `f(begin, end)` for each run [begin, end) of consecutive elements (of the given geometry, in the
+   * mesh's numbering) within [first_element, last_element) that belong to this integral's domain, so that callers
+   * can skip the elements that don't
+   */
+  template <typename callable>
+  void ForEachElementRun(mfem::Geometry::Type geometry, uint32_t first_element, uint32_t last_element,
+                         callable&& f) const
+  {
+    auto subset = subsets_.find(geometry);
+    if (subset == subsets_.end()) {
+      if (first_element < last_element) f(first_element, last_element);
+      return;
+    }
+
+    const auto& elements = subset->second.elements;
+    auto        it       = std::lower_bound(elements.begin(), elements.end(), first_element);
+    while (it != elements.end() && *it < last_element) {
+      uint32_t begin = *it;
+      uint32_t end   = begin + 1;
+      while (++it != elements.end() && *it == end && end < last_element) end++;
+      f(begin, end);
+    }
+  }
+
   /**
    * @brief evaluate the jacobian (with respect to some trial space) of this integral
    *
    * @param K_e a collection (one for each element type) of element jacobians (num_elements x trial_dofs_per_elem x
    * test_dofs_per_elem)
    * @param differentiation_index the index of the trial space being differentiated
+   * @param symmetric whether to only compute the upper triangle of each element matrix, stored row by row (in which
+   * case K_e is num_elements x 1 x detail::upper_triangle_size(dofs_per_elem)), for trial spaces that are also the
+   * test space, and q-functions with symmetric tangents
+   *
+   * @note K_e must live in the memory space of the execution space this Integral was created for
    */
-  void ComputeElementGradients(std::map<mfem::Geometry::Type, ExecArray<double, 3, ExecutionSpace::CPU> >& K_e,
-                               uint32_t differentiation_index) const
+  template <axom::MemorySpace space>
+  void ComputeElementGradients(std::map<mfem::Geometry::Type, axom::Array<double, 3, space> >& K_e,
+                               uint32_t differentiation_index, bool symmetric = false) const
   {
     // if this integral actually depends on the specified variable
     if (functional_to_integral_index_.count(differentiation_index) > 0) {
-      for (auto& [geometry, func] : element_gradient_[functional_to_integral_index_.at(differentiation_index)]) {
-        func(view(K_e[geometry]));
+      uint32_t index = functional_to_integral_index_.at(differentiation_index);
+      for (auto& [geometry, func] : element_gradient_[index]) {
+        // kernels without a symmetric counterpart compute the whole element matrices, which are then packed
+        const grad_func* kernel = &func;
+        bool             pack   = false;
+        if (symmetric) {
+          auto symmetric_kernel = symmetric_element_gradient_[index].find(geometry);
+          pack                  = (symmetric_kernel == symmetric_element_gradient_[index].end());
+          if (!pack) kernel = &symmetric_kernel->second;
+        }
+
+        auto& K      = K_e[geometry];
+        auto  subset = subsets_.find(geometry);
+        if (subset == subsets_.end() && !pack) {
+          (*kernel)(K.data());
+          continue;
+        }
+
+        // the kernels only compute the element matrices of the elements in this integral's domain,
+        // which are then added to those of the corresponding mesh elements
+        bool     all_elements      = (subset == subsets_.end());
+        uint64_t num_mesh_elements = uint64_t(K.shape()[0]);
+        uint64_t num_elements      = all_elements ? num_mesh_elements : subset->second.elements.size();
+        uint64_t entries           = uint64_t(K.size()) / num_mesh_elements;
+        uint32_t dofs              = detail::upper_triangle_dimension(entries);
+        uint64_t computed          = pack ? uint64_t(dofs) * dofs : entries;
+
+        std::vector<double> K_subset(num_elements * computed, 0.0);
+        (*kernel)(K_subset.data());
+        for (std::size_t e = 0; e < num_elements; e++) {
+          double*       K_elem        = K.data() + (all_elements ? e : subset->second.elements[e]) * entries;
+          const double* computed_elem = K_subset.data() + e * computed;
+          if (pack) {
+            for (uint32_t i = 0; i < dofs; i++) {
+              for (uint32_t j = i; j < dofs; j++) {
+                K_elem[detail::upper_triangle_index(dofs, i, j)] += computed_elem[i * dofs + j];
+              }
+            }
+          } else {
+            for (uint64_t i = 0; i < entries; i++) {
+              K_elem[i] += computed_elem[i];
+            }
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief evaluate the element gradients of this (scalar-valued) integral with respect to some trial space, at the
+   * given inputs, in a single pass that doesn't store the q-function derivatives
+   *
+   * @param input_E see Integral::Mult()
+   * @param K_e see ComputeElementGradients()
+   * @param differentiation_index the index of the trial space being differentiated
+   *
+   * @note unlike ComputeElementGradients(), this doesn't require a prior call to Mult() that differentiates
+   * with respect to the same trial space
+   */
+  template <axom::MemorySpace space>
+  void ComputeQoIGradients(const std::vector<mfem::BlockVector>&                           input_E,
+                           std::map<mfem::Geometry::Type, axom::Array<double, 3, space> >& K_e,
+                           uint32_t differentiation_index) const
+  {
+    if (functional_to_integral_index_.count(differentiation_index) == 0) return;
+
+    for (auto& [geometry, func] : qoi_gradient_[functional_to_integral_index_.at(differentiation_index)]) {
+      std::vector<const double*> inputs(active_trial_spaces_.size());
+      for (std::size_t i = 0; i < active_trial_spaces_.size(); i++) {
+        inputs[i] = Read(input_E[uint32_t(active_trial_spaces_[i])].GetBlock(geometry));
+      }
+
+      auto subset = subsets_.find(geometry);
+      if (subset == subsets_.end()) {
+        func(inputs, K_e[geometry].data());
+        continue;
+      }
+
+      // copy the values of the elements in this integral's domain to contiguous buffers, and add their
+      // element gradients to those of the corresponding mesh elements, as in ComputeElementGradients()
+      const auto&                       elements = subset->second.elements;
+      std::vector<std::vector<double> > input_buffers(inputs.size());
+      std::vector<const double*>        subset_inputs(inputs.size());
+      for (std::size_t i = 0; i < inputs.size(); i++) {
+        uint64_t values = subset->second.trial_values_per_element[i];
+        input_buffers[i].resize(elements.size() * values);
+        for (std::size_t e = 0; e < elements.size(); e++) {
+          const double* source = inputs[i] + elements[e] * values;
+          std::copy(source, source + values, input_buffers[i].data() + e * values);
+        }
+        subset_inputs[i] = input_buffers[i].data();
+      }
+
+      auto&               K       = K_e[geometry];
+      uint64_t            entries = uint64_t(K.size()) / subset->second.num_mesh_elements;
+      std::vector<double> K_subset(elements.size() * entries, 0.0);
+      func(subset_inputs, K_subset.data());
+      for (std::size_t e = 0; e < elements.size(); e++) {
+        double* K_elem = K.data() + elements[e] * entries;
+        for (uint64_t i = 0; i < entries; i++) {
+          K_elem[i] += K_subset[e * entries + i];
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief call `kernel(inputs, outputs, first, count)` (with the signature of @p eval_func, less `update_state`)
+   * for the elements [first_element, first_element + num_elements) that belong to this integral's domain, where the
+   * kernel sees those elements as [first, first + count) in the numbering of this integral's kernels
+   *
+   * @param geometry the element geometry
+   * @param inputs the input values for the mesh elements [first_element, first_element + num_elements), for each of
+   * `num_directions` perturbations one after another
+   * @param trial_index the (integral) index of the trial space of the only input, or -1 for one input per trial space
+   * @param outputs the output values for the mesh elements [first_element, first_element + num_elements)
+   * @param first_element the index of the first element, in the mesh's numbering
+   * @param num_elements how many elements
+   * @param num_directions how many perturbations the inputs and outputs hold, see GradientMult()
+   * @param kernel the kernel to call
+   *
+   * @note when only some of the given elements belong to this integral's domain, their values are copied to (and
+   * from) contiguous buffers on the host, which is why restricted integrals require ExecutionSpace::CPU
+   */
+  template <typename kernel_type>
+  void EvaluateOnDomain(mfem::Geometry::Type geometry, const std::vector<const double*>& inputs, int trial_index,
+                        double* outputs, uint32_t first_element, uint32_t num_elements, uint32_t num_directions,
+                        kernel_type&& kernel) const
+  {
+    if (subsets_.count(geometry) == 0) {
+      kernel(inputs, outputs, first_element, num_elements);
+      return;
+    }
+
+    std::vector<uint32_t> trial_indices(inputs.size());
+    for (uint32_t i = 0; i < inputs.size(); i++) {
+      trial_indices[i] = (trial_index < 0) ? i : uint32_t(trial_index);
+    }
+    EvaluateOnDomain(geometry, inputs, trial_indices, outputs, first_element, num_elements, num_directions,
+                     num_directions, kernel);
+  }
+
+  /**
+   * @brief the counterpart of EvaluateOnDomain() for inputs and outputs that hold different numbers of perturbations
+   *
+   * @param trial_indices the (integral) index of the trial space of each input
+   * @param num_input_blocks how many perturbations each input holds
+   * @param num_output_blocks how many perturbations the outputs hold
+   */
+  template <typename kernel_type>
+  void EvaluateOnDomain(mfem::Geometry::Type geometry, const std::vector<const double*>& inputs,
+                        const std::vector<uint32_t>& trial_indices, double* outputs, uint32_t first_element,
+                        uint32_t num_elements, uint32_t num_input_blocks, uint32_t num_output_blocks,
+                        kernel_type&& kernel) const
+  {
+    auto subset = subsets_.find(geometry);
+    if (subset == subsets_.end()) {
+      kernel(inputs, outputs, first_element, num_elements);
+      return;
+    }
+
+    const auto& elements = subset->second.elements;
+    auto        begin    = std::lower_bound(elements.begin(), elements.end(), first_element);
+    auto        end      = std::lower_bound(begin, elements.end(), first_element + num_elements);
+    auto        first    = uint32_t(begin - elements.begin());
+    auto        count    = uint32_t(end - begin);
+    if (count == 0) return;
+
+    // every one of the given elements belongs to the domain (e.g. a run from ForEachElementRun()),
+    // so the kernel can use their values directly
+    if (count == num_elements) {
+      kernel(inputs, outputs, first, count);
+      return;
+    }
+
+    std::vector<std::vector<double> > input_buffers(inputs.size());
+    std::vector<const double*>        subset_inputs(inputs.size());
+    for (std::size_t i = 0; i < inputs.size(); i++) {
+      uint64_t values = subset->second.trial_values_per_element[trial_indices[i]];
+      input_buffers[i].resize(num_input_blocks * count * values);
+      for (uint64_t d = 0; d < num_input_blocks; d++) {
+        for (uint64_t e = 0; e < count; e++) {
+          const double* source = inputs[i] + (d * num_elements + begin[e] - first_element) * values;
+          std::copy(source, source + values, input_buffers[i].data() + (d * count + e) * values);
+        }
+      }
+      subset_inputs[i] = input_buffers[i].data();
+    }
+
+    uint64_t            values = subset->second.test_values_per_element;
+    std::vector<double> output_buffer(num_output_blocks * count * values, 0.0);
+    kernel(subset_inputs, output_buffer.data(), first, count);
+
+    for (uint64_t d = 0; d < num_output_blocks; d++) {
+      for (uint64_t e = 0; e < count; e++) {
+        const double* source = output_buffer.data() + (d * count + e) * values;
+        std::copy(source, source + values, outputs + (d * num_elements + begin[e] - first_element) * values);
       }
     }
   }
@@ -137,8 +665,11 @@ struct Integral {
   /// @brief which kind of integral is being computed
   Type type;
 
-  /// @brief signature of integral evaluation kernel
-  using eval_func = std::function<void(const std::vector<const double*>&, double*, bool)>;
+  /**
+   * @brief signature of integral evaluation kernel: (inputs, outputs, update_state, first_element, num_elements),
+   * where the inputs and outputs describe the elements [first_element, first_element + num_elements)
+   */
+  using eval_func = std::function<void(const std::vector<const double*>&, double*, bool, uint32_t, uint32_t)>;
 
   /// @brief kernels for integral evaluation over each type of element
   std::map<mfem::Geometry::Type, eval_func> evaluation_;
@@ -146,18 +677,70 @@ struct Integral {
   /// @brief kernels for integral evaluation + derivative w.r.t. specified argument over each type of element
   std::vector<std::map<mfem::Geometry::Type, eval_func> > evaluation_with_AD_;
 
-  /// @brief signature of element jvp kernel
-  using jacobian_vector_product_func = std::function<void(const double*, double*)>;
+  /**
+   * @brief signature of the kernel for integral evaluation + derivatives w.r.t. several arguments: (inputs, outputs,
+   * update_state, first_element, num_elements, which), like @p eval_func, where bit i of `which` selects the
+   * (integral) trial space i
+   */
+  using multi_eval_func =
+      std::function<void(const std::vector<const double*>&, double*, bool, uint32_t, uint32_t, uint32_t)>;
+
+  /// @brief kernels for integral evaluation + derivatives w.r.t. several arguments over each type of element
+  std::map<mfem::Geometry::Type, multi_eval_func> evaluation_with_multiple_AD_;
+
+  /**
+   * @brief signature of the kernel for integral evaluation + directional derivatives: (inputs, directions,
+   * direction_trial, outputs, first_element, num_elements), see DirectionalMult()
+   */
+  using directional_func =
+      std::function<void(const std::vector<const double*>&, const std::vector<const double*>&,
+                         const std::vector<uint32_t>&, double*, uint32_t, uint32_t)>;
+
+  /**
+   * @brief kernels for integral evaluation + directional derivatives in several directions at once over each type of
+   * element, only available for q-functions wrapped with `with_directional_derivatives()`
+   */
+  std::map<mfem::Geometry::Type, directional_func> directional_derivatives_;
+
+  /**
+   * @brief signature of element jvp kernel: (input, output, first_element, num_elements, num_directions), like
+   * @p eval_func, where the input and output hold the values of `num_directions` perturbations one after another
+   */
+  using jacobian_vector_product_func = std::function<void(const double*, double*, uint32_t, uint32_t, uint32_t)>;
 
   /// @brief kernels for jacobian-vector product of integral calculation
   std::vector<std::map<mfem::Geometry::Type, jacobian_vector_product_func> > jvp_;
 
-  /// @brief signature of element gradient kernel
-  using grad_func = std::function<void(ExecArrayView<double, 3, ExecutionSpace::CPU>)>;
+  /**
+   * @brief signature of element vector-jacobian product kernel: (input, output, first_element, num_elements), where
+   * the input holds test space values and the output trial space values
+   */
+  using vector_jacobian_product_func = std::function<void(const double*, double*, uint32_t, uint32_t)>;
+
+  /// @brief kernels for the vector-jacobian product (the transposed jacobian's action), see GradientMultTranspose()
+  std::vector<std::map<mfem::Geometry::Type, vector_jacobian_product_func> > vjp_;
+
+  /// @brief signature of element gradient kernel, which writes to the element jacobians (in the kernel's memory space)
+  using grad_func = std::function<void(double*)>;
 
   /// @brief kernels for calculation of element jacobians
   std::vector<std::map<mfem::Geometry::Type, grad_func> > element_gradient_;
 
+  /**
+   * @brief kernels for calculation of the upper triangles of element jacobians, for trial spaces that are also the
+   * test space (see ComputeElementGradients())
+   */
+  std::vector<std::map<mfem::Geometry::Type, grad_func> > symmetric_element_gradient_;
+
+  /**
+   * @brief signature of the kernels that differentiate a quantity of interest in a single pass: (inputs, element
+   * gradients), where the inputs are the per-element values of each trial space at which to differentiate
+   */
+  using qoi_gradient_func = std::function<void(const std::vector<const double*>&, double*)>;
+
+  /// @brief kernels for the element gradients of quantities of interest, see ComputeQoIGradients()
+  std::vector<std::map<mfem::Geometry::Type, qoi_gradient_func> > qoi_gradient_;
+
   /// @brief a list of the trial spaces that take part in this integrand
   std::vector<uint32_t> active_trial_spaces_;
 
@@ -177,15 +760,226 @@ struct Integral {
    */
   std::map<uint32_t, uint32_t> functional_to_integral_index_;
 
-  /// @brief the spatial positions and jacobians (dx_dxi) for each element type and quadrature point
-  std::map<mfem::Geometry::Type, GeometricFactors> geometric_factors_;
+  /**
+   * @brief the spatial positions and jacobians (dx_dxi) for each element type and quadrature point
+   * @note these tables are shared with any other Integral over the same elements (see shared_geometric_factors)
+   */
+  std::map<mfem::Geometry::Type, std::shared_ptr<const GeometricFactors> > geometric_factors_;
+
+  /**
+   * @brief which trial space (if any) reuses its values at each quadrature point between evaluations, shared by
+   * every evaluation kernel of this integral (see Functional::SetCachedArgument())
+   */
+  std::shared_ptr<InterpolationCacheState> interpolation_cache_;
+
+  /// @brief the elements of one geometry that an integral restricted to some of the mesh's elements is evaluated on
+  struct ElementSubset {
+    std::vector<uint32_t> elements;                  ///< the (ascending) indices of the elements in the domain
+    uint32_t              num_mesh_elements;         ///< the number of elements of this geometry in the mesh
+    uint64_t              test_values_per_element;   ///< the number of E-vector values per element of the test space
+    std::vector<uint64_t> trial_values_per_element;  ///< the number of E-vector values per element of each trial space
+  };
+
+  /**
+   * @brief the elements that make up the domain of an integral restricted to some of the mesh's elements, for each
+   * geometry it doesn't cover entirely (see MakeDomainIntegral() and MakeBoundaryIntegral() with a set of attributes)
+   *
+   * The kernels, geometric factors, q-function derivatives and quadrature point data of such an integral
+   * only describe the elements in its domain, numbered consecutively in the order of `ElementSubset::elements`.
+   */
+  std::map<mfem::Geometry::Type, ElementSubset> subsets_;
+
+  /// @brief analytic estimates of the work done by an evaluation kernel for each element, see evaluation_cost()
+  struct ElementCost {
+    double flops;  ///< the floating point operations outside of the q-function
+    double bytes;  ///< the memory traffic of the element inputs, outputs and geometric factors
+  };
+
+  /**
+   * @brief the cost of the evaluation kernel of each geometry (for domain and boundary integrals), which Functional
+   * reports to Caliper as the "flops" and "bytes" attributes of each kernel's region, for roofline analysis
+   */
+  std::map<mfem::Geometry::Type, ElementCost> costs_;
+
+  /**
+   * @brief identifies the evaluation kernel of each geometry (for domain and boundary integrals) in the tuning cache,
+   * see kernel_name() and Functional::Autotune()
+   */
+  std::map<mfem::Geometry::Type, std::string> kernel_names_;
+
+  /**
+   * @brief the number of elements per batch of the evaluation kernel of each geometry on the CPU, when tuned
+   * (see Functional::Autotune()), rather than the batch size of the Functional
+   */
+  std::map<mfem::Geometry::Type, uint32_t> batch_sizes_;
+
+  /**
+   * @brief where the kernels of this integral run: the execution space of the Functional it belongs to, or the one
+   * chosen for it by accelerator::selectExecutionSpace(), for Functionals in ExecutionSpace::Dynamic
+   */
+  ExecutionSpace execution_space_ = ExecutionSpace::CPU;
+
+  /// @brief the values of an (E-)vector, in the memory of the execution space of this integral's kernels
+  const double* Read(const mfem::Vector& v) const
+  {
+    return (execution_space_ == ExecutionSpace::CPU) ? v.HostRead() : v.Read();
+  }
+
+  /// @overload
+  double* ReadWrite(mfem::Vector& v) const
+  {
+    return (execution_space_ == ExecutionSpace::CPU) ? v.HostReadWrite() : v.ReadWrite();
+  }
 };
 
+/// @brief a name for a finite element space, e.g. "H1<2, 3>" for quadratic vector-valued H1 elements in 3D
+template <typename space>
+std::string space_name()
+{
+  constexpr const char* families[] = {"QOI", "H1", "Hcurl", "Hdiv", "L2"};
+  return axom::fmt::format("{}<{}, {}>", families[static_cast<int>(space::family)], space::order, space::components);
+}
+
+/**
+ * @brief a name for the evaluation kernel of an integral (see Integral::kernel_names_), from everything it is
+ * specialized on: the kind of integral, the element geometry, the quadrature rule, the spaces and the q-function
+ *
+ * @tparam geom the element geometry
+ * @tparam Q a parameter that controls the number of quadrature points
+ * @tparam test the kind of test functions used in the integral
+ * @tparam trials the trial space(s) of the integral's inputs
+ * @tparam lambda_type the type of the q-function, whose (implementation-defined) name is only meaningful within the
+ * same build, which the tuning cache keys its entries by as well
+ * @param type the kind of integral
+ */
+template <mfem::Geometry::Type geom, int Q, typename test, typename... trials, typename lambda_type>
+std::string kernel_name(Integral::Type type, const lambda_type&)
+{
+  std::string trial_names;
+  ((trial_names += (trial_names.empty() ? "" : ", ") + space_name<trials>()), ...);
+  return axom::fmt::format("{} {} Q={} {}({}) {}", Integral::TypeNames[type], mfem::Geometry::Name[geom], Q,
+                           space_name<test>(), trial_names, typeid(lambda_type).name());
+}
+
+/**
+ * @brief estimate the floating point operations of evaluating an integral on a single element, see evaluation_cost()
+ *
+ * @tparam geom the element geometry
+ * @tparam Q a parameter that controls the number of quadrature points
+ * @tparam test the kind of test functions used in the integral
+ * @tparam trials the trial space(s) of the integral's inputs
+ */
+template <mfem::Geometry::Type geom, int Q, typename test, typename... trials>
+constexpr double evaluation_flops()
+{
+  using test_element = finite_element<geom, test>;
+
+  constexpr double dim  = dimension_of(geom);
+  constexpr double qpts = num_quadrature_points(geom, Q);
+
+  constexpr double test_values = sizeof(typename test_element::dof_type) / sizeof(double);
+  constexpr double trial_values =
+      (0.0 + ... + sizeof(typename finite_element<geom, trials>::dof_type)) / sizeof(double);
+
+  return 2.0 * (test_values + trial_values) * (dim + 1.0) * qpts + 2.0 * dim * dim * test_element::components * qpts;
+}
+
+/**
+ * @brief estimate the cost of evaluating an integral on a single element
+ *
+ * The interpolation of each trial space and the integration against the test space are counted as dense products
+ * of the element values with the values and derivatives of the shape functions at each quadrature point (sum
+ * factorization does less work for tensor product elements), and physical_to_parent() as a matrix-vector product
+ * for each component of the flux. The work done by the q-function itself isn't known, so it isn't included.
+ *
+ * @tparam geom the element geometry
+ * @tparam Q a parameter that controls the number of quadrature points
+ * @tparam test the kind of test functions used in the integral
+ * @tparam trials the trial space(s) of the integral's inputs
+ * @param gf the geometric factors of the integral's elements, which each evaluation reads
+ */
+template <mfem::Geometry::Type geom, int Q, typename test, typename... trials>
+Integral::ElementCost evaluation_cost(const GeometricFactors& gf)
+{
+  constexpr double test_values = sizeof(typename finite_element<geom, test>::dof_type) / sizeof(double);
+  constexpr double trial_values =
+      (0.0 + ... + sizeof(typename finite_element<geom, trials>::dof_type)) / sizeof(double);
+
+  // the positions and jacobians at each quadrature point
+  const double num_elements      = double(std::max(gf.num_elements, std::size_t(1)));
+  const double geometric_factors = double(gf.X.Size() + gf.J.Size()) / num_elements;
+
+  return {evaluation_flops<geom, Q, test, trials...>(),
+          sizeof(double) * (test_values + trial_values + geometric_factors)};
+}
+
+/**
+ * @brief choose where the kernels of an integral in ExecutionSpace::Dynamic run (see
+ * accelerator::selectExecutionSpace()), estimating the cost of each of its elements like that of a tensor product
+ * element of the same dimension
+ *
+ * @tparam geom the tensor product geometry of the elements of the integral
+ * @tparam Q a parameter that controls the number of quadrature points
+ * @tparam test the kind of test functions used in the integral
+ * @tparam trials the trial space(s) of the integral's inputs
+ * @param num_elements the number of elements of the integral
+ */
+template <mfem::Geometry::Type geom, int Q, typename test, typename... trials>
+ExecutionSpace dynamic_execution_space(FunctionSignature<test(trials...)>, int num_elements)
+{
+  return accelerator::selectExecutionSpace(uint32_t(num_elements), evaluation_flops<geom, Q, test, trials...>());
+}
+
+/**
+ * @brief the elements with the given geometry (numbered like the ElementRestriction of that geometry) whose
+ * attribute is one of the given ones
+ */
+inline std::vector<uint32_t> elements_with_attributes(const mfem::Mesh& mesh, mfem::Geometry::Type geom,
+                                                      const std::set<int>& attributes)
+{
+  std::vector<uint32_t> elements;
+  uint32_t              index = 0;
+  for (int e = 0; e < mesh.GetNE(); e++) {
+    if (mesh.GetElementGeometry(e) != geom) continue;
+    if (attributes.count(mesh.GetAttribute(e))) {
+      elements.push_back(index);
+    }
+    index++;
+  }
+  return elements;
+}
+
+/**
+ * @brief the boundary faces with the given geometry (numbered like the boundary ElementRestriction of that geometry)
+ * whose boundary element's attribute is one of the given ones
+ */
+inline std::vector<uint32_t> boundary_elements_with_attributes(const mfem::Mesh& mesh, mfem::Geometry::Type geom,
+                                                               const std::set<int>& attributes)
+{
+  // the boundary restrictions visit the mesh's faces, rather than its boundary elements
+  std::vector<int> face_attributes(std::size_t(mesh.GetNumFaces()), -1);
+  for (int be = 0; be < mesh.GetNBE(); be++) {
+    face_attributes[std::size_t(mesh.GetBdrElementEdgeIndex(be))] = mesh.GetBdrAttribute(be);
+  }
+
+  std::vector<uint32_t> elements;
+  uint32_t              index = 0;
+  for (int f = 0; f < mesh.GetNumFaces(); f++) {
+    if (mesh.GetFaceGeometry(f) != geom || !mesh.GetFaceInformation(f).IsBoundary()) continue;
+    if (attributes.count(face_attributes[std::size_t(f)])) {
+      elements.push_back(index);
+    }
+    index++;
+  }
+  return elements;
+}
+
 /**
  * @brief function to generate kernels held by an `Integral` object of type "Domain", with a specific element type
  *
  * @tparam geom the element geometry
  * @tparam Q a parameter that controls the number of quadrature points
+ * @tparam exec whether to carry out the calculations on the CPU or GPU
  * @tparam test the kind of test functions used in the integral
  * @tparam trials the trial space(s) of the integral's inputs
  * @tparam lambda_type a callable object that implements the q-function concept
@@ -195,43 +989,208 @@ struct Integral {
  * @param qf the quadrature function
  * @param domain the domain of integration
  * @param qdata the values of any quadrature point data for the material
+ * @param attributes if nonempty, restricts the integral to the elements with these attributes (see
+ * `Integral::subsets_`), so that `qdata` only needs to describe those
+ * @param precompute_inverses whether to store the inverse jacobians at each quadrature point of non-affine elements,
+ * rather than computing them in every evaluation
  */
-template <mfem::Geometry::Type geom, int Q, typename test, typename... trials, typename lambda_type,
-          typename qpt_data_type>
+template <mfem::Geometry::Type geom, int Q, ExecutionSpace exec, typename test, typename... trials,
+          typename lambda_type, typename qpt_data_type>
 void generate_kernels(FunctionSignature<test(trials...)> s, Integral& integral, lambda_type&& qf, mfem::Mesh& domain,
-                      std::shared_ptr<QuadratureData<qpt_data_type> > qdata)
+                      std::shared_ptr<QuadratureData<qpt_data_type> > qdata, const std::set<int>& attributes = {},
+                      bool precompute_inverses = false)
 {
-  integral.geometric_factors_[geom] = GeometricFactors(&domain, Q, geom);
-  GeometricFactors& gf              = integral.geometric_factors_[geom];
+  integral.geometric_factors_[geom] = shared_geometric_factors(&domain, Q, geom, precompute_inverses);
+
+  if (!attributes.empty()) {
+    auto elements          = elements_with_attributes(domain, geom, attributes);
+    auto num_mesh_elements = uint32_t(integral.geometric_factors_[geom]->num_elements);
+    if (elements.size() < num_mesh_elements) {
+      SLIC_ERROR_ROOT_IF(exec != ExecutionSpace::CPU && !elements.empty(),
+                         "integrals over some of the elements are not yet supported for ExecutionSpace::GPU");
+      integral.geometric_factors_[geom] =
+          std::make_shared<const GeometricFactors>(select_elements(*integral.geometric_factors_[geom], elements));
+      integral.subsets_[geom] = Integral::ElementSubset{
+          elements, num_mesh_elements, sizeof(typename finite_element<geom, test>::dof_type) / sizeof(double),
+          std::vector<uint64_t>{sizeof(typename finite_element<geom, trials>::dof_type) / sizeof(double)...}};
+    }
+  }
+
+  // named on every rank, so that they tune the kernels of each geometry together (see Functional::Autotune())
+  integral.kernel_names_[geom] = kernel_name<geom, Q, test, trials...>(Integral::Domain, qf);
+
+  const GeometricFactors& gf = *integral.geometric_factors_[geom];
   if (gf.num_elements == 0) return;
 
-  const double*  positions        = gf.X.Read();
-  const double*  jacobians        = gf.J.Read();
-  const uint32_t num_elements     = uint32_t(gf.num_elements);
-  const uint32_t qpts_per_element = num_quadrature_points(geom, Q);
+  integral.costs_[geom] = evaluation_cost<geom, Q, test, trials...>(gf);
+
+  const double*  positions         = integral.Read(gf.X);
+  const double*  jacobians         = integral.Read(gf.J);
+  const double*  affine_jacobians  = gf.affine ? integral.Read(gf.affine_jacobians) : nullptr;
+  const double*  inverse_jacobians = (gf.inverse_jacobians.Size() > 0) ? integral.Read(gf.inverse_jacobians) : nullptr;
+  const uint32_t num_elements      = uint32_t(gf.num_elements);
+
+  // storage for the values at each quadrature point of a trial space that doesn't change between evaluations,
+  // shared by every kernel that interpolates the trial spaces
+  auto cache = std::make_shared<InterpolationCache<Q, geom, trials...> >(integral.interpolation_cache_, num_elements);
 
   std::shared_ptr<zero> dummy_derivatives;
-  integral.evaluation_[geom] = domain_integral::evaluation_kernel<NO_DIFFERENTIATION, Q, geom>(
-      s, qf, positions, jacobians, qdata, dummy_derivatives, num_elements);
+  integral.evaluation_[geom] = domain_integral::evaluation_kernel<NO_DIFFERENTIATION, Q, geom, exec>(
+      s, qf, positions, jacobians, affine_jacobians, inverse_jacobians, qdata, dummy_derivatives, cache);
+
+  // q-functions wrapped with `with_directional_derivatives<K>()` can also be evaluated along with
+  // their derivatives in several directions at once (see Functional::DirectionalDerivatives())
+  if constexpr (detail::directions_per_evaluation<std::decay_t<lambda_type> >::value > 0) {
+    constexpr int K                          = detail::directions_per_evaluation<std::decay_t<lambda_type> >::value;
+    integral.directional_derivatives_[geom] =
+        domain_integral::directional_derivatives_kernel<K, Q, geom, exec>(s, qf, positions, jacobians, qdata);
+  }
 
   constexpr std::size_t                 num_args = s.num_args;
   [[maybe_unused]] static constexpr int dim      = dimension_of(geom);
+
+  // quantities of interest can also be differentiated in a single pass over the elements,
+  // see Functional<double(trials...)>::ReverseModeGradient()
+  if constexpr (std::is_same_v<test, QOI>) {
+    for_constexpr<num_args>([&](auto index) {
+      integral.qoi_gradient_[index][geom] =
+          domain_integral::qoi_gradient_kernel<index, Q, geom, exec>(s, qf, positions, jacobians, qdata, num_elements);
+    });
+  }
+
+  // q-functions wrapped with `with_recomputed_derivatives()` store the inputs at the
+  // linearization point instead, and re-evaluate the derivatives in the gradient kernels
+  if constexpr (detail::recomputes_derivatives<std::decay_t<lambda_type> >::value) {
+    detail::LinearizationPoint linearization_point;
+    (linearization_point.allocate<exec>(num_elements,
+                                        sizeof(typename finite_element<geom, trials>::dof_type) / sizeof(double)),
+     ...);
+
+    for_constexpr<num_args>([&](auto index) {
+      integral.evaluation_with_AD_[index][geom] =
+          domain_integral::evaluation_kernel_with_saved_inputs<Q, geom, exec>(s, qf, positions, jacobians, qdata,
+                                                                              linearization_point, cache);
+      integral.jvp_[index][geom] = domain_integral::jacobian_vector_product_recompute_kernel<index, Q, geom, exec>(
+          s, qf, positions, jacobians, qdata, linearization_point);
+      integral.element_gradient_[index][geom] =
+          domain_integral::element_gradient_recompute_kernel<index, Q, geom, exec>(
+              s, qf, positions, jacobians, qdata, linearization_point, num_elements);
+    });
+
+    // saving the inputs serves every trial space at once
+    integral.evaluation_with_multiple_AD_[geom] = [kernel = integral.evaluation_with_AD_[0][geom]](
+                                                      const std::vector<const double*>& inputs, double* outputs,
+                                                      bool update_state, uint32_t first_element,
+                                                      uint32_t num_elements, uint32_t /* which */) {
+      kernel(inputs, outputs, update_state, first_element, num_elements);
+    };
+    return;
+  }
+
+  // q-functions wrapped with `with_constant_derivatives()` compute their derivatives once, here,
+  // so evaluations that request derivatives don't need to do anything extra
+  if constexpr (detail::has_constant_derivatives<std::decay_t<lambda_type> >::value) {
+    for_constexpr<num_args>([&](auto index) {
+      auto qf_derivative =
+          domain_integral::get_derivative_type<index, dim, trials...>(qf, qdata_value_t<qpt_data_type>{});
+
+      integral.evaluation_with_AD_[index][geom] = integral.evaluation_[geom];
+      integral.jvp_[index][geom] = domain_integral::constant_jacobian_vector_product_kernel<index, Q, geom, exec>(
+          s, qf_derivative, jacobians);
+      integral.element_gradient_[index][geom] =
+          domain_integral::constant_element_gradient_kernel<index, Q, geom, exec>(s, qf_derivative, jacobians,
+                                                                                  num_elements);
+    });
+
+    integral.evaluation_with_multiple_AD_[geom] = [kernel = integral.evaluation_[geom]](
+                                                      const std::vector<const double*>& inputs, double* outputs,
+                                                      bool update_state, uint32_t first_element,
+                                                      uint32_t num_elements, uint32_t /* which */) {
+      kernel(inputs, outputs, update_state, first_element, num_elements);
+    };
+    return;
+  }
+
+  // allocate memory for the derivatives of the q-function (w.r.t. each trial space) at each quadrature point
+  //
+  // Note: ptrs' lifetime is managed in an unusual way! It is captured by-value in the
+  // action_of_gradient functor below to augment the reference count, and extend its lifetime to match
+  // that of the DomainIntegral that allocated it.
+  //
+  // The derivatives are stored in single precision if the q-function was wrapped
+  // with `with_single_precision_derivatives()`
+  auto ptrs = domain_integral::allocate_qf_derivatives<Q, geom, exec>(s, qf, qdata, num_elements, s.index_seq);
+
   for_constexpr<num_args>([&](auto index) {
-    // allocate memory for the derivatives of the q-function at each quadrature point
-    //
-    // Note: ptrs' lifetime is managed in an unusual way! It is captured by-value in the
-    // action_of_gradient functor below to augment the reference count, and extend its lifetime to match
-    // that of the DomainIntegral that allocated it.
-    using derivative_type = decltype(domain_integral::get_derivative_type<index, dim, trials...>(qf, qpt_data_type{}));
-    auto ptr = accelerator::make_shared_array<ExecutionSpace::CPU, derivative_type>(num_elements * qpts_per_element);
+    auto ptr = get<index>(ptrs);
+
+    // when none of the outputs depend on this argument, its derivatives (and their actions) are zero by construction
+    using stored_type = typename std::decay_t<decltype(ptr)>::element_type;
+    if constexpr (detail::is_structurally_zero_v<stored_type>) {
+      integral.evaluation_with_AD_[index][geom] = integral.evaluation_[geom];
+      integral.jvp_[index][geom]                = [](const double*, double*, uint32_t, uint32_t, uint32_t) {};
+      if constexpr (test::family != Family::QOI) {
+        integral.vjp_[index][geom] = [](const double*, double*, uint32_t, uint32_t) {};
+      }
+      integral.element_gradient_[index][geom] = [](double*) {};
+      return;
+    }
 
     integral.evaluation_with_AD_[index][geom] =
-        domain_integral::evaluation_kernel<index, Q, geom>(s, qf, positions, jacobians, qdata, ptr, num_elements);
+        domain_integral::evaluation_kernel<index, Q, geom, exec>(s, qf, positions, jacobians, affine_jacobians,
+                                                                 inverse_jacobians, qdata, ptr, cache);
 
-    integral.jvp_[index][geom] = domain_integral::jacobian_vector_product_kernel<index, Q, geom>(s, ptr, num_elements);
+    integral.jvp_[index][geom] = domain_integral::jacobian_vector_product_kernel<index, Q, geom, exec>(s, ptr);
+    if constexpr (test::family != Family::QOI) {
+      integral.vjp_[index][geom] = domain_integral::vector_jacobian_product_kernel<index, Q, geom, exec>(s, ptr);
+    }
     integral.element_gradient_[index][geom] =
-        domain_integral::element_gradient_kernel<index, Q, geom>(s, ptr, num_elements);
+        domain_integral::element_gradient_kernel<index, Q, geom, exec>(s, ptr, num_elements);
+    if constexpr (std::is_same_v<test, std::tuple_element_t<index, std::tuple<trials...> > >) {
+      integral.symmetric_element_gradient_[index][geom] =
+          domain_integral::symmetric_element_gradient_kernel<index, Q, geom, exec>(s, ptr, num_elements);
+    }
   });
+
+  // evaluating derivatives w.r.t. several trial spaces at once writes to the same buffers
+  if constexpr (num_args > 1) {
+    integral.evaluation_with_multiple_AD_[geom] =
+        domain_integral::evaluation_kernel_with_multiple_derivatives<Q, geom, exec>(s, qf, positions, jacobians,
+                                                                                    qdata, ptrs, cache);
+  }
+}
+
+/// @brief the highest polynomial order of the test and trial spaces of an integral with signature s
+template <typename s>
+inline constexpr int max_element_order = 0;
+
+/// @overload
+template <typename test, typename... trials>
+inline constexpr int max_element_order<test(trials...)> = std::max({test::order, trials::order...});
+
+/**
+ * @brief whether an integral with signature s and Q quadrature points per dimension can be evaluated on triangles,
+ * tetrahedra and prisms, i.e. whether its elements (and a quadrature rule with that many points) are implemented there
+ */
+template <typename s, int Q>
+inline constexpr bool simplex_kernels_available =
+    max_element_order<s> <= max_simplex_order && Q <= max_simplex_order + 1;
+
+/**
+ * @brief errors out if the mesh has elements of a simplex (or prism) geometry that an integral can't be evaluated on,
+ * instead of skipping them
+ *
+ * @param domain the domain of integration
+ * @param geom the simplex (or prism) geometry
+ * @param order the highest polynomial order of the integral's test and trial spaces
+ * @param Q the number of quadrature points per dimension
+ */
+inline void check_for_unsupported_simplices(const mfem::Mesh& domain, mfem::Geometry::Type geom, int order, int Q)
+{
+  SLIC_ERROR_IF(domain.HasGeometry(geom),
+                axom::fmt::format("{} elements are only supported up to order {} (with up to {} quadrature points per "
+                                  "dimension), but this integral is of order {} (with {} quadrature points)",
+                                  mfem::Geometry::Name[geom], max_simplex_order, max_simplex_order + 1, order, Q));
 }
 
 /**
@@ -240,33 +1199,74 @@ void generate_kernels(FunctionSignature<test(trials...)> s, Integral& integral,
  * @tparam s a function signature type containing test/trial space informationa type containing a function signature
  * @tparam Q a parameter that controls the number of quadrature points
  * @tparam dim the dimension of the domain
+ * @tparam exec whether to carry out the calculations on the CPU or GPU, or (for ExecutionSpace::Dynamic) on
+ * either one, see dynamic_execution_space()
  * @tparam lambda_type a callable object that implements the q-function concept
  * @tparam qpt_data_type any quadrature point data needed by the material model
  * @param domain the domain of integration
  * @param qf the quadrature function
  * @param qdata the values of any quadrature point data for the material
  * @param argument_indices the indices of trial space arguments used in the Integral
+ * @param attributes if nonempty, only the elements with these attributes make up the domain of integration, and
+ * `qdata` only describes those elements (numbered in the order of the mesh's elements of each geometry)
+ * @param precompute_inverses whether to store the inverse jacobians at each quadrature point of non-affine elements
  * @return Integral the initialized `Integral` object
  */
-template <typename s, int Q, int dim, typename lambda_type, typename qpt_data_type>
+template <typename s, int Q, int dim, ExecutionSpace exec, typename lambda_type, typename qpt_data_type>
 Integral MakeDomainIntegral(mfem::Mesh& domain, lambda_type&& qf, std::shared_ptr<QuadratureData<qpt_data_type> > qdata,
-                            std::vector<uint32_t> argument_indices)
+                            std::vector<uint32_t> argument_indices, const std::set<int>& attributes = {},
+                            bool precompute_inverses = false)
 {
-  FunctionSignature<s> signature;
+  if constexpr (exec == ExecutionSpace::Dynamic) {
+    // integrals over some of the elements, or with quadrature point data, are only supported on the CPU
+#if defined(__CUDACC__)
+    if constexpr (std::is_same_v<qpt_data_type, Nothing>) {
+      constexpr auto geom = (dim == 2) ? mfem::Geometry::SQUARE : mfem::Geometry::CUBE;
+      if (attributes.empty() &&
+          dynamic_execution_space<geom, Q>(FunctionSignature<s>{}, domain.GetNE()) == ExecutionSpace::GPU) {
+        return MakeDomainIntegral<s, Q, dim, ExecutionSpace::GPU>(domain, qf, qdata, argument_indices, attributes,
+                                                                  precompute_inverses);
+      }
+    }
+#endif
+    return MakeDomainIntegral<s, Q, dim, ExecutionSpace::CPU>(domain, qf, qdata, argument_indices, attributes,
+                                                              precompute_inverses);
+  } else {
+    FunctionSignature<s> signature;
 
-  Integral integral(Integral::Type::Domain, argument_indices);
+    Integral integral(Integral::Type::Domain, argument_indices);
+    integral.execution_space_ = exec;
 
-  if constexpr (dim == 2) {
-    generate_kernels<mfem::Geometry::TRIANGLE, Q>(signature, integral, qf, domain, qdata);
-    generate_kernels<mfem::Geometry::SQUARE, Q>(signature, integral, qf, domain, qdata);
-  }
+    if constexpr (dim == 2) {
+      if constexpr (simplex_kernels_available<s, Q>) {
+        generate_kernels<mfem::Geometry::TRIANGLE, Q, exec>(signature, integral, qf, domain, qdata, attributes,
+                                                            precompute_inverses);
+      } else {
+        check_for_unsupported_simplices(domain, mfem::Geometry::TRIANGLE, max_element_order<s>, Q);
+      }
+      generate_kernels<mfem::Geometry::SQUARE, Q, exec>(signature, integral, qf, domain, qdata, attributes,
+                                                        precompute_inverses);
+    }
 
-  if constexpr (dim == 3) {
-    generate_kernels<mfem::Geometry::TETRAHEDRON, Q>(signature, integral, qf, domain, qdata);
-    generate_kernels<mfem::Geometry::CUBE, Q>(signature, integral, qf, domain, qdata);
-  }
+    if constexpr (dim == 3) {
+      if constexpr (simplex_kernels_available<s, Q>) {
+        generate_kernels<mfem::Geometry::TETRAHEDRON, Q, exec>(signature, integral, qf, domain, qdata, attributes,
+                                                               precompute_inverses);
+      } else {
+        check_for_unsupported_simplices(domain, mfem::Geometry::TETRAHEDRON, max_element_order<s>, Q);
+      }
+      if constexpr (simplex_kernels_available<s, Q>) {
+        generate_kernels<mfem::Geometry::PRISM, Q, exec>(signature, integral, qf, domain, qdata, attributes,
+                                                         precompute_inverses);
+      } else {
+        check_for_unsupported_simplices(domain, mfem::Geometry::PRISM, max_element_order<s>, Q);
+      }
+      generate_kernels<mfem::Geometry::CUBE, Q, exec>(signature, integral, qf, domain, qdata, attributes,
+                                                      precompute_inverses);
+    }
 
-  return integral;
+    return integral;
+  }
 }
 
 /**
@@ -274,6 +1274,7 @@ Integral MakeDomainIntegral(mfem::Mesh& domain, lambda_type&& qf, std::shared_pt
  *
  * @tparam geom the element geometry
  * @tparam Q a parameter that controls the number of quadrature points
+ * @tparam exec whether to carry out the calculations on the CPU or GPU
  * @tparam test the kind of test functions used in the integral
  * @tparam trials the trial space(s) of the integral's inputs
  * @tparam lambda_type a callable object that implements the q-function concept
@@ -281,45 +1282,129 @@ Integral MakeDomainIntegral(mfem::Mesh& domain, lambda_type&& qf, std::shared_pt
  * @param integral the Integral object to initialize
  * @param qf the quadrature function
  * @param domain the domain of integration
+ * @param attributes if nonempty, restricts the integral to the boundary elements with these attributes (see
+ * `Integral::subsets_`)
  *
  * @note this function is not meant to be called by users
  */
-template <mfem::Geometry::Type geom, int Q, typename test, typename... trials, typename lambda_type>
+template <mfem::Geometry::Type geom, int Q, ExecutionSpace exec, typename test, typename... trials,
+          typename lambda_type>
 void generate_bdr_kernels(FunctionSignature<test(trials...)> s, Integral& integral, lambda_type&& qf,
-                          mfem::Mesh& domain)
+                          mfem::Mesh& domain, const std::set<int>& attributes = {})
 {
-  integral.geometric_factors_[geom] = GeometricFactors(&domain, Q, geom, FaceType::BOUNDARY);
-  GeometricFactors& gf              = integral.geometric_factors_[geom];
+  integral.geometric_factors_[geom] = shared_geometric_factors(&domain, Q, geom, FaceType::BOUNDARY);
+
+  if (!attributes.empty()) {
+    auto elements          = boundary_elements_with_attributes(domain, geom, attributes);
+    auto num_mesh_elements = uint32_t(integral.geometric_factors_[geom]->num_elements);
+    if (elements.size() < num_mesh_elements) {
+      SLIC_ERROR_ROOT_IF(exec != ExecutionSpace::CPU && !elements.empty(),
+                         "integrals over some of the elements are not yet supported for ExecutionSpace::GPU");
+      integral.geometric_factors_[geom] =
+          std::make_shared<const GeometricFactors>(select_elements(*integral.geometric_factors_[geom], elements));
+      integral.subsets_[geom] = Integral::ElementSubset{
+          elements, num_mesh_elements, sizeof(typename finite_element<geom, test>::dof_type) / sizeof(double),
+          std::vector<uint64_t>{sizeof(typename finite_element<geom, trials>::dof_type) / sizeof(double)...}};
+    }
+  }
+
+  integral.kernel_names_[geom] = kernel_name<geom, Q, test, trials...>(Integral::Boundary, qf);
+
+  const GeometricFactors& gf = *integral.geometric_factors_[geom];
   if (gf.num_elements == 0) return;
 
-  const double*  positions        = gf.X.Read();
-  const double*  jacobians        = gf.J.Read();
-  const uint32_t num_elements     = uint32_t(gf.num_elements);
-  const uint32_t qpts_per_element = num_quadrature_points(geom, Q);
+  integral.costs_[geom] = evaluation_cost<geom, Q, test, trials...>(gf);
+
+  const double*  positions    = integral.Read(gf.X);
+  const double*  jacobians    = integral.Read(gf.J);
+  const uint32_t num_elements = uint32_t(gf.num_elements);
+
+  // storage for the values at each quadrature point of a trial space that doesn't change between evaluations,
+  // shared by every kernel that interpolates the trial spaces
+  auto cache = std::make_shared<InterpolationCache<Q, geom, trials...> >(integral.interpolation_cache_, num_elements);
 
   std::shared_ptr<zero> dummy_derivatives;
-  integral.evaluation_[geom] = boundary_integral::evaluation_kernel<NO_DIFFERENTIATION, Q, geom>(
-      s, qf, positions, jacobians, dummy_derivatives, num_elements);
+  integral.evaluation_[geom] = boundary_integral::evaluation_kernel<NO_DIFFERENTIATION, Q, geom, exec>(
+      s, qf, positions, jacobians, dummy_derivatives, cache);
+
+  // q-functions wrapped with `with_directional_derivatives<K>()` can also be evaluated along with
+  // their derivatives in several directions at once (see Functional::DirectionalDerivatives())
+  if constexpr (detail::directions_per_evaluation<std::decay_t<lambda_type> >::value > 0) {
+    constexpr int K                          = detail::directions_per_evaluation<std::decay_t<lambda_type> >::value;
+    integral.directional_derivatives_[geom] =
+        boundary_integral::directional_derivatives_kernel<K, Q, geom, exec>(s, qf, positions, jacobians);
+  }
 
   constexpr std::size_t                 num_args = s.num_args;
   [[maybe_unused]] static constexpr int dim      = dimension_of(geom);
+
+  // quantities of interest can also be differentiated in a single pass over the elements,
+  // see Functional<double(trials...)>::ReverseModeGradient()
+  if constexpr (std::is_same_v<test, QOI>) {
+    for_constexpr<num_args>([&](auto index) {
+      integral.qoi_gradient_[index][geom] =
+          boundary_integral::qoi_gradient_kernel<index, Q, geom, exec>(s, qf, positions, jacobians, num_elements);
+    });
+  }
+
+  // q-functions wrapped with `with_recomputed_derivatives()` store the inputs at the
+  // linearization point instead, and re-evaluate the derivatives in the gradient kernels
+  if constexpr (detail::recomputes_derivatives<std::decay_t<lambda_type> >::value) {
+    detail::LinearizationPoint linearization_point;
+    (linearization_point.allocate<exec>(num_elements,
+                                        sizeof(typename finite_element<geom, trials>::dof_type) / sizeof(double)),
+     ...);
+
+    for_constexpr<num_args>([&](auto index) {
+      integral.evaluation_with_AD_[index][geom] = boundary_integral::evaluation_kernel_with_saved_inputs<Q, geom, exec>(
+          s, qf, positions, jacobians, linearization_point, cache);
+      integral.jvp_[index][geom] = boundary_integral::jacobian_vector_product_recompute_kernel<index, Q, geom, exec>(
+          s, qf, positions, jacobians, linearization_point);
+      integral.element_gradient_[index][geom] =
+          boundary_integral::element_gradient_recompute_kernel<index, Q, geom, exec>(
+              s, qf, positions, jacobians, linearization_point, num_elements);
+    });
+
+    // saving the inputs serves every trial space at once
+    integral.evaluation_with_multiple_AD_[geom] = [kernel = integral.evaluation_with_AD_[0][geom]](
+                                                      const std::vector<const double*>& inputs, double* outputs,
+                                                      bool update_state, uint32_t first_element,
+                                                      uint32_t num_elements, uint32_t /* which */) {
+      kernel(inputs, outputs, update_state, first_element, num_elements);
+    };
+    return;
+  }
+
+  // allocate memory for the derivatives of the q-function (w.r.t. each trial space) at each quadrature point
+  //
+  // Note: ptrs' lifetime is managed in an unusual way! It is captured by-value in the
+  // action_of_gradient functor below to augment the reference count, and extend its lifetime to match
+  // that of the boundaryIntegral that allocated it.
+  //
+  // The derivatives are stored in single precision if the q-function was wrapped
+  // with `with_single_precision_derivatives()`
+  auto ptrs = boundary_integral::allocate_qf_derivatives<Q, geom, exec>(s, qf, num_elements, s.index_seq);
+
   for_constexpr<num_args>([&](auto index) {
-    // allocate memory for the derivatives of the q-function at each quadrature point
-    //
-    // Note: ptrs' lifetime is managed in an unusual way! It is captured by-value in the
-    // action_of_gradient functor below to augment the reference count, and extend its lifetime to match
-    // that of the boundaryIntegral that allocated it.
-    using derivative_type = decltype(boundary_integral::get_derivative_type<index, dim, trials...>(qf));
-    auto ptr = accelerator::make_shared_array<ExecutionSpace::CPU, derivative_type>(num_elements * qpts_per_element);
+    auto ptr = get<index>(ptrs);
 
     integral.evaluation_with_AD_[index][geom] =
-        boundary_integral::evaluation_kernel<index, Q, geom>(s, qf, positions, jacobians, ptr, num_elements);
+        boundary_integral::evaluation_kernel<index, Q, geom, exec>(s, qf, positions, jacobians, ptr, cache);
 
-    integral.jvp_[index][geom] =
-        boundary_integral::jacobian_vector_product_kernel<index, Q, geom>(s, ptr, num_elements);
+    integral.jvp_[index][geom] = boundary_integral::jacobian_vector_product_kernel<index, Q, geom, exec>(s, ptr);
+    if constexpr (test::family != Family::QOI) {
+      integral.vjp_[index][geom] = boundary_integral::vector_jacobian_product_kernel<index, Q, geom, exec>(s, ptr);
+    }
     integral.element_gradient_[index][geom] =
-        boundary_integral::element_gradient_kernel<index, Q, geom>(s, ptr, num_elements);
+        boundary_integral::element_gradient_kernel<index, Q, geom, exec>(s, ptr, num_elements);
   });
+
+  // evaluating derivatives w.r.t. several trial spaces at once writes to the same buffers
+  if constexpr (num_args > 1) {
+    integral.evaluation_with_multiple_AD_[geom] =
+        boundary_integral::evaluation_kernel_with_multiple_derivatives<Q, geom, exec>(s, qf, positions, jacobians,
+                                                                                      ptrs, cache);
+  }
 }
 
 /**
@@ -328,28 +1413,150 @@ void generate_bdr_kernels(FunctionSignature<test(trials...)> s, Integral& integr
  * @tparam s a function signature type containing test/trial space informationa type containing a function signature
  * @tparam Q a parameter that controls the number of quadrature points
  * @tparam dim the dimension of the domain
+ * @tparam exec whether to carry out the calculations on the CPU or GPU, or (for ExecutionSpace::Dynamic) on
+ * either one, see dynamic_execution_space()
  * @tparam lambda_type a callable object that implements the q-function concept
  * @param domain the domain of integration
  * @param qf the quadrature function
  * @param argument_indices the indices of trial space arguments used in the Integral
+ * @param attributes if nonempty, only the boundary elements with these attributes make up the domain of integration
  * @return Integral the initialized `Integral` object
  *
  * @note this function is not meant to be called by users
  */
-template <typename s, int Q, int dim, typename lambda_type>
-Integral MakeBoundaryIntegral(mfem::Mesh& domain, lambda_type&& qf, std::vector<uint32_t> argument_indices)
+template <typename s, int Q, int dim, ExecutionSpace exec, typename lambda_type>
+Integral MakeBoundaryIntegral(mfem::Mesh& domain, lambda_type&& qf, std::vector<uint32_t> argument_indices,
+                              const std::set<int>& attributes = {})
+{
+  if constexpr (exec == ExecutionSpace::Dynamic) {
+    // integrals over some of the boundary elements are only supported on the CPU
+#if defined(__CUDACC__)
+    constexpr auto geom = (dim == 1) ? mfem::Geometry::SEGMENT : mfem::Geometry::SQUARE;
+    if (attributes.empty() &&
+        dynamic_execution_space<geom, Q>(FunctionSignature<s>{}, domain.GetNBE()) == ExecutionSpace::GPU) {
+      return MakeBoundaryIntegral<s, Q, dim, ExecutionSpace::GPU>(domain, qf, argument_indices, attributes);
+    }
+#endif
+    return MakeBoundaryIntegral<s, Q, dim, ExecutionSpace::CPU>(domain, qf, argument_indices, attributes);
+  } else {
+    FunctionSignature<s> signature;
+
+    Integral integral(Integral::Type::Boundary, argument_indices);
+    integral.execution_space_ = exec;
+
+    if constexpr (dim == 1) {
+      generate_bdr_kernels<mfem::Geometry::SEGMENT, Q, exec>(signature, integral, qf, domain, attributes);
+    }
+
+    if constexpr (dim == 2) {
+      if constexpr (simplex_kernels_available<s, Q>) {
+        generate_bdr_kernels<mfem::Geometry::TRIANGLE, Q, exec>(signature, integral, qf, domain, attributes);
+      } else {
+        check_for_unsupported_simplices(domain, mfem::Geometry::TRIANGLE, max_element_order<s>, Q);
+      }
+      generate_bdr_kernels<mfem::Geometry::SQUARE, Q, exec>(signature, integral, qf, domain, attributes);
+    }
+
+    return integral;
+  }
+}
+
+/**
+ * @brief function to generate kernels used by an `Integral` object of type "InteriorFace", with a specific face
+ * geometry
+ *
+ * @tparam geom the face geometry
+ * @tparam Q a parameter that controls the number of quadrature points
+ * @tparam exec whether to carry out the calculations on the CPU or GPU
+ * @tparam test the kind of test functions used in the integral
+ * @tparam trials the trial space(s) of the integral's inputs
+ * @tparam lambda_type a callable object that implements the q-function concept
+ * @param s an object used to pass around test/trial information
+ * @param integral the Integral object to initialize
+ * @param qf the quadrature function
+ * @param domain the domain of integration
+ *
+ * @note this function is not meant to be called by users
+ */
+template <mfem::Geometry::Type geom, int Q, ExecutionSpace exec, typename test, typename... trials,
+          typename lambda_type>
+void generate_interior_face_kernels(FunctionSignature<test(trials...)> s, Integral& integral, lambda_type&& qf,
+                                    mfem::Mesh& domain)
+{
+  static_assert(!detail::recomputes_derivatives<std::decay_t<lambda_type> >::value,
+                "interior face integrals do not support recomputed derivatives");
+
+  integral.geometric_factors_[geom] = shared_geometric_factors(&domain, Q, geom, FaceType::INTERIOR);
+  const GeometricFactors& gf        = *integral.geometric_factors_[geom];
+  if (gf.num_elements == 0) return;
+
+  const double*  positions    = integral.Read(gf.X);
+  const double*  jacobians    = integral.Read(gf.J);
+  const uint32_t num_elements = uint32_t(gf.num_elements);
+
+  std::shared_ptr<zero> dummy_derivatives;
+  integral.evaluation_[geom] = interior_face_integral::evaluation_kernel<NO_DIFFERENTIATION, Q, geom, exec>(
+      s, qf, positions, jacobians, dummy_derivatives);
+
+  constexpr std::size_t num_args = s.num_args;
+
+  // allocate memory for the derivatives of the q-function (w.r.t. each trial space) at each quadrature point,
+  // (see generate_bdr_kernels() for how their lifetime is managed)
+  auto ptrs = interior_face_integral::allocate_qf_derivatives<Q, geom, exec>(s, qf, num_elements, s.index_seq);
+
+  for_constexpr<num_args>([&](auto index) {
+    auto ptr = get<index>(ptrs);
+
+    integral.evaluation_with_AD_[index][geom] =
+        interior_face_integral::evaluation_kernel<index, Q, geom, exec>(s, qf, positions, jacobians, ptr);
+
+    integral.jvp_[index][geom] = interior_face_integral::jacobian_vector_product_kernel<index, Q, geom, exec>(s, ptr);
+    integral.element_gradient_[index][geom] =
+        interior_face_integral::element_gradient_kernel<index, Q, geom, exec>(s, ptr, num_elements);
+  });
+
+  // evaluating derivatives w.r.t. several trial spaces at once writes to the same buffers
+  if constexpr (num_args > 1) {
+    integral.evaluation_with_multiple_AD_[geom] =
+        interior_face_integral::evaluation_kernel_with_multiple_derivatives<Q, geom, exec>(s, qf, positions,
+                                                                                           jacobians, ptrs);
+  }
+}
+
+/**
+ * @brief function to generate kernels held by an `Integral` object of type "InteriorFace", for all face geometries
+ *
+ * @tparam s a function signature type containing test/trial space information
+ * @tparam Q a parameter that controls the number of quadrature points
+ * @tparam dim the dimension of the faces
+ * @tparam exec whether to carry out the calculations on the CPU or GPU
+ * @tparam lambda_type a callable object that implements the q-function concept
+ * @param domain the domain of integration
+ * @param qf the quadrature function
+ * @param argument_indices the indices of trial space arguments used in the Integral
+ * @return Integral the initialized `Integral` object
+ *
+ * @note this function is not meant to be called by users
+ */
+template <typename s, int Q, int dim, ExecutionSpace exec, typename lambda_type>
+Integral MakeInteriorFaceIntegral(mfem::Mesh& domain, lambda_type&& qf, std::vector<uint32_t> argument_indices)
 {
   FunctionSignature<s> signature;
 
-  Integral integral(Integral::Type::Boundary, argument_indices);
+  Integral integral(Integral::Type::InteriorFace, argument_indices);
+  integral.execution_space_ = exec;
 
   if constexpr (dim == 1) {
-    generate_bdr_kernels<mfem::Geometry::SEGMENT, Q>(signature, integral, qf, domain);
+    generate_interior_face_kernels<mfem::Geometry::SEGMENT, Q, exec>(signature, integral, qf, domain);
   }
 
   if constexpr (dim == 2) {
-    generate_bdr_kernels<mfem::Geometry::TRIANGLE, Q>(signature, integral, qf, domain);
-    generate_bdr_kernels<mfem::Geometry::SQUARE, Q>(signature, integral, qf, domain);
+    if constexpr (simplex_kernels_available<s, Q>) {
+      generate_interior_face_kernels<mfem::Geometry::TRIANGLE, Q, exec>(signature, integral, qf, domain);
+    } else {
+      check_for_unsupported_simplices(domain, mfem::Geometry::TRIANGLE, max_element_order<s>, Q);
+    }
+    generate_interior_face_kernels<mfem::Geometry::SQUARE, Q, exec>(signature, integral, qf, domain);
   }
 
   return integral;
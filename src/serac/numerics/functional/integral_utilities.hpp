@@ -38,6 +38,34 @@ constexpr int pow(int x, int n)
   return x_to_the_n;
 }
 
+/**
+ * @brief the number of entries in the upper triangle (including the diagonal) of an n x n matrix
+ * @param[in] n the number of rows (and columns) of the matrix
+ */
+SERAC_HOST_DEVICE constexpr uint32_t upper_triangle_size(uint32_t n) { return n * (n + 1) / 2; }
+
+/**
+ * @brief the index of entry (i, j), with i <= j, of an n x n matrix whose upper triangle is stored row by row
+ * @param[in] n the number of rows (and columns) of the matrix
+ * @param[in] i the row index
+ * @param[in] j the column index
+ */
+SERAC_HOST_DEVICE constexpr uint32_t upper_triangle_index(uint32_t n, uint32_t i, uint32_t j)
+{
+  return i * n - (i * (i + 1)) / 2 + j;
+}
+
+/**
+ * @brief the number of rows (and columns) of a matrix whose upper triangle has the given number of entries
+ * @param[in] entries the number of entries of the upper triangle
+ */
+constexpr uint32_t upper_triangle_dimension(uint64_t entries)
+{
+  uint32_t n = 0;
+  while (upper_triangle_size(n) < entries) n++;
+  return n;
+}
+
 /**
  * @brief a class that provides the lambda argument types for a given integral
  * @tparam trial_space the trial space associated with the integral
@@ -0,0 +1,476 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file interior_face_integral_kernels.hpp
+ *
+ * @brief kernels for integrals over the interior faces of a mesh (e.g. the numerical fluxes of DG methods), where
+ * each face sees the values of the trial spaces from both of the elements that share it
+ */
+
+#pragma once
+
+#include <array>
+
+#include "serac/infrastructure/accelerator.hpp"
+#include "serac/numerics/functional/quadrature_data.hpp"
+#include "serac/numerics/functional/integral_utilities.hpp"
+#include "serac/numerics/functional/function_signature.hpp"
+#include "serac/numerics/functional/differentiate_wrt.hpp"
+#include "serac/numerics/functional/derivative_storage.hpp"
+
+namespace serac {
+
+namespace interior_face_integral {
+
+/**
+ *  @tparam space the user-specified trial space
+ *  @tparam dimension describes whether the problem is 1D, 2D, or 3D
+ *
+ *  @brief a struct used to encode what type of arguments will be passed to an interior face integral q-function, for
+ * the given trial space: the values from either side of the face
+ */
+template <typename space, typename dimension>
+struct QFunctionArgument;
+
+/// @overload
+template <int p, int dim>
+struct QFunctionArgument<L2<p, 1>, Dimension<dim>> {
+  using type = serac::tuple<double, double>;  ///< what will be passed to the q-function
+};
+
+/// @overload
+template <int p, int c, int dim>
+struct QFunctionArgument<L2<p, c>, Dimension<dim>> {
+  using type = serac::tuple<tensor<double, c>, tensor<double, c>>;  ///< what will be passed to the q-function
+};
+
+/**
+ * @brief the finite element on an interior face, made up of the face elements of both of the elements sharing it
+ *
+ * The dofs are laid out the way ElementRestriction gathers them for interior faces: by component, then by side
+ * (side 1 is the element that the face normal points out of), then by face node.
+ *
+ * @tparam geom the face geometry
+ * @tparam space the function space (on each side)
+ */
+template <mfem::Geometry::Type geom, typename space>
+struct face_element_pair {
+  /// @brief the face element of each side
+  using side_element = finite_element<geom, space>;
+
+  static constexpr int components = side_element::components;  ///< the number of components at each node
+  static constexpr int ndof       = 2 * side_element::ndof;     ///< the number of nodes (on both sides)
+
+  /// @brief the dof values of both sides
+  using dof_type = tensor<double, components, 2, side_element::ndof>;
+
+  /// @brief the values of the function space at a quadrature point, from either side
+  using qf_input_type = tuple<typename side_element::value_type, typename side_element::value_type>;
+
+  /// @brief extract the dof values of one side
+  SERAC_HOST_DEVICE static auto side_dofs(const dof_type& X, int side)
+  {
+    typename side_element::dof_type X_side{};
+    auto                            values = reinterpret_cast<double*>(&X_side);
+    for (int i = 0; i < components; i++) {
+      for (int j = 0; j < side_element::ndof; j++) {
+        values[i * side_element::ndof + j] = X(i, side, j);
+      }
+    }
+    return X_side;
+  }
+
+  /// @brief interpolate the values from either side at each quadrature point
+  template <int Q>
+  SERAC_HOST_DEVICE static auto interpolate(const dof_type& X, const TensorProductQuadratureRule<Q>& rule)
+  {
+    constexpr int nqp = num_quadrature_points(geom, Q);
+
+    auto side1 = side_element::interpolate(side_dofs(X, 0), rule);
+    auto side2 = side_element::interpolate(side_dofs(X, 1), rule);
+
+    tensor<qf_input_type, nqp> output{};
+    for (int q = 0; q < nqp; q++) {
+      output[q] = {get<0>(side1[q]), get<0>(side2[q])};
+    }
+    return output;
+  }
+
+  /**
+   * @brief integrate the sources (at each quadrature point) of either side against that side's test functions
+   * @param sources the sources for side 1 and side 2 at each quadrature point
+   * @param rule the quadrature rule
+   * @param element_residual the residuals to accumulate into
+   */
+  template <typename S1, typename S2, int n, int Q>
+  SERAC_HOST_DEVICE static void integrate(const tensor<tuple<S1, S2>, n>& sources,
+                                          const TensorProductQuadratureRule<Q>& rule, dof_type* element_residual)
+  {
+    tensor<tuple<S1, zero>, n> sources1{};
+    tensor<tuple<S2, zero>, n> sources2{};
+    for (int q = 0; q < n; q++) {
+      get<0>(sources1[q]) = get<0>(sources[q]);
+      get<0>(sources2[q]) = get<1>(sources[q]);
+    }
+
+    typename side_element::dof_type residuals[2]{};
+    side_element::integrate(sources1, rule, &residuals[0]);
+    side_element::integrate(sources2, rule, &residuals[1]);
+
+    for (int s = 0; s < 2; s++) {
+      auto values = reinterpret_cast<const double*>(&residuals[s]);
+      for (int i = 0; i < components; i++) {
+        for (int j = 0; j < side_element::ndof; j++) {
+          (*element_residual)(i, s, j) += values[i * side_element::ndof + j];
+        }
+      }
+    }
+  }
+};
+
+template <int i, int dim, typename... trials, typename lambda>
+auto get_derivative_type(lambda qf)
+{
+  using qf_arguments = serac::tuple<typename QFunctionArgument<trials, serac::Dimension<dim>>::type...>;
+  return get_gradient(detail::apply_qf(qf, tensor<double, dim + 1>{}, tensor<double, dim + 1>{},
+                                       make_dual_wrt<i>(qf_arguments{})));
+};
+
+/// @brief the type used to store the derivatives of a q-function with respect to trial space i
+template <int i, int dim, typename lambda, typename... trials>
+using qf_derivative_storage_t =
+    detail::derivative_storage_t<lambda, decltype(get_derivative_type<i, dim, trials...>(std::declval<lambda>()))>;
+
+/**
+ * @brief allocate the memory for the derivatives of a q-function with respect to each trial space, at each quadrature
+ * point of the given number of faces
+ *
+ * @note the derivatives are stored in single precision if the q-function was wrapped with
+ * `with_single_precision_derivatives()`
+ */
+template <int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename test, typename... trials, typename lambda,
+          int... i>
+auto allocate_qf_derivatives(FunctionSignature<test(trials...)>, const lambda&, uint32_t num_elements,
+                             std::integer_sequence<int, i...>)
+{
+  constexpr int         dim              = dimension_of(geom);
+  constexpr std::size_t qpts_per_element = num_quadrature_points(geom, Q);
+  return serac::make_tuple(accelerator::make_shared_array<exec, qf_derivative_storage_t<i, dim, lambda, trials...>>(
+      num_elements * qpts_per_element, memory::Subsystem::QFunctionDerivatives)...);
+}
+
+/**
+ * @brief evaluate the q-function at each quadrature point of a face
+ *
+ * @note the q-function is called as `qf(x, n, inputs...)`, where n is the unit normal pointing from side 1 to
+ * side 2, and returns the sources to integrate against the test functions of side 1 and side 2 (as a tuple)
+ */
+template <typename lambda, int dim, int n, typename... T>
+SERAC_HOST_DEVICE auto batch_apply_qf(lambda qf, const tensor<double, dim, n>& positions,
+                                      const tensor<double, dim - 1, dim, n>& jacobians, const T&... inputs)
+{
+  using return_type = decltype(qf(tensor<double, dim>{}, tensor<double, dim>{}, T{}[0]...));
+  tensor<return_type, n> outputs{};
+  for (int i = 0; i < n; i++) {
+    tensor<double, dim>          x_q;
+    tensor<double, dim, dim - 1> J_q;
+    for (int j = 0; j < dim; j++) {
+      x_q[j] = positions(j, i);
+      for (int k = 0; k < dim - 1; k++) {
+        J_q(j, k) = jacobians(k, j, i);
+      }
+    }
+    tensor<double, dim> n_q = cross(J_q);
+
+    double scale = norm(n_q);
+
+    auto sources       = qf(x_q, n_q / scale, inputs[i]...);
+    get<0>(outputs[i]) = get<0>(sources) * scale;
+    get<1>(outputs[i]) = get<1>(sources) * scale;
+  }
+  return outputs;
+}
+
+template <uint32_t differentiation_index, int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename test,
+          typename... trials, typename lambda_type, typename derivative_type, int... indices>
+void evaluation_kernel_impl(FunctionSignature<test(trials...)>, const std::vector<const double*>& inputs,
+                            double* outputs, const double* positions, const double* jacobians, lambda_type qf,
+                            [[maybe_unused]] derivative_type* qf_derivatives, uint32_t first_element,
+                            uint32_t num_elements, std::integer_sequence<int, indices...>)
+{
+  using test_element = face_element_pair<geom, test>;
+
+  /// @brief the element type for each trial space
+  using trial_elements = tuple<face_element_pair<geom, trials>...>;
+
+  // note: `inputs` and `outputs` only describe the faces [first_element, first_element + num_elements),
+  // so the other per-face quantities are offset to begin at `first_element` as well
+  constexpr int dim = dimension_of(geom) + 1;
+  constexpr int nqp = num_quadrature_points(geom, Q);
+  auto          J   = reinterpret_cast<const tensor<double, dim - 1, dim, nqp>*>(jacobians) + first_element;
+  auto          x   = reinterpret_cast<const tensor<double, dim, nqp>*>(positions) + first_element;
+  auto          r   = reinterpret_cast<typename test_element::dof_type*>(outputs);
+
+  [[maybe_unused]] tuple u = {
+      reinterpret_cast<const typename decltype(type<indices>(trial_elements{}))::dof_type*>(inputs[indices])...};
+
+  // for each face in the domain
+  accelerator::forall<exec>(num_elements, [=] SERAC_HOST_DEVICE(uint32_t e) {
+    TensorProductQuadratureRule<Q> rule{};
+
+    // batch-calculate the values of each trial space on both sides, at each quadrature point
+    [[maybe_unused]] tuple qf_inputs = {promote_each_to_dual_when<indices == differentiation_index>(
+        decltype(type<indices>(trial_elements{}))::interpolate(get<indices>(u)[e], rule))...};
+
+    // (batch) evalute the q-function at each quadrature point
+    auto qf_outputs = batch_apply_qf(qf, x[e], J[e], get<indices>(qf_inputs)...);
+
+    if constexpr (differentiation_index != serac::NO_DIFFERENTIATION) {
+      for (int q = 0; q < nqp; q++) {
+        detail::precision_copy(get_gradient(qf_outputs[q]), qf_derivatives[(first_element + e) * nqp + uint32_t(q)]);
+      }
+    }
+
+    // (batch) integrate the sources against the test-space basis functions of each side
+    test_element::integrate(get_value(qf_outputs), rule, &r[e]);
+  });
+}
+
+/**
+ * @brief a version of evaluation_kernel_impl() that stores the derivatives of the q-function with respect to several
+ * trial spaces in the same pass over the faces
+ *
+ * @param qf_derivatives where to write the derivatives with respect to each trial space
+ * @param which a bitmask of the trial spaces to differentiate with respect to: bit i selects trial space i
+ */
+template <int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename test, typename... trials,
+          typename lambda_type, typename... derivative_type, int... indices>
+void evaluation_kernel_with_multiple_derivatives_impl(FunctionSignature<test(trials...)>,
+                                                      const std::vector<const double*>& inputs, double* outputs,
+                                                      const double* positions, const double* jacobians,
+                                                      lambda_type qf, tuple<derivative_type*...> qf_derivatives,
+                                                      uint32_t which, uint32_t first_element, uint32_t num_elements,
+                                                      std::integer_sequence<int, indices...>)
+{
+  using test_element   = face_element_pair<geom, test>;
+  using trial_elements = tuple<face_element_pair<geom, trials>...>;
+
+  constexpr int dim = dimension_of(geom) + 1;
+  constexpr int nqp = num_quadrature_points(geom, Q);
+  auto          J   = reinterpret_cast<const tensor<double, dim - 1, dim, nqp>*>(jacobians) + first_element;
+  auto          x   = reinterpret_cast<const tensor<double, dim, nqp>*>(positions) + first_element;
+  auto          r   = reinterpret_cast<typename test_element::dof_type*>(outputs);
+
+  tuple u = {reinterpret_cast<const typename decltype(type<indices>(trial_elements{}))::dof_type*>(inputs[indices])...};
+
+  // for each face in the domain
+  accelerator::forall<exec>(num_elements, [=] SERAC_HOST_DEVICE(uint32_t e) {
+    TensorProductQuadratureRule<Q> rule{};
+
+    tuple values = {decltype(type<indices>(trial_elements{}))::interpolate(get<indices>(u)[e], rule)...};
+
+    for_constexpr<sizeof...(trials)>([&](auto i) {
+      if (((which >> i) & 1) == 0) return;
+
+      [[maybe_unused]] tuple qf_inputs = {promote_each_to_dual_when<indices == i>(get<indices>(values))...};
+
+      auto qf_outputs = batch_apply_qf(qf, x[e], J[e], get<indices>(qf_inputs)...);
+
+      for (int q = 0; q < nqp; q++) {
+        detail::precision_copy(get_gradient(qf_outputs[q]),
+                               get<i>(qf_derivatives)[(first_element + e) * nqp + uint32_t(q)]);
+      }
+
+      // the last selected trial space is responsible for the residual
+      if ((which >> i) == 1) {
+        test_element::integrate(get_value(qf_outputs), rule, &r[e]);
+      }
+    });
+  });
+}
+
+/**
+ * @brief apply the derivatives of the q-function (w.r.t. the values of one trial space on both sides) to
+ * a perturbation of those values
+ *
+ * @param dfdx the derivatives of the sources of either side w.r.t. the values of either side
+ * @param dx the perturbation of the values of either side
+ */
+template <typename S, typename T>
+SERAC_HOST_DEVICE auto chain_rule(const S& dfdx, const T& dx)
+{
+  return serac::tuple{
+      serac::chain_rule(serac::get<0>(serac::get<0>(dfdx)), serac::get<0>(dx)) +
+          serac::chain_rule(serac::get<1>(serac::get<0>(dfdx)), serac::get<1>(dx)),
+      serac::chain_rule(serac::get<0>(serac::get<1>(dfdx)), serac::get<0>(dx)) +
+          serac::chain_rule(serac::get<1>(serac::get<1>(dfdx)), serac::get<1>(dx))};
+}
+
+/**
+ * @brief the body of action_of_gradient_kernel() for a single face
+ *
+ * @param[in] du_e the DOF values of the perturbation on this face (both sides)
+ * @param[inout] dr_e the resulting perturbation of this face's residual (both sides)
+ * @param[in] qf_derivatives_e the derivatives of the q-function at each quadrature point of this face
+ */
+template <int Q, mfem::Geometry::Type geom, typename test, typename trial, typename derivatives_type>
+SERAC_HOST_DEVICE void action_of_gradient_element(const typename face_element_pair<geom, trial>::dof_type& du_e,
+                                                  typename face_element_pair<geom, test>::dof_type& dr_e,
+                                                  const derivatives_type* qf_derivatives_e)
+{
+  using test_element  = face_element_pair<geom, test>;
+  using trial_element = face_element_pair<geom, trial>;
+
+  constexpr int nqp = num_quadrature_points(geom, Q);
+
+  TensorProductQuadratureRule<Q> rule{};
+
+  // (batch) interpolate the perturbation at each quadrature point
+  auto du_q = trial_element::interpolate(du_e, rule);
+
+  using full_derivative_type = detail::double_precision_t<std::remove_const_t<derivatives_type>>;
+  using source_type          = decltype(chain_rule(full_derivative_type{}, du_q[0]));
+
+  // (batch) apply the q-function derivatives at each quadrature point
+  tensor<source_type, nqp> sources{};
+  for (int q = 0; q < nqp; q++) {
+    sources[q] = chain_rule(detail::to_double_precision(qf_derivatives_e[q]), du_q[q]);
+  }
+
+  // (batch) integrate the sources against the test-space basis functions of each side
+  test_element::integrate(sources, rule, &dr_e);
+}
+
+/**
+ * @brief The kernel for the directional derivative of an interior face integral, see
+ * boundary_integral::action_of_gradient_kernel()
+ *
+ * @param[in] dU The full set of per-face DOF values (primary input)
+ * @param[inout] dR The full set of per-face residuals (primary output)
+ * @param[in] qf_derivatives The derivatives of the q-function at each quadrature point of the first face
+ * @param[in] num_elements The number of faces
+ * @param[in] num_directions The number of perturbations to apply the gradient to: dU and dR hold the values for each
+ * perturbation one after another, each describing `num_elements` faces
+ */
+template <int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename test, typename trial,
+          typename derivatives_type>
+void action_of_gradient_kernel(const double* dU, double* dR, derivatives_type* qf_derivatives, std::size_t num_elements,
+                               uint32_t num_directions)
+{
+  using test_element  = face_element_pair<geom, test>;
+  using trial_element = face_element_pair<geom, trial>;
+
+  constexpr int nqp = num_quadrature_points(geom, Q);
+  auto          du  = reinterpret_cast<const typename trial_element::dof_type*>(dU);
+  auto          dr  = reinterpret_cast<typename test_element::dof_type*>(dR);
+
+  // for each face in the domain, the q-function derivatives are loaded
+  // once and applied to each of the perturbations
+  accelerator::forall<exec>(uint32_t(num_elements), [=] SERAC_HOST_DEVICE(uint32_t e) {
+    for (uint32_t d = 0; d < num_directions; d++) {
+      std::size_t i = std::size_t(d) * num_elements + e;
+      action_of_gradient_element<Q, geom, test, trial>(du[i], dr[i], qf_derivatives + e * nqp);
+    }
+  });
+}
+
+/**
+ * @brief The kernel for the element gradients of an interior face integral: each column of a face's matrix is the
+ * action of its gradient on the corresponding unit perturbation
+ *
+ * @param[inout] dK 3-dimensional array storing the face gradient matrices
+ * @param[in] qf_derivatives the derivatives of the q-function at each quadrature point
+ * @param[in] num_elements The number of faces
+ */
+template <mfem::Geometry::Type geom, typename test, typename trial, int Q, ExecutionSpace exec,
+          typename derivatives_type>
+void element_gradient_kernel(ExecArrayView<double, 3, exec> dK, derivatives_type* qf_derivatives,
+                             std::size_t num_elements)
+{
+  using test_element  = face_element_pair<geom, test>;
+  using trial_element = face_element_pair<geom, trial>;
+
+  constexpr int nqp         = num_quadrature_points(geom, Q);
+  constexpr int test_vdofs  = test_element::ndof * test_element::components;
+  constexpr int trial_vdofs = trial_element::ndof * trial_element::components;
+
+  double* K = dK.data();
+
+  // for each face in the domain
+  accelerator::forall<exec>(uint32_t(num_elements), [=] SERAC_HOST_DEVICE(uint32_t e) {
+    auto K_e = reinterpret_cast<typename test_element::dof_type*>(K + std::size_t(e) * trial_vdofs * test_vdofs);
+    for (int j = 0; j < trial_vdofs; j++) {
+      typename trial_element::dof_type du_e{};
+      reinterpret_cast<double*>(&du_e)[j] = 1.0;
+      action_of_gradient_element<Q, geom, test, trial>(du_e, K_e[j], qf_derivatives + e * nqp);
+    }
+  });
+}
+
+template <uint32_t wrt, int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename signature, typename lambda_type,
+          typename derivative_type>
+std::function<void(const std::vector<const double*>&, double*, bool, uint32_t, uint32_t)> evaluation_kernel(
+    signature s, lambda_type qf, const double* positions, const double* jacobians,
+    std::shared_ptr<derivative_type> qf_derivatives)
+{
+  return [=](const std::vector<const double*>& inputs, double* outputs, bool /* update state */,
+             uint32_t first_element, uint32_t num_elements) {
+    evaluation_kernel_impl<wrt, Q, geom, exec>(s, inputs, outputs, positions, jacobians, qf, qf_derivatives.get(),
+                                               first_element, num_elements, s.index_seq);
+  };
+}
+
+template <int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename signature, typename lambda_type,
+          typename... derivative_type>
+std::function<void(const std::vector<const double*>&, double*, bool, uint32_t, uint32_t, uint32_t)>
+evaluation_kernel_with_multiple_derivatives(signature s, lambda_type qf, const double* positions,
+                                            const double*                              jacobians,
+                                            tuple<std::shared_ptr<derivative_type>...> qf_derivatives)
+{
+  return [=](const std::vector<const double*>& inputs, double* outputs, bool /* update state */,
+             uint32_t first_element, uint32_t num_elements, uint32_t which) {
+    auto derivatives = serac::apply([](auto&... each) { return serac::make_tuple(each.get()...); }, qf_derivatives);
+    evaluation_kernel_with_multiple_derivatives_impl<Q, geom, exec>(s, inputs, outputs, positions, jacobians, qf,
+                                                                    derivatives, which, first_element, num_elements,
+                                                                    s.index_seq);
+  };
+}
+
+template <int wrt, int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename signature, typename derivative_type>
+std::function<void(const double*, double*, uint32_t, uint32_t, uint32_t)> jacobian_vector_product_kernel(
+    signature, std::shared_ptr<derivative_type> qf_derivatives)
+{
+  return [=](const double* du, double* dr, uint32_t first_element, uint32_t num_elements, uint32_t num_directions) {
+    using test_space  = typename signature::return_type;
+    using trial_space = typename std::tuple_element<wrt, typename signature::parameter_types>::type;
+    constexpr int nqp = num_quadrature_points(geom, Q);
+    action_of_gradient_kernel<Q, geom, exec, test_space, trial_space>(
+        du, dr, qf_derivatives.get() + std::size_t(first_element) * nqp, num_elements, num_directions);
+  };
+}
+
+template <int wrt, int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename signature, typename derivative_type>
+std::function<void(double*)> element_gradient_kernel(signature, std::shared_ptr<derivative_type> qf_derivatives,
+                                                     uint32_t num_elements)
+{
+  return [=](double* K_elem) {
+    using test_space    = typename signature::return_type;
+    using trial_space   = typename std::tuple_element<wrt, typename signature::parameter_types>::type;
+    using test_element  = face_element_pair<geom, test_space>;
+    using trial_element = face_element_pair<geom, trial_space>;
+
+    constexpr int test_vdofs  = test_element::ndof * test_element::components;
+    constexpr int trial_vdofs = trial_element::ndof * trial_element::components;
+
+    ExecArrayView<double, 3, exec> K_elem_view(K_elem, num_elements, trial_vdofs, test_vdofs);
+    element_gradient_kernel<geom, test_space, trial_space, Q, exec>(K_elem_view, qf_derivatives.get(), num_elements);
+  };
+}
+
+}  // namespace interior_face_integral
+
+}  // namespace serac
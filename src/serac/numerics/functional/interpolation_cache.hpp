@@ -0,0 +1,186 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file interpolation_cache.hpp
+ *
+ * @brief storage for reusing the values of a trial space argument at each quadrature point,
+ * across evaluations in which that argument doesn't change (or for supplying them directly)
+ */
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "serac/infrastructure/accelerator.hpp"
+#include "serac/infrastructure/logger.hpp"
+#include "serac/numerics/functional/tuple.hpp"
+#include "serac/numerics/functional/finite_element.hpp"
+#include "serac/numerics/functional/quadrature_data.hpp"
+
+namespace serac {
+
+/// @brief a value indicating that none of an Integral's trial spaces reuses its interpolated values
+static constexpr uint32_t NO_CACHED_ARGUMENT = uint32_t(1) << 31;
+
+/**
+ * @brief the type of the values of trial space `space` at each quadrature point, e.g. of the QuadratureData that
+ * supplies them (see Functional::SetQuadraturePointArgument())
+ */
+template <typename space>
+using quadrature_point_value_t = std::conditional_t<space::components == 1, double, tensor<double, space::components>>;
+
+/**
+ * @brief the values of a trial space at each quadrature point, given by a QuadratureData<T> buffer (with
+ * T = quadrature_point_value_t of that trial space) rather than interpolated from its dofs
+ */
+struct SuppliedValues {
+  std::shared_ptr<void> values;            ///< the QuadratureData<T> buffer
+  std::size_t           num_elements;      ///< the number of elements the buffer describes
+  std::size_t           qpts_per_element;  ///< the number of quadrature points per element in the buffer
+};
+
+/**
+ * @brief which trial space (if any) of an Integral reuses its values at each quadrature point between evaluations,
+ * and whether the stored values are out of date
+ *
+ * @note this is shared by every kernel of an Integral, and set by Functional (see Functional::SetCachedArgument() and
+ * Functional::SetQuadraturePointArgument())
+ */
+struct InterpolationCacheState {
+  uint32_t argument = NO_CACHED_ARGUMENT;  ///< the (integral) index of the trial space with reused values
+  bool     refresh  = true;                ///< whether the next evaluation must recompute (and store) the values
+
+  /// the trial spaces (by integral index) whose values at each quadrature point are supplied, not interpolated
+  std::map<uint32_t, SuppliedValues> supplied;
+};
+
+/**
+ * @brief the values (and derivatives) at each quadrature point of an Integral's trial spaces, for the elements of
+ * one geometry
+ *
+ * At most one of these trial spaces (the one selected in `state`) actually stores anything: that trial space is
+ * interpolated during evaluations that refresh the cache, and its stored values are used in place of the
+ * interpolation otherwise.
+ *
+ * @note only kernels in ExecutionSpace::CPU use this cache
+ *
+ * @tparam Q a parameter that controls the number of quadrature points
+ * @tparam geom the element geometry
+ * @tparam trials the trial spaces of the integral
+ */
+template <int Q, mfem::Geometry::Type geom, typename... trials>
+struct InterpolationCache {
+  /// @brief the type returned by interpolating trial space `space` on an element
+  template <typename space>
+  using interpolated_type = decltype(finite_element<geom, space>::interpolate(
+      typename finite_element<geom, space>::dof_type{}, TensorProductQuadratureRule<Q>{}));
+
+  /**
+   * @brief create an (empty) cache
+   * @param s the settings shared by every kernel of the Integral
+   * @param n the number of elements of this geometry
+   */
+  InterpolationCache(std::shared_ptr<InterpolationCacheState> s, uint32_t n) : state(s), num_elements(n) {}
+
+  /**
+   * @brief get the storage of each trial space, for the elements [first_element, first_element + num_elements)
+   * @param first_element the index of the first element
+   * @return a tuple with a pointer for each trial space: nullptr unless values of that trial space are to be reused
+   */
+  template <ExecutionSpace exec>
+  auto pointers(uint32_t first_element)
+  {
+    tuple<interpolated_type<trials>*...> output{};
+    if constexpr (exec == ExecutionSpace::CPU) {
+      for_constexpr<sizeof...(trials)>([&](auto i) {
+        if (state->argument != uint32_t(int(i))) {
+          get<i>(values).clear();
+          return;
+        }
+        if (get<i>(values).size() != num_elements) {
+          get<i>(values).resize(num_elements);
+          state->refresh = true;
+        }
+        get<i>(output) = get<i>(values).data() + first_element;
+      });
+    }
+    return output;
+  }
+
+  /**
+   * @brief get the supplied values of each trial space (see InterpolationCacheState::supplied), at the quadrature
+   * points of the elements [first_element, first_element + num_elements)
+   * @param first_element the index of the first element
+   * @return a tuple with a pointer for each trial space: nullptr unless the values of that trial space are supplied
+   */
+  template <ExecutionSpace exec>
+  auto supplied_values(uint32_t first_element)
+  {
+    tuple<const quadrature_point_value_t<trials>*...> output{};
+    if constexpr (exec == ExecutionSpace::CPU) {
+      constexpr std::size_t qpts_per_element = num_quadrature_points(geom, Q);
+      for_constexpr<sizeof...(trials)>([&](auto i) {
+        auto supplied = state->supplied.find(uint32_t(int(i)));
+        if (supplied == state->supplied.end()) return;
+
+        SLIC_ERROR_IF(supplied->second.qpts_per_element != qpts_per_element ||
+                          supplied->second.num_elements < num_elements,
+                      "the quadrature point values of an argument don't match the quadrature rule of an integral");
+
+        using value_type = std::remove_const_t<std::remove_pointer_t<std::decay_t<decltype(get<i>(output))>>>;
+        get<i>(output)   = static_cast<QuadratureData<value_type>*>(supplied->second.values.get())->at(first_element);
+      });
+    }
+    return output;
+  }
+
+  std::shared_ptr<InterpolationCacheState>         state;         ///< which trial space to store, and when to update it
+  uint32_t                                         num_elements;  ///< the number of elements of this geometry
+  tuple<std::vector<interpolated_type<trials>>...> values;        ///< the stored values
+};
+
+/**
+ * @brief interpolate the values of a trial space on one element, or reuse previously stored (or supplied) ones
+ *
+ * @tparam element_type the finite element type of the trial space
+ * @param u_e the element's dof values
+ * @param rule the quadrature rule
+ * @param cached the stored values for each element (see InterpolationCache::pointers()), or nullptr to interpolate
+ * @param supplied the supplied values at each quadrature point (see InterpolationCache::supplied_values()), or nullptr
+ * @param e the index of the element in `cached` and `supplied`
+ * @param refresh whether to recompute (and store) the values of element `e` rather than reusing them
+ *
+ * @note supplied values have a zero gradient
+ */
+template <typename element_type, typename T, typename V, int Q>
+SERAC_HOST_DEVICE auto interpolate_or_reuse(const typename element_type::dof_type& u_e,
+                                            const TensorProductQuadratureRule<Q>& rule, T* cached, const V* supplied,
+                                            uint32_t e, bool refresh)
+{
+  if constexpr (element_type::family == Family::H1 || element_type::family == Family::L2) {
+    if (supplied != nullptr) {
+      constexpr int qpts_per_element = num_quadrature_points(element_type::geometry, Q);
+
+      decltype(element_type::interpolate(u_e, rule)) values{};
+      for (int q = 0; q < qpts_per_element; q++) {
+        get<0>(values[q]) = supplied[e * uint32_t(qpts_per_element) + uint32_t(q)];
+      }
+      return values;
+    }
+  }
+  if (cached == nullptr) {
+    return element_type::interpolate(u_e, rule);
+  }
+  if (refresh) {
+    cached[e] = element_type::interpolate(u_e, rule);
+  }
+  return T(cached[e]);
+}
+
+}  // namespace serac
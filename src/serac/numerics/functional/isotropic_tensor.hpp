@@ -468,4 +468,21 @@ SERAC_HOST_DEVICE constexpr auto double_dot(const isotropic_tensor<S, m, m, m, m
   return I.c1 * tr(A) * Identity<m>() + I.c2 * sym(A) + I.c3 * antisym(A);
 }
 
+/**
+ * @brief the chain rule for a matrix-valued function with isotropic derivative I, applied to a small change in
+ * its (matrix-valued) argument
+ *
+ * @tparam m the dimension of each extent of I
+ * @param df_dx the isotropic derivative
+ * @param dx the small change in the argument
+ * @return a new tensor equal to the index notation expression:
+ *    output(i,j) := df_dx(i,j,k,l) * dx(k,l)
+ */
+template <int m>
+SERAC_HOST_DEVICE constexpr auto chain_rule(const isotropic_tensor<double, m, m, m, m>& df_dx,
+                                            const tensor<double, m, m>& dx)
+{
+  return double_dot(df_dx, dx);
+}
+
 }  // namespace serac
@@ -0,0 +1,200 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/numerics/functional/overlapped_prolongation.hpp"
+
+#include <algorithm>
+#include <map>
+#include <utility>
+
+namespace serac {
+
+struct OverlappedProlongation::ExchangePlan {
+  /// @brief P sends the values of owned dofs to the other ranks of their groups, P^T sends them back to the owners
+  static constexpr int bcast_tag  = 0;
+  static constexpr int reduce_tag = 1;
+
+  /// @brief a duplicate of the communicator of the space, so that the messages of different plans never match
+  MPI_Comm comm;
+
+  /// @brief the (local) true dofs whose values are sent to the other ranks of their groups, by neighbor rank
+  std::vector<int> send_tdofs;
+
+  /// @brief the local dofs whose values are received from their owners, by neighbor rank
+  std::vector<int> recv_ldofs;
+
+  /// @brief the values of send_tdofs (sent by P, and received by P^T) and of recv_ldofs (received by P, sent by P^T)
+  std::vector<double> send_buffer, recv_buffer;
+
+  /// @brief the persistent requests of the exchanges of P and P^T
+  std::vector<MPI_Request> bcast_requests, reduce_requests;
+
+  ~ExchangePlan()
+  {
+    for (auto* requests : {&bcast_requests, &reduce_requests}) {
+      for (auto& request : *requests) {
+        MPI_Request_free(&request);
+      }
+    }
+    MPI_Comm_free(&comm);
+  }
+};
+
+OverlappedProlongation::OverlappedProlongation(const mfem::ParFiniteElementSpace* pfes)
+    : P_(pfes->GetProlongationMatrix()), gc_(nullptr)
+{
+  // only the conforming prolongation operator is a plain copy of the owned values followed by a broadcast,
+  // so any other kind of operator is applied as-is (without overlapping its communication)
+  if (!pfes->Conforming() || dynamic_cast<const mfem::ConformingProlongationOperator*>(P_) == nullptr) {
+    return;
+  }
+
+  gc_ = &pfes->GroupComm();
+
+  owned_ldofs_.resize(static_cast<std::size_t>(pfes->GetTrueVSize()));
+  for (int ldof = 0; ldof < pfes->GetVSize(); ldof++) {
+    int ltdof = pfes->GetLocalTDofNumber(ldof);
+    if (ltdof >= 0) {
+      owned_ldofs_[static_cast<std::size_t>(ltdof)] = ldof;
+    }
+  }
+
+  // The dofs of each group are numbered alike on all of its ranks, and a group is identified across ranks by its
+  // number on its master, so the groups exchanged with a neighbor are ordered by that number on both sides.
+  const mfem::GroupTopology& gtopo      = pfes->GetGroupTopo();
+  const mfem::Table&         group_ldof = gc_->GroupLDofTable();
+
+  std::map<int, std::vector<std::pair<int, int>>> sends, recvs;  // (master group, group) pairs, by neighbor rank
+  for (int g = 1; g < gtopo.NGroups(); g++) {
+    if (group_ldof.RowSize(g) == 0) continue;
+    if (gtopo.IAmMaster(g)) {
+      const int* members = gtopo.GetGroup(g);
+      for (int m = 0; m < gtopo.GetGroupSize(g); m++) {
+        const int rank = gtopo.GetNeighborRank(members[m]);
+        if (rank != gtopo.MyRank()) {
+          sends[rank].emplace_back(g, g);
+        }
+      }
+    } else {
+      recvs[gtopo.GetGroupMasterRank(g)].emplace_back(gtopo.GetGroupMasterGroup(g), g);
+    }
+  }
+
+  plan_ = std::make_shared<ExchangePlan>();
+  MPI_Comm_dup(gtopo.GetComm(), &plan_->comm);
+
+  std::vector<std::pair<int, int>> send_ranges, recv_ranges;  // (rank, count)
+  for (auto& [rank, groups] : sends) {
+    std::sort(groups.begin(), groups.end());
+    const std::size_t begin = plan_->send_tdofs.size();
+    for (auto [master_group, g] : groups) {
+      for (int j = 0; j < group_ldof.RowSize(g); j++) {
+        plan_->send_tdofs.push_back(pfes->GetLocalTDofNumber(group_ldof.GetRow(g)[j]));
+      }
+    }
+    send_ranges.emplace_back(rank, static_cast<int>(plan_->send_tdofs.size() - begin));
+  }
+  for (auto& [rank, groups] : recvs) {
+    std::sort(groups.begin(), groups.end());
+    const std::size_t begin = plan_->recv_ldofs.size();
+    for (auto [master_group, g] : groups) {
+      for (int j = 0; j < group_ldof.RowSize(g); j++) {
+        plan_->recv_ldofs.push_back(group_ldof.GetRow(g)[j]);
+      }
+    }
+    recv_ranges.emplace_back(rank, static_cast<int>(plan_->recv_ldofs.size() - begin));
+  }
+
+  plan_->send_buffer.resize(plan_->send_tdofs.size());
+  plan_->recv_buffer.resize(plan_->recv_ldofs.size());
+
+  // the buffers of each direction are bound to the requests once, and reused by every exchange
+  double* send_values = plan_->send_buffer.data();
+  for (auto [rank, count] : send_ranges) {
+    MPI_Request bcast, reduce;
+    MPI_Send_init(send_values, count, MPI_DOUBLE, rank, ExchangePlan::bcast_tag, plan_->comm, &bcast);
+    MPI_Recv_init(send_values, count, MPI_DOUBLE, rank, ExchangePlan::reduce_tag, plan_->comm, &reduce);
+    plan_->bcast_requests.push_back(bcast);
+    plan_->reduce_requests.push_back(reduce);
+    send_values += count;
+  }
+
+  double* recv_values = plan_->recv_buffer.data();
+  for (auto [rank, count] : recv_ranges) {
+    MPI_Request bcast, reduce;
+    MPI_Recv_init(recv_values, count, MPI_DOUBLE, rank, ExchangePlan::bcast_tag, plan_->comm, &bcast);
+    MPI_Send_init(recv_values, count, MPI_DOUBLE, rank, ExchangePlan::reduce_tag, plan_->comm, &reduce);
+    plan_->bcast_requests.push_back(bcast);
+    plan_->reduce_requests.push_back(reduce);
+    recv_values += count;
+  }
+}
+
+void OverlappedProlongation::MultBegin(const mfem::Vector& T, mfem::Vector& L) const
+{
+  if (gc_ == nullptr) {
+    P_->Mult(T, L);
+    return;
+  }
+
+  const double* T_data = T.HostRead();
+  double*       L_data = L.HostWrite();
+
+  for (std::size_t k = 0; k < plan_->send_tdofs.size(); k++) {
+    plan_->send_buffer[k] = T_data[plan_->send_tdofs[k]];
+  }
+  MPI_Startall(static_cast<int>(plan_->bcast_requests.size()), plan_->bcast_requests.data());
+
+  for (std::size_t i = 0; i < owned_ldofs_.size(); i++) {
+    L_data[owned_ldofs_[i]] = T_data[i];
+  }
+}
+
+void OverlappedProlongation::MultEnd(mfem::Vector& L) const
+{
+  if (gc_ == nullptr) return;
+
+  MPI_Waitall(static_cast<int>(plan_->bcast_requests.size()), plan_->bcast_requests.data(), MPI_STATUSES_IGNORE);
+
+  double* L_data = L.HostReadWrite();
+  for (std::size_t k = 0; k < plan_->recv_ldofs.size(); k++) {
+    L_data[plan_->recv_ldofs[k]] = plan_->recv_buffer[k];
+  }
+}
+
+void OverlappedProlongation::MultTransposeBegin(const mfem::Vector& L) const
+{
+  if (gc_ == nullptr) return;
+
+  const double* L_data = L.HostRead();
+  for (std::size_t k = 0; k < plan_->recv_ldofs.size(); k++) {
+    plan_->recv_buffer[k] = L_data[plan_->recv_ldofs[k]];
+  }
+  MPI_Startall(static_cast<int>(plan_->reduce_requests.size()), plan_->reduce_requests.data());
+}
+
+void OverlappedProlongation::MultTransposeEnd(const mfem::Vector& L, mfem::Vector& T) const
+{
+  if (gc_ == nullptr) {
+    P_->MultTranspose(L, T);
+    return;
+  }
+
+  const double* L_data = L.HostRead();
+  double*       T_data = T.HostWrite();
+
+  for (std::size_t i = 0; i < owned_ldofs_.size(); i++) {
+    T_data[i] = L_data[owned_ldofs_[i]];
+  }
+
+  // add the contributions from other ranks to the (owned) true dof values
+  MPI_Waitall(static_cast<int>(plan_->reduce_requests.size()), plan_->reduce_requests.data(), MPI_STATUSES_IGNORE);
+  for (std::size_t k = 0; k < plan_->send_tdofs.size(); k++) {
+    T_data[plan_->send_tdofs[k]] += plan_->send_buffer[k];
+  }
+}
+
+}  // namespace serac
@@ -0,0 +1,105 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file overlapped_prolongation.hpp
+ *
+ * @brief A version of a parallel finite element space's prolongation operator (and its transpose) whose
+ * communication is split into separate begin/end phases, so that it can be overlapped with element calculations
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "mfem.hpp"
+
+namespace serac {
+
+/**
+ * @brief the prolongation operator P (true dofs -> local dofs) of an mfem::ParFiniteElementSpace and its transpose,
+ * with the exchange of shared dof values started and finished by separate calls
+ *
+ * For conforming spaces, P copies the values of the true dofs owned by this rank into the local dofs, and the values
+ * of the remaining local dofs are received from their owners. Calling MultBegin() does the local copy and posts the
+ * (non-blocking) messages, so any work that only reads owned dofs can be carried out before MultEnd() finishes the
+ * exchange. Similarly, MultTransposeBegin() sends the local values of dofs owned by other ranks, and
+ * MultTransposeEnd() sums the values of owned dofs with the contributions received from other ranks.
+ *
+ * The exchanges follow the shared dof groups of the space, but unlike mfem::GroupCommunicator's, their messages (one
+ * per neighbor rank and direction) are persistent MPI requests on preallocated buffers, set up once when the operator
+ * is created and only started and completed by each application, since the same exchange is repeated for every
+ * evaluation of a Functional.
+ *
+ * @note when the space does not use mfem::ConformingProlongationOperator (e.g. on nonconforming meshes), P is applied
+ * in a single blocking call: by MultBegin() for P, and by MultTransposeEnd() for P^T.
+ *
+ * @note copies of this object share the same exchange (and buffers), so only one exchange per copy can be in progress
+ * at a time
+ */
+class OverlappedProlongation {
+public:
+  /// @brief default ctor leaves this object uninitialized
+  OverlappedProlongation() : P_(nullptr), gc_(nullptr) {}
+
+  /**
+   * @brief create the prolongation operator for a given finite element space
+   * @param pfes the finite element space
+   */
+  OverlappedProlongation(const mfem::ParFiniteElementSpace* pfes);
+
+  /**
+   * @brief begin computing L = P * T
+   *
+   * @param T the true dof values, which must not be modified until MultEnd() is called
+   * @param L the local dof values: the entries for dofs owned by this rank are available after this returns
+   */
+  void MultBegin(const mfem::Vector& T, mfem::Vector& L) const;
+
+  /**
+   * @brief finish computing L = P * T, receiving the values of dofs owned by other ranks
+   * @param L the local dof values passed to MultBegin()
+   */
+  void MultEnd(mfem::Vector& L) const;
+
+  /**
+   * @brief begin computing T = P^T * L, sending the values of dofs owned by other ranks to their owners
+   * @param L the local dof values: the entries for dofs owned by other ranks must be final
+   */
+  void MultTransposeBegin(const mfem::Vector& L) const;
+
+  /**
+   * @brief finish computing T = P^T * L
+   * @param L the local dof values passed to MultTransposeBegin(): the entries for dofs owned by this rank must be final
+   * @param T the true dof values
+   */
+  void MultTransposeEnd(const mfem::Vector& L, mfem::Vector& T) const;
+
+  /**
+   * @brief the shared dof groups of the space, or nullptr if P is applied in a single blocking call: the operators
+   * made from the same space share them
+   */
+  const mfem::GroupCommunicator* Communicator() const { return gc_; }
+
+private:
+  /// @brief the persistent requests and buffers of the exchanges of shared dof values
+  struct ExchangePlan;
+
+  /// @brief the prolongation operator of the finite element space
+  const mfem::Operator* P_;
+
+  /// @brief the shared dof groups of a conforming space (nullptr otherwise)
+  const mfem::GroupCommunicator* gc_;
+
+  /// @brief the local dof index of each true dof owned by this rank
+  std::vector<int> owned_ldofs_;
+
+  /// @brief the exchanges of shared dof values of a conforming space
+  std::shared_ptr<ExchangePlan> plan_;
+};
+
+}  // namespace serac
@@ -29,7 +29,18 @@ SERAC_HOST_DEVICE constexpr tensor<T, n> GaussLobattoNodes(T a = T(0), T b = T(1
   if constexpr (n == 2) return {a, b}; 
   if constexpr (n == 3) return {a, a + 0.5000000000000000 * (b-a), b}; 
   if constexpr (n == 4) return {a, a + 0.2763932022500210 * (b-a), a + 0.7236067977499790 * (b-a), b};
-  return tensor<double, n>{};
+  if constexpr (n == 5) return {a, a + 0.17267316464601143 * (b-a), a + 0.5 * (b-a), a + 0.82732683535398857 * (b-a), b};
+  if constexpr (n == 6) return {a, a + 0.11747233803526766 * (b-a), a + 0.35738424175967748 * (b-a),
+                                   a + 0.64261575824032252 * (b-a), a + 0.88252766196473234 * (b-a), b};
+  if constexpr (n == 7) return {a, a + 0.084888051860716535 * (b-a), a + 0.26557560326464289 * (b-a), a + 0.5 * (b-a),
+                                   a + 0.73442439673535711 * (b-a), a + 0.91511194813928346 * (b-a), b};
+  if constexpr (n == 8) return {a, a + 0.064129925745196692 * (b-a), a + 0.20414990928342885 * (b-a),
+                                   a + 0.39535039104876056 * (b-a), a + 0.60464960895123944 * (b-a),
+                                   a + 0.79585009071657115 * (b-a), a + 0.93587007425480331 * (b-a), b};
+  if constexpr (n == 9) return {a, a + 0.050121002294269921 * (b-a), a + 0.16140686024463113 * (b-a),
+                                   a + 0.31844126808691092 * (b-a), a + 0.5 * (b-a), a + 0.68155873191308908 * (b-a),
+                                   a + 0.83859313975536887 * (b-a), a + 0.94987899770573008 * (b-a), b};
+  return tensor<T, n>{};
 };
 
 /**
@@ -37,7 +48,7 @@ SERAC_HOST_DEVICE constexpr tensor<T, n> GaussLobattoNodes(T a = T(0), T b = T(1
  * @tparam n The number of points per dimension
  * 
  * Mathematica/Wolfram Language code to generate the 1D entries in the table:
- * Do[Print["if constexpr (n == " <> ToString[n] <> ") return " <> ToString[GaussianQuadratureWeights[n, 0, 1, 17][[All, 1]]] <> ";"], {n, 1, 8}] 
+ * Do[Print["if constexpr (n == " <> ToString[n] <> ") return " <> ToString[GaussianQuadratureWeights[n, 0, 1, 17][[All, 1]]] <> ";"], {n, 1, 10}] 
  */
 template <int n, mfem::Geometry::Type geom>
 SERAC_HOST_DEVICE constexpr auto GaussLegendreNodes() {
@@ -51,6 +62,8 @@ SERAC_HOST_DEVICE constexpr auto GaussLegendreNodes() {
     if constexpr (n == 6) return tensor<double,n>{0.0337652428984240, 0.169395306766868, 0.380690406958402, 0.619309593041598, 0.830604693233132, 0.966234757101576};
     if constexpr (n == 7) return tensor<double,n>{0.0254460438286207, 0.129234407200303, 0.297077424311301, 0.500000000000000, 0.702922575688699, 0.87076559279970, 0.97455395617138};
     if constexpr (n == 8) return tensor<double,n>{0.0198550717512319, 0.101666761293187, 0.237233795041836, 0.408282678752175, 0.591717321247825, 0.76276620495816, 0.89833323870681, 0.98014492824877};
+    if constexpr (n == 9) return tensor<double,n>{0.0159198802461870, 0.0819844463366821, 0.193314283649705, 0.337873288298096, 0.500000000000000, 0.662126711701904, 0.806685716350295, 0.918015553663318, 0.984080119753813};
+    if constexpr (n == 10) return tensor<double,n>{0.0130467357414141, 0.0674683166555077, 0.160295215850488, 0.283302302935376, 0.425562830509184, 0.574437169490816, 0.716697697064624, 0.839704784149512, 0.932531683344492, 0.986953264258586};
   }
 
 
@@ -258,6 +271,21 @@ SERAC_HOST_DEVICE constexpr auto GaussLegendreNodes() {
                        {0.134478334792994016, 0.134478334792994016, 0.134478334792994016}}};
     }
   }
+
+  // prisms use the product of the triangle and segment rules, with the triangle points numbered fastest
+  if constexpr (geom == mfem::Geometry::PRISM) {
+    constexpr auto triangle = GaussLegendreNodes<n, mfem::Geometry::TRIANGLE>();
+    constexpr auto segment  = GaussLegendreNodes<n, mfem::Geometry::SEGMENT>();
+    constexpr int  ntri     = n * (n + 1) / 2;
+
+    tensor<double, ntri * n, 3> output{};
+    for (int qz = 0; qz < n; qz++) {
+      for (int qt = 0; qt < ntri; qt++) {
+        output[qz * ntri + qt] = {triangle[qt][0], triangle[qt][1], segment[qz]};
+      }
+    }
+    return output;
+  }
 };
 
 /**
@@ -266,7 +294,7 @@ SERAC_HOST_DEVICE constexpr auto GaussLegendreNodes() {
  *
  * Mathematica/Wolfram Language code to generate more entries in the table:
  * Do[Print["if constexpr (n == " <> ToString[n] <> ") return " <> ToString[GaussianQuadratureWeights[n, 0, 1, 17][[All,
- * 2]]] <> ";"], {n, 1, 8}]
+ * 2]]] <> ";"], {n, 1, 10}]
  */
 template <int n, mfem::Geometry::Type geom>
 SERAC_HOST_DEVICE constexpr auto GaussLegendreWeights()
@@ -280,6 +308,8 @@ SERAC_HOST_DEVICE constexpr auto GaussLegendreWeights()
     if constexpr (n == 6) return tensor<double, n>{0.085662246189585, 0.180380786524069, 0.233956967286346, 0.233956967286346, 0.180380786524069, 0.085662246189585};
     if constexpr (n == 7) return tensor<double, n>{0.0647424830844348, 0.139852695744638, 0.190915025252559, 0.208979591836735, 0.190915025252559,  0.139852695744638, 0.0647424830844348};
     if constexpr (n == 8) return tensor<double, n>{0.0506142681451881, 0.111190517226687, 0.156853322938944, 0.181341891689181, 0.181341891689181,  0.156853322938944, 0.111190517226687, 0.0506142681451881};
+    if constexpr (n == 9) return tensor<double, n>{0.0406371941807872, 0.0903240803474287, 0.130305348201468, 0.156173538520001, 0.165119677500630, 0.156173538520001, 0.130305348201468, 0.0903240803474287, 0.0406371941807872};
+    if constexpr (n == 10) return tensor<double, n>{0.0333356721543441, 0.0747256745752903, 0.109543181257991, 0.134633359654998, 0.147762112357376, 0.147762112357376, 0.134633359654998, 0.109543181257991, 0.0747256745752903, 0.0333356721543441};
   }
 
   if constexpr (geom == mfem::Geometry::TRIANGLE) {
@@ -364,6 +394,20 @@ SERAC_HOST_DEVICE constexpr auto GaussLegendreWeights()
     }
   }
 
+  if constexpr (geom == mfem::Geometry::PRISM) {
+    constexpr auto triangle = GaussLegendreWeights<n, mfem::Geometry::TRIANGLE>();
+    constexpr auto segment  = GaussLegendreWeights<n, mfem::Geometry::SEGMENT>();
+    constexpr int  ntri     = n * (n + 1) / 2;
+
+    tensor<double, ntri * n> output{};
+    for (int qz = 0; qz < n; qz++) {
+      for (int qt = 0; qt < ntri; qt++) {
+        output[qz * ntri + qt] = triangle[qt] * segment[qz];
+      }
+    }
+    return output;
+  }
+
 };
 // clang-format on
 
@@ -485,6 +529,61 @@ SERAC_HOST_DEVICE tensor<T, n> Bernstein(T s)
   return B;
 }
 
+namespace detail {
+
+/**
+ * @brief Lagrange interpolating polynomials through the given nodes, for the orders where
+ * closed-form expansions are not tabulated
+ * @tparam n how many entries to compute
+ * @param[in] nodes the interpolation nodes
+ * @param[in] x where to evaluate the polynomials
+ */
+template <int n, typename T>
+SERAC_HOST_DEVICE constexpr tensor<T, n> lagrange_interpolation(const tensor<double, n>& nodes, T x)
+{
+  tensor<T, n> L{};
+  for (int j = 0; j < n; j++) {
+    L[j] = 1.0;
+    for (int m = 0; m < n; m++) {
+      if (m != j) {
+        L[j] = L[j] * (x - nodes[m]) * (1.0 / (nodes[j] - nodes[m]));
+      }
+    }
+  }
+  return L;
+}
+
+/**
+ * @brief Derivatives of the Lagrange interpolating polynomials through the given nodes
+ * @tparam n how many entries to compute
+ * @param[in] nodes the interpolation nodes
+ * @param[in] x where to evaluate the polynomials
+ */
+template <int n, typename T>
+SERAC_HOST_DEVICE constexpr tensor<T, n> lagrange_interpolation_derivative(const tensor<double, n>& nodes, T x)
+{
+  tensor<T, n> dL{};
+  for (int j = 0; j < n; j++) {
+    dL[j] = 0.0;
+    for (int m = 0; m < n; m++) {
+      if (m == j) continue;
+
+      // the product rule term where the factor (x - nodes[m]) is differentiated
+      T term{};
+      term = 1.0 / (nodes[j] - nodes[m]);
+      for (int k = 0; k < n; k++) {
+        if (k != j && k != m) {
+          term = term * (x - nodes[k]) * (1.0 / (nodes[j] - nodes[k]));
+        }
+      }
+      dL[j] = dL[j] + term;
+    }
+  }
+  return dL;
+}
+
+}  // namespace detail
+
 /**
  * @brief Lagrange Interpolating polynomials for nodes at Gauss-Lobatto points on the interval [0, 1]
  * @tparam n how many entries to compute
@@ -493,7 +592,7 @@ SERAC_HOST_DEVICE tensor<T, n> Bernstein(T s)
 template <int n, typename T>
 SERAC_HOST_DEVICE constexpr tensor<T, n> GaussLobattoInterpolation([[maybe_unused]] T x)
 {
-  static_assert(1 <= n && n <= 4, "error: invalid polynomial order in GaussLobattoInterpolation");
+  static_assert(1 <= n && n <= 9, "error: invalid polynomial order in GaussLobattoInterpolation");
   if constexpr (n == 1) {
     return {1.0};
   }
@@ -508,6 +607,9 @@ SERAC_HOST_DEVICE constexpr tensor<T, n> GaussLobattoInterpolation([[maybe_unuse
     return {-(-1.0 + x) * (1.0 + 5.0 * (-1.0 + x) * x), -0.5 * sqrt5 * (5.0 + sqrt5 - 10.0 * x) * (-1.0 + x) * x,
             -0.5 * sqrt5 * (-1.0 + x) * x * (-5.0 + sqrt5 + 10.0 * x), x * (1.0 + 5.0 * (-1.0 + x) * x)};
   }
+  if constexpr (n > 4) {
+    return detail::lagrange_interpolation<n>(GaussLobattoNodes<n>(), x);
+  }
 
   return tensor<T, n>{};
 }
@@ -520,7 +622,7 @@ SERAC_HOST_DEVICE constexpr tensor<T, n> GaussLobattoInterpolation([[maybe_unuse
 template <int n, typename T>
 SERAC_HOST_DEVICE constexpr tensor<T, n> GaussLobattoInterpolationDerivative([[maybe_unused]] T x)
 {
-  static_assert(1 <= n && n <= 4, "error: invalid polynomial order in GaussLobattoInterpolationDerivative");
+  static_assert(1 <= n && n <= 9, "error: invalid polynomial order in GaussLobattoInterpolationDerivative");
   if constexpr (n == 1) {
     return {0.0};
   }
@@ -535,6 +637,9 @@ SERAC_HOST_DEVICE constexpr tensor<T, n> GaussLobattoInterpolationDerivative([[m
     return {-6.0 + 5.0 * (4.0 - 3.0 * x) * x, 2.5 * (1.0 + sqrt5 + 2.0 * x * (-1.0 - 3.0 * sqrt5 + 3.0 * sqrt5 * x)),
             -2.5 * (-1.0 + sqrt5 + 2.0 * x * (1.0 - 3.0 * sqrt5 + 3.0 * sqrt5 * x)), 1.0 + 5.0 * x * (-2.0 + 3.0 * x)};
   }
+  if constexpr (n > 4) {
+    return detail::lagrange_interpolation_derivative<n>(GaussLobattoNodes<n>(), x);
+  }
 
   return tensor<T, n>{};
 }
@@ -575,6 +680,7 @@ SERAC_HOST_DEVICE constexpr tensor<T, n> GaussLegendreInterpolation([[maybe_unus
                                              (24.9981258592191222217269164 - 18.79544940755506081126171563 * x) * x),
         -0.113917196281989931222711973 +
             x * (2.15592710364526077564170438 + x * (-7.9357618499449501626353065 + 7.4205400680389461052006424 * x))};
+  if constexpr (n > 4) return detail::lagrange_interpolation<n>(GaussLegendreNodes<n, mfem::Geometry::SEGMENT>(), x);
   return tensor<T, n>{};
 }
 
@@ -605,6 +711,9 @@ SERAC_HOST_DEVICE constexpr tensor<T, n> GaussLegendreInterpolationDerivative([[
             13.8071669256895770661586947 + x * (-62.776444726892120424116461 + 56.386348222665182433785147 * x),
             -7.4170704214626390758273806 + (49.996251718438244443453833 - 56.386348222665182433785147 * x) * x,
             2.15592710364526077564170438 + x * (-15.871523699889900325270613 + 22.2616202041168383156019272 * x)};
+  if constexpr (n > 4) {
+    return detail::lagrange_interpolation_derivative<n>(GaussLegendreNodes<n, mfem::Geometry::SEGMENT>(), x);
+  }
   return tensor<T, n>{};
 }
 
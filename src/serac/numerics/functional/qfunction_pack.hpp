@@ -0,0 +1,82 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file qfunction_pack.hpp
+ *
+ * @brief a statically typed collection of q-functions that Functional evaluates as a single, fused integral
+ */
+
+#pragma once
+
+#include <type_traits>
+#include <utility>
+
+#include "serac/infrastructure/accelerator.hpp"
+#include "serac/numerics/functional/tuple.hpp"
+#include "serac/numerics/functional/tensor.hpp"
+
+namespace serac {
+
+/**
+ * @brief several q-functions over the same domain (with the same arguments), evaluated as one integral
+ *
+ * Each integral added to a Functional is evaluated by its own kernels, called through `std::function`: the trial
+ * spaces are interpolated, and the results integrated against the test space, once per integral. When the terms
+ * of a weak form are known at compile time, e.g. the mass, stiffness and body force terms of a dynamics residual,
+ * packing their q-functions together lets them share a single kernel, with the q-functions inlined into it:
+ * the trial spaces are interpolated once, each q-function is evaluated at the quadrature point, and the sum of
+ * their outputs is integrated once. The derivatives of the sum (for the gradient kernels) are computed in the
+ * same pass.
+ *
+ * @note the q-functions share the quadrature point data of the integral, if any, and each must accept the same
+ * arguments. Wrappers that change how the derivatives are stored (e.g. with_single_precision_derivatives()) apply
+ * to the pack as a whole, so they wrap the pack rather than its members.
+ *
+ * @tparam lambdas the types of the q-functions
+ */
+template <typename... lambdas>
+struct QFunctionPack {
+  static_assert(sizeof...(lambdas) >= 1 && sizeof...(lambdas) <= 8, "a pack holds between 1 and 8 q-functions");
+
+  tuple<lambdas...> qfs;  ///< the q-functions
+
+  /// @brief evaluate each q-function, and return the sum of their outputs
+  template <typename... T>
+  SERAC_HOST_DEVICE auto operator()(T&&... args) const
+  {
+    return evaluate(std::make_integer_sequence<int, int(sizeof...(lambdas))>{}, args...);
+  }
+
+private:
+  /// @brief the sum of each q-function's output, where the arguments are passed (as lvalues) to each q-function
+  template <int... i, typename... T>
+  SERAC_HOST_DEVICE auto evaluate(std::integer_sequence<int, i...>, T&... args) const
+  {
+    return (get<i>(qfs)(args...) + ...);
+  }
+};
+
+/**
+ * @brief convenience function for packing several q-functions into one integral, e.g.
+ *
+ * @code{.cpp}
+ * auto mass      = [=](auto x, auto u) { return serac::tuple{rho * get<0>(u), zero{}}; };
+ * auto diffusion = [=](auto x, auto u) { return serac::tuple{zero{}, kappa * get<1>(u)}; };
+ * residual.AddDomainIntegral(Dimension<3>{}, DependsOn<0>{}, pack_qfunctions(mass, diffusion), mesh);
+ * @endcode
+ *
+ * which is equivalent to (but evaluated faster than) adding the integrals of `mass` and `diffusion` separately
+ *
+ * @param qfs the q-functions
+ */
+template <typename... lambdas>
+auto pack_qfunctions(lambdas&&... qfs)
+{
+  return QFunctionPack<std::decay_t<lambdas>...>{tuple<std::decay_t<lambdas>...>{std::forward<lambdas>(qfs)...}};
+}
+
+}  // namespace serac
@@ -12,6 +12,13 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
 #include "mfem.hpp"
 
 #include "axom/core.hpp"
@@ -55,10 +62,18 @@ struct Empty {
 template <typename T>
 struct QuadratureData {
   /// ctor, allocates memory and sets up strides
-  QuadratureData(size_t n1, size_t n2) : stride(n2) { data = new T[n1 * n2]; }
+  QuadratureData(size_t n1, size_t n2) : stride(n2), size(n1 * n2)
+  {
+    data = accelerator::make_host_array<T>(size);
+    account();
+  }
 
   /// dtor, deallocates memory
-  ~QuadratureData() { delete data; }
+  ~QuadratureData()
+  {
+    accelerator::destroy_host_array(data, size);
+    accelerator::destroy_host_array(tentative, size);
+  }
 
   /// access a mutable reference to the quadrature data at element `i`, quadrature point `j`
   SERAC_HOST_DEVICE T& operator()(size_t i, size_t j) { return data[i * stride + j]; }
@@ -66,8 +81,83 @@ struct QuadratureData {
   /// access a const reference to the quadrature data at element `i`, quadrature point `j`
   SERAC_HOST_DEVICE const T& operator()(size_t i, size_t j) const { return data[i * stride + j]; }
 
-  T*     data;    ///< pointer to the buffer of quadrature data
-  size_t stride;  ///< how many quadrature points per element
+  /// the quadrature data of element `i`, as read by the kernels (see detail::load_qdata())
+  SERAC_HOST_DEVICE T* at(size_t i) { return data + i * stride; }
+
+  /**
+   * @brief where q-functions write the updated quadrature data of element `i`
+   *
+   * This is the data itself, unless tentative updates are enabled, in which case updates go to a second (trial)
+   * buffer and q-functions keep starting from the committed data until commit() is called
+   */
+  SERAC_HOST_DEVICE T* updated(size_t i) { return (tentative ? tentative : data) + i * stride; }
+
+  /// called by the kernels before an evaluation that writes updated() for every quadrature point
+  void markUpdated() { updates_pending = true; }
+
+  /// write all subsequent updates to a tentative buffer, see updated()
+  void enableTentativeUpdates()
+  {
+    if (!tentative) {
+      tentative = accelerator::make_host_array<T>(size);
+      std::copy(data, data + size, tentative);
+    }
+    account();
+  }
+
+  /// make the latest tentative updates the committed quadrature data, by swapping the two buffers
+  void commit()
+  {
+    if (tentative && updates_pending) {
+      std::swap(data, tentative);
+    }
+    updates_pending = false;
+  }
+
+  /// discard the tentative updates since the last commit(), e.g. those of a rejected step
+  void rollback() { updates_pending = false; }
+
+  /**
+   * @brief move the data to the elements of a changed (e.g. adaptively refined) mesh, where element `i` of the new
+   * mesh takes the data of element `source_elements[i]` of the previous one, at each of its quadrature points
+   *
+   * @note pending tentative updates are discarded
+   */
+  void remap(const std::vector<size_t>& source_elements)
+  {
+    size_t new_size = source_elements.size() * stride;
+    T*     new_data = accelerator::make_host_array<T>(new_size);
+    for (size_t i = 0; i < source_elements.size(); i++) {
+      std::copy(data + source_elements[i] * stride, data + (source_elements[i] + 1) * stride, new_data + i * stride);
+    }
+
+    accelerator::destroy_host_array(data, size);
+    data = new_data;
+
+    if (tentative) {
+      accelerator::destroy_host_array(tentative, size);
+      tentative = accelerator::make_host_array<T>(new_size);
+      std::copy(data, data + new_size, tentative);
+    }
+    size = new_size;
+    account();
+    updates_pending = false;
+  }
+
+  /// the committed quadrature data as raw memory (a pointer to it and its size in bytes), e.g. for checkpointing
+  std::pair<void*, size_t> bytes() { return {data, sizeof(T) * size}; }
+
+  /// update the memory accounted to the quadrature data, after (re)allocating the buffers
+  void account() { tracker.set(sizeof(T) * size * (tentative ? 2 : 1)); }
+
+  T*     data;                    ///< pointer to the buffer of quadrature data
+  T*     tentative{nullptr};      ///< pointer to the buffer of tentative updates, if enabled
+  size_t stride;                  ///< how many quadrature points per element
+  size_t size;                    ///< how many quadrature points in total
+  bool   updates_pending{false};  ///< whether the tentative buffer holds updates that have not been committed
+
+  /// the accounting of the buffers, see memory::usage()
+  memory::Tracker tracker{memory::Subsystem::QuadratureData};
 };
 
 /**
@@ -83,6 +173,27 @@ struct QuadratureData<Nothing> {
   /// dummy accessor to satisfy interfacial requirements
   SERAC_HOST_DEVICE const Nothing& operator()(const size_t, const size_t) const { return data; }
 
+  /// dummy accessor to satisfy interfacial requirements
+  SERAC_HOST_DEVICE Nothing* at(const size_t) { return &data; }
+
+  /// dummy accessor to satisfy interfacial requirements
+  SERAC_HOST_DEVICE Nothing* updated(const size_t) { return &data; }
+
+  /// there is no data to update tentatively
+  void enableTentativeUpdates() {}
+
+  /// there is no data to update
+  void markUpdated() {}
+
+  /// there is no data to commit
+  void commit() {}
+
+  /// there is no data to roll back
+  void rollback() {}
+
+  /// there is no data to remap
+  void remap(const std::vector<size_t>&) {}
+
   /// dummy data to have an object to make a reference to in operator()
   Nothing data;
 };
@@ -100,10 +211,269 @@ struct QuadratureData<Empty> {
   /// dummy accessor to satisfy interfacial requirements
   SERAC_HOST_DEVICE const Empty& operator()(const size_t, const size_t) const { return data; }
 
+  /// dummy accessor to satisfy interfacial requirements
+  SERAC_HOST_DEVICE Empty* at(const size_t) { return &data; }
+
+  /// dummy accessor to satisfy interfacial requirements
+  SERAC_HOST_DEVICE Empty* updated(const size_t) { return &data; }
+
+  /// there is no data to update tentatively
+  void enableTentativeUpdates() {}
+
+  /// there is no data to update
+  void markUpdated() {}
+
+  /// there is no data to commit
+  void commit() {}
+
+  /// there is no data to roll back
+  void rollback() {}
+
+  /// there is no data to remap
+  void remap(const std::vector<size_t>&) {}
+
   /// dummy data to have an object to make a reference to in operator()
   Empty data;
 };
 
+/**
+ * @brief tag for quadrature data of type `T` that is stored in a structure-of-arrays layout, see
+ * QuadratureData<SoA<T>>. The q-functions still receive a `T&` at each quadrature point.
+ */
+template <typename T>
+struct SoA {
+};
+
+/// @brief the type of quadrature data that a QuadratureData<T> passes to the q-functions
+template <typename T>
+struct qdata_value {
+  using type = T;  ///< the type of the quadrature data
+};
+
+/// @overload
+template <typename T>
+struct qdata_value<SoA<T> > {
+  using type = T;  ///< the type of the quadrature data
+};
+
+/// @brief the type of quadrature data that a QuadratureData<T> passes to the q-functions
+template <typename T>
+using qdata_value_t = typename qdata_value<T>::type;
+
+namespace detail {
+
+/**
+ * @brief the quadrature data of one element in a structure-of-arrays layout (see QuadratureData<SoA<T>>), where
+ * the 64-bit words of the data at quadrature point `q` are `words[q]`, `words[q + size]`, `words[q + 2 * size]`, ...
+ */
+template <typename T>
+struct SoAElementView {
+  /// the number of 64-bit words in each value
+  static constexpr size_t num_words = sizeof(T) / sizeof(std::uint64_t);
+
+  /// an empty view, e.g. when the quadrature data isn't updated
+  SoAElementView() = default;
+
+  /// @overload
+  SERAC_HOST_DEVICE SoAElementView(std::nullptr_t) {}
+
+  /// view the words of an element, the first ones of which begin at `first_word`
+  SERAC_HOST_DEVICE SoAElementView(std::uint64_t* first_word, size_t words_apart)
+      : words(first_word), size(words_apart)
+  {
+  }
+
+  /// whether this views any data
+  SERAC_HOST_DEVICE explicit operator bool() const { return words != nullptr; }
+
+  /// gather the quadrature data at quadrature point `q`
+  SERAC_HOST_DEVICE T load(size_t q) const
+  {
+    std::uint64_t value[num_words];
+    for (size_t k = 0; k < num_words; k++) {
+      value[k] = words[k * size + q];
+    }
+    T result;
+    std::memcpy(&result, value, sizeof(T));
+    return result;
+  }
+
+  /// scatter the quadrature data at quadrature point `q`
+  SERAC_HOST_DEVICE void store(size_t q, const T& result) const
+  {
+    std::uint64_t value[num_words];
+    std::memcpy(value, &result, sizeof(T));
+    for (size_t k = 0; k < num_words; k++) {
+      words[k * size + q] = value[k];
+    }
+  }
+
+  std::uint64_t* words = nullptr;  ///< the first word of the first quadrature point of the element
+  size_t         size  = 0;        ///< how many quadrature points in total, i.e. the distance between words
+};
+
+/// @brief read the quadrature data at quadrature point `q` of an element (given by QuadratureData::at())
+template <typename T>
+SERAC_HOST_DEVICE T load_qdata(const T* qpt_data, size_t q)
+{
+  return qpt_data[q];
+}
+
+/// @overload
+template <typename T>
+SERAC_HOST_DEVICE T load_qdata(const SoAElementView<T>& qpt_data, size_t q)
+{
+  return qpt_data.load(q);
+}
+
+/// @brief write the quadrature data at quadrature point `q` of an element (given by QuadratureData::updated())
+template <typename T>
+SERAC_HOST_DEVICE void store_qdata(T* qpt_data, size_t q, const T& value)
+{
+  qpt_data[q] = value;
+}
+
+/// @overload
+template <typename T>
+SERAC_HOST_DEVICE void store_qdata(const SoAElementView<T>& qpt_data, size_t q, const T& value)
+{
+  qpt_data.store(q, value);
+}
+
+}  // namespace detail
+
+/**
+ * @brief a QuadratureData container that stores each 64-bit word of `T` (e.g. each scalar component of its members)
+ * contiguously over all of the quadrature points, rather than the values of `T` one after the other
+ *
+ * Material models that loop over quadrature points then read and write each component of their internal variables
+ * with unit stride, which makes more efficient use of memory bandwidth (and vectorizes) when they don't use every
+ * member of `T` at once. The q-functions receive a `T&` either way.
+ *
+ * @tparam T the data type to be stored, which must be trivially copyable, and a whole number of 64-bit words
+ */
+template <typename T>
+struct QuadratureData<SoA<T> > {
+  static_assert(std::is_trivially_copyable_v<T>, "QuadratureData<SoA<T>> requires a trivially copyable T");
+  static_assert(sizeof(T) % sizeof(std::uint64_t) == 0, "QuadratureData<SoA<T>> requires whole 64-bit words in T");
+
+  /// the number of 64-bit words in each value
+  static constexpr size_t num_words = detail::SoAElementView<T>::num_words;
+
+  /// @brief a proxy for the quadrature data at one quadrature point, which reads and writes a `T`
+  struct reference {
+    /// read the quadrature data
+    SERAC_HOST_DEVICE operator T() const { return element.load(q); }
+
+    /// write the quadrature data
+    SERAC_HOST_DEVICE reference& operator=(const T& value)
+    {
+      element.store(q, value);
+      return *this;
+    }
+
+    detail::SoAElementView<T> element;  ///< the quadrature data of the element
+    size_t                    q;        ///< which quadrature point of the element
+  };
+
+  /// ctor, allocates memory and sets up strides
+  QuadratureData(size_t n1, size_t n2) : stride(n2), size(n1 * n2)
+  {
+    data = accelerator::make_host_array<std::uint64_t>(num_words * size, num_words);
+    account();
+  }
+
+  /// dtor, deallocates memory
+  ~QuadratureData()
+  {
+    accelerator::destroy_host_array(data, num_words * size);
+    accelerator::destroy_host_array(tentative, num_words * size);
+  }
+
+  /// access the quadrature data at element `i`, quadrature point `j`
+  SERAC_HOST_DEVICE reference operator()(size_t i, size_t j) { return reference{at(i), j}; }
+
+  /// read the quadrature data at element `i`, quadrature point `j`
+  SERAC_HOST_DEVICE T operator()(size_t i, size_t j) const
+  {
+    return detail::SoAElementView<T>(data + i * stride, size).load(j);
+  }
+
+  /// the quadrature data of element `i`, as read by the kernels (see detail::load_qdata())
+  SERAC_HOST_DEVICE detail::SoAElementView<T> at(size_t i) { return {data + i * stride, size}; }
+
+  /// where q-functions write the updated quadrature data of element `i`, see QuadratureData::updated()
+  SERAC_HOST_DEVICE detail::SoAElementView<T> updated(size_t i)
+  {
+    return {(tentative ? tentative : data) + i * stride, size};
+  }
+
+  /// called by the kernels before an evaluation that writes updated() for every quadrature point
+  void markUpdated() { updates_pending = true; }
+
+  /// write all subsequent updates to a tentative buffer, see updated()
+  void enableTentativeUpdates()
+  {
+    if (!tentative) {
+      tentative = accelerator::make_host_array<std::uint64_t>(num_words * size, num_words);
+      std::copy(data, data + num_words * size, tentative);
+    }
+    account();
+  }
+
+  /// make the latest tentative updates the committed quadrature data, by swapping the two buffers
+  void commit()
+  {
+    if (tentative && updates_pending) {
+      std::swap(data, tentative);
+    }
+    updates_pending = false;
+  }
+
+  /// discard the tentative updates since the last commit(), e.g. those of a rejected step
+  void rollback() { updates_pending = false; }
+
+  /// move the data to the elements of a changed mesh, see QuadratureData::remap()
+  void remap(const std::vector<size_t>& source_elements)
+  {
+    size_t         new_size = source_elements.size() * stride;
+    std::uint64_t* new_data = accelerator::make_host_array<std::uint64_t>(num_words * new_size, num_words);
+    for (size_t k = 0; k < num_words; k++) {
+      for (size_t i = 0; i < source_elements.size(); i++) {
+        const std::uint64_t* source = data + k * size + source_elements[i] * stride;
+        std::copy(source, source + stride, new_data + k * new_size + i * stride);
+      }
+    }
+
+    accelerator::destroy_host_array(data, num_words * size);
+    data = new_data;
+
+    if (tentative) {
+      accelerator::destroy_host_array(tentative, num_words * size);
+      tentative = accelerator::make_host_array<std::uint64_t>(num_words * new_size, num_words);
+      std::copy(data, data + num_words * new_size, tentative);
+    }
+    size = new_size;
+    account();
+    updates_pending = false;
+  }
+
+  /// the committed quadrature data as raw memory, see QuadratureData::bytes()
+  std::pair<void*, size_t> bytes() { return {data, sizeof(std::uint64_t) * num_words * size}; }
+
+  /// update the memory accounted to the quadrature data, after (re)allocating the buffers
+  void account() { tracker.set(sizeof(std::uint64_t) * num_words * size * (tentative ? 2 : 1)); }
+
+  std::uint64_t* data;                    ///< pointer to the buffer of quadrature data, one word of T after the other
+  std::uint64_t* tentative{nullptr};      ///< pointer to the buffer of tentative updates, if enabled
+  size_t         stride;                  ///< how many quadrature points per element
+  size_t         size;                    ///< how many quadrature points in total
+  bool           updates_pending{false};  ///< whether the tentative buffer holds updates that have not been committed
+
+  /// the accounting of the buffers, see memory::usage()
+  memory::Tracker tracker{memory::Subsystem::QuadratureData};
+};
+
 extern std::shared_ptr<QuadratureData<Nothing> > NoQData;
 extern std::shared_ptr<QuadratureData<Empty> >   EmptyQData;
 
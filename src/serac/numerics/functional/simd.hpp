@@ -0,0 +1,265 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file simd.hpp
+ *
+ * @brief This file contains the declaration of a fixed-width pack of scalars with elementwise arithmetic
+ */
+
+#pragma once
+
+#include <cmath>
+#include <type_traits>
+#include <utility>
+
+#include "serac/infrastructure/accelerator.hpp"
+
+namespace serac {
+
+/**
+ * @brief a pack of W values of type T ("lanes") with elementwise arithmetic and math functions
+ *
+ * Each operation is a loop over the lanes with a compile-time trip count, which compilers reliably turn into
+ * vector instructions (e.g. W = 4 doubles per AVX2 register, or W = 8 for AVX-512). So, code written for scalars
+ * (like a q-function) that is instead evaluated on `simd` values computes W independent results at once.
+ *
+ * @note there are intentionally no comparison operators, since a branch can't take different directions for
+ * different lanes. Conditional logic can be expressed with the elementwise max() and min() functions instead.
+ *
+ * @tparam T the type of each lane
+ * @tparam W the number of lanes
+ */
+template <typename T, int W>
+struct simd {
+  static_assert(W > 0, "simd must have at least one lane");
+
+  using value_type = T;  ///< the type of each lane
+
+  /// @brief default ctor, zero-initializing each lane
+  SERAC_HOST_DEVICE constexpr simd() : lanes{} {}
+
+  /// @brief broadcast a scalar value to every lane
+  SERAC_HOST_DEVICE constexpr simd(T value) : lanes{}
+  {
+    for (int i = 0; i < W; i++) {
+      lanes[i] = value;
+    }
+  }
+
+  /// @brief access the value of lane i
+  SERAC_HOST_DEVICE constexpr T& operator[](int i) { return lanes[i]; }
+
+  /// @overload
+  SERAC_HOST_DEVICE constexpr const T& operator[](int i) const { return lanes[i]; }
+
+  T lanes[W];  ///< the value of each lane
+};
+
+/** @brief class for checking if a type is a simd pack or not */
+template <typename T>
+struct is_simd {
+  static constexpr bool value = false;  ///< whether or not type T is a simd pack
+};
+
+/** @brief class for checking if a type is a simd pack or not */
+template <typename T, int W>
+struct is_simd<simd<T, W> > {
+  static constexpr bool value = true;  ///< whether or not type T is a simd pack
+};
+
+namespace detail {
+
+/// @brief whether S is an arithmetic type other than T, see simd_binary_operator_overload
+template <typename S, typename T>
+inline constexpr bool is_other_arithmetic_v = std::is_arithmetic_v<S> && !std::is_same_v<S, T>;
+
+}  // namespace detail
+
+/**
+ * @brief Generates the elementwise overloads (simd-simd, simd-scalar, scalar-simd) of a binary arithmetic operator,
+ * and its compound assignment counterpart
+ *
+ * The lanes of the two operands may have different types (e.g. a pack of dual numbers and a pack of doubles),
+ * in which case the lanes of the result have the type of the corresponding scalar expression. Likewise, packs
+ * can be combined with numbers of an arithmetic type other than that of their lanes.
+ *
+ * @param[in] x The arithmetic operator to overload
+ * @param[in] y The corresponding compound assignment operator
+ */
+#define simd_binary_operator_overload(x, y)                                                                    \
+  template <typename T, typename U, int W>                                                                     \
+  SERAC_HOST_DEVICE constexpr auto operator x(const simd<T, W>& a, const simd<U, W>& b)                        \
+  {                                                                                                            \
+    simd<decltype(std::declval<T>() x std::declval<U>()), W> c{};                                              \
+    for (int i = 0; i < W; i++) {                                                                              \
+      c.lanes[i] = a.lanes[i] x b.lanes[i];                                                                    \
+    }                                                                                                          \
+    return c;                                                                                                  \
+  }                                                                                                            \
+                                                                                                               \
+  template <typename T, int W>                                                                                 \
+  SERAC_HOST_DEVICE constexpr auto operator x(const simd<T, W>& a, typename simd<T, W>::value_type b)          \
+  {                                                                                                            \
+    simd<T, W> c{};                                                                                            \
+    for (int i = 0; i < W; i++) {                                                                              \
+      c.lanes[i] = a.lanes[i] x b;                                                                             \
+    }                                                                                                          \
+    return c;                                                                                                  \
+  }                                                                                                            \
+                                                                                                               \
+  template <typename T, int W>                                                                                 \
+  SERAC_HOST_DEVICE constexpr auto operator x(typename simd<T, W>::value_type a, const simd<T, W>& b)          \
+  {                                                                                                            \
+    simd<T, W> c{};                                                                                            \
+    for (int i = 0; i < W; i++) {                                                                              \
+      c.lanes[i] = a x b.lanes[i];                                                                             \
+    }                                                                                                          \
+    return c;                                                                                                  \
+  }                                                                                                            \
+                                                                                                               \
+  template <typename T, int W, typename S, typename = std::enable_if_t<detail::is_other_arithmetic_v<S, T> > > \
+  SERAC_HOST_DEVICE constexpr auto operator x(const simd<T, W>& a, S b)                                        \
+  {                                                                                                            \
+    simd<decltype(std::declval<T>() x b), W> c{};                                                              \
+    for (int i = 0; i < W; i++) {                                                                              \
+      c.lanes[i] = a.lanes[i] x b;                                                                             \
+    }                                                                                                          \
+    return c;                                                                                                  \
+  }                                                                                                            \
+                                                                                                               \
+  template <typename S, typename T, int W, typename = std::enable_if_t<detail::is_other_arithmetic_v<S, T> > > \
+  SERAC_HOST_DEVICE constexpr auto operator x(S a, const simd<T, W>& b)                                        \
+  {                                                                                                            \
+    simd<decltype(a x std::declval<T>()), W> c{};                                                              \
+    for (int i = 0; i < W; i++) {                                                                              \
+      c.lanes[i] = a x b.lanes[i];                                                                             \
+    }                                                                                                          \
+    return c;                                                                                                  \
+  }                                                                                                            \
+                                                                                                               \
+  template <typename T, typename U, int W>                                                                     \
+  SERAC_HOST_DEVICE constexpr auto& operator y(simd<T, W>& a, const simd<U, W>& b)                             \
+  {                                                                                                            \
+    for (int i = 0; i < W; i++) {                                                                              \
+      a.lanes[i] = a.lanes[i] x b.lanes[i];                                                                    \
+    }                                                                                                          \
+    return a;                                                                                                  \
+  }                                                                                                            \
+                                                                                                               \
+  template <typename T, int W>                                                                                 \
+  SERAC_HOST_DEVICE constexpr auto& operator y(simd<T, W>& a, typename simd<T, W>::value_type b)               \
+  {                                                                                                            \
+    for (int i = 0; i < W; i++) {                                                                              \
+      a.lanes[i] = a.lanes[i] x b;                                                                             \
+    }                                                                                                          \
+    return a;                                                                                                  \
+  }                                                                                                            \
+                                                                                                               \
+  template <typename T, int W, typename S, typename = std::enable_if_t<detail::is_other_arithmetic_v<S, T> > > \
+  SERAC_HOST_DEVICE constexpr auto& operator y(simd<T, W>& a, S b)                                             \
+  {                                                                                                            \
+    for (int i = 0; i < W; i++) {                                                                              \
+      a.lanes[i] = a.lanes[i] x b;                                                                             \
+    }                                                                                                          \
+    return a;                                                                                                  \
+  }
+
+simd_binary_operator_overload(+, +=);  ///< implement operator+ for simd packs
+simd_binary_operator_overload(-, -=);  ///< implement operator- for simd packs
+simd_binary_operator_overload(*, *=);  ///< implement operator* for simd packs
+simd_binary_operator_overload(/, /=);  ///< implement operator/ for simd packs
+
+#undef simd_binary_operator_overload
+
+/** @brief unary negation of a simd pack */
+template <typename T, int W>
+SERAC_HOST_DEVICE constexpr auto operator-(const simd<T, W>& a)
+{
+  simd<T, W> b{};
+  for (int i = 0; i < W; i++) {
+    b.lanes[i] = -a.lanes[i];
+  }
+  return b;
+}
+
+/**
+ * @brief Generates the elementwise overload of a unary math function
+ * @param[in] f The math function to overload
+ */
+#define simd_unary_function_overload(f)         \
+  template <typename T, int W>                  \
+  SERAC_HOST_DEVICE auto f(const simd<T, W>& a) \
+  {                                             \
+    using std::f;                               \
+    simd<T, W> b{};                             \
+    for (int i = 0; i < W; i++) {               \
+      b.lanes[i] = f(a.lanes[i]);               \
+    }                                           \
+    return b;                                   \
+  }
+
+simd_unary_function_overload(abs);   ///< implement abs() for simd packs
+simd_unary_function_overload(sqrt);  ///< implement sqrt() for simd packs
+simd_unary_function_overload(cbrt);  ///< implement cbrt() for simd packs
+simd_unary_function_overload(exp);   ///< implement exp() for simd packs
+simd_unary_function_overload(log);   ///< implement log() for simd packs
+simd_unary_function_overload(sin);   ///< implement sin() for simd packs
+simd_unary_function_overload(cos);   ///< implement cos() for simd packs
+simd_unary_function_overload(tan);   ///< implement tan() for simd packs
+simd_unary_function_overload(asin);  ///< implement asin() for simd packs
+simd_unary_function_overload(acos);  ///< implement acos() for simd packs
+simd_unary_function_overload(atan);  ///< implement atan() for simd packs
+
+#undef simd_unary_function_overload
+
+/**
+ * @brief Generates the elementwise overloads (simd-simd, simd-scalar, scalar-simd) of a binary math function
+ * @param[in] f The math function to overload
+ * @param[in] g The scalar function used to evaluate each lane
+ */
+#define simd_binary_function_overload(f, g)                                        \
+  template <typename T, int W>                                                     \
+  SERAC_HOST_DEVICE auto f(const simd<T, W>& a, const simd<T, W>& b)               \
+  {                                                                                \
+    using std::g;                                                                  \
+    simd<T, W> c{};                                                                \
+    for (int i = 0; i < W; i++) {                                                  \
+      c.lanes[i] = g(a.lanes[i], b.lanes[i]);                                      \
+    }                                                                              \
+    return c;                                                                      \
+  }                                                                                \
+                                                                                   \
+  template <typename T, int W>                                                     \
+  SERAC_HOST_DEVICE auto f(const simd<T, W>& a, typename simd<T, W>::value_type b) \
+  {                                                                                \
+    using std::g;                                                                  \
+    simd<T, W> c{};                                                                \
+    for (int i = 0; i < W; i++) {                                                  \
+      c.lanes[i] = g(a.lanes[i], b);                                               \
+    }                                                                              \
+    return c;                                                                      \
+  }                                                                                \
+                                                                                   \
+  template <typename T, int W>                                                     \
+  SERAC_HOST_DEVICE auto f(typename simd<T, W>::value_type a, const simd<T, W>& b) \
+  {                                                                                \
+    using std::g;                                                                  \
+    simd<T, W> c{};                                                                \
+    for (int i = 0; i < W; i++) {                                                  \
+      c.lanes[i] = g(a, b.lanes[i]);                                               \
+    }                                                                              \
+    return c;                                                                      \
+  }
+
+simd_binary_function_overload(pow, pow);      ///< implement pow() for simd packs
+simd_binary_function_overload(atan2, atan2);  ///< implement atan2() for simd packs
+simd_binary_function_overload(max, fmax);     ///< implement (elementwise) max() for simd packs
+simd_binary_function_overload(min, fmin);     ///< implement (elementwise) min() for simd packs
+
+#undef simd_binary_function_overload
+
+}  // namespace serac
@@ -0,0 +1,202 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file simd_element_batching.hpp
+ *
+ * @brief an option for evaluating a q-function on several elements at once, with each element in a separate lane
+ * of a serac::simd pack
+ */
+
+#pragma once
+
+#include <type_traits>
+#include <utility>
+
+#include "serac/infrastructure/accelerator.hpp"
+#include "serac/numerics/functional/simd.hpp"
+#include "serac/numerics/functional/tuple.hpp"
+#include "serac/numerics/functional/tensor.hpp"
+
+namespace serac {
+
+/**
+ * @brief a wrapper around a q-function that tells Functional to evaluate it on W elements at a time
+ *
+ * By default, q-functions are evaluated one quadrature point at a time, on `double` values. For q-functions wrapped
+ * in this type, residual evaluations of domain integrals instead gather the inputs at a given quadrature point of W
+ * consecutive elements into `simd<double, W>` values (one element per lane), and evaluate the q-function on those,
+ * so that its arithmetic is carried out with vector instructions.
+ *
+ * @note the q-function must be generic (i.e. accept its arguments as `auto`) and must not branch on its inputs,
+ * since all of the lanes follow the same path through the code (see serac::simd)
+ *
+ * @note this only applies to residual evaluations (no derivatives) of domain integrals without quadrature point data
+ * on the CPU, everything else evaluates the q-function one quadrature point at a time, as usual
+ *
+ * @tparam W how many elements to evaluate at once (e.g. 4 for AVX2, 8 for AVX-512)
+ * @tparam lambda the type of the q-function being wrapped
+ */
+template <int W, typename lambda>
+struct SimdElementBatching {
+  static_assert(W > 0, "the number of elements per batch must be positive");
+
+  lambda qf;  ///< the q-function
+
+  /// @brief evaluate the underlying q-function
+  template <typename... T>
+  SERAC_HOST_DEVICE auto operator()(T&&... args) const
+  {
+    return qf(std::forward<T>(args)...);
+  }
+};
+
+/**
+ * @brief convenience function for opting in to evaluating a given q-function on several elements at once, e.g.
+ *
+ * @code{.cpp}
+ * residual.AddDomainIntegral(Dimension<3>{}, DependsOn<0>{}, with_simd_element_batching<4>(qf), mesh);
+ * @endcode
+ *
+ * @tparam W how many elements to evaluate at once
+ * @param qf the q-function
+ */
+template <int W, typename lambda>
+auto with_simd_element_batching(lambda&& qf)
+{
+  return SimdElementBatching<W, std::decay_t<lambda>>{std::forward<lambda>(qf)};
+}
+
+namespace detail {
+
+/// @brief a trait for the number of elements that a q-function is evaluated on at a time
+template <typename T>
+struct simd_width {
+  static constexpr int value = 1;  ///< the number of elements per evaluation
+};
+
+/// @overload
+template <int W, typename lambda>
+struct simd_width<SimdElementBatching<W, lambda>> {
+  static constexpr int value = W;  ///< the number of elements per evaluation
+};
+
+/// @brief the type obtained by replacing each double in T by a simd<double, W>
+template <typename T, int W>
+struct simd_type {
+  using type = T;  ///< the type with simd values
+};
+
+/// @overload
+template <int W>
+struct simd_type<double, W> {
+  using type = simd<double, W>;  ///< the type with simd values
+};
+
+/// @overload
+template <typename T, int W, int... n>
+struct simd_type<tensor<T, n...>, W> {
+  using type = tensor<typename simd_type<T, W>::type, n...>;  ///< the type with simd values
+};
+
+/// @overload
+template <typename... T, int W>
+struct simd_type<tuple<T...>, W> {
+  using type = tuple<typename simd_type<T, W>::type...>;  ///< the type with simd values
+};
+
+/// @brief helper alias for @p simd_type
+template <typename T, int W>
+using simd_type_t = typename simd_type<T, W>::type;
+
+/**
+ * @brief write a value into one lane of its simd counterpart
+ * @param from the value to write
+ * @param to the simd value to write into
+ * @param lane which lane to write
+ */
+template <int W>
+SERAC_HOST_DEVICE void pack_lane(const double& from, simd<double, W>& to, int lane)
+{
+  to[lane] = from;
+}
+
+/// @overload
+template <typename S, typename T, int m, int... n>
+SERAC_HOST_DEVICE void pack_lane(const tensor<S, m, n...>& from, tensor<T, m, n...>& to, int lane)
+{
+  for (int i = 0; i < m; i++) {
+    pack_lane(from[i], to[i], lane);
+  }
+}
+
+/// @overload
+template <typename... S, typename... T, int... i>
+SERAC_HOST_DEVICE void pack_lane(const tuple<S...>& from, tuple<T...>& to, int lane, std::integer_sequence<int, i...>)
+{
+  (pack_lane(get<i>(from), get<i>(to), lane), ...);
+}
+
+/// @overload
+template <typename... S, typename... T>
+SERAC_HOST_DEVICE void pack_lane(const tuple<S...>& from, tuple<T...>& to, int lane)
+{
+  static_assert(sizeof...(S) == sizeof...(T));
+  pack_lane(from, to, lane, std::make_integer_sequence<int, int(sizeof...(S))>{});
+}
+
+/// @overload
+SERAC_HOST_DEVICE inline void pack_lane(zero, zero, int) {}
+
+/**
+ * @brief read one lane of a simd value into its scalar counterpart
+ * @param from the simd value to read
+ * @param to the value to write into
+ * @param lane which lane to read
+ *
+ * @note `from` may also be an ordinary value (e.g. a constant returned by the q-function), in which case it is
+ * the same for every lane
+ */
+template <int W>
+SERAC_HOST_DEVICE void unpack_lane(const simd<double, W>& from, double& to, int lane)
+{
+  to = from[lane];
+}
+
+/// @overload
+SERAC_HOST_DEVICE inline void unpack_lane(const double& from, double& to, int) { to = from; }
+
+/// @overload
+SERAC_HOST_DEVICE inline void unpack_lane(zero, zero, int) {}
+
+/// @overload
+template <typename S, typename T, int m, int... n>
+SERAC_HOST_DEVICE void unpack_lane(const tensor<S, m, n...>& from, tensor<T, m, n...>& to, int lane)
+{
+  for (int i = 0; i < m; i++) {
+    unpack_lane(from[i], to[i], lane);
+  }
+}
+
+/// @overload
+template <typename... S, typename... T, int... i>
+SERAC_HOST_DEVICE void unpack_lane(const tuple<S...>& from, tuple<T...>& to, int lane,
+                                   std::integer_sequence<int, i...>)
+{
+  (unpack_lane(get<i>(from), get<i>(to), lane), ...);
+}
+
+/// @overload
+template <typename... S, typename... T>
+SERAC_HOST_DEVICE void unpack_lane(const tuple<S...>& from, tuple<T...>& to, int lane)
+{
+  static_assert(sizeof...(S) == sizeof...(T));
+  unpack_lane(from, to, lane, std::make_integer_sequence<int, int(sizeof...(S))>{});
+}
+
+}  // namespace detail
+
+}  // namespace serac
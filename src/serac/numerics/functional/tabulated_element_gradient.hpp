@@ -0,0 +1,214 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file tabulated_element_gradient.hpp
+ *
+ * @brief element gradient matrices of domain integrals, formed as B^T D B from tabulated basis matrices
+ */
+
+#pragma once
+
+#include "serac/infrastructure/accelerator.hpp"
+#include "serac/numerics/functional/tuple.hpp"
+#include "serac/numerics/functional/tensor.hpp"
+#include "serac/numerics/functional/finite_element.hpp"
+
+namespace serac {
+
+namespace detail {
+
+/**
+ * @brief whether the element matrices of a domain integral are formed as B^T D B (see tabulated_element_gradient()),
+ * rather than one trial basis function at a time with sum factorization
+ *
+ * For tensor product elements of order 2 or higher, the element matrices are large enough that forming them as dense
+ * products of the tabulated basis functions (and their gradients) at the quadrature points, which is compute-bound,
+ * is faster than the sum-factorized integration of each of their rows, which is bound by the memory traffic of its
+ * many passes over small temporaries.
+ *
+ * @tparam g the element geometry
+ * @tparam test the test space
+ * @tparam trial the trial space
+ */
+template <mfem::Geometry::Type g, typename test, typename trial>
+constexpr bool uses_tabulated_element_gradient()
+{
+  if constexpr (g != mfem::Geometry::SQUARE && g != mfem::Geometry::CUBE) {
+    return false;
+  } else if constexpr ((test::family != Family::H1 && test::family != Family::L2) ||
+                       (trial::family != Family::H1 && trial::family != Family::L2)) {
+    return false;
+  } else {
+    return test::order >= 2 && trial::order >= 2;
+  }
+}
+
+/**
+ * @brief the values and parent-space gradients of each basis function of a tensor product element at the quadrature
+ * points: B(Q, 0, j) is the value of basis function j at quadrature point Q, and B(Q, 1 + k, j) its derivative in
+ * direction k
+ *
+ * @tparam element_type the finite element
+ * @tparam q the number of quadrature points in each direction
+ * @tparam apply_weights whether to multiply the entries of each quadrature point by its weight
+ */
+template <typename element_type, int q, bool apply_weights>
+constexpr auto tabulate_basis()
+{
+  constexpr int dim   = element_type::dim;
+  constexpr int n     = element_type::n;
+  constexpr int nqpts = (dim == 2) ? q * q : q * q * q;
+
+  constexpr auto B = element_type::template calculate_B<apply_weights, q>();
+  constexpr auto G = element_type::template calculate_G<apply_weights, q>();
+
+  tensor<double, nqpts, dim + 1, element_type::ndof> table{};
+  for (int Q = 0; Q < nqpts; Q++) {
+    int qx = Q % q;
+    int qy = (Q / q) % q;
+    int qz = Q / (q * q);
+    for (int j = 0; j < element_type::ndof; j++) {
+      int jx = j % n;
+      int jy = (j / n) % n;
+      int jz = j / (n * n);
+      if constexpr (dim == 2) {
+        table(Q, 0, j) = B(qx, jx) * B(qy, jy);
+        table(Q, 1, j) = G(qx, jx) * B(qy, jy);
+        table(Q, 2, j) = B(qx, jx) * G(qy, jy);
+      } else {
+        table(Q, 0, j) = B(qx, jx) * B(qy, jy) * B(qz, jz);
+        table(Q, 1, j) = G(qx, jx) * B(qy, jy) * B(qz, jz);
+        table(Q, 2, j) = B(qx, jx) * G(qy, jy) * B(qz, jz);
+        table(Q, 3, j) = B(qx, jx) * B(qy, jy) * G(qz, jz);
+      }
+    }
+  }
+  return table;
+}
+
+/**
+ * @brief copies one block of the q-function derivatives at a quadrature point into the matrix D of
+ * flatten_derivatives()
+ *
+ * @tparam ct the number of test space components
+ * @tparam cr the number of trial space components
+ * @tparam rows the number of rows of the block for each test component (1 for the source, dim for the flux)
+ * @tparam cols the number of columns of the block for each trial component (1 for the value, dim for the gradient)
+ * @param D the matrix to copy into
+ * @param block the derivatives of the source or flux w.r.t. the value or gradient, with the layout of
+ * tensor<double, ct, rows, cr, cols> (with the dimensions of size 1 omitted)
+ * @param row_offset the row of D of the first row of the block (for each test component)
+ * @param col_offset the column of D of the first column of the block (for each trial component)
+ */
+template <int ct, int cr, int rows, int cols, int dim, typename block_type>
+SERAC_HOST_DEVICE void copy_derivative_block(tensor<double, ct * (dim + 1), cr * (dim + 1)>& D,
+                                             const block_type& block, int row_offset, int col_offset)
+{
+  if constexpr (!is_zero<block_type>{}) {
+    static_assert(sizeof(block_type) == sizeof(double) * ct * rows * cr * cols,
+                  "unexpected layout of the q-function derivatives");
+    const double* values = reinterpret_cast<const double*>(&block);
+    for (int i = 0; i < ct; i++) {
+      for (int a = 0; a < rows; a++) {
+        for (int j = 0; j < cr; j++) {
+          for (int b = 0; b < cols; b++) {
+            D(i * (dim + 1) + row_offset + a, j * (dim + 1) + col_offset + b) =
+                values[((i * rows + a) * cr + j) * cols + b];
+          }
+        }
+      }
+    }
+  }
+}
+
+/**
+ * @brief the derivatives of the (source, flux) of a q-function w.r.t. its (value, gradient) input at a quadrature
+ * point, as a matrix D with a row for each (test component, source or flux direction) and a column for each
+ * (trial component, value or gradient direction)
+ *
+ * @tparam ct the number of test space components
+ * @tparam cr the number of trial space components
+ * @tparam dim the dimension of the element
+ * @param derivatives the (dense) derivatives
+ */
+template <int ct, int cr, int dim, typename derivatives_type>
+SERAC_HOST_DEVICE auto flatten_derivatives(const derivatives_type& derivatives)
+{
+  tensor<double, ct * (dim + 1), cr * (dim + 1)> D{};
+  copy_derivative_block<ct, cr, 1, 1, dim>(D, get<0>(get<0>(derivatives)), 0, 0);
+  copy_derivative_block<ct, cr, 1, dim, dim>(D, get<1>(get<0>(derivatives)), 0, 1);
+  copy_derivative_block<ct, cr, dim, 1, dim>(D, get<0>(get<1>(derivatives)), 1, 0);
+  copy_derivative_block<ct, cr, dim, dim, dim>(D, get<1>(get<1>(derivatives)), 1, 1);
+  return D;
+}
+
+/**
+ * @brief accumulates the element gradient matrix of one element, K += sum_Q B_test(Q)^T D(Q) B_trial(Q)
+ *
+ * At each quadrature point, the derivatives are first applied to the tabulated trial basis matrix, W = D B_trial,
+ * and the result is then multiplied by the (weighted) tabulated test basis matrix, with loops over contiguous rows
+ * of B_test and K that the compiler vectorizes, i.e. a small dense GEMM for each quadrature point of the element.
+ *
+ * @tparam Q the number of quadrature points in each direction
+ * @tparam g the element geometry
+ * @tparam test the test space
+ * @tparam trial the trial space
+ * @param K_e the element matrix, K_e(trial dof, test dof) in the component-major ordering of the element dofs
+ * @param derivatives the (dense) derivatives of the q-function at each quadrature point of the element
+ */
+template <int Q, mfem::Geometry::Type g, typename test, typename trial, int nquad, typename derivatives_type>
+SERAC_HOST_DEVICE void tabulated_element_gradient(double* K_e, const tensor<derivatives_type, nquad>& derivatives)
+{
+  using test_element  = finite_element<g, test>;
+  using trial_element = finite_element<g, trial>;
+
+  constexpr int dim         = test_element::dim;
+  constexpr int m           = dim + 1;
+  constexpr int ct          = test_element::components;
+  constexpr int cr          = trial_element::components;
+  constexpr int nt          = test_element::ndof;
+  constexpr int nr          = trial_element::ndof;
+  constexpr int test_vdofs  = ct * nt;
+  constexpr int trial_vdofs = cr * nr;
+
+  static constexpr auto B_test  = tabulate_basis<test_element, Q, true>();
+  static constexpr auto B_trial = tabulate_basis<trial_element, Q, false>();
+
+  for (int q = 0; q < nquad; q++) {
+    auto D = flatten_derivatives<ct, cr, dim>(derivatives[q]);
+
+    // W(a, (cj, j)) = D(a, (cj, b)) * B_trial(q, b, j)
+    tensor<double, ct * m, trial_vdofs> W{};
+    for (int a = 0; a < ct * m; a++) {
+      for (int cj = 0; cj < cr; cj++) {
+        for (int b = 0; b < m; b++) {
+          double d = D(a, cj * m + b);
+          for (int j = 0; j < nr; j++) {
+            W(a, cj * nr + j) += d * B_trial(q, b, j);
+          }
+        }
+      }
+    }
+
+    // K((cj, j), (ci, i)) += W((ci, a), (cj, j)) * B_test(q, a, i)
+    for (int r = 0; r < trial_vdofs; r++) {
+      double* K_row = K_e + r * test_vdofs;
+      for (int ci = 0; ci < ct; ci++) {
+        for (int a = 0; a < m; a++) {
+          double w = W(ci * m + a, r);
+          for (int i = 0; i < nt; i++) {
+            K_row[ci * nt + i] += w * B_test(q, a, i);
+          }
+        }
+      }
+    }
+  }
+}
+
+}  // namespace detail
+
+}  // namespace serac
@@ -919,7 +919,7 @@ auto cross(const tensor<T, 2>& v)
 
 /// compute the (right handed) cross product of two 3-vectors
 template <typename S, typename T>
-auto cross(const tensor<S, 3>& u, const tensor<T, 3>& v)
+SERAC_HOST_DEVICE auto cross(const tensor<S, 3>& u, const tensor<T, 3>& v)
 {
   return tensor<decltype(S{} * T{}), 3>{u(1) * v(2) - u(2) * v(1), u(2) * v(0) - u(0) * v(2),
                                         u(0) * v(1) - u(1) * v(0)};
@@ -1236,6 +1236,22 @@ auto matrix_sqrt(const tensor<T, dim, dim>& A)
   return B;
 }
 
+/**
+ * @overload
+ * @note 2x2 matrices use the closed form sqrt(A) = (A + sqrt(det(A)) I) / sqrt(tr(A) + 2 sqrt(det(A))),
+ * which is differentiable with dual numbers and usable on the GPU
+ */
+template <typename T>
+SERAC_HOST_DEVICE auto matrix_sqrt(const tensor<T, 2, 2>& A)
+{
+  using std::sqrt;
+  auto sqrt_det = sqrt(det(A));
+  auto B        = A;
+  B[0][0] += sqrt_det;
+  B[1][1] += sqrt_det;
+  return B / sqrt(tr(A) + 2.0 * sqrt_det);
+}
+
 /**
  * @brief a convenience function that computes a dot product between
  * two tensor, but that allows the user to specify which indices should
@@ -1814,6 +1830,40 @@ SERAC_HOST_DEVICE constexpr int size(const double&) { return 1; }
 /// @overload
 SERAC_HOST_DEVICE constexpr int size(zero) { return 0; }
 
+/**
+ * @brief the transpose of chain_rule(): given the derivative of a function f(x) and a small change in its output,
+ * df, returns the small change in its input, dx, that satisfies
+ *
+ *    inner(df, chain_rule(df_dx, y)) == inner(dx, y)   for every y
+ *
+ * @tparam x_type the type of the input of f (which can't be deduced from df_dx alone)
+ * @param df_dx the derivative of f, with the indices of f before those of x
+ * @param df the small change in the output of f
+ */
+template <typename x_type, typename S, typename T>
+SERAC_HOST_DEVICE auto chain_rule_transpose(const S& df_dx, const T& df)
+{
+  if constexpr (is_zero<S>{} || is_zero<T>{}) {
+    return zero{};
+  } else {
+    constexpr int m = size(T{});
+    constexpr int n = size(x_type{});
+    static_assert(size(S{}) == m * n, "df_dx must hold the derivative of each output of f w.r.t. each input");
+
+    auto D = reinterpret_cast<const double*>(&df_dx);
+    auto y = reinterpret_cast<const double*>(&df);
+
+    x_type dx{};
+    auto   x = reinterpret_cast<double*>(&dx);
+    for (int i = 0; i < m; i++) {
+      for (int j = 0; j < n; j++) {
+        x[j] += y[i] * D[i * n + j];
+      }
+    }
+    return dx;
+  }
+}
+
 /**
  * @brief a function for querying the ith dimension of a tensor
  *
@@ -1859,125 +1909,6 @@ inline bool isnan(const zero&) { return false; }
 
 // todo: port to current tensor class:
 #if 0
-// eigendecomposition for symmetric A
-//
-// based on "A robust algorithm for finding the eigenvalues and
-// eigenvectors of 3x3 symmetric matrices", by Scherzinger & Dohrmann
-__host__ __device__
-inline void eig(const r2tensor < 3, 3 > & A,
-                      r1tensor < 3 >    & eta,
-                      r2tensor < 3, 3 > & Q) {
-
-  for (int i = 0; i < 3; i++) {
-    eta(i) = 1.0;
-    for (int j = 0; j < 3; j++) {
-      Q(i,j) = (i == j);
-    }
-  }
-
-  auto A_dev = dev(A);
-
-  double J2 = I2(A_dev);
-  double J3 = I3(A_dev);
-
-  if (J2 > 0.0) {
-
-    // angle used to find eigenvalues
-    double tmp = (0.5 * J3) * pow(3.0 / J2, 1.5);
-    double alpha = acos(fmin(fmax(tmp, -1.0), 1.0)) / 3.0;
-
-    // consider the most distinct eigenvalue first
-    if (6.0 * alpha < M_PI) {
-      eta(0) = 2 * sqrt(J2 / 3.0) * cos(alpha);
-    } else {
-      eta(0) = 2 * sqrt(J2 / 3.0) * cos(alpha + 2.0 * M_PI / 3.0);
-    }
-
-    // find the eigenvector for that eigenvalue
-    r1tensor < 3 > r[3];
-
-    int imax = -1;
-    double norm_max = -1.0;
-
-    for (int i = 0; i < 3; i++) {
-
-      for (int j = 0; j < 3; j++) {
-        r[i](j) = A_dev(j,i) - (i == j) * eta(0);
-      }
-
-      double norm_r = norm(r[i]);
-      if (norm_max < norm_r) {
-        imax = i;
-        norm_max = norm_r;
-      }
-
-    }
-
-    r1tensor < 3 > s0, s1, t1, t2, v0, v1, v2, w;
-
-    s0 = normalize(r[imax]);
-    t1 = r[(imax+1)%3] - dot(r[(imax+1)%3], s0) * s0;
-    t2 = r[(imax+2)%3] - dot(r[(imax+2)%3], s0) * s0;
-    s1 = normalize((norm(t1) > norm(t2)) ? t1 : t2);
-
-    // record the first eigenvector
-    v0 = cross(s0, s1);
-    for (int i = 0; i < 3; i++) {
-      Q(i,0) = v0(i);
-    }
-
-    // get the other two eigenvalues by solving the
-    // remaining quadratic characteristic polynomial
-    auto A_dev_s0 = dot(A_dev, s0);
-    auto A_dev_s1 = dot(A_dev, s1);
-
-    double A11 = dot(s0, A_dev_s0);
-    double A12 = dot(s0, A_dev_s1);
-    double A21 = dot(s1, A_dev_s0);
-    double A22 = dot(s1, A_dev_s1);
-
-    double delta = 0.5 * signum(A11-A22) * sqrt((A11-A22)*(A11-A22) + 4*A12*A21);
-
-    eta(1) = 0.5 * (A11 + A22) - delta;
-    eta(2) = 0.5 * (A11 + A22) + delta;
-
-    // if the remaining eigenvalues are exactly the same
-    // then just use the basis for the orthogonal complement
-    // found earlier
-    if (fabs(delta) <= 1.0e-15) {
-      
-      for (int i = 0; i < 3; i++){
-        Q(i,1) = s0(i);
-        Q(i,2) = s1(i);
-      } 
-      
-    // otherwise compute the remaining eigenvectors
-    } else {
-
-      t1 = A_dev_s0 - eta(1) * s0;
-      t2 = A_dev_s1 - eta(1) * s1;
-
-      w = normalize((norm(t1) > norm(t2)) ? t1 : t2);
-
-      v1 = normalize(cross(w, v0));
-      for (int i = 0; i < 3; i++) Q(i,1) = v1(i);
-
-      // define the last eigenvector as
-      // the direction perpendicular to the
-      // first two directions
-      v2 = normalize(cross(v0, v1));
-      for (int i = 0; i < 3; i++) Q(i,2) = v2(i);
-
-    }
-
-    // eta are actually eigenvalues of A_dev, so
-    // shift them to get eigenvalues of A
-    eta += tr(A) / 3.0;
-
-  }
-
-}
-
 inline float angle_between(const vec < 2 > & a, const vec < 2 > & b) {
   return acos(clip(dot(normalize(a), normalize(b)), -1.0f, 1.0f));
 }
@@ -0,0 +1,326 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file benchmark_finite_element_kernels.cpp
+ *
+ * @brief compares the sum-factorized interpolate/integrate kernels for H1 quadrilaterals and hexahedra
+ * against a reference implementation that applies the full (p+1)^dim x q^dim table of shape functions
+ */
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "serac/numerics/functional/tensor.hpp"
+#include "serac/numerics/functional/finite_element.hpp"
+
+using namespace serac;
+
+static constexpr int num_elements = 1000;
+
+/// @brief the number of quadrature points in a tensor-product rule with q points per dimension
+template <mfem::Geometry::Type g, int q>
+constexpr int num_qpts = (g == mfem::Geometry::CUBE) ? q * q * q : q * q;
+
+/**
+ * @brief flop count for interpolating values and gradients (or integrating sources and fluxes)
+ * of a single component on one element, by applying the full table of shape functions
+ */
+template <mfem::Geometry::Type g>
+constexpr double full_product_flops(int n, int q)
+{
+  constexpr int dim = (g == mfem::Geometry::CUBE) ? 3 : 2;
+  double        nd  = (dim == 3) ? n * n * n : n * n;
+  double        qd  = (dim == 3) ? q * q * q : q * q;
+  return 2.0 * (dim + 1) * nd * qd;
+}
+
+/**
+ * @brief flop count for interpolating values and gradients (or integrating sources and fluxes)
+ * of a single component on one element, by contracting the 1D tables one dimension at a time
+ */
+template <mfem::Geometry::Type g>
+constexpr double sum_factorized_flops(int n, int q)
+{
+  if constexpr (g == mfem::Geometry::CUBE) {
+    return 2.0 * (4.0 * n * q * q * q + 3.0 * n * n * q * q + 2.0 * n * n * n * q);
+  } else {
+    return 2.0 * (3.0 * n * q * q + 2.0 * n * n * q);
+  }
+}
+
+/// @brief the parent-space coordinates of each quadrature point, in the same order used by the kernels
+template <mfem::Geometry::Type g, int q>
+auto quadrature_points()
+{
+  constexpr int  dim      = (g == mfem::Geometry::CUBE) ? 3 : 2;
+  constexpr auto points1D = GaussLegendreNodes<q, mfem::Geometry::SEGMENT>();
+
+  tensor<double, num_qpts<g, q>, dim> xi{};
+  for (int Q = 0; Q < num_qpts<g, q>; Q++) {
+    xi[Q][0] = points1D[Q % q];
+    xi[Q][1] = points1D[(Q / q) % q];
+    if constexpr (dim == 3) {
+      xi[Q][2] = points1D[Q / (q * q)];
+    }
+  }
+  return xi;
+}
+
+/// @brief the quadrature weight associated with each quadrature point
+template <mfem::Geometry::Type g, int q>
+auto quadrature_weights()
+{
+  constexpr auto weights1D = GaussLegendreWeights<q, mfem::Geometry::SEGMENT>();
+
+  tensor<double, num_qpts<g, q>> w{};
+  for (int Q = 0; Q < num_qpts<g, q>; Q++) {
+    w[Q] = weights1D[Q % q] * weights1D[(Q / q) % q];
+    if constexpr (g == mfem::Geometry::CUBE) {
+      w[Q] *= weights1D[Q / (q * q)];
+    }
+  }
+  return w;
+}
+
+/// @brief the shape functions and their gradients tabulated at every quadrature point of the element
+template <typename element_type, int q>
+struct FullProductTables {
+  static constexpr int nqpts = num_qpts<element_type::geometry, q>;  ///< quadrature points per element
+
+  FullProductTables()
+  {
+    auto xi = quadrature_points<element_type::geometry, q>();
+    auto w  = quadrature_weights<element_type::geometry, q>();
+    for (int Q = 0; Q < nqpts; Q++) {
+      N[Q]   = element_type::shape_functions(xi[Q]);
+      dN[Q]  = element_type::shape_function_gradients(xi[Q]);
+      wN[Q]  = w[Q] * N[Q];
+      wdN[Q] = w[Q] * dN[Q];
+    }
+  }
+
+  tensor<double, nqpts, element_type::ndof>                    N;    ///< shape functions
+  tensor<double, nqpts, element_type::ndof, element_type::dim> dN;   ///< shape function gradients
+  tensor<double, nqpts, element_type::ndof>                    wN;   ///< shape functions, times quadrature weights
+  tensor<double, nqpts, element_type::ndof, element_type::dim> wdN;  ///< gradients, times quadrature weights
+};
+
+/// @brief interpolate values and gradients at each quadrature point by applying the full shape function table
+template <typename element_type, int q, typename output_type>
+void full_product_interpolate(const typename element_type::dof_type& X, const FullProductTables<element_type, q>& T,
+                              output_type& output)
+{
+  constexpr int c   = element_type::components;
+  constexpr int dim = element_type::dim;
+
+  // each quadrature point stores c values, followed by c * dim gradient components
+  auto x   = reinterpret_cast<const double*>(&X);
+  auto out = reinterpret_cast<double*>(&output);
+  for (int Q = 0; Q < T.nqpts; Q++) {
+    double* value    = out + Q * c * (dim + 1);
+    double* gradient = value + c;
+    for (int i = 0; i < c; i++) {
+      double sum[dim + 1]{};
+      for (int k = 0; k < element_type::ndof; k++) {
+        sum[0] += T.N(Q, k) * x[i * element_type::ndof + k];
+        for (int j = 0; j < dim; j++) {
+          sum[j + 1] += T.dN(Q, k, j) * x[i * element_type::ndof + k];
+        }
+      }
+      value[i] = sum[0];
+      for (int j = 0; j < dim; j++) {
+        gradient[i * dim + j] = sum[j + 1];
+      }
+    }
+  }
+}
+
+/// @brief integrate sources and fluxes against each shape function by applying the full shape function table
+template <typename element_type, int q, typename input_type>
+void full_product_integrate(const input_type& qf_output, const FullProductTables<element_type, q>& T,
+                            typename element_type::dof_type* element_residual)
+{
+  constexpr int c   = element_type::components;
+  constexpr int dim = element_type::dim;
+
+  auto in = reinterpret_cast<const double*>(&qf_output);
+  auto r  = reinterpret_cast<double*>(element_residual);
+  for (int i = 0; i < c; i++) {
+    for (int k = 0; k < element_type::ndof; k++) {
+      double sum = 0.0;
+      for (int Q = 0; Q < T.nqpts; Q++) {
+        const double* source = in + Q * c * (dim + 1);
+        const double* flux   = source + c;
+        sum += T.wN(Q, k) * source[i];
+        for (int j = 0; j < dim; j++) {
+          sum += T.wdN(Q, k, j) * flux[i * dim + j];
+        }
+      }
+      r[i * element_type::ndof + k] += sum;
+    }
+  }
+}
+
+/// @brief generate some nodal values to interpolate
+template <typename element_type>
+std::vector<typename element_type::dof_type> random_nodal_values()
+{
+  std::default_random_engine             generator(0);
+  std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+
+  std::vector<typename element_type::dof_type> X(num_elements);
+  for (auto& X_e : X) {
+    auto values = reinterpret_cast<double*>(&X_e);
+    for (std::size_t i = 0; i < sizeof(X_e) / sizeof(double); i++) {
+      values[i] = distribution(generator);
+    }
+  }
+  return X;
+}
+
+/// @brief attach the analytic flop counts of a given kernel to the benchmark output
+void set_flop_counters(benchmark::State& state, double flops_per_element)
+{
+  state.counters["flops/elem"] = flops_per_element;
+  state.counters["FLOPS"]      = benchmark::Counter(flops_per_element * num_elements * double(state.iterations()),
+                                               benchmark::Counter::kIsRate);
+}
+
+template <mfem::Geometry::Type g, int p, int c>
+static void BM_interpolate_sum_factorized(benchmark::State& state)
+{
+  using element_type = finite_element<g, H1<p, c>>;
+  static constexpr int                            q = p + 1;
+  static constexpr TensorProductQuadratureRule<q> rule{};
+
+  auto X = random_nodal_values<element_type>();
+
+  for (auto _ : state) {
+    for (int e = 0; e < num_elements; e++) {
+      auto output = element_type::interpolate(X[std::size_t(e)], rule);
+      benchmark::DoNotOptimize(output);
+    }
+  }
+
+  set_flop_counters(state, c * sum_factorized_flops<g>(p + 1, q));
+}
+
+template <mfem::Geometry::Type g, int p, int c>
+static void BM_interpolate_full_product(benchmark::State& state)
+{
+  using element_type = finite_element<g, H1<p, c>>;
+  static constexpr int                            q = p + 1;
+  static constexpr TensorProductQuadratureRule<q> rule{};
+
+  auto tables = std::make_unique<FullProductTables<element_type, q>>();
+  auto X      = random_nodal_values<element_type>();
+
+  // make sure the two implementations agree before timing anything
+  using output_type    = decltype(element_type::interpolate(X[0], rule));
+  output_type expected = element_type::interpolate(X[0], rule);
+  output_type output{};
+  full_product_interpolate(X[0], *tables, output);
+  auto a = reinterpret_cast<const double*>(&expected);
+  auto b = reinterpret_cast<const double*>(&output);
+  for (std::size_t i = 0; i < sizeof(output_type) / sizeof(double); i++) {
+    if (std::abs(a[i] - b[i]) > 1.0e-12 * (1.0 + std::abs(a[i]))) {
+      state.SkipWithError("full-product interpolation disagrees with the sum-factorized kernel");
+      return;
+    }
+  }
+
+  for (auto _ : state) {
+    for (int e = 0; e < num_elements; e++) {
+      full_product_interpolate(X[std::size_t(e)], *tables, output);
+      benchmark::DoNotOptimize(output);
+    }
+  }
+
+  set_flop_counters(state, c * full_product_flops<g>(p + 1, q));
+}
+
+template <mfem::Geometry::Type g, int p, int c>
+static void BM_integrate_sum_factorized(benchmark::State& state)
+{
+  using element_type = finite_element<g, H1<p, c>>;
+  static constexpr int                            q = p + 1;
+  static constexpr TensorProductQuadratureRule<q> rule{};
+
+  // use interpolated fields as stand-ins for the q-function sources and fluxes
+  auto X         = random_nodal_values<element_type>();
+  auto qf_output = element_type::interpolate(X[0], rule);
+
+  std::vector<typename element_type::dof_type> R(num_elements);
+
+  for (auto _ : state) {
+    for (int e = 0; e < num_elements; e++) {
+      element_type::integrate(qf_output, rule, &R[std::size_t(e)]);
+    }
+    benchmark::DoNotOptimize(R.data());
+    benchmark::ClobberMemory();
+  }
+
+  set_flop_counters(state, c * sum_factorized_flops<g>(p + 1, q));
+}
+
+template <mfem::Geometry::Type g, int p, int c>
+static void BM_integrate_full_product(benchmark::State& state)
+{
+  using element_type = finite_element<g, H1<p, c>>;
+  static constexpr int                            q = p + 1;
+  static constexpr TensorProductQuadratureRule<q> rule{};
+
+  auto tables    = std::make_unique<FullProductTables<element_type, q>>();
+  auto X         = random_nodal_values<element_type>();
+  auto qf_output = element_type::interpolate(X[0], rule);
+
+  // make sure the two implementations agree before timing anything
+  typename element_type::dof_type expected{};
+  typename element_type::dof_type residual{};
+  element_type::integrate(qf_output, rule, &expected);
+  full_product_integrate(qf_output, *tables, &residual);
+  if (norm(expected - residual) > 1.0e-12 * (1.0 + norm(expected))) {
+    state.SkipWithError("full-product integration disagrees with the sum-factorized kernel");
+    return;
+  }
+
+  std::vector<typename element_type::dof_type> R(num_elements);
+
+  for (auto _ : state) {
+    for (int e = 0; e < num_elements; e++) {
+      full_product_integrate(qf_output, *tables, &R[std::size_t(e)]);
+    }
+    benchmark::DoNotOptimize(R.data());
+    benchmark::ClobberMemory();
+  }
+
+  set_flop_counters(state, c * full_product_flops<g>(p + 1, q));
+}
+
+// clang-format off
+#define SERAC_FE_KERNEL_BENCHMARKS(geom, p, c)                         \
+  BENCHMARK_TEMPLATE(BM_interpolate_sum_factorized, geom, p, c);      \
+  BENCHMARK_TEMPLATE(BM_interpolate_full_product, geom, p, c);        \
+  BENCHMARK_TEMPLATE(BM_integrate_sum_factorized, geom, p, c);        \
+  BENCHMARK_TEMPLATE(BM_integrate_full_product, geom, p, c);
+
+SERAC_FE_KERNEL_BENCHMARKS(mfem::Geometry::SQUARE, 1, 1)
+SERAC_FE_KERNEL_BENCHMARKS(mfem::Geometry::SQUARE, 2, 1)
+SERAC_FE_KERNEL_BENCHMARKS(mfem::Geometry::SQUARE, 3, 1)
+SERAC_FE_KERNEL_BENCHMARKS(mfem::Geometry::SQUARE, 3, 2)
+
+SERAC_FE_KERNEL_BENCHMARKS(mfem::Geometry::CUBE, 1, 1)
+SERAC_FE_KERNEL_BENCHMARKS(mfem::Geometry::CUBE, 2, 1)
+SERAC_FE_KERNEL_BENCHMARKS(mfem::Geometry::CUBE, 3, 1)
+SERAC_FE_KERNEL_BENCHMARKS(mfem::Geometry::CUBE, 3, 3)
+// clang-format on
+
+BENCHMARK_MAIN();
@@ -0,0 +1,220 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file benchmark_functional.cpp
+ *
+ * @brief times the residual evaluation, action of the gradient and gradient assembly of Functional
+ * for each element geometry, polynomial order and kind of function space
+ */
+
+#include <memory>
+
+#include <benchmark/benchmark.h>
+
+#include "mfem.hpp"
+
+#include "axom/slic/core/SimpleLogger.hpp"
+#include "serac/mesh/mesh_utils_base.hpp"
+#include "serac/numerics/functional/functional.hpp"
+#include "serac/numerics/functional/tensor.hpp"
+
+using namespace serac;
+
+/// @brief vector-valued H1 spaces with a component for each spatial dimension
+template <int p>
+using H1_vector_2D = H1<p, 2>;
+
+/// @overload
+template <int p>
+using H1_vector_3D = H1<p, 3>;
+
+/// @brief the part of the Functional pipeline being timed
+enum class Stage
+{
+  Residual,
+  ActionOfGradient,
+  Assembly
+};
+
+/// @brief the number of elements along each edge of the benchmark meshes of the unit square and cube
+constexpr int elements_per_edge(int dim) { return (dim == 2) ? 32 : 8; }
+
+/// @brief the dimension of the elements of the given type
+constexpr int element_dimension(mfem::Element::Type type)
+{
+  return (type == mfem::Element::TRIANGLE || type == mfem::Element::QUADRILATERAL) ? 2 : 3;
+}
+
+/// @brief the geometry of the elements of the given type
+constexpr mfem::Geometry::Type geometry_of(mfem::Element::Type type)
+{
+  switch (type) {
+    case mfem::Element::TRIANGLE:
+      return mfem::Geometry::TRIANGLE;
+    case mfem::Element::QUADRILATERAL:
+      return mfem::Geometry::SQUARE;
+    case mfem::Element::TETRAHEDRON:
+      return mfem::Geometry::TETRAHEDRON;
+    default:
+      return mfem::Geometry::CUBE;
+  }
+}
+
+/// @brief a (distributed) mesh of the unit square or cube, made of elements of the given type
+std::unique_ptr<mfem::ParMesh> benchmark_mesh(mfem::Element::Type type)
+{
+  const int n = elements_per_edge(element_dimension(type));
+  if (element_dimension(type) == 2) {
+    return mesh::refineAndDistribute(mfem::Mesh::MakeCartesian2D(n, n, type, true), 0, 0);
+  }
+  return mesh::refineAndDistribute(mfem::Mesh::MakeCartesian3D(n, n, n, type), 0, 0);
+}
+
+/**
+ * @brief report the number of (true) dofs processed per second and an estimate of the memory bandwidth
+ *
+ * The memory traffic of each element is the one that Functional reports to Caliper for the evaluation kernel
+ * (see evaluation_cost()), plus the gather and scatter of the element values and the quadrature point data.
+ */
+template <mfem::Geometry::Type geom, typename space>
+void set_throughput_counters(benchmark::State& state, mfem::ParMesh& mesh, mfem::ParFiniteElementSpace& fes,
+                             double qdata_bytes_per_element)
+{
+  constexpr int Q = space::order + 1;
+
+  auto   cost   = evaluation_cost<geom, Q, space, space>(*shared_geometric_factors(&mesh, Q, geom));
+  double values = sizeof(typename finite_element<geom, space>::dof_type) / sizeof(double);
+  double bytes  = cost.bytes + 2.0 * sizeof(double) * (2.0 * values) + qdata_bytes_per_element;
+
+  const double iterations = double(state.iterations());
+  const double dofs       = double(fes.GlobalTrueVSize());
+  state.counters["DOFs/s"]  = benchmark::Counter(dofs * iterations, benchmark::Counter::kIsRate);
+  state.counters["bytes/s"] = benchmark::Counter(bytes * mesh.GetNE() * iterations, benchmark::Counter::kIsRate);
+}
+
+template <Stage stage, mfem::Element::Type element, typename space, bool with_qdata>
+static void BM_functional(benchmark::State& state)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  constexpr int  dim  = element_dimension(element);
+  constexpr auto geom = geometry_of(element);
+
+  auto mesh       = benchmark_mesh(element);
+  auto [fes, fec] = generateParFiniteElementSpace<space>(mesh.get());
+
+  Functional<space(space)> residual(fes.get(), {fes.get()});
+
+  // the q-functions are cheap, so that the timings are dominated by the finite element kernels
+  double qdata_bytes_per_element = 0.0;
+  if constexpr (with_qdata) {
+    auto qpts_per_element = GaussQuadratureRule<geom, space::order + 1>().size();
+    auto qdata            = std::make_shared<QuadratureData<double>>(std::size_t(mesh->GetNE()), qpts_per_element);
+    for (std::size_t i = 0; i < qdata->size; i++) {
+      qdata->data[i] = 1.0;
+    }
+    qdata_bytes_per_element = sizeof(double) * double(qpts_per_element);
+
+    residual.AddDomainIntegral(
+        Dimension<dim>{}, DependsOn<0>{},
+        [](auto /*x*/, double& state_value, auto arg) {
+          auto [u, du] = arg;
+          return serac::tuple{state_value * u, state_value * du};
+        },
+        *mesh, qdata);
+  } else {
+    residual.AddDomainIntegral(
+        Dimension<dim>{}, DependsOn<0>{},
+        [](auto /*x*/, auto arg) {
+          auto [u, du] = arg;
+          return serac::tuple{2.0 * u, du};
+        },
+        *mesh);
+  }
+
+  mfem::Vector U(fes->GetTrueVSize());
+  U.Randomize(0);
+
+  mfem::Vector dU(fes->GetTrueVSize());
+  dU.Randomize(1);
+
+  if constexpr (stage == Stage::Residual) {
+    for (auto _ : state) {
+      // This code gets timed
+      mfem::Vector r = residual(U);
+      benchmark::DoNotOptimize(r.GetData());
+    }
+  }
+
+  if constexpr (stage == Stage::ActionOfGradient) {
+    auto [r, dR] = residual(differentiate_wrt(U));
+    for (auto _ : state) {
+      // This code gets timed
+      mfem::Vector& dr = dR(dU);
+      benchmark::DoNotOptimize(dr.GetData());
+    }
+  }
+
+  if constexpr (stage == Stage::Assembly) {
+    auto [r, dR] = residual(differentiate_wrt(U));
+    for (auto _ : state) {
+      // This code gets timed
+      auto K = assemble(dR);
+      benchmark::DoNotOptimize(K.get());
+    }
+  }
+
+  set_throughput_counters<geom, space>(state, *mesh, *fes, qdata_bytes_per_element);
+
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
+// clang-format off
+#define SERAC_FUNCTIONAL_BENCHMARKS(element, space, with_qdata)                                     \
+  BENCHMARK_TEMPLATE(BM_functional, Stage::Residual, element, space, with_qdata)                     \
+      ->Unit(benchmark::kMillisecond);                                                               \
+  BENCHMARK_TEMPLATE(BM_functional, Stage::ActionOfGradient, element, space, with_qdata)             \
+      ->Unit(benchmark::kMillisecond);                                                               \
+  BENCHMARK_TEMPLATE(BM_functional, Stage::Assembly, element, space, with_qdata)                     \
+      ->Unit(benchmark::kMillisecond);
+
+#define SERAC_FUNCTIONAL_BENCHMARKS_FOR_ORDER(element, vector_H1, p) \
+  SERAC_FUNCTIONAL_BENCHMARKS(element, H1<p>, false)                 \
+  SERAC_FUNCTIONAL_BENCHMARKS(element, H1<p>, true)                  \
+  SERAC_FUNCTIONAL_BENCHMARKS(element, vector_H1<p>, false)          \
+  SERAC_FUNCTIONAL_BENCHMARKS(element, vector_H1<p>, true)           \
+  SERAC_FUNCTIONAL_BENCHMARKS(element, L2<p>, false)
+
+// note: the H1 and L2 kernels of this version support p = 1, 2, 3
+#define SERAC_FUNCTIONAL_BENCHMARKS_FOR_ELEMENT(element, vector_H1) \
+  SERAC_FUNCTIONAL_BENCHMARKS_FOR_ORDER(element, vector_H1, 1)      \
+  SERAC_FUNCTIONAL_BENCHMARKS_FOR_ORDER(element, vector_H1, 2)      \
+  SERAC_FUNCTIONAL_BENCHMARKS_FOR_ORDER(element, vector_H1, 3)
+
+SERAC_FUNCTIONAL_BENCHMARKS_FOR_ELEMENT(mfem::Element::TRIANGLE, H1_vector_2D)
+SERAC_FUNCTIONAL_BENCHMARKS_FOR_ELEMENT(mfem::Element::QUADRILATERAL, H1_vector_2D)
+SERAC_FUNCTIONAL_BENCHMARKS_FOR_ELEMENT(mfem::Element::TETRAHEDRON, H1_vector_3D)
+SERAC_FUNCTIONAL_BENCHMARKS_FOR_ELEMENT(mfem::Element::HEXAHEDRON, H1_vector_3D)
+// clang-format on
+
+//------------------------------------------------------------------------------
+
+int main(int argc, char* argv[])
+{
+  ::benchmark::Initialize(&argc, argv);
+
+  MPI_Init(&argc, &argv);
+
+  axom::slic::SimpleLogger logger;  // create & initialize test logger, finalized when
+                                    // exiting main scope
+
+  ::benchmark::RunSpecifiedBenchmarks();
+
+  MPI_Finalize();
+
+  return 0;
+}
@@ -0,0 +1,218 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file benchmark_tensor_kernels.cpp
+ *
+ * @brief times the small (3x3) tensor operations that q-functions are made of, on each kind of scalar they are
+ * evaluated with: doubles, dual numbers with a single derivative, dual numbers w.r.t. a whole 3x3 matrix (the
+ * derivatives of a material w.r.t. the displacement gradient) and simd packs of doubles
+ *
+ * The throughput is reported as "ops/ns", where evaluating an operation on a simd pack counts once per lane.
+ * The tests guarding the layout and constexpr-evaluability these kernels rely on are in tensor_unit_tests.cpp.
+ */
+
+#include <type_traits>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "serac/numerics/functional/tuple_tensor_dual_functions.hpp"
+
+using namespace serac;
+
+/// @brief the number of matrices each benchmark iteration evaluates an operation on
+static constexpr int num_matrices = 256;
+
+/// @brief the number of independent operations in one evaluation on a scalar of type T, i.e. its simd lanes
+template <typename T>
+constexpr int lanes = 1;
+
+/// @overload
+template <typename T, int W>
+constexpr int lanes<simd<T, W>> = W;
+
+/// @brief a symmetric positive definite matrix, different for every i
+inline tensor<double, 3, 3> spd_matrix(int i)
+{
+  double h = 1.0e-2 * double(i % 23);
+  return {{{4.0 + h, 0.5, -0.2 * h}, {0.5, 3.0 - h, 0.1}, {-0.2 * h, 0.1, 5.0 + 2.0 * h}}};
+}
+
+/**
+ * @brief the operands of the benchmarks on scalars of type T: for dual numbers w.r.t. a matrix, only the first
+ * operand is differentiated (like the displacement gradient in a material), so the second one is a matrix of doubles
+ */
+template <typename T>
+auto first_operand(int i)
+{
+  if constexpr (std::is_same_v<T, double>) {
+    return spd_matrix(i);
+  } else if constexpr (std::is_same_v<T, dual<double>>) {
+    tensor<double, 3, 3> A = spd_matrix(i);
+    return make_tensor<3, 3>([&](int j, int k) { return dual<double>{A[j][k], 1.0}; });
+  } else if constexpr (std::is_same_v<T, dual<tensor<double, 3, 3>>>) {
+    return make_dual(spd_matrix(i));
+  } else {
+    tensor<T, 3, 3> A{};
+    for (int l = 0; l < lanes<T>; l++) {
+      tensor<double, 3, 3> A_l = spd_matrix(i * lanes<T> + l);
+      for (int j = 0; j < 3; j++) {
+        for (int k = 0; k < 3; k++) {
+          A[j][k][l] = A_l[j][k];
+        }
+      }
+    }
+    return A;
+  }
+}
+
+/// @brief see first_operand()
+template <typename T>
+auto second_operand(int i)
+{
+  if constexpr (std::is_same_v<T, dual<tensor<double, 3, 3>>>) {
+    return spd_matrix(i + 1);
+  } else {
+    return first_operand<T>(i + 1);
+  }
+}
+
+/// @brief det(A)
+struct Det {
+  template <typename M, typename N>
+  auto operator()(const M& A, const N&) const
+  {
+    return det(A);
+  }
+};
+
+/// @brief inv(A)
+struct Inv {
+  template <typename M, typename N>
+  auto operator()(const M& A, const N&) const
+  {
+    return inv(A);
+  }
+};
+
+/// @brief dot(A, B)
+struct Dot {
+  template <typename M, typename N>
+  auto operator()(const M& A, const N& B) const
+  {
+    return dot(A, B);
+  }
+};
+
+/// @brief double_dot(A, B)
+struct DoubleDot {
+  template <typename M, typename N>
+  auto operator()(const M& A, const N& B) const
+  {
+    return double_dot(A, B);
+  }
+};
+
+/// @brief linear_solve(A, b), with one right hand side (the first row of B)
+struct LinearSolve {
+  template <typename M, typename N>
+  auto operator()(const M& A, const N& B) const
+  {
+    return linear_solve(A, B[0]);
+  }
+};
+
+/// @brief factorize_lu(A), followed by a solve with one right hand side
+struct LuSolve {
+  template <typename M, typename N>
+  auto operator()(const M& A, const N& B) const
+  {
+    return linear_solve(factorize_lu(A), B[0]);
+  }
+};
+
+/// @brief matrix_sqrt(A), of a symmetric positive definite matrix
+struct MatrixSqrt {
+  template <typename M, typename N>
+  auto operator()(const M& A, const N&) const
+  {
+    return matrix_sqrt(A);
+  }
+};
+
+/// @brief eig(A), the eigendecomposition of a symmetric matrix
+struct Eig {
+  template <typename M, typename N>
+  auto operator()(const M& A, const N&) const
+  {
+    return eig(A);
+  }
+};
+
+/**
+ * @brief time an operation on an array of matrices of scalars of type T
+ *
+ * @tparam op the operation
+ * @tparam T the scalar type
+ */
+template <typename op, typename T>
+static void BM_tensor_op(benchmark::State& state)
+{
+  using first_type  = decltype(first_operand<T>(0));
+  using second_type = decltype(second_operand<T>(0));
+  using output_type = decltype(op{}(first_type{}, second_type{}));
+
+  std::vector<first_type>  A(num_matrices);
+  std::vector<second_type> B(num_matrices);
+  for (int i = 0; i < num_matrices; i++) {
+    A[std::size_t(i)] = first_operand<T>(i);
+    B[std::size_t(i)] = second_operand<T>(i);
+  }
+  std::vector<output_type> outputs(num_matrices);
+
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < std::size_t(num_matrices); i++) {
+      outputs[i] = op{}(A[i], B[i]);
+    }
+    benchmark::DoNotOptimize(outputs.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.counters["ops/ns"] = benchmark::Counter(1.0e-9 * double(state.iterations()) * num_matrices * lanes<T>,
+                                                benchmark::Counter::kIsRate);
+}
+
+using dual_matrix   = dual<tensor<double, 3, 3>>;
+using simd_double_4 = simd<double, 4>;
+
+/// @brief the operations that are implemented for every kind of scalar
+#define SERAC_TENSOR_KERNEL_BENCHMARKS(T)           \
+  BENCHMARK_TEMPLATE(BM_tensor_op, Det, T);         \
+  BENCHMARK_TEMPLATE(BM_tensor_op, Inv, T);         \
+  BENCHMARK_TEMPLATE(BM_tensor_op, Dot, T);         \
+  BENCHMARK_TEMPLATE(BM_tensor_op, DoubleDot, T);   \
+  BENCHMARK_TEMPLATE(BM_tensor_op, LinearSolve, T);
+
+SERAC_TENSOR_KERNEL_BENCHMARKS(double)
+SERAC_TENSOR_KERNEL_BENCHMARKS(dual<double>)
+SERAC_TENSOR_KERNEL_BENCHMARKS(dual_matrix)
+SERAC_TENSOR_KERNEL_BENCHMARKS(simd_double_4)
+
+// an explicit factorization, whose pivots are chosen lane by lane for simd packs
+BENCHMARK_TEMPLATE(BM_tensor_op, LuSolve, double);
+BENCHMARK_TEMPLATE(BM_tensor_op, LuSolve, dual<double>);
+BENCHMARK_TEMPLATE(BM_tensor_op, LuSolve, simd_double_4);
+
+// closed forms (through the eigendecomposition) for doubles and their derivatives, Newton's method otherwise
+BENCHMARK_TEMPLATE(BM_tensor_op, MatrixSqrt, double);
+BENCHMARK_TEMPLATE(BM_tensor_op, MatrixSqrt, dual_matrix);
+BENCHMARK_TEMPLATE(BM_tensor_op, MatrixSqrt, simd_double_4);
+
+// the eigendecomposition is only implemented for doubles
+BENCHMARK_TEMPLATE(BM_tensor_op, Eig, double);
+
+BENCHMARK_MAIN();
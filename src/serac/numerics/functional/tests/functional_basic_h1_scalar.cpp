@@ -75,6 +75,135 @@ void thermal_test_impl(std::unique_ptr<mfem::ParMesh>& mesh)
   check_gradient(residual, U);
 }
 
+// the terms of a residual packed into one integral (see QFunctionPack) give the same residual and gradient as
+// adding them separately
+template <int p, int dim>
+void packed_qfunctions_test_impl(std::unique_ptr<mfem::ParMesh>& mesh)
+{
+  auto                        fec = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace fespace(mesh.get(), &fec);
+
+  mfem::Vector U(fespace.TrueVSize());
+
+  mfem::ParGridFunction     U_gf(&fespace);
+  mfem::FunctionCoefficient x_squared([](mfem::Vector x) { return x[0] * x[0]; });
+  U_gf.ProjectCoefficient(x_squared);
+  U_gf.GetTrueDofs(U);
+
+  using space = H1<p>;
+
+  auto mass      = [](auto /*x*/, auto temperature) { return serac::tuple{2.0 * get<0>(temperature), zero{}}; };
+  auto diffusion = [](auto /*x*/, auto temperature) {
+    auto [u, du_dx] = temperature;
+    return serac::tuple{zero{}, (1.0 + u * u) * du_dx};
+  };
+  auto source = [](auto x, auto /*temperature*/) { return serac::tuple{x[0] * x[1], zero{}}; };
+
+  Functional<space(space)> separate(&fespace, {&fespace});
+  separate.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, mass, *mesh);
+  separate.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, diffusion, *mesh);
+  separate.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, source, *mesh);
+
+  Functional<space(space)> packed(&fespace, {&fespace});
+  packed.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, pack_qfunctions(mass, diffusion, source), *mesh);
+
+  auto [r1, dr1] = separate(differentiate_wrt(U));
+  auto [r2, dr2] = packed(differentiate_wrt(U));
+
+  mfem::Vector difference(r1);
+  difference -= r2;
+  EXPECT_NEAR(difference.Norml2() / r1.Norml2(), 0.0, 1.0e-14);
+
+  mfem::Vector dU(U.Size()), jvp1(U.Size()), jvp2(U.Size());
+  dU.Randomize(0);
+  dr1.Mult(dU, jvp1);
+  dr2.Mult(dU, jvp2);
+  jvp1 -= jvp2;
+  EXPECT_NEAR(jvp1.Norml2() / jvp2.Norml2(), 0.0, 1.0e-14);
+
+  check_gradient(packed, U);
+}
+
+// a Functional in ExecutionSpace::Dynamic (whose integrals run wherever suits their size) gives the same residual
+// and gradient as one on the CPU
+template <int p, int dim>
+void dynamic_execution_test_impl(std::unique_ptr<mfem::ParMesh>& mesh)
+{
+  auto                        fec = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace fespace(mesh.get(), &fec);
+
+  mfem::Vector U(fespace.TrueVSize());
+
+  mfem::ParGridFunction     U_gf(&fespace);
+  mfem::FunctionCoefficient x_squared([](mfem::Vector x) { return x[0] * x[0]; });
+  U_gf.ProjectCoefficient(x_squared);
+  U_gf.GetTrueDofs(U);
+
+  using space = H1<p>;
+
+  auto diffusion = [](auto x, auto temperature) {
+    auto [u, du_dx] = temperature;
+    return serac::tuple{u * u - x[0], (1.0 + u * u) * du_dx};
+  };
+  auto flux = [](auto x, auto /*n*/, auto temperature) { return x[1] * get<0>(temperature); };
+
+  Functional<space(space), ExecutionSpace::CPU>     cpu(&fespace, {&fespace});
+  Functional<space(space), ExecutionSpace::Dynamic> dynamic(&fespace, {&fespace});
+  cpu.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, diffusion, *mesh);
+  cpu.AddBoundaryIntegral(Dimension<dim - 1>{}, DependsOn<0>{}, flux, *mesh);
+  dynamic.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, diffusion, *mesh);
+  dynamic.AddBoundaryIntegral(Dimension<dim - 1>{}, DependsOn<0>{}, flux, *mesh);
+
+  auto [r1, dr1] = cpu(differentiate_wrt(U));
+  auto [r2, dr2] = dynamic(differentiate_wrt(U));
+
+  mfem::Vector difference(r1);
+  difference -= r2;
+  EXPECT_NEAR(difference.Norml2() / r1.Norml2(), 0.0, 1.0e-14);
+
+  mfem::Vector dU(U.Size()), jvp1(U.Size()), jvp2(U.Size());
+  dU.Randomize(0);
+  dr1.Mult(dU, jvp1);
+  dr2.Mult(dU, jvp2);
+  jvp1 -= jvp2;
+  EXPECT_NEAR(jvp1.Norml2() / jvp2.Norml2(), 0.0, 1.0e-14);
+
+  std::unique_ptr<mfem::HypreParMatrix> K1 = assemble(dr1);
+  std::unique_ptr<mfem::HypreParMatrix> K2 = assemble(dr2);
+  K1->Mult(dU, jvp1);
+  K2->Mult(dU, jvp2);
+  jvp1 -= jvp2;
+  EXPECT_NEAR(jvp1.Norml2() / jvp2.Norml2(), 0.0, 1.0e-14);
+}
+
+template <int p>
+void dynamic_execution_test(std::string meshfile)
+{
+  auto mesh = mesh::refineAndDistribute(buildMeshFromFile(SERAC_REPO_DIR + meshfile), 1);
+
+  if (mesh->Dimension() == 2) {
+    dynamic_execution_test_impl<p, 2>(mesh);
+  }
+
+  if (mesh->Dimension() == 3) {
+    dynamic_execution_test_impl<p, 3>(mesh);
+  }
+}
+
+template <int p>
+void packed_qfunctions_test(std::string meshfile)
+{
+  auto mesh = mesh::refineAndDistribute(buildMeshFromFile(SERAC_REPO_DIR + meshfile), 1);
+
+  if (mesh->Dimension() == 2) {
+    packed_qfunctions_test_impl<p, 2>(mesh);
+  }
+
+  if (mesh->Dimension() == 3) {
+    packed_qfunctions_test_impl<p, 3>(mesh);
+  }
+}
+
 template <int ptest, int ptrial>
 void thermal_test(std::string meshfile)
 {
@@ -96,9 +225,17 @@ TEST(basic, thermal_tris_and_quads) { thermal_test<1, 1>("/data/meshes/patch2D_t
 TEST(basic, thermal_tets) { thermal_test<1, 1>("/data/meshes/patch3D_tets.mesh"); }
 TEST(basic, thermal_hexes) { thermal_test<1, 1>("/data/meshes/patch3D_hexes.mesh"); }
 TEST(basic, thermal_tets_and_hexes) { thermal_test<1, 1>("/data/meshes/patch3D_tets_and_hexes.mesh"); }
+TEST(basic, thermal_prisms) { thermal_test<1, 1>("/data/meshes/beam-wedge.mesh"); }
+
+TEST(packed, thermal_tris_and_quads) { packed_qfunctions_test<2>("/data/meshes/patch2D_tris_and_quads.mesh"); }
+TEST(packed, thermal_tets_and_hexes) { packed_qfunctions_test<1>("/data/meshes/patch3D_tets_and_hexes.mesh"); }
+
+TEST(dynamic, thermal_quads) { dynamic_execution_test<2>("/data/meshes/patch2D_quads.mesh"); }
+TEST(dynamic, thermal_hexes) { dynamic_execution_test<1>("/data/meshes/patch3D_hexes.mesh"); }
 
 TEST(mixed, thermal_tris_and_quads) { thermal_test<2, 1>("/data/meshes/patch2D_tris_and_quads.mesh"); }
 TEST(mixed, thermal_tets_and_hexes) { thermal_test<2, 1>("/data/meshes/patch3D_tets_and_hexes.mesh"); }
+TEST(mixed, thermal_prisms) { thermal_test<2, 1>("/data/meshes/beam-wedge.mesh"); }
 
 int main(int argc, char* argv[])
 {
@@ -104,10 +104,53 @@ void hcurl_test_3D()
   check_gradient(residual, U);
 }
 
+// an Hcurl test space with a vector-valued H1 trial space, whose element gradients integrate
+// several trial directions at once
+template <int p>
+void hcurl_h1_test_3D()
+{
+  constexpr int dim = 3;
+
+  std::string meshfile = SERAC_REPO_DIR "/data/meshes/patch3D.mesh";
+
+  auto mesh = mesh::refineAndDistribute(buildMeshFromFile(meshfile), 1);
+
+  auto                        test_fec = mfem::ND_FECollection(p, dim);
+  mfem::ParFiniteElementSpace test_fespace(mesh.get(), &test_fec);
+
+  auto                        trial_fec = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace trial_fespace(mesh.get(), &trial_fec, dim);
+
+  mfem::Vector U(trial_fespace.TrueVSize());
+  U.Randomize();
+
+  using test_space  = Hcurl<p>;
+  using trial_space = H1<p, dim>;
+
+  Functional<test_space(trial_space)> residual(&test_fespace, {&trial_fespace});
+
+  auto d00 = make_tensor<dim, dim>([](int i, int j) { return i + j * j - 1; });
+  auto d11 = make_tensor<dim, dim, dim>([](int i, int j, int k) { return i * i + j - k + 2; });
+
+  residual.AddDomainIntegral(
+      Dimension<dim>{}, DependsOn<0>{},
+      [=](auto /*x*/, auto displacement) {
+        auto [u, du_dx] = displacement;
+        auto source     = dot(d00, u);
+        auto flux       = double_dot(d11, du_dx);
+        return serac::tuple{source, flux};
+      },
+      *mesh);
+
+  check_gradient(residual, U);
+}
+
 TEST(basic, hcurl_test_2D_linear) { hcurl_test_2D<1>(); }
 
 TEST(basic, hcurl_test_3D_linear) { hcurl_test_3D<1>(); }
 
+TEST(basic, hcurl_h1_test_3D_linear) { hcurl_h1_test_3D<1>(); }
+
 int main(int argc, char* argv[])
 {
   int num_procs, myid;
@@ -194,12 +194,73 @@ void boundary_test(mfem::ParMesh& mesh, L2<p> test, L2<p> trial, Dimension<dim>)
   }
 }
 
+// boundary integrals restricted to some of the boundary attributes should match their mfem counterparts with a
+// boundary marker, and skip the other boundary elements entirely (the q-function would be nonzero there)
+template <int p, int dim>
+void boundary_attribute_test(mfem::ParMesh& mesh, H1<p> test, H1<p> trial, Dimension<dim>)
+{
+  double        rho        = 1.75;
+  std::set<int> attributes = {1, 3};
+
+  auto                        fec = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace fespace(&mesh, &fec);
+
+  mfem::Array<int> marker(mesh.bdr_attributes.Max());
+  marker = 0;
+  for (int attribute : attributes) {
+    marker[attribute - 1] = 1;
+  }
+
+  mfem::ParLinearForm       f(&fespace);
+  mfem::FunctionCoefficient scalar_function([&](const mfem::Vector& coords) { return coords(0) * coords(1); });
+  f.AddBoundaryIntegrator(new mfem::BoundaryLFIntegrator(scalar_function, 2, 0), marker);
+  f.Assemble();
+  std::unique_ptr<mfem::HypreParVector> F(f.ParallelAssemble());
+
+  mfem::ParBilinearForm     B(&fespace);
+  mfem::ConstantCoefficient density(rho);
+  B.AddBoundaryIntegrator(new mfem::BoundaryMassIntegrator(density), marker);
+  B.Assemble(0);
+  B.Finalize();
+  std::unique_ptr<mfem::HypreParMatrix> J(B.ParallelAssemble());
+
+  mfem::Vector U(fespace.TrueVSize());
+  U.Randomize();
+
+  using test_space  = decltype(test);
+  using trial_space = decltype(trial);
+
+  Functional<test_space(trial_space)> residual(&fespace, {&fespace});
+
+  residual.AddBoundaryIntegral(
+      Dimension<dim - 1>{}, DependsOn<0>{},
+      [&](auto x, auto /*n*/, auto temperature) {
+        auto [u, unused] = temperature;
+        return x[0] * x[1] + rho * u;
+      },
+      mesh, attributes);
+
+  mfem::Vector r1 = (*J) * U + (*F);
+  mfem::Vector r2 = residual(U);
+
+  check_gradient(residual, U);
+
+  if (r1.Norml2() < 1.0e-15) {
+    EXPECT_NEAR(0., mfem::Vector(r1 - r2).Norml2(), 1.e-12);
+  } else {
+    EXPECT_NEAR(0., mfem::Vector(r1 - r2).Norml2() / r1.Norml2(), 1.e-12);
+  }
+}
+
 TEST(FunctionalBoundary, 2DLinear) { boundary_test(*mesh2D, H1<1>{}, H1<1>{}, Dimension<2>{}); }
 TEST(FunctionalBoundary, 2DQuadratic) { boundary_test(*mesh2D, H1<2>{}, H1<2>{}, Dimension<2>{}); }
 
 TEST(FunctionalBoundary, 3DLinear) { boundary_test(*mesh3D, H1<1>{}, H1<1>{}, Dimension<3>{}); }
 TEST(FunctionalBoundary, 3DQuadratic) { boundary_test(*mesh3D, H1<2>{}, H1<2>{}, Dimension<3>{}); }
 
+TEST(FunctionalBoundary, 2DAttributes) { boundary_attribute_test(*mesh2D, H1<2>{}, H1<2>{}, Dimension<2>{}); }
+TEST(FunctionalBoundary, 3DAttributes) { boundary_attribute_test(*mesh3D, H1<2>{}, H1<2>{}, Dimension<3>{}); }
+
 TEST(boundaryL2, 2DLinear) { boundary_test(*mesh2D, L2<1>{}, L2<1>{}, Dimension<2>{}); }
 TEST(boundaryL2, 2DQuadratic) { boundary_test(*mesh2D, L2<2>{}, L2<2>{}, Dimension<2>{}); }
 
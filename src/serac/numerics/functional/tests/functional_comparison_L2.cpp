@@ -128,15 +128,86 @@ void functional_test(mfem::ParMesh& mesh, L2<p> test, L2<p> trial, Dimension<dim
   EXPECT_NEAR(0., mfem::Vector(g1 - g2).Norml2() / g1.Norml2(), 1.e-14);
 }
 
+// this test adds a (nonlinear) penalty on the jumps across interior faces, of the kind used in DG methods,
+// and checks that the contributions to either side of each face are consistent, and that the action of
+// its gradient agrees with finite differences (and, in serial, with the assembled gradient)
+template <int p, int dim>
+void interior_face_test(mfem::ParMesh& mesh, Dimension<dim>)
+{
+  auto                        fec = mfem::L2_FECollection(p, dim, mfem::BasisType::GaussLobatto);
+  mfem::ParFiniteElementSpace fespace(&mesh, &fec);
+
+  Functional<L2<p>(L2<p>)> residual(&fespace, {&fespace});
+
+  residual.AddInteriorFaceIntegral(
+      Dimension<dim - 1>{}, DependsOn<0>{},
+      [](auto x, auto n, auto temperature) {
+        auto [u1, u2] = temperature;
+        auto flux     = (u1 - u2) * (u1 + u2 + x[0] * n[0]);
+        return serac::tuple{flux, -flux};
+      },
+      mesh);
+
+  mfem::ParGridFunction u_global(&fespace);
+  u_global.Randomize();
+
+  mfem::Vector U(fespace.TrueVSize());
+  u_global.GetTrueDofs(U);
+
+  auto [r, drdU] = residual(differentiate_wrt(U));
+
+  // the L2 basis functions on either side of a face sum to one, so the fluxes cancel in the sum of the residuals
+  double sum = r.Sum();
+  MPI_Allreduce(MPI_IN_PLACE, &sum, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+  EXPECT_NEAR(0., sum / mfem::ParNormlp(r, 2, MPI_COMM_WORLD), 1.e-12);
+
+  // the q-function is quadratic, so center differences are exact (up to roundoff)
+  mfem::Vector dU(U.Size());
+  dU.Randomize(1);
+
+  double       epsilon = 1.0e-3;
+  mfem::Vector U_plus  = U;
+  mfem::Vector U_minus = U;
+  U_plus.Add(epsilon, dU);
+  U_minus.Add(-epsilon, dU);
+
+  mfem::Vector g1 = residual(U_plus);
+  g1 -= residual(U_minus);
+  g1 /= (2.0 * epsilon);
+
+  mfem::Vector g2 = drdU(dU);
+
+  double relative_error = mfem::ParNormlp(mfem::Vector(g1 - g2), 2, MPI_COMM_WORLD) /
+                          mfem::ParNormlp(g1, 2, MPI_COMM_WORLD);
+  EXPECT_NEAR(0., relative_error, 1.e-8);
+
+  // the gradient of faces shared between ranks can only be applied, not assembled
+  if (num_procs == 1) {
+    std::unique_ptr<mfem::HypreParMatrix> K = assemble(drdU);
+
+    mfem::Vector g3(g2.Size());
+    K->Mult(dU, g3);
+    EXPECT_NEAR(0., mfem::Vector(g2 - g3).Norml2() / g2.Norml2(), 1.e-12);
+  }
+
+  // a constant field has no jumps
+  U = 1.0;
+  EXPECT_NEAR(0., mfem::ParNormlp(residual(U), 2, MPI_COMM_WORLD), 1.e-12);
+}
+
 TEST(L2, 2DConstant) { functional_test(*mesh2D, L2<0>{}, L2<0>{}, Dimension<2>{}); }
 TEST(L2, 2DLinear) { functional_test(*mesh2D, L2<1>{}, L2<1>{}, Dimension<2>{}); }
 TEST(L2, 2DQuadratic) { functional_test(*mesh2D, L2<2>{}, L2<2>{}, Dimension<2>{}); }
 TEST(L2, 2DCubic) { functional_test(*mesh2D, L2<3>{}, L2<3>{}, Dimension<2>{}); }
 
+TEST(L2, 3DConstant) { functional_test(*mesh3D, L2<0>{}, L2<0>{}, Dimension<3>{}); }
 TEST(L2, 3DLinear) { functional_test(*mesh3D, L2<1>{}, L2<1>{}, Dimension<3>{}); }
 TEST(L2, 3DQuadratic) { functional_test(*mesh3D, L2<2>{}, L2<2>{}, Dimension<3>{}); }
 TEST(L2, 3DCubic) { functional_test(*mesh3D, L2<3>{}, L2<3>{}, Dimension<3>{}); }
 
+TEST(L2, 2DInteriorFaces) { interior_face_test<1>(*mesh2D, Dimension<2>{}); }
+TEST(L2, 3DInteriorFaces) { interior_face_test<1>(*mesh3D, Dimension<3>{}); }
+
 TEST(L2, 2DMixed)
 {
   constexpr int dim = 2;
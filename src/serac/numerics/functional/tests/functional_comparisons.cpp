@@ -155,6 +155,14 @@ void functional_test(mfem::ParMesh& mesh, H1<p> test, H1<p> trial, Dimension<dim
   // Ensure the two methods generate the same result
   EXPECT_NEAR(0.0, mfem::Vector(g1 - g2).Norml2() / g1.Norml2(), 1.e-14);
   EXPECT_NEAR(0.0, mfem::Vector(g1 - g3).Norml2() / g1.Norml2(), 1.e-14);
+
+  // Ensure the matrix-free diagonal matches the diagonal of the assembled matrix
+  mfem::Vector d1(J_func->Height());
+  mfem::Vector d2(J_func->Height());
+  J_func->AssembleDiagonal(d1);
+  drdU.AssembleDiagonal(d2);
+
+  EXPECT_NEAR(0.0, mfem::Vector(d1 - d2).Norml2() / d1.Norml2(), 1.e-13);
 }
 
 // this test sets up a toy "elasticity" problem where the residual includes contributions
@@ -255,6 +263,55 @@ void functional_test(mfem::ParMesh& mesh, H1<p, dim> test, H1<p, dim> trial, Dim
 
   EXPECT_NEAR(0., mfem::Vector(g1 - g2).Norml2() / g1.Norml2(), 1.e-14);
   EXPECT_NEAR(0., mfem::Vector(g1 - g3).Norml2() / g1.Norml2(), 1.e-14);
+
+  mfem::Vector d1(J_func->Height());
+  mfem::Vector d2(J_func->Height());
+  J_func->AssembleDiagonal(d1);
+  drdU.AssembleDiagonal(d2);
+
+  EXPECT_NEAR(0., mfem::Vector(d1 - d2).Norml2() / d1.Norml2(), 1.e-13);
+
+  // linear elasticity has a symmetric tangent, so the gradient can also be assembled from the upper triangles
+  // of its element matrices
+  residual.SetSymmetricGradient(0);
+  auto [r_symmetric, drdU_symmetric] = residual(differentiate_wrt(U));
+
+  std::unique_ptr<mfem::HypreParMatrix> J_symmetric = assemble(drdU_symmetric);
+
+  mfem::Vector g4 = (*J_symmetric) * U;
+  EXPECT_NEAR(0., mfem::Vector(g1 - g4).Norml2() / g1.Norml2(), 1.e-14);
+
+  mfem::Vector d3(J_func->Height());
+  drdU_symmetric.AssembleDiagonal(d3);
+  EXPECT_NEAR(0., mfem::Vector(d1 - d3).Norml2() / d1.Norml2(), 1.e-13);
+
+  // and assembled with a dim x dim block for each pair of nodes, from either kind of element matrices
+  for (bool symmetric : {true, false}) {
+    residual.SetSymmetricGradient(0, symmetric);
+    auto         K_blocks = drdU_symmetric.assemble_blocks();
+    mfem::Vector g5(U.Size());
+    K_blocks->Mult(U, g5);
+    EXPECT_NEAR(0., mfem::Vector(g1 - g5).Norml2() / g1.Norml2(), 1.e-14);
+  }
+
+  // and with only the couplings between the same components, whose action on a single component of U is that
+  // component of the full gradient's action (the true dofs are ordered by nodes, one component after the other)
+  auto      K_components = drdU_symmetric.assemble_component_blocks();
+  const int num_nodes    = U.Size() / dim;
+  for (int c = 0; c < dim; c++) {
+    mfem::Vector U_c(U.Size());
+    U_c = 0.0;
+    for (int i = c * num_nodes; i < (c + 1) * num_nodes; i++) {
+      U_c[i] = U[i];
+    }
+
+    mfem::Vector g6 = (*K_components) * U_c;
+    mfem::Vector g7 = (*J_func) * U_c;
+    for (int i = 0; i < U.Size(); i++) {
+      if (i / num_nodes != c) g7[i] = 0.0;
+    }
+    EXPECT_NEAR(0., mfem::Vector(g6 - g7).Norml2() / g7.Norml2(), 1.e-14);
+  }
 }
 
 // this test sets up part of a toy "magnetic diffusion" problem where the residual includes contributions
@@ -199,6 +199,25 @@ void functional_test(H1<p> test, H1<p> trial, Dimension<dim>)
 
   std::cout << "Functional:" << serac::accelerator::getCUDAMemInfoString() << std::endl;
 
+  // evaluating the elements in batches (instead of through E-vectors for the whole mesh) gives the same results
+  residual.SetElementBatchSize(7);
+
+  mfem::Vector r3 = residual(U);
+  EXPECT_NEAR(0., mfem::Vector(r2 - r3).Norml2() / r2.Norml2(), 1.e-14);
+
+  mfem::Operator& grad3 = residual.GetGradient(U);
+  mfem::Vector    g3    = grad3 * U;
+  EXPECT_NEAR(0., mfem::Vector(g2 - g3).Norml2() / g2.Norml2(), 1.e-14);
+
+  std::cout << "Functional (batched):" << serac::accelerator::getCUDAMemInfoString() << std::endl;
+
+  // the matrix assembled on the device has the same action
+  auto [r4, drdU] = residual(serac::differentiate_wrt(U));
+
+  std::unique_ptr<mfem::HypreParMatrix> K  = assemble(drdU);
+  mfem::Vector                          g4 = (*K) * U;
+  EXPECT_NEAR(0., mfem::Vector(g1 - g4).Norml2() / g1.Norml2(), 1.e-13);
+
   serac::profiling::finalize();
 }
 
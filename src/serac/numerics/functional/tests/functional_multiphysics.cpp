@@ -80,6 +80,540 @@ TEST(FunctionalMultiphysics, NonlinearThermalTest3D)
   check_gradient(residual, U, dU_dt);
 }
 
+TEST(FunctionalMultiphysics, SimultaneousDerivatives3D)
+{
+  int serial_refinement   = 1;
+  int parallel_refinement = 0;
+
+  constexpr auto p   = 2;
+  constexpr auto dim = 3;
+
+  std::string meshfile = SERAC_REPO_DIR "/data/meshes/patch3D_tets_and_hexes.mesh";
+  auto        mesh3D   = mesh::refineAndDistribute(buildMeshFromFile(meshfile), serial_refinement, parallel_refinement);
+
+  auto                        fec = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace fespace(mesh3D.get(), &fec);
+
+  mfem::Vector U(fespace.TrueVSize());
+  mfem::Vector dU_dt(fespace.TrueVSize());
+  mfem::Vector dU(fespace.TrueVSize());
+  int          seed = 0;
+  U.Randomize(seed);
+  dU_dt.Randomize(seed + 1);
+  dU.Randomize(seed + 2);
+
+  using test_space  = H1<p>;
+  using trial_space = H1<p>;
+
+  Functional<test_space(trial_space, trial_space)> residual(&fespace, {&fespace, &fespace});
+
+  residual.AddVolumeIntegral(
+      DependsOn<0, 1>{},
+      [=](auto x, auto temperature, auto dtemperature_dt) {
+        auto [u, du_dx]      = temperature;
+        auto [du_dt, unused] = dtemperature_dt;
+        auto source          = u * du_dt * du_dt - (100 * x[0] * x[1]);
+        auto flux            = (1.0 + u * u) * du_dx;
+        return serac::tuple{source, flux};
+      },
+      *mesh3D);
+
+  residual.AddSurfaceIntegral(
+      DependsOn<0, 1>{},
+      [=](auto x, auto /*n*/, auto temperature, auto dtemperature_dt) {
+        auto [u, _0]     = temperature;
+        auto [du_dt, _1] = dtemperature_dt;
+        return x[0] + x[1] - cos(u) * du_dt;
+      },
+      *mesh3D);
+
+  // differentiate w.r.t. one argument at a time
+  auto         dr_du_expected = get<1>(residual(differentiate_wrt(U), dU_dt));
+  mfem::Vector jvp_u_expected = dr_du_expected(dU);
+
+  auto         dr_dudt_expected  = get<1>(residual(U, differentiate_wrt(dU_dt)));
+  mfem::Vector jvp_dudt_expected = dr_dudt_expected(dU);
+
+  mfem::Vector r_expected = residual(U, dU_dt);
+
+  // and w.r.t. both arguments in the same evaluation
+  auto [r, dr_du, dr_dudt] = residual(differentiate_wrt(U), differentiate_wrt(dU_dt));
+
+  EXPECT_LT(r.DistanceTo(r_expected.GetData()) / r_expected.Norml2(), 1.0e-14);
+
+  mfem::Vector jvp_u = dr_du(dU);
+  EXPECT_LT(jvp_u.DistanceTo(jvp_u_expected.GetData()) / jvp_u_expected.Norml2(), 1.0e-14);
+
+  mfem::Vector jvp_dudt = dr_dudt(dU);
+  EXPECT_LT(jvp_dudt.DistanceTo(jvp_dudt_expected.GetData()) / jvp_dudt_expected.Norml2(), 1.0e-14);
+}
+
+TEST(FunctionalMultiphysics, CombinedGradientAssembly3D)
+{
+  int serial_refinement   = 1;
+  int parallel_refinement = 0;
+
+  constexpr auto p   = 2;
+  constexpr auto dim = 3;
+
+  std::string meshfile = SERAC_REPO_DIR "/data/meshes/patch3D_tets_and_hexes.mesh";
+  auto        mesh3D   = mesh::refineAndDistribute(buildMeshFromFile(meshfile), serial_refinement, parallel_refinement);
+
+  auto                        fec = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace fespace(mesh3D.get(), &fec);
+
+  mfem::Vector U(fespace.TrueVSize());
+  mfem::Vector dU_dt(fespace.TrueVSize());
+  mfem::Vector dU(fespace.TrueVSize());
+  int          seed = 0;
+  U.Randomize(seed);
+  dU_dt.Randomize(seed + 1);
+  dU.Randomize(seed + 2);
+
+  using test_space  = H1<p>;
+  using trial_space = H1<p>;
+
+  Functional<test_space(trial_space, trial_space)> residual(&fespace, {&fespace, &fespace});
+
+  residual.AddVolumeIntegral(
+      DependsOn<0, 1>{},
+      [=](auto x, auto temperature, auto dtemperature_dt) {
+        auto [u, du_dx]      = temperature;
+        auto [du_dt, unused] = dtemperature_dt;
+        auto source          = u * du_dt * du_dt - (100 * x[0] * x[1]);
+        auto flux            = (1.0 + u * u) * du_dx;
+        return serac::tuple{source, flux};
+      },
+      *mesh3D);
+
+  constexpr double alpha = 1.0;
+  constexpr double beta  = 0.25;
+
+  std::unique_ptr<mfem::HypreParMatrix> J;
+  std::unique_ptr<mfem::HypreParMatrix> J_cached;
+
+  // the second assembly refreshes the values of J in place
+  for (int i = 0; i < 2; i++) {
+    auto [r, dr_du, dr_dudt] = residual(differentiate_wrt(U), differentiate_wrt(dU_dt));
+
+    assemble(alpha, dr_dudt, beta, dr_du, J);
+
+    mfem::Vector jvp_expected = dr_dudt(dU);
+    jvp_expected *= alpha;
+    jvp_expected.Add(beta, dr_du(dU));
+
+    mfem::Vector jvp(J->Height());
+    J->Mult(dU, jvp);
+
+    EXPECT_LT(jvp.DistanceTo(jvp_expected.GetData()) / jvp_expected.Norml2(), 1.0e-12);
+
+    // the same combination, with the first term given by its cached rank-local values
+    assemble(alpha, dr_dudt.local_values(), beta, dr_du, J_cached);
+    J_cached->Mult(dU, jvp);
+
+    EXPECT_LT(jvp.DistanceTo(jvp_expected.GetData()) / jvp_expected.Norml2(), 1.0e-12);
+
+    U *= 1.1;
+  }
+}
+
+TEST(FunctionalMultiphysics, CachedArgument3D)
+{
+  int serial_refinement   = 1;
+  int parallel_refinement = 0;
+
+  constexpr auto p   = 2;
+  constexpr auto dim = 3;
+
+  std::string meshfile = SERAC_REPO_DIR "/data/meshes/patch3D_tets_and_hexes.mesh";
+  auto        mesh3D   = mesh::refineAndDistribute(buildMeshFromFile(meshfile), serial_refinement, parallel_refinement);
+
+  auto                        fec = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace fespace(mesh3D.get(), &fec);
+
+  mfem::Vector U(fespace.TrueVSize());
+  mfem::Vector dU_dt(fespace.TrueVSize());
+  mfem::Vector dU(fespace.TrueVSize());
+  int          seed = 0;
+  U.Randomize(seed);
+  dU_dt.Randomize(seed + 1);
+  dU.Randomize(seed + 2);
+
+  using test_space  = H1<p>;
+  using trial_space = H1<p>;
+
+  auto volume_qf = [=](auto x, auto temperature, auto dtemperature_dt) {
+    auto [u, du_dx]      = temperature;
+    auto [du_dt, unused] = dtemperature_dt;
+    auto source          = u * du_dt * du_dt - (100 * x[0] * x[1]);
+    auto flux            = (1.0 + u * u) * du_dx;
+    return serac::tuple{source, flux};
+  };
+
+  auto surface_qf = [=](auto x, auto /*n*/, auto temperature, auto dtemperature_dt) {
+    auto [u, _0]     = temperature;
+    auto [du_dt, _1] = dtemperature_dt;
+    return x[0] + x[1] - cos(u) * du_dt;
+  };
+
+  Functional<test_space(trial_space, trial_space)> residual(&fespace, {&fespace, &fespace});
+  residual.AddVolumeIntegral(DependsOn<0, 1>{}, volume_qf, *mesh3D);
+  residual.AddSurfaceIntegral(DependsOn<0, 1>{}, surface_qf, *mesh3D);
+
+  Functional<test_space(trial_space, trial_space)> residual_cached(&fespace, {&fespace, &fespace});
+  residual_cached.AddVolumeIntegral(DependsOn<0, 1>{}, volume_qf, *mesh3D);
+  residual_cached.AddSurfaceIntegral(DependsOn<0, 1>{}, surface_qf, *mesh3D);
+  residual_cached.SetCachedArgument(1);
+
+  // the cached argument's values are computed in the first evaluation, and reused in the others,
+  // until that argument changes
+  for (int i = 0; i < 3; i++) {
+    if (i == 2) dU_dt *= 0.5;
+
+    mfem::Vector r_expected = residual(U, dU_dt);
+    mfem::Vector r          = residual_cached(U, dU_dt);
+    EXPECT_LT(r.DistanceTo(r_expected.GetData()) / r_expected.Norml2(), 1.0e-14);
+
+    mfem::Vector jvp_expected = get<1>(residual(differentiate_wrt(U), dU_dt))(dU);
+    mfem::Vector jvp          = get<1>(residual_cached(differentiate_wrt(U), dU_dt))(dU);
+    EXPECT_LT(jvp.DistanceTo(jvp_expected.GetData()) / jvp_expected.Norml2(), 1.0e-14);
+
+    mfem::Vector jvp_dudt_expected = get<1>(residual(U, differentiate_wrt(dU_dt)))(dU);
+    mfem::Vector jvp_dudt          = get<1>(residual_cached(U, differentiate_wrt(dU_dt)))(dU);
+    EXPECT_LT(jvp_dudt.DistanceTo(jvp_dudt_expected.GetData()) / jvp_dudt_expected.Norml2(), 1.0e-14);
+
+    U *= 1.1;
+  }
+}
+
+TEST(FunctionalMultiphysics, Memoization3D)
+{
+  int serial_refinement   = 1;
+  int parallel_refinement = 0;
+
+  constexpr auto p   = 2;
+  constexpr auto dim = 3;
+
+  std::string meshfile = SERAC_REPO_DIR "/data/meshes/patch3D_tets_and_hexes.mesh";
+  auto        mesh3D   = mesh::refineAndDistribute(buildMeshFromFile(meshfile), serial_refinement, parallel_refinement);
+
+  auto                        fec = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace fespace(mesh3D.get(), &fec);
+
+  mfem::Vector U(fespace.TrueVSize());
+  mfem::Vector dU_dt(fespace.TrueVSize());
+  mfem::Vector dU(fespace.TrueVSize());
+  int          seed = 0;
+  U.Randomize(seed);
+  dU_dt.Randomize(seed + 1);
+  dU.Randomize(seed + 2);
+
+  using test_space  = H1<p>;
+  using trial_space = H1<p>;
+
+  auto volume_qf = [=](auto x, auto temperature, auto dtemperature_dt) {
+    auto [u, du_dx]      = temperature;
+    auto [du_dt, unused] = dtemperature_dt;
+    auto source          = u * du_dt * du_dt - (100 * x[0] * x[1]);
+    auto flux            = (1.0 + u * u) * du_dx;
+    return serac::tuple{source, flux};
+  };
+
+  Functional<test_space(trial_space, trial_space)> residual(&fespace, {&fespace, &fespace});
+  residual.AddVolumeIntegral(DependsOn<0, 1>{}, volume_qf, *mesh3D);
+
+  Functional<test_space(trial_space, trial_space)> residual_memoized(&fespace, {&fespace, &fespace});
+  residual_memoized.AddVolumeIntegral(DependsOn<0, 1>{}, volume_qf, *mesh3D);
+  residual_memoized.SetMemoization(0);
+
+  // each residual evaluation is followed by a gradient evaluation at the same arguments (which reuses it),
+  // and both have to match those of the functional that evaluates them separately
+  for (int i = 0; i < 3; i++) {
+    if (i == 2) dU_dt *= 0.5;
+
+    mfem::Vector r_expected = residual(U, dU_dt);
+    mfem::Vector r          = residual_memoized(U, dU_dt);
+    EXPECT_LT(r.DistanceTo(r_expected.GetData()) / r_expected.Norml2(), 1.0e-14);
+
+    auto [r2_expected, dR_dU_expected] = residual(differentiate_wrt(U), dU_dt);
+    auto [r2, dR_dU]                   = residual_memoized(differentiate_wrt(U), dU_dt);
+    EXPECT_LT(r2.DistanceTo(r2_expected.GetData()) / r2_expected.Norml2(), 1.0e-14);
+
+    mfem::Vector jvp_expected = dR_dU_expected(dU);
+    mfem::Vector jvp          = dR_dU(dU);
+    EXPECT_LT(jvp.DistanceTo(jvp_expected.GetData()) / jvp_expected.Norml2(), 1.0e-14);
+
+    // a derivative w.r.t. another argument isn't memoized
+    mfem::Vector jvp_dudt_expected = get<1>(residual(U, differentiate_wrt(dU_dt)))(dU);
+    mfem::Vector jvp_dudt          = get<1>(residual_memoized(U, differentiate_wrt(dU_dt)))(dU);
+    EXPECT_LT(jvp_dudt.DistanceTo(jvp_dudt_expected.GetData()) / jvp_dudt_expected.Norml2(), 1.0e-14);
+
+    U *= 1.1;
+  }
+}
+
+TEST(FunctionalMultiphysics, GradientCaching3D)
+{
+  int serial_refinement   = 1;
+  int parallel_refinement = 0;
+
+  constexpr auto p   = 2;
+  constexpr auto dim = 3;
+
+  std::string meshfile = SERAC_REPO_DIR "/data/meshes/patch3D_tets_and_hexes.mesh";
+  auto        mesh3D   = mesh::refineAndDistribute(buildMeshFromFile(meshfile), serial_refinement, parallel_refinement);
+
+  auto                        fec = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace fespace(mesh3D.get(), &fec);
+
+  mfem::Vector U(fespace.TrueVSize());
+  mfem::Vector dU_dt(fespace.TrueVSize());
+  mfem::Vector adjoint(fespace.TrueVSize());
+  int          seed = 0;
+  U.Randomize(seed);
+  dU_dt.Randomize(seed + 1);
+  adjoint.Randomize(seed + 2);
+
+  using space = H1<p>;
+
+  auto volume_qf = [=](auto x, auto temperature, auto dtemperature_dt) {
+    auto [u, du_dx]      = temperature;
+    auto [du_dt, unused] = dtemperature_dt;
+    auto source          = u * du_dt * du_dt - (100 * x[0] * x[1]);
+    auto flux            = (1.0 + u * u) * du_dx;
+    return serac::tuple{source, flux};
+  };
+
+  Functional<space(space, space)> residual(&fespace, {&fespace, &fespace});
+  residual.AddVolumeIntegral(DependsOn<0, 1>{}, volume_qf, *mesh3D);
+
+  Functional<space(space, space)> residual_cached(&fespace, {&fespace, &fespace});
+  residual_cached.AddVolumeIntegral(DependsOn<0, 1>{}, volume_qf, *mesh3D);
+  residual_cached.SetGradientCaching(1);
+
+  // the derivatives w.r.t. the second argument are applied to several adjoints at the same point, with residual
+  // evaluations (and derivatives w.r.t. the first argument) in between, which mustn't overwrite them
+  for (int i = 0; i < 3; i++) {
+    if (i == 2) dU_dt *= 0.5;
+
+    for (int j = 0; j < 2; j++) {
+      mfem::Vector vjp_expected(fespace.TrueVSize());
+      mfem::Vector vjp(fespace.TrueVSize());
+      get<1>(residual(U, differentiate_wrt(dU_dt))).MultTranspose(adjoint, vjp_expected);
+
+      auto [r, dR_dUdt] = residual_cached(U, differentiate_wrt(dU_dt));
+      dR_dUdt.MultTranspose(adjoint, vjp);
+      EXPECT_LT(vjp.DistanceTo(vjp_expected.GetData()) / vjp_expected.Norml2(), 1.0e-14);
+
+      mfem::Vector r_expected = residual(U, dU_dt);
+      EXPECT_LT(r.DistanceTo(r_expected.GetData()) / r_expected.Norml2(), 1.0e-14);
+
+      residual_cached(U, dU_dt);
+      get<1>(residual_cached(differentiate_wrt(U), dU_dt))(adjoint);
+
+      adjoint *= -2.0;
+    }
+
+    U *= 1.1;
+  }
+}
+
+// derivatives w.r.t. an argument that none of the outputs depend on are zero by construction,
+// so they aren't stored, and their actions do nothing
+TEST(FunctionalMultiphysics, StructurallyZeroDerivatives3D)
+{
+  static_assert(detail::is_structurally_zero_v<tuple<zero, tuple<zero, zero>>>);
+  static_assert(!detail::is_structurally_zero_v<tuple<zero, tuple<double, zero>>>);
+
+  int serial_refinement   = 1;
+  int parallel_refinement = 0;
+
+  constexpr auto p   = 2;
+  constexpr auto dim = 3;
+
+  std::string meshfile = SERAC_REPO_DIR "/data/meshes/patch3D_tets_and_hexes.mesh";
+  auto        mesh3D   = mesh::refineAndDistribute(buildMeshFromFile(meshfile), serial_refinement, parallel_refinement);
+
+  auto                        fec = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace fespace(mesh3D.get(), &fec);
+
+  mfem::Vector U(fespace.TrueVSize());
+  mfem::Vector V(fespace.TrueVSize());
+  mfem::Vector dU(fespace.TrueVSize());
+  U.Randomize(0);
+  V.Randomize(1);
+  dU.Randomize(2);
+
+  using space = H1<p>;
+
+  // the q-function is given the second argument, but doesn't use it
+  auto volume_qf = [=](auto /*x*/, auto temperature, auto /*unused*/) {
+    auto [u, du_dx] = temperature;
+    return serac::tuple{u * u, (1.0 + u) * du_dx};
+  };
+
+  Functional<space(space, space)> residual(&fespace, {&fespace, &fespace});
+  residual.AddVolumeIntegral(DependsOn<0, 1>{}, volume_qf, *mesh3D);
+
+  mfem::Vector r_expected = residual(U, V);
+
+  auto [r, dr_dv] = residual(U, differentiate_wrt(V));
+  EXPECT_LT(r.DistanceTo(r_expected.GetData()) / r_expected.Norml2(), 1.0e-14);
+
+  mfem::Vector jvp = dr_dv(dU);
+  EXPECT_EQ(jvp.Normlinf(), 0.0);
+
+  mfem::Vector vjp(fespace.TrueVSize());
+  dr_dv.MultTranspose(dU, vjp);
+  EXPECT_EQ(vjp.Normlinf(), 0.0);
+
+  // and the derivatives w.r.t. the other argument are unaffected, also when computed together with them
+  auto [r2, dr_du, dr_dv2] = residual(differentiate_wrt(U), differentiate_wrt(V));
+  EXPECT_LT(r2.DistanceTo(r_expected.GetData()) / r_expected.Norml2(), 1.0e-14);
+
+  mfem::Vector jvp_u_expected = get<1>(residual(differentiate_wrt(U), V))(dU);
+  mfem::Vector jvp_u          = dr_du(dU);
+  EXPECT_LT(jvp_u.DistanceTo(jvp_u_expected.GetData()) / jvp_u_expected.Norml2(), 1.0e-14);
+  EXPECT_EQ(mfem::Vector(dr_dv2(dU)).Normlinf(), 0.0);
+}
+
+TEST(FunctionalMultiphysics, QuadraturePointArgument3D)
+{
+  int serial_refinement   = 1;
+  int parallel_refinement = 0;
+
+  constexpr auto p   = 2;
+  constexpr auto dim = 3;
+
+  std::string meshfile = SERAC_REPO_DIR "/data/meshes/patch3D_hexes.mesh";
+  auto        mesh3D   = mesh::refineAndDistribute(buildMeshFromFile(meshfile), serial_refinement, parallel_refinement);
+
+  auto                        fec = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace fespace(mesh3D.get(), &fec);
+
+  // a piecewise constant conductivity, which is the same whether interpolated or given at the quadrature points
+  auto                        L2fec = mfem::L2_FECollection(0, dim, mfem::BasisType::GaussLobatto);
+  mfem::ParFiniteElementSpace L2fespace(mesh3D.get(), &L2fec);
+
+  constexpr size_t qpts_per_element = (p + 1) * (p + 1) * (p + 1);
+  auto             num_elements     = size_t(mesh3D->GetNE());
+  auto             conductivity_q   = std::make_shared<QuadratureData<double>>(num_elements, qpts_per_element);
+
+  mfem::Vector K(L2fespace.TrueVSize());
+  for (int e = 0; e < mesh3D->GetNE(); e++) {
+    K(e) = 1.0 + 0.1 * (e % 7);
+    for (size_t q = 0; q < qpts_per_element; q++) {
+      (*conductivity_q)(size_t(e), q) = K(e);
+    }
+  }
+
+  mfem::Vector U(fespace.TrueVSize());
+  mfem::Vector dU(fespace.TrueVSize());
+  U.Randomize(0);
+  dU.Randomize(1);
+
+  using space = H1<p>;
+
+  auto volume_qf = [=](auto /*x*/, auto temperature, auto conductivity) {
+    auto [u, du_dx] = temperature;
+    auto [k, dk_dx] = conductivity;
+    return serac::tuple{u * u, k * (1.0 + u * u) * du_dx};
+  };
+
+  Functional<space(space, L2<0>)> residual(&fespace, {&fespace, &L2fespace});
+  residual.AddVolumeIntegral(DependsOn<0, 1>{}, volume_qf, *mesh3D);
+
+  Functional<space(space, L2<0>)> residual_q(&fespace, {&fespace, &L2fespace});
+  residual_q.AddVolumeIntegral(DependsOn<0, 1>{}, volume_qf, *mesh3D);
+  residual_q.SetQuadraturePointArgument(1, conductivity_q);
+
+  // the dofs of the argument given at the quadrature points are ignored
+  mfem::Vector ignored(L2fespace.TrueVSize());
+  ignored = 0.0;
+
+  mfem::Vector r_expected = residual(U, K);
+  mfem::Vector r          = residual_q(U, ignored);
+  EXPECT_LT(r.DistanceTo(r_expected.GetData()) / r_expected.Norml2(), 1.0e-14);
+
+  mfem::Vector jvp_expected = get<1>(residual(differentiate_wrt(U), K))(dU);
+  mfem::Vector jvp          = get<1>(residual_q(differentiate_wrt(U), ignored))(dU);
+  EXPECT_LT(jvp.DistanceTo(jvp_expected.GetData()) / jvp_expected.Norml2(), 1.0e-14);
+
+  // and the values are read again in each evaluation
+  K *= 2.0;
+  for (size_t q = 0; q < conductivity_q->size; q++) {
+    conductivity_q->data[q] *= 2.0;
+  }
+  r_expected = residual(U, K);
+  r          = residual_q(U, ignored);
+  EXPECT_LT(r.DistanceTo(r_expected.GetData()) / r_expected.Norml2(), 1.0e-14);
+}
+
+TEST(FunctionalMultiphysics, GradientTranspose3D)
+{
+  int serial_refinement   = 1;
+  int parallel_refinement = 0;
+
+  constexpr auto p   = 2;
+  constexpr auto dim = 3;
+
+  std::string meshfile = SERAC_REPO_DIR "/data/meshes/patch3D_tets_and_hexes.mesh";
+  auto        mesh3D   = mesh::refineAndDistribute(buildMeshFromFile(meshfile), serial_refinement, parallel_refinement);
+
+  auto                        fec = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace fespace(mesh3D.get(), &fec);
+  mfem::ParFiniteElementSpace vector_fespace(mesh3D.get(), &fec, dim);
+
+  mfem::Vector U(fespace.TrueVSize());
+  mfem::Vector V(vector_fespace.TrueVSize());
+  mfem::Vector adjoint(fespace.TrueVSize());
+  int          seed = 0;
+  U.Randomize(seed);
+  V.Randomize(seed + 1);
+  adjoint.Randomize(seed + 2);
+
+  // the gradient w.r.t. the vector-valued argument is rectangular
+  Functional<H1<p>(H1<p>, H1<p, dim>)> residual(&fespace, {&fespace, &vector_fespace});
+
+  residual.AddVolumeIntegral(
+      DependsOn<0, 1>{},
+      [=](auto x, auto temperature, auto velocity) {
+        auto [u, du_dx] = temperature;
+        auto [v, dv_dx] = velocity;
+        auto source     = dot(v, du_dx) + u * tr(dv_dx) - x[0];
+        auto flux       = (1.0 + u * u) * du_dx + dot(dv_dx, v);
+        return serac::tuple{source, flux};
+      },
+      *mesh3D);
+
+  residual.AddSurfaceIntegral(
+      DependsOn<0, 1>{},
+      [=](auto x, auto n, auto temperature, auto velocity) {
+        auto [u, _0] = temperature;
+        auto [v, _1] = velocity;
+        return x[0] + u * dot(v, n);
+      },
+      *mesh3D);
+
+  // the matrix-free vector-jacobian products agree with those of the assembled gradients
+  auto [r, dr_du, dr_dv] = residual(differentiate_wrt(U), differentiate_wrt(V));
+
+  std::unique_ptr<mfem::HypreParMatrix> dr_du_matrix = assemble(dr_du);
+  std::unique_ptr<mfem::HypreParMatrix> dr_dv_matrix = assemble(dr_dv);
+
+  mfem::Vector vjp_u(fespace.TrueVSize());
+  mfem::Vector vjp_u_expected(fespace.TrueVSize());
+  dr_du.MultTranspose(adjoint, vjp_u);
+  dr_du_matrix->MultTranspose(adjoint, vjp_u_expected);
+  EXPECT_LT(vjp_u.DistanceTo(vjp_u_expected.GetData()) / vjp_u_expected.Norml2(), 1.0e-12);
+
+  mfem::Vector vjp_v(vector_fespace.TrueVSize());
+  mfem::Vector vjp_v_expected(vector_fespace.TrueVSize());
+  dr_dv.MultTranspose(adjoint, vjp_v);
+  dr_dv_matrix->MultTranspose(adjoint, vjp_v_expected);
+  EXPECT_LT(vjp_v.DistanceTo(vjp_v_expected.GetData()) / vjp_v_expected.Norml2(), 1.0e-12);
+}
+
 int main(int argc, char* argv[])
 {
   int num_procs, myid;
@@ -4,6 +4,7 @@
 //
 // SPDX-License-Identifier: (BSD-3-Clause)
 
+#include <cstring>
 #include <fstream>
 #include <iostream>
 
@@ -19,6 +20,7 @@
 #include "serac/numerics/functional/functional.hpp"
 #include "serac/numerics/functional/tensor.hpp"
 #include "serac/infrastructure/profiling.hpp"
+#include "serac/physics/state/finite_element_state.hpp"
 
 #include "serac/numerics/functional/tests/check_gradient.hpp"
 
@@ -140,6 +142,920 @@ void functional_test(mfem::ParMesh& mesh, H1<p, dim> test, H1<p, dim> trial, Dim
   serac::profiling::finalize();
 }
 
+// this test checks that opting in to single-precision storage of the q-function derivatives
+// only perturbs the gradient calculations at the level of single-precision roundoff
+template <int p, int dim>
+void single_precision_derivatives_test(mfem::ParMesh& mesh)
+{
+  auto                        fec = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace fespace(&mesh, &fec, dim);
+
+  mfem::Vector U(fespace.TrueVSize());
+  U.Randomize();
+
+  mfem::Vector dU(fespace.TrueVSize());
+  dU.Randomize(1);
+
+  using space = H1<p, dim>;
+
+  auto qf = [=](auto /*x*/, auto displacement) {
+    auto [u, du_dx] = displacement;
+    auto source     = a * u * u[0];
+    auto flux       = b * dot(du_dx, transpose(du_dx)) + du_dx;
+    return serac::tuple{source, flux};
+  };
+
+  Functional<space(space)> residual(&fespace, {&fespace});
+  residual.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, qf, mesh);
+
+  Functional<space(space)> residual_sp(&fespace, {&fespace});
+  residual_sp.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, with_single_precision_derivatives(qf), mesh);
+
+  auto [r, drdU]       = residual(differentiate_wrt(U));
+  auto [r_sp, drdU_sp] = residual_sp(differentiate_wrt(U));
+
+  // the residual itself is always evaluated in double precision
+  EXPECT_NEAR(0., r.DistanceTo(r_sp.GetData()) / r.Norml2(), 1.e-14);
+
+  mfem::Vector jvp    = drdU(dU);
+  mfem::Vector jvp_sp = drdU_sp(dU);
+  EXPECT_NEAR(0., jvp.DistanceTo(jvp_sp.GetData()) / jvp.Norml2(), 1.e-6);
+
+  std::unique_ptr<mfem::HypreParMatrix> K    = assemble(drdU);
+  std::unique_ptr<mfem::HypreParMatrix> K_sp = assemble(drdU_sp);
+
+  mfem::Vector Kv(jvp.Size()), Kv_sp(jvp.Size());
+  K->Mult(dU, Kv);
+  K_sp->Mult(dU, Kv_sp);
+  EXPECT_NEAR(0., Kv.DistanceTo(Kv_sp.GetData()) / Kv.Norml2(), 1.e-6);
+}
+
+// this test checks that storing the derivatives of a linear isotropic q-function as isotropic tensors
+// gives the same gradients as storing them densely
+template <int p, int dim>
+void isotropic_derivatives_test(mfem::ParMesh& mesh)
+{
+  auto                        fec = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace fespace(&mesh, &fec, dim);
+
+  mfem::Vector U(fespace.TrueVSize());
+  U.Randomize();
+
+  mfem::Vector dU(fespace.TrueVSize());
+  dU.Randomize(1);
+
+  using space = H1<p, dim>;
+
+  auto qf = [=](auto /*x*/, auto displacement) {
+    auto [u, du_dx] = displacement;
+    auto source     = a * u;
+    auto flux       = a * tr(du_dx) * Identity<dim>() + b * (du_dx + transpose(du_dx));
+    return serac::tuple{source, flux};
+  };
+
+  Functional<space(space)> residual(&fespace, {&fespace});
+  residual.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, qf, mesh);
+
+  Functional<space(space)> residual_iso(&fespace, {&fespace});
+  residual_iso.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, with_isotropic_derivatives(qf), mesh);
+
+  auto [r, drdU]         = residual(differentiate_wrt(U));
+  auto [r_iso, drdU_iso] = residual_iso(differentiate_wrt(U));
+  EXPECT_NEAR(0., r.DistanceTo(r_iso.GetData()) / r.Norml2(), 1.e-14);
+
+  mfem::Vector jvp     = drdU(dU);
+  mfem::Vector jvp_iso = drdU_iso(dU);
+  EXPECT_NEAR(0., jvp.DistanceTo(jvp_iso.GetData()) / jvp.Norml2(), 1.e-12);
+
+  std::unique_ptr<mfem::HypreParMatrix> K     = assemble(drdU);
+  std::unique_ptr<mfem::HypreParMatrix> K_iso = assemble(drdU_iso);
+
+  mfem::Vector Kv(jvp.Size()), Kv_iso(jvp.Size());
+  K->Mult(dU, Kv);
+  K_iso->Mult(dU, Kv_iso);
+  EXPECT_NEAR(0., Kv.DistanceTo(Kv_iso.GetData()) / Kv.Norml2(), 1.e-12);
+}
+
+// this test checks that a linear q-function declared to have constant derivatives
+// gives the same gradients as one whose derivatives are stored at each quadrature point
+template <int p, int dim>
+void constant_derivatives_test(mfem::ParMesh& mesh)
+{
+  auto                        fec = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace fespace(&mesh, &fec, dim);
+
+  mfem::Vector U(fespace.TrueVSize());
+  U.Randomize();
+
+  mfem::Vector dU(fespace.TrueVSize());
+  dU.Randomize(1);
+
+  using space = H1<p, dim>;
+
+  auto qf = [=](auto /*x*/, auto displacement) {
+    auto [u, du_dx] = displacement;
+    auto source     = a * u + dot(du_dx, tensor<double, dim>{1.0});
+    auto flux       = a * tr(du_dx) * Identity<dim>() + b * du_dx + transpose(du_dx);
+    return serac::tuple{source, flux};
+  };
+
+  Functional<space(space)> residual(&fespace, {&fespace});
+  residual.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, qf, mesh);
+
+  Functional<space(space)> residual_c(&fespace, {&fespace});
+  residual_c.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, with_constant_derivatives(qf), mesh);
+
+  auto [r, drdU]     = residual(differentiate_wrt(U));
+  auto [r_c, drdU_c] = residual_c(differentiate_wrt(U));
+  EXPECT_NEAR(0., r.DistanceTo(r_c.GetData()) / r.Norml2(), 1.e-14);
+
+  mfem::Vector jvp   = drdU(dU);
+  mfem::Vector jvp_c = drdU_c(dU);
+  EXPECT_NEAR(0., jvp.DistanceTo(jvp_c.GetData()) / jvp.Norml2(), 1.e-12);
+
+  std::unique_ptr<mfem::HypreParMatrix> K   = assemble(drdU);
+  std::unique_ptr<mfem::HypreParMatrix> K_c = assemble(drdU_c);
+
+  mfem::Vector Kv(jvp.Size()), Kv_c(jvp.Size());
+  K->Mult(dU, Kv);
+  K_c->Mult(dU, Kv_c);
+  EXPECT_NEAR(0., Kv.DistanceTo(Kv_c.GetData()) / Kv.Norml2(), 1.e-12);
+}
+
+// this test checks that recomputing the q-function derivatives (instead of storing them)
+// gives the same gradients, even if the functional is evaluated elsewhere in the meantime
+template <int p, int dim>
+void recomputed_derivatives_test(mfem::ParMesh& mesh)
+{
+  auto                        fec = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace fespace(&mesh, &fec, dim);
+
+  mfem::Vector U(fespace.TrueVSize());
+  U.Randomize();
+
+  mfem::Vector dU(fespace.TrueVSize());
+  dU.Randomize(1);
+
+  using space = H1<p, dim>;
+
+  auto qf = [=](auto /*x*/, auto displacement) {
+    auto [u, du_dx] = displacement;
+    auto source     = a * u * u[0];
+    auto flux       = b * dot(du_dx, transpose(du_dx)) + du_dx;
+    return serac::tuple{source, flux};
+  };
+
+  auto bdr_qf = [=](auto x, auto /*n*/, auto displacement) {
+    auto u = get<0>(displacement);
+    return a * u * dot(u, u) + x;
+  };
+
+  Functional<space(space)> residual(&fespace, {&fespace});
+  residual.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, qf, mesh);
+  residual.AddBoundaryIntegral(Dimension<dim - 1>{}, DependsOn<0>{}, bdr_qf, mesh);
+
+  Functional<space(space)> residual_rc(&fespace, {&fespace});
+  residual_rc.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, with_recomputed_derivatives(qf), mesh);
+  residual_rc.AddBoundaryIntegral(Dimension<dim - 1>{}, DependsOn<0>{}, with_recomputed_derivatives(bdr_qf), mesh);
+
+  auto [r, drdU]       = residual(differentiate_wrt(U));
+  auto [r_rc, drdU_rc] = residual_rc(differentiate_wrt(U));
+  EXPECT_NEAR(0., r.DistanceTo(r_rc.GetData()) / r.Norml2(), 1.e-14);
+
+  // evaluating the residual somewhere else should not affect the linearization point
+  mfem::Vector U2(fespace.TrueVSize());
+  U2.Randomize(2);
+  residual_rc(U2);
+
+  mfem::Vector jvp    = drdU(dU);
+  mfem::Vector jvp_rc = drdU_rc(dU);
+  EXPECT_NEAR(0., jvp.DistanceTo(jvp_rc.GetData()) / jvp.Norml2(), 1.e-12);
+
+  std::unique_ptr<mfem::HypreParMatrix> K    = assemble(drdU);
+  std::unique_ptr<mfem::HypreParMatrix> K_rc = assemble(drdU_rc);
+
+  mfem::Vector Kv(jvp.Size()), Kv_rc(jvp.Size());
+  K->Mult(dU, Kv);
+  K_rc->Mult(dU, Kv_rc);
+  EXPECT_NEAR(0., Kv.DistanceTo(Kv_rc.GetData()) / Kv.Norml2(), 1.e-12);
+}
+
+// this test checks that the results don't depend on how many elements
+// are processed at a time by the fused gather / evaluate / scatter-add loop
+template <int p, int dim>
+void element_batch_size_test(mfem::ParMesh& mesh)
+{
+  auto                        fec = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace fespace(&mesh, &fec, dim);
+
+  mfem::Vector U(fespace.TrueVSize());
+  U.Randomize();
+
+  mfem::Vector dU(fespace.TrueVSize());
+  dU.Randomize(1);
+
+  using space = H1<p, dim>;
+
+  auto qf = [=](auto /*x*/, auto displacement) {
+    auto [u, du_dx] = displacement;
+    auto source     = a * u * u[0];
+    auto flux       = b * dot(du_dx, transpose(du_dx)) + du_dx;
+    return serac::tuple{source, flux};
+  };
+
+  auto bdr_qf = [=](auto x, auto /*n*/, auto displacement) {
+    auto u = get<0>(displacement);
+    return a * u * dot(u, u) + x;
+  };
+
+  std::vector<mfem::Vector> residuals, jvps;
+  for (uint32_t batch_size : {1u, 3u, 1000000u}) {
+    Functional<space(space)> residual(&fespace, {&fespace});
+    residual.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, qf, mesh);
+    residual.AddBoundaryIntegral(Dimension<dim - 1>{}, DependsOn<0>{}, bdr_qf, mesh);
+    residual.SetElementBatchSize(batch_size);
+
+    auto [r, drdU] = residual(differentiate_wrt(U));
+    residuals.push_back(r);
+    jvps.push_back(drdU(dU));
+  }
+
+  for (std::size_t i = 1; i < residuals.size(); i++) {
+    EXPECT_NEAR(0., residuals[i].DistanceTo(residuals[0].GetData()) / residuals[0].Norml2(), 1.e-14);
+    EXPECT_NEAR(0., jvps[i].DistanceTo(jvps[0].GetData()) / jvps[0].Norml2(), 1.e-14);
+  }
+}
+
+template <int p, int dim>
+void simd_element_batching_test(mfem::ParMesh& mesh)
+{
+  auto                        fec = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace fespace(&mesh, &fec, dim);
+
+  mfem::Vector U(fespace.TrueVSize());
+  U.Randomize();
+  U *= 0.1;
+
+  mfem::Vector dU(fespace.TrueVSize());
+  dU.Randomize(1);
+
+  using space = H1<p, dim>;
+
+  // a branch-free, neo-hookean-like q-function
+  auto qf = [=](auto x, auto displacement) {
+    auto [u, du_dx] = displacement;
+    auto F          = du_dx + Identity<dim>();
+    auto J          = det(F);
+    auto source     = a * u * u[0] + x * exp(-dot(x, x));
+    auto flux       = b * (dot(F, transpose(F)) - Identity<dim>()) / J + log(J) * inv(transpose(F));
+    return serac::tuple{source, flux};
+  };
+
+  Functional<space(space)> reference(&fespace, {&fespace});
+  reference.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, qf, mesh);
+
+  Functional<space(space)> batched(&fespace, {&fespace});
+  batched.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, with_simd_element_batching<4>(qf), mesh);
+
+  mfem::Vector r0 = reference(U);
+  mfem::Vector r1 = batched(U);
+  EXPECT_NEAR(0., r1.DistanceTo(r0.GetData()) / r0.Norml2(), 1.e-14);
+
+  // derivatives are still evaluated one quadrature point at a time
+  auto [r2, drdU0] = reference(differentiate_wrt(U));
+  auto [r3, drdU1] = batched(differentiate_wrt(U));
+  mfem::Vector jvp0 = drdU0(dU);
+  mfem::Vector jvp1 = drdU1(dU);
+  EXPECT_NEAR(0., r3.DistanceTo(r2.GetData()) / r2.Norml2(), 1.e-14);
+  EXPECT_NEAR(0., jvp1.DistanceTo(jvp0.GetData()) / jvp0.Norml2(), 1.e-14);
+}
+
+// this test checks that applying the gradient to several directions at once
+// gives the same results as applying it to each direction separately
+template <int p, int dim>
+void multiple_directions_test(mfem::ParMesh& mesh)
+{
+  auto                        fec = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace fespace(&mesh, &fec, dim);
+
+  mfem::Vector U(fespace.TrueVSize());
+  U.Randomize();
+
+  constexpr int     num_directions = 4;
+  mfem::DenseMatrix dU(fespace.TrueVSize(), num_directions);
+  for (int d = 0; d < num_directions; d++) {
+    mfem::Vector column(dU.GetColumn(d), dU.Height());
+    column.Randomize(d + 1);
+  }
+
+  using space = H1<p, dim>;
+
+  auto qf = [=](auto /*x*/, auto displacement) {
+    auto [u, du_dx] = displacement;
+    auto source     = a * u * u[0];
+    auto flux       = b * dot(du_dx, transpose(du_dx)) + du_dx;
+    return serac::tuple{source, flux};
+  };
+
+  auto bdr_qf = [=](auto x, auto /*n*/, auto displacement) {
+    auto u = get<0>(displacement);
+    return a * u * dot(u, u) + x;
+  };
+
+  Functional<space(space)> residual(&fespace, {&fespace});
+  residual.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, qf, mesh);
+  residual.AddBoundaryIntegral(Dimension<dim - 1>{}, DependsOn<0>{}, bdr_qf, mesh);
+
+  Functional<space(space)> residual_rc(&fespace, {&fespace});
+  residual_rc.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, with_recomputed_derivatives(qf), mesh);
+  residual_rc.AddBoundaryIntegral(Dimension<dim - 1>{}, DependsOn<0>{}, with_recomputed_derivatives(bdr_qf), mesh);
+
+  auto [r, drdU]       = residual(differentiate_wrt(U));
+  auto [r_rc, drdU_rc] = residual_rc(differentiate_wrt(U));
+
+  mfem::DenseMatrix jvps, jvps_rc;
+  drdU.Mult(dU, jvps);
+  drdU_rc.Mult(dU, jvps_rc);
+
+  for (int d = 0; d < num_directions; d++) {
+    mfem::Vector column(dU.GetColumn(d), dU.Height());
+    mfem::Vector jvp = drdU(column);
+
+    mfem::Vector jvp_block(jvps.GetColumn(d), jvps.Height());
+    mfem::Vector jvp_block_rc(jvps_rc.GetColumn(d), jvps_rc.Height());
+    EXPECT_NEAR(0., jvp_block.DistanceTo(jvp.GetData()) / jvp.Norml2(), 1.e-14);
+    EXPECT_NEAR(0., jvp_block_rc.DistanceTo(jvp.GetData()) / jvp.Norml2(), 1.e-12);
+  }
+}
+
+// this test checks that the directional derivatives computed in a single pass, propagating several directions
+// through each q-function evaluation, match those from differentiating w.r.t. each argument separately
+template <int p, int dim>
+void directional_derivatives_test(mfem::ParMesh& mesh)
+{
+  auto                        fec = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace fespace(&mesh, &fec);
+
+  auto                        param_fec = mfem::H1_FECollection(1, dim);
+  mfem::ParFiniteElementSpace param_fespace(&mesh, &param_fec);
+
+  mfem::Vector U(fespace.TrueVSize()), dU(fespace.TrueVSize());
+  mfem::Vector K(param_fespace.TrueVSize()), dK(param_fespace.TrueVSize());
+  mfem::Vector C(param_fespace.TrueVSize()), dC(param_fespace.TrueVSize());
+  U.Randomize(1);
+  dU.Randomize(2);
+  K.Randomize(3);
+  dK.Randomize(4);
+  C.Randomize(5);
+  dC.Randomize(6);
+
+  using space       = H1<p>;
+  using param_space = H1<1>;
+
+  auto qf = [=](auto /*x*/, auto temperature, auto conductivity, auto capacity) {
+    auto [u, du_dx] = temperature;
+    auto k          = get<0>(conductivity);
+    auto c          = get<0>(capacity);
+    return serac::tuple{c * u * u, (1.0 + k * k) * du_dx};
+  };
+
+  auto bdr_qf = [=](auto /*x*/, auto /*n*/, auto temperature, auto conductivity, auto capacity) {
+    return get<0>(temperature) * get<0>(conductivity) * get<0>(capacity);
+  };
+
+  // two directions per evaluation, so that the three directions below take two passes
+  Functional<space(space, param_space, param_space)> residual(&fespace, {&fespace, &param_fespace, &param_fespace});
+  residual.AddDomainIntegral(Dimension<dim>{}, DependsOn<0, 1, 2>{}, with_directional_derivatives<2>(qf), mesh);
+  residual.AddBoundaryIntegral(Dimension<dim - 1>{}, DependsOn<0, 1, 2>{}, with_directional_derivatives<2>(bdr_qf),
+                               mesh);
+
+  std::vector<mfem::Vector> derivatives;
+  mfem::Vector r = residual.DirectionalDerivatives({0, 1, 2}, {&dU, &dK, &dC}, derivatives, U, K, C);
+
+  auto [r0, dr_dU] = residual(differentiate_wrt(U), K, C);
+  auto [r1, dr_dK] = residual(U, differentiate_wrt(K), C);
+  auto [r2, dr_dC] = residual(U, K, differentiate_wrt(C));
+
+  mfem::Vector expected[] = {dr_dU(dU), dr_dK(dK), dr_dC(dC)};
+
+  EXPECT_NEAR(0., r.DistanceTo(r0.GetData()) / r0.Norml2(), 1.e-14);
+  ASSERT_EQ(derivatives.size(), 3);
+  for (int d = 0; d < 3; d++) {
+    EXPECT_NEAR(0., derivatives[d].DistanceTo(expected[d].GetData()) / expected[d].Norml2(), 1.e-13);
+  }
+}
+
+// this test checks that a Functional with constrained (essential) dofs produces the same residual and
+// assembled gradient as eliminating those dofs after evaluation and assembly
+template <int p, int dim>
+void constrained_assembly_test(mfem::ParMesh& mesh)
+{
+  auto                        fec = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace fespace(&mesh, &fec, dim);
+
+  mfem::Vector U(fespace.TrueVSize());
+  U.Randomize();
+
+  mfem::Vector dU(fespace.TrueVSize());
+  dU.Randomize(1);
+
+  mfem::Array<int> ess_bdr(mesh.bdr_attributes.Max());
+  ess_bdr    = 0;
+  ess_bdr[0] = 1;
+  mfem::Array<int> constrained_dofs;
+  fespace.GetEssentialTrueDofs(ess_bdr, constrained_dofs);
+
+  using space = H1<p, dim>;
+
+  auto qf = [=](auto /*x*/, auto displacement) {
+    auto [u, du_dx] = displacement;
+    auto source     = a * u * u[0];
+    auto flux       = b * dot(du_dx, transpose(du_dx)) + du_dx;
+    return serac::tuple{source, flux};
+  };
+
+  Functional<space(space)> residual(&fespace, {&fespace});
+  residual.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, qf, mesh);
+
+  mfem::Vector r_expected = residual(U);
+  r_expected.SetSubVector(constrained_dofs, 0.0);
+
+  auto [r, drdU]  = residual(differentiate_wrt(U));
+  auto J_expected = assemble(drdU);
+  J_expected->EliminateBC(constrained_dofs, mfem::Operator::DiagonalPolicy::DIAG_ONE);
+  mfem::Vector jvp_expected(fespace.TrueVSize());
+  J_expected->Mult(dU, jvp_expected);
+
+  residual.SetEssentialTrueDofs(constrained_dofs);
+  residual.constrain_essential_dofs = true;
+
+  mfem::Vector r_constrained = residual(U);
+  EXPECT_NEAR(0., r_constrained.DistanceTo(r_expected.GetData()) / r_expected.Norml2(), 1.e-14);
+
+  // the second assembly refreshes the values of J in place
+  std::unique_ptr<mfem::HypreParMatrix> J;
+  for (int i = 0; i < 2; i++) {
+    assemble(drdU, J);
+
+    mfem::Vector jvp(fespace.TrueVSize());
+    J->Mult(dU, jvp);
+    EXPECT_NEAR(0., jvp.DistanceTo(jvp_expected.GetData()) / jvp_expected.Norml2(), 1.e-12);
+  }
+}
+
+// this test checks that splitting a domain integral into integrals over the elements with each attribute
+// (one of them with quadrature point data for only its elements) gives the same residual and gradient
+template <int p, int dim>
+void element_subset_test(const mfem::ParMesh& original_mesh)
+{
+  // every third element gets its own attribute, so the elements of each attribute are not all consecutive
+  mfem::ParMesh mesh(original_mesh);
+  size_t        num_special_elements = 0;
+  for (int e = 0; e < mesh.GetNE(); e++) {
+    mesh.SetAttribute(e, (e % 3 == 0) ? 2 : 1);
+    num_special_elements += (e % 3 == 0);
+  }
+  mesh.SetAttributes();
+
+  auto                        fec = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace fespace(&mesh, &fec, dim);
+
+  mfem::Vector U(fespace.TrueVSize());
+  U.Randomize();
+
+  mfem::Vector dU(fespace.TrueVSize());
+  dU.Randomize(1);
+
+  using space = H1<p, dim>;
+
+  auto qf = [=](auto /*x*/, auto displacement) {
+    auto [u, du_dx] = displacement;
+    auto source     = a * u * u[0];
+    auto flux       = b * dot(du_dx, transpose(du_dx)) + du_dx;
+    return serac::tuple{source, flux};
+  };
+
+  auto qf_with_state = [=](auto x, double& state, auto displacement) {
+    auto [source, flux] = qf(x, displacement);
+    return serac::tuple{state * source, state * flux};
+  };
+
+  // note: the elements of each geometry index the quadrature data separately
+  constexpr auto geom            = (dim == 2) ? mfem::Geometry::SQUARE : mfem::Geometry::CUBE;
+  size_t         qpts_per_element = GaussQuadratureRule<geom, p + 1>().size();
+  auto           qdata            = std::make_shared<QuadratureData<double>>(num_special_elements, qpts_per_element);
+  for (size_t i = 0; i < qdata->size; i++) {
+    qdata->data[i] = 1.0;
+  }
+
+  Functional<space(space)> residual(&fespace, {&fespace});
+  residual.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, qf, mesh);
+
+  Functional<space(space)> split_residual(&fespace, {&fespace});
+  split_residual.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, qf, mesh, {1});
+  split_residual.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, qf_with_state, mesh, {2}, qdata);
+
+  auto [r, drdU]             = residual(differentiate_wrt(U));
+  auto [split_r, split_drdU] = split_residual(differentiate_wrt(U));
+  EXPECT_NEAR(0., split_r.DistanceTo(r.GetData()) / r.Norml2(), 1.e-13);
+
+  mfem::Vector jvp       = drdU(dU);
+  mfem::Vector split_jvp = split_drdU(dU);
+  EXPECT_NEAR(0., split_jvp.DistanceTo(jvp.GetData()) / jvp.Norml2(), 1.e-13);
+
+  auto         J       = assemble(drdU);
+  auto         split_J = assemble(split_drdU);
+  mfem::Vector assembled_jvp(fespace.TrueVSize());
+  split_J->Mult(dU, assembled_jvp);
+  J->Mult(dU, jvp);
+  EXPECT_NEAR(0., assembled_jvp.DistanceTo(jvp.GetData()) / jvp.Norml2(), 1.e-13);
+}
+
+// this test checks that evaluating incrementally, i.e. only re-evaluating the elements whose dofs changed,
+// gives the same residual (and gradient) as evaluating every element
+template <int p, int dim>
+void incremental_evaluation_test(mfem::ParMesh& mesh)
+{
+  auto                        fec = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace fespace(&mesh, &fec, dim);
+
+  mfem::Vector U(fespace.TrueVSize());
+  U.Randomize();
+
+  mfem::Vector dU(fespace.TrueVSize());
+  dU.Randomize(1);
+
+  using space = H1<p, dim>;
+
+  auto qf = [=](auto /*x*/, auto displacement) {
+    auto [u, du_dx] = displacement;
+    auto source     = a * u * u[0];
+    auto flux       = b * dot(du_dx, transpose(du_dx)) + du_dx;
+    return serac::tuple{source, flux};
+  };
+
+  auto bdr_qf = [=](auto x, auto /*n*/, auto displacement) {
+    auto u = get<0>(displacement);
+    return a * u * dot(u, u) + x;
+  };
+
+  Functional<space(space)> residual(&fespace, {&fespace});
+  residual.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, qf, mesh);
+  residual.AddBoundaryIntegral(Dimension<dim - 1>{}, DependsOn<0>{}, bdr_qf, mesh);
+
+  Functional<space(space)> incremental_residual(&fespace, {&fespace});
+  incremental_residual.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, qf, mesh);
+  incremental_residual.AddBoundaryIntegral(Dimension<dim - 1>{}, DependsOn<0>{}, bdr_qf, mesh);
+  incremental_residual.SetIncrementalEvaluation(true);
+
+  // the first evaluation evaluates every element, the later ones only those near the perturbed dofs
+  for (int step = 0; step < 3; step++) {
+    for (int i = step; i < U.Size(); i += 17) {
+      U[i] += 0.1;
+    }
+
+    auto [r, drdU]                         = residual(differentiate_wrt(U));
+    auto [incremental_r, incremental_drdU] = incremental_residual(differentiate_wrt(U));
+    EXPECT_NEAR(0., incremental_r.DistanceTo(r.GetData()) / r.Norml2(), 1.e-13);
+
+    mfem::Vector jvp             = drdU(dU);
+    mfem::Vector incremental_jvp = incremental_drdU(dU);
+    EXPECT_NEAR(0., incremental_jvp.DistanceTo(jvp.GetData()) / jvp.Norml2(), 1.e-13);
+  }
+}
+
+// this test checks that evaluating into caller-provided buffers gives the same residual as operator(),
+// and that evaluations with different workspaces don't interfere with each other
+template <int p, int dim>
+void workspace_evaluation_test(mfem::ParMesh& mesh)
+{
+  auto                        fec = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace fespace(&mesh, &fec, dim);
+
+  mfem::Vector U1(fespace.TrueVSize());
+  U1.Randomize();
+
+  mfem::Vector U2(fespace.TrueVSize());
+  U2.Randomize(1);
+
+  using space = H1<p, dim>;
+
+  auto qf = [=](auto /*x*/, auto displacement) {
+    auto [u, du_dx] = displacement;
+    auto source     = a * u * u[0];
+    auto flux       = b * dot(du_dx, transpose(du_dx)) + du_dx;
+    return serac::tuple{source, flux};
+  };
+
+  auto bdr_qf = [=](auto x, auto /*n*/, auto displacement) {
+    auto u = get<0>(displacement);
+    return a * u * dot(u, u) + x;
+  };
+
+  Functional<space(space)> residual(&fespace, {&fespace});
+  residual.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, qf, mesh);
+  residual.AddBoundaryIntegral(Dimension<dim - 1>{}, DependsOn<0>{}, bdr_qf, mesh);
+  residual.SetElementBatchSize(5);
+
+  mfem::Vector r1 = residual(U1);
+  mfem::Vector r2 = residual(U2);
+
+  Functional<space(space)>::Workspace workspace1, workspace2;
+  mfem::Vector                        output1, output2;
+  residual.Evaluate(workspace1, output1, U1);
+  residual.Evaluate(workspace2, output2, U2);
+  EXPECT_NEAR(0., output1.DistanceTo(r1.GetData()) / r1.Norml2(), 1.e-14);
+  EXPECT_NEAR(0., output2.DistanceTo(r2.GetData()) / r2.Norml2(), 1.e-14);
+
+  // the workspaces are reused by later evaluations
+  residual.Evaluate(workspace2, output1, U1);
+  EXPECT_NEAR(0., output1.DistanceTo(r1.GetData()) / r1.Norml2(), 1.e-14);
+
+  // as is the caller's vector, when operator() writes into it directly
+  residual.Mult(output2, U1);
+  EXPECT_NEAR(0., output2.DistanceTo(r1.GetData()) / r1.Norml2(), 1.e-14);
+}
+
+// this test checks that precomputing the inverse jacobians at each quadrature point
+// gives the same residual and gradient as computing them in every evaluation
+template <int p, int dim>
+void precomputed_inverse_jacobians_test(mfem::ParMesh& mesh)
+{
+  auto                        fec = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace fespace(&mesh, &fec, dim);
+
+  mfem::Vector U(fespace.TrueVSize());
+  mfem::Vector dU(fespace.TrueVSize());
+  U.Randomize();
+  dU.Randomize(1);
+
+  using space = H1<p, dim>;
+
+  auto qf = [=](auto /*x*/, auto displacement) {
+    auto [u, du_dx] = displacement;
+    auto source     = a * u * u[0];
+    auto flux       = b * dot(du_dx, transpose(du_dx)) + du_dx;
+    return serac::tuple{source, flux};
+  };
+
+  Functional<space(space)> residual(&fespace, {&fespace});
+  residual.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, qf, mesh);
+
+  Functional<space(space)> precomputed_residual(&fespace, {&fespace});
+  precomputed_residual.SetPrecomputedInverseJacobians(true);
+  precomputed_residual.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, qf, mesh);
+
+  auto [r, drdU]                         = residual(differentiate_wrt(U));
+  auto [precomputed_r, precomputed_drdU] = precomputed_residual(differentiate_wrt(U));
+  EXPECT_NEAR(0., precomputed_r.DistanceTo(r.GetData()) / r.Norml2(), 1.e-13);
+
+  mfem::Vector jvp             = drdU(dU);
+  mfem::Vector precomputed_jvp = precomputed_drdU(dU);
+  EXPECT_NEAR(0., precomputed_jvp.DistanceTo(jvp.GetData()) / jvp.Norml2(), 1.e-13);
+}
+
+// this test checks that integrals over the same elements share their geometric factors,
+// and that they are recomputed if the mesh nodes have moved in the meantime
+TEST(SharedGeometricFactors, 3D)
+{
+  auto hex = shared_geometric_factors(mesh3D.get(), 2, mfem::Geometry::CUBE);
+  EXPECT_EQ(hex, shared_geometric_factors(mesh3D.get(), 2, mfem::Geometry::CUBE));
+  EXPECT_NE(hex, shared_geometric_factors(mesh3D.get(), 3, mfem::Geometry::CUBE));
+
+  auto quad = shared_geometric_factors(mesh3D.get(), 2, mfem::Geometry::SQUARE, FaceType::BOUNDARY);
+  EXPECT_EQ(quad, shared_geometric_factors(mesh3D.get(), 2, mfem::Geometry::SQUARE, FaceType::BOUNDARY));
+
+  mfem::GridFunction* nodes = mesh3D->GetNodes();
+  *nodes *= 2.0;
+  auto moved_hex = shared_geometric_factors(mesh3D.get(), 2, mfem::Geometry::CUBE);
+  *nodes *= 0.5;
+
+  EXPECT_NE(hex, moved_hex);
+
+  mfem::Vector expected(hex->X);
+  expected *= 2.0;
+  EXPECT_NEAR(0., moved_hex->X.DistanceTo(expected.GetData()) / expected.Norml2(), 1.e-14);
+}
+
+// this test checks that the discontinuous nodes of a periodic mesh, which are gathered without an element
+// restriction, give the same geometric factors as the continuous nodes of the mesh it was made from
+TEST(PeriodicGeometricFactors, 3D)
+{
+  auto mesh = mfem::Mesh::MakeCartesian3D(3, 3, 2, mfem::Element::HEXAHEDRON, 1.0, 1.0, 0.5);
+
+  std::vector<mfem::Vector> translations = {mfem::Vector({1.0, 0.0, 0.0}), mfem::Vector({0.0, 1.0, 0.0})};
+  auto periodic_mesh = mfem::Mesh::MakePeriodic(mesh, mesh.CreatePeriodicVertexMapping(translations, 1.0e-8));
+  periodic_mesh.SetCurvature(1, true, -1, mfem::Ordering::byNODES);
+  mesh.SetCurvature(1, false, -1, mfem::Ordering::byNODES);
+
+  GeometricFactors continuous(&mesh, 2, mfem::Geometry::CUBE);
+  GeometricFactors periodic(&periodic_mesh, 2, mfem::Geometry::CUBE);
+
+  ASSERT_EQ(periodic.num_elements, continuous.num_elements);
+  EXPECT_NEAR(0., periodic.X.DistanceTo(continuous.X.GetData()) / continuous.X.Norml2(), 1.e-14);
+  EXPECT_NEAR(0., periodic.J.DistanceTo(continuous.J.GetData()) / continuous.J.Norml2(), 1.e-14);
+}
+
+// this test checks that straight-sided tets are detected as affine, with the same jacobian as
+// the one stored at each of their quadrature points
+TEST(AffineGeometricFactors, 3D)
+{
+  constexpr int dim           = 3;
+  constexpr int q             = 2;
+  auto          tet           = shared_geometric_factors(mesh3D.get(), q, mfem::Geometry::TETRAHEDRON);
+  int           qpts_per_elem = num_quadrature_points(mfem::Geometry::TETRAHEDRON, q);
+  ASSERT_TRUE(tet->affine);
+  ASSERT_EQ(tet->affine_jacobians.Size(), int(tet->num_elements) * int(sizeof(AffineJacobian<dim>) / sizeof(double)));
+
+  auto          affine = reinterpret_cast<const AffineJacobian<dim>*>(tet->affine_jacobians.HostRead());
+  const double* J      = tet->J.HostRead();
+  for (int e = 0; e < int(tet->num_elements); e++) {
+    EXPECT_NEAR(affine[e].det_J, det(affine[e].J), 1.0e-14 * std::abs(affine[e].det_J));
+    EXPECT_LT(norm(dot(affine[e].J, affine[e].inv_J) - DenseIdentity<dim>()), 1.0e-12);
+    for (int k = 0; k < qpts_per_elem; k++) {
+      for (int i = 0; i < dim; i++) {
+        for (int j = 0; j < dim; j++) {
+          EXPECT_NEAR(affine[e].J[i][j], J[((e * dim + j) * dim + i) * qpts_per_elem + k], 1.0e-12);
+        }
+      }
+    }
+  }
+}
+
+// this test checks that tentative quadrature data updates are only visible once committed,
+// and that rolling them back leaves the committed data untouched
+TEST(QuadratureData, TentativeUpdates)
+{
+  QuadratureData<double> qdata(2, 3);
+  for (size_t i = 0; i < qdata.size; i++) {
+    qdata.data[i] = 1.0;
+  }
+  qdata.enableTentativeUpdates();
+
+  auto write = [&](double value) {
+    qdata.markUpdated();
+    for (size_t e = 0; e < 2; e++) {
+      for (size_t q = 0; q < 3; q++) {
+        qdata.updated(e)[q] = value;
+      }
+    }
+  };
+
+  write(2.0);
+  EXPECT_EQ(qdata(1, 2), 1.0);
+
+  // a rejected step
+  qdata.rollback();
+  qdata.commit();
+  EXPECT_EQ(qdata(1, 2), 1.0);
+
+  write(3.0);
+  qdata.commit();
+  EXPECT_EQ(qdata(0, 0), 3.0);
+  EXPECT_EQ(qdata(1, 2), 3.0);
+
+  // committing again without new updates keeps the committed data
+  qdata.commit();
+  EXPECT_EQ(qdata(1, 2), 3.0);
+}
+
+// this test checks that each element of a changed mesh takes the quadrature data of its source element
+TEST(QuadratureData, Remap)
+{
+  QuadratureData<double> qdata(2, 3);
+  for (size_t q = 0; q < 3; q++) {
+    qdata(0, q) = 1.0;
+    qdata(1, q) = 2.0;
+  }
+  qdata.enableTentativeUpdates();
+
+  qdata.remap({1, 1, 0});
+  EXPECT_EQ(qdata.size, 9);
+  EXPECT_EQ(qdata(0, 2), 2.0);
+  EXPECT_EQ(qdata(1, 0), 2.0);
+  EXPECT_EQ(qdata(2, 1), 1.0);
+
+  // the tentative buffer is resized along with the data
+  qdata.markUpdated();
+  qdata.updated(2)[0] = 3.0;
+  qdata.commit();
+  EXPECT_EQ(qdata(2, 0), 3.0);
+  EXPECT_EQ(qdata(0, 0), 2.0);
+}
+
+// this test checks that the structure-of-arrays layout stores each component contiguously over the quadrature
+// points, and that it behaves like the default layout when read, updated, and remapped
+TEST(QuadratureData, StructureOfArrays)
+{
+  struct State {
+    double            plastic_strain;
+    tensor<double, 2> back_stress;
+  };
+
+  QuadratureData<SoA<State>> qdata(2, 3);
+  for (size_t e = 0; e < 2; e++) {
+    for (size_t q = 0; q < 3; q++) {
+      qdata(e, q) = State{double(e), {double(q), 1.0}};
+    }
+  }
+
+  // the plastic strains come first, then the first and second components of the back stresses
+  std::uint64_t bits;
+  double        value = 1.0;
+  std::memcpy(&bits, &value, sizeof(double));
+  EXPECT_EQ(qdata.data[3], bits);
+  value = 2.0;
+  std::memcpy(&bits, &value, sizeof(double));
+  EXPECT_EQ(qdata.data[qdata.size + 5], bits);
+
+  qdata.enableTentativeUpdates();
+  qdata.markUpdated();
+  detail::store_qdata(qdata.updated(1), 2, State{4.0, {5.0, 6.0}});
+  EXPECT_EQ(State(qdata(1, 2)).plastic_strain, 1.0);
+  qdata.commit();
+  EXPECT_EQ(State(qdata(1, 2)).plastic_strain, 4.0);
+  EXPECT_EQ(detail::load_qdata(qdata.at(1), 2).back_stress[1], 6.0);
+
+  qdata.remap({1, 0, 1});
+  EXPECT_EQ(qdata.size, 9);
+  EXPECT_EQ(State(qdata(0, 2)).back_stress[0], 5.0);
+  EXPECT_EQ(State(qdata(1, 1)).plastic_strain, 0.0);
+  EXPECT_EQ(State(qdata(2, 1)).back_stress[0], 1.0);
+  EXPECT_EQ(State(qdata(2, 0)).back_stress[1], 1.0);
+}
+
+// this test refines (and then derefines) part of a mesh, and checks that a Functional rebuilt with the updated
+// state and quadrature data evaluates the same integral as on the original mesh
+TEST(Functional, UpdateAfterLocalRefinement)
+{
+  constexpr int p    = 2;
+  auto          mesh = mesh::refineAndDistribute(buildRectangleMesh(4, 4), 0, 0);
+
+  FiniteElementState        u(*mesh, FiniteElementState::Options{.order = p, .name = "u"});
+  mfem::FunctionCoefficient quadratic([](const mfem::Vector& x) { return x(0) * x(0) + x(1); });
+  u.project(quadratic);
+
+  // the material state is 1 on the left half of the square, and 2 on the right half
+  auto qdata = std::make_shared<QuadratureData<double>>(size_t(mesh->GetNE()), size_t((p + 1) * (p + 1)));
+  for (int e = 0; e < mesh->GetNE(); e++) {
+    mfem::Vector center;
+    mesh->GetElementCenter(e, center);
+    for (size_t q = 0; q < qdata->stride; q++) {
+      (*qdata)(size_t(e), q) = (center(0) < 0.5) ? 1.0 : 2.0;
+    }
+  }
+
+  Functional<H1<p>(H1<p>)> residual(&u.space(), {&u.space()});
+  residual.AddDomainIntegral(
+      Dimension<2>{}, DependsOn<0>{},
+      [](auto /* x */, auto& state, auto temperature) {
+        auto [T, dT_dx] = temperature;
+        return serac::tuple{state + 0.0 * T, 0.0 * dT_dx};
+      },
+      *mesh, qdata);
+
+  // the residual sums to the integral of the material state, as the test functions are a partition of unity
+  auto integral = [&]() {
+    double local = residual(u).Sum();
+    double total = 0.0;
+    MPI_Allreduce(&local, &total, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    return total;
+  };
+  EXPECT_NEAR(integral(), 1.5, 1.0e-12);
+
+  // refine the elements near the origin, twice
+  for (int level = 0; level < 2; level++) {
+    mfem::Array<int> marked;
+    for (int e = 0; e < mesh->GetNE(); e++) {
+      mfem::Vector center;
+      mesh->GetElementCenter(e, center);
+      if (center.Norml2() < 0.5) {
+        marked.Append(e);
+      }
+    }
+    qdata->remap(mesh::refineMarkedElements(*mesh, marked));
+    u.updateSpace();
+    residual.Update();
+  }
+  EXPECT_TRUE(mesh->Nonconforming());
+  EXPECT_GT(mesh->GetGlobalNE(), 16);
+  EXPECT_EQ(qdata->size, size_t(mesh->GetNE()) * qdata->stride);
+  EXPECT_NEAR(integral(), 1.5, 1.0e-12);
+  EXPECT_NEAR(computeL2Error(u, quadratic), 0.0, 1.0e-12);
+
+  // derefine everything again, one level at a time
+  for (int level = 0; level < 2; level++) {
+    mfem::Vector error(mesh->GetNE());
+    error = 0.0;
+    qdata->remap(mesh::derefineElements(*mesh, error, 1.0));
+    u.updateSpace();
+    residual.Update();
+  }
+  EXPECT_EQ(mesh->GetGlobalNE(), 16);
+  EXPECT_NEAR(integral(), 1.5, 1.0e-12);
+  EXPECT_NEAR(computeL2Error(u, quadratic), 0.0, 1.0e-10);
+}
+
 TEST(Thermal, 2DLinear) { functional_test(*mesh2D, H1<1>{}, H1<1>{}, Dimension<2>{}); }
 TEST(Thermal, 2DQuadratic) { functional_test(*mesh2D, H1<2>{}, H1<2>{}, Dimension<2>{}); }
 TEST(Thermal, 2DCubic) { functional_test(*mesh2D, H1<3>{}, H1<3>{}, Dimension<2>{}); }
@@ -156,6 +1072,45 @@ TEST(Elasticity, 3DLinear) { functional_test(*mesh3D, H1<1, 3>{}, H1<1, 3>{}, Di
 TEST(Elasticity, 3DQuadratic) { functional_test(*mesh3D, H1<2, 3>{}, H1<2, 3>{}, Dimension<3>{}); }
 TEST(Elasticity, 3DCubic) { functional_test(*mesh3D, H1<3, 3>{}, H1<3, 3>{}, Dimension<3>{}); }
 
+TEST(SinglePrecisionDerivatives, 2DQuadratic) { single_precision_derivatives_test<2, 2>(*mesh2D); }
+TEST(SinglePrecisionDerivatives, 3DQuadratic) { single_precision_derivatives_test<2, 3>(*mesh3D); }
+
+TEST(IsotropicDerivatives, 2DQuadratic) { isotropic_derivatives_test<2, 2>(*mesh2D); }
+TEST(IsotropicDerivatives, 3DQuadratic) { isotropic_derivatives_test<2, 3>(*mesh3D); }
+
+TEST(ConstantDerivatives, 2DQuadratic) { constant_derivatives_test<2, 2>(*mesh2D); }
+TEST(ConstantDerivatives, 3DQuadratic) { constant_derivatives_test<2, 3>(*mesh3D); }
+
+TEST(RecomputedDerivatives, 2DQuadratic) { recomputed_derivatives_test<2, 2>(*mesh2D); }
+TEST(RecomputedDerivatives, 3DQuadratic) { recomputed_derivatives_test<2, 3>(*mesh3D); }
+
+TEST(ElementBatchSize, 2DQuadratic) { element_batch_size_test<2, 2>(*mesh2D); }
+TEST(ElementBatchSize, 3DQuadratic) { element_batch_size_test<2, 3>(*mesh3D); }
+
+TEST(SimdElementBatching, 2DQuadratic) { simd_element_batching_test<2, 2>(*mesh2D); }
+TEST(SimdElementBatching, 3DQuadratic) { simd_element_batching_test<2, 3>(*mesh3D); }
+
+TEST(MultipleDirections, 2DQuadratic) { multiple_directions_test<2, 2>(*mesh2D); }
+TEST(MultipleDirections, 3DQuadratic) { multiple_directions_test<2, 3>(*mesh3D); }
+
+TEST(DirectionalDerivatives, 2DQuadratic) { directional_derivatives_test<2, 2>(*mesh2D); }
+TEST(DirectionalDerivatives, 3DQuadratic) { directional_derivatives_test<2, 3>(*mesh3D); }
+
+TEST(ConstrainedAssembly, 2DQuadratic) { constrained_assembly_test<2, 2>(*mesh2D); }
+TEST(ConstrainedAssembly, 3DQuadratic) { constrained_assembly_test<2, 3>(*mesh3D); }
+
+TEST(ElementSubset, 2DQuadratic) { element_subset_test<2, 2>(*mesh2D); }
+TEST(ElementSubset, 3DQuadratic) { element_subset_test<2, 3>(*mesh3D); }
+
+TEST(IncrementalEvaluation, 2DQuadratic) { incremental_evaluation_test<2, 2>(*mesh2D); }
+TEST(IncrementalEvaluation, 3DQuadratic) { incremental_evaluation_test<2, 3>(*mesh3D); }
+
+TEST(WorkspaceEvaluation, 2DQuadratic) { workspace_evaluation_test<2, 2>(*mesh2D); }
+TEST(WorkspaceEvaluation, 3DQuadratic) { workspace_evaluation_test<2, 3>(*mesh3D); }
+
+TEST(PrecomputedInverseJacobians, 2DQuadratic) { precomputed_inverse_jacobians_test<2, 2>(*mesh2D); }
+TEST(PrecomputedInverseJacobians, 3DQuadratic) { precomputed_inverse_jacobians_test<2, 3>(*mesh3D); }
+
 int main(int argc, char* argv[])
 {
   ::testing::InitGoogleTest(&argc, argv);
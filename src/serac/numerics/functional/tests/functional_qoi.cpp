@@ -371,6 +371,81 @@ TEST(QoI, AddVolumeIntegral)
   delete tmp;
 }
 
+// the measures and first moment of the (linear) meshes are integrated exactly with 2 quadrature points per
+// dimension, fewer than the default rule for quadratic trial spaces
+template <int dim>
+void reduced_quadrature_test(mfem::ParMesh& mesh)
+{
+  constexpr int p = 2;
+
+  auto                        fec = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace fespace(&mesh, &fec);
+
+  mfem::HypreParVector* U = fespace.NewTrueDofVector();
+  *U                      = 0.0;
+
+  Functional<double(H1<p>)> measure({&fespace});
+  measure.AddDomainIntegral(
+      Dimension<dim>{}, DependsOn<>{}, QuadraturePoints<2>{}, [](auto /*x*/) { return 1.0; }, mesh);
+
+  Functional<double(H1<p>)> x_moment({&fespace});
+  x_moment.AddDomainIntegral(
+      Dimension<dim>{}, DependsOn<>{}, QuadraturePoints<2>{}, [](auto x) { return x[0]; }, mesh);
+
+  Functional<double(H1<p>)> sum_of_measures({&fespace});
+  sum_of_measures.AddDomainIntegral(
+      Dimension<dim>{}, DependsOn<>{}, QuadraturePoints<2>{}, [](auto /*x*/) { return 1.0; }, mesh);
+  sum_of_measures.AddBoundaryIntegral(
+      Dimension<dim - 1>{}, DependsOn<>{}, QuadraturePoints<2>{}, [](auto /*x*/) { return 1.0; }, mesh);
+
+  EXPECT_NEAR(0.0, (measure(*U) - measure_mfem(mesh)) / measure(*U), 1.0e-10);
+  EXPECT_NEAR(0.0, (x_moment(*U) - x_moment_mfem(mesh)) / x_moment(*U), 1.0e-10);
+  EXPECT_NEAR(0.0, (sum_of_measures(*U) - sum_of_measures_mfem(mesh)) / sum_of_measures(*U), 1.0e-10);
+
+  delete U;
+}
+
+TEST(QoI, ReducedQuadrature2D) { reduced_quadrature_test<2>(*mesh2D); }
+TEST(QoI, ReducedQuadrature3D) { reduced_quadrature_test<3>(*mesh3D); }
+
+// the quadrature rules, geometric factors and element restrictions of prisms
+TEST(QoI, Prisms)
+{
+  constexpr int p   = 2;
+  constexpr int dim = 3;
+
+  auto mesh = mesh::refineAndDistribute(buildMeshFromFile(SERAC_REPO_DIR "/data/meshes/beam-wedge.mesh"), 1, 0);
+
+  auto                        fec = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace fespace(mesh.get(), &fec);
+
+  mfem::ParGridFunction     U_gf(&fespace);
+  mfem::FunctionCoefficient x_squared([](mfem::Vector x) { return x[0] * x[0]; });
+  U_gf.ProjectCoefficient(x_squared);
+
+  mfem::HypreParVector* U = fespace.NewTrueDofVector();
+  U_gf.GetTrueDofs(*U);
+
+  Functional<double(H1<p>)> measure({&fespace});
+  measure.AddVolumeIntegral(
+      DependsOn<>{}, [](auto /*x*/) { return 1.0; }, *mesh);
+
+  Functional<double(H1<p>)> x_moment({&fespace});
+  x_moment.AddVolumeIntegral(
+      DependsOn<>{}, [](auto x) { return x[0]; }, *mesh);
+
+  // the interpolated field (x^2) is integrated exactly, as the prisms of this mesh are affine
+  Functional<double(H1<p>)> x_squared_moment({&fespace});
+  x_squared_moment.AddVolumeIntegral(
+      DependsOn<0>{}, [](auto x, auto u) { return get<0>(u) - x[0] * x[0]; }, *mesh);
+
+  EXPECT_NEAR(0.0, (measure(*U) - measure_mfem(*mesh)) / measure(*U), 1.0e-10);
+  EXPECT_NEAR(0.0, (x_moment(*U) - x_moment_mfem(*mesh)) / x_moment(*U), 1.0e-10);
+  EXPECT_NEAR(0.0, x_squared_moment(*U) / measure(*U), 1.0e-10);
+
+  delete U;
+}
+
 TEST(QoI, UsingL2)
 {
   constexpr int p   = 1;
@@ -441,6 +516,107 @@ TEST(QoI, ShapeAndParameter)
   constexpr double expected = 1.6;  // volume of 2 2x2x2 cubes == 16, so expected is 0.1 * 16
   EXPECT_NEAR(val, expected, 1.0e-14);
 }
+
+TEST(QoI, ReverseModeGradientMatchesAssembledGradient)
+{
+  constexpr int p   = 2;
+  constexpr int dim = 2;
+
+  mfem::ParMesh& mesh = *mesh2D;
+
+  auto [fespace0, fec0] = generateParFiniteElementSpace<H1<p, dim> >(&mesh);
+  auto [fespace1, fec1] = generateParFiniteElementSpace<H1<p> >(&mesh);
+
+  std::unique_ptr<mfem::HypreParVector> U0(fespace0->NewTrueDofVector());
+  U0->Randomize(0);
+
+  std::unique_ptr<mfem::HypreParVector> U1(fespace1->NewTrueDofVector());
+  U1->Randomize(1);
+
+  Functional<double(H1<p, dim>, H1<p>)> f({fespace0.get(), fespace1.get()});
+  f.AddDomainIntegral(
+      Dimension<dim>{}, DependsOn<0, 1>{},
+      [](auto x, auto displacement, auto temperature) {
+        auto [u, du_dx]      = displacement;
+        auto [theta, unused] = temperature;
+        return x[0] * theta * theta + sin(theta) * squared_norm(du_dx) + dot(u, u) * tr(du_dx);
+      },
+      mesh);
+  f.AddBoundaryIntegral(
+      Dimension<dim - 1>{}, DependsOn<0, 1>{},
+      [](auto x, auto n, auto displacement, auto temperature) {
+        auto [u, unused_u]         = displacement;
+        auto [theta, unused_theta] = temperature;
+        return dot(u, n) * exp(0.5 * theta) + x[1] * theta;
+      },
+      mesh);
+
+  // the gradients assembled from the stored q-function derivatives of a differentiated evaluation
+  // should match the ones evaluated in a single pass
+  auto expected0 = assemble(serac::get<1>(f(differentiate_wrt(*U0), *U1)));
+  auto expected1 = assemble(serac::get<1>(f(*U0, differentiate_wrt(*U1))));
+
+  auto dQ_dU0 = f.ReverseModeGradient(0, *U0, *U1);
+  auto dQ_dU1 = f.ReverseModeGradient(1, *U0, *U1);
+
+  mfem::Vector difference0(*dQ_dU0);
+  difference0 -= *expected0;
+  EXPECT_NEAR(difference0.Normlinf(), 0.0, 1.0e-12 * expected0->Normlinf());
+
+  mfem::Vector difference1(*dQ_dU1);
+  difference1 -= *expected1;
+  EXPECT_NEAR(difference1.Normlinf(), 0.0, 1.0e-12 * expected1->Normlinf());
+}
+
+TEST(QoI, GroupMatchesIndividualFunctionals)
+{
+  constexpr int p   = 1;
+  constexpr int dim = 3;
+
+  mfem::ParMesh& mesh = *mesh3D;
+
+  auto [fespace, fec] = generateParFiniteElementSpace<H1<p, dim> >(&mesh);
+
+  std::unique_ptr<mfem::HypreParVector> U(fespace->NewTrueDofVector());
+  U->Randomize(0);
+
+  auto volume     = [](auto /*x*/, auto displacement) { return det(Identity<dim>() + get<1>(displacement)); };
+  auto energy     = [](auto /*x*/, auto displacement) { return squared_norm(sym(get<1>(displacement))); };
+  auto reaction_x = [](auto /*x*/, auto /*n*/, auto displacement) { return get<0>(displacement)[0]; };
+
+  QoIGroup<double(H1<p, dim>)> qois({fespace.get()}, 3);
+  qois[0].AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, volume, mesh);
+  qois[1].AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, energy, mesh);
+  qois[2].AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, energy, mesh);
+  qois[2].AddBoundaryIntegral(Dimension<dim - 1>{}, DependsOn<0>{}, reaction_x, mesh);
+
+  Functional<double(H1<p, dim>)> f0({fespace.get()});
+  f0.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, volume, mesh);
+
+  Functional<double(H1<p, dim>)> f1({fespace.get()});
+  f1.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, energy, mesh);
+
+  Functional<double(H1<p, dim>)> f2({fespace.get()});
+  f2.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, energy, mesh);
+  f2.AddBoundaryIntegral(Dimension<dim - 1>{}, DependsOn<0>{}, reaction_x, mesh);
+
+  Functional<double(H1<p, dim>)>* individual[] = {&f0, &f1, &f2};
+
+  auto values    = qois(*U);
+  auto gradients = qois.Gradients(0, *U);
+  ASSERT_EQ(values.size(), 3);
+  ASSERT_EQ(gradients.size(), 3);
+
+  for (std::size_t q = 0; q < 3; q++) {
+    double expected = (*individual[q])(*U);
+    EXPECT_NEAR(values[q], expected, 1.0e-12 * std::abs(expected));
+
+    auto         expected_gradient = individual[q]->ReverseModeGradient(0, *U);
+    mfem::Vector difference(*gradients[q]);
+    difference -= *expected_gradient;
+    EXPECT_NEAR(difference.Normlinf(), 0.0, 1.0e-12 * expected_gradient->Normlinf());
+  }
+}
 #endif
 
 // clang-format off
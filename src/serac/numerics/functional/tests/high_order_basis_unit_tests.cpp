@@ -0,0 +1,154 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "mfem.hpp"
+#include <gtest/gtest.h>
+
+#include "axom/slic/core/SimpleLogger.hpp"
+
+#include "serac/numerics/functional/detail/metaprogramming.hpp"
+#include "serac/numerics/functional/tensor.hpp"
+#include "serac/numerics/functional/finite_element.hpp"
+#include "serac/numerics/functional/polynomials.hpp"
+#include "serac/numerics/functional/quadrature.hpp"
+
+using namespace serac;
+
+// the basis tables of the hexahedral elements are evaluated at compile time, for every (p, q)
+static_assert(finite_element<mfem::Geometry::CUBE, H1<8> >::calculate_B<false, 9>()(0, 0) != 0.0);
+static_assert(finite_element<mfem::Geometry::CUBE, H1<8> >::calculate_G<true, 9>()(8, 8) != 0.0);
+
+// an n-point Gauss-Legendre rule integrates polynomials of degree 2n-1 exactly
+template <int n>
+void verify_gauss_legendre_exactness(double tolerance)
+{
+  constexpr auto x = GaussLegendreNodes<n, mfem::Geometry::SEGMENT>();
+  constexpr auto w = GaussLegendreWeights<n, mfem::Geometry::SEGMENT>();
+  for (int k = 0; k < 2 * n; k++) {
+    double integral = 0.0;
+    for (int i = 0; i < n; i++) {
+      integral += w[i] * std::pow(x[i], k);
+    }
+    EXPECT_NEAR(integral, 1.0 / (k + 1), tolerance);
+  }
+}
+
+TEST(GaussLegendre, Exactness)
+{
+  for_constexpr<10>([](auto i) { verify_gauss_legendre_exactness<i + 1>(1.0e-14); });
+}
+
+// an n-point Gauss-Lobatto rule (with the endpoints) integrates polynomials of degree 2n-3 exactly,
+// so the interior nodes must be the roots of the derivative of the Legendre polynomial of degree n-1
+template <int n>
+void verify_gauss_lobatto_nodes(double tolerance)
+{
+  constexpr auto x = GaussLobattoNodes<n>();
+  EXPECT_EQ(x[0], 0.0);
+  EXPECT_EQ(x[n - 1], 1.0);
+  for (int i = 1; i < n - 1; i++) {
+    double t      = 2.0 * x[i] - 1.0;
+    auto   P      = Legendre<n>(t);
+    double dP_dt  = (n - 1) * (P[n - 2] - t * P[n - 1]) / (1.0 - t * t);
+    double mirror = x[n - 1 - i];
+    EXPECT_NEAR(dP_dt, 0.0, tolerance);
+    EXPECT_NEAR(x[i] + mirror, 1.0, tolerance);
+  }
+}
+
+TEST(GaussLobatto, Nodes)
+{
+  for_constexpr<8>([](auto i) { verify_gauss_lobatto_nodes<i + 2>(1.0e-13); });
+}
+
+template <int n, typename interpolation, typename derivative>
+void verify_interpolation(const tensor<double, n>& nodes, interpolation N, derivative dN_dx, double tolerance)
+{
+  constexpr double eps = 1.0e-7;
+
+  for (int i = 0; i < n; i++) {
+    EXPECT_NEAR(norm(N(nodes[i]) - DenseIdentity<n>()[i]), 0.0, tolerance);
+  }
+
+  for (double x : {0.0, 0.1234, 0.5, 0.87654, 1.0}) {
+    // partition of unity
+    double sum = 0.0;
+    for (int i = 0; i < n; i++) {
+      sum += N(x)[i];
+    }
+    EXPECT_NEAR(sum, 1.0, tolerance);
+
+    auto fd = (N(x + eps) - N(x - eps)) / (2.0 * eps);
+    EXPECT_NEAR(norm(dN_dx(x) - fd), 0.0, 1.0e-5);
+  }
+}
+
+TEST(GaussLobatto, Interpolation)
+{
+  for_constexpr<8>([](auto i) {
+    constexpr int n = i + 2;
+    verify_interpolation<n>(
+        GaussLobattoNodes<n>(), [](double x) { return GaussLobattoInterpolation<n>(x); },
+        [](double x) { return GaussLobattoInterpolationDerivative<n>(x); }, 1.0e-13);
+  });
+}
+
+TEST(GaussLegendre, Interpolation)
+{
+  for_constexpr<8>([](auto i) {
+    constexpr int n = i + 2;
+    verify_interpolation<n>(
+        GaussLegendreNodes<n, mfem::Geometry::SEGMENT>(), [](double x) { return GaussLegendreInterpolation<n>(x); },
+        [](double x) { return GaussLegendreInterpolationDerivative<n>(x); }, 1.0e-12);
+  });
+}
+
+// the mass matrix of an order-p hexahedron, integrated with p+1 points per direction, through the 3D shape functions
+// and through the 1D basis tables used by the sum-factorized kernels
+template <int p>
+void verify_hexahedron_mass(double tolerance)
+{
+  using element_type  = finite_element<mfem::Geometry::CUBE, H1<p> >;
+  constexpr int  q    = p + 1;
+  constexpr auto rule = GaussQuadratureRule<mfem::Geometry::CUBE, q>();
+  constexpr auto B    = element_type::template calculate_B<false, q>();
+  constexpr auto w1D  = GaussLegendreWeights<q, mfem::Geometry::SEGMENT>();
+
+  // the mass matrix of the 1D Gauss-Lobatto basis
+  tensor<double, p + 1, p + 1> M1D{};
+  for (int k = 0; k < q; k++) {
+    M1D += w1D[k] * outer(B[k], B[k]);
+  }
+
+  // the diagonal of the tensor product mass matrix, compared to that of the full quadrature
+  double max_error = 0.0;
+  for (int i = 0; i < element_type::ndof; i += 17) {
+    int    ix = i % (p + 1), iy = (i / (p + 1)) % (p + 1), iz = i / ((p + 1) * (p + 1));
+    double M_ii = 0.0;
+    for (int k = 0; k < q * q * q; k++) {
+      double N_i = element_type::shape_functions(rule.points[k])[i];
+      M_ii += rule.weights[k] * N_i * N_i;
+    }
+    max_error = std::max(max_error, std::abs(M_ii - M1D(ix, ix) * M1D(iy, iy) * M1D(iz, iz)));
+  }
+  EXPECT_NEAR(max_error, 0.0, tolerance);
+}
+
+TEST(HighOrderHexahedron, MassMatrix)
+{
+  verify_hexahedron_mass<4>(1.0e-14);
+  verify_hexahedron_mass<6>(1.0e-14);
+  verify_hexahedron_mass<8>(1.0e-14);
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  axom::slic::SimpleLogger logger;
+
+  return RUN_ALL_TESTS();
+}
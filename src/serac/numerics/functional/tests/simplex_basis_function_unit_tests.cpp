@@ -704,6 +704,49 @@ TEST(CubicTetrahedron, mass_integration_exact)
   verify_mass_matrix_integration<element_type, 5>(2.0e-15);
 }
 
+// the mass matrix assembled through the tabulated interpolate() and integrate() kernels,
+// one column at a time, should match the exact one
+template <typename element_type, int q>
+void verify_mass_matrix_kernels(double tolerance)
+{
+  constexpr int dim   = element_type::dim;
+  constexpr int ndof  = element_type::ndof;
+  constexpr int nqpts = num_quadrature_points(element_type::geometry, q);
+
+  TensorProductQuadratureRule<q> rule{};
+
+  tensor<double, ndof, ndof> M{};
+  for (int k = 0; k < ndof; k++) {
+    tensor<double, 1, ndof> X{};
+    X(0, k) = 1.0;
+
+    auto qf_input = element_type::interpolate(X, rule);
+
+    tensor<tuple<double, tensor<double, dim> >, nqpts> qf_output{};
+    for (int i = 0; i < nqpts; i++) {
+      get<0>(qf_output[i]) = get<0>(qf_input[i]);
+    }
+
+    tensor<double, 1, ndof> element_residual{};
+    element_type::integrate(qf_output, rule, &element_residual);
+    M[k] = element_residual[0];
+  }
+
+  auto Mexact = exact_mass_matrix<element_type>();
+
+  EXPECT_NEAR(norm(Mexact - M) / norm(Mexact), 0.0, tolerance);
+}
+
+TEST(CubicTriangle, mass_kernels)
+{
+  verify_mass_matrix_kernels<finite_element<mfem::Geometry::TRIANGLE, H1<3> >, 5>(1.0e-14);
+}
+
+TEST(CubicTetrahedron, mass_kernels)
+{
+  verify_mass_matrix_kernels<finite_element<mfem::Geometry::TETRAHEDRON, H1<3> >, 5>(1.0e-14);
+}
+
 int main(int argc, char* argv[])
 {
   ::testing::InitGoogleTest(&argc, argv);
@@ -4,6 +4,8 @@
 //
 // SPDX-License-Identifier: (BSD-3-Clause)
 
+#include <type_traits>
+
 #include <gtest/gtest.h>
 
 #include "serac/numerics/functional/tensor.hpp"
@@ -192,6 +194,55 @@ TEST(tensor, matrix_sqrt)
   EXPECT_LT(norm(Uhat - Uhat_exact), 1.0e-10);
 }
 
+TEST(Tensor, ClosedFormMatrixSqrt)
+{
+  tensor<double, 3, 3> F = {{{0.3852817904392833, 0.1735582533169708, 0.5598788687303271},
+                             {-0.04379404406828202, 0.914979929679738, 0.995874974838651},
+                             {0.1909462690511288, -0.3981402297792775, 0.864926796819512}}};
+
+  tensor<double, 3, 3> Uhat_exact = {{{0.3718851927062453, -0.0809474212888889, 0.2048642780892224},
+                                      {-0.0809474212888888, 0.967374407775298, 0.2888955723924189},
+                                      {0.2048642780892223, 0.288895572392419, 1.388488261683237}}};
+
+  EXPECT_LT(norm(matrix_sqrt(dot(transpose(F), F)) - Uhat_exact), 1.0e-13);
+
+  tensor<double, 2, 2> A = {{{2.0, 0.5}, {0.5, 1.0}}};
+  auto                 B = matrix_sqrt(A);
+  EXPECT_LT(norm(dot(B, B) - A), 1.0e-14);
+  EXPECT_LT(norm(B - transpose(B)), 1.0e-14);
+}
+
+TEST(Tensor, SymmetricEigendecomposition)
+{
+  // an exact rotation, so that A has precisely the eigenvalues prescribed below
+  double               c = std::cos(0.7), s = std::sin(0.7);
+  tensor<double, 3, 3> Rz = {{{c, -s, 0.0}, {s, c, 0.0}, {0.0, 0.0, 1.0}}};
+  tensor<double, 3, 3> Rx = {{{1.0, 0.0, 0.0}, {0.0, c, -s}, {0.0, s, c}}};
+  tensor<double, 3, 3> R  = dot(Rz, Rx);
+
+  // distinct, repeated and triply-repeated eigenvalues
+  tensor<double, 3> spectra[] = {{3.0, 1.0, 2.0}, {2.0, 1.0, 2.0}, {4.0, 4.0, 4.0}};
+  for (auto lambda : spectra) {
+    tensor<double, 3, 3> A = dot(R, dot(diag(lambda), transpose(R)));
+
+    auto [eigenvalues, Q] = eig(A);
+    EXPECT_LE(eigenvalues[0], eigenvalues[1]);
+    EXPECT_LE(eigenvalues[1], eigenvalues[2]);
+    EXPECT_LT(norm(dot(transpose(Q), Q) - DenseIdentity<3>()), 1.0e-14);
+    EXPECT_LT(norm(dot(Q, dot(diag(eigenvalues), transpose(Q))) - A), 1.0e-13);
+  }
+}
+
+TEST(Tensor, PolarDecomposition)
+{
+  tensor<double, 3, 3> F = {{{1.1, 0.2, -0.1}, {0.05, 0.9, 0.3}, {-0.2, 0.1, 1.2}}};
+
+  auto [R, U] = polar_decomposition(F);
+  EXPECT_LT(norm(dot(R, U) - F), 1.0e-14);
+  EXPECT_LT(norm(dot(transpose(R), R) - DenseIdentity<3>()), 1.0e-14);
+  EXPECT_LT(norm(U - transpose(U)), 1.0e-14);
+}
+
 TEST(Tensor, Inverse4x4)
 {
   const tensor<double, 4, 4> A{{{2, 1, -1, 1}, {-3, -1, 2, 8}, {-2, 4, 2, 6}, {1, 1, 7, 2}}};
@@ -353,3 +404,124 @@ TEST(Tensor, DerivativeOfLinearSolveWrtAMatchesFiniteDifference)
 
   EXPECT_LT(squared_norm(dx_FD - get_gradient(x)), tolerance);
 }
+
+TEST(Tensor, ChainRuleTranspose)
+{
+  // the derivative of a matrix-valued function of a vector, and of a vector-valued function of a matrix
+  auto dA_dx = make_tensor<2, 3, 4>([](int i, int j, int k) { return i - 2.0 * j + k * k; });
+  auto dx_dA = make_tensor<4, 2, 3>([](int i, int j, int k) { return i * j + 0.5 * k; });
+
+  tensor<double, 4>    x  = {1.0, -2.0, 0.5, 3.0};
+  tensor<double, 2, 3> dA = {{{0.1, 0.2, 0.3}, {-1.0, 2.0, 0.25}}};
+
+  // inner(df, chain_rule(df_dx, x)) == inner(chain_rule_transpose(df_dx, df), x)
+  EXPECT_NEAR(double_dot(dA, chain_rule(dA_dx, x)), dot(chain_rule_transpose<tensor<double, 4> >(dA_dx, dA), x),
+              1.0e-13);
+  EXPECT_NEAR(dot(x, chain_rule(dx_dA, dA)), double_dot(chain_rule_transpose<tensor<double, 2, 3> >(dx_dA, x), dA),
+              1.0e-13);
+
+  // scalar inputs and outputs
+  EXPECT_NEAR(chain_rule_transpose<double>(x, x), dot(x, x), 1.0e-13);
+  EXPECT_NEAR(norm(chain_rule_transpose<tensor<double, 4> >(x, 2.0) - 2.0 * x), 0.0, 1.0e-13);
+  EXPECT_TRUE(is_zero<decltype(chain_rule_transpose<double>(zero{}, x))>{});
+}
+
+TEST(Tensor, LinearSolveOfSimdPacksMatchesEachLane)
+{
+  constexpr int W = 4;
+
+  // the lanes pivot differently: the second one has a zero on its diagonal
+  tensor<double, 4, 4> A[W] = {{{{2, 1, -1, 1}, {-3, -1, 2, 8}, {-2, 4, 2, 6}, {1, 1, 7, 2}}},
+                               {{{0, 1, -1, 1}, {-3, -1, 2, 8}, {-2, 4, 2, 6}, {1, 1, 7, 2}}},
+                               {{{4, 1, 0, 0}, {1, 4, 1, 0}, {0, 1, 4, 1}, {0, 0, 1, 4}}},
+                               {{{1, 2, 3, 4}, {2, 5, 3, 1}, {3, 3, 9, 2}, {4, 1, 2, 8}}}};
+  tensor<double, 4> b[W] = {{{-1, 2, 3, 1}}, {{1, 0, 0, 2}}, {{3, 1, 4, 1}}, {{0, 1, 0, 1}}};
+
+  tensor<simd<double, W>, 4, 4> A_simd{};
+  tensor<simd<double, W>, 4>    b_simd{};
+  for (int l = 0; l < W; l++) {
+    for (int i = 0; i < 4; i++) {
+      for (int j = 0; j < 4; j++) {
+        A_simd[i][j][l] = A[l][i][j];
+      }
+      b_simd[i][l] = b[l][i];
+    }
+  }
+
+  auto x    = linear_solve(A_simd, b_simd);
+  auto invA = inv(A_simd);
+  for (int l = 0; l < W; l++) {
+    auto expected_x    = linear_solve(A[l], b[l]);
+    auto expected_invA = inv(A[l]);
+    for (int i = 0; i < 4; i++) {
+      EXPECT_DOUBLE_EQ(x[i][l], expected_x[i]);
+      for (int j = 0; j < 4; j++) {
+        EXPECT_DOUBLE_EQ(invA[i][j][l], expected_invA[i][j]);
+      }
+    }
+  }
+}
+
+TEST(Tensor, SimdPacksOfDualNumbers)
+{
+  constexpr int W = 4;
+
+  simd<dual<double>, W> x{};
+  simd<double, W>       c{};
+  for (int l = 0; l < W; l++) {
+    x[l] = make_dual(0.5 + l);
+    c[l] = 1.0 + 0.25 * l;
+  }
+
+  // packs of dual numbers combine with packs of doubles and plain numbers, like dual numbers do with doubles
+  auto f = c * x * x + 3.0 * sin(x) - x / 2 + exp(x);
+  f *= 2.0;
+
+  auto value    = get_value(f);
+  auto gradient = get_gradient(f);
+  for (int l = 0; l < W; l++) {
+    double x_l = 0.5 + l;
+    double c_l = 1.0 + 0.25 * l;
+    EXPECT_NEAR(value[l], 2.0 * (c_l * x_l * x_l + 3.0 * std::sin(x_l) - x_l / 2 + std::exp(x_l)), 1.0e-12);
+    EXPECT_NEAR(gradient[l], 2.0 * (2.0 * c_l * x_l + 3.0 * std::cos(x_l) - 0.5 + std::exp(x_l)), 1.0e-12);
+  }
+}
+
+// the small tensor kernels are only fast when the compiler can unroll (and vectorize) them completely, see
+// benchmark_tensor_kernels.cpp: these tests guard the properties that relies on
+
+TEST(Tensor, SmallTensorLayouts)
+{
+  // contiguous, unpadded storage, so that the loops over the entries (and the lanes of simd packs) vectorize
+  static_assert(sizeof(tensor<double, 3, 3>) == 9 * sizeof(double));
+  static_assert(sizeof(tensor<dual<double>, 3, 3>) == 18 * sizeof(double));
+  static_assert(sizeof(dual<tensor<double, 3, 3>>) == 10 * sizeof(double));
+  static_assert(sizeof(tensor<simd<double, 4>, 3, 3>) == 36 * sizeof(double));
+
+  // copied with plain moves, rather than calls to user-defined copy constructors
+  static_assert(std::is_trivially_copyable_v<tensor<double, 3, 3>>);
+  static_assert(std::is_trivially_copyable_v<tensor<dual<double>, 3, 3>>);
+  static_assert(std::is_trivially_copyable_v<tensor<dual<tensor<double, 3, 3>>, 3, 3>>);
+  static_assert(std::is_trivially_copyable_v<tensor<simd<double, 4>, 3, 3>>);
+}
+
+TEST(Tensor, SmallTensorKernelsAreConstexpr)
+{
+  // evaluating the kernels at compile time requires them (and everything they call) to be defined inline, with loops
+  // whose trip counts are known at compile time, which is also what lets them be unrolled inside q-functions
+  constexpr tensor<double, 3, 3> A{{{4.0, 0.5, -0.2}, {0.5, 3.0, 0.1}, {-0.2, 0.1, 5.0}}};
+  constexpr tensor<double, 3>    b{{-1.0, 2.0, 3.0}};
+
+  constexpr double detA  = det(A);
+  constexpr auto   invA  = inv(A);
+  constexpr auto   AinvA = dot(A, invA);
+  constexpr double AA    = double_dot(A, A);
+  constexpr auto   x     = linear_solve(A, b);
+  constexpr auto   x_lu  = linear_solve(factorize_lu(A), b);
+
+  EXPECT_NEAR(detA * det(invA), 1.0, 1.0e-14);
+  EXPECT_LT(norm(AinvA - DenseIdentity<3>()), 1.0e-14);
+  EXPECT_NEAR(AA, squared_norm(A), 1.0e-14);
+  EXPECT_LT(norm(dot(A, x) - b), 1.0e-14);
+  EXPECT_LT(norm(x_lu - x), 1.0e-14);
+}
@@ -289,3 +289,28 @@ TEST(Tensor, Eigenvalues)
   EXPECT_LT(abs(get<0>(lambda[1].gradient) - expected[1]), 1.0e-14);
   EXPECT_LT(abs(get<0>(lambda[2].gradient) - expected[2]), 1.0e-14);
 }
+
+TEST(Tensor, DerivativeOfMatrixSqrtMatchesFiniteDifference)
+{
+  tensor<double, 3, 3> F = {{{1.1, 0.2, -0.1}, {0.05, 0.9, 0.3}, {-0.2, 0.1, 1.2}}};
+  tensor<double, 3, 3> dF = {{{0.3, -0.1, 0.2}, {0.4, 0.1, -0.3}, {0.2, 0.5, 0.1}}};
+
+  auto f = [](auto X) { return matrix_sqrt(dot(transpose(X), X)); };
+
+  auto U = f(make_dual(F));
+
+  // derivative of sqrt(F^T F) in direction dF, by central finite difference
+  const double h     = 1.0e-6;
+  auto         dU_FD = (f(F + h * dF) - f(F - h * dF)) / (2.0 * h);
+
+  tensor<double, 3, 3> dU{};
+  for_constexpr<3, 3, 3, 3>([&](auto i, auto j, auto k, auto l) { dU(i, j) += U(i, j).gradient(k, l) * dF(k, l); });
+
+  EXPECT_LT(norm(get_value(U) - f(F)), 1.0e-14);
+  EXPECT_LT(norm(dU - dU_FD), 1.0e-8);
+
+  // the derivative is well-defined even where the eigenvalues are repeated
+  auto I_sqrt = matrix_sqrt(make_dual(DenseIdentity<3>()));
+  EXPECT_LT(norm(get_value(I_sqrt) - DenseIdentity<3>()), 1.0e-14);
+  EXPECT_FALSE(isnan(get_gradient(I_sqrt)));
+}
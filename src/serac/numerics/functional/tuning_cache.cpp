@@ -0,0 +1,132 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/numerics/functional/tuning_cache.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <utility>
+
+#include "serac/infrastructure/about.hpp"
+#include "serac/infrastructure/accelerator.hpp"
+#include "serac/infrastructure/logger.hpp"
+
+namespace serac {
+
+namespace autotuning {
+
+// Restrict global to this file only
+namespace {
+Options tuning_options;
+
+/// the entries of the cache file, by (platform, kernel)
+std::map<std::pair<std::string, std::string>, uint32_t> entries;
+
+/// whether the cache file has been read
+bool loaded = false;
+
+/// each line of the cache file is "<platform>\t<kernel>\t<value>"
+void load()
+{
+  loaded = true;
+
+  std::ifstream file(tuning_options.cache_file);
+  std::string   line;
+  while (std::getline(file, line)) {
+    auto first = line.find('\t');
+    auto last  = line.rfind('\t');
+    if (first == std::string::npos || first == last) continue;
+    try {
+      entries[{line.substr(0, first), line.substr(first + 1, last - first - 1)}] =
+          static_cast<uint32_t>(std::stoul(line.substr(last + 1)));
+    } catch (const std::exception&) {
+      SLIC_WARNING_ROOT(
+          axom::fmt::format("Ignoring an invalid line of the tuning cache '{}'", tuning_options.cache_file));
+    }
+  }
+}
+
+/// the platform() of this run, which doesn't change
+const std::string& this_platform()
+{
+  static const std::string name = platform();
+  return name;
+}
+}  // namespace
+
+void configure(const Options& options)
+{
+  SLIC_ERROR_ROOT_IF(options.repetitions < 1, "The autotuning must time each candidate at least once");
+  if (options.cache_file != tuning_options.cache_file) {
+    entries.clear();
+    loaded = false;
+  }
+  tuning_options = options;
+}
+
+const Options& options() { return tuning_options; }
+
+std::string platform()
+{
+  std::string   cpu = "unknown CPU";
+  std::ifstream cpuinfo("/proc/cpuinfo");
+  std::string   line;
+  while (std::getline(cpuinfo, line)) {
+    if (line.rfind("model name", 0) == 0 && line.find(':') != std::string::npos) {
+      cpu = line.substr(line.find(':') + 2);
+      break;
+    }
+  }
+
+  int threads = 1;
+#if defined(SERAC_USE_OPENMP) && defined(_OPENMP)
+  threads = omp_get_max_threads();
+#endif
+
+#ifdef __VERSION__
+  const char* compiler = __VERSION__;
+#else
+  const char* compiler = "unknown compiler";
+#endif
+
+  return axom::fmt::format("{} ({} threads), Serac {}, {}", cpu, threads, version(), compiler);
+}
+
+std::optional<uint32_t> lookup(const std::string& kernel)
+{
+  if (!loaded) load();
+
+  auto entry = entries.find({this_platform(), kernel});
+  if (entry == entries.end()) return std::nullopt;
+  return entry->second;
+}
+
+void store(const std::string& kernel, uint32_t value, MPI_Comm comm)
+{
+  if (!loaded) load();
+  entries[{this_platform(), kernel}] = value;
+
+  int rank = 0;
+  MPI_Comm_rank(comm, &rank);
+  if (rank != 0) return;
+
+  // written next to the cache, and moved over it, so that concurrent runs never read a partially written file
+  const std::string temporary = tuning_options.cache_file + ".tmp";
+  {
+    std::ofstream file(temporary);
+    for (auto& [key, parameter] : entries) {
+      file << key.first << '\t' << key.second << '\t' << parameter << '\n';
+    }
+  }
+  SLIC_WARNING_IF(std::rename(temporary.c_str(), tuning_options.cache_file.c_str()) != 0,
+                  axom::fmt::format("Could not write the tuning cache '{}'", tuning_options.cache_file));
+}
+
+}  // namespace autotuning
+
+}  // namespace serac
@@ -0,0 +1,74 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file tuning_cache.hpp
+ *
+ * @brief The kernel launch parameters chosen by Functional::Autotune(), persisted between runs in a cache file
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#include "mpi.h"
+
+namespace serac {
+
+namespace autotuning {
+
+/// @brief Whether, and where, the physics modules tune their kernels (see Functional::Autotune())
+struct Options {
+  /// @brief whether completeSetup() of the physics modules tunes the kernels of their residuals
+  bool enabled = false;
+
+  /**
+   * @brief the file the tuned parameters are read from, and written to, shared by the runs on the same hardware
+   * and build (which are part of the key of each entry, so one file can hold the parameters of several of them)
+   */
+  std::string cache_file = "serac_tuning_cache.txt";
+
+  /// @brief how many times each candidate is timed, of which the fastest is kept
+  int repetitions = 3;
+};
+
+/**
+ * @brief Sets the options of the autotuning, e.g. from the input file of a driver
+ * @param options the options
+ */
+void configure(const Options& options);
+
+/// @brief The options of the autotuning
+const Options& options();
+
+/**
+ * @brief A description of the hardware and build the kernels run with, i.e. the CPU model, the number of OpenMP
+ * threads, the version of Serac (with its Git SHA) and the compiler
+ */
+std::string platform();
+
+/**
+ * @brief The tuned parameter of a kernel on this platform, from the cache file (read the first time this is called)
+ *
+ * @param kernel identifies the kernel, e.g. its integral type, geometry, spaces and quadrature rule
+ * @return the parameter, if this kernel was tuned (on this platform) before
+ */
+std::optional<uint32_t> lookup(const std::string& kernel);
+
+/**
+ * @brief Records the tuned parameter of a kernel on this platform, and rewrites the cache file
+ *
+ * @param kernel see lookup()
+ * @param value the parameter
+ * @param comm the ranks that tuned the kernel (together), of which only the first writes the file
+ */
+void store(const std::string& kernel, uint32_t value, MPI_Comm comm);
+
+}  // namespace autotuning
+
+}  // namespace serac
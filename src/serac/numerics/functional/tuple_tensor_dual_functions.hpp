@@ -3,6 +3,7 @@
 #include "serac/numerics/functional/tuple.hpp"
 #include "serac/numerics/functional/tensor.hpp"
 #include "serac/numerics/functional/dual.hpp"
+#include "serac/numerics/functional/simd.hpp"
 
 #include "mfem.hpp"
 
@@ -22,14 +23,14 @@ struct is_tensor_of_dual_number<tensor<dual<T>, n...>> {
 
 /**
  * @brief multiply a tensor by a scalar value
- * @tparam S the scalar value type. Must be arithmetic (e.g. float, double, int) or a dual number
+ * @tparam S the scalar value type. Must be arithmetic (e.g. float, double, int), a dual number or a simd pack
  * @tparam T the underlying type of the tensor (righthand) argument
  * @tparam n integers describing the tensor shape
  * @param[in] scale The scaling factor
  * @param[in] A The tensor to be scaled
  */
 template <typename S, typename T, int m, int... n,
-          typename = std::enable_if_t<std::is_arithmetic_v<S> || is_dual_number<S>::value>>
+          typename = std::enable_if_t<std::is_arithmetic_v<S> || is_dual_number<S>::value || is_simd<S>::value>>
 SERAC_HOST_DEVICE constexpr auto operator*(S scale, const tensor<T, m, n...>& A)
 {
   tensor<decltype(S{} * T{}), m, n...> C{};
@@ -41,14 +42,14 @@ SERAC_HOST_DEVICE constexpr auto operator*(S scale, const tensor<T, m, n...>& A)
 
 /**
  * @brief multiply a tensor by a scalar value
- * @tparam S the scalar value type. Must be arithmetic (e.g. float, double, int) or a dual number
+ * @tparam S the scalar value type. Must be arithmetic (e.g. float, double, int), a dual number or a simd pack
  * @tparam T the underlying type of the tensor (righthand) argument
  * @tparam n integers describing the tensor shape
  * @param[in] A The tensor to be scaled
  * @param[in] scale The scaling factor
  */
 template <typename S, typename T, int m, int... n,
-          typename = std::enable_if_t<std::is_arithmetic_v<S> || is_dual_number<S>::value>>
+          typename = std::enable_if_t<std::is_arithmetic_v<S> || is_dual_number<S>::value || is_simd<S>::value>>
 SERAC_HOST_DEVICE constexpr auto operator*(const tensor<T, m, n...>& A, S scale)
 {
   tensor<decltype(T{} * S{}), m, n...> C{};
@@ -60,14 +61,14 @@ SERAC_HOST_DEVICE constexpr auto operator*(const tensor<T, m, n...>& A, S scale)
 
 /**
  * @brief divide a scalar by each element in a tensor
- * @tparam S the scalar value type. Must be arithmetic (e.g. float, double, int) or a dual number
+ * @tparam S the scalar value type. Must be arithmetic (e.g. float, double, int), a dual number or a simd pack
  * @tparam T the underlying type of the tensor (righthand) argument
  * @tparam n integers describing the tensor shape
  * @param[in] scale The numerator
  * @param[in] A The tensor of denominators
  */
 template <typename S, typename T, int m, int... n,
-          typename = std::enable_if_t<std::is_arithmetic_v<S> || is_dual_number<S>::value>>
+          typename = std::enable_if_t<std::is_arithmetic_v<S> || is_dual_number<S>::value || is_simd<S>::value>>
 SERAC_HOST_DEVICE constexpr auto operator/(S scale, const tensor<T, m, n...>& A)
 {
   tensor<decltype(S{} * T{}), n...> C{};
@@ -79,14 +80,14 @@ SERAC_HOST_DEVICE constexpr auto operator/(S scale, const tensor<T, m, n...>& A)
 
 /**
  * @brief divide a tensor by a scalar
- * @tparam S the scalar value type. Must be arithmetic (e.g. float, double, int) or a dual number
+ * @tparam S the scalar value type. Must be arithmetic (e.g. float, double, int), a dual number or a simd pack
  * @tparam T the underlying type of the tensor (righthand) argument
  * @tparam n integers describing the tensor shape
  * @param[in] A The tensor of numerators
  * @param[in] scale The denominator
  */
 template <typename S, typename T, int m, int... n,
-          typename = std::enable_if_t<std::is_arithmetic_v<S> || is_dual_number<S>::value>>
+          typename = std::enable_if_t<std::is_arithmetic_v<S> || is_dual_number<S>::value || is_simd<S>::value>>
 SERAC_HOST_DEVICE constexpr auto operator/(const tensor<T, m, n...>& A, S scale)
 {
   tensor<decltype(T{} * S{}), m, n...> C{};
@@ -235,6 +236,102 @@ SERAC_HOST_DEVICE auto promote_each_to_dual_when(const tensor<T, n>& x)
   }
 }
 
+/**
+ * @brief promote a value to dual numbers with room for the derivatives in K directions, all initialized to zero
+ *
+ * The derivatives in each direction are filled in with seed_direction(), so that a single evaluation on the
+ * result propagates all K of them at once (see with_directional_derivatives()).
+ *
+ * @tparam K the number of directions
+ * @param x the value to be promoted
+ */
+template <int K>
+SERAC_HOST_DEVICE constexpr auto make_multidirectional_dual(double x)
+{
+  return dual<tensor<double, K>>{x, tensor<double, K>{}};
+}
+
+/// @overload
+template <int K, typename T, int m, int... n>
+SERAC_HOST_DEVICE constexpr auto make_multidirectional_dual(const tensor<T, m, n...>& x)
+{
+  tensor<decltype(make_multidirectional_dual<K>(T{})), m, n...> output{};
+  for (int i = 0; i < m; i++) {
+    output[i] = make_multidirectional_dual<K>(x[i]);
+  }
+  return output;
+}
+
+/// @overload
+template <int K, typename... T>
+SERAC_HOST_DEVICE constexpr auto make_multidirectional_dual(const serac::tuple<T...>& x)
+{
+  return serac::apply([](const auto&... each) { return serac::tuple{make_multidirectional_dual<K>(each)...}; }, x);
+}
+
+/**
+ * @brief add a perturbation to the derivatives of a value (see make_multidirectional_dual()) in direction @a d
+ *
+ * @param x the dual numbers to seed
+ * @param dx the perturbation of each of x's values, with the same layout
+ * @param d which direction the perturbation belongs to
+ */
+template <int K>
+SERAC_HOST_DEVICE constexpr void seed_direction(dual<tensor<double, K>>& x, double dx, int d)
+{
+  x.gradient[d] += dx;
+}
+
+/// @overload
+template <typename T, typename S, int m, int... n>
+SERAC_HOST_DEVICE constexpr void seed_direction(tensor<T, m, n...>& x, const tensor<S, m, n...>& dx, int d)
+{
+  for (int i = 0; i < m; i++) {
+    seed_direction(x[i], dx[i], d);
+  }
+}
+
+/// @overload
+template <typename... T, typename... S>
+SERAC_HOST_DEVICE constexpr void seed_direction(serac::tuple<T...>& x, const serac::tuple<S...>& dx, int d)
+{
+  for_constexpr<sizeof...(T)>([&](auto i) { seed_direction(serac::get<i>(x), serac::get<i>(dx), d); });
+}
+
+/**
+ * @brief extract the derivative in direction @a d from the result of a calculation on multidirectional dual numbers
+ * (see make_multidirectional_dual()), with the same layout as its value
+ */
+template <int K>
+SERAC_HOST_DEVICE constexpr double get_direction(const dual<tensor<double, K>>& x, int d)
+{
+  return x.gradient[d];
+}
+
+/// @overload
+SERAC_HOST_DEVICE constexpr double get_direction(double /* x */, int /* d */) { return 0.0; }
+
+/// @overload
+SERAC_HOST_DEVICE constexpr zero get_direction(zero /* x */, int /* d */) { return zero{}; }
+
+/// @overload
+template <typename T, int m, int... n>
+SERAC_HOST_DEVICE constexpr auto get_direction(const tensor<T, m, n...>& x, int d)
+{
+  tensor<decltype(get_direction(T{}, d)), m, n...> output{};
+  for (int i = 0; i < m; i++) {
+    output[i] = get_direction(x[i], d);
+  }
+  return output;
+}
+
+/// @overload
+template <typename... T>
+SERAC_HOST_DEVICE constexpr auto get_direction(const serac::tuple<T...>& x, int d)
+{
+  return serac::apply([d](const auto&... each) { return serac::tuple{get_direction(each, d)...}; }, x);
+}
+
 /// @brief layer of indirection required to implement `make_dual_wrt`
 template <int n, typename... T, int... i>
 SERAC_HOST_DEVICE constexpr auto make_dual_helper(const serac::tuple<T...>& args, std::integer_sequence<int, i...>)
@@ -486,6 +583,176 @@ SERAC_HOST_DEVICE constexpr auto inv(tensor<dual<gradient_type>, n, n> A)
   });
 }
 
+/**
+ * @overload
+ * @note the general inv() uses partial pivoting, which can't branch differently for each lane of a simd pack,
+ * so small matrices of simd packs are inverted with the same closed-form expressions as the 2x2 and 3x3 double case
+ */
+template <typename T, int W>
+SERAC_HOST_DEVICE constexpr auto inv(const tensor<simd<T, W>, 2, 2>& A)
+{
+  auto inv_detA = T(1) / det(A);
+
+  tensor<simd<T, W>, 2, 2> invA{};
+
+  invA[0][0] = A[1][1] * inv_detA;
+  invA[0][1] = -A[0][1] * inv_detA;
+  invA[1][0] = -A[1][0] * inv_detA;
+  invA[1][1] = A[0][0] * inv_detA;
+
+  return invA;
+}
+
+/// @overload
+template <typename T, int W>
+SERAC_HOST_DEVICE constexpr auto inv(const tensor<simd<T, W>, 3, 3>& A)
+{
+  auto inv_detA = T(1) / det(A);
+
+  tensor<simd<T, W>, 3, 3> invA{};
+
+  invA[0][0] = (A[1][1] * A[2][2] - A[1][2] * A[2][1]) * inv_detA;
+  invA[0][1] = (A[0][2] * A[2][1] - A[0][1] * A[2][2]) * inv_detA;
+  invA[0][2] = (A[0][1] * A[1][2] - A[0][2] * A[1][1]) * inv_detA;
+  invA[1][0] = (A[1][2] * A[2][0] - A[1][0] * A[2][2]) * inv_detA;
+  invA[1][1] = (A[0][0] * A[2][2] - A[0][2] * A[2][0]) * inv_detA;
+  invA[1][2] = (A[0][2] * A[1][0] - A[0][0] * A[1][2]) * inv_detA;
+  invA[2][0] = (A[1][0] * A[2][1] - A[1][1] * A[2][0]) * inv_detA;
+  invA[2][1] = (A[0][1] * A[2][0] - A[0][0] * A[2][1]) * inv_detA;
+  invA[2][2] = (A[0][0] * A[1][1] - A[0][1] * A[1][0]) * inv_detA;
+
+  return invA;
+}
+
+/**
+ * @brief Representation of the LU factorizations of a matrix of simd packs, one for each lane
+ *
+ * The lanes may pivot differently, so each has its own row permutation, but the triangular factors
+ * are stored as matrices of simd packs, so that the substitutions in linear_solve() handle every lane at once.
+ */
+template <typename T, int W, int n>
+struct LuFactorization<simd<T, W>, n> {
+  tensor<int, n>           P[W];  ///< Row permutation indices of each lane, as in LuFactorization<double, n>
+  tensor<simd<T, W>, n, n> L;     ///< Lower triangular factor. Has ones on diagonal.
+  tensor<simd<T, W>, n, n> U;     ///< Upper triangular factor
+};
+
+/**
+ * @overload
+ * @note the pivots of each lane are chosen exactly as in the scalar version, after which the
+ * elimination is carried out on every lane at once
+ */
+template <typename T, int W, int n>
+SERAC_HOST_DEVICE constexpr LuFactorization<simd<T, W>, n> factorize_lu(const tensor<simd<T, W>, n, n>& A)
+{
+  constexpr auto abs = [](T x) { return (x < 0) ? -x : x; };
+
+  LuFactorization<simd<T, W>, n> lu{};
+
+  for (int l = 0; l < W; l++) {
+    tensor<int, n> P(make_tensor<n>([](auto i) { return i; }));
+
+    // row i of the permuted matrix is row P[i] of A
+    for (int i = 0; i < n; i++) {
+      T   max_val = abs(A[P[i]][i][l]);
+      int max_row = i;
+      for (int j = i + 1; j < n; j++) {
+        if (abs(A[P[j]][i][l]) > max_val) {
+          max_val = abs(A[P[j]][i][l]);
+          max_row = j;
+        }
+      }
+
+      auto tmp   = P[max_row];
+      P[max_row] = P[i];
+      P[i]       = tmp;
+    }
+
+    for (int i = 0; i < n; i++) {
+      for (int j = 0; j < n; j++) {
+        lu.U[i][j][l] = A[P[i]][j][l];
+      }
+    }
+    lu.P[l] = P;
+  }
+
+  for (int i = 0; i < n; i++) {
+    lu.L[i][i] = T(1);
+  }
+
+  for (int i = 0; i < n; i++) {
+    for (int j = i + 1; j < n; j++) {
+      auto c     = lu.U[j][i] / lu.U[i][i];
+      lu.L[j][i] = c;
+      lu.U[j] -= c * lu.U[i];
+      lu.U[j][i] = simd<T, W>{};
+    }
+  }
+
+  return lu;
+}
+
+/**
+ * @overload
+ * @note each lane's row permutation is applied to the right hand side up front, so that the
+ * substitutions are the same for every lane
+ */
+template <typename T, int W, typename S, int n, int... m>
+SERAC_HOST_DEVICE constexpr auto linear_solve(const LuFactorization<simd<T, W>, n>& lu_factors,
+                                              const tensor<S, n, m...>& b)
+{
+  // the value of lane l of a simd pack, or the value shared by every lane of anything else
+  constexpr auto lane = [](const auto& x, int l) -> T {
+    if constexpr (is_simd<std::decay_t<decltype(x)> >::value) {
+      return x[l];
+    } else {
+      return T(x);
+    }
+  };
+
+  tensor<simd<T, W>, n, m...> Pb{};
+  for (int l = 0; l < W; l++) {
+    for (int i = 0; i < n; i++) {
+      if constexpr (sizeof...(m) == 0) {
+        Pb[i][l] = lane(b[lu_factors.P[l][i]], l);
+      } else {
+        for_constexpr<m...>([&](auto... k) { Pb[i](k...)[l] = lane(b[lu_factors.P[l][i]](k...), l); });
+      }
+    }
+  }
+
+  return solve_upper_triangular(lu_factors.U, solve_lower_triangular(lu_factors.L, Pb));
+}
+
+/// @brief tensors of simd packs are constants, as far as differentiation is concerned
+template <typename T, int W, int... n>
+SERAC_HOST_DEVICE constexpr auto get_gradient(const tensor<simd<T, W>, n...>& /* arg */)
+{
+  return zero{};
+}
+
+/// @brief the values of each lane of a simd pack of dual numbers
+template <typename gradient_type, int W>
+SERAC_HOST_DEVICE constexpr auto get_value(const simd<dual<gradient_type>, W>& arg)
+{
+  simd<double, W> value{};
+  for (int l = 0; l < W; l++) {
+    value[l] = arg[l].value;
+  }
+  return value;
+}
+
+/// @brief the gradients of each lane of a simd pack of dual numbers
+template <typename gradient_type, int W>
+SERAC_HOST_DEVICE constexpr auto get_gradient(const simd<dual<gradient_type>, W>& arg)
+{
+  simd<gradient_type, W> gradient{};
+  for (int l = 0; l < W; l++) {
+    gradient[l] = arg[l].gradient;
+  }
+  return gradient;
+}
+
 /**
  * @brief Retrieves a value tensor from a tensor of dual numbers
  * @param[in] arg The tensor of dual numbers
@@ -710,6 +977,240 @@ auto find_root(function&& f, tensor<double, n> x0)
   return x;
 };
 
+/**
+ * @brief the eigenvalues and eigenvectors of a symmetric matrix
+ * @tparam n the number of rows and columns in the matrix
+ */
+template <int n>
+struct Eigendecomposition {
+  tensor<double, n>    eigenvalues;   ///< the eigenvalues, in ascending order
+  tensor<double, n, n> eigenvectors;  ///< column i is the unit eigenvector associated with eigenvalues[i]
+};
+
+/**
+ * @brief compute the eigenvalues and eigenvectors of a symmetric 2x2 matrix in closed form
+ *
+ * @param A the (symmetric) matrix
+ * @return the eigenvalues (in ascending order) and the corresponding eigenvectors
+ */
+SERAC_HOST_DEVICE inline Eigendecomposition<2> eig(const tensor<double, 2, 2>& A)
+{
+  using std::atan2, std::cos, std::sin, std::sqrt;
+  double mean      = 0.5 * (A[0][0] + A[1][1]);
+  double half_diff = 0.5 * (A[0][0] - A[1][1]);
+  double offdiag   = 0.5 * (A[0][1] + A[1][0]);
+  double radius    = sqrt(half_diff * half_diff + offdiag * offdiag);
+
+  // the eigenvector of the larger eigenvalue is {cos(theta), sin(theta)}
+  double theta = 0.5 * atan2(offdiag, half_diff);
+  double c     = cos(theta);
+  double s     = sin(theta);
+
+  return {{mean - radius, mean + radius}, {{{-s, c}, {c, s}}}};
+}
+
+/**
+ * @brief compute the eigenvalues and eigenvectors of a symmetric 3x3 matrix in closed form
+ *
+ * based on "A robust algorithm for finding the eigenvalues and
+ * eigenvectors of 3x3 symmetric matrices", by Scherzinger & Dohrmann
+ *
+ * @param A the (symmetric) matrix
+ * @return the eigenvalues (in ascending order) and the corresponding eigenvectors
+ */
+SERAC_HOST_DEVICE inline Eigendecomposition<3> eig(const tensor<double, 3, 3>& A)
+{
+  using std::acos, std::cos, std::fabs, std::fmax, std::fmin, std::pow, std::sqrt;
+  constexpr double pi = 3.14159265358979323846;
+
+  tensor<double, 3>    eta{};
+  tensor<double, 3, 3> Q{{{1.0, 0.0, 0.0}, {0.0, 1.0, 0.0}, {0.0, 0.0, 1.0}}};
+
+  auto A_dev = dev(A);
+
+  double J2 = 0.5 * squared_norm(A_dev);
+  double J3 = det(A_dev);
+
+  if (J2 > 0.0) {
+    // angle used to find eigenvalues
+    double tmp   = (0.5 * J3) * pow(3.0 / J2, 1.5);
+    double alpha = acos(fmin(fmax(tmp, -1.0), 1.0)) / 3.0;
+
+    // consider the most distinct eigenvalue first
+    if (6.0 * alpha < pi) {
+      eta[0] = 2 * sqrt(J2 / 3.0) * cos(alpha);
+    } else {
+      eta[0] = 2 * sqrt(J2 / 3.0) * cos(alpha + 2.0 * pi / 3.0);
+    }
+
+    // find the eigenvector for that eigenvalue
+    tensor<double, 3, 3> r{};
+
+    int    imax     = 0;
+    double norm_max = -1.0;
+
+    for (int i = 0; i < 3; i++) {
+      for (int j = 0; j < 3; j++) {
+        r[i][j] = A_dev[j][i] - (i == j) * eta[0];
+      }
+
+      double norm_r = norm(r[i]);
+      if (norm_max < norm_r) {
+        imax     = i;
+        norm_max = norm_r;
+      }
+    }
+
+    tensor<double, 3> s0 = normalize(r[imax]);
+    tensor<double, 3> t1 = r[(imax + 1) % 3] - dot(r[(imax + 1) % 3], s0) * s0;
+    tensor<double, 3> t2 = r[(imax + 2) % 3] - dot(r[(imax + 2) % 3], s0) * s0;
+    tensor<double, 3> s1 = normalize((norm(t1) > norm(t2)) ? t1 : t2);
+
+    // record the first eigenvector
+    tensor<double, 3> v0 = cross(s0, s1);
+
+    // get the other two eigenvalues by solving the
+    // remaining quadratic characteristic polynomial
+    auto A_dev_s0 = dot(A_dev, s0);
+    auto A_dev_s1 = dot(A_dev, s1);
+
+    double A11 = dot(s0, A_dev_s0);
+    double A12 = dot(s0, A_dev_s1);
+    double A22 = dot(s1, A_dev_s1);
+
+    double delta = 0.5 * ((A11 >= A22) ? 1.0 : -1.0) * sqrt((A11 - A22) * (A11 - A22) + 4 * A12 * A12);
+
+    eta[1] = 0.5 * (A11 + A22) - delta;
+    eta[2] = 0.5 * (A11 + A22) + delta;
+
+    // if the remaining eigenvalues are the same, then just use
+    // the basis for the orthogonal complement found earlier
+    tensor<double, 3> v1 = s0;
+    tensor<double, 3> v2 = s1;
+
+    // otherwise compute the remaining eigenvectors
+    if (fabs(delta) > 1.0e-15 * sqrt(J2)) {
+      t1 = A_dev_s0 - eta[1] * s0;
+      t2 = A_dev_s1 - eta[1] * s1;
+
+      auto w = normalize((norm(t1) > norm(t2)) ? t1 : t2);
+
+      // the last eigenvector is perpendicular to the first two
+      v1 = normalize(cross(w, v0));
+      v2 = normalize(cross(v0, v1));
+    }
+
+    for (int i = 0; i < 3; i++) {
+      Q[i][0] = v0[i];
+      Q[i][1] = v1[i];
+      Q[i][2] = v2[i];
+    }
+  }
+
+  // eta are actually eigenvalues of A_dev, so
+  // shift them to get eigenvalues of A
+  for (int i = 0; i < 3; i++) {
+    eta[i] += tr(A) / 3.0;
+  }
+
+  // sort the eigenvalues (and their eigenvectors) in ascending order
+  auto swap = [&](int i, int j) {
+    if (eta[j] < eta[i]) {
+      double tmp_eta = eta[i];
+      eta[i]         = eta[j];
+      eta[j]         = tmp_eta;
+      for (int k = 0; k < 3; k++) {
+        double tmp_Q = Q[k][i];
+        Q[k][i]      = Q[k][j];
+        Q[k][j]      = tmp_Q;
+      }
+    }
+  };
+  swap(0, 1);
+  swap(1, 2);
+  swap(0, 1);
+
+  return {eta, Q};
+}
+
+/**
+ * @overload
+ * @note symmetric 3x3 matrices of doubles are square-rooted in closed form, through their eigendecomposition,
+ * rather than with the Newton iteration above
+ */
+SERAC_HOST_DEVICE inline tensor<double, 3, 3> matrix_sqrt(const tensor<double, 3, 3>& A)
+{
+  using std::fmax, std::sqrt;
+  auto [lambda, Q] = eig(A);
+
+  tensor<double, 3, 3> B{};
+  for (int k = 0; k < 3; k++) {
+    double sqrt_lambda = sqrt(fmax(lambda[k], 0.0));
+    for (int i = 0; i < 3; i++) {
+      for (int j = 0; j < 3; j++) {
+        B[i][j] += sqrt_lambda * Q[i][k] * Q[j][k];
+      }
+    }
+  }
+  return B;
+}
+
+/**
+ * @overload
+ * @note the derivative of B = sqrt(A) is the solution, dB, of the Sylvester equation dot(B, dB) + dot(dB, B) = dA,
+ * which is solved in closed form in the eigenbasis of A
+ */
+template <typename gradient_type>
+SERAC_HOST_DEVICE auto matrix_sqrt(const tensor<dual<gradient_type>, 3, 3>& A)
+{
+  using std::fmax, std::sqrt;
+  auto [lambda, Q] = eig(get_value(A));
+
+  tensor<double, 3> sqrt_lambda{};
+  for (int k = 0; k < 3; k++) {
+    sqrt_lambda[k] = sqrt(fmax(lambda[k], 0.0));
+  }
+
+  // dB(a, b) = Q(a, i) Q(b, j) (Q(k, i) dA(k, l) Q(l, j)) / (sqrt_lambda(i) + sqrt_lambda(j))
+  tensor<double, 3, 3, 3, 3> dB_dA{};
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      double scale = 1.0 / (sqrt_lambda[i] + sqrt_lambda[j]);
+      for_constexpr<3, 3, 3, 3>([&](auto a, auto b, auto k, auto l) {
+        dB_dA(a, b, k, l) += scale * Q[a][i] * Q[b][j] * Q[k][i] * Q[l][j];
+      });
+    }
+  }
+
+  return make_tensor<3, 3>([&](int a, int b) {
+    double value = 0.0;
+    for (int k = 0; k < 3; k++) {
+      value += sqrt_lambda[k] * Q[a][k] * Q[b][k];
+    }
+    gradient_type gradient{};
+    for (int k = 0; k < 3; k++) {
+      for (int l = 0; l < 3; l++) {
+        gradient += dB_dA[a][b][k][l] * A[k][l].gradient;
+      }
+    }
+    return dual<gradient_type>{value, gradient};
+  });
+}
+
+/**
+ * @brief compute the polar decomposition, F = dot(R, U), of a square matrix with positive determinant
+ *
+ * @param F the matrix to decompose
+ * @return a tuple of the rotation R and the symmetric positive-definite stretch U
+ */
+template <typename T, int dim>
+SERAC_HOST_DEVICE auto polar_decomposition(const tensor<T, dim, dim>& F)
+{
+  auto U = matrix_sqrt(dot(transpose(F), F));
+  auto R = dot(F, inv(U));
+  return serac::tuple{R, U};
+}
+
 /**
  * @brief compute the eigenvalues of a symmetric matrix A
  *
@@ -721,6 +1222,22 @@ auto find_root(function&& f, tensor<double, n> x0)
 template <typename T, int size>
 auto eigenvalues(const serac::tensor<T, size, size>& A)
 {
+  // small matrices are decomposed in closed form
+  if constexpr (size == 2 || size == 3) {
+    auto [lambda, Q] = eig(get_value(A));
+
+    serac::tensor<T, size> output;
+    for (int k = 0; k < size; k++) {
+      output[k] = lambda[k];
+      if constexpr (is_dual_number<T>::value) {
+        tensor<double, size> phi = make_tensor<size>([&](int i) { return Q[i][k]; });
+        auto                 dA  = make_tensor<size, size>([&](int i, int j) { return A(i, j).gradient; });
+        output[k].gradient       = dot(phi, dA, phi);
+      }
+    }
+    return output;
+  }
+
   // put tensor values in an mfem::DenseMatrix
   mfem::DenseMatrix matA(size, size);
   for (int i = 0; i < size; i++) {
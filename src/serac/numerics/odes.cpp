@@ -6,17 +6,89 @@
 
 #include "serac/numerics/odes.hpp"
 
+#include <algorithm>
+#include <cmath>
+
 #include "serac/numerics/expr_template_ops.hpp"
 
 namespace serac::mfem_ext {
 
+TimestepController::TimestepController(const TimesteppingOptions& options, int order)
+    : options_(options), order_(order)
+{
+  SLIC_ERROR_ROOT_IF(options.error_relative_tol <= 0.0 && options.error_absolute_tol <= 0.0,
+                     "Adaptive timestepping requires a positive error tolerance");
+  SLIC_ERROR_ROOT_IF(options.max_dt_growth <= 1.0, "Adaptive timestepping requires max_dt_growth > 1");
+}
+
+double TimestepController::trialTimestep(double requested_dt) const
+{
+  double dt = (proposed_dt_ > 0.0) ? std::min(requested_dt, proposed_dt_) : requested_dt;
+  if (options_.max_dt > 0.0) {
+    dt = std::min(dt, options_.max_dt);
+  }
+  return dt;
+}
+
+double TimestepController::errorNorm(const mfem::Vector& error, const mfem::Vector& x, MPI_Comm comm) const
+{
+  // the sum of the squared scaled errors, and the number of dofs
+  double local[2] = {0.0, static_cast<double>(error.Size())};
+  for (int i = 0; i < error.Size(); i++) {
+    double scaled = error[i] / (options_.error_absolute_tol + options_.error_relative_tol * std::abs(x[i]));
+    local[0] += scaled * scaled;
+  }
+
+  double global[2];
+  MPI_Allreduce(local, global, 2, MPI_DOUBLE, MPI_SUM, comm);
+  return (global[1] > 0.0) ? std::sqrt(global[0] / global[1]) : 0.0;
+}
+
+bool TimestepController::accept(double error, bool converged, double dt)
+{
+  constexpr double safety      = 0.9;
+  constexpr double max_cut     = 0.2;
+  constexpr double failure_cut = 0.25;
+
+  // keeps the growth factor finite for steps with no measurable error
+  constexpr double min_error = 1.0e-10;
+
+  const double k        = order_;
+  const bool   accepted = converged && error <= 1.0;
+
+  double factor;
+  if (!converged) {
+    factor = failure_cut;
+  } else if (!accepted) {
+    factor = std::max(max_cut, safety * std::pow(1.0 / error, 1.0 / k));
+  } else {
+    error           = std::max(error, min_error);
+    factor          = safety * std::pow(1.0 / error, 0.3 / k) * std::pow(previous_error_ / error, 0.4 / k);
+    factor          = std::clamp(factor, max_cut, options_.max_dt_growth);
+    previous_error_ = std::max(error, 1.0e-4);
+  }
+
+  proposed_dt_ = dt * factor;
+  if (options_.max_dt > 0.0) {
+    proposed_dt_ = std::min(proposed_dt_, options_.max_dt);
+  }
+
+  if (accepted) {
+    proposed_dt_ = std::max(proposed_dt_, options_.min_dt);
+  } else {
+    SLIC_ERROR_ROOT_IF(proposed_dt_ < options_.min_dt, "Adaptive timestep was cut back below min_dt = "
+                                                           << options_.min_dt << " (error " << error << ", "
+                                                           << (converged ? "converged" : "not converged") << ")");
+  }
+
+  return accepted;
+}
+
 SecondOrderODE::SecondOrderODE(int n, State&& state, const EquationSolver& solver, const BoundaryConditionManager& bcs)
     : mfem::SecondOrderTimeDependentOperator(n, 0.0), state_(std::move(state)), solver_(solver), bcs_(bcs), zero_(n)
 {
   zero_ = 0.0;
-  U_minus_.SetSize(n);
   U_.SetSize(n);
-  U_plus_.SetSize(n);
   dU_dt_.SetSize(n);
   d2U_dt2_.SetSize(n);
 }
@@ -74,26 +146,75 @@ void SecondOrderODE::SetTimestepper(const serac::TimestepMethod timestepper)
   }
 }
 
+void SecondOrderODE::SetAdaptiveTimestepping(const TimesteppingOptions& options)
+{
+  controller_ = std::make_unique<TimestepController>(options, 3);
+  error_.SetSize(height);
+}
+
 void SecondOrderODE::Step(mfem::Vector& x, mfem::Vector& dxdt, double& time, double& dt)
+{
+  if (!controller_) {
+    StepOnce(x, dxdt, time, dt);
+    return;
+  }
+
+  x_n_                = x;
+  dxdt_n_             = dxdt;
+  d2xdt2_n_           = state_.d2u_dt2;
+  const double time_n = time;
+
+  double trial_dt = controller_->trialTimestep(dt);
+  for (int rejections = 1;; rejections++) {
+    solve_failed_  = false;
+    double step_dt = trial_dt;
+    StepOnce(x, dxdt, time, step_dt);
+
+    // e = (x_{n+1} - x_n - dt * v_n - dt^2 / 2 * a_n) / 3
+    add(1.0 / 3.0, x, -1.0 / 3.0, x_n_, error_);
+    error_.Add(-trial_dt / 3.0, dxdt_n_);
+    error_.Add(-trial_dt * trial_dt / 6.0, d2xdt2_n_);
+    error_.SetSubVector(bcs_.allEssentialTrueDofs(), 0.0);
+
+    double error = controller_->errorNorm(error_, x, solver_.nonlinearSolver().GetComm());
+    if (controller_->accept(error, !solve_failed_, trial_dt)) {
+      dt = trial_dt;
+      return;
+    }
+
+    SLIC_ERROR_ROOT_IF(rejections >= controller_->maxRejections(),
+                       "Adaptive timestep was rejected " << rejections << " times");
+    SLIC_INFO_ROOT("Rejected adaptive timestep dt = " << trial_dt << " (error " << error << "), retrying with dt = "
+                                                      << controller_->proposedTimestep());
+
+    // restart from the beginning of the step, re-initializing the mfem solver discards any
+    // acceleration it kept from the rejected step
+    x              = x_n_;
+    dxdt           = dxdt_n_;
+    state_.d2u_dt2 = d2xdt2_n_;
+    time           = time_n;
+    predictor_.clear();
+    if (second_order_ode_solver_) {
+      second_order_ode_solver_->Init(*this);
+    } else {
+      first_order_system_ode_solver_->Init(*this);
+    }
+    trial_dt = controller_->proposedTimestep();
+  }
+}
+
+void SecondOrderODE::StepOnce(mfem::Vector& x, mfem::Vector& dxdt, double& time, double& dt)
 {
   if (second_order_ode_solver_) {
     // if we used a 2nd order method
     second_order_ode_solver_->Step(x, dxdt, time, dt);
 
     if (enforcement_method_ == DirichletEnforcementMethod::FullControl) {
-      U_minus_ = 0.0;
-      U_       = 0.0;
-      U_plus_  = 0.0;
-      for (const auto& bc : bcs_.essentials()) {
-        bc.setDofs(U_minus_, t - epsilon);
-        bc.setDofs(U_, t);
-        bc.setDofs(U_plus_, t + epsilon);
-      }
+      bcs_.setEssentialDofs(t, epsilon, U_, dU_dt_);
 
-      auto constrained_dofs = bcs_.allEssentialTrueDofs();
-      for (int i = 0; i < constrained_dofs.Size(); i++) {
+      for (int i : bcs_.allEssentialTrueDofs()) {
         x[i]    = U_[i];
-        dxdt[i] = (U_plus_[i] - U_minus_[i]) / (2.0 * epsilon);
+        dxdt[i] = dU_dt_[i];
       }
     }
 
@@ -156,18 +277,9 @@ void SecondOrderODE::Solve(const double time, const double c0, const double c1,
   state_.u     = u;
   state_.du_dt = du_dt;
 
-  // evaluate the constraint functions at a 3-point
-  // stencil of times centered on the time of interest
-  // in order to compute finite-difference approximations
-  // to the time derivatives that appear in the residual
-  U_minus_ = 0.0;
-  U_       = 0.0;
-  U_plus_  = 0.0;
-  for (const auto& bc : bcs_.essentials()) {
-    bc.setDofs(U_minus_, time - epsilon);
-    bc.setDofs(U_, time);
-    bc.setDofs(U_plus_, time + epsilon);
-  }
+  // evaluate the constraint functions and the time
+  // derivatives of them that appear in the residual
+  bcs_.setEssentialDofs(time, epsilon, U_, dU_dt_, &d2U_dt2_);
 
   bool implicit = (c0 != 0.0 || c1 != 0.0);
   if (implicit) {
@@ -181,22 +293,19 @@ void SecondOrderODE::Solve(const double time, const double c0, const double c1,
     }
 
     if (enforcement_method_ == DirichletEnforcementMethod::RateControl) {
-      d2U_dt2_ = ((U_plus_ - U_minus_) / (2.0 * epsilon) - du_dt) / c1;
-      dU_dt_   = du_dt;
-      U_       = u;
+      // d2U_dt2_ = (dU_dt_ - du_dt) / c1;
+      subtract(1.0 / c1, dU_dt_, du_dt, d2U_dt2_);
+      dU_dt_ = du_dt;
+      U_     = u;
     }
 
     if (enforcement_method_ == DirichletEnforcementMethod::FullControl) {
-      d2U_dt2_ = (U_minus_ - 2.0 * U_ + U_plus_) / (epsilon * epsilon);
-      dU_dt_   = (U_plus_ - U_minus_) / (2.0 * epsilon) - c1 * d2U_dt2_;
-      U_       = U_ - c0 * d2U_dt2_;
+      dU_dt_.Add(-c1, d2U_dt2_);
+      U_.Add(-c0, d2U_dt2_);
     }
-  } else {
-    d2U_dt2_ = (U_minus_ - 2.0 * U_ + U_plus_) / (epsilon * epsilon);
-    dU_dt_   = (U_plus_ - U_minus_) / (2.0 * epsilon);
   }
 
-  auto constrained_dofs = bcs_.allEssentialTrueDofs();
+  const auto& constrained_dofs = bcs_.allEssentialTrueDofs();
   state_.u.SetSubVector(constrained_dofs, 0.0);
   U_.SetSubVectorComplement(constrained_dofs, 0.0);
   state_.u += U_;
@@ -205,14 +314,22 @@ void SecondOrderODE::Solve(const double time, const double c0, const double c1,
   dU_dt_.SetSubVectorComplement(constrained_dofs, 0.0);
   state_.du_dt += dU_dt_;
 
-  // use the previous solution as our starting guess
-  d2u_dt2 = state_.d2u_dt2;
+  // use the previous (or extrapolated) solution as our starting guess
+  if (predictor_.ready()) {
+    predictor_.predict(time, d2u_dt2);
+  } else {
+    d2u_dt2 = state_.d2u_dt2;
+  }
   d2u_dt2.SetSubVector(constrained_dofs, 0.0);
   d2U_dt2_.SetSubVectorComplement(constrained_dofs, 0.0);
   d2u_dt2 += d2U_dt2_;
 
   solver_.solve(d2u_dt2);
-  SLIC_WARNING_ROOT_IF(!solver_.nonlinearSolver().GetConverged(), "Newton Solver did not converge.");
+  solve_failed_ = solve_failed_ || !solver_.converged();
+  if (solver_.converged()) {
+    predictor_.push(time, d2u_dt2);
+  }
+  SLIC_WARNING_ROOT_IF(!controller_ && !solver_.converged(), "Newton Solver did not converge.");
 
   state_.d2u_dt2 = d2u_dt2;
 }
@@ -222,9 +339,7 @@ FirstOrderODE::FirstOrderODE(int n, FirstOrderODE::State&& state, const Equation
     : mfem::TimeDependentOperator(n, 0.0), state_(std::move(state)), solver_(solver), bcs_(bcs), zero_(n)
 {
   zero_ = 0.0;
-  U_minus_.SetSize(n);
   U_.SetSize(n);
-  U_plus_.SetSize(n);
   dU_dt_.SetSize(n);
 }
 
@@ -261,12 +376,148 @@ void FirstOrderODE::SetTimestepper(const serac::TimestepMethod timestepper)
     case serac::TimestepMethod::SDIRK34:
       ode_solver_ = std::make_unique<mfem::SDIRK34Solver>();
       break;
+    case serac::TimestepMethod::IMEXEuler:
+      imex_tableau_ = IMEXTableau{.gamma      = 1.0,
+                                  .c          = {0.0, 1.0},
+                                  .a_implicit = {{0.0, 0.0}, {0.0, 1.0}},
+                                  .a_explicit = {{0.0, 0.0}, {1.0, 0.0}}};
+      ode_solver_.reset();
+      return;
+    case serac::TimestepMethod::IMEXARS222: {
+      // Ascher, Ruuth and Spiteri (1997), section 2.6
+      double gamma  = 1.0 - 1.0 / std::sqrt(2.0);
+      double delta  = 1.0 - 1.0 / (2.0 * gamma);
+      imex_tableau_ = IMEXTableau{.gamma      = gamma,
+                                  .c          = {0.0, gamma, 1.0},
+                                  .a_implicit = {{0.0, 0.0, 0.0}, {0.0, gamma, 0.0}, {0.0, 1.0 - gamma, gamma}},
+                                  .a_explicit = {{0.0, 0.0, 0.0}, {gamma, 0.0, 0.0}, {delta, 1.0 - delta, 0.0}}};
+      ode_solver_.reset();
+      return;
+    }
     default:
       SLIC_ERROR_ROOT("Timestep method was not a supported first-order ODE method");
   }
+  imex_tableau_.reset();
   ode_solver_->Init(*this);
 }
 
+void FirstOrderODE::SetAdaptiveTimestepping(const TimesteppingOptions& options)
+{
+  controller_ = std::make_unique<TimestepController>(options, 2);
+  error_.SetSize(height);
+}
+
+void FirstOrderODE::Step(mfem::Vector& x, double& time, double& dt)
+{
+  if (imex_tableau_) {
+    SLIC_ERROR_ROOT_IF(controller_, "Adaptive timestepping is not supported by the IMEX timesteppers");
+    IMEXStep(x, time, dt);
+    return;
+  }
+
+  SLIC_ERROR_ROOT_IF(!ode_solver_, "ode_solver_ unspecified");
+
+  if (!controller_) {
+    ode_solver_->Step(x, time, dt);
+    return;
+  }
+
+  x_n_                = x;
+  du_dt_n_            = state_.du_dt;
+  const double time_n = time;
+
+  double trial_dt = controller_->trialTimestep(dt);
+  for (int rejections = 1;; rejections++) {
+    solve_failed_  = false;
+    double step_dt = trial_dt;
+    ode_solver_->Step(x, time, step_dt);
+
+    // e = (x_{n+1} - x_n - dt * du_dt_n) / 2
+    add(0.5, x, -0.5, x_n_, error_);
+    error_.Add(-0.5 * trial_dt, du_dt_n_);
+    error_.SetSubVector(bcs_.allEssentialTrueDofs(), 0.0);
+
+    double error = controller_->errorNorm(error_, x, solver_.nonlinearSolver().GetComm());
+    if (controller_->accept(error, !solve_failed_, trial_dt)) {
+      dt = trial_dt;
+      return;
+    }
+
+    SLIC_ERROR_ROOT_IF(rejections >= controller_->maxRejections(),
+                       "Adaptive timestep was rejected " << rejections << " times");
+    SLIC_INFO_ROOT("Rejected adaptive timestep dt = " << trial_dt << " (error " << error << "), retrying with dt = "
+                                                      << controller_->proposedTimestep());
+
+    // restart from the beginning of the step, re-initializing the mfem solver discards any
+    // state it kept from the rejected step
+    x            = x_n_;
+    state_.du_dt = du_dt_n_;
+    time         = time_n;
+    predictor_.clear();
+    ode_solver_->Init(*this);
+    trial_dt = controller_->proposedTimestep();
+  }
+}
+
+void FirstOrderODE::IMEXStep(mfem::Vector& x, double& time, double dt)
+{
+  SLIC_ERROR_ROOT_IF(!imex_splitting_, "The IMEX timesteppers require the split of the residual, see SetIMEXSplitting");
+
+  const IMEXTableau& tableau = *imex_tableau_;
+  const std::size_t  stages  = tableau.c.size();
+
+  // whether a later stage uses the residual of stage j
+  auto used = [stages](const std::vector<std::vector<double>>& a, std::size_t j) {
+    for (std::size_t i = j + 1; i < stages; i++) {
+      if (a[i][j] != 0.0) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  imex_implicit_residuals_.resize(stages);
+  imex_explicit_residuals_.resize(stages);
+  x_n_        = x;
+  imex_stage_ = x;
+  imex_rate_  = state_.du_dt;
+
+  mfem::Vector& load = imex_splitting_->load;
+  load.SetSize(height);
+
+  for (std::size_t i = 0; i < stages; i++) {
+    double t_i = time + tableau.c[i] * dt;
+
+    if (i > 0) {
+      load = 0.0;
+      for (std::size_t j = 0; j < i; j++) {
+        if (tableau.a_implicit[i][j] != 0.0) {
+          load.Add(tableau.a_implicit[i][j] / tableau.gamma, imex_implicit_residuals_[j]);
+        }
+        if (tableau.a_explicit[i][j] != 0.0) {
+          load.Add(tableau.a_explicit[i][j] / tableau.gamma, imex_explicit_residuals_[j]);
+        }
+      }
+
+      Solve(t_i, tableau.gamma * dt, x_n_, imex_rate_);
+      add(state_.u, tableau.gamma * dt, imex_rate_, imex_stage_);
+    }
+
+    if (used(tableau.a_implicit, i)) {
+      imex_implicit_residuals_[i].SetSize(height);
+      imex_splitting_->implicit_residual(imex_stage_, imex_implicit_residuals_[i]);
+    }
+    if (used(tableau.a_explicit, i)) {
+      imex_explicit_residuals_[i].SetSize(height);
+      imex_splitting_->explicit_residual(imex_stage_, t_i, imex_explicit_residuals_[i]);
+    }
+  }
+
+  load = 0.0;
+  x    = imex_stage_;
+  time += dt;
+}
+
 void FirstOrderODE::Solve(const double time, const double dt, const mfem::Vector& u, mfem::Vector& du_dt) const
 {
   // assign these values to variables with greater scope,
@@ -275,18 +526,9 @@ void FirstOrderODE::Solve(const double time, const double dt, const mfem::Vector
   state_.dt   = dt;
   state_.u    = u;
 
-  // evaluate the constraint functions at a 3-point
-  // stencil of times centered on the time of interest
-  // in order to compute finite-difference approximations
-  // to the time derivatives that appear in the residual
-  U_minus_ = 0.0;
-  U_       = 0.0;
-  U_plus_  = 0.0;
-  for (const auto& bc : bcs_.essentials()) {
-    bc.setDofs(U_minus_, time - epsilon);
-    bc.setDofs(U_, time);
-    bc.setDofs(U_plus_, time + epsilon);
-  }
+  // evaluate the constraint functions and the time
+  // derivative of them that appears in the residual
+  bcs_.setEssentialDofs(time, epsilon, U_, dU_dt_);
 
   bool implicit = (dt != 0.0);
   if (implicit) {
@@ -299,30 +541,35 @@ void FirstOrderODE::Solve(const double time, const double dt, const mfem::Vector
     }
 
     if (enforcement_method_ == DirichletEnforcementMethod::RateControl) {
-      dU_dt_ = (U_plus_ - U_minus_) / (2.0 * epsilon);
-      U_     = u;
+      U_ = u;
     }
 
     if (enforcement_method_ == DirichletEnforcementMethod::FullControl) {
-      dU_dt_ = (U_plus_ - U_minus_) / (2.0 * epsilon);
-      U_     = U_ - dt * dU_dt_;
+      U_.Add(-dt, dU_dt_);
     }
-  } else {
-    dU_dt_ = (U_plus_ - U_minus_) / (2.0 * epsilon);
   }
 
-  auto constrained_dofs = bcs_.allEssentialTrueDofs();
+  const auto& constrained_dofs = bcs_.allEssentialTrueDofs();
   state_.u.SetSubVector(constrained_dofs, 0.0);
   U_.SetSubVectorComplement(constrained_dofs, 0.0);
   state_.u += U_;
 
-  du_dt = state_.du_dt;
+  // use the previous (or extrapolated) solution as our starting guess
+  if (predictor_.ready()) {
+    predictor_.predict(time, du_dt);
+  } else {
+    du_dt = state_.du_dt;
+  }
   du_dt.SetSubVector(constrained_dofs, 0.0);
   dU_dt_.SetSubVectorComplement(constrained_dofs, 0.0);
   du_dt += dU_dt_;
 
   solver_.solve(du_dt);
-  SLIC_WARNING_ROOT_IF(!solver_.nonlinearSolver().GetConverged(), "Newton Solver did not converge.");
+  solve_failed_ = solve_failed_ || !solver_.converged();
+  if (solver_.converged()) {
+    predictor_.push(time, du_dt);
+  }
+  SLIC_WARNING_ROOT_IF(!controller_ && !solver_.converged(), "Newton Solver did not converge.");
 
   state_.du_dt       = du_dt;
   state_.previous_dt = dt;
@@ -13,14 +13,89 @@
 #pragma once
 
 #include <functional>
+#include <optional>
+#include <vector>
 
 #include "mfem.hpp"
 
 #include "serac/physics/boundary_conditions/boundary_condition_manager.hpp"
 #include "serac/numerics/equation_solver.hpp"
+#include "serac/numerics/solution_extrapolator.hpp"
 
 namespace serac::mfem_ext {
 
+/**
+ * @brief A PI controller that picks the timesteps of an adaptive ODE integrator from estimates of their local error
+ *
+ * The error of each step is measured in a weighted RMS norm, scaled so that a value of 1 is exactly at the
+ * tolerance. Steps with an error above 1, or whose nonlinear solves failed, are rejected and retried with a
+ * smaller timestep. The timestep after an accepted step is
+ *
+ * dt_{n+1} = s * dt_n * (1 / e_n)^{0.3 / k} * (e_{n-1} / e_n)^{0.4 / k}
+ *
+ * where k is the order of the error estimate and s is a safety factor, so that dt grows while the solution is quiet.
+ */
+class TimestepController {
+public:
+  /**
+   * @brief Construct a controller
+   *
+   * @param[in] options The adaptivity tolerances and timestep limits
+   * @param[in] order The order k of the error estimate in dt, e ~ dt^k
+   */
+  TimestepController(const TimesteppingOptions& options, int order);
+
+  /**
+   * @brief The timestep to attempt next
+   *
+   * @param[in] requested_dt The timestep requested by the caller, which caps the attempted step
+   * @return The smaller of the requested timestep and the timestep proposed after the previous step
+   */
+  double trialTimestep(double requested_dt) const;
+
+  /**
+   * @brief The weighted RMS norm of a local error estimate, summed over all ranks
+   *
+   * @param[in] error The local error estimate of each true DOF
+   * @param[in] x The solution at the end of the step, which scales the relative tolerance
+   * @param[in] comm The communicator the DOFs are distributed over
+   */
+  double errorNorm(const mfem::Vector& error, const mfem::Vector& x, MPI_Comm comm) const;
+
+  /**
+   * @brief Decide whether to keep a step, and propose the timestep to attempt next
+   *
+   * @param[in] error The error norm of the step from errorNorm()
+   * @param[in] converged Whether every nonlinear solve in the step converged
+   * @param[in] dt The timestep that was attempted
+   * @return Whether the step is accepted
+   */
+  bool accept(double error, bool converged, double dt);
+
+  /**
+   * @brief The timestep proposed by the last call to accept()
+   */
+  double proposedTimestep() const { return proposed_dt_; }
+
+  /**
+   * @brief The number of times a step may be rejected before giving up
+   */
+  int maxRejections() const { return options_.max_rejections; }
+
+private:
+  /// The adaptivity tolerances and timestep limits
+  TimesteppingOptions options_;
+
+  /// The order of the error estimate in dt
+  int order_;
+
+  /// The error norm of the last accepted step
+  double previous_error_ = 1.0;
+
+  /// The timestep proposed after the last step, zero before the first step
+  double proposed_dt_ = 0.0;
+};
+
 /**
  * @brief SecondOrderODE is a class wrapping mfem::SecondOrderTimeDependentOperator
  *   so that the user can use std::function to define the implementations of
@@ -146,13 +221,32 @@ public:
    */
   void SetTimestepper(const serac::TimestepMethod timestepper);
 
+  /**
+   * @brief Adapt the timestep of each Step() to the local error, see TimestepController
+   *
+   * The local error is estimated as a third of the difference between the displacement and its
+   * constant-acceleration extrapolation from the start of the step. For average acceleration Newmark (beta = 1/4)
+   * this is the Zienkiewicz-Xie estimate e = (beta - 1/6) * dt^2 * (d2u_dt2_{n+1} - d2u_dt2_n), e ~ dt^3.
+   *
+   * @param[in] options The adaptivity tolerances and timestep limits
+   */
+  void SetAdaptiveTimestepping(const TimesteppingOptions& options);
+
+  /**
+   * @brief Start each nonlinear solve from an extrapolation of the last converged solutions, see SolutionExtrapolator
+   *
+   * @param[in] num_states The number of converged solutions to extrapolate from, zero uses the previous solution
+   */
+  void SetPredictor(int num_states) { predictor_ = SolutionExtrapolator(num_states); }
+
   /**
    * @brief Performs a time step
    *
    * @param[inout] x The predicted solution
    * @param[inout] dxdt The predicted rate
    * @param[inout] time The current time
-   * @param[inout] dt The desired time step
+   * @param[inout] dt The desired time step. With adaptive timestepping this caps the step, and the timestep
+   * actually taken is returned.
    *
    * @see mfem::SecondOrderODESolver::Step
    */
@@ -178,6 +272,11 @@ private:
   void Solve(const double time, const double c0, const double c1, const mfem::Vector& u, const mfem::Vector& du_dt,
              mfem::Vector& d2u_dt2) const;
 
+  /**
+   * @brief Take one step with the underlying mfem solver, without any timestep adaptivity
+   */
+  void StepOnce(mfem::Vector& x, mfem::Vector& dxdt, double& time, double& dt);
+
   /**
    * @brief Set of references to external variables used by residual operator
    */
@@ -209,11 +308,32 @@ private:
   /**
    * @brief Working vectors for ODE outputs prior to constraint enforcement
    */
-  mutable mfem::Vector U_minus_;
   mutable mfem::Vector U_;
-  mutable mfem::Vector U_plus_;
   mutable mfem::Vector dU_dt_;
   mutable mfem::Vector d2U_dt2_;
+
+  /**
+   * @brief Controller for adaptive timestepping, null if the timestep is fixed
+   */
+  std::unique_ptr<TimestepController> controller_;
+
+  /**
+   * @brief Whether a nonlinear solve failed during the current step
+   */
+  mutable bool solve_failed_ = false;
+
+  /**
+   * @brief The state at the start of an adaptive step, restored if the step is rejected
+   */
+  mfem::Vector x_n_;
+  mfem::Vector dxdt_n_;
+  mfem::Vector d2xdt2_n_;
+  mfem::Vector error_;
+
+  /**
+   * @brief Predictor for the initial guess of d2u_dt2 in each solve
+   */
+  mutable SolutionExtrapolator predictor_;
 };
 
 /**
@@ -320,23 +440,61 @@ public:
    */
   void SetTimestepper(const serac::TimestepMethod timestepper);
 
+  /**
+   * @brief Adapt the timestep of each Step() to the local error, see TimestepController
+   *
+   * The local error is estimated as half the difference between the solution and its forward Euler
+   * extrapolation from the start of the step, e ~ dt^2 / 2 * d2u_dt2. This is the first-order estimate for every
+   * method, since mfem's SDIRK solvers do not expose their stages, so it is conservative for the higher order ones.
+   *
+   * @param[in] options The adaptivity tolerances and timestep limits
+   */
+  void SetAdaptiveTimestepping(const TimesteppingOptions& options);
+
+  /**
+   * @brief Start each nonlinear solve from an extrapolation of the last converged solutions, see SolutionExtrapolator
+   *
+   * @param[in] num_states The number of converged solutions to extrapolate from, zero uses the previous solution
+   */
+  void SetPredictor(int num_states) { predictor_ = SolutionExtrapolator(num_states); }
+
+  /**
+   * @brief The split of the residual r(u, du_dt, t) = r_I(u, du_dt) + r_E(u, t) into the part that the IMEX
+   * timesteppers (e.g. TimestepMethod::IMEXARS222) treat implicitly and the part they treat explicitly
+   *
+   * The operator of the equation solver is then the implicit residual r_I(u + dt * du_dt, du_dt) plus @a load, so
+   * each stage is one solve with the same dt = gamma * dt_step. When r_I is linear (e.g. conduction), the solver
+   * can keep its Jacobian and preconditioner across all stages and steps of the same size.
+   */
+  struct IMEXSplitting {
+    /// Evaluates the implicit residual at zero rate, r = r_I(u, 0)
+    std::function<void(const mfem::Vector& u, mfem::Vector& r)> implicit_residual;
+
+    /// Evaluates the explicit residual, r = r_E(u, t)
+    std::function<void(const mfem::Vector& u, double t, mfem::Vector& r)> explicit_residual;
+
+    /// The load added to the implicit residual, set by Step() before each stage solve
+    mfem::Vector& load;
+  };
+
+  /**
+   * @brief Set the split of the residual for the IMEX timesteppers
+   *
+   * @param[in] splitting The implicit and explicit parts of the residual
+   */
+  void SetIMEXSplitting(IMEXSplitting splitting) { imex_splitting_.emplace(std::move(splitting)); }
+
   /**
    * @brief Performs a time step
    *
    * @param[inout] x The predicted solution
    * @param[inout] time The current time
-   * @param[inout] dt The desired time step
+   * @param[inout] dt The desired time step. With adaptive timestepping this caps the step, and the timestep
+   * actually taken is returned.
    *
    * @see mfem::ODESolver::Step
    */
-  void Step(mfem::Vector& x, double& time, double& dt)
-  {
-    if (ode_solver_) {
-      ode_solver_->Step(x, time, dt);
-    } else {
-      SLIC_ERROR("ode_solver_ unspecified");
-    }
-  }
+  void Step(mfem::Vector& x, double& time, double& dt);
 
 private:
   /**
@@ -348,11 +506,53 @@ private:
    */
   virtual void Solve(const double time, const double dt, const mfem::Vector& u, mfem::Vector& du_dt) const;
 
+  /**
+   * @brief The Butcher tableaux of an IMEX Runge-Kutta method whose first stage is explicit and whose implicit
+   * stages share the diagonal gamma, e.g. c = (0, gamma, 1) for ARS(2,2,2)
+   */
+  struct IMEXTableau {
+    double                           gamma;       ///< the diagonal of the implicit tableau
+    std::vector<double>              c;           ///< the time of each stage, as a fraction of the step
+    std::vector<std::vector<double>> a_implicit;  ///< the implicit tableau
+    std::vector<std::vector<double>> a_explicit;  ///< the explicit tableau
+  };
+
+  /**
+   * @brief Performs a step of an IMEX method, which is stiffly accurate so the last stage is the solution
+   *
+   * Each stage i > 0 solves M (U_i - u_n) / (gamma dt) + r_I(U_i) + load_i = 0 with
+   * load_i = sum_{j < i} (a_implicit[i][j] r_I(U_j) + a_explicit[i][j] r_E(U_j, t_j)) / gamma.
+   *
+   * @param[inout] x The solution
+   * @param[inout] time The current time
+   * @param[in] dt The time step
+   */
+  void IMEXStep(mfem::Vector& x, double& time, double dt);
+
   /**
    * @brief Set of references to external variables used by residual operator
    */
   FirstOrderODE::State state_;
 
+  /**
+   * @brief The tableau of the IMEX timestepper, if one is used instead of an mfem solver
+   */
+  std::optional<IMEXTableau> imex_tableau_;
+
+  /**
+   * @brief The split of the residual for the IMEX timesteppers
+   */
+  std::optional<IMEXSplitting> imex_splitting_;
+
+  /**
+   * @brief Working vectors of IMEX steps: the implicit and explicit residuals of each stage, and the solution and
+   * rate of the current stage
+   */
+  std::vector<mfem::Vector> imex_implicit_residuals_;
+  std::vector<mfem::Vector> imex_explicit_residuals_;
+  mfem::Vector              imex_stage_;
+  mfem::Vector              imex_rate_;
+
   /**
    * @brief The method of enforcing time-varying dirichlet boundary conditions
    */
@@ -374,10 +574,30 @@ private:
   /**
    * @brief Working vectors for ODE outputs prior to constraint enforcement
    */
-  mutable mfem::Vector U_minus_;
   mutable mfem::Vector U_;
-  mutable mfem::Vector U_plus_;
   mutable mfem::Vector dU_dt_;
+
+  /**
+   * @brief Controller for adaptive timestepping, null if the timestep is fixed
+   */
+  std::unique_ptr<TimestepController> controller_;
+
+  /**
+   * @brief Whether a nonlinear solve failed during the current step
+   */
+  mutable bool solve_failed_ = false;
+
+  /**
+   * @brief The state at the start of an adaptive step, restored if the step is rejected
+   */
+  mfem::Vector x_n_;
+  mfem::Vector du_dt_n_;
+  mfem::Vector error_;
+
+  /**
+   * @brief Predictor for the initial guess of du_dt in each solve
+   */
+  mutable SolutionExtrapolator predictor_;
 };
 
 }  // namespace serac::mfem_ext
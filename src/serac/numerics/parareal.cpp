@@ -0,0 +1,116 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/numerics/parareal.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "axom/fmt.hpp"
+
+#include "serac/infrastructure/initialize.hpp"
+#include "serac/infrastructure/logger.hpp"
+
+namespace serac {
+
+std::pair<MPI_Comm, MPI_Comm> splitTimeSlices(MPI_Comm comm, int num_slices)
+{
+  auto [num_ranks, rank] = getMPIInfo(comm);
+  SLIC_ERROR_ROOT_IF(num_slices < 1 || num_ranks % num_slices != 0,
+                     axom::fmt::format("{} time slices do not divide {} ranks evenly", num_slices, num_ranks));
+
+  int ranks_per_slice = num_ranks / num_slices;
+
+  MPI_Comm space_comm;
+  MPI_Comm time_comm;
+  MPI_Comm_split(comm, rank / ranks_per_slice, rank, &space_comm);
+  MPI_Comm_split(comm, rank % ranks_per_slice, rank, &time_comm);
+  return {space_comm, time_comm};
+}
+
+Parareal::Parareal(MPI_Comm space_comm, MPI_Comm time_comm, Propagator fine, Propagator coarse,
+                   const PararealOptions& options)
+    : space_comm_(space_comm), time_comm_(time_comm), fine_(fine), coarse_(coarse), options_(options)
+{
+}
+
+double Parareal::norm(const mfem::Vector& state) const
+{
+  return std::sqrt(mfem::InnerProduct(space_comm_, state, state));
+}
+
+int Parareal::solve(mfem::Vector& state, double t0, double slice_length) const
+{
+  // one slice per rank (copied out of the pair, so that the lambdas below can capture them)
+  auto   time_info  = getMPIInfo(time_comm_);
+  int    num_slices = time_info.first;
+  int    slice      = time_info.second;
+  double t          = t0 + slice * slice_length;
+  int    size       = state.Size();
+
+  // the initial values are passed on to the next slice, in a sweep from the first slice to the last
+  auto receive = [&](mfem::Vector& initial) {
+    if (slice > 0) {
+      MPI_Recv(initial.HostWrite(), size, MPI_DOUBLE, slice - 1, 0, time_comm_, MPI_STATUS_IGNORE);
+    }
+  };
+  auto send = [&](const mfem::Vector& next_initial) {
+    if (slice < num_slices - 1) {
+      MPI_Send(next_initial.HostRead(), size, MPI_DOUBLE, slice + 1, 0, time_comm_);
+    }
+  };
+
+  // the initial value of the first slice is given, and those of the others are predicted by the coarse propagator
+  mfem::Vector initial(state);
+  mfem::Vector coarse(size);
+  receive(initial);
+  coarse = initial;
+  coarse_(coarse, t, slice_length);
+  send(coarse);
+
+  mfem::Vector fine(size);
+  mfem::Vector next_coarse(size);
+  mfem::Vector change(size);
+
+  int max_iterations = std::min(options_.max_iterations, num_slices);
+  int iteration      = 0;
+  while (iteration < max_iterations) {
+    iteration++;
+
+    // the fine propagation of every slice at once ...
+    fine = initial;
+    fine_(fine, t, slice_length);
+
+    // ... and the coarse correction of the initial values, U_{i+1} <- G(U_i^new) + F(U_i^old) - G(U_i^old)
+    change = initial;
+    receive(initial);
+    next_coarse = initial;
+    coarse_(next_coarse, t, slice_length);
+
+    mfem::Vector next_initial(next_coarse);
+    next_initial += fine;
+    next_initial -= coarse;
+    send(next_initial);
+    coarse = next_coarse;
+
+    change -= initial;
+    double norms[2] = {norm(change), norm(initial)};
+    MPI_Allreduce(MPI_IN_PLACE, norms, 2, MPI_DOUBLE, MPI_MAX, time_comm_);
+
+    if (options_.print_level > 0) {
+      SLIC_INFO_ROOT(axom::fmt::format("Parareal iteration {}: change in the initial values {}", iteration, norms[0]));
+    }
+    if (norms[0] <= std::max(options_.absolute_tol, options_.relative_tol * norms[1])) {
+      break;
+    }
+  }
+
+  // the fine solution of this slice, from an initial value within the tolerance of the converged one
+  state = fine;
+  return iteration;
+}
+
+}  // namespace serac
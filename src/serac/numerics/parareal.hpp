@@ -0,0 +1,113 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file parareal.hpp
+ *
+ * @brief A parallel-in-time (Parareal) driver for long transient simulations
+ */
+
+#pragma once
+
+#include <functional>
+#include <utility>
+
+#include "mpi.h"
+#include "mfem.hpp"
+
+namespace serac {
+
+/**
+ * @brief Advances a state (in place) from the time @a t over an interval of length @a dt
+ */
+using Propagator = std::function<void(mfem::Vector& state, double t, double dt)>;
+
+/// @brief The convergence criteria of the Parareal iteration
+struct PararealOptions {
+  /// Stop once the slice initial values change by less than this (relative to their norm) in an iteration
+  double relative_tol = 1.0e-8;
+
+  /// Stop once the slice initial values change by less than this in an iteration
+  double absolute_tol = 1.0e-12;
+
+  /// The maximum number of iterations, which never exceeds the number of time slices (where it is exact)
+  int max_iterations = 10;
+
+  /// Log the change of each iteration if positive
+  int print_level = 0;
+};
+
+/**
+ * @brief Split the ranks of @p comm into @p num_slices groups, each of which integrates one slice of time
+ *
+ * @param[in] comm The communicator of all the ranks
+ * @param[in] num_slices The number of time slices, which must divide the size of @p comm
+ * @return The spatial communicator (of the ranks of the same slice, over which the mesh of the slice is
+ * distributed) and the temporal communicator (of the ranks with the same part of the mesh in each slice)
+ */
+std::pair<MPI_Comm, MPI_Comm> splitTimeSlices(MPI_Comm comm, int num_slices);
+
+/**
+ * @brief Integrates a transient problem over the slices of time in parallel, with the Parareal algorithm
+ *
+ * The time interval is cut into one slice per rank of the temporal communicator. Each iteration integrates all
+ * of the slices at once with the accurate (fine) propagator, from the current estimates of their initial values,
+ * and then corrects those estimates with a sweep of the cheap (coarse) propagator across the slices:
+ *
+ *   U_{i+1} <- G(U_i^new) + F(U_i^old) - G(U_i^old)
+ *
+ * The fine propagator usually takes the many small steps of the sequential integration, and the coarse one a
+ * single large backward Euler step. After k iterations, the first k slices are exactly those of the sequential
+ * integration, so the iteration converges in at most as many iterations as there are slices, but typically in far
+ * fewer, each of which costs about one slice of fine steps.
+ */
+class Parareal {
+public:
+  /**
+   * @brief Construct a Parareal driver
+   *
+   * @param[in] space_comm The communicator the states of a time slice are distributed over
+   * @param[in] time_comm The communicator of the time slices, where rank i integrates slice i
+   * @param[in] fine The accurate propagator over a time slice
+   * @param[in] coarse The cheap propagator over a time slice
+   * @param[in] options The convergence criteria
+   * @note see splitTimeSlices() for the communicators
+   */
+  Parareal(MPI_Comm space_comm, MPI_Comm time_comm, Propagator fine, Propagator coarse,
+           const PararealOptions& options = {});
+
+  /**
+   * @brief Integrate the time slices
+   *
+   * @param[inout] state The initial state of the first slice (on every slice) on entry, and the fine solution at
+   * the end of this rank's slice on exit
+   * @param[in] t0 The time at the start of the first slice
+   * @param[in] slice_length The length of each time slice
+   * @return The number of iterations
+   */
+  int solve(mfem::Vector& state, double t0, double slice_length) const;
+
+private:
+  /// @brief The norm of a state over the spatial communicator
+  double norm(const mfem::Vector& state) const;
+
+  /// @brief The communicator the states of a time slice are distributed over
+  MPI_Comm space_comm_;
+
+  /// @brief The communicator of the time slices
+  MPI_Comm time_comm_;
+
+  /// @brief The accurate propagator
+  Propagator fine_;
+
+  /// @brief The cheap propagator
+  Propagator coarse_;
+
+  /// @brief The convergence criteria
+  PararealOptions options_;
+};
+
+}  // namespace serac
@@ -0,0 +1,61 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/numerics/solution_extrapolator.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "serac/infrastructure/logger.hpp"
+
+namespace serac {
+
+SolutionExtrapolator::SolutionExtrapolator(int num_states)
+    : capacity_(num_states), times_(static_cast<size_t>(std::max(num_states, 0))), solutions_(times_.size())
+{
+  SLIC_ERROR_ROOT_IF(num_states < 0 || num_states > 3,
+                     "Solution extrapolation keeps between 0 and 3 converged states, not " << num_states);
+}
+
+void SolutionExtrapolator::push(double time, const mfem::Vector& solution)
+{
+  if (!enabled()) {
+    return;
+  }
+
+  // discard anything that is not strictly older, so that the kept times stay distinct
+  constexpr double tolerance = 1.0e-14;
+  while (count_ > 0 && times_[static_cast<size_t>(newest_)] >= time - tolerance * std::max(1.0, std::abs(time))) {
+    newest_ = (newest_ + capacity_ - 1) % capacity_;
+    count_--;
+  }
+
+  newest_                                  = (newest_ + 1) % capacity_;
+  times_[static_cast<size_t>(newest_)]     = time;
+  solutions_[static_cast<size_t>(newest_)] = solution;
+  count_                                   = std::min(count_ + 1, capacity_);
+}
+
+void SolutionExtrapolator::predict(double time, mfem::Vector& solution) const
+{
+  SLIC_ERROR_ROOT_IF(!ready(), "Not enough converged states have been kept to extrapolate the solution");
+
+  solution.SetSize(solutions_[static_cast<size_t>(newest_)].Size());
+  solution = 0.0;
+
+  // Lagrange interpolating polynomial through the kept (time, solution) pairs, evaluated at time
+  for (size_t i = 0; i < times_.size(); i++) {
+    double weight = 1.0;
+    for (size_t j = 0; j < times_.size(); j++) {
+      if (j != i) {
+        weight *= (time - times_[j]) / (times_[i] - times_[j]);
+      }
+    }
+    solution.Add(weight, solutions_[i]);
+  }
+}
+
+}  // namespace serac
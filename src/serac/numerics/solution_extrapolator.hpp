@@ -0,0 +1,88 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file solution_extrapolator.hpp
+ *
+ * @brief A predictor for the initial guess of time-dependent nonlinear solves
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "mfem.hpp"
+
+namespace serac {
+
+/**
+ * @brief Predicts the solution at a new time by polynomial extrapolation of the last few converged solutions
+ *
+ * The converged solutions are kept in a ring buffer. With 2 of them the prediction is linear in time, and with 3
+ * it is quadratic. Higher orders are not supported, as equally spaced extrapolation quickly becomes oscillatory.
+ */
+class SolutionExtrapolator {
+public:
+  /**
+   * @brief Construct an extrapolator
+   *
+   * @param[in] num_states The number of converged solutions to extrapolate from, zero disables the predictor
+   */
+  explicit SolutionExtrapolator(int num_states = 0);
+
+  /**
+   * @brief Whether the predictor is enabled
+   */
+  bool enabled() const { return capacity_ > 0; }
+
+  /**
+   * @brief Whether enough converged solutions have been kept to make a prediction
+   */
+  bool ready() const { return enabled() && count_ == capacity_; }
+
+  /**
+   * @brief Keep a converged solution
+   *
+   * Kept solutions at or after @a time are discarded first, e.g. those from a rejected step that was restarted
+   *
+   * @param[in] time The time of the solution
+   * @param[in] solution The converged solution
+   */
+  void push(double time, const mfem::Vector& solution);
+
+  /**
+   * @brief Extrapolate the kept solutions to a new time
+   *
+   * @pre ready() must be true
+   *
+   * @param[in] time The time to predict the solution at
+   * @param[out] solution The predicted solution
+   */
+  void predict(double time, mfem::Vector& solution) const;
+
+  /**
+   * @brief Discard all of the kept solutions, e.g. after the state is reset
+   */
+  void clear() { count_ = 0; }
+
+private:
+  /// The number of solutions the ring buffer holds
+  int capacity_;
+
+  /// The number of solutions currently kept
+  int count_ = 0;
+
+  /// The index of the most recently kept solution
+  int newest_ = -1;
+
+  /// The times of the kept solutions
+  std::vector<double> times_;
+
+  /// The kept solutions
+  std::vector<mfem::Vector> solutions_;
+};
+
+}  // namespace serac
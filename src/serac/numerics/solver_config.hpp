@@ -36,6 +36,8 @@ enum class TimestepMethod
   ImplicitMidpoint, /**< FirstOrderODE option */
   SDIRK23,          /**< FirstOrderODE option */
   SDIRK34,          /**< FirstOrderODE option */
+  IMEXEuler,        /**< FirstOrderODE option, forward-backward Euler, see FirstOrderODE::SetIMEXSplitting() */
+  IMEXARS222,       /**< FirstOrderODE option, the L-stable second order IMEX method of Ascher, Ruuth and Spiteri */
 
   // options for second order ODEs
   //
@@ -49,7 +51,10 @@ enum class TimestepMethod
   AverageAcceleration, /**< SecondOrderODE option */
   LinearAcceleration,  /**< SecondOrderODE option */
   CentralDifference,   /**< SecondOrderODE option */
-  FoxGoodwin           /**< SecondOrderODE option */
+  FoxGoodwin,          /**< SecondOrderODE option */
+
+  // an explicit method that bypasses the ODE and nonlinear solvers, used by SolidMechanics only
+  ExplicitCentralDifference /**< Central difference with a lumped mass, so that steps need no linear solves */
 };
 
 /**
@@ -94,15 +99,46 @@ struct TimesteppingOptions {
 
   /// The essential boundary enforcement method to use
   DirichletEnforcementMethod enforcement_method = DirichletEnforcementMethod::RateControl;
+
+  /// Adapt the timestep with a PI controller on an estimate of the local error of each step
+  bool adaptive = false;
+
+  /// Relative tolerance on the local error estimate of an adaptive step
+  double error_relative_tol = 1.0e-4;
+
+  /// Absolute tolerance on the local error estimate of an adaptive step
+  double error_absolute_tol = 1.0e-8;
+
+  /// Smallest timestep an adaptive step may be cut back to before giving up
+  double min_dt = 0.0;
+
+  /// Largest timestep an adaptive step may grow to, zero means unlimited
+  double max_dt = 0.0;
+
+  /// Largest factor an adaptive timestep may grow by from one step to the next
+  double max_dt_growth = 2.0;
+
+  /// Number of times an adaptive step may be rejected and retried before giving up
+  int max_rejections = 10;
+
+  /// Number of previously converged states (2 or 3) extrapolated in time for the initial guess of each nonlinear
+  /// solve, zero to start from the previous solution (or the linearized predictor, for quasi-static problems)
+  int extrapolation_states = 0;
+
+  /// Take the ForwardEuler, RK2 or RK4 steps with a lumped (diagonal) mass, so that each stage is a residual
+  /// evaluation instead of a solve, used by HeatTransfer only (see HeatTransfer::stableTimestep())
+  bool lumped_mass = false;
 };
 
 // _linear_solvers_start
 /// Linear solution method indicator
 enum class LinearSolver
 {
-  CG,     /**< Conjugate gradient */
-  GMRES,  /**< Generalized minimal residual method */
-  SuperLU /**< SuperLU MPI-enabled direct Solver */
+  CG,          /**< Conjugate gradient */
+  DeflatedCG,  /**< Conjugate gradient deflated by a subspace recycled from previous solves */
+  PipelinedCG, /**< Conjugate gradient with one nonblocking reduction per iteration, for large rank counts */
+  GMRES,       /**< Generalized minimal residual method */
+  SuperLU      /**< SuperLU MPI-enabled direct Solver */
 };
 // _linear_solvers_end
 
@@ -117,10 +153,44 @@ enum class NonlinearSolver
   LBFGS,                     /**< MFEM-native Limited memory BFGS */
   KINFullStep,               /**< KINSOL Full Newton (Sundials must be enabled) */
   KINBacktrackingLineSearch, /**< KINSOL Newton with Backtracking Line Search (Sundials must be enabled) */
-  KINPicard                  /**< KINSOL Picard (Sundials must be enabled) */
+  KINPicard,                 /**< KINSOL Picard (Sundials must be enabled) */
+  Anderson,                  /**< Anderson-accelerated modified Newton, i.e. fixed-point iteration preconditioned with a
+                                  reused Jacobian */
+  JFNK                       /**< Jacobian-free Newton-Krylov, preconditioned with a solve with a reused Jacobian */
 };
 // _nonlinear_solvers_end
 
+// _jacobian_reuse_start
+/// Policy for reusing the Jacobian (and the preconditioner built from it) between Newton iterations
+enum class JacobianReuse
+{
+  Never,       /**< Full Newton, the Jacobian is rebuilt every iteration */
+  WithinSolve, /**< Modified Newton, the Jacobian is rebuilt at the start of every solve and reused within it */
+  AcrossSolves /**< Modified Newton, the Jacobian is also kept from one solve (e.g. timestep) to the next */
+};
+// _jacobian_reuse_end
+
+// _forcing_terms_start
+/// Method for choosing the relative tolerance of each linear solve inside an inexact Newton method
+enum class ForcingTerm
+{
+  Fixed,            /**< Use the linear solver's own relative tolerance for every Newton iteration */
+  EisenstatWalker1, /**< Eisenstat-Walker choice 1, based on the agreement of the linear model and the residual */
+  EisenstatWalker2  /**< Eisenstat-Walker choice 2, based on the nonlinear residual reduction */
+};
+// _forcing_terms_end
+
+// _globalization_start
+/// Globalization of the Newton updates, which only evaluates residuals (with no Jacobian assembly) to pick the step
+enum class NonlinearGlobalization
+{
+  None,         /**< Take every full Newton update */
+  Backtracking, /**< Halve the update until it sufficiently decreases the residual norm (Armijo line search) */
+  TrustRegion   /**< Limit the length of the update to a radius set by how well the linear model predicted the
+                     decrease of the residual norm in the previous iterations */
+};
+// _globalization_end
+
 /**
  * @brief Solver types supported by AMGX
  */
@@ -142,6 +212,18 @@ enum class AMGXSolver
   MULTICOLOR_DILU /**< GPU MULTICOLOR_DILU */
 };
 
+/**
+ * @brief How an AMGX preconditioner is updated when it is given a new operator (e.g. in each Newton iteration)
+ */
+enum class AMGXResetup
+{
+  Full,             /**< Upload the new matrix and set up the AMG hierarchy from scratch */
+  CoefficientsOnly, /**< Replace the coefficients of the uploaded matrix (with the same sparsity pattern), and set up
+                         the hierarchy again on the structure (aggregates and interpolation sparsity) of the last one */
+  ReuseHierarchy    /**< Keep the last hierarchy for a number of operator updates (see AMGXOptions::reuse_period)
+                         before a full setup */
+};
+
 /**
  * @brief Stores the information required to configure a NVIDIA AMGX preconditioner
  */
@@ -158,22 +240,47 @@ struct AMGXOptions {
    * @brief Whether to display statistics from AMGX
    */
   bool verbose = false;
+  /**
+   * @brief How the preconditioner is updated for a new operator. Operators with a different sparsity pattern than
+   * the last one always get a full setup.
+   */
+  AMGXResetup resetup = AMGXResetup::Full;
+  /**
+   * @brief For AMGXResetup::ReuseHierarchy, the number of operator updates that use one setup
+   */
+  int reuse_period = 1;
 };
 
 // _preconditioners_start
 /// The type of preconditioner to be used
 enum class Preconditioner
 {
-  HypreJacobi,      /**< Hypre-based Jacobi */
-  HypreL1Jacobi,    /**< Hypre-based L1-scaled Jacobi */
-  HypreGaussSeidel, /**< Hypre-based Gauss-Seidel */
-  HypreAMG,         /**< Hypre's BoomerAMG algebraic multi-grid */
-  HypreILU,         /**< Hypre's Incomplete LU */
-  AMGX,             /**< NVIDIA's AMGX GPU-enabled algebraic multi-grid, GPU builds only */
-  None              /**< No preconditioner used */
+  HypreJacobi,          /**< Hypre-based Jacobi */
+  HypreL1Jacobi,        /**< Hypre-based L1-scaled Jacobi */
+  HypreGaussSeidel,     /**< Hypre-based Gauss-Seidel */
+  HypreAMG,             /**< Hypre's BoomerAMG algebraic multi-grid */
+  HypreILU,             /**< Hypre's Incomplete LU */
+  AMGX,                 /**< NVIDIA's AMGX GPU-enabled algebraic multi-grid, GPU builds only */
+  Jacobi,               /**< Jacobi smoother built from the operator's diagonal, no assembled matrix required */
+  Chebyshev,            /**< Chebyshev smoother built from the operator's diagonal, no assembled matrix required */
+  PMultigrid,           /**< p-multigrid over the H1 orders p, p/2, ..., 1, with BoomerAMG on the p = 1 level */
+  GeometricMultigrid,   /**< geometric multigrid over refineAndDistribute's coarse meshes, BoomerAMG on the coarsest */
+  LOR,                  /**< BoomerAMG on the low-order-refined matrix of an H1 space, no assembled matrix required */
+  SeparateComponentAMG, /**< BoomerAMG on the Jacobian without couplings between components, see SolidMechanics */
+  None                  /**< No preconditioner used */
 };
 // _preconditioners_end
 
+// _adjoint_preconditioning_start
+/// How the transposed (adjoint) linear systems of EquationSolver::solveTranspose() are preconditioned
+enum class AdjointPreconditioning
+{
+  Rebuild,        /**< Set up the preconditioner (or SuperLU factorization) anew for every adjoint solve */
+  ReuseForward,   /**< Reuse the preconditioner or factorization of the last forward solve, where it applies to J^T */
+  CachedTranspose /**< Like ReuseForward, and otherwise set up J^T's preconditioner once until the next forward solve */
+};
+// _adjoint_preconditioning_end
+
 // _linear_options_start
 /// Parameters for an iterative linear solution scheme
 struct LinearSolverOptions {
@@ -197,6 +304,45 @@ struct LinearSolverOptions {
 
   /// Debugging print level for the preconditioner
   int preconditioner_print_level = 0;
+
+  /**
+   * For the HypreAMG preconditioner, the number of operator updates (e.g. Newton iterations or timesteps) that
+   * reuse an AMG hierarchy before it is set up again. The default of 1 sets it up for every new operator.
+   */
+  int preconditioner_rebuild_period = 1;
+
+  /// For the AMGX preconditioner, its configuration (including how it is updated for new operators)
+  AMGXOptions amgx_options = {};
+
+  /**
+   * For the DeflatedCG linear solver, the number of previous solutions kept as the recycled (deflation) subspace
+   * of the following solves
+   */
+  int recycled_subspace_dimension = 4;
+
+  /**
+   * For the PMultigrid and GeometricMultigrid preconditioners, store and apply the operators of the smoothed levels
+   * in single precision, which halves their memory footprint and the memory traffic of the smoothers, while the
+   * Krylov solver (and the coarsest level's AMG) remain in double precision
+   */
+  bool single_precision_preconditioner = false;
+
+  /**
+   * Use the action of the Jacobian (instead of an assembled sparse matrix) in the linear solves.
+   * This requires an iterative linear solver and one of the matrix-free preconditioners
+   * (Jacobi, Chebyshev, LOR, SeparateComponentAMG) or no preconditioner.
+   */
+  bool matrix_free = false;
+
+  /**
+   * How the adjoint solves are preconditioned. The forward preconditioner (e.g. the AMG hierarchy of the last Newton
+   * iteration) applies to the transposed system when the Jacobian is symmetric, or when it only depends on the
+   * diagonal of the matrix (e.g. Jacobi). A SuperLU factorization of the last Newton iteration always applies, with
+   * a few steps of iterative refinement for the slightly different Jacobian at the converged solution. Otherwise,
+   * CachedTranspose keeps a separate preconditioner of J^T, set up by the first adjoint solve after each forward solve
+   * (i.e. once per design iteration), so that the adjoint solves of several quantities of interest share it.
+   */
+  AdjointPreconditioning adjoint_preconditioning = AdjointPreconditioning::ReuseForward;
 };
 // _linear_options_end
 
@@ -217,6 +363,51 @@ struct NonlinearSolverOptions {
 
   /// Debug print level
   int print_level = 0;
+
+  /**
+   * When the Jacobian is rebuilt, only supported by the Newton, Anderson and JFNK nonlinear solvers. The latter two
+   * always reuse the Jacobian within a solve, so only AcrossSolves changes their behavior.
+   */
+  JacobianReuse jacobian_reuse = JacobianReuse::Never;
+
+  /// When reusing the Jacobian, rebuild it after this many iterations (0 means no limit)
+  int jacobian_rebuild_period = 0;
+
+  /**
+   * When reusing the Jacobian, rebuild it once an iteration reduces the residual norm
+   * by less than this factor, i.e. when ||r_{k+1}|| > jacobian_stagnation_ratio * ||r_k||
+   */
+  double jacobian_stagnation_ratio = 0.5;
+
+  /// How the linear solver relative tolerance is chosen each Newton iteration, requires an iterative linear solver
+  ForcingTerm forcing_term = ForcingTerm::Fixed;
+
+  /// Linear solver relative tolerance for the first Newton iteration, when using an Eisenstat-Walker forcing term
+  double forcing_term_initial = 0.5;
+
+  /// Upper bound for the linear solver relative tolerance, when using an Eisenstat-Walker forcing term
+  double forcing_term_max = 0.9;
+
+  /// The globalization of the updates, only supported by the Newton and JFNK nonlinear solvers
+  NonlinearGlobalization globalization = NonlinearGlobalization::None;
+
+  /// The maximum number of shortened updates tried by the globalization in each iteration
+  int max_line_search_iterations = 10;
+
+  /**
+   * The fraction of the decrease of the residual norm predicted by the linear model that an update must achieve to
+   * be accepted by the globalization
+   */
+  double sufficient_decrease = 1.0e-4;
+
+  /// The number of previous iterates the Anderson nonlinear solver fits the residual with
+  int anderson_depth = 5;
+
+  /// The relative tolerance of the Jacobian-free Krylov solve of each JFNK iteration
+  double jfnk_relative_tol = 1.0e-4;
+
+  /// The maximum number of Jacobian-free Krylov iterations of each JFNK iteration
+  int jfnk_max_iterations = 50;
 };
 // _nonlinear_options_end
 
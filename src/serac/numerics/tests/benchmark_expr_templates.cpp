@@ -203,12 +203,74 @@ static void BM_large_expr_single_alloc_hypre_par_EXPR(benchmark::State& state)
   MPI_Barrier(MPI_COMM_WORLD);
 }
 
+static void BM_finite_difference_MFEM(benchmark::State& state)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  // Number of rows is the argument that varies
+  const int rows         = static_cast<int>(state.range(0));
+  auto [U_minus, U_plus] = sample_vectors(rows);
+
+  constexpr double epsilon = 1.0e-6;
+  mfem::Vector     mfem_result(rows);
+
+  for (auto _ : state) {
+    // This code gets timed
+    add(1.0 / (2.0 * epsilon), U_plus, -1.0 / (2.0 * epsilon), U_minus, mfem_result);
+  }
+
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
+static void BM_finite_difference_EXPR(benchmark::State& state)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  // Number of rows is the argument that varies
+  const int rows         = static_cast<int>(state.range(0));
+  auto [U_minus, U_plus] = sample_vectors(rows);
+
+  constexpr double epsilon = 1.0e-6;
+  mfem::Vector     expr_result(rows);
+
+  for (auto _ : state) {
+    // This code gets timed
+    expr_result = (U_plus - U_minus) / (2.0 * epsilon);
+  }
+
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
+static void BM_finite_difference_evaluate_into_EXPR(benchmark::State& state)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  // Number of rows is the argument that varies
+  const int rows         = static_cast<int>(state.range(0));
+  auto [U_minus, U_plus] = sample_vectors(rows);
+
+  constexpr double epsilon = 1.0e-6;
+  mfem::Vector     expr_result(rows);
+
+  for (auto _ : state) {
+    // This code gets timed
+    ((U_plus - U_minus) / (2.0 * epsilon)).evaluate_into(expr_result);
+  }
+
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
 BENCHMARK(BM_mixed_expr_MFEM)->RangeMultiplier(2)->Range(10, 10 << 10);
 BENCHMARK(BM_mixed_expr_EXPR)->RangeMultiplier(2)->Range(10, 10 << 10);
 BENCHMARK(BM_mixed_expr_single_alloc_EXPR)->RangeMultiplier(2)->Range(10, 10 << 10);
 BENCHMARK(BM_large_expr_MFEM)->RangeMultiplier(2)->Range(10, 10 << 10);
 BENCHMARK(BM_large_expr_single_alloc_EXPR)->RangeMultiplier(2)->Range(10, 10 << 10);
 
+// the largest sizes are evaluated in parallel when OpenMP is enabled
+BENCHMARK(BM_finite_difference_MFEM)->RangeMultiplier(4)->Range(10, 10 << 16);
+BENCHMARK(BM_finite_difference_EXPR)->RangeMultiplier(4)->Range(10, 10 << 16);
+BENCHMARK(BM_finite_difference_evaluate_into_EXPR)->RangeMultiplier(4)->Range(10, 10 << 16);
+
 // Too slow
 BENCHMARK(BM_large_expr_single_alloc_hypre_par_EXPR)->RangeMultiplier(2)->Range(10, 10 << 10);
 
@@ -0,0 +1,101 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include <map>
+
+#include "axom/slic/core/SimpleLogger.hpp"
+#include <gtest/gtest.h>
+#include "mpi.h"
+
+#include "serac/numerics/checkpoint_schedule.hpp"
+
+using namespace serac;
+
+using Action = CheckpointOperation::Action;
+
+TEST(CheckpointSchedule, Capacity)
+{
+  EXPECT_EQ(binomialCheckpointCapacity(1, 4), 5);
+  EXPECT_EQ(binomialCheckpointCapacity(3, 0), 1);
+  EXPECT_EQ(binomialCheckpointCapacity(3, 2), 10);
+  EXPECT_EQ(binomialCheckpointCapacity(5, 5), 252);
+}
+
+TEST(CheckpointSchedule, NoRecomputationWithACheckpointPerStep)
+{
+  auto schedule = binomialCheckpointSchedule(2, 2);
+
+  std::vector<CheckpointOperation> expected = {{Action::Store, 0, 0},   {Action::Advance, 0},
+                                               {Action::Store, 1, 1},   {Action::Advance, 1},
+                                               {Action::Adjoint, 1},    {Action::Restore, 0, 0},
+                                               {Action::Advance, 0},    {Action::Adjoint, 0}};
+  EXPECT_EQ(schedule, expected);
+}
+
+// replay each schedule, checking that every operation is valid, that the adjoint steps come in reverse order and
+// that no step is advanced more often than the binomial bound
+TEST(CheckpointSchedule, ReversesEveryStepWithinTheBinomialBound)
+{
+  for (int num_checkpoints = 1; num_checkpoints <= 5; num_checkpoints++) {
+    for (int num_steps = 1; num_steps <= 40; num_steps++) {
+      std::map<int, int> checkpoints;
+      std::map<int, int> advances;
+      int                position     = 0;
+      int                next_adjoint = num_steps - 1;
+
+      for (auto op : binomialCheckpointSchedule(num_steps, num_checkpoints)) {
+        switch (op.action) {
+          case Action::Store:
+            ASSERT_EQ(op.step, position);
+            ASSERT_LT(op.slot, num_checkpoints);
+            checkpoints[op.slot] = op.step;
+            break;
+          case Action::Restore:
+            ASSERT_EQ(checkpoints.count(op.slot), 1);
+            ASSERT_EQ(checkpoints[op.slot], op.step);
+            position = op.step;
+            break;
+          case Action::Advance:
+            ASSERT_EQ(op.step, position);
+            advances[position]++;
+            position++;
+            break;
+          case Action::Adjoint:
+            ASSERT_EQ(op.step, next_adjoint);
+            ASSERT_EQ(position, op.step + 1);
+            next_adjoint--;
+            break;
+        }
+      }
+      EXPECT_EQ(next_adjoint, -1);
+
+      int repetitions = 0;
+      while (binomialCheckpointCapacity(num_checkpoints, repetitions) < num_steps) {
+        repetitions++;
+      }
+      for (auto [step, count] : advances) {
+        EXPECT_LE(count, repetitions + 1);
+      }
+    }
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  int result = 0;
+
+  ::testing::InitGoogleTest(&argc, argv);
+
+  MPI_Init(&argc, &argv);
+
+  axom::slic::SimpleLogger logger;
+
+  result = RUN_ALL_TESTS();
+
+  MPI_Finalize();
+
+  return result;
+}
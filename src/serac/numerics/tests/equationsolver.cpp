@@ -116,16 +116,1111 @@ INSTANTIATE_TEST_SUITE_P(
                      testing::Values(LinearSolver::CG, LinearSolver::GMRES, LinearSolver::SuperLU),
                      testing::Values(Preconditioner::HypreJacobi, Preconditioner::HypreL1Jacobi,
                                      Preconditioner::HypreGaussSeidel, Preconditioner::HypreAMG,
-                                     Preconditioner::HypreILU)));
+                                     Preconditioner::HypreILU, Preconditioner::Jacobi,
+                                     Preconditioner::Chebyshev)));
 #else
 INSTANTIATE_TEST_SUITE_P(AllEquationSolverTests, EquationSolverSuite,
                          testing::Combine(testing::Values(NonlinearSolver::Newton, NonlinearSolver::LBFGS),
                                           testing::Values(LinearSolver::CG, LinearSolver::GMRES, LinearSolver::SuperLU),
                                           testing::Values(Preconditioner::HypreJacobi, Preconditioner::HypreL1Jacobi,
                                                           Preconditioner::HypreGaussSeidel, Preconditioner::HypreAMG,
-                                                          Preconditioner::HypreILU)));
+                                                          Preconditioner::HypreILU, Preconditioner::Jacobi,
+                                     Preconditioner::Chebyshev)));
 #endif
 
+TEST(EquationSolver, JacobianReuse)
+{
+  auto mesh  = mfem::Mesh::MakeCartesian2D(4, 4, mfem::Element::QUADRILATERAL);
+  auto pmesh = mfem::ParMesh(MPI_COMM_WORLD, mesh);
+
+  pmesh.EnsureNodes();
+  pmesh.ExchangeFaceNbrData();
+
+  constexpr int p   = 1;
+  constexpr int dim = 2;
+
+  auto                        fec = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace fes(&pmesh, &fec);
+
+  mfem::HypreParVector x_exact(&fes);
+  x_exact.Randomize(0);
+
+  Functional<H1<p>(H1<p>)> residual(&fes, {&fes});
+
+  // a mildly nonlinear reaction-diffusion problem, where a stale Jacobian is still a good approximation
+  residual.AddDomainIntegral(
+      Dimension<dim>{}, DependsOn<0>{},
+      [&](auto, auto scalar) {
+        auto [u, du_dx] = scalar;
+        auto source     = u + 0.1 * sin(u);
+        auto flux       = du_dx;
+        return serac::tuple{source, flux};
+      },
+      pmesh);
+
+  std::unique_ptr<mfem::HypreParMatrix> J;
+  int                                   assemblies = 0;
+
+  StdFunctionOperator residual_opr(
+      fes.TrueVSize(),
+      [&x_exact, &residual](const mfem::Vector& x, mfem::Vector& r) {
+        const mfem::Vector res = residual(x);
+
+        r = res;
+        r -= residual(x_exact);
+      },
+      [&residual, &J, &assemblies](const mfem::Vector& x) -> mfem::Operator& {
+        auto [val, grad] = residual(differentiate_wrt(x));
+        J                = assemble(grad);
+        assemblies++;
+        return *J;
+      });
+
+  const LinearSolverOptions lin_opts = {.linear_solver  = LinearSolver::GMRES,
+                                        .preconditioner = Preconditioner::HypreJacobi,
+                                        .relative_tol   = 1.0e-12,
+                                        .absolute_tol   = 1.0e-14,
+                                        .max_iterations = 500,
+                                        .print_level    = 0};
+
+  auto solve = [&](JacobianReuse reuse, int num_solves) {
+    const NonlinearSolverOptions nonlin_opts = {.nonlin_solver  = NonlinearSolver::Newton,
+                                                .relative_tol   = 1.0e-10,
+                                                .absolute_tol   = 1.0e-12,
+                                                .max_iterations = 100,
+                                                .print_level    = 1,
+                                                .jacobian_reuse = reuse};
+
+    EquationSolver eq_solver(nonlin_opts, lin_opts);
+    eq_solver.setOperator(residual_opr);
+
+    assemblies = 0;
+    for (int i = 0; i < num_solves; i++) {
+      mfem::HypreParVector x_computed(&fes);
+      x_computed = 0.0;
+
+      eq_solver.solve(x_computed);
+
+      EXPECT_TRUE(eq_solver.nonlinearSolver().GetConverged());
+      for (int j = 0; j < x_computed.Size(); ++j) {
+        EXPECT_NEAR(x_computed(j), x_exact(j), 1.0e-8);
+      }
+    }
+    return assemblies;
+  };
+
+  int full_newton   = solve(JacobianReuse::Never, 2);
+  int within_solve  = solve(JacobianReuse::WithinSolve, 2);
+  int across_solves = solve(JacobianReuse::AcrossSolves, 2);
+
+  EXPECT_LT(within_solve, full_newton);
+  EXPECT_LE(across_solves, within_solve);
+
+  // every solve starts by rebuilding the Jacobian, unless it is kept across solves
+  EXPECT_GE(within_solve, 2);
+}
+
+TEST(EquationSolver, AndersonAndJacobianFreeNewtonKrylov)
+{
+  auto mesh  = mfem::Mesh::MakeCartesian2D(4, 4, mfem::Element::QUADRILATERAL);
+  auto pmesh = mfem::ParMesh(MPI_COMM_WORLD, mesh);
+
+  pmesh.EnsureNodes();
+  pmesh.ExchangeFaceNbrData();
+
+  constexpr int p   = 1;
+  constexpr int dim = 2;
+
+  auto                        fec = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace fes(&pmesh, &fec);
+
+  mfem::HypreParVector x_exact(&fes);
+  x_exact.Randomize(0);
+
+  Functional<H1<p>(H1<p>)> residual(&fes, {&fes});
+
+  // nonlinear enough that the Jacobian of the initial guess alone converges slowly
+  residual.AddDomainIntegral(
+      Dimension<dim>{}, DependsOn<0>{},
+      [&](auto, auto scalar) {
+        auto [u, du_dx] = scalar;
+        auto source     = u + 0.5 * u * u * u;
+        auto flux       = du_dx;
+        return serac::tuple{source, flux};
+      },
+      pmesh);
+
+  std::unique_ptr<mfem::HypreParMatrix> J;
+  int                                   assemblies = 0;
+
+  StdFunctionOperator residual_opr(
+      fes.TrueVSize(),
+      [&x_exact, &residual](const mfem::Vector& x, mfem::Vector& r) {
+        const mfem::Vector res = residual(x);
+
+        r = res;
+        r -= residual(x_exact);
+      },
+      [&residual, &J, &assemblies](const mfem::Vector& x) -> mfem::Operator& {
+        auto [val, grad] = residual(differentiate_wrt(x));
+        J                = assemble(grad);
+        assemblies++;
+        return *J;
+      });
+
+  const LinearSolverOptions lin_opts = {.linear_solver  = LinearSolver::GMRES,
+                                        .preconditioner = Preconditioner::HypreJacobi,
+                                        .relative_tol   = 1.0e-12,
+                                        .absolute_tol   = 1.0e-14,
+                                        .max_iterations = 500,
+                                        .print_level    = 0};
+
+  auto solve = [&](NonlinearSolver method, double stagnation_ratio) {
+    const NonlinearSolverOptions nonlin_opts = {.nonlin_solver             = method,
+                                                .relative_tol              = 1.0e-10,
+                                                .absolute_tol              = 1.0e-12,
+                                                .max_iterations            = 100,
+                                                .print_level               = 1,
+                                                .jacobian_stagnation_ratio = stagnation_ratio,
+                                                .jfnk_relative_tol         = 1.0e-8};
+
+    EquationSolver eq_solver(nonlin_opts, lin_opts);
+    eq_solver.setOperator(residual_opr);
+
+    mfem::HypreParVector x_computed(&fes);
+    x_computed = 0.0;
+
+    assemblies = 0;
+    eq_solver.solve(x_computed);
+
+    EXPECT_TRUE(eq_solver.nonlinearSolver().GetConverged());
+    for (int j = 0; j < x_computed.Size(); ++j) {
+      EXPECT_NEAR(x_computed(j), x_exact(j), 1.0e-8);
+    }
+    return assemblies;
+  };
+
+  int newton = solve(NonlinearSolver::Newton, 0.5);
+
+  // with the Jacobian of the initial guess only, which is never rebuilt
+  int anderson = solve(NonlinearSolver::Anderson, 1.0e10);
+  int jfnk     = solve(NonlinearSolver::JFNK, 1.0e10);
+
+  EXPECT_EQ(anderson, 1);
+  EXPECT_EQ(jfnk, 1);
+  EXPECT_GT(newton, 1);
+}
+
+class GlobalizationSuite : public testing::TestWithParam<NonlinearGlobalization> {
+};
+
+TEST_P(GlobalizationSuite, ConvergesFromFarAway)
+{
+  auto mesh  = mfem::Mesh::MakeCartesian2D(4, 4, mfem::Element::QUADRILATERAL);
+  auto pmesh = mfem::ParMesh(MPI_COMM_WORLD, mesh);
+
+  pmesh.EnsureNodes();
+  pmesh.ExchangeFaceNbrData();
+
+  constexpr int p   = 1;
+  constexpr int dim = 2;
+
+  auto                        fec = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace fes(&pmesh, &fec);
+
+  mfem::HypreParVector x_exact(&fes);
+  x_exact.Randomize(0);
+
+  Functional<H1<p>(H1<p>)> residual(&fes, {&fes});
+
+  // like the scalar atan(u) = 0, full Newton updates overshoot further and further from a distant initial guess
+  residual.AddDomainIntegral(
+      Dimension<dim>{}, DependsOn<0>{},
+      [&](auto, auto scalar) {
+        auto [u, du_dx] = scalar;
+        auto source     = atan(u);
+        auto flux       = 0.01 * du_dx;
+        return serac::tuple{source, flux};
+      },
+      pmesh);
+
+  std::unique_ptr<mfem::HypreParMatrix> J;
+
+  StdFunctionOperator residual_opr(
+      fes.TrueVSize(),
+      [&x_exact, &residual](const mfem::Vector& x, mfem::Vector& r) {
+        const mfem::Vector res = residual(x);
+
+        r = res;
+        r -= residual(x_exact);
+      },
+      [&residual, &J](const mfem::Vector& x) -> mfem::Operator& {
+        auto [val, grad] = residual(differentiate_wrt(x));
+        J                = assemble(grad);
+        return *J;
+      });
+
+  const LinearSolverOptions lin_opts = {.linear_solver  = LinearSolver::GMRES,
+                                        .preconditioner = Preconditioner::HypreJacobi,
+                                        .relative_tol   = 1.0e-12,
+                                        .absolute_tol   = 1.0e-14,
+                                        .max_iterations = 500,
+                                        .print_level    = 0};
+
+  const NonlinearSolverOptions nonlin_opts = {.nonlin_solver  = NonlinearSolver::Newton,
+                                              .relative_tol   = 1.0e-10,
+                                              .absolute_tol   = 1.0e-12,
+                                              .max_iterations = 100,
+                                              .print_level    = 1,
+                                              .globalization  = GetParam()};
+
+  EquationSolver eq_solver(nonlin_opts, lin_opts);
+  eq_solver.setOperator(residual_opr);
+
+  mfem::HypreParVector x_computed(&fes);
+  x_computed = 5.0;
+  eq_solver.solve(x_computed);
+
+  EXPECT_TRUE(eq_solver.nonlinearSolver().GetConverged());
+  for (int j = 0; j < x_computed.Size(); ++j) {
+    EXPECT_NEAR(x_computed(j), x_exact(j), 1.0e-8);
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(EquationSolver, GlobalizationSuite,
+                         testing::Values(NonlinearGlobalization::Backtracking, NonlinearGlobalization::TrustRegion));
+
+TEST(EquationSolver, EisenstatWalkerForcingTerm)
+{
+  auto mesh  = mfem::Mesh::MakeCartesian2D(4, 4, mfem::Element::QUADRILATERAL);
+  auto pmesh = mfem::ParMesh(MPI_COMM_WORLD, mesh);
+
+  pmesh.EnsureNodes();
+  pmesh.ExchangeFaceNbrData();
+
+  constexpr int p   = 1;
+  constexpr int dim = 2;
+
+  auto                        fec = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace fes(&pmesh, &fec);
+
+  mfem::HypreParVector x_exact(&fes);
+  x_exact.Randomize(0);
+
+  Functional<H1<p>(H1<p>)> residual(&fes, {&fes});
+
+  residual.AddDomainIntegral(
+      Dimension<dim>{}, DependsOn<0>{},
+      [&](auto, auto scalar) {
+        auto [u, du_dx] = scalar;
+        auto source     = u + u * u * u;
+        auto flux       = du_dx;
+        return serac::tuple{source, flux};
+      },
+      pmesh);
+
+  std::unique_ptr<mfem::HypreParMatrix> J;
+
+  StdFunctionOperator residual_opr(
+      fes.TrueVSize(),
+      [&x_exact, &residual](const mfem::Vector& x, mfem::Vector& r) {
+        const mfem::Vector res = residual(x);
+
+        r = res;
+        r -= residual(x_exact);
+      },
+      [&residual, &J](const mfem::Vector& x) -> mfem::Operator& {
+        auto [val, grad] = residual(differentiate_wrt(x));
+        J                = assemble(grad);
+        return *J;
+      });
+
+  const LinearSolverOptions lin_opts = {.linear_solver  = LinearSolver::GMRES,
+                                        .preconditioner = Preconditioner::HypreJacobi,
+                                        .relative_tol   = 1.0e-12,
+                                        .absolute_tol   = 1.0e-14,
+                                        .max_iterations = 500,
+                                        .print_level    = 0};
+
+  for (auto forcing_term : {ForcingTerm::EisenstatWalker1, ForcingTerm::EisenstatWalker2}) {
+    const NonlinearSolverOptions nonlin_opts = {.nonlin_solver  = NonlinearSolver::Newton,
+                                                .relative_tol   = 1.0e-10,
+                                                .absolute_tol   = 1.0e-12,
+                                                .max_iterations = 100,
+                                                .print_level    = 1,
+                                                .forcing_term   = forcing_term};
+
+    EquationSolver eq_solver(nonlin_opts, lin_opts);
+    eq_solver.setOperator(residual_opr);
+
+    mfem::HypreParVector x_computed(&fes);
+    x_computed = 0.0;
+
+    eq_solver.solve(x_computed);
+
+    EXPECT_TRUE(eq_solver.nonlinearSolver().GetConverged());
+    for (int i = 0; i < x_computed.Size(); ++i) {
+      EXPECT_NEAR(x_computed(i), x_exact(i), 1.0e-8);
+    }
+  }
+}
+
+TEST(EquationSolver, ReusableBoomerAMG)
+{
+  auto mesh  = mfem::Mesh::MakeCartesian2D(8, 8, mfem::Element::QUADRILATERAL);
+  auto pmesh = mfem::ParMesh(MPI_COMM_WORLD, mesh);
+
+  constexpr int p   = 1;
+  constexpr int dim = 2;
+
+  auto                        fec = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace fes(&pmesh, &fec);
+
+  Functional<H1<p>(H1<p>)> residual(&fes, {&fes});
+
+  residual.AddDomainIntegral(
+      Dimension<dim>{}, DependsOn<0>{},
+      [&](auto, auto scalar) {
+        auto [u, du_dx] = scalar;
+        auto source     = u + u * u * u;
+        auto flux       = du_dx;
+        return serac::tuple{source, flux};
+      },
+      pmesh);
+
+  constexpr int rebuild_period = 3;
+  auto          amg = buildPreconditioner(Preconditioner::HypreAMG, 0, MPI_COMM_WORLD, rebuild_period);
+  auto*         reusable_amg = dynamic_cast<ReusableBoomerAMG*>(amg.get());
+  ASSERT_NE(reusable_amg, nullptr);
+
+  mfem::CGSolver cg(MPI_COMM_WORLD);
+  cg.SetRelTol(1.0e-10);
+  cg.SetAbsTol(0.0);
+  cg.SetMaxIter(500);
+  cg.SetPreconditioner(*amg);
+
+  mfem::HypreParVector u(&fes);
+  mfem::HypreParVector b(&fes);
+  mfem::HypreParVector x(&fes);
+  b.Randomize(1);
+
+  // each linearization point changes the values (but not the sparsity) of the matrix, like successive timesteps
+  constexpr int num_updates = 5;
+  for (int i = 0; i < num_updates; i++) {
+    u = 0.1 * i;
+
+    auto [r, drdu] = residual(differentiate_wrt(u));
+    auto J         = assemble(drdu);
+
+    cg.SetOperator(*J);
+    x = 0.0;
+    cg.Mult(b, x);
+
+    EXPECT_TRUE(cg.GetConverged());
+  }
+
+  EXPECT_EQ(reusable_amg->numSetups(), (num_updates + rebuild_period - 1) / rebuild_period);
+}
+
+TEST(EquationSolver, DeflatedCG)
+{
+  auto mesh  = mfem::Mesh::MakeCartesian2D(8, 8, mfem::Element::QUADRILATERAL);
+  auto pmesh = mfem::ParMesh(MPI_COMM_WORLD, mesh);
+
+  constexpr int p   = 2;
+  constexpr int dim = 2;
+
+  auto                        fec = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace fes(&pmesh, &fec);
+
+  Functional<H1<p>(H1<p>)> residual(&fes, {&fes});
+
+  residual.AddDomainIntegral(
+      Dimension<dim>{}, DependsOn<0>{},
+      [&](auto, auto scalar) {
+        auto [u, du_dx] = scalar;
+        auto source     = u + u * u * u;
+        auto flux       = du_dx;
+        return serac::tuple{source, flux};
+      },
+      pmesh);
+
+  const LinearSolverOptions cg_opts = {.linear_solver  = LinearSolver::CG,
+                                       .preconditioner = Preconditioner::HypreJacobi,
+                                       .relative_tol   = 1.0e-10,
+                                       .absolute_tol   = 0.0,
+                                       .max_iterations = 500,
+                                       .print_level    = 0};
+
+  LinearSolverOptions deflated_opts = cg_opts;
+  deflated_opts.linear_solver       = LinearSolver::DeflatedCG;
+
+  auto [cg, cg_prec]             = buildLinearSolverAndPreconditioner(cg_opts);
+  auto [deflated, deflated_prec] = buildLinearSolverAndPreconditioner(deflated_opts);
+
+  auto& cg_solver       = dynamic_cast<mfem::IterativeSolver&>(*cg);
+  auto& deflated_solver = dynamic_cast<DeflatedCGSolver&>(*deflated);
+
+  mfem::HypreParVector u(&fes);
+  mfem::HypreParVector b(&fes);
+  mfem::HypreParVector x_cg(&fes);
+  mfem::HypreParVector x_deflated(&fes);
+  b.Randomize(1);
+
+  // slowly changing operators, like those of consecutive timesteps
+  constexpr int num_solves = 6;
+  for (int i = 0; i < num_solves; i++) {
+    u = 0.02 * i;
+
+    auto [r, drdu] = residual(differentiate_wrt(u));
+    auto J         = assemble(drdu);
+
+    cg_solver.SetOperator(*J);
+    deflated_solver.SetOperator(*J);
+
+    x_cg       = 0.0;
+    x_deflated = 0.0;
+    cg_solver.Mult(b, x_cg);
+    deflated_solver.Mult(b, x_deflated);
+
+    EXPECT_TRUE(cg_solver.GetConverged());
+    EXPECT_TRUE(deflated_solver.GetConverged());
+
+    for (int j = 0; j < x_cg.Size(); ++j) {
+      EXPECT_NEAR(x_cg(j), x_deflated(j), 1.0e-6 * std::max(1.0, std::abs(x_cg(j))));
+    }
+
+    // once there is a recycled subspace, the deflated solves need fewer iterations
+    if (i > 0) {
+      EXPECT_LT(deflated_solver.GetNumIterations(), cg_solver.GetNumIterations());
+    }
+  }
+
+  EXPECT_EQ(deflated_solver.recycledDimension(), deflated_opts.recycled_subspace_dimension);
+}
+
+TEST(EquationSolver, PipelinedCG)
+{
+  auto mesh  = mfem::Mesh::MakeCartesian2D(8, 8, mfem::Element::QUADRILATERAL);
+  auto pmesh = mfem::ParMesh(MPI_COMM_WORLD, mesh);
+
+  constexpr int p   = 2;
+  constexpr int dim = 2;
+
+  auto                        fec = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace fes(&pmesh, &fec);
+
+  Functional<H1<p>(H1<p>)> residual(&fes, {&fes});
+
+  residual.AddDomainIntegral(
+      Dimension<dim>{}, DependsOn<0>{},
+      [&](auto, auto scalar) {
+        auto [u, du_dx] = scalar;
+        auto source     = u;
+        auto flux       = du_dx;
+        return serac::tuple{source, flux};
+      },
+      pmesh);
+
+  mfem::HypreParVector u(&fes);
+  u = 0.0;
+
+  auto [r, drdu] = residual(differentiate_wrt(u));
+  auto J         = assemble(drdu);
+
+  mfem::HypreParVector b(&fes);
+  b.Randomize(1);
+
+  std::vector<mfem::HypreParVector> solutions;
+  solutions.reserve(2);
+  for (auto lin_solver : {LinearSolver::CG, LinearSolver::PipelinedCG}) {
+    const LinearSolverOptions lin_opts = {.linear_solver  = lin_solver,
+                                          .preconditioner = Preconditioner::HypreJacobi,
+                                          .relative_tol   = 1.0e-12,
+                                          .absolute_tol   = 0.0,
+                                          .max_iterations = 500,
+                                          .print_level    = 0};
+
+    auto [solver, precond] = buildLinearSolverAndPreconditioner(lin_opts);
+    solver->SetOperator(*J);
+
+    auto& x = solutions.emplace_back(&fes);
+    x       = 0.0;
+    solver->Mult(b, x);
+
+    EXPECT_TRUE(dynamic_cast<mfem::IterativeSolver&>(*solver).GetConverged());
+  }
+
+  for (int i = 0; i < b.Size(); ++i) {
+    EXPECT_NEAR(solutions[0](i), solutions[1](i), 1.0e-8 * std::max(1.0, std::abs(solutions[0](i))));
+  }
+}
+
+TEST(EquationSolver, PMultigrid)
+{
+  auto mesh  = mfem::Mesh::MakeCartesian2D(6, 6, mfem::Element::QUADRILATERAL);
+  auto pmesh = mfem::ParMesh(MPI_COMM_WORLD, mesh);
+
+  constexpr int p   = 4;
+  constexpr int dim = 2;
+
+  auto                        fec = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace fes(&pmesh, &fec);
+
+  Functional<H1<p>(H1<p>)> residual(&fes, {&fes});
+
+  residual.AddDomainIntegral(
+      Dimension<dim>{}, DependsOn<0>{},
+      [&](auto, auto scalar) {
+        auto [u, du_dx] = scalar;
+        auto source     = u;
+        auto flux       = du_dx;
+        return serac::tuple{source, flux};
+      },
+      pmesh);
+
+  mfem::HypreParVector u(&fes);
+  u = 0.0;
+
+  auto [r, drdu] = residual(differentiate_wrt(u));
+  auto J         = assemble(drdu);
+
+  auto  precond = buildPreconditioner(Preconditioner::PMultigrid, 0, MPI_COMM_WORLD);
+  auto* pmg     = dynamic_cast<PMultigridPreconditioner*>(precond.get());
+  ASSERT_NE(pmg, nullptr);
+  pmg->setFiniteElementSpace(fes);
+
+  // orders 4, 2 and 1
+  EXPECT_EQ(pmg->numLevels(), 3);
+
+  mfem::CGSolver cg(MPI_COMM_WORLD);
+  cg.SetRelTol(1.0e-10);
+  cg.SetAbsTol(0.0);
+  cg.SetMaxIter(100);
+  cg.SetPreconditioner(*pmg);
+  cg.SetOperator(*J);
+
+  mfem::HypreParVector b(&fes);
+  mfem::HypreParVector x(&fes);
+  b.Randomize(1);
+  x = 0.0;
+  cg.Mult(b, x);
+
+  EXPECT_TRUE(cg.GetConverged());
+}
+
+TEST(EquationSolver, SinglePrecisionPMultigrid)
+{
+  auto mesh  = mfem::Mesh::MakeCartesian2D(6, 6, mfem::Element::QUADRILATERAL);
+  auto pmesh = mfem::ParMesh(MPI_COMM_WORLD, mesh);
+
+  constexpr int p   = 4;
+  constexpr int dim = 2;
+
+  auto                        fec = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace fes(&pmesh, &fec);
+
+  Functional<H1<p>(H1<p>)> residual(&fes, {&fes});
+
+  residual.AddDomainIntegral(
+      Dimension<dim>{}, DependsOn<0>{},
+      [&](auto, auto scalar) {
+        auto [u, du_dx] = scalar;
+        auto source     = u;
+        auto flux       = du_dx;
+        return serac::tuple{source, flux};
+      },
+      pmesh);
+
+  mfem::HypreParVector u(&fes);
+  u = 0.0;
+
+  auto [r, drdu] = residual(differentiate_wrt(u));
+  auto J         = assemble(drdu);
+
+  mfem::HypreParVector b(&fes);
+  mfem::HypreParVector x(&fes);
+  b.Randomize(1);
+
+  // the single precision copy of the matrix has the action of the original one, up to the rounding of its values
+  SinglePrecisionParMatrix J_single(*J);
+  mfem::Vector             y(J->Height()), y_single(J->Height());
+  J->Mult(b, y);
+  J_single.Mult(b, y_single);
+  y_single -= y;
+  EXPECT_LT(mfem::ParNormlp(y_single, 2, MPI_COMM_WORLD), 1.0e-6 * mfem::ParNormlp(y, 2, MPI_COMM_WORLD));
+
+  mfem::Vector diagonal, diagonal_single;
+  J->AssembleDiagonal(diagonal);
+  J_single.AssembleDiagonal(diagonal_single);
+  for (int i = 0; i < diagonal.Size(); i++) {
+    EXPECT_NEAR(diagonal(i), diagonal_single(i), 1.0e-6 * std::abs(diagonal(i)));
+  }
+
+  // the single precision levels barely affect the convergence of the (double precision) Krylov solver
+  int iterations[2];
+  for (bool single_precision : {false, true}) {
+    auto  precond = buildPreconditioner(Preconditioner::PMultigrid, 0, MPI_COMM_WORLD, 1, {}, single_precision);
+    auto* pmg     = dynamic_cast<PMultigridPreconditioner*>(precond.get());
+    ASSERT_NE(pmg, nullptr);
+    pmg->setFiniteElementSpace(fes);
+
+    mfem::CGSolver cg(MPI_COMM_WORLD);
+    cg.SetRelTol(1.0e-10);
+    cg.SetAbsTol(0.0);
+    cg.SetMaxIter(100);
+    cg.SetPreconditioner(*pmg);
+    cg.SetOperator(*J);
+
+    x = 0.0;
+    cg.Mult(b, x);
+
+    EXPECT_TRUE(cg.GetConverged());
+    iterations[single_precision] = cg.GetNumIterations();
+  }
+
+  EXPECT_LE(iterations[1], iterations[0] + 2);
+}
+
+TEST(EquationSolver, GeometricMultigrid)
+{
+  auto mesh = mfem::Mesh::MakeCartesian2D(4, 4, mfem::Element::QUADRILATERAL);
+
+  // the hierarchy of mesh::refineAndDistribute, refined twice in parallel
+  std::vector<std::unique_ptr<mfem::ParMesh>> coarse_meshes;
+  auto                                        pmesh = std::make_unique<mfem::ParMesh>(MPI_COMM_WORLD, mesh);
+  for (int level = 0; level < 2; level++) {
+    auto refined = std::make_unique<mfem::ParMesh>(*pmesh);
+    coarse_meshes.push_back(std::move(pmesh));
+    pmesh = std::move(refined);
+    pmesh->UniformRefinement();
+  }
+  pmesh->EnsureNodes();
+
+  constexpr int p   = 2;
+  constexpr int dim = 2;
+
+  auto                        fec = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace fes(pmesh.get(), &fec);
+
+  Functional<H1<p>(H1<p>)> residual(&fes, {&fes});
+
+  residual.AddDomainIntegral(
+      Dimension<dim>{}, DependsOn<0>{},
+      [&](auto, auto scalar) {
+        auto [u, du_dx] = scalar;
+        auto source     = u;
+        auto flux       = du_dx;
+        return serac::tuple{source, flux};
+      },
+      *pmesh);
+
+  mfem::HypreParVector u(&fes);
+  u = 0.0;
+
+  auto [r, drdu] = residual(differentiate_wrt(u));
+  auto J         = assemble(drdu);
+
+  auto  precond = buildPreconditioner(Preconditioner::GeometricMultigrid, 0, MPI_COMM_WORLD);
+  auto* gmg     = dynamic_cast<GeometricMultigridPreconditioner*>(precond.get());
+  ASSERT_NE(gmg, nullptr);
+  gmg->setFiniteElementSpace(fes, {coarse_meshes[0].get(), coarse_meshes[1].get()});
+
+  // the fine mesh and the two coarse meshes
+  EXPECT_EQ(gmg->numLevels(), 3);
+
+  mfem::CGSolver cg(MPI_COMM_WORLD);
+  cg.SetRelTol(1.0e-10);
+  cg.SetAbsTol(0.0);
+  cg.SetMaxIter(100);
+  cg.SetPreconditioner(*gmg);
+  cg.SetOperator(*J);
+
+  mfem::HypreParVector b(&fes);
+  mfem::HypreParVector x(&fes);
+  b.Randomize(1);
+  x = 0.0;
+  cg.Mult(b, x);
+
+  EXPECT_TRUE(cg.GetConverged());
+}
+
+TEST(EquationSolver, LowOrderRefined)
+{
+  auto mesh  = mfem::Mesh::MakeCartesian2D(6, 6, mfem::Element::QUADRILATERAL);
+  auto pmesh = mfem::ParMesh(MPI_COMM_WORLD, mesh);
+
+  constexpr int p   = 3;
+  constexpr int dim = 2;
+
+  auto                        fec = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace fes(&pmesh, &fec);
+
+  // a conductivity that varies by orders of magnitude, which the diagonal scaling of the LOR matrix accounts for
+  Functional<H1<p>(H1<p>)> residual(&fes, {&fes});
+  residual.AddDomainIntegral(
+      Dimension<dim>{}, DependsOn<0>{},
+      [&](auto x, auto scalar) {
+        auto [u, du_dx] = scalar;
+        double kappa    = (x[0] < 0.5) ? 1.0 : 100.0;
+        return serac::tuple{0.0 * u, kappa * du_dx};
+      },
+      pmesh);
+
+  mfem::Array<int> essential_dofs;
+  fes.GetBoundaryTrueDofs(essential_dofs);
+
+  mfem::HypreParVector u(&fes);
+  u = 0.0;
+
+  // the high order operator is never assembled
+  auto [r, drdu] = residual(differentiate_wrt(u));
+  mfem::ConstrainedOperator A(&drdu, essential_dofs);
+
+  auto  precond = buildPreconditioner(Preconditioner::LOR, 0, MPI_COMM_WORLD);
+  auto* lor     = dynamic_cast<LORPreconditioner*>(precond.get());
+  ASSERT_NE(lor, nullptr);
+  lor->setFiniteElementSpace(fes, essential_dofs);
+
+  mfem::CGSolver cg(MPI_COMM_WORLD);
+  cg.SetRelTol(1.0e-10);
+  cg.SetAbsTol(0.0);
+  cg.SetMaxIter(100);
+  cg.SetPreconditioner(*lor);
+  cg.SetOperator(A);
+
+  // the LOR matrix is a p = 1 matrix, with at most 9 entries per row on this mesh
+  EXPECT_LE(lor->lowOrderMatrix().NNZ(), 9 * lor->lowOrderMatrix().GetGlobalNumRows());
+
+  mfem::HypreParVector b(&fes);
+  mfem::HypreParVector x(&fes);
+  b.Randomize(1);
+  b.SetSubVector(essential_dofs, 0.0);
+  x = 0.0;
+  cg.Mult(b, x);
+
+  EXPECT_TRUE(cg.GetConverged());
+  EXPECT_LT(cg.GetNumIterations(), 50);
+}
+
+TEST(EquationSolver, TransposeSolve)
+{
+  auto mesh  = mfem::Mesh::MakeCartesian2D(8, 8, mfem::Element::QUADRILATERAL);
+  auto pmesh = mfem::ParMesh(MPI_COMM_WORLD, mesh);
+
+  constexpr int p   = 1;
+  constexpr int dim = 2;
+
+  auto                        fec = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace fes(&pmesh, &fec);
+
+  Functional<H1<p>(H1<p>)> residual(&fes, {&fes});
+
+  // the advection term makes the Jacobian nonsymmetric
+  residual.AddDomainIntegral(
+      Dimension<dim>{}, DependsOn<0>{},
+      [&](auto, auto scalar) {
+        auto [u, du_dx] = scalar;
+        auto source     = u + 2.0 * du_dx[0] + du_dx[1];
+        auto flux       = du_dx;
+        return serac::tuple{source, flux};
+      },
+      pmesh);
+
+  mfem::HypreParVector u(&fes);
+  u = 0.0;
+
+  auto [r, drdu] = residual(differentiate_wrt(u));
+  auto J         = assemble(drdu);
+
+  mfem::HypreParVector b(&fes);
+  b.Randomize(1);
+
+  const NonlinearSolverOptions nonlin_opts = {.nonlin_solver = NonlinearSolver::Newton, .print_level = 0};
+
+  for (auto [lin_solver, precond] : {std::pair{LinearSolver::SuperLU, Preconditioner::None},
+                                     std::pair{LinearSolver::GMRES, Preconditioner::HypreAMG},
+                                     std::pair{LinearSolver::GMRES, Preconditioner::HypreJacobi}}) {
+    const LinearSolverOptions lin_opts = {.linear_solver  = lin_solver,
+                                          .preconditioner = precond,
+                                          .relative_tol   = 1.0e-12,
+                                          .absolute_tol   = 1.0e-14,
+                                          .max_iterations = 500,
+                                          .print_level    = 0};
+
+    EquationSolver eq_solver(nonlin_opts, lin_opts);
+
+    mfem::HypreParVector x(&fes);
+    x = 0.0;
+    eq_solver.solveTranspose(*J, b, x);
+
+    mfem::HypreParVector JTx(&fes);
+    J->MultTranspose(x, JTx);
+    JTx -= b;
+
+    EXPECT_LT(mfem::ParNormlp(JTx, 2, MPI_COMM_WORLD), 1.0e-8 * mfem::ParNormlp(b, 2, MPI_COMM_WORLD));
+  }
+}
+
+TEST(EquationSolver, TransposeSolveAfterForwardSolve)
+{
+  auto mesh  = mfem::Mesh::MakeCartesian2D(8, 8, mfem::Element::QUADRILATERAL);
+  auto pmesh = mfem::ParMesh(MPI_COMM_WORLD, mesh);
+
+  constexpr int p   = 1;
+  constexpr int dim = 2;
+
+  auto                        fec = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace fes(&pmesh, &fec);
+
+  const NonlinearSolverOptions nonlin_opts = {.nonlin_solver = NonlinearSolver::Newton, .print_level = 0};
+
+  // without the advection term, the Jacobian is symmetric and the forward preconditioner applies to the adjoint
+  for (double advection : {0.0, 2.0}) {
+    Functional<H1<p>(H1<p>)> residual(&fes, {&fes});
+    residual.AddDomainIntegral(
+        Dimension<dim>{}, DependsOn<0>{},
+        [advection](auto, auto scalar) {
+          auto [u, du_dx] = scalar;
+          auto source     = u + advection * du_dx[0] - 1.0;
+          auto flux       = du_dx;
+          return serac::tuple{source, flux};
+        },
+        pmesh);
+
+    mfem::HypreParVector u(&fes);
+    u = 0.0;
+    auto [r, drdu] = residual(differentiate_wrt(u));
+    auto J         = assemble(drdu);
+
+    mfem_ext::StdFunctionOperator op(
+        fes.GetTrueVSize(), [&residual](const mfem::Vector& x, mfem::Vector& f) { residual.Mult(f, x); },
+        [&J](const mfem::Vector&) -> mfem::Operator& { return *J; });
+
+    for (auto policy : {AdjointPreconditioning::Rebuild, AdjointPreconditioning::ReuseForward,
+                        AdjointPreconditioning::CachedTranspose}) {
+      for (auto [lin_solver, precond] : {std::pair{LinearSolver::SuperLU, Preconditioner::None},
+                                         std::pair{LinearSolver::GMRES, Preconditioner::HypreAMG},
+                                         std::pair{LinearSolver::GMRES, Preconditioner::HypreJacobi}}) {
+        const LinearSolverOptions lin_opts = {.linear_solver           = lin_solver,
+                                              .preconditioner          = precond,
+                                              .relative_tol            = 1.0e-12,
+                                              .absolute_tol            = 1.0e-14,
+                                              .max_iterations          = 500,
+                                              .print_level             = 0,
+                                              .adjoint_preconditioning = policy};
+
+        EquationSolver eq_solver(nonlin_opts, lin_opts);
+        eq_solver.setOperator(op);
+        eq_solver.setLinear(true);
+
+        mfem::HypreParVector x(&fes);
+        x = 0.0;
+        eq_solver.solve(x);
+
+        // several adjoint solves after one forward solve, e.g. for several quantities of interest
+        for (int seed : {1, 2}) {
+          mfem::HypreParVector b(&fes);
+          b.Randomize(seed);
+
+          mfem::HypreParVector adjoint(&fes);
+          adjoint = 0.0;
+          eq_solver.solveTranspose(*J, b, adjoint);
+
+          mfem::HypreParVector JTx(&fes);
+          J->MultTranspose(adjoint, JTx);
+          JTx -= b;
+          EXPECT_LT(mfem::ParNormlp(JTx, 2, MPI_COMM_WORLD), 1.0e-8 * mfem::ParNormlp(b, 2, MPI_COMM_WORLD));
+        }
+
+        // and the forward solver is left as it was
+        eq_solver.solve(x);
+        mfem::HypreParVector f(&fes);
+        op.Mult(x, f);
+        EXPECT_LT(mfem::ParNormlp(f, 2, MPI_COMM_WORLD), 1.0e-8);
+      }
+    }
+  }
+}
+
+TEST(EquationSolver, LinearMode)
+{
+  auto mesh  = mfem::Mesh::MakeCartesian2D(4, 4, mfem::Element::QUADRILATERAL);
+  auto pmesh = mfem::ParMesh(MPI_COMM_WORLD, mesh);
+
+  pmesh.EnsureNodes();
+  pmesh.ExchangeFaceNbrData();
+
+  constexpr int p   = 1;
+  constexpr int dim = 2;
+
+  auto                        fec = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace fes(&pmesh, &fec);
+
+  mfem::HypreParVector x_exact(&fes);
+  x_exact.Randomize(0);
+
+  Functional<H1<p>(H1<p>)> residual(&fes, {&fes});
+
+  // a linear reaction-diffusion problem, so that the Jacobian is constant
+  residual.AddDomainIntegral(
+      Dimension<dim>{}, DependsOn<0>{},
+      [&](auto, auto scalar) {
+        auto [u, du_dx] = scalar;
+        return serac::tuple{u, du_dx};
+      },
+      pmesh);
+
+  std::unique_ptr<mfem::HypreParMatrix> J;
+  int                                   assemblies  = 0;
+  int                                   evaluations = 0;
+
+  StdFunctionOperator residual_opr(
+      fes.TrueVSize(),
+      [&x_exact, &residual, &evaluations](const mfem::Vector& x, mfem::Vector& r) {
+        const mfem::Vector res = residual(x);
+
+        r = res;
+        r -= residual(x_exact);
+        evaluations++;
+      },
+      [&residual, &J, &assemblies](const mfem::Vector& x) -> mfem::Operator& {
+        auto [val, grad] = residual(differentiate_wrt(x));
+        J                = assemble(grad);
+        assemblies++;
+        return *J;
+      });
+
+  const LinearSolverOptions lin_opts = {.linear_solver  = LinearSolver::CG,
+                                        .preconditioner = Preconditioner::HypreJacobi,
+                                        .relative_tol   = 1.0e-12,
+                                        .absolute_tol   = 1.0e-14,
+                                        .max_iterations = 500,
+                                        .print_level    = 0};
+
+  EquationSolver eq_solver({}, lin_opts);
+  eq_solver.setOperator(residual_opr);
+  eq_solver.setLinear(true);
+
+  constexpr int num_solves = 3;
+  for (int i = 0; i < num_solves; i++) {
+    mfem::HypreParVector x_computed(&fes);
+    x_computed = 0.0;
+
+    eq_solver.solve(x_computed);
+
+    EXPECT_TRUE(eq_solver.converged());
+    for (int j = 0; j < x_computed.Size(); ++j) {
+      EXPECT_NEAR(x_computed(j), x_exact(j), 1.0e-8);
+    }
+  }
+
+  // one residual evaluation per solve, and the Jacobian is only assembled once
+  EXPECT_EQ(evaluations, num_solves);
+  EXPECT_EQ(assemblies, 1);
+
+  // discarding the Jacobian makes the next solve rebuild it
+  eq_solver.resetJacobian();
+  mfem::HypreParVector x_computed(&fes);
+  x_computed = 0.0;
+  eq_solver.solve(x_computed);
+  EXPECT_EQ(assemblies, 2);
+}
+
+TEST(EquationSolver, Telemetry)
+{
+  auto mesh  = mfem::Mesh::MakeCartesian2D(4, 4, mfem::Element::QUADRILATERAL);
+  auto pmesh = mfem::ParMesh(MPI_COMM_WORLD, mesh);
+
+  pmesh.EnsureNodes();
+  pmesh.ExchangeFaceNbrData();
+
+  constexpr int p   = 1;
+  constexpr int dim = 2;
+
+  auto                        fec = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace fes(&pmesh, &fec);
+
+  mfem::HypreParVector x_exact(&fes);
+  x_exact.Randomize(0);
+
+  Functional<H1<p>(H1<p>)> residual(&fes, {&fes});
+
+  residual.AddDomainIntegral(
+      Dimension<dim>{}, DependsOn<0>{},
+      [&](auto, auto scalar) {
+        auto [u, du_dx] = scalar;
+        auto source     = u + 0.1 * sin(u);
+        auto flux       = du_dx;
+        return serac::tuple{source, flux};
+      },
+      pmesh);
+
+  std::unique_ptr<mfem::HypreParMatrix> J;
+  int                                   assemblies = 0;
+
+  StdFunctionOperator residual_opr(
+      fes.TrueVSize(),
+      [&x_exact, &residual](const mfem::Vector& x, mfem::Vector& r) {
+        const mfem::Vector res = residual(x);
+
+        r = res;
+        r -= residual(x_exact);
+      },
+      [&residual, &J, &assemblies](const mfem::Vector& x) -> mfem::Operator& {
+        auto [val, grad] = residual(differentiate_wrt(x));
+        J                = assemble(grad);
+        assemblies++;
+        return *J;
+      });
+
+  const LinearSolverOptions lin_opts = {.linear_solver  = LinearSolver::CG,
+                                        .preconditioner = Preconditioner::HypreJacobi,
+                                        .relative_tol   = 1.0e-12,
+                                        .absolute_tol   = 1.0e-14,
+                                        .max_iterations = 500,
+                                        .print_level    = 0};
+
+  const NonlinearSolverOptions nonlin_opts = {.nonlin_solver  = NonlinearSolver::Newton,
+                                              .relative_tol   = 1.0e-10,
+                                              .absolute_tol   = 1.0e-12,
+                                              .max_iterations = 100,
+                                              .print_level    = 1};
+
+  EquationSolver eq_solver(nonlin_opts, lin_opts);
+  eq_solver.setOperator(residual_opr);
+
+  mfem::HypreParVector x_computed(&fes);
+  x_computed = 0.0;
+  eq_solver.solve(x_computed);
+
+  EXPECT_TRUE(eq_solver.nonlinearSolver().GetConverged());
+
+  const SolveTelemetry& telemetry = eq_solver.telemetry();
+  EXPECT_EQ(telemetry.solves, 1);
+  EXPECT_EQ(telemetry.nonlinear_iterations, eq_solver.nonlinearSolver().GetNumIterations());
+  EXPECT_EQ(telemetry.nonlinear_iterations, assemblies);
+
+  // one linear solve per Newton update
+  EXPECT_EQ(static_cast<int>(telemetry.linear_iterations.size()), telemetry.nonlinear_iterations);
+  for (int iterations : telemetry.linear_iterations) {
+    EXPECT_GT(iterations, 0);
+  }
+  EXPECT_GE(telemetry.totalLinearIterations(), telemetry.nonlinear_iterations);
+
+  EXPECT_GT(telemetry.initial_residual_norm, 0.0);
+  EXPECT_LE(telemetry.final_residual_norm, 1.0e-10 * telemetry.initial_residual_norm + 1.0e-12);
+
+  EXPECT_GT(telemetry.residual_time, 0.0);
+  EXPECT_GT(telemetry.assembly_time, 0.0);
+  EXPECT_GE(telemetry.preconditioner_setup_time, 0.0);
+  EXPECT_GE(telemetry.linear_solve_time, 0.0);
+
+  eq_solver.resetTelemetry();
+  EXPECT_EQ(eq_solver.telemetry().solves, 0);
+  EXPECT_TRUE(eq_solver.telemetry().linear_iterations.empty());
+}
+
 int main(int argc, char* argv[])
 {
   int result = 0;
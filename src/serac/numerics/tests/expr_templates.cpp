@@ -398,6 +398,56 @@ TEST(ExprTemplates, LargeMixedExpr)
   MPI_Barrier(MPI_COMM_WORLD);
 }
 
+TEST(ExprTemplates, LargeExprEvaluateInto)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+  // large enough to be evaluated in parallel, when OpenMP is enabled
+  constexpr int rows = 100000;
+  auto [lhs, rhs]    = sample_vectors(rows);
+
+  constexpr double epsilon = 0.25;
+
+  mfem::Vector mfem_result(rows);
+  add(1.0 / (2.0 * epsilon), rhs, -1.0 / (2.0 * epsilon), lhs, mfem_result);
+
+  mfem::Vector expr_result(rows);
+  ((rhs - lhs) / (2.0 * epsilon)).evaluate_into(expr_result);
+
+  EXPECT_EQ(mfem_result.Size(), expr_result.Size());
+  for (int i = 0; i < rows; i++) {
+    EXPECT_DOUBLE_EQ(mfem_result[i], expr_result[i]);
+  }
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
+TEST(ExprTemplates, FusedReductions)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+  constexpr int rows = 100000;
+  auto [lhs, rhs]    = sample_vectors(rows);
+
+  mfem::Vector difference(rows);
+  subtract(rhs, lhs, difference);
+
+  mfem::Vector sum(rows);
+  add(rhs, lhs, sum);
+
+  // the fused reductions should agree with those of the evaluated vectors
+  EXPECT_NEAR(serac::dot(MPI_COMM_WORLD, rhs - lhs, rhs + lhs), mfem::InnerProduct(MPI_COMM_WORLD, difference, sum),
+              1.0e-12 * std::abs(mfem::InnerProduct(MPI_COMM_WORLD, difference, sum)));
+  EXPECT_NEAR(serac::dot(MPI_COMM_WORLD, lhs, 2.0 * rhs), 2.0 * mfem::InnerProduct(MPI_COMM_WORLD, lhs, rhs),
+              1.0e-12 * std::abs(mfem::InnerProduct(MPI_COMM_WORLD, lhs, rhs)));
+
+  const double expected_norm2 = std::sqrt(mfem::InnerProduct(MPI_COMM_WORLD, difference, difference));
+  EXPECT_NEAR(serac::norm2(MPI_COMM_WORLD, rhs - lhs), expected_norm2, 1.0e-12 * expected_norm2);
+
+  double local_l1 = difference.Norml1();
+  double expected_l1;
+  MPI_Allreduce(&local_l1, &expected_l1, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+  EXPECT_NEAR(serac::l1(MPI_COMM_WORLD, lhs - rhs), expected_l1, 1.0e-12 * expected_l1);
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
 TEST(ExprTemplates, ComplexExprLambda)
 {
   MPI_Barrier(MPI_COMM_WORLD);
@@ -0,0 +1,70 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "axom/slic/core/SimpleLogger.hpp"
+#include <gtest/gtest.h>
+#include "mfem.hpp"
+
+#include "serac/numerics/fixed_point_acceleration.hpp"
+
+using namespace serac;
+
+// the iterations of x = G(x) = diag(lambda) x + b, a linear contraction with a spectral radius close to 1
+int iterationsToConverge(const FixedPointAccelerationOptions& options)
+{
+  constexpr double lambda[4] = {0.9, -0.8, 0.5, 0.95};
+
+  FixedPointAccelerator accelerator(MPI_COMM_WORLD, options);
+
+  mfem::Vector x(4);
+  mfem::Vector g(4);
+  x = 0.0;
+  for (int iteration = 0; iteration < 2000; iteration++) {
+    double residual = 0.0;
+    for (int i = 0; i < 4; i++) {
+      g(i) = lambda[i] * x(i) + 1.0 + i;
+      residual += (g(i) - x(i)) * (g(i) - x(i));
+    }
+    if (std::sqrt(residual) < 1.0e-10) {
+      return iteration;
+    }
+    accelerator.update(x, g);
+  }
+  return -1;
+}
+
+TEST(FixedPointAcceleration, AcceleratedIterationsConvergeFaster)
+{
+  int relaxed  = iterationsToConverge({.method = FixedPointAcceleration::Relaxation, .relaxation = 0.5});
+  int aitken   = iterationsToConverge({.method = FixedPointAcceleration::Aitken, .relaxation = 0.5});
+  int anderson = iterationsToConverge({.method = FixedPointAcceleration::Anderson, .relaxation = 0.5, .depth = 5});
+
+  ASSERT_GT(relaxed, 0);
+  EXPECT_GT(aitken, 0);
+  EXPECT_LT(aitken, relaxed / 10);
+
+  // with a deep enough history, Anderson acceleration is GMRES on (I - diag(lambda)) x = b, which converges in
+  // (about) as many iterations as there are distinct eigenvalues
+  EXPECT_GT(anderson, 0);
+  EXPECT_LE(anderson, 6);
+}
+
+int main(int argc, char* argv[])
+{
+  int result = 0;
+
+  ::testing::InitGoogleTest(&argc, argv);
+
+  MPI_Init(&argc, &argv);
+
+  axom::slic::SimpleLogger logger;
+
+  result = RUN_ALL_TESTS();
+
+  MPI_Finalize();
+
+  return result;
+}
@@ -5,8 +5,10 @@
 // SPDX-License-Identifier: (BSD-3-Clause)
 
 #include <array>
+#include <cmath>
 #include <fstream>
 #include <functional>
+#include <utility>
 
 #include <gtest/gtest.h>
 #include "mfem.hpp"
@@ -161,6 +163,8 @@ std::string to_string(serac::TimestepMethod m)
   if (m == serac::TimestepMethod::ImplicitMidpoint) return "ImplicitMidpoint";
   if (m == serac::TimestepMethod::SDIRK23) return "SDIRK23";
   if (m == serac::TimestepMethod::SDIRK34) return "SDIRK34";
+  if (m == serac::TimestepMethod::IMEXEuler) return "IMEXEuler";
+  if (m == serac::TimestepMethod::IMEXARS222) return "IMEXARS222";
 
   // for second order odes
   if (m == serac::TimestepMethod::Newmark) return "Newmark";
@@ -617,6 +621,210 @@ INSTANTIATE_TEST_SUITE_P(
     );
 // clang-format on
 
+// integrates M dx_dt + K x = f_ext to t_final, where x approaches a linear growth in time
+// so that the timestep can grow once the initial transient has decayed
+mfem::Vector integrate_linear_first_order_ode(TimestepMethod timestepper, bool adaptive, double dt, double t_final,
+                                              int& steps, double& max_dt)
+{
+  double t                      = 0.0;
+  double ode_residual_eval_time = 0.0;
+  double previous_dt            = -1.0;
+  double c0;
+
+  mfem::Vector x(3);
+  mfem::Vector previous(3);
+  previous = 0.0;
+
+  mfem::DenseMatrix J(3, 3);
+
+  auto                      mesh1D = mfem::Mesh::MakeCartesian1D(2);
+  mfem::ParMesh             mesh(MPI_COMM_WORLD, mesh1D);
+  BoundaryConditionManager  bcs(mesh);
+  serac::FiniteElementState dummy(mesh, FiniteElementState::Options{.order = 1, .name = "dummy"});
+
+  StdFunctionOperator residual(
+      3,
+      [&](const mfem::Vector& dx_dt, mfem::Vector& r) {
+        r = M * dx_dt + internal_force_linear(x + c0 * dx_dt) - f_ext;
+      },
+      [&](const mfem::Vector& dx_dt) -> mfem::Operator& {
+        J = M;
+        J.Add(c0, stiffness_linear(x + c0 * dx_dt));
+        return J;
+      });
+
+  EquationSolver solver(nonlinear_options, linear_options);
+  solver.setOperator(residual);
+
+  FirstOrderODE ode(dummy.space().TrueVSize(),
+                    {.time = ode_residual_eval_time, .u = x, .dt = c0, .du_dt = previous, .previous_dt = previous_dt},
+                    solver, bcs);
+
+  ode.SetTimestepper(timestepper);
+  if (adaptive) {
+    ode.SetAdaptiveTimestepping(
+        TimesteppingOptions{.timestepper = timestepper, .adaptive = true, .error_relative_tol = 1.0e-5});
+  }
+
+  mfem::Vector soln(3);
+  soln[0] = 1.0;
+  soln[1] = 2.0;
+  soln[2] = 3.0;
+
+  steps  = 0;
+  max_dt = 0.0;
+  while (t < t_final - 1.0e-12) {
+    // ask for the whole remaining interval, the controller caps it to what the error allows
+    double step_dt = adaptive ? t_final - t : std::min(dt, t_final - t);
+    if (adaptive && steps == 0) {
+      step_dt = dt;
+    }
+    ode.Step(soln, t, step_dt);
+    max_dt = std::max(max_dt, step_dt);
+    steps++;
+  }
+
+  return soln;
+}
+
+TEST(FirstOrderODE, AdaptiveTimestepGrowsNearSteadyState)
+{
+  constexpr double t_final = 10.0;
+
+  int    reference_steps;
+  double reference_max_dt;
+  auto   reference = integrate_linear_first_order_ode(TimestepMethod::SDIRK34, false, 1.0e-3, t_final, reference_steps,
+                                                      reference_max_dt);
+
+  int    adaptive_steps;
+  double adaptive_max_dt;
+  auto   adaptive = integrate_linear_first_order_ode(TimestepMethod::BackwardEuler, true, 1.0e-3, t_final,
+                                                     adaptive_steps, adaptive_max_dt);
+
+  mfem::Vector error = (reference - adaptive) / reference.Norml2();
+  SLIC_INFO(axom::fmt::format("adaptive backward euler: {} steps, max dt {}, relative error {}", adaptive_steps,
+                              adaptive_max_dt, error.Norml2()));
+
+  // the step grows by orders of magnitude from its initial value once the transient decays
+  EXPECT_GT(adaptive_max_dt, 100.0 * 1.0e-3);
+  EXPECT_LT(adaptive_steps, reference_steps / 10);
+  EXPECT_LT(error.Norml2(), 1.0e-2);
+}
+
+// integrates M dx_dt + K x + g(x) = f_ext with an IMEX timestepper, where g(x) = x^3 / 10 is treated explicitly
+mfem::Vector integrate_imex_first_order_ode(TimestepMethod timestepper, int steps, double t_final)
+{
+  double t                      = 0.0;
+  double ode_residual_eval_time = 0.0;
+  double previous_dt            = -1.0;
+  double c0;
+
+  mfem::Vector x(3);
+  mfem::Vector previous(3);
+  mfem::Vector load(3);
+  previous = 0.0;
+  load     = 0.0;
+
+  mfem::DenseMatrix J(3, 3);
+
+  auto                      mesh1D = mfem::Mesh::MakeCartesian1D(2);
+  mfem::ParMesh             mesh(MPI_COMM_WORLD, mesh1D);
+  BoundaryConditionManager  bcs(mesh);
+  serac::FiniteElementState dummy(mesh, FiniteElementState::Options{.order = 1, .name = "dummy"});
+
+  // only the linear part is solved for, so its Jacobian doesn't depend on the solution
+  StdFunctionOperator residual(
+      3,
+      [&](const mfem::Vector& dx_dt, mfem::Vector& r) {
+        r = M * dx_dt + internal_force_linear(x + c0 * dx_dt) + load;
+      },
+      [&](const mfem::Vector& /* dx_dt */) -> mfem::Operator& {
+        J = M;
+        J.Add(c0, stiffness_linear(x));
+        return J;
+      });
+
+  EquationSolver solver(nonlinear_options, linear_options);
+  solver.setOperator(residual);
+
+  FirstOrderODE ode(dummy.space().TrueVSize(),
+                    {.time = ode_residual_eval_time, .u = x, .dt = c0, .du_dt = previous, .previous_dt = previous_dt},
+                    solver, bcs);
+
+  ode.SetTimestepper(timestepper);
+  auto linear_part = [](const mfem::Vector& u, mfem::Vector& r) { r = internal_force_linear(u); };
+  auto cubic_part  = [](const mfem::Vector& u, double, mfem::Vector& r) {
+    for (int i = 0; i < 3; i++) {
+      r(i) = 0.1 * u(i) * u(i) * u(i) - f_ext(i);
+    }
+  };
+  ode.SetIMEXSplitting({.implicit_residual = linear_part, .explicit_residual = cubic_part, .load = load});
+
+  mfem::Vector soln(3);
+  soln[0] = 1.0;
+  soln[1] = 2.0;
+  soln[2] = 3.0;
+
+  double dt = t_final / steps;
+  for (int i = 0; i < steps; i++) {
+    ode.Step(soln, t, dt);
+  }
+
+  return soln;
+}
+
+TEST(FirstOrderODE, IMEXOrderOfConvergence)
+{
+  constexpr double t_final = 1.0;
+
+  auto reference = integrate_imex_first_order_ode(TimestepMethod::IMEXARS222, 1024, t_final);
+
+  std::array methods = {std::pair{TimestepMethod::IMEXEuler, 1}, std::pair{TimestepMethod::IMEXARS222, 2}};
+  for (auto [timestepper, order] : methods) {
+    mfem::Vector coarse_error = integrate_imex_first_order_ode(timestepper, 16, t_final) - reference;
+    mfem::Vector fine_error   = integrate_imex_first_order_ode(timestepper, 32, t_final) - reference;
+
+    double rate = std::log2(coarse_error.Norml2() / fine_error.Norml2());
+    SLIC_INFO(axom::fmt::format("{}: observed order of convergence {}", to_string(timestepper), rate));
+    EXPECT_GT(rate, order - 0.2);
+  }
+}
+
+TEST(SolutionExtrapolator, QuadraticIsExact)
+{
+  auto quadratic = [](double t) {
+    mfem::Vector u(2);
+    u[0] = 1.0 + 2.0 * t - 3.0 * t * t;
+    u[1] = -t * t;
+    return u;
+  };
+
+  SolutionExtrapolator predictor(3);
+  predictor.push(0.0, quadratic(0.0));
+  predictor.push(0.1, quadratic(0.1));
+  EXPECT_FALSE(predictor.ready());
+
+  // a restarted step replaces the kept states at and after its time
+  mfem::Vector rejected = quadratic(0.5);
+  rejected *= 2.0;
+  predictor.push(0.5, rejected);
+  predictor.push(0.3, quadratic(0.3));
+  ASSERT_TRUE(predictor.ready());
+
+  mfem::Vector u;
+  mfem::Vector exact = quadratic(0.45);
+  predictor.predict(0.45, u);
+  u -= exact;
+  EXPECT_LT(u.Norml2(), 1.0e-12);
+
+  // the oldest state falls out of the ring buffer
+  predictor.push(0.6, quadratic(0.6));
+  exact = quadratic(1.0);
+  predictor.predict(1.0, u);
+  u -= exact;
+  EXPECT_LT(u.Norml2(), 1.0e-12);
+}
+
 int main(int argc, char* argv[])
 {
   int result = 0;
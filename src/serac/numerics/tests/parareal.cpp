@@ -0,0 +1,86 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "axom/slic/core/SimpleLogger.hpp"
+#include <gtest/gtest.h>
+#include "mfem.hpp"
+
+#include "serac/infrastructure/initialize.hpp"
+#include "serac/numerics/parareal.hpp"
+
+using namespace serac;
+
+// du/dt = -lambda u, where each rank of a slice owns a few of the components (with different decay rates)
+Propagator backwardEuler(int space_rank, int num_steps)
+{
+  return [=](mfem::Vector& u, double, double dt) {
+    double h = dt / num_steps;
+    for (int step = 0; step < num_steps; step++) {
+      for (int i = 0; i < u.Size(); i++) {
+        double lambda = 1.0 + i + u.Size() * space_rank;
+        u(i) /= 1.0 + lambda * h;
+      }
+    }
+  };
+}
+
+void verifyParareal(int num_slices, const PararealOptions& options, double tolerance)
+{
+  auto [space_comm, time_comm] = splitTimeSlices(MPI_COMM_WORLD, num_slices);
+  auto [_, space_rank]         = getMPIInfo(space_comm);
+  auto [num_time_ranks, slice] = getMPIInfo(time_comm);
+  ASSERT_EQ(num_time_ranks, num_slices);
+
+  constexpr int    steps_per_slice = 20;
+  constexpr double slice_length    = 0.25;
+
+  Parareal parareal(space_comm, time_comm, backwardEuler(space_rank, steps_per_slice), backwardEuler(space_rank, 1),
+                    options);
+
+  mfem::Vector u(3);
+  u = 1.0;
+  int iterations = parareal.solve(u, 0.0, slice_length);
+  EXPECT_LE(iterations, num_slices);
+
+  // the sequential fine integration, up to the end of this slice
+  mfem::Vector expected(3);
+  expected = 1.0;
+  backwardEuler(space_rank, steps_per_slice * (slice + 1))(expected, 0.0, slice_length * (slice + 1));
+
+  for (int i = 0; i < 3; i++) {
+    EXPECT_NEAR(u(i), expected(i), tolerance);
+  }
+
+  MPI_Comm_free(&space_comm);
+  MPI_Comm_free(&time_comm);
+}
+
+TEST(Parareal, ExactAfterAsManyIterationsAsSlices)
+{
+  verifyParareal(4, {.relative_tol = 0.0, .absolute_tol = 0.0, .max_iterations = 4}, 1.0e-14);
+}
+
+TEST(Parareal, ConvergesWithSlicesOfSeveralRanks)
+{
+  verifyParareal(2, {.relative_tol = 1.0e-10, .absolute_tol = 1.0e-14, .max_iterations = 10}, 1.0e-9);
+}
+
+int main(int argc, char* argv[])
+{
+  int result = 0;
+
+  ::testing::InitGoogleTest(&argc, argv);
+
+  MPI_Init(&argc, &argv);
+
+  axom::slic::SimpleLogger logger;
+
+  result = RUN_ALL_TESTS();
+
+  MPI_Finalize();
+
+  return result;
+}
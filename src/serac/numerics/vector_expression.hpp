@@ -15,7 +15,20 @@
 
 #include "mfem.hpp"
 
+#include "serac/infrastructure/accelerator.hpp"
+
 namespace serac {
+
+namespace detail {
+
+/**
+ * @brief expressions with fewer entries than this are evaluated serially, since starting threads would take
+ * longer than evaluating them
+ */
+inline constexpr int parallel_evaluation_threshold = 8192;
+
+}  // namespace detail
+
 /**
  * @brief A base class representing a vector expression
  * @tparam T The base vector type, e.g., mfem::Vector, or another VectorExpr
@@ -44,12 +57,32 @@ public:
   operator mfem::Vector() const
   {
     mfem::Vector result(Size());
-    for (int i = 0; i < Size(); i++) {
-      result[i] = (*this)[i];
-    }
+    evaluate_into(result);
     return result;
   }
 
+  /**
+   * @brief Fully evaluates the vector expression into an existing vector, without allocating a temporary
+   * @param result The vector to populate with the expression result
+   *
+   * @note the entries are evaluated in parallel when OpenMP is enabled (and the expression is large enough
+   * to benefit), so any user-provided functors in the expression must be thread-safe
+   */
+  void evaluate_into(mfem::Vector& result) const
+  {
+    SLIC_ERROR_IF(Size() != result.Size(), "Vector sizes in expression assignment must be equal");
+
+    // Get the underlying array for indexing compatibility with mfem::HypreParVector
+    double*   result_arr = result.GetData();
+    const T&  expr       = asDerived();
+    const int n          = expr.Size();
+
+    SERAC_OMP_PARALLEL_FOR_IF(n >= detail::parallel_evaluation_threshold)
+    for (int i = 0; i < n; i++) {
+      result_arr[i] = expr[i];
+    }
+  }
+
   /**
    * @brief Performs a compile-time downcast to the derived object
    * @return The derived object
@@ -81,16 +114,12 @@ mfem::Vector evaluate(const VectorExpr<T>& expr)
  * @brief Fully evaluates a vector expression into an actual mfem::Vector
  * @param expr The expression to evaluate
  * @param result The vector to populate with the expression result
+ * @see VectorExpr::evaluate_into
  */
 template <typename T>
 void evaluate(const VectorExpr<T>& expr, mfem::Vector& result)
 {
-  SLIC_ERROR_IF(expr.Size() != result.Size(), "Vector sizes in expression assignment must be equal");
-  // Get the underlying array for indexing compatibility with mfem::HypreParVector
-  double* result_arr = result.GetData();
-  for (int i = 0; i < expr.Size(); i++) {
-    result_arr[i] = expr[i];
-  }
+  expr.evaluate_into(result);
 }
 
 }  // namespace serac
@@ -6,18 +6,146 @@
 
 #include "serac/physics/base_physics.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
 #include <fstream>
+#include <limits>
+#include <thread>
 
 #include "axom/fmt.hpp"
 
 #include "serac/infrastructure/initialize.hpp"
 #include "serac/infrastructure/logger.hpp"
 #include "serac/infrastructure/terminator.hpp"
+#include "serac/numerics/checkpoint_schedule.hpp"
 #include "serac/physics/state/finite_element_state.hpp"
 #include "serac/physics/state/state_manager.hpp"
 
 namespace serac {
 
+namespace {
+
+/// The statistics of a state reduced by saveSummary(): the sums (l1 norm, squared l2 norm, sum and size)
+/// first, then the maxima (linf norm, max and -min)
+constexpr int num_summed_statistics = 4;
+constexpr int num_statistics        = 7;
+
+/// The MPI reduction of the (contiguous) statistics of each state
+void reduceStatistics(void* in, void* inout, int* len, MPI_Datatype*)
+{
+  auto* local  = static_cast<const double*>(in);
+  auto* global = static_cast<double*>(inout);
+  for (int i = 0; i < *len; i++, local += num_statistics, global += num_statistics) {
+    for (int j = 0; j < num_summed_statistics; j++) {
+      global[j] += local[j];
+    }
+    for (int j = num_summed_statistics; j < num_statistics; j++) {
+      global[j] = std::max(global[j], local[j]);
+    }
+  }
+}
+
+/// The Lp norm of the state on the elements of this rank, see norm()
+double localNorm(const FiniteElementState& state, const double p)
+{
+  const mfem::GridFunction& grid_function = state.gridFunction();
+  if (state.space().GetVDim() == 1) {
+    mfem::ConstantCoefficient zero(0.0);
+    return grid_function.mfem::GridFunction::ComputeLpError(p, zero);
+  }
+  mfem::Vector zero(state.space().GetVDim());
+  zero = 0.0;
+  mfem::VectorConstantCoefficient zerovec(zero);
+  return grid_function.mfem::GridFunction::ComputeLpError(p, zerovec);
+}
+
+/**
+ * @brief The l1, l2 and linf norms, average, min and max of each state
+ *
+ * These are the values of norm(), avg(), min() and max(), but with a single reduction for all the states.
+ */
+std::vector<std::array<double, 6>> summaryStatistics(const std::vector<FiniteElementState*>& states, MPI_Comm comm)
+{
+  std::vector<double> local(states.size() * num_statistics);
+  for (std::size_t i = 0; i < states.size(); i++) {
+    const FiniteElementState& state = *states[i];
+    double*                   stats = &local[i * num_statistics];
+
+    stats[0] = localNorm(state, 1.0);
+    stats[1] = std::pow(localNorm(state, 2.0), 2);
+    stats[2] = state.Sum();
+    stats[3] = state.Size();
+    stats[4] = localNorm(state, mfem::infinity());
+    stats[5] = state.Size() > 0 ? state.Max() : -std::numeric_limits<double>::infinity();
+    stats[6] = state.Size() > 0 ? -state.Min() : -std::numeric_limits<double>::infinity();
+  }
+
+  MPI_Datatype statistics_type;
+  MPI_Type_contiguous(num_statistics, MPI_DOUBLE, &statistics_type);
+  MPI_Type_commit(&statistics_type);
+  MPI_Op reduction;
+  MPI_Op_create(reduceStatistics, 1, &reduction);
+
+  std::vector<double> global(local.size());
+  MPI_Allreduce(local.data(), global.data(), static_cast<int>(states.size()), statistics_type, reduction, comm);
+
+  MPI_Op_free(&reduction);
+  MPI_Type_free(&statistics_type);
+
+  std::vector<std::array<double, 6>> statistics(states.size());
+  for (std::size_t i = 0; i < states.size(); i++) {
+    const double* stats = &global[i * num_statistics];
+    statistics[i]       = {stats[0], std::sqrt(stats[1]), stats[4], stats[2] / stats[3], -stats[6], stats[5]};
+  }
+  return statistics;
+}
+
+/// The names of the statistics of summaryStatistics(), in order
+const std::array<std::string, 6> statistic_names = {"l1norms", "l2norms", "linfnorms", "avgs", "mins", "maxs"};
+
+/// The names of the values of telemetryValues(), in order
+const std::array<std::string, 11> telemetry_names = {"solves",
+                                                     "nonlinear_iterations",
+                                                     "linear_iterations",
+                                                     "max_linear_iterations",
+                                                     "initial_residual_norm",
+                                                     "final_residual_norm",
+                                                     "residual_time",
+                                                     "assembly_time",
+                                                     "preconditioner_setup_time",
+                                                     "linear_solve_time",
+                                                     "output_time"};
+
+/**
+ * @brief The values of the telemetry of the solves (and outputs) since the last summary, with the times of the
+ * slowest rank
+ */
+std::array<double, 11> telemetryValues(const SolveTelemetry& telemetry, double output_time, MPI_Comm comm)
+{
+  std::array<double, 5> times = {telemetry.residual_time, telemetry.assembly_time,
+                                 telemetry.preconditioner_setup_time, telemetry.linear_solve_time, output_time};
+  MPI_Allreduce(MPI_IN_PLACE, times.data(), static_cast<int>(times.size()), MPI_DOUBLE, MPI_MAX, comm);
+
+  const auto& iterations     = telemetry.linear_iterations;
+  int         max_iterations = iterations.empty() ? 0 : *std::max_element(iterations.begin(), iterations.end());
+  return {double(telemetry.solves),
+          double(telemetry.nonlinear_iterations),
+          double(telemetry.totalLinearIterations()),
+          double(max_iterations),
+          telemetry.initial_residual_norm,
+          telemetry.final_residual_norm,
+          times[0],
+          times[1],
+          times[2],
+          times[3],
+          times[4]};
+}
+
+}  // namespace
+
 BasePhysics::BasePhysics(std::string name, mfem::ParMesh* pmesh)
     : name_(name),
       sidre_datacoll_id_(StateManager::collectionID(pmesh)),
@@ -28,6 +156,7 @@ BasePhysics::BasePhysics(std::string name, mfem::ParMesh* pmesh)
       time_(0.0),
       cycle_(0),
       ode_time_point_(0.0),
+      last_restart_wall_time_(MPI_Wtime()),
       bcs_(mesh_)
 {
   std::tie(mpi_size_, mpi_rank_) = getMPIInfo(comm_);
@@ -108,31 +237,168 @@ void BasePhysics::setShapeDisplacement(FiniteElementState& shape_displacement)
   shape_displacement_ = shape_displacement;
 }
 
-void BasePhysics::outputState(std::optional<std::string> paraview_output_dir) const
+void BasePhysics::setOutputPolicy(const OutputPolicy& policy)
 {
-  // Update the states and duals in the state manager
-  for (auto& state : states_) {
-    StateManager::updateState(*state);
+  SLIC_ERROR_ROOT_IF(policy.restart_cycle_interval < 0 || policy.visualization_cycle_interval < 0 ||
+                         policy.in_situ_cycle_interval < 0,
+                     "Output cycle intervals must be >= 0");
+  SLIC_ERROR_ROOT_IF(policy.visualization_levels_of_detail < 0, "Visualization levels of detail must be >= 0");
+  SLIC_WARNING_ROOT_IF(paraview_dc_, "The visualization options of the output policy are ignored after the first "
+                                     "visualization output");
+  SLIC_ERROR_ROOT_IF(policy.summary_flush_interval < 1, "The summary flush interval must be >= 1");
+  output_policy_ = policy;
+
+  if (summary_stream_.is_open()) {
+    summary_stream_.close();
   }
+  if (!policy.summary_file.empty() && mpi_rank_ == 0) {
+    // a restarted run continues the summary file of the original one
+    auto mode = StateManager::isRestart() ? std::ios::app | std::ios::ate : std::ios::trunc;
+    summary_stream_.open(policy.summary_file, std::ios::out | mode);
+    SLIC_ERROR_IF(!summary_stream_, axom::fmt::format("Could not open summary file '{}'", policy.summary_file));
+    summary_stream_.precision(std::numeric_limits<double>::max_digits10);
+    summary_rows_ = 0;
+  }
+}
 
-  for (auto& dual : duals_) {
-    StateManager::updateDual(*dual);
+void BasePhysics::addSummaryQuantity(const std::string& name, std::function<double()> qoi)
+{
+  summary_quantities_.emplace_back(name, std::move(qoi));
+}
+
+void BasePhysics::addDerivedField(std::unique_ptr<FiniteElementState>      field,
+                                  std::function<void(FiniteElementState&)> compute)
+{
+  SLIC_ERROR_ROOT_IF(!field || !compute, "A derived field needs a field and a function computing it");
+  derived_fields_.push_back({std::move(field), std::move(compute)});
+}
+
+const FiniteElementState& BasePhysics::derivedField(const std::string& name) const
+{
+  for (auto& derived : derived_fields_) {
+    if (derived.field->name() == name) {
+      derived.compute(*derived.field);
+      return *derived.field;
+    }
   }
 
+  SLIC_ERROR_ROOT(axom::fmt::format("Derived field '{}' requested from physics module '{}', but it doesn't exist",
+                                    name, name_));
+  return *derived_fields_.front().field;
+}
+
+std::vector<const FiniteElementState*> BasePhysics::visualizationFields() const
+{
+  // The fields written to the visualization files
+  const auto& subset          = output_policy_.visualization_fields;
+  auto        is_output_field = [&subset](const FiniteElementState& state) {
+    return subset.empty() || std::find(subset.begin(), subset.end(), state.name()) != subset.end();
+  };
+  std::vector<const FiniteElementState*> fields;
+  for (FiniteElementState* state : states_) {
+    fields.push_back(state);
+  }
   for (auto& parameter : parameters_) {
-    SLIC_ERROR_ROOT_IF(!parameter.state, "Parameter state expected but not defined");
-    StateManager::updateState(*parameter.state);
-    StateManager::updateDual(*parameter.sensitivity);
+    fields.push_back(parameter.state);
+  }
+  fields.push_back(&shape_displacement_);
+
+  // the derived fields are only computed on the cycles that write them
+  for (auto& derived : derived_fields_) {
+    if (is_output_field(*derived.field)) {
+      derived.compute(*derived.field);
+      derived.field->gridFunction();
+      fields.push_back(derived.field.get());
+    }
+  }
+
+  fields.erase(std::remove_if(fields.begin(), fields.end(), [&](auto field) { return !is_output_field(*field); }),
+               fields.end());
+
+  return fields;
+}
+
+void BasePhysics::shareVisualization(BasePhysics& module)
+{
+  SLIC_ERROR_ROOT_IF(&module == this || module.visualization_host_ || !module.visualization_modules_.empty(),
+                     axom::fmt::format("The visualization of physics module '{}' cannot be shared with '{}'",
+                                       module.name_, name_));
+  SLIC_ERROR_ROOT_IF(&module.mesh_ != &mesh_,
+                     axom::fmt::format("Physics modules '{}' and '{}' can only share their visualization on the same "
+                                       "mesh",
+                                       module.name_, name_));
+  SLIC_ERROR_ROOT_IF(paraview_dc_, axom::fmt::format("The visualization of physics module '{}' must be shared before "
+                                                     "its first visualization output",
+                                                     name_));
+  visualization_modules_.push_back(&module);
+  module.visualization_host_ = this;
+}
+
+void BasePhysics::outputState(std::optional<std::string> paraview_output_dir, bool force) const
+{
+  double start = MPI_Wtime();
+
+  auto on_cycle = [this](int interval) { return interval > 0 && cycle_ % interval == 0; };
+
+  bool write_restart = force || on_cycle(output_policy_.restart_cycle_interval);
+  if (!write_restart && output_policy_.restart_wall_interval > 0.0) {
+    // rank 0 decides, so that all the ranks take part in the (collective) save
+    int due = (mpi_rank_ == 0) && (MPI_Wtime() - last_restart_wall_time_ >= output_policy_.restart_wall_interval);
+    MPI_Bcast(&due, 1, MPI_INT, 0, comm_);
+    write_restart = due;
+  }
+
+  bool publish_in_situ = StateManager::inSituEnabled() && (force || on_cycle(output_policy_.in_situ_cycle_interval));
+
+  if (write_restart || publish_in_situ) {
+    // Update the states and duals in the state manager
+    for (auto& state : states_) {
+      StateManager::updateState(*state);
+    }
+
+    for (auto& dual : duals_) {
+      StateManager::updateDual(*dual);
+    }
+
+    for (auto& parameter : parameters_) {
+      SLIC_ERROR_ROOT_IF(!parameter.state, "Parameter state expected but not defined");
+      StateManager::updateState(*parameter.state);
+      StateManager::updateDual(*parameter.sensitivity);
+    }
+
+    StateManager::updateState(shape_displacement_);
+    StateManager::updateDual(shape_displacement_sensitivity_);
+
   }
 
-  StateManager::updateState(shape_displacement_);
-  StateManager::updateDual(shape_displacement_sensitivity_);
+  if (write_restart) {
+    // Save the restart/Sidre file
+    StateManager::save(time_, cycle_, sidre_datacoll_id_);
+    last_restart_wall_time_ = MPI_Wtime();
+  }
 
-  // Save the restart/Sidre file
-  StateManager::save(time_, cycle_, sidre_datacoll_id_);
+  if (publish_in_situ) {
+    // Run the in-situ visualization and analysis on the Blueprint data of the state manager
+    StateManager::publishInSitu(time_, cycle_, sidre_datacoll_id_);
+  }
 
   // Optionally output a paraview datacollection for visualization
-  if (paraview_output_dir) {
+  // (the visualization fields of a module that shares them are written by the outputState() of its host)
+  if (paraview_output_dir && !visualization_host_ &&
+      (force || on_cycle(output_policy_.visualization_cycle_interval))) {
+    std::vector<const FiniteElementState*> fields = visualizationFields();
+
+    // the fields of the modules sharing this one's visualization, except for those this module writes already
+    std::vector<const FiniteElementState*> shared_fields;
+    for (const BasePhysics* module : visualization_modules_) {
+      for (const FiniteElementState* field : module->visualizationFields()) {
+        if (std::find(fields.begin(), fields.end(), field) == fields.end() &&
+            std::find(shared_fields.begin(), shared_fields.end(), field) == shared_fields.end()) {
+          shared_fields.push_back(field);
+        }
+      }
+    }
+
     // Check to see if the paraview data collection exists. If not, create it.
     if (!paraview_dc_) {
       std::string output_name = name_;
@@ -143,33 +409,47 @@ void BasePhysics::outputState(std::optional<std::string> paraview_output_dir) co
       paraview_dc_            = std::make_unique<mfem::ParaViewDataCollection>(output_name, &states_.front()->mesh());
       int max_order_in_fields = 0;
 
-      // Find the maximum polynomial order in the physics module's states
-      for (FiniteElementState* state : states_) {
-        paraview_dc_->RegisterField(state->name(), &state->gridFunction());
-        max_order_in_fields = std::max(max_order_in_fields, state->space().GetOrder(0));
-      }
-
-      for (auto& parameter : parameters_) {
-        paraview_dc_->RegisterField(parameter.state->name(), &parameter.state->gridFunction());
-        max_order_in_fields = std::max(max_order_in_fields, parameter.state->space().GetOrder(0));
+      // Find the maximum polynomial order in the physics module's output fields
+      for (auto* field_list : {&fields, &shared_fields}) {
+        for (const FiniteElementState* field : *field_list) {
+          paraview_dc_->RegisterField(field->name(), &field->gridFunction());
+          max_order_in_fields = std::max(max_order_in_fields, field->space().GetOrder(0));
+        }
       }
 
-      paraview_dc_->RegisterField(shape_displacement_.name(), &shape_displacement_.gridFunction());
-      max_order_in_fields = std::max(max_order_in_fields, shape_displacement_.space().GetOrder(0));
-
       // Set the options for the paraview output files
-      paraview_dc_->SetLevelsOfDetail(max_order_in_fields);
-      paraview_dc_->SetHighOrderOutput(true);
+      int levels_of_detail = output_policy_.visualization_levels_of_detail;
+      paraview_dc_->SetLevelsOfDetail(levels_of_detail > 0 ? levels_of_detail : std::max(max_order_in_fields, 1));
+      paraview_dc_->SetHighOrderOutput(output_policy_.visualization_high_order);
       paraview_dc_->SetDataFormat(mfem::VTKFormat::BINARY);
       paraview_dc_->SetCompression(true);
+      if (StateManager::outputCompression().lossless_level > 0) {
+        paraview_dc_->SetCompressionLevel(StateManager::outputCompression().lossless_level);
+      }
     } else {
-      for (FiniteElementState* state : states_) {
-        state->gridFunction();  // update grid function values
+      // (updating the state manager already updated the grid functions of this module's fields)
+      if (!write_restart && !publish_in_situ) {
+        for (const FiniteElementState* field : fields) {
+          field->gridFunction();  // update grid function values
+        }
+      }
+      for (const FiniteElementState* field : shared_fields) {
+        field->gridFunction();
       }
-      for (auto& parameter : parameters_) {
-        parameter.state->gridFunction();
+    }
+
+    // Round the fields to the error bound of the lossy compression, if any. They are only the
+    // L-vectors of the states, which the next call to gridFunction() (or StateManager::updateState)
+    // overwrites again, and the restart file and in-situ visualization above already used them.
+    if (double bound = StateManager::outputCompression().visualization_error_bound; bound > 0.0) {
+      // a power of two step, so that the rounded values have trailing zero bits for the lossless stage
+      const double step = std::exp2(std::floor(std::log2(2.0 * bound)));
+      for (auto& named_field : paraview_dc_->GetFieldMap()) {
+        auto* field = named_field.second;
+        for (int i = 0; i < field->Size(); i++) {
+          (*field)(i) = step * std::round((*field)(i) / step);
+        }
       }
-      shape_displacement_.gridFunction();
     }
 
     // Set the current time, cycle, and requested paraview directory
@@ -180,6 +460,8 @@ void BasePhysics::outputState(std::optional<std::string> paraview_output_dir) co
     // Write the paraview file
     paraview_dc_->Save();
   }
+
+  output_time_ += MPI_Wtime() - start;
 }
 
 void BasePhysics::initializeSummary(axom::sidre::DataStore& datastore, double t_final, double dt) const
@@ -194,11 +476,22 @@ void BasePhysics::initializeSummary(axom::sidre::DataStore& datastore, double t_
   //         │    ├── l1norm : Sidre::Array<double>
   //         │    └── l2norm : Sidre::Array<double>
   //         ...
-  //         └── <FiniteElementState name>
-  //              ├── l1norm : Sidre::Array<double>
-  //              └── l2norm : Sidre::Array<double>
-
-  auto [count, rank] = getMPIInfo();
+  //         ├── <FiniteElementState name>
+  //         │    ├── l1norm : Sidre::Array<double>
+  //         │    └── l2norm : Sidre::Array<double>
+  //         ...
+  //         ├── <quantity of interest name>
+  //         │    └── values : Sidre::Array<double>
+  //         ...
+  //         └── telemetry
+  //              ├── <telemetry name, e.g. linear_iterations> : Sidre::Array<double>
+  //              ...
+  //
+  // The telemetry of each time step is that of the solves and outputs since the previous summary (see
+  // SolveTelemetry), with the times of the slowest rank.
+  // The curves are empty when they are streamed to the summary file, whose header this writes instead
+
+  auto [count, rank] = getMPIInfo(comm_);
   if (rank != 0) {
     // Don't initialize except on root node
     return;
@@ -216,6 +509,26 @@ void BasePhysics::initializeSummary(axom::sidre::DataStore& datastore, double t_
   // Write curves info
   axom::sidre::Group* curves_group = summary_group->createGroup("curves");
 
+  if (summary_stream_.is_open()) {
+    // a restarted run appending to its summary file already has the header
+    if (summary_stream_.tellp() == 0) {
+      summary_stream_ << "t";
+      for (FiniteElementState* state : states_) {
+        for (const auto& stat_name : statistic_names) {
+          summary_stream_ << "," << state->name() << "_" << stat_name;
+        }
+      }
+      for (const auto& [name, qoi] : summary_quantities_) {
+        summary_stream_ << "," << name;
+      }
+      for (const auto& telemetry_name : telemetry_names) {
+        summary_stream_ << ",telemetry_" << telemetry_name;
+      }
+      summary_stream_ << std::endl;
+    }
+    return;
+  }
+
   // Calculate how many time steps which is the array size
   axom::IndexType array_size = static_cast<axom::IndexType>(ceil(t_final / dt));
 
@@ -228,75 +541,230 @@ void BasePhysics::initializeSummary(axom::sidre::DataStore& datastore, double t_
     axom::sidre::Group* state_group = curves_group->createGroup(state->name());
 
     // Create an array for each stat type to hold a value at each time step
-    for (std::string stat_name : {"l1norms", "l2norms", "linfnorms", "avgs", "mins", "maxs"}) {
+    for (const auto& stat_name : statistic_names) {
       axom::sidre::View*         curr_array_view = state_group->createView(stat_name);
       axom::sidre::Array<double> array(curr_array_view, 0, array_size);
     }
   }
+
+  for (const auto& [name, qoi] : summary_quantities_) {
+    axom::sidre::View*         values_view = curves_group->createGroup(name)->createView("values");
+    axom::sidre::Array<double> values(values_view, 0, array_size);
+  }
+
+  axom::sidre::Group* telemetry_group = curves_group->createGroup("telemetry");
+  for (const auto& telemetry_name : telemetry_names) {
+    axom::sidre::Array<double> values(telemetry_group->createView(telemetry_name), 0, array_size);
+  }
 }
 
 void BasePhysics::saveSummary(axom::sidre::DataStore& datastore, const double t) const
 {
-  auto [_, rank] = getMPIInfo();
+  // Calculate the current stat values of every Finite Element State (Field) and quantity of interest
+  // Note: These are collective operations.
+  auto                statistics = summaryStatistics(states_, comm_);
+  std::vector<double> qoi_values;
+  for (const auto& [name, qoi] : summary_quantities_) {
+    qoi_values.push_back(qoi());
+  }
+
+  // the telemetry of the next time step starts anew
+  auto telemetry = telemetryValues(solveTelemetry(), output_time_, comm_);
+  resetSolveTelemetry();
+  output_time_ = 0.0;
 
-  // Find curves sidre group
-  axom::sidre::Group* curves_group = nullptr;
   // Only save on root node
-  if (rank == 0) {
-    axom::sidre::Group* sidre_root        = datastore.getRoot();
-    const std::string   curves_group_name = "serac_summary/curves";
-    SLIC_ERROR_IF(!sidre_root->hasGroup(curves_group_name),
-                  axom::fmt::format("Sidre Group '{0}' did not exist when saveCurves was called", curves_group_name));
-    curves_group = sidre_root->getGroup(curves_group_name);
+  if (mpi_rank_ != 0) {
+    return;
+  }
 
-    // Save time step
-    axom::sidre::Array<double> ts(curves_group->getView("t"));
-    ts.push_back(t);
+  // Append a row to the summary file, flushing it periodically so that crashed runs keep their summary data
+  if (summary_stream_.is_open()) {
+    summary_stream_ << t;
+    for (const auto& state_statistics : statistics) {
+      for (double value : state_statistics) {
+        summary_stream_ << "," << value;
+      }
+    }
+    for (double value : qoi_values) {
+      summary_stream_ << "," << value;
+    }
+    for (double value : telemetry) {
+      summary_stream_ << "," << value;
+    }
+    summary_stream_ << "\n";
+    if (++summary_rows_ % output_policy_.summary_flush_interval == 0) {
+      summary_stream_.flush();
+    }
+    return;
   }
 
-  // For each Finite Element State (Field)
-  double l1norm_value, l2norm_value, linfnorm_value, avg_value, max_value, min_value;
-  for (FiniteElementState* state : states_) {
-    // Calculate current stat value
-    // Note: These are collective operations.
-    l1norm_value   = norm(*state, 1.0);
-    l2norm_value   = norm(*state, 2.0);
-    linfnorm_value = norm(*state, mfem::infinity());
-    avg_value      = avg(*state);
-    max_value      = max(*state);
-    min_value      = min(*state);
-
-    // Only save on root node
-    if (rank == 0) {
-      // Group for this Finite Element State (Field)
-      axom::sidre::Group* state_group = curves_group->getGroup(state->name());
-
-      // Save all current stat values in their respective sidre arrays
-      axom::sidre::View*         l1norms_view = state_group->getView("l1norms");
-      axom::sidre::Array<double> l1norms(l1norms_view);
-      l1norms.push_back(l1norm_value);
-
-      axom::sidre::View*         l2norms_view = state_group->getView("l2norms");
-      axom::sidre::Array<double> l2norms(l2norms_view);
-      l2norms.push_back(l2norm_value);
-
-      axom::sidre::View*         linfnorms_view = state_group->getView("linfnorms");
-      axom::sidre::Array<double> linfnorms(linfnorms_view);
-      linfnorms.push_back(linfnorm_value);
-
-      axom::sidre::View*         avgs_view = state_group->getView("avgs");
-      axom::sidre::Array<double> avgs(avgs_view);
-      avgs.push_back(avg_value);
-
-      axom::sidre::View*         maxs_view = state_group->getView("maxs");
-      axom::sidre::Array<double> maxs(maxs_view);
-      maxs.push_back(max_value);
-
-      axom::sidre::View*         mins_view = state_group->getView("mins");
-      axom::sidre::Array<double> mins(mins_view);
-      mins.push_back(min_value);
+  // Find curves sidre group
+  axom::sidre::Group* sidre_root        = datastore.getRoot();
+  const std::string   curves_group_name = "serac_summary/curves";
+  SLIC_ERROR_IF(!sidre_root->hasGroup(curves_group_name),
+                axom::fmt::format("Sidre Group '{0}' did not exist when saveCurves was called", curves_group_name));
+  axom::sidre::Group* curves_group = sidre_root->getGroup(curves_group_name);
+
+  // Save time step
+  axom::sidre::Array<double> ts(curves_group->getView("t"));
+  ts.push_back(t);
+
+  for (std::size_t i = 0; i < states_.size(); i++) {
+    // Group for this Finite Element State (Field)
+    axom::sidre::Group* state_group = curves_group->getGroup(states_[i]->name());
+
+    // Save all current stat values in their respective sidre arrays
+    for (std::size_t j = 0; j < statistic_names.size(); j++) {
+      axom::sidre::Array<double> values(state_group->getView(statistic_names[j]));
+      values.push_back(statistics[i][j]);
+    }
+  }
+
+  for (std::size_t i = 0; i < summary_quantities_.size(); i++) {
+    axom::sidre::Array<double> values(curves_group->getGroup(summary_quantities_[i].first)->getView("values"));
+    values.push_back(qoi_values[i]);
+  }
+
+  axom::sidre::Group* telemetry_group = curves_group->getGroup("telemetry");
+  for (std::size_t i = 0; i < telemetry_names.size(); i++) {
+    axom::sidre::Array<double> values(telemetry_group->getView(telemetry_names[i]));
+    values.push_back(telemetry[i]);
+  }
+}
+
+void BasePhysics::solveTransientAdjoint(int num_steps, double dt, std::function<void(int)> adjoint_step,
+                                        const CheckpointOptions& options)
+{
+  SLIC_ERROR_ROOT_IF(options.memory_checkpoints < 1 || options.disk_checkpoints < 0,
+                     "Transient adjoints need at least one checkpoint in memory");
+
+  std::vector<std::vector<char>> memory_checkpoints(static_cast<size_t>(options.memory_checkpoints));
+
+  // each disk checkpoint is written by its own thread, from a copy of the states, so that the forward steps carry on
+  // while it is written. Each rank writes its own file.
+  std::vector<std::thread> disk_writers(static_cast<size_t>(options.disk_checkpoints));
+  auto checkpoint_file = [&](int slot) {
+    return axom::fmt::format("{}/{}_checkpoint_{}.{}.bin", options.directory, name_, slot, mpi_rank_);
+  };
+
+  using Action = CheckpointOperation::Action;
+  for (auto op : binomialCheckpointSchedule(num_steps, options.memory_checkpoints + options.disk_checkpoints)) {
+    auto slot = static_cast<size_t>(op.slot);
+    switch (op.action) {
+      case Action::Store:
+        if (op.slot < options.memory_checkpoints) {
+          memory_checkpoints[slot] = packCheckpoint();
+        } else {
+          auto& writer = disk_writers[slot - memory_checkpoints.size()];
+          if (writer.joinable()) {
+            writer.join();
+          }
+          writer = std::thread([file = checkpoint_file(op.slot), checkpoint = packCheckpoint()]() {
+            std::ofstream(file, std::ios::binary)
+                .write(checkpoint.data(), static_cast<std::streamsize>(checkpoint.size()));
+          });
+        }
+        break;
+
+      case Action::Restore:
+        if (op.slot < options.memory_checkpoints) {
+          unpackCheckpoint(memory_checkpoints[slot]);
+        } else {
+          auto& writer = disk_writers[slot - memory_checkpoints.size()];
+          if (writer.joinable()) {
+            writer.join();
+          }
+          std::ifstream     file(checkpoint_file(op.slot), std::ios::binary);
+          std::vector<char> checkpoint(checkpointSize());
+          file.read(checkpoint.data(), static_cast<std::streamsize>(checkpoint.size()));
+          SLIC_ERROR_IF(!file, axom::fmt::format("Could not read the checkpoint file '{}'", checkpoint_file(op.slot)));
+          unpackCheckpoint(checkpoint);
+        }
+        break;
+
+      case Action::Advance: {
+        double step_dt = dt;
+        advanceTimestep(step_dt);
+        SLIC_ERROR_ROOT_IF(step_dt != dt, "Transient adjoints need fixed time steps, but the step was cut back");
+        break;
+      }
+
+      case Action::Adjoint:
+        adjoint_step(op.step);
+        break;
     }
   }
+
+  for (int slot = 0; slot < options.disk_checkpoints; slot++) {
+    auto& writer = disk_writers[static_cast<size_t>(slot)];
+    if (writer.joinable()) {
+      writer.join();
+      std::remove(checkpoint_file(options.memory_checkpoints + slot).c_str());
+    }
+  }
+}
+
+size_t BasePhysics::checkpointSize() const
+{
+  size_t size = sizeof(time_) + sizeof(cycle_);
+  for (auto* state : states_) {
+    size += sizeof(double) * static_cast<size_t>(state->Size());
+  }
+  for (auto& qdata : checkpointed_qdata_) {
+    size += qdata().second;
+  }
+  return size;
+}
+
+std::vector<char> BasePhysics::packCheckpoint() const
+{
+  std::vector<char> checkpoint(checkpointSize());
+  char*             position = checkpoint.data();
+  auto              pack     = [&position](const void* data, size_t bytes) {
+    std::memcpy(position, data, bytes);
+    position += bytes;
+  };
+
+  double checkpoint_time  = time();
+  int    checkpoint_cycle = cycle();
+  pack(&checkpoint_time, sizeof(checkpoint_time));
+  pack(&checkpoint_cycle, sizeof(checkpoint_cycle));
+  for (auto* state : states_) {
+    pack(state->HostRead(), sizeof(double) * static_cast<size_t>(state->Size()));
+  }
+  for (auto& qdata : checkpointed_qdata_) {
+    auto [data, bytes] = qdata();
+    pack(data, bytes);
+  }
+  return checkpoint;
+}
+
+void BasePhysics::unpackCheckpoint(const std::vector<char>& checkpoint)
+{
+  SLIC_ERROR_IF(checkpoint.size() != checkpointSize(),
+                "The checkpoint does not match the states, e.g. because the mesh changed since it was stored");
+
+  const char* position = checkpoint.data();
+  auto        unpack   = [&position](void* data, size_t bytes) {
+    std::memcpy(data, position, bytes);
+    position += bytes;
+  };
+
+  double checkpoint_time  = 0.0;
+  int    checkpoint_cycle = 0;
+  unpack(&checkpoint_time, sizeof(checkpoint_time));
+  unpack(&checkpoint_cycle, sizeof(checkpoint_cycle));
+  for (auto* state : states_) {
+    unpack(state->HostWrite(), sizeof(double) * static_cast<size_t>(state->Size()));
+  }
+  for (auto& qdata : checkpointed_qdata_) {
+    auto [data, bytes] = qdata();
+    unpack(data, bytes);
+  }
+
+  setTime(checkpoint_time);
+  setCycle(checkpoint_cycle);
 }
 
 namespace detail {
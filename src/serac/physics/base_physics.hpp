@@ -12,8 +12,12 @@
 
 #pragma once
 
+#include <fstream>
 #include <functional>
 #include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "mfem.hpp"
 #include "axom/sidre.hpp"
@@ -26,6 +30,49 @@
 
 namespace serac {
 
+/// When outputState() writes restart and visualization files (or publishes in situ), and what goes in the latter
+struct OutputPolicy {
+  /// Write a restart file on the cycles that are multiples of this, zero to only use restart_wall_interval
+  int restart_cycle_interval = 1;
+
+  /// Also write a restart file once this many wall-clock seconds have passed since the last one, zero to disable
+  double restart_wall_interval = 0.0;
+
+  /// Write the visualization files on the cycles that are multiples of this, zero to disable them
+  int visualization_cycle_interval = 1;
+
+  /// Levels of detail (subdivisions of each element) of the visualization, zero for the highest field order
+  int visualization_levels_of_detail = 0;
+
+  /// Write high-order (Lagrange) visualization cells instead of subdividing the elements into linear ones
+  bool visualization_high_order = true;
+
+  /// Names of the fields written to the visualization files, all of them if empty
+  std::vector<std::string> visualization_fields;
+
+  /// File (on rank 0) that saveSummary() appends the summary rows to as CSV, instead of keeping them in the datastore
+  std::string summary_file;
+
+  /// Flush the rows of the summary file every this many calls of saveSummary()
+  int summary_flush_interval = 1;
+
+  /// Publish the state to the in-situ visualization (see StateManager::enableInSitu) on the cycles that are multiples
+  /// of this, zero to disable it
+  int in_situ_cycle_interval = 1;
+};
+
+/// Where solveTransientAdjoint() keeps the checkpoints of the forward states
+struct CheckpointOptions {
+  /// The number of checkpoints kept in memory, at least 1
+  int memory_checkpoints = 8;
+
+  /// The number of additional checkpoints spilled to disk, which are written asynchronously
+  int disk_checkpoints = 0;
+
+  /// The directory (writable by every rank) of the disk checkpoints
+  std::string directory = ".";
+};
+
 /**
  * @brief This is the abstract base class for a generic forward solver
  */
@@ -212,6 +259,23 @@ public:
     return shape_displacement_sensitivity_;
   }
 
+  /**
+   * @brief Compute the implicit sensitivities of the quantity of interest used in defining the load for the adjoint
+   * problem with respect to every parameter field and the shape displacement field
+   *
+   * The results are written to the same sensitivities as computeSensitivity() and computeShapeSensitivity(), which
+   * this calls in turn, unless a physics module can compute them all in a single evaluation.
+   *
+   * @pre `solveAdjoint` with an appropriate adjoint load must be called prior to this method.
+   */
+  virtual void computeAllSensitivities()
+  {
+    for (size_t i = 0; i < parameters_.size(); i++) {
+      computeSensitivity(i);
+    }
+    computeShapeSensitivity();
+  }
+
   /**
    * @brief Advance the state variables according to the chosen time integrator
    *
@@ -237,13 +301,44 @@ public:
     return {};
   }
 
+  /**
+   * @brief Run a transient forward analysis, and then the adjoint of each of its time steps in reverse order
+   *
+   * The forward states are not all kept: a binomial (revolve) schedule over the checkpoints of @p options stores
+   * a few of them (the states, time, cycle and committed quadrature data of the materials), and recomputes the
+   * others from the nearest checkpoint as the adjoint sweep reaches them. With c checkpoints and r recomputations of
+   * each step, (c + r choose c) steps can be reversed, so memory grows only logarithmically with the number of steps
+   * for a few recomputations.
+   *
+   * @param[in] num_steps The number of time steps, starting from the current state
+   * @param[in] dt The (fixed) time step
+   * @param[in] adjoint_step Called with each step, from the last one to the first, while the states are those at the
+   * end of that step. It solves the adjoint problem of the step (e.g. with solveAdjoint() and a load that depends on
+   * the adjoint of the following step) and accumulates the sensitivities.
+   * @param[in] options Where the checkpoints are kept
+   * @note The states are those at the end of the first step when this returns
+   */
+  void solveTransientAdjoint(int num_steps, double dt, std::function<void(int)> adjoint_step,
+                             const CheckpointOptions& options = {});
+
   /**
    * @brief Output the current state of the PDE fields in Sidre format and optionally in Paraview format
    *  if \p paraview_output_dir is given.
    *
+   * Which of the files are written on the current cycle is given by the output policy, see setOutputPolicy().
+   *
    * @param[in] paraview_output_dir Optional output directory for paraview visualization files
+   * @param[in] force Write all the files regardless of the output policy, e.g. on the last cycle
+   */
+  virtual void outputState(std::optional<std::string> paraview_output_dir = {}, bool force = false) const;
+
+  /**
+   * @brief Sets when outputState() writes restart and visualization files, and what goes in the latter
+   *
+   * @param[in] policy The output policy
+   * @pre The visualization options only take effect if this is called before the first visualization output
    */
-  virtual void outputState(std::optional<std::string> paraview_output_dir = {}) const;
+  void setOutputPolicy(const OutputPolicy& policy);
 
   /**
    * @brief Initializes the Sidre structure for simulation summary data
@@ -255,13 +350,68 @@ public:
   virtual void initializeSummary(axom::sidre::DataStore& datastore, const double t_final, const double dt) const;
 
   /**
-   * @brief Saves the summary data to the Sidre Datastore
+   * @brief Saves the summary data to the Sidre Datastore, or appends it to the summary file of the output policy
+   *
+   * The statistics of all the states are reduced over the ranks at once. The telemetry of the solves and outputs
+   * since the previous summary is saved with them, and reset.
    *
    * @param[in] datastore Sidre DataStore where curves are saved
    * @param[in] t The current time of the simulation
    */
   virtual void saveSummary(axom::sidre::DataStore& datastore, const double t) const;
 
+  /**
+   * @brief The telemetry of the solves of the physics module since the last resetSolveTelemetry(), which
+   * saveSummary() saves (and resets) for each time step
+   */
+  virtual SolveTelemetry solveTelemetry() const { return {}; }
+
+  /**
+   * @brief Start accumulating the telemetry of the next solves anew, see solveTelemetry()
+   */
+  virtual void resetSolveTelemetry() const {}
+
+  /**
+   * @brief Adds a quantity of interest to the summary data
+   *
+   * @param[in] name The name of the quantity
+   * @param[in] qoi Function returning the current (global) value of the quantity. It is called on every rank, so it
+   * may be collective.
+   * @pre This must be called before initializeSummary()
+   */
+  void addSummaryQuantity(const std::string& name, std::function<double()> qoi);
+
+  /**
+   * @brief Adds a field derived from the state of the physics module (e.g. a stress), which outputState() writes to
+   * the visualization files along with the states
+   *
+   * The field is only computed when it is written (or requested with derivedField()), not on every cycle.
+   *
+   * @param[in] field The field, whose name is the one used by the visualization files and the output policy
+   * @param[in] compute Sets the field to its current values. It is called on every rank, so it may be collective.
+   */
+  void addDerivedField(std::unique_ptr<FiniteElementState> field, std::function<void(FiniteElementState&)> compute);
+
+  /**
+   * @brief Computes a derived field (see addDerivedField()) from the current state
+   *
+   * @param[in] name The name of the field
+   * @return The field, which is valid until it is computed again
+   */
+  const FiniteElementState& derivedField(const std::string& name) const;
+
+  /**
+   * @brief Writes the visualization fields of another physics module on the same mesh along with those of this one,
+   * in a single shared collection, so that the mesh is written once per output instead of once per module
+   *
+   * The fields of @a module (those selected by its own output policy) are then written by the outputState() of this
+   * module, with its visualization options, and the outputState() of @a module only writes the restart files.
+   *
+   * @param[in] module The physics module, which must outlive this one
+   * @pre This must be called before the first visualization output of this module
+   */
+  void shareVisualization(BasePhysics& module);
+
   /**
    * @brief Destroy the Base Solver object
    */
@@ -377,6 +527,36 @@ protected:
    */
   mutable std::unique_ptr<mfem::ParaViewDataCollection> paraview_dc_;
 
+  /**
+   * @brief When restart and visualization files are written by outputState()
+   */
+  OutputPolicy output_policy_;
+
+  /**
+   * @brief Wall-clock time (of rank 0) of the last restart file written by outputState()
+   */
+  mutable double last_restart_wall_time_;
+
+  /**
+   * @brief The quantities of interest of the summary data, and the functions computing them
+   */
+  std::vector<std::pair<std::string, std::function<double()>>> summary_quantities_;
+
+  /**
+   * @brief The summary file of the output policy, only open on rank 0
+   */
+  mutable std::ofstream summary_stream_;
+
+  /**
+   * @brief The number of rows written to the summary file
+   */
+  mutable int summary_rows_ = 0;
+
+  /**
+   * @brief The time spent in outputState() since the last summary, for its telemetry
+   */
+  mutable double output_time_ = 0.0;
+
   /**
    * @brief State variable initialization indicator
    */
@@ -386,6 +566,51 @@ protected:
    * @brief Boundary condition manager instance
    */
   BoundaryConditionManager bcs_;
+
+  /**
+   * @brief The committed quadrature data of the materials, as raw memory (see QuadratureData::bytes()), which the
+   * checkpoints of solveTransientAdjoint() save along with the states
+   */
+  std::vector<std::function<std::pair<void*, size_t>()>> checkpointed_qdata_;
+
+  /// @brief A field derived from the states, see addDerivedField()
+  struct DerivedField {
+    std::unique_ptr<FiniteElementState>      field;    ///< the values of the field, when it was last computed
+    std::function<void(FiniteElementState&)> compute;  ///< sets the field to its current values
+  };
+
+  /**
+   * @brief The fields derived from the states, which are only computed when they are output
+   */
+  std::vector<DerivedField> derived_fields_;
+
+  /**
+   * @brief The other physics modules whose fields are written to the visualization files of this one, see
+   * shareVisualization()
+   */
+  std::vector<const BasePhysics*> visualization_modules_;
+
+  /**
+   * @brief The physics module that writes the visualization fields of this one, if they are shared
+   */
+  const BasePhysics* visualization_host_ = nullptr;
+
+private:
+  /**
+   * @brief The fields written to the visualization files, computing the derived ones among them
+   *
+   * @return The states, parameters, shape displacement and derived fields selected by the output policy
+   */
+  std::vector<const FiniteElementState*> visualizationFields() const;
+
+  /// @brief The size (in bytes) of a checkpoint of solveTransientAdjoint()
+  size_t checkpointSize() const;
+
+  /// @brief Copy the states, time, cycle and quadrature data into a checkpoint of solveTransientAdjoint()
+  std::vector<char> packCheckpoint() const;
+
+  /// @brief Restore the states, time, cycle and quadrature data from a checkpoint of solveTransientAdjoint()
+  void unpackCheckpoint(const std::vector<char>& checkpoint);
 };
 
 namespace detail {
@@ -0,0 +1,282 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file benchmark_io.cpp
+ *
+ * @brief Times the output of a solid mechanics problem with a plasticity model: restart files (StateManager::save(),
+ * including the internal variables of the material at each quadrature point), restarts from them
+ * (StateManager::load()), ParaView files (BasePhysics::outputState()) and the summary file
+ * (output::outputSummary()), on the benchmark beam refined 0, 1, ..., --parallel-refinement times, and with each
+ * of the restart file configurations: one file per rank, aggregated, asynchronous, incremental and compressed
+ *
+ * For each operation, the table printed at the end lists the (slowest rank's) time, the time that the simulation
+ * is blocked (less than the former for asynchronous saves), the bandwidth per rank, and the number of files and
+ * directories created, which is the number of metadata operations the file system has to serve.
+ */
+
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "axom/slic/core/SimpleLogger.hpp"
+#include "mfem.hpp"
+
+#include "serac/infrastructure/output.hpp"
+#include "serac/infrastructure/profiling.hpp"
+#include "serac/physics/benchmarks/benchmark_options.hpp"
+#include "serac/physics/materials/solid_material.hpp"
+#include "serac/physics/solid_mechanics.hpp"
+#include "serac/physics/state/state_manager.hpp"
+
+using namespace serac;
+
+/// the restart file options of a benchmark run, see StateManager
+struct OutputConfiguration {
+  std::string name;                      ///< the name of the configuration, in the report
+  int         writers_per_node = 0;      ///< see StateManager::setRestartWritersPerNode()
+  bool        async            = false;  ///< see StateManager::enableAsyncSaves()
+  bool        incremental      = false;  ///< see StateManager::enableIncrementalSaves()
+  int         lossless_level   = 0;      ///< see OutputCompression::lossless_level
+};
+
+/// the configurations that are benchmarked
+const std::vector<OutputConfiguration> configurations = {
+    {.name = "file per rank"},
+    {.name = "aggregated", .writers_per_node = 1},
+    {.name = "asynchronous", .async = true},
+    {.name = "incremental", .incremental = true},
+    {.name = "compressed", .lossless_level = 4}};
+
+/// the number of files (and directories) in a directory, and their total size
+struct DirectoryUsage {
+  long   entries = 0;    ///< the number of files and directories, recursively
+  double bytes   = 0.0;  ///< the total size of the files
+};
+
+/// @brief The usage of a directory (shared by every rank), as seen by rank 0
+DirectoryUsage usage(const std::string& directory)
+{
+  DirectoryUsage result;
+
+  int rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  if (rank == 0 && std::filesystem::exists(directory)) {
+    for (auto& entry : std::filesystem::recursive_directory_iterator(directory)) {
+      result.entries++;
+      if (entry.is_regular_file()) {
+        result.bytes += double(entry.file_size());
+      }
+    }
+  }
+
+  MPI_Bcast(&result.entries, 1, MPI_LONG, 0, MPI_COMM_WORLD);
+  MPI_Bcast(&result.bytes, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+  return result;
+}
+
+/// the cost of one kind of output operation, accumulated over its repetitions
+struct Measurement {
+  std::string operation;          ///< the name of the operation
+  int         repetitions = 0;    ///< the number of times it was done
+  double      seconds     = 0.0;  ///< the time of the slowest rank, including any background writes
+  double      blocked     = 0.0;  ///< the time of the slowest rank until the operation returned
+  double      bytes       = 0.0;  ///< the size of the files written (or read)
+  long        creates     = 0;    ///< the number of files and directories created
+};
+
+/// the measurements of one configuration on one mesh
+struct Run {
+  long                     elements;       ///< the number of elements of the mesh
+  std::string              configuration;  ///< the name of the output configuration
+  std::vector<Measurement> measurements;   ///< the measurement of each operation
+};
+
+/**
+ * @brief Does an output operation in a Caliper region, and adds its cost to a measurement
+ *
+ * @param measurement the measurement of this kind of operation
+ * @param directory the directory the operation writes to
+ * @param operation does the operation
+ * @param wait waits for any part of the operation that is done in the background
+ */
+void measure(Measurement& measurement, const std::string& directory, const std::function<void()>& operation,
+             const std::function<void()>& wait = [] {})
+{
+  DirectoryUsage before = usage(directory);
+
+  MPI_Barrier(MPI_COMM_WORLD);
+  SERAC_MARK_BEGIN(measurement.operation.c_str());
+  double start = MPI_Wtime();
+  operation();
+  double blocked = MPI_Wtime() - start;
+  wait();
+  double elapsed = MPI_Wtime() - start;
+  SERAC_MARK_END(measurement.operation.c_str());
+
+  double times[2] = {elapsed, blocked};
+  MPI_Allreduce(MPI_IN_PLACE, times, 2, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+
+  DirectoryUsage after = usage(directory);
+  measurement.repetitions++;
+  measurement.seconds += times[0];
+  measurement.blocked += times[1];
+  measurement.bytes += after.bytes - before.bytes;
+  measurement.creates += after.entries - before.entries;
+}
+
+/// @brief Empties (or creates) a directory, on rank 0
+void clearDirectory(const std::string& directory)
+{
+  int rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  if (rank == 0) {
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+  }
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
+/**
+ * @brief Writes the output of a beam in bending, in one configuration: a restart file every step, then the ParaView
+ * and summary files, and finally restarts from the last restart file
+ */
+template <int p>
+Run output_benchmark(const benchmarks::BenchmarkOptions& options, const OutputConfiguration& configuration)
+{
+  constexpr int dim = 3;
+
+  const std::string directory = axom::fmt::format("io_benchmark/{}_refinement_{}", configuration.name,
+                                                  options.parallel_refinement);
+  clearDirectory(directory);
+
+  Run run{0, configuration.name, {{"save"}, {"ParaView output"}, {"summary output"}, {"restart"}}};
+  Measurement& save     = run.measurements[0];
+  Measurement& paraview = run.measurements[1];
+  Measurement& summary  = run.measurements[2];
+  Measurement& restart  = run.measurements[3];
+
+  axom::sidre::DataStore datastore;
+  serac::StateManager::initialize(datastore, directory);
+  serac::StateManager::setRestartWritersPerNode(configuration.writers_per_node);
+  serac::StateManager::enableAsyncSaves(configuration.async);
+  serac::StateManager::enableIncrementalSaves(configuration.incremental);
+  serac::StateManager::setOutputCompression({.lossless_level = configuration.lossless_level});
+
+  auto mesh    = benchmarks::buildBenchmarkBeam(options);
+  run.elements = static_cast<long>(mesh->GetGlobalNE());
+  serac::StateManager::setMesh(std::move(mesh));
+
+  {
+    SolidMechanics<p, dim> solid_solver(solid_mechanics::default_nonlinear_options,
+                                        solid_mechanics::default_linear_options,
+                                        solid_mechanics::default_quasistatic_options, GeometricNonlinearities::On,
+                                        "io_benchmark");
+    solid_mechanics::J2 material{.E = 100.0, .nu = 0.25, .Hi = 1.0, .Hk = 0.1, .sigma_y = 1.0, .density = 1.0};
+    solid_solver.setMaterial(material, solid_solver.createQuadratureDataBuffer(solid_mechanics::J2::State{}));
+
+    // only the ParaView files are written by outputState()
+    solid_solver.setOutputPolicy({.restart_cycle_interval = 0, .visualization_cycle_interval = 1});
+
+    const double dt = 1.0;
+    solid_solver.initializeSummary(datastore, dt * options.steps, dt);
+
+    // the displacement changes every step, so that every restart file (including incremental ones) holds new values
+    for (int step = 0; step < options.steps; step++) {
+      solid_solver.setDisplacement([step](const mfem::Vector& x, mfem::Vector& u) {
+        u    = 0.0;
+        u[2] = -1.0e-3 * (step + 1) * x[0] * x[0];
+      });
+      solid_solver.saveSummary(datastore, dt * (step + 1));
+
+      measure(
+          save, directory, [&]() { serac::StateManager::save(dt * (step + 1), step); },
+          [] { serac::StateManager::waitForPendingSaves(); });
+    }
+
+    const std::string paraview_directory = directory + "/paraview";
+    measure(paraview, directory, [&]() { solid_solver.outputState(paraview_directory); });
+
+    measure(summary, directory, [&]() { output::outputSummary(datastore, directory); });
+  }
+
+  const DirectoryUsage restart_files = usage(directory);
+  serac::StateManager::reset();
+
+  // the restart reads the files of every save since the last full one, which is at most all of them
+  axom::sidre::DataStore restart_datastore;
+  measure(restart, directory, [&]() {
+    serac::StateManager::initialize(restart_datastore, directory);
+    serac::StateManager::load(options.steps - 1);
+  });
+  restart.bytes = restart_files.bytes - paraview.bytes - summary.bytes;
+
+  serac::StateManager::reset();
+  serac::StateManager::setRestartWritersPerNode(0);
+  serac::StateManager::setOutputCompression({});
+
+  return run;
+}
+
+/// @brief Prints the cost of each operation, per repetition, of each run
+void report(const std::vector<Run>& runs)
+{
+  int num_ranks = 0;
+  MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+
+  std::string table = axom::fmt::format("\n{:>10} {:<16} {:<16} {:>12} {:>12} {:>14} {:>10}\n", "elements",
+                                        "configuration", "operation", "time (s)", "blocked (s)", "MB/s per rank",
+                                        "creates");
+  for (auto& run : runs) {
+    for (auto& m : run.measurements) {
+      double n         = double(m.repetitions);
+      double bandwidth = (m.seconds > 0.0) ? 1.0e-6 * m.bytes / m.seconds / num_ranks : 0.0;
+      table += axom::fmt::format("{:>10} {:<16} {:<16} {:>12.4e} {:>12.4e} {:>14.2f} {:>10.1f}\n", run.elements,
+                                 run.configuration, m.operation, m.seconds / n, m.blocked / n, bandwidth,
+                                 double(m.creates) / n);
+    }
+  }
+
+  SLIC_INFO_ROOT(table);
+}
+
+int main(int argc, char* argv[])
+{
+  // the asynchronous saves write in a background thread that uses MPI
+  int provided = 0;
+  MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &provided);
+
+  axom::slic::SimpleLogger logger;
+
+  auto options = benchmarks::parseBenchmarkOptions(argc, argv, "Output benchmarks");
+
+  // Initialize profiling
+  serac::profiling::initialize(MPI_COMM_WORLD, options.caliper_config);
+
+  std::vector<Run> runs;
+  for (int refinement = 0; refinement <= options.parallel_refinement; refinement++) {
+    auto run_options                = options;
+    run_options.parallel_refinement = refinement;
+
+    for (auto& configuration : configurations) {
+      std::string region = axom::fmt::format("{} (refinement {})", configuration.name, refinement);
+      SERAC_MARK_BEGIN(region.c_str());
+      runs.push_back((options.order == 1) ? output_benchmark<1>(run_options, configuration)
+                                          : output_benchmark<2>(run_options, configuration));
+      SERAC_MARK_END(region.c_str());
+    }
+  }
+
+  report(runs);
+
+  // Finalize profiling
+  serac::profiling::finalize();
+
+  MPI_Finalize();
+
+  return 0;
+}
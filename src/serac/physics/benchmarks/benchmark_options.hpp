@@ -0,0 +1,116 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file benchmark_options.hpp
+ *
+ * @brief The command line options shared by the physics benchmark drivers
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "axom/CLI11.hpp"
+#include "mfem.hpp"
+
+#include "serac/infrastructure/logger.hpp"
+#include "serac/infrastructure/profiling.hpp"
+#include "serac/infrastructure/terminator.hpp"
+#include "serac/mesh/mesh_utils_base.hpp"
+
+namespace serac::benchmarks {
+
+/// @brief the problem size and discretization of a benchmark run (the rank count is that of MPI_COMM_WORLD)
+struct BenchmarkOptions {
+  int elements            = 4;  ///< the number of elements through the thickness of the benchmark beams
+  int order               = 1;  ///< the polynomial order of the finite element spaces
+  int serial_refinement   = 0;  ///< the number of uniform refinements of the serial mesh
+  int parallel_refinement = 0;  ///< the number of uniform refinements of the distributed mesh
+  int steps               = 4;  ///< the number of time steps (or load steps, for quasi-static problems)
+
+  /// additional Caliper configurations, e.g. `spot(output=run.cali)` to name the output of a scaling run
+  std::string caliper_config = "";
+};
+
+/**
+ * @brief Parses the benchmark options from the command line, exiting after printing a help message if asked to
+ *
+ * @param argc the number of command line arguments
+ * @param argv the command line arguments
+ * @param description a description of the benchmark, for the help message
+ */
+inline BenchmarkOptions parseBenchmarkOptions(int argc, char* argv[], const std::string& description)
+{
+  BenchmarkOptions options;
+
+  axom::CLI::App app{description};
+  app.add_option("-e, --elements", options.elements, "Number of elements through the thickness of the beam")
+      ->check(axom::CLI::PositiveNumber);
+  app.add_option("-p, --order", options.order, "Polynomial order of the finite element spaces (1 or 2)")
+      ->check(axom::CLI::Range(1, 2));
+  app.add_option("-s, --serial-refinement", options.serial_refinement, "Number of serial mesh refinements")
+      ->check(axom::CLI::NonNegativeNumber);
+  app.add_option("-r, --parallel-refinement", options.parallel_refinement, "Number of parallel mesh refinements")
+      ->check(axom::CLI::NonNegativeNumber);
+  app.add_option("-t, --steps", options.steps, "Number of time (or load) steps")->check(axom::CLI::PositiveNumber);
+  app.add_option("-c, --caliper", options.caliper_config, "Additional Caliper configurations");
+
+  try {
+    app.parse(argc, argv);
+  } catch (const axom::CLI::ParseError& e) {
+    serac::logger::flush();
+    if (e.get_name() == "CallForHelp") {
+      SLIC_INFO_ROOT(app.help());
+      serac::exitGracefully();
+    } else {
+      SLIC_ERROR_ROOT(axom::CLI::FailureMessage::simple(&app, e));
+    }
+  }
+
+  return options;
+}
+
+/**
+ * @brief Builds the distributed mesh of a beam, 4 times as long (along x) as it is thick, with the
+ * ends at x = 0 and x = 4 labelled by the boundary attributes 5 and 3
+ *
+ * The mesh is generated with buildParallelBoxMesh, so that setting up large runs of a scaling study
+ * does not require any rank to build (or partition) the whole mesh.
+ *
+ * @param options the size of the mesh
+ */
+inline std::unique_ptr<mfem::ParMesh> buildBenchmarkBeam(const BenchmarkOptions& options)
+{
+  const int             n = options.elements;
+  mesh::BoxInputOptions box{.elements = {4 * n, n, n}, .overall_size = {4.0, 1.0, 1.0}, .parallel_generation = true};
+  return mesh::buildParallelBoxMesh(box, options.serial_refinement, options.parallel_refinement);
+}
+
+/**
+ * @brief Records the benchmark's configuration as Adiak metadata, so that runs can be grouped by it
+ *
+ * @param name the name of the benchmark
+ * @param options the configuration of the run
+ * @param mesh the distributed mesh the benchmark runs on
+ */
+inline void setBenchmarkMetadata([[maybe_unused]] const std::string&      name,
+                                 [[maybe_unused]] const BenchmarkOptions& options, mfem::ParMesh& mesh)
+{
+  int num_ranks = 0;
+  MPI_Comm_size(mesh.GetComm(), &num_ranks);
+
+  SERAC_SET_METADATA("benchmark", name);
+  SERAC_SET_METADATA("order", options.order);
+  SERAC_SET_METADATA("elements", static_cast<long>(mesh.GetGlobalNE()));
+  SERAC_SET_METADATA("serial_refinement", options.serial_refinement);
+  SERAC_SET_METADATA("parallel_refinement", options.parallel_refinement);
+  SERAC_SET_METADATA("steps", options.steps);
+  SERAC_SET_METADATA("num_ranks", num_ranks);
+}
+
+}  // namespace serac::benchmarks
@@ -0,0 +1,227 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file benchmark_setup.cpp
+ *
+ * @brief Times the phases of setting up a solid mechanics problem, i.e. everything before its first solve, on a
+ * sequence of meshes (the benchmark beam refined 0, 1, ..., --parallel-refinement times)
+ *
+ * Each phase is a Caliper region, and the phases of a Functional's setup (the element restrictions, geometric
+ * factors, assembly lookup tables) and of the solvers (AMG) have their own regions inside the library as well.
+ * At the end, a table of the time of each phase on each mesh is printed, along with the exponent of its growth
+ * with the number of elements between consecutive meshes: a phase that scales linearly has an exponent of about 1,
+ * so larger exponents point at the setup components that grow superlinearly.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "axom/slic/core/SimpleLogger.hpp"
+#include "mfem.hpp"
+
+#include "serac/infrastructure/profiling.hpp"
+#include "serac/physics/benchmarks/benchmark_options.hpp"
+#include "serac/physics/materials/solid_material.hpp"
+#include "serac/physics/solid_mechanics.hpp"
+#include "serac/physics/state/state_manager.hpp"
+
+using namespace serac;
+
+/// the times of the setup phases on one mesh, in the order they run
+struct SetupTimes {
+  long                                        elements;  ///< the number of elements of the mesh
+  std::vector<std::pair<std::string, double>> phases;    ///< the name and time (in seconds) of each phase
+};
+
+/**
+ * @brief Runs one phase of the setup in a Caliper region, and records the time of the slowest rank
+ *
+ * @param times the times of the setup so far
+ * @param name the name of the phase (and its region)
+ * @param phase the work of the phase
+ */
+void timePhase(SetupTimes& times, const std::string& name, const std::function<void()>& phase)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+  SERAC_MARK_BEGIN(name.c_str());
+  double start = MPI_Wtime();
+  phase();
+  double elapsed = MPI_Wtime() - start;
+  SERAC_MARK_END(name.c_str());
+
+  MPI_Allreduce(MPI_IN_PLACE, &elapsed, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+  times.phases.emplace_back(name, elapsed);
+}
+
+/**
+ * @brief Sets up the residual of a linear elasticity problem with Functional, and a preconditioner for its
+ * Jacobian, one phase at a time, and then the same problem with SolidMechanics
+ */
+template <int p>
+SetupTimes setup_phases(const benchmarks::BenchmarkOptions& options)
+{
+  constexpr int dim = 3;
+  using space       = H1<p, dim>;
+
+  SetupTimes times;
+
+  std::unique_ptr<mfem::ParMesh> mesh;
+  timePhase(times, "mesh", [&]() { mesh = benchmarks::buildBenchmarkBeam(options); });
+  times.elements = static_cast<long>(mesh->GetGlobalNE());
+
+  timePhase(times, "face neighbor data", [&]() { mesh->ExchangeFaceNbrData(); });
+
+  std::pair<std::unique_ptr<mfem::ParFiniteElementSpace>, std::unique_ptr<mfem::FiniteElementCollection>> fes;
+  timePhase(times, "finite element space", [&]() { fes = generateParFiniteElementSpace<space>(mesh.get()); });
+
+  // the element restrictions of the test and trial spaces
+  std::unique_ptr<Functional<space(space)>> residual;
+  timePhase(times, "Functional construction", [&]() {
+    residual = std::make_unique<Functional<space(space)>>(
+        fes.first.get(), std::array<const mfem::ParFiniteElementSpace*, 1>{fes.first.get()});
+  });
+
+  // the geometric factors of the elements (and boundary elements)
+  timePhase(times, "domain integral", [&]() {
+    residual->AddDomainIntegral(
+        Dimension<dim>{}, DependsOn<0>{},
+        [](auto /*x*/, auto displacement) {
+          auto [u, du_dX] = displacement;
+          auto stress     = tr(du_dX) * DenseIdentity<dim>() + du_dX + transpose(du_dX);
+          return serac::tuple{zero{}, stress};
+        },
+        *mesh);
+  });
+
+  timePhase(times, "boundary integral", [&]() {
+    residual->AddBoundaryIntegral(
+        Dimension<dim - 1>{}, DependsOn<0>{},
+        [](auto /*x*/, auto /*n*/, auto displacement) { return 1.0e-3 * get<VALUE>(displacement); }, *mesh);
+  });
+
+  mfem::Vector U(fes.first->GetTrueVSize());
+  U = 0.0;
+
+  // the first assembly also builds the lookup tables that map the element matrices into the sparse matrix
+  std::unique_ptr<mfem::HypreParMatrix> K;
+  timePhase(times, "first assembly", [&]() {
+    auto [r, dR] = (*residual)(differentiate_wrt(U));
+    K            = assemble(dR);
+  });
+
+  timePhase(times, "reassembly", [&]() {
+    auto [r, dR] = (*residual)(differentiate_wrt(U));
+    assemble(dR, K);
+  });
+
+  // hypre sets up the hierarchy the first time the preconditioner is applied
+  timePhase(times, "AMG setup", [&]() {
+    mfem::HypreBoomerAMG amg;
+    amg.SetPrintLevel(0);
+    amg.SetSystemsOptions(dim);
+    amg.SetOperator(*K);
+
+    mfem::Vector b(K->Height()), x(K->Height());
+    b = 1.0;
+    x = 0.0;
+    amg.Mult(b, x);
+  });
+
+  // the same problem through the physics module, whose setup includes the first Jacobian assembly
+  axom::sidre::DataStore datastore;
+  serac::StateManager::initialize(datastore, "setup_benchmark");
+  serac::StateManager::setMesh(benchmarks::buildBenchmarkBeam(options));
+
+  std::unique_ptr<SolidMechanics<p, dim>> solid_solver;
+  timePhase(times, "SolidMechanics construction", [&]() {
+    solid_solver = std::make_unique<SolidMechanics<p, dim>>(
+        solid_mechanics::default_nonlinear_options, solid_mechanics::default_linear_options,
+        solid_mechanics::default_quasistatic_options, GeometricNonlinearities::On, "setup_benchmark");
+  });
+
+  timePhase(times, "SolidMechanics::setMaterial", [&]() {
+    solid_solver->setMaterial(solid_mechanics::NeoHookean{.density = 1.0, .K = 1.0, .G = 0.25});
+  });
+
+  auto zero_displacement = [](const mfem::Vector&, mfem::Vector& u) -> void { u = 0.0; };
+  solid_solver->setDisplacementBCs(std::set<int>{5}, zero_displacement);
+  solid_solver->setDisplacement(zero_displacement);
+
+  timePhase(times, "SolidMechanics::completeSetup", [&]() { solid_solver->completeSetup(); });
+
+  solid_solver.reset();
+  serac::StateManager::reset();
+
+  return times;
+}
+
+/**
+ * @brief Prints the time of each phase on each mesh, and the exponent of its growth with the number of elements
+ * from one mesh to the next (1 is linear)
+ */
+void report(const std::vector<SetupTimes>& runs)
+{
+  std::string table = axom::fmt::format("\n{:<32}", "phase \\ elements");
+  for (auto& run : runs) {
+    table += axom::fmt::format("{:>14}", run.elements);
+  }
+  table += axom::fmt::format("{:>14}\n", "max exponent");
+
+  for (std::size_t i = 0; i < runs.front().phases.size(); i++) {
+    table += axom::fmt::format("{:<32}", runs.front().phases[i].first);
+    double max_exponent = 0.0;
+    for (std::size_t j = 0; j < runs.size(); j++) {
+      table += axom::fmt::format("{:>14.4e}", runs[j].phases[i].second);
+      if (j > 0 && runs[j - 1].phases[i].second > 0.0) {
+        double time_ratio     = runs[j].phases[i].second / runs[j - 1].phases[i].second;
+        double elements_ratio = double(runs[j].elements) / double(runs[j - 1].elements);
+        max_exponent          = std::max(max_exponent, std::log(time_ratio) / std::log(elements_ratio));
+      }
+    }
+    table += (runs.size() > 1) ? axom::fmt::format("{:>14.2f}\n", max_exponent) : axom::fmt::format("{:>14}\n", "-");
+  }
+
+  SLIC_INFO_ROOT(table);
+}
+
+int main(int argc, char* argv[])
+{
+  MPI_Init(&argc, &argv);
+
+  axom::slic::SimpleLogger logger;
+
+  auto options = benchmarks::parseBenchmarkOptions(argc, argv, "Setup phase benchmarks");
+
+  // Initialize profiling
+  serac::profiling::initialize(MPI_COMM_WORLD, options.caliper_config);
+
+  // the mesh is refined one more time for each run, so each one has 8 times as many elements as the last
+  std::vector<SetupTimes> runs;
+  for (int refinement = 0; refinement <= options.parallel_refinement; refinement++) {
+    auto run_options                = options;
+    run_options.parallel_refinement = refinement;
+
+    std::string region = axom::fmt::format("Setup (refinement {})", refinement);
+    SERAC_MARK_BEGIN(region.c_str());
+    runs.push_back((options.order == 1) ? setup_phases<1>(run_options) : setup_phases<2>(run_options));
+    SERAC_MARK_END(region.c_str());
+  }
+
+  report(runs);
+
+  // Finalize profiling
+  serac::profiling::finalize();
+
+  MPI_Finalize();
+
+  return 0;
+}
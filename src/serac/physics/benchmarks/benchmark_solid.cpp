@@ -0,0 +1,222 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include <set>
+
+#include "axom/slic/core/SimpleLogger.hpp"
+#include "mfem.hpp"
+
+#include "serac/infrastructure/memory.hpp"
+#include "serac/infrastructure/profiling.hpp"
+#include "serac/physics/benchmarks/benchmark_options.hpp"
+#include "serac/physics/materials/solid_material.hpp"
+#include "serac/physics/solid_mechanics.hpp"
+#include "serac/physics/state/state_manager.hpp"
+
+using namespace serac;
+
+/// the clamped end of the benchmark beams, see benchmarks::buildBenchmarkBeam()
+const std::set<int> support = {5};
+
+/// A quasi-static bending problem: a cantilever beam of a NeoHookean material, with a load on its free end
+template <int p>
+void solid_static_neohookean(const benchmarks::BenchmarkOptions& options)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  constexpr int dim = 3;
+
+  // Create DataStore
+  axom::sidre::DataStore datastore;
+  serac::StateManager::initialize(datastore, "solid_static_neohookean");
+
+  auto mesh = benchmarks::buildBenchmarkBeam(options);
+  benchmarks::setBenchmarkMetadata("solid_static_neohookean", options, *mesh);
+  serac::StateManager::setMesh(std::move(mesh));
+
+  SERAC_MARK_BEGIN("Setup");
+  SolidMechanics<p, dim> solid_solver(solid_mechanics::default_nonlinear_options,
+                                      solid_mechanics::default_linear_options,
+                                      solid_mechanics::default_quasistatic_options, GeometricNonlinearities::On,
+                                      "solid_static_neohookean");
+
+  solid_mechanics::NeoHookean mat{.density = 1.0, .K = 1.0, .G = 0.25};
+  solid_solver.setMaterial(mat);
+
+  auto zero_displacement = [](const mfem::Vector&, mfem::Vector& u) -> void { u = 0.0; };
+  solid_solver.setDisplacementBCs(support, zero_displacement);
+  solid_solver.setDisplacement(zero_displacement);
+
+  // a downward traction on the free end of the beam, ramped up over the load steps
+  solid_solver.setPiolaTraction([](const auto& x, const tensor<double, dim>&, const double t) {
+    tensor<double, dim> traction{};
+    if (x[0] > 4.0 - 1.0e-8) {
+      traction[2] = -1.0e-2 * t;
+    }
+    return traction;
+  });
+
+  solid_solver.completeSetup();
+  SERAC_MARK_END("Setup");
+
+  SERAC_MARK_BEGIN("Solve");
+  double dt = 1.0 / options.steps;
+  for (int i = 0; i < options.steps; i++) {
+    solid_solver.advanceTimestep(dt);
+  }
+  SERAC_MARK_END("Solve");
+  memory::report("solid_static_neohookean.solve");
+
+  SERAC_MARK_BEGIN("I/O");
+  solid_solver.outputState();
+  SERAC_MARK_END("I/O");
+}
+
+/// A quasi-static loading problem with internal variables: a beam of a J2 material, stretched past yield
+template <int p>
+void solid_static_J2(const benchmarks::BenchmarkOptions& options)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  constexpr int dim = 3;
+
+  // Create DataStore
+  axom::sidre::DataStore datastore;
+  serac::StateManager::initialize(datastore, "solid_static_J2");
+
+  auto mesh = benchmarks::buildBenchmarkBeam(options);
+  benchmarks::setBenchmarkMetadata("solid_static_J2", options, *mesh);
+  serac::StateManager::setMesh(std::move(mesh));
+
+  SERAC_MARK_BEGIN("Setup");
+  SolidMechanics<p, dim> solid_solver(solid_mechanics::default_nonlinear_options,
+                                      solid_mechanics::default_linear_options,
+                                      solid_mechanics::default_quasistatic_options, GeometricNonlinearities::Off,
+                                      "solid_static_J2");
+
+  solid_mechanics::J2 mat{
+      10000,  // Young's modulus
+      0.25,   // Poisson's ratio
+      50.0,   // isotropic hardening constant
+      5.0,    // kinematic hardening constant
+      50.0,   // yield stress
+      1.0     // mass density
+  };
+
+  solid_mechanics::J2::State initial_state{};
+
+  auto state = solid_solver.createQuadratureDataBuffer(initial_state);
+  solid_solver.setMaterial(mat, state);
+
+  auto zero_displacement = [](const mfem::Vector&, mfem::Vector& u) -> void { u = 0.0; };
+  solid_solver.setDisplacementBCs(support, zero_displacement);
+  solid_solver.setDisplacement(zero_displacement);
+
+  // stretch the beam along its axis, to 4 times the yield strain
+  auto stretched = [](const mfem::Vector&, double t, mfem::Vector& u) -> void {
+    u    = 0.0;
+    u[0] = 4.0 * (4.0 * 50.0 / 10000) * t;
+  };
+  solid_solver.setDisplacementBCs({3}, stretched);
+
+  solid_solver.completeSetup();
+  SERAC_MARK_END("Setup");
+
+  SERAC_MARK_BEGIN("Solve");
+  double dt = 1.0 / options.steps;
+  for (int i = 0; i < options.steps; i++) {
+    solid_solver.advanceTimestep(dt);
+  }
+  SERAC_MARK_END("Solve");
+  memory::report("solid_static_J2.solve");
+
+  SERAC_MARK_BEGIN("I/O");
+  solid_solver.outputState();
+  SERAC_MARK_END("I/O");
+}
+
+/// An implicit dynamics problem: a NeoHookean cantilever beam, released with an initial velocity
+template <int p>
+void solid_dynamic_neohookean(const benchmarks::BenchmarkOptions& options)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  constexpr int dim = 3;
+
+  // Create DataStore
+  axom::sidre::DataStore datastore;
+  serac::StateManager::initialize(datastore, "solid_dynamic_neohookean");
+
+  auto mesh = benchmarks::buildBenchmarkBeam(options);
+  benchmarks::setBenchmarkMetadata("solid_dynamic_neohookean", options, *mesh);
+  serac::StateManager::setMesh(std::move(mesh));
+
+  SERAC_MARK_BEGIN("Setup");
+  SolidMechanics<p, dim> solid_solver(solid_mechanics::default_nonlinear_options,
+                                      solid_mechanics::default_linear_options,
+                                      solid_mechanics::default_timestepping_options, GeometricNonlinearities::On,
+                                      "solid_dynamic_neohookean");
+
+  solid_mechanics::NeoHookean mat{.density = 1.0, .K = 1.0, .G = 0.25};
+  solid_solver.setMaterial(mat);
+
+  auto zero_displacement = [](const mfem::Vector&, mfem::Vector& u) -> void { u = 0.0; };
+  solid_solver.setDisplacementBCs(support, zero_displacement);
+  solid_solver.setDisplacement(zero_displacement);
+
+  // a transverse velocity that grows along the beam
+  solid_solver.setVelocity([](const mfem::Vector& x, mfem::Vector& v) {
+    v    = 0.0;
+    v[2] = 1.0e-2 * x[0];
+  });
+
+  solid_solver.completeSetup();
+  SERAC_MARK_END("Setup");
+
+  SERAC_MARK_BEGIN("Solve");
+  double dt = 0.1;
+  for (int i = 0; i < options.steps; i++) {
+    solid_solver.advanceTimestep(dt);
+  }
+  SERAC_MARK_END("Solve");
+  memory::report("solid_dynamic_neohookean.solve");
+
+  SERAC_MARK_BEGIN("I/O");
+  solid_solver.outputState();
+  SERAC_MARK_END("I/O");
+}
+
+int main(int argc, char* argv[])
+{
+  MPI_Init(&argc, &argv);
+
+  axom::slic::SimpleLogger logger;
+
+  auto options = benchmarks::parseBenchmarkOptions(argc, argv, "Solid mechanics benchmarks");
+
+  // Initialize profiling
+  serac::profiling::initialize(MPI_COMM_WORLD, options.caliper_config);
+
+  // Profile code
+  SERAC_MARK_BEGIN("Static NeoHookean");
+  (options.order == 1) ? solid_static_neohookean<1>(options) : solid_static_neohookean<2>(options);
+  SERAC_MARK_END("Static NeoHookean");
+
+  SERAC_MARK_BEGIN("Static J2");
+  (options.order == 1) ? solid_static_J2<1>(options) : solid_static_J2<2>(options);
+  SERAC_MARK_END("Static J2");
+
+  SERAC_MARK_BEGIN("Dynamic NeoHookean");
+  (options.order == 1) ? solid_dynamic_neohookean<1>(options) : solid_dynamic_neohookean<2>(options);
+  SERAC_MARK_END("Dynamic NeoHookean");
+
+  // Finalize profiling
+  serac::profiling::finalize();
+
+  MPI_Finalize();
+
+  return 0;
+}
@@ -12,10 +12,12 @@
 #include "serac/serac_config.hpp"
 #include "serac/infrastructure/profiling.hpp"
 #include "serac/mesh/mesh_utils.hpp"
-#include "serac/physics/materials/thermal_functional_material.hpp"
+#include "serac/physics/materials/thermal_material.hpp"
 #include "serac/physics/state/state_manager.hpp"
 #include "serac/physics/heat_transfer.hpp"
 
+using namespace serac;
+
 template <int p, int dim>
 void functional_test_static()
 {
@@ -41,7 +43,8 @@ void functional_test_static()
   std::set<int> ess_bdr = {1};
 
   // Construct a functional-based thermal conduction solver
-  HeatTransfer<p, dim> thermal_solver(HeatTransfer<p, dim>::defaultQuasistaticOptions(), "thermal_functional");
+  HeatTransfer<p, dim> thermal_solver(heat_transfer::default_nonlinear_options, heat_transfer::default_linear_options,
+                                      heat_transfer::default_static_options, "thermal_functional");
 
   tensor<double, dim, dim> cond;
 
@@ -54,7 +57,7 @@ void functional_test_static()
     cond = {{{1.5, 0.01, 0.0}, {0.01, 1.0, 0.0}, {0.0, 0.0, 1.0}}};
   }
 
-  Thermal::LinearConductor<dim> mat(1.0, 1.0, cond);
+  heat_transfer::LinearConductor<dim> mat(1.0, 1.0, cond);
   thermal_solver.setMaterial(mat);
 
   // Define the function for the initial temperature and boundary condition
@@ -65,11 +68,11 @@ void functional_test_static()
   thermal_solver.setTemperature(one);
 
   // Define a constant source term
-  Thermal::ConstantSource source{1.0};
+  heat_transfer::ConstantSource source{1.0};
   thermal_solver.setSource(source);
 
   // Set the flux term to zero for testing code paths
-  Thermal::FluxBoundary flux_bc{0.0};
+  heat_transfer::ConstantFlux flux_bc{0.0};
   thermal_solver.setFluxBCs(flux_bc);
 
   // Finalize the data structures
@@ -108,10 +111,11 @@ void functional_test_dynamic()
   std::set<int> ess_bdr = {1};
 
   // Construct a functional-based thermal conduction solver
-  HeatTransfer<p, dim> thermal_solver(HeatTransfer<p, dim>::defaultDynamicOptions(), "thermal_functional");
+  HeatTransfer<p, dim> thermal_solver(heat_transfer::default_nonlinear_options, heat_transfer::default_linear_options,
+                                      heat_transfer::default_timestepping_options, "thermal_functional");
 
   // Define an isotropic conductor material model
-  Thermal::LinearIsotropicConductor mat(1.0, 1.0, 1.0);
+  heat_transfer::LinearIsotropicConductor mat(1.0, 1.0, 1.0);
 
   thermal_solver.setMaterial(mat);
 
@@ -128,11 +132,11 @@ void functional_test_dynamic()
   thermal_solver.setTemperature(initial_temp);
 
   // Define a constant source term
-  Thermal::ConstantSource source{1.0};
+  heat_transfer::ConstantSource source{1.0};
   thermal_solver.setSource(source);
 
   // Set the flux term to zero for testing code paths
-  Thermal::FluxBoundary flux_bc{0.0};
+  heat_transfer::ConstantFlux flux_bc{0.0};
   thermal_solver.setFluxBCs(flux_bc);
 
   // Finalize the data structures
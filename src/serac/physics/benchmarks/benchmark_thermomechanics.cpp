@@ -0,0 +1,112 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include <set>
+
+#include "axom/slic/core/SimpleLogger.hpp"
+#include "mfem.hpp"
+
+#include "serac/infrastructure/memory.hpp"
+#include "serac/infrastructure/profiling.hpp"
+#include "serac/physics/benchmarks/benchmark_options.hpp"
+#include "serac/physics/materials/green_saint_venant_thermoelastic.hpp"
+#include "serac/physics/materials/solid_material.hpp"
+#include "serac/physics/materials/thermal_material.hpp"
+#include "serac/physics/state/state_manager.hpp"
+#include "serac/physics/thermomechanics.hpp"
+
+using namespace serac;
+
+/// A quasi-static thermal expansion problem: a clamped beam, heated from its free end
+template <int p>
+void thermomechanics_static(const benchmarks::BenchmarkOptions& options)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  constexpr int dim = 3;
+
+  // Create DataStore
+  axom::sidre::DataStore datastore;
+  serac::StateManager::initialize(datastore, "thermomechanics_static");
+
+  auto mesh = benchmarks::buildBenchmarkBeam(options);
+  benchmarks::setBenchmarkMetadata("thermomechanics_static", options, *mesh);
+  serac::StateManager::setMesh(std::move(mesh));
+
+  // the ends of the benchmark beam, see benchmarks::buildBenchmarkBeam()
+  std::set<int> clamped_end = {5};
+  std::set<int> heated_end  = {3};
+
+  SERAC_MARK_BEGIN("Setup");
+  Thermomechanics<p, dim> thermal_solid_solver(
+      heat_transfer::default_nonlinear_options, heat_transfer::default_linear_options,
+      heat_transfer::default_static_options, solid_mechanics::default_nonlinear_options,
+      solid_mechanics::default_linear_options, solid_mechanics::default_quasistatic_options,
+      GeometricNonlinearities::On, "thermomechanics_static");
+
+  double rho       = 1.0;
+  double E         = 1.0;
+  double nu        = 0.25;
+  double c         = 1.0;
+  double alpha     = 1.0e-3;
+  double theta_ref = 1.0;
+  double k         = 1.0;
+
+  GreenSaintVenantThermoelasticMaterial        material{rho, E, nu, c, alpha, theta_ref, k};
+  GreenSaintVenantThermoelasticMaterial::State initial_state{};
+  auto                                         qdata = thermal_solid_solver.createQuadratureDataBuffer(initial_state);
+  thermal_solid_solver.setMaterial(material, qdata);
+
+  // hold the clamped end at the reference temperature, and ramp up the temperature of the free end
+  auto reference = [=](const mfem::Vector&, double) -> double { return theta_ref; };
+  auto heated    = [=](const mfem::Vector&, double t) -> double { return theta_ref + 10.0 * t; };
+  thermal_solid_solver.setTemperatureBCs(clamped_end, reference);
+  thermal_solid_solver.setTemperatureBCs(heated_end, heated);
+  thermal_solid_solver.setTemperature(reference);
+
+  auto zero_displacement = [](const mfem::Vector&, mfem::Vector& u) -> void { u = 0.0; };
+  thermal_solid_solver.setDisplacementBCs(clamped_end, zero_displacement);
+  thermal_solid_solver.setDisplacement(zero_displacement);
+
+  thermal_solid_solver.completeSetup();
+  SERAC_MARK_END("Setup");
+
+  SERAC_MARK_BEGIN("Solve");
+  double dt = 1.0 / options.steps;
+  for (int i = 0; i < options.steps; i++) {
+    thermal_solid_solver.advanceTimestep(dt);
+  }
+  SERAC_MARK_END("Solve");
+  memory::report("thermomechanics_static.solve");
+
+  SERAC_MARK_BEGIN("I/O");
+  thermal_solid_solver.outputState();
+  SERAC_MARK_END("I/O");
+}
+
+int main(int argc, char* argv[])
+{
+  MPI_Init(&argc, &argv);
+
+  axom::slic::SimpleLogger logger;
+
+  auto options = benchmarks::parseBenchmarkOptions(argc, argv, "Thermomechanics benchmarks");
+
+  // Initialize profiling
+  serac::profiling::initialize(MPI_COMM_WORLD, options.caliper_config);
+
+  // Profile code
+  SERAC_MARK_BEGIN("Static Thermomechanics");
+  (options.order == 1) ? thermomechanics_static<1>(options) : thermomechanics_static<2>(options);
+  SERAC_MARK_END("Static Thermomechanics");
+
+  // Finalize profiling
+  serac::profiling::finalize();
+
+  MPI_Finalize();
+
+  return 0;
+}
@@ -42,71 +42,182 @@ void BoundaryCondition::setTrueDofList(const mfem::Array<int>& true_dofs)
 {
   true_dofs_ = true_dofs;
   space_.GetRestrictionMatrix()->BooleanMultTranspose(true_dofs_, local_dofs_);
+  node_coordinates_.reset();
 }
 
 void BoundaryCondition::setLocalDofList(const mfem::Array<int>& local_dofs)
 {
   local_dofs_ = local_dofs;
   space_.GetRestrictionMatrix()->BooleanMult(local_dofs_, true_dofs_);
+  node_coordinates_.reset();
 }
 
 void BoundaryCondition::setDofListsFromMarkers()
 {
-  auto& mutable_space = const_cast<mfem::ParFiniteElementSpace&>(space_);
-
+  // the local DOFs are marked (and synchronized across the ranks) with a single pass over the boundary elements,
+  // and the true DOFs restricted from them, instead of marking them again for GetEssentialTrueDofs()
+  mfem::Array<int> dof_markers;
   if (component_) {
-    mfem::Array<int> dof_markers;
-
-    mutable_space.GetEssentialTrueDofs(markers_, true_dofs_, *component_);
     space_.GetEssentialVDofs(markers_, dof_markers, *component_);
-
-    // The VDof call actually returns a marker array, so we need to transform it to a list of indices
-    space_.MarkerToList(dof_markers, local_dofs_);
-
   } else {
-    mfem::Array<int> dof_markers;
-
-    mutable_space.GetEssentialTrueDofs(markers_, true_dofs_);
     space_.GetEssentialVDofs(markers_, dof_markers);
-
-    // The VDof call actually returns a marker array, so we need to transform it to a list of indices
-    space_.MarkerToList(dof_markers, local_dofs_);
   }
+
+  // The VDof call actually returns a marker array, so we need to transform it to a list of indices
+  space_.MarkerToList(dof_markers, local_dofs_);
+
+  mfem::Array<int> true_dof_markers;
+  space_.GetRestrictionMatrix()->BooleanMult(dof_markers, true_dof_markers);
+  space_.MarkerToList(true_dof_markers, true_dofs_);
+  node_coordinates_.reset();
 }
 
-void BoundaryCondition::setDofs(mfem::Vector& vector, const double time) const
+void BoundaryCondition::projectCoefficient(mfem::Vector& vector, const double time) const
 {
   SLIC_ERROR_IF(space_.GetTrueVSize() != vector.Size(),
                 "State to project and boundary condition space are not compatible.");
 
   FiniteElementState state(space_);
 
-  // Generate the scalar dof list from the vector dof list
-  mfem::Array<int> dof_list(local_dofs_.Size());
-  std::transform(local_dofs_.begin(), local_dofs_.end(), dof_list.begin(),
-                 [&space = space_](int ldof) { return space.VDofToDof(ldof); });
+  if (!projectBatched(state, time)) {
+    // Generate the scalar dof list from the vector dof list
+    mfem::Array<int> dof_list(local_dofs_.Size());
+    std::transform(local_dofs_.begin(), local_dofs_.end(), dof_list.begin(),
+                   [&space = space_](int ldof) { return space.VDofToDof(ldof); });
+
+    // the only reason to store a VectorCoefficient is to act on all components
+    if (is_vector_valued(coef_)) {
+      auto vec_coef = get<std::shared_ptr<mfem::VectorCoefficient>>(coef_);
+      vec_coef->SetTime(time);
+      state.project(*vec_coef, dof_list);
+    } else {
+      // an mfem::Coefficient could be used to describe a scalar-valued function, or
+      // a single component of a vector-valued function
+      auto scalar_coef = get<std::shared_ptr<mfem::Coefficient>>(coef_);
+      scalar_coef->SetTime(time);
+      if (component_) {
+        state.project(*scalar_coef, dof_list, *component_);
+
+      } else {
+        state.projectOnBoundary(*scalar_coef, markers_);
+      }
+    }
+  }
+
+  for (int i : true_dofs_) {
+    vector(i) = state(i);
+  }
+}
 
-  // the only reason to store a VectorCoefficient is to act on all components
+bool BoundaryCondition::projectBatched(FiniteElementState& state, const double time) const
+{
+  BatchedVectorCoefficient* vec_coef    = nullptr;
+  BatchedCoefficient*       scalar_coef = nullptr;
   if (is_vector_valued(coef_)) {
-    auto vec_coef = get<std::shared_ptr<mfem::VectorCoefficient>>(coef_);
+    vec_coef = dynamic_cast<BatchedVectorCoefficient*>(get<std::shared_ptr<mfem::VectorCoefficient>>(coef_).get());
+  } else {
+    scalar_coef = dynamic_cast<BatchedCoefficient*>(get<std::shared_ptr<mfem::Coefficient>>(coef_).get());
+  }
+
+  if ((!vec_coef && !scalar_coef) || !hasNodalDofs(space_)) {
+    return false;
+  }
+
+  // the coordinates of the nodes are the same every time the BC is applied
+  if (!node_coordinates_) {
+    nodes_.SetSize(local_dofs_.Size());
+    std::transform(local_dofs_.begin(), local_dofs_.end(), nodes_.begin(),
+                   [&space = space_](int ldof) { return space.VDofToDof(ldof); });
+    nodes_.Sort();
+    nodes_.Unique();
+    node_coordinates_ = nodeCoordinates(space_, nodes_);
+  }
+
+  mfem::ParGridFunction& grid_function = state.gridFunction();
+  if (vec_coef) {
     vec_coef->SetTime(time);
-    state.project(*vec_coef, dof_list);
+    projectAtNodes(*vec_coef, nodes_, *node_coordinates_, grid_function);
   } else {
-    // an mfem::Coefficient could be used to describe a scalar-valued function, or
-    // a single component of a vector-valued function
-    auto scalar_coef = get<std::shared_ptr<mfem::Coefficient>>(coef_);
     scalar_coef->SetTime(time);
-    if (component_) {
-      state.project(*scalar_coef, dof_list, *component_);
+    projectAtNodes(*scalar_coef, nodes_, *node_coordinates_, grid_function, component_);
+  }
+  state.setFromGridFunction(grid_function);
+  return true;
+}
 
-    } else {
-      state.projectOnBoundary(*scalar_coef, markers_);
-    }
+void BoundaryCondition::setDofs(mfem::Vector& vector, const double time) const
+{
+  if (!scale_) {
+    projectCoefficient(vector, time);
+    return;
   }
 
-  for (int i : true_dofs_) {
-    vector(i) = state(i);
+  SLIC_ERROR_IF(space_.GetTrueVSize() != vector.Size(),
+                "State to project and boundary condition space are not compatible.");
+
+  const auto&  values = profile();
+  const double scale  = scale_(time);
+  for (int i = 0; i < true_dofs_.Size(); i++) {
+    vector(true_dofs_[i]) = scale * values(i);
+  }
+}
+
+void BoundaryCondition::setTimeScaling(std::function<double(double)> scale, std::function<double(double)> scale_rate,
+                                       std::function<double(double)> scale_accel)
+{
+  SLIC_ERROR_ROOT_IF(!scale, "A time-separable boundary condition requires a scaling function");
+  scale_         = std::move(scale);
+  scale_rate_    = std::move(scale_rate);
+  scale_accel_   = std::move(scale_accel);
+  profile_valid_ = false;
+}
+
+void BoundaryCondition::setDofDerivatives(mfem::Vector& vector, const double time, const int order) const
+{
+  SLIC_ERROR_ROOT_IF(!scale_, "Only the derivatives of time-separable boundary conditions can be evaluated directly");
+  SLIC_ERROR_IF(space_.GetTrueVSize() != vector.Size(),
+                "State to project and boundary condition space are not compatible.");
+
+  const auto&  values = profile();
+  const double scale  = timeScaling(time, order);
+  for (int i = 0; i < true_dofs_.Size(); i++) {
+    vector(true_dofs_[i]) = scale * values(i);
+  }
+}
+
+double BoundaryCondition::timeScaling(const double time, const int order) const
+{
+  // the step for the finite difference approximations, only used
+  // when the derivatives of the scaling function were not given
+  constexpr double h = 1.0e-4;
+
+  switch (order) {
+    case 0:
+      return scale_(time);
+    case 1:
+      return scale_rate_ ? scale_rate_(time) : (scale_(time + h) - scale_(time - h)) / (2.0 * h);
+    case 2:
+      return scale_accel_ ? scale_accel_(time) : (scale_(time + h) - 2.0 * scale_(time) + scale_(time - h)) / (h * h);
+    default:
+      SLIC_ERROR_ROOT("Only the first and second time derivatives of a boundary condition are supported");
+      return 0.0;
+  }
+}
+
+const mfem::Vector& BoundaryCondition::profile() const
+{
+  if (!profile_valid_) {
+    mfem::Vector projected(space_.GetTrueVSize());
+    projected = 0.0;
+    projectCoefficient(projected, 0.0);
+
+    profile_.SetSize(true_dofs_.Size());
+    for (int i = 0; i < true_dofs_.Size(); i++) {
+      profile_(i) = projected(true_dofs_[i]);
+    }
+    profile_valid_ = true;
   }
+  return profile_;
 }
 
 void BoundaryCondition::apply(mfem::HypreParMatrix& k_mat, mfem::Vector& rhs, mfem::Vector& state) const
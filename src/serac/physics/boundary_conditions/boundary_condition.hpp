@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <optional>
 #include <set>
@@ -20,6 +21,7 @@
 #include <utility>
 
 #include "serac/infrastructure/logger.hpp"
+#include "serac/physics/state/batched_coefficient.hpp"
 #include "serac/physics/state/finite_element_state.hpp"
 
 namespace serac {
@@ -156,6 +158,35 @@ public:
    */
   void setDofs(mfem::Vector& state, const double time = 0.0) const;
 
+  /**
+   * @brief Declares the boundary condition time-separable, i.e. U(x, t) = scale(t) * U(x)
+   *
+   * The coefficient then only describes the spatial profile U(x). It is projected once, the first time the DOFs are
+   * set, and every later call to setDofs or setDofDerivatives scales that projection instead of evaluating the
+   * coefficient again.
+   *
+   * @param[in] scale The scalar function of time multiplying the spatial profile
+   * @param[in] scale_rate The first time derivative of @a scale, approximated by central differences if empty
+   * @param[in] scale_accel The second time derivative of @a scale, approximated by central differences if empty
+   */
+  void setTimeScaling(std::function<double(double)> scale, std::function<double(double)> scale_rate = nullptr,
+                      std::function<double(double)> scale_accel = nullptr);
+
+  /**
+   * @brief Whether the boundary condition is time-separable
+   * @see setTimeScaling
+   */
+  bool timeSeparable() const { return static_cast<bool>(scale_); }
+
+  /**
+   * @brief Sets the DOFs constrained by a time-separable boundary condition to a time derivative of their values
+   * @param[inout] state The field to set the derivatives on
+   * @param[in] time The time at which to evaluate the derivative
+   * @param[in] order The order of the time derivative, 1 or 2
+   * @pre The boundary condition must be time-separable
+   */
+  void setDofDerivatives(mfem::Vector& state, const double time, const int order) const;
+
   /**
    * @brief Modify the system of equations \f$Ax=b\f$ by replacing equations that correspond to
    * essential boundary conditions with ones that prescribe the desired values. The rows of the matrix containing
@@ -210,6 +241,35 @@ private:
    */
   void setLocalDofList(const mfem::Array<int>& local_dofs);
 
+  /**
+   * @brief Projects the associated coefficient at a given time and copies the constrained DOFs into a vector
+   * @param[inout] vector The vector to set the constrained DOFs of
+   * @param[in] time The time at which to project the coefficient
+   */
+  void projectCoefficient(mfem::Vector& vector, const double time) const;
+
+  /**
+   * @brief Projects a batched coefficient (see BatchedCoefficient) onto the constrained nodes of a state, evaluating
+   * it once for all of them
+   * @param[inout] state The state to set the constrained DOFs of
+   * @param[in] time The time at which to project the coefficient
+   * @return Whether the coefficient was projected, i.e. it is batched and the space has nodal DOFs
+   */
+  bool projectBatched(FiniteElementState& state, const double time) const;
+
+  /**
+   * @brief Evaluates the time scaling function of a time-separable boundary condition, or one of its derivatives
+   * @param[in] time The time at which to evaluate the function
+   * @param[in] order The order of the time derivative, between 0 and 2
+   */
+  double timeScaling(const double time, const int order) const;
+
+  /**
+   * @brief Returns the spatial profile of a time-separable boundary condition on its true DOFs, projecting it first
+   * if it has not been already
+   */
+  const mfem::Vector& profile() const;
+
   /**
    * @brief A coefficient containing either a mfem::Coefficient or an mfem::VectorCoefficient
    */
@@ -238,6 +298,35 @@ private:
    */
   const mfem::ParFiniteElementSpace& space_;
 
+  /**
+   * @brief The scalar function of time multiplying the spatial profile of a time-separable BC (empty otherwise)
+   */
+  std::function<double(double)> scale_;
+  /**
+   * @brief The first time derivative of @a scale_, if it is known analytically
+   */
+  std::function<double(double)> scale_rate_;
+  /**
+   * @brief The second time derivative of @a scale_, if it is known analytically
+   */
+  std::function<double(double)> scale_accel_;
+  /**
+   * @brief The projected spatial profile of a time-separable BC, one entry per true DOF in @a true_dofs_
+   */
+  mutable mfem::Vector profile_;
+  /**
+   * @brief Whether @a profile_ has been projected
+   */
+  mutable bool profile_valid_ = false;
+  /**
+   * @brief The nodes (scalar local DOFs) of @a local_dofs_, each one once, for batched coefficients
+   */
+  mutable mfem::Array<int> nodes_;
+  /**
+   * @brief The coordinates of @a nodes_, found the first time a batched coefficient is projected
+   */
+  mutable std::optional<mfem::Vector> node_coordinates_;
+
   /**
    * @brief A label for the BC, for filtering purposes, in addition to its type hash
    * @note This should always correspond to an enum
@@ -8,13 +8,16 @@
 
 #include <algorithm>
 #include <iterator>
+#include <vector>
 
 #include "serac/infrastructure/logger.hpp"
 
 namespace serac {
 
-void BoundaryConditionManager::addEssential(const std::set<int>& ess_bdr, serac::GeneralCoefficient ess_bdr_coef,
-                                            mfem::ParFiniteElementSpace& space, const std::optional<int> component)
+BoundaryCondition& BoundaryConditionManager::addEssential(const std::set<int>&         ess_bdr,
+                                                          serac::GeneralCoefficient    ess_bdr_coef,
+                                                          mfem::ParFiniteElementSpace& space,
+                                                          const std::optional<int>     component)
 {
   std::set<int> filtered_attrs;
   std::set_difference(ess_bdr.begin(), ess_bdr.end(), attrs_in_use_.begin(), attrs_in_use_.end(),
@@ -27,14 +30,13 @@ void BoundaryConditionManager::addEssential(const std::set<int>& ess_bdr, serac:
 
   ess_bdr_.emplace_back(ess_bdr_coef, component, space, filtered_attrs);
   attrs_in_use_.insert(ess_bdr.begin(), ess_bdr.end());
-  all_dofs_valid_ = false;
+  return ess_bdr_.back();
 }
 
 void BoundaryConditionManager::addNatural(const std::set<int>& nat_bdr, serac::GeneralCoefficient nat_bdr_coef,
                                           mfem::ParFiniteElementSpace& space, const std::optional<int> component)
 {
   nat_bdr_.emplace_back(nat_bdr_coef, component, space, nat_bdr);
-  all_dofs_valid_ = false;
 }
 
 void BoundaryConditionManager::addEssentialTrueDofs(const mfem::Array<int>&      true_dofs,
@@ -42,21 +44,69 @@ void BoundaryConditionManager::addEssentialTrueDofs(const mfem::Array<int>&
                                                     mfem::ParFiniteElementSpace& space, std::optional<int> component)
 {
   ess_bdr_.emplace_back(ess_bdr_coef, component, space, true_dofs);
-  all_dofs_valid_ = false;
 }
 
-void BoundaryConditionManager::updateAllDofs() const
+void BoundaryConditionManager::setEssentialDofs(double time, double epsilon, mfem::Vector& U, mfem::Vector& dU_dt,
+                                                mfem::Vector* d2U_dt2) const
 {
-  all_true_dofs_.DeleteAll();
-  all_local_dofs_.DeleteAll();
+  U     = 0.0;
+  dU_dt = 0.0;
+  if (d2U_dt2) {
+    *d2U_dt2 = 0.0;
+  }
+
   for (const auto& bc : ess_bdr_) {
-    all_true_dofs_.Append(bc.getTrueDofList());
-    all_local_dofs_.Append(bc.getLocalDofList());
+    bc.setDofs(U, time);
+    if (bc.timeSeparable()) {
+      bc.setDofDerivatives(dU_dt, time, 1);
+      if (d2U_dt2) {
+        bc.setDofDerivatives(*d2U_dt2, time, 2);
+      }
+      continue;
+    }
+
+    U_minus_.SetSize(U.Size());
+    U_plus_.SetSize(U.Size());
+    bc.setDofs(U_minus_, time - epsilon);
+    bc.setDofs(U_plus_, time + epsilon);
+    for (int i : bc.getTrueDofList()) {
+      dU_dt[i] = (U_plus_[i] - U_minus_[i]) / (2.0 * epsilon);
+      if (d2U_dt2) {
+        (*d2U_dt2)[i] = (U_minus_[i] - 2.0 * U[i] + U_plus_[i]) / (epsilon * epsilon);
+      }
+    }
+  }
+}
+
+void BoundaryConditionManager::updateAllDofs() const
+{
+  if (!all_dofs_valid_ || merged_ess_bdr_ > ess_bdr_.size()) {
+    all_true_dofs_.DeleteAll();
+    all_local_dofs_.DeleteAll();
+    merged_ess_bdr_ = 0;
+  }
+
+  // merge the (sorted) DOFs of each new BC into the sorted lists, instead of sorting everything again
+  std::vector<int> sorted;
+  std::vector<int> merged;
+  auto             merge = [&sorted, &merged](mfem::Array<int>& all_dofs, const mfem::Array<int>& dofs) {
+    sorted.assign(dofs.begin(), dofs.end());
+    if (!std::is_sorted(sorted.begin(), sorted.end())) {
+      std::sort(sorted.begin(), sorted.end());
+    }
+    merged.clear();
+    merged.reserve(static_cast<std::size_t>(all_dofs.Size()) + sorted.size());
+    std::set_union(all_dofs.begin(), all_dofs.end(), sorted.begin(), sorted.end(), std::back_inserter(merged));
+    merged.erase(std::unique(merged.begin(), merged.end()), merged.end());
+    all_dofs.SetSize(static_cast<int>(merged.size()));
+    std::copy(merged.begin(), merged.end(), all_dofs.begin());
+  };
+
+  for (; merged_ess_bdr_ < ess_bdr_.size(); merged_ess_bdr_++) {
+    const auto& bc = ess_bdr_[merged_ess_bdr_];
+    merge(all_true_dofs_, bc.getTrueDofList());
+    merge(all_local_dofs_, bc.getLocalDofList());
   }
-  all_true_dofs_.Sort();
-  all_local_dofs_.Sort();
-  all_true_dofs_.Unique();
-  all_local_dofs_.Unique();
   all_dofs_valid_ = true;
 }
 
@@ -169,9 +169,11 @@ public:
    * @param[in] ess_bdr_coef The essential BC value coefficient
    * @param[in] space The finite element space to which the BC should be applied
    * @param[in] component The component to set (null implies all components are set)
+   * @return A reference to the new boundary condition, e.g. to declare it time-separable
+   * @see BoundaryCondition::setTimeScaling
    */
-  void addEssential(const std::set<int>& ess_bdr, serac::GeneralCoefficient ess_bdr_coef,
-                    mfem::ParFiniteElementSpace& space, const std::optional<int> component = {});
+  BoundaryCondition& addEssential(const std::set<int>& ess_bdr, serac::GeneralCoefficient ess_bdr_coef,
+                                  mfem::ParFiniteElementSpace& space, const std::optional<int> component = {});
 
   /**
    * @brief Set the natural boundary conditions from a list of boundary markers and a coefficient
@@ -201,7 +203,6 @@ public:
   {
     other_bdr_.emplace_back(bdr_coef, component, space, bdr_attr);
     other_bdr_.back().setTag(tag);
-    all_dofs_valid_ = false;
   }
 
   /**
@@ -221,7 +222,7 @@ public:
    */
   const mfem::Array<int>& allEssentialTrueDofs() const
   {
-    if (!all_dofs_valid_) {
+    if (!all_dofs_valid_ || merged_ess_bdr_ != ess_bdr_.size()) {
       updateAllDofs();
     }
     return all_true_dofs_;
@@ -233,12 +234,28 @@ public:
    */
   const mfem::Array<int>& allEssentialLocalDofs() const
   {
-    if (!all_dofs_valid_) {
+    if (!all_dofs_valid_ || merged_ess_bdr_ != ess_bdr_.size()) {
       updateAllDofs();
     }
     return all_local_dofs_;
   }
 
+  /**
+   * @brief Sets the constrained DOFs of all the essential BCs, and their first (and optionally second) time derivatives
+   *
+   * Time-separable BCs scale their cached projection. The others are differentiated with a 3-point finite difference
+   * stencil of times centered on @a time, so their coefficients are evaluated 3 times.
+   *
+   * @param[in] time The time at which to evaluate the boundary data
+   * @param[in] epsilon The step of the finite difference stencil
+   * @param[out] U The boundary data, zero on the unconstrained DOFs
+   * @param[out] dU_dt The first time derivative of the boundary data, zero on the unconstrained DOFs
+   * @param[out] d2U_dt2 The second time derivative of the boundary data, zero on the unconstrained DOFs, if not null
+   * @see BoundaryCondition::setTimeScaling
+   */
+  void setEssentialDofs(double time, double epsilon, mfem::Vector& U, mfem::Vector& dU_dt,
+                        mfem::Vector* d2U_dt2 = nullptr) const;
+
   /**
    * @brief Eliminates all essential BCs from a matrix
    * @param[inout] matrix The matrix to eliminate from, will be modified
@@ -251,6 +268,20 @@ public:
     return std::unique_ptr<mfem::HypreParMatrix>(matrix.EliminateRowsCols(allEssentialTrueDofs()));
   }
 
+  /**
+   * @brief Eliminates all essential BCs from a matrix in place, without keeping the eliminated entries
+   *
+   * The rows and columns of the essential DOFs are zeroed (keeping the sparsity of the matrix), with a 1 on the
+   * diagonal. Unlike eliminateAllEssentialDofsFromMatrix(), no matrix is allocated, so this suits e.g. the Jacobians
+   * of Newton iterations, whose corrections vanish on the essential DOFs.
+   *
+   * @param[inout] matrix The matrix to eliminate from, will be modified
+   */
+  void eliminateAllEssentialDofsInPlace(mfem::HypreParMatrix& matrix) const
+  {
+    matrix.EliminateBC(allEssentialTrueDofs(), mfem::Operator::DiagonalPolicy::DIAG_ONE);
+  }
+
   /**
    * @brief Accessor for the essential BC objects
    */
@@ -292,7 +323,8 @@ public:
 
 private:
   /**
-   * @brief Updates the "cached" list of all DOF indices
+   * @brief Updates the "cached" list of all DOF indices, by merging the DOFs of the essential BCs added since the
+   * last update into it (or recomputing it, if it was invalidated)
    */
   void updateAllDofs() const;
 
@@ -339,6 +371,21 @@ private:
    * @brief Whether the set of stored total DOFs is valid
    */
   mutable bool all_dofs_valid_ = false;
+
+  /**
+   * @brief The number of essential BCs (the first ones of ess_bdr_) whose DOFs are merged into the stored lists
+   */
+  mutable std::size_t merged_ess_bdr_ = 0;
+
+  /**
+   * @brief Workspace for the stencil point before the time of interest, for the BCs that are not time-separable
+   */
+  mutable mfem::Vector U_minus_;
+
+  /**
+   * @brief Workspace for the stencil point after the time of interest, for the BCs that are not time-separable
+   */
+  mutable mfem::Vector U_plus_;
 };
 
 }  // namespace serac
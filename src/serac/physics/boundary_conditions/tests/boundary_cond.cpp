@@ -4,7 +4,10 @@
 //
 // SPDX-License-Identifier: (BSD-3-Clause)
 
+#include <algorithm>
+#include <cmath>
 #include <memory>
+#include <vector>
 
 #include "axom/slic/core/SimpleLogger.hpp"
 #include <gtest/gtest.h>
@@ -42,6 +45,189 @@ TEST(BoundaryCond, SimpleRepeatedDofs)
   MPI_Barrier(MPI_COMM_WORLD);
 }
 
+TEST(BoundaryCond, IncrementalDofMerge)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+  auto               mesh = mfem::Mesh::MakeCartesian2D(8, 8, mfem::Element::QUADRILATERAL);
+  mfem::ParMesh      par_mesh(MPI_COMM_WORLD, mesh);
+  FiniteElementState state(par_mesh, FiniteElementState::Options{.order = 2, .vector_dim = 2});
+
+  BoundaryConditionManager bcs(par_mesh);
+  auto                     vector_coef = std::make_shared<mfem::VectorConstantCoefficient>(mfem::Vector(2));
+  auto                     coef        = std::make_shared<mfem::ConstantCoefficient>(1);
+
+  // query the lists after every added BC, so that each one is merged into them
+  bcs.addEssential({1}, vector_coef, state.space());
+  EXPECT_GT(bcs.allEssentialTrueDofs().Size(), 0);
+  bcs.addEssential({2, 3}, coef, state.space(), 0);
+  EXPECT_GT(bcs.allEssentialLocalDofs().Size(), 0);
+  mfem::Array<int> true_dofs({state.space().GetTrueVSize() - 1, 0});
+  bcs.addEssentialTrueDofs(true_dofs, coef, state.space(), 1);
+
+  // the merged lists are the sorted union of the lists of all the BCs
+  for (bool local : {false, true}) {
+    std::vector<int> expected;
+    for (const auto& bc : bcs.essentials()) {
+      const auto& dofs = local ? bc.getLocalDofList() : bc.getTrueDofList();
+      expected.insert(expected.end(), dofs.begin(), dofs.end());
+    }
+    std::sort(expected.begin(), expected.end());
+    expected.erase(std::unique(expected.begin(), expected.end()), expected.end());
+
+    const auto& merged = local ? bcs.allEssentialLocalDofs() : bcs.allEssentialTrueDofs();
+    EXPECT_EQ(std::vector<int>(merged.begin(), merged.end()), expected);
+  }
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
+TEST(BoundaryCond, InPlaceEliminationMatchesEliminatedMatrix)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+  auto               mesh = mfem::Mesh::MakeCartesian2D(6, 6, mfem::Element::QUADRILATERAL);
+  mfem::ParMesh      par_mesh(MPI_COMM_WORLD, mesh);
+  FiniteElementState state(par_mesh);
+
+  BoundaryConditionManager bcs(par_mesh);
+  bcs.addEssential({1, 2}, std::make_shared<mfem::ConstantCoefficient>(1), state.space());
+
+  mfem::ParBilinearForm form(&state.space());
+  form.AddDomainIntegrator(new mfem::DiffusionIntegrator());
+  form.Assemble();
+  form.Finalize();
+  std::unique_ptr<mfem::HypreParMatrix> in_place(form.ParallelAssemble());
+  std::unique_ptr<mfem::HypreParMatrix> eliminated(form.ParallelAssemble());
+
+  bcs.eliminateAllEssentialDofsInPlace(*in_place);
+  auto eliminated_entries = bcs.eliminateAllEssentialDofsFromMatrix(*eliminated);
+
+  // both eliminated matrices have the same action
+  mfem::Vector x(state.space().GetTrueVSize()), in_place_x(x.Size()), eliminated_x(x.Size());
+  x.Randomize(1);
+  in_place->Mult(x, in_place_x);
+  eliminated->Mult(x, eliminated_x);
+  in_place_x -= eliminated_x;
+  EXPECT_LT(in_place_x.Normlinf(), 1.0e-12);
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
+TEST(BoundaryCond, TimeSeparableMatchesCoefficient)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+  constexpr int      N    = 15;
+  constexpr int      ATTR = 1;
+  auto               mesh = mfem::Mesh::MakeCartesian2D(N, N, mfem::Element::TRIANGLE);
+  mfem::ParMesh      par_mesh(MPI_COMM_WORLD, mesh);
+  FiniteElementState state(par_mesh);
+
+  for (int i = 0; i < par_mesh.GetNBE(); i++) {
+    par_mesh.GetBdrElement(i)->SetAttribute(ATTR);
+  }
+
+  auto profile = [](const mfem::Vector& x) { return x[0] + 2.0 * x[1]; };
+  auto scale   = [](double t) { return std::sin(t); };
+
+  // the same boundary data, once as a function of space and time and once as a scaled profile
+  BoundaryConditionManager reference(par_mesh);
+  reference.addEssential(
+      {ATTR}, std::make_shared<mfem::FunctionCoefficient>([&](const mfem::Vector& x, double t) {
+        return scale(t) * profile(x);
+      }),
+      state.space());
+
+  BoundaryConditionManager separable(par_mesh);
+  separable.addEssential({ATTR}, std::make_shared<mfem::FunctionCoefficient>(profile), state.space())
+      .setTimeScaling(scale, [](double t) { return std::cos(t); });
+
+  const int    n       = state.space().GetTrueVSize();
+  const double t       = 0.3;
+  const double epsilon = 1.0e-4;
+
+  mfem::Vector U_ref(n), dU_dt_ref(n), d2U_dt2_ref(n);
+  mfem::Vector U(n), dU_dt(n), d2U_dt2(n);
+  reference.setEssentialDofs(t, epsilon, U_ref, dU_dt_ref, &d2U_dt2_ref);
+  separable.setEssentialDofs(t, epsilon, U, dU_dt, &d2U_dt2);
+
+  EXPECT_GT(separable.allEssentialTrueDofs().Size(), 0);
+  for (int dof : separable.allEssentialTrueDofs()) {
+    EXPECT_NEAR(U[dof], U_ref[dof], 1.0e-12);
+    EXPECT_NEAR(dU_dt[dof], dU_dt_ref[dof], 1.0e-6);
+    EXPECT_NEAR(d2U_dt2[dof], d2U_dt2_ref[dof], 1.0e-3);
+  }
+
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
+TEST(BoundaryCond, BatchedMatchesPointwiseCoefficient)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+  constexpr int      N    = 15;
+  constexpr int      ATTR = 1;
+  auto               mesh = mfem::Mesh::MakeCartesian2D(N, N, mfem::Element::TRIANGLE);
+  mfem::ParMesh      par_mesh(MPI_COMM_WORLD, mesh);
+  FiniteElementState state(par_mesh, {.order = 2, .vector_dim = 2});
+
+  for (int i = 0; i < par_mesh.GetNBE(); i++) {
+    par_mesh.GetBdrElement(i)->SetAttribute(ATTR);
+  }
+
+  auto u = [](const tensor<double, 2>& x, double t) { return tensor<double, 2>{x[0] * x[1] + t, x[0] - t * x[1]}; };
+
+  // the same boundary data, once evaluated one point at a time and once for all the nodes at once
+  BoundaryConditionManager reference(par_mesh);
+  reference.addEssential({ATTR},
+                         std::make_shared<mfem::VectorFunctionCoefficient>(
+                             2,
+                             [&](const mfem::Vector& x, double t, mfem::Vector& v) {
+                               auto value = u({x[0], x[1]}, t);
+                               v[0]       = value[0];
+                               v[1]       = value[1];
+                             }),
+                         state.space());
+
+  BoundaryConditionManager batched(par_mesh);
+  batched.addEssential({ATTR}, makeBatchedVectorCoefficient<2>(u), state.space());
+
+  const int n = state.space().GetTrueVSize();
+
+  // the coordinates of the nodes are reused by the second projection
+  for (double t : {0.0, 0.7}) {
+    mfem::Vector U_ref(n), U(n);
+    U_ref = 0.0;
+    U     = 0.0;
+    for (auto& bc : reference.essentials()) {
+      bc.setDofs(U_ref, t);
+    }
+    for (auto& bc : batched.essentials()) {
+      bc.setDofs(U, t);
+    }
+
+    EXPECT_GT(batched.allEssentialTrueDofs().Size(), 0);
+    for (int dof : batched.allEssentialTrueDofs()) {
+      EXPECT_NEAR(U[dof], U_ref[dof], 1.0e-12);
+    }
+  }
+
+  // and the projection of a (single component of a) field onto every node
+  FiniteElementState component(state.space());
+  FiniteElementState component_ref(state.space());
+  mfem::Array<int>   nodes(state.space().GetNDofs());
+  for (int i = 0; i < nodes.Size(); i++) {
+    nodes[i] = i;
+  }
+
+  auto                      f = [](const tensor<double, 2>& x, double) { return x[0] * x[0] - 3.0 * x[1]; };
+  mfem::FunctionCoefficient f_ref([&](const mfem::Vector& x) { return f({x[0], x[1]}, 0.0); });
+  component     = 0.0;
+  component_ref = 0.0;
+  component.project(*makeBatchedCoefficient<2>(f), nodes, 1);
+  component_ref.project(f_ref, nodes, 1);
+
+  component -= component_ref;
+  EXPECT_LT(component.Normlinf(), 1.0e-12);
+
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
 enum TestTag
 {
   Tag1 = 0,
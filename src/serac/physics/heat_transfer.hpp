@@ -14,12 +14,15 @@
 
 #include "mfem.hpp"
 
+#include "serac/infrastructure/profiling.hpp"
 #include "serac/physics/common.hpp"
 #include "serac/physics/heat_transfer_input.hpp"
+#include "serac/physics/materials/thermal_material.hpp"
 #include "serac/physics/base_physics.hpp"
 #include "serac/numerics/odes.hpp"
 #include "serac/numerics/stdfunction_operator.hpp"
 #include "serac/numerics/functional/functional.hpp"
+#include "serac/physics/state/batched_coefficient.hpp"
 #include "serac/physics/state/state_manager.hpp"
 #include "serac/numerics/expr_template_ops.hpp"
 
@@ -172,14 +175,80 @@ public:
     residual_ = std::make_unique<Functional<test(scalar_trial, scalar_trial, shape_trial, parameter_space...)>>(
         test_space, trial_spaces);
 
+    // the shape displacement rarely changes between residual evaluations,
+    // so its values at each quadrature point are only recomputed when it does
+    residual_->SetCachedArgument(2);
+
+    // and computeShapeSensitivity() is called once per quantity of interest at the same state
+    // (and shape), so those calls share the derivatives w.r.t. it
+    residual_->SetGradientCaching(2);
+
+    // the IMEX timesteppers treat the sources and fluxes explicitly, so they go in a residual of their own
+    bool imex = timestepping_opts.timestepper == TimestepMethod::IMEXEuler ||
+                timestepping_opts.timestepper == TimestepMethod::IMEXARS222;
+    if (imex) {
+      explicit_residual_ =
+          std::make_unique<Functional<test(scalar_trial, scalar_trial, shape_trial, parameter_space...)>>(
+              test_space, trial_spaces);
+      explicit_residual_->SetCachedArgument(2);
+    }
+
     nonlin_solver_->setOperator(residual_with_bcs_);
 
+    // p-multigrid builds its coarse levels from the temperature space
+    auto* pmg_prec = dynamic_cast<PMultigridPreconditioner*>(nonlin_solver_->preconditioner());
+    if (pmg_prec) {
+      pmg_prec->setFiniteElementSpace(temperature_.space());
+    }
+
+    // geometric multigrid builds its coarse levels on the coarse meshes of the mesh
+    auto* gmg_prec = dynamic_cast<GeometricMultigridPreconditioner*>(nonlin_solver_->preconditioner());
+    if (gmg_prec) {
+      gmg_prec->setFiniteElementSpace(temperature_.space(), StateManager::coarseMeshes(sidre_datacoll_id_));
+    }
+
+    // the low-order-refined preconditioner assembles its own matrix, with the same essential dofs
+    auto* lor_prec = dynamic_cast<LORPreconditioner*>(nonlin_solver_->preconditioner());
+    if (lor_prec) {
+      lor_prec->setFiniteElementSpace(temperature_.space(), bcs_.allEssentialTrueDofs());
+    }
+
     // Check for dynamic mode
-    if (timestepping_opts.timestepper != TimestepMethod::QuasiStatic) {
+    if (timestepping_opts.lumped_mass) {
+      bool explicit_method = timestepping_opts.timestepper == TimestepMethod::ForwardEuler ||
+                             timestepping_opts.timestepper == TimestepMethod::RK2 ||
+                             timestepping_opts.timestepper == TimestepMethod::RK4;
+      SLIC_ERROR_ROOT_IF(!explicit_method || timestepping_opts.adaptive,
+                         "A lumped heat capacity requires a fixed step ForwardEuler, RK2 or RK4 timestepper");
+
+      // explicit steps are taken by this module directly, without the ODE or nonlinear solvers
+      explicit_timestepper_ = timestepping_opts.timestepper;
+      is_explicit_          = true;
+      is_quasistatic_       = false;
+    } else if (timestepping_opts.timestepper != TimestepMethod::QuasiStatic) {
       ode_.SetTimestepper(timestepping_opts.timestepper);
       ode_.SetEnforcementMethod(timestepping_opts.enforcement_method);
+      if (timestepping_opts.adaptive) {
+        ode_.SetAdaptiveTimestepping(timestepping_opts);
+      }
+      ode_.SetPredictor(timestepping_opts.extrapolation_states);
+      if (imex) {
+        ode_.SetIMEXSplitting({.implicit_residual =
+                                   [this](const mfem::Vector& u, mfem::Vector& r) {
+                                     residual_->Mult(r, u, zero_, shape_displacement_,
+                                                     *parameters_[parameter_indices].state...);
+                                   },
+                               .explicit_residual =
+                                   [this](const mfem::Vector& u, double t, mfem::Vector& r) {
+                                     ode_time_point_ = t;
+                                     explicit_residual_->Mult(r, u, zero_, shape_displacement_,
+                                                              *parameters_[parameter_indices].state...);
+                                   },
+                               .load = imex_load_});
+      }
       is_quasistatic_ = false;
     } else {
+      predictor_      = SolutionExtrapolator(timestepping_opts.extrapolation_states);
       is_quasistatic_ = true;
     }
 
@@ -193,6 +262,15 @@ public:
     previous_.SetSize(true_size);
     previous_ = 0.0;
 
+    previous_temperature_.SetSize(true_size);
+    coupled_rate_.SetSize(true_size);
+
+    bc_temperature_.SetSize(true_size);
+    bc_rate_.SetSize(true_size);
+
+    imex_load_.SetSize(true_size);
+    imex_load_ = 0.0;
+
     zero_.SetSize(true_size);
     zero_ = 0.0;
 
@@ -209,6 +287,22 @@ public:
    */
   HeatTransfer(const HeatTransferInputOptions& options, const std::string& name = "")
       : HeatTransfer(options.nonlin_solver_options, options.lin_solver_options, options.timestepping_options, name)
+  {
+    // TODO: move these material parameters out of the HeatTransferInputOptions
+    setMaterial(heat_transfer::LinearIsotropicConductor(options.rho, options.cp, options.kappa));
+
+    setInputConditions(options);
+  }
+
+  /**
+   * @brief Set the initial conditions and the boundary conditions given in the input file options
+   *
+   * This is what the constructor from the input file options does besides setting the material, so that modules
+   * with other materials (e.g. that of a coupled problem, see Thermomechanics) can use the rest of the options.
+   *
+   * @param[in] options The physics module input file option struct
+   */
+  void setInputConditions(const HeatTransferInputOptions& options)
   {
     if (options.initial_temperature) {
       auto temp = options.initial_temperature->constructScalar();
@@ -228,13 +322,13 @@ public:
       // FIXME: Better naming for boundary conditions?
       if (bc_name.find("temperature") != std::string::npos) {
         std::shared_ptr<mfem::Coefficient> temp_coef(bc.coef_opts.constructScalar());
-        bcs_.addEssential(bc.attrs, temp_coef, temperature_.space(), *bc.coef_opts.component);
+        bcs_.addEssential(bc.attrs, temp_coef, temperature_.space(), bc.coef_opts.component);
       } else if (bc_name.find("flux") != std::string::npos) {
         // TODO: Not implemented yet in input files
         // NOTE: cannot use std::functions that use mfem::vector
         SLIC_ERROR("'flux' is not implemented yet in input files.");
       } else {
-        SLIC_WARNING_ROOT("Ignoring boundary condition with unknown name: " << name);
+        SLIC_WARNING_ROOT("Ignoring boundary condition with unknown name: " << bc_name);
       }
     }
   }
@@ -253,6 +347,39 @@ public:
     bcs_.addEssential(temp_bdr, temp_bdr_coef_, temperature_.space());
   }
 
+  /**
+   * @brief Set time-separable essential temperature boundary conditions, T(x, t) = scale(t) * profile(x)
+   *
+   * The profile is projected once and scaled every timestep, so the (rates of the) boundary temperatures are
+   * obtained without evaluating @a profile again.
+   *
+   * @param[in] temp_bdr The boundary attributes on which to enforce a temperature
+   * @param[in] profile The spatial profile of the prescribed boundary temperature
+   * @param[in] scale The scalar function of time multiplying the profile
+   * @param[in] scale_rate The time derivative of @a scale, approximated by central differences if empty
+   */
+  void setTemperatureBCs(const std::set<int>& temp_bdr, std::function<double(const mfem::Vector& x)> profile,
+                         std::function<double(double)> scale, std::function<double(double)> scale_rate = nullptr)
+  {
+    temp_bdr_coef_ = std::make_shared<mfem::FunctionCoefficient>(profile);
+
+    bcs_.addEssential(temp_bdr, temp_bdr_coef_, temperature_.space()).setTimeScaling(scale, scale_rate);
+  }
+
+  /**
+   * @brief Set essential temperature boundary conditions (strongly enforced) from a batched coefficient, which is
+   * evaluated once for all the constrained nodes every time the boundary conditions are applied
+   *
+   * @param[in] temp_bdr The boundary attributes on which to enforce a temperature
+   * @param[in] temp The prescribed boundary temperature, e.g. from makeBatchedCoefficient()
+   */
+  void setTemperatureBCs(const std::set<int>& temp_bdr, std::shared_ptr<BatchedCoefficient> temp)
+  {
+    temp_bdr_coef_ = temp;
+
+    bcs_.addEssential(temp_bdr, temp_bdr_coef_, temperature_.space());
+  }
+
   /**
    * @brief Advance the timestep
    *
@@ -261,12 +388,18 @@ public:
   void advanceTimestep(double& dt) override
   {
     if (is_quasistatic_) {
+      predictor_.push(time_, temperature_);
       time_ += dt;
+      if (predictor_.ready()) {
+        predictor_.predict(time_, temperature_);
+      }
       // Project the essential boundary coefficients
       for (auto& bc : bcs_.essentials()) {
         bc.setDofs(temperature_, time_);
       }
       nonlin_solver_->solve(temperature_);
+    } else if (is_explicit_) {
+      explicitStep(dt);
     } else {
       SLIC_ASSERT_MSG(gf_initialized_[0], "Thermal state not initialized!");
 
@@ -277,6 +410,154 @@ public:
     cycle_ += 1;
   }
 
+  /**
+   * @brief Estimate the largest stable timestep of the explicit (lumped heat capacity) timestepper
+   *
+   * The largest eigenvalue lambda of C_L^{-1} K, where C_L is the lumped heat capacity and K = dR/du the
+   * conductance at the current temperature (restricted to the unconstrained dofs), is estimated by power iteration
+   * with the Rayleigh quotient, using only the action of K. The stable timestep is then the extent of the stability
+   * region of the method on the negative real axis (2 for ForwardEuler and RK2, 2.785 for RK4) over lambda.
+   *
+   * @param safety_factor The fraction of the estimated critical timestep to return
+   * @param iterations The number of power iterations
+   * @return The stable timestep estimate
+   * @pre The timestepping options must set `lumped_mass`
+   * @note The power iteration approaches lambda from below, which the safety factor accounts for
+   */
+  double stableTimestep(double safety_factor = 0.9, int iterations = 30)
+  {
+    SLIC_ERROR_ROOT_IF(!is_explicit_, "Stable timestep estimates require a lumped heat capacity (lumped_mass)");
+
+    updateLumpedCapacity();
+
+    ode_time_point_ = time_;
+    auto [r, K]     = (*residual_)(differentiate_wrt(temperature_), zero_, shape_displacement_,
+                               *parameters_[parameter_indices].state...);
+
+    const auto&  constrained_dofs = bcs_.allEssentialTrueDofs();
+    mfem::Vector v(zero_.Size());
+    mfem::Vector Kv(zero_.Size());
+    v.Randomize(1);
+
+    double lambda = 0.0;
+    for (int k = 0; k < iterations; k++) {
+      v.SetSubVector(constrained_dofs, 0.0);
+      K.Mult(v, Kv);
+      Kv.SetSubVector(constrained_dofs, 0.0);
+
+      // {v . K v, v . C_L v}
+      std::array<double, 2> products = {0.0, 0.0};
+      for (int i = 0; i < v.Size(); i++) {
+        products[0] += v[i] * Kv[i];
+        products[1] += v[i] * lumped_capacity_[i] * v[i];
+      }
+      MPI_Allreduce(MPI_IN_PLACE, products.data(), 2, MPI_DOUBLE, MPI_SUM, mesh_.GetComm());
+
+      if (products[0] <= 0.0 || products[1] <= 0.0) {
+        break;
+      }
+      lambda = products[0] / products[1];
+
+      // v := C_L^{-1} K v, scaled to unit C_L-norm
+      double scale = std::sqrt(products[1]) / products[0];
+      for (int i = 0; i < v.Size(); i++) {
+        v[i] = scale * Kv[i] / lumped_capacity_[i];
+      }
+    }
+
+    if (lambda <= 0.0) {
+      return std::numeric_limits<double>::max();
+    }
+
+    double stability_limit = (explicit_timestepper_ == TimestepMethod::RK4) ? 2.785 : 2.0;
+    return safety_factor * stability_limit / lambda;
+  }
+
+  /**
+   * @brief Begin a timestep that is solved together with other physics (e.g. by Thermomechanics), instead of
+   * with this module's own nonlinear solver
+   *
+   * This advances the time and applies the essential boundary conditions to the temperature. The temperature is
+   * then the unknown of the coupled solve, and transient problems are integrated with backward Euler.
+   *
+   * @param dt The timestep
+   */
+  void beginCoupledTimestep(double dt)
+  {
+    SLIC_ERROR_ROOT_IF(explicit_residual_, "Coupled timesteps are not supported by the IMEX timesteppers");
+
+    if (!is_quasistatic_) {
+      dt_                   = dt;
+      previous_temperature_ = temperature_;
+    }
+
+    time_ += dt;
+    for (auto& bc : bcs_.essentials()) {
+      bc.setDofs(temperature_, time_);
+    }
+  }
+
+  /**
+   * @brief The residual of a coupled timestep at the current temperature and parameter values
+   *
+   * @return The residual, with the rows of the essential boundary condition dofs zeroed
+   * @pre beginCoupledTimestep() must be called prior to this call
+   */
+  mfem::Vector coupledResidual()
+  {
+    constrainEssentialDofs(true);
+    mfem::Vector r = (*residual_)(temperature_, coupledRate(), shape_displacement_,
+                                  *parameters_[parameter_indices].state...);
+    constrainEssentialDofs(false);
+    return r;
+  }
+
+  /**
+   * @brief The Jacobian of a coupled timestep with respect to the temperature
+   *
+   * @return The assembled Jacobian, with the essential boundary condition rows and columns eliminated
+   * @pre beginCoupledTimestep() must be called prior to this call
+   */
+  mfem::HypreParMatrix& coupledJacobian()
+  {
+    const mfem::Vector& rate = coupledRate();
+
+    constrainEssentialDofs(true);
+    if (is_quasistatic_) {
+      auto K = serac::get<DERIVATIVE>((*residual_)(differentiate_wrt(temperature_), rate, shape_displacement_,
+                                                   *parameters_[parameter_indices].state...));
+      assemble(K, J_);
+    } else {
+      // J := dR/du + (1/dt) dR/du_dot, since backward Euler has du_dot = (u - u_previous) / dt
+      auto [r, K, M] = (*residual_)(differentiate_wrt(temperature_), differentiate_wrt(rate), shape_displacement_,
+                                    *parameters_[parameter_indices].state...);
+      assemble(1.0, K, 1.0 / dt_, M, J_);
+    }
+    constrainEssentialDofs(false);
+    return *J_;
+  }
+
+  /**
+   * @brief The Jacobian of a coupled timestep with respect to one of the parameter fields
+   *
+   * @tparam parameter_index The index of the parameter field
+   * @return The assembled Jacobian, with the essential boundary condition rows zeroed
+   * @pre beginCoupledTimestep() must be called prior to this call
+   */
+  template <int parameter_index>
+  std::unique_ptr<mfem::HypreParMatrix> coupledParameterJacobian()
+  {
+    auto drdp = serac::get<DERIVATIVE>((*residual_)(DifferentiateWRT<NUM_STATE_VARS + parameter_index>{},
+                                                    temperature_, coupledRate(), shape_displacement_,
+                                                    *parameters_[parameter_indices].state...));
+    auto J    = assemble(drdp);
+    J->EliminateRows(bcs_.allEssentialTrueDofs());
+    return J;
+  }
+
+  /// @brief Finish a timestep started with beginCoupledTimestep(), once the coupled solve has converged
+  void endCoupledTimestep() { cycle_ += 1; }
+
   /**
    * @brief Set the thermal material model for the physics solver
    *
@@ -297,10 +578,29 @@ public:
    *
    * @pre MaterialType must return a serac::tuple of volumetric heat capacity and thermal flux when operator() is called
    * with the arguments listed above.
+   *
+   * @note If the material (and every source and flux) declares `is_linear` (see heat_transfer::is_linear), the
+   * Jacobian is only assembled when the timestep, shape displacement or a parameter changes, and each step is
+   * solved with a single linear solve
    */
   template <int... active_parameters, typename MaterialType>
   void setMaterial(DependsOn<active_parameters...>, MaterialType material)
   {
+    setMaterial(DependsOn<active_parameters...>{}, material, std::set<int>{});
+  }
+
+  /**
+   * @brief Set the thermal material model of the elements with the given attributes, so that different parts of
+   * the mesh can be made of different materials without branching in (and evaluating every branch of) one material
+   *
+   * @param material A material containing heat capacity and thermal flux evaluation information, see setMaterial()
+   * @param attributes the attributes of the elements made of this material (or every element, if empty)
+   */
+  template <int... active_parameters, typename MaterialType>
+  void setMaterial(DependsOn<active_parameters...>, MaterialType material, const std::set<int>& attributes)
+  {
+    is_linear_ = is_linear_ && heat_transfer::is_linear_v<MaterialType>;
+
     residual_->AddDomainIntegral(
         Dimension<dim>{}, DependsOn<0, 1, 2, active_parameters + NUM_STATE_VARS...>{},
         [material](auto x, auto temperature, auto dtemp_dt, auto shape, auto... params) {
@@ -327,7 +627,7 @@ public:
           return serac::tuple{heat_capacity * du_dt * det_I_plus_dp_dX,
                               -1.0 * dot(inv_I_plus_dp_dX, heat_flux) * det_I_plus_dp_dX};
         },
-        mesh_);
+        mesh_, attributes);
   }
 
   /// @overload
@@ -337,6 +637,106 @@ public:
     setMaterial(DependsOn<>{}, material);
   }
 
+  /// @overload
+  template <typename MaterialType>
+  void setMaterial(MaterialType material, const std::set<int>& attributes)
+  {
+    setMaterial(DependsOn<>{}, material, attributes);
+  }
+
+  /**
+   * @brief Create a shared ptr to a quadrature data buffer, e.g. for the values of a parameter at each quadrature
+   * point (see setParameter())
+   *
+   * @tparam T the type to be created at each quadrature point
+   * @param initial_state the value to be broadcast to each quadrature point
+   * @return std::shared_ptr< QuadratureData<T> >
+   */
+  template <typename T>
+  std::shared_ptr<QuadratureData<T>> createQuadratureDataBuffer(T initial_state)
+  {
+    constexpr auto Q = order + 1;
+
+    size_t num_elements        = size_t(mesh_.GetNE());
+    size_t qpoints_per_element = GaussQuadratureRule<supported_geometries[dim], Q>().size();
+
+    auto  qdata     = std::make_shared<QuadratureData<T>>(num_elements, qpoints_per_element);
+    auto& container = *qdata;
+    for (size_t e = 0; e < num_elements; e++) {
+      for (size_t q = 0; q < qpoints_per_element; q++) {
+        container(e, q) = initial_state;
+      }
+    }
+
+    return qdata;
+  }
+
+  using BasePhysics::setParameter;
+
+  /**
+   * @brief Use values at each quadrature point as parameter `parameter_index`, rather than a finite element field
+   *
+   * The materials that depend on the parameter receive these values (with a zero gradient) directly, e.g. for
+   * parameters computed at quadrature points by an upstream process simulation, without projecting them onto (and
+   * interpolating them back from) the parameter's finite element space. The parameter's finite element state is
+   * only a placeholder then (a zero field is created if none was set), and sensitivities with respect to it are not
+   * available.
+   *
+   * @param parameter_index the index of the parameter
+   * @param values the values at each quadrature point, in the layout of createQuadratureDataBuffer(), of type
+   * `double` for scalar parameter spaces and `tensor<double, components>` otherwise
+   *
+   * @note see Functional::SetQuadraturePointArgument()
+   */
+  template <typename T>
+  void setParameter(const size_t parameter_index, std::shared_ptr<QuadratureData<T>> values)
+  {
+    SLIC_ERROR_ROOT_IF(
+        parameter_index >= parameters_.size(),
+        axom::fmt::format("Parameter index '{}' is not available in physics module '{}'", parameter_index, name_));
+
+    if (!parameters_[parameter_index].state) {
+      quadrature_point_parameter_states_.push_back(generateParameter(
+          detail::addPrefix(name_, "quadrature_point_parameter_" + std::to_string(parameter_index)), parameter_index));
+      *quadrature_point_parameter_states_.back() = 0.0;
+    }
+
+    residual_->SetQuadraturePointArgument(uint32_t(parameter_index + NUM_STATE_VARS), values);
+    if (explicit_residual_) {
+      explicit_residual_->SetQuadraturePointArgument(uint32_t(parameter_index + NUM_STATE_VARS), values);
+    }
+  }
+
+  /**
+   * @brief Replay the element kernels of each residual and Jacobian evaluation on the GPU from a CUDA graph, which
+   * removes most of the kernel launch latency on small meshes per GPU
+   *
+   * @param enabled Whether to use kernel graphs (off by default)
+   * @note see Functional::SetKernelGraphs()
+   */
+  void setKernelGraphs(bool enabled)
+  {
+    residual_->SetKernelGraphs(enabled);
+    if (explicit_residual_) {
+      explicit_residual_->SetKernelGraphs(enabled);
+    }
+  }
+
+  /**
+   * @brief Launch the element kernels of the integrals (e.g. the domain and boundary integrals) on the GPU
+   * concurrently, on separate streams
+   *
+   * @param enabled Whether to launch the integrals concurrently (off by default)
+   * @note see Functional::SetConcurrentIntegrals()
+   */
+  void setConcurrentIntegrals(bool enabled)
+  {
+    residual_->SetConcurrentIntegrals(enabled);
+    if (explicit_residual_) {
+      explicit_residual_->SetConcurrentIntegrals(enabled);
+    }
+  }
+
   /**
    * @brief Set the underlying finite element state to a prescribed temperature
    *
@@ -352,6 +752,19 @@ public:
     gf_initialized_[0] = true;
   }
 
+  /**
+   * @brief Set the underlying finite element state to a prescribed temperature, evaluating a batched coefficient
+   * once for all the nodes
+   *
+   * @param temp The temperature field, e.g. from makeBatchedCoefficient()
+   */
+  void setTemperature(std::shared_ptr<BatchedCoefficient> temp)
+  {
+    temp->SetTime(time_);
+    temperature_.project(*temp);
+    gf_initialized_[0] = true;
+  }
+
   /**
    * @brief Set the thermal source function
    *
@@ -370,11 +783,17 @@ public:
    *    when doing direct evaluation. When differentiating with respect to one of the inputs, its stored
    *    values will change to `dual` numbers rather than `double`. (e.g. `tensor<double,3>` becomes `tensor<dual<...>,
    * 3>`)
+   *
+   * @note The IMEX timesteppers (e.g. TimestepMethod::IMEXARS222) treat the sources and fluxes explicitly
    */
   template <int... active_parameters, typename SourceType>
   void setSource(DependsOn<active_parameters...>, SourceType source_function)
   {
-    residual_->AddDomainIntegral(
+    if (!explicit_residual_) {
+      is_linear_ = is_linear_ && heat_transfer::is_linear_v<SourceType>;
+    }
+
+    sourcesAndFluxes().AddDomainIntegral(
         Dimension<dim>{}, DependsOn<0, 1, 2, active_parameters + NUM_STATE_VARS...>{},
         [source_function, this](auto x, auto temperature, auto /* dtemp_dt */, auto shape, auto... params) {
           // Get the value and the gradient from the input tuple
@@ -410,6 +829,9 @@ public:
    *
    * @tparam FluxType The type of the thermal flux object
    * @param flux_function A function describing the flux applied to a boundary
+   * @param boundary_attributes the attributes of the boundary elements the flux is applied to (or every boundary
+   * element, if empty). Only those boundary elements are evaluated, so a flux on a small part of the boundary should
+   * name its attributes rather than return zero elsewhere
    *
    * @pre FluxType must be a object that can be called with the following arguments:
    *    1. `tensor<T,dim> x` the spatial coordinates for the quadrature point
@@ -429,23 +851,28 @@ public:
    * shape sensitivities for boundary integrals.
    */
   template <int... active_parameters, typename FluxType>
-  void setFluxBCs(DependsOn<active_parameters...>, FluxType flux_function)
+  void setFluxBCs(DependsOn<active_parameters...>, FluxType flux_function,
+                  const std::set<int>& boundary_attributes = {})
   {
-    residual_->AddBoundaryIntegral(
+    if (!explicit_residual_) {
+      is_linear_ = is_linear_ && heat_transfer::is_linear_v<FluxType>;
+    }
+
+    sourcesAndFluxes().AddBoundaryIntegral(
         Dimension<dim - 1>{}, DependsOn<0, 1, 2, active_parameters + NUM_STATE_VARS...>{},
         [this, flux_function](auto x, auto n, auto u, auto /* dtemp_dt */, auto shape, auto... params) {
           auto p    = get<VALUE>(shape);
           auto temp = get<VALUE>(u);
           return flux_function(x + p, n, ode_time_point_, temp, params...);
         },
-        mesh_);
+        mesh_, boundary_attributes);
   }
 
   /// @overload
   template <typename FluxType>
-  void setFluxBCs(FluxType flux_function)
+  void setFluxBCs(FluxType flux_function, const std::set<int>& boundary_attributes = {})
   {
-    setFluxBCs(DependsOn<>{}, flux_function);
+    setFluxBCs(DependsOn<>{}, flux_function, boundary_attributes);
   }
 
   /**
@@ -514,6 +941,12 @@ public:
     return std::vector<std::string>{{"temperature"}, {"adjoint_temperature"}};
   }
 
+  /// @brief The telemetry of the nonlinear solves of the temperature since the last resetSolveTelemetry()
+  SolveTelemetry solveTelemetry() const override { return nonlin_solver_->telemetry(); }
+
+  /// @brief Start accumulating the telemetry of the next solves anew
+  void resetSolveTelemetry() const override { nonlin_solver_->resetTelemetry(); }
+
   /**
    * @brief Complete the initialization and allocation of the data structures.
    *
@@ -521,29 +954,50 @@ public:
    */
   void completeSetup() override
   {
+    SERAC_MARK_FUNCTION;
+
+    // what assembling the Jacobian will allocate, reported before any of it is
+    if (!nonlin_solver_->matrixFree()) {
+      memory::reportEstimate(axom::fmt::format("assembling the Jacobian of '{}'", name_),
+                             residual_->EstimatedAssemblyMemory(0));
+    }
+
     // Build the dof array lookup tables
     temperature_.space().BuildDofToArrays();
 
+    // choose the batch sizes of the residual's kernels before its first evaluation below
+    if (autotuning::options().enabled) {
+      residual_->Autotune();
+      if (explicit_residual_) {
+        explicit_residual_->Autotune();
+      }
+    }
+
+    // when the residual is affine in the temperature, its Jacobian is constant
+    nonlin_solver_->setLinear(is_linear_);
+
     if (is_quasistatic_) {
       residual_with_bcs_ = mfem_ext::StdFunctionOperator(
           temperature_.space().TrueVSize(),
 
           [this](const mfem::Vector& u, mfem::Vector& r) {
-            const mfem::Vector res =
-                (*residual_)(u, zero_, shape_displacement_, *parameters_[parameter_indices].state...);
-
-            // TODO this copy is required as the sundials solvers do not allow move assignments because of their memory
-            // tracking strategy
-            // See https://github.com/mfem/mfem/issues/3531
-            r = res;
-            r.SetSubVector(bcs_.allEssentialTrueDofs(), 0.0);
+            discardStaleLinearJacobian();
+
+            constrainEssentialDofs(true);
+            residual_->Mult(r, u, zero_, shape_displacement_, *parameters_[parameter_indices].state...);
+            constrainEssentialDofs(false);
           },
 
           [this](const mfem::Vector& u) -> mfem::Operator& {
             auto [r, drdu] = (*residual_)(differentiate_wrt(u), zero_, shape_displacement_,
                                           *parameters_[parameter_indices].state...);
-            J_             = assemble(drdu);
-            J_e_           = bcs_.eliminateAllEssentialDofsFromMatrix(*J_);
+            if (nonlin_solver_->matrixFree()) {
+              J_operator_ = std::make_unique<mfem::ConstrainedOperator>(&drdu, bcs_.allEssentialTrueDofs());
+              return *J_operator_;
+            }
+            constrainEssentialDofs(true);
+            assemble(drdu, J_);
+            constrainEssentialDofs(false);
             return *J_;
           });
 
@@ -552,37 +1006,40 @@ public:
           temperature_.space().TrueVSize(),
 
           [this](const mfem::Vector& du_dt, mfem::Vector& r) {
+            discardStaleLinearJacobian();
+
             add(1.0, u_, dt_, du_dt, u_predicted_);
-            const mfem::Vector res =
-                (*residual_)(u_predicted_, du_dt, shape_displacement_, *parameters_[parameter_indices].state...);
-
-            // TODO this copy is required as the sundials solvers do not allow move assignments because of their memory
-            // tracking strategy
-            // See https://github.com/mfem/mfem/issues/3531
-            r = res;
-            r.SetSubVector(bcs_.allEssentialTrueDofs(), 0.0);
+            constrainEssentialDofs(true);
+            residual_->Mult(r, u_predicted_, du_dt, shape_displacement_, *parameters_[parameter_indices].state...);
+            constrainEssentialDofs(false);
+
+            // the explicit residuals of the earlier stages of an IMEX step
+            if (explicit_residual_) {
+              r += imex_load_;
+              r.SetSubVector(bcs_.allEssentialTrueDofs(), 0.0);
+            }
           },
 
           [this](const mfem::Vector& du_dt) -> mfem::Operator& {
-            add(1.0, u_, dt_, du_dt, u_predicted_);
+            SLIC_ERROR_ROOT_IF(nonlin_solver_->matrixFree(),
+                               "Matrix-free linear solves are only supported for quasi-static heat transfer");
 
-            // K := dR/du
-            auto K = serac::get<DERIVATIVE>((*residual_)(differentiate_wrt(u_predicted_), du_dt, shape_displacement_,
-                                                         *parameters_[parameter_indices].state...));
-            std::unique_ptr<mfem::HypreParMatrix> k_mat(assemble(K));
+            add(1.0, u_, dt_, du_dt, u_predicted_);
 
-            // M := dR/du_dot
-            auto M = serac::get<DERIVATIVE>((*residual_)(u_predicted_, differentiate_wrt(du_dt), shape_displacement_,
-                                                         *parameters_[parameter_indices].state...));
-            std::unique_ptr<mfem::HypreParMatrix> m_mat(assemble(M));
+            // K := dR/du and M := dR/du_dot, from a single evaluation of the residual
+            auto [r, K, M] = (*residual_)(differentiate_wrt(u_predicted_), differentiate_wrt(du_dt),
+                                          shape_displacement_, *parameters_[parameter_indices].state...);
 
-            // J := M + dt K
-            J_.reset(mfem::Add(1.0, *m_mat, dt_, *k_mat));
-            J_e_ = bcs_.eliminateAllEssentialDofsFromMatrix(*J_);
+            // J := M + dt K, assembled directly into one matrix
+            constrainEssentialDofs(true);
+            assemble(1.0, M, dt_, K, J_);
+            constrainEssentialDofs(false);
 
             return *J_;
           });
     }
+
+    memory::report(name_ + ".setup", mesh_.GetComm());
   }
 
   /**
@@ -605,32 +1062,31 @@ public:
   {
     SLIC_ERROR_ROOT_IF(adjoint_loads.size() != 1,
                        "Adjoint load container is not the expected size of 1 in the heat transfer module.");
+    SLIC_ERROR_ROOT_IF(explicit_residual_, "Adjoint solves are not supported by the IMEX timesteppers");
 
     auto temp_adjoint_load = adjoint_loads.find("temperature");
 
     SLIC_ERROR_ROOT_IF(temp_adjoint_load == adjoint_loads.end(), "Adjoint load for \"temperature\" not found.");
 
-    mfem::HypreParVector adjoint_load_vector(temp_adjoint_load->second);
+    auto adjoint_load_vector = StateManager::scratchVector(temperature_.space());
+    *adjoint_load_vector     = temp_adjoint_load->second;
 
     // Add the sign correction to move the term to the RHS
-    adjoint_load_vector *= -1.0;
-
-    auto& lin_solver = nonlin_solver_->linearSolver();
+    *adjoint_load_vector *= -1.0;
 
     // By default, use a homogeneous essential boundary condition
-    mfem::HypreParVector adjoint_essential(temp_adjoint_load->second);
-    adjoint_essential = 0.0;
+    auto adjoint_essential = StateManager::scratchVector(temperature_.space());
+    *adjoint_essential     = 0.0;
 
     auto [r, drdu] = (*residual_)(differentiate_wrt(temperature_), zero_, shape_displacement_,
                                   *parameters_[parameter_indices].state...);
     auto jacobian  = assemble(drdu);
-    auto J_T       = std::unique_ptr<mfem::HypreParMatrix>(jacobian->Transpose());
 
     // If we have a non-homogeneous essential boundary condition, extract it from the given state
     auto essential_adjoint_temp = adjoint_with_essential_boundary.find("temperature");
 
     if (essential_adjoint_temp != adjoint_with_essential_boundary.end()) {
-      adjoint_essential = essential_adjoint_temp->second;
+      *adjoint_essential = essential_adjoint_temp->second;
     } else {
       // If the essential adjoint load container does not have a temperature dual but it has a non-zero size, the
       // user has supplied an incorrectly-named dual vector.
@@ -639,12 +1095,15 @@ public:
                     "boundary condition named \"temperature\".");
     }
 
-    for (const auto& bc : bcs_.essentials()) {
-      bc.apply(*J_T, adjoint_load_vector, adjoint_essential);
+    // Eliminating the essential dofs symmetrically commutes with the transpose, so the forward matrix is eliminated
+    // and the transposed eliminated columns are moved to the RHS
+    auto J_e = bcs_.eliminateAllEssentialDofsFromMatrix(*jacobian);
+    J_e->MultTranspose(-1.0, *adjoint_essential, 1.0, *adjoint_load_vector);
+    for (int dof : bcs_.allEssentialTrueDofs()) {
+      (*adjoint_load_vector)(dof) = (*adjoint_essential)(dof);
     }
 
-    lin_solver.SetOperator(*J_T);
-    lin_solver.Mult(adjoint_load_vector, adjoint_temperature_);
+    nonlin_solver_->solveTranspose(*jacobian, *adjoint_load_vector, adjoint_temperature_);
 
     // Reset the equation solver to use the full nonlinear residual operator
     nonlin_solver_->setOperator(residual_with_bcs_);
@@ -666,10 +1125,10 @@ public:
     SLIC_ASSERT_MSG(parameter_field < sizeof...(parameter_indices),
                     axom::fmt::format("Invalid parameter index '{}' reqested for sensitivity."));
 
-    auto drdparam     = serac::get<1>(d_residual_d_[parameter_field]());
-    auto drdparam_mat = assemble(drdparam);
+    auto drdparam = serac::get<1>(d_residual_d_[parameter_field]());
 
-    drdparam_mat->MultTranspose(adjoint_temperature_, *parameters_[parameter_field].sensitivity);
+    // the transposed gradient is applied matrix-free, so no (rectangular) sparse matrix is assembled
+    drdparam.MultTranspose(adjoint_temperature_, *parameters_[parameter_field].sensitivity);
 
     return *parameters_[parameter_field].sensitivity;
   }
@@ -684,16 +1143,42 @@ public:
    */
   FiniteElementDual& computeShapeSensitivity() override
   {
+    // the residual's derivatives w.r.t. the shape are reused while its arguments don't change (see
+    // Functional::SetGradientCaching()), but the loads may also depend on the time
+    if (time_ != shape_derivative_time_) {
+      residual_->ClearMemoization();
+      shape_derivative_time_ = time_;
+    }
+
     auto drdshape = serac::get<DERIVATIVE>((*residual_)(DifferentiateWRT<SHAPE>{}, temperature_, zero_,
                                                         shape_displacement_, *parameters_[parameter_indices].state...));
 
-    auto drdshape_mat = assemble(drdshape);
-
-    drdshape_mat->MultTranspose(adjoint_temperature_, shape_displacement_sensitivity_);
+    drdshape.MultTranspose(adjoint_temperature_, shape_displacement_sensitivity_);
 
     return shape_displacement_sensitivity_;
   }
 
+  /**
+   * @brief Compute the implicit sensitivities of the quantity of interest used in defining the load for the adjoint
+   * problem with respect to every parameter field and the shape displacement field
+   *
+   * The residual is evaluated once, differentiating w.r.t. all of those fields in the same pass over the elements,
+   * and the transpose of each gradient is applied to the adjoint matrix-free.
+   *
+   * @pre `solveAdjoint` with an appropriate adjoint load must be called prior to this method.
+   */
+  void computeAllSensitivities() override
+  {
+    auto derivatives = (*residual_)(DifferentiateWRT<SHAPE, NUM_STATE_VARS + parameter_indices...>{},
+                                    temperature_, zero_, shape_displacement_, *parameters_[parameter_indices].state...);
+
+    // the first derivative is that of the shape displacement, followed by those of the parameters, in order
+    serac::get<1>(derivatives).MultTranspose(adjoint_temperature_, shape_displacement_sensitivity_);
+    (serac::get<2 + parameter_indices>(derivatives)
+         .MultTranspose(adjoint_temperature_, *parameters_[parameter_indices].sensitivity),
+     ...);
+  }
+
   /// Destroy the Thermal Solver object
   virtual ~HeatTransfer() = default;
 
@@ -716,6 +1201,24 @@ protected:
   /// serac::Functional that is used to calculate the residual and its derivatives
   std::unique_ptr<Functional<test(scalar_trial, scalar_trial, shape_trial, parameter_space...)>> residual_;
 
+  /**
+   * @brief the sources and fluxes, which the IMEX timesteppers treat explicitly (see
+   * mfem_ext::FirstOrderODE::SetIMEXSplitting()), or null if they are part of residual_
+   */
+  std::unique_ptr<Functional<test(scalar_trial, scalar_trial, shape_trial, parameter_space...)>> explicit_residual_;
+
+  /// the explicit residuals of the earlier stages of an IMEX step, added to the residual of each stage solve
+  mfem::Vector imex_load_;
+
+  /// @brief the Functional that the sources and fluxes are added to
+  Functional<test(scalar_trial, scalar_trial, shape_trial, parameter_space...)>& sourcesAndFluxes()
+  {
+    return explicit_residual_ ? *explicit_residual_ : *residual_;
+  }
+
+  /// the placeholder states of the parameters given at quadrature points, see setParameter()
+  std::vector<std::unique_ptr<FiniteElementState>> quadrature_point_parameter_states_;
+
   /// Assembled mass matrix
   std::unique_ptr<mfem::HypreParMatrix> M_;
 
@@ -738,12 +1241,14 @@ protected:
    */
   mfem_ext::FirstOrderODE ode_;
 
+  /// Extrapolates the last converged temperatures for the initial guess of quasi-static solves
+  SolutionExtrapolator predictor_;
+
   /// Assembled sparse matrix for the Jacobian
   std::unique_ptr<mfem::HypreParMatrix> J_;
 
-  /// rows and columns of J_ that have been separated out
-  /// because are associated with essential boundary conditions
-  std::unique_ptr<mfem::HypreParMatrix> J_e_;
+  /// the action of the Jacobian with essential boundary conditions applied, used instead of J_ for matrix-free solves
+  std::unique_ptr<mfem::ConstrainedOperator> J_operator_;
 
   /// The current timestep
   double dt_;
@@ -754,6 +1259,9 @@ protected:
   /// An auxilliary zero vector
   mfem::Vector zero_;
 
+  /// @brief the time of the last shape derivative of the residual, see computeShapeSensitivity()
+  double shape_derivative_time_ = 0.0;
+
   /// Predicted temperature true dofs
   mfem::Vector u_;
 
@@ -763,6 +1271,227 @@ protected:
   /// Previous value of du_dt used to prime the pump for the nonlinear solver
   mfem::Vector previous_;
 
+  /// The temperature true dofs at the start of a coupled timestep
+  mfem::Vector previous_temperature_;
+
+  /// The backward Euler temperature rate true dofs of a coupled timestep
+  mfem::Vector coupled_rate_;
+
+  /**
+   * @brief The temperature rate of a coupled timestep, i.e. zero for quasi-static problems and the backward
+   * Euler approximation (u - u_previous) / dt otherwise
+   */
+  const mfem::Vector& coupledRate()
+  {
+    if (is_quasistatic_) {
+      return zero_;
+    }
+    add(1.0 / dt_, temperature_, -1.0 / dt_, previous_temperature_, coupled_rate_);
+    return coupled_rate_;
+  }
+
+  /// @brief Whether the steps are explicit, with a lumped heat capacity (see TimesteppingOptions::lumped_mass)
+  bool is_explicit_ = false;
+
+  /// @brief The explicit method (ForwardEuler, RK2 or RK4) of the explicit steps
+  TimestepMethod explicit_timestepper_ = TimestepMethod::ForwardEuler;
+
+  /// @brief The lumped (diagonal) heat capacity of the explicit steps, see updateLumpedCapacity()
+  mfem::Vector lumped_capacity_;
+
+  /// @brief The shape displacement the lumped heat capacity was computed with
+  mfem::Vector lumped_capacity_shape_displacement_;
+
+  /// @brief The temperature of the explicit stage
+  mfem::Vector stage_temperature_;
+
+  /// @brief The temperature rate of the explicit stage
+  mfem::Vector stage_rate_;
+
+  /// @brief The temperature increment of an explicit step, accumulated over its stages
+  mfem::Vector step_increment_;
+
+  /// @brief The prescribed temperatures of the constrained dofs at the time of an explicit stage
+  mfem::Vector bc_temperature_;
+
+  /// @brief The prescribed temperature rates of the constrained dofs at the time of an explicit stage
+  mfem::Vector bc_rate_;
+
+  /**
+   * @brief Take an explicit step with the lumped heat capacity C_L, as a Runge-Kutta method each of whose stages
+   * only depends on the one before it:
+   *
+   *   k_s = -C_L^{-1} r(u_n + a_s dt k_{s-1}, t_n + a_s dt), where r is the residual with zero temperature rate
+   *   u_{n+1} = u_n + dt sum_s b_s k_s
+   *
+   * which covers ForwardEuler, the midpoint RK2 and the classical RK4. So each stage is a single residual
+   * evaluation and a diagonal scaling. The essential boundary conditions prescribe the temperature and rate of the
+   * constrained dofs directly.
+   *
+   * @param dt The timestep, see stableTimestep()
+   */
+  void explicitStep(double dt)
+  {
+    SLIC_ASSERT_MSG(gf_initialized_[0], "Thermal state not initialized!");
+
+    updateLumpedCapacity();
+
+    std::vector<double> a;
+    std::vector<double> b;
+    switch (explicit_timestepper_) {
+      case TimestepMethod::RK2:
+        a = {0.0, 0.5};
+        b = {0.0, 1.0};
+        break;
+      case TimestepMethod::RK4:
+        a = {0.0, 0.5, 0.5, 1.0};
+        b = {1.0 / 6.0, 1.0 / 3.0, 1.0 / 3.0, 1.0 / 6.0};
+        break;
+      default:
+        a = {0.0};
+        b = {1.0};
+    }
+
+    stage_temperature_ = temperature_;
+    step_increment_.SetSize(temperature_.Size());
+    step_increment_ = 0.0;
+    for (std::size_t s = 0; s < a.size(); s++) {
+      if (s > 0) {
+        add(temperature_, a[s] * dt, stage_rate_, stage_temperature_);
+      }
+      explicitRate(time_ + a[s] * dt, stage_temperature_, stage_rate_);
+      step_increment_.Add(b[s] * dt, stage_rate_);
+    }
+
+    temperature_ += step_increment_;
+    time_ += dt;
+    for (auto& bc : bcs_.essentials()) {
+      bc.setDofs(temperature_, time_);
+    }
+  }
+
+  /**
+   * @brief Compute the temperature rate -C_L^{-1} r(u) of an explicit stage
+   *
+   * @param t The time of the stage
+   * @param[inout] u The temperature of the stage, whose constrained dofs are set to their prescribed values
+   * @param[out] du_dt The temperature rate, with the prescribed rates on the constrained dofs
+   */
+  void explicitRate(double t, mfem::Vector& u, mfem::Vector& du_dt)
+  {
+    bcs_.setEssentialDofs(t, mfem_ext::FirstOrderODE::epsilon, bc_temperature_, bc_rate_);
+
+    const auto& constrained_dofs = bcs_.allEssentialTrueDofs();
+    for (int dof : constrained_dofs) {
+      u[dof] = bc_temperature_[dof];
+    }
+
+    ode_time_point_ = t;
+    du_dt.SetSize(u.Size());
+    residual_->Mult(du_dt, u, zero_, shape_displacement_, *parameters_[parameter_indices].state...);
+
+    for (int i = 0; i < du_dt.Size(); i++) {
+      du_dt[i] = -du_dt[i] / lumped_capacity_[i];
+    }
+    for (int dof : constrained_dofs) {
+      du_dt[dof] = bc_rate_[dof];
+    }
+  }
+
+  /**
+   * @brief Compute the lumped heat capacity from the row sums of the capacity matrix dR/du_dot, unless it was
+   * already computed with the current shape displacement
+   *
+   * A heat capacity that depends on the temperature is evaluated at the temperature of the first explicit step.
+   * Row sums of higher order capacity matrices (e.g. on quadratic simplices) need not be positive, in which case
+   * the diagonal of the capacity matrix, scaled to the same total heat capacity, is used instead.
+   */
+  void updateLumpedCapacity()
+  {
+    bool current = lumped_capacity_.Size() == zero_.Size() &&
+                   lumped_capacity_shape_displacement_.DistanceTo(shape_displacement_.GetData()) == 0.0;
+    if (current) {
+      return;
+    }
+
+    auto [r, C] = (*residual_)(temperature_, differentiate_wrt(zero_), shape_displacement_,
+                               *parameters_[parameter_indices].state...);
+
+    mfem::Vector ones(zero_.Size());
+    ones             = 1.0;
+    lumped_capacity_ = C(ones);
+
+    double min_capacity = lumped_capacity_.Min();
+    MPI_Allreduce(MPI_IN_PLACE, &min_capacity, 1, MPI_DOUBLE, MPI_MIN, mesh_.GetComm());
+
+    if (min_capacity <= 0.0) {
+      mfem::Vector diagonal;
+      C.AssembleDiagonal(diagonal);
+
+      std::array<double, 2> totals = {lumped_capacity_.Sum(), diagonal.Sum()};
+      MPI_Allreduce(MPI_IN_PLACE, totals.data(), 2, MPI_DOUBLE, MPI_SUM, mesh_.GetComm());
+
+      lumped_capacity_ = diagonal;
+      lumped_capacity_ *= totals[0] / totals[1];
+    }
+
+    lumped_capacity_shape_displacement_ = shape_displacement_;
+  }
+
+  /// @brief Whether every material, source and flux is affine in the temperature, see heat_transfer::is_linear
+  bool is_linear_ = true;
+
+  /// @brief The timestep the Jacobian kept for a linear problem was built with
+  double linear_jacobian_dt_ = -1.0;
+
+  /// @brief The shape displacement and parameter fields the Jacobian kept for a linear problem was built with
+  std::array<mfem::Vector, 1 + sizeof...(parameter_space)> linear_jacobian_inputs_;
+
+  /**
+   * @brief For linear problems, discard the Jacobian kept by the equation solver if the timestep, the shape
+   * displacement or a parameter field changed since it was built
+   */
+  void discardStaleLinearJacobian()
+  {
+    if (!is_linear_) {
+      return;
+    }
+
+    auto update = [](mfem::Vector& saved, const mfem::Vector& current) {
+      bool changed = saved.Size() != current.Size() || saved.DistanceTo(current.GetData()) != 0.0;
+      if (changed) {
+        saved = current;
+      }
+      return changed;
+    };
+
+    bool stale          = (dt_ != linear_jacobian_dt_);
+    linear_jacobian_dt_ = dt_;
+
+    stale = update(linear_jacobian_inputs_[0], shape_displacement_) || stale;
+    for (std::size_t i = 0; i < sizeof...(parameter_space); i++) {
+      stale = update(linear_jacobian_inputs_[i + 1], *parameters_[i].state) || stale;
+    }
+
+    if (stale) {
+      nonlin_solver_->resetJacobian();
+    }
+  }
+
+  /**
+   * @brief Start (or stop) constraining the essential boundary condition dofs in the residual and its assembled
+   * Jacobians, while they are evaluated for the nonlinear solver (see Functional::SetEssentialTrueDofs())
+   *
+   * @param constrain whether the evaluations that follow should be constrained
+   */
+  void constrainEssentialDofs(bool constrain)
+  {
+    if (constrain) {
+      residual_->SetEssentialTrueDofs(bcs_.allEssentialTrueDofs());
+    }
+    residual_->constrain_essential_dofs = constrain;
+  }
+
   /// @brief Array functions computing the derivative of the residual with respect to each given parameter
   /// @note This is needed so the user can ask for a specific sensitivity at runtime as opposed to it being a
   /// template parameter.
@@ -775,4 +1504,15 @@ protected:
       }...};
 };
 
+/// @cond
+// The common specializations (orders 1-3, in 2D and 3D) are compiled once, in heat_transfer.cpp, and
+// applications link to them instead of instantiating them again
+extern template class HeatTransfer<1, 2>;
+extern template class HeatTransfer<2, 2>;
+extern template class HeatTransfer<3, 2>;
+extern template class HeatTransfer<1, 3>;
+extern template class HeatTransfer<2, 3>;
+extern template class HeatTransfer<3, 3>;
+/// @endcond
+
 }  // namespace serac
@@ -28,6 +28,16 @@ void HeatTransferInputOptions::defineInputFileSchema(axom::inlet::Container& con
   auto& dynamics_container = container.addStruct("dynamics", "Parameters for mass matrix inversion");
   dynamics_container.addString("timestepper", "Timestepper (ODE) method to use");
   dynamics_container.addString("enforcement_method", "Time-varying constraint enforcement method to use");
+  dynamics_container.addBool("adaptive", "Adapt the timestep to an estimate of the local error").defaultValue(false);
+  dynamics_container.addDouble("error_relative_tol", "Relative tolerance on the local error of adaptive timesteps")
+      .defaultValue(1.0e-4);
+  dynamics_container.addDouble("error_absolute_tol", "Absolute tolerance on the local error of adaptive timesteps")
+      .defaultValue(1.0e-8);
+  dynamics_container
+      .addInt("extrapolation_states", "Number of converged states extrapolated for the initial guess of each solve")
+      .defaultValue(0)
+      .range(0, 3);
+  dynamics_container.addBool("lumped_mass", "Take explicit steps with a lumped heat capacity").defaultValue(false);
 
   auto& bc_container = container.addStructDictionary("boundary_conds", "Container of boundary conditions");
   serac::input::BoundaryConditionInputOptions::defineInputFileSchema(bc_container);
@@ -58,7 +68,11 @@ serac::HeatTransferInputOptions FromInlet<serac::HeatTransferInputOptions>::oper
     const static std::map<std::string, serac::TimestepMethod> timestep_methods = {
         {"AverageAcceleration", serac::TimestepMethod::AverageAcceleration},
         {"BackwardEuler", serac::TimestepMethod::BackwardEuler},
-        {"ForwardEuler", serac::TimestepMethod::ForwardEuler}};
+        {"ForwardEuler", serac::TimestepMethod::ForwardEuler},
+        {"IMEXARS222", serac::TimestepMethod::IMEXARS222},
+        {"IMEXEuler", serac::TimestepMethod::IMEXEuler},
+        {"RK2", serac::TimestepMethod::RK2},
+        {"RK4", serac::TimestepMethod::RK4}};
     std::string timestep_method = dynamics["timestepper"];
     SLIC_ERROR_ROOT_IF(timestep_methods.count(timestep_method) == 0,
                        "Unrecognized timestep method: " << timestep_method);
@@ -72,6 +86,12 @@ serac::HeatTransferInputOptions FromInlet<serac::HeatTransferInputOptions>::oper
                        "Unrecognized enforcement method: " << enforcement_method);
     timestepping_options.enforcement_method = enforcement_methods.at(enforcement_method);
 
+    timestepping_options.adaptive             = dynamics["adaptive"];
+    timestepping_options.error_relative_tol   = dynamics["error_relative_tol"];
+    timestepping_options.error_absolute_tol   = dynamics["error_absolute_tol"];
+    timestepping_options.extrapolation_states = dynamics["extrapolation_states"];
+    timestepping_options.lumped_mass          = dynamics["lumped_mass"];
+
     result.timestepping_options = timestepping_options;
   }
 
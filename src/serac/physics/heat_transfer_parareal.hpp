@@ -0,0 +1,56 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file heat_transfer_parareal.hpp
+ *
+ * @brief The propagators for integrating a transient heat transfer problem in parallel in time
+ */
+
+#pragma once
+
+#include "serac/numerics/parareal.hpp"
+#include "serac/physics/heat_transfer.hpp"
+
+namespace serac {
+
+/**
+ * @brief A Parareal propagator that integrates a heat transfer module over each time slice, in @p num_steps equal
+ * steps of its time integrator
+ *
+ * The fine propagator of a long transient is usually the module of the sequential simulation, taking its usual
+ * timestep. The coarse one is a second module on the same mesh (with the same materials, sources and boundary
+ * conditions) constructed with heat_transfer::default_timestepping_options, i.e. backward Euler, taking a single step
+ * per slice:
+ *
+ * @code{.cpp}
+ * auto [space_comm, time_comm] = splitTimeSlices(MPI_COMM_WORLD, num_slices);
+ * // ... build the mesh on space_comm, and the fine and coarse HeatTransfer modules on it
+ * Parareal parareal(space_comm, time_comm, heatTransferPropagator(fine, steps_per_slice),
+ *                   heatTransferPropagator(coarse, 1));
+ * mfem::Vector temperature(fine.temperature());
+ * parareal.solve(temperature, 0.0, slice_length);
+ * @endcode
+ *
+ * @param[in] physics The heat transfer module, which must outlive the propagator
+ * @param[in] num_steps The number of timesteps per slice
+ * @note The module is left with the temperature at the end of the last slice it propagated
+ */
+template <int order, int dim, typename parameters, typename parameter_indices>
+Propagator heatTransferPropagator(HeatTransfer<order, dim, parameters, parameter_indices>& physics, int num_steps)
+{
+  return [&physics, num_steps](mfem::Vector& temperature, double t, double dt) {
+    physics.temperature().Set(1.0, temperature);
+    physics.setTime(t);
+    for (int i = 0; i < num_steps; i++) {
+      double step = dt / num_steps;
+      physics.advanceTimestep(step);
+    }
+    temperature = physics.temperature();
+  };
+}
+
+}  // namespace serac
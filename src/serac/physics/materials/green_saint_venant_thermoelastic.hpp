@@ -6,6 +6,7 @@
 
 #include "serac/numerics/functional/tensor.hpp"
 #include "serac/numerics/functional/tuple.hpp"
+#include "serac/physics/materials/tabulated_property.hpp"
 
 namespace serac {
 
@@ -186,4 +187,67 @@ struct ParameterizedGreenSaintVenantThermoelasticMaterial {
   }
 };
 
+/**
+ * @brief Green-Saint Venant isotropic thermoelastic model with temperature-dependent properties
+ *
+ * The property curves are tabulated over the expected temperature range when the material is set up
+ * (see TabulatedProperty), so that each quadrature point evaluation only interpolates them.
+ */
+struct TabulatedGreenSaintVenantThermoelasticMaterial {
+  double            density;    ///< density
+  double            nu;         ///< Poisson's ratio
+  double            theta_ref;  ///< datum temperature for thermal expansion
+  TabulatedProperty E;          ///< Young's modulus vs. temperature
+  TabulatedProperty C_v;        ///< volumetric heat capacity vs. temperature
+  TabulatedProperty alpha;      ///< secant thermal expansion coefficient (relative to theta_ref) vs. temperature
+  TabulatedProperty k;          ///< thermal conductivity vs. temperature
+
+  /// internal variables for the material model
+  struct State {
+    double strain_trace;  ///< trace of Green-Saint Venant strain tensor
+  };
+
+  /**
+   * @brief Evaluate constitutive variables for thermomechanics
+   *
+   * @tparam T1 Type of the displacement gradient components (number-like)
+   * @tparam T2 Type of the temperature (number-like)
+   * @tparam T3 Type of the temperature gradient components (number-like)
+   *
+   * @param[in] grad_u Displacement gradient
+   * @param[in] theta Temperature
+   * @param[in] grad_theta Temperature gradient
+   * @param[in,out] state State variables for this material
+   *
+   * @return[out] tuple of constitutive outputs, as for GreenSaintVenantThermoelasticMaterial
+   */
+  template <typename T1, typename T2, typename T3>
+  auto operator()(State& state, const tensor<T1, 3, 3>& grad_u, T2 theta, const tensor<T3, 3>& grad_theta) const
+  {
+    const auto            E_theta = E(theta);
+    const auto            K       = E_theta / (3.0 * (1.0 - 2.0 * nu));
+    const auto            G       = 0.5 * E_theta / (1.0 + nu);
+    const auto            a       = alpha(theta);
+    static constexpr auto I       = Identity<3>();
+    auto                  F       = grad_u + I;
+    const auto            Eg      = greenStrain(grad_u);
+    const auto            trEg    = tr(Eg);
+
+    // stress
+    const auto S     = 2.0 * G * dev(Eg) + K * (trEg - 3.0 * a * (theta - theta_ref)) * I;
+    const auto P     = dot(F, S);
+    const auto sigma = dot(P, transpose(F)) / det(F);
+
+    // internal heat source
+    const auto s0 = -3.0 * K * a * theta * (trEg - state.strain_trace);
+
+    // heat flux
+    const auto q0 = -k(theta) * grad_theta;
+
+    state.strain_trace = get_value(trEg);
+
+    return serac::tuple{sigma, C_v(theta), s0, q0};
+  }
+};
+
 }  // namespace serac
@@ -163,8 +163,7 @@ struct LiquidCrystElastomerBrighenti {
     auto Q     = 0.5 * ((1.0 - q) * I + 3.0 * q * n_dyad);
 
     // Polar decomposition of incremental deformation gradient
-    auto U_hat = matrix_sqrt(transpose(F_hat) * F_hat);
-    auto R_hat = F_hat * inv(U_hat);
+    auto R_hat = get<0>(polar_decomposition(F_hat));
 
     // Distribution tensor (using 'Strang Splitting' approach)
     double alpha  = 2.0 * N_b_squared_ / 3.0;
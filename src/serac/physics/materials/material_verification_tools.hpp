@@ -13,7 +13,9 @@
 #pragma once
 
 #include <functional>
+#include <vector>
 
+#include "serac/infrastructure/accelerator.hpp"
 #include "serac/numerics/functional/tensor.hpp"
 #include "serac/numerics/functional/tuple.hpp"
 
@@ -80,6 +82,89 @@ auto uniaxial_stress_test(double t_max, size_t num_steps, const MaterialType mat
   return output_history;
 }
 
+/**
+ * @brief The responses of a batch of independent material points, each driven through the same number of steps
+ *
+ * The histories are stored contiguously with the steps of a point adjacent, i.e. step `j` of point `i` is at
+ * index `i * num_steps + j`.
+ *
+ * @tparam StateType the state variable collection of the material model
+ */
+template <typename StateType>
+struct MaterialPointHistories {
+  size_t                            num_points;  ///< the number of material points in the batch
+  size_t                            num_steps;   ///< the number of samples in the history of each point
+  std::vector<double>               time;        ///< the time of each sample, shared by all points
+  std::vector<tensor<double, 3, 3>> du_dX;       ///< the displacement gradient of each point at each sample
+  std::vector<tensor<double, 3, 3>> stress;      ///< the stress of each point at each sample
+  std::vector<StateType>            state;       ///< the state variables of each point at each sample
+
+  /// @brief the flat index of step @a j of point @a i in the histories
+  size_t index(size_t i, size_t j) const { return i * num_steps + j; }
+};
+
+/**
+ * @brief Drive a batch of independent material points through uniaxial tension experiments
+ *
+ * This is the batched counterpart of `uniaxial_stress_test`, intended for calibration workflows that
+ * sample many parameter sets or loading paths. Each point gets its own material instance, initial state,
+ * axial strain history and parameter histories, and is solved independently of the others, so the
+ * points are distributed over the OpenMP threads when serac is built with OpenMP.
+ *
+ * @param t_max upper limit of the time interval.
+ * @param num_steps The number of discrete time points at which the response is sampled (uniformly spaced).
+ *        This is inclusive of the point at time zero.
+ * @param materials The material model of each point
+ * @param initial_states The initial state variable collection of each point, of the same length as @a materials
+ * @param epsilon_xx A function `(point, t)` describing the axial displacement gradient of each point as a
+ *        function of time.
+ * @param parameter_functions Pack of functions `(point, t)` that return each parameter of each point as a
+ *        function of time. Leave empty if the material has no parameters.
+ * @return the stress-strain histories of all points, contiguous in memory
+ *
+ * @note the material models and parameter functions are evaluated concurrently, and must be thread-safe
+ */
+template <typename MaterialType, typename StateType, typename... parameter_types>
+auto batched_uniaxial_stress_test(double t_max, size_t num_steps, const std::vector<MaterialType>& materials,
+                                  const std::vector<StateType>&         initial_states,
+                                  std::function<double(size_t, double)> epsilon_xx,
+                                  const parameter_types... parameter_functions)
+{
+  SLIC_ERROR_IF(materials.size() != initial_states.size(),
+                "batched_uniaxial_stress_test: need exactly one initial state per material point");
+
+  const size_t                      num_points = materials.size();
+  MaterialPointHistories<StateType> histories{num_points,
+                                              num_steps,
+                                              std::vector<double>(num_steps),
+                                              std::vector<tensor<double, 3, 3>>(num_points * num_steps),
+                                              std::vector<tensor<double, 3, 3>>(num_points * num_steps),
+                                              std::vector<StateType>(num_points * num_steps)};
+
+  double       t  = 0;
+  const double dt = t_max / double(num_steps - 1);
+  for (size_t j = 0; j < num_steps; j++) {
+    histories.time[j] = t;
+    t += dt;
+  }
+
+  // each iteration writes only to the slice of the histories owned by its point
+  SERAC_OMP_PARALLEL_FOR
+  for (size_t i = 0; i < num_points; i++) {
+    auto response = uniaxial_stress_test(
+        t_max, num_steps, materials[i], initial_states[i], [&epsilon_xx, i](double time) { return epsilon_xx(i, time); },
+        [&, i](double time) { return parameter_functions(i, time); }...);
+
+    for (size_t j = 0; j < num_steps; j++) {
+      histories.du_dX[histories.index(i, j)]  = get<1>(response[j]);
+      histories.stress[histories.index(i, j)] = get<2>(response[j]);
+      histories.state[histories.index(i, j)]  = get<3>(response[j]);
+    }
+  }
+
+  return histories;
+}
+
 /**
  * @brief This function takes a material model (and associate state variables),
  *        subjects it to a time history of stimuli, described by `functions ... f`,
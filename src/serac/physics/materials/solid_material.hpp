@@ -12,11 +12,43 @@
 
 #pragma once
 
+#include <cmath>
+#include <tuple>
+#include <type_traits>
+
+#include "serac/serac_config.hpp"
 #include "serac/numerics/functional/functional.hpp"
 
 /// SolidMechanics helper data types
 namespace serac::solid_mechanics {
 
+/**
+ * @brief Whether a material has the `density`, bulk modulus `K` and shear modulus `G` members needed to
+ * estimate its wave speed
+ */
+template <typename T, typename = void>
+struct has_wave_speed : std::false_type {
+};
+
+/// @overload
+template <typename T>
+struct has_wave_speed<T, std::void_t<decltype(T::density), decltype(T::K), decltype(T::G)>> : std::true_type {
+};
+
+/**
+ * @brief The dilatational (P-) wave speed of a material in its reference configuration, sqrt((K + 4/3 G) / density),
+ * which is the fastest wave speed of an isotropic material
+ *
+ * @tparam MaterialType a material type satisfying has_wave_speed
+ * @param material the material
+ * @return the wave speed
+ */
+template <typename MaterialType>
+double waveSpeed(const MaterialType& material)
+{
+  return std::sqrt((material.K + 4.0 / 3.0 * material.G) / material.density);
+}
+
 /**
  * @brief Linear isotropic elasticity material model
  *
@@ -44,6 +76,31 @@ struct LinearIsotropic {
     return lambda * tr(epsilon) * I + 2.0 * G * epsilon;
   }
 
+  /**
+   * @brief closed-form material tangent, d(stress)/d(du_dX), of the linear isotropic model
+   *
+   * @tparam dim Dimensionality of space
+   * @param du_dX Displacement gradient with respect to the reference configuration
+   * @return The fourth-order tangent C, where C(i, j, k, l) = d(sigma(i, j)) / d(du_dX(k, l))
+   */
+  template <int dim>
+  SERAC_HOST_DEVICE auto tangent(State& /* state */, const tensor<double, dim, dim>& /* du_dX */) const
+  {
+    constexpr auto                     I      = Identity<dim>();
+    auto                               lambda = K - (2.0 / 3.0) * G;
+    tensor<double, dim, dim, dim, dim> C{};
+    for (int i = 0; i < dim; i++) {
+      for (int j = 0; j < dim; j++) {
+        for (int k = 0; k < dim; k++) {
+          for (int l = 0; l < dim; l++) {
+            C[i][j][k][l] = lambda * I[i][j] * I[k][l] + G * (I[i][k] * I[j][l] + I[i][l] * I[j][k]);
+          }
+        }
+      }
+    }
+    return C;
+  }
+
   double density;  ///< mass density
   double K;        ///< bulk modulus
   double G;        ///< shear modulus
@@ -120,11 +177,122 @@ struct NeoHookean {
     return (lambda * log(J) * I + G * B_minus_I) / J;
   }
 
+  /**
+   * @brief closed-form material tangent, d(stress)/d(du_dX), of the NeoHookean model
+   *
+   * @tparam dim Dimensionality of space
+   * @param du_dX displacement gradient with respect to the reference configuration (displacement_grad)
+   * @return The fourth-order tangent C, where C(i, j, k, l) = d(sigma(i, j)) / d(du_dX(k, l))
+   */
+  template <int dim>
+  SERAC_HOST_DEVICE auto tangent(State& /* state */, const tensor<double, dim, dim>& du_dX) const
+  {
+    using std::log;
+    constexpr auto I      = Identity<dim>();
+    auto           lambda = K - (2.0 / 3.0) * G;
+    auto           F      = I + du_dX;
+    auto           J      = det(F);
+    auto           Finv   = inv(F);
+    auto           sigma  = (lambda * log(J) * I + G * (du_dX * transpose(du_dX) + transpose(du_dX) + du_dX)) / J;
+
+    // d(J)/d(F_kl) = J * Finv_lk and d(B_ij)/d(F_kl) = delta_ik F_jl + F_il delta_jk
+    tensor<double, dim, dim, dim, dim> C{};
+    for (int i = 0; i < dim; i++) {
+      for (int j = 0; j < dim; j++) {
+        for (int k = 0; k < dim; k++) {
+          for (int l = 0; l < dim; l++) {
+            C[i][j][k][l] = (lambda * I[i][j] * Finv[l][k] + G * (I[i][k] * F[j][l] + F[i][l] * I[j][k])) / J -
+                            sigma[i][j] * Finv[l][k];
+          }
+        }
+      }
+    }
+    return C;
+  }
+
   double density;  ///< mass density
   double K;        ///< bulk modulus
   double G;        ///< shear modulus
 };
 
+/**
+ * @brief Whether a material provides a closed-form `tangent(state, du_dX, params...)` returning the derivative of
+ * its stress with respect to the displacement gradient
+ *
+ * @tparam MaterialType the material model
+ * @tparam StateType the internal variables of the material
+ * @tparam dim Dimensionality of space
+ * @tparam ParamTypes a std::tuple of the (non-dual) parameter types passed to the material
+ */
+template <typename MaterialType, typename StateType, int dim, typename ParamTypes, typename = void>
+struct has_tangent : std::false_type {
+};
+
+/// @overload
+template <typename MaterialType, typename StateType, int dim, typename... ParamTypes>
+struct has_tangent<MaterialType, StateType, dim, std::tuple<ParamTypes...>,
+                   std::void_t<decltype(std::declval<const MaterialType&>().tangent(
+                       std::declval<StateType&>(), std::declval<tensor<double, dim, dim>>(),
+                       std::declval<ParamTypes>()...))>> : std::true_type {
+};
+
+/**
+ * @brief Evaluate the stress of a material model, using its closed-form tangent in place of dual-number
+ * differentiation when one is available
+ *
+ * When @p du_dX carries derivatives, the parameters do not, and the material satisfies has_tangent, the stress is
+ * evaluated with doubles and its derivatives are assembled from the chain rule dsigma = C : d(du_dX). Otherwise,
+ * this is the same as calling the material directly. The tangent is evaluated before the stress, so it sees the
+ * internal variables from before they are updated.
+ *
+ * In debug builds, the closed-form tangent is checked against the one computed by automatic differentiation.
+ *
+ * @param material the material model
+ * @param state the internal variables of the material
+ * @param du_dX the displacement gradient with respect to the reference configuration
+ * @param params the parameters of the material
+ * @return The Cauchy stress
+ */
+template <typename MaterialType, typename StateType, typename T, int dim, typename... ParamTypes>
+SERAC_HOST_DEVICE auto evaluateStress(const MaterialType& material, StateType& state, const tensor<T, dim, dim>& du_dX,
+                                      const ParamTypes&... params)
+{
+  constexpr bool params_are_values = (std::is_same_v<ParamTypes, decltype(get_value(params))> && ...);
+  if constexpr (is_dual_number<T>::value && params_are_values &&
+                has_tangent<MaterialType, StateType, dim, std::tuple<ParamTypes...>>::value) {
+    auto H = get_value(du_dX);
+
+#if defined(SERAC_DEBUG) && !defined(__CUDA_ARCH__)
+    StateType state_copy = state;
+    auto      C_AD       = get_gradient(material(state_copy, make_dual(H), params...));
+#endif
+
+    auto C     = material.tangent(state, H, params...);
+    auto sigma = material(state, H, params...);
+
+#if defined(SERAC_DEBUG) && !defined(__CUDA_ARCH__)
+    SLIC_WARNING_IF(norm(C - C_AD) > 1.0e-8 * (1.0 + norm(C_AD)),
+                    axom::fmt::format("closed-form material tangent differs from automatic differentiation by {}",
+                                      norm(C - C_AD)));
+#endif
+
+    tensor<T, dim, dim> stress{};
+    for (int i = 0; i < dim; i++) {
+      for (int j = 0; j < dim; j++) {
+        stress[i][j].value = sigma[i][j];
+        for (int k = 0; k < dim; k++) {
+          for (int l = 0; l < dim; l++) {
+            stress[i][j].gradient = stress[i][j].gradient + C[i][j][k][l] * du_dX[k][l].gradient;
+          }
+        }
+      }
+    }
+    return stress;
+  } else {
+    return material(state, du_dX, params...);
+  }
+}
+
 /**
  * @brief Power-law isotropic hardening law
  */
@@ -293,6 +461,134 @@ struct J2 {
   }
 };
 
+/**
+ * @brief The von Mises measure sqrt(3/2) |s| of a deviatoric stress, regularized by a tiny fraction of the yield
+ * stress so that its derivatives exist at s = 0, for the branch-free return mappings
+ *
+ * The regularization only changes the result where s is below 1e-12 sigma_y, i.e. never at a plastic point.
+ */
+template <typename T>
+SERAC_HOST_DEVICE auto regularized_mises(const tensor<T, 3, 3>& s, double sigma_y)
+{
+  using std::sqrt;
+  double epsilon = 1.0e-12 * sigma_y;
+  return sqrt(1.5 * squared_norm(s) + epsilon * epsilon);
+}
+
+/**
+ * @brief J2 with linear isotropic and kinematic hardening, like J2, with a return mapping that doesn't branch on
+ * the elastic / plastic state of the point
+ *
+ * The closed-form plastic strain increment (7.207) is masked with max(phi, 0), so elastic points take the same
+ * arithmetic path as plastic ones with a zero increment. The results are those of J2 to rounding, and the same
+ * instructions run at every quadrature point, e.g. in the lanes of a simd pack and the threads of a GPU warp.
+ */
+struct J2BranchFree {
+  /// this material is written for 3D
+  static constexpr int dim = 3;
+
+  double E;        ///< Young's modulus
+  double nu;       ///< Poisson's ratio
+  double Hi;       ///< isotropic hardening constant
+  double Hk;       ///< kinematic hardening constant
+  double sigma_y;  ///< yield stress
+  double density;  ///< mass density
+
+  /// @brief variables required to characterize the hysteresis response
+  using State = J2::State;
+
+  /** @brief calculate the Cauchy stress, given the displacement gradient and previous material state */
+  template <typename T>
+  auto operator()(State& state, const T du_dX) const
+  {
+    using std::max;
+    using std::sqrt;
+    constexpr auto I = Identity<3>();
+    const double   K = E / (3.0 * (1.0 - 2.0 * nu));
+    const double   G = 0.5 * E / (1.0 + nu);
+
+    // (i) elastic predictor
+    auto el_strain = sym(du_dX) - state.plastic_strain;
+    auto p         = K * tr(el_strain);
+    auto s         = 2.0 * G * dev(el_strain);
+    auto eta       = s - state.beta;
+    auto q         = regularized_mises(eta, sigma_y);
+    auto phi       = q - (sigma_y + Hi * state.accumulated_plastic_strain);
+
+    // (ii) admissibility, as a mask: the increment is zero at elastic points
+    auto plastic_strain_inc = max(phi, 0.0) / (3 * G + Hk + Hi);
+
+    // (iii) return mapping, with normalize(eta) = sqrt(3/2) eta / q
+    auto eta_hat = sqrt(1.5) * eta / q;
+    s            = s - sqrt(6.0) * G * plastic_strain_inc * eta_hat;
+    state.accumulated_plastic_strain += get_value(plastic_strain_inc);
+    state.plastic_strain += sqrt(3.0 / 2.0) * get_value(plastic_strain_inc) * get_value(eta_hat);
+    state.beta = state.beta + sqrt(2.0 / 3.0) * Hk * get_value(plastic_strain_inc) * get_value(eta_hat);
+
+    return s + p * I;
+  }
+};
+
+/**
+ * @brief J2 with nonlinear isotropic hardening, like J2Nonlinear, with a return mapping that doesn't branch on the
+ * elastic / plastic state of the point or on the convergence of its Newton iterations
+ *
+ * The consistency condition is solved with a fixed number of Newton iterations, each masked with max(., 0), so
+ * elastic points stay at a zero increment. For a concave hardening law (e.g. PowerLawHardening with n >= 1 and
+ * VoceHardening), the consistency condition is convex and decreasing, so the iterates approach the root from below
+ * and converge quadratically: the default iteration count reaches the tolerance of J2Nonlinear. Since the slope of
+ * each iteration is computed from the values alone, the derivatives of the result are those of the converged
+ * increment (as from the implicit function theorem in J2Nonlinear).
+ *
+ * @tparam HardeningType the flow stress hardening model
+ * @tparam iterations the number of Newton iterations
+ */
+template <typename HardeningType, int iterations = 12>
+struct J2NonlinearBranchFree {
+  static constexpr int dim = 3;  ///< spatial dimension
+
+  double        E;          ///< Young's modulus
+  double        nu;         ///< Poisson's ratio
+  HardeningType hardening;  ///< Flow stress hardening model
+  double        density;    ///< mass density
+
+  /// @brief variables required to characterize the hysteresis response
+  using State = typename J2Nonlinear<HardeningType>::State;
+
+  /** @brief calculate the Cauchy stress, given the displacement gradient and previous material state */
+  template <typename T>
+  auto operator()(State& state, const T du_dX) const
+  {
+    using std::max;
+    constexpr auto I = Identity<dim>();
+    const double   K = E / (3.0 * (1.0 - 2.0 * nu));
+    const double   G = 0.5 * E / (1.0 + nu);
+
+    // (i) elastic predictor
+    auto el_strain = sym(du_dX) - state.plastic_strain;
+    auto p         = K * tr(el_strain);
+    auto s         = 2.0 * G * dev(el_strain);
+    auto q         = regularized_mises(s, hardening.sigma_y);
+
+    // (ii) admissibility and (iii) return mapping, as masked Newton iterations from a zero increment
+    const double eqps_old   = state.accumulated_plastic_strain;
+    auto         delta_eqps = 0.0 * q;
+    for (int k = 0; k < iterations; k++) {
+      auto   residual = q - 3.0 * G * delta_eqps - hardening(eqps_old + delta_eqps);
+      double slope    = 3.0 * G + hardening(make_dual(eqps_old + get_value(delta_eqps))).gradient;
+      delta_eqps      = max(delta_eqps + residual / slope, 0.0);
+    }
+
+    auto Np = 1.5 * s / q;
+
+    s = s - 2.0 * G * delta_eqps * Np;
+    state.accumulated_plastic_strain += get_value(delta_eqps);
+    state.plastic_strain += get_value(delta_eqps) * get_value(Np);
+
+    return s + p * I;
+  }
+};
+
 /**
  * @brief Transform the Kirchhoff stress to the Piola stress
  *
@@ -0,0 +1,111 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file tabulated_property.hpp
+ *
+ * @brief Interpolation tables that stand in for expensive material property curves
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "serac/infrastructure/logger.hpp"
+#include "serac/numerics/functional/dual.hpp"
+#include "serac/numerics/functional/tensor.hpp"
+
+namespace serac {
+
+/**
+ * @brief A scalar property curve f(x), tabulated over a bounded interval at construction
+ *
+ * The interval is split into uniform cells, and f is replaced on each cell by the cubic Hermite
+ * interpolant of its values and slopes at the cell ends. The interpolant is C1 continuous and
+ * fourth-order accurate, and evaluating it costs one cell lookup and a Horner evaluation of
+ * four contiguous coefficients, however expensive the original curve was.
+ *
+ * Calls with `dual` arguments propagate derivatives through the interpolant, so a tabulated
+ * property can be used in place of the original expression inside material models.
+ * Arguments outside the tabulated interval are extrapolated with the polynomial of the nearest end cell.
+ */
+class TabulatedProperty {
+ public:
+  /// @brief An empty table, to be assigned a tabulated curve before use
+  TabulatedProperty() = default;
+
+  /**
+   * @brief Tabulate a property curve
+   *
+   * @tparam func the type of the property curve
+   * @param f the property curve, which must be callable with `dual<double>`, so that its slopes can be
+   *        sampled with automatic differentiation
+   * @param lower the lower end of the tabulated interval
+   * @param upper the upper end of the tabulated interval
+   * @param num_cells the number of uniform cells in the table
+   */
+  template <typename func>
+  TabulatedProperty(func f, double lower, double upper, int num_cells = 64)
+      : lower_(lower), h_((upper - lower) / num_cells), inv_h_(num_cells / (upper - lower))
+  {
+    SLIC_ERROR_ROOT_IF(!(upper > lower), "TabulatedProperty: the upper end of the interval must exceed the lower");
+    SLIC_ERROR_ROOT_IF(num_cells < 1, "TabulatedProperty: the table needs at least one cell");
+
+    // value and slope with respect to the cell coordinate s = (x - x_i) / h
+    auto sample = [&](double x) {
+      auto fx = f(make_dual(x));
+      return tensor<double, 2>{fx.value, fx.gradient * h_};
+    };
+
+    coefficients_.resize(static_cast<size_t>(num_cells));
+    auto left = sample(lower);
+    for (int i = 0; i < num_cells; i++) {
+      auto right = sample(lower + (i + 1) * h_);
+
+      auto [f0, m0]                         = left;
+      auto [f1, m1]                         = right;
+      coefficients_[static_cast<size_t>(i)] = {f0, m0, 3.0 * (f1 - f0) - 2.0 * m0 - m1, 2.0 * (f0 - f1) + m0 + m1};
+
+      left = right;
+    }
+  }
+
+  /**
+   * @brief Evaluate the tabulated curve
+   *
+   * @tparam T the type of the argument (`double` or `dual`)
+   * @param x where to evaluate the curve
+   */
+  template <typename T>
+  auto operator()(const T& x) const
+  {
+    SLIC_ASSERT_MSG(!coefficients_.empty(), "TabulatedProperty: evaluating an empty table");
+
+    const int last = static_cast<int>(coefficients_.size()) - 1;
+    const int i    = std::clamp(static_cast<int>(std::floor((get_value(x) - lower_) * inv_h_)), 0, last);
+
+    const auto& c = coefficients_[static_cast<size_t>(i)];
+    auto        s = (x - (lower_ + i * h_)) * inv_h_;
+    return c[0] + s * (c[1] + s * (c[2] + s * c[3]));
+  }
+
+ private:
+  /// the lower end of the tabulated interval
+  double lower_ = 0.0;
+
+  /// the width of each cell
+  double h_ = 1.0;
+
+  /// the reciprocal of the cell width
+  double inv_h_ = 1.0;
+
+  /// the coefficients of the cubic polynomial in the cell coordinate on each cell
+  std::vector<tensor<double, 4> > coefficients_;
+};
+
+}  // namespace serac
@@ -0,0 +1,235 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file benchmark_materials.cpp
+ *
+ * @brief times the evaluation of each material model at a single point and over an array of points, with double
+ * inputs (residual evaluations) and dual number inputs (the derivatives for the Jacobian), to measure the overhead
+ * of automatic differentiation and catch regressions in the cost of a material
+ */
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "axom/slic/core/SimpleLogger.hpp"
+
+#include "serac/physics/materials/solid_material.hpp"
+#include "serac/physics/materials/liquid_crystal_elastomer.hpp"
+#include "serac/physics/materials/green_saint_venant_thermoelastic.hpp"
+#include "serac/physics/materials/thermal_material.hpp"
+
+using namespace serac;
+
+/// @brief the number of points in the batched benchmarks, about as many as the quadrature points of a few elements
+static constexpr int num_points = 1000;
+
+/// @brief a displacement gradient large enough to yield the plasticity models (so they run their return maps)
+static constexpr tensor<double, 3, 3> displacement_grad{
+    {{0.120, -0.034, 0.051}, {0.027, -0.083, 0.016}, {-0.042, 0.068, 0.094}}};
+
+/// @brief a temperature gradient, for the thermal conductors
+static constexpr tensor<double, 3> temperature_grad{1.0, -2.0, 0.5};
+
+/// @brief the input of a material at point i of a batch: a slightly different multiple of `x` at each point
+template <bool dual, typename T>
+auto input(const T& x, int i)
+{
+  T x_i = (1.0 + 1.0e-3 * double(i % 17)) * x;
+  if constexpr (dual) {
+    return make_dual(x_i);
+  } else {
+    return x_i;
+  }
+}
+
+/**
+ * @brief time one evaluation of a material at a single point
+ *
+ * @param state the benchmark state
+ * @param material evaluates the material, given (a copy of) its state and the varying input
+ * @param material_state the state of the material before each evaluation, which is copied so that every
+ * evaluation does the same work (e.g. each one runs the return map of a plasticity model)
+ * @param x the varying input (e.g. the displacement gradient)
+ */
+template <bool dual, typename material_type, typename state_type, typename T>
+void point_benchmark(benchmark::State& state, const material_type& material, const state_type& material_state,
+                     const T& x)
+{
+  auto x_0 = input<dual>(x, 0);
+  for (auto _ : state) {
+    state_type s      = material_state;
+    auto       output = material(s, x_0);
+    benchmark::DoNotOptimize(output);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+/// @brief time the evaluations of a material over an array of points, see point_benchmark()
+template <bool dual, typename material_type, typename state_type, typename T>
+void batch_benchmark(benchmark::State& state, const material_type& material, const state_type& material_state,
+                     const T& x)
+{
+  using input_type  = decltype(input<dual>(x, 0));
+  using output_type = decltype(material(std::declval<state_type&>(), std::declval<const input_type&>()));
+
+  std::vector<input_type> inputs;
+  for (int i = 0; i < num_points; i++) {
+    inputs.push_back(input<dual>(x, i));
+  }
+  std::vector<state_type>  states(num_points, material_state);
+  std::vector<output_type> outputs(num_points);
+
+  for (auto _ : state) {
+    for (int i = 0; i < num_points; i++) {
+      state_type s            = states[std::size_t(i)];
+      outputs[std::size_t(i)] = material(s, inputs[std::size_t(i)]);
+    }
+    benchmark::DoNotOptimize(outputs.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * num_points);
+}
+
+/**
+ * @brief register the single point and batched benchmarks of a material, with double and dual inputs, named
+ * "<name>/<double or dual>/<point or batch>"
+ */
+template <typename material_type, typename state_type, typename T>
+void register_material(const std::string& name, material_type material, state_type material_state, T x)
+{
+  benchmark::RegisterBenchmark((name + "/double/point").c_str(), [=](benchmark::State& state) {
+    point_benchmark<false>(state, material, material_state, x);
+  });
+  benchmark::RegisterBenchmark((name + "/dual/point").c_str(), [=](benchmark::State& state) {
+    point_benchmark<true>(state, material, material_state, x);
+  });
+  benchmark::RegisterBenchmark((name + "/double/batch").c_str(), [=](benchmark::State& state) {
+    batch_benchmark<false>(state, material, material_state, x);
+  });
+  benchmark::RegisterBenchmark((name + "/dual/batch").c_str(), [=](benchmark::State& state) {
+    batch_benchmark<true>(state, material, material_state, x);
+  });
+}
+
+/// @brief register the benchmarks of a solid material whose only input is the displacement gradient
+template <typename material_type>
+void register_solid_material(const std::string& name, material_type material)
+{
+  register_material(
+      name, [material](typename material_type::State& s, const auto& du_dX) { return material(s, du_dX); },
+      typename material_type::State{}, displacement_grad);
+}
+
+void register_benchmarks()
+{
+  register_solid_material("LinearIsotropic", solid_mechanics::LinearIsotropic{.density = 1.0, .K = 1.3, .G = 0.7});
+  register_solid_material("StVenantKirchhoff", solid_mechanics::StVenantKirchhoff{.density = 1.0, .K = 1.3, .G = 0.7});
+  register_solid_material("NeoHookean", solid_mechanics::NeoHookean{.density = 1.0, .K = 1.3, .G = 0.7});
+
+  register_solid_material(
+      "J2", solid_mechanics::J2{.E = 100.0, .nu = 0.25, .Hi = 1.0, .Hk = 0.1, .sigma_y = 1.0, .density = 1.0});
+
+  register_solid_material("J2BranchFree", solid_mechanics::J2BranchFree{.E       = 100.0,
+                                                                        .nu      = 0.25,
+                                                                        .Hi      = 1.0,
+                                                                        .Hk      = 0.1,
+                                                                        .sigma_y = 1.0,
+                                                                        .density = 1.0});
+
+  using PowerLawJ2 = solid_mechanics::J2Nonlinear<solid_mechanics::PowerLawHardening>;
+  register_solid_material(
+      "J2Nonlinear<PowerLawHardening>",
+      PowerLawJ2{.E = 100.0, .nu = 0.25, .hardening = {.sigma_y = 1.0, .n = 2.0, .eps0 = 0.01}, .density = 1.0});
+
+  using BranchFreePowerLawJ2 = solid_mechanics::J2NonlinearBranchFree<solid_mechanics::PowerLawHardening>;
+  register_solid_material(
+      "J2NonlinearBranchFree<PowerLawHardening>",
+      BranchFreePowerLawJ2{
+          .E = 100.0, .nu = 0.25, .hardening = {.sigma_y = 1.0, .n = 2.0, .eps0 = 0.01}, .density = 1.0});
+
+  using VoceJ2 = solid_mechanics::J2Nonlinear<solid_mechanics::VoceHardening>;
+  register_solid_material(
+      "J2Nonlinear<VoceHardening>",
+      VoceJ2{.E         = 100.0,
+             .nu        = 0.25,
+             .hardening = {.sigma_y = 1.0, .sigma_sat = 2.0, .strain_constant = 0.01},
+             .density   = 1.0});
+
+  // the liquid crystal elastomers also read the temperature (or order parameter) and orientation angles, which are
+  // (value, gradient) tuples like the parameters of a residual, but only the displacement gradient is differentiated
+  {
+    LiquidCrystElastomerBrighenti material(1.0, 1.0e5, 1.0e7, 10.0, 0.4, 348.0, 1.0);
+    auto evaluate = [material](LiquidCrystElastomerBrighenti::State& s, const auto& du_dX) {
+      return material(s, du_dX, tuple{300.0, tensor<double, 3>{}}, tuple{0.5, tensor<double, 3>{}});
+    };
+
+    // the first evaluation initializes the state (from the undeformed configuration)
+    LiquidCrystElastomerBrighenti::State state{};
+    evaluate(state, tensor<double, 3, 3>{});
+    register_material("LiquidCrystElastomerBrighenti", evaluate, state, displacement_grad);
+  }
+
+  {
+    LiquidCrystalElastomerBertoldi material(1.0, 1.0e5, 0.45, 0.4, 5.0e4);
+    register_material(
+        "LiquidCrystalElastomerBertoldi",
+        [material](LiquidCrystalElastomerBertoldi::State& s, const auto& du_dX) {
+          return material(s, du_dX, tuple{0.3, tensor<double, 3>{}}, tuple{0.5, tensor<double, 3>{}},
+                          tuple{0.1, tensor<double, 3>{}});
+        },
+        LiquidCrystalElastomerBertoldi::State{}, displacement_grad);
+  }
+
+  {
+    GreenSaintVenantThermoelasticMaterial material{.density   = 1.0,
+                                                   .E         = 100.0,
+                                                   .nu        = 0.25,
+                                                   .C_v       = 1.0,
+                                                   .alpha     = 1.0e-3,
+                                                   .theta_ref = 300.0,
+                                                   .k         = 1.0};
+    register_material(
+        "GreenSaintVenantThermoelasticMaterial",
+        [material](GreenSaintVenantThermoelasticMaterial::State& s, const auto& du_dX) {
+          return material(s, du_dX, 330.0, temperature_grad);
+        },
+        GreenSaintVenantThermoelasticMaterial::State{0.001}, displacement_grad);
+  }
+
+  // the conductors have no state, and their input is the temperature gradient
+  {
+    heat_transfer::LinearIsotropicConductor material(1.0, 1.0, 1.5);
+    register_material(
+        "LinearIsotropicConductor",
+        [material](Empty&, const auto& dT_dX) { return material(tensor<double, 3>{}, 300.0, dT_dX); }, Empty{},
+        temperature_grad);
+  }
+
+  {
+    heat_transfer::LinearConductor<3> material(1.0, 1.0, {{{1.5, 0.1, 0.0}, {0.1, 2.0, 0.2}, {0.0, 0.2, 1.0}}});
+    register_material(
+        "LinearConductor",
+        [material](Empty&, const auto& dT_dX) { return material(tensor<double, 3>{}, 300.0, dT_dX); }, Empty{},
+        temperature_grad);
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  ::benchmark::Initialize(&argc, argv);
+
+  axom::slic::SimpleLogger logger;  // create & initialize test logger, finalized when
+                                    // exiting main scope
+
+  register_benchmarks();
+  ::benchmark::RunSpecifiedBenchmarks();
+
+  return 0;
+}
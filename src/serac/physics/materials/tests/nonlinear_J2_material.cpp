@@ -77,6 +77,106 @@ TEST(NonlinearJ2Material, Uniaxial)
   }
 };
 
+TEST(NonlinearJ2Material, BatchedUniaxialMatchesSinglePoint)
+{
+  using Material = solid_mechanics::J2Nonlinear<solid_mechanics::PowerLawHardening>;
+
+  // a small calibration sweep over the yield stress, with a different loading rate for each point
+  std::vector<Material>        materials;
+  std::vector<Material::State> initial_states;
+  for (double sigma_y : {0.005, 0.01, 0.02, 0.04}) {
+    solid_mechanics::PowerLawHardening hardening{.sigma_y = sigma_y, .n = 2.0, .eps0 = 0.01};
+    materials.push_back(Material{.E = 1.0, .nu = 0.25, .hardening = hardening, .density = 1.0});
+    initial_states.push_back(Material::State{});
+  }
+  auto strain = [](size_t i, double t) { return 0.01 * double(i + 1) * t; };
+
+  auto histories = batched_uniaxial_stress_test(2.0, 5, materials, initial_states, strain);
+  ASSERT_EQ(histories.stress.size(), materials.size() * 5);
+
+  for (size_t i = 0; i < materials.size(); i++) {
+    auto response_history = uniaxial_stress_test(2.0, 5, materials[i], initial_states[i],
+                                                 [&strain, i](double t) { return strain(i, t); });
+    for (size_t j = 0; j < 5; j++) {
+      EXPECT_DOUBLE_EQ(histories.time[j], get<0>(response_history[j]));
+      EXPECT_LT(norm(histories.du_dX[histories.index(i, j)] - get<1>(response_history[j])), 1e-14);
+      EXPECT_LT(norm(histories.stress[histories.index(i, j)] - get<2>(response_history[j])), 1e-14);
+    }
+  }
+};
+
+/// @brief a loading, unloading and reverse loading path through a general displacement gradient
+tensor<double, 3, 3> cyclic_displacement_gradient(double t)
+{
+  tensor<double, 3, 3> A{{{0.7551559, 0.3129729, 0.12388372}, {0.548188, 0.8851279, 0.30576992},
+                          {0.82008433, 0.95633745, 0.3566252}}};
+  return 0.05 * std::sin(3.0 * t) * A;
+}
+
+/**
+ * @brief Compare the stress, tangent and internal variables of two materials with the same State along
+ * cyclic_displacement_gradient(), including the undeformed configuration
+ */
+template <typename Material, typename BranchFreeMaterial>
+void expect_same_response(const Material& material, const BranchFreeMaterial& branch_free, double tol)
+{
+  typename Material::State state{};
+  typename Material::State branch_free_state{};
+
+  for (int i = 0; i <= 40; i++) {
+    auto du_dX = cyclic_displacement_gradient(0.1 * i);
+
+    // the tangents are evaluated on copies, since each evaluation updates the state
+    auto state_copy             = state;
+    auto branch_free_state_copy = branch_free_state;
+    auto tangent                = get_gradient(material(state_copy, make_dual(du_dX)));
+    auto branch_free_tangent    = get_gradient(branch_free(branch_free_state_copy, make_dual(du_dX)));
+
+    auto stress             = material(state, du_dX);
+    auto branch_free_stress = branch_free(branch_free_state, du_dX);
+
+    double scale = std::max(norm(stress), 1.0e-3);
+    EXPECT_LT(norm(stress - branch_free_stress), tol * scale);
+    EXPECT_LT(norm(tangent - branch_free_tangent), tol * norm(tangent));
+    EXPECT_NEAR(state.accumulated_plastic_strain, branch_free_state.accumulated_plastic_strain, tol);
+    EXPECT_LT(norm(state.plastic_strain - branch_free_state.plastic_strain), tol);
+  }
+
+  // the path yields, so the masked return mapping is exercised on plastic points as well
+  EXPECT_GT(state.accumulated_plastic_strain, 0.0);
+}
+
+TEST(NonlinearJ2Material, BranchFreeMatchesReturnMapping)
+{
+  solid_mechanics::PowerLawHardening hardening{.sigma_y = 0.01, .n = 2.0, .eps0 = 0.01};
+  solid_mechanics::J2Nonlinear<solid_mechanics::PowerLawHardening> material{
+      .E = 1.0, .nu = 0.25, .hardening = hardening, .density = 1.0};
+  solid_mechanics::J2NonlinearBranchFree<solid_mechanics::PowerLawHardening> branch_free{
+      .E = 1.0, .nu = 0.25, .hardening = hardening, .density = 1.0};
+
+  expect_same_response(material, branch_free, 1.0e-8);
+}
+
+TEST(NonlinearJ2Material, BranchFreeVoceMatchesReturnMapping)
+{
+  solid_mechanics::VoceHardening hardening{.sigma_y = 0.01, .sigma_sat = 0.02, .strain_constant = 0.01};
+  solid_mechanics::J2Nonlinear<solid_mechanics::VoceHardening> material{
+      .E = 1.0, .nu = 0.25, .hardening = hardening, .density = 1.0};
+  solid_mechanics::J2NonlinearBranchFree<solid_mechanics::VoceHardening> branch_free{
+      .E = 1.0, .nu = 0.25, .hardening = hardening, .density = 1.0};
+
+  expect_same_response(material, branch_free, 1.0e-8);
+}
+
+TEST(NonlinearJ2Material, BranchFreeLinearHardeningMatchesJ2)
+{
+  solid_mechanics::J2 material{.E = 1.0, .nu = 0.25, .Hi = 0.01, .Hk = 0.005, .sigma_y = 0.01, .density = 1.0};
+  solid_mechanics::J2BranchFree branch_free{
+      .E = 1.0, .nu = 0.25, .Hi = 0.01, .Hk = 0.005, .sigma_y = 0.01, .density = 1.0};
+
+  expect_same_response(material, branch_free, 1.0e-12);
+}
+
 }  // namespace serac
 
 int main(int argc, char* argv[])
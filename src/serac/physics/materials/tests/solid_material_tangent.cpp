@@ -0,0 +1,64 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file solid_material_tangent.cpp
+ *
+ * @brief unit tests comparing the closed-form solid material tangents against automatic differentiation
+ */
+
+#include "axom/slic/core/SimpleLogger.hpp"
+#include <gtest/gtest.h>
+
+#include "serac/physics/materials/solid_material.hpp"
+
+namespace serac {
+
+static constexpr tensor<double, 3, 3> displacement_grad{
+    {{0.120, -0.034, 0.051}, {0.027, -0.083, 0.016}, {-0.042, 0.068, 0.094}}};
+
+template <typename MaterialType, int dim>
+void check_tangent(const MaterialType& material)
+{
+  typename MaterialType::State state{};
+
+  tensor<double, dim, dim> du_dX{};
+  for (int i = 0; i < dim; i++) {
+    for (int j = 0; j < dim; j++) {
+      du_dX[i][j] = displacement_grad[i][j];
+    }
+  }
+
+  static_assert(solid_mechanics::has_tangent<MaterialType, typename MaterialType::State, dim, std::tuple<>>::value);
+
+  auto C    = material.tangent(state, du_dX);
+  auto C_AD = get_gradient(material(state, make_dual(du_dX)));
+  EXPECT_LT(norm(C - C_AD), 1.0e-12 * norm(C_AD));
+
+  // the stress derivatives from the closed-form tangent should match those of the dual number evaluation
+  auto stress    = solid_mechanics::evaluateStress(material, state, make_dual(du_dX));
+  auto stress_AD = material(state, make_dual(du_dX));
+  EXPECT_LT(norm(get_value(stress) - get_value(stress_AD)), 1.0e-12 * norm(get_value(stress_AD)));
+  EXPECT_LT(norm(get_gradient(stress) - get_gradient(stress_AD)), 1.0e-12 * norm(get_gradient(stress_AD)));
+}
+
+TEST(SolidMaterialTangent, LinearIsotropic2D) { check_tangent<solid_mechanics::LinearIsotropic, 2>({1.0, 1.3, 0.7}); }
+TEST(SolidMaterialTangent, LinearIsotropic3D) { check_tangent<solid_mechanics::LinearIsotropic, 3>({1.0, 1.3, 0.7}); }
+TEST(SolidMaterialTangent, NeoHookean2D) { check_tangent<solid_mechanics::NeoHookean, 2>({1.0, 1.3, 0.7}); }
+TEST(SolidMaterialTangent, NeoHookean3D) { check_tangent<solid_mechanics::NeoHookean, 3>({1.0, 1.3, 0.7}); }
+
+}  // namespace serac
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  axom::slic::SimpleLogger logger;
+
+  int result = RUN_ALL_TESTS();
+
+  return result;
+}
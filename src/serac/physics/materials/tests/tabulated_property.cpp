@@ -0,0 +1,93 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file tabulated_property.cpp
+ *
+ * @brief unit tests for tabulated material property curves
+ */
+
+#include "axom/slic/core/SimpleLogger.hpp"
+#include <gtest/gtest.h>
+
+#include "serac/physics/materials/green_saint_venant_thermoelastic.hpp"
+#include "serac/physics/materials/tabulated_property.hpp"
+
+namespace serac {
+
+// a smooth, moderately expensive stand-in for a measured property curve
+auto conductivity = [](auto theta) {
+  using std::exp;
+  return 1.0 + 0.5 * exp(-theta / 200.0) * theta / (100.0 + theta);
+};
+
+TEST(TabulatedProperty, InterpolatesValuesAndDerivatives)
+{
+  TabulatedProperty k(conductivity, 0.0, 500.0, 128);
+
+  for (double theta = 0.0; theta <= 500.0; theta += 7.3) {
+    auto exact  = conductivity(make_dual(theta));
+    auto approx = k(make_dual(theta));
+    EXPECT_NEAR(approx.value, exact.value, 1.0e-7);
+    EXPECT_NEAR(approx.gradient, exact.gradient, 1.0e-6);
+    EXPECT_DOUBLE_EQ(k(theta), approx.value);
+  }
+}
+
+TEST(TabulatedProperty, ReproducesCubicsExactly)
+{
+  auto              cubic = [](auto x) { return 2.0 - x + 0.5 * x * x * x; };
+  TabulatedProperty f(cubic, -1.0, 2.0, 3);
+
+  // including extrapolation past either end of the table
+  for (double x : {-1.5, -1.0, -0.3, 0.0, 0.7, 1.4, 2.0, 2.5}) {
+    EXPECT_NEAR(f(x), cubic(x), 1.0e-13);
+  }
+}
+
+TEST(TabulatedProperty, ThermoelasticMaterialWithConstantTablesMatchesOriginal)
+{
+  GreenSaintVenantThermoelasticMaterial material{
+      .density = 1.0, .E = 100.0, .nu = 0.25, .C_v = 2.0, .alpha = 1.0e-3, .theta_ref = 300.0, .k = 5.0};
+
+  auto constant = [](double value) { return [value](auto theta) { return value + 0.0 * theta; }; };
+  TabulatedGreenSaintVenantThermoelasticMaterial tabulated{.density   = 1.0,
+                                                           .nu        = 0.25,
+                                                           .theta_ref = 300.0,
+                                                           .E         = {constant(100.0), 200.0, 400.0, 4},
+                                                           .C_v       = {constant(2.0), 200.0, 400.0, 4},
+                                                           .alpha     = {constant(1.0e-3), 200.0, 400.0, 4},
+                                                           .k         = {constant(5.0), 200.0, 400.0, 4}};
+
+  tensor<double, 3, 3> grad_u{{{0.01, 0.02, -0.01}, {0.0, -0.015, 0.005}, {0.03, 0.01, 0.02}}};
+  tensor<double, 3>    grad_theta{1.0, -2.0, 0.5};
+  double               theta = 330.0;
+
+  GreenSaintVenantThermoelasticMaterial::State          state{0.001};
+  TabulatedGreenSaintVenantThermoelasticMaterial::State tabulated_state{0.001};
+
+  auto [sigma, C_v, s0, q0]     = material(state, grad_u, theta, grad_theta);
+  auto [sigma_t, C_t, s_t, q_t] = tabulated(tabulated_state, grad_u, theta, grad_theta);
+
+  EXPECT_LT(norm(sigma - sigma_t), 1.0e-12 * norm(sigma));
+  EXPECT_NEAR(C_v, C_t, 1.0e-12);
+  EXPECT_NEAR(s0, s_t, 1.0e-12 * std::abs(s0));
+  EXPECT_LT(norm(q0 - q_t), 1.0e-12 * norm(q0));
+  EXPECT_DOUBLE_EQ(state.strain_trace, tabulated_state.strain_trace);
+}
+
+}  // namespace serac
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  axom::slic::SimpleLogger logger;
+
+  int result = RUN_ALL_TESTS();
+
+  return result;
+}
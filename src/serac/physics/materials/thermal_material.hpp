@@ -12,12 +12,37 @@
 
 #pragma once
 
+#include <type_traits>
+
 #include "serac/numerics/functional/functional.hpp"
 
 namespace serac::heat_transfer {
 
+/**
+ * @brief Whether a material model or load declares that its contribution to the residual is affine in the
+ * temperature, by defining `static constexpr bool is_linear = true`
+ *
+ * When every term is linear, HeatTransfer solves each step with a single linear solve, reusing the Jacobian
+ * until the timestep, shape displacement or a parameter changes.
+ */
+template <typename T, typename = void>
+struct is_linear : std::false_type {
+};
+
+/// @overload
+template <typename T>
+struct is_linear<T, std::void_t<decltype(T::is_linear)>> : std::bool_constant<T::is_linear> {
+};
+
+/// @brief Shorthand for is_linear<T>::value
+template <typename T>
+inline constexpr bool is_linear_v = is_linear<T>::value;
+
 /// Linear isotropic thermal conduction material model
 struct LinearIsotropicConductor {
+  /// The heat capacity is constant and the flux is linear in the temperature gradient
+  static constexpr bool is_linear = true;
+
   /**
    * @brief Construct a new Linear Isotropic Conductor object
    *
@@ -72,6 +97,9 @@ private:
  */
 template <int dim>
 struct LinearConductor {
+  /// The heat capacity is constant and the flux is linear in the temperature gradient
+  static constexpr bool is_linear = true;
+
   /**
    * @brief Construct a new Linear Isotropic Conductor object
    *
@@ -122,6 +150,9 @@ private:
 
 /// Constant thermal source model
 struct ConstantSource {
+  /// The source does not depend on the temperature
+  static constexpr bool is_linear = true;
+
   /// The constant source
   double source_ = 0.0;
 
@@ -144,6 +175,9 @@ struct ConstantSource {
 
 /// Constant thermal flux boundary model
 struct ConstantFlux {
+  /// The flux does not depend on the temperature
+  static constexpr bool is_linear = true;
+
   /// The constant flux applied to the boundary
   double flux_ = 0.0;
 
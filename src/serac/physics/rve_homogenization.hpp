@@ -0,0 +1,449 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file rve_homogenization.hpp
+ *
+ * @brief A driver for the homogenization of a periodic representative volume element (RVE) under many macroscopic
+ * load cases, which sets up the problem once for all of them
+ */
+
+#pragma once
+
+#include <optional>
+#include <set>
+#include <vector>
+
+#include "mfem.hpp"
+
+#include "serac/infrastructure/logger.hpp"
+#include "serac/infrastructure/profiling.hpp"
+#include "serac/numerics/equation_solver.hpp"
+#include "serac/numerics/stdfunction_operator.hpp"
+#include "serac/numerics/functional/functional.hpp"
+#include "serac/physics/common.hpp"
+#include "serac/physics/materials/solid_material.hpp"
+
+namespace serac {
+
+/// @brief The homogenized response of an RVE to one macroscopic load case, see RVEHomogenization::solve()
+template <int dim>
+struct HomogenizedResponse {
+  /// @brief The volume average of the stress (the first Piola-Kirchhoff stress, with geometric nonlinearities)
+  tensor<double, dim, dim> stress;
+
+  /**
+   * @brief The effective tangent, i.e. the derivative of the average stress w.r.t. the macroscopic displacement
+   * gradient, where tangent(i, j, k, l) = d(stress(i, j)) / d(H(k, l))
+   */
+  tensor<double, dim, dim, dim, dim> tangent;
+
+  /// @brief Whether the solves of this load case converged
+  bool converged;
+};
+
+/**
+ * @brief The homogenization of a periodic RVE: for each macroscopic displacement gradient H, solves for the periodic
+ * fluctuation w of the displacement u = H X + w at equilibrium, and returns the average stress and effective tangent
+ *
+ * The mesh, finite element spaces, element restrictions, geometric factors and solvers are set up once, when the
+ * driver is constructed, rather than once per load case. The fluctuation of each load case starts from that of the
+ * previous one, so a sequence of nearby load cases converges in a few Newton iterations.
+ *
+ * For a linear RVE (a linear material without geometric nonlinearities), the response is linear in H: the Jacobian
+ * and its preconditioner (e.g. the AMG hierarchy) are then built once, and the fluctuations of the dim * dim unit
+ * load cases are solved with them. Every load case is then a combination of those, which costs no further solves.
+ *
+ * @code{.cpp}
+ * auto mesh = mesh::refineAndDistribute(mfem::Mesh::MakePeriodic(cell, cell.CreatePeriodicVertexMapping(shifts)));
+ * RVEHomogenization<1, 3> rve(*mesh, nonlinear_options, linear_options);
+ * rve.setMaterial(fiber, {1});
+ * rve.setMaterial(matrix, {2});
+ * auto responses = rve.solve(macro_gradients);
+ * @endcode
+ *
+ * @tparam order The order of the fluctuation's H1 space
+ * @tparam dim The spatial dimension of the mesh
+ */
+template <int order, int dim>
+class RVEHomogenization {
+public:
+  /// @brief The space of the periodic displacement fluctuation
+  using fluctuation_space = H1<order, dim>;
+
+  /// @brief The (constant) macroscopic displacement gradient, as a field with dim * dim components in row-major order
+  using macro_space = L2<0, dim * dim>;
+
+  /**
+   * @brief Sets up the RVE problem on a periodic mesh
+   *
+   * @param mesh The periodic mesh of the RVE (see mfem::Mesh::MakePeriodic()), which must outlive the driver
+   * @param nonlinear_opts The options of the nonlinear solver of each load case
+   * @param lin_opts The options of the linear solver of the Newton iterations and of the tangent
+   * @param geom_nonlin Whether the strains are finite, in which case the macroscopic deformation gradient is I + H
+   * @param linear Whether the RVE is linear, so that its response can be superposed from the unit load cases
+   */
+  RVEHomogenization(mfem::ParMesh& mesh, const NonlinearSolverOptions& nonlinear_opts,
+                    const LinearSolverOptions&  lin_opts,
+                    GeometricNonlinearities geom_nonlin = GeometricNonlinearities::On, bool linear = false)
+      : mesh_(mesh),
+        geom_nonlin_(geom_nonlin),
+        linear_(linear),
+        nonlin_solver_(std::make_unique<EquationSolver>(nonlinear_opts, lin_opts, mesh.GetComm()))
+  {
+    SLIC_ERROR_ROOT_IF(mesh.Dimension() != dim,
+                       axom::fmt::format("RVEHomogenization<{}, {}> given a mesh of dimension {}", order, dim,
+                                         mesh.Dimension()));
+    SLIC_WARNING_ROOT_IF(!mesh.GetNodes() || !mesh.GetNodes()->FESpace()->IsDGSpace(),
+                         "RVEHomogenization: the mesh is not periodic, see mfem::Mesh::MakePeriodic()");
+    SLIC_ERROR_ROOT_IF(linear && geom_nonlin == GeometricNonlinearities::On,
+                       "RVEHomogenization: an RVE with geometric nonlinearities is not linear");
+
+    std::tie(fluctuation_fes_, fluctuation_fec_) = generateParFiniteElementSpace<fluctuation_space>(&mesh);
+    std::tie(macro_fes_, macro_fec_)             = generateParFiniteElementSpace<macro_space>(&mesh);
+
+    std::array<const mfem::ParFiniteElementSpace*, 2> trial_spaces{fluctuation_fes_.get(), macro_fes_.get()};
+    residual_ = std::make_unique<Functional<fluctuation_space(fluctuation_space, macro_space)>>(fluctuation_fes_.get(),
+                                                                                                trial_spaces);
+    stress_integrals_ =
+        std::make_unique<Functional<macro_space(fluctuation_space, macro_space)>>(macro_fes_.get(), trial_spaces);
+
+    w_.SetSize(fluctuation_fes_->GetTrueVSize());
+    w_ = 0.0;
+    H_.SetSize(macro_fes_->GetTrueVSize());
+    H_ = 0.0;
+
+    // a periodic fluctuation is only determined up to a translation, so the first node is held in place
+    if (fluctuation_fes_->GetMyTDofOffset() == 0 && fluctuation_fes_->GetTrueVSize() > 0) {
+      const int nodes = fluctuation_fes_->GetTrueVSize() / dim;
+      for (int c = 0; c < dim; c++) {
+        fixed_dofs_.Append(c * nodes);
+      }
+    }
+    residual_->SetEssentialTrueDofs(fixed_dofs_);
+
+    for (int e = 0; e < mesh.GetNE(); e++) {
+      volume_ += mesh.GetElementVolume(e);
+    }
+    MPI_Allreduce(MPI_IN_PLACE, &volume_, 1, MPI_DOUBLE, MPI_SUM, mesh.GetComm());
+
+    residual_with_bcs_ = std::make_unique<mfem_ext::StdFunctionOperator>(
+        fluctuation_fes_->GetTrueVSize(),
+
+        [this](const mfem::Vector& w, mfem::Vector& r) {
+          residual_->Mult(r, w, H_);
+          r.SetSubVector(fixed_dofs_, 0.0);
+        },
+
+        [this](const mfem::Vector& w) -> mfem::Operator& {
+          auto [r, drdw] = (*residual_)(differentiate_wrt(w), H_);
+          if (nonlin_solver_->matrixFree()) {
+            J_operator_ = std::make_unique<mfem::ConstrainedOperator>(&drdw, fixed_dofs_);
+            return *J_operator_;
+          }
+          residual_->constrain_essential_dofs = true;
+          assemble(drdw, J_);
+          residual_->constrain_essential_dofs = false;
+          return *J_;
+        });
+
+    nonlin_solver_->setOperator(*residual_with_bcs_);
+  }
+
+  /**
+   * @brief Sets the material of (some of) the elements of the RVE
+   *
+   * @tparam MaterialType The type of a solid material without internal variables, see SolidMechanics::setMaterial()
+   * @param material The material, whose stress is evaluated with the displacement gradient H + dw/dX
+   * @param attributes The attributes of the elements made of this material (or every element, if empty)
+   */
+  template <typename MaterialType>
+  void setMaterial(MaterialType material, const std::set<int>& attributes = {})
+  {
+    static_assert(std::is_same_v<typename MaterialType::State, Empty>,
+                  "RVEHomogenization: materials with internal variables are not supported");
+
+    // the stress that the test functions are integrated against
+    auto piola_stress = [geom_nonlin = geom_nonlin_, material](auto fluctuation, auto macro) {
+      auto h = get<VALUE>(macro);
+      auto H = make_tensor<dim, dim>([&](int i, int j) { return h[i * dim + j]; }) + get<DERIVATIVE>(fluctuation);
+
+      Empty state{};
+      auto  stress = solid_mechanics::evaluateStress(material, state, H);
+
+      // as in SolidMechanics, the stress of the material is pulled back to the reference configuration
+      auto dx_dX = 0.0 * H + DenseIdentity<dim>();
+      if (geom_nonlin == GeometricNonlinearities::On) {
+        dx_dX += H;
+      }
+      return dot(stress, transpose(inv(dx_dX))) * det(dx_dX);
+    };
+
+    residual_->AddDomainIntegral(
+        Dimension<dim>{}, DependsOn<0, 1>{},
+        [piola_stress](auto /*x*/, auto fluctuation, auto macro) {
+          return serac::tuple{zero{}, piola_stress(fluctuation, macro)};
+        },
+        mesh_, attributes);
+
+    // the integral of each component of the stress over each element
+    stress_integrals_->AddDomainIntegral(
+        Dimension<dim>{}, DependsOn<0, 1>{},
+        [piola_stress](auto /*x*/, auto fluctuation, auto macro) {
+          auto P = piola_stress(fluctuation, macro);
+          return serac::tuple{make_tensor<dim * dim>([&](int c) { return P[c / dim][c % dim]; }), zero{}};
+        },
+        mesh_, attributes);
+
+    material_set_ = true;
+    linear_response_.reset();
+  }
+
+  /**
+   * @brief Solves the load cases, one after the other, with the same setup
+   *
+   * @param macro_gradients The macroscopic displacement gradient H of each load case
+   * @return The homogenized response to each load case
+   */
+  std::vector<HomogenizedResponse<dim>> solve(const std::vector<tensor<double, dim, dim>>& macro_gradients)
+  {
+    SERAC_MARK_FUNCTION;
+    SLIC_ERROR_ROOT_IF(!material_set_, "RVEHomogenization: setMaterial() must be called before solve()");
+
+    std::vector<HomogenizedResponse<dim>> responses;
+    responses.reserve(macro_gradients.size());
+
+    if (linear_) {
+      if (!linear_response_) {
+        linear_response_ = solveUnitLoadCases();
+      }
+
+      for (auto& H : macro_gradients) {
+        setMacroGradient(H, H_);
+        mfem::Vector h(dim * dim);
+        for (int c = 0; c < dim * dim; c++) {
+          h[c] = H[c / dim][c % dim];
+        }
+        w_ = w0_;
+        dw_dH_.AddMult(h, w_);
+        responses.push_back({averageStress(), linear_response_->tangent, linear_response_->converged});
+      }
+      return responses;
+    }
+
+    for (auto& H : macro_gradients) {
+      setMacroGradient(H, H_);
+      nonlin_solver_->solve(w_);
+      bool converged = nonlin_solver_->converged();
+
+      auto tangent = computeTangent(converged);
+      responses.push_back({averageStress(), tangent, converged});
+    }
+    return responses;
+  }
+
+  /// @brief The fluctuation of the last load case solved
+  const mfem::Vector& fluctuation() const { return w_; }
+
+  /// @brief The space of the fluctuation
+  const mfem::ParFiniteElementSpace& fluctuationSpace() const { return *fluctuation_fes_; }
+
+  /// @brief The volume of the RVE
+  double volume() const { return volume_; }
+
+  /// @brief The equation solver of the load cases, e.g. for its telemetry
+  const EquationSolver& solver() const { return *nonlin_solver_; }
+
+private:
+  /// @brief The response of a linear RVE to an unloaded state and to the unit load cases
+  struct LinearResponse {
+    tensor<double, dim, dim, dim, dim> tangent;    ///< the (constant) effective tangent
+    bool                               converged;  ///< whether the linear solves converged
+  };
+
+  /// @brief Sets a field of the macro space to the same macroscopic displacement gradient in every element
+  static void setMacroGradient(const tensor<double, dim, dim>& H, mfem::Vector& field)
+  {
+    const int elements = field.Size() / (dim * dim);
+    double*   values   = field.HostWrite();
+    for (int i = 0; i < dim; i++) {
+      for (int j = 0; j < dim; j++) {
+        for (int e = 0; e < elements; e++) {
+          values[(i * dim + j) * elements + e] = H[i][j];
+        }
+      }
+    }
+  }
+
+  /// @brief The volume average of a field of the macro space holding the stress integrals of each element
+  tensor<double, dim, dim> average(const mfem::Vector& integrals) const
+  {
+    const int     elements = integrals.Size() / (dim * dim);
+    const double* values   = integrals.HostRead();
+
+    tensor<double, dim, dim> sum{};
+    for (int i = 0; i < dim; i++) {
+      for (int j = 0; j < dim; j++) {
+        for (int e = 0; e < elements; e++) {
+          sum[i][j] += values[(i * dim + j) * elements + e];
+        }
+      }
+    }
+    MPI_Allreduce(MPI_IN_PLACE, &sum[0][0], dim * dim, MPI_DOUBLE, MPI_SUM, mesh_.GetComm());
+    return (1.0 / volume_) * sum;
+  }
+
+  /// @brief The average stress of the current fluctuation and macroscopic displacement gradient
+  tensor<double, dim, dim> averageStress()
+  {
+    mfem::Vector integrals;
+    stress_integrals_->Mult(integrals, w_, H_);
+    return average(integrals);
+  }
+
+  /**
+   * @brief Computes the effective tangent at the current state: the derivatives dw/dH of the fluctuation solve
+   * (dR/dw) dw/dH = -dR/dH, one per component of H with the same Jacobian and preconditioner, and then
+   * d(stress)/dH = <dP/dw dw/dH + dP/dH>
+   *
+   * @param[in,out] converged Whether the solves so far converged, which is cleared if one of the tangent solves doesn't
+   */
+  tensor<double, dim, dim, dim, dim> computeTangent(bool& converged)
+  {
+    constexpr int n = dim * dim;
+
+    mfem::Solver& lin_solver = nonlin_solver_->linearSolver();
+    lin_solver.SetOperator(residual_with_bcs_->GetGradient(w_));
+
+    // the unit macroscopic displacement gradients, one per column
+    mfem::DenseMatrix dH(H_.Size(), n);
+    for (int c = 0; c < n; c++) {
+      mfem::Vector column(dH.GetColumn(c), H_.Size());
+      setMacroGradient(make_tensor<dim, dim>([c](int i, int j) { return (i * dim + j == c) ? 1.0 : 0.0; }), column);
+    }
+
+    mfem::DenseMatrix rhs;
+    auto [r, dR_dH] = (*residual_)(w_, differentiate_wrt(H_));
+    dR_dH.Mult(dH, rhs);
+
+    dw_dH_.SetSize(w_.Size(), n);
+    for (int c = 0; c < n; c++) {
+      mfem::Vector b(rhs.GetColumn(c), w_.Size());
+      mfem::Vector x(dw_dH_.GetColumn(c), w_.Size());
+      b.SetSubVector(fixed_dofs_, 0.0);
+      b.Neg();
+      x = 0.0;
+      lin_solver.Mult(b, x);
+
+      auto* iterative_solver = dynamic_cast<mfem::IterativeSolver*>(&lin_solver);
+      converged              = converged && (!iterative_solver || iterative_solver->GetConverged());
+    }
+
+    mfem::DenseMatrix d_integrals, d_integrals_dH;
+    auto [m_w, dM_dw] = (*stress_integrals_)(differentiate_wrt(w_), H_);
+    dM_dw.Mult(dw_dH_, d_integrals);
+    auto [m_H, dM_dH] = (*stress_integrals_)(w_, differentiate_wrt(H_));
+    dM_dH.Mult(dH, d_integrals_dH);
+    d_integrals += d_integrals_dH;
+
+    tensor<double, dim, dim, dim, dim> tangent{};
+    for (int k = 0; k < dim; k++) {
+      for (int l = 0; l < dim; l++) {
+        mfem::Vector column(d_integrals.GetColumn(k * dim + l), d_integrals.Height());
+        auto         dstress_dHkl = average(column);
+        for (int i = 0; i < dim; i++) {
+          for (int j = 0; j < dim; j++) {
+            tangent[i][j][k][l] = dstress_dHkl[i][j];
+          }
+        }
+      }
+    }
+    return tangent;
+  }
+
+  /**
+   * @brief Solves a linear RVE once for all load cases: the fluctuation w0 of the unloaded RVE (nonzero for
+   * e.g. an eigenstrain) and the fluctuations dw/dH of the unit load cases, so that w = w0 + dw/dH H
+   */
+  LinearResponse solveUnitLoadCases()
+  {
+    w_ = 0.0;
+    H_ = 0.0;
+
+    bool converged = true;
+    auto tangent   = computeTangent(converged);
+
+    mfem::Vector r(w_.Size());
+    residual_with_bcs_->Mult(w_, r);
+    r.Neg();
+    w0_.SetSize(w_.Size());
+    w0_ = 0.0;
+    nonlin_solver_->linearSolver().Mult(r, w0_);
+
+    return {tangent, converged};
+  }
+
+  /// @brief The mesh of the RVE
+  mfem::ParMesh& mesh_;
+
+  /// @brief Whether the strains are finite
+  GeometricNonlinearities geom_nonlin_;
+
+  /// @brief Whether the load cases are superposed from the unit load cases
+  bool linear_;
+
+  /// @brief The space of the fluctuation, and its collection
+  std::unique_ptr<mfem::ParFiniteElementSpace>   fluctuation_fes_;
+  std::unique_ptr<mfem::FiniteElementCollection> fluctuation_fec_;  ///< @see fluctuation_fes_
+
+  /// @brief The space of the macroscopic displacement gradient, and its collection
+  std::unique_ptr<mfem::ParFiniteElementSpace>   macro_fes_;
+  std::unique_ptr<mfem::FiniteElementCollection> macro_fec_;  ///< @see macro_fes_
+
+  /// @brief The residual of the fluctuation, R(w, H) = int P(H + dw/dX) : dv/dX
+  std::unique_ptr<Functional<fluctuation_space(fluctuation_space, macro_space)>> residual_;
+
+  /// @brief The integrals of the components of the stress over each element
+  std::unique_ptr<Functional<macro_space(fluctuation_space, macro_space)>> stress_integrals_;
+
+  /// @brief The residual with the fixed node, as an operator of the fluctuation
+  std::unique_ptr<mfem_ext::StdFunctionOperator> residual_with_bcs_;
+
+  /// @brief The solver of the fluctuations
+  std::unique_ptr<EquationSolver> nonlin_solver_;
+
+  /// @brief The assembled Jacobian of the residual
+  std::unique_ptr<mfem::HypreParMatrix> J_;
+
+  /// @brief The constrained action of the Jacobian, for matrix-free solvers
+  std::unique_ptr<mfem::ConstrainedOperator> J_operator_;
+
+  /// @brief The true dofs of the node held in place
+  mfem::Array<int> fixed_dofs_;
+
+  /// @brief The fluctuation
+  mfem::Vector w_;
+
+  /// @brief The macroscopic displacement gradient
+  mfem::Vector H_;
+
+  /// @brief The fluctuation of an unloaded linear RVE
+  mfem::Vector w0_;
+
+  /// @brief The derivatives of the fluctuation w.r.t. each component of the macroscopic displacement gradient
+  mfem::DenseMatrix dw_dH_;
+
+  /// @brief The response of a linear RVE, once the unit load cases are solved
+  std::optional<LinearResponse> linear_response_;
+
+  /// @brief The volume of the RVE
+  double volume_ = 0.0;
+
+  /// @brief Whether a material has been set
+  bool material_set_ = false;
+};
+
+}  // namespace serac
@@ -0,0 +1,18 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/physics/solid_mechanics.hpp"
+
+namespace serac {
+
+template class SolidMechanics<1, 2>;
+template class SolidMechanics<2, 2>;
+template class SolidMechanics<3, 2>;
+template class SolidMechanics<1, 3>;
+template class SolidMechanics<2, 3>;
+template class SolidMechanics<3, 3>;
+
+}  // namespace serac
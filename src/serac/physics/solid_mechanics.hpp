@@ -14,12 +14,15 @@
 
 #include "mfem.hpp"
 
+#include "serac/infrastructure/profiling.hpp"
 #include "serac/physics/common.hpp"
 #include "serac/physics/solid_mechanics_input.hpp"
 #include "serac/physics/base_physics.hpp"
 #include "serac/numerics/odes.hpp"
 #include "serac/numerics/stdfunction_operator.hpp"
 #include "serac/numerics/functional/functional.hpp"
+#include "serac/physics/state/batched_coefficient.hpp"
+#include "serac/physics/state/l2_projection.hpp"
 #include "serac/physics/state/state_manager.hpp"
 #include "serac/physics/materials/solid_material.hpp"
 
@@ -187,6 +190,14 @@ public:
     residual_ =
         std::make_unique<Functional<test(trial, trial, shape_trial, parameter_space...)>>(test_space, trial_spaces);
 
+    // the shape displacement rarely changes between residual evaluations,
+    // so its values at each quadrature point are only recomputed when it does
+    residual_->SetCachedArgument(2);
+
+    // and computeShapeSensitivity() is called once per quantity of interest at the same state
+    // (and shape), so those calls share the derivatives w.r.t. it
+    residual_->SetGradientCaching(2);
+
     displacement_         = 0.0;
     velocity_             = 0.0;
     shape_displacement_   = 0.0;
@@ -199,13 +210,49 @@ public:
       amg_prec->SetElasticityOptions(&displacement_.space());
     }
 
+    // p-multigrid builds its coarse levels from the displacement space
+    auto* pmg_prec = dynamic_cast<PMultigridPreconditioner*>(nonlin_solver_->preconditioner());
+    if (pmg_prec) {
+      pmg_prec->setFiniteElementSpace(displacement_.space());
+    }
+
+    // geometric multigrid builds its coarse levels on the coarse meshes of the mesh
+    auto* gmg_prec = dynamic_cast<GeometricMultigridPreconditioner*>(nonlin_solver_->preconditioner());
+    if (gmg_prec) {
+      gmg_prec->setFiniteElementSpace(displacement_.space(), StateManager::coarseMeshes(sidre_datacoll_id_));
+    }
+
+    // the low-order-refined preconditioner assembles its own matrix, with the same essential dofs
+    auto* lor_prec = dynamic_cast<LORPreconditioner*>(nonlin_solver_->preconditioner());
+    if (lor_prec) {
+      lor_prec->setFiniteElementSpace(displacement_.space(), bcs_.allEssentialTrueDofs());
+    }
+
+    // the separate-displacement-component preconditioner is given a matrix with each Jacobian
+    component_prec_ = dynamic_cast<SeparateComponentPreconditioner*>(nonlin_solver_->preconditioner());
+    if (component_prec_) {
+      SLIC_ERROR_ROOT_IF(timestepping_opts.timestepper != TimestepMethod::QuasiStatic,
+                         "The SeparateComponentAMG preconditioner is only supported for quasi-static solid mechanics");
+      component_prec_->setFiniteElementSpace(displacement_.space());
+    }
+
     // Check for dynamic mode
-    if (timestepping_opts.timestepper != TimestepMethod::QuasiStatic) {
+    if (timestepping_opts.timestepper == TimestepMethod::ExplicitCentralDifference) {
+      // explicit steps are taken by this module directly, without the ODE or nonlinear solvers
+      is_explicit_    = true;
+      is_quasistatic_ = false;
+    } else if (timestepping_opts.timestepper != TimestepMethod::QuasiStatic) {
       ode2_.SetTimestepper(timestepping_opts.timestepper);
       ode2_.SetEnforcementMethod(timestepping_opts.enforcement_method);
+      if (timestepping_opts.adaptive) {
+        ode2_.SetAdaptiveTimestepping(timestepping_opts);
+      }
+      ode2_.SetPredictor(timestepping_opts.extrapolation_states);
       is_quasistatic_ = false;
     } else {
-      is_quasistatic_ = true;
+      predictor_           = SolutionExtrapolator(timestepping_opts.extrapolation_states);
+      quasistatic_cutback_ = timestepping_opts;
+      is_quasistatic_      = true;
     }
 
     int true_size = velocity_.space().TrueVSize();
@@ -226,6 +273,11 @@ public:
 
     zero_.SetSize(true_size);
     zero_ = 0.0;
+
+    acceleration_.SetSize(true_size);
+    for (auto& bc_values : bc_values_) {
+      bc_values.SetSize(true_size);
+    }
   }
 
   /**
@@ -241,7 +293,22 @@ public:
     // This is the only other options stored in the input file that we can use
     // in the initialization stage
     // TODO: move these material parameters out of the SolidMechanicsInputOptions
-    if (input_options.material_nonlin) {
+    if (input_options.plasticity) {
+      if constexpr (dim == solid_mechanics::J2::dim) {
+        const double K  = input_options.K;
+        const double mu = input_options.mu;
+        const auto&  p  = *input_options.plasticity;
+        solid_mechanics::J2 mat{.E       = 9.0 * K * mu / (3.0 * K + mu),
+                                .nu      = (3.0 * K - 2.0 * mu) / (2.0 * (3.0 * K + mu)),
+                                .Hi      = p.Hi,
+                                .Hk      = p.Hk,
+                                .sigma_y = p.sigma_y,
+                                .density = input_options.initial_mass_density};
+        setMaterial(mat, createQuadratureDataBuffer(solid_mechanics::J2::State{}));
+      } else {
+        SLIC_ERROR_ROOT("J2 plasticity in input files is only implemented in 3D");
+      }
+    } else if (input_options.material_nonlin) {
       solid_mechanics::NeoHookean mat{input_options.initial_mass_density, input_options.K, input_options.mu};
       setMaterial(mat);
     } else {
@@ -249,6 +316,19 @@ public:
       setMaterial(mat);
     }
 
+    setInputConditions(input_options);
+  }
+
+  /**
+   * @brief Set the initial conditions and the boundary conditions given in the input file options
+   *
+   * This is what the constructor from the input file options does besides setting the material, so that modules
+   * with other materials (e.g. that of a coupled problem, see Thermomechanics) can use the rest of the options.
+   *
+   * @param[in] input_options The solver information parsed from the input file
+   */
+  void setInputConditions(const SolidMechanicsInputOptions& input_options)
+  {
     if (input_options.initial_displacement) {
       displacement_.project(input_options.initial_displacement->constructVector(dim));
     }
@@ -283,7 +363,7 @@ public:
         // TODO: Not implemented yet in input files
         SLIC_ERROR("'pressure_ref' is not implemented yet in input files.");
       } else {
-        SLIC_WARNING_ROOT("Ignoring boundary condition with unknown name: " << name);
+        SLIC_WARNING_ROOT("Ignoring boundary condition with unknown name: " << bc_name);
       }
     }
   }
@@ -296,14 +376,16 @@ public:
    *
    * @tparam T the type to be created at each quadrature point
    * @param initial_state the value to be broadcast to each quadrature point
+   * @param attributes if nonempty, the buffer only describes the elements with these attributes, for a material
+   * assigned to them (see setMaterial())
    * @return std::shared_ptr< QuadratureData<T> >
    */
   template <typename T>
-  std::shared_ptr<QuadratureData<T>> createQuadratureDataBuffer(T initial_state)
+  std::shared_ptr<QuadratureData<T>> createQuadratureDataBuffer(T initial_state, const std::set<int>& attributes = {})
   {
     constexpr auto Q = order + 1;
 
-    size_t num_elements        = size_t(mesh_.GetNE());
+    size_t num_elements        = numElementsWithAttributes(attributes);
     size_t qpoints_per_element = GaussQuadratureRule<geom, Q>().size();
 
     auto  qdata     = std::make_shared<QuadratureData<T>>(num_elements, qpoints_per_element);
@@ -317,6 +399,69 @@ public:
     return qdata;
   }
 
+  /**
+   * @brief Create a shared ptr to a quadrature data buffer for the given material type, which stores each component
+   * of the type contiguously over all of the quadrature points (see QuadratureData<SoA<T>>)
+   *
+   * @tparam T the type to be created at each quadrature point
+   * @param initial_state the value to be broadcast to each quadrature point
+   * @param attributes see createQuadratureDataBuffer(T, const std::set<int>&)
+   * @return std::shared_ptr< QuadratureData<SoA<T>> >
+   */
+  template <typename T>
+  std::shared_ptr<QuadratureData<SoA<T>>> createQuadratureDataBuffer(SoA<T>, T initial_state,
+                                                                     const std::set<int>& attributes = {})
+  {
+    constexpr auto Q = order + 1;
+
+    size_t num_elements        = numElementsWithAttributes(attributes);
+    size_t qpoints_per_element = GaussQuadratureRule<geom, Q>().size();
+
+    auto  qdata     = std::make_shared<QuadratureData<SoA<T>>>(num_elements, qpoints_per_element);
+    auto& container = *qdata;
+    for (size_t e = 0; e < num_elements; e++) {
+      for (size_t q = 0; q < qpoints_per_element; q++) {
+        container(e, q) = initial_state;
+      }
+    }
+
+    return qdata;
+  }
+
+  using BasePhysics::setParameter;
+
+  /**
+   * @brief Use values at each quadrature point as parameter `parameter_index`, rather than a finite element field
+   *
+   * The materials that depend on the parameter receive these values (with a zero gradient) directly, e.g. for
+   * parameters computed at quadrature points by an upstream process simulation, without projecting them onto (and
+   * interpolating them back from) the parameter's finite element space. The parameter's finite element state is
+   * only a placeholder then (a zero field is created if none was set), and sensitivities with respect to it are not
+   * available.
+   *
+   * @param parameter_index the index of the parameter
+   * @param values the values at each quadrature point, in the layout of createQuadratureDataBuffer() for the
+   * elements of the materials that depend on the parameter, of type `double` for scalar parameter spaces and
+   * `tensor<double, components>` otherwise
+   *
+   * @note see Functional::SetQuadraturePointArgument()
+   */
+  template <typename T>
+  void setParameter(const size_t parameter_index, std::shared_ptr<QuadratureData<T>> values)
+  {
+    SLIC_ERROR_ROOT_IF(
+        parameter_index >= parameters_.size(),
+        axom::fmt::format("Parameter index '{}' is not available in physics module '{}'", parameter_index, name_));
+
+    if (!parameters_[parameter_index].state) {
+      quadrature_point_parameter_states_.push_back(generateParameter(
+          detail::addPrefix(name_, "quadrature_point_parameter_" + std::to_string(parameter_index)), parameter_index));
+      *quadrature_point_parameter_states_.back() = 0.0;
+    }
+
+    residual_->SetQuadraturePointArgument(uint32_t(parameter_index + NUM_STATE_VARS), values);
+  }
+
   /**
    * @brief Set essential displacement boundary conditions (strongly enforced)
    *
@@ -347,6 +492,29 @@ public:
     bcs_.addEssential(disp_bdr, disp_bdr_coef_, displacement_.space());
   }
 
+  /**
+   * @brief Set time-separable essential displacement boundary conditions, u(x, t) = scale(t) * profile(x)
+   *
+   * The profile is projected once and scaled every timestep, so the boundary displacements (and their rates) are
+   * obtained without evaluating @a profile again.
+   *
+   * @param[in] disp_bdr The boundary attributes on which to enforce a displacement
+   * @param[in] profile The spatial profile of the prescribed boundary displacement
+   * @param[in] scale The scalar function of time multiplying the profile
+   * @param[in] scale_rate The first time derivative of @a scale, approximated by central differences if empty
+   * @param[in] scale_accel The second time derivative of @a scale, approximated by central differences if empty
+   */
+  void setDisplacementBCs(const std::set<int>&                                           disp_bdr,
+                          std::function<void(const mfem::Vector& x, mfem::Vector& disp)> profile,
+                          std::function<double(double)>                                  scale,
+                          std::function<double(double)>                                  scale_rate  = nullptr,
+                          std::function<double(double)>                                  scale_accel = nullptr)
+  {
+    disp_bdr_coef_ = std::make_shared<mfem::VectorFunctionCoefficient>(dim, profile);
+
+    bcs_.addEssential(disp_bdr, disp_bdr_coef_, displacement_.space()).setTimeScaling(scale, scale_rate, scale_accel);
+  }
+
   /**
    * @brief Set the displacement essential boundary conditions on a single component
    *
@@ -363,6 +531,34 @@ public:
     bcs_.addEssential(disp_bdr, component_disp_bdr_coef_, displacement_.space(), component);
   }
 
+  /**
+   * @brief Set essential displacement boundary conditions (strongly enforced) from a batched coefficient, which is
+   * evaluated once for all the constrained nodes every time the boundary conditions are applied
+   *
+   * @param[in] disp_bdr The boundary attributes on which to enforce a displacement
+   * @param[in] disp The prescribed boundary displacement, e.g. from makeBatchedVectorCoefficient()
+   */
+  void setDisplacementBCs(const std::set<int>& disp_bdr, std::shared_ptr<BatchedVectorCoefficient> disp)
+  {
+    disp_bdr_coef_ = disp;
+
+    bcs_.addEssential(disp_bdr, disp_bdr_coef_, displacement_.space());
+  }
+
+  /**
+   * @brief Set the displacement essential boundary conditions on a single component from a batched coefficient
+   *
+   * @param[in] disp_bdr The set of boundary attributes to set the displacement on
+   * @param[in] disp The prescribed displacement component, e.g. from makeBatchedCoefficient()
+   * @param[in] component The component to set the displacment on
+   */
+  void setDisplacementBCs(const std::set<int>& disp_bdr, std::shared_ptr<BatchedCoefficient> disp, int component)
+  {
+    component_disp_bdr_coef_ = disp;
+
+    bcs_.addEssential(disp_bdr, component_disp_bdr_coef_, displacement_.space(), component);
+  }
+
   /**
    * @brief Accessor for getting named finite element state fields from the physics modules
    *
@@ -394,6 +590,12 @@ public:
     return std::vector<std::string>{{"displacement"}, {"velocity"}, {"adjoint_displacement"}};
   }
 
+  /// @brief The telemetry of the nonlinear solves of the displacement since the last resetSolveTelemetry()
+  SolveTelemetry solveTelemetry() const override { return nonlin_solver_->telemetry(); }
+
+  /// @brief Start accumulating the telemetry of the next solves anew
+  void resetSolveTelemetry() const override { nonlin_solver_->resetTelemetry(); }
+
   /**
    * @brief register a custom domain integral calculation as part of the residual
    *
@@ -425,6 +627,12 @@ public:
   void addCustomDomainIntegral(DependsOn<active_parameters...>, callable qfunction,
                                std::shared_ptr<QuadratureData<StateType>> qdata = NoQData)
   {
+    // a custom integrand may make the mass term depend on the displacement, so it can't be cached
+    constant_mass_ = false;
+    mass_values_.clear();
+
+    trackQuadratureData(qdata);
+
     residual_->AddDomainIntegral(Dimension<dim>{}, DependsOn<0, 1, 2, active_parameters + NUM_STATE_VARS...>{},
                                  qfunction, mesh_, qdata);
   }
@@ -450,11 +658,39 @@ public:
    *
    * @pre MaterialType must have a public member variable `density`
    * @pre MaterialType must define operator() that returns the Cauchy stress
+   *
+   * @note stableTimestep() requires every material to also have the bulk and shear moduli `K` and `G`
    */
   template <int... active_parameters, typename MaterialType, typename StateType = Empty>
   void setMaterial(DependsOn<active_parameters...>, MaterialType material,
                    std::shared_ptr<QuadratureData<StateType>> qdata = EmptyQData)
   {
+    setMaterial(DependsOn<active_parameters...>{}, material, std::set<int>{}, qdata);
+  }
+
+  /**
+   * @brief Set the material stress response and mass properties of the elements with the given attributes
+   *
+   * Different materials can be assigned to different parts of the mesh this way, e.g. so that a material
+   * with internal variables only needs to store (and update) them where it is used.
+   *
+   * @param material A material that provides a function to evaluate stress, see setMaterial()
+   * @param attributes the attributes of the elements made of this material (or every element, if empty)
+   * @param qdata the buffer of material internal variables at each quadrature point of those elements, see
+   * createQuadratureDataBuffer()
+   */
+  template <int... active_parameters, typename MaterialType, typename StateType = Empty>
+  void setMaterial(DependsOn<active_parameters...>, MaterialType material, const std::set<int>& attributes,
+                   std::shared_ptr<QuadratureData<StateType>> qdata = EmptyQData)
+  {
+    if constexpr (solid_mechanics::has_wave_speed<MaterialType>::value) {
+      max_wave_speed_ = std::max(max_wave_speed_, solid_mechanics::waveSpeed(material));
+    } else {
+      wave_speeds_known_ = false;
+    }
+
+    trackQuadratureData(qdata);
+
     residual_->AddDomainIntegral(
         Dimension<dim>{},
         DependsOn<0, 1, 2,
@@ -476,7 +712,7 @@ public:
 
           auto du_dX_prime = dot(du_dX, inv(I + dp_dX));
 
-          auto stress = material(state, du_dX_prime, params...);
+          auto stress = solid_mechanics::evaluateStress(material, state, du_dX_prime, params...);
 
           // dx_dX is the volumetric transform to get us back to the original
           // reference configuration (dx/dX = I + du/dX + dp/dX). If we are not including geometric
@@ -499,7 +735,7 @@ public:
           // configuration, hence the det(I + dp_dx) = det(dX'/dX)
           return serac::tuple{material.density * d2u_dt2 * det(I + dp_dX), flux};
         },
-        mesh_, qdata);
+        mesh_, attributes, qdata);
   }
 
   /// @overload
@@ -509,6 +745,102 @@ public:
     setMaterial(DependsOn<>{}, material, qdata);
   }
 
+  /// @overload
+  template <typename MaterialType, typename StateType = Empty>
+  void setMaterial(MaterialType material, const std::set<int>& attributes,
+                   std::shared_ptr<QuadratureData<StateType>> qdata = EmptyQData)
+  {
+    setMaterial(DependsOn<>{}, material, attributes, qdata);
+  }
+
+  /**
+   * @brief Adds a field computed from the response of a material at each quadrature point (e.g. the stress, its von
+   * Mises norm or an internal variable) to the visualization output, see addDerivedField()
+   *
+   * The values at the quadrature points are L2-projected onto a discontinuous space, whose element mass matrices are
+   * inverted once, and only when the field is output. The projection integrates over the same mesh, spaces and
+   * quadrature rule as the residual, so it shares the residual's element restrictions and geometric factors.
+   *
+   * @tparam derived_order The polynomial order of the discontinuous space
+   * @param name The name of the field
+   * @param material The material, see setMaterial()
+   * @param output Computes the field at a quadrature point from the stress, the displacement gradient and the
+   * (committed) internal variables of the material, `output(stress, du_dX, state)`, returning a scalar or a tensor
+   * @param attributes The attributes of the elements made of this material (or every element, if empty)
+   * @param qdata The internal variables of the material, see setMaterial()
+   *
+   * ~~~ {.cpp}
+   *
+   *  solid_mechanics.addMaterialOutput("von_mises", DependsOn<>{}, material, [](auto stress, auto, auto) {
+   *    auto s = dev(stress);
+   *    return sqrt(1.5 * inner(s, s));
+   *  });
+   *
+   * ~~~
+   */
+  template <int derived_order = order, int... active_parameters, typename MaterialType, typename OutputType,
+            typename StateType = Empty>
+  void addMaterialOutput(const std::string& name, DependsOn<active_parameters...>, MaterialType material,
+                         OutputType output, const std::set<int>& attributes = {},
+                         std::shared_ptr<QuadratureData<StateType>> qdata = EmptyQData)
+  {
+    using output_type = decltype(output(tensor<double, dim, dim>{}, tensor<double, dim, dim>{}, StateType{}));
+    constexpr int components = int(sizeof(output_type) / sizeof(double));
+    using flat_type          = std::conditional_t<components == 1, double, tensor<double, components>>;
+    using derived_space      = L2<derived_order, components>;
+
+    // the quadrature rule of the material's integral in the residual, which the internal variables are stored at
+    constexpr int Q = std::max({order, SHAPE_ORDER, parameter_space::order...}) + 1;
+
+    auto field = std::make_unique<FiniteElementState>(
+        mesh_, FiniteElementState::Options{.order        = derived_order,
+                                           .vector_dim   = components,
+                                           .element_type = ElementType::L2,
+                                           .name         = detail::addPrefix(name_, name)});
+
+    std::array<const mfem::ParFiniteElementSpace*, 2 + sizeof...(parameter_space)> trial_spaces;
+    trial_spaces[0] = &displacement_.space();
+    trial_spaces[1] = &shape_displacement_.space();
+    if constexpr (sizeof...(parameter_space) > 0) {
+      for (std::size_t i = 0; i < sizeof...(parameter_space); i++) {
+        trial_spaces[i + 2] = parameters_[i].trial_space.get();
+      }
+    }
+
+    auto integrals = std::make_shared<Functional<derived_space(trial, shape_trial, parameter_space...)>>(
+        &field->space(), trial_spaces);
+    integrals->AddDomainIntegral(
+        Dimension<dim>{}, DependsOn<0, 1, active_parameters + 2...>{}, QuadraturePoints<Q>{},
+        [material, output](auto /*x*/, auto& state, auto displacement, auto shape, auto... params) {
+          // the stress in the shape-adjusted configuration, as in setMaterial()
+          auto du_dX_prime = dot(get<DERIVATIVE>(displacement), inv(I + get<DERIVATIVE>(shape)));
+
+          // the material may update its internal variables, but the output is computed from the committed ones
+          auto committed = state;
+          auto stress    = solid_mechanics::evaluateStress(material, state, du_dX_prime, params...);
+          auto value     = get_value(output(stress, du_dX_prime, committed));
+          return serac::tuple{reinterpret_cast<const flat_type&>(value), zero{}};
+        },
+        mesh_, attributes, qdata);
+
+    auto projection = std::make_shared<L2Projection>(field->space());
+
+    addDerivedField(std::move(field), [this, integrals, projection](FiniteElementState& derived) {
+      const mfem::Vector& r =
+          (*integrals)(displacement_, shape_displacement_, *parameters_[parameter_indices].state...);
+      projection->solve(r, derived);
+    });
+  }
+
+  /// @overload
+  template <int derived_order = order, typename MaterialType, typename OutputType, typename StateType = Empty>
+  void addMaterialOutput(const std::string& name, MaterialType material, OutputType output,
+                         const std::set<int>& attributes = {},
+                         std::shared_ptr<QuadratureData<StateType>> qdata = EmptyQData)
+  {
+    addMaterialOutput<derived_order>(name, DependsOn<>{}, material, output, attributes, qdata);
+  }
+
   /**
    * @brief Set the underlying finite element state to a prescribed displacement
    *
@@ -522,6 +854,19 @@ public:
     gf_initialized_[1] = true;
   }
 
+  /**
+   * @brief Set the underlying finite element state to a prescribed displacement, evaluating a batched coefficient
+   * once for all the nodes
+   *
+   * @param disp The displacement field, e.g. from makeBatchedVectorCoefficient()
+   */
+  void setDisplacement(std::shared_ptr<BatchedVectorCoefficient> disp)
+  {
+    disp->SetTime(time_);
+    displacement_.project(*disp);
+    gf_initialized_[1] = true;
+  }
+
   /**
    * @brief Set the underlying finite element state to a prescribed velocity
    *
@@ -577,6 +922,9 @@ public:
    *
    * @tparam TractionType The type of the traction load
    * @param traction_function A function describing the traction applied to a boundary
+   * @param boundary_attributes the attributes of the boundary elements the traction is applied to (or every boundary
+   * element, if empty). Only those boundary elements are evaluated, so a load on a small part of the boundary should
+   * name its attributes rather than return zero elsewhere
    *
    * @pre TractionType must be a object that can be called with the following arguments:
    *    1. `tensor<T,dim> x` the spatial coordinates for the quadrature point
@@ -595,7 +943,8 @@ public:
    * shape sensitivities for boundary integrals.
    */
   template <int... active_parameters, typename TractionType>
-  void setPiolaTraction(DependsOn<active_parameters...>, TractionType traction_function)
+  void setPiolaTraction(DependsOn<active_parameters...>, TractionType traction_function,
+                        const std::set<int>& boundary_attributes = {})
   {
     residual_->AddBoundaryIntegral(
         Dimension<dim - 1>{}, DependsOn<0, 1, 2, active_parameters + NUM_STATE_VARS...>{},
@@ -603,14 +952,14 @@ public:
           auto p = get<VALUE>(shape);
           return -1.0 * traction_function(x + p, n, ode_time_point_, params...);
         },
-        mesh_);
+        mesh_, boundary_attributes);
   }
 
   /// @overload
   template <typename TractionType>
-  void setPiolaTraction(TractionType traction_function)
+  void setPiolaTraction(TractionType traction_function, const std::set<int>& boundary_attributes = {})
   {
-    setPiolaTraction(DependsOn<>{}, traction_function);
+    setPiolaTraction(DependsOn<>{}, traction_function, boundary_attributes);
   }
 
   /// @brief Build the quasi-static operator corresponding to the total Lagrangian formulation
@@ -623,13 +972,15 @@ public:
 
         // residual function
         [this](const mfem::Vector& u, mfem::Vector& r) {
-          const mfem::Vector res =
-              (*residual_)(u, zero_, shape_displacement_, *parameters_[parameter_indices].state...);
+          residual_->Mult(r, u, zero_, shape_displacement_, *parameters_[parameter_indices].state...);
+
+          // during a solve, each evaluation also writes tentative quadrature data (see trackQuadratureData),
+          // so keep its unconstrained residual too, in case this is the evaluation at the converged displacement
+          if (residual_->update_qdata) {
+            reactions_.Vector::operator=(r);
+            reactions_displacement_ = u;
+          }
 
-          // TODO this copy is required as the sundials solvers do not allow move assignments because of their memory
-          // tracking strategy
-          // See https://github.com/mfem/mfem/issues/3531
-          r = res;
           r.SetSubVector(bcs_.allEssentialTrueDofs(), 0.0);
         },
 
@@ -637,8 +988,17 @@ public:
         [this](const mfem::Vector& u) -> mfem::Operator& {
           auto [r, drdu] =
               (*residual_)(differentiate_wrt(u), zero_, shape_displacement_, *parameters_[parameter_indices].state...);
-          J_   = assemble(drdu);
-          J_e_ = bcs_.eliminateAllEssentialDofsFromMatrix(*J_);
+          constrainEssentialDofs(true);
+          if (component_prec_) {
+            component_prec_->setMatrix(drdu.assemble_component_blocks());
+          }
+          if (nonlin_solver_->matrixFree()) {
+            constrainEssentialDofs(false);
+            J_operator_ = std::make_unique<mfem::ConstrainedOperator>(&drdu, bcs_.allEssentialTrueDofs());
+            return *J_operator_;
+          }
+          assemble(drdu, J_);
+          constrainEssentialDofs(false);
           return *J_;
         });
   }
@@ -650,6 +1010,10 @@ public:
    * The K matrix has the essential degree of freedom rows and columns zeroed with a
    * 1 on the diagonal and K_e contains the zeroed rows and columns, e.g. K_total = K + K_e.
    *
+   * @note The Jacobians of the Newton iterations are assembled with their essential rows and columns already
+   * constrained, without keeping the eliminated entries, so K_e holds those of the linearized predictor of the last
+   * quasi-static timestep.
+   *
    * @warning This interface is not stable and may change in the future.
    *
    * @return A pair of the eliminated stiffness matrix and a matrix containing the eliminated rows and cols
@@ -668,6 +1032,8 @@ public:
    */
   void completeSetup() override
   {
+    SERAC_MARK_FUNCTION;
+
     if constexpr (sizeof...(parameter_space) > 0) {
       for (size_t i = 0; i < sizeof...(parameter_space); i++) {
         SLIC_ERROR_ROOT_IF(!parameters_[i].state,
@@ -675,15 +1041,27 @@ public:
       }
     }
 
+    // what assembling the Jacobian will allocate, reported before any of it is
+    if (!nonlin_solver_->matrixFree()) {
+      memory::reportEstimate(axom::fmt::format("assembling the Jacobian of '{}'", name_),
+                             residual_->EstimatedAssemblyMemory(0));
+    }
+
     // Build the dof array lookup tables
     displacement_.space().BuildDofToArrays();
 
+    // choose the batch sizes of the residual's kernels before its first evaluation below
+    if (autotuning::options().enabled) {
+      residual_->Autotune();
+    }
+
     if (is_quasistatic_) {
       residual_with_bcs_ = buildQuasistaticOperator();
 
       // the residual calculation uses the old stiffness matrix
       // to help apply essential boundary conditions, so we
       // compute J here to prime the pump for the first solve
+      SERAC_PROFILE_SCOPE("SolidMechanics::initial Jacobian");
       residual_with_bcs_->GetGradient(displacement_);
 
     } else {
@@ -695,55 +1073,94 @@ public:
 
           [this](const mfem::Vector& d2u_dt2, mfem::Vector& r) {
             add(1.0, u_, c0_, d2u_dt2, predicted_displacement_);
-            const mfem::Vector res = (*residual_)(predicted_displacement_, d2u_dt2, shape_displacement_,
-                                                  *parameters_[parameter_indices].state...);
-
-            // TODO this copy is required as the sundials solvers do not allow move assignments because of their memory
-            // tracking strategy
-            // See https://github.com/mfem/mfem/issues/3531
-            r = res;
-            r.SetSubVector(bcs_.allEssentialTrueDofs(), 0.0);
+            constrainEssentialDofs(true);
+            residual_->Mult(r, predicted_displacement_, d2u_dt2, shape_displacement_,
+                            *parameters_[parameter_indices].state...);
+            constrainEssentialDofs(false);
           },
 
           [this](const mfem::Vector& d2u_dt2) -> mfem::Operator& {
-            add(1.0, u_, c0_, d2u_dt2, predicted_displacement_);
+            SLIC_ERROR_ROOT_IF(nonlin_solver_->matrixFree(),
+                               "Matrix-free linear solves are only supported for quasi-static solid mechanics");
 
-            // K := dR/du
-            auto K =
-                serac::get<DERIVATIVE>((*residual_)(differentiate_wrt(predicted_displacement_), d2u_dt2,
-                                                    shape_displacement_, *parameters_[parameter_indices].state...));
-            std::unique_ptr<mfem::HypreParMatrix> k_mat(assemble(K));
-
-            // M := dR/da
-            auto M =
-                serac::get<DERIVATIVE>((*residual_)(predicted_displacement_, differentiate_wrt(d2u_dt2),
-                                                    shape_displacement_, *parameters_[parameter_indices].state...));
-            std::unique_ptr<mfem::HypreParMatrix> m_mat(assemble(M));
+            add(1.0, u_, c0_, d2u_dt2, predicted_displacement_);
 
-            // J = M + c0 * K
-            J_.reset(mfem::Add(1.0, *m_mat, c0_, *k_mat));
-            J_e_ = bcs_.eliminateAllEssentialDofsFromMatrix(*J_);
+            // the mass term of the residual is linear in the acceleration and independent of the displacement,
+            // so unless a custom integral could change that, M := dR/da only needs to be recomputed if the
+            // shape displacement changes
+            bool mass_is_cached = constant_mass_ && !mass_values_.empty() &&
+                                  mass_shape_displacement_.Size() == shape_displacement_.Size() &&
+                                  mass_shape_displacement_.DistanceTo(shape_displacement_.GetData()) == 0.0;
+
+            constrainEssentialDofs(true);
+            if (mass_is_cached) {
+              auto [r, K] = (*residual_)(differentiate_wrt(predicted_displacement_), d2u_dt2, shape_displacement_,
+                                         *parameters_[parameter_indices].state...);
+
+              // J = M + c0 * K, assembled directly into one matrix
+              assemble(1.0, mass_values_, c0_, K, J_);
+            } else {
+              // K := dR/du and M := dR/da, from a single evaluation of the residual
+              auto [r, K, M] = (*residual_)(differentiate_wrt(predicted_displacement_), differentiate_wrt(d2u_dt2),
+                                            shape_displacement_, *parameters_[parameter_indices].state...);
+
+              if (constant_mass_) {
+                mass_values_             = M.local_values();
+                mass_shape_displacement_ = shape_displacement_;
+              }
+
+              // J = M + c0 * K, assembled directly into one matrix
+              assemble(1.0, M, c0_, K, J_);
+            }
+            constrainEssentialDofs(false);
 
             return *J_;
           });
     }
 
     nonlin_solver_->setOperator(*residual_with_bcs_);
+
+    memory::report(name_ + ".setup", mesh_.GetComm());
   }
 
   /// @brief Solve the Quasi-static Newton system
   void quasiStaticSolve(double dt)
   {
+    predictor_.push(time_, displacement_);
     time_ += dt;
 
+    if (predictor_.ready()) {
+      // the extrapolation already follows the trend of the loads and parameters, so it replaces
+      // the linearized predictor below, along with the Jacobian assembly and linear solve it costs
+      predictor_.predict(time_, displacement_);
+      for (auto& bc : bcs_.essentials()) {
+        bc.setDofs(displacement_, time_);
+      }
+
+      for_constexpr<sizeof...(parameter_indices)>([&](auto parameter_index) {
+        *parameters_[parameter_index].previous_state = *parameters_[parameter_index].state;
+      });
+
+      solveWithTentativeUpdates();
+      return;
+    }
+
     // the ~20 lines of code below are essentially equivalent to the 1-liner
     // u += dot(inv(J), dot(J_elim[:, dofs], (U(t + dt) - u)[dofs]));
 
-    // Update the linearized Jacobian matrix
-    auto [r, drdu] = (*residual_)(differentiate_wrt(displacement_), zero_, shape_displacement_,
-                                  *parameters_[parameter_indices].state...);
-    J_             = assemble(drdu);
-    J_e_           = bcs_.eliminateAllEssentialDofsFromMatrix(*J_);
+    // Update the linearized Jacobian matrix, along with the derivatives w.r.t. each parameter
+    // (which are all computed by the same residual evaluation)
+    auto  r_and_derivatives = (*residual_)(DifferentiateWRT<0, NUM_STATE_VARS + parameter_indices...>{}, displacement_,
+                                           zero_, shape_displacement_, *parameters_[parameter_indices].state...);
+    auto& drdu              = serac::get<DERIVATIVE>(r_and_derivatives);
+
+    // if the nonlinear solver keeps its Jacobian across solves, the linear solver is still set up
+    // with J_, so the predictor uses that instead of assembling another one
+    const bool reuse_jacobian = nonlin_solver_->reusingJacobian();
+    if (!nonlin_solver_->matrixFree() && !reuse_jacobian) {
+      assemble(drdu, J_);
+      J_e_ = bcs_.eliminateAllEssentialDofsFromMatrix(*J_);
+    }
 
     du_ = 0.0;
     for (auto& bc : bcs_.essentials()) {
@@ -756,28 +1173,35 @@ public:
       du_[j] -= displacement_(j);
     }
 
-    dr_ = 0.0;
-    mfem::EliminateBC(*J_, *J_e_, constrained_dofs, du_, dr_);
+    if (nonlin_solver_->matrixFree()) {
+      // du_ is only nonzero on the constrained dofs, so the unconstrained rows of
+      // -drdu * du_ are the same as the -J_e_ * du_ used by mfem::EliminateBC
+      drdu.Mult(du_, dr_);
+      dr_.Neg();
+      J_operator_ = std::make_unique<mfem::ConstrainedOperator>(&drdu, constrained_dofs);
+    } else {
+      dr_ = 0.0;
+      mfem::EliminateBC(*J_, *J_e_, constrained_dofs, du_, dr_);
+    }
 
     // Update the initial guess for changes in the parameters if this is not the first solve
-    for (std::size_t parameter_index = 0; parameter_index < parameters_.size(); ++parameter_index) {
+    for_constexpr<sizeof...(parameter_indices)>([&](auto parameter_index) {
       // Compute the change in parameters parameter_diff = parameter_new - parameter_old
-      serac::FiniteElementState parameter_difference = *parameters_[parameter_index].state;
-      parameter_difference -= *parameters_[parameter_index].previous_state;
+      auto parameter_difference = StateManager::scratchVector(parameters_[parameter_index].state->space());
+      subtract(*parameters_[parameter_index].state, *parameters_[parameter_index].previous_state,
+               *parameter_difference);
 
       // Compute a linearized estimate of the residual forces due to this change in parameter
-      auto drdparam        = serac::get<DERIVATIVE>(d_residual_d_[parameter_index]());
-      auto residual_update = drdparam(parameter_difference);
+      auto&               drdparam        = serac::get<DERIVATIVE + 1 + parameter_index>(r_and_derivatives);
+      const mfem::Vector& residual_update = drdparam(*parameter_difference);
 
       // Flip the sign to get the RHS of the Newton update system
       // J^-1 du = - residual
-      residual_update *= -1.0;
-
-      dr_ += residual_update;
+      dr_.Add(-1.0, residual_update);
 
       // Save the current parameter value for the next timestep
       *parameters_[parameter_index].previous_state = *parameters_[parameter_index].state;
-    }
+    });
 
     for (int i = 0; i < constrained_dofs.Size(); i++) {
       int j  = constrained_dofs[i];
@@ -786,12 +1210,69 @@ public:
 
     auto& lin_solver = nonlin_solver_->linearSolver();
 
-    lin_solver.SetOperator(*J_);
+    if (component_prec_ && (nonlin_solver_->matrixFree() || !reuse_jacobian)) {
+      constrainEssentialDofs(true);
+      component_prec_->setMatrix(drdu.assemble_component_blocks());
+      constrainEssentialDofs(false);
+    }
+
+    if (nonlin_solver_->matrixFree()) {
+      lin_solver.SetOperator(*J_operator_);
+    } else if (!reuse_jacobian) {
+      lin_solver.SetOperator(*J_);
+    }
 
     lin_solver.Mult(dr_, du_);
     displacement_ += du_;
 
+    solveWithTentativeUpdates();
+  }
+
+  /**
+   * @brief Take a quasi-static step, halving the timestep and retrying until the nonlinear solve converges
+   *
+   * The material state of a failed attempt is only ever written to the tentative quadrature data buffers, so it
+   * is discarded without copying, see trackQuadratureData().
+   *
+   * @param[inout] dt The timestep to attempt, returns the timestep actually taken
+   */
+  void cutBackQuasiStaticSolve(double& dt)
+  {
+    const double       initial_time = time_;
+    const mfem::Vector initial_displacement(displacement_);
+
+    for (int rejections = 0;; rejections++) {
+      quasiStaticSolve(dt);
+      if (nonlin_solver_->converged()) {
+        return;
+      }
+
+      bool give_up = rejections + 1 >= quasistatic_cutback_.max_rejections || 0.5 * dt < quasistatic_cutback_.min_dt;
+      SLIC_ERROR_ROOT_IF(give_up,
+                         "Quasi-static step did not converge after " << rejections + 1 << " attempts, dt = " << dt);
+      SLIC_INFO_ROOT("Quasi-static step with dt = " << dt << " did not converge, retrying with dt = " << 0.5 * dt);
+
+      rollbackQuadratureData();
+      time_ = initial_time;
+      displacement_.Vector::operator=(initial_displacement);
+      dt *= 0.5;
+    }
+  }
+
+  /**
+   * @brief Solve the quasi-static nonlinear system, letting every residual evaluation update the (tentative)
+   * quadrature data and reactions, so that finishTimestep() can keep those of the converged displacement
+   */
+  void solveWithTentativeUpdates()
+  {
+    reactions_displacement_.Destroy();
+
+    // the time, boundary conditions and committed state may have changed since the last solve
+    residual_->ClearMemoization();
+
+    residual_->update_qdata = true;
     nonlin_solver_->solve(displacement_);
+    residual_->update_qdata = false;
   }
 
   /**
@@ -814,34 +1295,503 @@ public:
       }
     }
 
-    if (is_quasistatic_) {
+    if (is_quasistatic_ && quasistatic_cutback_.adaptive) {
+      cutBackQuasiStaticSolve(dt);
+    } else if (is_quasistatic_) {
       quasiStaticSolve(dt);
+    } else if (is_explicit_) {
+      // the material state and reactions are updated by the step's only residual evaluation
+      explicitStep(dt);
+      cycle_ += 1;
+      measureResultants();
+      return;
     } else {
       ode2_.Step(displacement_, velocity_, time_, dt);
     }
 
-    {
-      // after finding displacements that satisfy equilibrium,
-      // compute the residual one more time, this time enabling
-      // the material state buffers to be updated
-      residual_->update_qdata = true;
-
-      // this seems like the wrong way to be doing this assignment, but
-      // reactions_ = residual(displacement, ...);
-      // isn't currently supported
-      reactions_.Vector::operator=(
-          (*residual_)(displacement_, zero_, shape_displacement_, *parameters_[parameter_indices].state...));
-      // TODO (talamini1): Fix above reactions for dynamics. Setting the accelerations to zero
-      // works for quasi-statics, but we need to account for the accelerations in
-      // dynamics. We need to figure out how to get the updated accelerations out of the
-      // ODE solver.
-
-      residual_->update_qdata = false;
+    finishTimestep();
+  }
+
+  /**
+   * @brief Estimate the stable timestep of each element for explicit dynamics from the CFL condition
+   *
+   * This is dt_e = h_e / (p * c), where h_e is the smallest length scale of the element (from the jacobians of its
+   * geometric factors, see min_element_lengths()), p is the polynomial order and c is the largest (dilatational)
+   * wave speed of the materials.
+   *
+   * @return The stable timestep of each element of this rank, in the order of the mesh elements
+   * @pre Every material must provide `density`, `K` and `G` (see solid_mechanics::has_wave_speed)
+   * @note The estimate uses the undeformed mesh, i.e. it does not account for the shape displacement or for the
+   * change of the element sizes and wave speeds under large deformations
+   */
+  mfem::Vector elementStableTimesteps()
+  {
+    SLIC_ERROR_ROOT_IF(!wave_speeds_known_ || max_wave_speed_ <= 0.0,
+                       "Stable timestep estimates require materials with a density, bulk modulus and shear modulus");
+
+    mfem::Vector dt(mesh_.GetNE());
+
+    mfem::Array<mfem::Geometry::Type> geometries;
+    mesh_.GetGeometries(dim, geometries);
+    for (auto geom : geometries) {
+      // the jacobians at a few points per element are enough to find the thinnest direction of a (curved) element
+      constexpr int q       = 2;
+      auto          lengths = min_element_lengths(*shared_geometric_factors(&mesh_, q, geom), geom);
+
+      std::size_t k = 0;
+      for (int e = 0; e < mesh_.GetNE(); e++) {
+        if (mesh_.GetElementGeometry(e) == geom) {
+          dt[e] = lengths[k++] / (order * max_wave_speed_);
+        }
+      }
     }
 
+    return dt;
+  }
+
+  /**
+   * @brief Estimate the largest stable timestep for explicit dynamics, the smallest of the elementStableTimesteps()
+   * over all ranks
+   *
+   * @param safety_factor The fraction of the estimated critical timestep to return
+   * @return The stable timestep estimate
+   * @note This does not account for mass scaling, see setMassScalingTimestep()
+   */
+  double stableTimestep(double safety_factor = 0.9)
+  {
+    mfem::Vector dt_e = elementStableTimesteps();
+
+    double dt = (dt_e.Size() > 0) ? dt_e.Min() : std::numeric_limits<double>::max();
+    MPI_Allreduce(MPI_IN_PLACE, &dt, 1, MPI_DOUBLE, MPI_MIN, mesh_.GetComm());
+
+    return safety_factor * dt;
+  }
+
+  /**
+   * @brief Scale the lumped mass of the elements that are too small to be stable at a given explicit timestep
+   *
+   * The dofs of each element whose stable timestep (safety_factor * dt_e, see elementStableTimesteps()) is below
+   * target_dt get their lumped mass scaled by (target_dt / (safety_factor * dt_e))^2, so that a few small elements
+   * (e.g. slivers) don't dictate the timestep of the whole mesh. This adds mass, and so changes the dynamics, only
+   * around those elements. The added mass is logged when the lumped mass is computed.
+   *
+   * @param target_dt The timestep that the explicit steps will take, or 0 to disable mass scaling
+   * @param safety_factor The fraction of the estimated critical timestep of each element that is considered stable
+   */
+  void setMassScalingTimestep(double target_dt, double safety_factor = 0.9)
+  {
+    SLIC_ERROR_ROOT_IF(target_dt < 0.0, "The mass scaling timestep must be non-negative");
+    mass_scaling_dt_            = target_dt;
+    mass_scaling_safety_factor_ = safety_factor;
+
+    // the lumped mass is recomputed by the next explicit step
+    lumped_mass_.SetSize(0);
+  }
+
+  /**
+   * @brief Let each residual evaluation also compute the gradient w.r.t. the displacement, so that the gradient that
+   * a Newton iteration asks for right after the residual at the same displacement doesn't take another pass over
+   * the elements (see Functional::SetMemoization())
+   *
+   * This pays off for full Newton iterations, which evaluate a gradient after every residual. Solvers that reuse
+   * the Jacobian or search along the Newton direction evaluate many residuals without a gradient, each of which
+   * then costs about as much as a gradient evaluation.
+   *
+   * @param enabled Whether to memoize the residual evaluations (off by default)
+   */
+  void setResidualMemoization(bool enabled) { residual_->SetMemoization(enabled ? 0 : NO_DIFFERENTIATION); }
+
+  /**
+   * @brief Replay the element kernels of each residual and Jacobian evaluation on the GPU from a CUDA graph, which
+   * removes most of the kernel launch latency on small meshes per GPU
+   *
+   * @param enabled Whether to use kernel graphs (off by default)
+   * @note see Functional::SetKernelGraphs()
+   */
+  void setKernelGraphs(bool enabled) { residual_->SetKernelGraphs(enabled); }
+
+  /**
+   * @brief Launch the element kernels of the integrals (e.g. the domain and boundary integrals) on the GPU
+   * concurrently, on separate streams
+   *
+   * @param enabled Whether to launch the integrals concurrently (off by default)
+   * @note see Functional::SetConcurrentIntegrals()
+   */
+  void setConcurrentIntegrals(bool enabled) { residual_->SetConcurrentIntegrals(enabled); }
+
+  /**
+   * @brief Begin a timestep that is solved together with other physics (e.g. by Thermomechanics), instead of
+   * with this module's own nonlinear solver
+   *
+   * This advances the time and applies the essential boundary conditions to the displacement, which is then
+   * the unknown of the coupled solve.
+   *
+   * @param dt The timestep
+   * @pre Only quasi-static problems can be solved in a coupled way
+   */
+  void beginCoupledTimestep(double dt)
+  {
+    SLIC_ERROR_ROOT_IF(!residual_,
+                       "completeSetup() must be called prior to beginCoupledTimestep(dt) in SolidMechanics.");
+    SLIC_ERROR_ROOT_IF(!is_quasistatic_, "Coupled timesteps are only supported for quasi-static solid mechanics");
+
+    time_ += dt;
+    for (auto& bc : bcs_.essentials()) {
+      bc.setDofs(displacement_, time_);
+    }
+  }
+
+  /**
+   * @brief The residual of a coupled timestep at the current displacement and parameter values
+   *
+   * @return The residual, with the rows of the essential boundary condition dofs zeroed
+   * @pre beginCoupledTimestep() must be called prior to this call
+   */
+  mfem::Vector coupledResidual()
+  {
+    constrainEssentialDofs(true);
+    mfem::Vector r = (*residual_)(displacement_, zero_, shape_displacement_, *parameters_[parameter_indices].state...);
+    constrainEssentialDofs(false);
+    return r;
+  }
+
+  /**
+   * @brief The Jacobian of a coupled timestep with respect to the displacement
+   *
+   * @return The assembled Jacobian, with the essential boundary condition rows and columns eliminated
+   * @pre beginCoupledTimestep() must be called prior to this call
+   */
+  mfem::HypreParMatrix& coupledJacobian()
+  {
+    auto drdu = serac::get<DERIVATIVE>((*residual_)(differentiate_wrt(displacement_), zero_, shape_displacement_,
+                                                    *parameters_[parameter_indices].state...));
+    constrainEssentialDofs(true);
+    assemble(drdu, J_);
+    constrainEssentialDofs(false);
+    return *J_;
+  }
+
+  /**
+   * @brief The Jacobian of a coupled timestep with respect to one of the parameter fields
+   *
+   * @tparam parameter_index The index of the parameter field
+   * @return The assembled Jacobian, with the essential boundary condition rows zeroed
+   * @pre beginCoupledTimestep() must be called prior to this call
+   */
+  template <int parameter_index>
+  std::unique_ptr<mfem::HypreParMatrix> coupledParameterJacobian()
+  {
+    auto drdp = serac::get<DERIVATIVE>((*residual_)(DifferentiateWRT<NUM_STATE_VARS + parameter_index>{},
+                                                    displacement_, zero_, shape_displacement_,
+                                                    *parameters_[parameter_indices].state...));
+    auto J    = assemble(drdp);
+    J->EliminateRows(bcs_.allEssentialTrueDofs());
+    return J;
+  }
+
+  /// @brief Finish a timestep started with beginCoupledTimestep(), once the coupled solve has converged
+  void endCoupledTimestep()
+  {
+    // the predictor of the next quasi-static solve extrapolates from these parameter values
+    for (auto& parameter : parameters_) {
+      *parameter.previous_state = *parameter.state;
+    }
+
+    finishTimestep();
+  }
+
+protected:
+  /**
+   * @brief Take an explicit central difference step with the lumped mass M_L:
+   *
+   *   u_{n+1} = u_n + dt v_n + dt^2 / 2 a_n
+   *   a_{n+1} = -M_L^{-1} r(u_{n+1}), where r is the residual with zero acceleration (internal minus external forces)
+   *   v_{n+1} = v_n + dt / 2 (a_n + a_{n+1})
+   *
+   * so each step is a single residual evaluation and a diagonal scaling. The essential boundary conditions
+   * prescribe the displacement, velocity and acceleration of the constrained dofs directly.
+   *
+   * @param dt The timestep, see stableTimestep()
+   */
+  void explicitStep(double dt)
+  {
+    updateLumpedMass();
+
+    const mfem::Vector& dU_dt            = bc_values_[1];
+    const mfem::Vector& d2U_dt2          = bc_values_[2];
+    const auto&         constrained_dofs = bcs_.allEssentialTrueDofs();
+
+    // the prescribed acceleration of the constrained dofs
+    auto constrained_acceleration = [&](mfem::Vector& acceleration) {
+      for (int dof : constrained_dofs) {
+        acceleration[dof] = d2U_dt2[dof];
+      }
+    };
+
+    // the acceleration of the initial conditions
+    if (cycle_ == 0) {
+      applyExplicitBoundaryConditions(time_);
+      explicitAcceleration(previous_);
+      constrained_acceleration(previous_);
+    }
+
+    displacement_.Add(dt, velocity_);
+    displacement_.Add(0.5 * dt * dt, previous_);
+    time_ += dt;
+    applyExplicitBoundaryConditions(time_);
+
+    residual_->update_qdata = true;
+    explicitAcceleration(acceleration_);
+    residual_->update_qdata = false;
+
+    constrained_acceleration(acceleration_);
+
+    velocity_.Add(0.5 * dt, previous_);
+    velocity_.Add(0.5 * dt, acceleration_);
+    previous_ = acceleration_;
+
+    for (int dof : constrained_dofs) {
+      velocity_[dof] = dU_dt[dof];
+    }
+  }
+
+  /**
+   * @brief Set the displacement of the constrained dofs at time t, keeping their prescribed velocity and acceleration
+   *
+   * @param t The time
+   */
+  void applyExplicitBoundaryConditions(double t)
+  {
+    auto& [U, dU_dt, d2U_dt2] = bc_values_;
+    bcs_.setEssentialDofs(t, mfem_ext::SecondOrderODE::epsilon, U, dU_dt, &d2U_dt2);
+
+    for (int dof : bcs_.allEssentialTrueDofs()) {
+      displacement_[dof] = U[dof];
+    }
+  }
+
+  /**
+   * @brief Compute the acceleration a = -M_L^{-1} r(u) of the current displacement, along with the reactions
+   *
+   * @param[out] acceleration The acceleration (the constrained dofs are overwritten by the caller)
+   */
+  void explicitAcceleration(mfem::Vector& acceleration)
+  {
+    ode_time_point_ = time_;
+
+    // with zero acceleration, the residual is the difference of internal and external forces, i.e. the reactions
+    reactions_.Vector::operator=(
+        (*residual_)(displacement_, zero_, shape_displacement_, *parameters_[parameter_indices].state...));
+
+    for (int i = 0; i < acceleration.Size(); i++) {
+      acceleration[i] = -reactions_[i] / lumped_mass_[i];
+    }
+  }
+
+  /**
+   * @brief Compute the lumped mass from the row sums of the mass matrix dR/da, unless it is still current
+   *
+   * Row sums of higher order mass matrices (e.g. on quadratic simplices) need not be positive, in which case
+   * the diagonal of the mass matrix, scaled to the same total mass, is used instead.
+   */
+  void updateLumpedMass()
+  {
+    bool current = constant_mass_ && lumped_mass_.Size() == shape_displacement_.Size() &&
+                   lumped_mass_shape_displacement_.DistanceTo(shape_displacement_.GetData()) == 0.0;
+    if (current) {
+      return;
+    }
+
+    auto [r, M] = (*residual_)(displacement_, differentiate_wrt(zero_), shape_displacement_,
+                               *parameters_[parameter_indices].state...);
+
+    mfem::Vector ones(zero_.Size());
+    ones         = 1.0;
+    lumped_mass_ = M(ones);
+
+    double min_mass = lumped_mass_.Min();
+    MPI_Allreduce(MPI_IN_PLACE, &min_mass, 1, MPI_DOUBLE, MPI_MIN, mesh_.GetComm());
+
+    if (min_mass <= 0.0) {
+      mfem::Vector diagonal;
+      M.AssembleDiagonal(diagonal);
+
+      std::array<double, 2> totals = {lumped_mass_.Sum(), diagonal.Sum()};
+      MPI_Allreduce(MPI_IN_PLACE, totals.data(), 2, MPI_DOUBLE, MPI_SUM, mesh_.GetComm());
+
+      lumped_mass_ = diagonal;
+      lumped_mass_ *= totals[0] / totals[1];
+    }
+
+    if (mass_scaling_dt_ > 0.0) {
+      scaleLumpedMass();
+    }
+
+    lumped_mass_shape_displacement_ = shape_displacement_;
+  }
+
+  /// @brief Apply the mass scaling of setMassScalingTimestep() to the lumped mass
+  void scaleLumpedMass()
+  {
+    mfem::Vector dt_e  = elementStableTimesteps();
+    auto&        space = displacement_.space();
+
+    // each local dof takes the largest scaling of the elements it belongs to
+    mfem::Vector     scaling_L(space.GetVSize());
+    mfem::Array<int> vdofs;
+    scaling_L = 1.0;
+    for (int e = 0; e < mesh_.GetNE(); e++) {
+      double ratio   = mass_scaling_dt_ / (mass_scaling_safety_factor_ * dt_e[e]);
+      double scaling = ratio * ratio;
+      if (scaling > 1.0) {
+        space.GetElementVDofs(e, vdofs);
+        for (int dof : vdofs) {
+          scaling_L[dof] = std::max(scaling_L[dof], scaling);
+        }
+      }
+    }
+
+    // dofs shared between ranks take the largest scaling of their elements on any rank
+    space.GroupComm().Reduce<double>(scaling_L.GetData(), mfem::GroupCommunicator::Max<double>);
+    space.GroupComm().Bcast<double>(scaling_L.GetData());
+
+    mfem::Vector scaling(lumped_mass_.Size());
+    space.GetRestrictionMatrix()->Mult(scaling_L, scaling);
+
+    std::array<double, 2> masses = {lumped_mass_.Sum(), 0.0};
+    for (int i = 0; i < lumped_mass_.Size(); i++) {
+      masses[1] += (scaling[i] - 1.0) * lumped_mass_[i];
+      lumped_mass_[i] *= scaling[i];
+    }
+    MPI_Allreduce(MPI_IN_PLACE, masses.data(), 2, MPI_DOUBLE, MPI_SUM, mesh_.GetComm());
+
+    SLIC_INFO_ROOT(axom::fmt::format("Mass scaling for an explicit timestep of {} adds {:.3}% to the total mass",
+                                     mass_scaling_dt_, 100.0 * masses[1] / masses[0]));
+  }
+
+  /// @brief Update the material state and reactions for the converged displacement, and advance the cycle
+  void finishTimestep()
+  {
+    // Newton's last residual evaluation is usually at the converged displacement, in which case it already computed
+    // the material state and reactions, see solveWithTentativeUpdates()
+    bool converged_evaluation = is_quasistatic_ && reactions_displacement_.Size() == displacement_.Size() &&
+                                reactions_displacement_.DistanceTo(displacement_.GetData()) == 0.0;
+    reactions_displacement_.Destroy();
+
+    if (converged_evaluation) {
+      commitQuadratureData();
+      cycle_ += 1;
+      measureResultants();
+      return;
+    }
+
+    // after finding displacements that satisfy equilibrium,
+    // compute the residual one more time, this time enabling
+    // the material state buffers to be updated
+    residual_->update_qdata = true;
+
+    // this seems like the wrong way to be doing this assignment, but
+    // reactions_ = residual(displacement, ...);
+    // isn't currently supported
+    reactions_.Vector::operator=(
+        (*residual_)(displacement_, zero_, shape_displacement_, *parameters_[parameter_indices].state...));
+    // TODO (talamini1): Fix above reactions for dynamics. Setting the accelerations to zero
+    // works for quasi-statics, but we need to account for the accelerations in
+    // dynamics. We need to figure out how to get the updated accelerations out of the
+    // ODE solver.
+
+    residual_->update_qdata = false;
+    commitQuadratureData();
+
     cycle_ += 1;
+    measureResultants();
+  }
+
+  /// @brief Sum the reactions of the resultants due on this cycle, with a single reduction over the ranks
+  void measureResultants()
+  {
+    std::vector<Resultant*> due;
+    for (auto& resultant : resultants_) {
+      if (cycle_ % resultant.cycle_interval == 0) {
+        due.push_back(&resultant);
+      }
+    }
+    if (due.empty()) return;
+
+    std::vector<double> sums(due.size() * dim, 0.0);
+    const double*       reactions = reactions_.HostRead();
+    for (std::size_t i = 0; i < due.size(); i++) {
+      for (int c = 0; c < dim; c++) {
+        for (int dof : due[i]->true_dofs[std::size_t(c)]) {
+          sums[i * dim + std::size_t(c)] += reactions[dof];
+        }
+      }
+    }
+
+    MPI_Allreduce(MPI_IN_PLACE, sums.data(), int(sums.size()), MPI_DOUBLE, MPI_SUM, mesh_.GetComm());
+
+    for (std::size_t i = 0; i < due.size(); i++) {
+      for (int c = 0; c < dim; c++) {
+        due[i]->value[c] = sums[i * dim + std::size_t(c)];
+      }
+    }
+  }
+
+  /// @brief the number of elements with the given attributes (or of every element, if there are none)
+  size_t numElementsWithAttributes(const std::set<int>& attributes) const
+  {
+    if (attributes.empty()) return size_t(mesh_.GetNE());
+
+    size_t num_elements = 0;
+    for (int e = 0; e < mesh_.GetNE(); e++) {
+      num_elements += attributes.count(mesh_.GetAttribute(e));
+    }
+    return num_elements;
+  }
+
+  /**
+   * @brief Register the quadrature data of a material or custom integral
+   *
+   * Quasi-static solves update it tentatively in every residual evaluation, and only the updates from the converged
+   * displacement are committed (by swapping buffers), in finishTimestep(). Dynamic and explicit steps update it
+   * directly. The committed data is also saved by the checkpoints of solveTransientAdjoint(), and in the restart
+   * files (see StateManager::storeQuadratureData()), from which it is restored here on a restart.
+   */
+  template <typename StateType>
+  void trackQuadratureData(std::shared_ptr<QuadratureData<StateType>> qdata)
+  {
+    if constexpr (!std::is_same_v<StateType, Nothing> && !std::is_same_v<StateType, Empty>) {
+      if (qdata) {
+        StateManager::storeQuadratureData(
+            detail::addPrefix(name_, "quadrature_data_" + std::to_string(checkpointed_qdata_.size())), qdata,
+            sidre_datacoll_id_);
+        checkpointed_qdata_.push_back([qdata]() { return qdata->bytes(); });
+      }
+      if (is_quasistatic_ && qdata) {
+        qdata->enableTentativeUpdates();
+        commit_qdata_.push_back([qdata]() { qdata->commit(); });
+        rollback_qdata_.push_back([qdata]() { qdata->rollback(); });
+      }
+    }
+  }
+
+  /// @brief Commit the tentative quadrature data updates, see trackQuadratureData()
+  void commitQuadratureData()
+  {
+    for (auto& commit : commit_qdata_) {
+      commit();
+    }
+  }
+
+  /// @brief Discard the tentative quadrature data updates since the last commit, see trackQuadratureData()
+  void rollbackQuadratureData()
+  {
+    for (auto& rollback : rollback_qdata_) {
+      rollback();
+    }
   }
 
+public:
   /**
    * @brief Solve the adjoint problem
    * @pre It is expected that the forward analysis is complete and the current displacement state is valid
@@ -866,29 +1816,27 @@ public:
     auto disp_adjoint_load = adjoint_loads.find("displacement");
 
     SLIC_ERROR_ROOT_IF(disp_adjoint_load == adjoint_loads.end(), "Adjoint load for \"displacement\" not found.");
-    mfem::HypreParVector adjoint_load_vector(disp_adjoint_load->second);
+    auto adjoint_load_vector = StateManager::scratchVector(displacement_.space());
+    *adjoint_load_vector     = disp_adjoint_load->second;
 
     // Add the sign correction to move the term to the RHS
-    adjoint_load_vector *= -1.0;
-
-    auto& lin_solver = nonlin_solver_->linearSolver();
+    *adjoint_load_vector *= -1.0;
 
     // By default, use a homogeneous essential boundary condition
-    mfem::HypreParVector adjoint_essential(disp_adjoint_load->second);
-    adjoint_essential = 0.0;
+    auto adjoint_essential = StateManager::scratchVector(displacement_.space());
+    *adjoint_essential     = 0.0;
 
     // sam: is this the right thing to be doing for dynamics simulations,
     // or are we implicitly assuming this should only be used in quasistatic analyses?
     auto drdu     = serac::get<DERIVATIVE>((*residual_)(differentiate_wrt(displacement_), zero_, shape_displacement_,
                                                     *parameters_[parameter_indices].state...));
     auto jacobian = assemble(drdu);
-    auto J_T      = std::unique_ptr<mfem::HypreParMatrix>(jacobian->Transpose());
 
     // If we have a non-homogeneous essential boundary condition, extract it from the given state
     auto essential_adjoint_disp = adjoint_with_essential_boundary.find("displacement");
 
     if (essential_adjoint_disp != adjoint_with_essential_boundary.end()) {
-      adjoint_essential = essential_adjoint_disp->second;
+      *adjoint_essential = essential_adjoint_disp->second;
     } else {
       // If the essential adjoint load container does not have a displacement dual but it has a non-zero size, the
       // user has supplied an incorrectly-named dual vector.
@@ -897,12 +1845,23 @@ public:
                     "boundary condition named \"displacement\"");
     }
 
-    for (const auto& bc : bcs_.essentials()) {
-      bc.apply(*J_T, adjoint_load_vector, adjoint_essential);
+    // Eliminating the essential dofs symmetrically commutes with the transpose, so the forward matrix is eliminated
+    // and the transposed eliminated columns are moved to the RHS
+    auto J_e = bcs_.eliminateAllEssentialDofsFromMatrix(*jacobian);
+    J_e->MultTranspose(-1.0, *adjoint_essential, 1.0, *adjoint_load_vector);
+    for (int dof : bcs_.allEssentialTrueDofs()) {
+      (*adjoint_load_vector)(dof) = (*adjoint_essential)(dof);
     }
 
-    lin_solver.SetOperator(*J_T);
-    lin_solver.Mult(adjoint_load_vector, adjoint_displacement_);
+    // the transpose of the separate-displacement-component matrix is that of the transposed Jacobian
+    if (component_prec_) {
+      constrainEssentialDofs(true);
+      auto components = drdu.assemble_component_blocks();
+      constrainEssentialDofs(false);
+      component_prec_->setMatrix(std::unique_ptr<mfem::HypreParMatrix>(components->Transpose()));
+    }
+
+    nonlin_solver_->solveTranspose(*jacobian, *adjoint_load_vector, adjoint_displacement_);
 
     return {{"adjoint_displacement", adjoint_displacement_}};
   }
@@ -923,9 +1882,8 @@ public:
 
     auto drdparam = serac::get<DERIVATIVE>(d_residual_d_[parameter_field]());
 
-    auto drdparam_mat = assemble(drdparam);
-
-    drdparam_mat->MultTranspose(adjoint_displacement_, *parameters_[parameter_field].sensitivity);
+    // the transposed gradient is applied matrix-free, so no (rectangular) sparse matrix is assembled
+    drdparam.MultTranspose(adjoint_displacement_, *parameters_[parameter_field].sensitivity);
 
     return *parameters_[parameter_field].sensitivity;
   }
@@ -938,16 +1896,43 @@ public:
    */
   FiniteElementDual& computeShapeSensitivity() override
   {
+    // the residual's derivatives w.r.t. the shape are reused while its arguments don't change (see
+    // Functional::SetGradientCaching()), but the loads may also depend on the time
+    if (time_ != shape_derivative_time_) {
+      residual_->ClearMemoization();
+      shape_derivative_time_ = time_;
+    }
+
     auto drdshape = serac::get<DERIVATIVE>((*residual_)(DifferentiateWRT<2>{}, displacement_, zero_,
                                                         shape_displacement_, *parameters_[parameter_indices].state...));
 
-    auto drdshape_mat = assemble(drdshape);
-
-    drdshape_mat->MultTranspose(adjoint_displacement_, shape_displacement_sensitivity_);
+    drdshape.MultTranspose(adjoint_displacement_, shape_displacement_sensitivity_);
 
     return shape_displacement_sensitivity_;
   }
 
+  /**
+   * @brief Compute the implicit sensitivities of the quantity of interest used in defining the load for the adjoint
+   * problem with respect to every parameter field and the shape displacement field
+   *
+   * The residual is evaluated once, differentiating w.r.t. all of those fields in the same pass over the elements,
+   * and the transpose of each gradient is applied to the adjoint matrix-free.
+   *
+   * @pre `solveAdjoint` with an appropriate adjoint load must be called prior to this method.
+   */
+  void computeAllSensitivities() override
+  {
+    auto derivatives = (*residual_)(DifferentiateWRT<2, NUM_STATE_VARS + parameter_indices...>{},
+                                    displacement_, zero_, shape_displacement_,
+                                    *parameters_[parameter_indices].state...);
+
+    // the first derivative is that of the shape displacement, followed by those of the parameters, in order
+    serac::get<1>(derivatives).MultTranspose(adjoint_displacement_, shape_displacement_sensitivity_);
+    (serac::get<2 + parameter_indices>(derivatives)
+         .MultTranspose(adjoint_displacement_, *parameters_[parameter_indices].sensitivity),
+     ...);
+  }
+
   /**
    * @brief Get the displacement state
    *
@@ -981,6 +1966,62 @@ public:
   /// @brief getter for nodal forces (before zeroing-out essential dofs)
   const serac::FiniteElementDual& reactions() { return reactions_; };
 
+  /**
+   * @brief Adds the resultant of the reactions on some boundary attributes (e.g. the force on a loaded surface) to
+   * the measurements taken at the end of the timesteps, see resultant()
+   *
+   * The true dofs of the attributes are only found once, and the resultants due on a cycle are all reduced over the
+   * ranks at once. Each component is also added to the summary data, as `<name>_x`, `<name>_y` (and `<name>_z`).
+   *
+   * @param name The name of the resultant
+   * @param attributes The boundary attributes to sum the reactions over
+   * @param cycle_interval Measure the resultant at the end of the cycles that are multiples of this
+   * @pre This must be called before initializeSummary(), for the resultant to be in the summary data
+   */
+  void addResultant(const std::string& name, const std::set<int>& attributes, int cycle_interval = 1)
+  {
+    SLIC_ERROR_ROOT_IF(cycle_interval < 1, "The cycle interval of a resultant must be positive");
+
+    mfem::Array<int> markers(mesh_.bdr_attributes.Max());
+    markers = 0;
+    for (int attr : attributes) {
+      SLIC_ERROR_ROOT_IF(attr < 1 || attr > markers.Size(), axom::fmt::format("Invalid boundary attribute {}", attr));
+      markers[attr - 1] = 1;
+    }
+
+    // each true dof is owned by a single rank, so the sums over them add up to the resultant without double counting
+    Resultant resultant{.name = name, .cycle_interval = cycle_interval};
+    for (int c = 0; c < dim; c++) {
+      displacement_.space().GetEssentialTrueDofs(markers, resultant.true_dofs[std::size_t(c)], c);
+    }
+    resultants_.push_back(std::move(resultant));
+
+    constexpr const char* axes[3] = {"x", "y", "z"};
+    for (int c = 0; c < dim; c++) {
+      std::size_t index = resultants_.size() - 1;
+      addSummaryQuantity(axom::fmt::format("{}_{}", name, axes[c]),
+                         [this, index, c]() { return resultants_[index].value[c]; });
+    }
+  }
+
+  /**
+   * @brief The resultant of the reactions on some boundary attributes, as of its last measurement
+   *
+   * @param name The name of the resultant, see addResultant()
+   */
+  tensor<double, dim> resultant(const std::string& name) const
+  {
+    for (const auto& resultant : resultants_) {
+      if (resultant.name == name) {
+        return resultant.value;
+      }
+    }
+
+    SLIC_ERROR_ROOT(axom::fmt::format("Resultant '{}' requested from solid mechanics module '{}', but it doesn't exist",
+                                      name, name_));
+    return {};
+  }
+
 protected:
   /// The compile-time finite element trial space for displacement and velocity (H1 of order p)
   using trial = H1<order, dim>;
@@ -1007,6 +2048,9 @@ protected:
   /// serac::Functional that is used to calculate the residual and its derivatives
   std::unique_ptr<Functional<test(trial, trial, shape_trial, parameter_space...)>> residual_;
 
+  /// the placeholder states of the parameters given at quadrature points, see setParameter()
+  std::vector<std::unique_ptr<FiniteElementState>> quadrature_point_parameter_states_;
+
   /// mfem::Operator that calculates the residual after applying essential boundary conditions
   std::unique_ptr<mfem_ext::StdFunctionOperator> residual_with_bcs_;
 
@@ -1020,6 +2064,9 @@ protected:
    */
   mfem_ext::SecondOrderODE ode2_;
 
+  /// Extrapolates the last converged displacements for the initial guess of quasi-static solves
+  SolutionExtrapolator predictor_;
+
   /// Assembled sparse matrix for the Jacobian
   std::unique_ptr<mfem::HypreParMatrix> J_;
 
@@ -1027,9 +2074,38 @@ protected:
   /// because are associated with essential boundary conditions
   std::unique_ptr<mfem::HypreParMatrix> J_e_;
 
+  /// the action of the Jacobian with essential boundary conditions applied, used instead of J_ for matrix-free solves
+  std::unique_ptr<mfem::ConstrainedOperator> J_operator_;
+
+  /// the preconditioner, if it is set up from the matrices of assemble_component_blocks() (owned by nonlin_solver_)
+  SeparateComponentPreconditioner* component_prec_ = nullptr;
+
   /// an intermediate variable used to store the predicted end-step displacement
   mfem::Vector predicted_displacement_;
 
+  /// the displacement of the last residual evaluation that also computed reactions_, see solveWithTentativeUpdates()
+  mfem::Vector reactions_displacement_;
+
+  /// @brief A resultant of the reactions on some boundary attributes, see addResultant()
+  struct Resultant {
+    std::string                       name;            ///< the name of the resultant
+    std::array<mfem::Array<int>, dim> true_dofs;       ///< the true dofs (of this rank) of each component
+    int                               cycle_interval;  ///< it is measured on the cycles that are multiples of this
+    tensor<double, dim>               value{};         ///< the value at its last measurement
+  };
+
+  /// the resultants measured at the end of the timesteps
+  std::vector<Resultant> resultants_;
+
+  /// commits the tentative updates of each quadrature data buffer, see trackQuadratureData()
+  std::vector<std::function<void()>> commit_qdata_;
+
+  /// discards the tentative updates of each quadrature data buffer, see trackQuadratureData()
+  std::vector<std::function<void()>> rollback_qdata_;
+
+  /// the limits on cutting back failed quasi-static steps, if TimesteppingOptions::adaptive is set
+  TimesteppingOptions quasistatic_cutback_;
+
   /// vector used to store the change in essential bcs between timesteps
   mfem::Vector du_;
 
@@ -1045,6 +2121,42 @@ protected:
   /// @brief the previous acceleration, used as a starting guess for newton's method
   mfem::Vector previous_;
 
+  /// @brief whether the mass term dR/da depends only on the (constant) density and the shape displacement
+  bool constant_mass_ = true;
+
+  /// @brief whether the dynamics are integrated explicitly, see explicitStep()
+  bool is_explicit_ = false;
+
+  /// @brief the lumped (diagonal) mass of explicit dynamics
+  mfem::Vector lumped_mass_;
+
+  /// @brief the shape displacement that lumped_mass_ was computed with
+  mfem::Vector lumped_mass_shape_displacement_;
+
+  /// @brief the end-step acceleration of an explicit step
+  mfem::Vector acceleration_;
+
+  /// @brief the prescribed displacement, velocity and acceleration of the constrained dofs of explicit steps
+  std::array<mfem::Vector, 3> bc_values_;
+
+  /// @brief the largest wave speed of the materials, used by stableTimestep()
+  double max_wave_speed_ = 0.0;
+
+  /// @brief whether the wave speed of every material is known
+  bool wave_speeds_known_ = true;
+
+  /// @brief the explicit timestep that the lumped mass is scaled for, see setMassScalingTimestep() (0 if unused)
+  double mass_scaling_dt_ = 0.0;
+
+  /// @brief the fraction of the critical timestep of each element that mass scaling considers stable
+  double mass_scaling_safety_factor_ = 0.9;
+
+  /// @brief the rank-local values of the mass term dR/da, cached for the dynamic Jacobian when constant_mass_ is set
+  std::vector<double> mass_values_;
+
+  /// @brief the shape displacement that mass_values_ was computed with
+  mfem::Vector mass_shape_displacement_;
+
   /// coefficient used to calculate predicted displacement: u_p := u + c0 * d2u_dt2
   double c0_;
 
@@ -1063,6 +2175,23 @@ protected:
   /// @brief An auxilliary zero vector
   mfem::Vector zero_;
 
+  /// @brief the time of the last shape derivative of the residual, see computeShapeSensitivity()
+  double shape_derivative_time_ = 0.0;
+
+  /**
+   * @brief Start (or stop) constraining the essential boundary condition dofs in the residual and its assembled
+   * Jacobians, while they are evaluated for the nonlinear solver (see Functional::SetEssentialTrueDofs())
+   *
+   * @param constrain whether the evaluations that follow should be constrained
+   */
+  void constrainEssentialDofs(bool constrain)
+  {
+    if (constrain) {
+      residual_->SetEssentialTrueDofs(bcs_.allEssentialTrueDofs());
+    }
+    residual_->constrain_essential_dofs = constrain;
+  }
+
   /// @brief Array functions computing the derivative of the residual with respect to each given parameter
   /// @note This is needed so the user can ask for a specific sensitivity at runtime as opposed to it being a
   /// template parameter.
@@ -1075,4 +2204,15 @@ protected:
       }...};
 };
 
+/// @cond
+// The common specializations (orders 1-3, in 2D and 3D) are compiled once, in solid_mechanics.cpp, and
+// applications link to them instead of instantiating them again
+extern template class SolidMechanics<1, 2>;
+extern template class SolidMechanics<2, 2>;
+extern template class SolidMechanics<3, 2>;
+extern template class SolidMechanics<1, 3>;
+extern template class SolidMechanics<2, 3>;
+extern template class SolidMechanics<3, 3>;
+/// @endcond
+
 }  // namespace serac
@@ -11,7 +11,7 @@ namespace serac {
 void SolidMechanicsInputOptions::defineInputFileSchema(axom::inlet::Container& container)
 {
   // interpolation order - currently up to 3rd order is allowed
-  container.addInt("order", "polynomial order of the basis functions.").defaultValue(1).range(1, 3);
+  container.addInt("order", "polynomial order of the basis functions.").defaultValue(1).range(1, 8);
 
   // neo-Hookean material parameters
   container.addDouble("mu", "Shear modulus in the Neo-Hookean hyperelastic model.").defaultValue(0.25);
@@ -29,6 +29,13 @@ void SolidMechanicsInputOptions::defineInputFileSchema(axom::inlet::Container& c
 
   container.addDouble("density", "Initial mass density").defaultValue(1.0);
 
+  // J2 plasticity material parameters, with the elastic moduli above
+  auto& plasticity_container =
+      container.addStruct("plasticity", "J2 plasticity, in place of the (Neo-Hookean or linear) elastic model");
+  plasticity_container.addDouble("sigma_y", "Yield stress").required();
+  plasticity_container.addDouble("Hi", "Isotropic hardening modulus").defaultValue(0.0);
+  plasticity_container.addDouble("Hk", "Kinematic hardening modulus").defaultValue(0.0);
+
   auto& equation_solver_container =
       container.addStruct("equation_solver", "Linear and Nonlinear stiffness Solver Parameters.");
   serac::EquationSolver::defineInputFileSchema(equation_solver_container);
@@ -68,7 +75,8 @@ serac::SolidMechanicsInputOptions FromInlet<serac::SolidMechanicsInputOptions>::
     const static std::map<std::string, serac::TimestepMethod> timestep_methods = {
         {"AverageAcceleration", serac::TimestepMethod::AverageAcceleration},
         {"NewmarkBeta", serac::TimestepMethod::Newmark},
-        {"BackwardEuler", serac::TimestepMethod::BackwardEuler}};
+        {"BackwardEuler", serac::TimestepMethod::BackwardEuler},
+        {"ExplicitCentralDifference", serac::TimestepMethod::ExplicitCentralDifference}};
     std::string timestep_method = dynamics["timestepper"];
     SLIC_ERROR_ROOT_IF(timestep_methods.count(timestep_method) == 0,
                        "Unrecognized timestep method: " << timestep_method);
@@ -101,6 +109,15 @@ serac::SolidMechanicsInputOptions FromInlet<serac::SolidMechanicsInputOptions>::
   // Set the material nonlinearity flag
   result.material_nonlin = base["material_nonlin"];
 
+  if (base.contains("plasticity")) {
+    auto                                          plasticity = base["plasticity"];
+    serac::SolidMechanicsInputOptions::Plasticity parameters;
+    parameters.sigma_y = plasticity["sigma_y"];
+    parameters.Hi      = plasticity["Hi"];
+    parameters.Hk      = plasticity["Hk"];
+    result.plasticity  = parameters;
+  }
+
   if (base.contains("boundary_conds")) {
     result.boundary_conditions =
         base["boundary_conds"].get<std::unordered_map<std::string, serac::input::BoundaryConditionInputOptions>>();
@@ -87,6 +87,20 @@ struct SolidMechanicsInputOptions {
    */
   bool material_nonlin;
 
+  /// @brief The parameters of a J2 plasticity model, whose elastic moduli are K and mu
+  struct Plasticity {
+    double sigma_y;  ///< yield stress
+    double Hi;       ///< isotropic hardening modulus
+    double Hk;       ///< kinematic hardening modulus
+  };
+
+  /**
+   * @brief The J2 plasticity parameters, when the material is plastic rather than elastic
+   *
+   */
+  // TODO: Move to material options
+  std::optional<Plasticity> plasticity;
+
   /**
    * @brief Boundary condition information
    *
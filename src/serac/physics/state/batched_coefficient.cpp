@@ -0,0 +1,115 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/physics/state/batched_coefficient.hpp"
+
+#include "serac/infrastructure/logger.hpp"
+
+namespace serac {
+
+void BatchedFunction::evaluate(const mfem::Vector& X, double t, mfem::Vector& values) const
+{
+  bool on_device = (exec_ == ExecutionSpace::GPU);
+  auto n         = static_cast<uint32_t>(values.Size() / vdim_);
+  function_(X.Read(on_device), t, values.Write(on_device), n);
+}
+
+double BatchedCoefficient::Eval(mfem::ElementTransformation& T, const mfem::IntegrationPoint& ip)
+{
+  mfem::Vector X(T.GetSpaceDim());
+  T.Transform(ip, X);
+
+  mfem::Vector value(1);
+  evaluate(X, value);
+  return value.HostRead()[0];
+}
+
+void BatchedVectorCoefficient::Eval(mfem::Vector& V, mfem::ElementTransformation& T, const mfem::IntegrationPoint& ip)
+{
+  mfem::Vector X(T.GetSpaceDim());
+  T.Transform(ip, X);
+
+  V.SetSize(vdim);
+  evaluate(X, V);
+  V.HostRead();
+}
+
+bool hasNodalDofs(const mfem::ParFiniteElementSpace& space)
+{
+  const mfem::Mesh*                 mesh = space.GetMesh();
+  mfem::Array<mfem::Geometry::Type> geometries;
+  mesh->GetGeometries(mesh->Dimension(), geometries);
+
+  for (auto geometry : geometries) {
+    if (!dynamic_cast<const mfem::NodalFiniteElement*>(space.FEColl()->FiniteElementForGeometry(geometry))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+mfem::Vector nodeCoordinates(const mfem::ParFiniteElementSpace& space, const mfem::Array<int>& nodes)
+{
+  mfem::ParMesh* mesh = space.GetParMesh();
+  int            dim  = mesh->SpaceDimension();
+
+  // the dofs of a space only depend on the mesh and the collection, so the nodes of this (vector-valued) space
+  // are numbered the same way as those of the given one
+  mfem::ParFiniteElementSpace coordinate_space(mesh, space.FEColl(), dim, mfem::Ordering::byVDIM);
+  mfem::ParGridFunction       coordinates(&coordinate_space);
+  mesh->GetNodes(coordinates);
+
+  mfem::Vector X(dim * nodes.Size());
+  X.UseDevice(true);
+  double*       x     = X.HostWrite();
+  const double* all_x = coordinates.HostRead();
+  for (int i = 0; i < nodes.Size(); i++) {
+    for (int d = 0; d < dim; d++) {
+      x[i * dim + d] = all_x[nodes[i] * dim + d];
+    }
+  }
+  return X;
+}
+
+void projectAtNodes(const BatchedCoefficient& coef, const mfem::Array<int>& nodes, const mfem::Vector& X,
+                    mfem::ParGridFunction& grid_function, std::optional<int> component)
+{
+  mfem::Vector values(nodes.Size());
+  values.UseDevice(true);
+  coef.evaluate(X, values);
+
+  const mfem::ParFiniteElementSpace& space = *grid_function.ParFESpace();
+  const double*                      v     = values.HostRead();
+  double*                            u     = grid_function.HostReadWrite();
+  for (int i = 0; i < nodes.Size(); i++) {
+    u[space.DofToVDof(nodes[i], component.value_or(0))] = v[i];
+  }
+}
+
+void projectAtNodes(const BatchedVectorCoefficient& coef, const mfem::Array<int>& nodes, const mfem::Vector& X,
+                    mfem::ParGridFunction& grid_function)
+{
+  const mfem::ParFiniteElementSpace& space = *grid_function.ParFESpace();
+  int                                vdim  = space.GetVDim();
+  SLIC_ERROR_ROOT_IF(
+      coef.components() != vdim,
+      axom::fmt::format("Batched coefficient with {} components cannot be projected onto a space with {}",
+                        coef.components(), vdim));
+
+  mfem::Vector values(vdim * nodes.Size());
+  values.UseDevice(true);
+  coef.evaluate(X, values);
+
+  const double* v = values.HostRead();
+  double*       u = grid_function.HostReadWrite();
+  for (int i = 0; i < nodes.Size(); i++) {
+    for (int c = 0; c < vdim; c++) {
+      u[space.DofToVDof(nodes[i], c)] = v[i * vdim + c];
+    }
+  }
+}
+
+}  // namespace serac
@@ -0,0 +1,204 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file batched_coefficient.hpp
+ *
+ * @brief Coefficients that are evaluated at many points at once, for projecting boundary conditions and initial
+ * conditions without a (virtual) call per node
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <optional>
+
+#include "mfem.hpp"
+
+#include "serac/infrastructure/accelerator.hpp"
+#include "serac/numerics/functional/tensor.hpp"
+
+namespace serac {
+
+/**
+ * @brief A function of space and time, evaluated at many points at once
+ *
+ * The function is given the coordinates of n points (one point after the other), the time, and an array for its
+ * values at those points (again one point after the other), both in the memory of its execution space. So a function
+ * for ExecutionSpace::GPU can evaluate the points in a device kernel (e.g. with accelerator::forall()).
+ */
+class BatchedFunction {
+public:
+  /// @brief The signature of the function: (coordinates, time, values, number of points)
+  using Function = std::function<void(const double* X, double t, double* values, uint32_t n)>;
+
+  /**
+   * @brief Wraps a batched function
+   *
+   * @param vdim the number of values at each point
+   * @param function the function
+   * @param exec the execution space whose memory the arrays given to @a function are in
+   */
+  BatchedFunction(int vdim, Function function, ExecutionSpace exec = ExecutionSpace::CPU)
+      : vdim_(vdim), function_(std::move(function)), exec_(exec)
+  {
+  }
+
+  /**
+   * @brief Evaluates the function at every point
+   *
+   * @param X the coordinates of the points, one point after the other
+   * @param t the time
+   * @param values the values at the points, one point after the other (with `vdim` values per point)
+   */
+  void evaluate(const mfem::Vector& X, double t, mfem::Vector& values) const;
+
+private:
+  /// @brief The number of values at each point
+  int vdim_;
+
+  /// @brief The function
+  Function function_;
+
+  /// @brief The execution space whose memory the arrays given to the function are in
+  ExecutionSpace exec_;
+};
+
+/**
+ * @brief A scalar coefficient defined by a batched function
+ *
+ * FiniteElementState::project() (and the boundary conditions) evaluate it once for all the nodes they set. Other
+ * users of the coefficient evaluate it one point at a time, through the usual mfem::Coefficient interface.
+ */
+class BatchedCoefficient : public mfem::Coefficient {
+public:
+  /**
+   * @brief Wraps a batched function with one value per point
+   *
+   * @param function the function, see BatchedFunction
+   * @param exec the execution space whose memory the arrays given to @a function are in
+   */
+  BatchedCoefficient(BatchedFunction::Function function, ExecutionSpace exec = ExecutionSpace::CPU)
+      : function_(1, std::move(function), exec)
+  {
+  }
+
+  /// @brief Evaluates the function at every point (see BatchedFunction::evaluate()), at the time of the coefficient
+  void evaluate(const mfem::Vector& X, mfem::Vector& values) const { function_.evaluate(X, time, values); }
+
+  /// @brief Evaluates the function at a single point
+  double Eval(mfem::ElementTransformation& T, const mfem::IntegrationPoint& ip) override;
+
+private:
+  /// @brief The function
+  BatchedFunction function_;
+};
+
+/// @brief A vector coefficient defined by a batched function, see BatchedCoefficient
+class BatchedVectorCoefficient : public mfem::VectorCoefficient {
+public:
+  /**
+   * @brief Wraps a batched function with @a vdim values per point
+   *
+   * @param vdim the number of values at each point
+   * @param function the function, see BatchedFunction
+   * @param exec the execution space whose memory the arrays given to @a function are in
+   */
+  BatchedVectorCoefficient(int vdim, BatchedFunction::Function function, ExecutionSpace exec = ExecutionSpace::CPU)
+      : mfem::VectorCoefficient(vdim), function_(vdim, std::move(function), exec)
+  {
+  }
+
+  /// @brief Evaluates the function at every point (see BatchedFunction::evaluate()), at the time of the coefficient
+  void evaluate(const mfem::Vector& X, mfem::Vector& values) const { function_.evaluate(X, time, values); }
+
+  /// @brief The number of values at each point
+  int components() const { return vdim; }
+
+  using mfem::VectorCoefficient::Eval;
+
+  /// @brief Evaluates the function at a single point
+  void Eval(mfem::Vector& V, mfem::ElementTransformation& T, const mfem::IntegrationPoint& ip) override;
+
+private:
+  /// @brief The function
+  BatchedFunction function_;
+};
+
+/**
+ * @brief Creates a batched scalar coefficient from a function of a single point, which is evaluated at every point
+ * with accelerator::forall()
+ *
+ * @tparam dim the spatial dimension
+ * @tparam exec where to evaluate the function
+ * @param f the function, `double f(tensor<double, dim> x, double t)`, which must be marked SERAC_HOST_DEVICE (and
+ * only capture by value) for ExecutionSpace::GPU
+ */
+template <int dim, ExecutionSpace exec = ExecutionSpace::CPU, typename lambda>
+std::shared_ptr<BatchedCoefficient> makeBatchedCoefficient(lambda f)
+{
+  return std::make_shared<BatchedCoefficient>(
+      [f](const double* X, double t, double* values, uint32_t n) {
+        auto x = reinterpret_cast<const tensor<double, dim>*>(X);
+        accelerator::forall<exec>(n, [=] SERAC_HOST_DEVICE(uint32_t i) { values[i] = f(x[i], t); });
+      },
+      exec);
+}
+
+/**
+ * @brief Creates a batched vector coefficient from a function of a single point, see makeBatchedCoefficient()
+ *
+ * @tparam dim the spatial dimension
+ * @tparam exec where to evaluate the function
+ * @param f the function, `tensor<double, vdim> f(tensor<double, dim> x, double t)`
+ */
+template <int dim, ExecutionSpace exec = ExecutionSpace::CPU, typename lambda>
+std::shared_ptr<BatchedVectorCoefficient> makeBatchedVectorCoefficient(lambda f)
+{
+  using value_type = decltype(f(tensor<double, dim>{}, 0.0));
+  return std::make_shared<BatchedVectorCoefficient>(
+      int(sizeof(value_type) / sizeof(double)),
+      [f](const double* X, double t, double* values, uint32_t n) {
+        auto x = reinterpret_cast<const tensor<double, dim>*>(X);
+        auto v = reinterpret_cast<value_type*>(values);
+        accelerator::forall<exec>(n, [=] SERAC_HOST_DEVICE(uint32_t i) { v[i] = f(x[i], t); });
+      },
+      exec);
+}
+
+/**
+ * @brief Whether the dofs of a space are the values of a field at its nodes, so that batched coefficients can be
+ * projected onto it by evaluating them at the nodes (e.g. H1 and L2 spaces, but not Hcurl ones)
+ */
+bool hasNodalDofs(const mfem::ParFiniteElementSpace& space);
+
+/**
+ * @brief The coordinates of some of the nodes of a space with nodal dofs
+ *
+ * @param space the space
+ * @param nodes the (local, scalar) dofs of the nodes
+ * @return the coordinates of the nodes, one node after the other
+ */
+mfem::Vector nodeCoordinates(const mfem::ParFiniteElementSpace& space, const mfem::Array<int>& nodes);
+
+/**
+ * @brief Projects a batched coefficient onto some of the nodes of a grid function, evaluating it once for all of them
+ *
+ * @param coef the coefficient
+ * @param nodes the (local, scalar) dofs of the nodes to set
+ * @param X the coordinates of the nodes, see nodeCoordinates()
+ * @param grid_function the grid function to set the values of
+ * @param component the component to set, for vector-valued grid functions
+ */
+void projectAtNodes(const BatchedCoefficient& coef, const mfem::Array<int>& nodes, const mfem::Vector& X,
+                    mfem::ParGridFunction& grid_function, std::optional<int> component = {});
+
+/// @overload
+void projectAtNodes(const BatchedVectorCoefficient& coef, const mfem::Array<int>& nodes, const mfem::Vector& X,
+                    mfem::ParGridFunction& grid_function);
+
+}  // namespace serac
@@ -5,14 +5,70 @@
 // SPDX-License-Identifier: (BSD-3-Clause)
 
 #include "serac/physics/state/finite_element_state.hpp"
+
+#include <type_traits>
+
 #include "serac/infrastructure/logger.hpp"
+#include "serac/physics/state/batched_coefficient.hpp"
 
 namespace serac {
 
+namespace {
+
+/// @brief Every (local, scalar) dof of a space
+mfem::Array<int> allNodes(const mfem::ParFiniteElementSpace& space)
+{
+  mfem::Array<int> nodes(space.GetNDofs());
+  for (int i = 0; i < nodes.Size(); i++) {
+    nodes[i] = i;
+  }
+  return nodes;
+}
+
+/// @brief The (local, scalar) dofs of a space on the marked boundary attributes
+mfem::Array<int> boundaryNodes(const mfem::ParFiniteElementSpace& space, const mfem::Array<int>& markers)
+{
+  mfem::Array<int> vdof_markers;
+  space.GetEssentialVDofs(markers, vdof_markers);
+
+  mfem::Array<int> nodes;
+  for (int i = 0; i < space.GetNDofs(); i++) {
+    if (vdof_markers[space.DofToVDof(i, 0)]) {
+      nodes.Append(i);
+    }
+  }
+  return nodes;
+}
+
+/**
+ * @brief Projects a batched coefficient onto some nodes of a grid function, if it is one and the space is nodal
+ *
+ * @return whether the coefficient was projected
+ */
+template <typename coefficient_type, typename... component_type>
+bool projectBatched(coefficient_type& coef, const mfem::Array<int>& nodes, mfem::ParGridFunction& grid_function,
+                    component_type... component)
+{
+  using batched_type = std::conditional_t<std::is_base_of_v<mfem::Coefficient, coefficient_type>, BatchedCoefficient,
+                                          BatchedVectorCoefficient>;
+
+  auto* batched = dynamic_cast<batched_type*>(&coef);
+  if (!batched || !hasNodalDofs(*grid_function.ParFESpace())) {
+    return false;
+  }
+
+  projectAtNodes(*batched, nodes, nodeCoordinates(*grid_function.ParFESpace(), nodes), grid_function, component...);
+  return true;
+}
+
+}  // namespace
+
 void FiniteElementState::project(mfem::VectorCoefficient& coef, mfem::Array<int>& dof_list)
 {
   mfem::ParGridFunction& grid_function = gridFunction();
-  grid_function.ProjectCoefficient(coef, dof_list);
+  if (!projectBatched(coef, dof_list, grid_function)) {
+    grid_function.ProjectCoefficient(coef, dof_list);
+  }
   setFromGridFunction(grid_function);
 }
 
@@ -20,10 +76,12 @@ void FiniteElementState::project(mfem::Coefficient& coef, mfem::Array<int>& dof_
 {
   mfem::ParGridFunction& grid_function = gridFunction();
 
-  if (component) {
-    grid_function.ProjectCoefficient(coef, dof_list, *component);
-  } else {
-    grid_function.ProjectCoefficient(coef, dof_list);
+  if (!projectBatched(coef, dof_list, grid_function, component)) {
+    if (component) {
+      grid_function.ProjectCoefficient(coef, dof_list, *component);
+    } else {
+      grid_function.ProjectCoefficient(coef, dof_list);
+    }
   }
 
   setFromGridFunction(grid_function);
@@ -37,7 +95,9 @@ void FiniteElementState::project(const GeneralCoefficient& coef)
   // to be deduced, and the appropriate version of ProjectCoefficient is dispatched.
   visit(
       [this, &grid_function](auto&& concrete_coef) {
-        grid_function.ProjectCoefficient(*concrete_coef);
+        if (!projectBatched(*concrete_coef, allNodes(*space_), grid_function)) {
+          grid_function.ProjectCoefficient(*concrete_coef);
+        }
         setFromGridFunction(grid_function);
       },
       coef);
@@ -46,30 +106,38 @@ void FiniteElementState::project(const GeneralCoefficient& coef)
 void FiniteElementState::project(mfem::Coefficient& coef)
 {
   mfem::ParGridFunction& grid_function = gridFunction();
-  grid_function.ProjectCoefficient(coef);
+  if (!projectBatched(coef, allNodes(*space_), grid_function)) {
+    grid_function.ProjectCoefficient(coef);
+  }
   setFromGridFunction(grid_function);
 }
 
 void FiniteElementState::project(mfem::VectorCoefficient& coef)
 {
   mfem::ParGridFunction& grid_function = gridFunction();
-  grid_function.ProjectCoefficient(coef);
+  if (!projectBatched(coef, allNodes(*space_), grid_function)) {
+    grid_function.ProjectCoefficient(coef);
+  }
   setFromGridFunction(grid_function);
 }
 
 void FiniteElementState::projectOnBoundary(mfem::Coefficient& coef, const mfem::Array<int>& markers)
 {
   mfem::ParGridFunction& grid_function = gridFunction();
-  // markers should be const param in mfem, but it's not
-  grid_function.ProjectBdrCoefficient(coef, const_cast<mfem::Array<int>&>(markers));
+  if (!projectBatched(coef, boundaryNodes(*space_, markers), grid_function)) {
+    // markers should be const param in mfem, but it's not
+    grid_function.ProjectBdrCoefficient(coef, const_cast<mfem::Array<int>&>(markers));
+  }
   setFromGridFunction(grid_function);
 }
 
 void FiniteElementState::projectOnBoundary(mfem::VectorCoefficient& coef, const mfem::Array<int>& markers)
 {
   mfem::ParGridFunction& grid_function = gridFunction();
-  // markers should be const param in mfem, but it's not
-  grid_function.ProjectBdrCoefficient(coef, const_cast<mfem::Array<int>&>(markers));
+  if (!projectBatched(coef, boundaryNodes(*space_, markers), grid_function)) {
+    // markers should be const param in mfem, but it's not
+    grid_function.ProjectBdrCoefficient(coef, const_cast<mfem::Array<int>&>(markers));
+  }
   setFromGridFunction(grid_function);
 }
 
@@ -83,6 +151,25 @@ mfem::ParGridFunction& FiniteElementState::gridFunction() const
   return *grid_func_;
 }
 
+void FiniteElementState::shareGridFunctionData(mfem::ParGridFunction& grid_function)
+{
+  SLIC_ERROR_ROOT_IF(grid_function.Size() != space_->GetVSize(),
+                     axom::fmt::format("Grid function of size {} cannot hold the L-vector of state '{}' of size {}",
+                                       grid_function.Size(), name_, space_->GetVSize()));
+  grid_func_ = std::make_unique<mfem::ParGridFunction>(space_.get(), grid_function.GetData());
+}
+
+void FiniteElementState::updateSpace()
+{
+  mfem::ParGridFunction& grid_function = gridFunction();
+
+  FiniteElementVector::updateSpace();
+
+  // the grid function interpolates its values through the update operator of the space
+  grid_function.Update();
+  setFromGridFunction(grid_function);
+}
+
 double norm(const FiniteElementState& state, const double p)
 {
   if (state.space().GetVDim() == 1) {
@@ -63,7 +63,10 @@ public:
    *
    * @param[in] rhs The input vector used for construction
    */
-  FiniteElementState(FiniteElementState&& rhs) : FiniteElementVector(std::move(rhs)) {}
+  FiniteElementState(FiniteElementState&& rhs)
+      : FiniteElementVector(std::move(rhs)), grid_func_(std::move(rhs.grid_func_))
+  {
+  }
 
   /**
    * @brief Copy assignment
@@ -129,6 +132,8 @@ public:
    *
    * @note This only sets nodal values based on the coefficient at that point. It does not perform
    * a full least squares projection.
+   * @note Batched coefficients (see BatchedCoefficient) are evaluated once for all the nodes, by this and the other
+   * projections, when the space has nodal dofs
    */
   void project(const GeneralCoefficient& coef);
 
@@ -159,6 +164,29 @@ public:
    */
   mfem::ParGridFunction& gridFunction() const;
 
+  /**
+   * @brief Makes gridFunction() prolong the true vector into the data of another grid function of the same space
+   *
+   * This lets the state use e.g. the L-vector owned by the data collection of the StateManager, instead of
+   * allocating its own, so that outputting the state takes no additional memory or copies.
+   *
+   * @param grid_function The grid function whose data is used
+   * @pre The data of \p grid_function must outlive the uses of gridFunction(). Copies of the state allocate their
+   * own grid function.
+   */
+  void shareGridFunctionData(mfem::ParGridFunction& grid_function);
+
+  /**
+   * @brief Update the finite element space after its mesh changed, e.g. through adaptive refinement, and interpolate
+   * the state to it
+   *
+   * On refined elements the state is interpolated exactly, on derefined ones it is projected onto the coarser space.
+   *
+   * @note a grid function whose data was shared with shareGridFunctionData() allocates its own data again, so the
+   * data has to be shared again to keep using it
+   */
+  void updateSpace() override;
+
 protected:
   /**
    * @brief An optional container for a grid function (L-vector) view of the finite element state.
@@ -48,8 +48,13 @@ FiniteElementVector::FiniteElementVector(mfem::ParMesh& mesh, FiniteElementVecto
   auto* parallel_vec = new_vector.StealParVector();
   WrapHypreParVector(parallel_vec);
 
+  // Keep the data resident on the device, if one is configured
+  UseDevice(true);
+
   // Initialize the vector to zero
   HypreParVector::operator=(0.0);
+
+  tracker_.set(sizeof(double) * std::size_t(Size()));
 }
 
 FiniteElementVector::FiniteElementVector(const mfem::ParFiniteElementSpace& space, const std::string& name)
@@ -68,8 +73,13 @@ FiniteElementVector::FiniteElementVector(const mfem::ParFiniteElementSpace& spac
   auto* parallel_vec = new_vector.StealParVector();
   WrapHypreParVector(parallel_vec);
 
+  // Keep the data resident on the device, if one is configured
+  UseDevice(true);
+
   // Initialize the vector to zero
   HypreParVector::operator=(0.0);
+
+  tracker_.set(sizeof(double) * std::size_t(Size()));
 }
 
 FiniteElementVector::FiniteElementVector(FiniteElementVector&& input_vector)
@@ -81,6 +91,10 @@ FiniteElementVector::FiniteElementVector(FiniteElementVector&& input_vector)
   // Grab the allocated data from the input argument for the underlying Hypre vector
   auto* parallel_vec = input_vector.StealParVector();
   WrapHypreParVector(parallel_vec);
+  UseDevice(true);
+
+  tracker_.set(input_vector.tracker_.bytes());
+  input_vector.tracker_.set(0);
 }
 
 FiniteElementVector& FiniteElementVector::operator=(const mfem::HypreParVector& rhs)
@@ -113,10 +127,28 @@ FiniteElementVector& FiniteElementVector::operator=(FiniteElementVector&& rhs)
 
   auto* parallel_vec = rhs.StealParVector();
   WrapHypreParVector(parallel_vec);
+  UseDevice(true);
+
+  tracker_.set(rhs.tracker_.bytes());
+  rhs.tracker_.set(0);
 
   return *this;
 }
 
+void FiniteElementVector::updateSpace()
+{
+  space_->Update();
+
+  HypreParVector new_vector(space_.get());
+  auto*          parallel_vec = new_vector.StealParVector();
+  WrapHypreParVector(parallel_vec);
+  UseDevice(true);
+
+  HypreParVector::operator=(0.0);
+
+  tracker_.set(sizeof(double) * std::size_t(Size()));
+}
+
 FiniteElementVector& FiniteElementVector::operator=(const double value)
 {
   HypreParVector::operator=(value);
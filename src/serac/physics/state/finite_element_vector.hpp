@@ -17,6 +17,7 @@
 
 #include "mfem.hpp"
 
+#include "serac/infrastructure/memory.hpp"
 #include "serac/infrastructure/variant.hpp"
 
 namespace serac {
@@ -44,6 +45,9 @@ enum class ElementType
  *
  * Namely: Mesh, FiniteElementCollection, FiniteElementSpace, name, and a HypreParVector
  * containing the true degrees of freedom for the field.
+ *
+ * When mfem is configured with a device backend, the true degrees of freedom live in device memory,
+ * see syncToHost() and syncToDevice().
  */
 class FiniteElementVector : public mfem::HypreParVector {
 public:
@@ -171,6 +175,33 @@ public:
    */
   FiniteElementVector& operator=(const double value);
 
+  /**
+   * @brief Ensure the host copy of the data is up to date
+   *
+   * Finite element vectors are device-resident when a device (GPU) backend is configured, so
+   * this must be called before accessing the values directly on the host (e.g. for output)
+   *
+   * @note this is a no-op when the host copy is already valid
+   */
+  void syncToHost() const { HostRead(); }
+
+  /**
+   * @brief Ensure the device copy of the data is up to date, e.g. after modifying the values on the host
+   *
+   * @note this is a no-op when the device copy is already valid, or when no device backend is configured
+   */
+  void syncToDevice() const { Read(); }
+
+  /**
+   * @brief Update the finite element space after its mesh changed, e.g. through adaptive refinement, and resize the
+   * vector to it
+   *
+   * The values are set to zero, see FiniteElementState::updateSpace() for a vector whose values are transferred.
+   *
+   * @note this must be called after each change of the mesh
+   */
+  virtual void updateSpace();
+
   /**
    * @brief Destroy the Finite Element Vector object
    */
@@ -197,6 +228,11 @@ protected:
    * @brief The name of the finite element vector
    */
   std::string name_ = "";
+
+  /**
+   * @brief The accounting of the memory of the (true dof) values, see memory::usage()
+   */
+  memory::Tracker tracker_{memory::Subsystem::States};
 };
 
 /**
@@ -0,0 +1,55 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/physics/state/l2_projection.hpp"
+
+#include "serac/infrastructure/logger.hpp"
+
+namespace serac {
+
+L2Projection::L2Projection(const mfem::ParFiniteElementSpace& space)
+    : space_(space), inverse_mass_(static_cast<std::size_t>(space.GetNE()))
+{
+  // the dofs of a discontinuous space aren't shared between elements (or ranks), so its true dofs are its local ones
+  SLIC_ERROR_ROOT_IF(!dynamic_cast<const mfem::L2_FECollection*>(space.FEColl()),
+                     "L2Projection only supports discontinuous (L2) spaces");
+
+  mfem::MassIntegrator mass;
+  for (int e = 0; e < space.GetNE(); e++) {
+    mfem::DenseMatrix& M = inverse_mass_[static_cast<std::size_t>(e)];
+    mass.AssembleElementMatrix(*space.GetFE(e), *space.GetElementTransformation(e), M);
+    M.Invert();
+  }
+}
+
+void L2Projection::solve(const mfem::Vector& rhs, mfem::Vector& field) const
+{
+  SLIC_ERROR_IF(rhs.Size() != space_.GetTrueVSize(), "right hand side and discontinuous space are not compatible");
+  field.SetSize(rhs.Size());
+
+  const double* r = rhs.HostRead();
+  double*       u = field.HostWrite();
+
+  mfem::Array<int> dofs;
+  mfem::Vector     b, x;
+  for (int e = 0; e < space_.GetNE(); e++) {
+    space_.GetElementDofs(e, dofs);
+    b.SetSize(dofs.Size());
+    x.SetSize(dofs.Size());
+
+    for (int c = 0; c < space_.GetVDim(); c++) {
+      for (int i = 0; i < dofs.Size(); i++) {
+        b(i) = r[space_.DofToVDof(dofs[i], c)];
+      }
+      inverse_mass_[static_cast<std::size_t>(e)].Mult(b, x);
+      for (int i = 0; i < dofs.Size(); i++) {
+        u[space_.DofToVDof(dofs[i], c)] = x(i);
+      }
+    }
+  }
+}
+
+}  // namespace serac
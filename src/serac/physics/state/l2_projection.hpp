@@ -0,0 +1,53 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file l2_projection.hpp
+ *
+ * @brief The L2 projection onto discontinuous finite element spaces
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "mfem.hpp"
+
+namespace serac {
+
+/**
+ * @brief The L2 projection onto a discontinuous (L2) space
+ *
+ * The mass matrix of a discontinuous space is block diagonal, so the inverse of each element's block is computed
+ * once, and each projection is then a small matrix-vector product per element (and per component).
+ */
+class L2Projection {
+public:
+  /**
+   * @brief Computes the inverses of the element mass matrices of a space
+   *
+   * @param space the discontinuous space, which must outlive the projection
+   */
+  explicit L2Projection(const mfem::ParFiniteElementSpace& space);
+
+  /**
+   * @brief Finds the field of the space whose integrals against its basis functions are given
+   *
+   * @param rhs the integrals of the field against each basis function, e.g. the residual of a Functional whose test
+   * space is the discontinuous space
+   * @param field the (true dof) values of the field
+   */
+  void solve(const mfem::Vector& rhs, mfem::Vector& field) const;
+
+private:
+  /// @brief The discontinuous space
+  const mfem::ParFiniteElementSpace& space_;
+
+  /// @brief The inverse of the (scalar) mass matrix of each element
+  std::vector<mfem::DenseMatrix> inverse_mass_;
+};
+
+}  // namespace serac
@@ -6,7 +6,27 @@
 
 #include "serac/physics/state/state_manager.hpp"
 
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+
+#include "axom/config.hpp"
 #include "axom/core.hpp"
+#include "axom/sidre.hpp"
+#ifdef AXOM_USE_HDF5
+#include "conduit_relay_io_hdf5.hpp"
+#endif
+
+#include "serac/serac_config.hpp"
+#ifdef SERAC_USE_ASCENT
+#include "ascent.hpp"
+#endif
+#ifdef SERAC_USE_SCR
+#include "scr.h"
+#endif
+
+#include "serac/infrastructure/initialize.hpp"
+#include "serac/infrastructure/profiling.hpp"
 
 namespace serac {
 
@@ -20,9 +40,95 @@ std::string                                                           StateManag
 const std::string                                                     StateManager::default_mesh_name_ = "default";
 std::unordered_map<std::string, mfem::ParGridFunction*>               StateManager::named_states_;
 std::unordered_map<std::string, mfem::ParGridFunction*>               StateManager::named_duals_;
+bool                                                                  StateManager::async_saves_ = false;
+std::unique_ptr<axom::sidre::DataStore>                               StateManager::staging_ds_;
+std::thread                                                           StateManager::save_thread_;
+OutputCompression                                                     StateManager::compression_;
+bool                                                                  StateManager::incremental_saves_ = false;
+bool                                                                  StateManager::node_local_checkpoints_ = false;
+bool                                                                  StateManager::scr_initialized_ = false;
+bool                                                                  StateManager::scr_finalized_ = false;
+int                                                                   StateManager::restart_writers_per_node_ = 0;
+std::unordered_map<std::string, int>                                  StateManager::base_cycles_;
+std::unordered_map<std::string, int>                                  StateManager::last_saved_cycles_;
+std::set<std::string>                                                 StateManager::dirty_fields_;
+std::unordered_map<std::string, std::uint64_t>                        StateManager::saved_checksums_;
+std::string                                                           StateManager::in_situ_actions_;
+std::shared_ptr<ascent::Ascent>                                       StateManager::ascent_;
+std::unordered_map<int, std::vector<std::unique_ptr<mfem::Vector>>>   StateManager::scratch_vectors_;
+std::unordered_map<std::string, std::unordered_map<std::string, std::function<std::pair<void*, size_t>()>>>
+    StateManager::named_qdata_;
+
+memory::Tracker StateManager::sidre_memory_{memory::Subsystem::States};
+memory::Tracker StateManager::qdata_memory_{memory::Subsystem::QuadratureData};
+
+std::unordered_map<std::string, std::vector<std::unique_ptr<mfem::ParMesh>>> StateManager::coarse_meshes_;
+
+namespace {
+
+/**
+ * @brief Deep copies the views and subgroups of one sidre group into another
+ * @param[in] src The group to copy
+ * @param[inout] dst The group to copy into
+ */
+void deepCopyContents(axom::sidre::Group& src, axom::sidre::Group& dst)
+{
+  for (auto idx = src.getFirstValidViewIndex(); axom::sidre::indexIsValid(idx); idx = src.getNextValidViewIndex(idx)) {
+    dst.deepCopyView(src.getView(idx));
+  }
+  for (auto idx = src.getFirstValidGroupIndex(); axom::sidre::indexIsValid(idx);
+       idx      = src.getNextValidGroupIndex(idx)) {
+    dst.deepCopyGroup(src.getGroup(idx));
+  }
+}
+
+/**
+ * @brief Makes sure that the mesh has the nodal grid function Functional expects, and hands it over to Sidre
+ *
+ * That is an order 1 vector grid function in the spatial dimension with nodal (xxxyyyzzz) ordering, continuous
+ * unless the mesh is periodic. Nodes that already are such a grid function, e.g. those of a mesh loaded from a
+ * restart file, are kept instead of being projected onto a new finite element space.
+ *
+ * @param[inout] mesh The mesh
+ */
+void prepareNodes(mfem::ParMesh& mesh)
+{
+  // Determine if the existing nodal grid function is discontinuous. This
+  // indicates that the mesh is periodic and the new nodal grid function must also
+  // be discontinuous.
+  bool is_discontinuous = false;
+  auto nodes            = mesh.GetNodes();
+  if (nodes) {
+    is_discontinuous = nodes->FESpace()->FEColl()->GetContType() == mfem::FiniteElementCollection::DISCONTINUOUS;
+    SLIC_WARNING_ROOT_IF(
+        is_discontinuous,
+        "Periodic mesh detected! This will only work on translational periodic surfaces for vector H1 fields and "
+        "has not been thoroughly tested. Proceed at your own risk.");
+  }
+
+  bool nodes_ready = nodes && (nodes->FESpace()->GetMaxElementOrder() == 1) &&
+                     (nodes->FESpace()->GetOrdering() == mfem::Ordering::byNODES) &&
+                     (nodes->FESpace()->GetVDim() == mesh.SpaceDimension());
+
+  // This mfem call ensures the mesh contains an H1 grid function describing nodal
+  // cordinates. The parameters do the following:
+  // 1. Sets the order of the mesh to  p = 1
+  // 2. Uses the existing continuity of the mesh finite element space (periodic meshes are discontinuous)
+  // 3. Uses the spatial dimension as the mesh dimension (i.e. it is not a lower dimension manifold)
+  // 4. Uses nodal instead of VDIM ordering (i.e. xxxyyyzzz instead of xyzxyzxyz)
+  if (!nodes_ready) {
+    mesh.SetCurvature(1, is_discontinuous, -1, mfem::Ordering::byNODES);
+  }
+
+  // Sidre will destruct the nodal grid function instead of the mesh
+  mesh.SetNodesOwner(false);
+}
+
+}  // namespace
 
 double StateManager::newDataCollection(const std::string& name, const std::optional<int> cycle_to_load)
 {
+  SERAC_MARK_FUNCTION;
   SLIC_ERROR_ROOT_IF(!ds_, "Cannot construct a DataCollection without a DataStore");
   std::string coll_name = name + "_datacoll";
 
@@ -40,46 +146,40 @@ double StateManager::newDataCollection(const std::string& name, const std::optio
   datacoll.SetPrefixPath(output_dir_);
 
   if (cycle_to_load) {
+    // An incremental restart file only holds the fields that changed, the rest comes from its base cycle
+    std::unique_ptr<axom::sidre::DataStore> increment;
+    int                                     base_cycle = *cycle_to_load;
+
     // NOTE: Load invalidates previous Sidre pointers
-    datacoll.Load(*cycle_to_load);
+    SERAC_MARK_BEGIN("Restart read");
+    if (!loadCheckpoint(datacoll, *cycle_to_load)) {
+      base_cycle = loadIncrement(datacoll, *cycle_to_load, increment);
+      datacoll.Load(base_cycle);
+    }
     datacoll.SetGroupPointers(ds_->getRoot()->getGroup(coll_name + "_global/blueprint_index/" + coll_name),
                               ds_->getRoot()->getGroup(coll_name));
     SLIC_ERROR_ROOT_IF(datacoll.GetBPGroup()->getNumGroups() == 0,
                        "Loaded datastore is empty, was the datastore created on a "
                        "different number of nodes?");
+    SERAC_MARK_END("Restart read");
 
+    SERAC_MARK_BEGIN("Restart mesh setup");
     datacoll.UpdateStateFromDS();
     datacoll.UpdateMeshAndFieldsFromDS();
 
-    // Functional needs the nodal grid function and neighbor data in the mesh
-
-    // Determine if the existing nodal grid function is discontinuous. This
-    // indicates that the mesh is periodic and the new nodal grid function must also
-    // be discontinuous.
-    bool is_discontinuous = false;
-    auto nodes            = mesh(name).GetNodes();
-    if (nodes) {
-      is_discontinuous = nodes->FESpace()->FEColl()->GetContType() == mfem::FiniteElementCollection::DISCONTINUOUS;
-      SLIC_WARNING_ROOT_IF(
-          is_discontinuous,
-          "Periodic mesh detected! This will only work on translational periodic surfaces for vector H1 fields and "
-          "has not been thoroughly tested. Proceed at your own risk.");
+    if (increment) {
+      applyIncrement(datacoll, base_cycle, *cycle_to_load, *increment);
+      base_cycles_[name] = base_cycle;
     }
 
-    // This mfem call ensures the mesh contains an H1 grid function describing nodal
-    // cordinates. The parameters do the following:
-    // 1. Sets the order of the mesh to  p = 1
-    // 2. Uses the existing continuity of the mesh finite element space (periodic meshes are discontinuous)
-    // 3. Uses the spatial dimension as the mesh dimension (i.e. it is not a lower dimension manifold)
-    // 4. Uses nodal instead of VDIM ordering (i.e. xxxyyyzzz instead of xyzxyzxyz)
-    mesh(name).SetCurvature(1, is_discontinuous, -1, mfem::Ordering::byNODES);
-
-    // Sidre will destruct the nodal grid function instead of the mesh
-    mesh(name).SetNodesOwner(false);
+    // Functional needs the nodal grid function and neighbor data in the mesh. The mesh of a restart
+    // file was saved with the right nodal grid function already, so it is reused as it was loaded.
+    prepareNodes(mesh(name));
 
     // Generate the face neighbor information in the mesh. This is needed by the face restriction
     // operators used by Functional
     mesh(name).ExchangeFaceNbrData();
+    SERAC_MARK_END("Restart mesh setup");
 
     // Construct and store the shape displacement fields and sensitivities associated with this mesh
     constructShapeFields(name);
@@ -138,7 +238,10 @@ void StateManager::storeState(FiniteElementState& state)
     datacoll.RegisterField(name, grid_function);
     state.setFromGridFunction(*grid_function);
   }
+  // The state prolongs into the sidre-owned L-vector, instead of a copy of its own
+  state.shareGridFunctionData(*grid_function);
   named_states_[name] = grid_function;
+  sidre_memory_.set(sidre_memory_.bytes() + sizeof(double) * std::size_t(grid_function->Size()));
 }
 
 FiniteElementState StateManager::newState(FiniteElementVector::Options&& options, const std::string& mesh_tag)
@@ -192,6 +295,102 @@ void StateManager::storeDual(FiniteElementDual& dual)
     dual = *true_dofs;
   }
   named_duals_[name] = grid_function;
+  sidre_memory_.set(sidre_memory_.bytes() + sizeof(double) * std::size_t(grid_function->Size()));
+}
+
+void StateManager::storeQuadratureData(const std::string& name, std::function<std::pair<void*, size_t>()> bytes,
+                                       const std::string& mesh_tag)
+{
+  SLIC_ERROR_ROOT_IF(!ds_, "Serac's data store was not initialized - call StateManager::initialize first");
+  SLIC_ERROR_ROOT_IF(datacolls_.find(mesh_tag) == datacolls_.end(),
+                     axom::fmt::format("Mesh tag '{}' not found in the data store", mesh_tag));
+  auto& named = named_qdata_[mesh_tag];
+  SLIC_ERROR_ROOT_IF(named.find(name) != named.end(),
+                     axom::fmt::format("StateManager already contains quadrature data named '{}'", name));
+
+  if (is_restart_) {
+    auto* group       = quadratureDataGroup(datacolls_.at(mesh_tag));
+    auto [data, size] = bytes();
+    if (group->hasView(name)) {
+      auto* view = group->getView(name);
+      SLIC_ERROR_IF(static_cast<size_t>(view->getNumElements()) != size,
+                    axom::fmt::format("The restart file holds {} bytes of the quadrature data '{}', instead of {}",
+                                      view->getNumElements(), name, size));
+      if (size > 0) {
+        std::memcpy(data, view->getVoidPtr(), size);
+      }
+    } else {
+      SLIC_WARNING_ROOT(
+          axom::fmt::format("The restart file has no quadrature data named '{}', it is not restored", name));
+    }
+  }
+  named.emplace(name, std::move(bytes));
+}
+
+axom::sidre::Group* StateManager::quadratureDataGroup(axom::sidre::MFEMSidreDataCollection& datacoll)
+{
+  // a group of its own, next to the blueprint groups of the data collection, so that it is saved and loaded with them
+  const std::string name = datacoll.GetCollectionName() + "_quadrature_data";
+  auto*             root = ds_->getRoot();
+  return root->hasGroup(name) ? root->getGroup(name) : root->createGroup(name);
+}
+
+void StateManager::updateQuadratureData(const std::string& mesh_tag)
+{
+  auto qdata = named_qdata_.find(mesh_tag);
+  if (qdata == named_qdata_.end()) {
+    return;
+  }
+
+  auto*  group = quadratureDataGroup(datacolls_.at(mesh_tag));
+  size_t total = qdata_memory_.bytes();
+  for (auto& [name, bytes] : qdata->second) {
+    auto [data, size] = bytes();
+    if (!data) {
+      continue;
+    }
+
+    // a single copy of each buffer, which keeps its size unless the mesh changed
+    auto* view = group->hasView(name) ? group->getView(name) : nullptr;
+    if (!view || static_cast<size_t>(view->getNumElements()) != size) {
+      if (view) {
+        total -= static_cast<size_t>(view->getNumElements());
+        group->destroyViewAndData(name);
+      }
+      view = group->createViewAndAllocate(name, axom::sidre::UINT8_ID, static_cast<axom::sidre::IndexType>(size));
+      total += size;
+    }
+    if (size > 0) {
+      std::memcpy(view->getVoidPtr(), data, size);
+    }
+  }
+  qdata_memory_.set(total);
+}
+
+ScratchVector::~ScratchVector()
+{
+  if (vector_) {
+    StateManager::releaseScratchVector(std::move(vector_));
+  }
+}
+
+ScratchVector StateManager::scratchVector(const mfem::ParFiniteElementSpace& space)
+{
+  auto& pool = scratch_vectors_[space.GetTrueVSize()];
+  if (pool.empty()) {
+    auto vector = std::make_unique<mfem::Vector>(space.GetTrueVSize(), mfem::Device::GetMemoryType());
+    vector->UseDevice(true);
+    return ScratchVector(std::move(vector));
+  }
+
+  auto vector = std::move(pool.back());
+  pool.pop_back();
+  return ScratchVector(std::move(vector));
+}
+
+void StateManager::releaseScratchVector(std::unique_ptr<mfem::Vector> vector)
+{
+  scratch_vectors_[vector->Size()].push_back(std::move(vector));
 }
 
 FiniteElementDual StateManager::newDual(const mfem::ParFiniteElementSpace& space, const std::string& dual_name)
@@ -230,36 +429,481 @@ void StateManager::save(const double t, const int cycle, const std::string& mesh
   std::string file_path = axom::utilities::filesystem::joinPath(datacoll.GetPrefixPath(), datacoll.GetCollectionName());
   SLIC_INFO_ROOT(axom::fmt::format("Saving data collection at time: '{}' to path: '{}'", t, file_path));
 
+  // the data collection writes the host copy of each field
+  for (auto* fields : {&named_states_, &named_duals_}) {
+    for (auto& [name, grid_function] : *fields) {
+      if (datacoll.HasField(name)) {
+        grid_function->HostRead();
+      }
+    }
+  }
+
+  // the staging datastore (and the files) of the previous save may not be reused until it has been written
+  waitForPendingSaves();
+
   datacoll.SetTime(t);
   datacoll.SetCycle(cycle);
-  datacoll.Save();
+  updateQuadratureData(mesh_tag);
+
+  if (node_local_checkpoints_) {
+    saveCheckpoint(datacoll, cycle);
+    return;
+  }
+
+  if (incremental_saves_) {
+    auto base = base_cycles_.find(mesh_tag);
+    if (base != base_cycles_.end()) {
+      saveIncrement(datacoll, base->second, t, cycle);
+      return;
+    }
+
+    // this full save is the base that the following increments refer to
+    base_cycles_[mesh_tag] = cycle;
+    for (auto* fields : {&named_states_, &named_duals_}) {
+      for (auto& [name, grid_function] : *fields) {
+        if (datacoll.HasField(name)) {
+          last_saved_cycles_[name] = cycle;
+          saved_checksums_[name]   = checksum(*grid_function);
+          dirty_fields_.erase(name);
+        }
+      }
+    }
+  }
+
+  if (!async_saves_ && restart_writers_per_node_ == 0) {
+    datacoll.Save();
+    return;
+  }
+
+  // Update the blueprint state in the datastore as Save() would. For asynchronous saves, snapshot
+  // all of it, so the simulation can keep modifying the fields during the write.
+  datacoll.PrepareToSave();
+  if (async_saves_) {
+    staging_ds_ = std::make_unique<axom::sidre::DataStore>();
+    deepCopyContents(*ds_->getRoot(), *staging_ds_->getRoot());
+  }
+
+  // the same file names as MFEMSidreDataCollection::Save()
+  writeStaged(datacoll, axom::fmt::format("{}_{:06}", file_path, cycle),
+              datacoll.GetCollectionName() + "_global/blueprint_index");
 }
 
-mfem::ParMesh* StateManager::setMesh(std::unique_ptr<mfem::ParMesh> pmesh, const std::string& mesh_tag)
+void StateManager::saveIncrement(axom::sidre::MFEMSidreDataCollection& datacoll, int base_cycle, const double t,
+                                 const int cycle)
 {
-  // Determine if the existing nodal grid function is discontinuous. This
-  // indicates that the mesh is periodic and the new nodal grid function must also
-  // be discontinuous.
-  bool is_discontinuous = false;
-  auto nodes            = pmesh->GetNodes();
-  if (nodes) {
-    is_discontinuous = nodes->FESpace()->FEColl()->GetContType() == mfem::FiniteElementCollection::DISCONTINUOUS;
-    SLIC_WARNING_ROOT_IF(
-        is_discontinuous,
-        "Periodic mesh detected! This will only work on translational periodic surfaces for vector H1 fields and "
-        "has not been thoroughly tested. Proceed at your own risk.");
+  // Every rank writes the fields that changed on it since they were last saved, and the cycle of the
+  // file holding the latest values of each of the other fields, so that a restart reads at most one
+  // file per field
+  staging_ds_        = std::make_unique<axom::sidre::DataStore>();
+  auto* root         = staging_ds_->getRoot();
+  auto* fields_grp   = root->createGroup("fields");
+  auto* last_cyc_grp = root->createGroup("last_cycle");
+  root->createViewScalar("base_cycle", base_cycle);
+  root->createViewScalar("time", t);
+
+  for (auto* fields : {&named_states_, &named_duals_}) {
+    for (auto& [name, grid_function] : *fields) {
+      if (!datacoll.HasField(name)) {
+        continue;
+      }
+      if (dirty_fields_.count(name)) {
+        auto* view = fields_grp->createViewAndAllocate(name, axom::sidre::DOUBLE_ID, grid_function->Size());
+        std::copy_n(grid_function->HostRead(), grid_function->Size(), view->getData<double*>());
+        last_saved_cycles_[name] = cycle;
+        saved_checksums_[name]   = checksum(*grid_function);
+        dirty_fields_.erase(name);
+      }
+      last_cyc_grp->createViewScalar(name, last_saved_cycles_.at(name));
+    }
   }
 
-  // This mfem call ensures the mesh contains an H1 grid function describing nodal
-  // cordinates. The parameters do the following:
-  // 1. Sets the order of the mesh to  p = 1
-  // 2. Uses the existing continuity of the mesh finite element space (periodic meshes are discontinuous)
-  // 3. Uses the spatial dimension as the mesh dimension (i.e. it is not a lower dimension manifold)
-  // 4. Uses nodal instead of VDIM ordering (i.e. xxxyyyzzz instead of xyzxyzxyz)
-  pmesh->SetCurvature(1, is_discontinuous, -1, mfem::Ordering::byNODES);
+  // the material state changes with every step, so every increment holds all of the quadrature data
+  deepCopyContents(*quadratureDataGroup(datacoll), *root->createGroup("quadrature_data"));
 
-  // Sidre will destruct the nodal grid function instead of the mesh
-  pmesh->SetNodesOwner(false);
+  std::string file_path = axom::utilities::filesystem::joinPath(datacoll.GetPrefixPath(), datacoll.GetCollectionName());
+  writeStaged(datacoll, axom::fmt::format("{}_delta_{:06}", file_path, cycle));
+}
+
+void StateManager::writeStaged(axom::sidre::MFEMSidreDataCollection& datacoll, const std::string& path,
+                               const std::optional<std::string>& index_path)
+{
+  auto [num_procs, rank] = getMPIInfo(datacoll.GetComm());
+  if (rank == 0) {
+    axom::utilities::filesystem::makeDirsForPath(datacoll.GetPrefixPath());
+  }
+
+  // The writer gets its own communicator, so that the messages of a background
+  // write cannot be matched by the ones of the rest of the simulation
+  MPI_Comm comm;
+  MPI_Comm_dup(datacoll.GetComm(), &comm);
+  MPI_Barrier(comm);
+
+  // Synchronous full saves write the simulation's datastore directly, the others
+  // write a staging datastore that the simulation does not modify
+  SLIC_ERROR_ROOT_IF(async_saves_ && !staging_ds_, "Asynchronous saves can only write a staging datastore");
+  axom::sidre::Group* root      = staging_ds_ ? staging_ds_->getRoot() : ds_->getRoot();
+  const int           num_files = numRestartFiles(comm);
+
+  auto write = [comm, root, num_files, rank = rank, path, index_path]() mutable {
+    axom::sidre::IOManager writer(comm);
+    writer.write(root, num_files, path, "sidre_hdf5");
+    if (rank == 0 && index_path) {
+      writer.writeGroupToRootFile(root->getGroup(*index_path), path + ".root");
+    }
+    MPI_Comm_free(&comm);
+  };
+
+  if (async_saves_) {
+    save_thread_ = std::thread(write);
+  } else {
+    write();
+    staging_ds_.reset();
+  }
+}
+
+void StateManager::enableNodeLocalCheckpoints(const NodeLocalCheckpointOptions& options)
+{
+#ifdef SERAC_USE_SCR
+  SLIC_ERROR_ROOT_IF(!ds_, "Serac's data store was not initialized - call StateManager::initialize first");
+  SLIC_ERROR_ROOT_IF(scr_finalized_, "SCR was finalized, node-local checkpoints cannot be enabled again in this run");
+  SLIC_ERROR_ROOT_IF(options.flush_interval < 0, "The checkpoint flush interval must be >= 0");
+  waitForPendingSaves();
+
+  if (!scr_initialized_) {
+    // SCR reads its configuration once, in SCR_Init()
+    auto config = [](const std::string& parameter, const auto& value) {
+      SCR_Config(axom::fmt::format("{}={}", parameter, value).c_str());
+    };
+    config("SCR_PREFIX", std::filesystem::absolute(output_dir_).string());
+    if (!options.cache_directory.empty()) {
+      config("SCR_CACHE_BASE", options.cache_directory);
+    }
+    config("SCR_COPY_TYPE", options.redundancy);
+    config("SCR_FLUSH", options.flush_interval);
+    SLIC_ERROR_ROOT_IF(SCR_Init() != SCR_SUCCESS, "Could not initialize SCR for the node-local checkpoints");
+    scr_initialized_ = true;
+  }
+  node_local_checkpoints_ = true;
+#else
+  SLIC_ERROR_ROOT(axom::fmt::format("Node-local checkpoints in '{}' require a build with SCR (SCR_DIR)",
+                                    options.cache_directory.empty() ? "/dev/shm" : options.cache_directory));
+#endif
+}
+
+void StateManager::disableNodeLocalCheckpoints()
+{
+#ifdef SERAC_USE_SCR
+  if (scr_initialized_) {
+    // this flushes the latest checkpoint to the output directory, unless it already is there
+    SCR_Finalize();
+    scr_initialized_ = false;
+    scr_finalized_   = true;
+  }
+#endif
+  node_local_checkpoints_ = false;
+}
+
+std::string StateManager::checkpointFile(axom::sidre::MFEMSidreDataCollection& datacoll, int cycle)
+{
+  auto [num_procs, rank] = getMPIInfo(datacoll.GetComm());
+  std::string name       = axom::fmt::format("{}_{:06}", datacoll.GetCollectionName(), cycle);
+  return axom::fmt::format("{}/{}/{}_{:06}.hdf5", std::filesystem::absolute(datacoll.GetPrefixPath()).string(), name,
+                           name, rank);
+}
+
+void StateManager::saveCheckpoint([[maybe_unused]] axom::sidre::MFEMSidreDataCollection& datacoll,
+                                  [[maybe_unused]] int                                    cycle)
+{
+#ifdef SERAC_USE_SCR
+  SERAC_MARK_FUNCTION;
+  SLIC_ERROR_ROOT_IF(datacolls_.size() > 1, "Node-local checkpoints only support a single mesh");
+
+  // Update the blueprint state in the datastore as Save() would
+  datacoll.PrepareToSave();
+
+  const std::string name = axom::fmt::format("{}_{:06}", datacoll.GetCollectionName(), cycle);
+  SCR_Start_output(name.c_str(), SCR_FLAG_CHECKPOINT);
+
+  // SCR routes the file of each rank to the node-local cache, and keeps track of whether every rank wrote it
+  char routed[SCR_MAX_FILENAME];
+  int  valid = (SCR_Route_file(checkpointFile(datacoll, cycle).c_str(), routed) == SCR_SUCCESS) ? 1 : 0;
+  if (valid) {
+    ds_->getRoot()->save(routed, "sidre_hdf5");
+    valid = axom::utilities::filesystem::pathExists(routed) ? 1 : 0;
+  }
+  SLIC_WARNING_ROOT_IF(SCR_Complete_output(valid) != SCR_SUCCESS,
+                       axom::fmt::format("The node-local checkpoint of cycle {} could not be written", cycle));
+#endif
+}
+
+bool StateManager::loadCheckpoint([[maybe_unused]] axom::sidre::MFEMSidreDataCollection& datacoll,
+                                  [[maybe_unused]] int                                    cycle)
+{
+#ifdef SERAC_USE_SCR
+  if (!node_local_checkpoints_) {
+    return false;
+  }
+
+  // SCR fetches the checkpoint from the most accessible level that holds a valid copy of it
+  const std::string name = axom::fmt::format("{}_{:06}", datacoll.GetCollectionName(), cycle);
+  int               have_restart = 0;
+  char              restart_name[SCR_MAX_FILENAME];
+  if (SCR_Current(name.c_str()) != SCR_SUCCESS || SCR_Have_restart(&have_restart, restart_name) != SCR_SUCCESS ||
+      !have_restart || name != restart_name) {
+    return false;
+  }
+
+  SCR_Start_restart(restart_name);
+  char routed[SCR_MAX_FILENAME];
+  int  valid = (SCR_Route_file(checkpointFile(datacoll, cycle).c_str(), routed) == SCR_SUCCESS) ? 1 : 0;
+  if (valid) {
+    ds_->getRoot()->load(routed, "sidre_hdf5");
+  }
+  SLIC_ERROR_ROOT_IF(SCR_Complete_restart(valid) != SCR_SUCCESS,
+                     axom::fmt::format("The node-local checkpoint of cycle {} could not be read", cycle));
+  return true;
+#else
+  return false;
+#endif
+}
+
+void StateManager::setOutputCompression(const OutputCompression& compression)
+{
+  SLIC_ERROR_ROOT_IF(compression.lossless_level < 0 || compression.lossless_level > 9,
+                     axom::fmt::format("Invalid lossless compression level '{}', it must be between 0 and 9",
+                                       compression.lossless_level));
+  SLIC_ERROR_ROOT_IF(compression.visualization_error_bound < 0.0, "The lossy compression error bound must be >= 0");
+  compression_ = compression;
+
+#ifdef AXOM_USE_HDF5
+  // Sidre writes its hdf5 files through Conduit, whose datasets are only compressed when they are chunked
+  conduit::Node opts;
+  opts["chunking/enabled"] = (compression.lossless_level > 0) ? "true" : "false";
+  if (compression.lossless_level > 0) {
+    opts["chunking/compression/method"] = "gzip";
+    opts["chunking/compression/level"]  = compression.lossless_level;
+  }
+  conduit::relay::io::hdf5_set_options(opts);
+#else
+  SLIC_WARNING_ROOT_IF(compression.lossless_level > 0, "Restart files are only compressed in HDF5-enabled builds");
+#endif
+}
+
+void StateManager::setRestartWritersPerNode(int writers_per_node)
+{
+  SLIC_ERROR_ROOT_IF(writers_per_node < 0, "The number of restart file writers per node must be >= 0");
+  waitForPendingSaves();
+  restart_writers_per_node_ = writers_per_node;
+}
+
+int StateManager::numRestartFiles(MPI_Comm comm)
+{
+  auto [num_procs, rank] = getMPIInfo(comm);
+  if (restart_writers_per_node_ == 0) {
+    return num_procs;
+  }
+
+  // count the nodes from the ranks that share memory with each other
+  MPI_Comm node_comm;
+  MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &node_comm);
+  int node_rank = 0;
+  MPI_Comm_rank(node_comm, &node_rank);
+  MPI_Comm_free(&node_comm);
+
+  int is_node_leader = (node_rank == 0) ? 1 : 0;
+  int num_nodes      = 0;
+  MPI_Allreduce(&is_node_leader, &num_nodes, 1, MPI_INT, MPI_SUM, comm);
+
+  return std::min(num_procs, num_nodes * restart_writers_per_node_);
+}
+
+void StateManager::enableIncrementalSaves(bool enable)
+{
+  waitForPendingSaves();
+  incremental_saves_ = enable;
+  base_cycles_.clear();
+  last_saved_cycles_.clear();
+  dirty_fields_.clear();
+  saved_checksums_.clear();
+}
+
+std::uint64_t StateManager::checksum(const mfem::Vector& values)
+{
+  std::uint64_t hash = 14695981039346656037ull;
+  const double* data = values.HostRead();
+  for (int i = 0; i < values.Size(); i++) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &data[i], sizeof(bits));
+    hash = (hash ^ bits) * 1099511628211ull;
+  }
+  return hash;
+}
+
+int StateManager::loadIncrement(axom::sidre::MFEMSidreDataCollection& datacoll, int cycle,
+                                std::unique_ptr<axom::sidre::DataStore>& increment)
+{
+  std::string file_path = axom::utilities::filesystem::joinPath(datacoll.GetPrefixPath(), datacoll.GetCollectionName());
+  auto        root_file = [&file_path](int c) { return axom::fmt::format("{}_delta_{:06}.root", file_path, c); };
+
+  if (!axom::utilities::filesystem::pathExists(root_file(cycle))) {
+    return cycle;
+  }
+
+  increment = std::make_unique<axom::sidre::DataStore>();
+  axom::sidre::IOManager reader(datacoll.GetComm());
+  reader.read(increment->getRoot(), root_file(cycle));
+  return increment->getRoot()->getView("base_cycle")->getData<int>();
+}
+
+void StateManager::applyIncrement(axom::sidre::MFEMSidreDataCollection& datacoll, int base_cycle, int cycle,
+                                  axom::sidre::DataStore& increment)
+{
+  std::string file_path = axom::utilities::filesystem::joinPath(datacoll.GetPrefixPath(), datacoll.GetCollectionName());
+  axom::sidre::IOManager reader(datacoll.GetComm());
+
+  // the increments holding the latest values of the fields, each one read once
+  std::unordered_map<int, std::unique_ptr<axom::sidre::DataStore>> increments;
+
+  auto* last_cyc_grp = increment.getRoot()->getGroup("last_cycle");
+  for (auto idx = last_cyc_grp->getFirstValidViewIndex(); axom::sidre::indexIsValid(idx);
+       idx      = last_cyc_grp->getNextValidViewIndex(idx)) {
+    auto*       view       = last_cyc_grp->getView(idx);
+    std::string name       = view->getName();
+    int         last_cycle = view->getData<int>();
+    last_saved_cycles_[name] = last_cycle;
+    if (last_cycle == base_cycle) {
+      continue;
+    }
+
+    axom::sidre::DataStore* source = &increment;
+    if (last_cycle != cycle) {
+      auto& stored = increments[last_cycle];
+      if (!stored) {
+        stored = std::make_unique<axom::sidre::DataStore>();
+        reader.read(stored->getRoot(), axom::fmt::format("{}_delta_{:06}.root", file_path, last_cycle));
+      }
+      source = stored.get();
+    }
+
+    auto* values        = source->getRoot()->getView("fields/" + name);
+    auto* grid_function = datacoll.GetParField(name);
+    SLIC_ERROR_IF(!values || !grid_function || values->getNumElements() != grid_function->Size(),
+                  axom::fmt::format("Restart increment of cycle {} does not match the field '{}'", cycle, name));
+    std::copy_n(values->getData<double*>(), grid_function->Size(), grid_function->HostWrite());
+  }
+
+  // the quadrature data of the increment is the latest
+  if (increment.getRoot()->hasGroup("quadrature_data")) {
+    auto* source = increment.getRoot()->getGroup("quadrature_data");
+    auto* group  = quadratureDataGroup(datacoll);
+    for (auto idx = source->getFirstValidViewIndex(); axom::sidre::indexIsValid(idx);
+         idx      = source->getNextValidViewIndex(idx)) {
+      auto* view = source->getView(idx);
+      if (group->hasView(view->getName())) {
+        group->destroyViewAndData(view->getName());
+      }
+      group->deepCopyView(view);
+    }
+  }
+
+  datacoll.SetCycle(cycle);
+  datacoll.SetTime(increment.getRoot()->getView("time")->getData<double>());
+}
+
+void StateManager::enableAsyncSaves(bool enable)
+{
+  if (enable) {
+    int provided = MPI_THREAD_SINGLE;
+    MPI_Query_thread(&provided);
+    if (provided < MPI_THREAD_MULTIPLE) {
+      SLIC_WARNING_ROOT("Asynchronous saves require MPI_THREAD_MULTIPLE support, saving synchronously instead");
+      enable = false;
+    }
+  }
+  async_saves_ = enable;
+}
+
+void StateManager::enableInSitu(const std::string& actions_file)
+{
+#ifdef SERAC_USE_ASCENT
+  SLIC_ERROR_ROOT_IF(actions_file.empty(), "An Ascent actions file is required for in-situ visualization");
+  SLIC_ERROR_ROOT_IF(!axom::utilities::filesystem::pathExists(actions_file),
+                     axom::fmt::format("Ascent actions file '{}' not found", actions_file));
+  disableInSitu();
+  in_situ_actions_ = actions_file;
+#else
+  SLIC_ERROR_ROOT(
+      axom::fmt::format("In-situ visualization with '{}' requires a build with Ascent (ASCENT_DIR)", actions_file));
+#endif
+}
+
+void StateManager::publishInSitu(const double t, const int cycle, const std::string& mesh_tag)
+{
+  if (!inSituEnabled()) {
+    return;
+  }
+  SLIC_ERROR_ROOT_IF(datacolls_.find(mesh_tag) == datacolls_.end(),
+                     axom::fmt::format("Mesh tag '{}' not found in the data store", mesh_tag));
+  SERAC_MARK_FUNCTION;
+  auto& datacoll = datacolls_.at(mesh_tag);
+
+  // Ascent reads the host copy of each field
+  for (auto* fields : {&named_states_, &named_duals_}) {
+    for (auto& [name, grid_function] : *fields) {
+      if (datacoll.HasField(name)) {
+        grid_function->HostRead();
+      }
+    }
+  }
+
+  // Update the blueprint state (time, cycle and topology) in the datastore as save() would
+  datacoll.SetTime(t);
+  datacoll.SetCycle(cycle);
+  datacoll.PrepareToSave();
+
+#ifdef SERAC_USE_ASCENT
+  if (!ascent_) {
+    conduit::Node options;
+    options["mpi_comm"]     = MPI_Comm_c2f(datacoll.GetComm());
+    options["actions_file"] = in_situ_actions_;
+    ascent_                 = std::make_shared<ascent::Ascent>();
+    ascent_->open(options);
+  }
+
+  // a zero-copy view of the blueprint mesh and fields of this rank
+  conduit::Node mesh;
+  datacoll.GetBPGroup()->createNativeLayout(mesh);
+  ascent_->publish(mesh);
+
+  // the actions come from the actions file
+  conduit::Node actions;
+  ascent_->execute(actions);
+#endif
+}
+
+void StateManager::disableInSitu()
+{
+#ifdef SERAC_USE_ASCENT
+  if (ascent_) {
+    ascent_->close();
+  }
+#endif
+  ascent_.reset();
+  in_situ_actions_.clear();
+}
+
+void StateManager::waitForPendingSaves()
+{
+  if (save_thread_.joinable()) {
+    save_thread_.join();
+  }
+  staging_ds_.reset();
+}
+
+mfem::ParMesh* StateManager::setMesh(std::unique_ptr<mfem::ParMesh> pmesh, const std::string& mesh_tag)
+{
+  // Functional needs the nodal grid function in the mesh
+  prepareNodes(*pmesh);
 
   newDataCollection(mesh_tag);
   auto& datacoll = datacolls_.at(mesh_tag);
@@ -310,6 +954,25 @@ mfem::ParMesh& StateManager::mesh(const std::string& mesh_tag)
   return static_cast<mfem::ParMesh&>(*mesh);
 }
 
+void StateManager::setCoarseMeshes(std::vector<std::unique_ptr<mfem::ParMesh>> coarse_meshes,
+                                   const std::string&                          mesh_tag)
+{
+  SLIC_ERROR_ROOT_IF(datacolls_.find(mesh_tag) == datacolls_.end(),
+                     axom::fmt::format("Mesh tag \"{}\" not found in the data store", mesh_tag));
+  coarse_meshes_[mesh_tag] = std::move(coarse_meshes);
+}
+
+std::vector<mfem::ParMesh*> StateManager::coarseMeshes(const std::string& mesh_tag)
+{
+  std::vector<mfem::ParMesh*> meshes;
+  if (auto levels = coarse_meshes_.find(mesh_tag); levels != coarse_meshes_.end()) {
+    for (auto& mesh : levels->second) {
+      meshes.push_back(mesh.get());
+    }
+  }
+  return meshes;
+}
+
 std::string StateManager::collectionID(const mfem::ParMesh* pmesh)
 {
   if (!pmesh) {
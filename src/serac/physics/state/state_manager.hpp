@@ -12,22 +12,94 @@
 
 #pragma once
 
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <optional>
+#include <set>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 #include "mfem.hpp"
 #include "axom/sidre/core/MFEMSidreDataCollection.hpp"
 
 #include "serac/infrastructure/logger.hpp"
+#include "serac/infrastructure/memory.hpp"
 #include "serac/physics/state/finite_element_state.hpp"
 #include "serac/physics/state/finite_element_dual.hpp"
 #include "serac/numerics/functional/quadrature_data.hpp"
 
+namespace ascent {
+class Ascent;
+}  // namespace ascent
+
 namespace serac {
 
 /// Polynomial order used to discretize the shape displacement field
 constexpr int SHAPE_ORDER = 1;
 
+/// Compression of the fields written to restart and visualization files
+struct OutputCompression {
+  /// gzip level, from 0 (no compression) to 9, of the lossless compression of the restart and ParaView files
+  int lossless_level = 0;
+
+  /**
+   * Pointwise error bound of the lossy compression of the fields written to ParaView files, zero for lossless
+   * output. The values are rounded to a power-of-two multiple of the bound, whose trailing zero bits the lossless
+   * stage then compresses. Restart files are always lossless.
+   */
+  double visualization_error_bound = 0.0;
+};
+
+/// Where and how the node-local checkpoints of StateManager::enableNodeLocalCheckpoints() are kept
+struct NodeLocalCheckpointOptions {
+  /// The node-local directory (e.g. of an NVMe drive) of the checkpoints, SCR's default (/dev/shm) if empty
+  std::string cache_directory = "";
+
+  /// How the checkpoints are protected from the loss of a node: SINGLE (none), PARTNER (a copy on another node) or
+  /// XOR (parity data over a set of nodes)
+  std::string redundancy = "PARTNER";
+
+  /// Copy every this many checkpoints to the output directory on the parallel file system
+  int flush_interval = 10;
+};
+
+/**
+ * @brief A scratch vector of true dof values, borrowed from the pool of StateManager::scratchVector()
+ *
+ * The vector is returned to the pool when this handle is destroyed, so that the next scratch vector of the same size
+ * reuses its memory instead of allocating it again.
+ */
+class ScratchVector {
+public:
+  /**
+   * @brief Take ownership of a vector (from the pool)
+   * @param vector The vector
+   */
+  explicit ScratchVector(std::unique_ptr<mfem::Vector> vector) : vector_(std::move(vector)) {}
+
+  /// @brief Move constructor, the moved-from handle no longer holds a vector
+  ScratchVector(ScratchVector&&) = default;
+
+  ScratchVector(const ScratchVector&) = delete;
+  ScratchVector& operator=(const ScratchVector&) = delete;
+  ScratchVector& operator=(ScratchVector&&) = delete;
+
+  /// @brief Return the vector to the pool
+  ~ScratchVector();
+
+  /// @brief Access the vector
+  mfem::Vector& operator*() { return *vector_; }
+
+  /// @brief Access the vector's members
+  mfem::Vector* operator->() { return vector_.get(); }
+
+private:
+  /// @brief The borrowed vector
+  std::unique_ptr<mfem::Vector> vector_;
+};
+
 /**
  * @brief Manages the lifetimes of FEState objects such that restarts are abstracted
  * from physics modules
@@ -93,11 +165,64 @@ public:
    */
   static void storeDual(FiniteElementDual& dual);
 
+  /**
+   * @brief Saves a quadrature data buffer (e.g. the internal variables of a material) in the restart files of a mesh
+   *
+   * Each save() copies the committed data of the buffer into the datastore as one block of raw bytes, which is
+   * written (and compressed, and written in the background) with the fields. On a restart, the data is restored
+   * from the loaded block, without any conversion at the quadrature points.
+   *
+   * @param[in] name A name for the buffer, unique amongst the quadrature data of the mesh
+   * @param[in] qdata The buffer, which is not kept alive by the StateManager
+   * @param[in] mesh_tag A string that uniquely identifies the mesh of the buffer
+   * @note If this is a restart, the buffer must have the same size as the saved one
+   */
+  template <typename T>
+  static void storeQuadratureData(const std::string& name, std::shared_ptr<QuadratureData<T>> qdata,
+                                  const std::string& mesh_tag = default_mesh_name_)
+  {
+    storeQuadratureData(
+        name,
+        [weak_qdata = std::weak_ptr<QuadratureData<T>>(qdata)]() {
+          auto buffer = weak_qdata.lock();
+          return buffer ? buffer->bytes() : std::pair<void*, size_t>{nullptr, 0};
+        },
+        mesh_tag);
+  }
+
+  /**
+   * @brief Saves a block of raw memory in the restart files of a mesh, see the overload for QuadratureData
+   *
+   * @param[in] name A name for the memory, unique amongst the quadrature data of the mesh
+   * @param[in] bytes Returns the memory and its size in bytes, or a null pointer once it is no longer saved
+   * @param[in] mesh_tag A string that uniquely identifies the mesh of the memory
+   */
+  static void storeQuadratureData(const std::string& name, std::function<std::pair<void*, size_t>()> bytes,
+                                  const std::string& mesh_tag = default_mesh_name_);
+
+  /**
+   * @brief Borrow a scratch vector for the true dofs of a finite element space, e.g. for the temporaries of a
+   * timestep or an adjoint solve
+   *
+   * The vectors are pooled by size (so spaces with the same number of true dofs share them), and only allocated when
+   * every vector of that size is in use. This avoids reallocating large vectors, which fragments (device) memory.
+   *
+   * @param space The finite element space
+   * @return A handle to the vector, which returns it to the pool when destroyed
+   * @note The values of the vector are not initialized
+   */
+  static ScratchVector scratchVector(const mfem::ParFiniteElementSpace& space);
+
+  /// @brief Free the scratch vectors that are not in use (see scratchVector())
+  static void clearScratchVectors() { scratch_vectors_.clear(); }
+
   /**
    * @brief Updates the StateManager-owned grid function using the values from a given
    * FiniteElementState.
    *
-   * This sync operation must occur prior to writing a restart file.
+   * This sync operation must occur prior to writing a restart file. The states stored by the StateManager
+   * share the data of its grid functions (see FiniteElementState::shareGridFunctionData), so this prolongs their
+   * true vector in place. It also leaves the gridFunction() of \p state up to date.
    *
    * @param state The state used to update the internal grid function
    */
@@ -106,7 +231,14 @@ public:
     SLIC_ERROR_ROOT_IF(named_states_.find(state.name()) == named_states_.end(),
                        axom::fmt::format("State manager does not contain state named '{}'", state.name()));
 
-    state.fillGridFunction(*named_states_[state.name()]);
+    state.syncToHost();
+    updateField(state.name(), *named_states_[state.name()], [&state](mfem::ParGridFunction& grid_function) {
+      const mfem::ParGridFunction& state_grid_function = state.gridFunction();
+      // copies of the stored states have their own grid function
+      if (state_grid_function.GetData() != grid_function.GetData()) {
+        grid_function = state_grid_function;
+      }
+    });
   }
 
   /**
@@ -122,7 +254,10 @@ public:
     SLIC_ERROR_ROOT_IF(named_duals_.find(dual.name()) == named_duals_.end(),
                        axom::fmt::format("State manager does not contain dual named '{}'", dual.name()));
 
-    dual.space().GetRestrictionMatrix()->MultTranspose(dual, *named_duals_[dual.name()]);
+    dual.syncToHost();
+    updateField(dual.name(), *named_duals_[dual.name()], [&dual](mfem::ParGridFunction& grid_function) {
+      dual.space().GetRestrictionMatrix()->MultTranspose(dual, grid_function);
+    });
   }
 
   /**
@@ -133,6 +268,110 @@ public:
    */
   static void save(const double t, const int cycle, const std::string& mesh_tag = default_mesh_name_);
 
+  /**
+   * @brief Makes save() return once the datastore has been copied to a staging datastore, and write it in the
+   * background
+   *
+   * The snapshot doubles the host memory used by the datastore while a save is pending. Only one save is pending
+   * at a time: save() waits for the previous one before taking its snapshot.
+   *
+   * @param[in] enable Whether saves are written asynchronously
+   * @note The background writes use MPI, so asynchronous saves need MPI_THREAD_MULTIPLE support. Saves stay
+   * synchronous (with a warning) when the MPI library does not provide it.
+   */
+  static void enableAsyncSaves(bool enable = true);
+
+  /**
+   * @brief Makes save() write incremental restart files
+   *
+   * The next save is a full one, the base of the following ones. Those only write the fields that were changed
+   * by updateState() or updateDual() since the field was last saved, and refer to the files holding the latest
+   * values of the others, so the mesh and the static fields (e.g. the shape displacement) are only written once.
+   * load() reads both kinds of restart files.
+   *
+   * @param[in] enable Whether saves are incremental
+   */
+  static void enableIncrementalSaves(bool enable = true);
+
+  /**
+   * @brief Aggregates the restart files written by save() into a given number of files per node
+   *
+   * sidre's IOManager gathers the data of consecutive ranks into each file, taking turns to write it, and the
+   * root file indexes the files, so load() is unchanged. This keeps the number of files (and the load on the
+   * metadata servers of the file system) proportional to the number of nodes instead of the number of ranks.
+   *
+   * @param[in] writers_per_node The number of files per node, zero for one file per rank
+   * @note ParaView output is still written as one file per rank by mfem::ParaViewDataCollection
+   */
+  static void setRestartWritersPerNode(int writers_per_node);
+
+  /**
+   * @brief Makes save() write the restart files through SCR (the Scalable Checkpoint/Restart library), as
+   * checkpoints in node-local storage that are only copied to the output directory every few saves
+   *
+   * Each rank writes its own file to the node-local cache, which SCR protects with the redundancy of the options
+   * (e.g. a copy in the cache of a partner node) and flushes to the parallel file system at the flush interval and
+   * when the checkpoints are disabled. load() restores the checkpoint of the requested cycle from whichever copy of
+   * it is still valid (the cache, a partner or the output directory), or reads the restart files written without SCR
+   * if SCR has no checkpoint of that cycle.
+   *
+   * @param[in] options Where and how the checkpoints are kept, which are fixed by the first call
+   * @pre initialize() must have been called, the output directory is the prefix directory of SCR
+   * @note This needs a build with SCR (SCR_DIR). The checkpoints are written synchronously and replace the
+   * asynchronous, incremental and aggregated restart files. SCR is only initialized once per run, so the checkpoints
+   * cannot be enabled again once disabled.
+   */
+  static void enableNodeLocalCheckpoints(const NodeLocalCheckpointOptions& options = {});
+
+  /// @brief Makes save() write restart files again, after SCR flushed the latest checkpoint if it had to
+  static void disableNodeLocalCheckpoints();
+
+  /**
+   * @brief Sets the compression of the restart files written by save(), and of the ParaView files of the physics
+   * modules
+   *
+   * @param[in] compression The compression options
+   * @note The lossless compression of restart files uses the chunked gzip filter of HDF5, so it needs an HDF5-enabled
+   * build. It configures every later HDF5 write of Conduit.
+   */
+  static void setOutputCompression(const OutputCompression& compression);
+
+  /// @brief Returns the compression of the restart and visualization files
+  static const OutputCompression& outputCompression() { return compression_; }
+
+  /**
+   * @brief Publishes the Conduit Blueprint mesh and fields to Ascent (in place, without copies or files) on each
+   * later call of publishInSitu()
+   *
+   * At each publish, Ascent runs the actions (e.g. renders, slices or extracts) of the given file on the Blueprint
+   * data of the sidre datastore, after updating its state (the time and cycle) like save() does.
+   *
+   * @param[in] actions_file The Ascent actions (YAML or JSON) file
+   * @note This needs a build with Ascent (ASCENT_DIR)
+   */
+  static void enableInSitu(const std::string& actions_file);
+
+  /// @brief Returns whether enableInSitu() was called
+  static bool inSituEnabled() { return !in_situ_actions_.empty(); }
+
+  /**
+   * @brief Runs the in-situ visualization and analysis actions of enableInSitu() on the current Blueprint state
+   * @param[in] t The current sim time
+   * @param[in] cycle The current iteration number of the simulation
+   * @param[in] mesh_tag A string that uniquely identifies the mesh (and accompanying fields) to publish
+   */
+  static void publishInSitu(const double t, const int cycle, const std::string& mesh_tag = default_mesh_name_);
+
+  /// @brief Closes the in-situ session of enableInSitu(), if any, so that publishInSitu() does nothing
+  static void disableInSitu();
+
+  /**
+   * @brief Blocks until the file of the pending asynchronous save (if any) has been written
+   *
+   * This must be called before exiting, and before anything else writes to the files of the pending save.
+   */
+  static void waitForPendingSaves();
+
   /**
    * @brief Loads an existing DataCollection
    * @param[in] cycle_to_load What cycle to load the DataCollection from
@@ -157,11 +396,20 @@ public:
    */
   static void reset()
   {
+    enableIncrementalSaves(false);
+    disableInSitu();
+    disableNodeLocalCheckpoints();
+    async_saves_ = false;
     named_states_.clear();
     named_duals_.clear();
+    named_qdata_.clear();
+    qdata_memory_.set(0);
+    clearScratchVectors();
+    sidre_memory_.set(0);
     shape_displacements_.clear();
     shape_sensitivities_.clear();
     datacolls_.clear();
+    coarse_meshes_.clear();
     output_dir_.clear();
     is_restart_ = false;
     ds_         = nullptr;
@@ -182,6 +430,22 @@ public:
    */
   static mfem::ParMesh& mesh(const std::string& mesh_tag = default_mesh_name_);
 
+  /**
+   * @brief Gives ownership of the coarse meshes of the refinements that produced a registered mesh to StateManager,
+   * for the physics modules whose preconditioner is a GeometricMultigridPreconditioner
+   * @param[in] coarse_meshes The coarse meshes, from the coarsest to the finest, see mesh::refineAndDistribute
+   * @param[in] mesh_tag A string that uniquely identifies the (fine) mesh
+   */
+  static void setCoarseMeshes(std::vector<std::unique_ptr<mfem::ParMesh>> coarse_meshes,
+                              const std::string&                          mesh_tag = default_mesh_name_);
+
+  /**
+   * @brief Returns non-owning pointers to the coarse meshes of a registered mesh, from the coarsest to the finest
+   * @param[in] mesh_tag A string that uniquely identifies the (fine) mesh
+   * @return The coarse meshes given to setCoarseMeshes, or none
+   */
+  static std::vector<mfem::ParMesh*> coarseMeshes(const std::string& mesh_tag = default_mesh_name_);
+
   /**
    * @brief Get the shape displacement finite element state
    *
@@ -226,6 +490,129 @@ private:
    */
   static double newDataCollection(const std::string& name, const std::optional<int> cycle_to_load = {});
 
+  /**
+   * @brief Updates a StateManager-owned grid function, and flags the field as changed if it differs from its
+   * last saved values
+   *
+   * @param[in] name The name of the field
+   * @param[inout] grid_function The grid function of the field
+   * @param[in] fill Sets the grid function to the values of the field
+   */
+  template <typename Fill>
+  static void updateField(const std::string& name, mfem::ParGridFunction& grid_function, Fill&& fill)
+  {
+    fill(grid_function);
+    if (!incremental_saves_) {
+      return;
+    }
+
+    // the grid function may have been modified in place since the save, so compare with a checksum of the
+    // saved values instead of the previous ones
+    auto saved = saved_checksums_.find(name);
+    if (saved == saved_checksums_.end() || saved->second != checksum(grid_function)) {
+      dirty_fields_.insert(name);
+    } else {
+      dirty_fields_.erase(name);
+    }
+  }
+
+  /**
+   * @brief A hash of the bits of the values of a field, to detect the fields that changed
+   *
+   * @param[in] values The values of the field
+   * @return The FNV-1a hash of the values
+   */
+  static std::uint64_t checksum(const mfem::Vector& values);
+
+  /**
+   * @brief Returns the group of the datastore that holds the quadrature data of a data collection
+   * @param[in] datacoll The data collection
+   */
+  static axom::sidre::Group* quadratureDataGroup(axom::sidre::MFEMSidreDataCollection& datacoll);
+
+  /**
+   * @brief Copies the quadrature data registered with storeQuadratureData() into the datastore
+   * @param[in] mesh_tag The mesh the quadrature data is defined on
+   */
+  static void updateQuadratureData(const std::string& mesh_tag);
+
+  /**
+   * @brief Writes an incremental restart file, with the fields that changed since they were last saved
+   *
+   * @param[in] datacoll The data collection to save
+   * @param[in] base_cycle The cycle of the last full save
+   * @param[in] t The current sim time
+   * @param[in] cycle The current iteration number of the simulation
+   */
+  static void saveIncrement(axom::sidre::MFEMSidreDataCollection& datacoll, int base_cycle, const double t,
+                            const int cycle);
+
+  /**
+   * @brief Writes the staging datastore (or for synchronous full saves, the datastore), in the background for
+   * asynchronous saves
+   *
+   * @param[in] datacoll The data collection being saved
+   * @param[in] path The path of the files, without extension
+   * @param[in] index_path The path in the staging datastore of the blueprint index to add to the root file, if any
+   */
+  static void writeStaged(axom::sidre::MFEMSidreDataCollection& datacoll, const std::string& path,
+                          const std::optional<std::string>& index_path = {});
+
+  /**
+   * @brief Writes the datastore of a node-local checkpoint through SCR
+   *
+   * @param[in] datacoll The data collection being saved
+   * @param[in] cycle The current iteration number of the simulation
+   */
+  static void saveCheckpoint(axom::sidre::MFEMSidreDataCollection& datacoll, int cycle);
+
+  /**
+   * @brief Reads the datastore from the node-local checkpoint of a cycle, if SCR has one
+   *
+   * @param[in] datacoll The data collection to load
+   * @param[in] cycle The cycle to load
+   * @return Whether the checkpoint was read, otherwise the restart files of the cycle are
+   */
+  static bool loadCheckpoint(axom::sidre::MFEMSidreDataCollection& datacoll, int cycle);
+
+  /**
+   * @brief The file of the node-local checkpoint of a cycle of a data collection on a rank, before SCR routes it
+   *
+   * @param[in] datacoll The data collection
+   * @param[in] cycle The cycle of the checkpoint
+   */
+  static std::string checkpointFile(axom::sidre::MFEMSidreDataCollection& datacoll, int cycle);
+
+  /**
+   * @brief Returns the number of files the restart files of a communicator are aggregated into
+   *
+   * @param[in] comm The communicator of the data collection
+   * @see setRestartWritersPerNode
+   */
+  static int numRestartFiles(MPI_Comm comm);
+
+  /**
+   * @brief Reads the incremental restart file of a cycle, if it is one
+   *
+   * @param[in] datacoll The data collection to load
+   * @param[in] cycle The cycle to load
+   * @param[out] increment The contents of the incremental restart file, null if the cycle was a full save
+   * @return The cycle of the full save to load first
+   */
+  static int loadIncrement(axom::sidre::MFEMSidreDataCollection& datacoll, int cycle,
+                           std::unique_ptr<axom::sidre::DataStore>& increment);
+
+  /**
+   * @brief Overwrites the fields of a loaded full save with their latest values in an incremental restart file
+   *
+   * @param[inout] datacoll The data collection, loaded from @a base_cycle
+   * @param[in] base_cycle The cycle of the full save
+   * @param[in] cycle The cycle of the incremental restart file
+   * @param[in] increment The contents of the incremental restart file
+   */
+  static void applyIncrement(axom::sidre::MFEMSidreDataCollection& datacoll, int base_cycle, int cycle,
+                             axom::sidre::DataStore& increment);
+
   /**
    * @brief Construct the shape displacement and sensitivity fields for the requested mesh
    *
@@ -233,6 +620,14 @@ private:
    */
   static void constructShapeFields(const std::string& mesh_tag);
 
+  friend class ScratchVector;
+
+  /**
+   * @brief Return a scratch vector to the pool
+   * @param vector The vector
+   */
+  static void releaseScratchVector(std::unique_ptr<mfem::Vector> vector);
+
   /**
    * @brief The datacollection instances
    * The object is constructed when the user calls StateManager::initialize.
@@ -245,6 +640,9 @@ private:
   /// @brief A map of the shape sensitivity duals for each stored mesh ID
   static std::unordered_map<std::string, std::unique_ptr<FiniteElementDual>> shape_sensitivities_;
 
+  /// @brief A map of the coarse meshes of the refinements of each stored mesh ID, see setCoarseMeshes
+  static std::unordered_map<std::string, std::vector<std::unique_ptr<mfem::ParMesh>>> coarse_meshes_;
+
   /**
    * @brief Whether this simulation has been restarted from another simulation
    */
@@ -257,10 +655,51 @@ private:
   /// @brief Default name for the mesh - mostly for backwards compatibility
   const static std::string default_mesh_name_;
 
+  /// @brief Whether save() writes the datastore in the background
+  static bool async_saves_;
+  /// @brief The snapshot of the datastore being written by a pending asynchronous save
+  static std::unique_ptr<axom::sidre::DataStore> staging_ds_;
+  /// @brief The thread writing the pending asynchronous save, not joinable if there is none
+  static std::thread save_thread_;
+
+  /// @brief The number of files per node the restart files are aggregated into, zero for one file per rank
+  static int restart_writers_per_node_;
+  /// @brief The compression of the restart and visualization files
+  static OutputCompression compression_;
+  /// @brief Whether save() writes incremental restart files
+  static bool incremental_saves_;
+  /// @brief Whether save() writes node-local checkpoints through SCR
+  static bool node_local_checkpoints_;
+  /// @brief Whether SCR was initialized (and not yet finalized) by enableNodeLocalCheckpoints()
+  static bool scr_initialized_;
+  /// @brief Whether SCR was finalized, after which it cannot be initialized again
+  static bool scr_finalized_;
+  /// @brief The cycle of the full save that the incremental restart files of each mesh refer to
+  static std::unordered_map<std::string, int> base_cycles_;
+  /// @brief The cycle of the last restart file that holds the values of each field
+  static std::unordered_map<std::string, int> last_saved_cycles_;
+  /// @brief The fields that changed since they were last saved
+  static std::set<std::string> dirty_fields_;
+  /// @brief The checksum of the values of each field when it was last saved
+  static std::unordered_map<std::string, std::uint64_t> saved_checksums_;
+  /// @brief The Ascent actions file of the in-situ session, empty when it is disabled
+  static std::string in_situ_actions_;
+  /// @brief The in-situ session, opened by the first publishInSitu() (shared, as Ascent is an optional dependency)
+  static std::shared_ptr<ascent::Ascent> ascent_;
+
   /// @brief A collection of FiniteElementState names and their corresponding Sidre-owned grid function pointers
   static std::unordered_map<std::string, mfem::ParGridFunction*> named_states_;
   /// @brief A collection of FiniteElementDual names and their corresponding Sidre-owned grid function pointers
   static std::unordered_map<std::string, mfem::ParGridFunction*> named_duals_;
+  /// @brief The raw memory of the quadrature data of each mesh, by name, see storeQuadratureData()
+  static std::unordered_map<std::string, std::unordered_map<std::string, std::function<std::pair<void*, size_t>()>>>
+      named_qdata_;
+  /// @brief The scratch vectors that are not in use, by size
+  static std::unordered_map<int, std::vector<std::unique_ptr<mfem::Vector>>> scratch_vectors_;
+  /// @brief The accounting of the Sidre-owned grid functions of the states and duals, see memory::usage()
+  static memory::Tracker sidre_memory_;
+  /// @brief The accounting of the copies of the quadrature data in Sidre, see memory::usage()
+  static memory::Tracker qdata_memory_;
 };
 
 }  // namespace serac
@@ -0,0 +1,34 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/physics/state/submesh_transfer.hpp"
+
+#include <string>
+
+#include "serac/infrastructure/logger.hpp"
+
+namespace serac {
+
+SubmeshTransfer::SubmeshTransfer(const FiniteElementState& from, const FiniteElementState& to)
+{
+  SLIC_ERROR_ROOT_IF(!mfem::ParSubMesh::IsParSubMesh(&from.mesh()) && !mfem::ParSubMesh::IsParSubMesh(&to.mesh()),
+                     "Transfers between states need the mesh of one of them to be a submesh of the other");
+  SLIC_ERROR_ROOT_IF(from.space().GetVDim() != to.space().GetVDim() ||
+                         std::string(from.space().FEColl()->Name()) != to.space().FEColl()->Name(),
+                     axom::fmt::format("States '{}' and '{}' are of different kinds of spaces", from.name(), to.name()));
+
+  map_ = std::make_unique<mfem::ParTransferMap>(from.gridFunction(), to.gridFunction());
+}
+
+void SubmeshTransfer::transfer(const FiniteElementState& from, FiniteElementState& to) const
+{
+  // the grid function of the destination holds its current values, which the dofs outside the submesh keep
+  mfem::ParGridFunction& destination = to.gridFunction();
+  map_->Transfer(from.gridFunction(), destination);
+  to.setFromGridFunction(destination);
+}
+
+}  // namespace serac
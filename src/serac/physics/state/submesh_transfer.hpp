@@ -0,0 +1,58 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file submesh_transfer.hpp
+ *
+ * @brief Transfers of finite element states between a mesh and a submesh of some of its elements (an
+ * mfem::ParSubMesh), for physics that are confined to a region of the mesh
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "mfem.hpp"
+
+#include "serac/physics/state/finite_element_state.hpp"
+
+namespace serac {
+
+/**
+ * @brief Copies the values of a state into another one of the same kind of space, where one of their meshes is an
+ * mfem::ParSubMesh of the other
+ *
+ * The map between the dofs of the two spaces is computed once, when the transfer is constructed, so each transfer
+ * only costs a gather (or scatter) of the dofs of the submesh. A transfer from the submesh to its parent only sets
+ * the dofs of the submesh, and the others keep their values.
+ */
+class SubmeshTransfer {
+public:
+  /**
+   * @brief Builds the map between the dofs of the spaces of two states
+   *
+   * @param from a state of the space that is transferred from
+   * @param to a state of the space that is transferred to
+   *
+   * @pre The mesh of one of the states is an mfem::ParSubMesh of the mesh of the other, and their spaces have the same
+   * finite element collection and number of components
+   */
+  SubmeshTransfer(const FiniteElementState& from, const FiniteElementState& to);
+
+  /**
+   * @brief Copies the values of a state into another one
+   *
+   * @param from the state to transfer, of the space given as @a from to the constructor
+   * @param to the state to set, of the space given as @a to to the constructor
+   */
+  void transfer(const FiniteElementState& from, FiniteElementState& to) const;
+
+private:
+  /// @brief The map between the dofs of the spaces
+  std::unique_ptr<mfem::ParTransferMap> map_;
+};
+
+}  // namespace serac
@@ -90,6 +90,72 @@ TEST(BeamBending, TwoDimensional)
   solid_solver.outputState("paraview_output");
 }
 
+/// @brief The displacement of the two dimensional beam, solved with the given linear solver options
+mfem::Vector bentBeamDisplacement(const LinearSolverOptions& linear_options)
+{
+  constexpr int p   = 1;
+  constexpr int dim = 2;
+
+  axom::sidre::DataStore datastore;
+  serac::StateManager::initialize(datastore, "beam_bending_data");
+
+  std::string filename = SERAC_REPO_DIR "/data/meshes/beam-quad.mesh";
+  serac::StateManager::setMesh(mesh::refineAndDistribute(buildMeshFromFile(filename), 1, 0));
+
+  serac::NonlinearSolverOptions nonlinear_options{.nonlin_solver  = NonlinearSolver::Newton,
+                                                  .relative_tol   = 1.0e-10,
+                                                  .absolute_tol   = 1.0e-12,
+                                                  .max_iterations = 20,
+                                                  .print_level    = 1};
+
+  mfem::Vector displacement;
+  {
+    SolidMechanics<p, dim> solid_solver(nonlinear_options, linear_options,
+                                        solid_mechanics::default_quasistatic_options, GeometricNonlinearities::On,
+                                        "solid_mechanics");
+
+    solid_mechanics::StVenantKirchhoff mat{1.0, 1.91666666666667, 1.0};
+    solid_solver.setMaterial(mat);
+
+    auto bc = [](const mfem::Vector&, mfem::Vector& bc_vec) -> void { bc_vec = 0.0; };
+    solid_solver.setDisplacementBCs(std::set<int>{1}, bc);
+    solid_solver.setDisplacement(bc);
+
+    solid_solver.setPiolaTraction(
+        [](const auto& x, const tensor<double, dim>& n, const double) { return -0.01 * n * (x[1] > 0.99); });
+
+    solid_solver.completeSetup();
+    solid_solver.advanceTimestep(1.0);
+
+    displacement = solid_solver.displacement();
+  }
+
+  serac::StateManager::reset();
+  return displacement;
+}
+
+TEST(BeamBending, SeparateComponentPreconditioner)
+{
+  serac::LinearSolverOptions amg_options{.linear_solver  = LinearSolver::GMRES,
+                                         .preconditioner = Preconditioner::HypreAMG,
+                                         .relative_tol   = 1.0e-10,
+                                         .absolute_tol   = 1.0e-14,
+                                         .max_iterations = 500};
+  mfem::Vector               expected = bentBeamDisplacement(amg_options);
+
+  // the preconditioner ignores the couplings between the components of the displacement, but the linear solver
+  // (with an assembled or a matrix-free Jacobian) doesn't, so the solution is the same
+  for (bool matrix_free : {false, true}) {
+    serac::LinearSolverOptions sdc_options = amg_options;
+    sdc_options.preconditioner             = Preconditioner::SeparateComponentAMG;
+    sdc_options.matrix_free                = matrix_free;
+
+    mfem::Vector displacement = bentBeamDisplacement(sdc_options);
+    displacement -= expected;
+    EXPECT_LT(displacement.Normlinf(), 1.0e-8 * expected.Normlinf());
+  }
+}
+
 }  // namespace serac
 
 int main(int argc, char* argv[])
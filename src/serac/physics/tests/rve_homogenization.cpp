@@ -0,0 +1,131 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/physics/rve_homogenization.hpp"
+
+#include "axom/slic/core/SimpleLogger.hpp"
+#include <gtest/gtest.h>
+#include "mfem.hpp"
+
+#include "serac/mesh/mesh_utils.hpp"
+#include "serac/physics/materials/solid_material.hpp"
+#include "serac/physics/solid_mechanics.hpp"
+
+namespace serac {
+
+constexpr int dim = 3;
+
+/**
+ * @brief A unit cube made periodic in every direction, whose elements with x < 0.5 have attribute 1 and the others
+ * attribute 2, i.e. a laminate of two layers of equal thickness
+ */
+std::unique_ptr<mfem::ParMesh> periodicLaminate()
+{
+  int  n    = 4;
+  auto cell = mfem::Mesh::MakeCartesian3D(n, n, n, mfem::Element::HEXAHEDRON, 1.0, 1.0, 1.0);
+  for (int e = 0; e < cell.GetNE(); e++) {
+    mfem::Vector center(dim);
+    cell.GetElementCenter(e, center);
+    cell.SetAttribute(e, (center[0] < 0.5) ? 1 : 2);
+  }
+  cell.SetAttributes();
+
+  std::vector<mfem::Vector> translations = {mfem::Vector({1.0, 0.0, 0.0}), mfem::Vector({0.0, 1.0, 0.0}),
+                                            mfem::Vector({0.0, 0.0, 1.0})};
+  auto periodic = mfem::Mesh::MakePeriodic(cell, cell.CreatePeriodicVertexMapping(translations, 1.0e-6));
+  return mesh::refineAndDistribute(std::move(periodic), 0, 0);
+}
+
+TEST(RVEHomogenization, LinearLaminate)
+{
+  auto mesh = periodicLaminate();
+
+  RVEHomogenization<1, dim> rve(*mesh, solid_mechanics::default_nonlinear_options,
+                                {.linear_solver  = LinearSolver::CG,
+                                 .preconditioner = Preconditioner::HypreAMG,
+                                 .relative_tol   = 1.0e-12,
+                                 .absolute_tol   = 1.0e-14,
+                                 .max_iterations = 500,
+                                 .print_level    = 0},
+                                GeometricNonlinearities::Off, true);
+
+  solid_mechanics::LinearIsotropic stiff{.density = 1.0, .K = 10.0, .G = 5.0};
+  solid_mechanics::LinearIsotropic soft{.density = 1.0, .K = 1.0, .G = 0.5};
+  rve.setMaterial(stiff, {1});
+  rve.setMaterial(soft, {2});
+
+  tensor<double, dim, dim> H_a = {{{1.0e-3, 0.0, 0.0}, {0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}}};
+  tensor<double, dim, dim> H_b = {{{2.0e-3, 1.0e-3, 0.0}, {0.0, -1.0e-3, 0.0}, {0.0, 5.0e-4, 3.0e-4}}};
+  auto                     responses = rve.solve({H_a, H_b});
+
+  ASSERT_EQ(responses.size(), std::size_t(2));
+  EXPECT_TRUE(responses[0].converged);
+  EXPECT_NEAR(rve.volume(), 1.0, 1.0e-12);
+
+  // under a uniaxial strain normal to the layers, the laminate is as stiff as its layers in series
+  auto   C           = responses[0].tangent;
+  double M_stiff     = stiff.K + 4.0 * stiff.G / 3.0;
+  double M_soft      = soft.K + 4.0 * soft.G / 3.0;
+  double M_effective = 1.0 / (0.5 / M_stiff + 0.5 / M_soft);
+  EXPECT_NEAR(C[0][0][0][0], M_effective, 1.0e-8 * M_effective);
+
+  // the tangent of a linear RVE is the same for every load case, and has the major symmetry of the materials
+  EXPECT_LT(norm(responses[1].tangent - C), 1.0e-12 * norm(C));
+  EXPECT_LT(norm(C - make_tensor<dim, dim, dim, dim>([&](int i, int j, int k, int l) { return C[k][l][i][j]; })),
+            1.0e-8 * norm(C));
+
+  // and the stress of each load case, from the superposition of the unit load cases, is that of the tangent
+  for (auto [H, response] : {std::pair{H_a, responses[0]}, std::pair{H_b, responses[1]}}) {
+    EXPECT_LT(norm(response.stress - double_dot(C, H)), 1.0e-8 * norm(response.stress));
+  }
+}
+
+TEST(RVEHomogenization, NonlinearHomogeneous)
+{
+  auto mesh = periodicLaminate();
+
+  RVEHomogenization<1, dim> rve(*mesh, solid_mechanics::default_nonlinear_options,
+                                solid_mechanics::default_linear_options);
+
+  // the same material in both layers, so the fluctuation vanishes and the RVE responds like its material
+  solid_mechanics::NeoHookean material{.density = 1.0, .K = 10.0, .G = 2.0};
+  rve.setMaterial(material);
+
+  tensor<double, dim, dim> H_a = {{{0.1, 0.02, 0.0}, {0.0, -0.05, 0.0}, {0.01, 0.0, 0.03}}};
+  tensor<double, dim, dim> H_b = {{{0.15, 0.02, 0.0}, {0.0, -0.08, 0.01}, {0.01, 0.0, 0.05}}};
+  auto                     responses = rve.solve({H_a, H_b});
+
+  auto piola_stress = [&material](auto H) {
+    Empty state{};
+    auto  F = DenseIdentity<dim>() + H;
+    return dot(material(state, H), transpose(inv(F))) * det(F);
+  };
+
+  for (auto [H, response] : {std::pair{H_a, responses[0]}, std::pair{H_b, responses[1]}}) {
+    EXPECT_TRUE(response.converged);
+
+    auto P = piola_stress(H);
+    EXPECT_LT(norm(response.stress - P), 1.0e-8 * norm(P));
+
+    auto dP_dH = get_gradient(piola_stress(make_dual(H)));
+    EXPECT_LT(norm(response.tangent - dP_dH), 1.0e-6 * norm(dP_dH));
+  }
+}
+
+}  // namespace serac
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  MPI_Init(&argc, &argv);
+
+  axom::slic::SimpleLogger logger;
+
+  int result = RUN_ALL_TESTS();
+  MPI_Finalize();
+
+  return result;
+}
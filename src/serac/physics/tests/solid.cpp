@@ -98,6 +98,14 @@ void functional_solid_test_static_J2()
   // that plasticity models can have permanent
   // deformation after unloading
   // EXPECT_LT(norm(solid_solver.reactions()), 1.0e-5);
+
+  // the quadrature data is updated tentatively during each solve, check that the converged updates were committed
+  double max_plastic_strain = 0.0;
+  for (size_t i = 0; i < state->size; i++) {
+    max_plastic_strain = std::max(max_plastic_strain, state->data[i].accumulated_plastic_strain);
+  }
+  MPI_Allreduce(MPI_IN_PLACE, &max_plastic_strain, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+  EXPECT_GT(max_plastic_strain, 0.0);
 }
 
 enum class TestType
@@ -329,6 +337,218 @@ TEST(SolidMechanics, 2DLinearPressure)
   functional_solid_test_boundary<1, 2>(0.028525698834671667, TestType::Pressure);
 }
 
+TEST(SolidMechanics, 3DExplicitConstantBodyForce)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  constexpr int p   = 1;
+  constexpr int dim = 3;
+
+  axom::sidre::DataStore datastore;
+  serac::StateManager::initialize(datastore, "solid_mechanics_explicit_test");
+
+  std::string filename = SERAC_REPO_DIR "/data/meshes/beam-hex.mesh";
+  auto        mesh     = mesh::refineAndDistribute(buildMeshFromFile(filename), 0, 0);
+  serac::StateManager::setMesh(std::move(mesh));
+
+  SolidMechanics<p, dim> solid_solver(solid_mechanics::default_nonlinear_options,
+                                      solid_mechanics::default_linear_options,
+                                      {.timestepper = TimestepMethod::ExplicitCentralDifference},
+                                      GeometricNonlinearities::On, "solid_mechanics");
+
+  constexpr double density = 2.0;
+  solid_solver.setMaterial(solid_mechanics::LinearIsotropic{density, 1.0, 1.0});
+
+  // an unconstrained body under a uniform load accelerates rigidly, so the lumped mass gives the exact acceleration
+  solid_mechanics::ConstantBodyForce<dim> force{{1.0, 0.0, 0.0}};
+  solid_solver.addBodyForce(force);
+
+  solid_solver.completeSetup();
+
+  double dt = solid_solver.stableTimestep();
+  EXPECT_GT(dt, 0.0);
+
+  constexpr int num_steps = 10;
+  for (int i = 0; i < num_steps; i++) {
+    solid_solver.advanceTimestep(dt);
+  }
+
+  // central differences integrate a constant acceleration exactly
+  double t = num_steps * dt;
+  double a = force.force_[0] / density;
+
+  mfem::Vector expected_displacement(solid_solver.displacement().Size());
+  mfem::Vector expected_velocity(solid_solver.velocity().Size());
+  for (int i = 0; i < expected_displacement.Size(); i++) {
+    int  component           = i / (expected_displacement.Size() / dim);
+    bool loaded              = (component == 0);
+    expected_displacement[i] = loaded ? 0.5 * a * t * t : 0.0;
+    expected_velocity[i]     = loaded ? a * t : 0.0;
+  }
+
+  EXPECT_LT(solid_solver.displacement().DistanceTo(expected_displacement.GetData()),
+            1.0e-10 * expected_displacement.Norml2());
+  EXPECT_LT(solid_solver.velocity().DistanceTo(expected_velocity.GetData()), 1.0e-10 * expected_velocity.Norml2());
+}
+
+TEST(SolidMechanics, 3DExplicitStableTimestepAndMassScaling)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  constexpr int p   = 1;
+  constexpr int dim = 3;
+
+  axom::sidre::DataStore datastore;
+  serac::StateManager::initialize(datastore, "solid_mechanics_mass_scaling_test");
+
+  // a mesh of unit cubes
+  std::string filename = SERAC_REPO_DIR "/data/meshes/beam-hex.mesh";
+  auto        mesh     = mesh::refineAndDistribute(buildMeshFromFile(filename), 0, 0);
+  serac::StateManager::setMesh(std::move(mesh));
+
+  SolidMechanics<p, dim> solid_solver(solid_mechanics::default_nonlinear_options,
+                                      solid_mechanics::default_linear_options,
+                                      {.timestepper = TimestepMethod::ExplicitCentralDifference},
+                                      GeometricNonlinearities::On, "solid_mechanics");
+
+  solid_mechanics::LinearIsotropic mat{2.0, 1.0, 1.0};
+  solid_solver.setMaterial(mat);
+
+  solid_mechanics::ConstantBodyForce<dim> force{{1.0, 0.0, 0.0}};
+  solid_solver.addBodyForce(force);
+
+  solid_solver.completeSetup();
+
+  double wave_speed = solid_mechanics::waveSpeed(mat);
+
+  mfem::Vector dt_e = solid_solver.elementStableTimesteps();
+  for (int e = 0; e < dt_e.Size(); e++) {
+    EXPECT_NEAR(dt_e[e], 1.0 / wave_speed, 1.0e-12);
+  }
+  EXPECT_NEAR(solid_solver.stableTimestep(), 0.9 / wave_speed, 1.0e-12);
+
+  // stepping at twice the stable timestep scales the mass of every (identical) element by 4
+  double dt = 2.0 * solid_solver.stableTimestep();
+  solid_solver.setMassScalingTimestep(dt);
+
+  constexpr int num_steps = 4;
+  for (int i = 0; i < num_steps; i++) {
+    solid_solver.advanceTimestep(dt);
+  }
+
+  double t = num_steps * dt;
+  double a = force.force_[0] / (4.0 * mat.density);
+
+  auto& velocity = solid_solver.velocity();
+  for (int i = 0; i < velocity.Size() / dim; i++) {
+    EXPECT_NEAR(velocity[i], a * t, 1.0e-10);
+  }
+}
+
+TEST(SolidMechanics, 3DMaterialOutputOfUniformStrain)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  constexpr int p   = 1;
+  constexpr int dim = 3;
+
+  axom::sidre::DataStore datastore;
+  serac::StateManager::initialize(datastore, "solid_mechanics_material_output_test");
+
+  std::string filename = SERAC_REPO_DIR "/data/meshes/beam-hex.mesh";
+  auto        mesh     = mesh::refineAndDistribute(buildMeshFromFile(filename), 0, 0);
+  serac::StateManager::setMesh(std::move(mesh));
+
+  SolidMechanics<p, dim> solid_solver(solid_mechanics::default_nonlinear_options,
+                                      solid_mechanics::default_linear_options,
+                                      solid_mechanics::default_quasistatic_options, GeometricNonlinearities::Off,
+                                      "solid_mechanics");
+
+  solid_mechanics::LinearIsotropic mat{.density = 1.0, .K = 2.0, .G = 1.0};
+  solid_solver.setMaterial(mat);
+  solid_solver.addMaterialOutput("stress", mat, [](auto stress, auto, auto) { return stress; });
+  solid_solver.addMaterialOutput<0>("pressure", mat, [](auto stress, auto, auto) { return -tr(stress) / 3.0; });
+
+  // a uniform strain, whose stress is the same everywhere, so its L2 projection is exact
+  tensor<double, dim, dim> du_dX{{{0.01, 0.002, 0.0}, {0.0, -0.003, 0.001}, {0.004, 0.0, 0.005}}};
+  solid_solver.setDisplacement([&](const mfem::Vector& X, mfem::Vector& u) {
+    for (int i = 0; i < dim; i++) {
+      u[i] = 0.0;
+      for (int j = 0; j < dim; j++) {
+        u[i] += du_dX[i][j] * X[j];
+      }
+    }
+  });
+
+  solid_mechanics::LinearIsotropic::State state{};
+  auto                                    expected = mat(state, du_dX);
+
+  const FiniteElementState& stress = solid_solver.derivedField("solid_mechanics_stress");
+  EXPECT_EQ(stress.space().GetVDim(), dim * dim);
+  int nodes = stress.space().GetNDofs();
+  for (int i = 0; i < dim; i++) {
+    for (int j = 0; j < dim; j++) {
+      for (int n = 0; n < nodes; n++) {
+        EXPECT_NEAR(stress[(i * dim + j) * nodes + n], expected[i][j], 1.0e-12);
+      }
+    }
+  }
+
+  const FiniteElementState& pressure = solid_solver.derivedField("solid_mechanics_pressure");
+  for (int n = 0; n < pressure.Size(); n++) {
+    EXPECT_NEAR(pressure[n], -tr(expected) / 3.0, 1.0e-12);
+  }
+}
+
+TEST(SolidMechanics, 3DResultantBalancesBodyForce)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  constexpr int p   = 1;
+  constexpr int dim = 3;
+
+  axom::sidre::DataStore datastore;
+  serac::StateManager::initialize(datastore, "solid_mechanics_resultant_test");
+
+  // a beam of 8 unit cubes, supported on its first end (attribute 1)
+  std::string filename = SERAC_REPO_DIR "/data/meshes/beam-hex.mesh";
+  auto        mesh     = mesh::refineAndDistribute(buildMeshFromFile(filename), 0, 0);
+  serac::StateManager::setMesh(std::move(mesh));
+
+  SolidMechanics<p, dim> solid_solver(solid_mechanics::default_nonlinear_options,
+                                      solid_mechanics::default_linear_options,
+                                      solid_mechanics::default_quasistatic_options, GeometricNonlinearities::Off,
+                                      "solid_mechanics");
+
+  solid_solver.setMaterial(solid_mechanics::LinearIsotropic{.density = 1.0, .K = 1.0, .G = 1.0});
+  solid_solver.setDisplacementBCs({1}, [](const mfem::Vector&, mfem::Vector& u) { u = 0.0; });
+
+  solid_mechanics::ConstantBodyForce<dim> force{{0.0, 0.0, -1.0e-3}};
+  solid_solver.addBodyForce(force);
+
+  solid_solver.addResultant("support", {1});
+  solid_solver.addResultant("free_end", {2});
+  solid_solver.addResultant("every_other_cycle", {1}, 2);
+  solid_solver.completeSetup();
+
+  double dt = 1.0;
+  solid_solver.advanceTimestep(dt);
+
+  // the support carries the whole weight of the beam, and the free end none of it
+  constexpr double volume   = 8.0;
+  auto             support  = solid_solver.resultant("support");
+  auto             free_end = solid_solver.resultant("free_end");
+  for (int c = 0; c < dim; c++) {
+    EXPECT_NEAR(support[c], -volume * force.force_[c], 1.0e-6);
+    EXPECT_NEAR(free_end[c], 0.0, 1.0e-6);
+  }
+
+  // a resultant is only measured on its cycles
+  EXPECT_EQ(norm(solid_solver.resultant("every_other_cycle")), 0.0);
+  solid_solver.advanceTimestep(dt);
+  EXPECT_NEAR(solid_solver.resultant("every_other_cycle")[2], -volume * force.force_[2], 1.0e-6);
+}
+
 }  // namespace serac
 
 int main(int argc, char* argv[])
@@ -80,6 +80,7 @@ std::set<int> essentialBoundaryAttributes(PatchBoundaryCondition bc)
  *
  * @param exact_solution Exact solution of problem
  * @param bc Specifier for boundary condition type to test
+ * @param timestepper The time integration method
  * @return double L2 norm (continuous) of error in computed solution
  * *
  * @pre ExactSolution must implement operator() that is an MFEM
@@ -89,7 +90,8 @@ std::set<int> essentialBoundaryAttributes(PatchBoundaryCondition bc)
  * thermal functional that should lead to the exact solution
  */
 template <int p, int dim, typename ExactSolution>
-double dynamic_solution_error(const ExactSolution& exact_solution, PatchBoundaryCondition bc)
+double dynamic_solution_error(const ExactSolution& exact_solution, PatchBoundaryCondition bc,
+                              TimestepMethod timestepper = TimestepMethod::BackwardEuler)
 {
   MPI_Barrier(MPI_COMM_WORLD);
 
@@ -106,7 +108,7 @@ double dynamic_solution_error(const ExactSolution& exact_solution, PatchBoundary
   // Construct a heat transfer solver
   NonlinearSolverOptions nonlinear_opts{.relative_tol = 5.0e-13, .absolute_tol = 5.0e-13};
 
-  TimesteppingOptions dyn_opts{.timestepper        = TimestepMethod::BackwardEuler,
+  TimesteppingOptions dyn_opts{.timestepper        = timestepper,
                                .enforcement_method = DirichletEnforcementMethod::DirectControl};
 
   HeatTransfer<p, dim> thermal(nonlinear_opts, heat_transfer::direct_linear_options, dyn_opts, "thermal");
@@ -287,6 +289,124 @@ TEST(HeatTransferDynamic, PatchTest3dQ2FluxBcs)
   EXPECT_LT(error, tol);
 }
 
+TEST(HeatTransferDynamic, PatchTest2dQ1EssentialBcsIMEXEuler)
+{
+  constexpr int p     = 1;
+  constexpr int dim   = 2;
+  double        error = dynamic_solution_error<p, dim>(LinearSolution<dim>(), PatchBoundaryCondition::Essential,
+                                                TimestepMethod::IMEXEuler);
+  EXPECT_LT(error, tol);
+}
+
+TEST(HeatTransferDynamic, PatchTest3dQ2EssentialBcsIMEXARS222)
+{
+  constexpr int p     = 2;
+  constexpr int dim   = 3;
+  double        error = dynamic_solution_error<p, dim>(LinearSolution<dim>(), PatchBoundaryCondition::Essential,
+                                                TimestepMethod::IMEXARS222);
+  EXPECT_LT(error, tol);
+}
+
+/**
+ * @brief Heat a patch uniformly, T(x, t) = b + rate * t, with explicit steps and a lumped heat capacity
+ *
+ * The lumped heat capacity has the same row sums as the consistent one, so a spatially uniform temperature rate
+ * is integrated exactly.
+ *
+ * @return double L2 norm (continuous) of error in computed solution
+ */
+template <int p, int dim>
+double explicit_uniform_heating_error(TimestepMethod timestepper)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  axom::sidre::DataStore datastore;
+  serac::StateManager::initialize(datastore, "thermal_explicit_heating");
+
+  std::string filename = std::string(SERAC_REPO_DIR) + "/data/meshes/patch" + std::to_string(dim) + "D.mesh";
+  auto        mesh     = mesh::refineAndDistribute(buildMeshFromFile(filename));
+  serac::StateManager::setMesh(std::move(mesh));
+
+  TimesteppingOptions dyn_opts{.timestepper = timestepper, .lumped_mass = true};
+
+  HeatTransfer<p, dim> thermal(heat_transfer::default_nonlinear_options, heat_transfer::direct_linear_options,
+                               dyn_opts, "thermal");
+
+  heat_transfer::LinearIsotropicConductor mat(1.0, 1.0, 1.0);
+  thermal.setMaterial(mat);
+
+  constexpr double rate     = 2.0;
+  auto             exact    = [](const mfem::Vector&, double t) { return b + rate * t; };
+  auto             boundary = essentialBoundaryAttributes<dim>(PatchBoundaryCondition::Essential);
+
+  thermal.setTemperature(exact);
+  thermal.setTemperatureBCs(boundary, exact);
+  thermal.setSource([](auto /* X */, auto /* time */, auto /* u */, auto /* du_dx */) { return rate; });
+
+  thermal.completeSetup();
+
+  double dt = thermal.stableTimestep();
+  EXPECT_GT(dt, 0.0);
+  for (int i = 0; i < 10; i++) {
+    thermal.advanceTimestep(dt);
+  }
+
+  mfem::FunctionCoefficient exact_solution_coef(exact);
+  exact_solution_coef.SetTime(thermal.time());
+  return computeL2Error(thermal.temperature(), exact_solution_coef);
+}
+
+TEST(HeatTransferDynamic, ExplicitUniformHeating2dQ1ForwardEuler)
+{
+  EXPECT_LT((explicit_uniform_heating_error<1, 2>(TimestepMethod::ForwardEuler)), tol);
+}
+
+TEST(HeatTransferDynamic, ExplicitUniformHeating3dQ1RK2)
+{
+  EXPECT_LT((explicit_uniform_heating_error<1, 3>(TimestepMethod::RK2)), tol);
+}
+
+TEST(HeatTransferDynamic, ExplicitUniformHeating2dQ2RK4)
+{
+  EXPECT_LT((explicit_uniform_heating_error<2, 2>(TimestepMethod::RK4)), tol);
+}
+
+TEST(HeatTransferDynamic, ExplicitStableTimestepDecays)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  constexpr int p   = 1;
+  constexpr int dim = 2;
+
+  axom::sidre::DataStore datastore;
+  serac::StateManager::initialize(datastore, "thermal_explicit_decay");
+
+  auto mesh = mesh::refineAndDistribute(buildRectangleMesh(16, 16));
+  serac::StateManager::setMesh(std::move(mesh));
+
+  TimesteppingOptions dyn_opts{.timestepper = TimestepMethod::ForwardEuler, .lumped_mass = true};
+
+  HeatTransfer<p, dim> thermal(heat_transfer::default_nonlinear_options, heat_transfer::direct_linear_options,
+                               dyn_opts, "thermal");
+
+  heat_transfer::LinearIsotropicConductor mat(1.0, 1.0, 1.0);
+  thermal.setMaterial(mat);
+
+  // a rough initial temperature excites the fastest modes, which grow at any timestep past the stable one
+  thermal.setTemperature([](const mfem::Vector& x, double) { return std::sin(40.0 * x[0]) * std::cos(37.0 * x[1]); });
+  thermal.setTemperatureBCs({1, 2, 3, 4}, [](const mfem::Vector&, double) { return 0.0; });
+  thermal.completeSetup();
+
+  double initial_norm = mfem::ParNormlp(thermal.temperature(), mfem::infinity(), MPI_COMM_WORLD);
+
+  double dt = thermal.stableTimestep();
+  for (int i = 0; i < 100; i++) {
+    thermal.advanceTimestep(dt);
+  }
+
+  EXPECT_LT(mfem::ParNormlp(thermal.temperature(), mfem::infinity(), MPI_COMM_WORLD), initial_norm);
+}
+
 }  // namespace serac
 
 int main(int argc, char* argv[])
@@ -106,6 +106,16 @@ TEST(Thermal, FiniteDifference)
   // Compute the sensitivity (d QOI/ d state * d state/d parameter) given the current adjoint solution
   [[maybe_unused]] auto& sensitivity = thermal_solver.computeSensitivity(conductivity_parameter_index);
 
+  // Computing the sensitivities w.r.t. every field at once must give the same results as computing them one by one
+  auto&        shape_sensitivity = thermal_solver.computeShapeSensitivity();
+  mfem::Vector sensitivity_difference(sensitivity);
+  mfem::Vector shape_sensitivity_difference(shape_sensitivity);
+  thermal_solver.computeAllSensitivities();
+  sensitivity_difference -= sensitivity;
+  shape_sensitivity_difference -= shape_sensitivity;
+  EXPECT_NEAR(sensitivity_difference.Normlinf(), 0.0, 1.0e-12 * sensitivity.Normlinf());
+  EXPECT_NEAR(shape_sensitivity_difference.Normlinf(), 0.0, 1.0e-12 * shape_sensitivity.Normlinf());
+
   // Perform finite difference on each conduction value
   // to check if computed qoi sensitivity is consistent
   // with finite difference on the temperature
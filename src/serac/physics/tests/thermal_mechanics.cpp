@@ -9,7 +9,9 @@
 #include "serac/physics/materials/solid_material.hpp"
 #include "serac/physics/materials/green_saint_venant_thermoelastic.hpp"
 
+#include <filesystem>
 #include <fstream>
+#include <sstream>
 
 #include <gtest/gtest.h>
 #include "mfem.hpp"
@@ -100,8 +102,18 @@ void functional_test_static_3D(double expected_norm)
   EXPECT_NEAR(temperature_norm_exact, norm(thermal_solid_solver.temperature()), 1.0e-6);
 }
 
+/// How the thermal and mechanical equations of the timesteps of a test are coupled
+enum class Coupling
+{
+  OperatorSplit,
+  Monolithic,
+  Lagged,
+  Iterated,
+  ThermalSubmesh
+};
+
 template <int p>
-void functional_test_shrinking_3D(double expected_norm)
+void functional_test_shrinking_3D(double expected_norm, Coupling coupling = Coupling::OperatorSplit)
 {
   MPI_Barrier(MPI_COMM_WORLD);
 
@@ -135,10 +147,17 @@ void functional_test_shrinking_3D(double expected_norm)
   const NonlinearSolverOptions default_nonlinear_options = {
       .relative_tol = 1.0e-4, .absolute_tol = 1.0e-8, .max_iterations = 10, .print_level = 1};
 
+  // the heat transfer on half of the beam only, with the temperature it would have on the other half outside of it
+  mfem::ParMesh* thermal_mesh = nullptr;
+  if (coupling == Coupling::ThermalSubmesh) {
+    thermal_mesh = serac::StateManager::setMesh(mesh::buildSubmesh(serac::StateManager::mesh(), {1}), "thermal_region");
+  }
+
   Thermomechanics<p, dim> thermal_solid_solver(
       heat_transfer::default_nonlinear_options, heat_transfer::default_linear_options,
       heat_transfer::default_static_options, default_nonlinear_options, default_linear_options,
-      solid_mechanics::default_quasistatic_options, GeometricNonlinearities::On, "thermal_solid_functional");
+      solid_mechanics::default_quasistatic_options, GeometricNonlinearities::On, "thermal_solid_functional", nullptr,
+      thermal_mesh);
 
   double                                       rho       = 1.0;
   double                                       E         = 1.0;
@@ -170,6 +189,26 @@ void functional_test_shrinking_3D(double expected_norm)
   thermal_solid_solver.setDisplacementBCs(constraint_bdr, zeroVector);
   thermal_solid_solver.setDisplacement(zeroVector);
 
+  if (coupling == Coupling::Monolithic) {
+    thermal_solid_solver.setMonolithicSolve({.nonlinear_options    = default_nonlinear_options,
+                                             .linear_options       = default_linear_options,
+                                             .block_preconditioner = BlockPreconditioner::BlockTriangular});
+  }
+
+  // the temperature is the same at the start and the end of the step, so lagging it doesn't change the solution
+  if (coupling == Coupling::Lagged) {
+    thermal_solid_solver.setOperatorSplitCoupling(OperatorSplitCoupling::Lagged);
+  }
+
+  if (coupling == Coupling::ThermalSubmesh) {
+    thermal_solid_solver.setOutsideTemperature(theta_0);
+  }
+
+  if (coupling == Coupling::Iterated) {
+    thermal_solid_solver.setCouplingIterations(
+        {.acceleration = {.method = FixedPointAcceleration::Anderson, .relaxation = 1.0}, .relative_tol = 1.0e-8});
+  }
+
   // Finalize the data structures
   thermal_solid_solver.completeSetup();
 
@@ -179,6 +218,10 @@ void functional_test_shrinking_3D(double expected_norm)
 
   // Check the final displacement norm
   EXPECT_NEAR(expected_norm, norm(thermal_solid_solver.displacement()), 1.0e-4);
+
+  if (coupling == Coupling::Monolithic || coupling == Coupling::Iterated) {
+    EXPECT_NEAR(1.0, thermal_solid_solver.temperature().Max(), 1.0e-6);
+  }
 }
 
 // TODO: investigate this failing test
@@ -314,6 +357,62 @@ void parameterized()
   // EXPECT_LT(error_norm, 1e-10);
 }
 
+TEST(Thermomechanics, sharedVisualization)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  constexpr int p   = 1;
+  constexpr int dim = 3;
+
+  axom::sidre::DataStore datastore;
+  serac::StateManager::initialize(datastore, "thermal_mechanics_shared_visualization");
+
+  std::string filename = SERAC_REPO_DIR "/data/meshes/beam-hex.mesh";
+  serac::StateManager::setMesh(mesh::refineAndDistribute(buildMeshFromFile(filename), 0, 0));
+
+  const std::string directory = "shared_visualization_output";
+  int               rank      = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  if (rank == 0) {
+    std::filesystem::remove_all(directory);
+  }
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  {
+    HeatTransfer<p, dim>   thermal(heat_transfer::default_nonlinear_options, heat_transfer::default_linear_options,
+                                   heat_transfer::default_static_options, "shared_thermal");
+    SolidMechanics<p, dim> solid(solid_mechanics::default_nonlinear_options, solid_mechanics::default_linear_options,
+                                 solid_mechanics::default_quasistatic_options, GeometricNonlinearities::On,
+                                 "shared_solid");
+    solid.shareVisualization(thermal);
+
+    thermal.setTemperature([](const mfem::Vector& x, double) { return x[0]; });
+    solid.setDisplacement([](const mfem::Vector& x, mfem::Vector& u) { u = x[1]; });
+
+    // the thermal module's fields are only written by the solid module's output
+    thermal.outputState(directory, true);
+    solid.outputState(directory, true);
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    EXPECT_FALSE(std::filesystem::exists(directory + "/shared_thermal"));
+    ASSERT_TRUE(std::filesystem::exists(directory + "/shared_solid"));
+
+    int pvtu_files = 0;
+    for (auto& entry : std::filesystem::recursive_directory_iterator(directory + "/shared_solid")) {
+      if (entry.path().extension() != ".pvtu") continue;
+      pvtu_files++;
+      std::ifstream     file(entry.path());
+      std::stringstream contents;
+      contents << file.rdbuf();
+      EXPECT_NE(contents.str().find(thermal.temperature().name()), std::string::npos);
+      EXPECT_NE(contents.str().find(solid.displacement().name()), std::string::npos);
+    }
+    EXPECT_EQ(pvtu_files, 1);
+  }
+
+  serac::StateManager::reset();
+}
+
 }  // namespace serac
 
 TEST(Thermomechanics, staticTest)
@@ -333,6 +432,43 @@ TEST(Thermomechanics, thermalContraction)
   serac::functional_test_shrinking_3D<p>(std::sqrt(L * L * L / 3.0) * alpha * delta_theta);
 }
 
+TEST(Thermomechanics, thermalContractionMonolithic)
+{
+  constexpr int p           = 2;
+  double        alpha       = 1e-3;
+  double        L           = 8;
+  double        delta_theta = 1.0;
+  serac::functional_test_shrinking_3D<p>(std::sqrt(L * L * L / 3.0) * alpha * delta_theta, serac::Coupling::Monolithic);
+}
+
+TEST(Thermomechanics, thermalContractionLagged)
+{
+  constexpr int p           = 2;
+  double        alpha       = 1e-3;
+  double        L           = 8;
+  double        delta_theta = 1.0;
+  serac::functional_test_shrinking_3D<p>(std::sqrt(L * L * L / 3.0) * alpha * delta_theta, serac::Coupling::Lagged);
+}
+
+TEST(Thermomechanics, thermalContractionCouplingIterations)
+{
+  constexpr int p           = 2;
+  double        alpha       = 1e-3;
+  double        L           = 8;
+  double        delta_theta = 1.0;
+  serac::functional_test_shrinking_3D<p>(std::sqrt(L * L * L / 3.0) * alpha * delta_theta, serac::Coupling::Iterated);
+}
+
+TEST(Thermomechanics, thermalContractionThermalSubmesh)
+{
+  constexpr int p           = 2;
+  double        alpha       = 1e-3;
+  double        L           = 8;
+  double        delta_theta = 1.0;
+  serac::functional_test_shrinking_3D<p>(std::sqrt(L * L * L / 3.0) * alpha * delta_theta,
+                                         serac::Coupling::ThermalSubmesh);
+}
+
 TEST(Thermomechanics, parameterized)
 {
   // this is the small strain solution, which works with a loose enought tolerance
@@ -0,0 +1,18 @@
+// Copyright (c) 2019-2023, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/physics/thermomechanics.hpp"
+
+namespace serac {
+
+template class Thermomechanics<1, 2>;
+template class Thermomechanics<2, 2>;
+template class Thermomechanics<3, 2>;
+template class Thermomechanics<1, 3>;
+template class Thermomechanics<2, 3>;
+template class Thermomechanics<3, 3>;
+
+}  // namespace serac
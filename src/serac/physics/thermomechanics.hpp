@@ -7,26 +7,85 @@
 /**
  * @file thermomechanics.hpp
  *
- * @brief An object containing an operator-split thermal structural solver
+ * @brief An object containing a coupled thermal structural solver, either operator-split or monolithic
  */
 
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+#include <optional>
+
 #include "mfem.hpp"
 
+#include "serac/numerics/equation_solver.hpp"
+#include "serac/numerics/fixed_point_acceleration.hpp"
+#include "serac/numerics/stdfunction_operator.hpp"
 #include "serac/physics/base_physics.hpp"
 #include "serac/physics/thermomechanics_input.hpp"
 #include "serac/physics/solid_mechanics.hpp"
 #include "serac/physics/heat_transfer.hpp"
 #include "serac/physics/materials/thermal_material.hpp"
 #include "serac/physics/materials/solid_material.hpp"
+#include "serac/physics/materials/green_saint_venant_thermoelastic.hpp"
+#include "serac/physics/state/submesh_transfer.hpp"
 
 namespace serac {
 
+/// The preconditioner for the block Jacobian of a monolithic thermomechanics solve
+enum class BlockPreconditioner
+{
+  BlockJacobi,    /**< Apply the thermal and mechanical preconditioners independently */
+  BlockTriangular /**< Precondition the temperature, then the displacement including the thermal coupling term */
+};
+
+/// How the thermal and mechanical steps of an operator-split timestep are coupled
+enum class OperatorSplitCoupling
+{
+  Sequential, /**< The solid step uses the temperature at the end of the thermal step */
+  Lagged      /**< The solid step uses the temperature at the start of the timestep, like the thermal step uses the
+                 displacement, so that neither step depends on the other */
+};
+
+/// Options for solving the thermal and mechanical equations of each timestep together, as one nonlinear system
+struct MonolithicSolverOptions {
+  /// The options for the nonlinear solver of the coupled system
+  NonlinearSolverOptions nonlinear_options = {};
+
+  /**
+   * The options for the linear solver of the block Jacobian. For iterative solvers, the preconditioner selection
+   * is ignored, since the block preconditioner reuses the preconditioners of the thermal and mechanical solvers.
+   */
+  LinearSolverOptions linear_options = {};
+
+  /// The block preconditioner for iterative linear solvers
+  BlockPreconditioner block_preconditioner = BlockPreconditioner::BlockTriangular;
+};
+
+/// Options for iterating the thermal and mechanical steps of each timestep until their coupling converges
+struct CouplingIterationOptions {
+  /// The relaxation or acceleration of the iterations, on the displacement exchanged between the steps
+  FixedPointAccelerationOptions acceleration = {};
+
+  /// The coupling residual (the change in the displacement over an iteration) tolerance, relative to the first one
+  double relative_tol = 1.0e-6;
+
+  /// The absolute coupling residual tolerance
+  double absolute_tol = 1.0e-12;
+
+  /// The maximum number of coupling iterations per timestep
+  int max_iterations = 20;
+
+  /// Print the coupling residual of each iteration if positive
+  int print_level = 0;
+};
+
 /**
- * @brief The operator-split thermal-structural solver
+ * @brief The thermal-structural solver
  *
- * Uses Functional to compute action of operators
+ * Uses Functional to compute action of operators. By default, each timestep is operator-split (thermal, then
+ * solid), see setMonolithicSolve() for solving both fields together, or setCouplingIterations() for iterating the
+ * split to convergence.
  */
 template <int order, int dim, typename... parameter_space>
 class Thermomechanics : public BasePhysics {
@@ -43,19 +102,21 @@ public:
    * @param geom_nonlin Flag to include geometric nonlinearities
    * @param name An optional name for the physics module instance
    * @param pmesh The mesh to conduct the simulation on, if different than the default mesh
+   * @param thermal_pmesh The mesh of the heat transfer, if it is confined to a submesh of @a pmesh (see
+   * mesh::buildSubmesh())
    */
   Thermomechanics(const NonlinearSolverOptions thermal_nonlin_opts, const LinearSolverOptions thermal_lin_opts,
                   TimesteppingOptions thermal_timestepping, const NonlinearSolverOptions solid_nonlin_opts,
                   const LinearSolverOptions solid_lin_opts, TimesteppingOptions solid_timestepping,
                   GeometricNonlinearities geom_nonlin = GeometricNonlinearities::On, const std::string& name = "",
-                  mfem::ParMesh* pmesh = nullptr)
+                  mfem::ParMesh* pmesh = nullptr, mfem::ParMesh* thermal_pmesh = nullptr)
       : Thermomechanics(
             std::make_unique<EquationSolver>(thermal_nonlin_opts, thermal_lin_opts,
                                              StateManager::mesh(StateManager::collectionID(pmesh)).GetComm()),
             thermal_timestepping,
             std::make_unique<EquationSolver>(solid_nonlin_opts, solid_lin_opts,
                                              StateManager::mesh(StateManager::collectionID(pmesh)).GetComm()),
-            solid_timestepping, geom_nonlin, name, pmesh)
+            solid_timestepping, geom_nonlin, name, pmesh, thermal_pmesh)
   {
   }
 
@@ -69,24 +130,56 @@ public:
    * @param geom_nonlin Flag to include geometric nonlinearities
    * @param name An optional name for the physics module instance
    * @param pmesh The mesh to conduct the simulation on, if different than the default mesh
+   * @param thermal_pmesh The mesh of the heat transfer, if it is confined to a submesh of @a pmesh
+   *
+   * With a thermal submesh (see mesh::buildSubmesh()), the heat transfer only costs what its region costs: the
+   * displacement is transferred to the submesh before each thermal step, and the temperature back to the mesh of
+   * the solid after it. Outside the region, the solid sees the temperature given to setOutsideTemperature().
    */
   Thermomechanics(std::unique_ptr<EquationSolver> thermal_solver, TimesteppingOptions thermal_timestepping,
                   std::unique_ptr<EquationSolver> solid_solver, TimesteppingOptions solid_timestepping,
                   GeometricNonlinearities geom_nonlin = GeometricNonlinearities::On, const std::string& name = "",
-                  mfem::ParMesh* pmesh = nullptr)
+                  mfem::ParMesh* pmesh = nullptr, mfem::ParMesh* thermal_pmesh = nullptr)
       : BasePhysics(3, order, name, pmesh),
-        thermal_(std::move(thermal_solver), thermal_timestepping, name + "thermal", pmesh),
+        thermal_solver_(thermal_solver.get()),
+        thermal_timestepper_(thermal_timestepping.timestepper),
+        solid_solver_(solid_solver.get()),
+        thermal_(std::move(thermal_solver), thermal_timestepping, name + "thermal",
+                 thermal_pmesh ? thermal_pmesh : pmesh),
         solid_(std::move(solid_solver), solid_timestepping, geom_nonlin, name + "mechanical", pmesh)
   {
     SLIC_ERROR_ROOT_IF(mesh_.Dimension() != dim,
                        axom::fmt::format("Compile time dimension and runtime mesh dimension mismatch"));
 
-    states_.push_back(&thermal_.temperature());
+    if (thermal_pmesh && thermal_pmesh != &mesh_) {
+      const auto* region = dynamic_cast<const mfem::ParSubMesh*>(thermal_pmesh);
+      SLIC_ERROR_ROOT_IF(!region || region->GetParent() != &mesh_,
+                         "The thermal mesh of thermomechanics must be a submesh of the mechanical one");
+
+      const std::string region_displacement_name = detail::addPrefix(name, "region_displacement");
+      region_displacement_                       = std::make_unique<FiniteElementState>(
+          *thermal_pmesh,
+          FiniteElementVector::Options{.order = order, .vector_dim = dim, .name = region_displacement_name});
+      solid_temperature_ = std::make_unique<FiniteElementState>(
+          mesh_, FiniteElementVector::Options{.order = order, .name = detail::addPrefix(name, "solid_temperature")});
+
+      displacement_to_region_  = std::make_unique<SubmeshTransfer>(solid_.displacement(), *region_displacement_);
+      temperature_from_region_ = std::make_unique<SubmeshTransfer>(thermal_.temperature(), *solid_temperature_);
+    }
+
+    states_.push_back(&solidTemperature());
     states_.push_back(&solid_.velocity());
     states_.push_back(&solid_.displacement());
 
-    thermal_.setParameter(0, solid_.displacement());
-    solid_.setParameter(0, thermal_.temperature());
+    thermal_.setParameter(0, region_displacement_ ? *region_displacement_ : solid_.displacement());
+    solid_.setParameter(0, solidTemperature());
+
+    // the fields of the thermal and solid modules are written along with these states, with a single copy of the
+    // mesh (a thermal submesh is a different mesh, so only the temperature transferred to the solid is written)
+    if (!region_displacement_) {
+      shareVisualization(thermal_);
+    }
+    shareVisualization(solid_);
   }
 
   /**
@@ -103,6 +196,8 @@ public:
                         solid_options.lin_solver_options, solid_options.timestepping_options, solid_options.geom_nonlin,
                         name)
   {
+    // without a thermal expansion, the temperature only couples to the solid through the material's heat source
+    setInputOptions(thermal_options, solid_options, 0.0, 0.0);
   }
 
   /**
@@ -112,14 +207,56 @@ public:
    * @param[in] name A name for the physics module
    */
   Thermomechanics(const ThermomechanicsInputOptions& options, const std::string& name = "")
-      : Thermomechanics(options.thermal_options, options.solid_options, name)
+      : Thermomechanics(options.thermal_options.nonlin_solver_options, options.thermal_options.lin_solver_options,
+                        options.thermal_options.timestepping_options, options.solid_options.nonlin_solver_options,
+                        options.solid_options.lin_solver_options, options.solid_options.timestepping_options,
+                        options.solid_options.geom_nonlin, name)
   {
+    double alpha     = 0.0;
+    double theta_ref = 0.0;
     if (options.coef_thermal_expansion) {
-      std::unique_ptr<mfem::Coefficient> cte(options.coef_thermal_expansion->constructScalar());
-      std::unique_ptr<mfem::Coefficient> ref_temp(options.reference_temperature->constructScalar());
+      // the thermoelastic material has a uniform expansion coefficient and reference temperature
+      SLIC_ERROR_ROOT_IF(!options.coef_thermal_expansion->scalar_constant ||
+                             !options.reference_temperature->scalar_constant,
+                         "The thermal expansion in input files must be given by constant coefficients");
+      alpha     = *options.coef_thermal_expansion->scalar_constant;
+      theta_ref = *options.reference_temperature->scalar_constant;
+    }
 
-      // setThermalExpansion(std::move(cte), std::move(ref_temp));
+    setInputOptions(options.thermal_options, options.solid_options, alpha, theta_ref);
+  }
+
+  /**
+   * @brief Set the thermoelastic material, and the initial and boundary conditions of both modules, of the input file
+   *
+   * The material is a GreenSaintVenantThermoelasticMaterial with the elastic moduli and density of the solid
+   * options, and the conductivity and (volumetric) heat capacity of the thermal ones.
+   *
+   * @param[in] thermal_options The thermal physics module input file option struct
+   * @param[in] solid_options The solid physics module input file option struct
+   * @param[in] alpha The coefficient of thermal expansion
+   * @param[in] theta_ref The reference temperature of the thermal expansion
+   */
+  void setInputOptions(const HeatTransferInputOptions& thermal_options, const SolidMechanicsInputOptions& solid_options,
+                       double alpha, double theta_ref)
+  {
+    if constexpr (dim == 3) {
+      const double K  = solid_options.K;
+      const double mu = solid_options.mu;
+      GreenSaintVenantThermoelasticMaterial material{.density   = solid_options.initial_mass_density,
+                                                     .E         = 9.0 * K * mu / (3.0 * K + mu),
+                                                     .nu        = (3.0 * K - 2.0 * mu) / (2.0 * (3.0 * K + mu)),
+                                                     .C_v       = thermal_options.rho * thermal_options.cp,
+                                                     .alpha     = alpha,
+                                                     .theta_ref = theta_ref,
+                                                     .k         = thermal_options.kappa};
+      setMaterial(material, createQuadratureDataBuffer(GreenSaintVenantThermoelasticMaterial::State{}));
+    } else {
+      SLIC_ERROR_ROOT("Thermomechanics in input files is only implemented in 3D");
     }
+
+    thermal_.setInputConditions(thermal_options);
+    solid_.setInputConditions(solid_options);
   }
 
   /**
@@ -131,6 +268,100 @@ public:
   {
     thermal_.completeSetup();
     solid_.completeSetup();
+
+    SLIC_ERROR_ROOT_IF((monolithic_options_ || coupling_iteration_options_) && lagged_temperature_,
+                       "Lagged coupling only applies to operator-split thermomechanics timesteps");
+    SLIC_ERROR_ROOT_IF(monolithic_options_ && coupling_iteration_options_,
+                       "Thermomechanics timesteps are either monolithic or coupling iterations, not both");
+    SLIC_ERROR_ROOT_IF((monolithic_options_ || coupling_iteration_options_) && temperature_from_region_,
+                       "Thermomechanics with a thermal submesh only supports operator-split timesteps");
+
+    transferToRegion();
+    transferFromRegion();
+
+    if (monolithic_options_) {
+      buildMonolithicSolver(*monolithic_options_);
+    }
+    if (coupling_iteration_options_) {
+      buildCouplingIterations(*coupling_iteration_options_);
+    }
+  }
+
+  /**
+   * @brief Solve the thermal and mechanical equations of each timestep together, with Newton's method on the
+   * coupled system, instead of one after the other
+   *
+   * @param options The options for the coupled nonlinear and linear solvers
+   * @pre This must be called before completeSetup()
+   * @pre The solid mechanics must be quasi-static, and the heat transfer either quasi-static or backward Euler
+   */
+  void setMonolithicSolve(const MonolithicSolverOptions& options)
+  {
+    SLIC_ERROR_ROOT_IF(
+        thermal_timestepper_ != TimestepMethod::QuasiStatic && thermal_timestepper_ != TimestepMethod::BackwardEuler,
+        "Monolithic thermomechanics solves require quasi-static or backward Euler heat transfer");
+    SLIC_ERROR_ROOT_IF(thermal_solver_->matrixFree() || solid_solver_->matrixFree() ||
+                           options.linear_options.matrix_free,
+                       "Monolithic thermomechanics solves require assembled Jacobians");
+
+    monolithic_options_ = options;
+  }
+
+  /**
+   * @brief Repeat the thermal and mechanical steps of each timestep until the displacement they exchange converges,
+   * instead of taking each of them once
+   *
+   * Each coupling iteration solves the thermal step with the current displacement iterate, and the solid step with
+   * the resulting temperature. The next displacement iterate is picked from these by (accelerated) relaxation, which
+   * converges for strongly coupled problems where plain repetition would stall or diverge, at the cost of the
+   * separate thermal and mechanical solves of the operator split.
+   *
+   * @param options The acceleration, tolerances and maximum number of coupling iterations
+   * @pre This must be called before completeSetup(), and not together with setMonolithicSolve() or lagged coupling
+   * @pre The solid mechanics must be quasi-static, and the heat transfer either quasi-static or backward Euler
+   */
+  void setCouplingIterations(const CouplingIterationOptions& options)
+  {
+    SLIC_ERROR_ROOT_IF(
+        thermal_timestepper_ != TimestepMethod::QuasiStatic && thermal_timestepper_ != TimestepMethod::BackwardEuler,
+        "Thermomechanics coupling iterations require quasi-static or backward Euler heat transfer");
+    SLIC_ERROR_ROOT_IF(thermal_solver_->matrixFree() || solid_solver_->matrixFree(),
+                       "Thermomechanics coupling iterations require assembled Jacobians");
+    SLIC_ERROR_ROOT_IF(options.max_iterations < 1, "Thermomechanics coupling iterations need a positive maximum");
+
+    coupling_iteration_options_ = options;
+  }
+
+  /**
+   * @brief Set how the thermal and mechanical steps of the operator-split timesteps are coupled
+   *
+   * Lagged coupling is first order in time, like the operator split itself, and suits one-way or weakly coupled
+   * problems: the thermal and mechanical steps of a timestep then only depend on the states at its start.
+   *
+   * @param coupling The coupling of the steps
+   * @pre This must be called before completeSetup(), and not together with setMonolithicSolve()
+   */
+  void setOperatorSplitCoupling(OperatorSplitCoupling coupling)
+  {
+    if (coupling == OperatorSplitCoupling::Lagged) {
+      lagged_temperature_ = std::make_unique<FiniteElementState>(solidTemperature());
+      solid_.setParameter(0, *lagged_temperature_);
+    } else {
+      lagged_temperature_.reset();
+      solid_.setParameter(0, solidTemperature());
+    }
+  }
+
+  /**
+   * @brief Set the temperature that the solid sees outside the region of a thermal submesh
+   *
+   * @param temperature The temperature outside the region, e.g. the reference temperature of the material
+   * @pre The heat transfer is on a submesh, and this must be called before completeSetup()
+   */
+  void setOutsideTemperature(double temperature)
+  {
+    SLIC_ERROR_ROOT_IF(!solid_temperature_, "Only thermomechanics with a thermal submesh has an outside temperature");
+    *solid_temperature_ = temperature;
   }
 
   /**
@@ -176,6 +407,46 @@ public:
     return std::vector<std::string>{{"displacement"}, {"velocity"}, {"temperature"}};
   }
 
+  /// @brief The telemetry of the solves of both physics modules (and of the monolithic solver, if any) together
+  SolveTelemetry solveTelemetry() const override
+  {
+    SolveTelemetry telemetry = thermal_.solveTelemetry();
+    telemetry += solid_.solveTelemetry();
+    if (coupled_solver_) {
+      telemetry += coupled_solver_->telemetry();
+    }
+    return telemetry;
+  }
+
+  /// @brief Start accumulating the telemetry of the next solves of both physics modules anew
+  void resetSolveTelemetry() const override
+  {
+    thermal_.resetSolveTelemetry();
+    solid_.resetSolveTelemetry();
+    if (coupled_solver_) {
+      coupled_solver_->resetTelemetry();
+    }
+  }
+
+  /// @brief Set the time of both physics modules
+  void setTime(const double time) override
+  {
+    BasePhysics::setTime(time);
+    thermal_.setTime(time);
+    solid_.setTime(time);
+  }
+
+  /// @brief The time of the physics modules, which advance it in their own timesteps
+  double time() const override { return thermal_.time(); }
+
+  /// @brief Set the cycle of both physics modules
+  void setCycle(const int cycle) override
+  {
+    BasePhysics::setCycle(cycle);
+    thermal_.setCycle(cycle);
+    solid_.setCycle(cycle);
+  }
+
   /**
    * @brief Advance the timestep
    *
@@ -185,11 +456,31 @@ public:
    */
   void advanceTimestep(double& dt) override
   {
-    double initial_dt = dt;
+    if (coupled_solver_) {
+      monolithicSolve(dt);
+      cycle_ += 1;
+      return;
+    }
+
+    if (coupling_accelerator_) {
+      couplingIterationSolve(dt);
+      cycle_ += 1;
+      return;
+    }
+
+    // with lagged coupling, the solid step sees the temperature of the start of the timestep
+    if (lagged_temperature_) {
+      *lagged_temperature_ = solidTemperature();
+    }
+
+    // an adaptive thermal step picks the timestep, and the solid follows it
+    transferToRegion();
     thermal_.advanceTimestep(dt);
+    transferFromRegion();
+    double thermal_dt = dt;
     solid_.advanceTimestep(dt);
-    SLIC_ERROR_ROOT_IF(std::abs(dt - initial_dt) > 1.0e-6,
-                       "Operator split coupled solvers cannot adaptively change the timestep");
+    SLIC_ERROR_ROOT_IF(std::abs(dt - thermal_dt) > 1.0e-6 * thermal_dt,
+                       "Operator split coupled solvers can only adapt the timestep in the thermal module");
 
     cycle_ += 1;
   }
@@ -199,12 +490,22 @@ public:
    *
    * @tparam T the type to be created at each quadrature point
    * @param initial_state the value to be broadcast to each quadrature point
+   * @param attributes if nonempty, the buffer only describes the elements with these attributes, for a material
+   * assigned to them (see setMaterial())
    * @return std::shared_ptr< QuadratureData<T> >
    */
   template <typename T>
-  std::shared_ptr<QuadratureData<T>> createQuadratureDataBuffer(T initial_state)
+  std::shared_ptr<QuadratureData<T>> createQuadratureDataBuffer(T initial_state, const std::set<int>& attributes = {})
   {
-    return solid_.createQuadratureDataBuffer(initial_state);
+    return solid_.createQuadratureDataBuffer(initial_state, attributes);
+  }
+
+  /// @overload
+  template <typename T>
+  std::shared_ptr<QuadratureData<SoA<T>>> createQuadratureDataBuffer(SoA<T> layout, T initial_state,
+                                                                     const std::set<int>& attributes = {})
+  {
+    return solid_.createQuadratureDataBuffer(layout, initial_state, attributes);
   }
 
   /**
@@ -321,13 +622,35 @@ public:
   template <int... active_parameters, typename MaterialType, typename StateType>
   void setMaterial(DependsOn<active_parameters...>, MaterialType material,
                    std::shared_ptr<QuadratureData<StateType>> qdata)
+  {
+    setMaterial(DependsOn<active_parameters...>{}, material, std::set<int>{}, qdata);
+  }
+
+  /**
+   * @brief Set the thermomechanical material response of the elements with the given attributes
+   *
+   * @param material A material that provides a function to evaluate stress, heat flux, density, and heat capacity,
+   * see setMaterial()
+   * @param attributes the attributes of the elements made of this material (or every element, if empty)
+   * @param qdata the buffer of material internal variables at each quadrature point of those elements
+   */
+  template <int... active_parameters, typename MaterialType, typename StateType>
+  void setMaterial(DependsOn<active_parameters...>, MaterialType material, const std::set<int>& attributes,
+                   std::shared_ptr<QuadratureData<StateType>> qdata)
   {
     // note: these parameter indices are offset by 1 since, internally, this module uses the first parameter
     // to communicate the temperature and displacement field information to the other physics module
     //
-    thermal_.setMaterial(DependsOn<0, active_parameters + 1 ...>{}, ThermalMaterialInterface<MaterialType>{material});
+    thermal_.setMaterial(DependsOn<0, active_parameters + 1 ...>{}, ThermalMaterialInterface<MaterialType>{material},
+                         attributes);
     solid_.setMaterial(DependsOn<0, active_parameters + 1 ...>{}, MechanicalMaterialInterface<MaterialType>{material},
-                       qdata);
+                       attributes, qdata);
+
+    if constexpr (!std::is_same_v<StateType, Nothing> && !std::is_same_v<StateType, Empty>) {
+      if (qdata) {
+        checkpointed_qdata_.push_back([qdata]() { return qdata->bytes(); });
+      }
+    }
   }
 
   /// @overload
@@ -337,6 +660,14 @@ public:
     setMaterial(DependsOn<>{}, material, qdata);
   }
 
+  /// @overload
+  template <typename MaterialType, typename StateType = Empty>
+  void setMaterial(MaterialType material, const std::set<int>& attributes,
+                   std::shared_ptr<QuadratureData<StateType>> qdata = EmptyQData)
+  {
+    setMaterial(DependsOn<>{}, material, attributes, qdata);
+  }
+
   /**
    * @brief Set essential temperature boundary conditions (strongly enforced)
    *
@@ -366,6 +697,8 @@ public:
    *
    * @tparam FluxType The type of the thermal flux object
    * @param flux_function A function describing the flux applied to a boundary
+   * @param boundary_attributes the attributes of the boundary elements the flux is applied to (or every boundary
+   * element, if empty)
    *
    * @pre FluxType must be a object that can be called with the following arguments:
    *    1. `tensor<T,dim> x` the spatial coordinates for the quadrature point
@@ -385,9 +718,9 @@ public:
    * shape sensitivities for boundary integrals.
    */
   template <typename FluxType>
-  void setHeatFluxBCs(FluxType flux_function)
+  void setHeatFluxBCs(FluxType flux_function, const std::set<int>& boundary_attributes = {})
   {
-    thermal_.setFluxBCs(flux_function);
+    thermal_.setFluxBCs(flux_function, boundary_attributes);
   }
 
   /**
@@ -474,11 +807,316 @@ protected:
   using displacement_field = H1<order, dim>;  ///< the function space for the displacement field
   using temperature_field  = H1<order>;       ///< the function space for the temperature field
 
+  /// @brief The temperature on the mesh of the solid, which is that of the heat transfer unless it is on a submesh
+  FiniteElementState& solidTemperature()
+  {
+    return solid_temperature_ ? *solid_temperature_ : thermal_.temperature();
+  }
+
+  /// @brief Transfer the displacement to the thermal submesh, if there is one
+  void transferToRegion()
+  {
+    if (displacement_to_region_) {
+      displacement_to_region_->transfer(solid_.displacement(), *region_displacement_);
+    }
+  }
+
+  /// @brief Transfer the temperature from the thermal submesh, if there is one, to the mesh of the solid
+  void transferFromRegion()
+  {
+    if (temperature_from_region_) {
+      temperature_from_region_->transfer(thermal_.temperature(), *solid_temperature_);
+    }
+  }
+
+  /// @brief Build the block residual operator, the block preconditioner and the coupled equation solver
+  void buildMonolithicSolver(const MonolithicSolverOptions& options)
+  {
+    MPI_Comm comm = mesh_.GetComm();
+
+    block_offsets_.SetSize(3);
+    block_offsets_[0] = 0;
+    block_offsets_[1] = thermal_.temperature().space().TrueVSize();
+    block_offsets_[2] = block_offsets_[1] + solid_.displacement().space().TrueVSize();
+
+    coupled_residual_ = std::make_unique<mfem_ext::StdFunctionOperator>(
+        block_offsets_.Last(),
+
+        [this](const mfem::Vector& x, mfem::Vector& r) {
+          setCoupledStates(x);
+          mfem::BlockVector r_blocks(r.GetData(), block_offsets_);
+          r_blocks.GetBlock(0) = thermal_.coupledResidual();
+          r_blocks.GetBlock(1) = solid_.coupledResidual();
+        },
+
+        [this](const mfem::Vector& x) -> mfem::Operator& {
+          setCoupledStates(x);
+
+          // the diagonal blocks are owned by the physics modules, the off-diagonal (coupling) blocks by this one
+          mfem::HypreParMatrix& J_thermal = thermal_.coupledJacobian();
+          mfem::HypreParMatrix& J_solid   = solid_.coupledJacobian();
+          J_thermal_displacement_         = thermal_.template coupledParameterJacobian<0>();
+          J_solid_temperature_            = solid_.template coupledParameterJacobian<0>();
+
+          J_ = std::make_unique<mfem::BlockOperator>(block_offsets_);
+          J_->SetBlock(0, 0, &J_thermal);
+          J_->SetBlock(0, 1, J_thermal_displacement_.get());
+          J_->SetBlock(1, 0, J_solid_temperature_.get());
+          J_->SetBlock(1, 1, &J_solid);
+
+          if (block_preconditioner_) {
+            if (auto* thermal_prec = thermal_solver_->preconditioner()) {
+              thermal_prec->SetOperator(J_thermal);
+            }
+            if (auto* solid_prec = solid_solver_->preconditioner()) {
+              solid_prec->SetOperator(J_solid);
+            }
+            auto* triangular = dynamic_cast<mfem::BlockLowerTriangularPreconditioner*>(block_preconditioner_.get());
+            if (triangular) {
+              triangular->SetBlock(1, 0, J_solid_temperature_.get());
+            }
+          }
+
+          return *J_;
+        });
+
+    LinearSolverOptions linear_options = options.linear_options;
+    linear_options.preconditioner      = Preconditioner::None;
+
+    auto [linear_solver, preconditioner] = buildLinearSolverAndPreconditioner(linear_options, comm);
+
+    // iterative solvers are preconditioned with the per-field preconditioners (e.g. AMG) on the diagonal blocks,
+    // while direct solvers factor the monolithic matrix
+    if (auto* iterative_solver = dynamic_cast<mfem::IterativeSolver*>(linear_solver.get())) {
+      if (options.block_preconditioner == BlockPreconditioner::BlockJacobi) {
+        auto block_jacobi = std::make_unique<mfem::BlockDiagonalPreconditioner>(block_offsets_);
+        block_jacobi->SetDiagonalBlock(0, thermal_solver_->preconditioner());
+        block_jacobi->SetDiagonalBlock(1, solid_solver_->preconditioner());
+        block_preconditioner_ = std::move(block_jacobi);
+      } else {
+        auto triangular = std::make_unique<mfem::BlockLowerTriangularPreconditioner>(block_offsets_);
+        triangular->SetDiagonalBlock(0, thermal_solver_->preconditioner());
+        triangular->SetDiagonalBlock(1, solid_solver_->preconditioner());
+        block_preconditioner_ = std::move(triangular);
+      }
+      iterative_solver->SetPreconditioner(*block_preconditioner_);
+    }
+
+    coupled_solver_ = std::make_unique<EquationSolver>(buildNonlinearSolver(options.nonlinear_options, comm),
+                                                       std::move(linear_solver));
+    coupled_solver_->setOperator(*coupled_residual_);
+  }
+
+  /**
+   * @brief Copy the temperature and displacement blocks of a coupled solution vector into the physics modules
+   *
+   * @param x The coupled solution vector
+   */
+  void setCoupledStates(const mfem::Vector& x)
+  {
+    const mfem::Vector temperature(const_cast<double*>(x.GetData()) + block_offsets_[0],
+                                   block_offsets_[1] - block_offsets_[0]);
+    const mfem::Vector displacement(const_cast<double*>(x.GetData()) + block_offsets_[1],
+                                    block_offsets_[2] - block_offsets_[1]);
+
+    thermal_.temperature().Vector::operator=(temperature);
+    solid_.displacement().Vector::operator=(displacement);
+  }
+
+  /**
+   * @brief Advance both physics modules by one timestep, solving the coupled system with Newton's method
+   *
+   * @param dt The timestep
+   */
+  void monolithicSolve(double dt)
+  {
+    thermal_.beginCoupledTimestep(dt);
+    solid_.beginCoupledTimestep(dt);
+
+    mfem::BlockVector x(block_offsets_);
+    x.GetBlock(0) = thermal_.temperature();
+    x.GetBlock(1) = solid_.displacement();
+
+    coupled_solver_->solve(x);
+
+    SLIC_WARNING_ROOT_IF(!coupled_solver_->nonlinearSolver().GetConverged(),
+                         "Monolithic thermomechanics Newton solver did not converge.");
+
+    setCoupledStates(x);
+
+    thermal_.endCoupledTimestep();
+    solid_.endCoupledTimestep();
+  }
+
+  /// @brief Point the thermal and mechanical solvers at the coupled timestep residuals, and build the accelerator
+  void buildCouplingIterations(const CouplingIterationOptions& options)
+  {
+    // the operators of the steps only take the field of their own module, the other one is a parameter
+    thermal_step_residual_ = std::make_unique<mfem_ext::StdFunctionOperator>(
+        thermal_.temperature().space().TrueVSize(),
+
+        [this](const mfem::Vector& temperature, mfem::Vector& r) {
+          thermal_.temperature().Vector::operator=(temperature);
+          r = thermal_.coupledResidual();
+        },
+
+        [this](const mfem::Vector& temperature) -> mfem::Operator& {
+          thermal_.temperature().Vector::operator=(temperature);
+          return thermal_.coupledJacobian();
+        });
+
+    solid_step_residual_ = std::make_unique<mfem_ext::StdFunctionOperator>(
+        solid_.displacement().space().TrueVSize(),
+
+        [this](const mfem::Vector& displacement, mfem::Vector& r) {
+          solid_.displacement().Vector::operator=(displacement);
+          r = solid_.coupledResidual();
+        },
+
+        [this](const mfem::Vector& displacement) -> mfem::Operator& {
+          solid_.displacement().Vector::operator=(displacement);
+          return solid_.coupledJacobian();
+        });
+
+    thermal_solver_->setOperator(*thermal_step_residual_);
+    solid_solver_->setOperator(*solid_step_residual_);
+
+    coupling_accelerator_ = std::make_unique<FixedPointAccelerator>(mesh_.GetComm(), options.acceleration);
+  }
+
+  /**
+   * @brief Advance both physics modules by one timestep, iterating the thermal and mechanical steps until the
+   * displacement converges
+   *
+   * @param dt The timestep
+   */
+  void couplingIterationSolve(double dt)
+  {
+    const CouplingIterationOptions& options = *coupling_iteration_options_;
+
+    thermal_.beginCoupledTimestep(dt);
+    solid_.beginCoupledTimestep(dt);
+    coupling_accelerator_->reset();
+
+    // the fixed point is that of the displacement, through the thermal step it enters and the solid step that follows
+    mfem::Vector displacement(solid_.displacement());
+    mfem::Vector temperature(thermal_.temperature());
+    mfem::Vector image(displacement.Size());
+    mfem::Vector coupling_residual(displacement.Size());
+
+    double initial_norm = 0.0;
+    bool   converged    = false;
+    for (int iteration = 0; iteration < options.max_iterations && !converged; iteration++) {
+      solid_.displacement().Vector::operator=(displacement);
+      temperature = thermal_.temperature();
+      thermal_solver_->solve(temperature);
+      thermal_.temperature().Vector::operator=(temperature);
+
+      image = displacement;
+      solid_solver_->solve(image);
+
+      coupling_residual = image;
+      coupling_residual -= displacement;
+      double norm = std::sqrt(mfem::InnerProduct(mesh_.GetComm(), coupling_residual, coupling_residual));
+      if (iteration == 0) {
+        initial_norm = norm;
+      }
+
+      if (options.print_level > 0) {
+        SLIC_INFO_ROOT(axom::fmt::format("Thermomechanics coupling iteration {}: residual {}", iteration, norm));
+      }
+
+      converged = norm <= std::max(options.absolute_tol, options.relative_tol * initial_norm);
+      if (!converged) {
+        coupling_accelerator_->update(displacement, image);
+      }
+    }
+
+    SLIC_WARNING_ROOT_IF(!converged, "Thermomechanics coupling iterations did not converge.");
+
+    // the displacement of the last solid step, which is consistent with the temperature
+    solid_.displacement().Vector::operator=(image);
+
+    thermal_.endCoupledTimestep();
+    solid_.endCoupledTimestep();
+  }
+
+  /// The equation solver of the heat transfer module, which owns the thermal preconditioner
+  EquationSolver* thermal_solver_;
+
+  /// The timestepping method of the heat transfer module
+  TimestepMethod thermal_timestepper_;
+
+  /// The equation solver of the solid mechanics module, which owns the mechanical preconditioner
+  EquationSolver* solid_solver_;
+
   /// Submodule to compute the thermal conduction physics
   HeatTransfer<order, dim, Parameters<displacement_field, parameter_space...>> thermal_;
 
   /// Submodule to compute the mechanics
   SolidMechanics<order, dim, Parameters<temperature_field, parameter_space...>> solid_;
+
+  /// The temperature at the start of the timestep, which the solid step uses with lagged operator-split coupling
+  std::unique_ptr<FiniteElementState> lagged_temperature_;
+
+  /// The displacement on the thermal submesh, if the heat transfer is on one
+  std::unique_ptr<FiniteElementState> region_displacement_;
+
+  /// The temperature on the mesh of the solid, if the heat transfer is on a submesh (see setOutsideTemperature())
+  std::unique_ptr<FiniteElementState> solid_temperature_;
+
+  /// The transfer of the displacement to the thermal submesh
+  std::unique_ptr<SubmeshTransfer> displacement_to_region_;
+
+  /// The transfer of the temperature from the thermal submesh
+  std::unique_ptr<SubmeshTransfer> temperature_from_region_;
+
+  /// The options of the monolithic solve, if one was requested
+  std::optional<MonolithicSolverOptions> monolithic_options_;
+
+  /// The options of the coupling iterations, if they were requested
+  std::optional<CouplingIterationOptions> coupling_iteration_options_;
+
+  /// The residual of the thermal step of the coupling iterations
+  std::unique_ptr<mfem_ext::StdFunctionOperator> thermal_step_residual_;
+
+  /// The residual of the mechanical step of the coupling iterations
+  std::unique_ptr<mfem_ext::StdFunctionOperator> solid_step_residual_;
+
+  /// The relaxation or acceleration of the displacement iterates of the coupling iterations
+  std::unique_ptr<FixedPointAccelerator> coupling_accelerator_;
+
+  /// The offsets of the temperature and displacement blocks in the coupled true dof vectors
+  mfem::Array<int> block_offsets_;
+
+  /// The residual of the coupled system, and its block Jacobian
+  std::unique_ptr<mfem_ext::StdFunctionOperator> coupled_residual_;
+
+  /// The nonlinear and linear solvers of the coupled system
+  std::unique_ptr<EquationSolver> coupled_solver_;
+
+  /// The block preconditioner built from the thermal and mechanical preconditioners
+  std::unique_ptr<mfem::Solver> block_preconditioner_;
+
+  /// The derivative of the thermal residual with respect to the displacement
+  std::unique_ptr<mfem::HypreParMatrix> J_thermal_displacement_;
+
+  /// The derivative of the mechanical residual with respect to the temperature
+  std::unique_ptr<mfem::HypreParMatrix> J_solid_temperature_;
+
+  /// The block Jacobian of the coupled system
+  std::unique_ptr<mfem::BlockOperator> J_;
 };
 
+/// @cond
+// The common specializations (orders 1-3, in 2D and 3D) are compiled once, in thermomechanics.cpp, and
+// applications link to them instead of instantiating them again
+extern template class Thermomechanics<1, 2>;
+extern template class Thermomechanics<2, 2>;
+extern template class Thermomechanics<3, 2>;
+extern template class Thermomechanics<1, 3>;
+extern template class Thermomechanics<2, 3>;
+extern template class Thermomechanics<3, 3>;
+/// @endcond
+
 }  // namespace serac
@@ -0,0 +1,85 @@
+-- Performance deck: implicit dynamics of a Neo-Hookean beam, clamped at one end and set in motion by an initial
+-- velocity. See performance.ats.
+
+-- Simulation time parameters
+dt      = 0.5
+t_final = 5.0
+
+main_mesh = {
+    type = "file",
+    -- mesh file
+    mesh = "../../data/meshes/beam-hex.mesh",
+    -- serial and parallel refinement levels
+    ser_ref_levels = 2,
+    par_ref_levels = 1,
+}
+
+-- Solver parameters
+solid = {
+    equation_solver = {
+        linear = {
+            type = "iterative",
+            iterative_options = {
+                rel_tol     = 1.0e-8,
+                abs_tol     = 1.0e-12,
+                max_iter    = 2000,
+                print_level = 0,
+                solver_type = "gmres",
+                prec_type   = "HypreAMG",
+            },
+        },
+
+        nonlinear = {
+            rel_tol     = 1.0e-8,
+            abs_tol     = 1.0e-10,
+            max_iter    = 20,
+            print_level = 1,
+        },
+    },
+
+    dynamics = {
+        timestepper = "AverageAcceleration",
+        enforcement_method = "RateControl",
+    },
+
+    -- polynomial interpolation order
+    order = 1,
+
+    -- neo-Hookean material parameters
+    mu = 0.25,
+    K  = 5.0,
+
+    -- initial conditions
+    initial_displacement = {
+        vector_constant = {
+            x = 0.0,
+            y = 0.0,
+            z = 0.0
+        }
+    },
+
+    initial_velocity = {
+        vector_function = function (v)
+            s = 0.1 / 64
+            return Vector.new(-s * v.x * v.x, 0.0, s * v.x * v.x * (8.0 - v.x))
+        end
+    },
+
+    -- boundary condition parameters
+    boundary_conds = {
+        ['displacement'] = {
+            -- the end at x = 0 is clamped
+            attrs = {1},
+            vector_constant = {
+                x = 0.0,
+                y = 0.0,
+                z = 0.0
+            }
+        },
+    },
+}
+
+output = {
+    visualization_cycle_interval = 0,
+    counter_file                 = "counters.json",
+}
@@ -0,0 +1,80 @@
+-- Performance deck: quasistatic J2 plasticity of a beam, loaded past yield by a displacement of its end that grows
+-- with time. See performance.ats.
+
+-- Simulation time parameters
+dt      = 0.25
+t_final = 2.0
+
+main_mesh = {
+    type = "file",
+    -- mesh file
+    mesh = "../../data/meshes/beam-hex.mesh",
+    -- serial and parallel refinement levels
+    ser_ref_levels = 2,
+    par_ref_levels = 1,
+}
+
+-- Solver parameters
+solid = {
+    equation_solver = {
+        linear = {
+            type = "iterative",
+            iterative_options = {
+                rel_tol     = 1.0e-8,
+                abs_tol     = 1.0e-12,
+                max_iter    = 2000,
+                print_level = 0,
+                solver_type = "gmres",
+                prec_type   = "HypreAMG",
+            },
+        },
+
+        nonlinear = {
+            rel_tol     = 1.0e-8,
+            abs_tol     = 1.0e-10,
+            max_iter    = 20,
+            print_level = 1,
+        },
+    },
+
+    -- polynomial interpolation order
+    order = 1,
+
+    -- elastic parameters
+    mu = 40.0,
+    K  = 66.7,
+
+    -- J2 plasticity parameters
+    plasticity = {
+        sigma_y = 0.5,
+        Hi      = 1.0,
+        Hk      = 0.1,
+    },
+
+    geometric_nonlin = false,
+
+    -- boundary condition parameters
+    boundary_conds = {
+        ['displacement'] = {
+            -- the end at x = 0 is clamped
+            attrs = {1},
+            vector_constant = {
+                x = 0.0,
+                y = 0.0,
+                z = 0.0
+            }
+        },
+        ['bending'] = {
+            -- and the end at x = 8 is pushed down
+            attrs = {2},
+            vector_function = function (v, t)
+                return Vector.new(0.0, 0.0, -0.05 * t)
+            end
+        },
+    },
+}
+
+output = {
+    visualization_cycle_interval = 0,
+    counter_file                 = "counters.json",
+}
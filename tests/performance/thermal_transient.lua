@@ -0,0 +1,73 @@
+-- Performance deck: transient heat conduction in a beam, one end of which is heated at a rate that grows with time.
+-- See performance.ats.
+
+-- Simulation time parameters
+dt      = 0.25
+t_final = 5.0
+
+main_mesh = {
+    type = "file",
+    -- mesh file
+    mesh = "../../data/meshes/beam-hex.mesh",
+    -- serial and parallel refinement levels
+    ser_ref_levels = 2,
+    par_ref_levels = 1,
+}
+
+-- Solver parameters
+thermal_conduction = {
+    equation_solver = {
+        linear = {
+            type = "iterative",
+            iterative_options = {
+                rel_tol     = 1.0e-10,
+                abs_tol     = 1.0e-12,
+                max_iter    = 500,
+                print_level = 0,
+                solver_type = "cg",
+                prec_type   = "HypreAMG",
+            },
+        },
+
+        nonlinear = {
+            rel_tol     = 1.0e-8,
+            abs_tol     = 1.0e-10,
+            max_iter    = 20,
+            print_level = 1,
+        },
+    },
+
+    dynamics = {
+        timestepper = "BackwardEuler",
+        enforcement_method = "RateControl",
+    },
+
+    -- polynomial interpolation order
+    order = 2,
+
+    -- material parameters
+    kappa = 1.0,
+    rho   = 1.0,
+    cp    = 1.0,
+
+    -- initial conditions
+    initial_temperature = {
+        constant = 1.0
+    },
+
+    -- boundary condition parameters
+    boundary_conds = {
+        ['temperature'] = {
+            -- the end at x = 0 is heated
+            attrs = {1},
+            scalar_function = function (v, t)
+                return 1.0 + 0.5 * t * t
+            end
+        },
+    },
+}
+
+output = {
+    visualization_cycle_interval = 0,
+    counter_file                 = "counters.json",
+}